@@ -137,35 +137,6 @@ executor::body_writer make_streamed(rjson::value&& value) {
     };
 }
 
-// make_streamed_with_extra_array() is variant of make_streamed() above, which
-// builds a streaming response (a function writing to an output stream) from a
-// JSON object (rjson::value) but adds to it at the end an additional array.
-// The extra array is given a separate chunked_vector to avoid putting it
-// inside the rjson::value - because RapidJSON does contiguous allocations for
-// arrays which we want to avoid for potentially long arrays in Query/Scan
-// responses (see #23535).
-// If we ever fix RapidJSON to avoid contiguous allocations for arrays, or
-// replace it entirely (#24458), we can remove this function and the function
-// rjson::print_with_extra_array() which it calls.
-executor::body_writer make_streamed_with_extra_array(rjson::value&& value,
-    std::string array_name, utils::chunked_vector<rjson::value>&& array) {
-    return [value = std::move(value), array_name = std::move(array_name), array = std::move(array)](output_stream<char>&& _out) mutable -> future<> {
-        auto out = std::move(_out);
-        std::exception_ptr ex;
-        try {
-            co_await rjson::print_with_extra_array(value, array_name, array, out);
-        } catch (...) {
-            ex = std::current_exception();
-        }
-        co_await out.close();
-        co_await rjson::destroy_gently(std::move(value));
-        // TODO: can/should we also destroy the array gently?
-        if (ex) {
-            co_await coroutine::return_exception_ptr(std::move(ex));
-        }
-    };
-}
-
 // This function throws api_error::validation if input value is not an object.
 static void validate_is_object(const rjson::value& value, const char* caller) {
     if (!value.IsObject()) {
@@ -2968,11 +2939,22 @@ static future<> do_batch_write(service::storage_proxy& proxy,
     });
     if (!needs_lwt) {
         // Do a normal write, without LWT:
+        // Items of one partition are joined into one mutation, so that the
+        // partition is written with one request to each of its replicas
+        // (items have distinct keys, so they never overlap).
         utils::chunked_vector<mutation> mutations;
         mutations.reserve(mutation_builders.size());
+        std::unordered_map<schema_decorated_key, size_t, schema_decorated_key_hash, schema_decorated_key_equal>
+            key_mutations(mutation_builders.size(), schema_decorated_key_hash{}, schema_decorated_key_equal{});
         api::timestamp_type now = api::new_timestamp();
         for (auto& b : mutation_builders) {
-            mutations.push_back(b.second.build(b.first, now));
+            auto m = b.second.build(b.first, now);
+            auto [it, added] = key_mutations.try_emplace(schema_decorated_key{b.first, m.decorated_key()}, mutations.size());
+            if (added) {
+                mutations.push_back(std::move(m));
+            } else {
+                mutations[it->second].apply(std::move(m));
+            }
         }
         return proxy.mutate(std::move(mutations),
                 db::consistency_level::LOCAL_QUORUM,
@@ -4813,6 +4795,32 @@ void filter::for_filters_on(const noncopyable_function<void(std::string_view)>&
     }
 }
 
+// The items of a Query or Scan response, each already printed as JSON.
+// They are kept in a chunked_vector, and not in a RapidJSON array, because
+// RapidJSON arrays are stored contiguously in memory, and cause large
+// allocations when a Query/Scan returns a long list of short items
+// (issue #23535).
+class printed_items {
+    utils::chunked_vector<std::string> _items;
+    size_t _size_in_bytes = 0;
+public:
+    void push_back(std::string item) {
+        _size_in_bytes += item.size();
+        _items.push_back(std::move(item));
+    }
+    size_t size() const noexcept {
+        return _items.size();
+    }
+    // Total length of all the printed items.
+    size_t size_in_bytes() const noexcept {
+        return _size_in_bytes;
+    }
+    auto begin() noexcept { return _items.begin(); }
+    auto end() noexcept { return _items.end(); }
+    auto begin() const noexcept { return _items.begin(); }
+    auto end() const noexcept { return _items.end(); }
+};
+
 class describe_items_visitor {
     typedef std::vector<const column_definition*> columns_t;
     const columns_t& _columns;
@@ -4821,11 +4829,11 @@ class describe_items_visitor {
     const filter& _filter;
     typename columns_t::const_iterator _column_it;
     rjson::value _item;
-    // _items is a chunked_vector<rjson::value> instead of a RapidJson array
-    // (rjson::value) because unfortunately RapidJson arrays are stored
-    // contiguously in memory, and cause large allocations when a Query/Scan
-    // returns a long list of short items (issue #23535).
-    utils::chunked_vector<rjson::value> _items;
+    // If false, the user asked only to count the items (Select=COUNT),
+    // so the matching items are counted but not kept.
+    bool _keep_items;
+    printed_items _items;
+    size_t _count;
     size_t _scanned_count;
 
 public:
@@ -4835,6 +4843,8 @@ class describe_items_visitor {
             , _filter(filter)
             , _column_it(columns.begin())
             , _item(rjson::empty_object())
+            , _keep_items(!attrs_to_get || !attrs_to_get->empty())
+            , _count(0)
             , _scanned_count(0)
     {
         // _filter.check() may need additional attributes not listed in
@@ -4913,30 +4923,38 @@ class describe_items_visitor {
                 rjson::remove_member(_item, attr);
             }
 
-            _items.push_back(std::move(_item));
+            if (_keep_items) {
+                // Print the item right away, so that its DOM, which is
+                // several times bigger than its text, can be dropped
+                // before the next row is read.
+                _items.push_back(rjson::print(_item));
+            }
+            ++_count;
         }
         _item = rjson::empty_object();
         ++_scanned_count;
     }
 
-    utils::chunked_vector<rjson::value> get_items() && {
+    printed_items get_items() && {
         return std::move(_items);
     }
 
+    size_t get_count() {
+        return _count;
+    }
+
     size_t get_scanned_count() {
         return _scanned_count;
     }
 };
 
 // describe_items() returns a JSON object that includes members "Count"
-// and "ScannedCount", but *not* "Items" - that is returned separately
-// as a chunked_vector to avoid large contiguous allocations which
-// RapidJSON does of its array. The caller should add "Items" to the
-// returned JSON object if needed, or print it separately.
-// The returned chunked_vector (the items) is std::optional<>, because
-// the user may have requested only to count items, and not return any
-// items - which is different from returning an empty list of items.
-static future<std::tuple<rjson::value, std::optional<utils::chunked_vector<rjson::value>>, size_t>> describe_items(
+// and "ScannedCount", but *not* "Items" - that is returned separately,
+// already printed, and should be written out with make_items_response().
+// The returned items are std::optional<>, because the user may have
+// requested only to count items, and not return any items - which is
+// different from returning an empty list of items.
+static future<std::tuple<rjson::value, std::optional<printed_items>, size_t>> describe_items(
         const cql3::selection::selection& selection,
         std::unique_ptr<cql3::result_set> result_set,
         std::optional<attrs_to_get>&& attrs_to_get,
@@ -4944,21 +4962,16 @@ static future<std::tuple<rjson::value, std::optional<utils::chunked_vector<rjson
     describe_items_visitor visitor(selection.get_columns(), attrs_to_get, filter);
     co_await result_set->visit_gently(visitor);
     auto scanned_count = visitor.get_scanned_count();
-    utils::chunked_vector<rjson::value> items = std::move(visitor).get_items();
+    auto size = visitor.get_count();
     rjson::value items_descr = rjson::empty_object();
-    auto size = items.size();
     rjson::add(items_descr, "Count", rjson::value(size));
     rjson::add(items_descr, "ScannedCount", rjson::value(scanned_count));
     // If attrs_to_get && attrs_to_get->empty(), this means the user asked not
     // to get any attributes (i.e., a Scan or Query with Select=COUNT) and we
     // shouldn't return "Items" at all.
-    // TODO: consider optimizing the case of Select=COUNT without a filter.
-    // In that case, we currently build a list of empty items and here drop
-    // it. We could just count the items and not bother with the empty items.
-    // (However, remember that when we do have a filter, we need the items).
-    std::optional<utils::chunked_vector<rjson::value>> opt_items;
+    std::optional<printed_items> opt_items;
     if (!attrs_to_get || !attrs_to_get->empty()) {
-        opt_items = std::move(items);
+        opt_items = std::move(visitor).get_items();
     }
     co_return std::tuple(std::move(items_descr), std::move(opt_items), size);
 }
@@ -4998,11 +5011,59 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
     return last_evaluated_key;
 }
 
-// RapidJSON allocates arrays contiguously in memory, so we want to avoid
-// returning a large number of items as a single rapidjson array, and use
-// a chunked_vector instead. The following constant is an arbitrary cutoff
-// point for when to switch from a rapidjson array to a chunked_vector.
-static constexpr int max_items_for_rapidjson_array = 256;
+// Builds a Query or Scan response out of the given JSON object and the
+// already printed items, which are added to it as the "Items" array.
+// The items are never put back into a DOM: a small response is returned
+// as a string, a big one is streamed, item by item, to the HTTP output.
+static executor::request_return_type make_items_response(rjson::value&& value, printed_items&& items) {
+    // The object always has at least the "Count" member, so the items
+    // can be simply spliced in before its closing brace.
+    SCYLLA_ASSERT(value.IsObject() && value.MemberCount() > 0);
+    std::string head = rjson::print(value);
+    head.back() = ',';
+    head += "\"Items\":[";
+    static constexpr std::string_view tail = "]}";
+    if (head.size() + items.size_in_bytes() + items.size() + tail.size() <= 100'000) {
+        std::string response = std::move(head);
+        response.reserve(response.size() + items.size_in_bytes() + items.size() + tail.size());
+        bool first = true;
+        for (const auto& item : items) {
+            if (!first) {
+                response += ',';
+            }
+            response += item;
+            first = false;
+        }
+        response += tail;
+        return response;
+    }
+    return [head = std::move(head), items = std::move(items)] (output_stream<char>&& _out) mutable -> future<> {
+        auto out = std::move(_out);
+        std::exception_ptr ex;
+        try {
+            co_await out.write(head.data(), head.size());
+            bool first = true;
+            for (auto& item : items) {
+                if (!first) {
+                    co_await out.write(",", 1);
+                }
+                co_await out.write(item.data(), item.size());
+                // Free each item as soon as it's written, the output stream
+                // holds its own copy of whatever wasn't sent out yet.
+                std::string().swap(item);
+                first = false;
+                co_await coroutine::maybe_yield();
+            }
+            co_await out.write(tail.data(), tail.size());
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    };
+}
 
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
         schema_ptr table_schema,
@@ -5086,20 +5147,7 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
         cql_stats.filtered_rows_matched_total += size;
     }
     if (opt_items) {
-        if (opt_items->size() >= max_items_for_rapidjson_array) {
-            // There are many items, better print the JSON and the array of
-            // items (opt_items) separately to avoid RapidJSON's contiguous
-            // allocation of arrays.
-            co_return make_streamed_with_extra_array(std::move(items_descr), "Items", std::move(*opt_items));
-        }
-        // There aren't many items in the chunked vector opt_items,
-        // let's just insert them into the JSON object and print the
-        // full JSON normally.
-        rjson::value items_json = rjson::empty_array();
-        for (auto& item : *opt_items) {
-            rjson::push_back(items_json, std::move(item));
-        }
-        rjson::add(items_descr, "Items", std::move(items_json));
+        co_return make_items_response(std::move(items_descr), std::move(*opt_items));
     }
     if (is_big(items_descr)) {
         co_return make_streamed(std::move(items_descr));
@@ -21,7 +21,9 @@
 #include <seastar/util/log.hh>
 
 #include <functional>
+#include <list>
 #include <unordered_map>
+#include <variant>
 
 namespace alternator {
 
@@ -62,19 +64,98 @@ static Result parse(const char* input_name, std::string_view input, Func&& f) {
     }
 }
 
+namespace {
+
+// A per-shard LRU cache of parsed expressions, see parse_update_expression().
+class parsed_expression_cache {
+public:
+    using expression = std::variant<parsed::update_expression, std::vector<parsed::path>, parsed::condition_expression>;
+    // The same text may be valid as different kinds of expressions,
+    // so the kind (the index of the alternative in 'expression', see
+    // kind_of()) is a part of the key.
+    struct key {
+        size_t kind;
+        std::string text;
+        bool operator==(const key&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key& k) const noexcept {
+            return std::hash<std::string_view>()(k.text) ^ k.kind;
+        }
+    };
+    // Expressions are at most 4096 bytes long, so the cache takes
+    // at most about 4MB per shard, and usually much less.
+    static constexpr size_t max_entries = 1024;
+private:
+    using lru_list = std::list<std::pair<key, expression>>;
+    lru_list _lru;
+    std::unordered_map<key, lru_list::iterator, key_hash> _index;
+    parsed_expression_cache_stats _stats;
+
+    template <typename T>
+    static constexpr size_t kind_of() {
+        if constexpr (std::is_same_v<T, parsed::update_expression>) {
+            return 0;
+        } else if constexpr (std::is_same_v<T, std::vector<parsed::path>>) {
+            return 1;
+        } else {
+            static_assert(std::is_same_v<T, parsed::condition_expression>);
+            return 2;
+        }
+    }
+public:
+    template <typename T, typename Func>
+    T get_or_parse(std::string_view text, Func&& parse_func) {
+        key k{kind_of<T>(), std::string(text)};
+        if (auto it = _index.find(k); it != _index.end()) {
+            ++_stats.hits;
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return std::get<T>(it->second->second);
+        }
+        ++_stats.misses;
+        T parsed = parse_func();
+        if (_lru.size() >= max_entries) {
+            _index.erase(_lru.back().first);
+            _lru.pop_back();
+            ++_stats.evictions;
+        }
+        _lru.emplace_front(k, parsed);
+        _index.emplace(std::move(k), _lru.begin());
+        _stats.size = _lru.size();
+        return parsed;
+    }
+    const parsed_expression_cache_stats& stats() const noexcept {
+        return _stats;
+    }
+};
+
+thread_local parsed_expression_cache the_parsed_expression_cache;
+
+}
+
+const parsed_expression_cache_stats& get_parsed_expression_cache_stats() {
+    return the_parsed_expression_cache.stats();
+}
+
 parsed::update_expression
 parse_update_expression(std::string_view query) {
-    return parse("UpdateExpression", query,  std::mem_fn(&expressionsParser::update_expression));
+    return the_parsed_expression_cache.get_or_parse<parsed::update_expression>(query, [query] {
+        return parse("UpdateExpression", query,  std::mem_fn(&expressionsParser::update_expression));
+    });
 }
 
 std::vector<parsed::path>
 parse_projection_expression(std::string_view query) {
-    return parse ("ProjectionExpression", query,  std::mem_fn(&expressionsParser::projection_expression));
+    return the_parsed_expression_cache.get_or_parse<std::vector<parsed::path>>(query, [query] {
+        return parse ("ProjectionExpression", query,  std::mem_fn(&expressionsParser::projection_expression));
+    });
 }
 
 parsed::condition_expression
 parse_condition_expression(std::string_view query, const char* caller) {
-    return parse(caller, query,  std::mem_fn(&expressionsParser::condition_expression));
+    return the_parsed_expression_cache.get_or_parse<parsed::condition_expression>(query, [query, caller] {
+        return parse(caller, query,  std::mem_fn(&expressionsParser::condition_expression));
+    });
 }
 
 namespace parsed {
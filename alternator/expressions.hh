@@ -26,10 +26,27 @@ class expressions_syntax_error : public std::runtime_error {
     using runtime_error::runtime_error;
 };
 
+// The parse_*() functions keep a per-shard LRU cache of the parsed
+// expressions, keyed by the expression's text, so that the common case of
+// many requests using the same few expressions doesn't run the parser for
+// each of them. The cached expressions are the unresolved ones, so the
+// attribute name and value placeholders do not need to be part of the key -
+// each call returns a copy, to be resolved with the request's
+// ExpressionAttributeNames and ExpressionAttributeValues. Expressions which
+// failed to parse are not cached.
 parsed::update_expression parse_update_expression(std::string_view query);
 std::vector<parsed::path> parse_projection_expression(std::string_view query);
 parsed::condition_expression parse_condition_expression(std::string_view query, const char* caller);
 
+struct parsed_expression_cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t size = 0;
+};
+// Statistics of this shard's cache of parsed expressions.
+const parsed_expression_cache_stats& get_parsed_expression_cache_stats();
+
 void resolve_update_expression(parsed::update_expression& ue,
         const rjson::value* expression_attribute_names,
         const rjson::value* expression_attribute_values,
@@ -7,6 +7,7 @@
  */
 
 #include "stats.hh"
+#include "expressions.hh"
 #include "utils/histogram_metrics_helper.hh"
 #include <seastar/core/metrics.hh>
 #include "utils/labels.hh"
@@ -130,6 +131,12 @@ static void register_metrics_with_optional_table(seastar::metrics::metric_groups
                     seastar::metrics::description("Counts a number of requests blocked due to memory pressure."), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("requests_shed", stats.requests_shed,
                     seastar::metrics::description("Counts a number of requests shed due to overload."), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("get_records_waits", stats.get_records_waits,
+                    seastar::metrics::description("number of times a GetRecords request found no new records and waited for them"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("get_records_rows_read", stats.get_records_rows_read,
+                    seastar::metrics::description("number of CDC log rows read by GetRecords requests"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("get_records_records_returned", stats.get_records_records_returned,
+                    seastar::metrics::description("number of stream records returned by GetRecords requests"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("filtered_rows_read_total", stats.cql_stats.filtered_rows_read_total,
                     seastar::metrics::description("number of rows read during filtering operations"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("filtered_rows_matched_total", stats.cql_stats.filtered_rows_matched_total,
@@ -159,6 +166,17 @@ static void register_metrics_with_optional_table(seastar::metrics::metric_groups
 
 void register_metrics(seastar::metrics::metric_groups& metrics, const stats& stats) {
     register_metrics_with_optional_table(metrics, stats, "", "");
+    const auto& cache_stats = get_parsed_expression_cache_stats();
+    metrics.add_group(ALTERNATOR_METRICS, {
+            seastar::metrics::make_total_operations("expression_cache_hits", cache_stats.hits,
+                    seastar::metrics::description("number of expressions found in the cache of parsed expressions"))(basic_level),
+            seastar::metrics::make_total_operations("expression_cache_misses", cache_stats.misses,
+                    seastar::metrics::description("number of expressions not found in the cache of parsed expressions, which had to be parsed"))(basic_level),
+            seastar::metrics::make_total_operations("expression_cache_evictions", cache_stats.evictions,
+                    seastar::metrics::description("number of expressions evicted from the cache of parsed expressions"))(basic_level),
+            seastar::metrics::make_gauge("expression_cache_size", cache_stats.size,
+                    seastar::metrics::description("number of expressions in the cache of parsed expressions")),
+    });
 }
 table_stats::table_stats(const sstring& ks, const sstring& table) {
     _stats = make_lw_shared<stats>();
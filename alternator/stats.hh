@@ -87,6 +87,12 @@ class stats {
     uint64_t shard_bounce_for_lwt = 0;
     uint64_t requests_blocked_memory = 0;
     uint64_t requests_shed = 0;
+    // Number of times GetRecords found nothing and waited for new records
+    uint64_t get_records_waits = 0;
+    // CDC log rows read by GetRecords, and the records they made up. Their
+    // ratio is the read amplification of GetRecords.
+    uint64_t get_records_rows_read = 0;
+    uint64_t get_records_records_returned = 0;
     uint64_t rcu_half_units_total = 0;
     // wcu can results from put, update, delete and index
     // Index related will be done on top of the operation it comes with
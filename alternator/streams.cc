@@ -11,6 +11,7 @@
 #include <boost/io/ios_state.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include <seastar/core/sleep.hh>
 #include <seastar/json/formatter.hh>
 
 #include "auth/permission.hh"
@@ -429,6 +430,10 @@ using namespace std::chrono_literals;
 // Dynamo docs says no data shall live longer than 24h.
 static constexpr auto dynamodb_streams_max_window = 24h;
 
+// How often a waiting GetRecords request looks for new records, see
+// alternator_streams_get_records_max_wait_ms.
+static constexpr auto get_records_poll_interval = 100ms;
+
 future<executor::request_return_type> executor::describe_stream(client_state& client_state, service_permit permit, rjson::value request) {
     _stats.api_operations.describe_stream++;
 
@@ -835,15 +840,6 @@ future<executor::request_return_type> executor::get_records(client_state& client
 
     dht::partition_range_vector partition_ranges{ dht::partition_range::make_singular(dht::decorate_key(*schema, pk)) };
 
-    auto high_ts = db_clock::now() - confidence_interval(db);
-    auto high_uuid = utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch());
-    auto lo = clustering_key_prefix::from_exploded(*schema, { iter.threshold.serialize() });
-    auto hi = clustering_key_prefix::from_exploded(*schema, { high_uuid.serialize() });
-
-    std::vector<query::clustering_range> bounds;
-    using bound = typename query::clustering_range::bound;
-    bounds.push_back(query::clustering_range::make(bound(lo, iter.inclusive), bound(hi, false)));
-
     static const bytes timestamp_column_name = cdc::log_meta_column_name_bytes("time");
     static const bytes op_column_name = cdc::log_meta_column_name_bytes("operation");
     static const bytes eor_column_name = cdc::log_meta_column_name_bytes("end_of_batch");
@@ -884,9 +880,6 @@ future<executor::request_return_type> executor::get_records(client_state& client
     stream_view_type type = cdc_options_to_steam_view_type(base->cdc_options());
 
     auto selection = cql3::selection::selection::for_columns(schema, std::move(columns));
-    auto partition_slice = query::partition_slice(
-        std::move(bounds)
-        , {}, std::move(regular_columns), selection->get_query_options());
 
 	auto& opts = base->cdc_options();
 	auto mul = 2; // key-only, allow for delete + insert
@@ -896,16 +889,37 @@ future<executor::request_return_type> executor::get_records(client_state& client
     if (opts.postimage()) {
         ++mul;
     }
-    auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-            query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * mul));
 
-    co_return co_await _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), std::move(permit), client_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
+    auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
+    // If there is nothing to return yet from a shard which is still open,
+    // GetRecords can wait for new records to show up instead of returning
+    // an empty result right away, to save the client from polling in a
+    // tight loop (see alternator_streams_get_records_max_wait_ms).
+    auto wait_until = start_time + std::chrono::milliseconds(db.get_config().alternator_streams_get_records_max_wait_ms());
+
+    for (;;) {
+        auto high_ts = db_clock::now() - confidence_interval(db);
+        auto high_uuid = utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch());
+        auto lo = clustering_key_prefix::from_exploded(*schema, { iter.threshold.serialize() });
+        auto hi = clustering_key_prefix::from_exploded(*schema, { high_uuid.serialize() });
+
+        std::vector<query::clustering_range> bounds;
+        using bound = typename query::clustering_range::bound;
+        bounds.push_back(query::clustering_range::make(bound(lo, iter.inclusive), bound(hi, false)));
+
+        auto partition_slice = query::partition_slice(
+            std::move(bounds)
+            , {}, regular_columns, selection->get_query_options());
+        auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
+                query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * mul));
+
+        auto qr = co_await _proxy.query(schema, std::move(command), partition_ranges, cl, service::storage_proxy::coordinator_query_options(default_timeout(), permit, client_state));
         cql3::selection::result_set_builder builder(*selection, gc_clock::now());
         query::result_view::consume(*qr.query_result, partition_slice, cql3::selection::result_set_builder::visitor(builder, *schema, *selection));
 
         auto result_set = builder.build();
         auto records = rjson::empty_array();
+        _stats.get_records_rows_read += result_set->rows().size();
 
         auto& metadata = result_set->get_metadata();
 
@@ -1015,6 +1029,7 @@ future<executor::request_return_type> executor::get_records(client_state& client
 
         auto ret = rjson::empty_object();
         auto nrecords = records.Size();
+        _stats.get_records_records_returned += nrecords;
         rjson::add(ret, "Records", std::move(records));
 
         if (nrecords != 0) {
@@ -1026,35 +1041,43 @@ future<executor::request_return_type> executor::get_records(client_state& client
             // will notice end end of shard and not return NextShardIterator.
             rjson::add(ret, "NextShardIterator", next_iter);
             _stats.api_operations.get_records_latency.mark(std::chrono::steady_clock::now() - start_time);
-            return make_ready_future<executor::request_return_type>(rjson::print(std::move(ret)));
+            co_return rjson::print(std::move(ret));
         }
 
         // ugh. figure out if we are and end-of-shard
-        auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
-
-        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, ret = std::move(ret)](db_clock::time_point ts) mutable {
-            auto& shard = iter.shard;            
-
-            if (shard.time < ts && ts < high_ts) {
-                // The DynamoDB documentation states that when a shard is
-                // closed, reading it until the end has NextShardIterator
-                // "set to null". Our test test_streams_closed_read
-                // confirms that by "null" they meant not set at all.
-            } else {
-                // We could have return the same iterator again, but we did
-                // a search from it until high_ts and found nothing, so we
-                // can also start the next search from high_ts.
-                // TODO: but why? It's simpler just to leave the iterator be.
-                shard_iterator next_iter(iter.table, iter.shard, utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch()), true);
-                rjson::add(ret, "NextShardIterator", iter);
+        auto ts = co_await _sdks.cdc_current_generation_timestamp({ normal_token_owners });
+        auto& shard = iter.shard;
+
+        if (shard.time < ts && ts < high_ts) {
+            // The DynamoDB documentation states that when a shard is
+            // closed, reading it until the end has NextShardIterator
+            // "set to null". Our test test_streams_closed_read
+            // confirms that by "null" they meant not set at all.
+        } else {
+            // If we did a search from the iterator until high_ts and found
+            // no rows at all (not even rows of an incomplete record cut by
+            // the row limit), the next search can start from high_ts, since
+            // records older than high_ts cannot show up anymore. Without
+            // that, a consumer polling a shard with no new records would
+            // scan the same range, possibly full of expired records, on
+            // every GetRecords. An iterator past high_ts (e.g. of LATEST)
+            // stays where it is.
+            if (result_set->rows().empty() && utils::timeuuid_tri_compare(high_uuid, iter.threshold) > 0) {
+                iter = shard_iterator(iter.table, iter.shard, high_uuid, true);
             }
-            _stats.api_operations.get_records_latency.mark(std::chrono::steady_clock::now() - start_time);
-            if (is_big(ret)) {
-                return make_ready_future<executor::request_return_type>(make_streamed(std::move(ret)));
+            if (std::chrono::steady_clock::now() + get_records_poll_interval <= wait_until) {
+                _stats.get_records_waits++;
+                co_await seastar::sleep(get_records_poll_interval);
+                continue;
             }
-            return make_ready_future<executor::request_return_type>(rjson::print(std::move(ret)));
-        });
-    });
+            rjson::add(ret, "NextShardIterator", iter);
+        }
+        _stats.api_operations.get_records_latency.mark(std::chrono::steady_clock::now() - start_time);
+        if (is_big(ret)) {
+            co_return make_streamed(std::move(ret));
+        }
+        co_return rjson::print(std::move(ret));
+    }
 }
 
 bool executor::add_stream_options(const rjson::value& stream_specification, schema_builder& builder, service::storage_proxy& sp) {
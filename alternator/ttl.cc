@@ -514,17 +514,36 @@ struct scan_ranges_context {
         , member(member)
         , internal_client_state(service::client_state::internal_tag())
     {
-        // FIXME: don't read the entire items - read only parts of it.
-        // We must read the key columns (to be able to delete) and also
-        // the requested attribute. If the requested attribute is a map's
-        // member we may be forced to read the entire map - but it would
-        // be good if we can read only the single item of the map - it
-        // should be possible (and a must for issue #7751!).
+        // Don't read the entire items - we only need the key columns (to be
+        // able to delete) and the column holding the expiration time. If the
+        // expiration time is a map's member we are still forced to read the
+        // entire map - but it would be good if we can read only the single
+        // item of the map - it should be possible (and a must for issue #7751!).
+        // If the expiration time is itself a key column, we still read all
+        // the regular columns, because without any of them a row which has
+        // no row marker would not be returned at all.
+        // NOTICE: expire_item() relies on the key columns coming first, in
+        // the same order as in selection::wildcard().
         lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
-        auto regular_columns =
-            s->regular_columns() | std::views::transform(&column_definition::id)
-            | std::ranges::to<query::column_id_vector>();
-        selection = cql3::selection::selection::wildcard(s);
+        const column_definition* cd = s->get_column_definition(column_name);
+        std::vector<const column_definition*> columns;
+        for (const column_definition& c : s->partition_key_columns()) {
+            columns.push_back(&c);
+        }
+        for (const column_definition& c : s->clustering_key_columns()) {
+            columns.push_back(&c);
+        }
+        query::column_id_vector regular_columns;
+        if (cd && cd->is_regular()) {
+            columns.push_back(cd);
+            regular_columns.push_back(cd->id);
+            selection = cql3::selection::selection::for_columns(s, std::move(columns));
+        } else {
+            regular_columns =
+                s->regular_columns() | std::views::transform(&column_definition::id)
+                | std::ranges::to<query::column_id_vector>();
+            selection = cql3::selection::selection::wildcard(s);
+        }
         query::partition_slice::option_set opts = selection->get_query_options();
         opts.set<query::partition_slice::option::allow_short_read>();
         // It is important that the scan bypass cache to avoid polluting it:
@@ -607,6 +626,7 @@ static future<> scan_table_ranges(
             continue;
         }
         for (const auto& row : rows) {
+            expiration_stats.items_scanned++;
             const managed_bytes_opt& cell = row[*expiration_column];
             if (!cell) {
                 continue;
@@ -900,6 +920,8 @@ expiration_service::stats::stats() {
             seastar::metrics::description("number of passes over the database"))(alternator_label).set_skip_when_empty(),
         seastar::metrics::make_total_operations("scan_table", scan_table,
             seastar::metrics::description("number of table scans (counting each scan of each table that enabled expiration)"))(alternator_label).set_skip_when_empty(),
+        seastar::metrics::make_total_operations("items_scanned", items_scanned,
+            seastar::metrics::description("number of items read by the expiration scanner, whether expired or not"))(alternator_label).set_skip_when_empty(),
         seastar::metrics::make_total_operations("items_deleted", items_deleted,
             seastar::metrics::description("number of items deleted after expiration"))(basic_level)(alternator_label).set_skip_when_empty(),
         seastar::metrics::make_total_operations("secondary_ranges_scanned", secondary_ranges_scanned,
@@ -41,6 +41,7 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
         stats();
         uint64_t scan_passes = 0;
         uint64_t scan_table = 0;
+        uint64_t items_scanned = 0;
         uint64_t items_deleted = 0;
         uint64_t secondary_ranges_scanned = 0;
     private:
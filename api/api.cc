@@ -188,6 +188,14 @@ future<> unset_server_snapshot(http_context& ctx) {
     return ctx.http_server.set_routes([&ctx] (routes& r) { unset_snapshot(ctx, r); });
 }
 
+future<> set_server_cache_warmer(http_context& ctx, sharded<db::cache_warmer>& cw) {
+    return ctx.http_server.set_routes([&ctx, &cw] (routes& r) { set_cache_warmer(ctx, r, cw); });
+}
+
+future<> unset_server_cache_warmer(http_context& ctx) {
+    return ctx.http_server.set_routes([&ctx] (routes& r) { unset_cache_warmer(ctx, r); });
+}
+
 future<> set_server_token_metadata(http_context& ctx, sharded<locator::shared_token_metadata>& tm, sharded<gms::gossiper>& g) {
     return ctx.http_server.set_routes([&ctx, &tm, &g] (routes& r) { set_token_metadata(ctx, r, tm, g); });
 }
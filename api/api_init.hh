@@ -50,6 +50,7 @@ class snitch_ptr;
 
 namespace cql_transport { class controller; }
 namespace db {
+class cache_warmer;
 class snapshot_ctl;
 class config;
 class sstables_format_selector;
@@ -112,6 +113,8 @@ future<> set_server_authorization_cache(http_context& ctx, sharded<auth::service
 future<> unset_server_authorization_cache(http_context& ctx);
 future<> set_server_snapshot(http_context& ctx, sharded<db::snapshot_ctl>& snap_ctl);
 future<> unset_server_snapshot(http_context& ctx);
+future<> set_server_cache_warmer(http_context& ctx, sharded<db::cache_warmer>& cw);
+future<> unset_server_cache_warmer(http_context& ctx);
 future<> set_server_token_metadata(http_context& ctx, sharded<locator::shared_token_metadata>& tm, sharded<gms::gossiper>& g);
 future<> unset_server_token_metadata(http_context& ctx);
 future<> set_server_gossip(http_context& ctx, sharded<gms::gossiper>& g);
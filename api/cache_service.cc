@@ -10,6 +10,7 @@
 #include "api/api.hh"
 #include "api/api-doc/cache_service.json.hh"
 #include "column_family.hh"
+#include "db/cache_warmer.hh"
 
 namespace api {
 using namespace json;
@@ -17,12 +18,6 @@ using namespace seastar::httpd;
 namespace cs = httpd::cache_service_json;
 
 void set_cache_service(http_context& ctx, sharded<replica::database>& db, routes& r) {
-    cs::get_row_cache_save_period_in_seconds.set(r, [](std::unique_ptr<http::request> req) {
-        // We never save the cache
-        // Origin uses 0 for never
-        return make_ready_future<json::json_return_type>(0);
-    });
-
     cs::set_row_cache_save_period_in_seconds.set(r, [](std::unique_ptr<http::request> req) {
         // TBD
         unimplemented();
@@ -56,12 +51,6 @@ void set_cache_service(http_context& ctx, sharded<replica::database>& db, routes
         return make_ready_future<json::json_return_type>(json_void());
     });
 
-    cs::get_row_cache_keys_to_save.set(r, [](std::unique_ptr<http::request> req) {
-        // TBD
-        unimplemented();
-        return make_ready_future<json::json_return_type>(0);
-    });
-
     cs::set_row_cache_keys_to_save.set(r, [](std::unique_ptr<http::request> req) {
         // TBD
         unimplemented();
@@ -128,12 +117,6 @@ void set_cache_service(http_context& ctx, sharded<replica::database>& db, routes
         return make_ready_future<json::json_return_type>(json_void());
     });
 
-    cs::save_caches.set(r, [](std::unique_ptr<http::request> req) {
-        // TBD
-        unimplemented();
-        return make_ready_future<json::json_return_type>(json_void());
-    });
-
     cs::get_key_capacity.set(r, [] (std::unique_ptr<http::request> req) {
         // TBD
         // FIXME
@@ -321,13 +304,11 @@ void set_cache_service(http_context& ctx, sharded<replica::database>& db, routes
 }
 
 void unset_cache_service(http_context& ctx, routes& r) {
-    cs::get_row_cache_save_period_in_seconds.unset(r);
     cs::set_row_cache_save_period_in_seconds.unset(r);
     cs::get_key_cache_save_period_in_seconds.unset(r);
     cs::set_key_cache_save_period_in_seconds.unset(r);
     cs::get_counter_cache_save_period_in_seconds.unset(r);
     cs::set_counter_cache_save_period_in_seconds.unset(r);
-    cs::get_row_cache_keys_to_save.unset(r);
     cs::set_row_cache_keys_to_save.unset(r);
     cs::get_key_cache_keys_to_save.unset(r);
     cs::set_key_cache_keys_to_save.unset(r);
@@ -338,7 +319,6 @@ void unset_cache_service(http_context& ctx, routes& r) {
     cs::set_row_cache_capacity_in_mb.unset(r);
     cs::set_key_cache_capacity_in_mb.unset(r);
     cs::set_counter_cache_capacity_in_mb.unset(r);
-    cs::save_caches.unset(r);
     cs::get_key_capacity.unset(r);
     cs::get_key_hits.unset(r);
     cs::get_key_requests.unset(r);
@@ -365,5 +345,43 @@ void unset_cache_service(http_context& ctx, routes& r) {
     cs::get_counter_entries.unset(r);
 }
 
+void set_cache_warmer(http_context& ctx, routes& r, sharded<db::cache_warmer>& cw) {
+    cs::get_row_cache_save_period_in_seconds.set(r, [&cw] (std::unique_ptr<http::request> req) {
+        // Origin uses 0 for never
+        return make_ready_future<json::json_return_type>(cw.local().get_config().save_period.count());
+    });
+
+    cs::get_row_cache_keys_to_save.set(r, [&cw] (std::unique_ptr<http::request> req) {
+        return make_ready_future<json::json_return_type>(cw.local().get_config().keys_to_save);
+    });
+
+    cs::save_caches.set(r, [&cw] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        co_await cw.local().save();
+        co_return json_void();
+    });
+
+    cs::get_row_cache_warmup_progress.set(r, [&cw] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        auto progress = co_await cw.map_reduce0([] (db::cache_warmer& cw) {
+            return cw.get_warmup_progress();
+        }, db::cache_warmer::warmup_progress{.done = true}, [] (db::cache_warmer::warmup_progress a, const db::cache_warmer::warmup_progress& b) {
+            a.keys_to_load += b.keys_to_load;
+            a.keys_loaded += b.keys_loaded;
+            a.done = a.done && b.done;
+            return a;
+        });
+        cs::row_cache_warmup_progress res;
+        res.keys_to_load = progress.keys_to_load;
+        res.keys_loaded = progress.keys_loaded;
+        res.done = progress.done;
+        co_return res;
+    });
+}
+
+void unset_cache_warmer(http_context& ctx, routes& r) {
+    cs::get_row_cache_save_period_in_seconds.unset(r);
+    cs::get_row_cache_keys_to_save.unset(r);
+    cs::save_caches.unset(r);
+    cs::get_row_cache_warmup_progress.unset(r);
 }
 
+}
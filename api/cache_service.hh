@@ -17,10 +17,16 @@ namespace replica {
 class database;
 }
 
+namespace db {
+class cache_warmer;
+}
+
 namespace api {
 
 struct http_context;
 void set_cache_service(http_context& ctx, seastar::sharded<replica::database>& db, seastar::httpd::routes& r);
 void unset_cache_service(http_context& ctx, seastar::httpd::routes& r);
+void set_cache_warmer(http_context& ctx, seastar::httpd::routes& r, seastar::sharded<db::cache_warmer>& cw);
+void unset_cache_warmer(http_context& ctx, seastar::httpd::routes& r);
 
 }
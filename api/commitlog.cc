@@ -12,21 +12,24 @@
 #include "api/api-doc/storage_service.json.hh"
 #include "api/api_init.hh"
 #include "replica/database.hh"
+#include <seastar/core/coroutine.hh>
 #include <vector>
 
 namespace api {
 using namespace seastar::httpd;
 namespace ss = httpd::storage_service_json;
 
+// Sums the metric over all shards and commitlog domains
 template<typename T>
 static auto acquire_cl_metric(sharded<replica::database>& db, std::function<T (const db::commitlog*)> func) {
     typedef T ret_type;
 
     return db.map_reduce0([func = std::move(func)](replica::database& db) {
-        if (db.commitlog() == nullptr) {
-            return make_ready_future<ret_type>();
+        ret_type res{};
+        for (auto cl : db.commitlogs()) {
+            res += func(cl);
         }
-        return make_ready_future<ret_type>(func(db.commitlog()));
+        return make_ready_future<ret_type>(res);
     }, ret_type(), std::plus<ret_type>()).then([](ret_type res) {
         return make_ready_future<json::json_return_type>(res);
     });
@@ -39,10 +42,12 @@ void set_commitlog(http_context& ctx, routes& r, sharded<replica::database>& db)
         return db.map_reduce([res](std::vector<sstring> names) {
             res->insert(res->end(), names.begin(), names.end());
         }, [](replica::database& db) {
-            if (db.commitlog() == nullptr) {
-                return make_ready_future<std::vector<sstring>>(std::vector<sstring>());
+            std::vector<sstring> names;
+            for (auto cl : db.commitlogs()) {
+                auto n = cl->get_active_segment_names();
+                names.insert(names.end(), n.begin(), n.end());
             }
-            return make_ready_future<std::vector<sstring>>(db.commitlog()->get_active_segment_names());
+            return make_ready_future<std::vector<sstring>>(std::move(names));
         }).then([res] {
             return make_ready_future<json::json_return_type>(*res.get());
         });
@@ -69,6 +74,37 @@ void set_commitlog(http_context& ctx, routes& r, sharded<replica::database>& db)
         return acquire_cl_metric<uint64_t>(db, std::bind(&db::commitlog::disk_limit, std::placeholders::_1));
     });
 
+    httpd::commitlog_json::get_pinned_segments.set(r, [&db](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        using pinned_segments = httpd::commitlog_json::pinned_segments;
+        auto res = co_await db.map_reduce0([](replica::database& db) {
+            std::vector<pinned_segments> res;
+            auto now = gc_clock::now();
+            auto cls = db.commitlogs();
+            for (unsigned domain = 0; domain < cls.size(); ++domain) {
+                for (auto& p : cls[domain]->get_pinned_segments()) {
+                    pinned_segments e;
+                    if (auto t = db.get_tables_metadata().get_table_if_exists(p.id)) {
+                        e.keyspace = t->schema()->ks_name();
+                        e.table = t->schema()->cf_name();
+                    }
+                    e.table_id = fmt::to_string(p.id);
+                    e.shard = this_shard_id();
+                    e.domain = domain;
+                    e.segments = p.segments;
+                    e.exclusive_segments = p.exclusive_segments;
+                    e.bytes = p.bytes;
+                    e.oldest_data_age = p.oldest_data < now ? std::chrono::duration_cast<std::chrono::seconds>(now - p.oldest_data).count() : 0;
+                    res.push_back(std::move(e));
+                }
+            }
+            return res;
+        }, std::vector<pinned_segments>(), [](std::vector<pinned_segments> a, std::vector<pinned_segments> b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+        co_return json::json_return_type(std::move(res));
+    });
+
     ss::get_commitlog.set(r, [&db](const_req req) {
         return db.local().commitlog()->active_config().commit_log_location;
     });
@@ -82,6 +118,7 @@ void unset_commitlog(http_context& ctx, routes& r) {
     httpd::commitlog_json::get_pending_tasks.unset(r);
     httpd::commitlog_json::get_total_commit_log_size.unset(r);
     httpd::commitlog_json::get_max_disk_size.unset(r);
+    httpd::commitlog_json::get_pinned_segments.unset(r);
     ss::get_commitlog.unset(r);
 }
 
@@ -39,6 +39,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/exception.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "repair/row_level.hh"
 #include "locator/snitch_base.hh"
 #include "locator/tablets.hh"
@@ -60,6 +61,7 @@
 #include "utils/rjson.hh"
 #include "utils/user_provided_param.hh"
 #include "sstable_dict_autotrainer.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 
 using namespace seastar::httpd;
 using namespace std::chrono_literals;
@@ -1205,6 +1207,30 @@ rest_get_slow_query_info(const_req req) {
         return res;
 }
 
+static
+future<json::json_return_type>
+rest_get_tracing_ring_buffer(std::unique_ptr<http::request> req) {
+        auto per_shard = co_await tracing::trace_ring_buffer_helper::get_records_of_all_shards();
+        std::vector<ss::tracing_ring_buffer_record> res;
+        for (unsigned shard = 0; shard < per_shard.size(); ++shard) {
+            for (const auto& r : per_shard[shard]) {
+                ss::tracing_ring_buffer_record rec;
+                rec.shard = shard;
+                rec.seq = r.seq;
+                rec.session_id = fmt::to_string(r.session_id);
+                rec.kind = r.is_session ? "session" : "event";
+                rec.command = tracing::type_to_string(r.command);
+                rec.at = std::chrono::duration_cast<std::chrono::microseconds>(r.at.time_since_epoch()).count();
+                rec.elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(r.elapsed).count();
+                rec.slow_query = r.slow_query;
+                rec.message = r.message;
+                res.push_back(std::move(rec));
+            }
+            co_await coroutine::maybe_yield();
+        }
+        co_return res;
+}
+
 static
 future<json::json_return_type>
 rest_set_slow_query(std::unique_ptr<http::request> req) {
@@ -1875,6 +1901,7 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
     ss::get_trace_probability.set(r, rest_bind(rest_get_trace_probability));
     ss::get_slow_query_info.set(r, rest_bind(rest_get_slow_query_info));
     ss::set_slow_query.set(r, rest_bind(rest_set_slow_query));
+    ss::get_tracing_ring_buffer.set(r, rest_bind(rest_get_tracing_ring_buffer));
     ss::deliver_hints.set(r, rest_bind(rest_deliver_hints));
     ss::get_cluster_name.set(r, rest_bind(rest_get_cluster_name, ss));
     ss::get_partitioner_name.set(r, rest_bind(rest_get_partitioner_name, ss));
@@ -1958,6 +1985,7 @@ void unset_storage_service(http_context& ctx, routes& r) {
     ss::get_trace_probability.unset(r);
     ss::get_slow_query_info.unset(r);
     ss::set_slow_query.unset(r);
+    ss::get_tracing_ring_buffer.unset(r);
     ss::deliver_hints.unset(r);
     ss::get_cluster_name.unset(r);
     ss::get_partitioner_name.unset(r);
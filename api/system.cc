@@ -11,6 +11,9 @@
 #include "api/api-doc/metrics.json.hh"
 #include "replica/database.hh"
 #include "db/sstables-format-selector.hh"
+#include "supervisor.hh"
+#include "utils/cpu_sampler.hh"
+#include "utils/scheduling_group_stats.hh"
 
 #include <rapidjson/document.h>
 #include <boost/lexical_cast.hpp>
@@ -35,7 +38,113 @@ extern "C" void __attribute__((weak)) __llvm_profile_dump();
 extern "C" const char * __attribute__((weak)) __llvm_profile_get_filename();
 extern "C" void __attribute__((weak)) __llvm_profile_reset_counters();
 
+// The shard of the "shard" parameter, if given.
+static std::optional<shard_id> parse_shard_param(const http::request& req) {
+    auto param = req.get_query_param("shard");
+    if (param.empty()) {
+        return std::nullopt;
+    }
+    try {
+        auto shard = boost::lexical_cast<shard_id>(std::string(param));
+        if (shard < smp::count) {
+            return shard;
+        }
+    } catch (boost::bad_lexical_cast&) {
+    }
+    throw bad_param_exception(fmt::format("Invalid shard {}, there are {} shards", param, smp::count));
+}
+
+template <typename Func>
+static future<> invoke_on_shards(std::optional<shard_id> shard, Func func) {
+    if (shard) {
+        return smp::submit_to(*shard, std::move(func));
+    }
+    return smp::invoke_on_all(std::move(func));
+}
+
+static void set_cpu_sampler(routes& r) {
+    hs::start_cpu_sampler.set(r, [] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        auto shard = parse_shard_param(*req);
+        unsigned frequency = 10;
+        if (auto param = req->get_query_param("frequency"); !param.empty()) {
+            try {
+                frequency = boost::lexical_cast<unsigned>(std::string(param));
+            } catch (boost::bad_lexical_cast&) {
+                throw bad_param_exception(fmt::format("Invalid frequency {}", param));
+            }
+        }
+        if (frequency == 0 || frequency > utils::cpu_sampler::max_frequency) {
+            throw bad_param_exception(fmt::format("Frequency must be between 1 and {}", utils::cpu_sampler::max_frequency));
+        }
+        co_await invoke_on_shards(shard, [frequency] {
+            utils::get_local_cpu_sampler().start(frequency);
+        });
+        co_return json::json_void();
+    });
+
+    hs::stop_cpu_sampler.set(r, [] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        co_await invoke_on_shards(parse_shard_param(*req), [] {
+            utils::get_local_cpu_sampler().stop();
+        });
+        co_return json::json_void();
+    });
+
+    hs::get_cpu_sampler_stacks.set(r, [] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        auto shard = parse_shard_param(*req);
+        std::unordered_map<sstring, uint64_t> stacks;
+        for (auto s : std::views::iota(0u, smp::count)) {
+            if (shard && s != *shard) {
+                continue;
+            }
+            auto shard_stacks = co_await smp::submit_to(s, [] {
+                return utils::get_local_cpu_sampler().collapsed_stacks();
+            });
+            for (auto& [stack, count] : shard_stacks) {
+                stacks[stack] += count;
+            }
+        }
+        co_return json::json_return_type(json::stream_range_as_array(std::move(stacks), [] (const auto& e) {
+            return fmt::format("{} {}", e.first, e.second);
+        }));
+    });
+}
+
+static void set_scheduling_group_stats(routes& r) {
+    hs::get_scheduling_group_stats.set(r, [] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        auto shard = parse_shard_param(*req);
+        std::vector<hs::scheduling_group_stats> res;
+        for (auto s : std::views::iota(0u, smp::count)) {
+            if (shard && s != *shard) {
+                continue;
+            }
+            auto stats = co_await smp::submit_to(s, [] {
+                return utils::get_local_scheduling_group_stats();
+            });
+            for (const auto& st : stats) {
+                hs::scheduling_group_stats e;
+                e.shard = s;
+                e.group = st.group;
+                e.shares = st.shares;
+                e.runtime_ms = st.runtime_ms;
+                e.waittime_ms = st.waittime_ms;
+                e.starvetime_ms = st.starvetime_ms;
+                e.tasks_processed = st.tasks_processed;
+                e.queue_length = st.queue_length;
+                e.io_operations = st.io_operations;
+                e.io_bytes = st.io_bytes;
+                e.io_queue_delay_us = st.io_queue_delay_us;
+                e.io_exec_us = st.io_exec_us;
+                res.push_back(std::move(e));
+            }
+        }
+        co_return json::json_return_type(std::move(res));
+    });
+}
+
 void set_system(http_context& ctx, routes& r) {
+    set_cpu_sampler(r);
+    set_scheduling_group_stats(r);
+
     hm::get_metrics_config.set(r, [](const_req req) {
         std::vector<hm::metrics_config> res;
         res.resize(seastar::metrics::get_relabel_configs().size());
@@ -108,6 +217,20 @@ void set_system(http_context& ctx, routes& r) {
         return std::chrono::duration_cast<std::chrono::milliseconds>(engine().uptime()).count();
     });
 
+    hs::get_startup_phases.set(r, [] (std::unique_ptr<request> req) {
+        return smp::submit_to(0, [] {
+            std::vector<hs::startup_phase> res;
+            for (auto& p : supervisor::startup_phases()) {
+                hs::startup_phase phase;
+                phase.name = p.name;
+                phase.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(p.duration).count();
+                phase.completed = p.completed;
+                res.push_back(std::move(phase));
+            }
+            return make_ready_future<json::json_return_type>(std::move(res));
+        });
+    });
+
     hs::get_all_logger_names.set(r, [](const_req req) {
         return logging::logger_registry().get_all_logger_names();
     });
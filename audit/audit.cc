@@ -6,13 +6,16 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
  */
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include "audit/audit.hh"
 #include "db/config.hh"
 #include "cql3/cql_statement.hh"
 #include "cql3/statements/batch_statement.hh"
+#include "cql3/statements/schema_batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
 #include "storage_helper.hh"
+#include "audit_queue.hh"
 #include "audit.hh"
 #include "../db/config.hh"
 #include "utils/class_registrator.hh"
@@ -190,11 +193,22 @@ future<> audit::start(const db::config& cfg, cql3::query_processor& qp, service:
     } catch (...) {
         throw;
     }
-    return _storage_helper_ptr->start(cfg);
+    co_await _storage_helper_ptr->start(cfg);
+    if (cfg.audit_flush_interval_in_ms()) {
+        _queue = std::make_unique<audit_queue>(*_storage_helper_ptr, audit_queue::config{
+            .flush_interval = std::chrono::milliseconds(cfg.audit_flush_interval_in_ms()),
+            .max_records = cfg.audit_queue_max_records(),
+            .policy = audit_queue::parse_full_policy(cfg.audit_queue_full_policy()),
+        });
+        _queue->start();
+    }
 }
 
 future<> audit::stop() {
-    return _storage_helper_ptr->stop();
+    if (_queue) {
+        co_await _queue->stop();
+    }
+    co_await _storage_helper_ptr->stop();
 }
 
 future<> audit::shutdown() {
@@ -214,6 +228,17 @@ future<> audit::log(const audit_info* audit_info, service::query_state& query_st
             node_ip, audit_info->category_string(), cl, error, audit_info->keyspace(),
             audit_info->query(), client_ip, audit_info->table(), username);
     }
+    if (_queue) {
+        return push(audit_record{
+            .info = *audit_info,
+            .node_ip = node_ip,
+            .client_ip = client_ip,
+            .cl = cl,
+            .username = username,
+            .error = error,
+            .time = std::chrono::system_clock::now(),
+        });
+    }
     return futurize_invoke(std::mem_fn(&storage_helper::write), _storage_helper_ptr, audit_info, node_ip, client_ip, cl, username, error)
         .handle_exception([audit_info, node_ip, client_ip, cl, username, error] (auto ep) {
             logger.error("Unexpected exception when writing log with: node_ip {} category {} cl {} error {} keyspace {} query '{}' client_ip {} table {} username {} exception {}",
@@ -228,6 +253,17 @@ future<> audit::log_login(const sstring& username, socket_address client_ip, boo
         logger.debug("Login log written: node_ip {}, client_ip {}, username {}, error {}",
             node_ip, client_ip, username, error ? "true" : "false");
     }
+    if (_queue) {
+        return push(audit_record{
+            .info = std::nullopt,
+            .node_ip = node_ip,
+            .client_ip = client_ip,
+            .cl = db::consistency_level::ANY,
+            .username = username,
+            .error = error,
+            .time = std::chrono::system_clock::now(),
+        });
+    }
     return futurize_invoke(std::mem_fn(&storage_helper::write_login), _storage_helper_ptr, username, node_ip, client_ip, error)
         .handle_exception([username, node_ip, client_ip, error] (auto ep) {
             logger.error("Unexpected exception when writing login log with: node_ip {} client_ip {} username {} error {} exception {}",
@@ -235,12 +271,22 @@ future<> audit::log_login(const sstring& username, socket_address client_ip, boo
     });
 }
 
+future<> audit::push(audit_record record) noexcept {
+    return futurize_invoke([this, &record] { return _queue->push(std::move(record)); }).handle_exception([] (auto ep) {
+        logger.error("Unexpected exception when queueing audit record: {}", ep);
+    });
+}
+
 future<> inspect(shared_ptr<cql3::cql_statement> statement, service::query_state& query_state, const cql3::query_options& options, bool error) {
     cql3::statements::batch_statement* batch = dynamic_cast<cql3::statements::batch_statement*>(statement.get());
     if (batch != nullptr) {
         return do_for_each(batch->statements().begin(), batch->statements().end(), [&query_state, &options, error] (auto&& m) {
             return inspect(m.statement, query_state, options, error);
         });
+    } else if (auto schema_batch = dynamic_cast<cql3::statements::schema_batch_statement*>(statement.get())) {
+        return do_for_each(schema_batch->statements().begin(), schema_batch->statements().end(), [&query_state, &options, error] (auto&& s) {
+            return inspect(s, query_state, options, error);
+        });
     } else {
         auto audit_info = statement->get_audit_info();
         if (bool(audit_info) && audit::local_audit_instance().should_log(audit_info)) {
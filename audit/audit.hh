@@ -94,6 +94,8 @@ class audit_info final {
 using audit_info_ptr = std::unique_ptr<audit_info>;
 
 class storage_helper;
+class audit_queue;
+struct audit_record;
 
 class audit final : public seastar::async_sharded_service<audit> {
     locator::shared_token_metadata& _token_metadata;
@@ -104,6 +106,8 @@ class audit final : public seastar::async_sharded_service<audit> {
 
     sstring _storage_helper_class_name;
     std::unique_ptr<storage_helper> _storage_helper_ptr;
+    // Set when the records are written in the background, see audit_flush_interval_in_ms.
+    std::unique_ptr<audit_queue> _queue;
 
     const db::config& _cfg;
     utils::observer<sstring> _cfg_keyspaces_observer;
@@ -114,6 +118,7 @@ class audit final : public seastar::async_sharded_service<audit> {
     void update_config(const sstring & new_value, std::function<T(const sstring&)> parse_func, T& cfg_parameter);
 
     bool should_log_table(const sstring& keyspace, const sstring& name) const;
+    future<> push(audit_record record) noexcept;
 public:
     static seastar::sharded<audit>& audit_instance() {
         // FIXME: leaked intentionally to avoid shutdown problems, see #293
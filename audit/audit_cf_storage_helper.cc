@@ -8,6 +8,8 @@
 
 #include "audit/audit_cf_storage_helper.hh"
 
+#include <seastar/core/loop.hh>
+
 #include "cql3/query_processor.hh"
 #include "data_dictionary/keyspace_metadata.hh"
 #include "utils/UUID_gen.hh"
@@ -22,6 +24,9 @@ namespace audit {
 const sstring audit_cf_storage_helper::KEYSPACE_NAME("audit");
 const sstring audit_cf_storage_helper::TABLE_NAME("audit_log");
 
+// Bounds the inserts of a batch of records in flight at once.
+static constexpr size_t max_concurrent_batch_writes = 16;
+
 audit_cf_storage_helper::audit_cf_storage_helper(cql3::query_processor& qp, service::migration_manager& mm)
     : _qp(qp)
     , _mm(mm)
@@ -131,23 +136,32 @@ future<> audit_cf_storage_helper::write(const audit_info* audit_info,
                                     db::consistency_level cl,
                                     const sstring& username,
                                     bool error) {
-    return _table.insert(_qp, _mm, _dummy_query_state, make_data, audit_info, node_ip, client_ip, cl, username, error);
+    return _table.insert(_qp, _mm, _dummy_query_state, make_data, std::chrono::system_clock::now(), audit_info, node_ip, client_ip, cl, username, error);
 }
 
 future<> audit_cf_storage_helper::write_login(const sstring& username,
                                               socket_address node_ip,
                                               socket_address client_ip,
                                               bool error) {
-    return _table.insert(_qp, _mm, _dummy_query_state, make_login_data, node_ip, client_ip, username, error);
+    return _table.insert(_qp, _mm, _dummy_query_state, make_login_data, std::chrono::system_clock::now(), node_ip, client_ip, username, error);
+}
+
+future<> audit_cf_storage_helper::write_batch(std::span<const audit_record> records) {
+    return max_concurrent_for_each(records, max_concurrent_batch_writes, [this] (const audit_record& r) {
+        if (r.info) {
+            return _table.insert(_qp, _mm, _dummy_query_state, make_data, r.time, &*r.info, r.node_ip, r.client_ip, r.cl, r.username, r.error);
+        }
+        return _table.insert(_qp, _mm, _dummy_query_state, make_login_data, r.time, r.node_ip, r.client_ip, r.username, r.error);
+    });
 }
 
-cql3::query_options audit_cf_storage_helper::make_data(const audit_info* audit_info,
+cql3::query_options audit_cf_storage_helper::make_data(std::chrono::system_clock::time_point time,
+                                                       const audit_info* audit_info,
                                                        socket_address node_ip,
                                                        socket_address client_ip,
                                                        db::consistency_level cl,
                                                        const sstring& username,
                                                        bool error) {
-    auto time = std::chrono::system_clock::now();
     auto millis_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
     auto ticks_per_day = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::hours(24)).count();
     auto date = millis_since_epoch / ticks_per_day * ticks_per_day;
@@ -170,11 +184,11 @@ cql3::query_options audit_cf_storage_helper::make_data(const audit_info* audit_i
     return cql3::query_options(cql3::default_cql_config, db::consistency_level::ONE, std::nullopt, std::move(values), false, cql3::query_options::specific_options::DEFAULT);
 }
 
-cql3::query_options audit_cf_storage_helper::make_login_data(socket_address node_ip,
+cql3::query_options audit_cf_storage_helper::make_login_data(std::chrono::system_clock::time_point time,
+                                                             socket_address node_ip,
                                                              socket_address client_ip,
                                                              const sstring& username,
                                                              bool error) {
-    auto time = std::chrono::system_clock::now();
     auto millis_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
     auto ticks_per_day = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::hours(24)).count();
     auto date = millis_since_epoch / ticks_per_day * ticks_per_day;
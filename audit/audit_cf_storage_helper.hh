@@ -34,13 +34,15 @@ class audit_cf_storage_helper : public storage_helper {
     service::migration_manager& _mm;
     table_helper _table;
     service::query_state _dummy_query_state;
-    static cql3::query_options make_data(const audit_info* audit_info,
+    static cql3::query_options make_data(std::chrono::system_clock::time_point time,
+                                         const audit_info* audit_info,
                                          socket_address node_ip,
                                          socket_address client_ip,
                                          db::consistency_level cl,
                                          const sstring& username,
                                          bool error);
-    static cql3::query_options make_login_data(socket_address node_ip,
+    static cql3::query_options make_login_data(std::chrono::system_clock::time_point time,
+                                               socket_address node_ip,
                                                socket_address client_ip,
                                                const sstring& username,
                                                bool error);
@@ -62,6 +64,7 @@ class audit_cf_storage_helper : public storage_helper {
                                  socket_address node_ip,
                                  socket_address client_ip,
                                  bool error) override;
+    virtual future<> write_batch(std::span<const audit_record> records) override;
 };
 
 }
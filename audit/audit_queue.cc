@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "audit/audit_queue.hh"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+
+namespace audit {
+
+audit_queue::audit_queue(storage_helper& helper, config cfg)
+    : _helper(helper)
+    , _cfg(cfg)
+    , _flush_threshold(std::max<size_t>(cfg.max_records / 2, 1))
+    , _capacity(std::max<size_t>(cfg.max_records, 1))
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("audit", {
+        sm::make_gauge("queue_length", [this] { return size(); },
+                sm::description("Number of audit records queued or being written.")),
+        sm::make_gauge("queue_lag_ms", [this] { return lag().count(); },
+                sm::description("Age in milliseconds of the oldest audit record which is not written yet.")),
+        sm::make_counter("records_written", _stats.written,
+                sm::description("Number of queued audit records which were written.")),
+        sm::make_counter("records_dropped", _stats.dropped,
+                sm::description("Number of audit records dropped because the audit queue was full.")),
+        sm::make_counter("records_failed", _stats.failed,
+                sm::description("Number of queued audit records which failed to be written.")),
+    });
+}
+
+audit_queue::full_policy audit_queue::parse_full_policy(std::string_view policy) {
+    if (policy == "block") {
+        return full_policy::block;
+    } else if (policy == "drop") {
+        return full_policy::drop;
+    }
+    throw audit_exception(fmt::format("Bad configuration: invalid 'audit_queue_full_policy': {}", policy));
+}
+
+void audit_queue::start() {
+    _flusher = flush_loop();
+}
+
+future<> audit_queue::stop() {
+    _stopping = true;
+    // Requests waiting for room would otherwise wait for the flushes, and
+    // queue records which are never written.
+    _capacity.broken();
+    _flush_cv.signal();
+    if (_flusher) {
+        co_await std::exchange(_flusher, std::nullopt).value();
+    }
+}
+
+future<> audit_queue::push(audit_record record) {
+    if (_stopping) {
+        ++_stats.dropped;
+        co_return;
+    }
+    if (_cfg.policy == full_policy::drop) {
+        if (!_capacity.try_wait(1)) {
+            ++_stats.dropped;
+            co_return;
+        }
+    } else {
+        try {
+            co_await _capacity.wait(1);
+        } catch (const seastar::broken_semaphore&) {
+            // The queue is stopping.
+            ++_stats.dropped;
+            co_return;
+        }
+    }
+    _records.push_back(std::move(record));
+    ++_stats.queued;
+    if (_records.size() >= _flush_threshold) {
+        _flush_cv.signal();
+    }
+}
+
+std::chrono::milliseconds audit_queue::lag() const noexcept {
+    const auto& oldest = _in_flight.empty() ? _records : _in_flight;
+    if (oldest.empty()) {
+        return std::chrono::milliseconds(0);
+    }
+    auto lag = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - oldest.front().time);
+    return std::max(lag, std::chrono::milliseconds(0));
+}
+
+future<> audit_queue::flush() {
+    if (_records.empty()) {
+        co_return;
+    }
+    _in_flight = std::exchange(_records, {});
+    auto n = _in_flight.size();
+    try {
+        co_await _helper.write_batch(_in_flight);
+        _stats.written += n;
+    } catch (...) {
+        _stats.failed += n;
+        logger.error("Failed to write a batch of {} audit records: {}", n, std::current_exception());
+    }
+    _in_flight.clear();
+    _capacity.signal(n);
+}
+
+future<> audit_queue::flush_loop() {
+    while (!_stopping) {
+        try {
+            co_await _flush_cv.wait(_cfg.flush_interval, [this] {
+                return _stopping || _records.size() >= _flush_threshold;
+            });
+        } catch (const seastar::condition_variable_timed_out&) {
+        }
+        co_await flush();
+    }
+    // Records queued while the last flush was in progress.
+    co_await flush();
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/semaphore.hh>
+
+#include "audit/storage_helper.hh"
+
+namespace audit {
+
+/// Buffers the audit records of a shard and writes them to the storage
+/// helper in batches, in the background.
+///
+/// Audited requests only wait for their record to be queued. The queue is
+/// flushed every flush interval, or sooner when it is half full. Once the
+/// queue is full, depending on the policy, requests either wait for the
+/// records ahead of them to be written, or their records are dropped.
+class audit_queue {
+public:
+    enum class full_policy {
+        block,
+        drop,
+    };
+
+    struct config {
+        std::chrono::milliseconds flush_interval;
+        size_t max_records;
+        full_policy policy;
+    };
+
+    struct stats {
+        uint64_t queued = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        uint64_t failed = 0;
+    };
+private:
+    storage_helper& _helper;
+    config _cfg;
+    size_t _flush_threshold;
+    std::vector<audit_record> _records;
+    // The batch being written.
+    std::vector<audit_record> _in_flight;
+    // Units are the records which can still be queued. Released once the
+    // records are written.
+    seastar::semaphore _capacity;
+    seastar::condition_variable _flush_cv;
+    bool _stopping = false;
+    std::optional<future<>> _flusher;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    future<> flush_loop();
+    future<> flush();
+public:
+    audit_queue(storage_helper& helper, config cfg);
+    audit_queue(audit_queue&&) = delete;
+
+    static full_policy parse_full_policy(std::string_view policy);
+
+    void start();
+    // Writes the queued records, then stops the flushes. Records pushed
+    // from now on, including those waiting for room, are dropped.
+    future<> stop();
+
+    // Resolves once the record is queued, not written.
+    future<> push(audit_record record);
+
+    size_t size() const noexcept {
+        return _records.size() + _in_flight.size();
+    }
+
+    // Age of the oldest record which is not written yet.
+    std::chrono::milliseconds lag() const noexcept;
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+}
@@ -99,48 +99,83 @@ future<> audit_syslog_storage_helper::stop() {
     co_return;
 }
 
+static sstring make_message(std::chrono::system_clock::time_point tp,
+                            const audit_info* audit_info,
+                            socket_address node_ip,
+                            socket_address client_ip,
+                            db::consistency_level cl,
+                            const sstring& username,
+                            bool error) {
+    auto now = std::chrono::system_clock::to_time_t(tp);
+    tm time;
+    localtime_r(&now, &time);
+    return seastar::format(R"(<{}>{:%h %e %T} scylla-audit: node="{}", category="{}", cl="{}", error="{}", keyspace="{}", query="{}", client_ip="{}", table="{}", username="{}")",
+                            LOG_NOTICE | LOG_USER,
+                            time,
+                            node_ip,
+                            audit_info->category_string(),
+                            cl,
+                            (error ? "true" : "false"),
+                            audit_info->keyspace(),
+                            json_escape(audit_info->query()),
+                            client_ip,
+                            audit_info->table(),
+                            username);
+}
+
+static sstring make_login_message(std::chrono::system_clock::time_point tp,
+                                  const sstring& username,
+                                  socket_address node_ip,
+                                  socket_address client_ip,
+                                  bool error) {
+    auto now = std::chrono::system_clock::to_time_t(tp);
+    tm time;
+    localtime_r(&now, &time);
+    return seastar::format(R"(<{}>{:%h %e %T} scylla-audit: node="{}", category="AUTH", cl="", error="{}", keyspace="", query="", client_ip="{}", table="", username="{}")",
+                            LOG_NOTICE | LOG_USER,
+                            time,
+                            node_ip,
+                            (error ? "true" : "false"),
+                            client_ip,
+                            username);
+}
+
 future<> audit_syslog_storage_helper::write(const audit_info* audit_info,
                                             socket_address node_ip,
                                             socket_address client_ip,
                                             db::consistency_level cl,
                                             const sstring& username,
                                             bool error) {
-    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    tm time;
-    localtime_r(&now, &time);
-    sstring msg = seastar::format(R"(<{}>{:%h %e %T} scylla-audit: node="{}", category="{}", cl="{}", error="{}", keyspace="{}", query="{}", client_ip="{}", table="{}", username="{}")",
-                                    LOG_NOTICE | LOG_USER,
-                                    time,
-                                    node_ip,
-                                    audit_info->category_string(),
-                                    cl,
-                                    (error ? "true" : "false"),
-                                    audit_info->keyspace(),
-                                    json_escape(audit_info->query()),
-                                    client_ip,
-                                    audit_info->table(),
-                                    username);
-
-    co_await syslog_send_helper(msg);
+    co_await syslog_send_helper(make_message(std::chrono::system_clock::now(), audit_info, node_ip, client_ip, cl, username, error));
 }
 
 future<> audit_syslog_storage_helper::write_login(const sstring& username,
                                                   socket_address node_ip,
                                                   socket_address client_ip,
                                                   bool error) {
+    co_await syslog_send_helper(make_login_message(std::chrono::system_clock::now(), username, node_ip, client_ip, error));
+}
 
-    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    tm time;
-    localtime_r(&now, &time);
-    sstring msg = seastar::format(R"(<{}>{:%h %e %T} scylla-audit: node="{}", category="AUTH", cl="", error="{}", keyspace="", query="", client_ip="{}", table="", username="{}")",
-                                    LOG_NOTICE | LOG_USER,
-                                    time,
-                                    node_ip,
-                                    (error ? "true" : "false"),
-                                    client_ip,
-                                    username);
-
-    co_await syslog_send_helper(msg.c_str());
+future<> audit_syslog_storage_helper::write_batch(std::span<const audit_record> records) {
+    // Takes the lock once for the whole batch rather than once per message.
+    try {
+        auto lock = co_await get_units(_semaphore, 1, std::chrono::hours(1));
+        for (const auto& r : records) {
+            auto msg = r.info
+                    ? make_message(r.time, &*r.info, r.node_ip, r.client_ip, r.cl, r.username, r.error)
+                    : make_login_message(r.time, r.username, r.node_ip, r.client_ip, r.error);
+            co_await _sender.send(_syslog_address, net::packet{msg.data(), msg.size()});
+        }
+    } catch (const std::exception& e) {
+        auto error_msg = seastar::format(
+            "Syslog audit backend failed (sending a batch of {} messages to {} resulted in {}).",
+            records.size(),
+            _syslog_address,
+            e
+        );
+        logger.error("{}", error_msg);
+        throw audit_exception(std::move(error_msg));
+    }
 }
 
 using registry = class_registrator<storage_helper, audit_syslog_storage_helper, cql3::query_processor&, service::migration_manager&>;
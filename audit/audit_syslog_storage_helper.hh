@@ -42,6 +42,7 @@ class audit_syslog_storage_helper : public storage_helper {
                                  socket_address node_ip,
                                  socket_address client_ip,
                                  bool error) override;
+    virtual future<> write_batch(std::span<const audit_record> records) override;
 };
 
 }
@@ -10,8 +10,26 @@
 #include "audit/audit.hh"
 #include <seastar/core/future.hh>
 
+#include <chrono>
+#include <optional>
+#include <span>
+
 namespace audit {
 
+// A copy of what an audit write needs, for records written after the
+// request which produced them completed, see audit_queue.
+struct audit_record {
+    // Disengaged for logins.
+    std::optional<audit_info> info;
+    socket_address node_ip;
+    socket_address client_ip;
+    db::consistency_level cl;
+    sstring username;
+    bool error;
+    // When the audited event happened.
+    std::chrono::system_clock::time_point time;
+};
+
 class storage_helper {
 public:
     using ptr_type = std::unique_ptr<storage_helper>;
@@ -29,6 +47,8 @@ class storage_helper {
                                  socket_address node_ip,
                                  socket_address client_ip,
                                  bool error) = 0;
+    // Writes the records, possibly concurrently.
+    virtual future<> write_batch(std::span<const audit_record> records) = 0;
 };
 
 }
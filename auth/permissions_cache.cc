@@ -15,17 +15,24 @@
 namespace auth {
 
 permissions_cache::permissions_cache(const utils::loading_cache_config& c, service& ser, logging::logger& log)
-        : _cache(c, log, [&ser, &log](const key_type& k) {
+        : _cache(c, log, [this, &ser, &log](const key_type& k) {
               log.debug("Refreshing permissions for {}", k.first);
-              return ser.get_uncached_permissions(k.first, k.second);
+              // Bumped on both ends, so that a value read from the cache while it is being loaded
+              // isn't taken for the new one.
+              ++_epoch;
+              return ser.get_uncached_permissions(k.first, k.second).finally([this] {
+                  ++_epoch;
+              });
           }) {
 }
 
 bool permissions_cache::update_config(utils::loading_cache_config c) {
+    ++_epoch;
     return _cache.update_config(std::move(c));
 }
 
 void permissions_cache::reset() {
+    ++_epoch;
     _cache.reset();
 }
 
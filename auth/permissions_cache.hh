@@ -50,6 +50,8 @@ class permissions_cache final {
     using key_type = typename cache_type::key_type;
 
     cache_type _cache;
+    // Bumped whenever a cached value may change, see epoch().
+    uint64_t _epoch = 0;
 
 public:
     explicit permissions_cache(const utils::loading_cache_config&, service&, logging::logger&);
@@ -61,6 +63,15 @@ class permissions_cache final {
     bool update_config(utils::loading_cache_config);
     void reset();
     future<permission_set> get(const role_or_anonymous&, const resource&);
+
+    ///
+    /// Changes whenever permissions returned by \ref get may have changed: when permissions are loaded into or
+    /// reloaded in the cache, and when the cache is reset or reconfigured. Permissions obtained while the epoch
+    /// stayed the same are as fresh as the cached ones.
+    ///
+    uint64_t epoch() const noexcept {
+        return _epoch;
+    }
 };
 
 }
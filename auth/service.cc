@@ -317,6 +317,10 @@ future<permission_set> service::get_permissions(const role_or_anonymous& maybe_r
     return _permissions_cache->get(maybe_role, r);
 }
 
+uint64_t service::permissions_epoch() const noexcept {
+    return _permissions_cache->epoch();
+}
+
 future<bool> service::has_superuser(std::string_view role_name, const role_set& roles) const {
     for (const auto& role : roles) {
         if (co_await _role_manager->is_superuser(role)) {
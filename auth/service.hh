@@ -145,6 +145,12 @@ class service final : public seastar::peering_sharded_service<service> {
     ///
     future<permission_set> get_permissions(const role_or_anonymous&, const resource&) const;
 
+    ///
+    /// Changes whenever the permissions returned by \ref get_permissions may have changed. Callers which keep
+    /// the returned permissions around can keep using them as long as the epoch stays the same.
+    ///
+    uint64_t permissions_epoch() const noexcept;
+
     ///
     /// Like \ref get_permissions, but never returns cached permissions.
     ///
@@ -123,7 +123,28 @@ class flush_controller : public backlog_controller {
     {}
 };
 
+// compaction CPU controller.
+//
+// The shares follow the compaction backlog, and can additionally be cut when reads get slow, see
+// set_read_latency_feedback().
 class compaction_controller : public backlog_controller {
+public:
+    // Returns the read latency measured since the last call, or zero if there were no reads.
+    using read_latency_source = std::function<std::chrono::microseconds()>;
+    using read_latency_target = std::function<std::chrono::microseconds()>;
+private:
+    // The shares are cut and restored gradually, so the controller doesn't oscillate when the
+    // latency hovers around the target.
+    static constexpr float throttle_decrease = 0.75;
+    static constexpr float throttle_increase = 1.1;
+    static constexpr float min_throttle = 0.1;
+
+    read_latency_source _read_latency;
+    read_latency_target _read_latency_target;
+    // Fraction of the shares given by the backlog which compaction gets.
+    float _throttle = 1.0;
+protected:
+    virtual void update_controller(float shares) override;
 public:
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
@@ -135,4 +156,17 @@ class compaction_controller : public backlog_controller {
           static_shares
         )
     {}
+
+    // Cuts the shares while the read latency exceeds the target, and lets them go back up as it
+    // recovers. The shares are never cut below the ones of an empty backlog, and not at all when
+    // the backlog is at its maximum, so reads can slow down compaction but can't make the backlog
+    // grow unbounded. A zero target disables the feedback.
+    void set_read_latency_feedback(read_latency_source latency, read_latency_target target) {
+        _read_latency = std::move(latency);
+        _read_latency_target = std::move(target);
+    }
+
+    float read_latency_throttle() const noexcept {
+        return _throttle;
+    }
 };
@@ -1683,7 +1683,6 @@ class transformer final : public change_processor {
 
         query::column_id_vector static_columns, regular_columns;
 
-        // TODO: this assumes all mutations touch the same set of columns. This might not be true, and we may need to do more horrible set operation here.
         if (!p.static_row().empty()) {
             // for postimage we need everything...
             if (_schema->cdc_options().postimage() || _schema->cdc_options().full_preimage()) {
@@ -1710,11 +1709,21 @@ class transformer final : public change_processor {
                     columns.emplace_back(&c);
                 }
             } else {
-                p.clustered_rows().begin()->row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
-                    const auto& cdef =_schema->column_at(column_kind::regular_column, id);
-                    regular_columns.emplace_back(id);
-                    columns.emplace_back(&cdef);
-                });
+                // All the rows of the partition are read with a single query,
+                // so it has to select the union of the columns touched by
+                // each of them, and not just those of the first row.
+                std::vector<bool> touched(_schema->regular_columns_count());
+                for (const rows_entry& re : p.clustered_rows()) {
+                    re.row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+                        touched[id] = true;
+                    });
+                }
+                for (column_id id = 0; id < touched.size(); ++id) {
+                    if (touched[id]) {
+                        regular_columns.emplace_back(id);
+                        columns.emplace_back(&_schema->column_at(column_kind::regular_column, id));
+                    }
+                }
             }
         }
         
@@ -1847,9 +1856,8 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
             if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
-                // Note: further improvement here would be to coalesce the pre-image selects into one
-                // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
-                // so this is premature.
+                // Batches are already merged per partition (see batch_statement::get_mutations()),
+                // so this is a single read for all the rows the batch modifies in this partition.
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
                 f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
@@ -46,6 +46,10 @@ struct client_data {
     std::optional<sstring> ssl_protocol;
     std::optional<sstring> username;
     std::optional<sstring> scheduling_group_name;
+    std::optional<int64_t> frames_read;
+    std::optional<int64_t> frames_written;
+    std::optional<int64_t> socket_reads;
+    std::optional<int64_t> socket_writes;
 
     sstring stage_str() const { return to_string(connection_stage); }
     sstring client_type_str() const { return to_string(ct); }
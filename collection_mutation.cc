@@ -12,7 +12,6 @@
 #include "concrete_types.hh"
 #include "mutation/mutation_partition.hh"
 #include "compaction/compaction_garbage_collector.hh"
-#include "combine.hh"
 
 #include "collection_mutation.hh"
 
@@ -272,66 +271,157 @@ collection_mutation collection_mutation_view_description::serialize(const abstra
     return serialize_collection_mutation(type, tomb, std::ranges::subrange(cells.begin(), cells.end()));
 }
 
-template <typename C>
-requires std::is_base_of_v<abstract_type, std::remove_reference_t<C>>
-static collection_mutation_view_description
-merge(collection_mutation_view_description a, collection_mutation_view_description b, C&& key_type) {
-    using element_type = std::pair<bytes_view, atomic_cell_view>;
+namespace {
+
+// Observes the cells of a serialized collection_mutation in place, one at a
+// time, without linearizing or copying them.
+class serialized_collection_cells {
+    managed_bytes_view _in;
+    uint32_t _remaining;
+    managed_bytes_view _key;
+    managed_bytes_view _value;
+public:
+    // Reads the header of the serialized mutation and positions on its first cell.
+    serialized_collection_cells(managed_bytes_view in, tombstone& tomb) : _in(in) {
+        auto has_tomb = read_simple<uint8_t>(_in);
+        if (has_tomb) {
+            auto ts = read_simple<api::timestamp_type>(_in);
+            auto deletion_time = read_simple<gc_clock::duration::rep>(_in);
+            tomb = tombstone{ts, gc_clock::time_point(gc_clock::duration(deletion_time))};
+        }
+        _remaining = read_simple<uint32_t>(_in);
+        load();
+    }
 
-    auto compare = [&] (const element_type& e1, const element_type& e2) {
-        return key_type.less(e1.first, e2.first);
-    };
+    bool at_end() const {
+        return _remaining == 0;
+    }
+
+    // Valid when !at_end()
+    managed_bytes_view key() const { return _key; }
+    managed_bytes_view value() const { return _value; }
 
-    auto merge = [] (const element_type& e1, const element_type& e2) {
-        // FIXME: use std::max()?
-        return std::make_pair(e1.first, compare_atomic_cell_for_merge(e1.second, e2.second) > 0 ? e1.second : e2.second);
+    void next() {
+        --_remaining;
+        load();
+    }
+private:
+    void load() {
+        if (_remaining) {
+            _key = read_simple_bytes(_in, read_simple<uint32_t>(_in));
+            _value = read_simple_bytes(_in, read_simple<uint32_t>(_in));
+        }
+    }
+};
+
+}
+
+// Calls emit(key, value) for each cell of the merge of the serialized
+// mutations a and b, in key order.
+//
+// Works on the serialized cells directly, so that merging large collections
+// (e.g. a memtable entry with a new element appended) doesn't build a
+// description of each of them.
+template <typename ValueTypeOf, typename Emit>
+requires std::is_invocable_r_v<const abstract_type&, ValueTypeOf, managed_bytes_view>
+    && std::is_invocable_v<Emit, managed_bytes_view, managed_bytes_view>
+static void merge_serialized_cells(const abstract_type& key_type, ValueTypeOf value_type_of,
+        serialized_collection_cells a, tombstone a_tomb, serialized_collection_cells b, tombstone b_tomb, Emit emit) {
+    auto cell = [&] (const serialized_collection_cells& c) {
+        return atomic_cell_view::from_bytes(value_type_of(c.key()), c.value());
     };
 
-    // applied to a tombstone, returns a predicate checking whether a cell is killed by
-    // the tombstone
-    auto cell_killed = [] (const std::optional<tombstone>& t) {
-        return [&t] (const element_type& e) {
-            if (!t) {
-                return false;
-            }
-            // tombstone wins if timestamps equal here, unlike row tombstones
-            if (t->timestamp < e.second.timestamp()) {
-                return false;
-            }
-            return true;
-            // FIXME: should we consider TTLs too?
-        };
+    // Tombstone wins if timestamps equal here, unlike row tombstones
+    // FIXME: should we consider TTLs too?
+    auto skip_killed = [&] (serialized_collection_cells& c, tombstone t) {
+        while (t && !c.at_end() && t.timestamp >= cell(c).timestamp()) {
+            c.next();
+        }
     };
 
-    collection_mutation_view_description merged;
-    merged.cells.reserve(a.cells.size() + b.cells.size());
+    while (true) {
+        skip_killed(a, b_tomb);
+        skip_killed(b, a_tomb);
+        if (a.at_end() || b.at_end()) {
+            break;
+        }
+        auto cmp = key_type.compare(a.key(), b.key());
+        if (cmp < 0) {
+            emit(a.key(), a.value());
+            a.next();
+        } else if (cmp > 0) {
+            emit(b.key(), b.value());
+            b.next();
+        } else {
+            emit(a.key(), compare_atomic_cell_for_merge(cell(a), cell(b)) > 0 ? a.value() : b.value());
+            a.next();
+            b.next();
+        }
+    }
+    // Cells are ordered by key, not by timestamp, so a killed cell may
+    // follow a live one.
+    for (skip_killed(a, b_tomb); !a.at_end(); a.next(), skip_killed(a, b_tomb)) {
+        emit(a.key(), a.value());
+    }
+    for (skip_killed(b, a_tomb); !b.at_end(); b.next(), skip_killed(b, a_tomb)) {
+        emit(b.key(), b.value());
+    }
+}
 
-    combine(a.cells.begin(), std::remove_if(a.cells.begin(), a.cells.end(), cell_killed(b.tomb)),
-            b.cells.begin(), std::remove_if(b.cells.begin(), b.cells.end(), cell_killed(a.tomb)),
-            std::back_inserter(merged.cells),
-            compare,
-            merge);
-    merged.tomb = std::max(a.tomb, b.tomb);
+template <typename ValueTypeOf>
+static collection_mutation merge_serialized(const abstract_type& type, const abstract_type& key_type, ValueTypeOf value_type_of,
+        collection_mutation_view a, collection_mutation_view b) {
+    tombstone a_tomb;
+    tombstone b_tomb;
+    serialized_collection_cells a_cells(a.data, a_tomb);
+    serialized_collection_cells b_cells(b.data, b_tomb);
+    auto tomb = std::max(a_tomb, b_tomb);
+
+    // The first pass sizes the result, the second one writes it.
+    size_t size = 1 + 4;
+    if (tomb) {
+        size += sizeof(int64_t) + sizeof(int64_t);
+    }
+    uint32_t nr = 0;
+    merge_serialized_cells(key_type, value_type_of, a_cells, a_tomb, b_cells, b_tomb, [&] (managed_bytes_view key, managed_bytes_view value) {
+        size += 8 + key.size() + value.size();
+        ++nr;
+    });
 
-    return merged;
+    managed_bytes ret(managed_bytes::initialized_later(), size);
+    managed_bytes_mutable_view out(ret);
+    write<uint8_t>(out, uint8_t(bool(tomb)));
+    if (tomb) {
+        write<int64_t>(out, tomb.timestamp);
+        write<int64_t>(out, tomb.deletion_time.time_since_epoch().count());
+    }
+    write<int32_t>(out, nr);
+    merge_serialized_cells(key_type, value_type_of, a_cells, a_tomb, b_cells, b_tomb, [&] (managed_bytes_view key, managed_bytes_view value) {
+        write<int32_t>(out, key.size());
+        write_fragmented(out, key);
+        write<int32_t>(out, value.size());
+        write_fragmented(out, value);
+    });
+    return collection_mutation(type, std::move(ret));
 }
 
 collection_mutation merge(const abstract_type& type, collection_mutation_view a, collection_mutation_view b) {
-    return a.with_deserialized(type, [&] (collection_mutation_view_description a_view) {
-        return b.with_deserialized(type, [&] (collection_mutation_view_description b_view) {
-            return visit(type, make_visitor(
-            [&] (const collection_type_impl& ctype) {
-                return merge(std::move(a_view), std::move(b_view), *ctype.name_comparator());
-            },
-            [&] (const user_type_impl& utype) {
-                return merge(std::move(a_view), std::move(b_view), *short_type);
-            },
-            [] (const abstract_type& o) -> collection_mutation_view_description {
-                throw std::runtime_error(format("collection_mutation merge: unknown type: {}", o.name()));
-            }
-            )).serialize(type);
-        });
-    });
+    return visit(type, make_visitor(
+    [&] (const collection_type_impl& ctype) {
+        auto& value_type = *ctype.value_comparator();
+        return merge_serialized(type, *ctype.name_comparator(), [&] (managed_bytes_view) -> const abstract_type& {
+            return value_type;
+        }, a, b);
+    },
+    [&] (const user_type_impl& utype) {
+        return merge_serialized(type, *short_type, [&] (managed_bytes_view key) -> const abstract_type& {
+            return *utype.type(deserialize_field_index(key));
+        }, a, b);
+    },
+    [] (const abstract_type& o) -> collection_mutation {
+        throw std::runtime_error(format("collection_mutation merge: unknown type: {}", o.name()));
+    }
+    ));
 }
 
 template <typename C>
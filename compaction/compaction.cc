@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <map>
+#include <deque>
 #include <functional>
 #include <utility>
 #include <assert.h>
@@ -26,6 +27,7 @@
 #include <seastar/core/shard_id.hh>
 #include <seastar/core/on_internal_error.hh>
 #include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 
 #include "compaction/compaction_garbage_collector.hh"
 #include "dht/i_partitioner.hh"
@@ -449,32 +451,58 @@ class compacted_fragments_writer {
 using use_backlog_tracker = bool_class<class use_backlog_tracker_tag>;
 
 struct compaction_read_monitor_generator final : public read_monitor_generator {
-    class compaction_read_monitor final : public  sstables::read_monitor, public backlog_read_progress_manager {
+    class compaction_read_monitor final : public backlog_read_progress_manager {
+        // Monitors one reader of the sstable. The sstable has a reader for each
+        // of the token sub-ranges compacted in parallel.
+        class reader_monitor final : public sstables::read_monitor {
+            compaction_read_monitor& _parent;
+            const sstables::reader_position_tracker* _tracker = nullptr;
+            uint64_t _last_position_seen = 0;
+        public:
+            explicit reader_monitor(compaction_read_monitor& parent) : _parent(parent) { }
+
+            virtual void on_read_started(const sstables::reader_position_tracker& tracker) override {
+                _tracker = &tracker;
+                _parent.on_read_started();
+            }
+
+            virtual void on_read_completed() override {
+                if (_tracker) {
+                    _last_position_seen = _tracker->position;
+                    _tracker = nullptr;
+                }
+            }
+
+            uint64_t compacted() const {
+                if (_tracker) {
+                    return _tracker->position;
+                }
+                return _last_position_seen;
+            }
+        };
+
         sstables::shared_sstable _sst;
         compaction_group_view& _table_s;
-        const sstables::reader_position_tracker* _tracker = nullptr;
-        uint64_t _last_position_seen = 0;
+        // A deque, so the monitors handed out to the readers stay put.
+        std::deque<reader_monitor> _readers;
+        uint64_t _data_size;
         use_backlog_tracker _use_backlog_tracker;
-    public:
-        virtual void on_read_started(const sstables::reader_position_tracker& tracker) override {
-            _tracker = &tracker;
-            if (_use_backlog_tracker) {
+        bool _registered = false;
+
+        void on_read_started() {
+            if (_sst && _use_backlog_tracker && !std::exchange(_registered, true)) {
                 _table_s.get_backlog_tracker().register_compacting_sstable(_sst, *this);
             }
         }
-
-        virtual void on_read_completed() override {
-            if (_tracker) {
-                _last_position_seen = _tracker->position;
-                _tracker = nullptr;
-            }
+    public:
+        virtual uint64_t compacted() const override {
+            auto compacted = std::ranges::fold_left(_readers | std::views::transform(std::mem_fn(&reader_monitor::compacted)), uint64_t(0), std::plus{});
+            // The readers of sub-ranges count the part of the file they skip as read.
+            return std::min(compacted, _data_size);
         }
 
-        virtual uint64_t compacted() const override {
-            if (_tracker) {
-                return _tracker->position;
-            }
-            return _last_position_seen;
+        sstables::read_monitor& add_reader() {
+            return _readers.emplace_back(*this);
         }
 
         void remove_sstable() {
@@ -485,7 +513,9 @@ struct compaction_read_monitor_generator final : public read_monitor_generator {
         }
 
         compaction_read_monitor(sstables::shared_sstable sst, compaction_group_view& table_s, use_backlog_tracker use_backlog_tracker)
-            : _sst(std::move(sst)), _table_s(table_s), _use_backlog_tracker(use_backlog_tracker) { }
+            : _sst(std::move(sst)), _table_s(table_s), _data_size(_sst->data_size()), _use_backlog_tracker(use_backlog_tracker) { }
+
+        compaction_read_monitor(compaction_read_monitor&&) = delete;
 
         ~compaction_read_monitor() {
             // We failed to finish handling this SSTable, so we have to update the backlog_tracker
@@ -499,8 +529,9 @@ struct compaction_read_monitor_generator final : public read_monitor_generator {
     };
 
     virtual sstables::read_monitor& operator()(sstables::shared_sstable sst) override {
-        auto p = _generated_monitors.emplace(sst->generation(), compaction_read_monitor(sst, _table_s, _use_backlog_tracker));
-        return p.first->second;
+        auto generation = sst->generation();
+        auto it = _generated_monitors.try_emplace(generation, std::move(sst), _table_s, _use_backlog_tracker).first;
+        return it->second.add_reader();
     }
 
     explicit compaction_read_monitor_generator(compaction_group_view& table_s, use_backlog_tracker use_backlog_tracker = use_backlog_tracker::yes)
@@ -583,7 +614,8 @@ class compaction {
     // optional clone of sstable set to be used for expiration purposes, so it will be set if expiration is enabled.
     std::optional<sstable_set> _sstable_set;
     // used to incrementally calculate max purgeable timestamp, as we iterate through decorated keys.
-    std::optional<sstable_set::incremental_selector> _selector;
+    // There is one for each sub-range compacted in parallel, as each iterates through its own keys.
+    std::vector<std::optional<sstable_set::incremental_selector>> _selectors;
     std::unordered_set<shared_sstable> _compacting_for_max_purgeable_func;
     // optional owned_ranges vector for cleanup;
     const owned_ranges_ptr _owned_ranges = {};
@@ -598,6 +630,10 @@ class compaction {
     // optional tombstone_gc_state that is used when gc has to check only the compacting sstables to collect tombstones.
     std::optional<tombstone_gc_state> _tombstone_gc_state_with_commitlog_check_disabled;
     int64_t _output_repaired_at = 0;
+    // Requested number of token sub-ranges to compact in parallel.
+    const unsigned _parallel_subranges;
+    // Number of token sub-ranges actually compacted in parallel.
+    unsigned _subranges_in_parallel = 1;
 private:
     // Keeps track of monitors for input sstable.
     // If _update_backlog_tracker is set to true, monitors are responsible for adjusting backlog as compaction progresses.
@@ -641,14 +677,15 @@ class compaction {
         , _replacer(std::move(descriptor.replacer))
         , _run_identifier(descriptor.run_identifier)
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
-        , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
         , _owned_ranges(std::move(descriptor.owned_ranges))
         , _sharder(descriptor.sharder)
         , _owned_ranges_checker(_owned_ranges ? std::optional<dht::incremental_owned_ranges_checker>(*_owned_ranges) : std::nullopt)
         , _tombstone_gc_state_with_commitlog_check_disabled(descriptor.gc_check_only_compacting_sstables ? std::make_optional(_table_s.get_tombstone_gc_state().with_commitlog_check_disabled()) : std::nullopt)
+        , _parallel_subranges(descriptor.parallel_subranges)
         , _progress_monitor(progress_monitor)
     {
+        reset_selectors(1);
         std::unordered_set<run_id> ssts_run_ids;
         _contains_multi_fragment_runs = std::any_of(_sstables.begin(), _sstables.end(), [&ssts_run_ids] (shared_sstable& sst) {
             return !ssts_run_ids.insert(sst->run_identifier()).second;
@@ -666,7 +703,7 @@ class compaction {
     virtual uint64_t partitions_per_sstable() const {
         // some tests use _max_sstable_size == 0 for force many one partition per sstable
         auto max_sstable_size = std::max<uint64_t>(_max_sstable_size, 1);
-        uint64_t estimated_sstables = std::max(1UL, uint64_t(ceil(double(_compacting_data_file_size) / max_sstable_size)));
+        uint64_t estimated_sstables = std::max(uint64_t(_subranges_in_parallel), uint64_t(ceil(double(_compacting_data_file_size) / max_sstable_size)));
         return std::min(uint64_t(ceil(double(_estimated_partitions) / estimated_sstables)),
                         _table_s.get_compaction_strategy().adjust_partition_estimate(_ms_metadata, _estimated_partitions, _schema));
     }
@@ -684,6 +721,7 @@ class compaction {
         writer->writer.consume_end_of_stream();
         writer->sst->open_data().get();
         _end_size += writer->sst->bytes_on_disk();
+        _cdata.output_bytes_written += writer->sst->bytes_on_disk();
         _new_unused_sstables.push_back(writer->sst);
         _new_partial_sstables.erase(writer->sst);
     }
@@ -779,6 +817,16 @@ class compaction {
     virtual bool enable_garbage_collected_sstable_writer() const noexcept {
         return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && bool(_replacer);
     }
+
+    void reset_selectors(size_t count) {
+        _selectors.clear();
+        _selectors.resize(count);
+        if (_sstable_set) {
+            for (auto& selector : _selectors) {
+                selector.emplace(_sstable_set->make_incremental_selector());
+            }
+        }
+    }
 public:
     compaction& operator=(const compaction&) = delete;
     compaction(const compaction&) = delete;
@@ -853,6 +901,10 @@ class compaction {
     future<> setup() {
         auto ssts = make_lw_shared<sstables::sstable_set>(make_sstable_set_for_input());
         auto fully_expired = _table_s.fully_expired_sstables(_sstables, gc_clock::now());
+        auto fully_unowned = _owned_ranges
+                ? _sstables | std::views::filter([this] (const shared_sstable& sst) { return is_fully_unowned(sst, *_owned_ranges); })
+                        | std::ranges::to<std::unordered_set<shared_sstable>>()
+                : std::unordered_set<shared_sstable>{};
         min_max_tracker<api::timestamp_type> timestamp_tracker;
 
         double sum_of_estimated_droppable_tombstone_ratio = 0;
@@ -861,6 +913,11 @@ class compaction {
         int64_t repaired_at = 0;
         std::vector<int64_t> repaired_at_for_compacted_sstables;
         uint64_t compaction_size = 0;
+        auto pass_through = co_await sstables_to_pass_through(fully_expired);
+        // The cardinality estimators of the compacted sstables, if all of them
+        // have one and the estimators can be merged.
+        std::optional<hll::HyperLogLog> partition_count_estimator;
+        bool partition_count_estimator_usable = true;
         for (auto& sst : _sstables) {
             co_await coroutine::maybe_yield();
             auto& sst_stats = sst->get_stats_metadata();
@@ -882,15 +939,30 @@ class compaction {
                 log_debug("Fully expired sstable {} will be dropped on compaction completion", sst->get_filename());
                 continue;
             }
+            // Nor a sstable of which cleanup would discard everything.
+            if (fully_unowned.contains(sst)) {
+                log_debug("Fully unowned sstable {} will be dropped on compaction completion", sst->get_filename());
+                continue;
+            }
+            if (pass_through.contains(sst)) {
+                continue;
+            }
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
 
             compaction_size += sst->data_size();
             // We also capture the sstable, so we keep it alive while the read isn't done
             ssts->insert(sst);
-            // FIXME: If the sstables have cardinality estimation bitmaps, use that
-            // for a better estimate for the number of partitions in the merged
-            // sstable than just adding up the lengths of individual sstables.
             _estimated_partitions += sst->get_estimated_key_count();
+            if (partition_count_estimator_usable) {
+                auto estimator = sst->get_partition_count_estimator();
+                if (!estimator || (partition_count_estimator && partition_count_estimator->registerSize() != estimator->registerSize())) {
+                    partition_count_estimator_usable = false;
+                } else if (partition_count_estimator) {
+                    partition_count_estimator->merge(*estimator);
+                } else {
+                    partition_count_estimator = std::move(estimator);
+                }
+            }
             sum_of_estimated_droppable_tombstone_ratio += sst->estimate_droppable_tombstone_ratio(gc_clock::now(), get_tombstone_gc_state(), _schema);
             _compacting_data_file_size += sst->ondisk_data_size();
             _compacting_max_timestamp = std::max(_compacting_max_timestamp, sst->get_stats_metadata().max_timestamp);
@@ -898,6 +970,19 @@ class compaction {
                 _rp = std::max(_rp, sst_stats.position);
             }
         }
+        // With few registers the error of the estimate is too large to rely on.
+        static constexpr size_t min_partition_count_estimator_registers = 1024;
+        if (partition_count_estimator_usable && partition_count_estimator && partition_count_estimator->registerSize() >= min_partition_count_estimator_registers) {
+            // Adding up the partitions of the compacted sstables overestimates
+            // the partitions of the output as much as the sstables overlap,
+            // which results in oversized bloom filters. Their merged estimator
+            // estimates the union instead. Allow for twice its standard error,
+            // since an underestimate results in a higher false-positive ratio.
+            auto error = 1.04 / std::sqrt(double(partition_count_estimator->registerSize()));
+            auto estimated_union = uint64_t(std::ceil(partition_count_estimator->estimate() * (1 + 2 * error)));
+            log_debug("Estimated {} partitions in the union of compacted sstables ({} in total)", estimated_union, _estimated_partitions);
+            _estimated_partitions = std::min(_estimated_partitions, std::max(estimated_union, uint64_t(1)));
+        }
         _cdata.compaction_size += compaction_size;        
         log_debug("{} [{}]", report_start_desc(), fmt::join(_sstables | std::views::transform([] (auto sst) { return to_string(sst, true); }), ","));
         if (repaired_at) {
@@ -905,7 +990,7 @@ class compaction {
         }
         log_debug("repaired_at_vec={} output_repaired_at={}", repaired_at_for_compacted_sstables, _output_repaired_at);
         if (ssts->size() < _sstables.size()) {
-            log_debug("{} out of {} input sstables are fully expired sstables that will not be actually compacted",
+            log_debug("{} out of {} input sstables are fully expired, fully unowned or passed through sstables that will not be actually compacted",
                       _sstables.size() - ssts->size(), _sstables.size());
         }
         // _estimated_droppable_tombstone_ratio could exceed 1.0 in certain cases, so limit it to 1.0.
@@ -915,12 +1000,82 @@ class compaction {
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
+
+        for (auto& sst : pass_through) {
+            co_await pass_through_sstable(sst);
+        }
+    }
+
+    // Returns the input sstables which compaction wouldn't change, other than by
+    // moving them to the output level, and which are thus copied as a whole into
+    // the output rather than read and rewritten partition by partition.
+    //
+    // That's the case for sstables whose token range overlaps no other input, so
+    // none of their partitions is merged, and in which no tombstone can be purged
+    // and no cell has expired, as told by their minimum local deletion time.
+    // Only regular compactions promoting sstables to another level qualify, as
+    // compacting within a level is meant to reduce the number of sstables, and
+    // only if the output isn't replaced incrementally, which relies on all input
+    // being read in token order.
+    future<std::unordered_set<shared_sstable>> sstables_to_pass_through(const std::unordered_set<shared_sstable>& fully_expired) const {
+        std::unordered_set<shared_sstable> ret;
+        if (_type != compaction_type::Compaction || _owned_ranges_checker || enable_garbage_collected_sstable_writer()) {
+            co_return ret;
+        }
+        auto sorted = _sstables;
+        std::ranges::sort(sorted, [this] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(*_schema, b->get_first_decorated_key()) < 0;
+        });
+        const auto now = gc_clock::now().time_since_epoch().count();
+        std::optional<dht::decorated_key> max_last_key;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            co_await coroutine::maybe_yield();
+            auto& sst = sorted[i];
+            const auto& first = sst->get_first_decorated_key();
+            const auto& last = sst->get_last_decorated_key();
+            bool overlaps = (max_last_key && max_last_key->tri_compare(*_schema, first) >= 0)
+                    || (i + 1 < sorted.size() && sorted[i + 1]->get_first_decorated_key().tri_compare(*_schema, last) <= 0);
+            if (!max_last_key || max_last_key->tri_compare(*_schema, last) < 0) {
+                max_last_key = last;
+            }
+            auto& stats = sst->get_stats_metadata();
+            if (overlaps
+                    || fully_expired.contains(sst)
+                    || sst->is_shared()
+                    || !sst->get_storage().supports_snapshot()
+                    || sst->get_version() < sstable_version_types::mc
+                    || stats.min_local_deletion_time <= now
+                    || stats.sstable_level == _sstable_level
+                    || sst->data_size() > _max_sstable_size) {
+                continue;
+            }
+            ret.insert(sst);
+        }
+        co_return ret;
+    }
+
+    // Copies the sstable into the output by hard-linking its components under a
+    // new generation, then moves the copy to the output level.
+    future<> pass_through_sstable(const shared_sstable& sst) {
+        auto new_sst = _sstable_creator(this_shard_id());
+        _all_new_sstables.push_back(new_sst);
+        _new_partial_sstables.insert(new_sst);
+        co_await sst->clone(new_sst->generation());
+        // The input is owned by this shard alone, and so is its copy.
+        co_await new_sst->load(_schema->get_sharder(), sstable_open_config{.current_shard_as_sstable_owner = true});
+        co_await new_sst->mutate_sstable_level(_sstable_level);
+        _end_size += new_sst->bytes_on_disk();
+        _cdata.output_bytes_written += new_sst->bytes_on_disk();
+        _cdata.total_keys_written += new_sst->get_estimated_key_count();
+        _new_unused_sstables.push_back(new_sst);
+        _new_partial_sstables.erase(new_sst);
+        log_debug("Passed sstable {} through to {} without rewriting it", sst->get_filename(), new_sst->get_filename());
     }
 
     // This consumer will perform mutation compaction on producer side using
     // compacting_reader. It's useful for allowing data from different buckets
     // to be compacted together.
-    future<> consume_without_gc_writer(gc_clock::time_point compaction_time) {
+    future<> consume_without_gc_writer(mutation_reader reader, gc_clock::time_point compaction_time, size_t subrange = 0) {
         auto consumer = make_interposer_consumer([this] (mutation_reader reader) mutable {
             return seastar::async([this, reader = std::move(reader)] () mutable {
                 auto close_reader = deferred_close(reader);
@@ -929,17 +1084,93 @@ class compaction {
             });
         });
         const auto& gc_state = get_tombstone_gc_state();
-        return consumer(make_compacting_reader(setup_sstable_reader(), compaction_time, max_purgeable_func(), gc_state,
+        return consumer(make_compacting_reader(std::move(reader), compaction_time, max_purgeable_func(subrange), gc_state,
                                                streamed_mutation::forwarding::no, &_tombstone_purge_stats));
     }
 
+    // Splits the token range spanned by the input into the sub-ranges to compact in
+    // parallel, or returns an empty vector if the input is to be compacted as a whole.
+    //
+    // Sub-ranges are compacted by separate readers and writers, so their output
+    // sstables are disjoint and still form a single run. But the output isn't
+    // written in token order, which the early replacement of exhausted input
+    // sstables (together with the garbage collected sstable writer) relies on,
+    // so such compactions are never split. Neither are cleanups and reshardings,
+    // which have their own ways of filtering and distributing the output.
+    dht::partition_range_vector make_parallel_subranges() const {
+        if (_parallel_subranges <= 1 || enable_garbage_collected_sstable_writer() || _owned_ranges_checker || _sharder || _sstables.size() < 2) {
+            return {};
+        }
+        uint64_t first = std::numeric_limits<uint64_t>::max();
+        uint64_t last = 0;
+        for (auto& sst : _sstables) {
+            first = std::min(first, sst->get_first_decorated_key().token().unbias());
+            last = std::max(last, sst->get_last_decorated_key().token().unbias());
+        }
+        if (first >= last) {
+            return {};
+        }
+        auto step = (last - first) / _parallel_subranges;
+        if (step == 0) {
+            return {};
+        }
+        dht::partition_range_vector ranges;
+        std::optional<dht::ring_position> start;
+        for (unsigned i = 1; i < _parallel_subranges; ++i) {
+            auto end = dht::ring_position::ending_at(dht::token::bias(first + step * i));
+            ranges.push_back(start
+                    ? dht::partition_range::make({std::move(*start), false}, {end, true})
+                    : dht::partition_range::make_ending_with({end, true}));
+            start = std::move(end);
+        }
+        ranges.push_back(dht::partition_range::make_starting_with({std::move(*start), false}));
+        return ranges;
+    }
+
+    // Compacts the sub-ranges concurrently, to overlap the CPU work of compacting
+    // some of them with the I/O of the others.
+    future<> consume_subranges_in_parallel(dht::partition_range_vector ranges, gc_clock::time_point now) {
+        log_debug("Compacting {} token sub-ranges in parallel", ranges.size());
+        _subranges_in_parallel = ranges.size();
+        reset_selectors(ranges.size());
+        co_await coroutine::parallel_for_each(std::views::iota(size_t(0), ranges.size()), [this, &ranges, now] (size_t i) -> future<> {
+            auto reader = make_sstable_reader(_schema,
+                                              _permit,
+                                              ranges[i],
+                                              _schema->full_slice(),
+                                              tracing::trace_state_ptr(),
+                                              ::streamed_mutation::forwarding::no,
+                                              ::mutation_reader::forwarding::no);
+            if (use_interposer_consumer()) {
+                co_return co_await consume_without_gc_writer(std::move(reader), now, i);
+            }
+            auto consumer = make_interposer_consumer([this, now, i] (mutation_reader reader) mutable {
+                return seastar::async([this, reader = std::move(reader), now, i] () mutable {
+                    auto close_reader = deferred_close(reader);
+                    using compact_mutations = compact_for_compaction<compacted_fragments_writer, noop_compacted_fragments_consumer>;
+                    auto cfc = compact_mutations(*schema(), now,
+                        max_purgeable_func(i),
+                        get_tombstone_gc_state(),
+                        get_compacted_fragments_writer(),
+                        noop_compacted_fragments_consumer(),
+                        &_tombstone_purge_stats);
+                    reader.consume_in_thread(std::move(cfc));
+                });
+            });
+            co_await consumer(std::move(reader));
+        });
+    }
+
     future<> consume() {
         auto now = gc_clock::now();
+        if (auto ranges = make_parallel_subranges(); !ranges.empty()) {
+            return consume_subranges_in_parallel(std::move(ranges), now);
+        }
         // consume_without_gc_writer(), which uses compacting_reader, is ~3% slower.
         // let's only use it when GC writer is disabled and interposer consumer is enabled, as we
         // wouldn't like others to pay the penalty for something they don't need.
         if (!enable_garbage_collected_sstable_writer() && use_interposer_consumer()) {
-            return consume_without_gc_writer(now);
+            return consume_without_gc_writer(setup_sstable_reader(), now);
         }
         auto consumer = make_interposer_consumer([this, now] (mutation_reader reader) mutable
         {
@@ -1042,12 +1273,12 @@ class compaction {
     virtual std::string_view report_start_desc() const = 0;
     virtual std::string_view report_finish_desc() const = 0;
 
-    max_purgeable_fn max_purgeable_func() {
+    max_purgeable_fn max_purgeable_func(size_t subrange = 0) {
         if (!tombstone_expiration_enabled()) {
             return can_never_purge;
         }
-        return [this] (const dht::decorated_key& dk, is_shadowable is_shadowable) {
-            return get_max_purgeable_timestamp(_table_s, *_selector, _compacting_for_max_purgeable_func, dk, _bloom_filter_checks, _compacting_max_timestamp, _tombstone_gc_state_with_commitlog_check_disabled.has_value(), is_shadowable);
+        return [this, subrange] (const dht::decorated_key& dk, is_shadowable is_shadowable) {
+            return get_max_purgeable_timestamp(_table_s, *_selectors[subrange], _compacting_for_max_purgeable_func, dk, _bloom_filter_checks, _compacting_max_timestamp, _tombstone_gc_state_with_commitlog_check_disabled.has_value(), is_shadowable);
         };
     }
 
@@ -1262,7 +1493,7 @@ class regular_compaction : public compaction {
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
                                                 mutation_reader::forwarding mr_fwd) override {
-        return _compacting->make_local_shard_sstable_reader(std::move(s),
+        return _compacting->make_local_shard_sstable_reader_by_runs(std::move(s),
                 std::move(permit),
                 range,
                 slice,
@@ -1382,7 +1613,7 @@ class regular_compaction : public compaction {
                 _sstable_set->insert(sst);
             }
         }
-        _selector.emplace(_sstable_set->make_incremental_selector());
+        reset_selectors(_selectors.size());
     }
 };
 
@@ -1412,7 +1643,7 @@ class reshape_compaction : public regular_compaction {
                                                 tracing::trace_state_ptr trace,
                                                 streamed_mutation::forwarding sm_fwd,
                                                 mutation_reader::forwarding mr_fwd) override {
-        return _compacting->make_local_shard_sstable_reader(std::move(s),
+        return _compacting->make_local_shard_sstable_reader_by_runs(std::move(s),
                 std::move(permit),
                 range,
                 slice,
@@ -2040,6 +2271,20 @@ compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cd
     return compaction::run(make_compaction(table_s, std::move(descriptor), cdata, progress_monitor));
 }
 
+bool is_fully_unowned(const sstables::shared_sstable& sst, const dht::token_range_vector& sorted_owned_ranges) {
+    auto first_token = sst->get_first_decorated_key().token();
+    auto last_token = sst->get_last_decorated_key().token();
+    dht::token_range sst_token_range = dht::token_range::make(first_token, last_token);
+
+    // The first owned range which doesn't end before the sstable starts is the only
+    // candidate for overlapping it, as the owned ranges are sorted and disjoint.
+    auto r = std::lower_bound(sorted_owned_ranges.begin(), sorted_owned_ranges.end(), first_token,
+            [] (const interval<dht::token>& a, const dht::token& b) {
+        return a.after(b, dht::token_comparator());
+    });
+    return r == sorted_owned_ranges.end() || !r->overlaps(sst_token_range, dht::token_comparator());
+}
+
 std::unordered_set<sstables::shared_sstable>
 get_fully_expired_sstables(const compaction_group_view& table_s, const std::vector<sstables::shared_sstable>& compacting, gc_clock::time_point compaction_time) {
     clogger.debug("Checking droppable sstables in {}.{}", table_s.schema()->ks_name(), table_s.schema()->cf_name());
@@ -2116,6 +2361,19 @@ uint64_t compaction_descriptor::sstables_size() const {
     return std::ranges::fold_left(sstables | std::views::transform(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0), std::plus{});
 }
 
+uint64_t compaction_descriptor::estimated_output_disk_space() const {
+    if (has_only_fully_expired) {
+        return 0;
+    }
+    auto size = sstables_size();
+    auto runs = fan_in();
+    // See compaction::enable_garbage_collected_sstable_writer()
+    if (max_sstable_bytes == default_max_sstable_bytes || runs == sstables.size()) {
+        return size;
+    }
+    return std::min(size, (uint64_t(runs) + 1) * max_sstable_bytes);
+}
+
 }
 
 auto fmt::formatter<sstables::compaction_type>::format(sstables::compaction_type type, fmt::format_context& ctx) const
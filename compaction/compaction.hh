@@ -46,6 +46,8 @@ struct compaction_info {
     sstring cf_name;
     uint64_t total_partitions = 0;
     uint64_t total_keys_written = 0;
+    // Disk space taken by the output sstables sealed so far.
+    uint64_t output_bytes_written = 0;
 };
 
 struct compaction_data {
@@ -141,6 +143,10 @@ future<compaction_result> compact_sstables(sstables::compaction_descriptor descr
 std::unordered_set<sstables::shared_sstable>
 get_fully_expired_sstables(const compaction_group_view& table_s, const std::vector<sstables::shared_sstable>& compacting, gc_clock::time_point gc_before);
 
+// Returns true iff no token of the sstable's token range is in the sorted owned ranges,
+// so that cleanup can drop the sstable without reading it.
+bool is_fully_unowned(const sstables::shared_sstable& sst, const dht::token_range_vector& sorted_owned_ranges);
+
 // For tests, can drop after we virtualize sstables.
 mutation_reader make_scrubbing_reader(mutation_reader rd, compaction_type_options::scrub::mode scrub_mode, uint64_t& validation_errors);
 
@@ -180,6 +180,12 @@ struct compaction_descriptor {
     // log, there is currently no way to check if the key exists; only the minimum
     // timestamp comparison, similar to memtables, is performed.
     bool gc_check_only_compacting_sstables = false;
+    // Number of token sub-ranges the input may be split into, to be compacted in parallel.
+    // The compaction may ignore it, e.g. when the output is replaced incrementally.
+    unsigned parallel_subranges = 1;
+    // Engaged for compactions of a single sstable scheduled to drop its tombstones,
+    // holds the estimated number of tombstones they purge.
+    std::optional<double> estimated_droppable_tombstones;
 
     compaction_descriptor() = default;
 
@@ -216,6 +222,11 @@ struct compaction_descriptor {
     void enable_garbage_collection(sstables::sstable_set snapshot) { all_sstables_snapshot = std::move(snapshot); }
     // Returns total size of all sstables contained in this descriptor
     uint64_t sstables_size() const;
+    // Returns the estimated disk space taken by the output of this job before
+    // its input can be deleted: the size of the input, unless the input runs
+    // are replaced incrementally as their fragments are exhausted, then about
+    // a fragment per input run and the output fragment being written.
+    uint64_t estimated_output_disk_space() const;
 };
 
 }
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ *
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace compaction {
+
+class compaction_manager;
+
+// Disk space reserved for the output of a compaction job, see
+// compaction_manager::try_reserve_disk_space().
+class compaction_disk_space_reservation {
+    compaction_manager* _cm;
+    uint64_t _size;
+public:
+    compaction_disk_space_reservation(compaction_manager* cm, uint64_t size);
+
+    compaction_disk_space_reservation& operator=(const compaction_disk_space_reservation&) = delete;
+    compaction_disk_space_reservation(const compaction_disk_space_reservation&) = delete;
+
+    compaction_disk_space_reservation& operator=(compaction_disk_space_reservation&& other) noexcept;
+
+    compaction_disk_space_reservation(compaction_disk_space_reservation&& other) noexcept;
+
+    ~compaction_disk_space_reservation();
+
+    // Release immediately the space held by this object
+    void release() noexcept;
+
+    uint64_t size() const noexcept {
+        return _size;
+    }
+};
+
+}
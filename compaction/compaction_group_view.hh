@@ -61,7 +61,12 @@ class compaction_group_view {
     virtual const std::string get_group_id() const noexcept = 0;
     virtual seastar::condition_variable& get_staging_done_condition() noexcept = 0;
     virtual dht::token_range get_token_range_after_split(const dht::token& t) const noexcept = 0;
+    // Engaged when the group is being split, so that regular compaction separates its data too.
+    virtual std::optional<sstables::compaction_type_options::split> split_options() const noexcept = 0;
     virtual int64_t get_sstables_repaired_at() const noexcept = 0;
+    // Mean number of sstables a read of the table touches, at least 1.
+    // Used to prioritize compaction across tables.
+    virtual double read_amplification() const noexcept = 0;
 };
 
 } // namespace compaction
@@ -23,6 +23,7 @@
 #include <seastar/coroutine/maybe_yield.hh>
 #include "sstables/exceptions.hh"
 #include "sstables/sstable_directory.hh"
+#include "sstables/sstable_set.hh"
 #include "utils/assert.hh"
 #include "utils/error_injection.hh"
 #include "utils/UUID_gen.hh"
@@ -161,6 +162,37 @@ int compaction_weight_registration::weight() const {
     return _weight;
 }
 
+compaction_disk_space_reservation::compaction_disk_space_reservation(compaction_manager* cm, uint64_t size)
+    : _cm(cm)
+    , _size(size)
+{
+    _cm->_reserved_disk_space += _size;
+}
+
+compaction_disk_space_reservation& compaction_disk_space_reservation::operator=(compaction_disk_space_reservation&& other) noexcept {
+    if (this != &other) {
+        this->~compaction_disk_space_reservation();
+        new (this) compaction_disk_space_reservation(std::move(other));
+    }
+    return *this;
+}
+
+compaction_disk_space_reservation::compaction_disk_space_reservation(compaction_disk_space_reservation&& other) noexcept
+    : _cm(std::exchange(other._cm, nullptr))
+    , _size(std::exchange(other._size, 0))
+{
+}
+
+compaction_disk_space_reservation::~compaction_disk_space_reservation() {
+    release();
+}
+
+void compaction_disk_space_reservation::release() noexcept {
+    if (auto cm = std::exchange(_cm, nullptr)) {
+        cm->release_disk_space(std::exchange(_size, 0));
+    }
+}
+
 // Calculate weight of compaction job.
 static inline int calculate_weight(uint64_t total_size) {
     // At the moment, '4' is being used as log base for determining the weight
@@ -234,6 +266,42 @@ void compaction_manager::deregister_weight(int weight) {
     reevaluate_postponed_compactions();
 }
 
+std::optional<uint64_t> compaction_manager::available_disk_space() const noexcept {
+    if (!_disk_space_budget) {
+        return std::nullopt;
+    }
+    // The budget is computed from the disk usage, which already includes the
+    // output the ongoing compactions wrote so far.
+    uint64_t written = 0;
+    for (const auto& task : _tasks) {
+        written += task.written_disk_space_reservation();
+    }
+    auto unwritten = _reserved_disk_space - std::min(_reserved_disk_space, written);
+    return *_disk_space_budget - std::min(*_disk_space_budget, unwritten);
+}
+
+std::optional<compaction_disk_space_reservation> compaction_manager::try_reserve_disk_space(uint64_t size) {
+    auto available = available_disk_space();
+    if (available && size > *available) {
+        return std::nullopt;
+    }
+    return compaction_disk_space_reservation(this, size);
+}
+
+void compaction_manager::release_disk_space(uint64_t size) noexcept {
+    _reserved_disk_space -= size;
+    reevaluate_postponed_compactions();
+}
+
+void compaction_manager::set_disk_space_budget(std::optional<uint64_t> budget) noexcept {
+    auto grew = budget != _disk_space_budget && (!budget || (_disk_space_budget && *budget > *_disk_space_budget));
+    _disk_space_budget = budget;
+    // Compactions postponed for lack of disk space may fit now
+    if (grew) {
+        reevaluate_postponed_compactions();
+    }
+}
+
 future<std::vector<sstables::shared_sstable>> in_strategy_sstables(compaction_group_view& table_s) {
     auto set = co_await table_s.main_sstable_set();
     auto sstables = set->all();
@@ -584,6 +652,7 @@ class major_compaction_task_executor : public compaction_task_executor, public m
         sstables::compaction_strategy cs = t->get_compaction_strategy();
         sstables::compaction_descriptor descriptor = cs.get_major_compaction_job(*t, co_await _cm.get_candidates(*t));
         descriptor.gc_check_only_compacting_sstables = _consider_only_existing_data;
+        descriptor.parallel_subranges = _cm.major_compaction_parallel_subranges();
         auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(t), descriptor.sstables);
         auto on_replace = compacting.update_on_sstable_replacement();
         setup_new_compaction(descriptor.run_identifier);
@@ -961,6 +1030,7 @@ void compaction_task_executor::setup_new_compaction(sstables::run_id output_run_
 }
 
 void compaction_task_executor::finish_compaction(state finish_state) noexcept {
+    _disk_space_reservation.reset();
     switch_state(finish_state);
     _output_run_identifier = sstables::run_id::create_null_id();
     if (finish_state != state::failed) {
@@ -1007,6 +1077,10 @@ class compaction_manager::strategy_control : public compaction::strategy_control
         auto main_set = co_await t.main_sstable_set();
         co_return _cm.get_candidates(t, main_set->all_sstable_runs());
     }
+
+    std::optional<uint64_t> available_disk_space() const noexcept override {
+        return _cm.available_disk_space();
+    }
 };
 
 compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task_manager& tm)
@@ -1036,6 +1110,13 @@ compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task
     , _strategy_control(std::make_unique<strategy_control>(*this))
     , _tombstone_gc_state(_shared_tombstone_gc_state) {
     tm.register_module(_task_manager_module->get_name(), _task_manager_module);
+    _compaction_controller.set_read_latency_feedback([this] {
+        auto latency = std::chrono::microseconds(_read_latency.quantile(0.99));
+        _read_latency.clear();
+        return latency;
+    }, [this] {
+        return read_latency_target();
+    });
     register_metrics();
     // Bandwidth throttling is node-wide, updater is needed on single shard
     if (this_shard_id() == 0) {
@@ -1102,6 +1183,18 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_gauge("read_latency_throttle", [this] { return _compaction_controller.read_latency_throttle(); },
+                       sm::description("Holds the fraction of the compaction shares given by the backlog which compaction gets, after cuts due to high read latency.")),
+        sm::make_counter("tombstone_compactions", [this] { return _stats.tombstone_compactions; },
+                       sm::description("Holds the number of single sstable compactions scheduled to drop tombstones.")),
+        sm::make_counter("tombstone_compaction_estimated_purges", [this] { return _stats.tombstone_compaction_estimated_purges; },
+                       sm::description("Holds the estimated number of tombstones to be purged by tombstone compactions, when they were scheduled.")),
+        sm::make_counter("tombstone_compaction_purges", [this] { return _stats.tombstone_compaction_purges; },
+                       sm::description("Holds the number of tombstones purged by tombstone compactions.")),
+        sm::make_gauge("reserved_disk_space", [this] { return _reserved_disk_space; },
+                       sm::description("Holds the disk space reserved for the output of ongoing compactions.")),
+        sm::make_counter("disk_space_postponed_compactions", [this] { return _stats.disk_space_postponed_compactions; },
+                       sm::description("Holds the number of compactions postponed because the disk space for their output couldn't be reserved.")),
     });
 }
 
@@ -1144,11 +1237,18 @@ future<> compaction_manager::postponed_compactions_reevaluation() {
         }
         // A task_state being reevaluated can re-insert itself into postponed list, which is the reason
         // for moving the list to be processed into a local.
-        auto postponed = std::exchange(_postponed, {});
+        auto postponed = std::exchange(_postponed, {}) | std::ranges::to<std::vector>();
+        // Weighted fair queueing: resubmit first the tables which got the least compaction relative
+        // to their read amplification, as that's where compaction reduces the read cost the most.
+        // The postponed tables compete for the same weights, so the first ones get to run.
+        std::ranges::sort(postponed, std::less<>(), [this] (compaction_group_view* t) {
+            auto it = _compaction_state.find(t);
+            return it != _compaction_state.end() ? it->second.virtual_time : 0;
+        });
+        size_t idx = 0;
         try {
-            for (auto it = postponed.begin(); it != postponed.end();) {
-                compaction_group_view* t = *it;
-                it = postponed.erase(it);
+            for (; idx < postponed.size(); idx++) {
+                compaction_group_view* t = postponed[idx];
                 // skip reevaluation of a compaction_group_view that became invalid post its removal
                 if (!_compaction_state.contains(t)) {
                     continue;
@@ -1158,7 +1258,7 @@ future<> compaction_manager::postponed_compactions_reevaluation() {
                 co_await coroutine::maybe_yield();
             }
         } catch (...) {
-            _postponed.insert(postponed.begin(), postponed.end());
+            _postponed.insert(postponed.begin() + idx, postponed.end());
         }
     }
 }
@@ -1256,6 +1356,19 @@ future<> compaction_manager::start(const db::config& cfg, utils::disk_space_moni
             }
             return container().invoke_on_all([] (compaction_manager& cm) { cm.enable(); });
         });
+        // Compactions must leave the disk below the critical utilization level, the
+        // space up to it is split evenly between the shards. The used space includes
+        // the output the ongoing compactions wrote so far, so only the part of their
+        // reservations not written yet is taken off it, see available_disk_space().
+        _disk_space_listener = dsm->listen([this, critical_level = utils::updateable_value<float>(cfg.critical_disk_utilization_level)] (const utils::disk_space_monitor& dsm) {
+            auto space = dsm.space();
+            auto used = space.capacity - space.available;
+            auto limit = uint64_t(space.capacity * std::clamp(critical_level(), 0.0f, 1.0f));
+            auto budget = (limit > used ? limit - used : 0) / smp::count;
+            return container().invoke_on_all([budget] (compaction_manager& cm) {
+                cm.set_disk_space_budget(budget);
+            });
+        });
     }
 
     return make_ready_future<>();
@@ -1275,6 +1388,7 @@ future<> compaction_manager::really_do_stop() noexcept {
     cmlog.info("Asked to stop");
     // Reset the metrics registry
     _metrics.clear();
+    _disk_space_listener.disconnect();
     co_await stop_ongoing_compactions("shutdown");
     if (!_tasks.empty()) {
         on_fatal_internal_error(cmlog, format("{} tasks still exist after being stopped", _tasks.size()));
@@ -1418,6 +1532,11 @@ class regular_compaction_task_executor : public compaction_task_executor, public
                 cmlog.debug("{}: sstables={} can_proceed={} auto_compaction={}", *this, descriptor.sstables.size(), can_proceed(), t.is_auto_compaction_disabled_by_user());
                 co_return std::nullopt;
             }
+            // While the group awaits split, regular compaction separates the data of the two
+            // halves as a side effect, which leaves the split itself fewer sstables to rewrite.
+            if (auto split_opt = t.split_options()) {
+                descriptor.options = sstables::compaction_type_options::make_split(std::move(split_opt->classifier));
+            }
             if (!_cm.can_register_compaction(t, weight, descriptor.fan_in())) {
                 cmlog.debug("Refused compaction job ({} sstable(s)) of weight {} for {}, postponing it...",
                     descriptor.sstables.size(), weight, t);
@@ -1425,25 +1544,50 @@ class regular_compaction_task_executor : public compaction_task_executor, public
                 _cm.postpone_compaction_for_table(&t);
                 co_return std::nullopt;
             }
+            _disk_space_reservation = _cm.try_reserve_disk_space(descriptor.estimated_output_disk_space());
+            if (!_disk_space_reservation) {
+                cmlog.debug("Refused compaction job ({} sstable(s)) needing {} bytes of disk space, {} available, for {}, postponing it...",
+                    descriptor.sstables.size(), descriptor.estimated_output_disk_space(), _cm.available_disk_space().value_or(0), t);
+                _cm._stats.disk_space_postponed_compactions++;
+                switch_state(state::postponed);
+                _cm.postpone_compaction_for_table(&t);
+                co_return std::nullopt;
+            }
             auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(&t), descriptor.sstables);
             auto weight_r = compaction_weight_registration(&_cm, weight);
             auto on_replace = compacting.update_on_sstable_replacement();
-            cmlog.debug("Accepted compaction job: task={} ({} sstable(s)) of weight {} for {}",
-                fmt::ptr(this), descriptor.sstables.size(), weight, t);
+            cmlog.debug("Accepted compaction job: task={} ({} sstable(s)) of weight {} reserving {} bytes for {}",
+                fmt::ptr(this), descriptor.sstables.size(), weight, _disk_space_reservation->size(), t);
 
             // Finished selecting and registering compacting sstables, so write lock can be released.
             lock_holder.return_all();
             lock_holder = co_await _compaction_state.lock.hold_read_lock();
 
+            auto virtual_start_time = std::max(_cm._compaction_virtual_time, _compaction_state.virtual_time);
+            _cm._compaction_virtual_time = virtual_start_time;
+
             setup_new_compaction(descriptor.run_identifier);
             _compaction_state.last_regular_compaction = gc_clock::now();
             std::exception_ptr ex;
 
             try {
                 bool should_update_history = this->should_update_history(descriptor.options.type());
+                bool tombstone_compaction = bool(descriptor.estimated_droppable_tombstones);
+                if (tombstone_compaction) {
+                    _cm._stats.tombstone_compactions++;
+                    _cm._stats.tombstone_compaction_estimated_purges += uint64_t(*descriptor.estimated_droppable_tombstones);
+                }
                 sstables::compaction_result res = co_await compact_sstables(std::move(descriptor), _compaction_data, on_replace);
+                _compaction_state.virtual_time = virtual_start_time + res.stats.start_size / t.read_amplification();
+                if (tombstone_compaction) {
+                    auto& purges = res.stats.tombstone_purge_stats;
+                    _cm._stats.tombstone_compaction_purges += purges.attempts - purges.failures_due_to_overlapping_with_memtable
+                            - purges.failures_due_to_overlapping_with_uncompacting_sstable - purges.failures_other;
+                }
                 cmlog.debug("Finished minor compaction old_sstables={} new_sstables={} sstables_reapired_at={} range={} uuid={} compaction_uuid={}",
                         old_sstables, res.new_sstables, compacting_table()->get_sstables_repaired_at(), compacting_table()->token_range(), uuid, _compaction_data.compaction_uuid);
+                // The input is replaced by the output, the latter is accounted
+                // for by the disk usage now.
                 finish_compaction();
                 if (should_update_history) {
                     // update_history can take a long time compared to
@@ -1541,6 +1685,36 @@ future<> compaction_manager::maybe_wait_for_sstable_count_reduction(compaction_g
 
 namespace compaction {
 
+bool trim_reshape_job_to_round_size(sstables::compaction_descriptor& desc, const schema_ptr& schema, uint64_t round_size) {
+    auto size = std::ranges::fold_left(desc.sstables | std::views::transform(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0), std::plus{});
+    // A round compacts at least two sstables, otherwise it may make no progress.
+    if (size <= round_size || desc.sstables.size() <= 2) {
+        return false;
+    }
+    // Input which is disjoint would be, typically, the output of repair or
+    // streaming token ranges, so rounds take them in token order.
+    std::ranges::sort(desc.sstables, sstables::sstable_first_key_less_comparator{});
+    // The output of a job over overlapping input replacing a leveled level
+    // would overlap the part of the level left out of the round.
+    if (desc.level != 0 && sstables::sstable_set_overlapping_count(schema, desc.sstables) != 0) {
+        return false;
+    }
+    size = 0;
+    auto it = std::ranges::find_if(desc.sstables, [&] (const sstables::shared_sstable& sst) {
+        size += sst->data_size();
+        return size > round_size;
+    });
+    auto kept = std::max(std::distance(desc.sstables.begin(), it), ptrdiff_t(2));
+    desc.sstables.resize(kept);
+    return true;
+}
+
+bool has_more_urgent_offstrategy_waiter(const std::unordered_map<const void*, double>& waiters, double read_amplification) {
+    return std::ranges::any_of(waiters | std::views::values, [&] (double ra) {
+        return ra > read_amplification;
+    });
+}
+
 class offstrategy_compaction_task_executor : public compaction_task_executor, public offstrategy_compaction_task_impl {
     bool& _performed;
 public:
@@ -1573,9 +1747,10 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
         // Incrementally reshape the SSTables in maintenance set. The output of each reshape
         // round is merged into the main set. The common case is that off-strategy input
         // is mostly disjoint, e.g. repair-based node ops, then all the input will be
-        // reshaped in a single round. The incremental approach allows us to be space
-        // efficient (avoiding a 100% overhead) as we will incrementally replace input
-        // SSTables from maintenance set by output ones into main set.
+        // reshaped in rounds of up to offstrategy_round_size() each. The incremental
+        // approach allows us to be space efficient (avoiding a 100% overhead) as we will
+        // incrementally replace input SSTables from maintenance set by output ones into
+        // main set, and lets reads benefit from the reshaped data before all of it is done.
 
         compaction_group_view& t = *_compacting_table;
 
@@ -1599,15 +1774,31 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
             auto& storage = candidates.front()->get_storage();
             sstables::reshape_config cfg = co_await sstables::make_reshape_config(storage, sstables::reshape_mode::strict);
             auto desc = t.get_compaction_strategy().get_reshaping_job(co_await get_reshape_candidates(), t.schema(), cfg);
-            co_return desc.sstables.size() ? std::make_optional(std::move(desc)) : std::nullopt;
+            if (desc.sstables.empty()) {
+                co_return std::nullopt;
+            }
+            if (trim_reshape_job_to_round_size(desc, t.schema(), _cm.offstrategy_round_size())) {
+                cmlog.debug("Limited off-strategy compaction round of {} to {} sstables", t, desc.sstables.size());
+            }
+            co_return std::make_optional(std::move(desc));
         };
 
         std::exception_ptr err;
-        while (auto desc = co_await get_next_job()) {
-            auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(&t), desc->sstables);
-            auto on_replace = compacting.update_on_sstable_replacement();
-
+        std::optional<semaphore_units<named_semaphore_exception_factory>> units;
+        for (;;) {
             try {
+                units.reset();
+                // Waiting for the other tables' rounds doesn't count as compacting.
+                switch_state(state::pending);
+                units = co_await acquire_round();
+                switch_state(state::active);
+                auto desc = co_await get_next_job();
+                if (!desc) {
+                    break;
+                }
+                auto compacting = compacting_sstable_registration(_cm, _cm.get_compaction_state(&t), desc->sstables);
+                auto on_replace = compacting.update_on_sstable_replacement();
+
                 sstables::compaction_result _ = co_await compact_sstables(std::move(*desc), _compaction_data, on_replace,
                                                                           compaction_manager::can_purge_tombstones::no,
                                                                           sstables::offstrategy::yes);
@@ -1638,6 +1829,24 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
         }
     }
 
+    // Off-strategy compactions of different tables take turns, a round at a
+    // time. The next round goes to the table with the highest read amplification,
+    // i.e. whose reads its maintenance set slows down the most.
+    future<semaphore_units<named_semaphore_exception_factory>> acquire_round() {
+        for (;;) {
+            _cm._offstrategy_waiters[this] = _compacting_table->read_amplification();
+            auto units = co_await std::invoke([this] () -> future<semaphore_units<named_semaphore_exception_factory>> {
+                auto deregister = defer([this] () noexcept { _cm._offstrategy_waiters.erase(this); });
+                co_return co_await acquire_semaphore(_cm._off_strategy_sem);
+            });
+            if (!has_more_urgent_offstrategy_waiter(_cm._offstrategy_waiters, _compacting_table->read_amplification())) {
+                co_return units;
+            }
+            // The semaphore is FIFO, so releasing the units lets the more urgent
+            // waiter go first, and we queue up again behind it.
+        }
+    }
+
     future<size_t> maintenance_set_size() const {
         auto maintenance_set = co_await _compacting_table->maintenance_sstable_set();
         co_return maintenance_set->size();
@@ -1647,11 +1856,6 @@ class offstrategy_compaction_task_executor : public compaction_task_executor, pu
         co_await coroutine::switch_to(_cm.maintenance_sg());
 
         for (;;) {
-            if (!can_proceed()) {
-                co_return std::nullopt;
-            }
-            switch_state(state::pending);
-            auto units = co_await acquire_semaphore(_cm._off_strategy_sem);
             if (!can_proceed()) {
                 co_return std::nullopt;
             }
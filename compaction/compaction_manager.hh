@@ -23,6 +23,7 @@
 #include "utils/serialized_action.hh"
 #include <vector>
 #include <functional>
+#include <limits>
 #include "compaction.hh"
 #include "compaction_backlog_manager.hh"
 #include "compaction/compaction_descriptor.hh"
@@ -35,7 +36,9 @@
 #include "tombstone_gc.hh"
 #include "utils/pluggable.hh"
 #include "compaction/compaction_reenabler.hh"
+#include "compaction/compaction_disk_space_reservation.hh"
 #include "utils/disk_space_monitor.hh"
+#include "utils/estimated_histogram.hh"
 
 namespace db {
 class compaction_history_entry;
@@ -74,6 +77,13 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         int64_t completed_tasks = 0;
         uint64_t active_tasks = 0; // Number of compaction going on.
         int64_t errors = 0;
+        // Single sstable compactions scheduled to drop tombstones, with the number
+        // of tombstones they were estimated to purge and the number they purged.
+        uint64_t tombstone_compactions = 0;
+        uint64_t tombstone_compaction_estimated_purges = 0;
+        uint64_t tombstone_compaction_purges = 0;
+        // Compactions postponed because the disk space for their output couldn't be reserved.
+        uint64_t disk_space_postponed_compactions = 0;
     };
     using scheduling_group = backlog_controller::scheduling_group;
     struct config {
@@ -83,6 +93,9 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
         std::chrono::seconds flush_all_tables_before_major = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::days(1));
+        utils::updateable_value<uint32_t> major_compaction_parallel_subranges = utils::updateable_value<uint32_t>(1);
+        utils::updateable_value<uint32_t> read_latency_target_ms = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> offstrategy_round_size_in_mb = utils::updateable_value<uint32_t>(0);
     };
 
 public:
@@ -129,6 +142,9 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     condition_variable _postponed_reevaluation;
     // tables that wait for compaction but had its submission postponed due to ongoing compaction.
     std::unordered_set<compaction::compaction_group_view*> _postponed;
+    // Virtual time of the compaction most recently started, tables which
+    // didn't compact for a while start from it, so they can't hoard credit.
+    double _compaction_virtual_time = 0;
     // tracks taken weights of ongoing compactions, only one compaction per weight is allowed.
     // weight is value assigned to a compaction job that is log base N of total size of all input sstables.
     std::unordered_set<int> _weight_tracker;
@@ -143,6 +159,10 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     // all tables, to limit space requirement and protect against candidates
     // being picked more than once.
     seastar::named_semaphore _off_strategy_sem = {1, named_semaphore_exception_factory{"off-strategy compaction"}};
+    // Off-strategy compactions waiting for _off_strategy_sem to run their next
+    // round, with the read amplification of their tables. The semaphore is taken
+    // per round, so that rounds of different tables interleave.
+    std::unordered_map<const void*, double> _offstrategy_waiters;
 
     utils::pluggable<db::system_keyspace> _sys_ks;
 
@@ -161,6 +181,8 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     serialized_action _update_compaction_static_shares_action;
     utils::observer<float> _compaction_static_shares_observer;
     uint64_t _validation_errors = 0;
+    // Latency of the local reads since the last adjustment of the compaction controller.
+    utils::time_estimated_histogram _read_latency;
 
     class strategy_control;
     std::unique_ptr<strategy_control> _strategy_control;
@@ -172,6 +194,14 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     tombstone_gc_state _tombstone_gc_state;
 
     utils::disk_space_monitor::subscription _out_of_space_subscription;
+    utils::disk_space_monitor::signal_connection_type _disk_space_listener;
+    // The disk space this shard's compactions may use for their output, before
+    // the disk reaches critical_disk_utilization_level. Disengaged when the
+    // disk space isn't monitored, then the reservations aren't limited.
+    std::optional<uint64_t> _disk_space_budget;
+    // Sum of the reservations of ongoing compactions, including the part of
+    // them their output already takes on disk.
+    uint64_t _reserved_disk_space = 0;
 private:
     // Requires task->_compaction_state.gate to be held and task to be registered in _tasks.
     future<compaction_stats_opt> perform_task(shared_ptr<compaction::compaction_task_executor> task, throw_if_stopping do_throw_if_stopping);
@@ -202,6 +232,8 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
     // Deregister weight for a table.
     void deregister_weight(int weight);
 
+    void release_disk_space(uint64_t size) noexcept;
+
     // Get candidates for compaction strategy, which are all sstables but the ones being compacted.
     future<std::vector<sstables::shared_sstable>> get_candidates(compaction::compaction_group_view& t) const;
 
@@ -299,6 +331,44 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
         return _cfg.flush_all_tables_before_major;
     }
 
+    unsigned major_compaction_parallel_subranges() const noexcept {
+        return std::max(_cfg.major_compaction_parallel_subranges(), uint32_t(1));
+    }
+
+    std::chrono::milliseconds read_latency_target() const noexcept {
+        return std::chrono::milliseconds(_cfg.read_latency_target_ms.get());
+    }
+
+    // The limit of the input of a round of off-strategy compaction, in bytes.
+    uint64_t offstrategy_round_size() const noexcept {
+        auto mb = _cfg.offstrategy_round_size_in_mb.get();
+        return mb ? uint64_t(mb) << 20 : std::numeric_limits<uint64_t>::max();
+    }
+
+    // The disk space left for compaction output once the ongoing compactions
+    // got theirs, or nullopt if it isn't limited.
+    std::optional<uint64_t> available_disk_space() const noexcept;
+
+    uint64_t reserved_disk_space() const noexcept {
+        return _reserved_disk_space;
+    }
+
+    // Reserves the disk space for the output of a compaction job, before it
+    // starts. Returns nullopt if there is not enough space left, then the job
+    // should wait for other compactions to release theirs, or pick a smaller
+    // one.
+    std::optional<compaction_disk_space_reservation> try_reserve_disk_space(uint64_t size);
+
+    // Sets the disk space this shard's compactions may use for their output.
+    // Updated by the disk space monitor, exposed for testing.
+    void set_disk_space_budget(std::optional<uint64_t> budget) noexcept;
+
+    // Feeds the compaction controller with the latency of a local read,
+    // see compaction_read_latency_target_ms.
+    void note_read_latency(std::chrono::steady_clock::duration latency) noexcept {
+        _read_latency.add(latency);
+    }
+
     void register_metrics();
 
     // enable the compaction manager.
@@ -470,6 +540,7 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
 
     friend class compacting_sstable_registration;
     friend class compaction_weight_registration;
+    friend class compaction_disk_space_reservation;
     friend class sstables::test_env_compaction_manager;
 
     friend class compaction::compaction_task_impl;
@@ -488,6 +559,18 @@ class compaction_manager: public peering_sharded_service<compaction_manager> {
 
 namespace compaction {
 
+// Limits a reshape job to a round of about round_size bytes of input, so its
+// output replaces its input for reads without waiting for the rest of the
+// maintenance set to be reshaped. Only jobs whose output can be integrated
+// without the rest of their input are trimmed: level 0 jobs and jobs with
+// disjoint input. The sstables with the lowest first keys are kept, at least
+// two of them. Returns whether the job was trimmed.
+bool trim_reshape_job_to_round_size(sstables::compaction_descriptor& desc, const schema_ptr& schema, uint64_t round_size);
+
+// Whether an off-strategy compaction of a table with the given read
+// amplification should let one of the waiters run its round first.
+bool has_more_urgent_offstrategy_waiter(const std::unordered_map<const void*, double>& waiters, double read_amplification);
+
 class compaction_task_executor
     : public enable_shared_from_this<compaction_task_executor>
     , public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -511,6 +594,8 @@ class compaction_task_executor
     ::compaction::compaction_group_view* _compacting_table = nullptr;
     compaction::compaction_state& _compaction_state;
     sstables::compaction_data _compaction_data;
+    // The disk space reserved for the output of the ongoing compaction, if any.
+    std::optional<compaction_disk_space_reservation> _disk_space_reservation;
     state _state = state::none;
     throw_if_stopping _do_throw_if_stopping;
     sstables::compaction_progress_monitor _progress_monitor;
@@ -599,6 +684,15 @@ class compaction_task_executor
         return _compaction_data;
     }
 
+    // The part of the disk space reservation of the ongoing compaction which
+    // its output already takes on disk.
+    uint64_t written_disk_space_reservation() const noexcept {
+        if (!_disk_space_reservation) {
+            return 0;
+        }
+        return std::min(_disk_space_reservation->size(), _compaction_data.output_bytes_written);
+    }
+
     bool generating_output_run() const noexcept {
         return compaction_running() && _output_run_identifier;
     }
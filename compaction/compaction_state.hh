@@ -53,6 +53,11 @@ struct compaction_state {
 
     gc_clock::time_point last_regular_compaction;
 
+    // Virtual time of the fair queueing of regular compaction across tables,
+    // advanced by the bytes compacted divided by the read amplification of
+    // the table. See compaction_manager::postponed_compactions_reevaluation().
+    double virtual_time = 0;
+
     explicit compaction_state(compaction_group_view& t);
     compaction_state(compaction_state&&) = delete;
     ~compaction_state();
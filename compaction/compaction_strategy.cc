@@ -73,6 +73,26 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const shared_sstable& s
     return droppable_ratio >= _tombstone_threshold;
 }
 
+compaction_descriptor compaction_strategy_impl::make_tombstone_compaction_job(const std::vector<shared_sstable>& candidates,
+        gc_clock::time_point compaction_time, const compaction_group_view& t, int level) {
+    shared_sstable best;
+    double best_droppable = 0;
+    for (auto& sst : candidates) {
+        auto droppable = sst->estimate_droppable_tombstones(compaction_time, t.get_tombstone_gc_state(), t.schema());
+        if (!best || droppable > best_droppable
+                || (droppable == best_droppable && sst->get_stats_metadata().min_timestamp < best->get_stats_metadata().min_timestamp)) {
+            best = sst;
+            best_droppable = droppable;
+        }
+    }
+    if (!best) {
+        return compaction_descriptor();
+    }
+    auto desc = compaction_descriptor({ best }, level);
+    desc.estimated_droppable_tombstones = best_droppable;
+    return desc;
+}
+
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const {
     return partition_estimate;
 }
@@ -642,6 +662,7 @@ time_window_compaction_strategy::time_window_compaction_strategy(const std::map<
     : compaction_strategy_impl(options)
     , _options(options)
     , _stcs_options(options)
+    , _ics_options(options)
 {
     if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)) {
         _disable_tombstone_compaction = true;
@@ -749,6 +770,10 @@ bool compaction_strategy::use_interposer_consumer() const {
     return _compaction_strategy_impl->use_interposer_consumer();
 }
 
+uint64_t compaction_strategy::max_sstable_size() const {
+    return _compaction_strategy_impl->max_sstable_size();
+}
+
 compaction_strategy make_compaction_strategy(compaction_strategy_type strategy, const std::map<sstring, sstring>& options) {
     ::shared_ptr<compaction_strategy_impl> impl;
 
@@ -116,6 +116,10 @@ class compaction_strategy {
     // Returns whether or not interposer consumer is used by a given strategy.
     bool use_interposer_consumer() const;
 
+    // Returns the size of the sstables of the runs the strategy compacts data
+    // into, or the maximum uint64_t if it doesn't split its output.
+    uint64_t max_sstable_size() const;
+
     // Informs the caller (usually the compaction manager) about what would it take for this set of
     // SSTables closer to becoming in-strategy. If this returns an empty compaction descriptor, this
     // means that the sstable set is already in-strategy.
@@ -66,6 +66,14 @@ class compaction_strategy_impl {
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const compaction_group_view& t);
 
+    // Makes a job for the tombstone compaction of the candidate which is expected
+    // to benefit reads the most, the one with the most droppable tombstones. Ties
+    // go to the oldest candidate, whose tombstones are the least likely to shadow
+    // data in other sstables, which would prevent their purge.
+    // The candidates have to be worth dropping tombstones from.
+    static compaction_descriptor make_tombstone_compaction_job(const std::vector<shared_sstable>& candidates,
+            gc_clock::time_point compaction_time, const compaction_group_view& t, int level = compaction_descriptor::default_level);
+
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const = 0;
 
     virtual uint64_t adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const;
@@ -88,6 +96,12 @@ class compaction_strategy_impl {
         return false;
     }
 
+    // The size of the sstables the strategy compacts data into, if it splits
+    // its output into runs of sstables.
+    virtual uint64_t max_sstable_size() const {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const;
 };
 }
@@ -55,26 +55,29 @@ class incremental_compaction_strategy : public compaction_strategy_impl {
     std::optional<double> _space_amplification_goal;
     static std::vector<sstable_run_and_length> create_run_and_length_pairs(const std::vector<sstables::frozen_sstable_run>& runs);
 
-    static std::vector<std::vector<sstables::frozen_sstable_run>> get_buckets(const std::vector<sstables::frozen_sstable_run>& runs, const incremental_compaction_strategy_options& options);
-
     std::vector<std::vector<sstables::frozen_sstable_run>> get_buckets(const std::vector<sstables::frozen_sstable_run>& runs) const {
         return get_buckets(runs, _options);
     }
 
-    std::vector<sstables::frozen_sstable_run>
-    most_interesting_bucket(std::vector<std::vector<sstables::frozen_sstable_run>> buckets, size_t min_threshold, size_t max_threshold);
-
-    uint64_t avg_size(std::vector<sstables::frozen_sstable_run>& runs) const;
-
     static bool is_bucket_interesting(const std::vector<sstables::frozen_sstable_run>& bucket, size_t min_threshold);
 
     bool is_any_bucket_interesting(const std::vector<std::vector<sstables::frozen_sstable_run>>& buckets, size_t min_threshold) const;
 
     compaction_descriptor find_garbage_collection_job(const compaction_group_view& t, std::vector<size_bucket_t>& buckets);
 
+    static void sort_run_bucket_by_first_key(size_bucket_t& bucket, size_t max_elements, const schema_ptr& schema);
+public:
+    // Also used by time_window_compaction_strategy, for compacting the
+    // sstable runs within its windows.
+    static std::vector<std::vector<sstables::frozen_sstable_run>> get_buckets(const std::vector<sstables::frozen_sstable_run>& runs, const incremental_compaction_strategy_options& options);
+
+    static std::vector<sstables::frozen_sstable_run>
+    most_interesting_bucket(std::vector<std::vector<sstables::frozen_sstable_run>> buckets, size_t min_threshold, size_t max_threshold);
+
+    static uint64_t avg_size(std::vector<sstables::frozen_sstable_run>& runs);
+
     static std::vector<shared_sstable> runs_to_sstables(std::vector<frozen_sstable_run> runs);
     static std::vector<frozen_sstable_run> sstables_to_runs(std::vector<shared_sstable> sstables);
-    static void sort_run_bucket_by_first_key(size_bucket_t& bucket, size_t max_elements, const schema_ptr& schema);
 public:
     incremental_compaction_strategy() = default;
 
@@ -94,6 +97,10 @@ class incremental_compaction_strategy : public compaction_strategy_impl {
         return compaction_strategy_type::incremental;
     }
 
+    virtual uint64_t max_sstable_size() const override {
+        return _fragment_size;
+    }
+
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
 
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
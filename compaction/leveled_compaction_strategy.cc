@@ -55,12 +55,7 @@ future<compaction_descriptor> leveled_compaction_strategy::get_sstables_for_comp
         if (sstables.empty()) {
             continue;
         }
-        auto& sst = *std::max_element(sstables.begin(), sstables.end(), [&] (auto& i, auto& j) {
-            auto ratio_i = i->estimate_droppable_tombstone_ratio(compaction_time, table_s.get_tombstone_gc_state(), table_s.schema());
-            auto ratio_j = j->estimate_droppable_tombstone_ratio(compaction_time, table_s.get_tombstone_gc_state(), table_s.schema());
-            return ratio_i < ratio_j;
-        });
-        co_return sstables::compaction_descriptor({ sst }, sst->get_sstable_level());
+        co_return make_tombstone_compaction_job(sstables, compaction_time, table_s, level);
     }
     co_return compaction_descriptor();
 }
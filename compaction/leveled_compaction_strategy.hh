@@ -70,6 +70,10 @@ class leveled_compaction_strategy : public compaction_strategy_impl {
     virtual compaction_strategy_type type() const override {
         return compaction_strategy_type::leveled;
     }
+
+    virtual uint64_t max_sstable_size() const override {
+        return uint64_t(_max_sstable_size_in_mb) * 1024 * 1024;
+    }
     virtual std::unique_ptr<sstable_set_impl> make_sstable_set(const compaction_group_view& ts) const override;
 
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
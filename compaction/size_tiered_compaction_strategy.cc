@@ -207,6 +207,26 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     return std::move(max);
 }
 
+std::vector<sstables::shared_sstable>
+size_tiered_compaction_strategy::trim_bucket_to_disk_space(std::vector<sstables::shared_sstable> bucket, uint64_t available_disk_space, unsigned min_threshold) {
+    auto sizes = bucket | std::views::transform(std::mem_fn(&sstables::sstable::data_size));
+    if (std::ranges::fold_left(sizes, uint64_t(0), std::plus{}) <= available_disk_space) {
+        return bucket;
+    }
+    auto trimmed = bucket;
+    std::ranges::sort(trimmed, std::ranges::less(), std::mem_fn(&sstables::sstable::data_size));
+    uint64_t size = 0;
+    auto it = std::ranges::find_if(trimmed, [&] (const sstables::shared_sstable& sst) {
+        size += sst->data_size();
+        return size > available_disk_space;
+    });
+    trimmed.erase(it, trimmed.end());
+    if (trimmed.size() < min_threshold) {
+        return bucket;
+    }
+    return trimmed;
+}
+
 future<compaction_descriptor>
 size_tiered_compaction_strategy::get_sstables_for_compaction(compaction_group_view& table_s, strategy_control& control) {
     // make local copies so they can't be changed out from under us mid-method
@@ -219,15 +239,24 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(compaction_group_vi
 
     auto buckets = get_buckets(candidates);
 
+    // When the disk space left doesn't fit the output of the whole bucket,
+    // compact its smaller sstables first rather than waiting for the space.
+    auto fit_to_disk_space = [&] (std::vector<sstables::shared_sstable> bucket, unsigned threshold) {
+        if (auto space = control.available_disk_space()) {
+            return trim_bucket_to_disk_space(std::move(bucket), *space, threshold);
+        }
+        return bucket;
+    };
+
     if (is_any_bucket_interesting(buckets, min_threshold)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), min_threshold, max_threshold);
-        co_return sstables::compaction_descriptor(std::move(most_interesting));
+        co_return sstables::compaction_descriptor(fit_to_disk_space(std::move(most_interesting), min_threshold));
     }
 
     // If we are not enforcing min_threshold explicitly, try any pair of SStables in the same tier.
     if (!table_s.compaction_enforce_min_threshold() && is_any_bucket_interesting(buckets, 2)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), 2, max_threshold);
-        co_return sstables::compaction_descriptor(std::move(most_interesting));
+        co_return sstables::compaction_descriptor(fit_to_disk_space(std::move(most_interesting), 2));
     }
 
     if (!table_s.tombstone_gc_enabled()) {
@@ -236,7 +265,7 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(compaction_group_vi
 
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
     // ratio is greater than threshold.
-    // prefer oldest sstables from biggest size tiers because they will be easier to satisfy conditions for
+    // prefer sstables from biggest size tiers because they will be easier to satisfy conditions for
     // tombstone purge, i.e. less likely to shadow even older data.
     for (auto&& sstables : buckets | std::views::reverse) {
         // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
@@ -246,11 +275,7 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(compaction_group_vi
         if (sstables.empty()) {
             continue;
         }
-        // find oldest sstable from current tier
-        auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
-            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
-        });
-        co_return sstables::compaction_descriptor({ *it });
+        co_return make_tombstone_compaction_job(sstables, compaction_time, table_s);
     }
     co_return sstables::compaction_descriptor();
 }
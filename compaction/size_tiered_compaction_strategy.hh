@@ -92,6 +92,12 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
     most_interesting_bucket(const std::vector<sstables::shared_sstable>& candidates, int min_threshold, int max_threshold,
         size_tiered_compaction_strategy_options options = {});
 
+    // Drops the largest sstables of a bucket until the output of its
+    // compaction fits in the available disk space. Returns the bucket as is
+    // if less than min_threshold sstables would remain.
+    static std::vector<sstables::shared_sstable>
+    trim_bucket_to_disk_space(std::vector<sstables::shared_sstable> bucket, uint64_t available_disk_space, unsigned min_threshold);
+
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
 
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
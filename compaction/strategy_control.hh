@@ -21,6 +21,12 @@ class strategy_control {
     virtual bool has_ongoing_compaction(compaction_group_view& table_s) const noexcept = 0;
     virtual future<std::vector<sstables::shared_sstable>> candidates(compaction_group_view&) const = 0;
     virtual future<std::vector<sstables::frozen_sstable_run>> candidates_as_runs(compaction_group_view&) const = 0;
+    // The disk space which can be reserved for the output of a new job, or
+    // nullopt if it isn't limited. Strategies which can pick a smaller job
+    // when the one they'd pick doesn't fit, should.
+    virtual std::optional<uint64_t> available_disk_space() const noexcept {
+        return std::nullopt;
+    }
 };
 
 }
@@ -114,6 +114,24 @@ static time_window_compaction_strategy_options::timestamp_resolutions validate_t
     return timestamp_resolution;
 }
 
+static std::optional<uint64_t> validate_fragment_size(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, incremental_compaction_strategy::FRAGMENT_SIZE_OPTION);
+    if (!tmp_value) {
+        return std::nullopt;
+    }
+    auto fragment_size_in_mb = cql3::statements::property_definitions::to_long(incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, tmp_value, 0);
+    if (fragment_size_in_mb <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, fragment_size_in_mb));
+    }
+    return uint64_t(fragment_size_in_mb) * 1024 * 1024;
+}
+
+static std::optional<uint64_t> validate_fragment_size(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    auto fragment_size = validate_fragment_size(options);
+    unchecked_options.erase(incremental_compaction_strategy::FRAGMENT_SIZE_OPTION);
+    return fragment_size;
+}
+
 time_window_compaction_strategy_options::time_window_compaction_strategy_options(const std::map<sstring, sstring>& options) {
     auto window_unit = validate_compaction_window_unit(options);
     int window_size = validate_compaction_window_size(options);
@@ -121,6 +139,7 @@ time_window_compaction_strategy_options::time_window_compaction_strategy_options
     sstable_window_size = window_size * window_unit;
     expired_sstable_check_frequency = validate_expired_sstable_check_frequency_seconds(options);
     timestamp_resolution = validate_timestamp_resolution(options);
+    fragment_size = validate_fragment_size(options);
 
     auto it = options.find("enable_optimized_twcs_queries");
     if (it != options.end() && it->second == "false") {
@@ -140,6 +159,7 @@ void time_window_compaction_strategy_options::validate(const std::map<sstring, s
     validate_compaction_window_size(options, unchecked_options);
     validate_expired_sstable_check_frequency_seconds(options, unchecked_options);
     validate_timestamp_resolution(options, unchecked_options);
+    validate_fragment_size(options, unchecked_options);
     compaction_strategy_impl::validate_min_max_threshold(options, unchecked_options);
 
     auto it = options.find("enable_optimized_twcs_queries");
@@ -360,9 +380,32 @@ time_window_compaction_strategy::get_sstables_for_compaction(compaction_group_vi
         clogger.debug("[{}] TWCS skipping check for fully expired SSTables", fmt::ptr(this));
     }
 
-    auto compaction_candidates = get_next_non_expired_sstables(table_s, control, std::move(candidates), compaction_time);
-    clogger.debug("[{}] Going to compact {} non-expired sstables", fmt::ptr(this), compaction_candidates.size());
-    co_return compaction_descriptor(std::move(compaction_candidates));
+    auto desc = get_next_non_expired_sstables(table_s, control, std::move(candidates), compaction_time);
+    clogger.debug("[{}] Going to compact {} non-expired sstables", fmt::ptr(this), desc.sstables.size());
+    // Output spanning several windows is segregated by window, into
+    // sstables which cannot form a single run.
+    if (incremental() && is_single_window(desc.sstables)) {
+        desc.max_sstable_bytes = *_options.fragment_size;
+    }
+    co_return desc;
+}
+
+size_t time_window_compaction_strategy::bucket_size(const bucket_t& bucket) const {
+    if (!incremental()) {
+        return bucket.size();
+    }
+    return std::ranges::size(bucket | std::views::transform(std::mem_fn(&sstable::run_identifier)) | std::ranges::to<std::unordered_set>());
+}
+
+bool time_window_compaction_strategy::is_single_window(const std::vector<shared_sstable>& sstables) const {
+    if (sstables.empty()) {
+        return false;
+    }
+    auto window = get_window_for(_options, sstables.front()->get_stats_metadata().max_timestamp);
+    return std::ranges::all_of(sstables, [&] (const shared_sstable& sst) {
+        return get_window_for(_options, sst->get_stats_metadata().min_timestamp) == window
+                && get_window_for(_options, sst->get_stats_metadata().max_timestamp) == window;
+    });
 }
 
 time_window_compaction_strategy::bucket_compaction_mode
@@ -373,25 +416,26 @@ time_window_compaction_strategy::compaction_mode(const time_window_compaction_st
     // space amplification when something like read repair cause small updates to
     // those past windows.
 
-    if (bucket.size() >= 2 && !is_last_active_bucket(bucket_key, now) && state.recent_active_windows.contains(bucket_key)) {
+    auto size = bucket_size(bucket);
+    if (size >= 2 && !is_last_active_bucket(bucket_key, now) && state.recent_active_windows.contains(bucket_key)) {
         return bucket_compaction_mode::major;
-    } else if (bucket.size() >= size_t(min_threshold)) {
+    } else if (size >= size_t(min_threshold)) {
         return bucket_compaction_mode::size_tiered;
     }
     return bucket_compaction_mode::none;
 }
 
-std::vector<shared_sstable>
+compaction_descriptor
 time_window_compaction_strategy::get_next_non_expired_sstables(compaction_group_view& table_s, strategy_control& control,
         std::vector<shared_sstable> non_expiring_sstables, gc_clock::time_point compaction_time) {
     auto most_interesting = get_compaction_candidates(table_s, control, non_expiring_sstables);
 
     if (!most_interesting.empty()) {
-        return most_interesting;
+        return compaction_descriptor(std::move(most_interesting));
     }
 
     if (!table_s.tombstone_gc_enabled()) {
-        return {};
+        return compaction_descriptor();
     }
 
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
@@ -400,12 +444,9 @@ time_window_compaction_strategy::get_next_non_expired_sstables(compaction_group_
         return !worth_dropping_tombstones(sst, compaction_time, table_s);
     });
     if (non_expiring_sstables.empty()) {
-        return {};
+        return compaction_descriptor();
     }
-    auto it = std::ranges::min_element(non_expiring_sstables, [] (auto& i, auto& j) {
-        return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
-    });
-    return { *it };
+    return make_tombstone_compaction_job(non_expiring_sstables, compaction_time, table_s);
 }
 
 std::vector<shared_sstable>
@@ -475,6 +516,17 @@ time_window_compaction_strategy::newest_bucket(compaction_group_view& table_s, s
         }
         switch (compaction_mode(state, bucket, key, now, min_threshold)) {
         case bucket_compaction_mode::size_tiered: {
+            if (incremental()) {
+                // Fragments of a run are not tiered on their own, the runs are.
+                auto ics_interesting_bucket = incremental_compaction_strategy::most_interesting_bucket(
+                        incremental_compaction_strategy::get_buckets(incremental_compaction_strategy::sstables_to_runs(bucket), _ics_options),
+                        min_threshold, max_threshold);
+                if (!ics_interesting_bucket.empty()) {
+                    clogger.debug("bucket size {} >= 2, key {}, performing ICS on what's here", bucket.size(), key);
+                    return incremental_compaction_strategy::runs_to_sstables(std::move(ics_interesting_bucket));
+                }
+                break;
+            }
             // If we're in the newest bucket, we'll use STCS to prioritize sstables.
             auto stcs_interesting_bucket = size_tiered_compaction_strategy::most_interesting_bucket(bucket, min_threshold, max_threshold, _stcs_options);
 
@@ -491,6 +543,9 @@ time_window_compaction_strategy::newest_bucket(compaction_group_view& table_s, s
                 break;
             }
             clogger.debug("bucket size {} >= 2 and not in current bucket, key {}, compacting what's here", bucket.size(), key);
+            if (incremental()) {
+                return trim_runs_to_threshold(std::move(bucket), max_threshold);
+            }
             return trim_to_threshold(std::move(bucket), max_threshold);
         default:
             // windows needing major will remain with major state until they're compacted into one file.
@@ -515,6 +570,15 @@ time_window_compaction_strategy::trim_to_threshold(std::vector<shared_sstable> b
     return bucket;
 }
 
+std::vector<shared_sstable>
+time_window_compaction_strategy::trim_runs_to_threshold(std::vector<shared_sstable> bucket, int max_threshold) {
+    auto runs = incremental_compaction_strategy::sstables_to_runs(std::move(bucket));
+    auto n = std::min(runs.size(), size_t(max_threshold));
+    std::ranges::partial_sort(runs, runs.begin() + n, std::ranges::less(), std::mem_fn(&sstable_run::data_size));
+    runs.resize(n);
+    return incremental_compaction_strategy::runs_to_sstables(std::move(runs));
+}
+
 future<int64_t> time_window_compaction_strategy::estimated_pending_compactions(compaction_group_view& table_s) const {
     auto& state = get_state(table_s);
     auto min_threshold = table_s.min_compaction_threshold();
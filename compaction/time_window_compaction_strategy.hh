@@ -12,6 +12,7 @@
 
 #include "compaction_strategy_impl.hh"
 #include "size_tiered_compaction_strategy.hh"
+#include "incremental_compaction_strategy.hh"
 #include "timestamp.hh"
 #include "sstables/shared_sstable.hh"
 
@@ -46,6 +47,10 @@ class time_window_compaction_strategy_options {
     db_clock::duration expired_sstable_check_frequency = DEFAULT_EXPIRED_SSTABLE_CHECK_FREQUENCY_SECONDS();
     timestamp_resolutions timestamp_resolution = timestamp_resolutions::microsecond;
     bool enable_optimized_twcs_queries{true};
+    // If engaged, the compactions within a window write sstable runs of
+    // fragments of this size, like incremental_compaction_strategy, so that
+    // compacting runs releases their fragments as they're exhausted.
+    std::optional<uint64_t> fragment_size;
 public:
     time_window_compaction_strategy_options(const time_window_compaction_strategy_options&);
     time_window_compaction_strategy_options(time_window_compaction_strategy_options&&);
@@ -54,6 +59,7 @@ class time_window_compaction_strategy_options {
     static void validate(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
 public:
     std::chrono::seconds get_sstable_window_size() const { return sstable_window_size; }
+    const std::optional<uint64_t>& get_fragment_size() const { return fragment_size; }
 
     friend class time_window_compaction_strategy;
     friend class time_window_backlog_tracker;
@@ -70,6 +76,8 @@ struct time_window_compaction_strategy_state {
 class time_window_compaction_strategy : public compaction_strategy_impl {
     time_window_compaction_strategy_options _options;
     size_tiered_compaction_strategy_options _stcs_options;
+    // Tiers the runs within a window, if the windows are compacted incrementally
+    incremental_compaction_strategy_options _ics_options;
 public:
     // The maximum amount of buckets we segregate data into when writing into sstables.
     // To prevent an explosion in the number of sstables we cap it.
@@ -110,7 +118,19 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
     bucket_compaction_mode
     compaction_mode(const time_window_compaction_strategy_state&, const bucket_t& bucket, api::timestamp_type bucket_key, api::timestamp_type now, size_t min_threshold) const;
 
-    std::vector<shared_sstable>
+    bool incremental() const {
+        return bool(_options.fragment_size);
+    }
+
+    // The number of sstables in the bucket, or of sstable runs if the
+    // windows are compacted incrementally.
+    size_t bucket_size(const bucket_t& bucket) const;
+
+    // Returns true if all data of the sstables falls into one window, so
+    // that compacting them writes a single run.
+    bool is_single_window(const std::vector<shared_sstable>& sstables) const;
+
+    compaction_descriptor
     get_next_non_expired_sstables(compaction_group_view& table_s, strategy_control& control, std::vector<shared_sstable> non_expiring_sstables, gc_clock::time_point compaction_time);
 
     std::vector<shared_sstable> get_compaction_candidates(compaction_group_view& table_s, strategy_control& control, std::vector<shared_sstable> candidate_sstables);
@@ -132,6 +152,10 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
     static std::vector<shared_sstable>
     trim_to_threshold(std::vector<shared_sstable> bucket, int max_threshold);
 
+    // Like trim_to_threshold(), but keeps the smallest runs, whole.
+    static std::vector<shared_sstable>
+    trim_runs_to_threshold(std::vector<shared_sstable> bucket, int max_threshold);
+
     static int64_t
     get_window_for(const time_window_compaction_strategy_options& options, api::timestamp_type ts) {
         return get_window_lower_bound(options.sstable_window_size, to_timestamp_type(options.timestamp_resolution, ts));
@@ -449,6 +449,7 @@ scylla_tests = set([
     'test/boost/allocation_strategy_test',
     'test/boost/alternator_unit_test',
     'test/boost/anchorless_list_test',
+    'test/boost/audit_queue_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
     'test/boost/big_decimal_test',
@@ -474,6 +475,7 @@ scylla_tests = set([
     'test/boost/compress_test',
     'test/boost/config_test',
     'test/boost/continuous_data_consumer_test',
+    'test/boost/counter_cache_test',
     'test/boost/counter_test',
     'test/boost/cql_auth_syntax_test',
     'test/boost/crc_test',
@@ -513,8 +515,11 @@ scylla_tests = set([
     'test/boost/lister_test',
     'test/boost/locator_topology_test',
     'test/boost/log_heap_test',
+    'test/boost/logalloc_hugepage_arena_segment_pool_backend_test',
     'test/boost/logalloc_standard_allocator_segment_pool_backend_test',
     'test/boost/logalloc_test',
+    'test/boost/loser_tree_test',
+    'test/boost/maintenance_shares_controller_test',
     'test/boost/managed_bytes_test',
     'test/boost/managed_vector_test',
     'test/boost/map_difference_test',
@@ -525,13 +530,18 @@ scylla_tests = set([
     'test/boost/mutation_test',
     'test/boost/mvcc_test',
     'test/boost/nonwrapping_interval_test',
+    'test/boost/object_storage_cache_test',
     'test/boost/observable_test',
     'test/boost/partitioner_test',
+    'test/boost/paxos_state_cache_test',
     'test/boost/pretty_printers_test',
     'test/boost/radix_tree_test',
+    'test/boost/raft_message_batcher_test',
     'test/boost/range_tombstone_list_test',
     'test/boost/rate_limiter_test',
     'test/boost/recent_entries_map_test',
+    'test/boost/replica_latency_tracker_test',
+    'test/boost/replica_phi_accrual_detector_test',
     'test/boost/reservoir_sampling_test',
     'test/boost/result_utils_test',
     'test/boost/reusable_buffer_test',
@@ -599,6 +609,7 @@ scylla_tests = set([
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_reads',
+    'test/perf/perf_read_layers',
     'test/perf/logalloc',
     'test/perf/perf_s3_client',
     'test/unit/lsa_async_eviction_test',
@@ -614,6 +625,7 @@ perf_tests = set([
     'test/perf/perf_checksum',
     'test/perf/perf_mutation_fragment',
     'test/perf/perf_idl',
+    'test/perf/perf_utf8',
     'test/perf/perf_vint',
     'test/perf/perf_big_decimal',
     'test/perf/perf_sort_by_proximity',
@@ -621,6 +633,8 @@ perf_tests = set([
 
 perf_standalone_tests = set([
      'test/perf/perf_generic_server',
+     'test/perf/perf_multi_raft',
+     'test/perf/perf_raft',
 ])
 
 raft_tests = set([
@@ -790,7 +804,9 @@ scylla_core = (['message/messaging_service.cc',
                 'replica/exceptions.cc',
                 'replica/dirty_memory_manager.cc',
                 'replica/mutation_dump.cc',
+                'replica/counter_cache.cc',
                 'mutation/atomic_cell.cc',
+                'mutation/cell_value_pool.cc',
                 'mutation/canonical_mutation.cc',
                 'mutation/frozen_mutation.cc',
                 'mutation/mutation.cc',
@@ -849,6 +865,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstables_manager.cc',
                 'sstables/sstable_set.cc',
                 'sstables/storage.cc',
+                'sstables/object_storage_cache.cc',
                 'sstables/mx/partition_reversing_data_source.cc',
                 'sstables/mx/reader.cc',
                 'sstables/mx/writer.cc',
@@ -872,11 +889,13 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/m_format_read_helpers.cc',
                 'sstables/sstable_directory.cc',
                 'sstables/random_access_reader.cc',
+                'sstables/resume_positions.cc',
                 'sstables/metadata_collector.cc',
                 'sstables/writer.cc',
                 'sstables/trie/bti_key_translation.cc',
                 'sstables/trie/bti_node_reader.cc',
                 'sstables/trie/bti_node_sink.cc',
+                'sstables/trie/bti_partition_index.cc',
                 'sstables/trie/trie_writer.cc',
                 'transport/cql_protocol_extension.cc',
                 'transport/event.cc',
@@ -926,6 +945,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/statements/drop_function_statement.cc',
                 'cql3/statements/drop_aggregate_statement.cc',
                 'cql3/statements/schema_altering_statement.cc',
+                'cql3/statements/schema_batch_statement.cc',
                 'cql3/statements/ks_prop_defs.cc',
                 'cql3/statements/function_statement.cc',
                 'cql3/statements/modification_statement.cc',
@@ -981,16 +1001,22 @@ scylla_core = (['message/messaging_service.cc',
                 'service/migration_manager.cc',
                 'service/tablet_allocator.cc',
                 'service/storage_proxy.cc',
+                'service/replica_latency_tracker.cc',
+                'service/replica_phi_accrual_detector.cc',
+                'service/maintenance_shares_controller.cc',
                 'query_ranges_to_vnodes.cc',
                 'service/mapreduce_service.cc',
                 'service/paxos/proposal.cc',
                 'service/paxos/prepare_response.cc',
                 'service/paxos/paxos_state.cc',
+                'service/paxos/paxos_state_cache.cc',
                 'service/paxos/prepare_summary.cc',
                 'cql3/column_identifier.cc',
                 'cql3/column_specification.cc',
                 'cql3/constants.cc',
                 'cql3/query_processor.cc',
+                'cql3/query_result_cache.cc',
+                'cql3/unprepared_statements_cache.cc',
                 'cql3/query_options.cc',
                 'cql3/user_types.cc',
                 'cql3/untyped_result_set.cc',
@@ -1001,6 +1027,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/result_set.cc',
                 'cql3/prepare_context.cc',
                 'db/batchlog_manager.cc',
+                'db/cache_warmer.cc',
                 'db/corrupt_data_handler.cc',
                 'db/commitlog/commitlog.cc',
                 'db/commitlog/commitlog_entry.cc',
@@ -1012,10 +1039,12 @@ scylla_core = (['message/messaging_service.cc',
                 'db/extensions.cc',
                 'db/functions/function.cc',
                 'db/heat_load_balance.cc',
+                'db/hot_partitions.cc',
                 'db/hints/host_filter.cc',
                 'db/hints/internal/hint_endpoint_manager.cc',
                 'db/hints/internal/hint_sender.cc',
                 'db/hints/internal/hint_storage.cc',
+                'db/hints/internal/replay_rate_limiter.cc',
                 'db/hints/manager.cc',
                 'db/hints/resource_manager.cc',
                 'db/hints/sync_point.cc',
@@ -1151,6 +1180,7 @@ scylla_core = (['message/messaging_service.cc',
                 'repair/repair.cc',
                 'repair/row_level.cc',
                 'repair/incremental.cc',
+                'repair/hash_tree.cc',
                 'streaming/table_check.cc',
                 'exceptions/exceptions.cc',
                 'auth/allow_all_authenticator.cc',
@@ -1176,10 +1206,12 @@ scylla_core = (['message/messaging_service.cc',
                 'auth/saslauthd_authenticator.cc',
                 'tracing/tracing.cc',
                 'tracing/trace_keyspace_helper.cc',
+                'tracing/trace_ring_buffer_helper.cc',
                 'tracing/trace_state.cc',
                 'tracing/traced_file.cc',
                 'table_helper.cc',
                 'audit/audit.cc',
+                'audit/audit_queue.cc',
                 'audit/audit_cf_storage_helper.cc',
                 'audit/audit_syslog_storage_helper.cc',
                 'tombstone_gc_options.cc',
@@ -1215,6 +1247,8 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/ascii.cc',
                 'utils/like_matcher.cc',
                 'utils/error_injection.cc',
+                'utils/cpu_sampler.cc',
+                'utils/scheduling_group_stats.cc',
                 'utils/build_id.cc',
                 'mutation_writer/timestamp_based_splitting_writer.cc',
                 'mutation_writer/shard_based_splitting_writer.cc',
@@ -1230,6 +1264,8 @@ scylla_core = (['message/messaging_service.cc',
                 'service/raft/group0_state_machine.cc',
                 'service/raft/group0_state_machine_merger.cc',
                 'service/raft/group0_voter_handler.cc',
+                'service/raft/raft_message_batcher.cc',
+                'service/raft/raft_segment_log.cc',
                 'service/raft/raft_sys_table_storage.cc',
                 'serializer.cc',
                 'release.cc',
@@ -1411,6 +1447,7 @@ scylla_perfs = ['test/perf/perf_alternator.cc',
                 'test/perf/perf_row_cache_update.cc',
                 'test/perf/perf_simple_query.cc',
                 'test/perf/perf_sstable.cc',
+                'test/perf/perf_sustained_write.cc',
                 'test/perf/perf_tablets.cc',
                 'test/perf/tablet_load_balancing.cc',
                 'test/perf/perf.cc',
@@ -1451,11 +1488,13 @@ pure_boost_tests = set([
     'test/boost/keys_test',
     'test/boost/like_matcher_test',
     'test/boost/linearizing_input_stream_test',
+    'test/boost/loser_tree_test',
     'test/boost/map_difference_test',
     'test/boost/nonwrapping_interval_test',
     'test/boost/observable_test',
     'test/boost/wrapping_interval_test',
     'test/boost/range_tombstone_list_test',
+    'test/boost/replica_phi_accrual_detector_test',
     'test/boost/reservoir_sampling_test',
     'test/boost/serialization_test',
     'test/boost/small_vector_test',
@@ -1570,6 +1609,8 @@ deps['test/boost/combined_tests'] += [
     'test/boost/sstable_set_test.cc',
     'test/boost/statement_restrictions_test.cc',
     'test/boost/storage_proxy_test.cc',
+    'test/boost/stream_manager_test.cc',
+    'test/boost/streaming_consumer_test.cc',
     'test/boost/tablets_test.cc',
     'test/boost/tracing_test.cc',
     'test/boost/user_function_test.cc',
@@ -1606,12 +1647,14 @@ deps['test/boost/summary_test'] = ['test/boost/summary_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
 deps['test/perf/perf_commitlog'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
+deps['test/perf/perf_read_layers'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/boost/reusable_buffer_test'] = [
     "test/boost/reusable_buffer_test.cc",
     "test/lib/log.cc",
 ]
-deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'test/boost/utf8_test.cc']
+deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'utils/ascii.cc', 'test/boost/utf8_test.cc']
 deps['test/boost/small_vector_test'] = ['test/boost/small_vector_test.cc']
+deps['test/boost/loser_tree_test'] = ['test/boost/loser_tree_test.cc']
 deps['test/boost/vint_serialization_test'] = ['test/boost/vint_serialization_test.cc', 'vint-serialization.cc', 'bytes.cc']
 deps['test/boost/linearizing_input_stream_test'] = [
     "test/boost/linearizing_input_stream_test.cc",
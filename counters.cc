@@ -260,3 +260,26 @@ void transform_counter_updates_to_shards(mutation& m, const mutation* current_st
         transform_row_to_shards(column_kind::regular_column, cr.row().cells(), it->row().cells());
     }
 }
+
+bool has_only_live_counter_cells(const mutation& m) {
+    auto& mp = m.partition();
+    if (mp.partition_tombstone() || !mp.row_tombstones().empty()) {
+        return false;
+    }
+    auto all_live = [&s = *m.schema()] (column_kind kind, const row& cells) {
+        bool live = true;
+        cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+            live = live && ac_o_c.as_atomic_cell(s.column_at(kind, id)).is_live();
+        });
+        return live;
+    };
+    if (!all_live(column_kind::static_column, mp.static_row().get())) {
+        return false;
+    }
+    for (auto& cr : mp.clustered_rows()) {
+        if (cr.row().deleted_at() || !all_live(column_kind::regular_column, cr.row().cells())) {
+            return false;
+        }
+    }
+    return true;
+}
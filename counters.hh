@@ -372,6 +372,10 @@ struct counter_cell_mutable_view : basic_counter_cell_view<mutable_view::yes> {
 // If current_state is present it has to be in the same schema as dst.
 void transform_counter_updates_to_shards(mutation& dst, const mutation* current_state, uint64_t clock_offset, locator::host_id local_id);
 
+// Checks whether the counter mutation only writes live cells, i.e. has no
+// tombstones of any kind.
+bool has_only_live_counter_cells(const mutation& m);
+
 template<>
 struct appending_hash<counter_shard_view> {
     template<typename Hasher>
@@ -50,6 +50,7 @@ options {
 #include "cql3/statements/index_prop_defs.hh"
 #include "cql3/statements/raw/use_statement.hh"
 #include "cql3/statements/raw/batch_statement.hh"
+#include "cql3/statements/schema_batch_statement.hh"
 #include "cql3/statements/raw/describe_statement.hh"
 #include "cql3/statements/list_users_statement.hh"
 #include "cql3/statements/grant_statement.hh"
@@ -386,6 +387,7 @@ cqlStatement returns [std::unique_ptr<raw::parsed_statement> stmt]
     | st48=pruneMaterializedViewStatement  { $stmt = std::move(st48); }
     | st49=describeStatement           { $stmt = std::move(st49); }
     | st50=listEffectiveServiceLevelStatement { $stmt = std::move(st50); }
+    | st51=schemaBatchStatement        { $stmt = std::move(st51); }
     ;
 
 /*
@@ -755,6 +757,36 @@ batchStatementObjective returns [::lw_shared_ptr<std::unique_ptr<cql3::statement
     | d=deleteStatement  { $statement = make_lw_shared<original_ret_type>(std::move(d)); }
     ;
 
+/**
+ * BEGIN SCHEMA BATCH
+ *   CREATE TABLE ks.t1 (...);
+ *   CREATE TABLE ks.t2 (...);
+ *   ALTER TABLE ks.t3 ADD c int;
+ *   ...
+ * APPLY BATCH
+ */
+schemaBatchStatement returns [std::unique_ptr<cql3::statements::schema_batch_statement::raw_statement> expr]
+    @init {
+        std::vector<cql3::statements::schema_batch_statement::raw_statement::parsed> statements;
+    }
+    : K_BEGIN K_SCHEMA K_BATCH
+          ( s=schemaBatchStatementObjective ';'?
+              {
+                  statements.push_back({std::move(*$s.statement), sstring{$s.text}});
+              } )*
+      K_APPLY K_BATCH
+      {
+          $expr = std::make_unique<cql3::statements::schema_batch_statement::raw_statement>(std::move(statements));
+      }
+    ;
+
+schemaBatchStatementObjective returns [::lw_shared_ptr<std::unique_ptr<cql3::statements::raw::cf_statement>> statement]
+    @init { using original_ret_type = std::unique_ptr<cql3::statements::raw::cf_statement>; }
+    : c=createTableStatement  { $statement = make_lw_shared<original_ret_type>(std::move(c)); }
+    | a=alterTableStatement   { $statement = make_lw_shared<original_ret_type>(std::move(a)); }
+    | i=createIndexStatement  { $statement = make_lw_shared<original_ret_type>(std::move(i)); }
+    ;
+
 dropAggregateStatement returns [std::unique_ptr<cql3::statements::drop_aggregate_statement> expr]
     @init {
         bool if_exists = false;
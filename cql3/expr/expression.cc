@@ -472,7 +472,11 @@ bool_or_null like(const expression& lhs, const expression& rhs, const evaluation
     bytes lhs_bytes = to_bytes(*lhs_managed_bytes);
     bytes rhs_bytes = to_bytes(*rhs_managed_bytes);
 
-    return like_matcher(bytes_view(rhs_bytes))(bytes_view(lhs_bytes));
+    // The pattern is usually the same for all the rows filtered by a query, so keep
+    // the last compiled one around rather than compiling it for every row.
+    static thread_local like_matcher matcher{bytes_view()};
+    matcher.reset(bytes_view(rhs_bytes));
+    return matcher(bytes_view(lhs_bytes));
 }
 
 /// True iff the column value is in the set defined by rhs.
@@ -8,6 +8,8 @@
  * SPDX-License-Identifier: (LicenseRef-ScyllaDB-Source-Available-1.0 and Apache-2.0)
  */
 
+#include <seastar/core/byteorder.hh>
+
 #include "bytes.hh"
 #include "cql3/description.hh"
 #include "types/types.hh"
@@ -22,8 +24,17 @@
 #include "first_function.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/multiprecision_int.hh"
+#include "utils/fragment_range.hh"
+#include "utils/streaming_histogram.hh"
+#include "utils/xx_hasher.hh"
+#include "sstables/hyperloglog.hh"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <type_traits>
 #include "utils/managed_string.hh"
@@ -43,6 +54,7 @@ class internal_scalar_function : public scalar_function {
     data_type _return_type;
     std::vector<data_type> _arg_types;
     noncopyable_function<bytes_opt (std::span<const bytes_opt> parameters)> _func;
+    std::function<std::unique_ptr<batch_aggregator> (std::span<const bytes_opt>)> _make_batch_aggregator;
 public:
     internal_scalar_function(
             sstring name,
@@ -94,6 +106,14 @@ class internal_scalar_function : public scalar_function {
     virtual sstring column_name(const std::vector<sstring>& column_names) const override {
         return _name.name;
     }
+
+    void set_batch_aggregator_factory(std::function<std::unique_ptr<batch_aggregator> (std::span<const bytes_opt>)> factory) {
+        _make_batch_aggregator = std::move(factory);
+    }
+
+    std::unique_ptr<batch_aggregator> make_batch_aggregator(std::span<const bytes_opt> constant_arguments) const {
+        return _make_batch_aggregator ? _make_batch_aggregator(constant_arguments) : nullptr;
+    }
 };
 
 // Called if any of the inputs is NULL
@@ -167,11 +187,219 @@ narrow(WideT acc) {
 template <typename T>
 using accumulator_for = std::conditional_t<std::is_integral_v<T>, utils::multiprecision_int, T>;
 
+// Number of inputs buffered by a batch_aggregator before they are folded into its accumulator.
+constexpr size_t aggregation_batch_size = 1024;
+
+// Reads a serialized value of a fixed-width type, or returns nullopt for values
+// of a different size (e.g. empty values), which the batched path doesn't handle.
+template <typename T>
+std::optional<T> read_fixed_width(managed_bytes_view v) {
+    if (v.size_bytes() != sizeof(T)) {
+        return std::nullopt;
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        using int_type = std::conditional_t<sizeof(T) == sizeof(int32_t), int32_t, int64_t>;
+        return std::bit_cast<T>(read_simple_exactly<int_type>(v));
+    } else {
+        return read_simple_exactly<T>(v);
+    }
+}
+
+template <typename T>
+std::optional<T> deserialize_state(const bytes_opt& state) {
+    if (!state) {
+        return std::nullopt;
+    }
+    return value_cast<T>(data_type_for<T>()->deserialize_value(*state));
+}
+
+// Sums a batch of integers. The loop has no dependencies other than the
+// accumulators, so it is vectorized.
+template <std::integral T>
+utils::multiprecision_int sum_batch(std::span<const T> values) {
+    static_assert(aggregation_batch_size <= (size_t(1) << 31));
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+        int64_t sum = 0;
+        for (auto v : values) {
+            sum += v;
+        }
+        return utils::multiprecision_int(sum);
+    } else {
+        // Sum the high and the low halves separately, neither of them can
+        // overflow for aggregation_batch_size inputs.
+        int64_t high = 0;
+        int64_t low = 0;
+        for (auto v : values) {
+            high += v >> 32;
+            low += v & 0xffffffff;
+        }
+        return (utils::multiprecision_int(high) << 32) + utils::multiprecision_int(low);
+    }
+}
+
+template <typename T>
+class sum_batch_aggregator final : public batch_aggregator {
+    using Acc = accumulator_for<T>;
+    // Disengaged when the state is null, which sum_step never changes.
+    std::optional<Acc> _acc;
+    std::array<T, aggregation_batch_size> _batch;
+    size_t _batch_len = 0;
+private:
+    void fold() {
+        if constexpr (std::is_floating_point_v<T>) {
+            // Floating-point addition isn't associative, add the inputs in
+            // the same order as sum_step would.
+            for (size_t i = 0; i < _batch_len; ++i) {
+                *_acc += _batch[i];
+            }
+        } else {
+            *_acc += sum_batch(std::span<const T>(_batch.data(), _batch_len));
+        }
+        _batch_len = 0;
+    }
+public:
+    virtual void load(const bytes_opt& state) override {
+        _acc = deserialize_state<Acc>(state);
+        _batch_len = 0;
+    }
+
+    virtual bool add(managed_bytes_view_opt value) override {
+        if (!value || !_acc) {
+            return true;
+        }
+        auto v = read_fixed_width<T>(*value);
+        if (!v) {
+            return false;
+        }
+        _batch[_batch_len++] = *v;
+        if (_batch_len == _batch.size()) {
+            fold();
+        }
+        return true;
+    }
+
+    virtual bytes_opt store() override {
+        if (!_acc) {
+            return std::nullopt;
+        }
+        fold();
+        return data_value(*_acc).serialize();
+    }
+};
+
+// Min or max of an integer type. Comparison of floating-point values has to
+// order NaNs, so they go through the aggregation function instead.
+template <std::integral T, bool Max>
+class min_max_batch_aggregator final : public batch_aggregator {
+    std::optional<T> _acc;
+    std::array<T, aggregation_batch_size> _batch;
+    size_t _batch_len = 0;
+private:
+    void fold() {
+        if (!_batch_len) {
+            return;
+        }
+        auto batch = std::span<const T>(_batch.data(), _batch_len);
+        T v = Max ? std::ranges::max(batch) : std::ranges::min(batch);
+        _acc = !_acc ? v : Max ? std::max(*_acc, v) : std::min(*_acc, v);
+        _batch_len = 0;
+    }
+public:
+    virtual void load(const bytes_opt& state) override {
+        _acc = deserialize_state<T>(state);
+        _batch_len = 0;
+    }
+
+    virtual bool add(managed_bytes_view_opt value) override {
+        if (!value) {
+            return true;
+        }
+        auto v = read_fixed_width<T>(*value);
+        if (!v) {
+            return false;
+        }
+        _batch[_batch_len++] = *v;
+        if (_batch_len == _batch.size()) {
+            fold();
+        }
+        return true;
+    }
+
+    virtual bytes_opt store() override {
+        fold();
+        if (!_acc) {
+            return std::nullopt;
+        }
+        return data_value(*_acc).serialize();
+    }
+};
+
+// count(col) counts non-null inputs of any type, countRows counts all rows,
+// neither has to look at the values.
+template <bool CountRows>
+class count_batch_aggregator final : public batch_aggregator {
+    // Disengaged when the state is null.
+    std::optional<int64_t> _count;
+public:
+    virtual void load(const bytes_opt& state) override {
+        _count = deserialize_state<int64_t>(state);
+    }
+
+    virtual bool add(managed_bytes_view_opt value) override {
+        if (!CountRows && !value) {
+            return true;
+        }
+        if (!_count) {
+            // countRows keeps a null state, but count_step fails on it.
+            return CountRows;
+        }
+        ++*_count;
+        return true;
+    }
+
+    virtual bytes_opt store() override {
+        if (!_count) {
+            return std::nullopt;
+        }
+        return data_value(*_count).serialize();
+    }
+};
+
+template <typename Aggregator>
+shared_ptr<scalar_function>
+with_batch_aggregator(shared_ptr<scalar_function> f) {
+    static_pointer_cast<internal_scalar_function>(f)->set_batch_aggregator_factory([] (std::span<const bytes_opt>) {
+        return std::make_unique<Aggregator>();
+    });
+    return f;
+}
+
+template <bool Max>
+shared_ptr<scalar_function>
+with_min_max_batch_aggregator(shared_ptr<scalar_function> f, const abstract_type& io_type) {
+    switch (io_type.get_kind()) {
+    case abstract_type::kind::byte:
+        return with_batch_aggregator<min_max_batch_aggregator<int8_t, Max>>(std::move(f));
+    case abstract_type::kind::short_kind:
+        return with_batch_aggregator<min_max_batch_aggregator<int16_t, Max>>(std::move(f));
+    case abstract_type::kind::int32:
+        return with_batch_aggregator<min_max_batch_aggregator<int32_t, Max>>(std::move(f));
+    case abstract_type::kind::long_kind:
+        return with_batch_aggregator<min_max_batch_aggregator<int64_t, Max>>(std::move(f));
+    default:
+        return f;
+    }
+}
+
 template <typename Type>
 static
 shared_ptr<aggregate_function>
 make_sum_function() {
     using Acc = accumulator_for<Type>;
+    auto sum_step = make_internal_scalar_function("sum_step", return_accumulator_on_null, [] (Acc acc, Type addend) -> Acc { return acc + addend; });
+    if constexpr (std::is_arithmetic_v<Type>) {
+        sum_step = with_batch_aggregator<sum_batch_aggregator<Type>>(std::move(sum_step));
+    }
     return make_shared<db::functions::aggregate_function>(
         db::functions::stateless_aggregate_function{
             .name = function_name::native_function("sum"),
@@ -179,7 +407,7 @@ make_sum_function() {
             .result_type = data_type_for<Type>(),
             .argument_types = {data_type_for<Type>()},
             .initial_state = data_type_for<accumulator_for<Type>>()->decompose(Acc(0)),
-            .aggregation_function = make_internal_scalar_function("sum_step", return_accumulator_on_null, [] (Acc acc, Type addend) -> Acc { return acc + addend; }),
+            .aggregation_function = std::move(sum_step),
             .state_to_result_function = make_internal_scalar_function("sum_finalizer", return_any_nonnull, [] (Acc acc) -> Type { return narrow<Type>(acc); }),
             .state_reduction_function = make_internal_scalar_function("sum_reducer", return_any_nonnull, [] (Acc a1, Acc a2) -> Acc { return a1 + a2; }),
         }
@@ -293,6 +521,177 @@ struct aggregate_type_for<time_native_type> {
     using type = time_native_type::primary_type;
 };
 
+// Register width of the HyperLogLog sketch of approx_count_distinct(): 2^12 one-byte
+// registers, for a standard error of about 1.6%.
+constexpr uint8_t approx_count_distinct_register_width = 12;
+
+// The state of approx_count_distinct() holds the registers of the sketch. Inputs
+// are hashed in their serialized form.
+hll::HyperLogLog deserialize_hll(const bytes_opt& state) {
+    hll::HyperLogLog hll(approx_count_distinct_register_width);
+    if (state) {
+        hll.restore_registers(std::span(reinterpret_cast<const uint8_t*>(state->data()), state->size()));
+    }
+    return hll;
+}
+
+bytes serialize_hll(const hll::HyperLogLog& hll) {
+    auto registers = hll.registers();
+    return bytes(reinterpret_cast<const int8_t*>(registers.data()), registers.size());
+}
+
+uint64_t hash_for_hll(managed_bytes_view value) {
+    xx_hasher h;
+    for (bytes_view frag : fragment_range(value)) {
+        h.update(reinterpret_cast<const char*>(frag.data()), frag.size());
+    }
+    return h.finalize_uint64();
+}
+
+class approx_count_distinct_batch_aggregator final : public batch_aggregator {
+    hll::HyperLogLog _hll{approx_count_distinct_register_width};
+public:
+    virtual void load(const bytes_opt& state) override {
+        _hll = deserialize_hll(state);
+    }
+
+    virtual bool add(managed_bytes_view_opt value) override {
+        if (value) {
+            _hll.offer_hashed(hash_for_hll(*value));
+        }
+        return true;
+    }
+
+    virtual bytes_opt store() override {
+        return serialize_hll(_hll);
+    }
+};
+
+// Maximum number of bins of the histogram of approx_percentile(), which bounds
+// its state to about 2kB.
+constexpr uint32_t approx_percentile_max_bins = 128;
+
+// The state of approx_percentile() is the requested percentile followed by
+// the bins of the histogram, each of them a point and a count.
+struct percentile_state {
+    double percentile;
+    utils::streaming_histogram histogram{approx_percentile_max_bins};
+};
+
+percentile_state deserialize_percentile_state(bytes_view state) {
+    constexpr size_t bin_size = sizeof(double) + sizeof(uint64_t);
+    if (state.size() < sizeof(double) || (state.size() - sizeof(double)) % bin_size) {
+        on_internal_error(cql3::functions::log, format("approx_percentile: invalid state of {} bytes", state.size()));
+    }
+    auto p = reinterpret_cast<const char*>(state.data());
+    percentile_state ret{std::bit_cast<double>(read_be<uint64_t>(p))};
+    auto end = reinterpret_cast<const char*>(state.data() + state.size());
+    for (p += sizeof(double); p != end; p += bin_size) {
+        ret.histogram.update(std::bit_cast<double>(read_be<uint64_t>(p)), read_be<uint64_t>(p + sizeof(double)));
+    }
+    return ret;
+}
+
+bytes serialize_percentile_state(const percentile_state& state) {
+    constexpr size_t bin_size = sizeof(double) + sizeof(uint64_t);
+    bytes ret(bytes::initialized_later(), sizeof(double) + state.histogram.bin.size() * bin_size);
+    auto p = reinterpret_cast<char*>(ret.data());
+    write_be<uint64_t>(p, std::bit_cast<uint64_t>(state.percentile));
+    p += sizeof(double);
+    for (auto& [point, count] : state.histogram.bin) {
+        write_be<uint64_t>(p, std::bit_cast<uint64_t>(point));
+        write_be<uint64_t>(p + sizeof(double), count);
+        p += bin_size;
+    }
+    return ret;
+}
+
+double validate_percentile(const bytes_opt& percentile) {
+    if (!percentile || percentile->empty()) {
+        throw exceptions::invalid_request_exception("approx_percentile() requires a non-null percentile");
+    }
+    auto p = value_cast<double>(double_type->deserialize_value(*percentile));
+    if (!(p >= 0 && p <= 1)) {
+        throw exceptions::invalid_request_exception(format("approx_percentile() requires a percentile between 0 and 1, got {}", p));
+    }
+    return p;
+}
+
+// Reads an input of approx_percentile(). Returns nullopt for inputs which are
+// ignored: empty values and values which are not finite.
+using percentile_input_reader = std::optional<double> (*)(managed_bytes_view);
+
+template <typename T>
+std::optional<double> read_percentile_input(managed_bytes_view v) {
+    auto x = read_fixed_width<T>(v);
+    if (!x || !std::isfinite(double(*x))) {
+        return std::nullopt;
+    }
+    return double(*x);
+}
+
+percentile_input_reader make_percentile_input_reader(const abstract_type& input_type) {
+    switch (input_type.get_kind()) {
+    case abstract_type::kind::byte:
+        return read_percentile_input<int8_t>;
+    case abstract_type::kind::short_kind:
+        return read_percentile_input<int16_t>;
+    case abstract_type::kind::int32:
+        return read_percentile_input<int32_t>;
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::counter:
+        return read_percentile_input<int64_t>;
+    case abstract_type::kind::float_kind:
+        return read_percentile_input<float>;
+    case abstract_type::kind::double_kind:
+        return read_percentile_input<double>;
+    default:
+        throw exceptions::invalid_request_exception(format("approx_percentile() is not supported for type {}, only for numeric types of fixed width",
+                input_type.as_cql3_type()));
+    }
+}
+
+class approx_percentile_batch_aggregator final : public batch_aggregator {
+    percentile_input_reader _read;
+    bytes_opt _percentile;
+    std::optional<percentile_state> _state;
+public:
+    approx_percentile_batch_aggregator(percentile_input_reader read, bytes_opt percentile)
+        : _read(read)
+        , _percentile(std::move(percentile))
+    { }
+
+    virtual void load(const bytes_opt& state) override {
+        _state.reset();
+        if (state) {
+            _state = deserialize_percentile_state(*state);
+        }
+    }
+
+    virtual bool add(managed_bytes_view_opt value) override {
+        if (!value) {
+            return true;
+        }
+        auto v = _read(*value);
+        if (!v) {
+            return true;
+        }
+        if (!_state) {
+            // Validated only once there is an input, like approx_percentile_step does.
+            _state = percentile_state{validate_percentile(_percentile)};
+        }
+        _state->histogram.update(*v);
+        return true;
+    }
+
+    virtual bytes_opt store() override {
+        if (!_state) {
+            return std::nullopt;
+        }
+        return serialize_percentile_state(*_state);
+    }
+};
+
 } // anonymous namespace
 
 /**
@@ -310,7 +709,7 @@ aggregate_fcts::make_count_function(data_type input_type) {
             .result_type = long_type,
             .argument_types = {input_type},
             .initial_state = data_value(int64_t(0)).serialize(),
-            .aggregation_function = ::make_shared<internal_scalar_function>(
+            .aggregation_function = with_batch_aggregator<count_batch_aggregator<false>>(::make_shared<internal_scalar_function>(
                     "count_step",
                     long_type,
                     std::vector<data_type>({long_type, input_type}),
@@ -321,12 +720,119 @@ aggregate_fcts::make_count_function(data_type input_type) {
                         auto count = value_cast<int64_t>(long_type->deserialize(*args[0]));
                         count += 1;
                         return data_value(count).serialize();
-                    }),
+                    })),
             .state_to_result_function = make_internal_scalar_function("count_finalizer", return_any_nonnull, [] (int64_t count) { return count; }),
             .state_reduction_function = make_internal_scalar_function("count_reducer", return_any_nonnull, [] (int64_t c1, int64_t c2) { return c1 + c2; }),
         });
 }
 
+shared_ptr<aggregate_function>
+aggregate_fcts::make_approx_count_distinct_function(data_type input_type) {
+    input_type = input_type->without_reversed().shared_from_this();
+    auto step = ::make_shared<internal_scalar_function>(
+            "approx_count_distinct_step",
+            bytes_type,
+            std::vector<data_type>({bytes_type, input_type}),
+            [] (std::span<const bytes_opt> args) -> bytes_opt {
+                if (!args[1]) {
+                    return args[0];
+                }
+                auto hll = deserialize_hll(args[0]);
+                hll.offer_hashed(hash_for_hll(managed_bytes_view(*args[1])));
+                return serialize_hll(hll);
+            });
+    return make_shared<db::functions::aggregate_function>(
+        db::functions::stateless_aggregate_function{
+            .name = function_name::native_function(APPROX_COUNT_DISTINCT_FUNCTION_NAME),
+            .state_type = bytes_type,
+            .result_type = long_type,
+            .argument_types = {input_type},
+            .initial_state = std::nullopt,
+            .aggregation_function = with_batch_aggregator<approx_count_distinct_batch_aggregator>(std::move(step)),
+            .state_to_result_function = ::make_shared<internal_scalar_function>(
+                    "approx_count_distinct_finalizer",
+                    long_type,
+                    std::vector<data_type>({bytes_type}),
+                    [] (std::span<const bytes_opt> args) -> bytes_opt {
+                        int64_t estimate = args[0] ? std::llround(deserialize_hll(args[0]).estimate()) : 0;
+                        return data_value(estimate).serialize();
+                    }),
+            .state_reduction_function = ::make_shared<internal_scalar_function>(
+                    "approx_count_distinct_reducer",
+                    bytes_type,
+                    std::vector<data_type>({bytes_type, bytes_type}),
+                    [] (std::span<const bytes_opt> args) -> bytes_opt {
+                        if (!args[0] || !args[1]) {
+                            return args[0] ? args[0] : args[1];
+                        }
+                        auto hll = deserialize_hll(args[0]);
+                        hll.merge(deserialize_hll(args[1]));
+                        return serialize_hll(hll);
+                    }),
+        });
+}
+
+shared_ptr<aggregate_function>
+aggregate_fcts::make_approx_percentile_function(data_type input_type) {
+    input_type = input_type->without_reversed().shared_from_this();
+    auto read = make_percentile_input_reader(*input_type);
+    auto step = ::make_shared<internal_scalar_function>(
+            "approx_percentile_step",
+            bytes_type,
+            std::vector<data_type>({bytes_type, input_type, double_type}),
+            [read] (std::span<const bytes_opt> args) -> bytes_opt {
+                if (!args[1]) {
+                    return args[0];
+                }
+                auto v = read(managed_bytes_view(*args[1]));
+                if (!v) {
+                    return args[0];
+                }
+                auto state = args[0] ? deserialize_percentile_state(*args[0]) : percentile_state{validate_percentile(args[2])};
+                state.histogram.update(*v);
+                return serialize_percentile_state(state);
+            });
+    step->set_batch_aggregator_factory([read] (std::span<const bytes_opt> constant_arguments) -> std::unique_ptr<batch_aggregator> {
+        if (constant_arguments.size() != 1) {
+            return nullptr;
+        }
+        return std::make_unique<approx_percentile_batch_aggregator>(read, constant_arguments[0]);
+    });
+    return make_shared<db::functions::aggregate_function>(
+        db::functions::stateless_aggregate_function{
+            .name = function_name::native_function(APPROX_PERCENTILE_FUNCTION_NAME),
+            .state_type = bytes_type,
+            .result_type = double_type,
+            .argument_types = {input_type, double_type},
+            .initial_state = std::nullopt,
+            .aggregation_function = std::move(step),
+            .state_to_result_function = ::make_shared<internal_scalar_function>(
+                    "approx_percentile_finalizer",
+                    double_type,
+                    std::vector<data_type>({bytes_type}),
+                    [] (std::span<const bytes_opt> args) -> bytes_opt {
+                        if (!args[0]) {
+                            return std::nullopt;
+                        }
+                        auto state = deserialize_percentile_state(*args[0]);
+                        return data_value(state.histogram.quantile(state.percentile)).serialize();
+                    }),
+            .state_reduction_function = ::make_shared<internal_scalar_function>(
+                    "approx_percentile_reducer",
+                    bytes_type,
+                    std::vector<data_type>({bytes_type, bytes_type}),
+                    [] (std::span<const bytes_opt> args) -> bytes_opt {
+                        if (!args[0] || !args[1]) {
+                            return args[0] ? args[0] : args[1];
+                        }
+                        auto state = deserialize_percentile_state(*args[0]);
+                        auto other = deserialize_percentile_state(*args[1]);
+                        state.histogram.merge(other.histogram);
+                        return serialize_percentile_state(state);
+                    }),
+        });
+}
+
 // Drops the first arg type from the types declaration (which denotes the accumulator)
 // in order to compute the actual type of given user-defined-aggregate (UDA)
 static std::vector<data_type> state_arg_types_to_uda_arg_types(const std::vector<data_type>& arg_types) {
@@ -412,9 +918,9 @@ aggregate_fcts::make_count_rows_function() {
             .result_type = long_type,
             .argument_types = {},
             .initial_state = data_value(int64_t(0)).serialize(),
-            .aggregation_function = make_internal_scalar_function("count_step", return_any_nonnull, [] (int64_t accumulator) {
+            .aggregation_function = with_batch_aggregator<count_batch_aggregator<true>>(make_internal_scalar_function("count_step", return_any_nonnull, [] (int64_t accumulator) {
                 return accumulator + 1;
-            }),
+            })),
             .state_to_result_function = make_internal_scalar_function("count_finalizer", return_any_nonnull, [] (int64_t accumulator) {
                 return accumulator;
             }),
@@ -444,7 +950,7 @@ aggregate_fcts::make_max_function(data_type io_type) {
             .result_type = io_type,
             .argument_types = {io_type},
             .initial_state = std::nullopt,
-            .aggregation_function = max,
+            .aggregation_function = with_min_max_batch_aggregator<true>(max, *io_type),
             .state_to_result_function = ::make_shared<internal_scalar_function>("max_finalizer", io_type, std::vector({io_type}), [] (std::span<const bytes_opt> args) {
                 return args[0];
             }),
@@ -472,7 +978,7 @@ aggregate_fcts::make_min_function(data_type io_type) {
             .result_type = io_type,
             .argument_types = {io_type},
             .initial_state = std::nullopt,
-            .aggregation_function = min,
+            .aggregation_function = with_min_max_batch_aggregator<false>(min, *io_type),
             .state_to_result_function = ::make_shared<internal_scalar_function>("min_finalizer", io_type, std::vector({io_type}), [] (std::span<const bytes_opt> args) {
                 return args[0];
             }),
@@ -481,6 +987,12 @@ aggregate_fcts::make_min_function(data_type io_type) {
     );
 }
 
+std::unique_ptr<batch_aggregator>
+aggregate_fcts::make_batch_aggregator(const scalar_function& aggregation_function, std::span<const bytes_opt> constant_arguments) {
+    auto f = dynamic_cast<const internal_scalar_function*>(&aggregation_function);
+    return f ? f->make_batch_aggregator(constant_arguments) : nullptr;
+}
+
 function_name
 aggregate_fcts::first_function_name() {
     return function_name::native_function("$$first$$");
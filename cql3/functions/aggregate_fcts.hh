@@ -11,6 +11,8 @@
 #pragma once
 
 #include "aggregate_function.hh"
+#include "scalar_function.hh"
+#include "utils/managed_bytes.hh"
 
 namespace cql3 {
 namespace functions {
@@ -36,6 +38,48 @@ make_min_function(data_type io_type);
 /// count(col) function for the specified type
 shared_ptr<aggregate_function> make_count_function(data_type input_type);
 
+static const sstring APPROX_COUNT_DISTINCT_FUNCTION_NAME = "approx_count_distinct";
+static const sstring APPROX_PERCENTILE_FUNCTION_NAME = "approx_percentile";
+
+/// approx_count_distinct(col): estimates the number of distinct non-null values of the
+/// column using a HyperLogLog sketch of bounded size.
+shared_ptr<aggregate_function> make_approx_count_distinct_function(data_type input_type);
+
+/// approx_percentile(col, p): estimates the p-th percentile (0 <= p <= 1) of the values
+/// of a numeric column using a streaming histogram with a bounded number of bins.
+shared_ptr<aggregate_function> make_approx_percentile_function(data_type input_type);
+
+/// Aggregates the inputs of a built-in aggregate in batches.
+///
+/// Evaluating the aggregation function of an aggregate for each row deserializes the
+/// state and the input and serializes the new state. For built-in aggregates over
+/// fixed-width types, the inputs of consecutive rows can instead be buffered here, and are
+/// folded into a native accumulator by a typed kernel when the buffer fills up.
+class batch_aggregator {
+public:
+    virtual ~batch_aggregator() = default;
+
+    /// Replaces the accumulated state, dropping any buffered inputs.
+    virtual void load(const bytes_opt& state) = 0;
+
+    /// Adds the input of a row, i.e. the value of the aggregated column (or nullopt for
+    /// aggregates without arguments). Returns false, without consuming the input, if the
+    /// input can't be aggregated here (e.g. an empty value). The caller then has to apply
+    /// the aggregation function to the result of store() and load() its result.
+    virtual bool add(managed_bytes_view_opt value) = 0;
+
+    /// Folds the buffered inputs into the state and returns it serialized. The state
+    /// stays loaded, so more inputs can be added afterwards.
+    virtual bytes_opt store() = 0;
+};
+
+/// Returns a batch aggregator equivalent to the aggregation function of a built-in
+/// aggregate, or nullptr if the function has no batched implementation.
+/// constant_arguments are the values of the arguments following the aggregated column,
+/// which have to be the same for all rows.
+std::unique_ptr<batch_aggregator>
+make_batch_aggregator(const scalar_function& aggregation_function, std::span<const bytes_opt> constant_arguments = {});
+
 }
 }
 }
@@ -60,8 +60,11 @@ class as_json_function : public scalar_function {
                 encoded_row.write("\\\"", 2);
             }
             encoded_row.write("\": ", 3);
-            sstring row_sstring = to_json_string(*_selector_types[i], parameters[i]);
-            encoded_row.write(row_sstring.c_str(), row_sstring.size());
+            if (parameters[i]) {
+                write_json(encoded_row, *_selector_types[i], *parameters[i]);
+            } else {
+                encoded_row.write("null", 4);
+            }
         }
         encoded_row.write("}", 1);
         return bytes(encoded_row.linearize());
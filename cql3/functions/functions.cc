@@ -233,6 +233,8 @@ static shared_ptr<function> get_dynamic_aggregate(const function_name &name, con
     static const function_name MAX_NAME = function_name::native_function("max");
     static const function_name COUNT_NAME = function_name::native_function("count");
     static const function_name COUNT_ROWS_NAME = function_name::native_function("countRows");
+    static const function_name APPROX_COUNT_DISTINCT_NAME = function_name::native_function(aggregate_fcts::APPROX_COUNT_DISTINCT_FUNCTION_NAME);
+    static const function_name APPROX_PERCENTILE_NAME = function_name::native_function(aggregate_fcts::APPROX_PERCENTILE_FUNCTION_NAME);
 
     auto get_arguments = [&] (const sstring& function_name) {
         return std::visit(overloaded_functor {
@@ -298,7 +300,42 @@ static shared_ptr<function> get_dynamic_aggregate(const function_name &name, con
         if (arg->is_collection() || arg->is_tuple() || arg->is_user_type()) {
             return aggregate_fcts::make_count_rows_function();
         }
-    } 
+    } else if (name.has_keyspace()
+                ? name == APPROX_COUNT_DISTINCT_NAME
+                : name.name == APPROX_COUNT_DISTINCT_NAME.name) {
+        auto arg_types = get_arguments(APPROX_COUNT_DISTINCT_NAME.name);
+        if (arg_types.size() != 1) {
+            throw std::runtime_error("approx_count_distinct() function requires only 1 argument");
+        }
+
+        auto& arg = arg_types[0];
+        return aggregate_fcts::make_approx_count_distinct_function(arg);
+    } else if (name.has_keyspace()
+                ? name == APPROX_PERCENTILE_NAME
+                : name.name == APPROX_PERCENTILE_NAME.name) {
+        // The percentile is usually an untyped literal, so only the type of
+        // the column decides. mapreduce_service looks the function up by the
+        // type of the column alone.
+        auto arg_type = std::visit(overloaded_functor {
+            [&] (const std::vector<data_type>& args) -> data_type {
+                if (args.size() != 1 && args.size() != 2) {
+                    throw std::runtime_error("approx_percentile() function requires 2 arguments");
+                }
+                return args[0];
+            },
+            [&] (const std::vector<shared_ptr<assignment_testable>>& args) -> data_type {
+                if (args.size() != 2) {
+                    throw exceptions::invalid_request_exception("approx_percentile() function requires 2 arguments");
+                }
+                auto arg_type_opt = args[0]->assignment_testable_type_opt();
+                if (!arg_type_opt) {
+                    throw exceptions::invalid_request_exception("approx_percentile() function is only valid when the type of its first argument is known");
+                }
+                return *arg_type_opt;
+            }
+        }, provided_args);
+        return aggregate_fcts::make_approx_percentile_function(arg_type);
+    }
     return {};
 }
 
@@ -36,30 +36,40 @@ bool user_function::is_aggregate() const { return false; }
 
 bool user_function::requires_thread() const { return true; }
 
-bytes_opt user_function::execute(std::span<const bytes_opt> parameters) {
-    const auto& types = arg_types();
-    if (parameters.size() != types.size()) {
+bool user_function::can_execute(std::span<const bytes_opt> parameters) const {
+    if (parameters.size() != arg_types().size()) {
         throw std::logic_error("Wrong number of parameters");
     }
+    return _called_on_null_input || std::ranges::all_of(parameters, [] (const bytes_opt& param) { return bool(param); });
+}
 
+bytes_opt user_function::execute_lua(lua_context& ctx, std::span<const bytes_opt> parameters) {
+    const auto& types = arg_types();
+    auto& values = ctx.arguments;
+    values.clear();
+    values.reserve(parameters.size());
+    for (int i = 0, n = types.size(); i != n; ++i) {
+        const data_type& type = types[i];
+        const bytes_opt& bytes = parameters[i];
+        values.push_back(bytes ? type->deserialize(*bytes) : data_value::make_null(type));
+    }
+    auto f = lua::run_script(lua::bitcode_view{ctx.bitcode}, values, return_type(), ctx.cfg);
+    // The arguments are already on the Lua stack, and the buffer may be
+    // reused by another call while this one waits.
+    values.clear();
+    return f.get();
+}
+
+bytes_opt user_function::execute(std::span<const bytes_opt> parameters) {
     if (!seastar::thread::running_in_thread()) {
         on_internal_error(log, "User function cannot be executed in this context");
     }
-    for (auto& param : parameters) {
-        if (!param && !_called_on_null_input) {
-            return std::nullopt;
-        }
+    if (!can_execute(parameters)) {
+        return std::nullopt;
     }
     return seastar::visit(_ctx,
         [&] (lua_context& ctx) -> bytes_opt {
-            std::vector<data_value> values;
-            values.reserve(parameters.size());
-            for (int i = 0, n = types.size(); i != n; ++i) {
-                const data_type& type = types[i];
-                const bytes_opt& bytes = parameters[i];
-                values.push_back(bytes ? type->deserialize(*bytes) : data_value::make_null(type));
-            }
-            return lua::run_script(lua::bitcode_view{ctx.bitcode}, values, return_type(), ctx.cfg).get();
+            return execute_lua(ctx, parameters);
         },
         [&] (wasm::context& ctx) -> bytes_opt {
             try {
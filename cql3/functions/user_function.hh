@@ -32,6 +32,9 @@ class user_function final : public abstract_function, public scalar_function {
         // lua_runtime in a thread_local variable, but that is one extra
         // global.
         lua::runtime_config cfg;
+        // Reused for the converted arguments of each call, lua::run_script()
+        // pushes them to the Lua stack before it returns.
+        std::vector<data_value> arguments;
     };
 
     using context = std::variant<lua_context, wasm::context>;
@@ -43,6 +46,11 @@ class user_function final : public abstract_function, public scalar_function {
     bool _called_on_null_input;
     context _ctx;
 
+private:
+    // Checks the number of parameters, and whether the function is called on them
+    // or returns null.
+    bool can_execute(std::span<const bytes_opt> parameters) const;
+    bytes_opt execute_lua(lua_context& ctx, std::span<const bytes_opt> parameters);
 public:
     user_function(function_name name, std::vector<data_type> arg_types, std::vector<sstring> arg_names, sstring body,
             sstring language, data_type return_type, bool called_on_null_input, context ctx);
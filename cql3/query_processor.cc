@@ -23,10 +23,15 @@
 #include "cql3/CqlParser.hpp"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/untyped_result_set.hh"
 #include "db/config.hh"
+#include "db/consistency_level_validations.hh"
+#include "db/data_listeners.hh"
 #include "data_dictionary/data_dictionary.hh"
+#include "mutation/frozen_mutation.hh"
+#include "replica/database.hh"
 #include "service/vector_store_client.hh"
 #include "utils/hashers.hh"
 #include "utils/error_injection.hh"
@@ -69,6 +74,19 @@ static service::query_state query_state_for_internal_call() {
     return {service::client_state::for_internal_calls(), empty_service_permit()};
 }
 
+// Invalidates cached results of partitions written to on this shard.
+class query_processor::result_cache_invalidator : public db::data_listener {
+    query_processor& _qp;
+public:
+    explicit result_cache_invalidator(query_processor& qp) : _qp(qp) { }
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override {
+        if (s->caching_options().results_ttl().count()) {
+            _qp.invalidate_cached_results(query_result_cache::partition_id{s->id(), m.token(*s)});
+        }
+    }
+};
+
 query_processor::query_processor(service::storage_proxy& proxy, data_dictionary::database db, service::migration_notifier& mn, service::vector_store_client& vsc, query_processor::memory_config mcfg, cql_config& cql_cfg, utils::loading_cache_config auth_prep_cache_cfg, lang::manager& langm)
         : _migration_subscriber{std::make_unique<migration_subscriber>(this)}
         , _proxy(proxy)
@@ -79,6 +97,9 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
         , _cql_config(cql_cfg)
         , _prepared_cache(prep_cache_log, _mcfg.prepared_statment_cache_size)
         , _authorized_prepared_cache(std::move(auth_prep_cache_cfg), authorized_prepared_statements_cache_log)
+        , _result_cache(_mcfg.query_result_cache_size)
+        , _result_cache_invalidator(std::make_unique<result_cache_invalidator>(*this))
+        , _unprepared_cache(_db.get_config().unprepared_statements_cache_entries())
         , _auth_prepared_cache_cfg_cb([this] (uint32_t) { (void) _authorized_prepared_cache_config_action.trigger_later(); })
         , _authorized_prepared_cache_config_action([this] { update_authorized_prepared_cache_config(); return make_ready_future<>(); })
         , _authorized_prepared_cache_update_interval_in_ms_observer(_db.get_config().permissions_update_interval_in_ms.observe(_auth_prepared_cache_cfg_cb))
@@ -371,6 +392,21 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             _cql_stats.secondary_index_rows_read,
                             sm::description("Counts the total number of rows read during CQL requests performed using secondary indexes.")).set_skip_when_empty(),
 
+                    sm::make_counter(
+                            "secondary_index_covered_reads",
+                            _cql_stats.secondary_index_covered_reads,
+                            sm::description("Counts the number of CQL read requests performed using secondary indexes which were answered from the index alone, without reading the base table.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "vector_local_searches",
+                            _cql_stats.vector_local_searches,
+                            sm::description("Counts the number of ANN queries answered with an exact search on the coordinator instead of the vector store.")).set_skip_when_empty(),
+
+                    sm::make_counter(
+                            "vector_local_search_rows_scanned",
+                            _cql_stats.vector_local_search_rows_scanned,
+                            sm::description("Counts the number of rows compared with the query vector by ANN queries answered on the coordinator.")).set_skip_when_empty(),
+
                     // read requests that required ALLOW FILTERING
                     sm::make_counter(
                             "filtered_read_requests",
@@ -502,6 +538,7 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
             });
 
     _mnotifier.register_listener(_migration_subscriber.get());
+    _proxy.get_db().local().data_listeners().install(_result_cache_invalidator.get());
 }
 
 query_processor::~query_processor() {
@@ -526,6 +563,8 @@ future<> query_processor::stop_remote() {
 
 future<> query_processor::stop() {
     co_await _mnotifier.unregister_listener(_migration_subscriber.get());
+    _proxy.get_db().local().data_listeners().uninstall(_result_cache_invalidator.get());
+    co_await _result_cache_invalidations.close();
     co_await _authorized_prepared_cache.stop();
     co_await _prepared_cache.stop();
 }
@@ -569,11 +608,53 @@ query_processor::execute_maybe_with_guard(service::query_state& query_state, ::s
     return execute_with_guard(std::bind_front(exec, std::ref(*this), std::forward<Args>(args)...), std::move(statement), query_state, options);
 }
 
+// Statements executed without being prepared are kept in _unprepared_cache only
+// if they are DML statements, which clients repeat, and if their text is short,
+// so that queries with large literals don't take over the cache.
+static constexpr size_t max_cached_unprepared_query_size = 4096;
+
+static prepared_cache_key_type unprepared_cache_key(std::string_view query_string, const service::client_state& client_state, dialect d) {
+    return query_processor::compute_id(unprepared_statements_cache::normalize(query_string), client_state.get_raw_keyspace(), d);
+}
+
+static bool is_cacheable_unprepared_statement(std::string_view query_string, const cql_statement& statement) {
+    return query_string.size() <= max_cached_unprepared_query_size
+            && (dynamic_cast<const statements::select_statement*>(&statement)
+                || dynamic_cast<const statements::modification_statement*>(&statement)
+                || dynamic_cast<const statements::batch_statement*>(&statement));
+}
+
+::shared_ptr<cql_statement>
+query_processor::find_cached_statement(std::string_view query_string, const service::client_state& client_state, dialect d) {
+    if (auto prepared = get_prepared(compute_id(query_string, client_state.get_raw_keyspace(), d))) {
+        return prepared->statement;
+    }
+    if (auto* cached = _unprepared_cache.peek(unprepared_cache_key(query_string, client_state, d))) {
+        return cached->statement;
+    }
+    return nullptr;
+}
+
 future<::shared_ptr<result_message>>
 query_processor::execute_direct_without_checking_exception_message(const std::string_view& query_string, service::query_state& query_state, dialect d, query_options& options) {
     log.trace("execute_direct: \"{}\"", query_string);
-    tracing::trace(query_state.get_trace_state(), "Parsing a statement");
-    auto p = get_statement(query_string, query_state.get_client_state(), d);
+    std::optional<prepared_cache_key_type> key;
+    const statements::prepared_statement* p = nullptr;
+    std::unique_ptr<statements::prepared_statement> uncached;
+    if (_unprepared_cache.enabled() && query_string.size() <= max_cached_unprepared_query_size) {
+        key = unprepared_cache_key(query_string, query_state.get_client_state(), d);
+        p = _unprepared_cache.find(*key);
+    }
+    if (p) {
+        tracing::trace(query_state.get_trace_state(), "Using a cached statement");
+    } else {
+        tracing::trace(query_state.get_trace_state(), "Parsing a statement");
+        uncached = get_statement(query_string, query_state.get_client_state(), d);
+        p = uncached.get();
+        if (key && is_cacheable_unprepared_statement(query_string, *p->statement)) {
+            p = &_unprepared_cache.insert(*key, std::move(uncached));
+        }
+    }
     auto statement = p->statement;
     if (statement->get_bound_terms() != options.get_values_count()) {
         const auto msg = format("Invalid amount of bind variables: expected {:d} received {:d}",
@@ -590,7 +671,7 @@ query_processor::execute_direct_without_checking_exception_message(const std::st
 #endif
     auto user = query_state.get_client_state().user();
     tracing::trace(query_state.get_trace_state(), "Processing a statement for authenticated user: {}", user ? (user->name ? *user->name : "anonymous") : "no user authenticated");
-    return execute_maybe_with_guard(query_state, std::move(statement), options, &query_processor::do_execute_direct, std::move(p->warnings));
+    return execute_maybe_with_guard(query_state, std::move(statement), options, &query_processor::do_execute_direct, cql3::cql_warnings_vec(p->warnings));
 }
 
 future<::shared_ptr<result_message>>
@@ -647,30 +728,77 @@ query_processor::do_execute_prepared(
     if (needs_authorization) {
         co_await statement->check_access(*this, query_state.get_client_state());
         try {
-            co_await _authorized_prepared_cache.insert(*query_state.get_client_state().user(), std::move(cache_key), std::move(prepared));
+            co_await _authorized_prepared_cache.insert(*query_state.get_client_state().user(), cache_key, std::move(prepared));
         } catch (...) {
             log.error("failed to cache the entry: {}", std::current_exception());
         }
     }
 
     co_await audit::inspect(statement, query_state, options, false);
-    co_return co_await process_authorized_statement(std::move(statement), query_state, options, std::move(guard));
+
+    auto select = dynamic_cast<const statements::primary_key_select_statement*>(statement.get());
+    auto token = select && !db::is_serial_consistency(options.get_consistency())
+            ? select->cacheable_partition_token(options) : std::nullopt;
+    if (!token) {
+        co_return co_await process_authorized_statement(std::move(statement), query_state, options, std::move(guard));
+    }
+
+    auto schema = select->get_schema();
+    auto partition = query_result_cache::partition_id{schema->id(), *token};
+    auto key = query_result_cache::make_key(prepared_cache_key_type::cql_id(cache_key), options);
+    auto table = _proxy.get_db().local().get_tables_metadata().get_table_if_exists(schema->id());
+    if (auto result = _result_cache.find(partition, key)) {
+        ++_stats.queries_by_cl[size_t(options.get_consistency())];
+        if (table) {
+            ++table->get_stats().query_result_cache_hits;
+        }
+        co_return result;
+    }
+    if (table) {
+        ++table->get_stats().query_result_cache_misses;
+    }
+
+    auto epoch = _result_cache.current_epoch(partition);
+    auto msg = co_await process_authorized_statement(std::move(statement), query_state, options, std::move(guard));
+    if (!msg->move_to_shard() && !msg->is_exception()) {
+        _result_cache.insert(partition, std::move(key), msg, schema->caching_options().results_ttl(), epoch);
+    }
+    co_return msg;
 }
 
+void query_processor::invalidate_cached_results(query_result_cache::partition_id partition) {
+    auto invalidate = [partition] (query_processor& qp) {
+        if (auto n = qp._result_cache.invalidate(partition)) {
+            if (auto table = qp._proxy.get_db().local().get_tables_metadata().get_table_if_exists(partition.table)) {
+                table->get_stats().query_result_cache_invalidations += n;
+            }
+        }
+    };
+    invalidate(*this);
+    if (smp::count > 1) {
+        (void)try_with_gate(_result_cache_invalidations, [this, invalidate] {
+            return container().invoke_on_others(invalidate);
+        }).handle_exception([] (std::exception_ptr) { });
+    }
+}
+
+// Not a coroutine, as every statement passes here, and a coroutine would
+// allocate its frame even when the statement completes without waiting.
 future<::shared_ptr<result_message>>
 query_processor::process_authorized_statement(const ::shared_ptr<cql_statement> statement, service::query_state& query_state, const query_options& options, std::optional<service::group0_guard> guard) {
     auto& client_state = query_state.get_client_state();
 
     ++_stats.queries_by_cl[size_t(options.get_consistency())];
 
-    statement->validate(*this, client_state);
-
-    auto msg = co_await statement->execute_without_checking_exception_message(*this, query_state, options, std::move(guard));
-
-    if (msg) {
-       co_return std::move(msg);
-    }
-    co_return ::make_shared<result_message::void_message>();
+    return futurize_invoke([&] {
+        statement->validate(*this, client_state);
+        return statement->execute_without_checking_exception_message(*this, query_state, options, std::move(guard));
+    }).then([statement] (::shared_ptr<result_message> msg) -> ::shared_ptr<result_message> {
+        if (msg) {
+            return msg;
+        }
+        return ::make_shared<result_message::void_message>();
+    });
 }
 
 future<::shared_ptr<cql_transport::messages::result_message::prepared>>
@@ -1136,6 +1264,9 @@ void query_processor::migration_subscriber::on_update_column_family(
     // #1255: Ignoring columns_changed deliberately.
     log.info("Column definitions for {}.{} changed, invalidating related prepared statements", ks_name, cf_name);
     remove_invalid_prepared_statements(ks_name, cf_name);
+    if (auto table = _qp->db().try_find_table(ks_name, cf_name)) {
+        _qp->_result_cache.invalidate(table->schema()->id());
+    }
 }
 
 void query_processor::migration_subscriber::on_update_user_type(const sstring& ks_name, const sstring& type_name) {
@@ -1184,6 +1315,9 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    _qp->_unprepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
+        return this->should_invalidate(ks_name, cf_name, stmt);
+    });
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
@@ -19,6 +19,8 @@
 
 #include "cql3/prepared_statements_cache.hh"
 #include "cql3/authorized_prepared_statements_cache.hh"
+#include "cql3/query_result_cache.hh"
+#include "cql3/unprepared_statements_cache.hh"
 #include "cql3/statements/prepared_statement.hh"
 #include "cql3/cql_statement.hh"
 #include "cql3/dialect.hh"
@@ -102,6 +104,7 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     struct memory_config {
         size_t prepared_statment_cache_size = 0;
         size_t authorized_prepared_cache_size = 0;
+        size_t query_result_cache_size = 0;
     };
 
 private:
@@ -128,6 +131,14 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     prepared_statements_cache _prepared_cache;
     authorized_prepared_statements_cache _authorized_prepared_cache;
 
+    class result_cache_invalidator;
+    query_result_cache _result_cache;
+    std::unique_ptr<result_cache_invalidator> _result_cache_invalidator;
+    // Invalidations of _result_cache on other shards, running in the background.
+    gate _result_cache_invalidations;
+
+    unprepared_statements_cache _unprepared_cache;
+
     std::function<void(uint32_t)> _auth_prepared_cache_cfg_cb;
     serialized_action _authorized_prepared_cache_config_action;
     utils::observer<uint32_t> _authorized_prepared_cache_update_interval_in_ms_observer;
@@ -177,6 +188,10 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _cql_stats;
     }
 
+    const unprepared_statements_cache& get_unprepared_cache() const noexcept {
+        return _unprepared_cache;
+    }
+
     lang::manager& lang() { return _lang_manager; }
 
     const service::vector_store_client& vector_store_client() const noexcept {
@@ -218,6 +233,11 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _prepared_cache.find(key);
     }
 
+    // Returns the statement of the query if it was prepared, or executed
+    // without being prepared and cached, without parsing the query. Null
+    // otherwise.
+    ::shared_ptr<cql_statement> find_cached_statement(std::string_view query_string, const service::client_state& client_state, dialect d);
+
     inline
     future<::shared_ptr<cql_transport::messages::result_message>>
     execute_prepared(
@@ -470,6 +490,9 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     void update_authorized_prepared_cache_config();
 
+    // Drops cached results of the partition on all shards, after it was written to.
+    void invalidate_cached_results(query_result_cache::partition_id partition);
+
     void reset_cache();
 
     bool topology_global_queue_empty();
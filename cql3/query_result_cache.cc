@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/metrics.hh>
+
+#include "cql3/query_result_cache.hh"
+#include "cql3/query_options.hh"
+#include "service/pager/paging_state.hh"
+#include "transport/messages/result_message.hh"
+#include "utils/fragment_range.hh"
+#include "utils/hash.hh"
+
+namespace cql3 {
+
+size_t query_result_cache::partition_id_hash::operator()(const partition_id& p) const noexcept {
+    return utils::hash_combine(std::hash<table_id>()(p.table), std::hash<dht::token>()(p.token));
+}
+
+namespace {
+
+// Counts the bytes held by the cells of a result.
+struct result_size_visitor {
+    size_t size = 0;
+
+    void start_row() {
+        size += sizeof(managed_bytes_opt);
+    }
+    void accept_value(managed_bytes_view_opt value) {
+        size += sizeof(managed_bytes_opt) + (value ? value->size_bytes() : 0);
+    }
+    void end_row() { }
+};
+
+size_t result_size(const cql_transport::messages::result_message::rows& rows) {
+    result_size_visitor v;
+    rows.rs().visit(v);
+    return v.size;
+}
+
+template <typename T>
+void write_be(bytes_ostream& out, T v) {
+    char buf[sizeof(T)];
+    seastar::write_be<T>(buf, v);
+    out.write(buf, sizeof(T));
+}
+
+}
+
+query_result_cache::query_result_cache(size_t max_memory)
+        : _max_memory(max_memory) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("query_processor", {
+        sm::make_gauge("result_cache_entries", [this] { return _entries; },
+                sm::description("Number of results of prepared statements held in the query result cache.")),
+        sm::make_gauge("result_cache_bytes", [this] { return _memory_used; },
+                sm::description("Memory used by results held in the query result cache.")),
+        sm::make_counter("result_cache_insertions", _stats.insertions,
+                sm::description("Number of results inserted into the query result cache.")),
+        sm::make_counter("result_cache_evictions", _stats.evictions,
+                sm::description("Number of results evicted from the query result cache because it was full.")),
+    });
+}
+
+query_result_cache::~query_result_cache() {
+    _lru.clear();
+}
+
+bytes query_result_cache::make_key(const bytes& prepared_id, const query_options& options) {
+    bytes_ostream out;
+    write_be<uint16_t>(out, prepared_id.size());
+    out.write(prepared_id);
+    write_be<uint16_t>(out, uint16_t(options.get_consistency()));
+    write_be<int32_t>(out, options.get_page_size());
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        if (options.is_unset(i)) {
+            write_be<int32_t>(out, -2);
+            continue;
+        }
+        auto value = options.get_value_at(i);
+        if (value.is_null()) {
+            write_be<int32_t>(out, -1);
+            continue;
+        }
+        write_be<int32_t>(out, value.size_bytes());
+        value.with_value([&out] (const FragmentedView auto& v) {
+            for (bytes_view frag : fragment_range(v)) {
+                out.write(frag);
+            }
+        });
+    }
+    if (auto state = options.get_paging_state()) {
+        auto serialized = state->serialize();
+        write_be<int32_t>(out, serialized->size());
+        out.write(*serialized);
+    }
+    return bytes(out.linearize());
+}
+
+void query_result_cache::erase(entry& e) noexcept {
+    _lru.erase(_lru.iterator_to(e));
+    _memory_used -= e.size;
+    --_entries;
+    auto p = _partitions.find(e.partition);
+    p->second.erase(p->second.find(e.key));
+    if (p->second.empty()) {
+        _partitions.erase(p);
+    }
+}
+
+void query_result_cache::evict_until_fits(size_t size) noexcept {
+    auto now = lowres_clock::now();
+    while (!_lru.empty() && (_memory_used + size > _max_memory || _lru.front().expiry <= now)) {
+        if (_lru.front().expiry > now) {
+            ++_stats.evictions;
+        }
+        erase(_lru.front());
+    }
+}
+
+query_result_cache::result_ptr query_result_cache::find(const partition_id& partition, const bytes& key) {
+    auto p = _partitions.find(partition);
+    if (p == _partitions.end()) {
+        return {};
+    }
+    auto i = p->second.find(key);
+    if (i == p->second.end()) {
+        return {};
+    }
+    auto& e = i->second;
+    if (e.expiry <= lowres_clock::now()) {
+        erase(e);
+        return {};
+    }
+    _lru.erase(_lru.iterator_to(e));
+    _lru.push_back(e);
+    return e.result;
+}
+
+void query_result_cache::insert(const partition_id& partition, bytes key, result_ptr result, std::chrono::milliseconds ttl, epoch_type epoch) {
+    auto rows = dynamic_cast<const cql_transport::messages::result_message::rows*>(result.get());
+    if (!rows || epoch != current_epoch(partition)) {
+        return;
+    }
+    auto size = sizeof(entry) + 2 * key.size() + result_size(*rows);
+    if (size > _max_memory / 16) {
+        return;
+    }
+    evict_until_fits(size);
+
+    auto& entries = _partitions[partition];
+    auto [i, inserted] = entries.try_emplace(key);
+    auto& e = i->second;
+    if (!inserted) {
+        _lru.erase(_lru.iterator_to(e));
+        _memory_used -= e.size;
+        --_entries;
+    }
+    e.partition = partition;
+    e.key = std::move(key);
+    e.result = std::move(result);
+    e.expiry = lowres_clock::now() + ttl;
+    e.size = size;
+    _lru.push_back(e);
+    _memory_used += size;
+    ++_entries;
+    ++_stats.insertions;
+}
+
+size_t query_result_cache::invalidate(const partition_id& partition) noexcept {
+    ++epoch_slot(partition);
+    auto p = _partitions.find(partition);
+    if (p == _partitions.end()) {
+        return 0;
+    }
+    size_t n = 0;
+    for (auto& [key, e] : p->second) {
+        _lru.erase(_lru.iterator_to(e));
+        _memory_used -= e.size;
+        ++n;
+    }
+    _entries -= n;
+    _partitions.erase(p);
+    return n;
+}
+
+void query_result_cache::invalidate(table_id table) noexcept {
+    std::erase_if(_partitions, [this, table] (auto& p) {
+        if (p.first.table != table) {
+            return false;
+        }
+        for (auto& [key, e] : p.second) {
+            _lru.erase(_lru.iterator_to(e));
+            _memory_used -= e.size;
+            --_entries;
+        }
+        return true;
+    });
+}
+
+}
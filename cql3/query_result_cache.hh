@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <unordered_map>
+#include <boost/intrusive/list.hpp>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "bytes.hh"
+#include "dht/token.hh"
+#include "schema/schema_fwd.hh"
+#include "seastarx.hh"
+
+namespace cql_transport::messages {
+class result_message;
+}
+
+namespace cql3 {
+
+class query_options;
+
+/// \brief Short-lived cache of results of prepared single-partition SELECTs.
+///
+/// Used for tables with a non-zero "results_ttl_in_ms" caching option, for
+/// statements which select_statement::cacheable_partition_token() accepts.
+/// Entries are keyed by the prepared statement id, the bound values and the
+/// paging state, and are indexed by the partition they read, so that writes to
+/// a partition applied on this node invalidate its entries.
+///
+/// Entries expire after the TTL of their table. Writes which this node doesn't
+/// apply, or whose invalidation didn't reach this shard yet, may be missed for
+/// up to that long.
+///
+/// Cached result messages are shared by all the responses served from them,
+/// so they must not be modified once inserted.
+class query_result_cache {
+public:
+    using result_ptr = ::shared_ptr<cql_transport::messages::result_message>;
+
+    struct partition_id {
+        table_id table;
+        dht::token token;
+
+        bool operator==(const partition_id&) const = default;
+    };
+
+    // Taken before executing a statement and passed to insert(), so that a result
+    // read concurrently with an invalidation of its partition is not cached.
+    using epoch_type = uint64_t;
+
+    struct stats {
+        uint64_t insertions = 0;
+        uint64_t evictions = 0;
+    };
+private:
+    struct partition_id_hash {
+        size_t operator()(const partition_id& p) const noexcept;
+    };
+
+    struct entry {
+        boost::intrusive::list_member_hook<> lru_link;
+        partition_id partition;
+        bytes key;
+        result_ptr result;
+        lowres_clock::time_point expiry;
+        size_t size;
+    };
+
+    using lru_type = boost::intrusive::list<entry,
+            boost::intrusive::member_hook<entry, boost::intrusive::list_member_hook<>, &entry::lru_link>,
+            boost::intrusive::constant_time_size<false>>;
+    using partition_entries = std::unordered_map<bytes, entry>;
+
+    static constexpr size_t epoch_slots = 64;
+
+    size_t _max_memory;
+    size_t _memory_used = 0;
+    size_t _entries = 0;
+    std::unordered_map<partition_id, partition_entries, partition_id_hash> _partitions;
+    // Least recently used entries at the front.
+    lru_type _lru;
+    // Bumped on invalidations of partitions whose token maps to the slot.
+    std::array<epoch_type, epoch_slots> _epochs = {};
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    epoch_type& epoch_slot(const partition_id& p) noexcept {
+        return _epochs[p.token.unbias() % epoch_slots];
+    }
+    void erase(entry& e) noexcept;
+    void evict_until_fits(size_t size) noexcept;
+public:
+    explicit query_result_cache(size_t max_memory);
+    ~query_result_cache();
+
+    query_result_cache(const query_result_cache&) = delete;
+    query_result_cache& operator=(const query_result_cache&) = delete;
+
+    // Serializes the parts of the options which a cached result depends on.
+    static bytes make_key(const bytes& prepared_id, const query_options& options);
+
+    // Returns the cached result, or null on a miss.
+    result_ptr find(const partition_id& partition, const bytes& key);
+
+    epoch_type current_epoch(const partition_id& partition) noexcept {
+        return epoch_slot(partition);
+    }
+
+    // Caches the result for ttl, unless the partition was invalidated since epoch was taken.
+    void insert(const partition_id& partition, bytes key, result_ptr result, std::chrono::milliseconds ttl, epoch_type epoch);
+
+    // Drops all entries reading the partition. Returns the number of dropped entries.
+    size_t invalidate(const partition_id& partition) noexcept;
+
+    // Drops all entries of the table.
+    void invalidate(table_id table) noexcept;
+
+    size_t memory_used() const noexcept {
+        return _memory_used;
+    }
+
+    size_t size() const noexcept {
+        return _entries;
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+}
@@ -11,6 +11,7 @@
 #include <boost/range/algorithm/set_algorithm.hpp>
 #include <functional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 
 #include "cql3/expr/expression.hh"
@@ -28,6 +29,8 @@
 #include "dht/i_partitioner.hh"
 #include "db/schema_tables.hh"
 #include "types/tuple.hh"
+#include "utils/like_matcher.hh"
+#include "utils/small_vector.hh"
 
 namespace {
 struct maybe_column_definition {
@@ -949,6 +952,49 @@ static std::vector<expr::expression> extract_partition_range(
     return {};
 }
 
+/// Turns the restrictions of a clustering column which need filtering into a slice when they are LIKE
+/// patterns starting with a literal, and the other restrictions don't need filtering.  Strings sort
+/// by their bytes, so the matching values lie between the literal and its successor, and the read can
+/// be limited to them.  The restrictions are still applied by filtering.
+static std::optional<expr::expression> like_prefix_slice(const column_definition& col, const expr::expression& restrictions) {
+    using namespace expr;
+    if (!col.type->is_string()) {
+        return std::nullopt;
+    }
+    std::vector<expression> slice;
+    bool has_prefix = false;
+    for (const auto& e : boolean_factors(restrictions)) {
+        const auto& binop = expr::as<binary_operator>(e);
+        if (!needs_filtering(binop.op)) {
+            slice.push_back(e);
+            continue;
+        }
+        const auto pattern = binop.op == oper_t::LIKE ? expr::as_if<constant>(&binop.rhs) : nullptr;
+        if (!pattern || pattern->is_null() || !expr::is<column_value>(binop.lhs)) {
+            return std::nullopt;
+        }
+        bytes prefix = like_matcher::literal_prefix(to_bytes(pattern->value.view()));
+        if (prefix.empty()) {
+            continue;
+        }
+        // The successor of the prefix: its last byte which can be incremented, incremented.
+        bytes end = prefix;
+        while (!end.empty() && uint8_t(end[end.size() - 1]) == 0xff) {
+            end.resize(end.size() - 1);
+        }
+        slice.push_back(binary_operator(binop.lhs, oper_t::GTE, constant(raw_value::make_value(std::move(prefix)), pattern->type)));
+        if (!end.empty()) {
+            end[end.size() - 1] = int8_t(uint8_t(end[end.size() - 1]) + 1);
+            slice.push_back(binary_operator(binop.lhs, oper_t::LT, constant(raw_value::make_value(std::move(end)), pattern->type)));
+        }
+        has_prefix = true;
+    }
+    if (!has_prefix) {
+        return std::nullopt;
+    }
+    return conjunction{std::move(slice)};
+}
+
 /// Extracts where_clause atoms with clustering-column LHS and copies them to a vector.  These elements define the
 /// boundaries of any clustering slice that can possibly meet where_clause.  This vector can be calculated before
 /// binding expression markers, since LHS and operator are always known.
@@ -1081,6 +1127,9 @@ static std::vector<expr::expression> extract_clustering_prefix_restrictions(
         if (find_needs_filtering(found->second)) { // This column's restriction doesn't define a clear bound.
             // TODO: if this is a conjunction of filtering and non-filtering atoms, we could split them and add the
             // latter to the prefix.
+            if (auto slice = like_prefix_slice(col, found->second)) {
+                prefix.push_back(std::move(*slice));
+            }
             break;
         }
         prefix.push_back(found->second);
@@ -1266,6 +1315,8 @@ statement_restrictions::statement_restrictions(data_dictionary::database db,
 
     _clustering_row_level_filter = expr::make_conjunction(std::move(_clustering_row_level_filter), std::move(multi_column_restrictions));
 
+    prepare_bound_primary_key();
+
     if (uses_secondary_indexing()) {
         auto& index_opt = _idx_opt;
         if (!index_opt) {
@@ -1872,7 +1923,7 @@ dht::partition_range_vector partition_ranges_from_token(const expr::expression&
 }
 
 /// Turns a partition-key value into a partition_range. \p pk must have elements for all partition columns.
-dht::partition_range range_from_bytes(const schema& schema, const std::vector<managed_bytes>& pk) {
+dht::partition_range range_from_bytes(const schema& schema, std::span<const managed_bytes> pk) {
     const auto k = partition_key::from_exploded(pk);
     const auto tok = dht::get_token(schema, k);
     const query::ring_position pos(std::move(tok), std::move(k));
@@ -1921,9 +1972,20 @@ dht::partition_range_vector partition_ranges_from_singles(
         }
     }
     cartesian_product cp(column_values);
+    std::vector<partition_key> keys;
+    keys.reserve(product_size);
+    std::transform(cp.begin(), cp.end(), std::back_inserter(keys), [] (const std::vector<managed_bytes>& pk) {
+        return partition_key::from_exploded(pk);
+    });
+    // Computing the tokens of all keys together is cheaper than one by one.
+    std::vector<partition_key_view> views(keys.begin(), keys.end());
+    std::vector<dht::token> tokens(keys.size());
+    dht::get_tokens(schema, views, tokens);
     dht::partition_range_vector ranges;
     ranges.reserve(product_size);
-    std::transform(cp.begin(), cp.end(), std::back_inserter(ranges), std::bind_front(range_from_bytes, std::ref(schema)));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ranges.push_back(dht::partition_range::make_singular(query::ring_position(std::move(tokens[i]), std::move(keys[i]))));
+    }
     return ranges;
 }
 
@@ -1943,12 +2005,35 @@ dht::partition_range_vector partition_ranges_from_EQs(
     return {range_from_bytes(schema, pk_value)};
 }
 
+/// Evaluates the RHS of the EQ restrictions of key columns.  Returns std::nullopt if any of them is NULL, in
+/// which case no key matches.
+std::optional<utils::small_vector<managed_bytes, 4>> bound_key_values(
+        const std::vector<expr::expression>& bound_values, const query_options& options) {
+    utils::small_vector<managed_bytes, 4> values;
+    values.reserve(bound_values.size());
+    for (const auto& e : bound_values) {
+        auto val = evaluate(e, options).to_managed_bytes_opt();
+        if (!val) {
+            return std::nullopt;
+        }
+        values.push_back(std::move(*val));
+    }
+    return values;
+}
+
 } // anonymous namespace
 
 dht::partition_range_vector statement_restrictions::get_partition_key_ranges(const query_options& options) const {
     if (_partition_range_restrictions.empty()) {
         return {dht::partition_range::make_open_ended_both_sides()};
     }
+    if (_bound_primary_key) {
+        auto pk_value = bound_key_values(_bound_primary_key->partition_key, options);
+        if (!pk_value) {
+            return {};
+        }
+        return {range_from_bytes(*_schema, *pk_value)};
+    }
     if (has_partition_token(_partition_range_restrictions[0], *_schema)) {
         if (_partition_range_restrictions.size() != 1) {
             on_internal_error(
@@ -2586,6 +2671,13 @@ std::vector<query::clustering_range> statement_restrictions::get_clustering_boun
     if (_clustering_prefix_restrictions.empty()) {
         return {query::clustering_range::make_open_ended_both_sides()};
     }
+    if (_bound_primary_key && !_bound_primary_key->clustering_key.empty()) {
+        auto ck_value = bound_key_values(_bound_primary_key->clustering_key, options);
+        if (!ck_value) {
+            return {};
+        }
+        return {query::clustering_range::make_singular(clustering_key_prefix::from_exploded(*ck_value))};
+    }
     if (find_binop(_clustering_prefix_restrictions[0], is_multi_column)) {
         bool all_natural = true, all_reverse = true; ///< Whether column types are reversed or natural.
         for (auto& r : _clustering_prefix_restrictions) { // TODO: move to constructor, do only once.
@@ -2790,6 +2882,43 @@ void statement_restrictions::prepare_indexed_local(const schema& idx_tbl_schema)
     add_clustering_restrictions_to_idx_ck_prefix(idx_tbl_schema);
 }
 
+void statement_restrictions::prepare_bound_primary_key() {
+    if (_uses_secondary_indexing
+            || _partition_range_restrictions.size() != _schema->partition_key_size()
+            || has_partition_token(_partition_range_restrictions[0], *_schema)
+            || (!_clustering_prefix_restrictions.empty() && _clustering_prefix_restrictions.size() != _schema->clustering_key_size())) {
+        return;
+    }
+    // Returns the column of the restriction, if it is a single EQ to a bind marker.
+    auto bound_column = [] (const expr::expression& e) -> const column_definition* {
+        const auto binop = expr::as_if<binary_operator>(&e);
+        if (!binop || binop->op != oper_t::EQ || !expr::is<bind_variable>(binop->rhs)) {
+            return nullptr;
+        }
+        const auto col = expr::as_if<column_value>(&binop->lhs);
+        return col ? col->col : nullptr;
+    };
+    bound_primary_key key{
+        .partition_key = std::vector<expr::expression>(_schema->partition_key_size(), expr::conjunction({})),
+        .clustering_key = std::vector<expr::expression>(_clustering_prefix_restrictions.size(), expr::conjunction({})),
+    };
+    for (const auto& e : _partition_range_restrictions) {
+        const auto col = bound_column(e);
+        if (!col || !col->is_partition_key()) {
+            return;
+        }
+        key.partition_key[_schema->position(*col)] = expr::as<binary_operator>(e).rhs;
+    }
+    for (size_t i = 0; i < _clustering_prefix_restrictions.size(); ++i) {
+        const auto& e = _clustering_prefix_restrictions[i];
+        if (bound_column(e) != &_schema->clustering_column_at(i)) {
+            return;
+        }
+        key.clustering_key[i] = expr::as<binary_operator>(e).rhs;
+    }
+    _bound_primary_key = std::move(key);
+}
+
 void statement_restrictions::add_clustering_restrictions_to_idx_ck_prefix(const schema& idx_tbl_schema) {
     for (const auto& e : _clustering_prefix_restrictions) {
         if (find_binop(_clustering_prefix_restrictions[0], is_multi_column)) {
@@ -117,6 +117,17 @@ class statement_restrictions {
 
     bool _partition_range_is_simple; ///< False iff _partition_range_restrictions imply a Cartesian product.
 
+    /// The RHS of the restrictions of the primary key columns, in schema order, if each partition key column,
+    /// and either no clustering key column or each of them, is restricted by a single EQ to a bind marker, so
+    /// that the key ranges are just the bound values.  This is the shape of the common prepared single-partition
+    /// and single-row reads, like `WHERE pk = ? AND ck = ?`, whose key ranges get computed without going through
+    /// the value sets of the restrictions.  See prepare_bound_primary_key().
+    struct bound_primary_key {
+        std::vector<expr::expression> partition_key;
+        std::vector<expr::expression> clustering_key;
+    };
+    std::optional<bound_primary_key> _bound_primary_key;
+
 
     check_indexes _check_indexes = check_indexes::yes;
     std::vector<const column_definition*> _column_defs_for_filtering;
@@ -391,7 +402,15 @@ class statement_restrictions {
     /// get_global_index_clustering_ranges() or get_global_index_token_clustering_ranges().
     void prepare_indexed_global(const schema& idx_tbl_schema);
 
+    /// Sets _bound_primary_key if the restrictions have its shape.
+    void prepare_bound_primary_key();
+
 public:
+    /// Whether the key ranges of the statement are computed directly from the bound values.
+    bool has_bound_primary_key() const {
+        return _bound_primary_key.has_value();
+    }
+
     /// Calculates clustering ranges for querying a global-index table.
     std::vector<query::clustering_range> get_global_index_clustering_ranges(
             const query_options& options, const schema& idx_tbl_schema) const;
@@ -15,6 +15,18 @@
 namespace cql3 {
 class untyped_result_set;
 
+// Passes a value owned by the result being visited, which stays valid for as long
+// as the result does, to the visitor. Visitors can opt into referencing such values
+// instead of copying them by providing accept_stable_value().
+template<typename Visitor>
+void accept_result_value(Visitor& visitor, managed_bytes_view_opt val) {
+    if constexpr (requires { visitor.accept_stable_value(val); }) {
+        visitor.accept_stable_value(std::move(val));
+    } else {
+        visitor.accept_value(std::move(val));
+    }
+}
+
 class result_generator {
     schema_ptr _schema;
     foreign_ptr<lw_shared_ptr<query::result>> _result;
@@ -35,10 +47,10 @@ class result_generator {
     private:
         void accept_cell_value(const column_definition& def, query::result_row_view::iterator_type& i) {
             if (def.is_multi_cell()) {
-                _visitor.accept_value(utils::buffer_view_to_managed_bytes_view(i.next_collection_cell()));
+                accept_result_value(_visitor, utils::buffer_view_to_managed_bytes_view(i.next_collection_cell()));
             } else {
                 auto cell = i.next_atomic_cell();
-                _visitor.accept_value(cell ? utils::buffer_view_to_managed_bytes_view(cell->value()) : managed_bytes_view_opt());
+                accept_result_value(_visitor, cell ? utils::buffer_view_to_managed_bytes_view(cell->value()) : managed_bytes_view_opt());
             }
         }
     public:
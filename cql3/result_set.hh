@@ -189,7 +189,7 @@ class result_set {
             visitor.start_row();
             for (auto i = 0u; i < column_count; i++) {
                 auto& cell = row[i];
-                visitor.accept_value(cell ? managed_bytes_view_opt(*cell) : managed_bytes_view_opt());
+                accept_result_value(visitor, cell ? managed_bytes_view_opt(*cell) : managed_bytes_view_opt());
             }
             visitor.end_row();
         }
@@ -205,7 +205,7 @@ class result_set {
             visitor.start_row();
             for (auto i = 0u; i < column_count; i++) {
                 auto& cell = row[i];
-                visitor.accept_value(cell ? managed_bytes_view_opt(*cell) : managed_bytes_view_opt());
+                accept_result_value(visitor, cell ? managed_bytes_view_opt(*cell) : managed_bytes_view_opt());
             }
             visitor.end_row();
         });
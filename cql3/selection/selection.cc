@@ -269,11 +269,17 @@ class selection_with_processing : public selection {
                     if (!agg_func->get_aggregate().state_reduction_function) {
                         return false;
                     }
-                    // We only support transforming columns directly for parallel queries
-                    if (!std::ranges::all_of(fc->args, expr::is<expr::column_value>)) {
-                        return false;
+                    // We only support transforming columns directly for parallel queries.
+                    // Native aggregates of columns may take constant arguments after
+                    // them (e.g. the percentile of approx_percentile()), since they are
+                    // looked up by the types of the columns alone.
+                    auto constants = std::ranges::find_if_not(fc->args, expr::is<expr::column_value>);
+                    if (constants == fc->args.end()) {
+                        return true;
                     }
-                    return true;
+                    return constants != fc->args.begin()
+                            && agg_func->is_native()
+                            && std::all_of(constants, fc->args.end(), expr::is<expr::constant>);
                 }
         );
     }
@@ -298,9 +304,14 @@ class selection_with_processing : public selection {
             auto type = (agg_func->name().name == "countRows") ? query::mapreduce_request::reduction_type::count : query::mapreduce_request::reduction_type::aggregate;
 
             std::vector<sstring> column_names;
+            std::vector<bytes_opt> constant_arguments;
             for (auto& arg : fc->args) {
+                if (auto c = expr::as_if<expr::constant>(&arg)) {
+                    constant_arguments.push_back(raw_value(c->value).to_bytes_opt());
+                    continue;
+                }
                 auto col = expr::as_if<expr::column_value>(&arg);
-                if (!col) {
+                if (!col || !constant_arguments.empty()) {
                     bad();
                 }
                 column_names.push_back(col->col->name_as_text());
@@ -309,6 +320,7 @@ class selection_with_processing : public selection {
             auto info = query::mapreduce_request::aggregation_info {
                 .name = agg_func->name(),
                 .column_names = std::move(column_names),
+                .constant_arguments = std::move(constant_arguments),
             };
 
             types.push_back(type);
@@ -341,10 +353,84 @@ class selection_with_processing : public selection {
 protected:
     class selectors_with_processing : public selectors {
     private:
+        // An inner loop step of a built-in aggregate which is aggregated in batches
+        // instead of being evaluated for each row.
+        struct batched_aggregate {
+            std::unique_ptr<functions::aggregate_fcts::batch_aggregator> aggregator;
+            // Index of the aggregated column in the selection, disengaged for aggregates
+            // without arguments.
+            std::optional<uint32_t> column_index;
+        };
+
         const selection_with_processing& _sel;
         std::vector<raw_value> _temporaries;
+        // Indexed like the inner loop. Temporaries of batched aggregates are only
+        // up to date after sync_batched_aggregates().
+        std::vector<std::optional<batched_aggregate>> _batched;
         bool _requires_thread;
         std::uint64_t _input_row_count;
+    private:
+        static bytes_opt to_bytes_opt(const raw_value& v) {
+            return raw_value(v).to_bytes_opt();
+        }
+
+        // Only steps of the form agg_step(temporary, column, constants...) over regular
+        // or static columns, reading the column directly from the row, can be batched.
+        std::optional<batched_aggregate> make_batched_aggregate(const expr::expression& e, size_t index) const {
+            auto fc = expr::as_if<expr::function_call>(&e);
+            if (!fc || fc->args.empty()) {
+                return std::nullopt;
+            }
+            auto temp = expr::as_if<expr::temporary>(&fc->args[0]);
+            if (!temp || temp->index != index) {
+                return std::nullopt;
+            }
+            std::vector<bytes_opt> constant_arguments;
+            for (size_t i = 2; i < fc->args.size(); ++i) {
+                auto c = expr::as_if<expr::constant>(&fc->args[i]);
+                if (!c) {
+                    return std::nullopt;
+                }
+                constant_arguments.push_back(to_bytes_opt(c->value));
+            }
+            std::optional<uint32_t> column_index;
+            if (fc->args.size() >= 2) {
+                auto col = expr::as_if<expr::column_value>(&fc->args[1]);
+                if (!col || (!col->col->is_regular() && !col->col->is_static())) {
+                    return std::nullopt;
+                }
+                auto idx = _sel.index_of(*col->col);
+                if (idx < 0) {
+                    return std::nullopt;
+                }
+                column_index = idx;
+            }
+            auto func = dynamic_pointer_cast<functions::scalar_function>(std::get<shared_ptr<functions::function>>(fc->func));
+            if (!func) {
+                return std::nullopt;
+            }
+            auto aggregator = functions::aggregate_fcts::make_batch_aggregator(*func, constant_arguments);
+            if (!aggregator) {
+                return std::nullopt;
+            }
+            return batched_aggregate{std::move(aggregator), column_index};
+        }
+
+        void load_batched_aggregates() {
+            for (size_t i = 0; i != _batched.size(); ++i) {
+                if (_batched[i]) {
+                    _batched[i]->aggregator->load(to_bytes_opt(_temporaries[i]));
+                }
+            }
+        }
+
+        void sync_batched_aggregates() {
+            for (size_t i = 0; i != _batched.size(); ++i) {
+                if (_batched[i]) {
+                    _temporaries[i] = raw_value::make_value(_batched[i]->aggregator->store());
+                }
+            }
+        }
     public:
         explicit selectors_with_processing(const selection_with_processing& sel)
             : _sel(sel)
@@ -355,7 +441,13 @@ class selection_with_processing : public selection {
                 });
              }))
             , _input_row_count(0)
-        { }
+        {
+            _batched.reserve(_sel._inner_loop.size());
+            for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
+                _batched.push_back(make_batched_aggregate(_sel._inner_loop[i], i));
+            }
+            load_batched_aggregates();
+        }
 
         virtual bool requires_thread() const override {
             return _requires_thread;
@@ -363,6 +455,7 @@ class selection_with_processing : public selection {
 
         virtual void reset() override {
             _temporaries = _sel._initial_values_for_temporaries;
+            load_batched_aggregates();
             _input_row_count = 0;
         }
 
@@ -391,6 +484,7 @@ class selection_with_processing : public selection {
         }
 
         virtual std::vector<managed_bytes_opt> get_output_row() override {
+            sync_batched_aggregates();
             std::vector<managed_bytes_opt> output_row;
             output_row.reserve(_sel._outer_loop.size());
             auto inputs = expr::evaluation_inputs{
@@ -422,6 +516,17 @@ class selection_with_processing : public selection {
                     .temporaries = _temporaries,
             };
             for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
+                if (auto& batched = _batched[i]) {
+                    auto value = batched->column_index ? managed_bytes_view_opt(rs.current[*batched->column_index]) : std::nullopt;
+                    if (batched->aggregator->add(value)) {
+                        continue;
+                    }
+                    // The aggregator can't take this input, apply the aggregation function to it.
+                    _temporaries[i] = raw_value::make_value(batched->aggregator->store());
+                    _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
+                    batched->aggregator->load(to_bytes_opt(_temporaries[i]));
+                    continue;
+                }
                 _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
             }
             ++_input_row_count;
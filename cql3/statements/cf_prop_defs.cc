@@ -21,6 +21,7 @@
 #include "tombstone_gc.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "db/bloom_filter_extension.hh"
 #include "db/tablet_options.hh"
 #include "utils/bloom_calculations.hh"
 #include "db/config.hh"
@@ -139,6 +140,10 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         cp.validate(
             compression_parameters::dicts_feature_enabled(bool(db.features().sstable_compression_dicts)),
             compression_parameters::dicts_usage_allowed(db.get_config().sstable_compression_dictionaries_allow_in_ddl()));
+        // Older nodes would fail to parse the 'auto' chunk length when loading the schema.
+        if (cp.auto_chunk_length() && !db.features().auto_compression_chunk_length) {
+            throw exceptions::configuration_exception("The 'auto' chunk_length_in_kb is not supported yet by the whole cluster");
+        }
     }
 
     auto per_partition_rate_limit_options = get_per_partition_rate_limit_options(schema_extensions);
@@ -149,6 +154,24 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
 
+    // Nodes which don't know the split-block layout would read such filters
+    // as classic ones, and miss keys which are present.
+    if (schema_extensions.contains(db::bloom_filter_extension::NAME) && !db.features().split_block_bloom_filter) {
+        throw exceptions::configuration_exception("The bloom_filter option is not supported yet by the whole cluster");
+    }
+
+    // Older nodes would reject the unknown "admission" caching key when loading the schema.
+    auto caching = get_caching_options();
+    if (caching && caching->frequency_admission() && !db.features().row_cache_frequency_admission) {
+        throw exceptions::configuration_exception("Frequency-based cache admission is not supported yet by the whole cluster");
+    }
+    if (caching && caching->results_ttl().count() && !db.features().query_result_cache) {
+        throw exceptions::configuration_exception("Caching of query results is not supported yet by the whole cluster");
+    }
+    if (caching && caching->intern_values() && !db.features().cell_value_interning) {
+        throw exceptions::configuration_exception("Interning of cell values is not supported yet by the whole cluster");
+    }
+
     validate_minimum_int(KW_DEFAULT_TIME_TO_LIVE, 0, DEFAULT_DEFAULT_TIME_TO_LIVE);
     validate_minimum_int(KW_PAXOSGRACESECONDS, 0, DEFAULT_GC_GRACE_SECONDS);
 
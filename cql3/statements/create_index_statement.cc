@@ -26,6 +26,8 @@
 #include "cql3/index_name.hh"
 #include "cql3/statements/index_prop_defs.hh"
 #include "index/secondary_index_manager.hh"
+#include "index/secondary_index.hh"
+#include "cql3/util.hh"
 #include "mutation/mutation.hh"
 
 #include <stdexcept>
@@ -341,10 +343,57 @@ void create_index_statement::validate_targets_for_multi_column_index(std::vector
     }
 }
 
+std::optional<sstring> create_index_statement::validate_included_columns(data_dictionary::database db, const schema& schema,
+        const std::vector<::shared_ptr<index_target>>& targets) const {
+    if (!_properties || _properties->custom_class) {
+        return std::nullopt;
+    }
+    auto options = _properties->get_raw_options();
+    auto it = options.find(db::index::secondary_index::include_option_name);
+    if (it == options.end()) {
+        return std::nullopt;
+    }
+    if (!db.features().covering_indexes) {
+        throw exceptions::invalid_request_exception("Cluster does not support including columns in secondary indexes yet,"
+                " upgrade the whole cluster first in order to be able to create them");
+    }
+    const auto& target = targets.back();
+    if (target->type != index_target::target_type::regular_values) {
+        throw exceptions::invalid_request_exception(
+                format("Cannot include columns in an index on {} of column {}", target_type_name(target->type), target->column_name()));
+    }
+    auto names = secondary_index::parse_included_columns(it->second);
+    std::vector<sstring> quoted_names;
+    std::unordered_set<sstring> seen;
+    for (const auto& name : names) {
+        auto cd = schema.get_column_definition(to_bytes(name));
+        if (!cd) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", cql3::util::maybe_quote(name)));
+        }
+        if (!cd->is_regular()) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot include column {} in the index, only regular columns can be included", cd->name_as_cql_string()));
+        }
+        if (name == target->column_name()) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot include the indexed column {} in the index", cd->name_as_cql_string()));
+        }
+        if (!seen.insert(name).second) {
+            throw exceptions::invalid_request_exception(format("Duplicate column {} in the list of included columns", cd->name_as_cql_string()));
+        }
+        quoted_names.push_back(cd->name_as_cql_string());
+    }
+    if (quoted_names.empty()) {
+        throw exceptions::invalid_request_exception("The list of included columns cannot be empty");
+    }
+    return fmt::to_string(fmt::join(quoted_names, ", "));
+}
+
 std::optional<create_index_statement::base_schema_with_new_index> create_index_statement::build_index_schema(data_dictionary::database db) const {
     auto targets = validate_while_executing(db);
 
     auto schema = db.find_schema(keyspace(), column_family());
+    auto included_columns = validate_included_columns(db, *schema, targets);
 
     sstring accepted_name = _index_name;
     if (accepted_name.empty()) {
@@ -363,6 +412,9 @@ std::optional<create_index_statement::base_schema_with_new_index> create_index_s
         kind = index_metadata_kind::custom;
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
+        if (included_columns) {
+            index_options.emplace(db::index::secondary_index::include_option_name, std::move(*included_columns));
+        }
     }
     auto index = make_index_metadata(targets, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
@@ -64,6 +64,10 @@ class create_index_statement : public schema_altering_statement {
                                                                   const index_target& target) const;
     void validate_target_column_is_map_if_index_involves_keys(bool is_map, const index_target& target) const;
     void validate_targets_for_multi_column_index(std::vector<::shared_ptr<index_target>> targets) const;
+    // Validates the columns listed in the "include" option, if any, and returns
+    // the option normalized to a list of quoted-if-needed column names.
+    std::optional<sstring> validate_included_columns(data_dictionary::database db, const schema& schema,
+                                                     const std::vector<::shared_ptr<index_target>>& targets) const;
     static index_metadata make_index_metadata(const std::vector<::shared_ptr<index_target>>& targets,
                                               const sstring& name,
                                               index_metadata_kind kind,
@@ -24,7 +24,12 @@ void cql3::statements::index_prop_defs::validate() {
     }
     
     if (!custom_class && !_properties.empty()) {
-        throw exceptions::invalid_request_exception("Cannot specify options for a non-CUSTOM index");
+        auto options = get_raw_options();
+        if (options.size() != 1 || !options.contains(db::index::secondary_index::include_option_name)) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot specify options other than '{}' for a non-CUSTOM index",
+                            db::index::secondary_index::include_option_name));
+        }
     }
     if (get_raw_options().count(
             db::index::secondary_index::custom_index_option_name)) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <unordered_set>
+
+#include "cql3/statements/schema_batch_statement.hh"
+#include "cql3/statements/prepared_statement.hh"
+#include "cql3/query_processor.hh"
+#include "exceptions/exceptions.hh"
+#include "service/client_state.hh"
+#include "service/query_state.hh"
+#include "utils/hash.hh"
+
+namespace cql3 {
+
+namespace statements {
+
+static logging::logger mylogger("schema_batch");
+
+schema_batch_statement::schema_batch_statement(std::vector<shared_ptr<schema_altering_statement>> statements)
+    : schema_altering_statement()
+    , _statements(std::move(statements))
+{ }
+
+future<> schema_batch_statement::check_access(query_processor& qp, const service::client_state& state) const {
+    for (auto& s : _statements) {
+        co_await s->check_access(qp, state);
+    }
+}
+
+void schema_batch_statement::validate(query_processor& qp, const service::client_state& state) const {
+    for (auto& s : _statements) {
+        s->validate(qp, state);
+    }
+}
+
+future<std::tuple<::shared_ptr<schema_altering_statement::event_t>, cql3::cql_warnings_vec>>
+schema_batch_statement::prepare_schema_mutations(query_processor& qp, service::query_state& state, const query_options& options, service::group0_batch& mc) const {
+    ::shared_ptr<event_t> event;
+    cql3::cql_warnings_vec warnings;
+    auto& client_state = state.get_client_state();
+    for (auto& s : _statements) {
+        // All the statements share the guard, and hence the timestamp, of the batch.
+        auto [ce, muts, w] = co_await s->prepare_schema_mutations(qp, options, mc.write_timestamp());
+        // Like query_processor::execute_schema_statement(), only grant
+        // permissions on what the statement actually created.
+        bool created = !muts.empty();
+        mc.add_mutations(std::move(muts));
+        if (created && !client_state.is_internal()) {
+            co_await s->grant_permissions_to_creator(client_state, mc);
+        }
+        if (ce) {
+            event = std::move(ce);
+        }
+        std::move(w.begin(), w.end(), std::back_inserter(warnings));
+    }
+    // The result carries a single event, which is enough for the drivers to
+    // wait for schema agreement. The notifications of all the changes are
+    // sent to the subscribed clients as usual, as the schema is merged.
+    co_return std::make_tuple(std::move(event), std::move(warnings));
+}
+
+std::unique_ptr<prepared_statement>
+schema_batch_statement::prepare(data_dictionary::database db, cql_stats& stats) {
+    // Cannot happen; schema_batch_statement is never instantiated as a raw statement
+    // (instead we instantiate schema_batch_statement::raw_statement)
+    abort();
+}
+
+schema_batch_statement::raw_statement::raw_statement(std::vector<parsed> parsed_statements)
+    : cf_statement(std::nullopt)
+    , _parsed_statements(std::move(parsed_statements))
+{ }
+
+void schema_batch_statement::raw_statement::prepare_keyspace(const service::client_state& state) {
+    for (auto& p : _parsed_statements) {
+        p.statement->prepare_keyspace(state);
+    }
+}
+
+std::unique_ptr<prepared_statement>
+schema_batch_statement::raw_statement::prepare(data_dictionary::database db, cql_stats& stats) {
+    if (_parsed_statements.empty()) {
+        throw exceptions::invalid_request_exception("A schema batch must contain at least one statement");
+    }
+    std::vector<shared_ptr<schema_altering_statement>> statements;
+    std::vector<sstring> warnings;
+    std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> targets;
+    statements.reserve(_parsed_statements.size());
+    for (auto& p : _parsed_statements) {
+        // The statements are validated against the schema as it was before the
+        // batch, and their mutations are merged together, so two statements on
+        // the same table would conflict.
+        if (!targets.emplace(p.statement->keyspace(), p.statement->column_family()).second) {
+            throw exceptions::invalid_request_exception(format("Table {}.{} is the target of more than one statement in the schema batch",
+                    p.statement->keyspace(), p.statement->column_family()));
+        }
+        auto prepared = p.statement->prepare(db, stats);
+        auto s = dynamic_pointer_cast<schema_altering_statement>(prepared->statement);
+        if (!s) {
+            on_internal_error(mylogger, format("Unexpected statement in a schema batch: {}", p.raw_cql));
+        }
+        if (s->get_bound_terms() > 0) {
+            throw exceptions::invalid_request_exception("Bind variables are not supported in a schema batch");
+        }
+        s->raw_cql_statement = p.raw_cql;
+        if (auto audit_info = s->get_audit_info()) {
+            audit_info->set_query_string(p.raw_cql);
+        }
+        std::move(prepared->warnings.begin(), prepared->warnings.end(), std::back_inserter(warnings));
+        statements.push_back(std::move(s));
+    }
+    return std::make_unique<prepared_statement>(audit_info(), ::make_shared<schema_batch_statement>(std::move(statements)), std::move(warnings));
+}
+
+audit::statement_category schema_batch_statement::raw_statement::category() const {
+    return audit::statement_category::DDL;
+}
+
+}
+
+}
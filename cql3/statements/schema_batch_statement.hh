@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "cql3/statements/schema_altering_statement.hh"
+#include "cql3/statements/raw/cf_statement.hh"
+
+#include <vector>
+
+namespace cql3 {
+
+class query_processor;
+
+namespace statements {
+
+/**
+ * BEGIN SCHEMA BATCH <ddl>; ... APPLY BATCH
+ *
+ * Applies several CREATE TABLE, ALTER TABLE and CREATE INDEX statements as
+ * a single schema change, that is, a single group 0 command which every node
+ * merges in a single pass, instead of one command and one merge per statement.
+ *
+ * Each statement is prepared and validated against the schema as it was
+ * before the batch, so a statement can't refer to an object created earlier
+ * in the same batch, and each table can be the target of at most one
+ * statement.
+ */
+class schema_batch_statement : public schema_altering_statement {
+    std::vector<shared_ptr<schema_altering_statement>> _statements;
+public:
+    explicit schema_batch_statement(std::vector<shared_ptr<schema_altering_statement>> statements);
+
+    const std::vector<shared_ptr<schema_altering_statement>>& statements() const {
+        return _statements;
+    }
+
+    virtual future<> check_access(query_processor& qp, const service::client_state& state) const override;
+
+    virtual void validate(query_processor& qp, const service::client_state& state) const override;
+
+    virtual future<std::tuple<::shared_ptr<event_t>, cql3::cql_warnings_vec>> prepare_schema_mutations(query_processor& qp, service::query_state& state, const query_options& options, service::group0_batch& mc) const override;
+
+    virtual std::unique_ptr<prepared_statement> prepare(data_dictionary::database db, cql_stats& stats) override;
+
+    class raw_statement;
+};
+
+class schema_batch_statement::raw_statement : public raw::cf_statement {
+public:
+    struct parsed {
+        std::unique_ptr<raw::cf_statement> statement;
+        sstring raw_cql;
+    };
+private:
+    std::vector<parsed> _parsed_statements;
+public:
+    explicit raw_statement(std::vector<parsed> parsed_statements);
+
+    virtual void prepare_keyspace(const service::client_state& state) override;
+
+    virtual std::unique_ptr<prepared_statement> prepare(data_dictionary::database db, cql_stats& stats) override;
+protected:
+    virtual audit::statement_category category() const override;
+    virtual audit::audit_info_ptr audit_info() const override {
+        // The statements inside the batch are audited instead.
+        return audit::audit::create_no_audit_info();
+    }
+};
+
+}
+
+}
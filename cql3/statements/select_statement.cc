@@ -25,11 +25,13 @@
 #include "service/qos/qos_common.hh"
 #include "service/vector_store_client.hh"
 #include "transport/messages/result_message.hh"
+#include "cql3/functions/aggregate_fcts.hh"
 #include "cql3/functions/as_json_function.hh"
 #include "cql3/selection/selection.hh"
 #include "cql3/util.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "index/secondary_index.hh"
+#include "index/vector_index.hh"
 #include "types/vector.hh"
 #include "validation.hh"
 #include "exceptions/unrecognized_entity_exception.hh"
@@ -211,6 +213,25 @@ select_statement::select_statement(schema_ptr schema,
     _opts.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
     _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
     _opts.set_if<query::partition_slice::option::reversed>(_is_reversed);
+    _results_cacheable = !_restrictions->is_key_range()
+            && !_restrictions->uses_secondary_indexing()
+            && !_restrictions->has_token_restrictions()
+            && _restrictions->partition_key_restrictions_is_all_eq()
+            && !_restrictions_need_filtering
+            && !expr::contains_nonpure_function(_restrictions->get_partition_key_restrictions())
+            && !expr::contains_nonpure_function(_restrictions->get_clustering_columns_restrictions())
+            && std::ranges::all_of(_selection->used_functions(), [] (const auto& f) { return f->is_pure(); });
+}
+
+std::optional<dht::token> select_statement::cacheable_partition_token(const query_options& options) const {
+    if (!_results_cacheable || !_schema->caching_options().results_ttl().count()) {
+        return std::nullopt;
+    }
+    auto ranges = _restrictions->get_partition_key_ranges(options);
+    if (ranges.size() != 1 || !ranges.front().is_singular()) {
+        return std::nullopt;
+    }
+    return ranges.front().start()->value().token();
 }
 
 db::timeout_clock::duration select_statement::get_timeout(const service::client_state& state, const query_options& options) const {
@@ -316,6 +337,69 @@ select_statement::make_partition_slice(const query_options& options) const
         std::move(static_columns), std::move(regular_columns), _opts, nullptr, per_partition_limit);
 }
 
+lw_shared_ptr<query::read_command>
+select_statement::make_read_command(query::read_command cmd) const {
+    // The statement is executed on a single shard, and the command is only shared
+    // with the execution until it completes, so if nothing else refers to it, it
+    // is free to be overwritten.
+    if (_last_read_command && _last_read_command.use_count() == 1) {
+        *_last_read_command = std::move(cmd);
+    } else {
+        _last_read_command = ::make_lw_shared<query::read_command>(std::move(cmd));
+    }
+    return _last_read_command;
+}
+
+std::vector<query::cell_predicate>
+select_statement::make_row_filter(const query_options& options) const {
+    std::vector<query::cell_predicate> row_filter;
+    for (auto& e : expr::boolean_factors(_restrictions->get_clustering_row_level_filter())) {
+        auto binop = expr::as_if<expr::binary_operator>(&e);
+        if (!binop || binop->null_handling != expr::null_handling_style::sql) {
+            continue;
+        }
+        auto col = expr::as_if<expr::column_value>(&binop->lhs);
+        if (!col || !col->col->is_regular() || !col->col->is_atomic() || col->col->is_counter()
+                || _selection->index_of(*col->col) < 0) {
+            continue;
+        }
+        if (expr::find_in_expression<expr::column_value>(binop->rhs, [] (const expr::column_value&) { return true; })) {
+            continue;
+        }
+        query::cell_predicate::op oper;
+        switch (binop->op) {
+        case expr::oper_t::EQ: oper = query::cell_predicate::op::eq; break;
+        case expr::oper_t::LT: oper = query::cell_predicate::op::lt; break;
+        case expr::oper_t::LTE: oper = query::cell_predicate::op::lte; break;
+        case expr::oper_t::GT: oper = query::cell_predicate::op::gt; break;
+        case expr::oper_t::GTE: oper = query::cell_predicate::op::gte; break;
+        case expr::oper_t::IN: oper = query::cell_predicate::op::in; break;
+        default: continue;
+        }
+        auto rhs = expr::evaluate(binop->rhs, options);
+        if (rhs.is_null()) {
+            // Matches no rows, leave it to the coordinator.
+            continue;
+        }
+        std::vector<bytes> values;
+        if (oper == query::cell_predicate::op::in) {
+            for (auto& v : expr::get_list_elements(rhs)) {
+                if (v) {
+                    values.push_back(to_bytes(*v));
+                }
+            }
+        } else {
+            values.push_back(std::move(rhs).to_bytes());
+        }
+        row_filter.push_back(query::cell_predicate{
+            .column = col->col->id,
+            .oper = oper,
+            .values = std::move(values),
+        });
+    }
+    return row_filter;
+}
+
 uint64_t select_statement::get_limit(const query_options& options, const std::optional<expr::expression>& limit, bool is_per_partition_limit) const
 {
     const auto& unset_guard = is_per_partition_limit ? _per_partition_limit_unset_guard : _limit_unset_guard;
@@ -410,8 +494,11 @@ select_statement::do_execute(query_processor& qp,
     _stats.select_partition_range_scan_no_bypass_cache += _range_scan_no_bypass_cache;
 
     auto slice = make_partition_slice(options);
+    if (_restrictions_need_filtering && qp.proxy().features().replica_side_filtering) {
+        slice.set_row_filter(make_row_filter(options));
+    }
     auto max_result_size = qp.proxy().get_max_result_size(slice);
-    auto command = ::make_lw_shared<query::read_command>(
+    auto command = make_read_command(query::read_command(
             _query_schema->id(),
             _query_schema->version(),
             std::move(slice),
@@ -423,8 +510,8 @@ select_statement::do_execute(query_processor& qp,
             tracing::make_trace_info(state.get_trace_state()),
             query_id::create_null_id(),
             query::is_first_page::no,
-            options.get_timestamp(state));
-    command->allow_limit = db::allow_per_partition_rate_limit::yes;
+            options.get_timestamp(state),
+            db::allow_per_partition_rate_limit::yes));
     logger.trace("Executing read query (reversed {}): table schema {}, query schema {}",
         command->slice.is_reversed(), _schema->version(), _query_schema->version());
     tracing::trace(state.get_trace_state(), "Executing read query (reversed {})", command->slice.is_reversed());
@@ -1089,6 +1176,46 @@ indexed_table_select_statement::indexed_table_select_statement(schema_ptr schema
         _get_partition_ranges_for_posting_list = [this] (const query_options& options) { return get_partition_ranges_for_global_index_posting_list(options); };
         _get_partition_slice_for_posting_list = [this] (const query_options& options) { return get_partition_slice_for_global_index_posting_list(options); };
     }
+    _covering_view_columns = find_covering_view_columns();
+}
+
+std::optional<std::vector<const column_definition*>> indexed_table_select_statement::find_covering_view_columns() const {
+    // Only simple queries, whose result is just the matching view rows,
+    // can be served from the index view. Everything else, including any
+    // restriction which the view read wouldn't apply, goes through the
+    // base table.
+    if (!_view_schema || _prepared_ann_ordering || _index.target_type() != index_target::target_type::regular_values) {
+        return std::nullopt;
+    }
+    const auto* target = _schema->get_column_definition(to_bytes(_index.target_column()));
+    if (!target || target->is_static()) {
+        return std::nullopt;
+    }
+    if (_selection->is_aggregate() || has_group_by() || !_selection->is_trivial()
+            || _restrictions_need_filtering || _per_partition_limit || _is_reversed || _ordering_comparator
+            || _parameters->is_distinct() || _parameters->is_json() || !_parameters->orderings().empty()
+            || _restrictions->has_clustering_columns_restriction()) {
+        return std::nullopt;
+    }
+    if (!_index.metadata().local() && !_restrictions->partition_key_restrictions_is_empty()
+            && (_restrictions->has_partition_key_unrestricted_components()
+                || (!_restrictions->has_token_restrictions() && !_restrictions->partition_key_restrictions_is_all_eq()))) {
+        return std::nullopt;
+    }
+    const auto& selected = _selection->get_columns();
+    if (_selection->get_result_metadata()->column_count() != selected.size()) {
+        return std::nullopt;
+    }
+    std::vector<const column_definition*> view_columns;
+    view_columns.reserve(selected.size());
+    for (const auto* cdef : selected) {
+        const auto* view_cdef = _view_schema->get_column_definition(cdef->name());
+        if (!view_cdef || view_cdef->is_view_virtual() || view_cdef->is_static()) {
+            return std::nullopt;
+        }
+        view_columns.push_back(view_cdef);
+    }
+    return view_columns;
 }
 
 template<typename KeyType>
@@ -1204,8 +1331,18 @@ indexed_table_select_statement::do_execute(query_processor& qp,
         auto values = value_cast<vector_type_impl::native_type>(ann_column->type->deserialize(expr::evaluate(ann_vector_expr, options).to_bytes()));
         auto ann_vector = util::to_vector<float>(values);
 
-        auto as = abort_source();
-        auto pkeys = co_await qp.vector_store_client().ann(_schema->ks_name(), _index.metadata().name(), _schema , std::move(ann_vector), limit, as);
+        std::expected<std::vector<primary_key>, service::vector_store_client::ann_error> pkeys;
+        if (qp.vector_store_client().is_disabled() && qp.db().get_config().vector_search_local_fallback()) {
+            tracing::trace(state.get_trace_state(), "Vector store is disabled, searching index {} locally", _index.metadata().name());
+            auto local_pkeys = co_await find_ann_primary_keys_locally(qp, state, options, *ann_column, std::move(ann_vector), limit, now);
+            if (local_pkeys.has_error()) {
+                co_return failed_result_to_result_message(std::move(local_pkeys));
+            }
+            pkeys = std::move(local_pkeys).assume_value();
+        } else {
+            auto as = abort_source();
+            pkeys = co_await qp.vector_store_client().ann(_schema->ks_name(), _index.metadata().name(), _schema , std::move(ann_vector), limit, as);
+        }
         if (!pkeys.has_value()) {
             co_await coroutine::return_exception(exceptions::invalid_request_exception(
                 std::visit(service::vector_store_client::ann_error_visitor{}, pkeys.error())
@@ -1227,6 +1364,12 @@ indexed_table_select_statement::do_execute(query_processor& qp,
 
     _stats.unpaged_select_queries(_ks_sel) += options.get_page_size() <= 0;
 
+    if (_covering_view_columns) {
+        tracing::trace(state.get_trace_state(), "Index {} covers the query, reading it without the base table", _index.metadata().name());
+        ++_stats.secondary_index_covered_reads;
+        co_return co_await execute_covering_index_query(qp, state, options, now);
+    }
+
     // Secondary index search has two steps: 1. use the index table to find a
     // list of primary keys matching the query. 2. read the rows matching
     // these primary keys from the base table and return the selected columns.
@@ -1471,6 +1614,181 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
     }));
 }
 
+future<exceptions::coordinator_result<std::vector<primary_key>>>
+indexed_table_select_statement::find_ann_primary_keys_locally(query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        const column_definition& ann_column,
+        std::vector<float> ann_vector,
+        uint64_t limit,
+        gc_clock::time_point now) const
+{
+    ++_stats.vector_local_searches;
+    if (limit == 0) {
+        co_return std::vector<primary_key>();
+    }
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    auto similarity_function = secondary_index::vector_index::get_similarity_function(_index.metadata());
+    auto dimension = static_cast<const vector_type_impl&>(*ann_column.type).get_dimension();
+    const auto pk_size = _schema->partition_key_size();
+    const auto ck_size = _schema->clustering_key_size();
+
+    std::vector<const column_definition*> columns;
+    for (const auto& cdef : _schema->partition_key_columns()) {
+        columns.push_back(&cdef);
+    }
+    for (const auto& cdef : _schema->clustering_key_columns()) {
+        columns.push_back(&cdef);
+    }
+    columns.push_back(&ann_column);
+    auto selection = selection::selection::for_columns(_schema, columns);
+
+    partition_slice_builder slice_builder(*_schema);
+    slice_builder.with_no_regular_columns().with_no_static_columns();
+    if (ann_column.is_static()) {
+        slice_builder.with_static_column(ann_column.name());
+    } else {
+        slice_builder.with_regular_column(ann_column.name());
+    }
+    auto partition_slice = slice_builder.build();
+    auto cmd = ::make_lw_shared<query::read_command>(
+            _schema->id(),
+            _schema->version(),
+            partition_slice,
+            qp.proxy().get_max_result_size(partition_slice),
+            query::tombstone_limit(qp.proxy().get_tombstone_limit()),
+            query::row_limit(query::max_rows),
+            query::partition_limit(query::max_partitions),
+            now,
+            tracing::make_trace_info(state.get_trace_state()),
+            query_id::create_null_id(),
+            query::is_first_page::no,
+            options.get_timestamp(state));
+
+    auto internal_options = std::make_unique<cql3::query_options>(cql3::query_options(options));
+    internal_options.reset(new cql3::query_options(std::move(internal_options), nullptr, internal_paging_size));
+    auto pager = service::pager::query_pagers::pager(qp.proxy(), _schema, selection, state, *internal_options, cmd,
+            {dht::partition_range::make_open_ended_both_sides()}, nullptr);
+
+    // The best `limit` rows seen so far, kept as a heap with the least
+    // similar row at the front.
+    struct candidate {
+        float similarity;
+        primary_key key;
+    };
+    auto more_similar = [] (const candidate& a, const candidate& b) {
+        return a.similarity > b.similarity;
+    };
+    std::vector<candidate> best;
+    best.reserve(limit);
+    std::vector<float> row_vector;
+    while (!pager->is_exhausted()) {
+        auto rs = co_await pager->fetch_page_result(internal_paging_size, now, timeout);
+        if (rs.has_error()) {
+            co_return std::move(rs).as_failure();
+        }
+        for (const auto& row : rs.value()->rows()) {
+            ++_stats.vector_local_search_rows_scanned;
+            const auto& cell = row[pk_size + ck_size];
+            if (!cell || (ck_size && !row[pk_size]) || !secondary_index::vector_index::deserialize_vector(to_bytes(*cell), dimension, row_vector)) {
+                continue;
+            }
+            float similarity = secondary_index::vector_index::similarity(similarity_function, ann_vector, row_vector);
+            if (best.size() == limit && !(similarity > best.front().similarity)) {
+                continue;
+            }
+            auto key_cells = [&] (size_t begin, size_t size) {
+                return std::ranges::subrange(row.begin() + begin, row.begin() + begin + size) | std::views::transform([] (const managed_bytes_opt& v) {
+                    return to_bytes(*v);
+                }) | std::ranges::to<std::vector<bytes>>();
+            };
+            auto pk = partition_key::from_exploded(*_schema, key_cells(0, pk_size));
+            auto ck = clustering_key_prefix::from_exploded(*_schema, key_cells(pk_size, ck_size));
+            if (best.size() == limit) {
+                std::ranges::pop_heap(best, more_similar);
+                best.pop_back();
+            }
+            best.push_back(candidate{similarity, primary_key{dht::decorate_key(*_schema, std::move(pk)), std::move(ck)}});
+            std::ranges::push_heap(best, more_similar);
+        }
+    }
+    std::ranges::sort_heap(best, more_similar);
+    co_return best | std::views::transform([] (candidate& c) {
+        return std::move(c.key);
+    }) | std::ranges::to<std::vector<primary_key>>();
+}
+
+future<shared_ptr<cql_transport::messages::result_message>>
+indexed_table_select_statement::execute_covering_index_query(query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        gc_clock::time_point now) const
+{
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
+    // The visitor consumes regular cells in the order of the selection, so
+    // the slice has to request them in the same order.
+    partition_slice_builder slice_builder(*_view_schema, _get_partition_slice_for_posting_list(options));
+    slice_builder.with_no_regular_columns();
+    for (const auto* cdef : *_covering_view_columns) {
+        if (cdef->is_regular()) {
+            slice_builder.with_regular_column(cdef->name());
+        }
+    }
+    auto partition_slice = slice_builder.build();
+
+    auto cmd = ::make_lw_shared<query::read_command>(
+            _view_schema->id(),
+            _view_schema->version(),
+            partition_slice,
+            qp.proxy().get_max_result_size(partition_slice),
+            query::tombstone_limit(qp.proxy().get_tombstone_limit()),
+            query::row_limit(get_limit(options, _limit)),
+            query::partition_limit(query::max_partitions),
+            now,
+            tracing::make_trace_info(state.get_trace_state()),
+            query_id::create_null_id(),
+            query::is_first_page::no,
+            options.get_timestamp(state));
+
+    auto selection = selection::selection::for_columns(_view_schema, *_covering_view_columns);
+
+    // The rows read from the view are returned with the metadata of the
+    // statement, which refers to the base table.
+    auto make_result = [this] (const cql3::result_set& view_rs, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+        auto rs = std::make_unique<cql3::result_set>(::make_shared<cql3::metadata>(*_selection->get_result_metadata()));
+        for (const auto& row : view_rs.rows()) {
+            rs->add_row(row);
+        }
+        if (paging_state) {
+            rs->get_metadata().set_paging_state(std::move(paging_state));
+        }
+        update_stats_rows_read(rs->size());
+        return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+    };
+
+    int32_t page_size = options.get_page_size();
+    if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*_view_schema, page_size, *cmd, partition_ranges)) {
+        auto qr = co_await qp.proxy().query_result(_view_schema, cmd, std::move(partition_ranges), options.get_consistency(),
+                {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+        if (qr.has_error()) {
+            co_return failed_result_to_result_message(std::move(qr));
+        }
+        cql3::selection::result_set_builder builder(*selection, now, &options);
+        query::result_view::consume(*qr.value().query_result, partition_slice,
+                cql3::selection::result_set_builder::visitor(builder, *_view_schema, *selection));
+        co_return make_result(*builder.build(), nullptr);
+    }
+
+    auto p = service::pager::query_pagers::pager(qp.proxy(), _view_schema, selection,
+            state, options, cmd, std::move(partition_ranges), nullptr);
+    auto rs = co_await p->fetch_page_result(page_size, now, timeout);
+    if (rs.has_error()) {
+        co_return failed_result_to_result_message(std::move(rs));
+    }
+    co_return make_result(*rs.value(), p->is_exhausted() ? nullptr : p->state());
+}
+
 // Note: the partitions keys returned by this function are sorted
 // in token order. See issue #3423.
 future<coordinator_result<std::tuple<dht::partition_range_vector, lw_shared_ptr<const service::pager::paging_state>>>>
@@ -2185,6 +2503,19 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
         );
     };
 
+    // Nodes which don't know the approximate aggregates can't execute their parts,
+    // and ignore constant arguments of aggregates, which came along with them.
+    auto reductions_supported_by_all_nodes = [&] {
+        if (db.features().approximate_aggregates) {
+            return true;
+        }
+        return std::ranges::none_of(selection->get_reductions().infos, [] (const query::mapreduce_request::aggregation_info& info) {
+            return !info.constant_arguments.empty()
+                    || info.name.name == functions::aggregate_fcts::APPROX_COUNT_DISTINCT_FUNCTION_NAME
+                    || info.name.name == functions::aggregate_fcts::APPROX_PERCENTILE_FUNCTION_NAME;
+        });
+    };
+
     auto is_local_table = [&] {
         return underlying_schema->table().get_effective_replication_map()->get_replication_strategy().is_local();
     };
@@ -2196,7 +2527,7 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
             && ( // SUPPORTED PARALLELIZATION
                  // All potential intermediate coordinators must support mapreduceing
                 (db.features().parallelized_aggregation && selection->is_count())
-                || (db.features().uda_native_parallelized_aggregation && selection->is_reducible())
+                || (db.features().uda_native_parallelized_aggregation && selection->is_reducible() && reductions_supported_by_all_nodes())
             )
             && !restrictions->need_filtering()  // No filtering
             && group_by_cell_indices->empty()   // No GROUP BY
@@ -96,7 +96,14 @@ class select_statement : public cql_statement {
     const ks_selector _ks_sel;
     bool _range_scan = false;
     bool _range_scan_no_bypass_cache = false;
+    // Whether the statement reads a single partition and its results depend only
+    // on the bound values, so that they can be served from cql3::query_result_cache.
+    bool _results_cacheable = false;
     std::unique_ptr<cql3::attributes> _attrs;
+    // The read command of the last execution, reused by the next one if no longer
+    // referenced, so that repeated executions of the statement don't allocate one
+    // each. See make_read_command().
+    mutable lw_shared_ptr<query::read_command> _last_read_command;
 private:
     future<shared_ptr<cql_transport::messages::result_message>> process_results_complex(foreign_ptr<lw_shared_ptr<query::result>> results,
         lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
@@ -150,12 +157,28 @@ protected :
 
     const sstring& column_family() const;
 
+    const schema_ptr& get_schema() const {
+        return _schema;
+    }
+
     query::partition_slice make_partition_slice(const query_options& options) const;
 
+    // Returns the command, reusing the allocation of the command of the previous
+    // execution, if it completed.
+    lw_shared_ptr<query::read_command> make_read_command(query::read_command cmd) const;
+
+    // Converts the single-column restrictions of the clustering row filter, which
+    // replicas can check on the stored cells, to partition_slice::row_filter().
+    std::vector<query::cell_predicate> make_row_filter(const query_options& options) const;
+
     const ::shared_ptr<const restrictions::statement_restrictions> get_restrictions() const;
 
     bool has_group_by() const { return _group_by_cell_indices && !_group_by_cell_indices->empty(); }
 
+    // Returns the token of the partition read by the statement, if the table enables
+    // caching of results and the results can be served from cql3::query_result_cache.
+    std::optional<dht::token> cacheable_partition_token(const query_options& options) const;
+
     db::timeout_clock::duration get_timeout(const service::client_state& state, const query_options& options) const;
 
 protected:
@@ -191,6 +214,10 @@ class indexed_table_select_statement : public select_statement {
     std::optional<prepared_ann_ordering_type>  _prepared_ann_ordering;
     noncopyable_function<dht::partition_range_vector(const query_options&)> _get_partition_ranges_for_posting_list;
     noncopyable_function<query::partition_slice(const query_options&)> _get_partition_slice_for_posting_list;
+    // Set if the index view stores all the selected columns, so that the
+    // query can be answered from the view alone. Holds the view columns
+    // corresponding to the selected columns, in the selection's order.
+    std::optional<std::vector<const column_definition*>> _covering_view_columns;
 public:
     static constexpr size_t max_base_table_query_concurrency = 4096;
     static constexpr size_t max_ann_query_limit = 1000;
@@ -313,6 +340,28 @@ class indexed_table_select_statement : public select_statement {
             db::timeout_clock::time_point timeout,
             bool include_base_clustering_key) const;
 
+    std::optional<std::vector<const column_definition*>> find_covering_view_columns() const;
+
+    // Finds the primary keys of the rows nearest to the given vector by
+    // comparing it with every row of the base table. Used for ANN queries
+    // when the vector store is not configured.
+    future<coordinator_result<std::vector<primary_key>>> find_ann_primary_keys_locally(
+            query_processor& qp,
+            service::query_state& state,
+            const query_options& options,
+            const column_definition& ann_column,
+            std::vector<float> ann_vector,
+            uint64_t limit,
+            gc_clock::time_point now) const;
+
+    // Reads the selected columns straight from the index view, without
+    // querying the base table. Used when _covering_view_columns is set.
+    future<shared_ptr<cql_transport::messages::result_message>> execute_covering_index_query(
+            query_processor& qp,
+            service::query_state& state,
+            const query_options& options,
+            gc_clock::time_point now) const;
+
     dht::partition_range_vector get_partition_ranges_for_local_index_posting_list(const query_options& options) const;
     dht::partition_range_vector get_partition_ranges_for_global_index_posting_list(const query_options& options) const;
 
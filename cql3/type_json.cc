@@ -28,52 +28,65 @@ static inline bool is_control_char(char c) {
     return c >= 0 && c <= 0x1F;
 }
 
-static inline bool needs_escaping(const sstring& s) {
+static inline bool needs_escaping(std::string_view s) {
     return std::any_of(s.begin(), s.end(), [](char c) {return is_control_char(c) || c == '"' || c == '\\';});
 }
 
-
-static sstring quote_json_string(const sstring& value) {
+static void write_quoted_json_string(bytes_ostream& out, std::string_view value) {
+    out.write("\"", 1);
     if (!needs_escaping(value)) {
-        return format("\"{}\"", value);
-    }
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    oss.put('"');
-    for (char c : value) {
+        out.write(value.data(), value.size());
+        out.write("\"", 1);
+        return;
+    }
+    // Writes the runs of characters which don't need escaping in one go.
+    size_t run_start = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        const char c = value[i];
+        const char* escaped = nullptr;
         switch (c) {
-        case '"':
-            oss.put('\\').put('"');
-            break;
-        case '\\':
-            oss.put('\\').put('\\');
-            break;
-        case '\b':
-            oss.put('\\').put('b');
-            break;
-        case '\f':
-            oss.put('\\').put('f');
-            break;
-        case '\n':
-            oss.put('\\').put('n');
-            break;
-        case '\r':
-            oss.put('\\').put('r');
-            break;
-        case '\t':
-            oss.put('\\').put('t');
-            break;
+        case '"': escaped = "\\\""; break;
+        case '\\': escaped = "\\\\"; break;
+        case '\b': escaped = "\\b"; break;
+        case '\f': escaped = "\\f"; break;
+        case '\n': escaped = "\\n"; break;
+        case '\r': escaped = "\\r"; break;
+        case '\t': escaped = "\\t"; break;
         default:
-            if (is_control_char(c)) {
-                oss.put('\\').put('u') << std::setw(4) << static_cast<int>(c);
-            } else {
-                oss.put(c);
+            if (!is_control_char(c)) {
+                continue;
             }
-            break;
+        }
+        out.write(value.data() + run_start, i - run_start);
+        run_start = i + 1;
+        if (escaped) {
+            out.write(escaped, 2);
+        } else {
+            char buf[6];
+            fmt::format_to(buf, "\\u{:04X}", static_cast<int>(c));
+            out.write(buf, sizeof(buf));
         }
     }
-    oss.put('"');
-    return std::move(oss).str();
+    out.write(value.data() + run_start, value.size() - run_start);
+    out.write("\"", 1);
+}
+
+static sstring linearized_sstring(const bytes_ostream& out) {
+    sstring ret(sstring::initialized_later(), out.size());
+    auto dst = ret.begin();
+    for (bytes_view frag : out) {
+        dst = std::copy_n(reinterpret_cast<const char*>(frag.data()), frag.size(), dst);
+    }
+    return ret;
+}
+
+static sstring quote_json_string(std::string_view value) {
+    if (!needs_escaping(value)) {
+        return format("\"{}\"", value);
+    }
+    bytes_ostream out;
+    write_quoted_json_string(out, value);
+    return linearized_sstring(out);
 }
 
 
@@ -397,151 +410,125 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json(bytes_ostream& out, const abstract_type& t, managed_bytes_view bv) {
+    if (bv.is_linearized()) {
+        write_json(out, t, bv.current_fragment());
+    } else {
+        write_json(out, t, bytes_view(linearized(bv)));
+    }
+}
 
-    out << '{';
+static void write_json_aux(bytes_ostream& out, const map_type_impl& t, bytes_view bv) {
+    out.write("{", 1);
     auto size = read_collection_size(bv);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_key(bv);
         auto vb = read_collection_value_nonnull(bv);
 
         if (i > 0) {
-            out << ", ";
+            out.write(", ", 2);
         }
 
         // Valid keys in JSON map must be quoted strings
-        sstring string_key = to_json_string(*t.get_keys_type(), kb);
-        bool is_unquoted = string_key.empty() || string_key[0] != '"';
-        if (is_unquoted) {
-            out << '"';
+        const bool quote_keys = to_json_type(*t.get_keys_type(), managed_bytes_view(kb)) != rjson::type::kStringType;
+        if (quote_keys) {
+            out.write("\"", 1);
         }
-        out << string_key;
-        if (is_unquoted) {
-            out << '"';
+        write_json(out, *t.get_keys_type(), kb);
+        if (quote_keys) {
+            out.write("\"", 1);
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        out.write(": ", 2);
+        write_json(out, *t.get_values_type(), vb);
     }
-    out << '}';
-    return std::move(out).str();
+    out.write("}", 1);
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_aux(bytes_ostream& out, const listlike_collection_type_impl& t, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
-    out << '[';
+    out.write("[", 1);
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            out.write(", ", 2);
         }
         if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
+            write_json(out, *t.get_elements_type(), *e);
         } else {
             // Impossible in sets, but let's not insist here.
-            out << "null";
+            out.write("null", 4);
         }
     });
-    out << ']';
-    return std::move(out).str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
-        } else {
-            out << "null";
-        }
-    });
-    out << ']';
-    return std::move(out).str();
-}
-
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_aux(bytes_ostream& out, const tuple_type_impl& t, bytes_view bv) {
+    out.write("[", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return std::move(out).str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const vector_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json_aux(bytes_ostream& out, const vector_type_impl& t, bytes_view bv) {
     auto fv = basic_single_fragmented_view<mutable_view::no>(bv);
 
-    out << '[';
+    out.write("[", 1);
 
     for (size_t i = 0; i < t.get_dimension(); ++i) {
         if (i != 0) {
-            out << ", ";
+            out.write(", ", 2);
         }
 
-        out << to_json_string(*t.get_elements_type(), read_vector_element(fv, *t.get_elements_type()->value_length_if_fixed()).current_fragment());
+        write_json(out, *t.get_elements_type(), read_vector_element(fv, *t.get_elements_type()->value_length_if_fixed()).current_fragment());
     }
 
-    out << ']';
-    return std::move(out).str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_aux(bytes_ostream& out, const user_type_impl& t, bytes_view bv) {
+    out.write("{", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        write_quoted_json_string(out, t.field_name_as_string(i));
+        out.write(": ", 2);
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return std::move(out).str();
+    out.write("}", 1);
 }
 
 namespace {
+// The JSON representation of scalar values
 struct to_json_string_visitor {
     bytes_view bv;
     sstring operator()(const reversed_type_impl& t) { return to_json_string(*t.underlying_type(), bv); }
@@ -564,12 +551,9 @@ struct to_json_string_visitor {
     sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
     sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(timestamp_to_json_string(t, bv)); }
     sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const vector_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
+    sstring operator()(const collection_type_impl& t) { return json_of_compound(t); }
+    sstring operator()(const tuple_type_impl& t) { return json_of_compound(t); }
+    sstring operator()(const vector_type_impl& t) { return json_of_compound(t); }
     sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
     sstring operator()(const time_type_impl& t) { return quote_json_string(t.to_string(bv)); }
     sstring operator()(const empty_type_impl& t) { return "null"; }
@@ -598,7 +582,38 @@ struct to_json_string_visitor {
         auto v = t.deserialize(bv);
         return value_cast<utils::multiprecision_int>(v).str();
     }
+
+    sstring json_of_compound(const abstract_type& t) {
+        bytes_ostream out;
+        write_json(out, t, bv);
+        return linearized_sstring(out);
+    }
 };
+
+// Writes compound values element by element, and strings without copying
+// them first. Everything else goes through to_json_string_visitor.
+struct write_json_visitor {
+    bytes_ostream& out;
+    bytes_view bv;
+    void operator()(const reversed_type_impl& t) { write_json(out, *t.underlying_type(), bv); }
+    void operator()(const string_type_impl& t) {
+        write_quoted_json_string(out, std::string_view(reinterpret_cast<const char*>(bv.data()), bv.size()));
+    }
+    void operator()(const map_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const set_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const list_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const vector_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const user_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const abstract_type& t) {
+        auto str = to_json_string(t, bv);
+        out.write(str.data(), str.size());
+    }
+};
+}
+
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv) {
+    visit(t, write_json_visitor{out, bv});
 }
 
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
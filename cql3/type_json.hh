@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "bytes_ostream.hh"
 #include "types/types.hh"
 #include "utils/rjson.hh"
 
@@ -15,6 +16,11 @@ bytes from_json_object(const abstract_type &t, const rjson::value& value);
 sstring to_json_string(const abstract_type &t, bytes_view bv);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
+// Appends the same representation as to_json_string() to out. Elements of
+// collections, tuples and user types are written directly, without building
+// a string for each of them.
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv);
+
 inline sstring to_json_string(const abstract_type &t, const bytes& b) {
     return to_json_string(t, bytes_view(b));
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <cctype>
+#include <seastar/core/metrics.hh>
+
+#include "cql3/unprepared_statements_cache.hh"
+#include "cql3/cql_statement.hh"
+
+namespace cql3 {
+
+unprepared_statements_cache::unprepared_statements_cache(size_t max_entries)
+        : _max_entries(max_entries) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("query_processor", {
+        sm::make_gauge("unprepared_cache_entries", [this] { return _entries.size(); },
+                sm::description("Number of statements held in the cache of statements executed without being prepared.")),
+        sm::make_counter("unprepared_cache_hits", _stats.hits,
+                sm::description("Number of statements executed without being prepared which were found in the cache.")),
+        sm::make_counter("unprepared_cache_misses", _stats.misses,
+                sm::description("Number of statements executed without being prepared which had to be parsed.")),
+        sm::make_counter("unprepared_cache_evictions", _stats.evictions,
+                sm::description("Number of statements evicted from the cache of statements executed without being prepared because it was full.")),
+    });
+}
+
+unprepared_statements_cache::~unprepared_statements_cache() {
+    _lru.clear();
+}
+
+const statements::prepared_statement* unprepared_statements_cache::find(const prepared_cache_key_type& key) noexcept {
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+    ++_stats.hits;
+    auto& e = it->second;
+    e.lru_link.unlink();
+    _lru.push_back(e);
+    return e.statement.get();
+}
+
+const statements::prepared_statement* unprepared_statements_cache::peek(const prepared_cache_key_type& key) const noexcept {
+    auto it = _entries.find(key);
+    return it == _entries.end() ? nullptr : it->second.statement.get();
+}
+
+const statements::prepared_statement& unprepared_statements_cache::insert(const prepared_cache_key_type& key,
+        std::unique_ptr<statements::prepared_statement> statement) {
+    auto [it, inserted] = _entries.try_emplace(key);
+    auto& e = it->second;
+    if (inserted) {
+        e.key = &it->first;
+    } else {
+        e.lru_link.unlink();
+    }
+    e.statement = std::move(statement);
+    _lru.push_back(e);
+    while (_entries.size() > _max_entries) {
+        ++_stats.evictions;
+        erase(_lru.front());
+    }
+    return *e.statement;
+}
+
+void unprepared_statements_cache::erase(entry& e) noexcept {
+    e.lru_link.unlink();
+    _entries.erase(_entries.find(*e.key));
+}
+
+sstring unprepared_statements_cache::normalize(std::string_view query) {
+    sstring out(sstring::initialized_later(), query.size());
+    size_t size = 0;
+    char quote = 0;
+    bool pending_space = false;
+    for (size_t i = 0; i < query.size(); ++i) {
+        char c = query[i];
+        if (quote) {
+            // A doubled quote closes the literal and opens it again right away.
+            out[size++] = c;
+            if (c == quote) {
+                quote = 0;
+            }
+            continue;
+        }
+        char next = i + 1 < query.size() ? query[i + 1] : 0;
+        if ((c == '-' && next == '-') || (c == '/' && (next == '/' || next == '*')) || (c == '$' && next == '$')) {
+            // Whitespace is significant in comments and $$-quoted strings.
+            return sstring(query);
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = size > 0;
+            continue;
+        }
+        if (pending_space) {
+            out[size++] = ' ';
+            pending_space = false;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+        }
+        out[size++] = c;
+    }
+    out.resize(size);
+    return out;
+}
+
+void unprepared_statements_cache::remove_if(std::function<bool(::shared_ptr<cql_statement>)> pred) {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto& e = (it++)->second;
+        if (pred(e.statement->statement)) {
+            erase(e);
+        }
+    }
+}
+
+}
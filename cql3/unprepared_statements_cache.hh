@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <boost/intrusive/list.hpp>
+#include <seastar/core/metrics_registration.hh>
+
+#include "cql3/prepared_statements_cache.hh"
+#include "cql3/statements/prepared_statement.hh"
+#include "seastarx.hh"
+
+namespace cql3 {
+
+class cql_statement;
+
+/// \brief Cache of statements executed without being prepared first.
+///
+/// Clients which don't prepare their statements, and tools which run the same
+/// queries over and over, pay for parsing and preparing each query they send.
+/// The statements are cached under the key a prepared statement of the
+/// normalized query text would get: the hash of the text and of the current
+/// keyspace of the client, and the dialect. Repeated queries then skip the
+/// parser, even if they are formatted differently, see normalize().
+///
+/// The cache holds a bounded number of entries and evicts the least recently
+/// used ones. Entries are invalidated on schema changes like the prepared
+/// statements are, see query_processor::migration_subscriber.
+class unprepared_statements_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+private:
+    struct entry {
+        boost::intrusive::list_member_hook<> lru_link;
+        const prepared_cache_key_type* key = nullptr;
+        std::unique_ptr<statements::prepared_statement> statement;
+    };
+
+    using lru_type = boost::intrusive::list<entry,
+            boost::intrusive::member_hook<entry, boost::intrusive::list_member_hook<>, &entry::lru_link>,
+            boost::intrusive::constant_time_size<false>>;
+
+    size_t _max_entries;
+    std::unordered_map<prepared_cache_key_type, entry> _entries;
+    // Least recently used entries at the front.
+    lru_type _lru;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void erase(entry& e) noexcept;
+public:
+    explicit unprepared_statements_cache(size_t max_entries);
+    ~unprepared_statements_cache();
+
+    unprepared_statements_cache(const unprepared_statements_cache&) = delete;
+    unprepared_statements_cache& operator=(const unprepared_statements_cache&) = delete;
+
+    bool enabled() const noexcept {
+        return _max_entries > 0;
+    }
+
+    // Returns the cached statement, or null on a miss. The statement stays valid
+    // until the next call to insert() or remove_if().
+    const statements::prepared_statement* find(const prepared_cache_key_type& key) noexcept;
+    // Like find(), but doesn't count as a use of the statement.
+    const statements::prepared_statement* peek(const prepared_cache_key_type& key) const noexcept;
+
+    // Caches the statement, evicting the least recently used one if the cache is
+    // full. Returns the cached statement, valid like the one returned by find().
+    // Must be called only when enabled().
+    const statements::prepared_statement& insert(const prepared_cache_key_type& key,
+            std::unique_ptr<statements::prepared_statement> statement);
+
+    // Returns the text under which the query is cached: runs of whitespace
+    // outside of string literals and quoted identifiers are replaced by a single
+    // space, and leading and trailing whitespace is dropped. Queries with
+    // comments or $$-quoted strings are returned as is. The case of keywords
+    // and identifiers is kept, as some literals, e.g. ISO 8601 durations, are
+    // case sensitive.
+    static sstring normalize(std::string_view query);
+
+    // Drops the statements for which the predicate returns true.
+    void remove_if(std::function<bool(::shared_ptr<cql_statement>)> pred);
+
+    size_t size() const noexcept {
+        return _entries.size();
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+}
@@ -10,6 +10,8 @@
 
 #include <chrono>
 #include <exception>
+#include <unordered_map>
+#include <unordered_set>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/semaphore.hh>
@@ -33,6 +35,7 @@
 #include "service_permit.hh"
 #include "cql3/query_processor.hh"
 #include "replica/database.hh"
+#include "locator/abstract_replication_strategy.hh"
 
 static logging::logger blogger("batchlog_manager");
 
@@ -58,27 +61,36 @@ db::batchlog_manager::batchlog_manager(cql3::query_processor& qp, db::system_key
     });
 }
 
+// The slice of the token ring, in (start, end], whose batches are replayed by the shard.
+// The batchlog is keyed by time UUIDs, so its entries are spread evenly over the ring.
+static std::pair<int64_t, int64_t> replay_token_slice(unsigned shard, unsigned shard_count) {
+    auto width = std::numeric_limits<uint64_t>::max() / shard_count;
+    auto bound = [width] (unsigned i) {
+        return static_cast<int64_t>(static_cast<uint64_t>(std::numeric_limits<int64_t>::min()) + i * width);
+    };
+    return {bound(shard), shard + 1 == shard_count ? std::numeric_limits<int64_t>::max() : bound(shard + 1)};
+}
+
 future<> db::batchlog_manager::do_batch_log_replay(post_replay_cleanup cleanup) {
     return container().invoke_on(0, [cleanup] (auto& bm) -> future<> {
         auto gate_holder = bm._gate.hold();
         auto sem_units = co_await get_units(bm._sem, 1);
 
-        auto dest = bm._cpu++ % smp::count;
-        blogger.debug("Batchlog replay on shard {}: starts", dest);
+        blogger.debug("Batchlog replay: starts");
         auto last_replay = gc_clock::now();
-        if (dest == 0) {
-            co_await bm.replay_all_failed_batches(cleanup);
-        } else {
-            co_await bm.container().invoke_on(dest, [cleanup] (auto& bm) {
-                return with_gate(bm._gate, [&bm, cleanup] {
-                    return bm.replay_all_failed_batches(cleanup);
-                });
-            });
+        co_await bm.container().invoke_on_all([] (auto& bm) {
+            auto [start, end] = replay_token_slice(this_shard_id(), smp::count);
+            return bm.replay_all_failed_batches(start, end);
+        });
+        if (cleanup == post_replay_cleanup::yes) {
+            // Replaying batches could have generated tombstones, flush to disk,
+            // where they can be compacted away.
+            co_await replica::database::flush_table_on_all_shards(bm._qp.proxy().get_db(), system_keyspace::NAME, system_keyspace::BATCHLOG);
         }
         co_await bm.container().invoke_on_all([last_replay] (auto& bm) {
             bm._last_replay = last_replay;
         });
-        blogger.debug("Batchlog replay on shard {}: done", dest);
+        blogger.debug("Batchlog replay: done");
     });
 }
 
@@ -88,8 +100,8 @@ future<> db::batchlog_manager::batchlog_replay_loop() {
         // it in parallel on each shard. It will just overlap/interfere.  To
         // simplify syncing between batchlog_replay_loop and user initiated replay operations,
         // we use the _sem on shard zero only. Replaying batchlog can
-        // generate a lot of work, so we distrute the real work on all cpus with
-        // round-robin scheduling.
+        // generate a lot of work, so each replay is spread over all cpus,
+        // every one replaying its own slice of the token ring.
         co_return;
     }
 
@@ -158,15 +170,20 @@ db_clock::duration db::batchlog_manager::get_batch_log_timeout() const {
     return _write_request_timeout * 2;
 }
 
-future<> db::batchlog_manager::replay_all_failed_batches(post_replay_cleanup cleanup) {
+future<> db::batchlog_manager::replay_all_failed_batches(int64_t start, int64_t end) {
     typedef db_clock::rep clock_type;
 
     // rate limit is in bytes per second. Uses Double.MAX_VALUE if disabled (set to 0 in cassandra.yaml).
     // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
-    auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
-    auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
+    // All shards replay at the same time, each one throttling the batches it sends to every
+    // replica, so that no replica receives more than the rate from this node.
+    // A zero rate disables the throttling, so the share of a rate which is
+    // enabled can't round down to zero.
+    const auto owners = std::max<size_t>(_qp.proxy().get_token_metadata_ptr()->count_normal_token_owners(), 1);
+    auto throttle = _replay_rate ? std::max<uint64_t>(_replay_rate / owners / smp::count, 1) : 0;
+    auto limiters = make_lw_shared<std::unordered_map<locator::host_id, utils::rate_limiter>>();
 
-    auto batch = [this, limiter](const cql3::untyped_result_set::row& row) -> future<stop_iteration> {
+    auto batch = [this, throttle, limiters](const cql3::untyped_result_set::row& row) -> future<stop_iteration> {
         auto written_at = row.get_as<db_clock::time_point>("written_at");
         auto id = row.get_as<utils::UUID>("id");
         // enough time for the actual write + batchlog entry mutation delivery (two separate requests).
@@ -216,7 +233,7 @@ future<> db::batchlog_manager::replay_all_failed_batches(post_replay_cleanup cle
                 mutations.emplace_back(fm->to_mutation(s));
             }
             return mutations;
-        }).then([this, limiter, written_at, size, fms] (utils::chunked_vector<mutation> mutations) {
+        }).then([this, throttle, limiters, written_at, size, fms] (utils::chunked_vector<mutation> mutations) {
             if (mutations.empty()) {
                 return make_ready_future<>();
             }
@@ -242,7 +259,21 @@ future<> db::batchlog_manager::replay_all_failed_batches(post_replay_cleanup cle
             // Our normal write path does not add much redundancy to the dispatch, and rate is handled after send
             // in both cases.
             // FIXME: verify that the above is reasonably true.
-            return limiter->reserve(size).then([this, mutations = std::move(mutations)] {
+            std::unordered_set<locator::host_id> replicas;
+            for (const auto& m : mutations) {
+                auto erm = _qp.proxy().local_db().find_column_family(m.schema()).get_effective_replication_map();
+                for (auto host : erm->get_natural_replicas(m.token())) {
+                    if (replicas.insert(host).second) {
+                        limiters->try_emplace(host, throttle);
+                    }
+                }
+            }
+            auto reserved = do_with(std::move(replicas), [limiters, size] (const std::unordered_set<locator::host_id>& replicas) {
+                return parallel_for_each(replicas, [limiters, size] (locator::host_id host) {
+                    return limiters->at(host).reserve(size);
+                });
+            });
+            return reserved.then([this, mutations = std::move(mutations)] {
                 _stats.write_attempts += mutations.size();
                 // #1222 - change cl level to ALL, emulating origins behaviour of sending/hinting
                 // to all natural end points.
@@ -276,23 +307,15 @@ future<> db::batchlog_manager::replay_all_failed_batches(post_replay_cleanup cle
         }).then([] { return make_ready_future<stop_iteration>(stop_iteration::no); });
     };
 
-    co_await with_gate(_gate, [this, cleanup, batch = std::move(batch)] () mutable -> future<> {
+    co_await with_gate(_gate, [this, start, end, batch = std::move(batch)] () mutable -> future<> {
         blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
         co_await utils::get_local_injector().inject("add_delay_to_batch_replay", std::chrono::milliseconds(1000));
         co_await _qp.query_internal(
-                format("SELECT id, data, written_at, version FROM {}.{} BYPASS CACHE", system_keyspace::NAME, system_keyspace::BATCHLOG),
+                format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) > ? AND token(id) <= ? BYPASS CACHE", system_keyspace::NAME, system_keyspace::BATCHLOG),
                 db::consistency_level::ONE,
-                {},
+                {data_value(start), data_value(end)},
                 page_size,
-                std::move(batch)).then([this, cleanup] {
-            if (cleanup == post_replay_cleanup::no) {
-                return make_ready_future<>();
-            }
-            // Replaying batches could have generated tombstones, flush to disk,
-            // where they can be compacted away.
-            return replica::database::flush_table_on_all_shards(_qp.proxy().get_db(), system_keyspace::NAME, system_keyspace::BATCHLOG);
-        }).then([] {
-            blogger.debug("Finished replayAllFailedBatches");
-        });
+                std::move(batch));
+        blogger.debug("Finished replayAllFailedBatches");
     });
 }
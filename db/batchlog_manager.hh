@@ -63,13 +63,13 @@ class batchlog_manager : public peering_sharded_service<batchlog_manager> {
     unsigned _replay_cleanup_after_replays = 100;
     semaphore _sem{1};
     seastar::named_gate _gate;
-    unsigned _cpu = 0;
     seastar::abort_source _stop;
     future<> _loop_done;
 
     gc_clock::time_point _last_replay;
 
-    future<> replay_all_failed_batches(post_replay_cleanup cleanup);
+    // Replays the failed batches with token(id) in (start, end].
+    future<> replay_all_failed_batches(int64_t start, int64_t end);
 public:
     // Takes a QP, not a distributes. Because this object is supposed
     // to be per shard and does no dispatching beyond delegating the the
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <map>
+
+#include <seastar/core/sstring.hh>
+
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+#include "utils/i_filter.hh"
+
+namespace db {
+
+/**
+ * \brief Schema extension which represents the `bloom_filter` per-table option.
+ *
+ * Selects the layout of the bloom filter written for new sstables of the table:
+ *
+ *     ALTER TABLE t WITH bloom_filter = {'layout': 'split_block'};
+ *
+ * Existing sstables keep the layout they were written with, the layout of
+ * each sstable is recorded in its Scylla component.
+ */
+class bloom_filter_extension : public schema_extension {
+    utils::filter_layout _layout = utils::filter_layout::classic;
+public:
+    static constexpr auto NAME = "bloom_filter";
+    static constexpr auto LAYOUT_KEY = "layout";
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    bloom_filter_extension() = default;
+    explicit bloom_filter_extension(utils::filter_layout layout) : _layout(layout) {}
+
+    explicit bloom_filter_extension(const std::map<sstring, sstring>& map) : _layout(from_map(map)) {}
+    explicit bloom_filter_extension(const bytes& b) : _layout(from_map(deserialize(b))) {}
+    explicit bloom_filter_extension(const sstring& s) {
+        throw std::logic_error("Cannot create bloom filter info from string");
+    }
+#pragma clang diagnostic pop
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_map());
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, std::type_identity<std::map<sstring, sstring>>());
+    }
+    std::map<sstring, sstring> to_map() const {
+        return {{LAYOUT_KEY, sstring(utils::to_string(_layout))}};
+    }
+    utils::filter_layout get_layout() const {
+        return _layout;
+    }
+
+private:
+    static utils::filter_layout from_map(const std::map<sstring, sstring>& map) {
+        auto layout = utils::filter_layout::classic;
+        for (auto& [key, value] : map) {
+            if (key != LAYOUT_KEY) {
+                throw exceptions::configuration_exception(format("Unknown key in map for bloom_filter extension: {}", key));
+            }
+            try {
+                layout = utils::filter_layout_from_string(value);
+            } catch (std::invalid_argument& e) {
+                throw exceptions::configuration_exception(e.what());
+            }
+        }
+        return layout;
+    }
+};
+
+}
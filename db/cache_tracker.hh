@@ -14,13 +14,18 @@
 #include "mutation/partition_version.hh"
 #include "mutation/mutation_cleaner.hh"
 #include "utils/cached_file_stats.hh"
+#include "utils/estimated_histogram.hh"
 #include "sstables/partition_index_cache_stats.hh"
+#include "sstables/decompressed_chunk_cache_stats.hh"
+#include "sstables/promoted_index_block_cache_stats.hh"
 
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include <stdint.h>
 
 class cache_entry;
+class compressed_cache_entry;
 
 namespace cache {
 
@@ -62,6 +67,8 @@ class cache_tracker final {
         uint64_t partitions;
         uint64_t rows;
         uint64_t mispopulations;
+        uint64_t partition_admissions;
+        uint64_t partition_admission_rejections;
         uint64_t underlying_recreations;
         uint64_t underlying_partition_skips;
         uint64_t underlying_row_skips;
@@ -73,6 +80,13 @@ class cache_tracker final {
         uint64_t row_tombstone_reads;
         uint64_t rows_compacted;
         uint64_t rows_compacted_away;
+        uint64_t partition_compressions;
+        uint64_t partition_decompressions;
+        uint64_t compressed_partition_evictions;
+        uint64_t compressed_partition_removals;
+        uint64_t compressed_partitions;
+        uint64_t compressed_partition_bytes;
+        uint64_t compressed_partition_uncompressed_bytes;
 
         uint64_t active_reads() const {
             return reads - reads_done;
@@ -82,6 +96,8 @@ class cache_tracker final {
     stats _stats{};
     cached_file_stats _index_cached_file_stats{};
     partition_index_cache_stats _partition_index_cache_stats{};
+    decompressed_chunk_cache_stats _decompressed_chunk_cache_stats{};
+    promoted_index_block_cache_stats _promoted_index_block_cache_stats{};
     seastar::metrics::metric_groups _metrics;
     logalloc::region _region;
     lru _lru;
@@ -89,12 +105,15 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    utils::time_estimated_histogram _partition_decompression_latency;
 private:
     void setup_metrics();
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
-    cache_tracker(utils::updateable_value<double> index_cache_fraction, mutation_application_stats&, register_metrics);
-    cache_tracker(utils::updateable_value<double> index_cache_fraction, register_metrics);
+    cache_tracker(utils::updateable_value<double> index_cache_fraction, utils::updateable_value<double> protected_fraction,
+            mutation_application_stats&, register_metrics);
+    cache_tracker(utils::updateable_value<double> index_cache_fraction, utils::updateable_value<double> protected_fraction,
+            register_metrics);
     cache_tracker();
     ~cache_tracker();
     void clear();
@@ -119,6 +138,8 @@ class cache_tracker final {
     void on_row_miss() noexcept;
     void on_miss_already_populated() noexcept;
     void on_mispopulate() noexcept;
+    void on_partition_admission() noexcept { ++_stats.partition_admissions; }
+    void on_partition_admission_rejection() noexcept { ++_stats.partition_admission_rejections; }
     void on_row_processed_from_memtable() noexcept { ++_stats.rows_processed_from_memtable; }
     void on_row_dropped_from_memtable() noexcept { ++_stats.rows_dropped_from_memtable; }
     void on_row_merged_from_memtable() noexcept { ++_stats.rows_merged_from_memtable; }
@@ -126,6 +147,13 @@ class cache_tracker final {
     void on_row_tombstone_read() noexcept { ++_stats.row_tombstone_reads; }
     void on_row_compacted() noexcept { ++_stats.rows_compacted; }
     void on_row_compacted_away() noexcept { ++_stats.rows_compacted_away; }
+    // Called when the entry of a partition is replaced by a compressed one.
+    void on_partition_compression() noexcept;
+    void on_partition_decompression(std::chrono::steady_clock::duration latency) noexcept;
+    void insert(compressed_cache_entry&) noexcept;
+    void remove(compressed_cache_entry&) noexcept;
+    void on_compressed_partition_eviction(compressed_cache_entry&) noexcept;
+    const utils::time_estimated_histogram& partition_decompression_latency() const noexcept { return _partition_decompression_latency; }
     void pinned_dirty_memory_overload(uint64_t bytes) noexcept;
     allocation_strategy& allocator() noexcept;
     logalloc::region& region() noexcept;
@@ -137,8 +165,14 @@ class cache_tracker final {
     stats& get_stats() noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
     lru& get_lru() { return _lru; }
+    // Calls func once with each cache entry whose rows are among the max_rows
+    // most recently used ones, the most recently used first, until it returns
+    // stop_iteration::yes. Doesn't preempt, and func must not touch the cache.
+    void for_each_recently_used_partition(size_t max_rows, noncopyable_function<stop_iteration(const cache_entry&)> func);
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
+    decompressed_chunk_cache_stats& get_decompressed_chunk_cache_stats() { return _decompressed_chunk_cache_stats; }
+    promoted_index_block_cache_stats& get_promoted_index_block_cache_stats() { return _promoted_index_block_cache_stats; }
     seastar::memory::reclaiming_result evict_from_lru_shallow() noexcept;
 };
 
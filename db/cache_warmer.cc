@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/switch_to.hh>
+#include <seastar/util/file.hh>
+
+#include "bytes_ostream.hh"
+#include "db/cache_warmer.hh"
+#include "db/row_cache.hh"
+#include "db/timeout_clock.hh"
+#include "replica/database.hh"
+#include "utils/checked-file-impl.hh"
+#include "utils/disk-error-handler.hh"
+#include "utils/fragment_range.hh"
+#include "utils/log.hh"
+
+static logging::logger cwlogger("cache_warmer");
+
+namespace db {
+
+// The file of each shard starts with a header, followed by a block for each table:
+//
+//   header:     magic (u32), format version (u32)
+//   table:      table id (2 x u64), number of keys (u32), keys
+//   key:        size (u32), serialized partition key
+//
+// All integers are big-endian.
+static constexpr uint32_t file_magic = 0x53435257; // "SCRW"
+static constexpr uint32_t file_version = 1;
+// Bounds the walk of the cache LRU, which doesn't preempt, to this many rows
+// per key to save. Partitions with many recently used rows take up more of it.
+static constexpr size_t max_rows_per_saved_key = 8;
+
+namespace {
+
+template <typename T>
+void write_be(bytes_ostream& out, T v) {
+    char buf[sizeof(T)];
+    seastar::write_be<T>(buf, v);
+    out.write(buf, sizeof(T));
+}
+
+class file_parser {
+    std::string_view _data;
+public:
+    explicit file_parser(std::string_view data) : _data(data) {}
+
+    bool empty() const noexcept {
+        return _data.empty();
+    }
+
+    std::string_view read(size_t size) {
+        if (_data.size() < size) {
+            throw std::runtime_error("unexpected end of file");
+        }
+        auto ret = _data.substr(0, size);
+        _data.remove_prefix(size);
+        return ret;
+    }
+
+    template <typename T>
+    T read_be() {
+        return seastar::read_be<T>(read(sizeof(T)).data());
+    }
+};
+
+struct saved_table {
+    table_id id;
+    std::vector<bytes> keys;
+};
+
+std::vector<saved_table> parse(std::string_view data) {
+    file_parser p(data);
+    if (p.read_be<uint32_t>() != file_magic) {
+        throw std::runtime_error("bad magic");
+    }
+    if (auto v = p.read_be<uint32_t>(); v != file_version) {
+        throw std::runtime_error(fmt::format("unsupported version {}", v));
+    }
+    std::vector<saved_table> tables;
+    while (!p.empty()) {
+        auto msb = p.read_be<int64_t>();
+        auto lsb = p.read_be<int64_t>();
+        auto& t = tables.emplace_back(table_id(utils::UUID(msb, lsb)));
+        auto nr_keys = p.read_be<uint32_t>();
+        t.keys.reserve(nr_keys);
+        for (uint32_t i = 0; i < nr_keys; ++i) {
+            auto key = p.read(p.read_be<uint32_t>());
+            t.keys.emplace_back(reinterpret_cast<const int8_t*>(key.data()), key.size());
+        }
+    }
+    return tables;
+}
+
+}
+
+cache_warmer::cache_warmer(sharded<replica::database>& db, config cfg)
+    : _db(db)
+    , _cfg(std::move(cfg))
+{ }
+
+std::filesystem::path cache_warmer::shard_file() const {
+    return _cfg.directory / fmt::format("row_cache-shard-{}.keys", this_shard_id());
+}
+
+future<> cache_warmer::start() {
+    if (!enabled()) {
+        _progress.done = true;
+        co_return;
+    }
+    _warmup = with_gate(_gate, [this] { return warm_up(); });
+    if (_cfg.save_period.count() > 0) {
+        _periodic_saves = with_gate(_gate, [this] { return periodic_saves(); });
+    }
+}
+
+future<> cache_warmer::stop() {
+    _as.request_abort();
+    _save_period_cv.broken();
+    co_await _gate.close();
+    co_await std::exchange(_warmup, make_ready_future<>());
+    co_await std::exchange(_periodic_saves, make_ready_future<>());
+    if (enabled()) {
+        try {
+            co_await do_save();
+        } catch (...) {
+            cwlogger.warn("Failed to save the row cache keys on shutdown: {}", std::current_exception());
+        }
+    }
+}
+
+future<> cache_warmer::periodic_saves() {
+    while (!_as.abort_requested()) {
+        try {
+            co_await _save_period_cv.wait(_cfg.save_period);
+        } catch (const seastar::condition_variable_timed_out&) {
+            // Time to save.
+        } catch (const seastar::broken_condition_variable&) {
+            co_return;
+        }
+        try {
+            co_await do_save();
+        } catch (...) {
+            cwlogger.warn("Failed to save the row cache keys: {}", std::current_exception());
+        }
+    }
+}
+
+future<> cache_warmer::save() {
+    return container().invoke_on_all([] (cache_warmer& cw) -> future<> {
+        if (!cw.enabled()) {
+            co_return;
+        }
+        auto holder = cw._gate.hold();
+        co_await cw.do_save();
+    });
+}
+
+future<> cache_warmer::do_save() {
+    auto& db = _db.local();
+    // The keys of the tables whose cache is enabled, the most recently used first.
+    std::unordered_map<table_id, std::vector<dht::decorated_key>> table_keys;
+    db.get_tables_metadata().for_each_table([&] (table_id id, lw_shared_ptr<replica::table> t) {
+        if (t->cache_enabled()) {
+            table_keys.emplace(id, std::vector<dht::decorated_key>());
+        }
+    });
+
+    // All the tables share the cache LRU, so the hottest partitions are saved,
+    // whichever their table.
+    const size_t keys_for_shard = std::max<size_t>(1, _cfg.keys_to_save / smp::count);
+    size_t total = 0;
+    db.row_cache_tracker().for_each_recently_used_partition(keys_for_shard * max_rows_per_saved_key, [&] (const cache_entry& ce) {
+        if (auto it = table_keys.find(ce.schema()->id()); it != table_keys.end()) {
+            it->second.push_back(ce.key());
+            ++total;
+        }
+        return stop_iteration(total == keys_for_shard);
+    });
+
+    bytes_ostream out;
+    write_be<uint32_t>(out, file_magic);
+    write_be<uint32_t>(out, file_version);
+    size_t tables = 0;
+    for (auto& [table, keys] : table_keys) {
+        if (keys.empty()) {
+            continue;
+        }
+        co_await coroutine::maybe_yield();
+        ++tables;
+        auto id = table.uuid();
+        write_be<int64_t>(out, id.get_most_significant_bits());
+        write_be<int64_t>(out, id.get_least_significant_bits());
+        write_be<uint32_t>(out, keys.size());
+        for (auto& dk : keys) {
+            auto key = dk.key().representation();
+            write_be<uint32_t>(out, key.size_bytes());
+            for (bytes_view frag : fragment_range(key)) {
+                out.write(frag);
+            }
+        }
+    }
+
+    auto path = shard_file();
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    co_await io_check([this] { return recursive_touch_directory(_cfg.directory.native()); });
+    auto f = co_await open_checked_file_dma(general_disk_error_handler, tmp_path.native(), open_flags::wo | open_flags::create | open_flags::truncate);
+    auto os = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        for (bytes_view frag : out) {
+            co_await os.write(reinterpret_cast<const char*>(frag.data()), frag.size());
+        }
+        co_await os.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await os.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    co_await io_check(rename_file, tmp_path.native(), path.native());
+    co_await io_check(sync_directory, _cfg.directory.native());
+    cwlogger.debug("Saved {} row cache keys of {} tables to {}", total, tables, path.native());
+}
+
+future<> cache_warmer::warm_up() {
+    auto path = shard_file();
+    std::vector<saved_table> saved;
+    try {
+        if (!co_await file_exists(path.native())) {
+            _progress.done = true;
+            co_return;
+        }
+        auto content = co_await util::read_entire_file_contiguous(path);
+        saved = parse(std::string_view(content.data(), content.size()));
+    } catch (...) {
+        cwlogger.warn("Failed to read the saved row cache keys from {}, skipping the warm-up: {}", path.native(), std::current_exception());
+        _progress.done = true;
+        co_return;
+    }
+    for (auto& t : saved) {
+        _progress.keys_to_load += t.keys.size();
+    }
+    cwlogger.info("Warming up the row cache with {} saved keys of {} tables", _progress.keys_to_load, saved.size());
+
+    co_await coroutine::switch_to(_cfg.sched_group);
+    auto& db = _db.local();
+    for (auto& st : saved) {
+        if (_as.abort_requested()) {
+            break;
+        }
+        auto t = db.get_tables_metadata().get_table_if_exists(st.id);
+        if (!t || !t->cache_enabled()) {
+            _progress.keys_loaded += st.keys.size();
+            continue;
+        }
+        auto s = t->schema();
+        co_await max_concurrent_for_each(st.keys, _cfg.warmup_concurrency, [&] (const bytes& key) -> future<> {
+            ++_progress.keys_loaded;
+            if (_as.abort_requested()) {
+                co_return;
+            }
+            auto dk = dht::decorate_key(*s, partition_key::from_bytes(bytes_view(key)));
+            if (t->shard_for_reads(dk.token()) != this_shard_id()) {
+                co_return;
+            }
+            try {
+                auto permit = co_await db.obtain_reader_permit(*t, "cache_warmup", db::no_timeout, {});
+                auto range = dht::partition_range::make_singular(dk);
+                auto reader = t->make_mutation_reader(s, std::move(permit), range, s->full_slice());
+                std::exception_ptr ex;
+                try {
+                    co_await reader.consume_pausable([] (mutation_fragment_v2) {
+                        return stop_iteration::no;
+                    });
+                } catch (...) {
+                    ex = std::current_exception();
+                }
+                co_await reader.close();
+                if (ex) {
+                    std::rethrow_exception(std::move(ex));
+                }
+            } catch (...) {
+                cwlogger.debug("Failed to read partition {} of {}.{} into the row cache: {}", dk, s->ks_name(), s->cf_name(), std::current_exception());
+            }
+        });
+    }
+    _progress.done = true;
+    cwlogger.info("Row cache warm-up done, {} keys loaded", _progress.keys_loaded);
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sharded.hh>
+
+#include "replica/database_fwd.hh"
+#include "seastarx.hh"
+
+namespace db {
+
+/// \brief Saves the keys of partitions held in the row cache, and reads them
+/// back into the cache after a restart.
+///
+/// Each shard saves up to its share of the configured number of keys, taken
+/// from the row caches of all tables, to its own file in the saved caches
+/// directory. This happens periodically, if a save period is configured, and
+/// on shutdown.
+///
+/// On startup, each shard reads the keys back from its file and reads their
+/// partitions in the background, through the regular cache-populating read
+/// path, in the given (low priority) scheduling group and with bounded
+/// concurrency. Besides the row cache, this also warms up the partition index
+/// cache and the cached index file pages of the sstables holding them, which
+/// are looked up on the way. Keys which this shard no longer owns, or of
+/// tables which no longer exist, are skipped.
+class cache_warmer : public peering_sharded_service<cache_warmer> {
+public:
+    struct config {
+        std::filesystem::path directory;
+        // Number of keys to save across all shards. 0 disables saving and warm-up.
+        uint32_t keys_to_save = 0;
+        // 0 disables periodic saves, the cache is then saved on shutdown only.
+        std::chrono::seconds save_period{0};
+        seastar::scheduling_group sched_group;
+        // Number of partitions which each shard reads concurrently during warm-up.
+        unsigned warmup_concurrency = 4;
+    };
+
+    struct warmup_progress {
+        uint64_t keys_to_load = 0;
+        uint64_t keys_loaded = 0;
+        bool done = false;
+    };
+private:
+    sharded<replica::database>& _db;
+    config _cfg;
+    warmup_progress _progress;
+    seastar::gate _gate;
+    seastar::abort_source _as;
+    seastar::condition_variable _save_period_cv;
+    future<> _periodic_saves = make_ready_future<>();
+    future<> _warmup = make_ready_future<>();
+private:
+    std::filesystem::path shard_file() const;
+    future<> periodic_saves();
+    future<> warm_up();
+    future<> do_save();
+public:
+    cache_warmer(sharded<replica::database>& db, config cfg);
+
+    // Starts warming up the cache in the background, and the periodic saves.
+    future<> start();
+    // Saves the cache contents, unless disabled, and stops the background work.
+    future<> stop();
+
+    // Saves the cache contents of all shards. Invoke on any shard.
+    future<> save();
+
+    const config& get_config() const noexcept {
+        return _cfg;
+    }
+
+    bool enabled() const noexcept {
+        return _cfg.keys_to_save > 0;
+    }
+
+    // Progress of the warm-up of this shard.
+    const warmup_progress& get_warmup_progress() const noexcept {
+        return _progress;
+    }
+};
+
+}
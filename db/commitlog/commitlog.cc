@@ -34,6 +34,8 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/condition-variable.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/switch_to.hh>
@@ -106,7 +108,10 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.group_commit_window = std::chrono::microseconds(cfg.commitlog_group_commit_window_in_us());
+    c.group_commit_max_bytes = cfg.commitlog_group_commit_max_bytes();
     c.allow_going_over_size_limit = false;
+    c.compression = commitlog_entry_compression_from_string(cfg.commitlog_compression());
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
         c.commitlog_flush_threshold_in_mb = cfg.commitlog_flush_threshold_in_mb();
@@ -245,6 +250,8 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     // we distribute stuff more or less equally across shards.
     const uint64_t max_disk_size; // per-shard
     const uint64_t disk_usage_threshold;
+    // Shared by all the entries written with add_entry()/add_entries().
+    const commitlog_entry_compressor entry_compressor;
 
     bool _shutdown = false;
     std::optional<shared_promise<>> _shutdown_promise = {};
@@ -389,6 +396,8 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        uint64_t group_commit_flushes = 0;
+        uint64_t group_commit_writes = 0;
     };
 
     class scope_increment_counter {
@@ -479,6 +488,7 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     std::vector<sstring> get_active_names() const;
     uint64_t get_num_dirty_segments() const;
     uint64_t get_num_active_segments() const;
+    std::vector<commitlog::pinned_segments> get_pinned_segments() const;
 
     using buffer_type = fragmented_temporary_buffer;
 
@@ -502,6 +512,12 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     void flush_segments(uint64_t size_to_remove);
     void check_no_data_older_than_allowed();
 
+    // Holds background work of the segments, so that shutdown() waits for it.
+    // Throws once shutdown() closed the gate.
+    gate::holder hold_gate() {
+        return _gate.hold();
+    }
+
 private:
     class shutdown_marker{};
 
@@ -762,6 +778,12 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     time_point _sync_time;
     utils::flush_queue<replay_position, std::less<replay_position>, clock_type> _pending_ops;
 
+    using group_commit_promise = shared_promise<with_clock<db::timeout_clock>>;
+    // Batch mode writes waiting for the currently collected group commit, see batch_cycle().
+    lw_shared_ptr<group_commit_promise> _group_commit;
+    // Signalled when the buffer reaches group_commit_max_bytes.
+    condition_variable _group_commit_cv;
+
     uint64_t _num_allocs = 0;
 
     std::unordered_set<table_schema_version> _known_schema_versions;
@@ -1250,6 +1272,21 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
                     // force flush here
                     co_await do_flush(fp);
                 }
+            } else if (_segment_manager->cfg.mode == sync_mode::BATCH && _segment_manager->cfg.group_commit_window.count() > 0) {
+                // Group commit: the first write starts collecting writes, which arrive
+                // within the window (or until the buffer fills up to group_commit_max_bytes)
+                // and all of them are acknowledged after one shared sync. The sync is
+                // done in the background so that it doesn't depend on the timeout of
+                // any particular write.
+                auto group = _group_commit;
+                if (!group) {
+                    auto gh = _segment_manager->hold_gate();
+                    group = _group_commit = make_lw_shared<group_commit_promise>();
+                    // Waited for by segment_manager::shutdown(), through the gate.
+                    (void)group_commit(group).finally([gh = std::move(gh)] {});
+                }
+                ++_segment_manager->totals.group_commit_writes;
+                co_await group->get_shared_future(timeout);
             } else {
                 // It is ok to leave the sync behind on timeout because there will be at most one
                 // such sync, all later allocations will block on _pending_ops until it is done.
@@ -1266,6 +1303,26 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         co_return me;
     }
 
+    future<> group_commit(lw_shared_ptr<group_commit_promise> group) noexcept {
+        auto me = shared_from_this();
+        try {
+            co_await _group_commit_cv.wait(_segment_manager->cfg.group_commit_window, [this] {
+                return buffer_position() >= _segment_manager->cfg.group_commit_max_bytes;
+            });
+        } catch (...) {
+            // Window elapsed.
+        }
+        // Writes arriving from now on are not covered by the sync below, they form the next group.
+        _group_commit = nullptr;
+        ++_segment_manager->totals.group_commit_flushes;
+        try {
+            co_await sync();
+            group->set_value();
+        } catch (...) {
+            group->set_exception(std::current_exception());
+        }
+    }
+
     void background_cycle() {
         //FIXME: discarded future
         (void)cycle().discard_result().handle_exception([] (auto ex) {
@@ -1401,6 +1458,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         ++_num_allocs;
 
         if (_segment_manager->cfg.mode == sync_mode::BATCH || writer.sync) {
+            if (_group_commit && npos >= _segment_manager->cfg.group_commit_max_bytes) {
+                _group_commit_cv.signal();
+            }
             return write_result::ok_need_batch_sync;
         } else {
             // If this buffer alone is too big, potentially bigger than the maximum allowed size,
@@ -1910,6 +1970,7 @@ db::commitlog::segment_manager::segment_manager(config c)
             return max_disk_size / 2;
         }
     }())
+    , entry_compressor(cfg.compression)
     , _flush_semaphore(cfg.max_active_flushes)
     // That is enough concurrency to allow for our largest mutation (max_mutation_size), plus
     // an existing in-flight buffer. Since we'll force the cycling() of any buffer that is bigger
@@ -2090,6 +2151,13 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_counter("flush", totals.flush_count,
                        sm::description("Counts number of times the flush() method was called for a file."))(basic_level),
 
+        sm::make_counter("group_commit_flushes", totals.group_commit_flushes,
+                       sm::description("Counts number of syncs shared by a group of writes in batch mode with commitlog_group_commit_window_in_us set.")),
+
+        sm::make_counter("group_commit_writes", totals.group_commit_writes,
+                       sm::description("Counts number of writes acknowledged by group commit syncs. "
+                                       "Divide this value by \"group_commit_flushes\" to get the average number of writes per sync.")),
+
         sm::make_counter("bytes_written", totals.bytes_written,
                        sm::description("Counts number of bytes written to the disk. "
                                        "Divide this value by \"alloc\" to get the average number of bytes per mutation written to the disk.")),
@@ -3004,6 +3072,24 @@ uint64_t db::commitlog::segment_manager::get_num_active_segments() const {
     });
 }
 
+std::vector<db::commitlog::pinned_segments> db::commitlog::segment_manager::get_pinned_segments() const {
+    std::unordered_map<cf_id_type, commitlog::pinned_segments> pinned;
+    for (auto& s : _segments) {
+        if (s->is_still_allocating()) {
+            continue;
+        }
+        for (auto& id : s->_cf_dirty | std::views::keys) {
+            auto& p = pinned[id];
+            p.id = id;
+            ++p.segments;
+            p.exclusive_segments += s->_cf_dirty.size() == 1;
+            p.bytes += s->size_on_disk();
+            p.oldest_data = std::min(p.oldest_data, s->min_time(id));
+        }
+    }
+    return pinned | std::views::values | std::ranges::to<std::vector>();
+}
+
 temporary_buffer<char> db::commitlog::segment_manager::allocate_single_buffer(size_t s, size_t alignment) {
     return temporary_buffer<char>::aligned(alignment, s);
 }
@@ -3064,9 +3150,11 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
         commitlog_entry_writer _writer;
     public:
         rp_handle res;
-        cl_entry_writer(const commitlog_entry_writer& wr) 
-            : entry_writer(wr.sync()), _writer(wr) 
-        {}
+        cl_entry_writer(const commitlog_entry_writer& wr, const commitlog_entry_compressor& compressor)
+            : entry_writer(wr.sync()), _writer(wr)
+        {
+            _writer.set_compressor(&compressor);
+        }
         const cf_id_type& id(size_t) const override {
             return _writer.schema()->id();
         }
@@ -3096,7 +3184,7 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
             return std::move(res);
         }
     };
-    return _segment_manager->allocate_when_possible(cl_entry_writer(cew), timeout);
+    return _segment_manager->allocate_when_possible(cl_entry_writer(cew, _segment_manager->entry_compressor), timeout);
 }
 
 future<utils::chunked_vector<db::rp_handle>>
@@ -3108,10 +3196,13 @@ db::commitlog::add_entries(utils::chunked_vector<commitlog_entry_writer> entry_w
     public:
         utils::chunked_vector<rp_handle> res;
 
-        cl_entries_writer(force_sync sync, utils::chunked_vector<commitlog_entry_writer> entry_writers)
+        cl_entries_writer(force_sync sync, utils::chunked_vector<commitlog_entry_writer> entry_writers, const commitlog_entry_compressor& compressor)
             : entry_writer(sync, entry_writers.size()), _writers(std::move(entry_writers))
         {
             res.reserve(_writers.size());
+            for (auto& w : _writers) {
+                w.set_compressor(&compressor);
+            }
         }
         const cf_id_type& id(size_t i) const override {
             return _writers.at(i).schema()->id();
@@ -3164,7 +3255,7 @@ db::commitlog::add_entries(utils::chunked_vector<commitlog_entry_writer> entry_w
     };
 
     force_sync sync(std::any_of(entry_writers.begin(), entry_writers.end(), [](auto& w) { return bool(w.sync()); }));
-    return _segment_manager->allocate_when_possible(cl_entries_writer(sync, std::move(entry_writers)), timeout);
+    return _segment_manager->allocate_when_possible(cl_entries_writer(sync, std::move(entry_writers), _segment_manager->entry_compressor), timeout);
 }
 
 db::commitlog::commitlog(config cfg)
@@ -3865,6 +3956,10 @@ uint64_t db::commitlog::get_flush_count() const {
     return _segment_manager->totals.flush_count;
 }
 
+uint64_t db::commitlog::get_bytes_written() const {
+    return _segment_manager->totals.bytes_written;
+}
+
 uint64_t db::commitlog::get_pending_tasks() const {
     return _segment_manager->totals.pending_flushes;
 }
@@ -3897,6 +3992,10 @@ uint64_t db::commitlog::get_num_active_segments() const {
     return _segment_manager->get_num_active_segments();
 }
 
+std::vector<db::commitlog::pinned_segments> db::commitlog::get_pinned_segments() const {
+    return _segment_manager->get_pinned_segments();
+}
+
 uint64_t db::commitlog::get_num_blocked_on_new_segment() const {
     return _segment_manager->totals.blocked_on_new_segment;
 }
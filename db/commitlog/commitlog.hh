@@ -107,9 +107,15 @@ class commitlog {
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        // Batch mode only. When non-zero, writes arriving within this window
+        // share one sync, unless the buffer reaches group_commit_max_bytes first.
+        std::chrono::microseconds group_commit_window{0};
+        uint64_t group_commit_max_bytes = 1024 * 1024;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = false;
         bool allow_fragmented_entries = false;
+        // Compression of the entries added with add_entry()/add_entries().
+        commitlog_entry_compression compression = commitlog_entry_compression::none;
 
         // The base segment ID to use.
         // The segment IDs of newly allocated segments will be issued sequentially
@@ -307,6 +313,7 @@ class commitlog {
     uint64_t get_buffer_size() const;
     uint64_t get_completed_tasks() const;
     uint64_t get_flush_count() const;
+    uint64_t get_bytes_written() const;
     uint64_t get_pending_tasks() const;
     uint64_t get_pending_flushes() const;
     uint64_t get_pending_allocations() const;
@@ -327,6 +334,24 @@ class commitlog {
      */
     uint64_t get_num_active_segments() const;
 
+    struct pinned_segments {
+        cf_id_type id;
+        // Inactive segments lingering due to unflushed data of the table
+        uint64_t segments = 0;
+        // Of those, the ones without unflushed data of other tables, which
+        // flushing the table alone would release
+        uint64_t exclusive_segments = 0;
+        uint64_t bytes = 0;
+        // When the oldest unflushed data of the table was added
+        gc_clock::time_point oldest_data = gc_clock::time_point::max();
+    };
+    /**
+     * Returns, for every table with unflushed data in inactive segments,
+     * the segments it keeps on disk. For telling which tables pin the
+     * commitlog, causing flushes when it fills up.
+     */
+    std::vector<pinned_segments> get_pinned_segments() const;
+
     /**
      * Returns the largest amount of data that can be written in a single "mutation".
      */
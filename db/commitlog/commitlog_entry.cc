@@ -10,8 +10,11 @@
 #include "commitlog_entry.hh"
 #include "idl/commitlog.dist.hh"
 #include "idl/commitlog.dist.impl.hh"
+#include "sstables/compressor.hh"
+#include "utils/fragment_range.hh"
 
 #include <seastar/core/simple-stream.hh>
+#include <seastar/core/byteorder.hh>
 
 template<typename Output>
 void commitlog_entry_writer::serialize(Output& out) const {
@@ -24,18 +27,129 @@ void commitlog_entry_writer::serialize(Output& out) const {
     }().write_mutation(_mutation).end_commitlog_entry();
 }
 
+commitlog_entry_compression commitlog_entry_compression_from_string(std::string_view name) {
+    if (name == "none" || name.empty()) {
+        return commitlog_entry_compression::none;
+    } else if (name == "lz4") {
+        return commitlog_entry_compression::lz4;
+    } else if (name == "zstd") {
+        return commitlog_entry_compression::zstd;
+    }
+    throw std::invalid_argument(fmt::format("Unknown commitlog compression: {}", name));
+}
+
+static compressor_ptr make_entry_compressor(commitlog_entry_compression type) {
+    switch (type) {
+    case commitlog_entry_compression::none:
+        return nullptr;
+    case commitlog_entry_compression::lz4:
+        return make_compressor_without_dicts(compression_parameters(compressor::algorithm::lz4));
+    case commitlog_entry_compression::zstd:
+        return make_compressor_without_dicts(compression_parameters({
+            {compression_parameters::SSTABLE_COMPRESSION, "ZstdCompressor"},
+            {compression_parameters::CHUNK_LENGTH_KB, std::to_string(commitlog_entry_compressor::max_entry_size / 1024)},
+        }));
+    }
+    throw std::runtime_error(fmt::format("Unknown commitlog entry compression type {}", static_cast<unsigned>(type)));
+}
+
+commitlog_entry_compressor::commitlog_entry_compressor(commitlog_entry_compression type)
+    : _type(type)
+    , _compressor(make_entry_compressor(type))
+{}
+
+commitlog_entry_compressor::~commitlog_entry_compressor() = default;
+
+std::optional<bytes> commitlog_entry_compressor::compress(bytes_view entry) const {
+    if (!_compressor || entry.size() < min_entry_size || entry.size() > max_entry_size) {
+        return std::nullopt;
+    }
+    bytes out(bytes::initialized_later(), header_size + _compressor->compress_max_size(entry.size()));
+    auto p = reinterpret_cast<char*>(out.data());
+    auto len = _compressor->compress(reinterpret_cast<const char*>(entry.data()), entry.size(), p + header_size, out.size() - header_size);
+    if (header_size + len >= entry.size()) {
+        return std::nullopt;
+    }
+    write_le<uint32_t>(p, 0);
+    p[sizeof(uint32_t)] = static_cast<char>(_type);
+    write_le<uint32_t>(p + sizeof(uint32_t) + sizeof(uint8_t), entry.size());
+    out.resize(header_size + len);
+    return out;
+}
+
 void commitlog_entry_writer::compute_size() {
     seastar::measuring_output_stream ms;
     serialize(ms);
     _size = ms.size();
+    _compressed = {};
+    if (_compressor && _size >= commitlog_entry_compressor::min_entry_size && _size <= commitlog_entry_compressor::max_entry_size) {
+        bytes raw(bytes::initialized_later(), _size);
+        seastar::simple_output_stream out(reinterpret_cast<char*>(raw.data()), raw.size());
+        serialize(out);
+        if (auto compressed = _compressor->compress(raw)) {
+            _compressed = std::move(*compressed);
+            _size = _compressed.size();
+        }
+    }
 }
 
 void commitlog_entry_writer::write(ostream& out) const {
+    if (!_compressed.empty()) {
+        out.write(reinterpret_cast<const char*>(_compressed.data()), _compressed.size());
+        return;
+    }
     serialize(out);
 }
 
+// Decompression doesn't need any per-writer state, so one decompressor
+// per shard and algorithm serves all readers.
+static const compressor& entry_decompressor(commitlog_entry_compression type) {
+    static thread_local compressor_ptr lz4 = make_entry_compressor(commitlog_entry_compression::lz4);
+    static thread_local compressor_ptr zstd = make_entry_compressor(commitlog_entry_compression::zstd);
+    switch (type) {
+    case commitlog_entry_compression::lz4:
+        return *lz4;
+    case commitlog_entry_compression::zstd:
+        return *zstd;
+    case commitlog_entry_compression::none:
+        break;
+    }
+    throw std::runtime_error(fmt::format("Unknown commitlog entry compression type {}", static_cast<unsigned>(type)));
+}
+
+static commitlog_entry read_compressed_entry(const fragmented_temporary_buffer& buffer) {
+    if (buffer.size_bytes() < commitlog_entry_compressor::header_size) {
+        throw std::runtime_error(fmt::format("Compressed commitlog entry truncated: {} bytes", buffer.size_bytes()));
+    }
+    auto raw = with_linearized(fragmented_temporary_buffer::view(buffer), [] (bytes_view input) {
+        auto p = reinterpret_cast<const char*>(input.data());
+        auto type = static_cast<commitlog_entry_compression>(p[sizeof(uint32_t)]);
+        auto uncompressed_size = read_le<uint32_t>(p + sizeof(uint32_t) + sizeof(uint8_t));
+        bytes raw(bytes::initialized_later(), uncompressed_size);
+        auto len = entry_decompressor(type).uncompress(p + commitlog_entry_compressor::header_size, input.size() - commitlog_entry_compressor::header_size,
+                reinterpret_cast<char*>(raw.data()), raw.size());
+        if (len != uncompressed_size) {
+            throw std::runtime_error(fmt::format("Compressed commitlog entry decompressed to {} bytes, expected {}", len, uncompressed_size));
+        }
+        return raw;
+    });
+    seastar::simple_input_stream in(reinterpret_cast<const char*>(raw.data()), raw.size());
+    return ser::deserialize(in, std::type_identity<commitlog_entry>());
+}
+
+static bool is_compressed_entry(const fragmented_temporary_buffer& buffer) {
+    if (buffer.size_bytes() < sizeof(uint32_t)) {
+        return false;
+    }
+    auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
+    return ser::deserialize(in, std::type_identity<uint32_t>()) == 0;
+}
+
 commitlog_entry_reader::commitlog_entry_reader(const fragmented_temporary_buffer& buffer)
     : _ce([&] {
+    if (is_compressed_entry(buffer)) {
+        return read_compressed_entry(buffer);
+    }
     auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
     return ser::deserialize(in, std::type_identity<commitlog_entry>());
 }())
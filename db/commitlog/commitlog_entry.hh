@@ -15,6 +15,9 @@
 #include "mutation/frozen_mutation.hh"
 #include "schema/schema_fwd.hh"
 #include "replay_position.hh"
+#include "bytes.hh"
+
+class compressor;
 
 namespace detail {
 
@@ -83,6 +86,46 @@ class commitlog_entry {
     frozen_mutation&& mutation() && { return std::move(_mutation); }
 };
 
+// Compression of commitlog (and hint) entries.
+//
+// Each entry is compressed on its own, so that replay doesn't depend on
+// anything outside of the entry. A compressed entry has the layout:
+//
+//   u32 0, u8 commitlog_entry_compression, u32 uncompressed size, compressed data
+//
+// all little-endian. A serialized commitlog_entry starts with its non-zero
+// IDL frame size, so the two are told apart by the first word.
+//
+// The values are stored on disk, don't reorder.
+enum class commitlog_entry_compression : uint8_t {
+    none = 0,
+    lz4 = 1,
+    zstd = 2,
+};
+
+commitlog_entry_compression commitlog_entry_compression_from_string(std::string_view);
+
+class commitlog_entry_compressor {
+    commitlog_entry_compression _type;
+    std::unique_ptr<compressor> _compressor;
+public:
+    static constexpr size_t header_size = 2 * sizeof(uint32_t) + sizeof(uint8_t);
+    // Smaller entries don't compress well enough to be worth it.
+    static constexpr size_t min_entry_size = 256;
+    // Bounds the memory needed by the compression context.
+    static constexpr size_t max_entry_size = 128 * 1024;
+
+    explicit commitlog_entry_compressor(commitlog_entry_compression);
+    ~commitlog_entry_compressor();
+
+    commitlog_entry_compression type() const {
+        return _type;
+    }
+    // Returns the entry in the compressed layout, or std::nullopt if
+    // the entry should be written uncompressed.
+    std::optional<bytes> compress(bytes_view entry) const;
+};
+
 class commitlog_entry_writer {
 public:
     using force_sync = db::commitlog_force_sync;
@@ -92,6 +135,9 @@ class commitlog_entry_writer {
     bool _with_schema = true;
     size_t _size = std::numeric_limits<size_t>::max();
     force_sync _sync;
+    const commitlog_entry_compressor* _compressor = nullptr;
+    // The compressed form of the entry, empty if it is written uncompressed.
+    bytes _compressed;
 private:
     template<typename Output>
     void serialize(Output&) const;
@@ -101,6 +147,12 @@ class commitlog_entry_writer {
         : _schema(std::move(s)), _mutation(fm), _sync(sync)
     {}
 
+    void set_compressor(const commitlog_entry_compressor* c) {
+        if (std::exchange(_compressor, c) != c) {
+            _size = std::numeric_limits<size_t>::max();
+        }
+    }
+
     void set_with_schema(bool value) {
         if (std::exchange(_with_schema, value) != value || _size == std::numeric_limits<size_t>::max()) {
             compute_size();
@@ -16,6 +16,11 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/loop.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -42,6 +47,40 @@ class db::commitlog_replayer::impl {
     // not modify content), but...
     mutable seastar::sharded<column_mappings> _column_mappings;
 
+    // Entries are applied in the background while the reader decodes the
+    // following ones. This bounds the memory of entries read but not yet applied.
+    static constexpr size_t max_inflight_bytes = 16 * 1024 * 1024;
+    // Number of segments replayed concurrently on a shard, so that reading
+    // of the next segment overlaps with applying the tail of the previous one.
+    static constexpr size_t segment_concurrency = 2;
+
+    struct shard_state {
+        seastar::semaphore inflight_memory{max_inflight_bytes};
+        uint64_t segments_to_replay = 0;
+        uint64_t segments_replayed = 0;
+        uint64_t bytes_to_replay = 0;
+        uint64_t bytes_replayed = 0;
+        seastar::metrics::metric_groups metrics;
+
+        shard_state() {
+            namespace sm = seastar::metrics;
+            metrics.add_group("commitlog_replay", {
+                sm::make_gauge("segments_to_replay", segments_to_replay,
+                        sm::description("Number of commitlog segments to replay on this shard.")),
+                sm::make_counter("segments_replayed", segments_replayed,
+                        sm::description("Number of commitlog segments replayed on this shard so far.")),
+                sm::make_gauge("bytes_to_replay", bytes_to_replay,
+                        sm::description("Total size of the commitlog segments to replay on this shard.")),
+                sm::make_counter("bytes_replayed", bytes_replayed,
+                        sm::description("Number of bytes of commitlog entries read for replay on this shard so far.")),
+                sm::make_gauge("inflight_bytes", [this] { return max_inflight_bytes - inflight_memory.available_units(); },
+                        sm::description("Size of commitlog entries read but not yet applied.")),
+            });
+        }
+        future<> stop() { return make_ready_future<>(); }
+    };
+    mutable seastar::sharded<shard_state> _shard_states;
+
     friend class db::commitlog_replayer;
 public:
     impl(seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks);
@@ -54,12 +93,14 @@ class db::commitlog_replayer::impl {
         uint64_t applied_mutations = 0;
         uint64_t corrupt_bytes = 0;
         uint64_t truncated_at = 0;
+        uint64_t replayed_bytes = 0;
 
         stats& operator+=(const stats& s) {
             invalid_mutations += s.invalid_mutations;
             skipped_mutations += s.skipped_mutations;
             applied_mutations += s.applied_mutations;
             corrupt_bytes += s.corrupt_bytes;
+            replayed_bytes += s.replayed_bytes;
             return *this;
         }
         stats operator+(const stats& s) const {
@@ -72,13 +113,17 @@ class db::commitlog_replayer::impl {
     // move start/stop of the thread local bookkeep to "top level"
     // and also make sure to SCYLLA_ASSERT on it actually being started.
     future<> start() {
-        return _column_mappings.start();
+        co_await _column_mappings.start();
+        co_await _shard_states.start();
     }
     future<> stop() {
-        return _column_mappings.stop();
+        co_await _shard_states.stop();
+        co_await _column_mappings.stop();
     }
 
     future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // Waits for memory for the entry and starts processing it in the background, under the gate.
+    future<> process_async(stats*, seastar::gate&, commitlog::buffer_and_replay_position buf_rp) const;
     future<stats> recover(const commitlog::descriptor&, const commitlog::replay_state&) const;
 
     typedef std::unordered_map<table_id, replay_position> rp_map;
@@ -182,9 +227,10 @@ db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const comm
 
     auto s = make_lw_shared<stats>();
     auto& exts = _db.local().extensions();
+    auto pending = make_lw_shared<seastar::gate>();
 
     return db::commitlog::read_log_file(rpstate, f, d.filename_prefix,
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
+            std::bind(&impl::process_async, this, s.get(), std::ref(*pending), std::placeholders::_1),
             p, &exts).then_wrapped([s](future<> f) {
         try {
             f.get();
@@ -193,12 +239,31 @@ db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const comm
         } catch (commitlog::segment_truncation& e) {
             s->truncated_at = e.position();
         } catch (...) {
-            throw;
+            return make_exception_future<>(std::current_exception());
         }
+        return make_ready_future<>();
+    }).finally([pending] {
+        // Entries already read are applied even if reading failed midway.
+        return pending->close();
+    }).then([this, s] {
+        ++_shard_states.local().segments_replayed;
         return make_ready_future<stats>(*s);
     });
 }
 
+future<> db::commitlog_replayer::impl::process_async(stats* s, seastar::gate& pending, commitlog::buffer_and_replay_position buf_rp) const {
+    auto& state = _shard_states.local();
+    auto size = buf_rp.buffer.size_bytes();
+    auto units = co_await get_units(state.inflight_memory, std::min(size, max_inflight_bytes));
+    state.bytes_replayed += size;
+    s->replayed_bytes += size;
+    // Mutations are commutative, so the order in which entries are applied doesn't matter
+    // and the reader can move on to decoding the next entries.
+    (void)seastar::with_gate(pending, [this, s, buf_rp = std::move(buf_rp), units = std::move(units)] () mutable {
+        return process(s, std::move(buf_rp)).finally([units = std::move(units)] {});
+    });
+}
+
 future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
@@ -352,15 +417,26 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
     co_await _impl->start();
     std::exception_ptr e;
     try {
+        auto start_time = std::chrono::steady_clock::now();
         auto totals = co_await map_reduce(smp::all_cpus(), [&](unsigned id) -> future<impl::stats> {
             co_return co_await smp::submit_to(id, [&] () -> future<impl::stats> {
                 impl::stats total;
                 std::unordered_map<unsigned, commitlog::replay_state> states;
-                // TODO: or something. For now, we do this serialized per shard,
-                // to reduce mutation congestion. We could probably (says avi)
-                // do 2 segments in parallel or something, but lets use this first.
-                auto range = map.equal_range(id);
-                for (auto& [id, d] : std::ranges::subrange(range.first, range.second)) {
+                auto shard_files = map.equal_range(id);
+                auto range = std::ranges::subrange(shard_files.first, shard_files.second);
+                auto& shard_state = _impl->_shard_states.local();
+                for (auto& [id, d] : range) {
+                    ++shard_state.segments_to_replay;
+                    try {
+                        shard_state.bytes_to_replay += co_await file_size(d.filename());
+                    } catch (...) {
+                        // Reported when the segment is replayed.
+                    }
+                }
+                // Segments of the same origin shard share the replay state, through which
+                // entries fragmented across segments are reassembled in any order.
+                co_await max_concurrent_for_each(range, impl::segment_concurrency, [&] (auto& id_and_desc) -> future<> {
+                    auto& d = id_and_desc.second;
                     auto f = d.filename();
                     rlogger.debug("Replaying {}", f);
                     auto stats = co_await _impl->recover(d, states[replay_position(d).shard_id()]);
@@ -377,15 +453,20 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
                                     , stats.skipped_mutations
                     );
                     total += stats;
-                }
+                });
                 co_return total;
             });
         }, impl::stats(), std::plus<impl::stats>());
-            
-        rlogger.info("Log replay complete, {} replayed mutations ({} invalid, {} skipped)"
+
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        auto mb = double(totals.replayed_bytes) / (1024 * 1024);
+        rlogger.info("Log replay complete, {} replayed mutations ({} invalid, {} skipped), {:.1f} MB in {:.3f}s ({:.1f} MB/s)"
                         , totals.applied_mutations
                         , totals.invalid_mutations
                         , totals.skipped_mutations
+                        , mb
+                        , elapsed
+                        , elapsed > 0 ? mb / elapsed : 0.0
         );
 
     } catch (...) {
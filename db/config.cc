@@ -29,6 +29,7 @@
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/bloom_filter_extension.hh"
 #include "db/tags/extension.hh"
 #include "config.hh"
 #include "extensions.hh"
@@ -521,12 +522,6 @@ struct convert<utils::UUID> {
 
 }
 
-#if defined(DEBUG)
-#define ENABLE_SSTABLE_KEY_VALIDATION true
-#else
-#define ENABLE_SSTABLE_KEY_VALIDATION false
-#endif
-
 #if defined(DEBUG) || defined(DEVEL)
 #define DEVELOPER_MODE_DEFAULT true
 #else
@@ -589,12 +584,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
+    , compaction_read_latency_target_ms(this, "compaction_read_latency_target_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller cuts the compaction shares while the 99th percentile of the latency of local reads exceeds this many milliseconds, "
+        "and restores them as the latency recovers. Compaction shares are not cut once the compaction backlog reaches its maximum, so the backlog can't grow unbounded. "
+        "Set to 0 (default) to control compaction shares by the backlog alone.")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold.")
     , compaction_flush_all_tables_before_major_seconds(this, "compaction_flush_all_tables_before_major_seconds", value_status::Used, 86400,
         "Set the minimum interval in seconds between flushing all tables before each major compaction (default is 86400)."
         "This option is useful for maximizing tombstone garbage collection by releasing all active commitlog segments."
         "Set to 0 to disable automatic flushing all tables before major compaction.")
+    , compaction_major_parallel_subranges(this, "compaction_major_parallel_subranges", liveness::LiveUpdate, value_status::Used, 1,
+        "Split the token range of a major compaction into this many sub-ranges, compacted in parallel by separate readers and writers. "
+        "This overlaps the CPU and I/O work of a single large major compaction, at the cost of more memory for buffers. "
+        "Ignored for compactions which replace their input incrementally. Set to 1 (default) to compact the whole range at once.")
+    , compaction_offstrategy_round_size_in_mb(this, "compaction_offstrategy_round_size_in_mb", liveness::LiveUpdate, value_status::Used, 10240,
+        "Limit the input of each round of off-strategy compaction to about this many megabytes. Each round integrates its output into the main sstable set "
+        "as soon as it completes, and off-strategy compactions of different tables take turns between rounds, the table whose reads touch the most sstables first. "
+        "Leveled reshape jobs over overlapping input are compacted in a single round. Set to 0 to reshape all the input of a reshape job in a single round.")
     /**
     * @Group Initialization properties
     * @GroupDescription The minimal properties needed for configuring a cluster.
@@ -621,6 +628,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where the commit log is stored. For optimal write performance, it is recommended the commit log be on a separate disk partition (ideally, a separate physical device) from the data file directories.")
     , schema_commitlog_directory(this, "schema_commitlog_directory", value_status::Used, "",
         "The directory where the schema commit log is stored. This is a special commitlog instance used for schema and system tables. For optimal write performance, it is recommended the commit log be on a separate disk partition (ideally, a separate physical device) from the data file directories.")
+    , raft_log_directory(this, "raft_log_directory", value_status::Used, "",
+        "The directory where the raft log segments are stored, when raft_segment_log_storage is enabled.")
     , data_file_directories(this, "data_file_directories", "datadir", value_status::Used, { },
         "The directory location where table data (SSTables) is stored.")
     , data_file_capacity(this, "data_file_capacity", liveness::LiveUpdate, value_status::Used, 0,
@@ -630,8 +639,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where hints files are stored if hinted handoff is enabled.")
     , view_hints_directory(this, "view_hints_directory", value_status::Used, "",
         "The directory where materialized-view updates are stored while a view replica is unreachable.")
-    , saved_caches_directory(this, "saved_caches_directory", value_status::Unused, "",
-        "The directory location where table key and row caches are stored.")
+    , saved_caches_directory(this, "saved_caches_directory", value_status::Used, "",
+        "The directory location where the keys of the row cache are saved. See row_cache_keys_to_save.")
     /**
     * @Group Commonly used properties
     * @GroupDescription Properties most frequently used when configuring Scylla.
@@ -771,6 +780,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in ``batch`` mode.")
+    , commitlog_group_commit_window_in_us(this, "commitlog_group_commit_window_in_us", value_status::Used, 0,
+        "In ``batch`` mode, the time in microseconds for which a write waits for other writes to share a sync with (group commit). Writes are still acknowledged only after the shared sync, so durability is the same as in ``batch`` mode. Set to 0 to disable group commit.")
+    , commitlog_group_commit_max_bytes(this, "commitlog_group_commit_max_bytes", value_status::Used, 1024 * 1024,
+        "In ``batch`` mode with ``commitlog_group_commit_window_in_us`` set, the amount of buffered data after which a group commit sync starts without waiting for the window to elapse.")
     , commitlog_max_data_lifetime_in_seconds(this, "commitlog_max_data_lifetime_in_seconds", liveness::LiveUpdate, value_status::Used, 24*60*60,
         "Controls how long data remains in commit log before the system tries to evict it to sstable, regardless of usage pressure. (0 disables)")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
@@ -788,6 +801,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas disabling this can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, "none",
+        "Compression of commitlog entries: none, lz4 or zstd. Each entry is compressed separately, entries which do not shrink are written uncompressed. Replay reads both forms, but compressed segments cannot be replayed by versions which do not support this option.", {"none", "lz4", "zstd"})
+    , commitlog_domains(this, "commitlog_domains", value_status::Used, 1,
+        "Number of separate commitlogs (domains) per shard for the tables which do not use the schema commitlog, up to 16. Tables start in the first domain and move to the following ones as their share of the writes of the shard drops, so that tables which are rarely flushed only keep the segments of their domain on disk, and filling a domain flushes only its tables. The commitlog_total_space_in_mb is split evenly between the domains, whose segments are kept in subdirectories of commitlog_directory. Segments of all domains are replayed on startup, also after the number of domains was decreased.")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -818,8 +835,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , memtable_flush_queue_size(this, "memtable_flush_queue_size", value_status::Unused, 4,
         "The number of full memtables to allow pending flush (memtables waiting for a write thread). At a minimum, set to the maximum number of indexes created on a single table.\n"
         "Related information: Flushing data from the memtable")
-    , memtable_flush_writers(this, "memtable_flush_writers", value_status::Invalid, 1,
-        "Sets the number of memtable flush writer threads. These threads are blocked by disk I/O, and each one holds a memtable in memory while blocked. If you have a large Java heap size and many data directories, you can increase the value for better flush performance.")
+    , memtable_flush_writers(this, "memtable_flush_writers", value_status::Used, 1,
+        "The number of memtables which can be written to sstables at the same time on each shard. Concurrent flushes of different tables (or compaction groups) share the memtable flush scheduling group, so raising this lets flushes keep a fast disk busy, without raising their share of I/O and CPU. Each flush holds its memtable in memory until it completes.")
     , memtable_heap_space_in_mb(this, "memtable_heap_space_in_mb", value_status::Unused, 0,
         "Total permitted memory to use for memtables. Triggers a flush based on memtable_cleanup_threshold. Cassandra stops accepting writes when the limit is exceeded until a flush completes. If unset, sets to default.")
     , memtable_offheap_space_in_mb(this, "memtable_offheap_space_in_mb", value_status::Unused, 0,
@@ -848,9 +865,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Throttles all streaming file transfer between the data centers. This setting allows throttles streaming throughput betweens data centers in addition to throttling all network stream traffic as configured with stream_throughput_outbound_megabits_per_sec.")
     , stream_io_throughput_mb_per_sec(this, "stream_io_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
         "Throttles streaming I/O to the specified total throughput (in MiBs/s) across the entire system. Streaming I/O includes the one performed by repair and both RBNO and legacy topology operations such as adding or removing a node. Setting the value to 0 disables stream throttling. It is recommended to set the value for this parameter to be 75% of network bandwidth")
+    , maintenance_shares(this, "maintenance_shares", liveness::LiveUpdate, value_status::Used, 200,
+        "The CPU and I/O shares of the maintenance scheduling group, which runs the internal background work: streaming, repair, "
+        "view building and hints replay. The user workload runs with 1000 shares. Throttle the I/O of the same work with stream_io_throughput_mb_per_sec.")
+    , maintenance_latency_slo_ms(this, "maintenance_latency_slo_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "The target 99th percentile of the read and write latency of the user workload, as seen by the coordinator, in milliseconds. "
+        "When set, a shard whose latency is above the target halves the shares of its maintenance scheduling group every second, "
+        "and gives them back gradually, up to maintenance_shares, once the latency is within the target again. "
+        "Setting the value to 0 disables the adjustment.")
     , stream_plan_ranges_fraction(this, "stream_plan_ranges_fraction", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of ranges to stream in a single stream plan. Value is between 0 and 1.")
+    , stream_rpc_streams_per_shard(this, "stream_rpc_streams_per_shard", liveness::LiveUpdate, value_status::Used, 4,
+        "The number of RPC streams each shard uses in parallel to send the mutation fragments of a table to a peer. The ranges of the table are split between the streams. "
+        "A single stream is often not enough to saturate a fast network, more streams create more sstables on the receiver, to be compacted by off-strategy compaction.")
     , enable_file_stream(this, "enable_file_stream", liveness::LiveUpdate, value_status::Used, true, "Set true to use file based stream for tablet instead of mutation based stream")
+    , load_and_stream_concurrency(this, "load_and_stream_concurrency", liveness::LiveUpdate, value_status::Used, 4,
+        "The maximum number of batches of sstables streamed concurrently by each shard during load-and-stream (nodetool refresh --load-and-stream and restore). "
+        "Memory used by the readers of the batches is bounded by the streaming reader concurrency semaphore. "
+        "When enable_file_stream is set, sstables of tablet tables which fall entirely within a single tablet are streamed as whole files instead.")
     , trickle_fsync(this, "trickle_fsync", value_status::Unused, false,
         "When doing sequential writing, enabling this option tells fsync to force the operating system to flush the dirty buffers at a set interval trickle_fsync_interval_in_kb. Enable this parameter to avoid sudden dirty buffer flushing from impacting read latencies. Recommended to use on SSDs, but not on HDDs.")
     , trickle_fsync_interval_in_kb(this, "trickle_fsync_interval_in_kb", value_status::Unused, 10240,
@@ -908,12 +940,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , key_cache_size_in_mb(this, "key_cache_size_in_mb", value_status::Unused, 100,
         "A global cache setting for tables. It is the maximum size of the key cache in memory. To disable set to 0.\n"
         "Related information: nodetool setcachecapacity.")
-    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Unused, 0,
-        "Number of keys from the row cache to save.")
+    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Used, 0,
+        "Number of keys from the row cache to save to saved_caches_directory, across all shards. The saved partitions are read back into the cache in the background on startup. To disable set to 0.")
     , row_cache_size_in_mb(this, "row_cache_size_in_mb", value_status::Unused, 0,
         "Maximum size of the row cache in memory. Row cache can save more time than key_cache_size_in_mb, but is space-intensive because it contains the entire row. Use the row cache only for hot rows or static rows. If you reduce the size, you may not get you hottest keys loaded on start up.")
-    , row_cache_save_period(this, "row_cache_save_period", value_status::Unused, 0,
-        "Duration in seconds that rows are saved in cache. Caches are saved to saved_caches_directory.")
+    , row_cache_save_period(this, "row_cache_save_period", value_status::Used, 0,
+        "Interval in seconds between saves of the row cache keys to saved_caches_directory. When set to 0, the keys are saved on shutdown only.")
+    , cache_cold_partition_compression_period_in_s(this, "cache_cold_partition_compression_period_in_s", value_status::Used, 0,
+        "Interval in seconds between sweeps of the row cache which compress the partitions not read since the previous sweep. Compressed partitions take less memory, and are decompressed back into the cache on the next single-partition read. To disable set to 0.")
     , memory_allocator(this, "memory_allocator", value_status::Invalid, "NativeAllocator",
         "The off-heap memory allocator. In addition to caches, this property affects storage engine meta data. Supported values:\n"
         "* NativeAllocator\n"
@@ -925,8 +959,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     * @GroupDescription Counter cache helps to reduce counter locks' contention for hot counter cells. In case of RF = 1 a counter cache hit will cause Cassandra to skip the read before write entirely. With RF > 1 a counter cache hit will still help to reduce the duration of the lock hold, helping with hot counter cell updates, but will not allow skipping the read entirely. Only the local (clock, count) tuple of a counter cell is kept in memory, not the whole counter, so it's relatively cheap.
       Note: Reducing the size counter cache may result in not getting the hottest keys loaded on start-up.
     */
-    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", value_status::Unused, 0,
-        "When no value is specified a minimum of 2.5% of Heap or 50MB. If you perform counter deletes and rely on low gc_grace_seconds, you should disable the counter cache. To disable, set to 0")
+    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", liveness::LiveUpdate, value_status::Used, 0,
+        "Size of the cache of the local shards of counter cells, which spares the read before write of counter updates, split between shards. When no value is specified a minimum of 2.5% of Heap or 50MB. If you perform counter deletes and rely on low gc_grace_seconds, you should disable the counter cache. To disable, set to 0")
     , counter_cache_save_period(this, "counter_cache_save_period", value_status::Unused, 7200,
         "Duration after which Cassandra should save the counter cache (keys only). Caches are saved to saved_caches_directory.")
     , counter_cache_keys_to_save(this, "counter_cache_keys_to_save", value_status::Unused, 0,
@@ -946,6 +980,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , query_page_size_in_bytes(this, "query_page_size_in_bytes", liveness::LiveUpdate, value_status::Used, 1 << 20,
         "The size of pages in bytes, after a page accumulates this much data, the page is cut and sent to the client."
         " Setting a too large value increases the risk of OOM.")
+    , adaptive_paging_latency_budget_in_ms(this, "adaptive_paging_latency_budget_in_ms", liveness::LiveUpdate, value_status::Used, 100,
+        "The time a range scan of a client using adaptive paging (see the SCYLLA_ADAPTIVE_PAGING protocol extension) can spend on a page."
+        " Once it is exceeded, the page is cut after the ranges already being read, if it is not empty. Set to 0 to disable.")
     , group0_tombstone_gc_refresh_interval_in_ms(this, "group0_tombstone_gc_refresh_interval_in_ms", value_status::Used,
               std::chrono::duration_cast<std::chrono::milliseconds>(60min).count(),
               "The interval in milliseconds at which we update the time point for safe tombstone expiration in group0 tables.")
@@ -960,6 +997,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The time that the coordinator waits for counter writes to complete.")
     , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 1000,
         "The time that the coordinator continues to retry a CAS (compare and set) operation that contends with other proposals for the same row.")
+    , paxos_state_cache_size_in_mb(this, "paxos_state_cache_size_in_mb", liveness::LiveUpdate, value_status::Used, 64,
+        "Size of the in-memory cache of the Paxos state of the keys a node is a replica of, shared by all shards. "
+        "It spares LWTs the reads of the paxos tables on the replicas. 0 disables the cache.")
     , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
         "The time that the coordinator waits for truncates (remove all data from a table) to complete. The long default value allows for a snapshot to be taken before removing the data. If auto_snapshot is disabled (not recommended), you can reduce this time.")
     , write_request_timeout_in_ms(this, "write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
@@ -974,6 +1014,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Timeout for CQL server requests on shutdown. After this timeout the server will shutdown all connections.")
     , group0_raft_op_timeout_in_ms(this, "group0_raft_op_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
             "The time in milliseconds that group0 allows a Raft operation to complete.")
+    , raft_segment_log_storage(this, "raft_segment_log_storage", value_status::Used, false,
+            "Store the raft log of group 0 in append-only segment files in raft_log_directory, instead of the system.raft table. "
+            "The log entries are moved from system.raft to the segments, or back when disabled, on startup.")
+    , raft_message_coalescing_window_in_us(this, "raft_message_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 200,
+            "How long, in microseconds, a message of a raft group may be held to send it together with the messages of other raft groups "
+            "to the same node in a single message. 0 disables the coalescing. Requires all nodes to support the RAFT_MESSAGE_BATCH feature.")
     /**
     * @Group Inter-node settings
     */
@@ -1013,6 +1059,28 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If this happens, this option can be used to make the stalls less severe.")
     , internode_compression_checksumming(this, "internode_compression_checksumming", liveness::LiveUpdate, value_status::Used, true,
         "Computes and checks checksums for compressed RPC frames. This is a paranoid precaution against corruption bugs in the compression protocol.")
+    , internode_compression_adaptive(this, "internode_compression_adaptive", liveness::LiveUpdate, value_status::Used, false,
+        "Advanced. Chooses the RPC compression algorithm of each message at runtime, from those allowed by internode_compression_algorithms and the ZSTD limits, "
+        "based on the compression ratio and CPU cost observed on connections of the same class (connection index and locality). "
+        "Requires internode_compression_enable_advanced.")
+    , internode_compression_adaptive_raw_max_message_size(this, "internode_compression_adaptive_raw_max_message_size", liveness::LiveUpdate, value_status::Used, 64,
+        "In adaptive RPC compression mode, messages up to this size are sent uncompressed.")
+    , internode_compression_adaptive_local_byte_cost_ns(this, "internode_compression_adaptive_local_byte_cost_ns", liveness::LiveUpdate, value_status::Used, 1,
+        "In adaptive RPC compression mode, the cost of sending one byte to a node in the same DC, expressed in nanoseconds of CPU time. "
+        "Higher values favor stronger compression.")
+    , internode_compression_adaptive_remote_byte_cost_ns(this, "internode_compression_adaptive_remote_byte_cost_ns", liveness::LiveUpdate, value_status::Used, 20,
+        "In adaptive RPC compression mode, the cost of sending one byte to a node in a different DC, expressed in nanoseconds of CPU time. "
+        "Higher values favor stronger compression.")
+    , write_coalescing_window_in_us(this, "write_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "How long, in microseconds, a coordinator may hold a mutation destined to a replica to send it together with other mutations "
+        "to the same replica in a single message. 0 disables write coalescing. Mutations which have to be forwarded to other "
+        "replicas by the receiving node are never coalesced. Requires all nodes to support the COALESCED_MUTATION_WRITES feature.")
+    , write_coalescing_max_bytes(this, "write_coalescing_max_bytes", liveness::LiveUpdate, value_status::Used, 64 * 1024,
+        "A coalesced write message is sent as soon as the mutations queued for it reach this size, without waiting for write_coalescing_window_in_us to pass.")
+    , hints_replay_coalescing_window_in_us(this, "hints_replay_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 500,
+        "How long, in microseconds, a node replaying hints may hold a hint to send it together with other hints to the same "
+        "destination in a single message. 0 disables hint coalescing. The message size is bounded by write_coalescing_max_bytes. "
+        "Requires all nodes to support the COALESCED_HINT_REPLAY feature.")
     , internode_compression_algorithms(this, "internode_compression_algorithms", liveness::LiveUpdate, value_status::Used,
             { utils::compression_algorithm::type::ZSTD, utils::compression_algorithm::type::LZ4, },
         "Specifies RPC compression algorithms supported by this node. ")
@@ -1081,6 +1149,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Enable or disable keepalive on client connections (CQL native and the maintenance socket).")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be chosen based on cache hit ratio.")
+    , replica_latency_read_balancing(this, "replica_latency_read_balancing", liveness::LiveUpdate, value_status::Used, false,
+        "Use the read latency of each replica, as observed by the coordinator, when executing reads. A replica whose median latency "
+        "is several times higher than that of the replica kept for speculative retry is replaced by the latter, and a PERCENTILE "
+        "speculative retry is triggered by the latency percentile of the contacted replicas if it is lower than the table's one. "
+        "The estimates are listed in system.replica_latencies.")
+    , read_replica_phi_suspicion_threshold(this, "read_replica_phi_suspicion_threshold", liveness::LiveUpdate, value_status::Used, 0,
+        "Replace the replicas which are suspected to be dead by other live replicas of the same datacenter when executing reads. "
+        "Each shard, as a coordinator, runs a phi accrual failure detector of the replicas, fed by the responses to its regular reads and writes: "
+        "a replica is suspected once phi, derived from how long the replica has not been responding compared to how long it usually takes, exceeds "
+        "this threshold. With the default tolerances, a threshold of 8 suspects a replica which usually responds within milliseconds after about "
+        "300ms without responses. Setting the value to 0 disables the replacement.")
+    , per_partition_rate_limit_coordinated(this, "per_partition_rate_limit_coordinated", liveness::LiveUpdate, value_status::Used, false,
+        "Make the per_partition_rate_limit of the tables apply to the whole cluster rather than to each replica. The coordinator asks "
+        "the replicas which receive an operation to also account it on behalf of the replicas which don't, e.g. the other "
+        "replicas of a CL=ONE read, or the ones in the other DCs for a LOCAL_QUORUM read, so that all the replicas reject with the "
+        "same rate, and a coordinator which is a replica rejects the operations of over-limit partitions before sending them.")
     /**
     * @Group Advanced fault detection settings
     * @GroupDescription Settings to handle poorly performing or failing nodes.
@@ -1097,6 +1181,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Related information: About hinted handoff writes")
     , max_hinted_handoff_concurrency(this, "max_hinted_handoff_concurrency", liveness::LiveUpdate, value_status::Used, 0,
         "Maximum concurrency allowed for sending hints. The concurrency is divided across shards and rounded up if not divisible by the number of shards. By default (or when set to 0), concurrency of 8*shard_count will be used.")
+    , hints_replay_throughput_mb_per_s(this, "hints_replay_throughput_mb_per_s", liveness::LiveUpdate, value_status::Used, 0,
+        "Maximum rate, in megabytes per second, at which this node replays hints to a single destination node. The rate is divided "
+        "across shards and is reduced when the destination reports a growing view update backlog. 0 disables the limit.")
+    , hints_compression(this, "hints_compression", value_status::Used, "none",
+        "Compression of hints stored on disk: none, lz4 or zstd. See commitlog_compression.", {"none", "lz4", "zstd"})
     , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
         "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
@@ -1109,6 +1198,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Total maximum throttle. Throttling is reduced proportionally to the number of nodes in the cluster.")
     , batchlog_replay_cleanup_after_replays(this, "batchlog_replay_cleanup_after_replays", liveness::LiveUpdate, value_status::Used, 60,
         "Clean up batchlog memtable after every N replays. Replays are issued on a timer, every 60 seconds. So if batchlog_replay_cleanup_after_replays is set to 60, the batchlog memtable is flushed every 60 * 60 seconds.")
+    , batchlog_local_durable_writes(this, "batchlog_local_durable_writes", liveness::LiveUpdate, value_status::Used, false,
+        "Record the batchlog entry of a logged batch only on the coordinator, in its commitlog synced to disk, instead of writing it to two other nodes of the local datacenter. "
+        "This makes logged batches cheaper, but a batch which failed half way is not replayed if its coordinator is lost for good.")
     /**
     * @Group Request scheduler properties
     * @GroupDescription Settings to handle incoming client requests according to a defined policy. If you need to use these properties, your nodes are overloaded and dropping requests. It is recommended that you add more nodes and not try to prioritize requests.
@@ -1211,6 +1303,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The SSL port for encrypted communication. Unused unless enabled in encryption_options.")
     , enable_in_memory_data_store(this, "enable_in_memory_data_store", value_status::Used, false, "Enable in memory mode (system tables are always persisted).")
     , enable_cache(this, "enable_cache", value_status::Used, true, "Enable cache.")
+    , enable_lazy_latest_row_reads(this, "enable_lazy_latest_row_reads", liveness::LiveUpdate, value_status::Used, true,
+        "Read the sstables of a partition one by one, in the order of their clustering ranges, for reversed single partition reads of a single row (e.g. ORDER BY ck DESC LIMIT 1), so that the sstables with older rows are not read once the row is found.")
     , enable_commitlog(this, "enable_commitlog", value_status::Used, true, "Enable commitlog.")
     , volatile_system_keyspace_for_testing(this, "volatile_system_keyspace_for_testing", value_status::Used, false, "Don't persist system keyspace - testing only!")
     , api_port(this, "api_port", value_status::Used, 10000, "Http Rest API port.")
@@ -1234,6 +1328,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             " This can reduce the amount of data repair has to process.")
     , repair_partition_count_estimation_ratio(this, "repair_partition_count_estimation_ratio", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of partitions written by repair out of the total partitions. The value is currently only used for bloom filter estimation. Value is between 0 and 1.")
+    , repair_hash_tree_min_rows(this, "repair_hash_tree_min_rows", liveness::LiveUpdate, value_status::Used, 256,
+        "When the rows a repair master and a follower hold for a sync boundary differ, and the master holds at least this many of them, "
+        "the master first compares hash trees over the row hashes with the follower, and then fetches only the row hashes of the mismatched parts of the tree "
+        "instead of all of them. This saves network traffic when the replicas are mostly in sync. Set to 0 to disable. Requires the REPAIR_HASH_TREE cluster feature.")
     , repair_hints_batchlog_flush_cache_time_in_ms(this, "repair_hints_batchlog_flush_cache_time_in_ms", liveness::LiveUpdate, value_status::Used, 60 * 1000, "The repair hints and batchlog flush request cache time. Setting 0 disables the flush cache. The cache reduces the number of hints and batchlog flushes during repair when tombstone_gc is set to repair mode. When the cache is on, a slightly smaller repair time will be used with the benefits of dropped hints and batchlog flushes.")
     , repair_multishard_reader_buffer_hint_size(this, "repair_multishard_reader_buffer_hint_size", liveness::LiveUpdate, value_status::Used, 1 * 1024 * 1024,
         "The buffer size to use for the buffer-hint feature of the multishard reader when running repair in mixed-shard clusters. This can help the performance of mixed-shard repair (including RBNO). Set to 0 to disable the hint feature altogether.")
@@ -1249,8 +1347,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , developer_mode(this, "developer_mode", value_status::Used, DEVELOPER_MODE_DEFAULT, "Relax environment checks. Setting to true can reduce performance and reliability significantly.")
     , skip_wait_for_gossip_to_settle(this, "skip_wait_for_gossip_to_settle", value_status::Used, -1, "An integer to configure the wait for gossip to settle. -1: wait normally, 0: do not wait at all, n: wait for at most n polls. Same as -Dcassandra.skip_wait_for_gossip_to_settle in cassandra.")
     , force_gossip_generation(this, "force_gossip_generation", liveness::LiveUpdate, value_status::Used, -1 , "Force gossip to use the generation number provided by user.")
+    , gossip_message_size_metrics(this, "gossip_message_size_metrics", liveness::LiveUpdate, value_status::Used, false,
+        "Count the serialized sizes of the gossip messages sent and received in the gossip message_bytes_sent and message_bytes_received metrics. "
+        "Computing the sizes costs a walk over each message, so it's off by default.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step.")
+    , lsa_hugepage_arenas(this, "lsa_hugepage_arenas", value_status::Used, false, "Allocate LSA segments in 2 MB arenas, so that the memory of the row cache and memtables doesn't share hugepages with other objects, which reduces TLB misses. "
+        "An arena is returned to the general purpose allocator only once all of its segments are free.")
+    , lsa_reclaim_time_slice_us(this, "lsa_reclaim_time_slice_us", value_status::Used, 0, "Maximum duration, in microseconds, of a single round of background LSA memory reclaim. "
+        "Shorter rounds free memory in smaller increments and delay other tasks less. 0 means a round runs until other tasks need the CPU.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable.")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set.")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
@@ -1261,14 +1366,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default)"
         "bytes written to data file. Value must be between 0 and 1.")
     , components_memory_reclaim_threshold(this, "components_memory_reclaim_threshold", liveness::LiveUpdate, value_status::Used, .2, "Ratio of available memory for all in-memory components of SSTables in a shard beyond which the memory will be reclaimed from components until it falls back under the threshold. Currently, this limit is only enforced for bloom filters.")
+    , defer_sstable_filter_loading_on_startup(this, "defer_sstable_filter_loading_on_startup", value_status::Used, false,
+        "Don't read the bloom filters of sstables of user tables when the node starts, but load them in the background once it's up, "
+        "within the components_memory_reclaim_threshold limit. Shortens the startup of nodes with many sstables, at the cost of "
+        "reads checking sstables whose filters are not loaded yet.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, (size_t(128) << 10) + 1, "Warn about memory allocations above this size; set to zero to disable.")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting.")
     , enable_node_aggregated_table_metrics(this, "enable_node_aggregated_table_metrics", value_status::Used, true, "Enable aggregated per node, per keyspace and per table metrics reporting, applicable if enable_keyspace_column_family_metrics is false.")
+    , table_metrics_top_k(this, "table_metrics_top_k", value_status::Used, 0,
+        "When non-zero, the per node aggregated read and write latency histograms (see enable_node_aggregated_table_metrics) are reported only for the tables with the most reads and writes, up to this many. "
+        "The tables are picked again every minute. Reduces the number of exported metrics on nodes with many tables.")
     , enable_sstable_data_integrity_check(this, "enable_sstable_data_integrity_check", value_status::Used, false, "Enable interposer which checks for integrity of every sstable write."
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
-    , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
-        " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, true, "Enable validation of partition and clustering keys monotonicity"
+        " of every sstable write. The clustering keys are mostly validated by a cheap fingerprint of their first component, so the performance is only affected slightly.")
+    , sstable_write_bti_partition_index(this, "sstable_write_bti_partition_index", liveness::LiveUpdate, value_status::Used, false,
+        "Write a trie-based partition index (PartitionTrie.db) alongside Index.db for new sstables. "
+        "It is used by single-partition reads to reject absent keys without reading Index.db pages.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Unused, true, "Enable cpu scheduling.")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
@@ -1310,6 +1425,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_clustering_key_restrictions_per_query(this, "max_clustering_key_restrictions_per_query", liveness::LiveUpdate, value_status::Used, 100,
             "Maximum number of distinct clustering key restrictions per query. This limit places a bound on the size of IN tuples, "
             "especially when multiple clustering key columns have IN restrictions. Increasing this value can result in server instability.")
+    , unprepared_statements_cache_entries(this, "unprepared_statements_cache_entries", value_status::Used, 1000,
+            "Maximum number of statements executed without being prepared, kept parsed and prepared by each shard for the next executions of the same query text. "
+            "Set to 0 to parse every such statement.")
     , max_memory_for_unlimited_query_soft_limit(this, "max_memory_for_unlimited_query_soft_limit", liveness::LiveUpdate, value_status::Used, uint64_t(1) << 20,
             "Maximum amount of memory a query, whose memory consumption is not naturally limited, is allowed to consume, e.g. non-paged and reverse queries. "
             "This is the soft limit, there will be a warning logged for queries violating this limit.")
@@ -1322,6 +1440,17 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Start killing reads after their collective memory consumption goes above $normal_limit * $multiplier.")
     , reader_concurrency_semaphore_cpu_concurrency(this, "reader_concurrency_semaphore_cpu_concurrency", liveness::LiveUpdate, value_status::Used, 2,
             "Admit new reads while there are less than this number of requests that need CPU.")
+    , reader_concurrency_semaphore_adaptive_concurrency(this, "reader_concurrency_semaphore_adaptive_concurrency", liveness::LiveUpdate, value_status::Used, false,
+            "Adjust the concurrency limit of user reads to the observed service time of reads and disk load. "
+            "The static concurrency limit remains an upper bound.")
+    , slow_read_log_threshold_in_ms(this, "slow_read_log_threshold_in_ms", liveness::LiveUpdate, value_status::Used, 500,
+            "User reads which take longer than this on a replica are recorded, with the time they spent queued in the reader concurrency semaphore "
+            "and reading from disk, and the number of sstables and bytes they read, in the system.slow_reads table. "
+            "Each shard keeps the latest 100 such reads. Set to 0 to disable.")
+    , hot_partitions_threshold(this, "hot_partitions_threshold", liveness::LiveUpdate, value_status::Used, 1000,
+            "Partitions which receive about this many single partition reads, or writes, on a shard within 10 to 20 seconds are tracked as hot "
+            "and listed in the system.hot_partitions table, with their decayed operation counts. Each shard tracks up to 64 hot partitions for reads and for writes. "
+            "Set to 0 to disable.")
     , view_update_reader_concurrency_semaphore_serialize_limit_multiplier(this, "view_update_reader_concurrency_semaphore_serialize_limit_multiplier", liveness::LiveUpdate, value_status::Used, 2,
             "Start serializing view update reads after their collective memory consumption goes above $normal_limit * $multiplier.")
     , view_update_reader_concurrency_semaphore_kill_limit_multiplier(this, "view_update_reader_concurrency_semaphore_kill_limit_multiplier", liveness::LiveUpdate, value_status::Used, 4,
@@ -1344,8 +1473,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , user_defined_function_contiguous_allocation_limit_bytes(this, "user_defined_function_contiguous_allocation_limit_bytes", value_status::Used, 1024*1024, "How much memory each UDF invocation can allocate in one chunk.")
     , schema_registry_grace_period(this, "schema_registry_grace_period", value_status::Used, 1,
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
+    , tracing_backend(this, "tracing_backend", value_status::Used, "system_traces",
+        "Where the tracing records are stored:\n"
+        "* system_traces  Written to the tables of the system_traces keyspace.\n"
+        "* ring_buffer    Kept in a bounded in-memory buffer on each shard, readable through the system.tracing_ring_buffer table. "
+        "The oldest records are overwritten, see tracing_ring_buffer_records. Cheap enough to keep probabilistic tracing enabled."
+        , {"system_traces", "ring_buffer"})
+    , tracing_ring_buffer_records(this, "tracing_ring_buffer_records", value_status::Used, 10000,
+        "Number of tracing records kept by each shard when tracing_backend is ring_buffer.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard", liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , cql_requests_offload_threshold(this, "cql_requests_offload_threshold", liveness::LiveUpdate, value_status::Used, 0,
+        "Number of concurrent CQL requests on a shard above which it processes new EXECUTE requests of its connections on less loaded shards. 0 disables the offloading.")
+    , cql_requests_prioritized_shedding_threshold(this, "cql_requests_prioritized_shedding_threshold", liveness::LiveUpdate, value_status::Used, 0,
+        "Number of concurrent CQL requests on a shard above which it sheds new requests with an OVERLOADED error, starting with the most expensive "
+        "ones (range scans, indexed queries and large batches before single partition reads and writes) of the service levels with the fewest shares. "
+        "A request is shed once there are more than threshold * (1 + shares / 1000 / cost) requests in flight, so the cheapest requests of the "
+        "service levels with 1000 shares are shed only at twice the threshold. The error message hints when to retry, based on the queueing delay "
+        "of the service level. 0 disables the prioritized shedding.")
     , uninitialized_connections_semaphore_cpu_concurrency(this, "uninitialized_connections_semaphore_cpu_concurrency", liveness::LiveUpdate, value_status::Used, 8,
         "Maximum number of new concurrent connections from drivers that a single shard can be processing before it starts throttling incoming connections. This limit applies only to new connections excluding the ones blocked on network IO; connections that are ready to serve requests are not affected. By default the limit is 8.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
@@ -1377,6 +1522,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , alternator_enforce_authorization(this, "alternator_enforce_authorization", value_status::Used, false, "Enforce checking the authorization header for every request in Alternator.")
     , alternator_write_isolation(this, "alternator_write_isolation", value_status::Used, "", "Default write isolation policy for Alternator.")
     , alternator_streams_time_window_s(this, "alternator_streams_time_window_s", value_status::Used, 10, "CDC query confidence window for alternator streams.")
+    , alternator_streams_get_records_max_wait_ms(this, "alternator_streams_get_records_max_wait_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If a GetRecords request finds no records in a shard which is still open, wait up to this many milliseconds for new records "
+        "before returning an empty result, instead of returning right away. This saves clients from polling idle shards in a tight loop. "
+        "Should be well below alternator_timeout_in_ms. 0 (the default) disables waiting, as in DynamoDB.")
     , alternator_timeout_in_ms(this, "alternator_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "The server-side timeout for completing Alternator API requests.")
     , alternator_ttl_period_in_seconds(this, "alternator_ttl_period_in_seconds", value_status::Used,
@@ -1396,6 +1545,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         false,
         "Allow writing to system tables using the .scylla.alternator.system prefix")
     , vector_store_uri(this, "vector_store_uri", liveness::LiveUpdate, value_status::Used, "", "The URI of the vector store to use for vector search. If not set, vector search is disabled.")
+    , vector_search_local_fallback(this, "vector_search_local_fallback", liveness::LiveUpdate, value_status::Used, false,
+        "When vector_store_uri is not set, answer ANN queries on vector indexes with an exact nearest neighbor search done by the coordinator."
+        " Such a query reads the indexed column of the whole table, so it is only practical for small tables.")
     , abort_on_ebadf(this, "abort_on_ebadf", value_status::Used, true, "Abort the server on incorrect file descriptor access. Throws exception when disabled.")
     , sanitizer_report_backtrace(this, "sanitizer_report_backtrace", value_status::Used, false,
             "In debug mode, report log-structured allocator sanitizer violations with a backtrace. Slow.")
@@ -1417,6 +1569,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , index_read_ahead_pages(this, "index_read_ahead_pages", liveness::LiveUpdate, value_status::Used, 8,
+        "The maximum number of SSTable index pages read ahead of a sequential scan. Read-ahead starts once a scan crossed a few index pages in a row, and doubles with every further page, so that point reads are not affected. It never goes past the end of the scanned range. Set to 0 to disable.")
+    , cache_decompressed_chunks(this, "cache_decompressed_chunks", liveness::LiveUpdate, value_status::Used, true,
+        "Keep the chunks of compressed SSTables decompressed by point reads in the global cache, so that reads of hot chunks which miss the row cache don't have to decompress them again. The chunks are evicted together with the row cache entries.")
+    , cache_protected_fraction(this, "cache_protected_fraction", liveness::LiveUpdate, value_status::Used, 0.5,
+        "The maximum fraction of cache entries kept in the protected segment of the cache LRU. Entries touched more than once are protected and are evicted only after the entries touched once, so that one-off scans (e.g. by repair, streaming or view building) don't evict frequently read data. Clamped to the [0.0; 1.0] range. The value 0 disables the segmentation, making the cache a plain LRU.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Used, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.  Note: gossip topology changes are incompatible with tablets.")
     , recovery_leader(this, "recovery_leader", liveness::LiveUpdate, value_status::Used, utils::null_uuid(), "Host ID of the node restarted first while performing the Manual Raft-based Recovery Procedure. Warning: this option disables some guardrails for the needs of the Manual Raft-based Recovery Procedure. Make sure you unset it at the end of the procedure.")
@@ -1447,6 +1605,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
          "Allows target tablet size to be configured. Defaults to 5G (in bytes). Maintaining tablets at reasonable sizes is important to be able to " \
          "redistribute load. A higher value means tablet migration throughput can be reduced. A lower value may cause number of tablets to increase significantly, " \
          "potentially resulting in performance drawbacks.")
+    , tablet_heat_imbalance_threshold(this, "tablet_heat_imbalance_threshold", liveness::LiveUpdate, value_status::Used, 0.5,
+         "The load balancer swaps tablets between shards of a node when the request rate of the hottest shard exceeds the average "
+         "shard request rate of the node by more than this fraction. Set to 0 to disable heat-based balancing.")
+    , tablet_split_requests_per_second_threshold(this, "tablet_split_requests_per_second_threshold", liveness::LiveUpdate, value_status::Used, 25000,
+         "Tablets of a table are split when a single tablet replica serves more reads and writes per second than this, averaged over the tablet load stats "
+         "refresh interval, so that the load can be spread between more shards. Set to 0 to split tablets based on their size only.")
     , replication_strategy_warn_list(this, "replication_strategy_warn_list", liveness::LiveUpdate, value_status::Used, {locator::replication_strategy_type::simple}, "Controls which replication strategies to warn about when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , replication_strategy_fail_list(this, "replication_strategy_fail_list", liveness::LiveUpdate, value_status::Used, {}, "Controls which replication strategies are disallowed to be used when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , service_levels_interval(this, "service_levels_interval_ms", liveness::LiveUpdate, value_status::Used, 10000, "Controls how often service levels module polls configuration table")
@@ -1462,12 +1626,38 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , audit_keyspaces(this, "audit_keyspaces", liveness::LiveUpdate, value_status::Used, "", "Comma separated list of keyspaces that will be audited. All tables in those keyspaces will be audited")
     , audit_unix_socket_path(this, "audit_unix_socket_path", value_status::Used, "/dev/log", "The path to the unix socket used for writing to syslog. Only applicable when audit is set to syslog.")
     , audit_syslog_write_buffer_size(this, "audit_syslog_write_buffer_size", value_status::Used, 1048576, "The size (in bytes) of a write buffer used when writing to syslog socket.")
+    , audit_flush_interval_in_ms(this, "audit_flush_interval_in_ms", value_status::Used, 0,
+        "When non-zero, audit records are queued on each shard and written in the background, in batches, at most this often, "
+        "so that audited requests don't wait for the audit writes. When 0, each audited request waits for its audit record to be written.")
+    , audit_queue_max_records(this, "audit_queue_max_records", value_status::Used, 10000,
+        "Maximum number of audit records queued on each shard when audit_flush_interval_in_ms is non-zero. "
+        "What happens to requests once the queue is full is controlled by audit_queue_full_policy.")
+    , audit_queue_full_policy(this, "audit_queue_full_policy", value_status::Used, "block",
+        "What to do with the audit records of requests when the audit queue of the shard is full:\n"
+        "* block  Requests wait for room in the queue.\n"
+        "* drop   The records are dropped and counted in the audit_records_dropped metric."
+        , {"block", "drop"})
     , ldap_url_template(this, "ldap_url_template", value_status::Used, "", "LDAP URL template used by LDAPRoleManager for crafting queries.")
     , ldap_attr_role(this, "ldap_attr_role", value_status::Used, "", "LDAP attribute containing Scylla role.")
     , ldap_bind_dn(this, "ldap_bind_dn", value_status::Used, "", "Distinguished name used by LDAPRoleManager for binding to LDAP server.")
     , ldap_bind_passwd(this, "ldap_bind_passwd", value_status::Used, "", "Password used by LDAPRoleManager for binding to LDAP server.")
     , saslauthd_socket_path(this, "saslauthd_socket_path", value_status::Used, "", "UNIX domain socket on which saslauthd is listening.")
     , object_storage_endpoints(this, "object_storage_endpoints", liveness::LiveUpdate, value_status::Used, {}, "Object storage endpoints configuration.")
+    , object_storage_cache_size_in_mb(this, "object_storage_cache_size_in_mb", liveness::LiveUpdate, value_status::Used, 0,
+        "Size of the in-memory cache of blocks of sstable components kept in object storage, shared by all shards. "
+        "Blocks of index, summary, filter and compression info components are evicted last. 0 disables the cache.")
+    , object_storage_read_ahead_depth(this, "object_storage_read_ahead_depth", liveness::LiveUpdate, value_status::Used, 0,
+        "Number of concurrent ranged GET requests issued ahead by sequential reads of sstables in object storage, "
+        "e.g. by compaction and full scans. 0 reads the objects with a single streaming request.")
+    , object_storage_read_ahead_part_size_in_kb(this, "object_storage_read_ahead_part_size_in_kb", liveness::LiveUpdate, value_status::Used, 8192,
+        "Size of a single ranged GET request issued by the read-ahead of sstables in object storage.")
+    , backup_on_flush_endpoint(this, "backup_on_flush_endpoint", liveness::LiveUpdate, value_status::Used, "",
+        "Object storage endpoint, one of object_storage_endpoints, to which sstables of user tables are uploaded while they are written "
+        "by memtable flushes, compaction, repair and streaming, without reading them back from disk. Empty disables it.")
+    , backup_on_flush_bucket(this, "backup_on_flush_bucket", liveness::LiveUpdate, value_status::Used, "",
+        "Bucket to which sstables are backed up on flush.")
+    , backup_on_flush_prefix(this, "backup_on_flush_prefix", liveness::LiveUpdate, value_status::Used, "",
+        "Prefix of the names of sstables backed up on flush. The components of each sstable are uploaded as <prefix>/<keyspace>/<table>/<component>.")
     , error_injections_at_startup(this, "error_injections_at_startup", error_injection_value_status, {}, "List of error injections that should be enabled on startup.")
     , topology_barrier_stall_detector_threshold_seconds(this, "topology_barrier_stall_detector_threshold_seconds", value_status::Used, 2, "Report sites blocking topology barrier if it takes longer than this.")
     , enable_tablets(this, "enable_tablets", value_status::Used, false, "Enable tablets for newly created keyspaces. (deprecated)")
@@ -1480,6 +1670,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "to try to slow down the client and prevent buildup of unfinished view updates. "
         "To be effective, this maximal delay should be larger than the typical latencies. "
         "Setting view_flow_control_delay_limit_in_ms to 0 disables view-update flow control.")
+    , view_update_generator_concurrency(this, "view_update_generator_concurrency", liveness::LiveUpdate, value_status::Used, 4,
+        "The maximal number of groups of staging sstables (e.g. streamed by repair or tablet migration) of a table, "
+        "which a shard generates view updates from concurrently. Only sstables with non-overlapping token ranges "
+        "are processed concurrently.")
     , disk_space_monitor_normal_polling_interval_in_seconds(this, "disk_space_monitor_normal_polling_interval_in_seconds", value_status::Used, 10, "Disk-space polling interval while below polling threshold")
     , disk_space_monitor_high_polling_interval_in_seconds(this, "disk_space_monitor_high_polling_interval_in_seconds", value_status::Used, 1, "Disk-space polling interval at or above polling threshold")
     , disk_space_monitor_polling_interval_threshold(this, "disk_space_monitor_polling_interval_threshold", value_status::Used, 0.9, "Disk-space polling threshold. Polling interval is increased when disk utilization is greater than or equal to this threshold")
@@ -1492,6 +1686,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     // Bigger tables will take longer to be resized. similar-sized tables can be batched into same iteration.
     , tablet_load_stats_refresh_interval_in_seconds(this, "tablet_load_stats_refresh_interval_in_seconds", liveness::LiveUpdate, value_status::Used, 60,
         "Tablet load stats refresh rate in seconds.")
+    , tablet_balancing_join_window_in_ms(this, "tablet_balancing_join_window_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
+        "Time for which the topology coordinator defers tablet load balancing after a node joins the cluster. "
+        "Nodes which join within the window of each other are balanced for together, with their tablet migrations "
+        "planned and streamed in parallel, instead of each node waiting for the migrations which were started for the "
+        "previous one. Set to 0 to balance right after each node joins.")
     , default_log_level(this, "default_log_level", value_status::Used, seastar::log_level::info, "Default log level for log messages")
     , logger_log_level(this, "logger_log_level", value_status::Used, {}, "Map of logger name to log level. Valid log levels are 'error', 'warn', 'info', 'debug' and 'trace'")
     , log_to_stdout(this, "log_to_stdout", value_status::Used, true, "Send log output to stdout")
@@ -1528,12 +1727,17 @@ void db::config::add_paxos_grace_seconds_extension() {
     _extensions->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
 }
 
+void db::config::add_bloom_filter_extension() {
+    _extensions->add_schema_extension<db::bloom_filter_extension>(db::bloom_filter_extension::NAME);
+}
+
 void db::config::add_all_default_extensions() {
     add_cdc_extension();
     add_per_partition_rate_limit_extension();
     add_tags_extension();
     add_tombstone_gc_extension();
     add_paxos_grace_seconds_extension();
+    add_bloom_filter_extension();
 }
 
 void db::config::setup_directories() {
@@ -1542,6 +1746,7 @@ void db::config::setup_directories() {
         schema_commitlog_directory(commitlog_directory() + "/schema");
     }
     maybe_in_workdir(schema_commitlog_directory, "schema_commitlog");
+    maybe_in_workdir(raft_log_directory, "raft_log");
     maybe_in_workdir(data_file_directories, "data");
     maybe_in_workdir(hints_directory, "hints");
     maybe_in_workdir(view_hints_directory, "view_hints");
@@ -174,6 +174,7 @@ class config final : public utils::config_file {
     void add_tags_extension();
     void add_tombstone_gc_extension();
     void add_paxos_grace_seconds_extension();
+    void add_bloom_filter_extension();
 
     void add_all_default_extensions();
 
@@ -209,8 +210,11 @@ class config final : public utils::config_file {
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
     named_value<float> compaction_static_shares;
+    named_value<uint32_t> compaction_read_latency_target_ms;
     named_value<bool> compaction_enforce_min_threshold;
     named_value<uint32_t> compaction_flush_all_tables_before_major_seconds;
+    named_value<uint32_t> compaction_major_parallel_subranges;
+    named_value<uint32_t> compaction_offstrategy_round_size_in_mb;
     named_value<sstring> cluster_name;
     named_value<sstring> listen_address;
     named_value<sstring> listen_interface;
@@ -218,6 +222,7 @@ class config final : public utils::config_file {
     named_value<sstring> work_directory;
     named_value<sstring> commitlog_directory;
     named_value<sstring> schema_commitlog_directory;
+    named_value<sstring> raft_log_directory;
     named_value<string_list> data_file_directories;
     named_value<uint64_t> data_file_capacity;
     named_value<sstring> hints_directory;
@@ -250,6 +255,8 @@ class config final : public utils::config_file {
     named_value<uint32_t> schema_commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_group_commit_window_in_us;
+    named_value<uint32_t> commitlog_group_commit_max_bytes;
     named_value<uint32_t> commitlog_max_data_lifetime_in_seconds;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
@@ -257,6 +264,8 @@ class config final : public utils::config_file {
     named_value<bool> commitlog_use_o_dsync;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<sstring> commitlog_compression;
+    named_value<uint32_t> commitlog_domains;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -279,8 +288,12 @@ class config final : public utils::config_file {
     named_value<uint32_t> stream_throughput_outbound_megabits_per_sec;
     named_value<uint32_t> inter_dc_stream_throughput_outbound_megabits_per_sec;
     named_value<uint32_t> stream_io_throughput_mb_per_sec;
+    named_value<uint32_t> maintenance_shares;
+    named_value<uint32_t> maintenance_latency_slo_ms;
     named_value<double> stream_plan_ranges_fraction;
+    named_value<uint32_t> stream_rpc_streams_per_shard;
     named_value<bool> enable_file_stream;
+    named_value<uint32_t> load_and_stream_concurrency;
     named_value<bool> trickle_fsync;
     named_value<uint32_t> trickle_fsync_interval_in_kb;
     named_value<bool> auto_bootstrap;
@@ -299,6 +312,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> row_cache_keys_to_save;
     named_value<uint32_t> row_cache_size_in_mb;
     named_value<uint32_t> row_cache_save_period;
+    named_value<uint32_t> cache_cold_partition_compression_period_in_s;
     named_value<sstring> memory_allocator;
     named_value<uint32_t> counter_cache_size_in_mb;
     named_value<uint32_t> counter_cache_save_period;
@@ -307,16 +321,20 @@ class config final : public utils::config_file {
     named_value<uint32_t> tombstone_failure_threshold;
     named_value<uint64_t> query_tombstone_page_limit;
     named_value<uint64_t> query_page_size_in_bytes;
+    named_value<uint32_t> adaptive_paging_latency_budget_in_ms;
     named_value<uint32_t> group0_tombstone_gc_refresh_interval_in_ms;
     named_value<uint32_t> range_request_timeout_in_ms;
     named_value<uint32_t> read_request_timeout_in_ms;
     named_value<uint32_t> counter_write_request_timeout_in_ms;
     named_value<uint32_t> cas_contention_timeout_in_ms;
+    named_value<uint32_t> paxos_state_cache_size_in_mb;
     named_value<uint32_t> truncate_request_timeout_in_ms;
     named_value<uint32_t> write_request_timeout_in_ms;
     named_value<uint32_t> request_timeout_in_ms;
     named_value<uint32_t> request_timeout_on_shutdown_in_seconds;
     named_value<uint32_t> group0_raft_op_timeout_in_ms;
+    named_value<bool> raft_segment_log_storage;
+    named_value<uint32_t> raft_message_coalescing_window_in_us;
     named_value<bool> cross_node_timeout;
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
@@ -328,6 +346,13 @@ class config final : public utils::config_file {
     named_value<uint32_t> internode_compression_zstd_min_message_size;
     named_value<uint32_t> internode_compression_zstd_max_message_size;
     named_value<bool> internode_compression_checksumming;
+    named_value<bool> internode_compression_adaptive;
+    named_value<uint32_t> internode_compression_adaptive_raw_max_message_size;
+    named_value<float> internode_compression_adaptive_local_byte_cost_ns;
+    named_value<float> internode_compression_adaptive_remote_byte_cost_ns;
+    named_value<uint32_t> write_coalescing_window_in_us;
+    named_value<uint32_t> write_coalescing_max_bytes;
+    named_value<uint32_t> hints_replay_coalescing_window_in_us;
     named_value<utils::advanced_rpc_compressor::tracker::algo_config> internode_compression_algorithms;
     named_value<bool> internode_compression_enable_advanced;
     named_value<enum_option<utils::dict_training_loop::when>> rpc_dict_training_when;
@@ -350,16 +375,22 @@ class config final : public utils::config_file {
     named_value<bool> start_rpc;
     named_value<bool> rpc_keepalive;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> replica_latency_read_balancing;
+    named_value<double> read_replica_phi_suspicion_threshold;
+    named_value<bool> per_partition_rate_limit_coordinated;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
     named_value<hinted_handoff_enabled_type> hinted_handoff_enabled;
     named_value<uint32_t> max_hinted_handoff_concurrency;
+    named_value<uint32_t> hints_replay_throughput_mb_per_s;
+    named_value<sstring> hints_compression;
     named_value<uint32_t> hinted_handoff_throttle_in_kb;
     named_value<uint32_t> max_hint_window_in_ms;
     named_value<uint32_t> max_hints_delivery_threads;
     named_value<uint32_t> batchlog_replay_throttle_in_kb;
     named_value<uint32_t> batchlog_replay_cleanup_after_replays;
+    named_value<bool> batchlog_local_durable_writes;
     named_value<sstring> request_scheduler;
     named_value<sstring> request_scheduler_id;
     named_value<string_map> request_scheduler_options;
@@ -377,6 +408,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> ssl_storage_port;
     named_value<bool> enable_in_memory_data_store;
     named_value<bool> enable_cache;
+    named_value<bool> enable_lazy_latest_row_reads;
     named_value<bool> enable_commitlog;
     named_value<bool> volatile_system_keyspace_for_testing;
     named_value<uint16_t> api_port;
@@ -397,6 +429,7 @@ class config final : public utils::config_file {
     named_value<bool> enable_compacting_data_for_streaming_and_repair;
     named_value<bool> enable_tombstone_gc_for_streaming_and_repair;
     named_value<double> repair_partition_count_estimation_ratio;
+    named_value<uint32_t> repair_hash_tree_min_rows;
     named_value<uint32_t> repair_hints_batchlog_flush_cache_time_in_ms;
     named_value<uint64_t> repair_multishard_reader_buffer_hint_size;
     named_value<uint64_t> repair_multishard_reader_enable_read_ahead;
@@ -409,8 +442,11 @@ class config final : public utils::config_file {
     named_value<bool> developer_mode;
     named_value<int32_t> skip_wait_for_gossip_to_settle;
     named_value<int32_t> force_gossip_generation;
+    named_value<bool> gossip_message_size_metrics;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<bool> lsa_hugepage_arenas;
+    named_value<uint32_t> lsa_reclaim_time_slice_us;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
@@ -420,12 +456,15 @@ class config final : public utils::config_file {
     named_value<double> unspooled_dirty_soft_limit;
     named_value<double> sstable_summary_ratio;
     named_value<double> components_memory_reclaim_threshold;
+    named_value<bool> defer_sstable_filter_loading_on_startup;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_node_aggregated_table_metrics;
+    named_value<uint32_t> table_metrics_top_k;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<bool> sstable_write_bti_partition_index;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
     named_value<bool> enable_sstables_mc_format;
@@ -446,11 +485,15 @@ class config final : public utils::config_file {
     named_value<bool> abort_on_internal_error;
     named_value<uint32_t> max_partition_key_restrictions_per_query;
     named_value<uint32_t> max_clustering_key_restrictions_per_query;
+    named_value<uint32_t> unprepared_statements_cache_entries;
     named_value<uint64_t> max_memory_for_unlimited_query_soft_limit;
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
     named_value<uint32_t> reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_kill_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_cpu_concurrency;
+    named_value<bool> reader_concurrency_semaphore_adaptive_concurrency;
+    named_value<uint32_t> slow_read_log_threshold_in_ms;
+    named_value<uint32_t> hot_partitions_threshold;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_kill_limit_multiplier;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_cpu_concurrency;
@@ -463,7 +506,11 @@ class config final : public utils::config_file {
     named_value<unsigned> user_defined_function_allocation_limit_bytes;
     named_value<unsigned> user_defined_function_contiguous_allocation_limit_bytes;
     named_value<uint32_t> schema_registry_grace_period;
+    named_value<sstring> tracing_backend;
+    named_value<uint32_t> tracing_ring_buffer_records;
     named_value<uint32_t> max_concurrent_requests_per_shard;
+    named_value<uint32_t> cql_requests_offload_threshold;
+    named_value<uint32_t> cql_requests_prioritized_shedding_threshold;
     named_value<uint32_t> uninitialized_connections_semaphore_cpu_concurrency;
     named_value<bool> cdc_dont_rewrite_streams;
     named_value<tri_mode_restriction> strict_allow_filtering;
@@ -478,6 +525,7 @@ class config final : public utils::config_file {
     named_value<bool> alternator_enforce_authorization;
     named_value<sstring> alternator_write_isolation;
     named_value<uint32_t> alternator_streams_time_window_s;
+    named_value<uint32_t> alternator_streams_get_records_max_wait_ms;
     named_value<uint32_t> alternator_timeout_in_ms;
     named_value<double> alternator_ttl_period_in_seconds;
     named_value<sstring> alternator_describe_endpoints;
@@ -485,6 +533,7 @@ class config final : public utils::config_file {
     named_value<bool> alternator_allow_system_table_write;
 
     named_value<sstring> vector_store_uri;
+    named_value<bool> vector_search_local_fallback;
 
     named_value<bool> abort_on_ebadf;
 
@@ -509,6 +558,9 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<uint32_t> index_read_ahead_pages;
+    named_value<bool> cache_decompressed_chunks;
+    named_value<double> cache_protected_fraction;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
@@ -545,6 +597,8 @@ class config final : public utils::config_file {
     named_value<double> tablets_initial_scale_factor;
     named_value<unsigned> tablets_per_shard_goal;
     named_value<uint64_t> target_tablet_size_in_bytes;
+    named_value<double> tablet_heat_imbalance_threshold;
+    named_value<uint64_t> tablet_split_requests_per_second_threshold;
 
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_warn_list;
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_fail_list;
@@ -557,6 +611,9 @@ class config final : public utils::config_file {
     named_value<sstring> audit_keyspaces;
     named_value<sstring> audit_unix_socket_path;
     named_value<size_t> audit_syslog_write_buffer_size;
+    named_value<uint32_t> audit_flush_interval_in_ms;
+    named_value<uint32_t> audit_queue_max_records;
+    named_value<sstring> audit_queue_full_policy;
 
     named_value<sstring> ldap_url_template;
     named_value<sstring> ldap_attr_role;
@@ -569,6 +626,12 @@ class config final : public utils::config_file {
     const db::extensions& extensions() const;
 
     named_value<std::vector<object_storage_endpoint_param>> object_storage_endpoints;
+    named_value<uint32_t> object_storage_cache_size_in_mb;
+    named_value<uint32_t> object_storage_read_ahead_depth;
+    named_value<uint32_t> object_storage_read_ahead_part_size_in_kb;
+    named_value<sstring> backup_on_flush_endpoint;
+    named_value<sstring> backup_on_flush_bucket;
+    named_value<sstring> backup_on_flush_prefix;
 
     named_value<std::vector<error_injection_at_startup>> error_injections_at_startup;
     named_value<double> topology_barrier_stall_detector_threshold_seconds;
@@ -591,6 +654,7 @@ class config final : public utils::config_file {
     }
 
     named_value<uint32_t> view_flow_control_delay_limit_in_ms;
+    named_value<uint32_t> view_update_generator_concurrency;
 
     named_value<int> disk_space_monitor_normal_polling_interval_in_seconds;
     named_value<int> disk_space_monitor_high_polling_interval_in_seconds;
@@ -602,6 +666,7 @@ class config final : public utils::config_file {
     named_value<bool> rf_rack_valid_keyspaces;
 
     named_value<uint32_t> tablet_load_stats_refresh_interval_in_seconds;
+    named_value<uint32_t> tablet_balancing_join_window_in_ms;
 
     static const sstring default_tls_priority;
 private:
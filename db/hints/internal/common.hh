@@ -43,6 +43,8 @@ struct hint_stats {
     uint64_t discarded                  = 0;
     uint64_t send_errors                = 0;
     uint64_t corrupted_files            = 0;
+    uint64_t replay_throttled           = 0;
+    uint64_t converted                  = 0;
 };
 
 } // namespace internal
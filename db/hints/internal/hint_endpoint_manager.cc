@@ -18,6 +18,7 @@
 #include <seastar/coroutine/exception.hh>
 
 // Scylla includes.
+#include "db/config.hh"
 #include "db/hints/internal/common.hh"
 #include "db/hints/internal/hint_logger.hh"
 #include "db/hints/internal/hint_storage.hh"
@@ -214,6 +215,7 @@ future<db::commitlog> hint_endpoint_manager::add_store() noexcept {
             cfg.commitlog_total_space_in_mb = resource_manager::max_hints_per_ep_size_mb;
             cfg.fname_prefix = manager::FILENAME_PREFIX;
             cfg.extensions = &_shard_manager.local_db().extensions();
+            cfg.compression = commitlog_entry_compression_from_string(_shard_manager.local_db().get_config().hints_compression());
 
             // HH leaves segments on disk after commitlog shutdown, and later reads
             // them when commitlog is re-created. This is expected to happen regularly
@@ -20,8 +20,10 @@
 #include <seastar/core/sleep.hh>
 #include <seastar/core/format.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/smp.hh>
 
 // Scylla includes.
+#include "db/config.hh"
 #include "db/hints/internal/common.hh"
 #include "db/hints/internal/hint_logger.hh"
 #include "db/hints/internal/hint_endpoint_manager.hh"
@@ -96,16 +98,24 @@ bool hint_sender::can_send() noexcept {
 frozen_mutation_and_schema hint_sender::get_mutation(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf) {
     hint_entry_reader hr(buf);
     auto& fm = hr.mutation();
-    auto& cm = get_column_mapping(std::move(ctx_ptr), fm, hr);
     auto schema = _db.find_schema(fm.column_family_id());
 
-    if (schema->version() != fm.schema_version()) {
-        mutation m(schema, fm.decorated_key(*schema));
-        converting_mutation_partition_applier v(cm, *schema, m.partition());
-        fm.partition().accept(cm, v);
-        return {freeze(m), std::move(schema)};
+    if (schema->version() == fm.schema_version()) {
+        // The common case: the serialized mutation is sent as it was read, without decoding it.
+        // A column mapping is stored only with the first hint of each schema version in a file,
+        // so it still has to be remembered, in case the schema changes before the following hints are sent.
+        if (const auto& cm = hr.get_column_mapping()) {
+            ctx_ptr->schema_ver_to_column_mapping.try_emplace(fm.schema_version(), *cm);
+        }
+        return {std::move(hr).mutation(), std::move(schema)};
     }
-    return {std::move(hr).mutation(), std::move(schema)};
+
+    auto& cm = get_column_mapping(std::move(ctx_ptr), fm, hr);
+    mutation m(schema, fm.decorated_key(*schema));
+    converting_mutation_partition_applier v(cm, *schema, m.partition());
+    fm.partition().accept(cm, v);
+    ++shard_stats().converted;
+    return {freeze(m), std::move(schema)};
 }
 
 const column_mapping& hint_sender::get_column_mapping(lw_shared_ptr<send_one_file_ctx> ctx_ptr, const frozen_mutation& fm, const hint_entry_reader& hr) {
@@ -270,6 +280,16 @@ future<> hint_sender::send_one_mutation(frozen_mutation_and_schema m) {
     });
 }
 
+hint_sender::clock::duration hint_sender::reserve_replay_rate(size_t bytes) noexcept {
+    // Draining means the destination is leaving the cluster, so it doesn't need to be spared.
+    if (draining()) {
+        return clock::duration::zero();
+    }
+    const double node_rate = double(_db.get_config().hints_replay_throughput_mb_per_s()) * 1024 * 1024;
+    const double rate = replay_rate_for_backlog(node_rate / smp::count, _proxy.get_backlog_of(_ep_key).relative_size());
+    return _rate_limiter.reserve(bytes, rate, clock::now());
+}
+
 future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
     return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
         ctx_ptr->mark_hint_as_in_progress(rp);
@@ -498,6 +518,12 @@ bool hint_sender::send_one_file(const sstring& fname) {
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
                 } else {
+                    if (auto delay = reserve_replay_rate(buf.size_bytes()); delay != clock::duration::zero()) {
+                        manager_logger.trace("hint_sender[{}]:send_one_file: Throttling replay for {}ms", _ep_key,
+                                std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
+                        ++this->shard_stats().replay_throttled;
+                        co_await sleep_abortable(delay, _stop_as);
+                    }
                     co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
                 }
@@ -22,6 +22,7 @@
 #include "db/commitlog/replay_position.hh"
 #include "db/hints/internal/common.hh"
 #include "db/hints/internal/hint_storage.hh"
+#include "db/hints/internal/replay_rate_limiter.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "mutation/frozen_mutation.hh"
 #include "schema/schema.hh"
@@ -116,6 +117,7 @@ class hint_sender {
     seastar::scheduling_group _hints_cpu_sched_group;
     const gms::gossiper& _gossiper;
     seastar::shared_mutex& _file_update_mutex;
+    replay_rate_limiter _rate_limiter;
 
     std::multimap<db::replay_position, lw_shared_ptr<std::optional<promise<>>>> _replay_waiters;
 
@@ -216,6 +218,15 @@ class hint_sender {
     /// \return future that resolves when next hint may be sent
     future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+    /// \brief Reserves the replay rate for a hint of \param bytes size.
+    ///
+    /// The rate allowed by hints_replay_throughput_mb_per_s is divided across shards and
+    /// is reduced when the destination reports a growing view update backlog.
+    /// Hints are not throttled while draining.
+    ///
+    /// \return How long to wait before sending the hint.
+    clock::duration reserve_replay_rate(size_t bytes) noexcept;
+
     /// \brief Send all hint from a single file and delete it after it has been successfully sent.
     /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
     /// iteration from where we left in this one.
@@ -229,6 +240,10 @@ class hint_sender {
     bool can_send() noexcept;
 
     /// \brief Restore a mutation object from the hints file entry.
+    ///
+    /// If the hint was written with the current schema version of its table, its serialized
+    /// mutation is returned as is. Otherwise it is converted to the current schema.
+    ///
     /// \param ctx_ptr pointer to the send context
     /// \param buf hints file entry
     /// \return The mutation object representing the original mutation stored in the hints file.
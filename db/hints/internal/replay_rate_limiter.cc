@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "db/hints/internal/replay_rate_limiter.hh"
+
+// STD.
+#include <algorithm>
+#include <chrono>
+
+namespace db::hints {
+namespace internal {
+
+replay_rate_limiter::clock::duration replay_rate_limiter::reserve(size_t bytes, double rate, clock::time_point now) noexcept {
+    if (rate <= 0) {
+        _tokens = 0;
+        _last_refill = std::nullopt;
+        return clock::duration::zero();
+    }
+
+    const double capacity = std::max(rate, double(bytes));
+    if (!_last_refill) {
+        _tokens = capacity;
+    } else {
+        const double elapsed = std::chrono::duration<double>(now - *_last_refill).count();
+        _tokens = std::min(capacity, _tokens + std::max(elapsed, 0.0) * rate);
+    }
+    _last_refill = now;
+
+    _tokens -= bytes;
+    if (_tokens >= 0) {
+        return clock::duration::zero();
+    }
+    return std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(-_tokens / rate));
+}
+
+double replay_rate_for_backlog(double rate, float backlog_relative_size) noexcept {
+    constexpr double min_fraction = 1.0 / 16;
+    const double fraction = std::clamp(1.0 - double(backlog_relative_size), min_fraction, 1.0);
+    return rate * fraction;
+}
+
+} // namespace internal
+} // namespace db::hints
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+#pragma once
+
+// Seastar features.
+#include <seastar/core/lowres_clock.hh>
+
+// STD.
+#include <cstddef>
+#include <optional>
+
+namespace db::hints {
+namespace internal {
+
+/// \brief A token bucket limiting the rate at which a hint_sender replays hints.
+///
+/// The bucket holds at most one second worth of the rate (or of the current hint,
+/// if it is bigger), so a sender which was idle can burst for that long. Reservations
+/// are never refused: a hint which doesn't fit puts the bucket in debt, and the
+/// sender has to wait until the debt is paid off before sending it.
+///
+/// The rate is passed with every reservation, so that changes of the configuration
+/// and of the destination's load take effect immediately.
+class replay_rate_limiter {
+public:
+    using clock = seastar::lowres_clock;
+
+private:
+    double _tokens = 0;
+    std::optional<clock::time_point> _last_refill;
+
+public:
+    /// \brief Reserves \param bytes from the bucket.
+    /// \param rate the allowed rate in bytes per second, 0 means unlimited
+    /// \return How long the caller has to wait before sending the reserved bytes.
+    clock::duration reserve(size_t bytes, double rate, clock::time_point now) noexcept;
+};
+
+/// \brief Scales the replay rate according to the load reported by the destination.
+///
+/// The rate drops linearly with the destination's view update backlog (see
+/// db::view::update_backlog::relative_size()), down to 1/16 of \param rate once
+/// the backlog reaches the admission control threshold, so that replay still
+/// makes progress.
+double replay_rate_for_backlog(double rate, float backlog_relative_size) noexcept;
+
+} // namespace internal
+} // namespace db::hints
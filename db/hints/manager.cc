@@ -186,6 +186,12 @@ void manager::register_metrics(const sstring& group_name) {
         sm::make_counter("corrupted_files", _stats.corrupted_files,
                         sm::description("Number of hints files that were discarded during sending because the file was corrupted.")),
 
+        sm::make_counter("replay_throttled", _stats.replay_throttled,
+                        sm::description("Number of hints whose sending was delayed to keep the replay rate to their destination within hints_replay_throughput_mb_per_s.")),
+
+        sm::make_counter("converted", _stats.converted,
+                        sm::description("Number of hints which had to be converted to the current schema of their table before sending.")),
+
         sm::make_gauge("pending_drains",
                         sm::description("Number of tasks waiting in the queue for draining hints"),
                         [this] { return _drain_lock.waiters(); }),
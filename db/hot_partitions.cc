@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <limits>
+
+#include <seastar/core/metrics.hh>
+
+#include "db/hot_partitions.hh"
+
+namespace db {
+
+static uint64_t mix(uint64_t h, unsigned row) noexcept {
+    // splitmix64 finalizer, seeded differently for each row
+    h += 0x9e3779b97f4a7c15 * (row + 1);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+    return h ^ (h >> 31);
+}
+
+hot_partitions::hot_partitions(utils::updateable_value<uint32_t> threshold, size_t capacity, lowres_clock::duration decay_period)
+        : _threshold(std::move(threshold))
+        , _capacity(capacity)
+        , _sketch(sketch_depth * sketch_width, 0)
+        , _reads(capacity)
+        , _writes(capacity)
+        , _decay_timer([this] { decay(); }) {
+    _decay_timer.arm_periodic(decay_period);
+    namespace sm = seastar::metrics;
+    _metrics.add_group("database", {
+        sm::make_counter("hot_partitions_admitted", _stats.admitted,
+                sm::description("Number of times a partition was found to be hot and started being tracked, see system.hot_partitions.")),
+        sm::make_gauge("hot_partition_reads", [this] { return hottest(operation_type::read); },
+                sm::description("Decayed number of reads of the partition with the most reads.")),
+        sm::make_gauge("hot_partition_writes", [this] { return hottest(operation_type::write); },
+                sm::description("Decayed number of writes of the partition with the most writes.")),
+    });
+}
+
+uint32_t hot_partitions::increment_sketch(uint64_t hash) noexcept {
+    uint32_t* counters[sketch_depth];
+    uint32_t freq = std::numeric_limits<uint32_t>::max();
+    for (unsigned row = 0; row < sketch_depth; ++row) {
+        counters[row] = &_sketch[row * sketch_width + (mix(hash, row) & (sketch_width - 1))];
+        freq = std::min(freq, *counters[row]);
+    }
+    if (freq == std::numeric_limits<uint32_t>::max()) {
+        return freq;
+    }
+    // Conservative update: only the smallest counters are incremented,
+    // which reduces the over-estimation caused by collisions.
+    for (auto c : counters) {
+        if (*c == freq) {
+            ++*c;
+        }
+    }
+    return freq + 1;
+}
+
+void hot_partitions::record(operation_type op, table_id table, const dht::token& token, partition_key_view pk) {
+    auto threshold = _threshold();
+    if (!threshold) {
+        return;
+    }
+    auto hash = uint64_t(dht::token::to_int64(token)) ^ (table.uuid().get_least_significant_bits() * 0x9e3779b97f4a7c15) ^ uint64_t(op);
+    auto estimate = increment_sketch(hash);
+    if (estimate < threshold) {
+        return;
+    }
+    auto& top = top_for(op);
+    if (top.append(key{table, dht::decorated_key(token, partition_key(pk))})) {
+        // Account for the operations counted by the sketch before the
+        // partition became hot.
+        top.append(key{table, dht::decorated_key(token, partition_key(pk))}, estimate - 1);
+        ++_stats.admitted;
+    }
+}
+
+void hot_partitions::decay() {
+    for (auto& c : _sketch) {
+        c /= 2;
+    }
+    for (auto* top : {&_reads, &_writes}) {
+        top_k decayed(_capacity);
+        for (auto& r : top->top(_capacity)) {
+            if (r.count / 2) {
+                decayed.append(std::move(r.item), r.count / 2, r.error / 2);
+            }
+        }
+        *top = std::move(decayed);
+    }
+}
+
+hot_partitions::top_k::results hot_partitions::top(operation_type op, unsigned k) const {
+    return top_for(op).top(k);
+}
+
+unsigned hot_partitions::hottest(operation_type op) const {
+    auto res = top_for(op).top(1);
+    return res.empty() ? 0 : res.front().count;
+}
+
+}
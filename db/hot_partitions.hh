@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+
+#include "db/operation_type.hh"
+#include "dht/decorated_key.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/top_k.hh"
+#include "utils/updateable_value.hh"
+
+namespace db {
+
+/// \brief Always-on detection of the partitions which receive the most reads and writes.
+///
+/// Unlike toppartitions, which samples all operations for the duration of an
+/// explicit session, this runs all the time, so it has to be cheap for the vast
+/// majority of the partitions, which are not hot.
+///
+/// Each single partition read and each write is counted in a count-min sketch,
+/// keyed by the table and the token; that's a few hashes and increments of
+/// fixed size counters. Only once the estimated count of a partition reaches
+/// the threshold, its operations are counted by a space_saving_top_k, one for
+/// reads and one for writes, which holds a copy of its key.
+///
+/// All the counts are halved every decay period, so they approximate the
+/// number of operations in the last two periods, and partitions which cooled
+/// down fade away.
+class hot_partitions {
+public:
+    struct key {
+        table_id table;
+        dht::decorated_key dk;
+
+        struct hash {
+            size_t operator()(const key& k) const noexcept {
+                return std::hash<dht::token>()(k.dk.token());
+            }
+        };
+
+        struct equal {
+            bool operator()(const key& k1, const key& k2) const noexcept {
+                return k1.table == k2.table && k1.dk.token() == k2.dk.token()
+                        && k1.dk.key().representation() == k2.dk.key().representation();
+            }
+        };
+    };
+
+    using top_k = utils::space_saving_top_k<key, key::hash, key::equal>;
+
+    struct stats {
+        uint64_t admitted = 0;
+    };
+
+    static constexpr lowres_clock::duration default_decay_period = std::chrono::seconds(10);
+private:
+    static constexpr unsigned sketch_depth = 4;
+    static constexpr size_t sketch_width = 4096;
+
+    // When zero, nothing is counted.
+    utils::updateable_value<uint32_t> _threshold;
+    size_t _capacity;
+    // sketch_depth rows of sketch_width counters.
+    std::vector<uint32_t> _sketch;
+    top_k _reads;
+    top_k _writes;
+    timer<lowres_clock> _decay_timer;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    top_k& top_for(operation_type op) noexcept {
+        return op == operation_type::read ? _reads : _writes;
+    }
+
+    const top_k& top_for(operation_type op) const noexcept {
+        return op == operation_type::read ? _reads : _writes;
+    }
+
+    // Returns the estimated count after the increment.
+    uint32_t increment_sketch(uint64_t hash) noexcept;
+    unsigned hottest(operation_type op) const;
+public:
+    hot_partitions(utils::updateable_value<uint32_t> threshold, size_t capacity = 64,
+            lowres_clock::duration decay_period = default_decay_period);
+    hot_partitions(hot_partitions&&) = delete;
+
+    bool enabled() const noexcept {
+        return _threshold() > 0;
+    }
+
+    void record(operation_type op, table_id table, const dht::token& token, partition_key_view pk);
+
+    // Halves all the counts, called every decay period.
+    void decay();
+
+    top_k::results top(operation_type op, unsigned k) const;
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+}
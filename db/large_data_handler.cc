@@ -62,6 +62,7 @@ future<> large_data_handler::stop() {
         _running = false;
         large_data_logger.info("Waiting for {} background handlers", max_concurrency - _sem.available_units());
         co_await _sem.wait(max_concurrency);
+        co_await stop_recording();
         co_await _sys_ks.close();
     }
 }
@@ -146,12 +147,80 @@ cql_table_large_data_handler::cql_table_large_data_handler(gms::feature_service&
     , _collection_elements_count_threshold_updater(_collection_elements_count_threshold, std::move(collection_elements_count_threshold))
 {}
 
+bool cql_table_large_data_handler::should_record(const sstring& key) const {
+    if (_recorded_keys.contains(key)) {
+        ++_recording_stats.deduplicated;
+        return false;
+    }
+    if (_pending_records.size() >= max_pending_records) {
+        ++_recording_stats.dropped;
+        return false;
+    }
+    if (_pending_records.size() >= max_pending_records / 2 && _sampled_records++ % sampling_rate != 0) {
+        ++_recording_stats.sampled_out;
+        return false;
+    }
+    if (_recorded_keys.size() >= max_recorded_keys) {
+        _recorded_keys.clear();
+    }
+    _recorded_keys.insert(key);
+    ++_recording_stats.recorded;
+    return true;
+}
+
+future<> cql_table_large_data_handler::run_recorder() const {
+    while (true) {
+        co_await _pending_records_cv.wait([this] { return !_pending_records.empty() || _stopping; });
+        if (_pending_records.empty()) {
+            co_return;
+        }
+        auto insert = std::move(_pending_records.front());
+        _pending_records.pop_front();
+        if (auto sys_ks = _sys_ks.get_permit()) {
+            co_await insert(*sys_ks);
+        }
+    }
+}
+
+future<> cql_table_large_data_handler::flush_pending_records() const {
+    if (!_recorder) {
+        co_return;
+    }
+    promise<> pr;
+    auto f = pr.get_future();
+    _pending_records.push_back([pr = std::move(pr)] (db::system_keyspace&) mutable {
+        pr.set_value();
+        return make_ready_future<>();
+    });
+    _pending_records_cv.signal();
+    try {
+        co_await std::move(f);
+    } catch (const broken_promise&) {
+        // The recorder skipped the entry, system_keyspace is gone.
+    }
+}
+
+future<> cql_table_large_data_handler::stop_recording() {
+    _stopping = true;
+    _pending_records_cv.broadcast();
+    if (_recorder) {
+        co_await std::exchange(_recorder, std::nullopt).value();
+    }
+}
+
 template <typename... Args>
 future<> cql_table_large_data_handler::try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
         std::string_view size_desc, std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) const {
-    auto sys_ks = _sys_ks.get_permit();
-    if (!sys_ks) {
-        co_return;
+    if (!_sys_ks.get_permit()) {
+        return make_ready_future<>();
+    }
+    const schema &s = *sst.get_schema();
+    auto ks_name = s.ks_name();
+    auto cf_name = s.cf_name();
+    const auto sstable_name = large_data_handler::sst_filename(sst);
+    std::string pk_str = key_to_str(partition_key.to_partition_key(s), s);
+    if (!should_record(seastar::format("{}/{}.{}/{}/{}", large_table, ks_name, cf_name, sstable_name, pk_str))) {
+        return make_ready_future<>();
     }
 
     sstring extra_fields_str;
@@ -160,21 +229,24 @@ future<> cql_table_large_data_handler::try_record(std::string_view large_table,
         extra_fields_str += seastar::format(", {}", field);
         extra_values += ", ?";
     }
-    const sstring req = seastar::format("INSERT INTO system.large_{}s (keyspace_name, table_name, sstable_name, {}_size, partition_key, compaction_time{}) VALUES (?, ?, ?, ?, ?, ?{}) USING TTL 2592000",
+    sstring req = seastar::format("INSERT INTO system.large_{}s (keyspace_name, table_name, sstable_name, {}_size, partition_key, compaction_time{}) VALUES (?, ?, ?, ?, ?, ?{}) USING TTL 2592000",
             large_table, large_table, extra_fields_str, extra_values);
-    const schema &s = *sst.get_schema();
-    auto ks_name = s.ks_name();
-    auto cf_name = s.cf_name();
-    const auto sstable_name = large_data_handler::sst_filename(sst);
-    std::string pk_str = key_to_str(partition_key.to_partition_key(s), s);
     auto timestamp = db_clock::now();
     large_data_logger.warn("Writing large {} {}/{}: {} ({}) to {}", desc, ks_name, cf_name, extra_path, size_desc, sstable_name);
-    co_await sys_ks->execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
-            .discard_result()
-            .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
-                large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
-                        large_table, ks_name, cf_name, sstable_name, ep);
-            });
+    _pending_records.push_back([req = std::move(req), ks_name, cf_name, large_table = sstring(large_table), sstable_name, size, pk_str = std::move(pk_str), timestamp,
+            ...args = std::forward<Args>(args)] (db::system_keyspace& sys_ks) {
+        return sys_ks.execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
+                .discard_result()
+                .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
+                    large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
+                            large_table, ks_name, cf_name, sstable_name, ep);
+                });
+    });
+    if (!_recorder) {
+        _recorder = run_recorder();
+    }
+    _pending_records_cv.signal();
+    return make_ready_future<>();
 }
 
 future<> cql_table_large_data_handler::record_large_partitions(const sstables::sstable& sst, const sstables::key& key,
@@ -246,6 +318,10 @@ future<> cql_table_large_data_handler::record_large_rows(const sstables::sstable
 }
 
 future<> cql_table_large_data_handler::delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const {
+    // The records of the sstable may still be queued, let them be inserted
+    // first, so they don't outlive the sstable. The sstable is not written
+    // anymore, no new records of it can be queued past this point.
+    co_await flush_pending_records();
     auto sys_ks = _sys_ks.get_permit();
     SCYLLA_ASSERT(sys_ks);
     const sstring req =
@@ -9,6 +9,10 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/util/noncopyable_function.hh>
 #include "schema/schema_fwd.hh"
 #include "system_keyspace.hh"
 #include "sstables/shared_sstable.hh"
@@ -142,10 +146,52 @@ class large_data_handler {
     virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const = 0;
     virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const = 0;
+    // Called by stop(), after the pending record_*() calls resolve, to wait
+    // for the records they left in the background.
+    virtual future<> stop_recording() { return make_ready_future<>(); }
 };
 
+// Records the large data in the system.large_* tables in the background, so
+// that sstable writers never wait for the internal writes.
+//
+// The records are queued on the shard and inserted one by one. To keep the
+// queue, and the load on the system tables, bounded when many partitions are
+// large:
+// * only the first record of a partition is kept for each sstable and
+//   system table, so a partition with many large rows or cells is recorded
+//   once, with the first of them;
+// * once the queue is half full, only one in sampling_rate records is kept;
+// * once the queue is full, records are dropped.
+// The writers still collect the large data statistics of the sstables,
+// they are not affected by the above.
 class cql_table_large_data_handler : public large_data_handler {
+public:
+    static constexpr size_t max_pending_records = 1024;
+    static constexpr unsigned sampling_rate = 8;
+
+    struct recording_stats {
+        uint64_t recorded = 0;
+        uint64_t deduplicated = 0;
+        uint64_t sampled_out = 0;
+        uint64_t dropped = 0;
+    };
+
+private:
+    // Bounds the memory used for deduplication. Forgetting the keys only
+    // means some partition may be recorded again.
+    static constexpr size_t max_recorded_keys = 16 * 1024;
+
+    using insert_function = noncopyable_function<future<> (db::system_keyspace&)>;
+
     gms::feature_service& _feat;
+    mutable std::deque<insert_function> _pending_records;
+    mutable condition_variable _pending_records_cv;
+    mutable std::unordered_set<sstring> _recorded_keys;
+    mutable uint64_t _sampled_records = 0;
+    mutable std::optional<future<>> _recorder;
+    bool _stopping = false;
+    mutable recording_stats _recording_stats;
+
     std::function<future<> (const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements)> _record_large_cells;
     std::function<future<> (const sstables::sstable& sst, const sstables::key& partition_key,
@@ -175,8 +221,21 @@ class cql_table_large_data_handler : public large_data_handler {
     virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const override;
     virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+    virtual future<> stop_recording() override;
+
+public:
+    const recording_stats& get_recording_stats() const noexcept {
+        return _recording_stats;
+    }
+
+    // Waits for the records queued so far to be inserted.
+    future<> flush_pending_records() const;
 
 private:
+    // Whether the record with the key should be queued, see the class comment.
+    bool should_record(const sstring& key) const;
+    future<> run_recorder() const;
+
     future<> internal_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const;
     future<> internal_record_large_cells_and_collections(const sstables::sstable& sst, const sstables::key& partition_key,
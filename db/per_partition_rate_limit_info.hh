@@ -22,7 +22,11 @@ namespace per_partition_rate_limit {
 // and accept it regardless from the value of the counter.
 //
 // Used when the coordinator IS a replica (correct node and shard).
-struct account_only {};
+struct account_only {
+    // By how much the replica should increase the counter, see
+    // account_and_enforce::weight.
+    uint32_t weight = 1;
+};
 
 // Tells the replica to account the operation and decide whether to reject
 // or not, based on the random variable sent by the coordinator.
@@ -34,6 +38,14 @@ struct account_and_enforce {
     // to accept or reject.
     uint32_t random_variable;
 
+    // By how much the replica should increase the counter. In the coordinated
+    // mode (per_partition_rate_limit_coordinated), it is the number of replicas
+    // of the partition divided by the number of replicas the operation is sent
+    // to, so that the counter of each replica approximates the rate of the
+    // partition in the whole cluster, and not only the part of it which
+    // reached the replica. Otherwise, it is 1.
+    uint32_t weight = 1;
+
     inline double get_random_variable_as_double() const {
         return double(random_variable) / double(1LL << 32);
     }
@@ -17,16 +17,19 @@
 
 #include "utils/small_vector.hh"
 #include "utils/murmur_hash.hh"
+#include "utils/overloaded_functor.hh"
 #include "db/rate_limiter.hh"
 
 // The rate limiter keeps a hashmap of counters differentiated by operation type
 // (e.g. read or write) and the partition token. On each operation,
-// the corresponding counter is increased by 1.
+// the corresponding counter is increased by the weight of the operation,
+// which is 1 unless the coordinator asks to account the operation on behalf
+// of the replicas which don't receive it (see per_partition_rate_limit_info.hh).
 //
 // The counters are decremented via two mechanisms:
 //
 // 1. Every `time_window_duration`, all counters are halved.
-// 2. Within a time window, on every `bucket_size` operations all counters
+// 2. Within a time window, on every `bucket_size` (weighted) operations all counters
 //    are decremented by 1.
 //
 // The mechanism 1) makes sure that we do not forget about very frequent
@@ -230,7 +233,7 @@ rate_limiter_base::rate_limiter_base()
     register_metrics();
 }
 
-uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token, uint32_t weight) noexcept {
     // Assign a label if not done yet
     if (l._label == 0) {
         l._label = _next_label++;
@@ -245,9 +248,9 @@ uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) n
     }
 
     // Protect from wrap-around
-    b->op_count = std::min<uint32_t>((1 << op_count_bits) - 1, b->op_count + 1);
-    ++_current_ops_in_bucket;
-    if (_current_ops_in_bucket >= bucket_size) {
+    b->op_count = std::min<uint64_t>((1 << op_count_bits) - 1, uint64_t(b->op_count) + weight);
+    _current_ops_in_bucket += weight;
+    while (_current_ops_in_bucket >= bucket_size) {
         // Every `bucket_size` operations, virtually decrement all entries
         // by one. We implement it by always subtracting the `_current_bucket`
         // when comparing the count in the entry with the limit.
@@ -268,7 +271,11 @@ rate_limiter_base::can_proceed rate_limiter_base::account_operation(
         return can_proceed::yes;
     }
 
-    const uint64_t count = increase_and_get_counter(l, token);
+    const uint32_t weight = std::visit(overloaded_functor {
+        [] (const std::monostate&) -> uint32_t { return 0; },
+        [] (const auto& info) { return std::max<uint32_t>(info.weight, 1); },
+    }, rate_limit_info);
+    const uint64_t count = increase_and_get_counter(l, token, weight);
 
     if (auto* info = std::get_if<db::per_partition_rate_limit::account_and_enforce>(&rate_limit_info)) {
         // On each time window change we halve the entry counts, therefore
@@ -126,11 +126,12 @@ class rate_limiter_base {
     rate_limiter_base& operator=(rate_limiter_base&&) = delete;
 
     // (For testing purposes only)
-    // Increments the counter for given (label, token) and returns
+    // Increases the counter for given (label, token) by `weight` and returns
     // the new value of the counter.
-    uint64_t increase_and_get_counter(label& l, uint64_t token) noexcept;
+    uint64_t increase_and_get_counter(label& l, uint64_t token, uint32_t weight = 1) noexcept;
 
-    // Increments the counter for given (label, token).
+    // Increases the counter for given (label, token) by the weight carried
+    // by `rate_limit_info`.
     // If the counter indicates that the partition is over the limit,
     // returns can_proceed::no with some probability.
     //
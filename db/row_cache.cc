@@ -14,7 +14,10 @@
 #include <seastar/core/thread.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/core/on_internal_error.hh>
 #include <seastar/util/defer.hh>
+#include <unordered_set>
 #include "replica/memtable.hh"
 #include <boost/version.hpp>
 #include <sys/sdt.h>
@@ -29,6 +32,9 @@
 #include "utils/assert.hh"
 #include "utils/updateable_value.hh"
 #include "utils/labels.hh"
+#include "utils/histogram_metrics_helper.hh"
+#include "mutation/frozen_mutation.hh"
+#include "sstables/compressor.hh"
 
 namespace cache {
 
@@ -56,19 +62,23 @@ row_cache::create_underlying_reader(read_context& ctx, mutation_source& src, con
 
 static thread_local mutation_application_stats dummy_app_stats;
 static thread_local utils::updateable_value<double> dummy_index_cache_fraction(1.0);
+static thread_local utils::updateable_value<double> dummy_protected_fraction(0.0);
 
 cache_tracker::cache_tracker()
-    : cache_tracker(dummy_index_cache_fraction, dummy_app_stats, register_metrics::no)
+    : cache_tracker(dummy_index_cache_fraction, dummy_protected_fraction, dummy_app_stats, register_metrics::no)
 {}
 
-cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fraction, register_metrics with_metrics)
-    : cache_tracker(std::move(index_cache_fraction), dummy_app_stats, with_metrics)
+cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fraction, utils::updateable_value<double> protected_fraction,
+        register_metrics with_metrics)
+    : cache_tracker(std::move(index_cache_fraction), std::move(protected_fraction), dummy_app_stats, with_metrics)
 {}
 
 static thread_local cache_tracker* current_tracker;
 
-cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fraction, mutation_application_stats& app_stats, register_metrics with_metrics)
-    : _garbage(_region, this, app_stats)
+cache_tracker::cache_tracker(utils::updateable_value<double> index_cache_fraction, utils::updateable_value<double> protected_fraction,
+        mutation_application_stats& app_stats, register_metrics with_metrics)
+    : _lru(std::move(protected_fraction))
+    , _garbage(_region, this, app_stats)
     , _memtable_cleaner(_region, nullptr, app_stats)
     , _app_stats(app_stats)
     , _index_cache_fraction(std::move(index_cache_fraction))
@@ -140,6 +150,8 @@ void cache_tracker::set_compaction_scheduling_group(seastar::scheduling_group sg
 namespace sstables {
 void register_index_page_cache_metrics(seastar::metrics::metric_groups&, cached_file_stats&);
 void register_index_page_metrics(seastar::metrics::metric_groups&, partition_index_cache_stats&);
+void register_decompressed_chunk_cache_metrics(seastar::metrics::metric_groups&, decompressed_chunk_cache_stats&);
+void register_promoted_index_block_cache_metrics(seastar::metrics::metric_groups&, promoted_index_block_cache_stats&);
 };
 
 void
@@ -151,6 +163,8 @@ cache_tracker::setup_metrics() {
         sm::make_counter("partition_hits", sm::description("number of partitions needed by reads and found in cache"), _stats.partition_hits)(basic_level),
         sm::make_counter("partition_misses", sm::description("number of partitions needed by reads and missing in cache"), _stats.partition_misses)(basic_level),
         sm::make_counter("partition_insertions", sm::description("total number of partitions added to cache"), _stats.partition_insertions)(basic_level),
+        sm::make_counter("partition_admissions", sm::description("number of missed partitions admitted into cache by the frequency admission policy"), _stats.partition_admissions),
+        sm::make_counter("partition_admission_rejections", sm::description("number of missed partitions not admitted into cache by the frequency admission policy, because they were not accessed frequently enough"), _stats.partition_admission_rejections),
         sm::make_counter("row_hits", sm::description("total number of rows needed by reads and found in cache"), _stats.row_hits)(basic_level),
         sm::make_counter("dummy_row_hits", sm::description("total number of dummy rows touched by reads in cache"), _stats.dummy_row_hits),
         sm::make_counter("row_misses", sm::description("total number of rows needed by reads and missing in cache"), _stats.row_misses)(basic_level),
@@ -167,6 +181,10 @@ cache_tracker::setup_metrics() {
         sm::make_counter("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
         sm::make_gauge("partitions", sm::description("total number of cached partitions"), _stats.partitions),
         sm::make_gauge("rows", sm::description("total number of cached rows"), _stats.rows),
+        sm::make_gauge("lru_probation_entries", sm::description("number of cache entries in the probationary segment of the LRU, touched once"),
+                [this] { return _lru.probation_size(); }),
+        sm::make_gauge("lru_protected_entries", sm::description("number of cache entries in the protected segment of the LRU, touched more than once"),
+                [this] { return _lru.protected_size(); }),
         sm::make_counter("reads", sm::description("number of started reads"), _stats.reads)(basic_level),
         sm::make_counter("reads_with_misses", sm::description("number of reads which had to read from sstables"), _stats.reads_with_misses)(basic_level),
         sm::make_gauge("active_reads", sm::description("number of currently active reads"), [this] { return _stats.active_reads(); }),
@@ -188,9 +206,25 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of attempts to compact expired rows during read")),
         sm::make_counter("rows_compacted_away", _stats.rows_compacted_away,
             sm::description("total amount of compacted and removed rows during read")),
+        sm::make_counter("partition_compressions", _stats.partition_compressions,
+            sm::description("total number of cold partitions replaced by their compressed form")),
+        sm::make_counter("partition_decompressions", _stats.partition_decompressions,
+            sm::description("total number of compressed partitions decompressed back by reads")),
+        sm::make_counter("compressed_partition_evictions", _stats.compressed_partition_evictions,
+            sm::description("total number of evicted compressed partitions")),
+        sm::make_counter("compressed_partition_removals", _stats.compressed_partition_removals,
+            sm::description("total number of invalidated compressed partitions")),
+        sm::make_gauge("compressed_partitions", sm::description("total number of cold partitions held in compressed form"), _stats.compressed_partitions),
+        sm::make_gauge("compressed_partition_bytes", sm::description("total size of the compressed partitions"), _stats.compressed_partition_bytes),
+        sm::make_gauge("compressed_partition_ratio", sm::description("ratio of the size of the compressed partitions to their uncompressed (frozen) size"),
+                [this] { return _stats.compressed_partition_uncompressed_bytes ? double(_stats.compressed_partition_bytes) / _stats.compressed_partition_uncompressed_bytes : 0.0; }),
+        sm::make_histogram("partition_decompression_latency", sm::description("latency of decompressing a compressed partition back into the cache"),
+                [this] { return to_metrics_histogram(_partition_decompression_latency); }).set_skip_when_empty(),
     });
     sstables::register_index_page_cache_metrics(_metrics, _index_cached_file_stats);
     sstables::register_index_page_metrics(_metrics, _partition_index_cache_stats);
+    sstables::register_decompressed_chunk_cache_metrics(_metrics, _decompressed_chunk_cache_stats);
+    sstables::register_promoted_index_block_cache_metrics(_metrics, _promoted_index_block_cache_stats);
 }
 
 void cache_tracker::clear() {
@@ -234,6 +268,43 @@ void cache_tracker::on_partition_erase() noexcept {
     allocator().invalidate_references();
 }
 
+void cache_tracker::on_partition_compression() noexcept {
+    --_stats.partitions;
+    ++_stats.partition_compressions;
+    allocator().invalidate_references();
+}
+
+void cache_tracker::on_partition_decompression(std::chrono::steady_clock::duration latency) noexcept {
+    ++_stats.partition_decompressions;
+    _partition_decompression_latency.add(latency);
+}
+
+void cache_tracker::insert(compressed_cache_entry& e) noexcept {
+    ++_stats.compressed_partitions;
+    _stats.compressed_partition_bytes += e.compressed_size();
+    _stats.compressed_partition_uncompressed_bytes += e.uncompressed_size();
+    _lru.add(e);
+}
+
+static void forget_compressed(cache_tracker::stats& stats, compressed_cache_entry& e) noexcept {
+    --stats.compressed_partitions;
+    stats.compressed_partition_bytes -= e.compressed_size();
+    stats.compressed_partition_uncompressed_bytes -= e.uncompressed_size();
+}
+
+void cache_tracker::remove(compressed_cache_entry& e) noexcept {
+    forget_compressed(_stats, e);
+    ++_stats.compressed_partition_removals;
+    if (e.is_linked()) {
+        _lru.remove(e);
+    }
+}
+
+void cache_tracker::on_compressed_partition_eviction(compressed_cache_entry& e) noexcept {
+    forget_compressed(_stats, e);
+    ++_stats.compressed_partition_evictions;
+}
+
 void cache_tracker::on_partition_merge() noexcept {
     ++_stats.partition_merges;
 }
@@ -423,8 +494,11 @@ class single_partition_populating_reader final : public mutation_reader::impl {
         _read_context->enter_partition(_read_context->range().start()->value().as_decorated_key(), src_and_phase.snapshot, phase);
         return _read_context->create_underlying().then([this, phase] {
           return _read_context->underlying().underlying()().then([this, phase] (auto&& mfopt) {
+            bool admitted = _cache.admit(_read_context->key());
             if (!mfopt) {
-                if (phase == _cache.phase_of(_read_context->range().start()->value())) {
+                if (!admitted) {
+                    // Absence of the partition is not cached either.
+                } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                     _cache._read_section(_cache._tracker.region(), [this] {
                         _cache.find_or_create_missing(_read_context->key());
                     });
@@ -432,6 +506,8 @@ class single_partition_populating_reader final : public mutation_reader::impl {
                     _cache._tracker.on_mispopulate();
                 }
                 _end_of_stream = true;
+            } else if (!admitted) {
+                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
             } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
                     cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
@@ -512,6 +588,40 @@ void row_cache::on_mispopulate() {
     _tracker.on_mispopulate();
 }
 
+// Enough to tell apart the hot partitions of a table from the ones touched
+// once by scans, at 4 bits per counter it costs 32KiB per table and shard.
+static constexpr size_t admission_sketch_items = 16 * 1024;
+
+void row_cache::record_access(const dht::decorated_key& dk) noexcept {
+    if (_admission_sketch && _schema->caching_options().frequency_admission()) {
+        _admission_sketch->increment(dk.token().raw());
+    }
+}
+
+bool row_cache::admit(const dht::decorated_key& dk) noexcept {
+    if (!_schema->caching_options().frequency_admission()) {
+        return true;
+    }
+    if (!_admission_sketch) {
+        try {
+            _admission_sketch = std::make_unique<utils::frequency_sketch>(admission_sketch_items);
+        } catch (...) {
+            return true;
+        }
+    }
+    auto hash = uint64_t(dk.token().raw());
+    _admission_sketch->increment(hash);
+    // Populate only partitions which were already accessed recently. Partitions
+    // which are read once, e.g. by a full scan, are served from the underlying
+    // source without displacing the working set.
+    if (_admission_sketch->estimate(hash) > 1) {
+        _tracker.on_partition_admission();
+        return true;
+    }
+    _tracker.on_partition_admission_rejection();
+    return false;
+}
+
 void row_cache::on_row_miss() {
     _stats.misses.mark();
     _tracker.on_row_miss();
@@ -576,7 +686,12 @@ class range_populating_reader {
                 _cache.on_partition_miss();
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
-                if (_reader.creation_phase() == _cache.phase_of(key)) {
+                if (!_cache.admit(key)) {
+                    // The partition is not inserted, so the next one populated
+                    // must not be marked as continuous with the previous one.
+                    _last_key = {};
+                    return make_ready_future<mutation_reader_opt>(read_directly_from_underlying(_read_context, std::move(*mfopt)));
+                } else if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
                                                                this->can_set_continuity() ? &*_last_key : nullptr);
@@ -625,6 +740,7 @@ class scanning_and_populating_reader final : public mutation_reader::impl {
     mutation_reader read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
         _cache.on_partition_hit();
+        _cache.record_access(ce.key());
         return ce.read(_cache, *_read_context);
     }
 
@@ -788,6 +904,9 @@ row_cache::make_reader_opt(schema_ptr s,
     if (query::is_single_partition(range) && !fwd_mr) {
         tracing::trace(trace_state, "Querying cache for range {} and slice {}",
                 range, seastar::value_of([&slice] { return slice.get_all_ranges(); }));
+        if (!_compressed_partitions.empty()) {
+            decompress_partition(range.start()->value().as_decorated_key());
+        }
         auto mr = _read_section(_tracker.region(), [&] () -> mutation_reader_opt {
             dht::ring_position_comparator cmp(*_schema);
             auto&& pos = range.start()->value();
@@ -797,6 +916,7 @@ row_cache::make_reader_opt(schema_ptr s,
                 cache_entry& e = *i;
                 upgrade_entry(e);
                 on_partition_hit();
+                record_access(e.key());
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return {};
@@ -865,6 +985,9 @@ mutation_reader row_cache::make_nonpopulating_reader(schema_ptr schema, reader_p
 
 void row_cache::clear_on_destruction() noexcept {
     with_allocator(_tracker.allocator(), [this] {
+        _compressed_partitions.clear_and_dispose([this] (compressed_cache_entry* e) noexcept {
+            _tracker.remove(*e);
+        });
         _partitions.clear_and_dispose([this] (cache_entry* p) mutable noexcept {
             if (!p->is_dummy_entry()) {
                 _tracker.on_partition_erase();
@@ -880,6 +1003,9 @@ row_cache::~row_cache() {
 
 void row_cache::clear_now() noexcept {
     with_allocator(_tracker.allocator(), [this] {
+        _compressed_partitions.clear_and_dispose([this] (compressed_cache_entry* e) noexcept {
+            _tracker.remove(*e);
+        });
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
             _tracker.on_partition_erase();
             p->evict(_tracker);
@@ -925,6 +1051,7 @@ cache_entry& row_cache::do_find_or_create_entry(const dht::decorated_key& key,
 cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous) {
     return do_find_or_create_entry(ps.key(), previous, [&] (auto i, const partitions_type::bound_hint& hint) { // create
         // Create an fully discontinuous, except for the partition tombstone, entry
+        drop_compressed(ps.key());
         mutation_partition mp = mutation_partition::make_incomplete(*_schema, ps.partition_tombstone());
         partitions_type::iterator entry = _partitions.emplace_before(i, ps.key().token().raw(), hint,
                 _schema, ps.key(), std::move(mp));
@@ -940,6 +1067,7 @@ cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row
 
 cache_entry& row_cache::find_or_create_missing(const dht::decorated_key& key) {
     return do_find_or_create_entry(key, nullptr, [&] (auto i, const partitions_type::bound_hint& hint) {
+        drop_compressed(key);
         mutation_partition mp(*_schema);
         bool cont = i->continuous();
         partitions_type::iterator entry = _partitions.emplace_before(i, key.token().raw(), hint,
@@ -952,9 +1080,15 @@ cache_entry& row_cache::find_or_create_missing(const dht::decorated_key& key) {
     });
 }
 
+cell_value_pool* row_cache::value_pool() const noexcept {
+    return _schema->caching_options().intern_values() ? _value_pool : nullptr;
+}
+
 void row_cache::populate(const mutation& m, const previous_entry_pointer* previous) {
+  cell_value_pool::scope interning(value_pool());
   _populate_section(_tracker.region(), [&] {
     do_find_or_create_entry(m.decorated_key(), previous, [&] (auto i, const partitions_type::bound_hint& hint) {
+        drop_compressed(m.decorated_key());
         partitions_type::iterator entry = _partitions.emplace_before(i, m.decorated_key().token().raw(), hint,
                 m.schema(), m.decorated_key(), m.partition());
         _tracker.insert(*entry);
@@ -1067,6 +1201,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                                 _update_section(_tracker.region(), [&] {
                                     replica::memtable_entry& mem_e = *m.partitions.begin();
                                     size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
+                                    drop_compressed(mem_e.key());
                                     partitions_type::bound_hint hint;
                                     auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
                                     update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint, preempt_src);
@@ -1180,6 +1315,203 @@ void row_cache::touch(const dht::decorated_key& dk) {
  });
 }
 
+void cache_tracker::for_each_recently_used_partition(size_t max_rows, noncopyable_function<stop_iteration(const cache_entry&)> func) {
+    // The entries must stay put while the LRU is walked.
+    logalloc::reclaim_lock _(region());
+    std::unordered_set<const cache_entry*> visited;
+    _lru.for_each_most_recently_used([&] (evictable& e) {
+        if (!max_rows--) {
+            return stop_iteration::yes;
+        }
+        auto* row = dynamic_cast<rows_entry*>(&e);
+        if (!row) {
+            return stop_iteration::no;
+        }
+        auto& rows = *mutation_partition_v2::rows_type::iterator(row).owning_tree();
+        partition_version& pv = partition_version::container_of(mutation_partition_v2::container_of(rows));
+        // The rows of older versions are read through the newest one.
+        if (!pv.is_referenced_from_entry()) {
+            return stop_iteration::no;
+        }
+        auto& ce = cache_entry::container_of(partition_entry::container_of(pv));
+        if (!visited.insert(&ce).second) {
+            return stop_iteration::no;
+        }
+        return func(ce);
+    });
+}
+
+// Partitions are compressed one at a time, without preemption, so larger ones
+// are left alone. Small partitions don't shrink enough to pay off.
+static constexpr size_t min_compressed_partition_size = 256;
+static constexpr size_t max_compressed_partition_size = 1 << 20;
+
+// Compression and decompression don't need any per-partition state.
+static const compressor& cold_partition_compressor() {
+    static thread_local compressor_ptr lz4 = make_compressor_without_dicts(compression_parameters(compressor::algorithm::lz4));
+    return *lz4;
+}
+
+void row_cache::erase_compressed(compressed_partitions_type::iterator it) noexcept {
+    it.erase_and_dispose(dht::raw_token_less_comparator{}, [this] (compressed_cache_entry* e) noexcept {
+        _tracker.remove(*e);
+    });
+}
+
+void row_cache::drop_compressed(const dht::decorated_key& dk) noexcept {
+    if (_compressed_partitions.empty()) {
+        return;
+    }
+    auto it = _compressed_partitions.find(dk, dht::ring_position_comparator(*_schema));
+    if (it != _compressed_partitions.end()) {
+        erase_compressed(it);
+    }
+}
+
+void row_cache::drop_compressed(const dht::partition_range& range) noexcept {
+    if (_compressed_partitions.empty()) {
+        return;
+    }
+    auto cmp = dht::ring_position_comparator(*_schema);
+    auto it = _compressed_partitions.lower_bound(dht::ring_position_view::for_range_start(range), cmp);
+    auto end = _compressed_partitions.lower_bound(dht::ring_position_view::for_range_end(range), cmp);
+    _compressed_partitions.erase_and_dispose(it, end, [this] (compressed_cache_entry* e) noexcept {
+        _tracker.remove(*e);
+    });
+}
+
+void row_cache::compress_partition(mutation&& m) {
+    auto fm = freeze(m);
+    bytes_view raw = fm.representation().linearize();
+    std::optional<bytes> compressed;
+    if (raw.size() >= min_compressed_partition_size && raw.size() <= max_compressed_partition_size) {
+        auto& c = cold_partition_compressor();
+        compressed.emplace(bytes::initialized_later(), c.compress_max_size(raw.size()));
+        auto len = c.compress(reinterpret_cast<const char*>(raw.data()), raw.size(), reinterpret_cast<char*>(compressed->data()), compressed->size());
+        // Not worth the decompression on the next read otherwise.
+        if (len > raw.size() * 3 / 4) {
+            compressed.reset();
+        } else {
+            compressed->resize(len);
+        }
+    }
+
+    _populate_section(_tracker.region(), [&] {
+        with_allocator(_tracker.allocator(), [&] {
+            dht::ring_position_comparator cmp(*_schema);
+            auto i = _partitions.find(m.decorated_key(), cmp);
+            // The entry could have been evicted from while allocating.
+            if (i == _partitions.end() || !i->can_compress()) {
+                return;
+            }
+            if (!compressed) {
+                i->set_incompressible();
+                return;
+            }
+            compressed_partitions_type::bound_hint hint;
+            auto ci = _compressed_partitions.lower_bound(m.decorated_key(), cmp, hint);
+            SCYLLA_ASSERT(!hint.match);
+            ci = _compressed_partitions.emplace_before(ci, m.decorated_key().token().raw(), hint,
+                    m.schema(), m.decorated_key(), managed_bytes(bytes_view(*compressed)), uint32_t(raw.size()));
+            _tracker.insert(*ci);
+            // Like eviction, this makes the range between the neighbours of
+            // the entry discontinuous.
+            auto next = i.erase_and_dispose(dht::raw_token_less_comparator{}, [this] (cache_entry* p) noexcept {
+                p->evict(_tracker);
+            });
+            _tracker.on_partition_compression();
+            _tracker.clear_continuity(*next);
+        });
+    });
+}
+
+void row_cache::decompress_partition(const dht::decorated_key& dk) {
+    struct compressed_partition {
+        schema_ptr schema;
+        bytes data;
+        uint32_t uncompressed_size;
+    };
+    auto cp = _read_section(_tracker.region(), [&] () -> std::optional<compressed_partition> {
+        auto it = _compressed_partitions.find(dk, dht::ring_position_comparator(*_schema));
+        if (it == _compressed_partitions.end()) {
+            return std::nullopt;
+        }
+        return compressed_partition{it->schema(), to_bytes(managed_bytes_view(it->data())), it->uncompressed_size()};
+    });
+    if (!cp) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bytes raw(bytes::initialized_later(), cp->uncompressed_size);
+    auto len = cold_partition_compressor().uncompress(reinterpret_cast<const char*>(cp->data.data()), cp->data.size(),
+            reinterpret_cast<char*>(raw.data()), raw.size());
+    if (len != raw.size()) {
+        on_internal_error(clogger, format("Compressed cache partition {} decompressed to {} bytes, expected {}", dk, len, raw.size()));
+    }
+    bytes_ostream out;
+    out.write(raw);
+    auto m = frozen_mutation(std::move(out)).unfreeze(cp->schema);
+    if (m.schema() != _schema) {
+        m.upgrade(_schema);
+    }
+
+    cell_value_pool::scope interning(value_pool());
+    _populate_section(_tracker.region(), [&] {
+        with_allocator(_tracker.allocator(), [&] {
+            dht::ring_position_comparator cmp(*_schema);
+            auto ci = _compressed_partitions.find(dk, cmp);
+            // Could have been evicted while allocating.
+            if (ci == _compressed_partitions.end()) {
+                return;
+            }
+            partitions_type::bound_hint hint;
+            auto i = _partitions.lower_bound(dk, cmp, hint);
+            if (!hint.match) {
+                auto entry = _partitions.emplace_before(i, dk.token().raw(), hint, _schema, dk, m.partition());
+                _tracker.insert(*entry);
+            }
+            erase_compressed(ci);
+        });
+    });
+    _tracker.on_partition_decompression(std::chrono::steady_clock::now() - start);
+}
+
+future<> row_cache::compress_cold_partitions() {
+    // Visited in batches, so that the scan over hot partitions doesn't have
+    // to leave the allocating section for every partition.
+    static constexpr unsigned batch_size = 32;
+    std::optional<dht::decorated_key> last;
+    while (true) {
+        std::optional<mutation> cold;
+        auto start = last;
+        auto done = _read_section(_tracker.region(), [&] {
+            last = start;
+            cold.reset();
+            dht::ring_position_comparator cmp(*_schema);
+            auto i = last ? _partitions.upper_bound(*last, cmp) : _partitions.begin();
+            for (unsigned visited = 0; i != partitions_end() && visited < batch_size; ++i, ++visited) {
+                cache_entry& e = *i;
+                last = e.key();
+                if (e.referenced()) {
+                    e.set_referenced(false);
+                } else if (e.can_compress()) {
+                    cold.emplace(e.schema(), e.key(), e.partition().squashed(*e.schema(), is_evictable::yes));
+                    return false;
+                }
+            }
+            return i == partitions_end();
+        });
+        if (cold) {
+            compress_partition(std::move(*cold));
+        }
+        if (done) {
+            co_return;
+        }
+        co_await coroutine::maybe_yield();
+    }
+}
+
 void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
     _read_section(_tracker.region(), [&] {
         auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
@@ -1197,6 +1529,7 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    drop_compressed(dk);
     auto pos = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1230,6 +1563,9 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
             for (auto&& range : ranges) {
                 _prev_snapshot_pos = dht::ring_position_view::for_range_start(range);
                 seastar::thread::maybe_yield();
+                with_allocator(_tracker.allocator(), [&] {
+                    drop_compressed(range);
+                });
 
                 while (true) {
                     auto done = _update_section(_tracker.region(), [&] {
@@ -1275,12 +1611,14 @@ void row_cache::evict() {
     while (_tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something) {}
 }
 
-row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker, is_continuous cont)
+row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker, is_continuous cont, cell_value_pool* value_pool)
     : _tracker(tracker)
     , _schema(std::move(s))
     , _partitions(dht::raw_token_less_comparator{})
+    , _compressed_partitions(dht::raw_token_less_comparator{})
     , _underlying(src())
     , _snapshot_source(std::move(src))
+    , _value_pool(value_pool)
 {
   try {
     with_allocator(_tracker.allocator(), [this, cont] {
@@ -1324,6 +1662,20 @@ void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
     it.erase(dht::raw_token_less_comparator{});
 }
 
+bool cache_entry::can_compress() noexcept {
+    return !is_dummy_entry()
+        && !_flags._incompressible
+        && !_pe._snapshot
+        && !_pe.version()->next()
+        && _pe.version()->partition().is_fully_continuous();
+}
+
+void compressed_cache_entry::on_evicted() noexcept {
+    current_tracker->on_compressed_partition_eviction(*this);
+    row_cache::compressed_partitions_type::iterator it(this);
+    it.erase(dht::raw_token_less_comparator{});
+}
+
 static
 mutation_partition_v2::rows_type::iterator on_evicted_shallow(rows_entry& e, cache_tracker& tracker) noexcept {
     mutation_partition_v2::rows_type::iterator it(&e);
@@ -1400,6 +1752,7 @@ mutation_reader cache_entry::read(row_cache& rc, std::unique_ptr<read_context> u
 
 // Assumes reader is in the corresponding partition
 mutation_reader cache_entry::do_read(row_cache& rc, read_context& reader) {
+    set_referenced(true);
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), &rc._tracker, reader.phase());
     auto ckr = query::clustering_key_filter_ranges::get_ranges(*schema(), reader.native_slice(), _key.key());
     schema_ptr entry_schema = to_query_domain(reader.slice(), schema());
@@ -1410,6 +1763,7 @@ mutation_reader cache_entry::do_read(row_cache& rc, read_context& reader) {
 }
 
 mutation_reader cache_entry::do_read(row_cache& rc, std::unique_ptr<read_context> unique_ctx) {
+    set_referenced(true);
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), &rc._tracker, unique_ctx->phase());
     auto ckr = query::clustering_key_filter_ranges::get_ranges(*schema(), unique_ctx->native_slice(), _key.key());
     schema_ptr reader_schema = unique_ctx->schema();
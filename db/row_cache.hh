@@ -17,6 +17,7 @@
 #include "utils/histogram.hh"
 #include "mutation/partition_version.hh"
 #include "utils/double-decker.hh"
+#include "utils/frequency_sketch.hh"
 #include "db/cache_tracker.hh"
 #include "readers/empty.hh"
 #include "readers/mutation_source.hh"
@@ -54,6 +55,10 @@ class cache_entry {
         bool _head : 1;
         bool _tail : 1;
         bool _train : 1;
+        // Set when the entry is read, cleared by row_cache::compress_cold_partitions().
+        bool _referenced : 1;
+        // Set when compressing the entry didn't pay off.
+        bool _incompressible : 1;
     } _flags{};
     friend class size_calculator;
 
@@ -82,7 +87,9 @@ class cache_entry {
     cache_entry(schema_ptr s, const dht::decorated_key& key, const mutation_partition& p)
         : _key(key)
         , _pe(partition_entry::make_evictable(*s, mutation_partition(*s, p)))
-    { }
+    {
+        _flags._referenced = true;
+    }
 
     cache_entry(schema_ptr s, dht::decorated_key&& key, mutation_partition&& p)
         : cache_entry(evictable_tag(), s, std::move(key),
@@ -94,7 +101,9 @@ class cache_entry {
     cache_entry(evictable_tag, schema_ptr s, dht::decorated_key&& key, partition_entry&& pe) noexcept
         : _key(std::move(key))
         , _pe(std::move(pe))
-    { }
+    {
+        _flags._referenced = true;
+    }
 
     cache_entry(cache_entry&&) noexcept;
     ~cache_entry();
@@ -131,6 +140,58 @@ class cache_entry {
     void set_continuous(bool value) noexcept { _flags._continuous = value; }
 
     bool is_dummy_entry() const noexcept { return _flags._dummy_entry; }
+
+    bool referenced() const noexcept { return _flags._referenced; }
+    void set_referenced(bool v) noexcept { _flags._referenced = v; }
+    void set_incompressible() noexcept { _flags._incompressible = true; }
+    // Tells whether the entry holds the whole partition in a single version
+    // not used by any reader, so that it can be replaced by a compressed_cache_entry.
+    bool can_compress() noexcept;
+};
+
+// A cold partition taken out of the partition tree of the cache, held as a
+// compressed frozen_mutation, see row_cache::compress_cold_partitions().
+// A single-partition read of the key turns it back into a cache_entry.
+//
+// Holds the whole partition, only fully continuous entries are compressed.
+// Linked in the cache LRU, so it's evicted as a whole with the rest of the
+// cache contents.
+class compressed_cache_entry final : public evictable {
+    dht::decorated_key _key;
+    // The schema the partition was frozen with.
+    schema_ptr _schema;
+    managed_bytes _data;
+    uint32_t _uncompressed_size;
+    struct {
+        bool _head : 1;
+        bool _tail : 1;
+        bool _train : 1;
+    } _flags{};
+public:
+    compressed_cache_entry(schema_ptr s, const dht::decorated_key& key, managed_bytes data, uint32_t uncompressed_size)
+        : _key(key)
+        , _schema(std::move(s))
+        , _data(std::move(data))
+        , _uncompressed_size(uncompressed_size)
+    { }
+    compressed_cache_entry(compressed_cache_entry&&) noexcept = default;
+
+    bool is_head() const noexcept { return _flags._head; }
+    void set_head(bool v) noexcept { _flags._head = v; }
+    bool is_tail() const noexcept { return _flags._tail; }
+    void set_tail(bool v) noexcept { _flags._tail = v; }
+    bool with_train() const noexcept { return _flags._train; }
+    void set_train(bool v) noexcept { _flags._train = v; }
+
+    const dht::decorated_key& key() const noexcept { return _key; }
+    const schema_ptr& schema() const noexcept { return _schema; }
+    const managed_bytes& data() const noexcept { return _data; }
+    uint32_t uncompressed_size() const noexcept { return _uncompressed_size; }
+    size_t compressed_size() const noexcept { return _data.size(); }
+
+    friend dht::ring_position_view ring_position_view_to_compare(const compressed_cache_entry& e) noexcept { return e._key; }
+
+    void on_evicted() noexcept override;
 };
 
 //
@@ -151,6 +212,9 @@ class row_cache final {
     using partitions_type = double_decker<int64_t, cache_entry,
                             dht::raw_token_less_comparator, dht::ring_position_comparator,
                             16, bplus::key_search::linear>;
+    using compressed_partitions_type = double_decker<int64_t, compressed_cache_entry,
+                            dht::raw_token_less_comparator, dht::ring_position_comparator,
+                            16, bplus::key_search::linear>;
     static_assert(bplus::SimpleLessCompare<int64_t, dht::raw_token_less_comparator>);
     friend class cache::autoupdating_underlying_reader;
     friend class single_partition_populating_reader;
@@ -214,6 +278,10 @@ class row_cache final {
     stats _stats{};
     schema_ptr _schema;
     partitions_type _partitions; // Cached partitions are complete.
+    // Cold partitions taken out of _partitions, in compressed form. The same
+    // key is never present in both. Reflect the same snapshot as entries of
+    // _partitions would, so they are dropped by cache updates and invalidation.
+    compressed_partitions_type _compressed_partitions;
 
     // The snapshots used by cache are versioned. The version number of a snapshot is
     // called the "population phase", or simply "phase". Between updates, cache
@@ -256,6 +324,13 @@ class row_cache final {
     logalloc::allocating_section _update_section;
     logalloc::allocating_section _populate_section;
     logalloc::allocating_section _read_section;
+
+    // Access frequencies of partitions, for the admission policy enabled by
+    // caching_options::frequency_admission(). Allocated on first use.
+    std::unique_ptr<utils::frequency_sketch> _admission_sketch;
+    // Pool of the table in which the values of cells populated into the
+    // cache are interned, see caching_options::intern_values().
+    cell_value_pool* _value_pool;
     mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
     mutation_reader make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
     void on_partition_hit();
@@ -264,8 +339,22 @@ class row_cache final {
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    // Records a hit on given partition for the admission policy.
+    void record_access(const dht::decorated_key&) noexcept;
+    // Decides whether a partition missing in cache should be populated.
+    bool admit(const dht::decorated_key&) noexcept;
     void upgrade_entry(cache_entry&);
+    cell_value_pool* value_pool() const noexcept;
     void invalidate_locked(const dht::decorated_key&);
+    // Must be run in the context of cache's allocator.
+    void drop_compressed(const dht::decorated_key&) noexcept;
+    void drop_compressed(const dht::partition_range&) noexcept;
+    void erase_compressed(compressed_partitions_type::iterator) noexcept;
+    // Replaces the cache entry of the partition with a compressed_cache_entry,
+    // the mutation holds the contents of the entry.
+    void compress_partition(mutation&&);
+    // Replaces the compressed_cache_entry of the key, if any, with a cache entry.
+    void decompress_partition(const dht::decorated_key&);
     void clear_now() noexcept;
     void clear_on_destruction() noexcept;
 
@@ -355,7 +444,7 @@ class row_cache final {
 
 public:
     ~row_cache();
-    row_cache(schema_ptr, snapshot_source, cache_tracker&, is_continuous = is_continuous::no);
+    row_cache(schema_ptr, snapshot_source, cache_tracker&, is_continuous = is_continuous::no, cell_value_pool* = nullptr);
     row_cache(row_cache&&) = default;
     row_cache(const row_cache&) = delete;
 public:
@@ -440,6 +529,16 @@ class row_cache final {
     // that they are not evicted by memory reclaimer.
     void unlink_from_lru(const dht::decorated_key&);
 
+    // Compresses the partitions which weren't read since the previous call,
+    // replacing their entries with compressed_cache_entry. Cold partitions
+    // hold 2-3 times less memory that way, and are decompressed back on the
+    // next single-partition read, which is much cheaper than a cache miss.
+    // Scans don't decompress, they read the partition from the underlying
+    // source instead, which drops the compressed copy.
+    //
+    // Scans the whole cache, yielding between partitions.
+    future<> compress_cold_partitions();
+
     // Synchronizes cache with the underlying mutation source
     // by invalidating ranges which were modified. This will force
     // them to be re-read from the underlying mutation source
@@ -506,6 +605,7 @@ class lsa_manager {
 
     template<typename Func>
     void run_in_update_section_with_allocator(Func &&func) {
+        cell_value_pool::scope interning(_cache.value_pool());
         return _cache._update_section(_cache._tracker.region(), [this, &func]() {
             return with_allocator(_cache._tracker.region().allocator(), [&func]() mutable {
                 return func();
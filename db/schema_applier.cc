@@ -845,10 +845,12 @@ future<> schema_applier::prepare(utils::chunked_vector<mutation>& muts) {
 
         replica::update_tablet_metadata_change_hint(_tablet_hint, mutation);
 
+        invalidate_schema_digest(keyspace_name, mutation);
         _keyspaces.emplace(std::move(keyspace_name));
     }
 
     if (_reload) {
+        invalidate_schema_digest();
         for (auto&& ks : _proxy.local().get_db().local().get_non_system_keyspaces()) {
             _keyspaces.emplace(ks);
             table_selector sel;
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <ranges>
 #include <seastar/coroutine/all.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "utils/log.hh"
 #include "frozen_schema.hh"
 #include "schema/schema_registry.hh"
@@ -47,6 +48,7 @@
 #include "db/config.hh"
 #include "db/extensions.hh"
 #include "utils/hashers.hh"
+#include "hashing_partition_visitor.hh"
 
 #include <fmt/ranges.h>
 
@@ -746,9 +748,360 @@ future<table_schema_version> calculate_schema_digest(distributed<service::storag
     }
 }
 
+namespace {
+
+// Hashers which capture the input of the schema digest: the first one only
+// counts its size, so that the second one can write it without allocating.
+class digest_input_size_counter : public hasher {
+public:
+    size_t size = 0;
+    void update(const char*, size_t length) noexcept override {
+        size += length;
+    }
+};
+
+class digest_input_writer : public hasher {
+    managed_bytes_mutable_view _out;
+public:
+    explicit digest_input_writer(managed_bytes& out) : _out(out) {}
+    void update(const char* ptr, size_t length) noexcept override {
+        write_fragmented(_out, single_fragmented_view(bytes_view(reinterpret_cast<const bytes_view::value_type*>(ptr), length)));
+    }
+};
+
+// The input of the schema digest of a partition of a schema table, that is of
+// a keyspace, split by the first clustering key component of the rows, which
+// for most schema tables is the name of the table, type or function the row
+// describes.
+struct partition_digest_input {
+    struct group_less {
+        data_type type;
+        bool operator()(const bytes& a, const bytes& b) const {
+            return type->compare(a, b) < 0;
+        }
+    };
+
+    // The key, the partition tombstone and the static row.
+    managed_bytes head;
+    bool has_static_row = false;
+    std::map<bytes, managed_bytes, group_less> groups;
+
+    explicit partition_digest_input(const schema& s)
+        : groups(group_less{s.clustering_key_size() ? s.clustering_column_at(0).type : bytes_type})
+    { }
+};
+
+// Captures the digest input of a compacted partition into a partition_digest_input.
+// The partition is visited twice: first to measure the head and the groups, then
+// to write them.
+class digest_input_splitter final : public mutation_partition_visitor {
+    struct section {
+        bytes group;
+        size_t size = 0;
+        managed_bytes input;
+    };
+
+    const schema& _s;
+    // The head, followed by the groups in visiting order.
+    std::vector<section> _sections;
+    size_t _current = 0;
+    bool _writing = false;
+    std::optional<digest_input_writer> _writer;
+    bool _has_static_row = false;
+private:
+    template <typename Func>
+    void feed(Func&& func) {
+        if (_writing) {
+            func(static_cast<hasher&>(*_writer));
+        } else {
+            digest_input_size_counter counter;
+            func(static_cast<hasher&>(counter));
+            _sections[_current].size += counter.size;
+        }
+    }
+
+    void enter(size_t i) {
+        _current = i;
+        if (_writing) {
+            _writer.emplace(_sections[i].input);
+        }
+    }
+public:
+    digest_input_splitter(const schema& s, const partition_key& key) : _s(s) {
+        _sections.emplace_back();
+        feed([&] (hasher& h) { feed_hash(h, key, _s); });
+    }
+
+    void start_writing(const partition_key& key) {
+        for (auto& sec : _sections) {
+            sec.input = managed_bytes(managed_bytes::initialized_later(), sec.size);
+        }
+        _writing = true;
+        enter(0);
+        feed([&] (hasher& h) { feed_hash(h, key, _s); });
+    }
+
+    partition_digest_input finish() && {
+        partition_digest_input res(_s);
+        res.head = std::move(_sections[0].input);
+        res.has_static_row = _has_static_row;
+        for (size_t i = 1; i < _sections.size(); ++i) {
+            res.groups.emplace(std::move(_sections[i].group), std::move(_sections[i].input));
+        }
+        return res;
+    }
+
+    virtual void accept_partition_tombstone(tombstone t) override {
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_partition_tombstone(t); });
+    }
+
+    virtual void accept_static_cell(column_id id, atomic_cell_view cell) override {
+        _has_static_row = true;
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_static_cell(id, cell); });
+    }
+
+    virtual void accept_static_cell(column_id id, collection_mutation_view cell) override {
+        _has_static_row = true;
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_static_cell(id, cell); });
+    }
+
+    virtual void accept_row_tombstone(const range_tombstone& rt) override {
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_row_tombstone(rt); });
+    }
+
+    virtual void accept_row(position_in_partition_view pos, const row_tombstone& deleted_at, const row_marker& rm, is_dummy dummy, is_continuous continuous) override {
+        auto group = _s.clustering_key_size() ? to_bytes(pos.key().get_component(_s, 0)) : bytes();
+        if (_current == 0 || _sections[_current].group != group) {
+            if (!_writing) {
+                _sections.push_back(section{std::move(group)});
+            }
+            enter(_current + 1);
+        }
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_row(pos, deleted_at, rm, dummy, continuous); });
+    }
+
+    virtual void accept_row_cell(column_id id, atomic_cell_view cell) override {
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_row_cell(id, cell); });
+    }
+
+    virtual void accept_row_cell(column_id id, collection_mutation_view cell) override {
+        feed([&] (hasher& h) { hashing_partition_visitor<hasher>(h, _s).accept_row_cell(id, cell); });
+    }
+};
+
+static partition_digest_input make_partition_digest_input(const mutation& m) {
+    auto compacted = compact_for_schema_digest(m);
+    const schema& s = *compacted.schema();
+    digest_input_splitter splitter(s, compacted.key());
+    compacted.partition().accept(s, splitter);
+    splitter.start_writing(compacted.key());
+    compacted.partition().accept(s, splitter);
+    return std::move(splitter).finish();
+}
+
+// Remembers what each partition of the schema tables contributes to the
+// digest of the non-system keyspaces, so that after a schema change only the
+// parts it wrote have to be read and hashed again.
+//
+// The digest is the MD5 of the contributions of all partitions of all schema
+// tables in a fixed order, so it has to be computed over all the cached
+// contributions, which is cheap compared to reading and compacting the schema.
+// Writes to a partition which only touch rows of some tables (or types,
+// functions) of the keyspace mark only the rows of those as stale.
+//
+// The schema tables are written by merge_schema(), which invalidates what it
+// writes, under the merge lock, like the digest is computed. Lives on shard 0.
+class schema_digest_cache {
+    using partitions = std::map<dht::decorated_key, partition_digest_input, dht::decorated_key::less_comparator>;
+
+    struct stale_partition {
+        bool whole = false;
+        std::set<bytes> groups;
+    };
+
+    std::optional<schema_features> _features;
+    std::unordered_map<table_id, partitions> _tables;
+    std::unordered_map<table_id, std::unordered_map<sstring, stale_partition>> _stale;
+private:
+    future<std::optional<mutation>> read_partition(distributed<service::storage_proxy>& proxy, schema_ptr s, const dht::decorated_key& dk,
+            std::optional<bytes> group, schema_features features) {
+        auto slice = s->full_slice();
+        if (group) {
+            auto range = query::clustering_range(clustering_key_prefix::from_exploded(*s, {std::move(*group)}));
+            slice = partition_slice_builder(*s).with_range(std::move(range)).build();
+        }
+        auto cmd = make_lw_shared<query::read_command>(s->id(), s->version(), slice, proxy.local().get_max_result_size(slice), query::tombstone_limit::max);
+        auto res_hit_rate = co_await proxy.local().query_mutations_locally(s, std::move(cmd), dht::partition_range::make_singular(dk),
+                db::no_timeout, tracing::trace_state_ptr{});
+        auto&& [res, hit_rate] = res_hit_rate;
+        if (res->partitions().empty()) {
+            co_return std::nullopt;
+        }
+        co_return redact_columns_for_missing_features(co_await unfreeze_gently(res->partitions()[0].mut(), s), features);
+    }
+
+    future<> populate(distributed<service::storage_proxy>& proxy, schema_features features) {
+        invalidate();
+        auto& db = proxy.local().get_db();
+        for (auto& table : all_table_infos(features)) {
+            auto s = db.local().find_schema(table.id);
+            auto& parts = _tables.emplace(table.id, partitions(dht::decorated_key::less_comparator(s))).first->second;
+            auto rs = co_await db::system_keyspace::query_mutations(db, s);
+            for (auto&& p : rs->partitions()) {
+                auto mut = co_await unfreeze_gently(p.mut(), s);
+                auto keyspace_name = value_cast<sstring>(utf8_type->deserialize(mut.key().get_component(*s, 0)));
+                if (is_system_keyspace(keyspace_name)) {
+                    continue;
+                }
+                mut = redact_columns_for_missing_features(std::move(mut), features);
+                auto dk = mut.decorated_key();
+                parts.emplace(std::move(dk), make_partition_digest_input(mut));
+                co_await coroutine::maybe_yield();
+            }
+        }
+        _features = features;
+    }
+
+    future<> refresh(distributed<service::storage_proxy>& proxy, schema_features features) {
+        auto stale = std::exchange(_stale, {});
+        auto& db = proxy.local().get_db();
+        for (auto& [id, stale_partitions] : stale) {
+            auto it = _tables.find(id);
+            if (it == _tables.end()) {
+                // Not a table the digest is computed over.
+                continue;
+            }
+            auto& parts = it->second;
+            auto s = db.local().find_schema(id);
+            for (auto& [keyspace_name, sp] : stale_partitions) {
+                if (is_system_keyspace(keyspace_name)) {
+                    continue;
+                }
+                auto dk = dht::decorate_key(*s, partition_key::from_singular(*s, keyspace_name));
+                auto pit = parts.find(dk);
+                if (sp.whole || pit == parts.end()) {
+                    auto mut = co_await read_partition(proxy, s, dk, std::nullopt, features);
+                    if (mut) {
+                        parts.insert_or_assign(std::move(dk), make_partition_digest_input(*mut));
+                    } else {
+                        parts.erase(dk);
+                    }
+                    continue;
+                }
+                for (auto& group : sp.groups) {
+                    auto mut = co_await read_partition(proxy, s, dk, group, features);
+                    auto input = mut ? make_partition_digest_input(*mut) : partition_digest_input(*s);
+                    // Refresh the iterator, the map could have been modified during the read.
+                    pit = parts.find(dk);
+                    if (pit == parts.end()) {
+                        break;
+                    }
+                    auto git = input.groups.find(group);
+                    if (git != input.groups.end()) {
+                        pit->second.groups.insert_or_assign(group, std::move(git->second));
+                    } else {
+                        pit->second.groups.erase(group);
+                    }
+                }
+            }
+        }
+    }
+public:
+    void invalidate() noexcept {
+        _features.reset();
+        _tables.clear();
+        _stale.clear();
+    }
+
+    void invalidate(const sstring& keyspace_name, const mutation& m) {
+        if (!_features) {
+            return;
+        }
+        auto& sp = _stale[m.column_family_id()][keyspace_name];
+        if (sp.whole) {
+            return;
+        }
+        const schema& s = *m.schema();
+        const auto& p = m.partition();
+        auto mark_whole = [&] {
+            sp.whole = true;
+            sp.groups.clear();
+        };
+        if (!s.clustering_key_size() || p.partition_tombstone() || !p.static_row().empty()) {
+            mark_whole();
+            return;
+        }
+        for (auto&& e : p.row_tombstones()) {
+            const range_tombstone& rt = e.tombstone();
+            if (rt.start.size(s) == 0 || rt.end.size(s) == 0) {
+                mark_whole();
+                return;
+            }
+            auto group = to_bytes(rt.start.get_component(s, 0));
+            if (group != to_bytes(rt.end.get_component(s, 0))) {
+                mark_whole();
+                return;
+            }
+            sp.groups.emplace(std::move(group));
+        }
+        for (auto&& row : p.clustered_rows()) {
+            sp.groups.emplace(to_bytes(row.key().get_component(s, 0)));
+        }
+    }
+
+    // Must be called under the merge lock.
+    future<table_schema_version> digest(distributed<service::storage_proxy>& proxy, schema_features features) {
+        try {
+            if (!_features || _features->mask() != features.mask()) {
+                co_await populate(proxy, features);
+            } else {
+                co_await refresh(proxy, features);
+            }
+        } catch (...) {
+            invalidate();
+            throw;
+        }
+        auto hash = md5_hasher();
+        auto feed = [&hash] (const managed_bytes& input) {
+            for (bytes_view frag : fragment_range(managed_bytes_view(input))) {
+                hash.update(reinterpret_cast<const char*>(frag.data()), frag.size());
+            }
+        };
+        for (auto& table : all_table_infos(features)) {
+            for (auto& [dk, input] : _tables.at(table.id)) {
+                if (features.contains<schema_feature::DIGEST_INSENSITIVE_TO_EXPIRY>() && !input.has_static_row && input.groups.empty()) {
+                    continue;
+                }
+                feed(input.head);
+                for (auto& [group, group_input] : input.groups) {
+                    feed(group_input);
+                }
+                co_await coroutine::maybe_yield();
+            }
+        }
+        co_return utils::UUID_gen::get_name_UUID(hash.finalize());
+    }
+};
+
+thread_local schema_digest_cache the_schema_digest_cache;
+
+}
+
 future<table_schema_version> calculate_schema_digest(distributed<service::storage_proxy>& proxy, schema_features features)
 {
-    return calculate_schema_digest(proxy, features, std::not_fn(&is_system_keyspace));
+    if (this_shard_id() != 0) {
+        return calculate_schema_digest(proxy, features, std::not_fn(&is_system_keyspace));
+    }
+    return the_schema_digest_cache.digest(proxy, features);
+}
+
+void invalidate_schema_digest(const sstring& keyspace_name, const mutation& m) {
+    SCYLLA_ASSERT(this_shard_id() == 0);
+    the_schema_digest_cache.invalidate(keyspace_name, m);
+}
+
+void invalidate_schema_digest() noexcept {
+    the_schema_digest_cache.invalidate();
 }
 
 static thread_local semaphore the_merge_lock {1};
@@ -809,6 +1162,9 @@ future<std::optional<table_schema_version>> get_group0_schema_version(db::system
 
 future<> recalculate_schema_version(sharded<db::system_keyspace>& sys_ks, distributed<service::storage_proxy>& proxy, gms::feature_service& feat) {
     co_await with_merge_lock([&] () -> future<> {
+        if (this_shard_id() == 0) {
+            invalidate_schema_digest();
+        }
         auto version_from_group0 = co_await get_group0_schema_version(sys_ks.local());
         co_await update_schema_version_and_announce(sys_ks, proxy, feat.cluster_schema_features(), version_from_group0);
     });
@@ -209,8 +209,15 @@ std::vector<table_info> all_table_infos(schema_features);
 future<> save_system_schema(cql3::query_processor& qp);
 
 future<table_schema_version> calculate_schema_digest(distributed<service::storage_proxy>& proxy, schema_features, noncopyable_function<bool(std::string_view)> accept_keyspace);
-// Calculates schema digest for all non-system keyspaces
+// Calculates schema digest for all non-system keyspaces.
+// On shard 0, only the partitions of the schema tables which were invalidated
+// since the previous call are read again.
 future<table_schema_version> calculate_schema_digest(distributed<service::storage_proxy>& proxy, schema_features);
+// Marks what the schema mutation writes as changed for calculate_schema_digest().
+// Must be called on shard 0 for each schema mutation applied.
+void invalidate_schema_digest(const sstring& keyspace_name, const mutation& m);
+// Forgets all the cached digest inputs.
+void invalidate_schema_digest() noexcept;
 
 // Must be called on shard 0.
 future<semaphore_units<>> hold_merge_lock() noexcept;
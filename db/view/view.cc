@@ -245,6 +245,10 @@ void stats::register_stats() {
                     {_cf_label, _ks_label}),
             ms::make_gauge("view_updates_pending", ms::description("Number of updates pushed to view and are still to be completed"),
                     {_cf_label, _ks_label}, writes),
+            ms::make_total_operations("view_update_rows", view_update_rows, ms::description("Number of view rows modified by generated view updates"),
+                    {_cf_label, _ks_label}),
+            ms::make_total_operations("view_update_mutations", view_update_mutations, ms::description("Number of generated view update mutations, each modifying the rows of a single view partition"),
+                    {_cf_label, _ks_label}),
     });
 }
 
@@ -1441,6 +1445,7 @@ future<std::optional<utils::chunked_vector<frozen_mutation_and_schema>>> view_up
 
     utils::chunked_vector<frozen_mutation_and_schema> mutations;
     for (auto& update : _view_updates) {
+        _base.view_stats().view_update_rows += update.op_count();
         co_await update.move_to(mutations);
     }
     co_return mutations;
@@ -2040,6 +2045,7 @@ future<> view_update_generator::mutate_MV(
         return it->second;
     };
     auto base_ermp = get_erm(base->id());
+    stats.view_update_mutations += view_updates.size();
     for (const auto& mut : view_updates) {
         (void)get_erm(mut.s->id());
     }
@@ -19,6 +19,12 @@ struct stats : public service::storage_proxy_stats::write_stats {
     int64_t view_updates_pushed_remote = 0;
     int64_t view_updates_failed_local = 0;
     int64_t view_updates_failed_remote = 0;
+    // View rows modified by the generated view updates, and the view update
+    // mutations carrying them. The rows of a single base mutation which fall
+    // in the same view partition are sent as a single mutation, so the ratio
+    // of the two is the batching factor of view updates.
+    int64_t view_update_rows = 0;
+    int64_t view_update_mutations = 0;
     using label_instance = seastar::metrics::label_instance;
     stats(const sstring& category, label_instance ks_label, label_instance cf_label);
     void register_stats();
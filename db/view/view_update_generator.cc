@@ -9,6 +9,7 @@
 #include "db/view/view_update_backlog.hh"
 #include <seastar/core/timed_out_error.hh>
 #include "gms/inet_address.hh"
+#include <seastar/core/loop.hh>
 #include <seastar/util/defer.hh>
 #include "replica/database.hh"
 #include "view_update_generator.hh"
@@ -187,8 +188,66 @@ future<> view_update_generator::start() {
     return make_ready_future<>();
 }
 
+// Splits the sstables into groups such that the token ranges of sstables
+// in different groups don't overlap.
+static std::vector<std::vector<sstables::shared_sstable>> group_overlapping_sstables(const schema& s, std::vector<sstables::shared_sstable> sstables) {
+    std::ranges::sort(sstables, [&s] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+        return a->get_first_decorated_key().tri_compare(s, b->get_first_decorated_key()) < 0;
+    });
+    std::vector<std::vector<sstables::shared_sstable>> groups;
+    const dht::decorated_key* group_last = nullptr;
+    for (auto& sst : sstables) {
+        if (!group_last || group_last->tri_compare(s, sst->get_first_decorated_key()) < 0) {
+            groups.emplace_back();
+            group_last = &sst->get_last_decorated_key();
+        } else if (group_last->tri_compare(s, sst->get_last_decorated_key()) < 0) {
+            group_last = &sst->get_last_decorated_key();
+        }
+        groups.back().push_back(sst);
+    }
+    return groups;
+}
+
 // Must be called in a seastar thread.
+//
+// View updates of a base row are generated against the base data outside
+// of staging, so two staging sstables which may contain the same partition
+// have to be read together, for the updates of one to take the other into
+// account. Groups of sstables with disjoint token ranges, however, are
+// independent, and are processed concurrently, up to
+// view_update_generator_concurrency groups at a time. This is the common
+// case with tablets, where each streamed sstable belongs to a single tablet.
+// The readers of all groups share the budget of the reader concurrency
+// semaphore.
 std::pair<stop_iteration, uint64_t> view_update_generator::generate_updates_from_staging_sstables(lw_shared_ptr<replica::table> table, std::vector<sstables::shared_sstable>& sstables) {
+    schema_ptr s = table->schema();
+    auto groups = group_overlapping_sstables(*s, sstables);
+    if (groups.size() == 1) {
+        return generate_updates_from_staging_sstable_group(std::move(table), groups.front());
+    }
+
+    vug_logger.debug("Processing {}.{}: {} sstables in {} non-overlapping groups",
+                    s->ks_name(), s->cf_name(), sstables.size(), groups.size());
+    auto concurrency = std::max(_db.get_config().view_update_generator_concurrency(), 1u);
+    auto result = stop_iteration::no;
+    uint64_t input_size = 0;
+    max_concurrent_for_each(groups, concurrency, [&] (std::vector<sstables::shared_sstable>& group) {
+        return seastar::async([&] {
+            if (result == stop_iteration::yes) {
+                return;
+            }
+            auto [group_result, group_input_size] = generate_updates_from_staging_sstable_group(table, group);
+            if (group_result == stop_iteration::yes) {
+                result = stop_iteration::yes;
+            }
+            input_size += group_input_size;
+        });
+    }).get();
+    return std::make_pair(result, input_size);
+}
+
+// Must be called in a seastar thread.
+std::pair<stop_iteration, uint64_t> view_update_generator::generate_updates_from_staging_sstable_group(lw_shared_ptr<replica::table> table, std::vector<sstables::shared_sstable>& sstables) {
     schema_ptr s = table->schema();
     uint64_t input_size = 0;
 
@@ -102,6 +102,7 @@ class view_update_generator : public async_sharded_service<view_update_generator
             wait_for_all_updates wait_for_all);
 
     std::pair<stop_iteration, uint64_t> generate_updates_from_staging_sstables(lw_shared_ptr<replica::table> table, std::vector<sstables::shared_sstable>& sstables);
+    std::pair<stop_iteration, uint64_t> generate_updates_from_staging_sstable_group(lw_shared_ptr<replica::table> table, std::vector<sstables::shared_sstable>& sstables);
 public:
     ssize_t available_register_units() const { return _registration_sem.available_units(); }
     size_t queued_batches_count() const { return _sstables_with_tables.size(); }
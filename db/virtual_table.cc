@@ -89,33 +89,45 @@ mutation_source streaming_virtual_table::as_mutation_source() {
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr) {
 
+        // Implementations with _native_reverse emit reversed partitions
+        // themselves, with the query schema and slice as they are.
         std::unique_ptr<query::partition_slice> unreversed_slice;
-        bool reversed = query_slice.is_reversed();
+        bool reversed = query_slice.is_reversed() && !_native_reverse;
         if (reversed) {
             unreversed_slice = std::make_unique<query::partition_slice>(query::reverse_slice(*query_schema, query_slice));
         }
         const auto& slice = reversed ? *unreversed_slice : query_slice;
         auto table_schema = reversed ? query_schema->make_reversed() : query_schema;
 
-        // We cannot pass the partition_range directly to execute()
-        // because it is not guaranteed to be alive until execute() resolves.
-        // It is only guaranteed to be alive as long as the returned reader is alive.
+        // We cannot pass the partition_range and the slice directly to execute()
+        // because they are not guaranteed to be alive until execute() resolves.
+        // They are only guaranteed to be alive as long as the returned reader is alive.
         // We achieve safety by mediating access through query_restrictions. When the reader
         // dies, pr is cleared and execute() will get an exception.
         struct my_result_collector : public result_collector, public query_restrictions {
             queue_reader_handle handle;
+            schema_ptr s;
 
             // Valid until handle.is_terminated(), which is set to true when the
             // queue_reader dies.
             const dht::partition_range* pr;
+            const query::partition_slice* ps;
             mutation_reader::forwarding fwd_mr;
 
-            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle&& handle)
+            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, const query::partition_slice* ps, queue_reader_handle&& handle)
                 : result_collector(s, p)
                 , handle(std::move(handle))
+                , s(std::move(s))
                 , pr(pr)
+                , ps(ps)
             { }
 
+            void check_alive() const {
+                if (handle.is_terminated()) {
+                    throw std::runtime_error("read abandoned");
+                }
+            }
+
             // result_collector
             future<> take(mutation_fragment_v2 fragment) override {
                 return handle.push(std::move(fragment));
@@ -123,15 +135,25 @@ mutation_source streaming_virtual_table::as_mutation_source() {
 
             // query_restrictions
             const dht::partition_range& partition_range() const override {
-                if (handle.is_terminated()) {
-                    throw std::runtime_error("read abandoned");
-                }
+                check_alive();
                 return *pr;
             }
+
+            const query::partition_slice& slice() const override {
+                check_alive();
+                return *ps;
+            }
+
+            bool contains_row(const dht::decorated_key& dk, const clustering_key& ck) const override {
+                auto cmp = clustering_key::prefix_equal_tri_compare(*s);
+                return std::ranges::any_of(slice().row_ranges(*s, dk.key()), [&] (const query::clustering_range& r) {
+                    return r.contains(ck, cmp);
+                });
+            }
         };
 
         auto reader_and_handle = make_queue_reader(table_schema, permit);
-        auto consumer = std::make_unique<my_result_collector>(table_schema, permit, &pr, std::move(reader_and_handle.second));
+        auto consumer = std::make_unique<my_result_collector>(table_schema, permit, &pr, &slice, std::move(reader_and_handle.second));
         auto f = execute(permit, *consumer, *consumer);
 
         // It is safe to discard this future because:
@@ -24,6 +24,13 @@ class virtual_table {
     // If set to false, data will be filtered out automatically.
     bool _shard_aware = false;
 
+    // If set to true, the implementation emits the rows of reversed queries
+    // in reverse clustering order itself, see query_restrictions::reversed().
+    // If set to false, reversed queries buffer each partition in
+    // make_reversing_reader() to reverse it.
+    // Only meaningful for streaming_virtual_table.
+    bool _native_reverse = false;
+
 protected:
     void set_cell(row&, const bytes& column_name, data_value);
     bool contains_key(const dht::partition_range&, const dht::decorated_key&) const;
@@ -33,6 +40,17 @@ class virtual_table {
     class query_restrictions {
     public:
         virtual const dht::partition_range& partition_range() const = 0;
+
+        // The slice of the query, in the order in which the rows are to be
+        // emitted: in native reverse format when reversed() is true.
+        virtual const query::partition_slice& slice() const = 0;
+
+        // Whether the rows of each partition are to be emitted in reverse
+        // clustering order. Only ever true with _native_reverse.
+        bool reversed() const { return slice().is_reversed(); }
+
+        // Whether the row with the given key is selected by slice().
+        virtual bool contains_row(const dht::decorated_key&, const clustering_key&) const = 0;
     };
 
     explicit virtual_table(schema_ptr s) : _s(std::move(s)) {}
@@ -98,7 +116,10 @@ class result_collector {
 // fragments (e.g. because the buffer is full) by returning a non-ready future.
 //
 // The fragments must be ordered according to the natural ordering of the keys
-// in the virtual table's schema.
+// in the virtual table's schema, or, for implementations which set
+// _native_reverse, with the rows of each partition in reverse clustering order
+// when query_restrictions::reversed() is true. The result_collector's schema is
+// the reversed schema then, see docs/dev/reverse-reads.md.
 //
 // The reader is free to emit more data than is needed by the query.
 // It will be filtered-out automatically.
@@ -106,7 +127,9 @@ class result_collector {
 //
 //  - avoid emitting partitions for which this_shard_owns() returns false.
 //
-//  - avoid emitting partitions which fall outside result_collector::partition_range().
+//  - avoid emitting partitions which fall outside query_restrictions::partition_range().
+//
+//  - avoid emitting rows for which query_restrictions::contains_row() returns false.
 //
 class streaming_virtual_table : public virtual_table {
 public:
@@ -30,13 +30,16 @@
 #include "replica/database.hh"
 #include "schema/schema_builder.hh"
 #include "service/raft/raft_group_registry.hh"
+#include "service/storage_proxy.hh"
 #include "service/storage_service.hh"
 #include "service/tablet_allocator.hh"
 #include "locator/load_sketch.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 #include "types/list.hh"
 #include "types/types.hh"
 #include "utils/build_id.hh"
 #include "utils/log.hh"
+#include "utils/scheduling_group_stats.hh"
 #include "replica/exceptions.hh"
 #include "service/paxos/paxos_state.hh"
 #include "idl/storage_proxy.dist.hh"
@@ -137,6 +140,7 @@ class token_ring_table : public streaming_virtual_table {
             , _ss(ss)
     {
         _shard_aware = true;
+        _native_reverse = true;
     }
 
     static schema_ptr build_schema() {
@@ -165,24 +169,30 @@ class token_ring_table : public streaming_virtual_table {
         });
     }
 
-    future<> emit_ring(result_collector& result, const dht::decorated_key& dk, const sstring& table_name, utils::chunked_vector<dht::token_range_endpoints> ranges) {
-
-        co_await result.emit_partition_start(dk);
+    future<> emit_ring(result_collector& result, const query_restrictions& qr, const dht::decorated_key& dk, const sstring& table_name, utils::chunked_vector<dht::token_range_endpoints> ranges) {
         std::ranges::sort(ranges, std::ranges::less(), std::mem_fn(&dht::token_range_endpoints::_start_token));
+        if (qr.reversed()) {
+            std::ranges::reverse(ranges);
+        }
 
         for (dht::token_range_endpoints& range : ranges) {
             std::ranges::sort(range._endpoint_details, endpoint_details_cmp());
+            if (qr.reversed()) {
+                std::ranges::reverse(range._endpoint_details);
+            }
 
             for (const dht::endpoint_details& detail : range._endpoint_details) {
-                clustering_row cr(make_clustering_key(table_name, range._start_token, detail._host));
+                auto ck = make_clustering_key(table_name, range._start_token, detail._host);
+                if (!qr.contains_row(dk, ck)) {
+                    continue;
+                }
+                clustering_row cr(std::move(ck));
                 set_cell(cr.cells(), "end_token", sstring(range._end_token));
                 set_cell(cr.cells(), "dc", sstring(detail._datacenter));
                 set_cell(cr.cells(), "rack", sstring(detail._rack));
                 co_await result.emit_row(std::move(cr));
             }
         }
-
-        co_await result.emit_partition_end();
     }
 
     struct endpoint_details_cmp {
@@ -213,19 +223,29 @@ class token_ring_table : public streaming_virtual_table {
                 continue;
             }
 
+            co_await result.emit_partition_start(dk);
             if (_db.find_keyspace(e.name).get_replication_strategy().uses_tablets()) {
-                co_await _db.get_tables_metadata().for_each_table_gently([&, this] (table_id, lw_shared_ptr<replica::table> table) -> future<> {
-                    if (table->schema()->ks_name() != e.name) {
-                        co_return;
+                // Rows are ordered by the table name first.
+                std::vector<sstring> table_names;
+                co_await _db.get_tables_metadata().for_each_table_gently([&] (table_id, lw_shared_ptr<replica::table> table) {
+                    if (table->schema()->ks_name() == e.name) {
+                        table_names.push_back(table->schema()->cf_name());
                     }
-                    const auto& table_name = table->schema()->cf_name();
-                    utils::chunked_vector<dht::token_range_endpoints> ranges = co_await _ss.describe_ring_for_table(e.name, table_name);
-                    co_await emit_ring(result, e.key, table_name, std::move(ranges));
+                    return make_ready_future<>();
                 });
+                std::ranges::sort(table_names);
+                if (qr.reversed()) {
+                    std::ranges::reverse(table_names);
+                }
+                for (const auto& table_name : table_names) {
+                    utils::chunked_vector<dht::token_range_endpoints> ranges = co_await _ss.describe_ring_for_table(e.name, table_name);
+                    co_await emit_ring(result, qr, dk, table_name, std::move(ranges));
+                }
             } else {
                 utils::chunked_vector<dht::token_range_endpoints> ranges = co_await _ss.describe_ring(e.name);
-                co_await emit_ring(result, e.key, "<ALL>", std::move(ranges));
+                co_await emit_ring(result, qr, dk, "<ALL>", std::move(ranges));
             }
+            co_await result.emit_partition_end();
         }
     }
 };
@@ -238,6 +258,7 @@ class snapshots_table : public streaming_virtual_table {
             , _db(db)
     {
         _shard_aware = true;
+        _native_reverse = true;
     }
 
     static schema_ptr build_schema() {
@@ -292,14 +313,26 @@ class snapshots_table : public streaming_virtual_table {
         for (const auto& [ks_data, snapshots_by_tables] : keyspace_snapshots) {
             co_await result.emit_partition_start(ks_data.key);
 
-            for (const auto& [table_name, snapshots] : snapshots_by_tables) {
+            auto emit_snapshots = [&] (const sstring& table_name, auto&& snapshots) -> future<> {
                 for (auto& [snapshot_name, details] : snapshots) {
-                    clustering_row cr(make_clustering_key(table_name, snapshot_name));
+                    auto ck = make_clustering_key(table_name, snapshot_name);
+                    if (!qr.contains_row(ks_data.key, ck)) {
+                        continue;
+                    }
+                    clustering_row cr(std::move(ck));
                     set_cell(cr.cells(), "live", details.live);
                     set_cell(cr.cells(), "total", details.total);
                     co_await result.emit_row(std::move(cr));
                 }
-
+            };
+            if (qr.reversed()) {
+                for (const auto& [table_name, snapshots] : snapshots_by_tables | std::views::reverse) {
+                    co_await emit_snapshots(table_name, snapshots | std::views::reverse);
+                }
+            } else {
+                for (const auto& [table_name, snapshots] : snapshots_by_tables) {
+                    co_await emit_snapshots(table_name, snapshots);
+                }
             }
 
             co_await result.emit_partition_end();
@@ -307,6 +340,325 @@ class snapshots_table : public streaming_virtual_table {
     }
 };
 
+// Lists each shard's estimates of the latency of reads it sends to replicas, see service::replica_latency_tracker.
+class replica_latencies_table : public memtable_filling_virtual_table {
+private:
+    sharded<service::storage_proxy>& _proxy;
+
+public:
+    explicit replica_latencies_table(sharded<service::storage_proxy>& proxy)
+            : memtable_filling_virtual_table(build_schema())
+            , _proxy(proxy) {}
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "replica_latencies");
+        return schema_builder(system_keyspace::NAME, "replica_latencies", std::make_optional(id))
+            .with_column("host_id", uuid_type, column_kind::partition_key)
+            .with_column("shard", int32_type, column_kind::clustering_key)
+            .with_column("samples", long_type)
+            .with_column("mean_us", long_type)
+            .with_column("median_us", long_type)
+            .with_column("p99_us", long_type)
+            .set_comment("Time-decayed latency of the reads which each shard of this node, as a coordinator, sends to each replica.")
+            .with_hash_version()
+            .build();
+    }
+
+    future<> execute(std::function<void(mutation)> mutation_sink) override {
+        auto per_shard = co_await _proxy.map([] (service::storage_proxy& sp) {
+            return sp.get_replica_latencies().get_replica_latencies();
+        });
+        for (unsigned shard = 0; shard < per_shard.size(); ++shard) {
+            for (auto& info : per_shard[shard]) {
+                mutation m(schema(), partition_key::from_single_value(*schema(), data_value(info.host.uuid()).serialize_nonnull()));
+                auto ck = clustering_key::from_single_value(*schema(), data_value(int32_t(shard)).serialize_nonnull());
+                row& cr = m.partition().clustered_row(*schema(), ck).cells();
+                set_cell(cr, "samples", info.samples);
+                set_cell(cr, "mean_us", int64_t(info.mean.count()));
+                set_cell(cr, "median_us", int64_t(info.median.count()));
+                set_cell(cr, "p99_us", int64_t(info.p99.count()));
+                mutation_sink(std::move(m));
+            }
+            co_await coroutine::maybe_yield();
+        }
+    }
+};
+
+// A table with a partition for each shard, keyed by the shard id, which
+// the query reads from one shard at a time.
+class per_shard_virtual_table : public streaming_virtual_table {
+protected:
+    struct shard_partition {
+        dht::decorated_key key;
+        unsigned shard;
+    };
+
+    explicit per_shard_virtual_table(schema_ptr s)
+            : streaming_virtual_table(std::move(s))
+    {
+        _shard_aware = true;
+        _native_reverse = true;
+    }
+
+    // The partitions selected by the query which this shard owns, in ring order.
+    std::vector<shard_partition> shard_partitions(const query_restrictions& qr) const {
+        std::vector<shard_partition> ret;
+        for (unsigned shard = 0; shard < smp::count; ++shard) {
+            auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(int32_t(shard)).serialize_nonnull()));
+            if (this_shard_owns(dk) && contains_key(qr.partition_range(), dk)) {
+                ret.push_back(shard_partition{std::move(dk), shard});
+            }
+        }
+        std::ranges::sort(ret, dht::ring_position_less_comparator(*_s), std::mem_fn(&shard_partition::key));
+        return ret;
+    }
+
+    // Emits the partition with a row for each of the entries, which are
+    // ordered by their clustering key, or nothing if there are no entries.
+    template <typename Entry, typename MakeKey, typename FillRow>
+    future<> emit_partition(result_collector& result, const query_restrictions& qr, const dht::decorated_key& dk,
+            const std::vector<Entry>& entries, MakeKey make_key, FillRow fill_row) {
+        if (entries.empty()) {
+            co_return;
+        }
+        co_await result.emit_partition_start(dk);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const auto& e = entries[qr.reversed() ? entries.size() - 1 - i : i];
+            auto ck = make_key(e);
+            if (!qr.contains_row(dk, ck)) {
+                continue;
+            }
+            clustering_row cr(std::move(ck));
+            fill_row(cr.cells(), e);
+            co_await result.emit_row(std::move(cr));
+        }
+        co_await result.emit_partition_end();
+    }
+};
+
+// Lists the latest slow reads of each shard, see slow_read_log.
+class slow_reads_table : public per_shard_virtual_table {
+private:
+    distributed<replica::database>& _db;
+
+public:
+    explicit slow_reads_table(distributed<replica::database>& db)
+            : per_shard_virtual_table(build_schema())
+            , _db(db) {}
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "slow_reads");
+        return schema_builder(system_keyspace::NAME, "slow_reads", std::make_optional(id))
+            .with_column("shard", int32_type, column_kind::partition_key)
+            .with_column("seq", long_type, column_kind::clustering_key)
+            .with_column("started_at", timestamp_type)
+            .with_column("keyspace_name", utf8_type)
+            .with_column("table_name", utf8_type)
+            .with_column("op", utf8_type)
+            .with_column("semaphore", utf8_type)
+            .with_column("duration_us", long_type)
+            .with_column("queued_us", long_type)
+            .with_column("disk_us", long_type)
+            .with_column("sstables_read", long_type)
+            .with_column("bytes_read", long_type)
+            .set_comment("The latest reads of each shard which took longer than slow_read_log_threshold_in_ms, with a breakdown of where they spent their time.")
+            .with_hash_version()
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        for (const auto& p : shard_partitions(qr)) {
+            // Ordered by seq
+            auto entries = co_await _db.invoke_on(p.shard, [] (replica::database& db) {
+                const auto& entries = db.get_slow_read_log().entries();
+                return std::vector<slow_read_log::entry>(entries.begin(), entries.end());
+            });
+            co_await emit_partition(result, qr, p.key, entries, [this] (const slow_read_log::entry& e) {
+                return clustering_key::from_single_value(*schema(), data_value(int64_t(e.seq)).serialize_nonnull());
+            }, [this] (row& cr, const slow_read_log::entry& e) {
+                set_cell(cr, "started_at", db_clock::time_point(std::chrono::duration_cast<db_clock::duration>(e.started_at.time_since_epoch())));
+                set_cell(cr, "keyspace_name", e.keyspace);
+                set_cell(cr, "table_name", e.table);
+                set_cell(cr, "op", e.op_name);
+                set_cell(cr, "semaphore", e.semaphore);
+                set_cell(cr, "duration_us", int64_t(e.duration.count()));
+                set_cell(cr, "queued_us", int64_t(e.queued.count()));
+                set_cell(cr, "disk_us", int64_t(e.disk.count()));
+                set_cell(cr, "sstables_read", int64_t(e.sstables_read));
+                set_cell(cr, "bytes_read", int64_t(e.bytes_read));
+            });
+        }
+    }
+};
+
+// Lists the hot partitions found by each shard, see db::hot_partitions.
+class hot_partitions_table : public per_shard_virtual_table {
+private:
+    distributed<replica::database>& _db;
+
+    struct entry {
+        sstring op;
+        int32_t rank;
+        sstring keyspace;
+        sstring table;
+        sstring key;
+        int64_t token;
+        int64_t count;
+        int64_t error;
+    };
+
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+            : per_shard_virtual_table(build_schema())
+            , _db(db) {}
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("shard", int32_type, column_kind::partition_key)
+            .with_column("op", utf8_type, column_kind::clustering_key)
+            .with_column("rank", int32_type, column_kind::clustering_key)
+            .with_column("keyspace_name", utf8_type)
+            .with_column("table_name", utf8_type)
+            .with_column("partition_key", utf8_type)
+            .with_column("token", long_type)
+            .with_column("count", long_type)
+            .with_column("error", long_type)
+            .set_comment("The partitions of each shard with the most recent reads and writes, see hot_partitions_threshold. "
+                    "The counts are decayed, and over-estimated by up to error.")
+            .with_hash_version()
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        for (const auto& p : shard_partitions(qr)) {
+            // Ordered by (op, rank), "read" sorts before "write".
+            auto entries = co_await _db.invoke_on(p.shard, [] (replica::database& db) {
+                std::vector<entry> entries;
+                for (auto op : {db::operation_type::read, db::operation_type::write}) {
+                    int32_t rank = 0;
+                    for (auto& r : db.get_hot_partitions().top(op, std::numeric_limits<unsigned>::max())) {
+                        auto t = db.get_tables_metadata().get_table_if_exists(r.item.table);
+                        if (!t) {
+                            continue;
+                        }
+                        auto& s = *t->schema();
+                        entries.push_back(entry{fmt::to_string(op), rank++, s.ks_name(), s.cf_name(), fmt::to_string(r.item.dk.key().with_schema(s)),
+                                dht::token::to_int64(r.item.dk.token()), int64_t(r.count), int64_t(r.error)});
+                    }
+                }
+                return entries;
+            });
+            co_await emit_partition(result, qr, p.key, entries, [this] (const entry& e) {
+                return clustering_key::from_exploded(*schema(), {data_value(e.op).serialize_nonnull(), data_value(e.rank).serialize_nonnull()});
+            }, [this] (row& cr, const entry& e) {
+                set_cell(cr, "keyspace_name", e.keyspace);
+                set_cell(cr, "table_name", e.table);
+                set_cell(cr, "partition_key", e.key);
+                set_cell(cr, "token", e.token);
+                set_cell(cr, "count", e.count);
+                set_cell(cr, "error", e.error);
+            });
+        }
+    }
+};
+
+// Lists the tracing records kept in memory by each shard, see tracing::trace_ring_buffer_helper.
+class tracing_ring_buffer_table : public per_shard_virtual_table {
+public:
+    tracing_ring_buffer_table()
+            : per_shard_virtual_table(build_schema()) {}
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "tracing_ring_buffer");
+        return schema_builder(system_keyspace::NAME, "tracing_ring_buffer", std::make_optional(id))
+            .with_column("shard", int32_type, column_kind::partition_key)
+            .with_column("seq", long_type, column_kind::clustering_key)
+            .with_column("session_id", uuid_type)
+            .with_column("kind", utf8_type)
+            .with_column("command", utf8_type)
+            .with_column("at", timestamp_type)
+            .with_column("elapsed_us", long_type)
+            .with_column("slow_query", boolean_type)
+            .with_column("message", utf8_type)
+            .set_comment("The latest tracing sessions and events of each shard, when tracing_backend is ring_buffer.")
+            .with_hash_version()
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        using record = tracing::trace_ring_buffer_helper::record;
+        for (const auto& p : shard_partitions(qr)) {
+            // Ordered by seq
+            auto records = co_await tracing::trace_ring_buffer_helper::get_records_of_shard(p.shard);
+            co_await emit_partition(result, qr, p.key, records, [this] (const record& r) {
+                return clustering_key::from_single_value(*schema(), data_value(int64_t(r.seq)).serialize_nonnull());
+            }, [this] (row& cr, const record& r) {
+                set_cell(cr, "session_id", r.session_id);
+                set_cell(cr, "kind", sstring(r.is_session ? "session" : "event"));
+                set_cell(cr, "command", tracing::type_to_string(r.command));
+                set_cell(cr, "at", db_clock::time_point(std::chrono::duration_cast<db_clock::duration>(r.at.time_since_epoch())));
+                set_cell(cr, "elapsed_us", int64_t(std::chrono::duration_cast<std::chrono::microseconds>(r.elapsed).count()));
+                set_cell(cr, "slow_query", r.slow_query);
+                set_cell(cr, "message", sstring(r.message));
+            });
+        }
+    }
+};
+
+// Lists what the scheduling groups of each shard consumed and waited for,
+// see utils::scheduling_group_stats.
+class scheduling_groups_table : public per_shard_virtual_table {
+public:
+    scheduling_groups_table()
+            : per_shard_virtual_table(build_schema()) {}
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "scheduling_groups");
+        return schema_builder(system_keyspace::NAME, "scheduling_groups", std::make_optional(id))
+            .with_column("shard", int32_type, column_kind::partition_key)
+            .with_column("group_name", utf8_type, column_kind::clustering_key)
+            .with_column("shares", double_type)
+            .with_column("runtime_ms", long_type)
+            .with_column("waittime_ms", long_type)
+            .with_column("starvetime_ms", long_type)
+            .with_column("tasks_processed", long_type)
+            .with_column("queue_length", long_type)
+            .with_column("io_operations", long_type)
+            .with_column("io_bytes", long_type)
+            .with_column("io_queue_delay_us", long_type)
+            .with_column("io_exec_us", long_type)
+            .set_comment("The CPU time and I/O the scheduling groups of each shard consumed since it started, and the time they "
+                    "spent waiting for the CPU and in the I/O queues.")
+            .with_hash_version()
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        using utils::scheduling_group_stats;
+        for (const auto& p : shard_partitions(qr)) {
+            // Ordered by group
+            auto stats = co_await smp::submit_to(p.shard, [] {
+                return utils::get_local_scheduling_group_stats();
+            });
+            co_await emit_partition(result, qr, p.key, stats, [this] (const scheduling_group_stats& s) {
+                return clustering_key::from_single_value(*schema(), data_value(s.group).serialize_nonnull());
+            }, [this] (row& cr, const scheduling_group_stats& s) {
+                set_cell(cr, "shares", s.shares);
+                set_cell(cr, "runtime_ms", int64_t(s.runtime_ms));
+                set_cell(cr, "waittime_ms", int64_t(s.waittime_ms));
+                set_cell(cr, "starvetime_ms", int64_t(s.starvetime_ms));
+                set_cell(cr, "tasks_processed", int64_t(s.tasks_processed));
+                set_cell(cr, "queue_length", int64_t(s.queue_length));
+                set_cell(cr, "io_operations", int64_t(s.io_operations));
+                set_cell(cr, "io_bytes", int64_t(s.io_bytes));
+                set_cell(cr, "io_queue_delay_us", int64_t(s.io_queue_delay_us));
+                set_cell(cr, "io_exec_us", int64_t(s.io_exec_us));
+            });
+        }
+    }
+};
+
 class protocol_servers_table : public memtable_filling_virtual_table {
 private:
     service::storage_service& _ss;
@@ -746,6 +1098,10 @@ class clients_table : public streaming_virtual_table {
             .with_column("ssl_protocol", utf8_type)
             .with_column("username", utf8_type)
             .with_column("scheduling_group", utf8_type)
+            .with_column("frames_read", long_type)
+            .with_column("frames_written", long_type)
+            .with_column("socket_reads", long_type)
+            .with_column("socket_writes", long_type)
             .with_hash_version()
             .build();
     }
@@ -823,11 +1179,18 @@ class clients_table : public streaming_virtual_table {
             auto& clients = cd_map[dip.ip];
 
             std::ranges::sort(clients, [] (const client_data& a, const client_data& b) {
-                return a.port < b.port || a.client_type_str() < b.client_type_str();
+                return std::tuple(a.port, a.client_type_str()) < std::tuple(b.port, b.client_type_str());
             });
+            if (qr.reversed()) {
+                std::ranges::reverse(clients);
+            }
 
             for (const auto& cd : clients) {
-                clustering_row cr(make_clustering_key(cd.port, cd.client_type_str()));
+                auto ck = make_clustering_key(cd.port, cd.client_type_str());
+                if (!qr.contains_row(dip.key, ck)) {
+                    continue;
+                }
+                clustering_row cr(std::move(ck));
                 set_cell(cr.cells(), "shard_id", cd.shard_id);
                 set_cell(cr.cells(), "connection_stage", cd.stage_str());
                 if (cd.driver_name) {
@@ -855,6 +1218,18 @@ class clients_table : public streaming_virtual_table {
                 if (cd.scheduling_group_name) {
                     set_cell(cr.cells(), "scheduling_group", *cd.scheduling_group_name);
                 }
+                if (cd.frames_read) {
+                    set_cell(cr.cells(), "frames_read", *cd.frames_read);
+                }
+                if (cd.frames_written) {
+                    set_cell(cr.cells(), "frames_written", *cd.frames_written);
+                }
+                if (cd.socket_reads) {
+                    set_cell(cr.cells(), "socket_reads", *cd.socket_reads);
+                }
+                if (cd.socket_writes) {
+                    set_cell(cr.cells(), "socket_writes", *cd.socket_writes);
+                }
                 co_await result.emit_row(std::move(cr));
             }
             co_await result.emit_partition_end();
@@ -867,6 +1242,7 @@ class clients_table : public streaming_virtual_table {
             , _ss(ss)
     {
         _shard_aware = true;
+        _native_reverse = true;
     }
 };
 
@@ -1163,6 +1539,7 @@ future<> initialize_virtual_tables(
         sharded<db::system_keyspace>& sys_ks,
         sharded<service::tablet_allocator>& tablet_allocator,
         sharded<netw::messaging_service>& ms,
+        sharded<service::storage_proxy>& proxy,
         db::config& cfg) {
     auto& virtual_tables_registry = sys_ks.local().get_virtual_tables_registry();
     auto& virtual_tables = *virtual_tables_registry;
@@ -1191,6 +1568,11 @@ future<> initialize_virtual_tables(
     co_await add_table(std::make_unique<clients_table>(ss));
     co_await add_table(std::make_unique<raft_state_table>(dist_raft_gr));
     co_await add_table(std::make_unique<load_per_node>(tablet_allocator, dist_db, dist_raft_gr, ms, dist_gossiper));
+    co_await add_table(std::make_unique<replica_latencies_table>(proxy));
+    co_await add_table(std::make_unique<tracing_ring_buffer_table>());
+    co_await add_table(std::make_unique<slow_reads_table>(dist_db));
+    co_await add_table(std::make_unique<hot_partitions_table>(dist_db));
+    co_await add_table(std::make_unique<scheduling_groups_table>());
 
     db.find_column_family(system_keyspace::size_estimates()).set_virtual_reader(mutation_source(db::size_estimates::virtual_reader(db, sys_ks.local())));
     db.find_column_family(system_keyspace::v3::views_builds_in_progress()).set_virtual_reader(mutation_source(db::view::build_progress_virtual_reader(db)));
@@ -18,6 +18,7 @@ class database;
 }
 
 namespace service {
+class storage_proxy;
 class storage_service;
 class raft_group_registry;
 class tablet_allocator;
@@ -44,6 +45,7 @@ future<> initialize_virtual_tables(
     sharded<db::system_keyspace>&,
     sharded<service::tablet_allocator>&,
     sharded<netw::messaging_service>&,
+    sharded<service::storage_proxy>&,
     db::config&);
 
 
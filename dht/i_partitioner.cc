@@ -26,6 +26,12 @@ namespace dht {
 
 static logging::logger logger("i_partitioner");
 
+void i_partitioner::get_tokens(const schema& s, std::span<const partition_key_view> keys, std::span<token> tokens) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        tokens[i] = get_token(s, keys[i]);
+    }
+}
+
 sharder::sharder(unsigned shard_count, unsigned sharding_ignore_msb_bits)
     : _shard_count(shard_count)
     // if one shard, ignore sharding_ignore_msb_bits as they will just cause needless
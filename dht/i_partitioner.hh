@@ -12,6 +12,7 @@
 #include <seastar/core/sstring.hh>
 #include "keys/keys.hh"
 #include <memory>
+#include <span>
 #include <utility>
 #include "dht/token.hh"
 #include "dht/token-sharding.hh"
@@ -56,6 +57,13 @@ class i_partitioner {
     virtual token get_token(const schema& s, partition_key_view key) const = 0;
     virtual token get_token(const sstables::key_view& key) const = 0;
 
+    /**
+     * Computes the tokens of many keys at once, into the corresponding
+     * elements of `tokens`, which must be at least as long as `keys`.
+     * The result is the same as get_token() of each key.
+     */
+    virtual void get_tokens(const schema& s, std::span<const partition_key_view> keys, std::span<token> tokens) const;
+
     // FIXME: token.tokenFactory
     //virtual token.tokenFactory gettokenFactory() = 0;
 
@@ -89,6 +97,10 @@ inline token get_token(const schema& s, partition_key_view key) {
     return s.get_partitioner().get_token(s, key);
 }
 
+inline void get_tokens(const schema& s, std::span<const partition_key_view> keys, std::span<token> tokens) {
+    s.get_partitioner().get_tokens(s, keys, tokens);
+}
+
 dht::partition_range to_partition_range(dht::token_range);
 dht::partition_range_vector to_partition_ranges(const dht::token_range_vector& ranges, utils::can_yield can_yield = utils::can_yield::no);
 
@@ -50,6 +50,39 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
     return get_token(hash[0]);
 }
 
+void
+murmur3_partitioner::get_tokens(const schema& s, std::span<const partition_key_view> keys, std::span<token> tokens) const {
+    // The legacy form of a key with a single component is the component
+    // itself, so such keys can be hashed in place, many at a time.
+    // Keys with fragmented components, and compound keys, whose legacy form
+    // has to be built on the fly, take the slow path.
+    constexpr size_t batch_size = 64;
+    std::array<bytes_view, batch_size> views;
+    std::array<size_t, batch_size> positions;
+    std::array<std::array<uint64_t, 2>, batch_size> hashes;
+    const bool singular = s.partition_key_size() == 1;
+
+    size_t i = 0;
+    while (i < keys.size()) {
+        size_t n = 0;
+        for (; i < keys.size() && n < batch_size; ++i) {
+            if (singular) {
+                managed_bytes_view component = *keys[i].begin(s);
+                if (component.is_linearized()) {
+                    views[n] = component.current_fragment();
+                    positions[n++] = i;
+                    continue;
+                }
+            }
+            tokens[i] = get_token(s, keys[i]);
+        }
+        utils::murmur_hash::hash3_x64_128(std::span(views.data(), n), 0, std::span(hashes.data(), n));
+        for (size_t j = 0; j < n; ++j) {
+            tokens[positions[j]] = get_token(hashes[j][0]);
+        }
+    }
+}
+
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
 static registry registrator("org.apache.cassandra.dht.Murmur3Partitioner");
 static registry registrator_short_name("Murmur3Partitioner");
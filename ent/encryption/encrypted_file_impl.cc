@@ -8,6 +8,7 @@
  */
 
 #include <fcntl.h>
+#include <unordered_map>
 #include <fmt/format.h>
 #include <seastar/core/file.hh>
 #include <seastar/core/byteorder.hh>
@@ -72,7 +73,11 @@ struct block_encryption_base {
 
     using mode = symmetric_key::mode;
 
-    bytes iv_for(uint64_t pos) const;
+    // The IVs of `blocks` consecutive blocks starting at pos, each
+    // iv_stride() apart, derived with a single block key call so that
+    // the block cipher can pipeline them.
+    bytes ivs_for(uint64_t pos, size_t blocks) const;
+    size_t iv_stride() const;
 
     static ::shared_ptr<symmetric_key> generate_block_key(::shared_ptr<symmetric_key>);
 
@@ -137,9 +142,23 @@ class encrypted_file_impl : public seastar::file_impl, block_encryption_base {
  *
  */
 ::shared_ptr<symmetric_key> block_encryption_base::generate_block_key(::shared_ptr<symmetric_key> key) {
+    // Many files (all the components of all the sstables of a table) share
+    // a data key, keep their block keys instead of deriving them on every open.
+    static constexpr size_t max_cached_block_keys = 128;
+    static thread_local std::unordered_map<bytes, ::shared_ptr<symmetric_key>> block_keys;
+
+    auto i = block_keys.find(key->key());
+    if (i != block_keys.end()) {
+        return i->second;
+    }
     auto hash = calculate_sha256(key->key());
     hash.resize(block_key_len / 8);
-    return ::make_shared<symmetric_key>(key_info{"AES/ECB", block_key_len }, hash);
+    auto block_key = ::make_shared<symmetric_key>(key_info{"AES/ECB", block_key_len }, hash);
+    if (block_keys.size() >= max_cached_block_keys) {
+        block_keys.clear();
+    }
+    block_keys.emplace(key->key(), block_key);
+    return block_key;
 }
 
 block_encryption_base::block_encryption_base(::shared_ptr<symmetric_key> key)
@@ -187,7 +206,11 @@ void encrypted_file_impl::clear_length() {
     _file_length = std::nullopt;
 }
 
-bytes block_encryption_base::iv_for(uint64_t pos) const {
+size_t block_encryption_base::iv_stride() const {
+    return align_up(std::max(_key->iv_len(), _block_key->block_size()), _block_key->block_size());
+}
+
+bytes block_encryption_base::ivs_for(uint64_t pos, size_t blocks) const {
     assert(!(pos & (block_size - 1)));
 
     // #658. ECB block mode has no IV. Bad for security,
@@ -200,18 +223,20 @@ bytes block_encryption_base::iv_for(uint64_t pos) const {
     assert(iv_len >= _key->block_size());
     assert(iv_len >= sizeof(uint64_t));
 
-    bytes b(bytes::initialized_later(), std::max(iv_len, _block_key->block_size()));
-    std::fill(b.begin(), b.end() - sizeof(uint64_t), 0);
+    auto stride = iv_stride();
+    bytes b(bytes::initialized_later(), stride * blocks);
+    std::fill(b.begin(), b.end(), 0);
 
     // write block pos as little endian IV-len integer
     auto block = pos / block_size;
-    write_le(reinterpret_cast<char *>(b.end()) - sizeof(uint64_t), block);
+    for (size_t n = 0; n < blocks; ++n) {
+        write_le(reinterpret_cast<char *>(b.data()) + (n + 1) * stride - sizeof(uint64_t), block + n);
+    }
 
-    // encrypt the encoded block number to build an IV
+    // encrypt the encoded block numbers to build the IVs. ECB encrypts
+    // each of them independently.
     _block_key->encrypt_unpadded(b.data(), b.size(), b.data());
 
-    b.resize(iv_len);
-
     return b;
 }
 
@@ -225,9 +250,11 @@ size_t encrypted_file_impl::transform(uint64_t pos, const void* buffer, size_t l
     auto b = _key->block_size();
 
     size_t off = 0;
+    auto ivs = ivs_for(pos, align_up(len, block_size) / block_size);
+    auto stride = iv_stride();
 
     for (; off < len; off += block_size) {
-        auto iv = iv_for(pos + off);
+        auto iv = ivs.empty() ? nullptr : ivs.data() + off / block_size * stride;
         auto rem = std::min<uint64_t>(block_size, len - off);
 
         if (rem < block_size || ((pos + off + rem) > l && m == symmetric_key::mode::decrypt)) {
@@ -235,7 +262,7 @@ size_t encrypted_file_impl::transform(uint64_t pos, const void* buffer, size_t l
             if (m != symmetric_key::mode::decrypt) {
                 throw std::invalid_argument("Output data not aligned");
             }
-            _key->transform_unpadded(m, i + off, align_down(rem, b), o + off, iv.data());
+            _key->transform_unpadded(m, i + off, align_down(rem, b), o + off, iv);
             // #22236 - ensure we don't wrap numbers here.
             // If reading past actual end of file (_file_length), we can be decoding
             // 1-<key block size> bytes here, that are at the boundary of last
@@ -249,7 +276,7 @@ size_t encrypted_file_impl::transform(uint64_t pos, const void* buffer, size_t l
             // But would be past _file_length -> ensure we return zero here.
             return std::max(l, pos) - pos;
         }
-        _key->transform_unpadded(m, i + off, block_size, o + off, iv.data());
+        _key->transform_unpadded(m, i + off, block_size, o + off, iv);
     }
 
     return off;
@@ -597,10 +624,12 @@ class encrypted_data_sink : public data_sink_impl, public block_encryption_base
         auto b = _key->block_size();
 
         size_t off = 0;
+        auto ivs = ivs_for(_pos, align_up(len, block_size) / block_size);
+        auto stride = iv_stride();
         for (; off < len; off += block_size) {
-            auto iv = iv_for(_pos + off);
+            auto iv = ivs.empty() ? nullptr : ivs.data() + off / block_size * stride;
             auto rem = std::min<uint64_t>(block_size, len - off);
-            _key->transform_unpadded(mode::encrypt, data + off, align_down(rem, b), data + off, iv.data());
+            _key->transform_unpadded(mode::encrypt, data + off, align_down(rem, b), data + off, iv);
         }
     }
 
@@ -748,12 +777,14 @@ class encrypted_data_source : public data_source_impl, public block_encryption_b
         }
 
         const size_t key_block_size = _key->block_size();
+        auto ivs = ivs_for(_current_position, align_up(output.size(), block_size) / block_size);
+        auto stride = iv_stride();
 
         // decrypt all blocks we have to return. might include the last, partial block
         for (size_t offset = 0; offset < output.size(); offset += block_size, _current_position += block_size) {
-            auto iv = iv_for(_current_position);
+            auto iv = ivs.empty() ? nullptr : ivs.data() + offset / block_size * stride;
             auto rem = std::min(block_size, output.size() - offset);
-            _key->transform_unpadded(mode::decrypt, output.get() + offset, align_down(rem, key_block_size), output.get_write() + offset, iv.data());
+            _key->transform_unpadded(mode::decrypt, output.get() + offset, align_down(rem, key_block_size), output.get_write() + offset, iv);
         }
 
         // now, if the output buffer is not aligned, we are at eof, and
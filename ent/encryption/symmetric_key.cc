@@ -260,25 +260,50 @@ void encryption::symmetric_key::generate_iv_impl(uint8_t* dst, size_t s) const {
     }
 }
 
-void encryption::symmetric_key::transform_unpadded_impl(const uint8_t* input,
-                size_t input_len, uint8_t* output, const uint8_t* iv, mode m) const {
-    if (!EVP_CipherInit_ex(*this, nullptr, nullptr,
-                    reinterpret_cast<const uint8_t*>(_key.data()), iv, int(m))) {
-        throw_evp_error("Could not initialize cipher (transform)");
-    }
-    if (!EVP_CIPHER_CTX_set_padding(*this, 0)) {
-        throw_evp_error("Could not disable padding");
+void encryption::symmetric_key::ctxt_deleter::operator()(evp_cipher_ctx_st* ctxt) const noexcept {
+    EVP_CIPHER_CTX_free(ctxt);
+}
+
+evp_cipher_ctx_st* encryption::symmetric_key::transform_context(mode m) const {
+    auto& ctxt = _transform_ctxts[size_t(m)];
+    if (!ctxt) {
+        ctxt_ptr c(EVP_CIPHER_CTX_new());
+        if (!c) {
+            throw std::bad_alloc();
+        }
+        // copies the cipher and key length resolved by the constructor
+        if (!EVP_CIPHER_CTX_copy(c.get(), *this)) {
+            throw_evp_error("Could not copy cipher context");
+        }
+        if (!EVP_CipherInit_ex(c.get(), nullptr, nullptr,
+                        reinterpret_cast<const uint8_t*>(_key.data()), nullptr, int(m))) {
+            throw_evp_error("Could not initialize cipher (transform)");
+        }
+        if (!EVP_CIPHER_CTX_set_padding(c.get(), 0)) {
+            throw_evp_error("Could not disable padding");
+        }
+        ctxt = std::move(c);
     }
+    return ctxt.get();
+}
 
+void encryption::symmetric_key::transform_unpadded_impl(const uint8_t* input,
+                size_t input_len, uint8_t* output, const uint8_t* iv, mode m) const {
     if (input_len & (_block_size - 1)) {
         throw std::invalid_argument("Data must be aligned to 'blocksize'");
     }
 
+    auto ctxt = transform_context(m);
+    // A null key keeps the key schedule set up by transform_context().
+    if (!EVP_CipherInit_ex(ctxt, nullptr, nullptr, nullptr, iv, int(m))) {
+        throw_evp_error("Could not initialize cipher (transform)");
+    }
+
     int outl = 0;
     auto res = m == mode::decrypt ?
-                    EVP_DecryptUpdate(*this, output, &outl, input,
+                    EVP_DecryptUpdate(ctxt, output, &outl, input,
                                     int(input_len)) :
-                    EVP_EncryptUpdate(*this, output, &outl, input,
+                    EVP_EncryptUpdate(ctxt, output, &outl, input,
                                     int(input_len));
 
     if (!res || outl != int(input_len)) {
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <tuple>
 #include <iosfwd>
@@ -45,7 +46,22 @@ std::tuple<sstring, sstring, sstring> parse_key_spec(const sstring&);
 std::tuple<sstring, sstring, sstring> parse_key_spec_and_validate_defaults(const sstring&);
 
 class symmetric_key {
+public:
+    enum class mode {
+        decrypt, encrypt,
+    };
+private:
+    struct ctxt_deleter {
+        void operator()(evp_cipher_ctx_st*) const noexcept;
+    };
+    using ctxt_ptr = std::unique_ptr<evp_cipher_ctx_st, ctxt_deleter>;
+
     std::unique_ptr<evp_cipher_ctx_st, void (*)(evp_cipher_ctx_st*)> _ctxt;
+    // Contexts of the unpadded transforms, one per mode, created on first use.
+    // The key is set up once, each transform only resets the IV, so that
+    // transforming a file block by block doesn't redo the key schedule
+    // for every block.
+    mutable std::array<ctxt_ptr, 2> _transform_ctxts;
     key_info _info;
     bytes _key;
     unsigned _iv_len = 0;
@@ -57,6 +73,7 @@ class symmetric_key {
     }
 
     void generate_iv_impl(uint8_t* dst, size_t) const;
+    evp_cipher_ctx_st* transform_context(mode) const;
     size_t decrypt_impl(const uint8_t* input, size_t input_len, uint8_t* output,
                     size_t output_len, const uint8_t* iv) const;
     size_t encrypt_impl(const uint8_t* input, size_t input_len, uint8_t* output,
@@ -116,9 +133,6 @@ class symmetric_key {
                         reinterpret_cast<const uint8_t*>(iv));
     }
 
-    enum class mode {
-        decrypt, encrypt,
-    };
     template<typename T, typename V, typename I = char>
     void transform_unpadded(mode m, const T* input, size_t input_len, V* output,
                     const I* iv = nullptr) const {
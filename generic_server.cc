@@ -22,6 +22,7 @@ namespace generic_server {
 class counted_data_source_impl : public data_source_impl {
     data_source _ds;
     connection::cpu_concurrency_t& _cpu_concurrency;
+    connection::io_stats& _io_stats;
 
     template <typename F>
     future<temporary_buffer<char>> invoke_with_counting(F&& fun) {
@@ -37,9 +38,11 @@ class counted_data_source_impl : public data_source_impl {
         });
     };
 public:
-    counted_data_source_impl(data_source ds, connection::cpu_concurrency_t& cpu_concurrency) : _ds(std::move(ds)), _cpu_concurrency(cpu_concurrency) {};
+    counted_data_source_impl(data_source ds, connection::cpu_concurrency_t& cpu_concurrency, connection::io_stats& io_stats)
+        : _ds(std::move(ds)), _cpu_concurrency(cpu_concurrency), _io_stats(io_stats) {};
     virtual ~counted_data_source_impl() = default;
     virtual future<temporary_buffer<char>> get() override {
+        ++_io_stats.reads;
         return invoke_with_counting([this] {return _ds.get();});
     };
     virtual future<temporary_buffer<char>> skip(uint64_t n) override {
@@ -53,6 +56,7 @@ class counted_data_source_impl : public data_source_impl {
 class counted_data_sink_impl : public data_sink_impl {
     data_sink _ds;
     connection::cpu_concurrency_t& _cpu_concurrency;
+    connection::io_stats& _io_stats;
 
     template <typename F>
     future<> invoke_with_counting(F&& fun) {
@@ -68,22 +72,26 @@ class counted_data_sink_impl : public data_sink_impl {
         });
     };
 public:
-    counted_data_sink_impl(data_sink ds, connection::cpu_concurrency_t& cpu_concurrency) : _ds(std::move(ds)), _cpu_concurrency(cpu_concurrency) {};
+    counted_data_sink_impl(data_sink ds, connection::cpu_concurrency_t& cpu_concurrency, connection::io_stats& io_stats)
+        : _ds(std::move(ds)), _cpu_concurrency(cpu_concurrency), _io_stats(io_stats) {};
     virtual ~counted_data_sink_impl() = default;
     virtual temporary_buffer<char> allocate_buffer(size_t size) override {
         return _ds.allocate_buffer(size);
     }
     virtual future<> put(net::packet data) override {
+        ++_io_stats.writes;
         return invoke_with_counting([this, data = std::move(data)] () mutable {
             return _ds.put(std::move(data));
         });
     }
     virtual future<> put(std::vector<temporary_buffer<char>> data)  override {
+        ++_io_stats.writes;
         return invoke_with_counting([this, data = std::move(data)] () mutable {
             return _ds.put(std::move(data));
         });
     }
     virtual future<> put(temporary_buffer<char> buf) override {
+        ++_io_stats.writes;
         return invoke_with_counting([this, buf = std::move(buf)] () mutable {
             return _ds.put(std::move(buf));
         });
@@ -112,8 +120,8 @@ connection::connection(server& server, connected_socket&& fd, named_semaphore& s
     , _server{server}
     , _connections_list_entry(_server._connections_list.emplace(*this))
     , _fd{std::move(fd)}
-    , _read_buf(data_source(std::make_unique<counted_data_source_impl>(_fd.input().detach(), _conns_cpu_concurrency)))
-    , _write_buf(output_stream<char>(data_sink(std::make_unique<counted_data_sink_impl>(_fd.output().detach(), _conns_cpu_concurrency)), 8192, output_stream_options{.batch_flushes = true}))
+    , _read_buf(data_source(std::make_unique<counted_data_source_impl>(_fd.input().detach(), _conns_cpu_concurrency, _io_stats)))
+    , _write_buf(output_stream<char>(data_sink(std::make_unique<counted_data_sink_impl>(_fd.output().detach(), _conns_cpu_concurrency, _io_stats)), 8192, output_stream_options{.batch_flushes = true}))
     , _pending_requests_gate("generic_server::connection")
     , _hold_server(_server._gate)
 {
@@ -49,9 +49,15 @@ class connection {
     };
     cpu_concurrency_t _conns_cpu_concurrency;
     execute_under_tenant_type _execute_under_current_tenant = no_tenant();
+    // Counts the reads from, and the writes to the socket.
+    struct io_stats {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+    };
 protected:
     server& _server;
     utils::scoped_item_list<std::reference_wrapper<connection>>::handle _connections_list_entry;
+    io_stats _io_stats;
 
     connected_socket _fd;
     input_stream<char> _read_buf;
@@ -170,6 +170,22 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature lwt_with_tablets { *this, "LWT_WITH_TABLETS"sv };
     gms::feature repair_msg_split { *this, "REPAIR_MSG_SPLIT"sv };
     gms::feature view_building_coordinator { *this, "VIEW_BUILDING_COORDINATOR"sv };
+    gms::feature split_block_bloom_filter { *this, "SPLIT_BLOCK_BLOOM_FILTER"sv };
+    gms::feature row_cache_frequency_admission { *this, "ROW_CACHE_FREQUENCY_ADMISSION"sv };
+    gms::feature query_result_cache { *this, "QUERY_RESULT_CACHE"sv };
+    gms::feature cell_value_interning { *this, "CELL_VALUE_INTERNING"sv };
+    gms::feature replica_side_filtering { *this, "REPLICA_SIDE_FILTERING"sv };
+    gms::feature approximate_aggregates { *this, "APPROXIMATE_AGGREGATES"sv };
+    gms::feature coalesced_mutation_writes { *this, "COALESCED_MUTATION_WRITES"sv };
+    gms::feature multi_partition_digest_reads { *this, "MULTI_PARTITION_DIGEST_READS"sv };
+    gms::feature repair_hash_tree { *this, "REPAIR_HASH_TREE"sv };
+    gms::feature coalesced_hint_replay { *this, "COALESCED_HINT_REPLAY"sv };
+    gms::feature covering_indexes { *this, "COVERING_INDEXES"sv };
+    gms::feature file_based_load_and_stream { *this, "FILE_BASED_LOAD_AND_STREAM"sv };
+    gms::feature lwt_leased_accept { *this, "LWT_LEASED_ACCEPT"sv };
+    gms::feature auto_compression_chunk_length { *this, "AUTO_COMPRESSION_CHUNK_LENGTH"sv };
+    gms::feature raft_message_batch { *this, "RAFT_MESSAGE_BATCH"sv };
+    gms::feature xxh3_digest { *this, "XXH3_DIGEST"sv };
 public:
 
     const std::unordered_map<sstring, std::reference_wrapper<feature>>& registered_features() const;
@@ -47,6 +47,8 @@
 #include "utils/exceptions.hh"
 #include "utils/error_injection.hh"
 #include "idl/gossip.dist.hh"
+#include "serializer_impl.hh"
+#include "idl/gossip.dist.impl.hh"
 #include <csignal>
 #include "build_mode.hh"
 #include "utils/labels.hh"
@@ -125,7 +127,28 @@ gossiper::gossiper(abort_source& as, const locator::shared_token_metadata& stm,
             [this] {
                 return _unreachable_endpoints.size();
             }, sm::description("How many unreachable nodes the current node sees"))(basic_level),
+        sm::make_counter("rounds", _nr_run,
+            sm::description("Number of gossip rounds run by the current node")),
+        sm::make_counter("round_duration_us", [this] { return _round_duration.count(); },
+            sm::description("Total time, in microseconds, spent in gossip rounds, excluding the sending of messages")),
+        sm::make_counter("apply_state_duration_us", [this] { return _apply_state_duration.count(); },
+            sm::description("Total time, in microseconds, spent in applying endpoint states received from other nodes")),
+        sm::make_counter("applied_endpoint_states", _applied_endpoint_states,
+            sm::description("Number of endpoint states received from other nodes and applied")),
     });
+    sm::label message_type("message_type");
+    for (auto& [name, stats] : {std::pair<const char*, message_stats&>{"syn", _syn_stats}, {"ack", _ack_stats}, {"ack2", _ack2_stats}}) {
+        _metrics.add_group("gossip", {
+            sm::make_counter("messages_sent", stats.sent,
+                sm::description("Number of gossip messages sent"), {message_type(name)}),
+            sm::make_counter("message_bytes_sent", stats.sent_bytes,
+                sm::description("Total serialized size of the gossip messages sent, counted only while gossip_message_size_metrics is set"), {message_type(name)}),
+            sm::make_counter("messages_received", stats.received,
+                sm::description("Number of gossip messages received"), {message_type(name)}),
+            sm::make_counter("message_bytes_received", stats.received_bytes,
+                sm::description("Total serialized size of the gossip messages received, counted only while gossip_message_size_metrics is set"), {message_type(name)}),
+        });
+    }
 
     // Add myself to the map on start
     _address_map.add_or_update_entry(_gcfg.host_id, get_broadcast_address());
@@ -175,6 +198,15 @@ void gossiper::do_sort(utils::chunked_vector<gossip_digest>& g_digest_list) cons
 
 // Depends on
 // - no external dependency
+// Computing the serialized size of a message walks all of it, which adds
+// up with many endpoint states, so it's done only if the metrics are enabled.
+template <typename Message>
+void gossiper::count_message_bytes(uint64_t& counter, const Message& msg) const {
+    if (_gcfg.message_size_metrics()) {
+        counter += ser::get_sizeof(msg);
+    }
+}
+
 future<> gossiper::handle_syn_msg(locator::host_id from, gossip_digest_syn syn_msg) {
     logger.trace(
             "handle_syn_msg():from={},cluster_name:peer={},local={},group0_id:peer={},local={},"
@@ -184,6 +216,8 @@ future<> gossiper::handle_syn_msg(locator::host_id from, gossip_digest_syn syn_m
     if (!is_enabled()) {
         co_return;
     }
+    ++_syn_stats.received;
+    count_message_bytes(_syn_stats.received_bytes, syn_msg);
 
     /* If the message is from a different cluster throw it away. */
     if (syn_msg.cluster_id() != get_cluster_name()) {
@@ -269,6 +303,8 @@ future<> gossiper::do_send_ack_msg(locator::host_id from, gossip_digest_syn syn_
     examine_gossiper(g_digest_list, delta_gossip_digest_list, delta_ep_state_map);
     gms::gossip_digest_ack ack_msg(std::move(delta_gossip_digest_list), std::move(delta_ep_state_map));
     logger.debug("Calling do_send_ack_msg to node {}, syn_msg={}, ack_msg={}", from, syn_msg, ack_msg);
+    ++_ack_stats.sent;
+    count_message_bytes(_ack_stats.sent_bytes, ack_msg);
     co_await ser::gossip_rpc_verbs::send_gossip_digest_ack(&_messaging, from, std::move(ack_msg));
 }
 
@@ -314,6 +350,8 @@ future<> gossiper::handle_ack_msg(locator::host_id id, gossip_digest_ack ack_msg
     if (!is_enabled()) {
         co_return;
     }
+    ++_ack_stats.received;
+    count_message_bytes(_ack_stats.received_bytes, ack_msg);
 
     auto g_digest_list = ack_msg.get_gossip_digest_list();
     auto& ep_state_map = ack_msg.get_endpoint_state_map();
@@ -406,6 +444,8 @@ future<> gossiper::do_send_ack2_msg(locator::host_id from, utils::chunked_vector
     }
     gms::gossip_digest_ack2 ack2_msg(std::move(delta_ep_state_map));
     logger.debug("Calling do_send_ack2_msg to node {}, ack_msg_digest={}, ack2_msg={}", from, ack_msg_digest, ack2_msg);
+    ++_ack2_stats.sent;
+    count_message_bytes(_ack2_stats.sent_bytes, ack2_msg);
     co_await ser::gossip_rpc_verbs::send_gossip_digest_ack2(&_messaging, from, std::move(ack2_msg));
     logger.debug("finished do_send_ack2_msg to node {}, ack_msg_digest={}, ack2_msg={}", from, ack_msg_digest, ack2_msg);
 }
@@ -421,6 +461,8 @@ future<> gossiper::handle_ack2_msg(locator::host_id from, gossip_digest_ack2 msg
     if (!is_enabled()) {
         co_return;
     }
+    ++_ack2_stats.received;
+    count_message_bytes(_ack2_stats.received_bytes, msg);
 
 
     auto& remote_ep_state_map = msg.get_endpoint_state_map();
@@ -597,6 +639,8 @@ future<> gossiper::send_gossip(gossip_digest_syn message, std::set<T> epset) {
     int index = dist(_random_engine);
     std::conditional_t<std::is_same_v<T, gms::inet_address>, netw::msg_addr, T> id{__live_endpoints[index]};
     logger.trace("Sending a GossipDigestSyn to {} ...", id);
+    ++_syn_stats.sent;
+    count_message_bytes(_syn_stats.sent_bytes, message);
     return ser::gossip_rpc_verbs::send_gossip_digest_syn(&_messaging, id, std::move(message)).handle_exception([id] (auto ep) {
         // It is normal to reach here because it is normal that a node
         // tries to send a SYN message to a peer node which is down before
@@ -712,8 +756,10 @@ future<> gossiper::apply_state_locally(std::map<inet_address, endpoint_state> ma
         });
     });
 
-    logger.debug("apply_state_locally() took {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start).count());
+    auto duration = std::chrono::steady_clock::now() - start;
+    _apply_state_duration += std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    _applied_endpoint_states += map.size();
+    logger.debug("apply_state_locally() took {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
 }
 
 future<> gossiper::force_remove_endpoint(locator::host_id id, permit_id pid) {
@@ -1118,6 +1164,7 @@ future<> gossiper::replicate_live_endpoints_on_change(foreign_ptr<std::unique_pt
 void gossiper::run() {
    // Run it in the background.
   (void)seastar::with_semaphore(_callback_running, 1, [this] {
+    auto start = std::chrono::steady_clock::now();
     return seastar::async([this, g = shared_from_this()] {
             logger.trace("=== Gossip round START");
 
@@ -1187,7 +1234,8 @@ void gossiper::run() {
                     do_status_check().get();
                 }
             }
-    }).then_wrapped([this] (auto&& f) {
+    }).then_wrapped([this, start] (auto&& f) {
+        _round_duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
         try {
             f.get();
             _nr_run++;
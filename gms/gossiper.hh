@@ -70,6 +70,7 @@ struct gossip_config {
     utils::updateable_value<uint32_t> failure_detector_timeout_ms;
     utils::updateable_value<int32_t> force_gossip_generation;
     utils::updateable_value<utils::UUID> recovery_leader;
+    utils::updateable_value<bool> message_size_metrics;
 };
 
 struct loaded_endpoint_state {
@@ -667,6 +668,24 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
     uint64_t _nr_run = 0;
     uint64_t _msg_processing = 0;
 
+    // Counts and serialized sizes of the gossip messages exchanged by this node.
+    // Together with the time spent in gossip rounds and in applying the received
+    // states, they show how the cost of gossip grows with the size of the cluster.
+    struct message_stats {
+        uint64_t sent = 0;
+        uint64_t sent_bytes = 0;
+        uint64_t received = 0;
+        uint64_t received_bytes = 0;
+    };
+    template <typename Message>
+    void count_message_bytes(uint64_t& counter, const Message& msg) const;
+    message_stats _syn_stats;
+    message_stats _ack_stats;
+    message_stats _ack2_stats;
+    std::chrono::microseconds _round_duration{0};
+    std::chrono::microseconds _apply_state_duration{0};
+    uint64_t _applied_endpoint_states = 0;
+
     class msg_proc_guard;
 private:
     abort_source& _abort_source;
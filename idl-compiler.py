@@ -381,9 +381,8 @@ void serializer<{name}{self.template_param_names_str}>::skip(Input& buf) {{
             fprintln(cout, f"""  {SIZETYPE} size = {DESERIALIZER}(buf, std::type_identity<{SIZETYPE}>());
   buf.skip(size - sizeof({SIZETYPE}));""")
         else:
-            for m in get_members(self):
-                full_type = param_view_type(m.type)
-                fprintln(cout, f"  ser::skip(buf, std::type_identity<{full_type}>());")
+            for stmt in skip_members("buf", [m.type for m in get_members(self)]):
+                fprintln(cout, f"  {stmt}")
         fprintln(cout, """ });\n}""")
 
 
@@ -841,11 +840,20 @@ def template_params_str(template_params):
     return ", ".join(map(lambda param: param.typename + " " + param.name, template_params))
 
 
+def declare_fixed_serialized_size(hout, name, size):
+    fprintln(hout, f"""
+template <>
+struct fixed_serialized_size<{name}> : std::integral_constant<size_t, {size}> {{}};
+""")
+
+
 def handle_enum(enum, hout, cout):
     '''Generate serializer declarations and definitions for an IDL enum'''
     temp_def = template_params_str(enum.parent_template_params)
     name = enum.ns_qualified_name()
     declare_methods(hout, name, temp_def)
+    if not temp_def:
+        declare_fixed_serialized_size(hout, name, f"fixed_serialized_size_v<{enum.underlying_type}>")
 
     enum.serializer_write_impl(cout)
     enum.serializer_read_impl(cout)
@@ -1452,6 +1460,30 @@ template<typename Input>
     fprintln(hout, f'    return {t}(deserialize(v, std::type_identity<unknown_variant_type>()));\n  }});\n}}')
 
 
+def skip_members(stream, types):
+    '''Generate the statements skipping the serialized values of the given
+    member types, one after the other. Types can also be given as C++ type names.
+
+    Runs of members are skipped with ser::skip_all(), which skips the consecutive
+    members of a fixed size at once. Variants are skipped on their own, as their
+    view skippers are overloads of ser::skip() rather than serializers.'''
+    stmts = []
+    run = []
+    for t in types:
+        if isinstance(t, str):
+            run.append(t)
+        elif is_variant(t):
+            if run:
+                stmts.append(f"ser::skip_all<{', '.join(run)}>({stream});")
+                run = []
+            stmts.append(f"ser::skip({stream}, std::type_identity<{param_view_type(t)}>());")
+        else:
+            run.append(param_view_type(t))
+    if run:
+        stmts.append(f"ser::skip_all<{', '.join(run)}>({stream});")
+    return stmts
+
+
 def add_view(cout, cls):
     members = get_members(cls)
     for m in members:
@@ -1469,7 +1501,8 @@ def add_view(cout, cls):
             }}
         """))
 
-    skip = "" if cls.final else "ser::skip(in, std::type_identity<size_type>());"
+    skipped = [] if cls.final else [SIZETYPE]
+    skip = "\n       ".join(skip_members("in", skipped))
     local_names = {}
     for m in members:
         name = get_member_name(m.name)
@@ -1506,7 +1539,8 @@ def add_view(cout, cls):
                 }}
             """).format(f=DESERIALIZER, **locals()))
 
-        skip = skip + f"\n       ser::skip(in, std::type_identity<{full_type}>());"
+        skipped.append(m.type)
+        skip = "\n       ".join(skip_members("in", skipped))
 
     fprintln(cout, "};")
     skip_impl = "auto& in = v;\n       " + skip if cls.final else "v.skip(read_frame_size(v));"
@@ -1593,6 +1627,12 @@ def handle_class(cls, hout, cout):
         elif isinstance(member, EnumDef):
             handle_enum(member, hout, cout)
     declare_methods(hout, full_name, template_params)
+    # Final classes have no size frame, so if all their members have a fixed
+    # size, so do they.
+    members = get_members(cls)
+    if cls.final and not template_params and not any(m.attribute for m in members):
+        types = ", ".join(param_type(m.type) for m in members)
+        declare_fixed_serialized_size(hout, full_name, f"fixed_serialized_size_of_all<{types}>")
 
     cls.serializer_write_impl(cout)
     cls.serializer_read_impl(cout)
@@ -24,6 +24,7 @@ struct mapreduce_request {
     struct aggregation_info {
         db::functions::function_name name;
         std::vector<sstring> column_names;
+        std::vector<bytes_opt> constant_arguments [[version 2026.1]];
     };
     enum class reduction_type : uint8_t {
         count,
@@ -12,10 +12,13 @@ namespace db {
 
 namespace per_partition_rate_limit {
 
-struct account_only {};
+struct account_only {
+    uint32_t weight [[version 2026.1]] = 1;
+};
 
 struct account_and_enforce {
     uint32_t random_variable;
+    uint32_t weight [[version 2026.1]] = 1;
 };
 
 // using info = std::variant<std::monostate, account_only, account_and_enforce>;
@@ -43,6 +43,7 @@ enum class digest_algorithm : uint8_t {
     none = 0,  // digest not required
     MD5 = 1,
     xxHash = 2,// default algorithm
+    xxh3 = 4,
 };
 
 }
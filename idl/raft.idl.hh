@@ -131,4 +131,11 @@ struct direct_fd_ping_reply {
 
 verb [[with_client_info, cancellable]] direct_fd_ping (raft::server_id dst_id) -> service::direct_fd_ping_reply;
 
+struct raft_batched_message {
+    raft::group_id gid;
+    std::variant<raft::append_request, raft::append_reply, raft::vote_request, raft::vote_reply, raft::timeout_now, raft::read_quorum, raft::read_quorum_reply> message;
+};
+
+verb [[with_client_info, with_timeout, one_way]] raft_message_batch (raft::server_id from_id, raft::server_id dst_id, std::vector<service::raft_batched_message> messages [[ref]]);
+
 } // namespace service
@@ -23,6 +23,21 @@ class specific_ranges {
     std::vector<interval<clustering_key_prefix>> ranges();
 };
 
+struct cell_predicate {
+    enum class op : uint8_t {
+        eq,
+        lt,
+        lte,
+        gt,
+        gte,
+        in,
+    };
+
+    uint32_t column;
+    query::cell_predicate::op oper;
+    std::vector<bytes> values;
+};
+
 // COMPATIBILITY NOTE: the partition-slice for reverse queries has two different
 // format:
 // * legacy format
@@ -38,6 +53,7 @@ class partition_slice {
     cql_serialization_format cql_format();
     uint32_t partition_row_limit_low_bits() [[version 1.3]] = std::numeric_limits<uint32_t>::max();
     uint32_t partition_row_limit_high_bits() [[version 4.3]] = 0;
+    std::vector<query::cell_predicate> row_filter() [[version 2026.1]];
 };
 
 struct max_result_size {
@@ -111,3 +111,5 @@ verb [[with_client_info]] repair_set_estimated_partitions (uint32_t repair_meta_
 verb [[with_client_info]] repair_get_diff_algorithms () -> std::vector<row_level_diff_detect_algorithm>;
 verb [[with_client_info]] repair_update_compaction_ctrl (locator::global_tablet_id gid, service::frozen_topology_guard topo_guard);
 verb [[with_client_info]] repair_update_repaired_at_for_merge(table_id);
+verb [[with_client_info]] repair_get_row_hash_tree_nodes (uint32_t repair_meta_id, uint32_t level, std::vector<uint32_t> nodes, shard_id dst_shard_id) -> std::vector<repair_hash>;
+verb [[with_client_info]] repair_get_row_hashes_in_hash_tree_nodes (uint32_t repair_meta_id, uint32_t level, std::vector<uint32_t> nodes, shard_id dst_shard_id) -> repair_hash_set;
@@ -24,6 +24,11 @@ struct table_load_stats final {
     int64_t split_ready_seq_number;
 };
 
+struct tablet_heat_stats {
+    uint64_t tablet_count;
+    std::unordered_map<locator::tablet_id, uint64_t> requests_per_second;
+};
+
 struct load_stats_v1 final {
     std::unordered_map<::table_id, locator::table_load_stats> tables;
 };
@@ -32,6 +37,7 @@ struct load_stats {
     std::unordered_map<::table_id, locator::table_load_stats> tables;
     std::unordered_map<locator::host_id, uint64_t> capacity;
     std::unordered_map<locator::host_id, bool> critical_disk_utilization [[version 2025.3]];
+    std::unordered_map<::table_id, locator::tablet_heat_stats> heat [[version 2026.1]];
 };
 
 }
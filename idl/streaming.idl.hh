@@ -103,6 +103,7 @@ class stream_blob_meta {
     streaming::file_ops fops;
     service::frozen_topology_guard topo_guard;
     std::optional<sstables::sstable_state> sstable_state;
+    bool load_and_stream [[version 2026.1]];
 };
 
 class node_and_shard {
@@ -19,6 +19,7 @@
 #include "utils/rjson.hh"
 
 const sstring db::index::secondary_index::custom_index_option_name = "class_name";
+const sstring db::index::secondary_index::include_option_name = "include";
 
 namespace secondary_index {
 
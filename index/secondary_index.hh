@@ -24,6 +24,7 @@ namespace index {
 class secondary_index {
 public:
     static const sstring custom_index_option_name;
+    static const sstring include_option_name;
 
 };
 
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: (LicenseRef-ScyllaDB-Source-Available-1.0 and Apache-2.0)
  */
 
+#include <cctype>
 #include <functional>
 #include <optional>
 #include <ranges>
@@ -199,6 +200,71 @@ sstring get_available_index_name(
     return accepted_name;
 }
 
+std::vector<sstring> parse_included_columns(std::string_view option) {
+    std::vector<sstring> names;
+    size_t i = 0;
+    auto skip_spaces = [&] {
+        while (i < option.size() && std::isspace(static_cast<unsigned char>(option[i]))) {
+            ++i;
+        }
+    };
+    auto malformed = [&] {
+        return exceptions::invalid_request_exception(
+                format("Malformed list of included columns: '{}'", option));
+    };
+    skip_spaces();
+    while (i < option.size()) {
+        sstring name;
+        if (option[i] == '"') {
+            ++i;
+            for (;;) {
+                if (i == option.size()) {
+                    throw malformed();
+                }
+                if (option[i] == '"') {
+                    if (i + 1 < option.size() && option[i + 1] == '"') {
+                        name += '"';
+                        i += 2;
+                        continue;
+                    }
+                    ++i;
+                    break;
+                }
+                name += option[i++];
+            }
+        } else {
+            while (i < option.size() && option[i] != ',' && !std::isspace(static_cast<unsigned char>(option[i]))) {
+                name += std::tolower(static_cast<unsigned char>(option[i++]));
+            }
+        }
+        if (name.empty()) {
+            throw malformed();
+        }
+        names.push_back(std::move(name));
+        skip_spaces();
+        if (i == option.size()) {
+            break;
+        }
+        if (option[i] != ',') {
+            throw malformed();
+        }
+        ++i;
+        skip_spaces();
+        if (i == option.size()) {
+            throw malformed();
+        }
+    }
+    return names;
+}
+
+std::vector<sstring> included_columns(const index_metadata& im) {
+    auto it = im.options().find(db::index::secondary_index::include_option_name);
+    if (it == im.options().end()) {
+        return {};
+    }
+    return parse_included_columns(it->second);
+}
+
 static bytes get_available_column_name(const schema& schema, const bytes& root) {
     bytes accepted_name = root;
     int i = 0;
@@ -298,8 +364,24 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
     }
 
+    // Columns included in the index are stored in its view as regular
+    // columns, so queries which select only them, besides the key, don't
+    // need to read the base table.
+    auto included = included_columns(im);
+    for (auto& name : included) {
+        const auto* def = schema->get_column_definition(to_bytes(name));
+        if (!def || !def->is_regular()) {
+            throw exceptions::invalid_request_exception(format("Column {} included in index {} is not a regular column of table {}",
+                    name, im.name(), schema->cf_name()));
+        }
+        builder.with_column(def->name(), def->type);
+    }
+
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
+            if (std::ranges::find(included, def.name_as_text()) != included.end()) {
+                continue;
+            }
             db::view::create_virtual_column(builder, def.name(), def.type);
         }
     }
@@ -57,6 +57,18 @@ sstring get_available_index_name(
         const std::set<sstring>& existing_names,
         std::function<bool(std::string_view, std::string_view)> has_schema);
 
+/// Parses the value of the "include" option of an index - a comma-separated
+/// list of CQL column identifiers - and returns the names of the columns.
+/// Like in CQL, a quoted identifier is taken as is and an unquoted one is
+/// folded to lower case. Throws invalid_request_exception if the list is
+/// malformed.
+std::vector<sstring> parse_included_columns(std::string_view option);
+
+/// Returns the names of the base columns which are stored in the view of
+/// the given index, besides the key columns, so that queries selecting only
+/// them can be answered from the index alone.
+std::vector<sstring> included_columns(const index_metadata& im);
+
 class index {
     index_metadata _im;
     cql3::statements::index_target::target_type _target_type;
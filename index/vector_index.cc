@@ -19,6 +19,9 @@
 #include "concrete_types.hh"
 #include "utils/managed_string.hh"
 #include <seastar/core/sstring.hh>
+#include <seastar/core/byteorder.hh>
+#include <bit>
+#include <cmath>
 
 
 namespace secondary_index {
@@ -162,6 +165,67 @@ bool vector_index::has_vector_index(const schema& s) {
     });
 }
 
+vector_index::similarity_function vector_index::get_similarity_function(const index_metadata& im) {
+    auto it = im.options().find("similarity_function");
+    if (it == im.options().end()) {
+        return similarity_function::cosine;
+    }
+    sstring name = it->second;
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (name == "euclidean") {
+        return similarity_function::euclidean;
+    } else if (name == "dot_product") {
+        return similarity_function::dot_product;
+    }
+    return similarity_function::cosine;
+}
+
+// The loops below are simple reductions over contiguous arrays, which the
+// compiler vectorizes.
+float vector_index::similarity(similarity_function f, std::span<const float> a, std::span<const float> b) {
+    switch (f) {
+    case similarity_function::euclidean: {
+        float sum = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            float d = a[i] - b[i];
+            sum += d * d;
+        }
+        return 1 / (1 + sum);
+    }
+    case similarity_function::dot_product: {
+        float dot = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            dot += a[i] * b[i];
+        }
+        return (1 + dot) / 2;
+    }
+    case similarity_function::cosine: {
+        float dot = 0, norm_a = 0, norm_b = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            dot += a[i] * b[i];
+            norm_a += a[i] * a[i];
+            norm_b += b[i] * b[i];
+        }
+        if (norm_a == 0 || norm_b == 0) {
+            return 0;
+        }
+        return (1 + dot / std::sqrt(norm_a * norm_b)) / 2;
+    }
+    }
+    std::abort();
+}
+
+bool vector_index::deserialize_vector(bytes_view value, size_t dimension, std::vector<float>& out) {
+    if (value.size() != dimension * sizeof(float)) {
+        return false;
+    }
+    out.resize(dimension);
+    for (size_t i = 0; i < dimension; ++i) {
+        out[i] = std::bit_cast<float>(read_be<uint32_t>(reinterpret_cast<const char*>(value.data()) + i * sizeof(float)));
+    }
+    return true;
+}
+
 std::unique_ptr<secondary_index::custom_index> vector_index_factory() {
     return std::make_unique<vector_index>();
 }
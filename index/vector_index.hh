@@ -14,6 +14,7 @@
 #include "cql3/statements/index_target.hh"
 #include "index/secondary_index_manager.hh"
 
+#include <span>
 #include <vector>
 
 namespace secondary_index {
@@ -31,6 +32,21 @@ class vector_index: public custom_index {
     void validate(const schema &schema, cql3::statements::index_prop_defs &properties, const std::vector<::shared_ptr<cql3::statements::index_target>> &targets, const gms::feature_service& fs) override;
     static bool has_vector_index(const schema& s);
     static void check_cdc_options(const schema& schema);
+
+    enum class similarity_function { cosine, euclidean, dot_product };
+
+    // Returns the similarity function set in the options of the index,
+    // cosine by default.
+    static similarity_function get_similarity_function(const index_metadata& im);
+
+    // Returns the similarity of two vectors of the same dimension, as defined
+    // by Cassandra's similarity_*() functions: for each of the functions a
+    // higher value means a closer vector.
+    static float similarity(similarity_function f, std::span<const float> a, std::span<const float> b);
+
+    // Parses a serialized value of a vector<float, dimension> column.
+    // Returns false, leaving `out` unspecified, if the value is malformed.
+    static bool deserialize_vector(bytes_view value, size_t dimension, std::vector<float>& out);
 private:
     void check_cdc_not_explicitly_disabled(const schema& schema);
     void check_target(const schema& schema, const std::vector<::shared_ptr<cql3::statements::index_target>>& targets);
@@ -353,7 +353,31 @@ abstract_replication_strategy::get_pending_address_ranges(const token_metadata_p
 
 static const auto default_replication_map_key = dht::token::from_int64(0);
 
-future<mutable_static_effective_replication_map_ptr> calculate_vnode_effective_replication_map(replication_strategy_ptr rs, token_metadata_ptr tmptr) {
+// The natural replicas of a token depend only on the ring and on the locations of the
+// token owners, so they are the same for both token metadata if these are.
+static future<bool> have_same_natural_replicas(const token_metadata& a, const token_metadata& b) {
+    const auto& a_ring = a.get_token_to_endpoint();
+    const auto& b_ring = b.get_token_to_endpoint();
+    if (a_ring.size() != b_ring.size() || a.get_normal_token_owners() != b.get_normal_token_owners()) {
+        co_return false;
+    }
+    for (const auto& [t, ep] : a_ring) {
+        auto it = b_ring.find(t);
+        if (it == b_ring.end() || it->second != ep) {
+            co_return false;
+        }
+        co_await coroutine::maybe_yield();
+    }
+    for (const auto& ep : a.get_normal_token_owners()) {
+        if (a.get_topology().get_location(ep) != b.get_topology().get_location(ep)) {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+future<mutable_static_effective_replication_map_ptr> calculate_vnode_effective_replication_map(replication_strategy_ptr rs, token_metadata_ptr tmptr,
+        const vnode_effective_replication_map* prev) {
     replication_map replication_map;
     ring_mapping pending_endpoints;
     ring_mapping read_endpoints;
@@ -361,6 +385,19 @@ future<mutable_static_effective_replication_map_ptr> calculate_vnode_effective_r
 
     const auto depend_on_token = rs->natural_endpoints_depend_on_token();
     const auto& sorted_tokens = tmptr->sorted_tokens();
+
+    if (prev && !co_await have_same_natural_replicas(*prev->get_token_metadata_ptr(), *tmptr)) {
+        prev = nullptr;
+    }
+    // Natural replicas of a token of the current ring.
+    auto natural_endpoints = [&] (const token& t) -> future<host_id_set> {
+        if (prev) {
+            if (auto it = prev->_replication_map.find(t); it != prev->_replication_map.end()) {
+                co_return host_id_set(it->second);
+            }
+        }
+        co_return co_await rs->calculate_natural_endpoints(t, *tmptr);
+    };
     replication_map.reserve(depend_on_token ? sorted_tokens.size() : 1);
     if (const auto& topology_changes = tmptr->get_topology_change_info(); topology_changes) {
         const auto& all_tokens = topology_changes->all_tokens;
@@ -370,7 +407,7 @@ future<mutable_static_effective_replication_map_ptr> calculate_vnode_effective_r
 
             const auto token = all_tokens[i];
 
-            auto current_endpoints = co_await rs->calculate_natural_endpoints(token, *tmptr);
+            auto current_endpoints = co_await natural_endpoints(depend_on_token ? token : default_replication_map_key);
             auto target_endpoints = co_await rs->calculate_natural_endpoints(token, *topology_changes->target_token_metadata);
 
             auto add_mapping = [&](ring_mapping& target, std::unordered_set<locator::host_id>&& endpoints) {
@@ -428,11 +465,11 @@ future<mutable_static_effective_replication_map_ptr> calculate_vnode_effective_r
         }
     } else if (depend_on_token) {
         for (const auto &t : sorted_tokens) {
-            auto eps = co_await rs->calculate_natural_endpoints(t, *tmptr);
+            auto eps = co_await natural_endpoints(t);
             replication_map.emplace(t, std::move(eps).extract_vector());
         }
     } else {
-        auto eps = co_await rs->calculate_natural_endpoints(default_replication_map_key, *tmptr);
+        auto eps = co_await natural_endpoints(default_replication_map_key);
         replication_map.emplace(default_replication_map_key, std::move(eps).extract_vector());
     }
 
@@ -559,7 +596,9 @@ future<static_effective_replication_map_ptr> effective_replication_map_factory::
         if (ref_erm) {
             new_erm = co_await ref_erm->clone_gently(std::move(rs), std::move(tmptr));
         } else {
-            new_erm = co_await calculate_vnode_effective_replication_map(std::move(rs), std::move(tmptr));
+            // Topology changes usually leave most of the ring as it was, start from the previous map.
+            auto prev = find_latest_vnode_effective_replication_map(key);
+            new_erm = co_await calculate_vnode_effective_replication_map(std::move(rs), std::move(tmptr), prev.get());
         }
     }
     co_return insert_effective_replication_map(std::move(new_erm), std::move(key));
@@ -573,6 +612,26 @@ static_effective_replication_map_ptr effective_replication_map_factory::find_eff
     return {};
 }
 
+shared_ptr<const vnode_effective_replication_map>
+effective_replication_map_factory::find_latest_vnode_effective_replication_map(const static_effective_replication_map::factory_key& key) const {
+    const vnode_effective_replication_map* latest = nullptr;
+    long latest_ring_version = 0;
+    for (const auto& [k, erm] : _effective_replication_maps) {
+        if (k.rs_type != key.rs_type || k.rs_config_options != key.rs_config_options
+                || (latest && k.ring_version <= latest_ring_version)) {
+            continue;
+        }
+        if (auto vnode_erm = erm->maybe_as_vnode_effective_replication_map()) {
+            latest = vnode_erm;
+            latest_ring_version = k.ring_version;
+        }
+    }
+    if (!latest) {
+        return {};
+    }
+    return static_pointer_cast<const vnode_effective_replication_map>(latest->shared_from_this());
+}
+
 static_effective_replication_map_ptr effective_replication_map_factory::insert_effective_replication_map(mutable_static_effective_replication_map_ptr erm, static_effective_replication_map::factory_key key) {
     auto [it, inserted] = _effective_replication_maps.insert({key, erm.get()});
     if (inserted) {
@@ -368,7 +368,12 @@ class static_effective_replication_map : public enable_shared_from_this<static_e
 };
 
 // Apply the replication strategy over the current configuration and the given token_metadata.
-future<mutable_static_erm_ptr> calculate_vnode_effective_replication_map(replication_strategy_ptr rs, token_metadata_ptr tmptr);
+//
+// If `prev` is given, it must have been calculated for a replication strategy of the same
+// type and options. Its natural replicas are reused when the ring didn't change since,
+// e.g. when only pending ranges did.
+future<mutable_static_erm_ptr> calculate_vnode_effective_replication_map(replication_strategy_ptr rs, token_metadata_ptr tmptr,
+        const vnode_effective_replication_map* prev = nullptr);
 
 // Class to hold a coherent view of a keyspace
 // effective replication map on all shards
@@ -412,6 +417,8 @@ class vnode_effective_replication_map : public static_effective_replication_map
 
     friend class abstract_replication_strategy;
     friend class effective_replication_map_factory;
+    friend future<mutable_static_erm_ptr> calculate_vnode_effective_replication_map(replication_strategy_ptr, token_metadata_ptr,
+            const vnode_effective_replication_map*);
 public: // effective_replication_map
     host_id_vector_replica_set get_natural_replicas(const token& search_token, bool is_vnode = false) const override;
     host_id_vector_topology_change get_pending_replicas(const token& search_token) const override;
@@ -602,6 +609,9 @@ class effective_replication_map_factory : public peering_sharded_service<effecti
 
 private:
     static_erm_ptr find_effective_replication_map(const static_effective_replication_map::factory_key& key) const;
+    // Finds the vnode map of the latest ring version for a replication strategy of the same
+    // type and options as `key`, if any.
+    shared_ptr<const vnode_effective_replication_map> find_latest_vnode_effective_replication_map(const static_effective_replication_map::factory_key& key) const;
     static_erm_ptr insert_effective_replication_map(mutable_static_erm_ptr erm, static_effective_replication_map::factory_key key);
 
     bool erase_effective_replication_map(static_effective_replication_map* erm);
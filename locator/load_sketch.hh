@@ -17,6 +17,7 @@
 
 #include <absl/container/btree_set.h>
 
+#include <algorithm>
 #include <optional>
 #include <vector>
 
@@ -24,6 +25,10 @@ namespace locator {
 
 /// A data structure which keeps track of load associated with data ownership
 /// on shards of the whole cluster.
+///
+/// Besides the tablet count, which stands for storage utilization, it can also
+/// track heat of shards, the rate of requests served by their tablet replicas,
+/// when it's given load_stats which carry tablet heat.
 class load_sketch {
     using shard_id = seastar::shard_id;
     using load_type = ssize_t; // In tablets.
@@ -44,8 +49,10 @@ class load_sketch {
         absl::btree_set<shard_load, shard_load_cmp> _shards_by_load;
         std::vector<load_type> _shards;
         load_type _load = 0;
+        std::vector<double> _shards_heat;
+        double _heat = 0;
 
-        node_load(size_t shard_count) : _shards(shard_count) {
+        node_load(size_t shard_count) : _shards(shard_count), _shards_heat(shard_count) {
             for (shard_id i = 0; i < shard_count; ++i) {
                 _shards[i] = 0;
             }
@@ -61,6 +68,11 @@ class load_sketch {
             _shards_by_load.insert(shard_load{shard, new_load});
         }
 
+        void update_shard_heat(shard_id shard, double heat_delta) {
+            _heat += heat_delta;
+            _shards_heat[shard] = std::max(0.0, _shards_heat[shard] + heat_delta);
+        }
+
         void populate_shards_by_load() {
             _shards_by_load.clear();
             for (shard_id i = 0; i < _shards.size(); ++i) {
@@ -78,6 +90,7 @@ class load_sketch {
     };
     std::unordered_map<host_id, node_load> _nodes;
     token_metadata_ptr _tm;
+    load_stats_ptr _stats;
 private:
     tablet_replica_set get_replicas_for_tablet_load(const tablet_info& ti, const tablet_transition_info* trinfo) const {
         // We reflect migrations in the load as if they already happened,
@@ -85,9 +98,10 @@ class load_sketch {
         return trinfo ? trinfo->next : ti.replicas;
     }
 
-    future<> populate_table(const tablet_map& tmap, std::optional<host_id> host, std::optional<sstring> only_dc) {
+    future<> populate_table(table_id table, const tablet_map& tmap, std::optional<host_id> host, std::optional<sstring> only_dc) {
         const topology& topo = _tm->get_topology();
         co_await tmap.for_each_tablet([&] (tablet_id tid, const tablet_info& ti) -> future<> {
+            auto heat = _stats ? _stats->get_tablet_replica_heat(global_tablet_id{table, tid}, tmap) : 0;
             for (auto&& replica : get_replicas_for_tablet_load(ti, tmap.get_tablet_transition_info(tid))) {
                 if (host && *host != replica.host) {
                     continue;
@@ -103,6 +117,8 @@ class load_sketch {
                 if (replica.shard < n._shards.size()) {
                     n.load() += 1;
                     n._shards[replica.shard] += 1;
+                    n._heat += heat;
+                    n._shards_heat[replica.shard] += heat;
                     // Note: as an optimization, _shards_by_load is populated later in populate_shards_by_load()
                 }
             }
@@ -110,8 +126,9 @@ class load_sketch {
         });
     }
 public:
-    load_sketch(token_metadata_ptr tm)
-        : _tm(std::move(tm)) {
+    load_sketch(token_metadata_ptr tm, load_stats_ptr stats = {})
+        : _tm(std::move(tm))
+        , _stats(std::move(stats)) {
     }
 
     future<> populate(std::optional<host_id> host = std::nullopt,
@@ -122,11 +139,11 @@ class load_sketch {
         if (only_table) {
             if (_tm->tablets().has_tablet_map(*only_table)) {
                 auto& tmap = _tm->tablets().get_tablet_map(*only_table);
-                co_await populate_table(tmap, host, only_dc);
+                co_await populate_table(*only_table, tmap, host, only_dc);
             }
         } else {
             for (const auto& [table, tmap] : _tm->tablets().all_tables_ungrouped()) {
-                co_await populate_table(*tmap, host, only_dc);
+                co_await populate_table(table, *tmap, host, only_dc);
             }
         }
 
@@ -170,14 +187,56 @@ class load_sketch {
         return s.id;
     }
 
-    void unload(host_id node, shard_id shard) {
+    void unload(host_id node, shard_id shard, double heat = 0) {
         auto& n = _nodes.at(node);
         n.update_shard_load(shard, -1);
+        n.update_shard_heat(shard, -heat);
     }
 
-    void pick(host_id node, shard_id shard) {
+    void pick(host_id node, shard_id shard, double heat = 0) {
         auto& n = _nodes.at(node);
         n.update_shard_load(shard, 1);
+        n.update_shard_heat(shard, heat);
+    }
+
+    // Returns the heat of a single replica of the tablet, or 0 if it's not known.
+    double get_tablet_heat(global_tablet_id id) const {
+        if (!_stats || !_tm->tablets().has_tablet_map(id.table)) {
+            return 0;
+        }
+        return _stats->get_tablet_replica_heat(id, _tm->tablets().get_tablet_map(id.table));
+    }
+
+    double get_heat(host_id node) const {
+        if (!_nodes.contains(node)) {
+            return 0;
+        }
+        return _nodes.at(node)._heat;
+    }
+
+    double get_shard_heat(host_id node, shard_id shard) const {
+        if (!_nodes.contains(node)) {
+            return 0;
+        }
+        return _nodes.at(node)._shards_heat[shard];
+    }
+
+    double get_avg_shard_heat(host_id node) const {
+        if (!_nodes.contains(node)) {
+            return 0;
+        }
+        auto& n = _nodes.at(node);
+        return n._heat / n._shards.size();
+    }
+
+    shard_id get_hottest_shard(host_id node) {
+        auto& n = ensure_node(node);
+        return std::distance(n._shards_heat.begin(), std::ranges::max_element(n._shards_heat));
+    }
+
+    shard_id get_coldest_shard(host_id node) {
+        auto& n = ensure_node(node);
+        return std::distance(n._shards_heat.begin(), std::ranges::min_element(n._shards_heat));
     }
 
     load_type get_load(host_id node) const {
@@ -317,10 +317,41 @@ future<> tablet_metadata::mutate_tablet_map_async(table_id id, noncopyable_funct
     it->second = make_foreign(std::move(new_map_ptr));
 }
 
+// Copies the pointers, which must be owned by the current shard.
+static future<std::vector<tablet_metadata::tablet_map_ptr>>
+copy_tablet_map_ptrs(const std::vector<const tablet_metadata::tablet_map_ptr*>& ptrs) {
+    std::vector<tablet_metadata::tablet_map_ptr> ret;
+    ret.reserve(ptrs.size());
+    for (auto ptr : ptrs) {
+        // Doesn't leave the shard.
+        ret.push_back(co_await ptr->copy());
+        co_await coroutine::maybe_yield();
+    }
+    co_return ret;
+}
+
 future<tablet_metadata> tablet_metadata::copy() const {
     tablet_metadata copy;
-    for (const auto& e : _tablets) {
-        copy._tablets.emplace(e.first, co_await e.second.copy());
+    // The tablet maps are immutable and shared by the copies, only the pointers are copied.
+    // This has to be done on the shard which owns the maps, so the pointers are copied
+    // with a single call to each owner, rather than with one call per table.
+    std::vector<std::vector<table_id>> ids(smp::count);
+    std::vector<std::vector<const tablet_map_ptr*>> ptrs(smp::count);
+    for (const auto& [id, ptr] : _tablets) {
+        ids[ptr.get_owner_shard()].push_back(id);
+        ptrs[ptr.get_owner_shard()].push_back(&ptr);
+    }
+    copy._tablets.reserve(_tablets.size());
+    for (shard_id shard = 0; shard < smp::count; ++shard) {
+        if (ptrs[shard].empty()) {
+            continue;
+        }
+        auto copies = co_await smp::submit_to(shard, [&ptrs = ptrs[shard]] {
+            return copy_tablet_map_ptrs(ptrs);
+        });
+        for (size_t i = 0; i < copies.size(); ++i) {
+            copy._tablets.emplace(ids[shard][i], std::move(copies[i]));
+        }
     }
 
     copy._table_groups = _table_groups;
@@ -802,6 +833,32 @@ table_load_stats& table_load_stats::operator+=(const table_load_stats& s) noexce
     return *this;
 }
 
+tablet_heat_stats& tablet_heat_stats::operator+=(const tablet_heat_stats& s) {
+    if (requests_per_second.empty() && !tablet_count) {
+        tablet_count = s.tablet_count;
+    }
+    if (tablet_count != s.tablet_count) {
+        return *this;
+    }
+    for (auto& [tid, rate] : s.requests_per_second) {
+        requests_per_second[tid] += rate;
+    }
+    return *this;
+}
+
+double load_stats::get_tablet_replica_heat(global_tablet_id id, const tablet_map& tmap) const {
+    auto it = heat.find(id.table);
+    if (it == heat.end() || it->second.tablet_count != tmap.tablet_count()) {
+        return 0;
+    }
+    auto rate = it->second.requests_per_second.find(id.tablet);
+    if (rate == it->second.requests_per_second.end()) {
+        return 0;
+    }
+    auto replicas = tmap.get_tablet_info(id.tablet).replicas.size();
+    return replicas ? double(rate->second) / replicas : 0;
+}
+
 load_stats load_stats::from_v1(load_stats_v1&& stats) {
     return { .tables = std::move(stats.tables) };
 }
@@ -816,6 +873,9 @@ load_stats& load_stats::operator+=(const load_stats& s) {
     for (auto& [host, cdu] : s.critical_disk_utilization) {
         critical_disk_utilization[host] = cdu;
     }
+    for (auto& [id, h] : s.heat) {
+        heat[id] += h;
+    }
 
     return *this;
 }
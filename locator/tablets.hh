@@ -389,6 +389,21 @@ struct table_load_stats {
     }
 };
 
+// Rates of requests served by the tablets of a table, used to balance the
+// load which they put on shards besides their size.
+struct tablet_heat_stats {
+    // Tablet count of the table when the rates were measured. Rates measured
+    // with a different tablet count than the current one don't apply.
+    uint64_t tablet_count = 0;
+    // Reads and writes per second served by all replicas of each tablet.
+    // Tablets which served no requests are absent.
+    std::unordered_map<tablet_id, uint64_t> requests_per_second;
+
+    // Rates measured with different tablet counts, i.e. around a resize,
+    // cannot be combined, so the ones which were merged first are kept.
+    tablet_heat_stats& operator+=(const tablet_heat_stats& s);
+};
+
 // Deprecated, use load_stats instead.
 struct load_stats_v1 {
     std::unordered_map<table_id, table_load_stats> tables;
@@ -403,8 +418,14 @@ struct load_stats {
     // Critical disk utilization check for each host.
     std::unordered_map<locator::host_id, bool> critical_disk_utilization;
 
+    std::unordered_map<table_id, tablet_heat_stats> heat;
+
     static load_stats from_v1(load_stats_v1&&);
 
+    // Returns the request rate of a single replica of the tablet, assuming
+    // that its replicas share the load evenly, or 0 if it's not known.
+    double get_tablet_replica_heat(global_tablet_id, const tablet_map&) const;
+
     load_stats& operator+=(const load_stats& s);
     friend load_stats operator+(load_stats a, const load_stats& b) {
         return a += b;
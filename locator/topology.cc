@@ -89,6 +89,7 @@ std::string node::to_string(node::state s) {
 
 future<> topology::clear_gently() noexcept {
     _this_node = nullptr;
+    _proximity_cache.clear();
     co_await utils::clear_gently(_dc_endpoints);
     co_await utils::clear_gently(_dc_racks);
     _datacenters.clear();
@@ -130,6 +131,7 @@ topology::topology(topology&& o) noexcept
     , _sort_by_proximity(o._sort_by_proximity)
     , _datacenters(std::move(o._datacenters))
     , _random_engine(std::move(o._random_engine))
+    , _proximity_cache(std::move(o._proximity_cache))
 {
     SCYLLA_ASSERT(_shard == this_shard_id());
     tlogger.trace("topology[{}]: move from [{}]", fmt::ptr(this), fmt::ptr(&o));
@@ -323,6 +325,7 @@ void topology::remove_node(const node& node) {
 
 void topology::index_node(const node& node) {
     tlogger.trace("topology[{}]: index_node: {}, at {}", fmt::ptr(this), node_printer(&node), lazy_backtrace());
+    _proximity_cache.clear();
 
     if (node.idx() < 0) {
         on_internal_error(tlogger, seastar::format("topology[{}]: {}: must already have a valid idx", fmt::ptr(this), node_printer(&node)));
@@ -360,6 +363,7 @@ void topology::index_node(const node& node) {
 
 void topology::unindex_node(const node& node) {
     tlogger.trace("topology[{}]: unindex_node: {}, at {}", fmt::ptr(this), node_printer(&node), lazy_backtrace());
+    _proximity_cache.clear();
 
     const auto& dc = node.dc_rack().dc;
     const auto& rack = node.dc_rack().rack;
@@ -495,16 +499,41 @@ void topology::sort_by_proximity(locator::host_id address, host_id_vector_replic
 }
 
 void topology::do_sort_by_proximity(locator::host_id address, host_id_vector_replica_set& addresses) const {
+    if (address != my_host_id()) {
+        apply_proximity_order(sort_by_distance(address, addresses), addresses);
+        return;
+    }
+    auto it = _proximity_cache.find(addresses);
+    if (it == _proximity_cache.end()) {
+        auto host_infos = sort_by_distance(address, addresses);
+        if (_proximity_cache.size() >= max_proximity_cache_size) {
+            apply_proximity_order(std::move(host_infos), addresses);
+            return;
+        }
+        it = _proximity_cache.emplace(addresses, std::move(host_infos)).first;
+    }
+    apply_proximity_order(it->second, addresses);
+}
+
+size_t topology::replica_set_hash::operator()(const host_id_vector_replica_set& replicas) const noexcept {
+    size_t h = 0;
+    for (const auto& id : replicas) {
+        boost::hash_combine(h, std::hash<locator::host_id>()(id));
+    }
+    return h;
+}
+
+topology::proximity_sorted_replica_set topology::sort_by_distance(locator::host_id address, const host_id_vector_replica_set& addresses) const {
     const auto& loc = get_location(address);
-    struct info {
-        locator::host_id id;
-        int distance;
-    };
     auto host_infos = addresses | std::views::transform([&] (locator::host_id id) {
         const auto& loc1 = get_location(id);
-        return info{id, distance(address, loc, id, loc1)};
-    }) | std::ranges::to<utils::small_vector<info, host_id_vector_replica_set::internal_capacity()>>();
-    std::ranges::sort(host_infos, std::ranges::less{}, std::mem_fn(&info::distance));
+        return proximity_info{id, distance(address, loc, id, loc1)};
+    }) | std::ranges::to<proximity_sorted_replica_set>();
+    std::ranges::sort(host_infos, std::ranges::less{}, std::mem_fn(&proximity_info::distance));
+    return host_infos;
+}
+
+void topology::apply_proximity_order(proximity_sorted_replica_set host_infos, host_id_vector_replica_set& addresses) const {
     auto dst = addresses.begin();
     auto it = host_infos.begin();
     auto prev = it;
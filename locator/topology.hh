@@ -405,6 +405,21 @@ class topology {
     void seed_random_engine(random_engine_type::result_type);
     const endpoint_dc_rack& get_location_slow(host_id id) const;
 
+    struct proximity_info {
+        locator::host_id id;
+        int distance;
+    };
+    using proximity_sorted_replica_set = utils::small_vector<proximity_info, host_id_vector_replica_set::internal_capacity()>;
+
+    struct replica_set_hash {
+        size_t operator()(const host_id_vector_replica_set& replicas) const noexcept;
+    };
+
+    proximity_sorted_replica_set sort_by_distance(locator::host_id address, const host_id_vector_replica_set& addresses) const;
+    // Writes the replicas to addresses in the order of distance, shuffling
+    // the replicas at equal distance.
+    void apply_proximity_order(proximity_sorted_replica_set host_infos, host_id_vector_replica_set& addresses) const;
+
     unsigned _shard;
     config _cfg;
     const node* _this_node = nullptr;
@@ -431,6 +446,13 @@ class topology {
 
     mutable random_engine_type _random_engine;
 
+    // Replica sets sorted by distance from this node, keyed by the replica
+    // set, so that reads coordinated by this node don't recompute distances
+    // of the same set of replicas over and over. Cleared whenever a node is
+    // (un)indexed, i.e. when any node's location may have changed.
+    static constexpr size_t max_proximity_cache_size = 4096;
+    mutable std::unordered_map<host_id_vector_replica_set, proximity_sorted_replica_set, replica_set_hash> _proximity_cache;
+
     friend class token_metadata_impl;
     friend struct ::sort_by_proximity_topology;
 public:
@@ -71,10 +71,12 @@
 #include <sys/resource.h>
 #include <sys/prctl.h>
 #include "tracing/tracing.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 #include "audit/audit.hh"
 #include <seastar/core/prometheus.hh>
 #include "message/messaging_service.hh"
 #include "db/sstables-format-selector.hh"
+#include "db/cache_warmer.hh"
 #include "db/snapshot-ctl.hh"
 #include "cql3/query_processor.hh"
 #include <seastar/net/dns.hh>
@@ -99,6 +101,7 @@
 #include "cdc/generation_service.hh"
 #include "service/qos/standard_service_level_distributed_data_accessor.hh"
 #include "service/storage_proxy.hh"
+#include "service/maintenance_shares_controller.hh"
 #include "service/mapreduce_service.hh"
 #include "alternator/controller.hh"
 #include "alternator/ttl.hh"
@@ -834,6 +837,8 @@ sharded<locator::shared_token_metadata> token_metadata;
             // See the comment at the definition of sstables::global_cache_index_pages.
             smp::invoke_on_all([&cfg] {
                 sstables::global_cache_index_pages = cfg->cache_index_pages.operator utils::updateable_value<bool>();
+                sstables::global_index_read_ahead_pages = cfg->index_read_ahead_pages.operator utils::updateable_value<uint32_t>();
+                sstables::global_cache_decompressed_chunks = cfg->cache_decompressed_chunks.operator utils::updateable_value<bool>();
             }).get();
 
             ::sighup_handler sighup_handler(opts, *cfg);
@@ -841,6 +846,9 @@ sharded<locator::shared_token_metadata> token_metadata;
                 sighup_handler.stop().get();
             });
 
+            if (cfg->lsa_hugepage_arenas()) {
+                logalloc::use_hugepage_arena_segment_pool_backend().get();
+            }
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
             logging::apply_settings(cfg->logging_settings(app.options().log_opts));
 
@@ -904,6 +912,7 @@ sharded<locator::shared_token_metadata> token_metadata;
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
                 st_cfg.sanitizer_report_backtrace = cfg->sanitizer_report_backtrace();
+                st_cfg.reclaim_time_slice = std::chrono::microseconds(cfg->lsa_reclaim_time_slice_us());
                 logalloc::shard_tracker().configure(st_cfg);
             }).get();
 
@@ -1085,6 +1094,9 @@ sharded<locator::shared_token_metadata> token_metadata;
             utils::directories::set dir_set;
             dir_set.add(cfg->commitlog_directory());
             dir_set.add(cfg->schema_commitlog_directory());
+            if (cfg->raft_segment_log_storage()) {
+                dir_set.add(cfg->raft_log_directory());
+            }
             dirs.emplace(cfg->developer_mode());
             dirs->create_and_verify(std::move(dir_set)).get();
 
@@ -1196,6 +1208,9 @@ sharded<locator::shared_token_metadata> token_metadata;
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
+                    .major_compaction_parallel_subranges = cfg->compaction_major_parallel_subranges,
+                    .read_latency_target_ms = cfg->compaction_read_latency_target_ms,
+                    .offstrategy_round_size_in_mb = cfg->compaction_offstrategy_round_size_in_mb,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source()), std::ref(task_manager)).get();
@@ -1328,6 +1343,26 @@ sharded<locator::shared_token_metadata> token_metadata;
                 api::unset_server_storage_proxy(ctx).get();
             });
 
+            sharded<service::maintenance_shares_controller> maintenance_shares_controller;
+            maintenance_shares_controller.start(maintenance_scheduling_group, sharded_parameter([&cfg] {
+                return service::maintenance_shares_controller::config{
+                    .shares = cfg->maintenance_shares,
+                    .latency_slo_ms = cfg->maintenance_latency_slo_ms,
+                };
+            }), sharded_parameter([&proxy] {
+                return service::maintenance_shares_controller::foreground_latency_func([&proxy] {
+                    // The worst p99 of the coordinator reads and writes of all the scheduling groups
+                    return map_reduce_scheduling_group_specific<service::storage_proxy_stats::stats>([] (const service::storage_proxy_stats::stats& s) {
+                        return std::max(s.read.summary().summary()[2], s.write.summary().summary()[2]);
+                    }, [] (double a, double b) { return std::max(a, b); }, 0.0, proxy.local().get_stats_key()).then([] (double p99) {
+                        return std::chrono::microseconds(int64_t(p99));
+                    });
+                });
+            })).get();
+            auto stop_maintenance_shares_controller = defer_verbose_shutdown("maintenance shares controller", [&maintenance_shares_controller] {
+                maintenance_shares_controller.stop().get();
+            });
+
             static sharded<cql3::cql_config> cql_config;
             cql_config.start(std::ref(*cfg)).get();
 
@@ -1339,7 +1374,7 @@ sharded<locator::shared_token_metadata> token_metadata;
             vector_store_client.invoke_on_all(&service::vector_store_client::start_background_tasks).get();
 
             checkpoint(stop_signal, "starting query processor");
-            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 256};
             debug::the_query_processor = &qp;
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
 
@@ -1359,7 +1394,8 @@ sharded<locator::shared_token_metadata> token_metadata;
 
             checkpoint(stop_signal, "creating tracing");
             sharded<tracing::tracing>& tracing = tracing::tracing::tracing_instance();
-            tracing.start(sstring("trace_keyspace_helper")).get();
+            auto tracing_backend = cfg->tracing_backend() == "ring_buffer" ? sstring(tracing::trace_ring_buffer_helper::CLASS_NAME) : sstring("trace_keyspace_helper");
+            tracing.start(std::move(tracing_backend), size_t(cfg->tracing_ring_buffer_records())).get();
             auto destroy_tracing = defer_verbose_shutdown("tracing instance", [&tracing] {
                 tracing.stop().get();
             });
@@ -1486,6 +1522,10 @@ sharded<locator::shared_token_metadata> token_metadata;
                     .algo_config = cfg->internode_compression_algorithms,
                     .register_metrics = cfg->internode_compression_enable_advanced(),
                     .checksumming = cfg->internode_compression_checksumming,
+                    .adaptive = cfg->internode_compression_adaptive,
+                    .adaptive_raw_max_msg_size = cfg->internode_compression_adaptive_raw_max_message_size,
+                    .adaptive_local_byte_cost_nanos = cfg->internode_compression_adaptive_local_byte_cost_ns,
+                    .adaptive_remote_byte_cost_nanos = cfg->internode_compression_adaptive_remote_byte_cost_ns,
                 };
             };
             static sharded<utils::walltime_compressor_tracker> compressor_tracker;
@@ -1618,6 +1658,7 @@ sharded<locator::shared_token_metadata> token_metadata;
                 gcfg.failure_detector_timeout_ms = cfg->failure_detector_timeout_in_ms;
                 gcfg.force_gossip_generation = cfg->force_gossip_generation;
                 gcfg.recovery_leader = cfg->recovery_leader;
+                gcfg.message_size_metrics = cfg->gossip_message_size_metrics;
                 return gcfg;
             });
 
@@ -1663,7 +1704,9 @@ sharded<locator::shared_token_metadata> token_metadata;
             });
 
             checkpoint(stop_signal, "starting Raft Group");
-            raft_gr.start(raft::server_id{host_id.id}, std::ref(messaging), std::ref(fd)).get();
+            raft_gr.start(raft::server_id{host_id.id}, std::ref(messaging), std::ref(fd), std::ref(feature_service), sharded_parameter([&cfg] {
+                return utils::updateable_value<uint32_t>(cfg->raft_message_coalescing_window_in_us);
+            })).get();
 
             // group0 client exists only on shard 0.
             // The client has to be created before `stop_raft` since during
@@ -1846,7 +1889,7 @@ sharded<locator::shared_token_metadata> token_metadata;
 
             checkpoint(stop_signal, "initializing virtual tables");
             smp::invoke_on_all([&] {
-                return db::initialize_virtual_tables(db, ss, gossiper, raft_gr, sys_ks, tablet_allocator, messaging, *cfg);
+                return db::initialize_virtual_tables(db, ss, gossiper, raft_gr, sys_ks, tablet_allocator, messaging, proxy, *cfg);
             }).get();
 
             // #293 - do not stop anything
@@ -1883,19 +1926,10 @@ sharded<locator::shared_token_metadata> token_metadata;
             });
 
             cm.invoke_on_all([&](compaction_manager& cm) {
-                auto cl = db.local().commitlog();
-                auto scl = db.local().schema_commitlog();
-                if (cl && scl) {
-                    cm.get_shared_tombstone_gc_state().set_gc_time_min_source([cl, scl](const table_id& id) {
-                        return std::min(cl->min_gc_time(id), scl->min_gc_time(id));
-                    });
-                } else if (cl) {
-                    cm.get_shared_tombstone_gc_state().set_gc_time_min_source([cl](const table_id& id) {
-                        return cl->min_gc_time(id);
-                    });
-                } else if (scl) {
-                    cm.get_shared_tombstone_gc_state().set_gc_time_min_source([scl](const table_id& id) {
-                        return scl->min_gc_time(id);
+                auto& local_db = db.local();
+                if (local_db.commitlog() || local_db.schema_commitlog()) {
+                    cm.get_shared_tombstone_gc_state().set_gc_time_min_source([&local_db](const table_id& id) {
+                        return local_db.commitlog_min_gc_time(id);
                     });
                 }
             }).get();
@@ -1927,7 +1961,7 @@ sharded<locator::shared_token_metadata> token_metadata;
                 [] { std::raise(SIGSTOP); });
 
             if (cl != nullptr) {
-                auto paths = cl->get_segments_to_replay().get();
+                auto paths = db.local().get_commitlog_segments_to_replay().get();
                 if (!paths.empty()) {
                     checkpoint(stop_signal, "replaying commit log");
                     auto rp = db::commitlog_replayer::create_replayer(db, sys_ks).get();
@@ -2370,6 +2404,25 @@ sharded<locator::shared_token_metadata> token_metadata;
             );
             cf_cache_hitrate_calculator.local().run_on(this_shard_id());
 
+            checkpoint(stop_signal, "starting row cache warmer");
+            static sharded<db::cache_warmer> cache_warmer;
+            db::cache_warmer::config cache_warmer_cfg = {
+                .directory = std::filesystem::path(cfg->saved_caches_directory()),
+                .keys_to_save = cfg->row_cache_keys_to_save(),
+                .save_period = std::chrono::seconds(cfg->row_cache_save_period()),
+                .sched_group = dbcfg.streaming_scheduling_group,
+            };
+            cache_warmer.start(std::ref(db), cache_warmer_cfg).get();
+            auto stop_cache_warmer = defer_verbose_shutdown("row cache warmer", [] {
+                cache_warmer.stop().get();
+            });
+            cache_warmer.invoke_on_all(&db::cache_warmer::start).get();
+
+            api::set_server_cache_warmer(ctx, cache_warmer).get();
+            auto stop_cache_warmer_api = defer_verbose_shutdown("row cache warmer API", [&ctx] {
+                api::unset_server_cache_warmer(ctx).get();
+            });
+
             checkpoint(stop_signal, "starting view update backlog broker");
             static sharded<service::view_update_backlog_broker> view_backlog_broker;
             view_backlog_broker.start(std::ref(proxy), std::ref(gossiper)).get();
@@ -2504,7 +2557,7 @@ sharded<locator::shared_token_metadata> token_metadata;
             }
 
             stop_signal.ready();
-            supervisor::notify("serving");
+            supervisor::notify(supervisor::serving_msg);
 
             startlog.info("Scylla version {} initialization completed.", scylla_version());
             if (after_init_func) {
@@ -2581,6 +2634,7 @@ int main(int ac, char** av) {
         {"perf-load-balancing", perf::scylla_tablet_load_balancing_main, "run tablet load balancer tests"},
         {"perf-simple-query", perf::scylla_simple_query_main, "run performance tests by sending simple queries to this server"},
         {"perf-sstable", perf::scylla_sstable_main, "run performance tests by exercising sstable related operations on this server"},
+        {"perf-sustained-write", perf::scylla_sustained_write_main, "run performance tests of the write path in steady state, with commitlog, flushes and compaction, on this server"},
         {"perf-alternator", perf::alternator(scylla_main, &after_init_func), "run performance tests on full alternator stack"}
     };
 
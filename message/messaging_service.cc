@@ -153,38 +153,60 @@ using namespace std::chrono_literals;
 class messaging_service::compressor_factory_wrapper {
     struct advanced_rpc_compressor_factory : rpc::compressor::factory {
         utils::walltime_compressor_tracker& _tracker;
-        advanced_rpc_compressor_factory(utils::walltime_compressor_tracker& tracker)
+        utils::connection_class _class;
+        advanced_rpc_compressor_factory(utils::walltime_compressor_tracker& tracker, utils::connection_class cls)
             : _tracker(tracker)
+            , _class(cls)
         {}
         const sstring& supported() const override {
             return _tracker.supported();
         }
         std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server, std::function<future<>()> send_empty_frame) const override {
-            return _tracker.negotiate(std::move(feature), is_server, std::move(send_empty_frame));
+            return _tracker.negotiate(std::move(feature), is_server, std::move(send_empty_frame), _class);
         }
         std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server) const override {
             assert(false && "negotiate() without send_empty_frame shouldn't happen");
             return nullptr;
         }
     };
+    // The advanced compressor learns its algorithm choice and keeps its metrics per connection class,
+    // so each class needs its own factory.
+    struct per_class_factory {
+        advanced_rpc_compressor_factory _arcf;
+        rpc::multi_algo_compressor_factory _multi_factory;
+        per_class_factory(compressor_factory_wrapper& w, utils::connection_class cls)
+            : _arcf(w._tracker, cls)
+            , _multi_factory(w._enable_advanced ? rpc::multi_algo_compressor_factory{
+                &_arcf,
+                &w._lz4_fragmented_compressor_factory,
+                &w._lz4_compressor_factory,
+            } : rpc::multi_algo_compressor_factory{
+                &w._lz4_fragmented_compressor_factory,
+                &w._lz4_compressor_factory,
+            })
+        {}
+    };
+    utils::walltime_compressor_tracker& _tracker;
+    bool _enable_advanced;
     rpc::lz4_fragmented_compressor::factory _lz4_fragmented_compressor_factory;
     rpc::lz4_compressor::factory _lz4_compressor_factory;
-    advanced_rpc_compressor_factory _arcf;
-    rpc::multi_algo_compressor_factory _multi_factory;
+    // Keyed by connection_class::key(). Factories are referenced by rpc clients and servers, so they are never removed.
+    std::unordered_map<uint64_t, std::unique_ptr<per_class_factory>> _factories;
 public:
-    compressor_factory_wrapper(decltype(advanced_rpc_compressor_factory::_tracker) t, bool enable_advanced)
-        : _arcf(t)
-        , _multi_factory(enable_advanced ? rpc::multi_algo_compressor_factory{
-            &_arcf,
-            &_lz4_fragmented_compressor_factory,
-            &_lz4_compressor_factory,
-        } : rpc::multi_algo_compressor_factory{
-            &_lz4_fragmented_compressor_factory,
-            &_lz4_compressor_factory,
-        })
+    compressor_factory_wrapper(utils::walltime_compressor_tracker& t, bool enable_advanced)
+        : _tracker(t)
+        , _enable_advanced(enable_advanced)
     {}
-    seastar::rpc::compressor::factory& get_factory() {
-        return _multi_factory;
+    seastar::rpc::compressor::factory& get_factory(utils::connection_class cls) {
+        if (!_enable_advanced) {
+            // The old compressors don't care about the class.
+            cls = {};
+        }
+        auto& f = _factories[cls.key()];
+        if (!f) {
+            f = std::make_unique<per_class_factory>(*this, cls);
+        }
+        return f->_multi_factory;
     }
 };
 
@@ -389,7 +411,11 @@ void messaging_service::do_start_listen() {
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != broadcast_address;
     rpc::server_options so;
     if (_cfg.compress != compress_what::none) {
-        so.compressor_factory = &_compressor_factory_wrapper->get_factory();
+        // The server can't tell the index of an incoming connection at negotiation time.
+        // With `dc` compression, only clients from other DCs request compression.
+        so.compressor_factory = &_compressor_factory_wrapper->get_factory(utils::connection_class{
+            .cross_dc = _cfg.compress == compress_what::dc,
+        });
     }
     so.load_balancing_algorithm = server_socket::load_balancing_algorithm::port;
 
@@ -674,6 +700,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::RAFT_EXECUTE_READ_BARRIER_ON_LEADER:
     case messaging_verb::RAFT_ADD_ENTRY:
     case messaging_verb::RAFT_MODIFY_CONFIG:
+    case messaging_verb::RAFT_MESSAGE_BATCH:
     case messaging_verb::RAFT_PULL_SNAPSHOT:
         // See comment above `TOPOLOGY_INDEPENDENT_IDX`.
         // DO NOT put any 'hot' (e.g. data path) verbs in this group,
@@ -707,8 +734,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::REPAIR_FLUSH_HINTS_BATCHLOG:
     case messaging_verb::REPAIR_UPDATE_COMPACTION_CTRL:
     case messaging_verb::REPAIR_UPDATE_REPAIRED_AT_FOR_MERGE:
+    case messaging_verb::REPAIR_GET_ROW_HASH_TREE_NODES:
+    case messaging_verb::REPAIR_GET_ROW_HASHES_IN_HASH_TREE_NODES:
     case messaging_verb::NODE_OPS_CMD:
     case messaging_verb::HINT_MUTATION:
+    case messaging_verb::HINT_MUTATION_BATCH:
     case messaging_verb::TABLET_STREAM_FILES:
     case messaging_verb::TABLET_STREAM_DATA:
     case messaging_verb::TABLET_CLEANUP:
@@ -720,9 +750,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
+    case messaging_verb::READ_DIGEST_MULTI:
     case messaging_verb::DEFINITIONS_UPDATE:
     case messaging_verb::TRUNCATE:
     case messaging_verb::TRUNCATE_WITH_TABLETS:
@@ -1135,7 +1167,10 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     // send keepalive messages each minute if connection is idle, drop connection after 10 failures
     opts.keepalive = std::optional<net::tcp_keepalive_params>({60s, 60s, 10});
     if (must_compress) {
-        opts.compressor_factory = &_compressor_factory_wrapper->get_factory();
+        opts.compressor_factory = &_compressor_factory_wrapper->get_factory(utils::connection_class{
+            .index = idx,
+            .cross_dc = !has_topology() || !is_same_dc(id.addr),
+        });
     }
     opts.tcp_nodelay = must_tcp_nodelay;
     opts.reuseaddr = true;
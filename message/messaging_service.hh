@@ -210,7 +210,13 @@ enum class messaging_verb : int32_t {
     REPAIR_UPDATE_COMPACTION_CTRL = 81,
     REPAIR_UPDATE_REPAIRED_AT_FOR_MERGE = 82,
     WORK_ON_VIEW_BUILDING_TASKS = 83,
-    LAST = 84,
+    MUTATION_BATCH = 84,
+    READ_DIGEST_MULTI = 85,
+    REPAIR_GET_ROW_HASH_TREE_NODES = 86,
+    REPAIR_GET_ROW_HASHES_IN_HASH_TREE_NODES = 87,
+    HINT_MUTATION_BATCH = 88,
+    RAFT_MESSAGE_BATCH = 89,
+    LAST = 90,
 };
 
 } // namespace netw
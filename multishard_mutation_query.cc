@@ -775,6 +775,8 @@ future<foreign_ptr<lw_shared_ptr<typename ResultBuilder::result_type>>> do_query
             auto last_pos = *r.compaction_state->current_full_position();
             co_await ctx->save_readers(std::move(r.unconsumed_fragments), std::move(*r.compaction_state).detach_state(), std::move(last_pos));
         }
+        // do_query_tablets() goes through table::query(), which accounts its reads itself.
+        ResultBuilder::note_read(table, ranges, r.result);
         co_return make_foreign(make_lw_shared<typename ResultBuilder::result_type>(std::move(r.result)));
     }));
     co_await ctx->stop();
@@ -909,6 +911,7 @@ class mutation_query_result_builder {
     }
 
     static void maybe_set_last_position(result_type& r, std::optional<full_position> full_position) { }
+    static void note_read(replica::table&, const dht::partition_range_vector&, const result_type&) { }
     static uint32_t get_partition_count(result_type& r) { return r.partitions().size(); }
     static uint64_t get_row_count(result_type& r) { return r.row_count(); }
 };
@@ -969,6 +972,9 @@ class data_query_result_builder {
     static void maybe_set_last_position(result_type& r, std::optional<full_position> full_position) {
         r.set_last_position(std::move(full_position));
     }
+    static void note_read(replica::table& t, const dht::partition_range_vector& ranges, const result_type& r) {
+        t.note_read(ranges, r.buf().size());
+    }
     static uint32_t get_partition_count(result_type& r) {
         r.ensure_counts();
         return *r.partition_count();
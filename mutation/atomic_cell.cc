@@ -10,46 +10,114 @@
 #include "atomic_cell_or_collection.hh"
 #include "counters.hh"
 #include "types/types.hh"
+#include "utils/allocation_strategy.hh"
+
+// Values are interned only in LSA, copies in the standard allocator may
+// outlive the pool.
+static cell_value_pool* current_value_pool() noexcept {
+    auto pool = cell_value_pool::current();
+    return pool && &current_allocator() != &standard_allocator() ? pool : nullptr;
+}
+
+template <FragmentRange Buffer>
+static const interned_cell_value* maybe_intern(const abstract_type& type, const Buffer& value, atomic_cell::collection_member cm) {
+    // Cells of collections are serialized together with the collection.
+    if (cm) {
+        return nullptr;
+    }
+    auto pool = current_value_pool();
+    if (!pool || !cell_value_pool::can_intern(type, value.size_bytes())) {
+        return nullptr;
+    }
+    return pool->intern(value);
+}
+
+// Copies an atomic cell to the current allocator, interning its value
+// in the current pool or materializing it as needed.
+static managed_bytes copy_atomic_cell(const abstract_type& type, managed_bytes_view cell) {
+    auto pool = current_value_pool();
+    bool interned = atomic_cell_type::is_interned(cell);
+    if (!pool) {
+        return interned ? atomic_cell_type::materialize(cell) : managed_bytes(cell);
+    }
+    if (interned && atomic_cell_type::interned_value(cell)->pool() == pool) {
+        return managed_bytes(cell);
+    }
+    auto acv = atomic_cell_view::from_bytes(type, cell);
+    if (acv.is_live() && !acv.is_counter_update()) {
+        auto value = acv.value();
+        if (cell_value_pool::can_intern(type, value.size())) {
+            if (auto v = pool->intern(fragment_range(value))) {
+                return atomic_cell_type::intern(cell, v);
+            }
+        }
+    }
+    return interned ? atomic_cell_type::materialize(cell) : managed_bytes(cell);
+}
 
 atomic_cell atomic_cell::make_dead(api::timestamp_type timestamp, gc_clock::time_point deletion_time) {
     return atomic_cell_type::make_dead(timestamp, deletion_time);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, bytes_view value, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, single_fragment_range(value), cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v);
+    }
     return atomic_cell_type::make_live(timestamp, single_fragment_range(value));
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, managed_bytes_view value, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, fragment_range(value), cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v);
+    }
     return atomic_cell_type::make_live(timestamp, fragment_range(value));
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, ser::buffer_view<bytes_ostream::fragment_iterator> value, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, value, cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v);
+    }
     return atomic_cell_type::make_live(timestamp, value);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, const fragmented_temporary_buffer::view& value, collection_member cm)
 {
+    if (auto v = maybe_intern(type, value, cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v);
+    }
     return atomic_cell_type::make_live(timestamp, value);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, bytes_view value,
                              gc_clock::time_point expiry, gc_clock::duration ttl, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, single_fragment_range(value), cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v, expiry, ttl);
+    }
     return atomic_cell_type::make_live(timestamp, single_fragment_range(value), expiry, ttl);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, managed_bytes_view value,
                              gc_clock::time_point expiry, gc_clock::duration ttl, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, fragment_range(value), cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v, expiry, ttl);
+    }
     return atomic_cell_type::make_live(timestamp, fragment_range(value), expiry, ttl);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, ser::buffer_view<bytes_ostream::fragment_iterator> value,
                              gc_clock::time_point expiry, gc_clock::duration ttl, atomic_cell::collection_member cm) {
+    if (auto v = maybe_intern(type, value, cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v, expiry, ttl);
+    }
     return atomic_cell_type::make_live(timestamp, value, expiry, ttl);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, const fragmented_temporary_buffer::view& value,
                                    gc_clock::time_point expiry, gc_clock::duration ttl, collection_member cm)
 {
+    if (auto v = maybe_intern(type, value, cm)) {
+        return atomic_cell_type::make_live_interned(timestamp, v, expiry, ttl);
+    }
     return atomic_cell_type::make_live(timestamp, value, expiry, ttl);
 }
 
@@ -62,7 +130,7 @@ atomic_cell atomic_cell::make_live_uninitialized(const abstract_type& type, api:
 }
 
 atomic_cell::atomic_cell(const abstract_type& type, atomic_cell_view other)
-    : _data(other._view) {
+    : _data(copy_atomic_cell(type, other._view)) {
     set_view(_data);
 }
 
@@ -125,11 +193,14 @@ atomic_cell_or_collection atomic_cell_or_collection::copy(const abstract_type& t
     if (_data.empty()) {
         return atomic_cell_or_collection();
     }
+    if (type.is_atomic()) {
+        return atomic_cell_or_collection(copy_atomic_cell(type, _data));
+    }
     return atomic_cell_or_collection(managed_bytes(_data));
 }
 
 atomic_cell_or_collection::atomic_cell_or_collection(const abstract_type& type, atomic_cell_view acv)
-    : _data(acv._view)
+    : _data(copy_atomic_cell(type, acv._view))
 {
 }
 
@@ -18,6 +18,7 @@
 #include <seastar/util/bool_class.hh>
 #include <cstdint>
 #include "utils/fragmented_temporary_buffer.hh"
+#include "mutation/cell_value_pool.hh"
 
 #include "serializer.hh"
 
@@ -69,12 +70,16 @@ static T get_field(Input in, unsigned offset = 0) {
  *
  *  <live>  := <int8_t:flags><int64_t:timestamp>(<int64_t:expiry><int32_t:ttl>)?<value>
  *  <dead>  := <int8_t:    0><int64_t:timestamp><int64_t:deletion_time>
+ *
+ * When INTERNED_FLAG is set, <value> is a pointer to an interned_cell_value
+ * which holds the value, see cell_value_pool.
  */
 class atomic_cell_type final {
 private:
     static constexpr int8_t LIVE_FLAG = 0x01;
     static constexpr int8_t EXPIRY_FLAG = 0x02; // When present, expiry field is present. Set only for live cells
     static constexpr int8_t COUNTER_UPDATE_FLAG = 0x08; // Cell is a counter update.
+    static constexpr int8_t INTERNED_FLAG = 0x10; // The value is interned. Set only for live cells
     static constexpr unsigned flags_size = 1;
     static constexpr unsigned timestamp_offset = flags_size;
     static constexpr unsigned timestamp_size = 8;
@@ -108,10 +113,21 @@ class atomic_cell_type final {
     // Can be called on live cells only
 private:
     template <mutable_view is_mutable>
-    static managed_bytes_basic_view<is_mutable> do_get_value(managed_bytes_basic_view<is_mutable> cell) {
+    static unsigned get_value_offset(managed_bytes_basic_view<is_mutable> cell) {
         auto expiry_field_size = bool(cell.front() & EXPIRY_FLAG) * (expiry_size + ttl_size);
-        auto value_offset = flags_size + timestamp_size + expiry_field_size;
-        cell.remove_prefix(value_offset);
+        return flags_size + timestamp_size + expiry_field_size;
+    }
+    template <mutable_view is_mutable>
+    static managed_bytes_basic_view<is_mutable> do_get_value(managed_bytes_basic_view<is_mutable> cell) {
+        bool interned = cell.front() & INTERNED_FLAG;
+        cell.remove_prefix(get_value_offset(cell));
+        if (interned) {
+            auto v = reinterpret_cast<const interned_cell_value*>(get_field<uint64_t>(cell))->value();
+            // Interned values are shared and must not be modified. Only counter
+            // cells are modified in place, and they are never interned.
+            using fragment_type = typename managed_bytes_basic_view<is_mutable>::fragment_type;
+            return managed_bytes_basic_view<is_mutable>(fragment_type(const_cast<bytes_view::value_type*>(v.data()), v.size()));
+        }
         return cell;
     }
 public:
@@ -176,6 +192,53 @@ class atomic_cell_type final {
         set_value(b, value_offset, value);
         return b;
     }
+    static managed_bytes make_live_interned(api::timestamp_type timestamp, const interned_cell_value* value) {
+        auto value_offset = flags_size + timestamp_size;
+        managed_bytes b(managed_bytes::initialized_later(), value_offset + sizeof(uint64_t));
+        b[0] = LIVE_FLAG | INTERNED_FLAG;
+        set_field(b, timestamp_offset, timestamp);
+        set_field(b, value_offset, uint64_t(reinterpret_cast<uintptr_t>(value)));
+        return b;
+    }
+    static managed_bytes make_live_interned(api::timestamp_type timestamp, const interned_cell_value* value, gc_clock::time_point expiry, gc_clock::duration ttl) {
+        auto value_offset = flags_size + timestamp_size + expiry_size + ttl_size;
+        managed_bytes b(managed_bytes::initialized_later(), value_offset + sizeof(uint64_t));
+        b[0] = EXPIRY_FLAG | LIVE_FLAG | INTERNED_FLAG;
+        set_field(b, timestamp_offset, timestamp);
+        set_field(b, expiry_offset, static_cast<int64_t>(expiry.time_since_epoch().count()));
+        set_field(b, ttl_offset, static_cast<int32_t>(ttl.count()));
+        set_field(b, value_offset, uint64_t(reinterpret_cast<uintptr_t>(value)));
+        return b;
+    }
+    // Makes a copy of a live cell with an interned value.
+    static managed_bytes intern(atomic_cell_value_view cell, const interned_cell_value* value) {
+        auto offset = get_value_offset(cell);
+        managed_bytes b(managed_bytes::initialized_later(), offset + sizeof(uint64_t));
+        auto out = managed_bytes_mutable_view(b);
+        write_fragmented(out, cell.prefix(offset));
+        b[0] |= INTERNED_FLAG;
+        set_field(b, offset, uint64_t(reinterpret_cast<uintptr_t>(value)));
+        return b;
+    }
+    // Makes a copy of an interned cell which holds the value itself.
+    static managed_bytes materialize(atomic_cell_value_view cell) {
+        auto offset = get_value_offset(cell);
+        auto v = value(cell);
+        managed_bytes b(managed_bytes::initialized_later(), offset + v.size());
+        auto out = managed_bytes_mutable_view(b);
+        write_fragmented(out, cell.prefix(offset));
+        write_fragmented(out, v);
+        b[0] &= ~INTERNED_FLAG;
+        return b;
+    }
+    static bool is_interned(atomic_cell_value_view cell) {
+        return cell.front() & INTERNED_FLAG;
+    }
+    // Can be called only when is_interned() is true.
+    static const interned_cell_value* interned_value(atomic_cell_value_view cell) {
+        cell.remove_prefix(get_value_offset(cell));
+        return reinterpret_cast<const interned_cell_value*>(get_field<uint64_t>(cell));
+    }
     static managed_bytes make_live_uninitialized(api::timestamp_type timestamp, size_t size) {
         auto value_offset = flags_size + timestamp_size;
         managed_bytes b(managed_bytes::initialized_later(), value_offset + size);
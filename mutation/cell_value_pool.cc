@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "mutation/cell_value_pool.hh"
+#include "types/types.hh"
+
+thread_local cell_value_pool* cell_value_pool::_current = nullptr;
+
+bool cell_value_pool::can_intern(const abstract_type& type, size_t size) noexcept {
+    // Counter cells are updated in place.
+    return size >= min_value_size && size <= max_value_size && !type.is_counter();
+}
+
+const interned_cell_value* cell_value_pool::intern(bytes_view value) noexcept {
+    if (auto it = _values.find(value); it != _values.end()) {
+        ++_stats.hits;
+        return it->second.get();
+    }
+    // Approximates the overhead of a node of the map.
+    static constexpr size_t node_overhead = 4 * sizeof(void*);
+    auto memory = node_overhead + sizeof(interned_cell_value) + value.size();
+    if (_stats.memory + memory > _max_memory) {
+        ++_stats.rejections;
+        return nullptr;
+    }
+    try {
+        auto v = std::make_unique<interned_cell_value>(this, value);
+        auto it = _values.emplace(v->value(), std::move(v)).first;
+        ++_stats.misses;
+        ++_stats.values;
+        _stats.memory += memory;
+        return it->second.get();
+    } catch (const std::bad_alloc&) {
+        ++_stats.rejections;
+        return nullptr;
+    }
+}
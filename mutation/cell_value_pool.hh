@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include "bytes.hh"
+#include "utils/fragment_range.hh"
+
+class abstract_type;
+class cell_value_pool;
+
+// An immutable value shared by the cells which were interned in the pool.
+class interned_cell_value {
+    const cell_value_pool* _pool;
+    bytes _value;
+public:
+    interned_cell_value(const cell_value_pool* pool, bytes_view value)
+        : _pool(pool), _value(value) { }
+    const cell_value_pool* pool() const noexcept { return _pool; }
+    bytes_view value() const noexcept { return _value; }
+};
+
+// Interns small values of the live atomic cells of a table in the memtables
+// and in the row cache, so that cells with identical values share one copy
+// of it. See caching_options::intern_values().
+//
+// The interned values live in the standard allocator, outside of LSA, so
+// that the cells don't have to be updated when the values are migrated.
+// They are never freed individually: the cells don't keep reference counts,
+// and the pool has to outlive all the cells which point to it, so it is
+// owned by the table and released together with its memtables and cache.
+// The pool is bounded, once full, new values are stored inline in the cells.
+//
+// Only cells in LSA are interned. Copies of interned cells to the standard
+// allocator are made self-contained.
+class cell_value_pool {
+public:
+    static constexpr size_t min_value_size = 16;
+    static constexpr size_t max_value_size = 64;
+    static constexpr size_t default_max_memory = 1 << 20;
+
+    struct stats {
+        uint64_t values = 0;
+        uint64_t memory = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t rejections = 0;
+    };
+private:
+    std::unordered_map<bytes_view, std::unique_ptr<interned_cell_value>> _values;
+    size_t _max_memory;
+    stats _stats;
+    static thread_local cell_value_pool* _current;
+public:
+    explicit cell_value_pool(size_t max_memory = default_max_memory) noexcept
+        : _max_memory(max_memory) { }
+    cell_value_pool(cell_value_pool&&) = delete;
+
+    // Whether values of the type and size are worth interning.
+    static bool can_intern(const abstract_type& type, size_t size) noexcept;
+
+    // Returns the shared copy of the value, nullptr if the pool is full
+    // or failed to allocate.
+    const interned_cell_value* intern(bytes_view value) noexcept;
+    template <FragmentRange Buffer>
+    const interned_cell_value* intern(const Buffer& value) noexcept {
+        if (value.size_bytes() > max_value_size) {
+            return nullptr;
+        }
+        std::array<bytes_view::value_type, max_value_size> buf;
+        auto out = buf.data();
+        for (bytes_view frag : value) {
+            out = std::copy(frag.begin(), frag.end(), out);
+        }
+        return intern(bytes_view(buf.data(), value.size_bytes()));
+    }
+
+    const stats& get_stats() const noexcept { return _stats; }
+
+    // The pool in which the cells created in LSA are interned, if any.
+    static cell_value_pool* current() noexcept { return _current; }
+
+    // Sets the current pool for the duration of the scope. A null pool
+    // disables interning.
+    class scope {
+        cell_value_pool* _prev;
+    public:
+        explicit scope(cell_value_pool* pool) noexcept : _prev(std::exchange(_current, pool)) { }
+        scope(const scope&) = delete;
+        ~scope() { _current = _prev; }
+    };
+};
@@ -113,6 +113,24 @@ class mutation_compactor_garbage_collector : public compaction_garbage_collector
     }
 };
 
+/// Tells whether a data source may contain tombstones or expiring cells.
+///
+/// Owned by the data source, which sets it before any such data becomes
+/// visible to its readers, and never clears it. Query compactors of the
+/// source's readers check it on each row, so that they can pass the rows
+/// through without compacting them while nothing in the source can be dead
+/// or expire, e.g. in insert-only tables.
+class dead_data_hint {
+    bool _may_have_dead_data = false;
+public:
+    bool may_have_dead_data() const noexcept {
+        return _may_have_dead_data;
+    }
+    void set_may_have_dead_data() noexcept {
+        _may_have_dead_data = true;
+    }
+};
+
 struct compaction_stats {
     struct row_stats {
         uint64_t live = 0;
@@ -199,6 +217,7 @@ class compact_mutation_state {
 
     compaction_stats _stats;
     tombstone_purge_stats* _tombstone_stats = nullptr;
+    lw_shared_ptr<const dead_data_hint> _dead_data_hint;
 
     mutation_fragment_stream_validating_filter _validator;
 
@@ -237,6 +256,13 @@ class compact_mutation_state {
         return SSTableCompaction == compact_for_sstables::yes;
     }
 
+    // Rows which no tombstone applies to can be passed through as they are
+    // if none of their cells can be dead or expire.
+    bool can_pass_through(row_tombstone row_tomb) const noexcept {
+        return !sstable_compaction() && _dead_data_hint && !_dead_data_hint->may_have_dead_data()
+            && !_partition_tombstone && !_effective_tombstone && !row_tomb;
+    }
+
     template <typename GCConsumer>
     void partition_is_not_empty_for_gc_consumer(GCConsumer& gc_consumer) {
         if (_empty_partition_in_gc_consumer) {
@@ -405,6 +431,23 @@ class compact_mutation_state {
         _current_emitted_gc_tombstone = {};
     }
 
+    template <typename Consumer>
+    requires CompactedFragmentsConsumer<Consumer>
+    stop_iteration consume_live(clustering_row&& cr, Consumer& consumer) {
+        // The marker and cells are all live and not expiring.
+        const bool marker_is_live = !cr.marker().is_missing();
+        _stats.clustering_rows.add_row(compact_and_expire_result{.live_cells = cr.cells().size()}, marker_is_live);
+        const auto is_live = marker_is_live || !cr.cells().empty();
+        if (!cr.empty()) {
+            partition_is_not_empty(consumer);
+            _stop = consumer.consume(std::move(cr), row_tombstone(), is_live);
+        }
+        if (is_live && ++_rows_in_current_partition == _current_partition_limit) {
+            _stop = stop_iteration::yes;
+        }
+        return _stop;
+    }
+
     template <typename Consumer, typename GCConsumer>
     requires CompactedFragmentsConsumer<Consumer> && CompactedFragmentsConsumer<GCConsumer>
     void consume(tombstone t, Consumer& consumer, GCConsumer& gc_consumer) {
@@ -429,25 +472,31 @@ class compact_mutation_state {
         _last_static_row = static_row(_schema, sr);
         _last_pos = position_in_partition(position_in_partition::static_row_tag_t());
         auto current_tombstone = _partition_tombstone;
-        if constexpr (sstable_compaction()) {
-            _collector->start_collecting_static_row();
-        }
-        auto gc_before = get_gc_before();
-        auto res = sr.cells().compact_and_expire(_schema, column_kind::static_column, row_tombstone(current_tombstone),
-                _query_time, _can_gc, gc_before, _collector.get());
-        _stats.static_rows.add_row(res);
-        const auto is_live = res.is_live();
-        if constexpr (sstable_compaction()) {
-            _collector->consume_static_row([this, &gc_consumer, current_tombstone] (static_row&& sr_garbage) {
-                partition_is_not_empty_for_gc_consumer(gc_consumer);
-                // We are passing only dead (purged) data so pass is_live=false.
-                gc_consumer.consume(std::move(sr_garbage), current_tombstone, false);
-            });
+        compact_and_expire_result res;
+        if (can_pass_through({})) {
+            res.live_cells = sr.cells().size();
+            _stats.static_rows.add_row(res);
         } else {
-            if (can_purge_tombstone(current_tombstone)) {
-                current_tombstone = {};
+            if constexpr (sstable_compaction()) {
+                _collector->start_collecting_static_row();
+            }
+            auto gc_before = get_gc_before();
+            res = sr.cells().compact_and_expire(_schema, column_kind::static_column, row_tombstone(current_tombstone),
+                    _query_time, _can_gc, gc_before, _collector.get());
+            _stats.static_rows.add_row(res);
+            if constexpr (sstable_compaction()) {
+                _collector->consume_static_row([this, &gc_consumer, current_tombstone] (static_row&& sr_garbage) {
+                    partition_is_not_empty_for_gc_consumer(gc_consumer);
+                    // We are passing only dead (purged) data so pass is_live=false.
+                    gc_consumer.consume(std::move(sr_garbage), current_tombstone, false);
+                });
+            } else {
+                if (can_purge_tombstone(current_tombstone)) {
+                    current_tombstone = {};
+                }
             }
         }
+        const auto is_live = res.is_live();
         _static_row_live = is_live;
         if (is_live || !sr.empty()) {
             partition_is_not_empty(consumer);
@@ -463,6 +512,9 @@ class compact_mutation_state {
         if (!sstable_compaction()) {
             _last_pos = cr.position();
         }
+        if (can_pass_through(cr.tomb())) {
+            return consume_live(std::move(cr), consumer);
+        }
         auto current_tombstone = std::max(_partition_tombstone, _effective_tombstone);
         auto t = cr.tomb();
         t.apply(current_tombstone);
@@ -681,6 +733,13 @@ class compact_mutation_state {
     }
 
     const compaction_stats& stats() const { return _stats; }
+
+    /// Lets the compactor pass rows through without compacting them while the
+    /// hint says that their source has no dead data. Only for queries.
+    void set_dead_data_hint(lw_shared_ptr<const dead_data_hint> hint) noexcept {
+        static_assert(!sstable_compaction(), "Compaction for sstables has to purge the data.");
+        _dead_data_hint = std::move(hint);
+    }
 };
 
 template<compact_for_sstables SSTableCompaction, typename Consumer, typename GCConsumer>
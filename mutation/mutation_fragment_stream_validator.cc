@@ -33,6 +33,7 @@ static mutation_fragment_v2::kind to_mutation_fragment_kind_v2(mutation_fragment
 
 mutation_fragment_stream_validator::mutation_fragment_stream_validator(const ::schema& s)
     : _schema(s)
+    , _pos_cmp(s)
     , _prev_kind(mutation_fragment_v2::kind::partition_end)
     , _prev_pos(position_in_partition::end_of_partition_tag_t{})
     , _prev_partition_key(dht::minimum_token(), partition_key::make_empty()) {
@@ -122,8 +123,7 @@ mutation_fragment_stream_validator::validate(mutation_fragment_v2::kind kind, st
     }
 
     if (pos && _prev_kind != mutation_fragment_v2::kind::partition_end) {
-        auto cmp = position_in_partition::tri_compare(_schema);
-        auto res = cmp(_prev_pos, *pos);
+        auto res = _pos_cmp(_prev_pos, *pos);
         if (_prev_kind == mutation_fragment_v2::kind::range_tombstone_change) {
             valid = res <= 0;
         } else {
@@ -40,6 +40,7 @@ class mutation_fragment_stream_validator {
 
 private:
     const ::schema& _schema;
+    position_in_partition::tri_compare _pos_cmp;
     mutation_fragment_v2::kind _prev_kind;
     position_in_partition _prev_pos;
     dht::decorated_key _prev_partition_key;
@@ -1933,11 +1933,59 @@ void mutation_querier::prepare_writers() {
     }
 }
 
-stop_iteration mutation_querier::consume(clustering_row&& cr, row_tombstone current_tombstone) {
-    prepare_writers();
+bool mutation_querier::matches_row_filter(const row& cells) const {
+    for (const auto& p : _pw.slice().row_filter()) {
+        if (p.column >= _schema.regular_columns_count()) {
+            continue;
+        }
+        const column_definition& def = _schema.regular_column_at(p.column);
+        if (!def.is_atomic() || def.is_counter()) {
+            // The coordinator doesn't send such predicates, let it evaluate them.
+            continue;
+        }
+        const atomic_cell_or_collection* cell = cells.find_cell(p.column);
+        if (!cell) {
+            return false;
+        }
+        auto c = cell->as_atomic_cell(def);
+        if (!c.is_live()) {
+            return false;
+        }
+        auto value = c.value();
+        const abstract_type& type = *def.type;
+        auto matches = [&] (const bytes& v) {
+            switch (p.oper) {
+            case query::cell_predicate::op::eq:
+            case query::cell_predicate::op::in:
+                return type.equal(value, bytes_view(v));
+            case query::cell_predicate::op::lt:
+                return type.compare(value, bytes_view(v)) < 0;
+            case query::cell_predicate::op::lte:
+                return type.compare(value, bytes_view(v)) <= 0;
+            case query::cell_predicate::op::gt:
+                return type.compare(value, bytes_view(v)) > 0;
+            case query::cell_predicate::op::gte:
+                return type.compare(value, bytes_view(v)) >= 0;
+            }
+            return true;
+        };
+        if (!std::ranges::any_of(p.values, matches)) {
+            return false;
+        }
+    }
+    return true;
+}
 
+stop_iteration mutation_querier::consume(clustering_row&& cr, row_tombstone current_tombstone) {
     const query::partition_slice& slice = _pw.slice();
 
+    if (!slice.row_filter().empty() && !matches_row_filter(cr.cells())) {
+        ++_filtered_out_rows;
+        return stop_iteration::no;
+    }
+
+    prepare_writers();
+
     if (_pw.requested_digest()) {
         _pw.digest().feed_hash(cr.key(), _schema);
         _pw.digest().feed_hash(current_tombstone);
@@ -1987,7 +2035,11 @@ uint64_t mutation_querier::consume_end_of_stream() {
     bool return_static_content_on_partition_with_no_rows =
         _pw.slice().options.contains(query::partition_slice::option::always_return_static_content) ||
         !has_ck_selector(_pw.ranges());
-    if (!_live_clustering_rows && (!return_static_content_on_partition_with_no_rows || !_live_data_in_static_row)) {
+    // Rows dropped by the row filter are counted as if they were returned, but
+    // a partition whose rows were all dropped isn't returned as a static row
+    // only partition, it had rows.
+    _pw.row_count() += _filtered_out_rows;
+    if (!_live_clustering_rows && (!return_static_content_on_partition_with_no_rows || !_live_data_in_static_row || _filtered_out_rows)) {
         _pw.retract();
         return 0;
     } else {
@@ -2066,6 +2118,11 @@ stop_iteration query::result_memory_accounter::check_local_limit() const {
 }
 
 void reconcilable_result_builder::consume_new_partition(const dht::decorated_key& dk) {
+    if (_result.empty() && _expected_partitions > 1) {
+        // Allocate the first chunk of the result at once, instead of growing
+        // it, and moving the partitions over, every few partitions.
+        _result.reserve(std::min(_expected_partitions, utils::chunked_vector<partition>::max_chunk_capacity()));
+    }
     _rt_assembler.reset();
     _return_static_content_on_partition_with_no_rows =
         _slice.options.contains(query::partition_slice::option::always_return_static_content) ||
@@ -1032,23 +1032,27 @@ class rows_entry final : public evictable {
         position_in_partition::tri_compare _c;
         explicit tri_compare(const schema& s) : _c(s) {}
 
+        std::strong_ordering compare(position_in_partition_view p1, position_in_partition_view p2) const {
+            return _c(p1, p2);
+        }
+
         std::strong_ordering operator()(const rows_entry& e1, const rows_entry& e2) const {
-            return _c(e1.position(), e2.position());
+            return compare(e1.position(), e2.position());
         }
         std::strong_ordering operator()(const clustering_key& key, const rows_entry& e) const {
-            return _c(position_in_partition_view::for_key(key), e.position());
+            return compare(position_in_partition_view::for_key(key), e.position());
         }
         std::strong_ordering operator()(const rows_entry& e, const clustering_key& key) const {
-            return _c(e.position(), position_in_partition_view::for_key(key));
+            return compare(e.position(), position_in_partition_view::for_key(key));
         }
         std::strong_ordering operator()(const rows_entry& e, position_in_partition_view p) const {
-            return _c(e.position(), p);
+            return compare(e.position(), p);
         }
         std::strong_ordering operator()(position_in_partition_view p, const rows_entry& e) const {
-            return _c(p, e.position());
+            return compare(p, e.position());
         }
         std::strong_ordering operator()(position_in_partition_view p1, position_in_partition_view p2) const {
-            return _c(p1, p2);
+            return compare(p1, p2);
         }
     };
     struct compare {
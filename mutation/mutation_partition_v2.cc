@@ -265,9 +265,24 @@ stop_iteration mutation_partition_v2::apply_monotonically(const schema& s, const
         if (i != _rows.end()) {
             auto x = cmp(*i, src_e);
             if (x < 0) {
-                bool match;
-                i = _rows.lower_bound(src_e, match, cmp);
-                miss = !match;
+                // Appends (e.g. time-series writes) land after the last row, or right before
+                // the trailing dummy. Check there before descending the tree. Reaching the last
+                // entry is O(1), and once i is at the end, the remaining rows of p are appended
+                // without further lookups.
+                auto last = std::prev(_rows.end());
+                auto x_last = cmp(*last, src_e);
+                if (x_last < 0) {
+                    i = _rows.end();
+                } else if (x_last == 0) {
+                    i = last;
+                    miss = false;
+                } else if (last->dummy() && last != i && cmp(*std::prev(last), src_e) < 0) {
+                    i = last;
+                } else {
+                    bool match;
+                    i = _rows.lower_bound(src_e, match, cmp);
+                    miss = !match;
+                }
             } else {
                 miss = x > 0;
             }
@@ -20,6 +20,7 @@ struct tombstone_purge_stats {
         attempts += other.attempts;
         failures_due_to_overlapping_with_memtable += other.failures_due_to_overlapping_with_memtable;
         failures_due_to_overlapping_with_uncompacting_sstable += other.failures_due_to_overlapping_with_uncompacting_sstable;
+        failures_other += other.failures_other;
 
         return *this;
     }
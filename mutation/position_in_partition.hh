@@ -9,13 +9,17 @@
 #pragma once
 
 #include "utils/assert.hh"
+#include "utils/UUID.hh"
 #include "types/types.hh"
 #include "keys/keys.hh"
 #include "keys/clustering_bounds_comparator.hh"
 #include "query-request.hh"
 
+#include <algorithm>
+#include <array>
 #include <optional>
 #include <cstdlib>
+#include <seastar/core/byteorder.hh>
 
 inline
 lexicographical_relation relation_for_lower_bound(composite_view v) {
@@ -563,9 +567,71 @@ class position_in_partition {
         }
     };
 
+    // When the first clustering column has a type whose values order like
+    // their serialized bytes (e.g. text or blob), like their sign-flipped
+    // serialized bytes (the integers and timestamp) or is a timeuuid, up to
+    // 8 bytes of the first components are mapped to unsigned integers with
+    // the same order. Keys whose integers differ are then ordered by
+    // comparing them, without going through the type layer, so for compound
+    // keys only the ties fall back to comparing component by component.
+    // The prefix is read from the first fragment of the key, which the full
+    // comparison would read anyway, so the fast path doesn't touch more memory.
     class tri_compare {
+        enum class prefix_kind : uint8_t { none, unsigned_bytes, signed_integer, timeuuid };
+
         bound_view::tri_compare _cmp;
+        prefix_kind _prefix_kind = prefix_kind::none;
+        bool _prefix_reversed = false;
+        // The length of the values, for prefix_kind::signed_integer.
+        uint8_t _prefix_value_length = 0;
     private:
+        // Returns false if the key has no first component in the expected form.
+        bool key_prefix(const clustering_key_prefix& ck, uint64_t& prefix) const noexcept {
+            auto f = managed_bytes_view(ck.representation()).current_fragment();
+            // The first component, as serialized by compound_type: 16-bit length followed by the value.
+            if (f.size() < sizeof(uint16_t)) {
+                return false;
+            }
+            size_t len = seastar::read_be<uint16_t>(reinterpret_cast<const char*>(f.data()));
+            auto value = reinterpret_cast<const char*>(f.data()) + sizeof(uint16_t);
+            auto available = f.size() - sizeof(uint16_t);
+            std::array<char, sizeof(uint64_t)> buf{};
+            switch (_prefix_kind) {
+            case prefix_kind::unsigned_bytes: {
+                // Shorter values are padded with zeros, which can make them tie
+                // with longer ones, but never order them differently.
+                auto n = std::min(len, buf.size());
+                if (available < n) {
+                    return false;
+                }
+                std::copy_n(value, n, buf.data());
+                prefix = seastar::read_be<uint64_t>(buf.data());
+                return true;
+            }
+            case prefix_kind::signed_integer:
+                if (len != _prefix_value_length || available < len) {
+                    return false;
+                }
+                std::copy_n(value, len, buf.data());
+                prefix = seastar::read_be<uint64_t>(buf.data()) ^ (uint64_t(1) << 63);
+                return true;
+            case prefix_kind::timeuuid:
+                if (len != 16 || available < 16) {
+                    return false;
+                }
+                prefix = utils::timeuuid_read_msb(reinterpret_cast<const int8_t*>(value));
+                return true;
+            case prefix_kind::none:
+                break;
+            }
+            return false;
+        }
+
+        void set_signed_integer_prefix(uint8_t value_length) noexcept {
+            _prefix_kind = prefix_kind::signed_integer;
+            _prefix_value_length = value_length;
+        }
+
         template<typename T, typename U>
         std::strong_ordering compare(const T& a, const U& b) const {
             if (a._type != b._type) {
@@ -574,10 +640,50 @@ class position_in_partition {
             if (!a._ck) {
                 return std::strong_ordering::equal;
             }
+            uint64_t k1, k2;
+            if (_prefix_kind != prefix_kind::none && key_prefix(*a._ck, k1) && key_prefix(*b._ck, k2) && k1 != k2) {
+                return _prefix_reversed ? k2 <=> k1 : k1 <=> k2;
+            }
             return _cmp(*a._ck, int8_t(a._bound_weight), *b._ck, int8_t(b._bound_weight));
         }
     public:
-        tri_compare(const schema& s) : _cmp(s) { }
+        tri_compare(const schema& s) : _cmp(s) {
+            if (s.clustering_key_size() == 0) {
+                return;
+            }
+            const auto& type = *s.clustering_key_prefix_type()->types().front();
+            _prefix_reversed = type.is_reversed();
+            switch (type.without_reversed().get_kind()) {
+            case abstract_type::kind::ascii:
+            case abstract_type::kind::utf8:
+            case abstract_type::kind::bytes:
+            case abstract_type::kind::inet:
+            case abstract_type::kind::duration:
+            case abstract_type::kind::date:
+            case abstract_type::kind::simple_date:
+                _prefix_kind = prefix_kind::unsigned_bytes;
+                break;
+            case abstract_type::kind::byte:
+                set_signed_integer_prefix(sizeof(int8_t));
+                break;
+            case abstract_type::kind::short_kind:
+                set_signed_integer_prefix(sizeof(int16_t));
+                break;
+            case abstract_type::kind::int32:
+                set_signed_integer_prefix(sizeof(int32_t));
+                break;
+            case abstract_type::kind::long_kind:
+            case abstract_type::kind::timestamp:
+            case abstract_type::kind::time:
+                set_signed_integer_prefix(sizeof(int64_t));
+                break;
+            case abstract_type::kind::timeuuid:
+                _prefix_kind = prefix_kind::timeuuid;
+                break;
+            default:
+                break;
+            }
+        }
         std::strong_ordering operator()(const position_in_partition& a, const position_in_partition& b) const {
             return compare(a, b);
         }
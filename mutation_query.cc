@@ -49,6 +49,7 @@ reconcilable_result::operator==(const reconcilable_result& other) const {
 
 void
 reconcilable_result::merge_disjoint(schema_ptr schema, const reconcilable_result& other) {
+    _partitions.reserve(_partitions.size() + other._partitions.size());
     std::copy(other._partitions.begin(), other._partitions.end(), std::back_inserter(_partitions));
     _short_read = _short_read || other._short_read;
     uint64_t row_count = this->row_count() + other.row_count();
@@ -145,6 +145,7 @@ class reconcilable_result_builder {
     range_tombstone_assembler _rt_assembler;
 
     uint64_t _live_rows{};
+    size_t _expected_partitions;
     // make this the last member so it is destroyed first. #7240
     utils::chunked_vector<partition> _result;
     size_t _used_at_entry;
@@ -154,10 +155,13 @@ class reconcilable_result_builder {
 
 public:
     // Expects reversed schema and reversed slice when building results for reverse query.
+    // expected_partitions is the number of partitions the page is expected to
+    // have at most, the storage for them is allocated with the first one.
     reconcilable_result_builder(const schema& query_schema, const query::partition_slice& slice,
-                                query::result_memory_accounter&& accounter) noexcept
+                                query::result_memory_accounter&& accounter, size_t expected_partitions = 0) noexcept
         : _query_schema(query_schema.shared_from_this()), _slice(slice)
         , _memory_accounter(std::move(accounter))
+        , _expected_partitions(expected_partitions)
     { }
 
     void consume_new_partition(const dht::decorated_key& dk);
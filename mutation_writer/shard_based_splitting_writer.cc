@@ -21,6 +21,8 @@ class shard_based_splitting_mutation_writer {
     schema_ptr _schema;
     reader_permit _permit;
     mutation_reader_consumer _consumer;
+    // When null, the shards are those of this node.
+    const dht::sharder* _sharder;
     unsigned _current_shard;
     std::vector<std::optional<shard_writer>> _shards;
 
@@ -29,15 +31,18 @@ class shard_based_splitting_mutation_writer {
         return writer.consume(std::move(mf));
     }
 public:
-    shard_based_splitting_mutation_writer(schema_ptr schema, reader_permit permit, mutation_reader_consumer consumer)
+    shard_based_splitting_mutation_writer(schema_ptr schema, reader_permit permit, mutation_reader_consumer consumer, const dht::sharder* sharder = nullptr)
         : _schema(std::move(schema))
         , _permit(std::move(permit))
         , _consumer(std::move(consumer))
-        , _shards(smp::count)
+        , _sharder(sharder)
+        , _shards(_sharder ? _sharder->shard_count() : smp::count)
     {}
 
     future<> consume(partition_start&& ps) {
-        _current_shard = dht::static_shard_of(*_schema, ps.key().token()); // FIXME: Use table sharder
+        _current_shard = _sharder
+                ? _sharder->shard_for_reads(ps.key().token())
+                : dht::static_shard_of(*_schema, ps.key().token()); // FIXME: Use table sharder
         if (!_shards[_current_shard]) {
             _shards[_current_shard] = shard_writer(_schema, _permit, _consumer);
         }
@@ -88,4 +93,12 @@ future<> segregate_by_shard(mutation_reader producer, mutation_reader_consumer c
         std::move(producer),
         shard_based_splitting_mutation_writer(std::move(schema), std::move(permit), std::move(consumer)));
 }
+
+future<> segregate_by_shard(mutation_reader producer, const dht::sharder& sharder, mutation_reader_consumer consumer) {
+    auto schema = producer.schema();
+    auto permit = producer.permit();
+    return feed_writer(
+        std::move(producer),
+        shard_based_splitting_mutation_writer(std::move(schema), std::move(permit), std::move(consumer), &sharder));
+}
 } // namespace mutation_writer
@@ -10,6 +10,10 @@
 
 #include "readers/mutation_reader.hh"
 
+namespace dht {
+class sharder;
+}
+
 namespace mutation_writer {
 
 // Given a producer that may contain data for all shards, consume it in a per-shard
@@ -18,4 +22,9 @@ namespace mutation_writer {
 // owners.
 future<> segregate_by_shard(mutation_reader producer, mutation_reader_consumer consumer);
 
+// Same as above, but the shards are those of the provided sharder, which may
+// have a different number of shards than this node. Used to generate sstables
+// offline for a node of a given shard count.
+future<> segregate_by_shard(mutation_reader producer, const dht::sharder& sharder, mutation_reader_consumer consumer);
+
 } // namespace mutation_writer
@@ -15,6 +15,7 @@ partition_slice_builder::partition_slice_builder(const schema& schema, query::pa
     , _specific_ranges(std::move(slice._specific_ranges))
     , _schema(schema)
     , _options(std::move(slice.options))
+    , _row_filter(std::move(slice._row_filter))
 {
 }
 
@@ -52,7 +53,7 @@ partition_slice_builder::build() {
             _schema.regular_columns() | std::views::transform(std::mem_fn(&column_definition::id)) | std::ranges::to<query::column_id_vector>();
     }
 
-    return {
+    query::partition_slice slice{
         std::move(ranges),
         std::move(static_columns),
         std::move(regular_columns),
@@ -60,6 +61,8 @@ partition_slice_builder::build() {
         std::move(_specific_ranges),
         _partition_row_limit,
     };
+    slice.set_row_filter(std::move(_row_filter));
+    return slice;
 }
 
 partition_slice_builder&
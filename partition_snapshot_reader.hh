@@ -50,6 +50,9 @@ class partition_snapshot_flat_reader : public mutation_reader::impl, public Acco
     // snapshot, references to region and alloc section) or dropped on any
     // allocation section retry (_clustering_rows).
     class lsa_partition_reader {
+        // Bounds the work done in a single allocating section.
+        static constexpr unsigned max_coalesced_dummies = 128;
+
         // _query_schema can be used to retrieve the clustering key order which is used
         // for result ordering. This schema is passed from the query and is reversed iff
         // the query was reversed (i.e. `Reversing==true`).
@@ -126,6 +129,15 @@ class partition_snapshot_flat_reader : public mutation_reader::impl, public Acco
                     mplog.trace("next_interval(): pos={}, rt={}", _cursor.position(), rt_before_row);
                     auto res = interval_info{rt_before_row, position_in_partition(_cursor.position())};
                     _done = !_cursor.next();
+                    // Bounds of range tombstones which are covered by other range tombstones, typically
+                    // from other versions, don't change the tombstone. Extend the interval over them
+                    // instead of returning an interval per bound.
+                    for (unsigned n = 0; !_done && n < max_coalesced_dummies && _cursor.dummy()
+                            && _cursor.range_tombstone() == rt_before_row
+                            && cmp(_cursor.position(), position_in_partition::for_range_end(ck_range_query)) < 0; ++n) {
+                        std::get<position_in_partition>(res.info) = position_in_partition(_cursor.position());
+                        _done = !_cursor.next();
+                    }
                     return res;
                 }
 
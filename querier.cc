@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
  */
 
+#include <algorithm>
+
 #include <seastar/core/coroutine.hh>
 
 #include "querier.hh"
@@ -189,7 +191,7 @@ static can_use can_be_used_for_page(querier_cache::is_user_semaphore_func& is_us
 // The time-to-live of a cache-entry.
 const std::chrono::seconds querier_cache::default_entry_ttl{10};
 
-static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, query_id key,
+static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, querier_cache::stats& stats, query_id key,
         dht::partition_ranges_view ranges, tracing::trace_state_ptr trace_state) {
     const auto queriers = index.equal_range(key);
 
@@ -204,6 +206,7 @@ static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, q
 
     if (it == queriers.second) {
         tracing::trace(trace_state, "Found cached querier(s) for key {} but none matches the query range(s) {}", key, ranges);
+        ++stats.range_mismatches;
         return nullptr;
     }
     tracing::trace(trace_state, "Found cached querier for key {} and range(s) {}", key, ranges);
@@ -218,6 +221,22 @@ querier_cache::querier_cache(is_user_semaphore_func is_user_semaphore_func, std:
     , _is_user_semaphore_func(is_user_semaphore_func) {
 }
 
+void querier_cache::note_eviction(query_id key) noexcept {
+    _recently_evicted[_recently_evicted_next++ % max_recently_evicted] = key;
+}
+
+bool querier_cache::was_recently_evicted(query_id key) const noexcept {
+    return std::ranges::find(_recently_evicted, key) != _recently_evicted.end();
+}
+
+void querier_cache::close_in_background(std::unique_ptr<querier_base> q) noexcept {
+    // It is safe to do so, since _closing_gate is closed and
+    // waited on in querier_cache::stop()
+    (void)with_gate(_closing_gate, [q = std::move(q)] () mutable {
+        return q->close().finally([q = std::move(q)] {});
+    });
+}
+
 struct querier_utils {
     static mutation_reader get_reader(querier_base& q) noexcept {
         return std::move(std::get<mutation_reader>(q._reader));
@@ -261,6 +280,7 @@ void querier_cache::insert_querier(
     auto irh = sem.register_inactive_read(querier_utils::get_reader(q));
     if (!irh) {
         ++stats.resource_based_evictions;
+        note_eviction(key);
         return;
     }
   try {
@@ -276,14 +296,16 @@ void querier_cache::insert_querier(
         --stats.population;
     });
 
-    auto notify_handler = [&stats, &index, it] (reader_concurrency_semaphore::evict_reason reason) {
+    auto notify_handler = [this, &stats, &index, it, key] (reader_concurrency_semaphore::evict_reason reason) {
         index.erase(it);
         switch (reason) {
             case reader_concurrency_semaphore::evict_reason::permit:
                 ++stats.resource_based_evictions;
+                note_eviction(key);
                 break;
             case reader_concurrency_semaphore::evict_reason::time:
                 ++stats.time_based_evictions;
+                note_eviction(key);
                 break;
             case reader_concurrency_semaphore::evict_reason::manual:
                 break;
@@ -318,6 +340,19 @@ void querier_cache::insert_mutation_querier(query_id key, querier&& q, tracing::
 }
 
 void querier_cache::insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state) {
+    const auto stale = _shard_mutation_querier_index.equal_range(key);
+    for (auto it = stale.first; it != stale.second;) {
+        tracing::trace(trace_state, "Replacing stale querier with key {}", key);
+        auto& stale_q = *it->second;
+        auto reader_opt = stale_q.permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(stale_q));
+        if (reader_opt) {
+            querier_utils::set_reader(stale_q, std::move(*reader_opt));
+        }
+        close_in_background(std::move(it->second));
+        it = _shard_mutation_querier_index.erase(it);
+        --_stats.population;
+        ++_stats.replacements;
+    }
     insert_querier(key, _shard_mutation_querier_index, _stats, std::move(q), _entry_ttl, std::move(trace_state));
 }
 
@@ -331,11 +366,15 @@ std::optional<Querier> querier_cache::lookup_querier(
         reader_concurrency_semaphore& current_sem,
         tracing::trace_state_ptr trace_state,
         db::timeout_clock::time_point timeout) {
-    auto base_ptr = find_querier(index, key, ranges, trace_state);
     auto& stats = _stats;
+    auto base_ptr = find_querier(index, stats, key, ranges, trace_state);
     ++stats.lookups;
     if (!base_ptr) {
         ++stats.misses;
+        if (was_recently_evicted(key)) {
+            tracing::trace(trace_state, "Querier with key {} was evicted", key);
+            ++stats.evicted_misses;
+        }
         return std::nullopt;
     }
 
@@ -360,6 +399,17 @@ std::optional<Querier> querier_cache::lookup_querier(
 
     tracing::trace(trace_state, "Dropping querier because {}", cannot_use_reason(can_be_used));
     ++stats.drops;
+    switch (can_be_used) {
+        case can_use::no_schema_version_mismatch:
+            ++stats.schema_version_mismatches;
+            break;
+        case can_use::no_ring_pos_mismatch:
+        case can_use::no_clustering_pos_mismatch:
+            ++stats.position_mismatches;
+            break;
+        default:
+            break;
+    }
 
     auto permit = q.permit();
 
@@ -471,6 +521,7 @@ future<bool> querier_cache::evict_one() noexcept {
         }
         auto it = idx.begin();
         auto reader_opt = it->second->permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(*it->second));
+        note_eviction(it->first);
         idx.erase(it);
         ++_stats.resource_based_evictions;
         --_stats.population;
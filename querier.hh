@@ -17,6 +17,7 @@
 
 #include <boost/intrusive/set.hpp>
 
+#include <array>
 #include <variant>
 
 namespace query {
@@ -56,6 +57,8 @@ class querier_base {
 public:
     struct querier_config {
         uint32_t tombstone_warn_threshold {0}; // 0 disabled
+        // See dead_data_hint, null => always compact.
+        lw_shared_ptr<const dead_data_hint> dead_data_hint;
         querier_config() = default;
         explicit querier_config(uint32_t warn)
             : tombstone_warn_threshold(warn) {}
@@ -163,6 +166,7 @@ class querier : public querier_base {
             querier_config config = {})
         : querier_base(schema, permit, std::move(range), std::move(slice), ms, std::move(trace_ptr), std::move(config))
         , _compaction_state(make_lw_shared<compact_for_query_state>(*schema, gc_clock::time_point{}, *_slice, 0, 0)) {
+        _compaction_state->set_dead_data_hint(_qr_config.dead_data_hint);
     }
 
     bool are_limits_reached() const {
@@ -315,12 +319,30 @@ class querier_cache {
         // The number of queries dropped due to scheduling group mismatch
         // between semaphores
         uint64_t scheduling_group_mismatches = 0;
+        // The subset of misses where the looked up querier was evicted
+        // (based on time or resources) since it was inserted.
+        uint64_t evicted_misses = 0;
+        // The subset of misses where queriers were found for the key but none
+        // of them matched the read range(s).
+        uint64_t range_mismatches = 0;
+        // The subset of drops due to schema version mismatch.
+        uint64_t schema_version_mismatches = 0;
+        // The subset of drops due to the page starting at a different
+        // position than the one the querier stopped at.
+        uint64_t position_mismatches = 0;
+        // The number of shard mutation queriers replaced by a newer querier
+        // of the same query, saved on the same shard.
+        uint64_t replacements = 0;
     };
 
     using index = std::unordered_multimap<query_id, std::unique_ptr<querier_base>>;
     using is_user_semaphore_func = std::function<bool(const reader_concurrency_semaphore&)>;
 
 private:
+    // The number of recently evicted keys remembered, to tell misses caused
+    // by eviction from ones caused by the querier not being saved at all.
+    static constexpr size_t max_recently_evicted = 256;
+
     index _data_querier_index;
     index _mutation_querier_index;
     index _shard_mutation_querier_index;
@@ -328,8 +350,14 @@ class querier_cache {
     stats _stats;
     named_gate _closing_gate;
     is_user_semaphore_func _is_user_semaphore_func;
+    std::array<query_id, max_recently_evicted> _recently_evicted = {};
+    size_t _recently_evicted_next = 0;
 
 private:
+    void note_eviction(query_id key) noexcept;
+    bool was_recently_evicted(query_id key) const noexcept;
+    void close_in_background(std::unique_ptr<querier_base> q) noexcept;
+
     template <typename Querier>
     void insert_querier(
             query_id key,
@@ -364,6 +392,11 @@ class querier_cache {
 
     void insert_mutation_querier(query_id key, querier&& q, tracing::trace_state_ptr trace_state);
 
+    /// Insert a shard mutation querier.
+    ///
+    /// A multishard query has at most one querier on each shard, so queriers
+    /// already cached for the key are stale (e.g. left behind by a retried
+    /// page) and are replaced.
     void insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state);
 
     /// Lookup a data querier in the cache.
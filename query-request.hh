@@ -147,6 +147,24 @@ class specific_ranges {
     clustering_row_ranges _ranges;
 };
 
+// A condition on the value of an atomic regular column, which replicas check on
+// clustering rows before adding them to a query result. See partition_slice::row_filter().
+struct cell_predicate {
+    enum class op : uint8_t {
+        eq,
+        lt,
+        lte,
+        gt,
+        gte,
+        in,
+    };
+
+    column_id column;
+    op oper;
+    // The value to compare with, or the IN list.
+    std::vector<bytes> values;
+};
+
 constexpr auto max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto partition_max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto max_rows_if_set = std::numeric_limits<uint32_t>::max();
@@ -207,13 +225,15 @@ class partition_slice {
     std::unique_ptr<specific_ranges> _specific_ranges;
     uint32_t _partition_row_limit_low_bits;
     uint32_t _partition_row_limit_high_bits;
+    std::vector<cell_predicate> _row_filter;
 public:
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges,
         cql_serialization_format,
         uint32_t partition_row_limit_low_bits,
-        uint32_t partition_row_limit_high_bits);
+        uint32_t partition_row_limit_high_bits,
+        std::vector<cell_predicate> row_filter = {});
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges = nullptr,
@@ -257,6 +277,19 @@ class partition_slice {
         _partition_row_limit_high_bits = static_cast<uint64_t>(limit >> 32);
     }
 
+    // Conditions which clustering rows have to satisfy to be added to the result.
+    // Rows failing them are dropped by the replica but still counted in the
+    // result's row count, so that paging and limits work as if they were sent.
+    // Filtering queries use it to avoid shipping rows which the coordinator
+    // would filter out anyway; it's an optimization, the coordinator still
+    // applies all restrictions.
+    const std::vector<cell_predicate>& row_filter() const {
+        return _row_filter;
+    }
+    void set_row_filter(std::vector<cell_predicate> row_filter) {
+        _row_filter = std::move(row_filter);
+    }
+
     [[nodiscard]]
     bool is_reversed() const {
         return options.contains<query::partition_slice::option::reversed>();
@@ -484,6 +517,9 @@ struct mapreduce_request {
     struct aggregation_info {
         db::functions::function_name name;
         std::vector<sstring> column_names;
+        // Values of the arguments following the columns, e.g. the percentile
+        // of approx_percentile().
+        std::vector<bytes_opt> constant_arguments;
     };
     struct reductions_info {
         // Used by selector_factries to prepare reductions information
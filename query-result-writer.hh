@@ -206,10 +206,13 @@ class mutation_querier {
     query::result::partition_writer _pw;
     bool _live_data_in_static_row{};
     uint64_t _live_clustering_rows = 0;
+    // Live rows dropped by partition_slice::row_filter().
+    uint64_t _filtered_out_rows = 0;
     std::optional<ser::qr_partition__rows<bytes_ostream>> _rows_wr;
 private:
     void query_static_row(const row& r, tombstone current_tombstone);
     void prepare_writers();
+    bool matches_row_filter(const row& cells) const;
 public:
     mutation_querier(const schema& s, query::result::partition_writer pw,
                      query::result_memory_accounter& memory_accounter);
@@ -8,6 +8,7 @@
 
 #include <limits>
 #include <memory>
+#include <ranges>
 #include <stdexcept>
 #include <fmt/ranges.h>
 #include "query-request.hh"
@@ -50,6 +51,10 @@ std::ostream& operator<<(std::ostream& out, const partition_slice& ps) {
         fmt::print(out, ", specific=[{}]", *ps._specific_ranges);
     }
     // FIXME: pretty print options
+    if (!ps._row_filter.empty()) {
+        fmt::print(out, ", row_filter_columns=[{}]",
+                   fmt::join(ps._row_filter | std::views::transform(std::mem_fn(&cell_predicate::column)), ", "));
+    }
     fmt::print(out, ", options={:x}, , partition_row_limit={}}}",
                ps.options.mask(), ps.partition_row_limit());
     return out;
@@ -84,8 +89,8 @@ std::ostream& operator<<(std::ostream& out, const mapreduce_request::reduction_t
 }
 
 std::ostream& operator<<(std::ostream& out, const mapreduce_request::aggregation_info& a) {
-    fmt::print(out, "aggregation_info{{, name={}, column_names=[{}]}}",
-               a.name, fmt::join(a.column_names, ","));;
+    fmt::print(out, "aggregation_info{{, name={}, column_names=[{}], constant_arguments={}}}",
+               a.name, fmt::join(a.column_names, ","), a.constant_arguments.size());
     return out;
 }
 
@@ -181,7 +186,8 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     std::unique_ptr<specific_ranges> specific_ranges,
     cql_serialization_format cql_format,
     uint32_t partition_row_limit_low_bits,
-    uint32_t partition_row_limit_high_bits)
+    uint32_t partition_row_limit_high_bits,
+    std::vector<cell_predicate> row_filter)
     : _row_ranges(std::move(row_ranges))
     , static_columns(std::move(static_columns))
     , regular_columns(std::move(regular_columns))
@@ -189,6 +195,7 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     , _specific_ranges(std::move(specific_ranges))
     , _partition_row_limit_low_bits(partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(partition_row_limit_high_bits)
+    , _row_filter(std::move(row_filter))
 {
     cql_format.ensure_supported();
 }
@@ -232,6 +239,7 @@ partition_slice::partition_slice(const partition_slice& s)
     , _specific_ranges(s._specific_ranges ? std::make_unique<specific_ranges>(*s._specific_ranges) : nullptr)
     , _partition_row_limit_low_bits(s._partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(s._partition_row_limit_high_bits)
+    , _row_filter(s._row_filter)
 {}
 
 partition_slice::~partition_slice()
@@ -360,6 +368,7 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
     for (auto&& r : _partial) {
         result_view::do_with(*r, [&] (result_view rv) {
             last_position.reset();
+            uint64_t rows_in_result = 0;
             for (auto&& pv : rv._v.partitions()) {
                 auto rows = pv.rows();
                 // If rows.empty(), then there's a static row, or there wouldn't be a partition
@@ -367,6 +376,7 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
                 const uint64_t rows_to_include = std::min(_max_rows - row_count, rows_in_partition);
                 row_count += rows_to_include;
                 if (rows_to_include >= rows_in_partition) {
+                    rows_in_result += rows_in_partition;
                     partitions.add(pv);
                     if (++partition_count >= _max_partitions) {
                         return;
@@ -379,6 +389,11 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
                     return;
                 }
             }
+            // Rows dropped by the replica's row filter (see partition_slice::row_filter())
+            // are counted in row_count() but absent from the result.
+            if (r->row_count() && *r->row_count() > rows_in_result) {
+                row_count += *r->row_count() - rows_in_result;
+            }
             last_position = r->last_position();
         });
         if (r->is_short_read()) {
@@ -58,6 +58,12 @@ struct fsm_config {
     size_t max_log_size;
     // If set to true will enable prevoting stage during election
     bool enable_prevoting;
+    // Max number of append entries requests which may be in flight
+    // to a single follower in PIPELINE state. The leader stops sending
+    // new requests to a follower until some of them are acked, so
+    // a slow follower pushes back on the leader only as far as its
+    // own stream goes, without affecting the other ones.
+    size_t max_in_flight_append_requests = follower_progress::max_in_flight;
 };
 
 class fsm;
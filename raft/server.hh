@@ -48,6 +48,12 @@ class server {
         size_t max_log_size = 4 * 1024 * 1024;
         // If set to true will enable prevoting stage during election
         bool enable_prevoting = true;
+        // Max number of append entries requests which may be in flight
+        // to a single follower. With a bigger window the leader keeps
+        // replicating new entries while the previous ones are still
+        // being persisted by the followers, at the cost of more
+        // wasted work if the follower's log diverges.
+        size_t max_in_flight_append_requests = 10;
         // If set to true, forward configuration and entries from
         // follower to the leader automatically. This guarantees
         // add_entry()/modify_config() never throws not_a_leader,
@@ -47,6 +47,8 @@ class follower_progress {
     bool probe_sent = false;
     // number of in flight still un-acked append entries requests
     size_t in_flight = 0;
+    // Default limit on the number of in flight append entries
+    // requests, see fsm_config::max_in_flight_append_requests.
     static constexpr size_t max_in_flight = 10;
 
     // Check if a reject packet should be ignored because it was delayed or reordered.
@@ -73,7 +75,9 @@ class follower_progress {
     }
 
     // Return true if a new replication record can be sent to the follower.
-    bool can_send_to();
+    // `max_in_flight` limits the number of un-acked append entries
+    // requests in PIPELINE state.
+    bool can_send_to(size_t max_in_flight);
 
     follower_progress(server_id id_arg, index_t next_idx_arg)
         : id(id_arg), next_idx(next_idx_arg)
@@ -14,6 +14,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/core/metrics.hh>
+#include <seastar/core/timer.hh>
 #include <utility>
 
 #include "reader_concurrency_semaphore.hh"
@@ -22,11 +23,66 @@
 #include "utils/assert.hh"
 #include "utils/exceptions.hh"
 #include "schema/schema.hh"
+#include "sstables/resume_positions.hh"
 #include "utils/human_readable.hh"
 #include "utils/memory_limit_reached.hh"
 
 logger rcslog("reader_concurrency_semaphore");
 
+// Periodically adjusts the effective count limit of the semaphore, AIMD-style.
+//
+// The input is the average service time of the permits served in the last
+// period, compared to a baseline: the lowest recent average. When the service
+// time inflates beyond the tolerance while most admitted reads are waiting on
+// the disk, the disk is assumed to be saturated and the limit is lowered, as
+// admitting more reads would only make them queue on the disk. Otherwise the
+// limit is raised back, towards the static limit.
+class reader_concurrency_semaphore::adaptive_concurrency_controller {
+    reader_concurrency_semaphore& _semaphore;
+    adaptive_concurrency_config _cfg;
+    timer<lowres_clock> _adjust_timer;
+    std::chrono::steady_clock::duration _service_time_sum{};
+    uint64_t _samples = 0;
+    double _baseline_us = 0;
+
+public:
+    adaptive_concurrency_controller(reader_concurrency_semaphore& semaphore, adaptive_concurrency_config cfg)
+        : _semaphore(semaphore)
+        , _cfg(cfg)
+        , _adjust_timer([this] { adjust(); })
+    {
+        _adjust_timer.arm_periodic(_cfg.adjust_period);
+    }
+
+    void on_permit_served(std::chrono::steady_clock::duration service_time) noexcept {
+        _service_time_sum += service_time;
+        ++_samples;
+    }
+
+    void adjust() noexcept {
+        const int max_count = _semaphore._initial_resources.count;
+        int limit = _semaphore.effective_count_limit();
+        bool latency_inflated = false;
+        if (_samples) {
+            const auto avg_us = std::chrono::duration<double, std::micro>(_service_time_sum).count() / _samples;
+            _service_time_sum = {};
+            _samples = 0;
+            // Follow decreases immediately but increases only slowly, so the
+            // baseline adapts to changes of the workload without following
+            // the inflation caused by too much concurrency.
+            _baseline_us = _baseline_us ? std::min(avg_us, _baseline_us + (avg_us - _baseline_us) / 64) : avg_us;
+            latency_inflated = avg_us > _baseline_us * _cfg.latency_tolerance;
+        }
+        const bool disk_saturated = _semaphore._stats.disk_reads * 2 >= uint64_t(std::max(limit, 1));
+        if (latency_inflated && disk_saturated) {
+            limit -= std::max(1, limit / 8);
+        } else if (!latency_inflated) {
+            limit += std::max(1, limit / 16);
+        }
+        _semaphore.set_effective_count_limit(std::clamp(limit, std::min(_cfg.min_count, max_count), max_count));
+    }
+};
+
 struct reader_concurrency_semaphore::inactive_read {
     mutation_reader reader;
     const dht::partition_range* range = nullptr;
@@ -168,6 +224,23 @@ class reader_permit::impl
     size_t _requested_memory = 0;
     uint64_t _oom_kills = 0;
     tracing::trace_state_ptr _trace_ptr;
+    // Set while an admitted permit is active, if adaptive concurrency is enabled.
+    std::optional<std::chrono::steady_clock::time_point> _active_since;
+    reader_concurrency_semaphore::admission_class _admission_class = reader_concurrency_semaphore::admission_class::scan;
+    std::chrono::steady_clock::time_point _admission_wait_started;
+
+    // Counters for the slow read log, collected only if _created_at is set.
+    std::optional<std::chrono::steady_clock::time_point> _created_at;
+    std::optional<std::chrono::steady_clock::time_point> _wait_started;
+    // Registered as inactive, e.g. between the pages of a paged read, or evicted.
+    std::optional<std::chrono::steady_clock::time_point> _inactive_since;
+    std::chrono::steady_clock::duration _inactive_time{};
+    std::chrono::steady_clock::duration _queued{};
+    std::chrono::steady_clock::duration _disk_time{};
+    uint64_t _sstables_touched = 0;
+    uint64_t _bytes_read = 0;
+
+    std::unique_ptr<sstables::resume_positions> _sstable_resume_positions;
 
     // Not strictly related to the permit.
     // Used by the semaphore to to manage the permit.
@@ -190,6 +263,16 @@ class reader_permit::impl
         _semaphore.on_permit_not_awaits();
         _marked_as_awaits = false;
     }
+    void on_service_started() noexcept {
+        if (_semaphore.adaptive_concurrency_enabled()) {
+            _active_since = std::chrono::steady_clock::now();
+        }
+    }
+    void on_service_stopped() noexcept {
+        if (_active_since) {
+            _semaphore.on_permit_served(std::chrono::steady_clock::now() - *std::exchange(_active_since, std::nullopt));
+        }
+    }
     void on_permit_active() {
         if (_need_cpu_branches) {
             _state = reader_permit::state::active_need_cpu;
@@ -218,6 +301,60 @@ class reader_permit::impl
         }
     }
 
+    void on_wait_started() noexcept {
+        if (_created_at && !_wait_started) {
+            _wait_started = std::chrono::steady_clock::now();
+        }
+    }
+    void on_wait_finished() noexcept {
+        if (_wait_started) {
+            _queued += std::chrono::steady_clock::now() - *std::exchange(_wait_started, std::nullopt);
+        }
+    }
+    void on_inactive_started() noexcept {
+        if (_created_at) {
+            _inactive_since = std::chrono::steady_clock::now();
+        }
+    }
+    void on_inactive_finished() noexcept {
+        if (_inactive_since) {
+            _inactive_time += std::chrono::steady_clock::now() - *std::exchange(_inactive_since, std::nullopt);
+        }
+    }
+    void maybe_record_slow_read() noexcept {
+        auto log = _semaphore._slow_read_log;
+        if (!_created_at || !log || !log->enabled()) {
+            return;
+        }
+        // The time a paged read waits for the next page to be requested
+        // is not the read's.
+        on_inactive_finished();
+        auto lifetime = std::chrono::steady_clock::now() - *_created_at;
+        auto duration = lifetime - _inactive_time;
+        if (duration < log->threshold()) {
+            return;
+        }
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        try {
+            log->record(slow_read_log::entry{
+                .seq = 0,
+                .started_at = std::chrono::system_clock::now() - duration_cast<std::chrono::system_clock::duration>(lifetime),
+                .keyspace = _schema ? _schema->ks_name() : "*",
+                .table = _schema ? _schema->cf_name() : "*",
+                .op_name = sstring(_op_name_view),
+                .semaphore = sstring(_semaphore.name()),
+                .duration = duration_cast<microseconds>(duration),
+                .queued = duration_cast<microseconds>(_queued),
+                .disk = duration_cast<microseconds>(_disk_time),
+                .sstables_read = _sstables_touched,
+                .bytes_read = _bytes_read,
+            });
+        } catch (...) {
+            // Losing an entry of the log is not worth failing for.
+        }
+    }
+
     void on_timeout() {
         auto ex = named_semaphore_timed_out(_semaphore._name);
         _ex = std::make_exception_ptr(ex);
@@ -256,6 +393,9 @@ class reader_permit::impl
     {
         set_timeout(timeout);
         _semaphore.on_permit_created(*this);
+        if (_semaphore._slow_read_log && _semaphore._slow_read_log->enabled()) {
+            _created_at = std::chrono::steady_clock::now();
+        }
     }
     impl(reader_concurrency_semaphore& semaphore, schema_ptr schema, sstring&& op_name, reader_resources base_resources, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr)
         : _semaphore(semaphore)
@@ -268,8 +408,12 @@ class reader_permit::impl
     {
         set_timeout(timeout);
         _semaphore.on_permit_created(*this);
+        if (_semaphore._slow_read_log && _semaphore._slow_read_log->enabled()) {
+            _created_at = std::chrono::steady_clock::now();
+        }
     }
     ~impl() {
+        on_service_stopped();
         if (_base_resources_consumed) {
             signal(_base_resources);
         }
@@ -304,6 +448,7 @@ class reader_permit::impl
         _semaphore._stats.sstables_read -= _sstables_read;
         _semaphore._stats.disk_reads -= bool(_sstables_read);
 
+        maybe_record_slow_read();
         _semaphore.on_permit_destroyed(*this);
     }
 
@@ -327,44 +472,72 @@ class reader_permit::impl
         return _aux_data;
     }
 
+    reader_concurrency_semaphore::admission_class get_admission_class() const noexcept {
+        return _admission_class;
+    }
+
+    void set_admission_class(reader_concurrency_semaphore::admission_class ac) noexcept {
+        _admission_class = ac;
+    }
+
+    std::chrono::steady_clock::time_point admission_wait_started() const noexcept {
+        return _admission_wait_started;
+    }
+
     void on_waiting_for_admission() {
+        // Evicted permits are readmitted.
+        on_inactive_finished();
         on_permit_inactive(reader_permit::state::waiting_for_admission);
+        _admission_wait_started = std::chrono::steady_clock::now();
+        on_wait_started();
     }
 
     void on_waiting_for_memory() {
         on_permit_inactive(reader_permit::state::waiting_for_memory);
+        on_wait_started();
     }
 
     void on_waiting_for_execution() {
         on_permit_inactive(reader_permit::state::waiting_for_execution);
+        on_wait_started();
     }
 
     void on_admission() {
         SCYLLA_ASSERT(_state != reader_permit::state::active_await);
+        on_wait_finished();
         on_permit_active();
         consume(_base_resources);
         _base_resources_consumed = true;
+        on_service_started();
     }
 
     void on_granted_memory() {
         if (_state == reader_permit::state::waiting_for_memory) {
+            on_wait_finished();
             on_permit_active();
         }
         consume({0, std::exchange(_requested_memory, 0)});
     }
 
     void on_executing() {
+        on_wait_finished();
         on_permit_active();
     }
 
     void on_register_as_inactive() {
         SCYLLA_ASSERT(_state == reader_permit::state::active || _state == reader_permit::state::active_need_cpu || _state == reader_permit::state::waiting_for_memory);
         on_permit_inactive(reader_permit::state::inactive);
+        on_service_stopped();
+        on_inactive_started();
     }
 
     void on_unregister_as_inactive() {
         SCYLLA_ASSERT(_state == reader_permit::state::inactive);
+        on_inactive_finished();
         on_permit_active();
+        if (_base_resources_consumed) {
+            on_service_started();
+        }
     }
 
     void on_evicted() {
@@ -402,6 +575,7 @@ class reader_permit::impl
     }
 
     void release_base_resources() noexcept {
+        on_service_stopped();
         if (_base_resources_consumed) {
             _resources -= _base_resources;
             _base_resources_consumed = false;
@@ -514,6 +688,7 @@ class reader_permit::impl
             ++_semaphore._stats.disk_reads;
         }
         ++_sstables_read;
+        ++_sstables_touched;
         ++_semaphore._stats.sstables_read;
     }
 
@@ -525,6 +700,25 @@ class reader_permit::impl
         }
     }
 
+    bool collects_read_stats() const noexcept {
+        return bool(_created_at);
+    }
+
+    void enable_sstable_resume_positions() {
+        if (!_sstable_resume_positions) {
+            _sstable_resume_positions = std::make_unique<sstables::resume_positions>();
+        }
+    }
+
+    sstables::resume_positions* sstable_resume_positions() noexcept {
+        return _sstable_resume_positions.get();
+    }
+
+    void on_disk_read(uint64_t bytes, std::chrono::steady_clock::duration duration) noexcept {
+        _bytes_read += bytes;
+        _disk_time += duration;
+    }
+
     bool on_oom_kill() noexcept {
         return !bool(_oom_kills++);
     }
@@ -664,6 +858,22 @@ void reader_permit::on_finish_sstable_read() noexcept {
     _impl->on_finish_sstable_read();
 }
 
+bool reader_permit::collects_read_stats() const noexcept {
+    return _impl->collects_read_stats();
+}
+
+void reader_permit::on_disk_read(uint64_t bytes, std::chrono::steady_clock::duration duration) noexcept {
+    _impl->on_disk_read(bytes, duration);
+}
+
+void reader_permit::enable_sstable_resume_positions() {
+    _impl->enable_sstable_resume_positions();
+}
+
+sstables::resume_positions* reader_permit::sstable_resume_positions() noexcept {
+    return _impl->sstable_resume_positions();
+}
+
 auto fmt::formatter<reader_permit::state>::format(reader_permit::state s, fmt::format_context& ctx) const
         -> decltype(ctx.out()) {
     std::string_view name;
@@ -787,10 +997,11 @@ static void do_dump_reader_permit_diagnostics(std::ostream& os, const reader_con
 
     permit_stats total;
 
-    fmt::print(os, "Semaphore {} with {}/{} count and {}/{} memory resources: {}, dumping permit diagnostics:\n",
+    fmt::print(os, "Semaphore {} with {}/{} count ({} withheld) and {}/{} memory resources: {}, dumping permit diagnostics:\n",
             semaphore.name(),
-            semaphore.initial_resources().count - semaphore.available_resources().count,
+            semaphore.consumed_resources().count,
             semaphore.initial_resources().count,
+            semaphore.withheld_count(),
             semaphore.initial_resources().memory - semaphore.available_resources().memory,
             semaphore.initial_resources().memory,
             problem);
@@ -927,7 +1138,7 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
 
 void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
     p.unlink();
-    _admission_queue.push_back(p);
+    _admission_queues[static_cast<size_t>(p.get_admission_class())].push_back(p);
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -936,11 +1147,18 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
 }
 
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
-    if (_memory_queue.empty()) {
-        return _admission_queue.front();
-    } else {
+    if (!_memory_queue.empty()) {
         return _memory_queue.front();
     }
+    auto& points = _admission_queues[static_cast<size_t>(admission_class::point)];
+    auto& scans = _admission_queues[static_cast<size_t>(admission_class::scan)];
+    if (points.empty()) {
+        return scans.front();
+    }
+    if (scans.empty() || points.front().timeout() <= scans.front().timeout()) {
+        return points.front();
+    }
+    return scans.front();
 }
 
 const reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() const {
@@ -1020,6 +1238,9 @@ void reader_concurrency_semaphore::consume(reader_permit::impl& permit, resource
 
 void reader_concurrency_semaphore::signal(const resources& r) noexcept {
     _resources += r;
+    if (_withheld_count < _withheld_count_target) [[unlikely]] {
+        maybe_withhold_count();
+    }
     maybe_wake_execution_loop();
 }
 
@@ -1058,6 +1279,11 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(
                                sm::description("Holds the number of currently active read operations. "),
                                {class_label(_name)}),
 
+                sm::make_gauge("reads_concurrency_limit", [this] { return effective_count_limit(); },
+                               sm::description("Holds the current limit of concurrently admitted reads. "
+                                               "Lower than the configured one when adaptive read concurrency reduced it."),
+                               {class_label(_name)}),
+
                 sm::make_gauge("reads_memory_consumption", [this] { return consumed_resources().memory; },
                                sm::description("Holds the amount of memory consumed by current read operations. "),
                                {class_label(_name)}),
@@ -1081,6 +1307,22 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(
                                                " When the queue is full, excessive reads are shed to avoid overload."),
                                {class_label(_name)}),
 
+                sm::make_counter("point_reads_admitted_after_wait", _stats.point_reads_admitted_after_wait,
+                               sm::description("Counts point reads admitted after waiting in the admission queue."),
+                               {class_label(_name)}),
+
+                sm::make_counter("point_reads_admission_wait_time", _stats.point_reads_admission_wait_time_us,
+                               sm::description("Total time point reads spent waiting in the admission queue, in microseconds."),
+                               {class_label(_name)}),
+
+                sm::make_counter("scans_admitted_after_wait", _stats.scans_admitted_after_wait,
+                               sm::description("Counts scans admitted after waiting in the admission queue."),
+                               {class_label(_name)}),
+
+                sm::make_counter("scans_admission_wait_time", _stats.scans_admission_wait_time_us,
+                               sm::description("Total time scans spent waiting in the admission queue, in microseconds."),
+                               {class_label(_name)}),
+
                 sm::make_gauge("disk_reads", _stats.disk_reads,
                                sm::description("Holds the number of currently active disk read operations. "),
                                {class_label(_name)}),
@@ -1256,6 +1498,7 @@ std::runtime_error reader_concurrency_semaphore::stopped_exception() {
 future<> reader_concurrency_semaphore::stop() noexcept {
     SCYLLA_ASSERT(!_stopped);
     _stopped = true;
+    set_adaptive_concurrency(std::nullopt);
     co_await stop_ext_pre();
     clear_inactive_reads();
     co_await _permit_gate.close();
@@ -1317,7 +1560,7 @@ void reader_concurrency_semaphore::close_reader(mutation_reader reader) {
 bool reader_concurrency_semaphore::has_available_units(const resources& r) const {
     // Special case: when there is no active reader (based on count) admit one
     // regardless of availability of memory.
-    return (_resources.non_zero() && _resources.count >= r.count && _resources.memory >= r.memory) || _resources.count == _initial_resources.count;
+    return (_resources.non_zero() && _resources.count >= r.count && _resources.memory >= r.memory) || _resources.count == _initial_resources.count - _withheld_count;
 }
 
 bool reader_concurrency_semaphore::cpu_concurrency_limit_reached() const {
@@ -1489,6 +1732,7 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
                 _blessed_permit = &permit;
                 permit.on_granted_memory();
             } else {
+                on_permit_admitted_after_wait(permit);
                 permit.on_admission();
                 ++_stats.reads_admitted;
             }
@@ -1560,6 +1804,28 @@ void reader_concurrency_semaphore::dequeue_permit(reader_permit::impl& permit) {
     _permit_list.push_back(permit);
 }
 
+slow_read_log::slow_read_log(utils::updateable_value<uint32_t> threshold_ms, size_t max_entries)
+    : _threshold_ms(std::move(threshold_ms))
+    , _max_entries(max_entries)
+{ }
+
+void slow_read_log::record(entry e) noexcept {
+    e.seq = _seq++;
+    rcslog.debug("slow read of {}.{}:{} on {}: {}us, queued {}us, disk {}us, {} sstables, {} bytes",
+            e.keyspace, e.table, e.op_name, e.semaphore, e.duration.count(), e.queued.count(), e.disk.count(), e.sstables_read, e.bytes_read);
+    if (!_max_entries) {
+        return;
+    }
+    if (_entries.size() >= _max_entries) {
+        _entries.pop_front();
+    }
+    try {
+        _entries.push_back(std::move(e));
+    } catch (...) {
+        // Drop the entry, the log is best effort.
+    }
+}
+
 void reader_concurrency_semaphore::on_permit_created(reader_permit::impl& permit) {
     _permit_gate.enter();
     _permit_list.push_back(permit);
@@ -1577,6 +1843,17 @@ void reader_concurrency_semaphore::on_permit_destroyed(reader_permit::impl& perm
     }
 }
 
+void reader_concurrency_semaphore::on_permit_admitted_after_wait(reader_permit::impl& permit) noexcept {
+    const auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - permit.admission_wait_started()).count();
+    if (permit.get_admission_class() == admission_class::point) {
+        ++_stats.point_reads_admitted_after_wait;
+        _stats.point_reads_admission_wait_time_us += wait_us;
+    } else {
+        ++_stats.scans_admitted_after_wait;
+        _stats.scans_admission_wait_time_us += wait_us;
+    }
+}
+
 void reader_concurrency_semaphore::on_permit_need_cpu() noexcept {
     ++_stats.need_cpu_permits;
 }
@@ -1600,16 +1877,18 @@ void reader_concurrency_semaphore::on_permit_not_awaits() noexcept {
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, admission_class ac) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_admission_class(ac);
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, admission_class ac) {
     auto permit = reader_permit(*this, std::move(schema), std::move(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_admission_class(ac);
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
@@ -1626,9 +1905,10 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(schema_ptr
 }
 
 future<> reader_concurrency_semaphore::with_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, reader_permit_opt& permit_holder, read_func func) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, reader_permit_opt& permit_holder, read_func func, admission_class ac) {
     permit_holder = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
     auto permit = *permit_holder;
+    permit->set_admission_class(ac);
     permit->aux_data().func = std::move(func);
     return do_wait_admission(*permit);
 }
@@ -1657,9 +1937,46 @@ void reader_concurrency_semaphore::set_resources(resources r) {
     auto delta = r - _initial_resources;
     _initial_resources = r;
     _resources += delta;
+    if (_withheld_count_target >= r.count) {
+        // Don't let the effective limit drop to zero, the controller will
+        // lower it again if needed.
+        set_effective_count_limit(std::min(r.count, 1));
+    }
     maybe_wake_execution_loop();
 }
 
+void reader_concurrency_semaphore::on_permit_served(std::chrono::steady_clock::duration service_time) noexcept {
+    if (_adaptive_controller) {
+        _adaptive_controller->on_permit_served(service_time);
+    }
+}
+
+void reader_concurrency_semaphore::set_effective_count_limit(int count) noexcept {
+    _withheld_count_target = std::max(_initial_resources.count - count, 0);
+    maybe_withhold_count();
+}
+
+void reader_concurrency_semaphore::maybe_withhold_count() noexcept {
+    auto delta = _withheld_count_target - _withheld_count;
+    if (delta > 0) {
+        delta = std::min(delta, std::max(_resources.count, 0));
+    }
+    _withheld_count += delta;
+    _resources.count -= delta;
+    if (delta < 0) {
+        maybe_wake_execution_loop();
+    }
+}
+
+void reader_concurrency_semaphore::set_adaptive_concurrency(std::optional<adaptive_concurrency_config> cfg) {
+    if (cfg) {
+        _adaptive_controller = std::make_unique<adaptive_concurrency_controller>(*this, *cfg);
+    } else {
+        _adaptive_controller.reset();
+        set_effective_count_limit(_initial_resources.count);
+    }
+}
+
 void reader_concurrency_semaphore::broken(std::exception_ptr ex) {
     if (!ex) {
         ex = std::make_exception_ptr(broken_semaphore{});
@@ -1679,7 +1996,9 @@ std::string reader_concurrency_semaphore::dump_diagnostics(unsigned max_lines) c
 
 void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(const reader_permit::impl&)> func) const {
     std::ranges::for_each(_permit_list, std::ref(func));
-    std::ranges::for_each(_wait_list._admission_queue, std::ref(func));
+    for (const auto& queue : _wait_list._admission_queues) {
+        std::ranges::for_each(queue, std::ref(func));
+    }
     std::ranges::for_each(_wait_list._memory_queue, std::ref(func));
     std::ranges::for_each(_ready_list, std::ref(func));
     std::ranges::for_each(_inactive_reads, std::ref(func));
@@ -1765,7 +2084,11 @@ class tracking_file_impl : public file_impl {
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
         return _permit.request_memory(range_size).then([this, offset, range_size, intent] (reader_permit::resource_units units) {
-            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+            auto started = _permit.collects_read_stats() ? std::make_optional(std::chrono::steady_clock::now()) : std::nullopt;
+            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([this, started, units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+                if (started) {
+                    _permit.on_disk_read(buf.size(), std::chrono::steady_clock::now() - *started);
+                }
                 return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), std::move(units)));
             });
         });
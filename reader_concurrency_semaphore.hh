@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
@@ -24,6 +28,69 @@ using namespace seastar;
 class mutation_reader;
 using mutation_reader_opt = optimized_optional<mutation_reader>;
 
+/// A bounded log of the reads which took longer than a threshold.
+///
+/// Permits of semaphores which have a log (see
+/// \ref reader_concurrency_semaphore::set_slow_read_log()) collect a few
+/// counters while they live: the time spent queued in the semaphore, the
+/// time spent reading from disk, the number of sstables read and the number
+/// of bytes read. When a permit which was in use for longer than the threshold
+/// is destroyed, its counters are recorded in the log, which only keeps the
+/// latest entries. The time a permit spends registered as an inactive read,
+/// e.g. between the pages of a paged read, doesn't count.
+class slow_read_log {
+public:
+    struct entry {
+        // Numbers the recorded reads, in the order they were recorded.
+        uint64_t seq;
+        std::chrono::system_clock::time_point started_at;
+        sstring keyspace;
+        sstring table;
+        sstring op_name;
+        sstring semaphore;
+        // Excludes the time registered as an inactive read.
+        std::chrono::microseconds duration;
+        // Waiting for admission, memory or execution in the semaphore.
+        std::chrono::microseconds queued;
+        // Sum of the durations of the disk reads, which may overlap.
+        std::chrono::microseconds disk;
+        uint64_t sstables_read;
+        uint64_t bytes_read;
+    };
+
+    static constexpr size_t default_max_entries = 100;
+private:
+    utils::updateable_value<uint32_t> _threshold_ms;
+    size_t _max_entries;
+    std::deque<entry> _entries;
+    uint64_t _seq = 0;
+public:
+    /// A threshold of 0 disables the log.
+    explicit slow_read_log(utils::updateable_value<uint32_t> threshold_ms, size_t max_entries = default_max_entries);
+
+    bool enabled() const noexcept {
+        return _threshold_ms() != 0;
+    }
+
+    std::chrono::milliseconds threshold() const noexcept {
+        return std::chrono::milliseconds(_threshold_ms());
+    }
+
+    /// Records the entry, dropping the oldest one if the log is full.
+    /// The sequence number of the entry is assigned here.
+    void record(entry e) noexcept;
+
+    /// From the oldest to the newest.
+    const std::deque<entry>& entries() const noexcept {
+        return _entries;
+    }
+
+    /// The number of reads recorded so far, including the dropped ones.
+    uint64_t recorded() const noexcept {
+        return _seq;
+    }
+};
+
 /// Specific semaphore for controlling reader concurrency
 ///
 /// Use `make_permit()` to create a permit to track the resource consumption
@@ -33,7 +100,7 @@ using mutation_reader_opt = optimized_optional<mutation_reader>;
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
 /// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// FIFO order within their admission class, see \ref admission_class.
 /// Semaphore's `name` must be provided in ctor and its only purpose is
 /// to increase readability of exceptions: both timeout exceptions and
 /// queue overflow exceptions (read below) include this `name` in messages.
@@ -77,6 +144,19 @@ class reader_concurrency_semaphore {
 
     using eviction_notify_handler = noncopyable_function<void(evict_reason)>;
 
+    /// The admission class of a permit.
+    ///
+    /// Each class has its own admission queue, so that cheap point reads
+    /// don't have to wait behind a batch of scans in a FIFO queue. When both
+    /// queues have waiters, the point read is admitted first, unless the scan
+    /// at the front of its queue has an earlier timeout. As newer permits have
+    /// later timeouts, this makes point reads overtake scans queued not much
+    /// earlier than them, without starving the scans.
+    enum class admission_class {
+        point, // reads of single partitions
+        scan, // everything else, the default
+    };
+
     struct stats {
         // The number of inactive reads evicted to free up permits.
         uint64_t permit_based_evictions = 0;
@@ -124,6 +204,14 @@ class reader_concurrency_semaphore {
         uint64_t sstables_read = 0;
         // Permits waiting on something: admission, memory or execution
         uint64_t waiters = 0;
+        // Total number of point reads admitted after waiting in the admission queue.
+        uint64_t point_reads_admitted_after_wait = 0;
+        // Total time point reads spent waiting in the admission queue, in microseconds.
+        uint64_t point_reads_admission_wait_time_us = 0;
+        // Total number of scans admitted after waiting in the admission queue.
+        uint64_t scans_admitted_after_wait = 0;
+        // Total time scans spent waiting in the admission queue, in microseconds.
+        uint64_t scans_admission_wait_time_us = 0;
 
         friend auto operator<=>(const stats&, const stats&) = default;
     };
@@ -135,8 +223,22 @@ class reader_concurrency_semaphore {
 
     using read_func = noncopyable_function<future<>(reader_permit)>;
 
+    /// Configuration of the adaptive concurrency controller.
+    ///
+    /// See \ref set_adaptive_concurrency().
+    struct adaptive_concurrency_config {
+        // How often the effective count limit is adjusted.
+        std::chrono::milliseconds adjust_period{500};
+        // The effective count limit is never lowered below this.
+        int min_count = 4;
+        // The effective count limit is lowered when the average service time
+        // of permits exceeds this multiple of the lowest recently observed one.
+        double latency_tolerance = 2.0;
+    };
+
 private:
     struct inactive_read;
+    class adaptive_concurrency_controller;
 
 public:
     class inactive_read_handle {
@@ -166,13 +268,14 @@ class reader_concurrency_semaphore {
     utils::observer<int> _count_observer;
 
     struct wait_queue {
-        // Stores entries for permits waiting to be admitted.
-        permit_list_type _admission_queue;
+        // Stores entries for permits waiting to be admitted, one list for
+        // each admission_class.
+        std::array<permit_list_type, 2> _admission_queues;
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
     public:
         bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
+            return std::ranges::all_of(_admission_queues, [] (const permit_list_type& q) { return q.empty(); }) && _memory_queue.empty();
         }
         void push_to_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
@@ -200,6 +303,13 @@ class reader_concurrency_semaphore {
     named_gate _permit_gate;
     std::optional<future<>> _execution_loop_future;
     reader_permit::impl* _blessed_permit = nullptr;
+    std::unique_ptr<adaptive_concurrency_controller> _adaptive_controller;
+    slow_read_log* _slow_read_log = nullptr;
+    // Count units withheld from admission by the adaptive concurrency controller,
+    // and the number it wants withheld. The difference is consumed by active
+    // reads, their units are withheld as they are released.
+    int _withheld_count = 0;
+    int _withheld_count_target = 0;
 
 private:
     void do_detach_inactive_reader(reader_permit::impl&, evict_reason reason) noexcept;
@@ -249,6 +359,7 @@ class reader_concurrency_semaphore {
 
     void on_permit_created(reader_permit::impl&);
     void on_permit_destroyed(reader_permit::impl&) noexcept;
+    void on_permit_admitted_after_wait(reader_permit::impl&) noexcept;
 
     void on_permit_need_cpu() noexcept;
     void on_permit_not_need_cpu() noexcept;
@@ -256,6 +367,18 @@ class reader_concurrency_semaphore {
     void on_permit_awaits() noexcept;
     void on_permit_not_awaits() noexcept;
 
+    bool adaptive_concurrency_enabled() const noexcept {
+        return bool(_adaptive_controller);
+    }
+    // Reports the time an admitted permit spent active, for adaptive concurrency.
+    void on_permit_served(std::chrono::steady_clock::duration service_time) noexcept;
+    // Withholds all but \p count of the count units from admission. Units
+    // consumed by active reads are only withheld after they are released.
+    void set_effective_count_limit(int count) noexcept;
+    // Moves count units between the available and the withheld ones, towards
+    // _withheld_count_target.
+    void maybe_withhold_count() noexcept;
+
     std::runtime_error stopped_exception();
 
     // closes reader in the background.
@@ -422,8 +545,12 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
-    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
+    /// The admission class selects the admission queue the permit waits in,
+    /// if it cannot be admitted immediately.
+    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            admission_class ac = admission_class::scan);
+    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            admission_class ac = admission_class::scan);
 
     /// Make a tracking only permit
     ///
@@ -461,7 +588,7 @@ class reader_concurrency_semaphore {
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
     future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout,
-            tracing::trace_state_ptr trace_ptr, reader_permit_opt& permit_holder, read_func func);
+            tracing::trace_state_ptr trace_ptr, reader_permit_opt& permit_holder, read_func func, admission_class ac = admission_class::scan);
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -482,6 +609,38 @@ class reader_concurrency_semaphore {
         return _initial_resources;
     }
 
+    /// Enable or disable (with std::nullopt) the adaptive concurrency controller.
+    ///
+    /// When enabled, the controller periodically adjusts the count limit
+    /// based on the average service time of admitted permits and on the
+    /// number of reads waiting on the disk: the limit is lowered when service
+    /// times inflate while the disk is saturated and raised back otherwise.
+    /// The count set by \ref set_resources() remains an upper bound.
+    /// Disabling restores the full count limit.
+    void set_adaptive_concurrency(std::optional<adaptive_concurrency_config> cfg);
+
+    /// Set (or clear, with nullptr) the log which permits record slow reads in.
+    ///
+    /// Only permits created while the log is set and enabled collect the
+    /// counters and may be recorded. The log has to outlive them.
+    void set_slow_read_log(slow_read_log* log) noexcept {
+        _slow_read_log = log;
+    }
+
+    /// The count limit currently applied to admission.
+    ///
+    /// Equals initial_resources().count, unless adaptive concurrency lowered it.
+    int effective_count_limit() const noexcept {
+        return _initial_resources.count - _withheld_count_target;
+    }
+
+    /// The count units currently withheld from admission by adaptive concurrency.
+    ///
+    /// Lags behind the lowered limit until the active reads release their units.
+    int withheld_count() const noexcept {
+        return _withheld_count;
+    }
+
     bool is_unlimited() const {
         return _initial_resources == reader_resources{std::numeric_limits<int>::max(), std::numeric_limits<ssize_t>::max()};
     }
@@ -491,7 +650,7 @@ class reader_concurrency_semaphore {
     }
 
     const resources consumed_resources() const {
-        return _initial_resources - _resources;
+        return _initial_resources - _resources - resources{_withheld_count, 0};
     }
 
     void broken(std::exception_ptr ex = {});
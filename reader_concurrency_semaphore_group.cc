@@ -73,6 +73,12 @@ reader_concurrency_semaphore& reader_concurrency_semaphore_group::add_or_update(
             _cpu_concurrency
         );
     auto&& it = result.first;
+    if (result.second && _adaptive_concurrency) {
+        it->second.sem.set_adaptive_concurrency(_adaptive_concurrency);
+    }
+    if (result.second) {
+        it->second.sem.set_slow_read_log(_slow_read_log);
+    }
     // since we serialize all group changes this change wait will be queues and no further operations
     // will be executed until this adjustment ends.
     (void)change_weight(it->second, shares);
@@ -103,6 +109,20 @@ void reader_concurrency_semaphore_group::foreach_semaphore(std::function<void(sc
     }
 }
 
+void reader_concurrency_semaphore_group::set_adaptive_concurrency(std::optional<reader_concurrency_semaphore::adaptive_concurrency_config> cfg) {
+    _adaptive_concurrency = cfg;
+    for (auto& [sg, wsem] : _semaphores) {
+        wsem.sem.set_adaptive_concurrency(cfg);
+    }
+}
+
+void reader_concurrency_semaphore_group::set_slow_read_log(slow_read_log* log) {
+    _slow_read_log = log;
+    for (auto& [sg, wsem] : _semaphores) {
+        wsem.sem.set_slow_read_log(log);
+    }
+}
+
 future<>
 reader_concurrency_semaphore_group::foreach_semaphore_async(std::function<future<> (scheduling_group, reader_concurrency_semaphore&)> func) {
     auto units = co_await get_units(_operations_serializer, 1);
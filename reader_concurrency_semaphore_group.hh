@@ -46,6 +46,8 @@ class reader_concurrency_semaphore_group {
     std::unordered_map<scheduling_group, weighted_reader_concurrency_semaphore> _semaphores;
     seastar::semaphore _operations_serializer;
     std::optional<sstring> _name_prefix;
+    std::optional<reader_concurrency_semaphore::adaptive_concurrency_config> _adaptive_concurrency;
+    slow_read_log* _slow_read_log = nullptr;
 
     future<> change_weight(weighted_reader_concurrency_semaphore& sem, size_t new_weight);
 
@@ -78,6 +80,10 @@ class reader_concurrency_semaphore_group {
     future<> remove(scheduling_group sg);
     size_t size();
     void foreach_semaphore(std::function<void(scheduling_group, reader_concurrency_semaphore&)> func);
+    // Applies to current and future semaphores of the group.
+    void set_adaptive_concurrency(std::optional<reader_concurrency_semaphore::adaptive_concurrency_config> cfg);
+    // Applies to current and future semaphores of the group.
+    void set_slow_read_log(slow_read_log* log);
 
     future<> foreach_semaphore_async(std::function<future<> (scheduling_group, reader_concurrency_semaphore&)> func);
 
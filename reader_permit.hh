@@ -25,6 +25,12 @@ namespace seastar {
     class file;
 } // namespace seastar
 
+namespace sstables {
+
+class resume_positions;
+
+}
+
 struct reader_resources {
     int count = 0;
     ssize_t memory = 0;
@@ -182,6 +188,16 @@ class reader_permit {
     void on_start_sstable_read() noexcept;
     void on_finish_sstable_read() noexcept;
 
+    // Whether the permit collects the counters of the slow read log, see slow_read_log.
+    bool collects_read_stats() const noexcept;
+    void on_disk_read(uint64_t bytes, std::chrono::steady_clock::duration duration) noexcept;
+
+    // Makes the sstable readers of the permit save their data file positions
+    // when they are closed, for resuming the read after eviction.
+    void enable_sstable_resume_positions();
+    // Null, unless enabled with enable_sstable_resume_positions().
+    sstables::resume_positions* sstable_resume_positions() noexcept;
+
     uintptr_t id() { return reinterpret_cast<uintptr_t>(_impl.get()); }
 };
 
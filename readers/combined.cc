@@ -14,6 +14,7 @@
 #include "readers/range_tombstone_change_merger.hh"
 #include "readers/combined.hh"
 #include "readers/combined_reader_stats.hh"
+#include "utils/loser_tree.hh"
 
 extern logging::logger mrlog;
 
@@ -185,10 +186,22 @@ class mutation_reader_merger {
     // Determines how many times a fragment should be taken from the same
     // reader in order to enter gallop mode. Must be greater than one.
     static constexpr int gallop_mode_entering_threshold = 3;
+    // Partitions with at least this many readers are merged with a loser
+    // tree instead of the fragment heap. For fewer readers the heap is
+    // shallow enough for its extra comparisons not to matter.
+    static constexpr size_t loser_tree_min_readers = 8;
 private:
     struct reader_heap_compare;
     struct fragment_heap_compare;
 
+    struct fragment_tree_compare {
+        position_in_partition::less_compare cmp;
+
+        bool operator()(const reader_and_fragment& a, const reader_and_fragment& b) const {
+            return cmp(a.fragment.position(), b.fragment.position());
+        }
+    };
+
     struct needs_merge_tag { };
     using needs_merge = bool_class<needs_merge_tag>;
 
@@ -232,15 +245,25 @@ class mutation_reader_merger {
     // that the gallop mode was stopped (galloping reader lost to some other reader).
     int _gallop_mode_hits = 0;
     const schema_ptr _schema;
+    // Used instead of _fragment_heap for partitions with many readers.
+    // Readers are refilled in place as soon as they contribute a fragment,
+    // so they never show up in _next.
+    utils::loser_tree<reader_and_fragment, fragment_tree_compare> _fragment_tree;
     streamed_mutation::forwarding _fwd_sm;
     mutation_reader::forwarding _fwd_mr;
 private:
     future<mutation_fragment_batch_opt> maybe_produce_batch();
+    future<mutation_fragment_batch_opt> produce_batch_from_tree();
     void maybe_add_readers_at_partition_boundary();
     void maybe_add_readers(const std::optional<dht::ring_position_view>& pos);
     void add_readers(std::vector<mutation_reader> new_readers);
     bool in_gallop_mode() const;
     future<needs_merge> prepare_one(reader_and_last_fragment_kind rk, reader_galloping reader_galloping);
+    // Moves a reader which is done with the current partition to where it
+    // belongs: _reader_heap if mfo is the start of its next partition,
+    // _halted_readers or the close queue if it reached end-of-stream.
+    void park_reader(reader_and_last_fragment_kind rk, mutation_fragment_v2_opt mfo, reader_galloping reader_galloping);
+    future<> maybe_wait_for_pending_closes();
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
     // Collect all forwardable readers into _next, and remove them from
@@ -364,7 +387,7 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
     // waiting for a fast-forward so there is nothing to do.
-    if (_fragment_heap.empty() && _halted_readers.empty()) {
+    if (_fragment_heap.empty() && _fragment_tree.empty() && _halted_readers.empty()) {
         if (_reader_heap.empty()) {
             maybe_add_readers(std::nullopt);
         } else {
@@ -392,68 +415,75 @@ future<> mutation_reader_merger::prepare_next() {
 future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
         reader_and_last_fragment_kind rk, reader_galloping reader_galloping) {
     return (*rk.reader)().then([this, rk, reader_galloping] (mutation_fragment_v2_opt mfo) {
-        if (mfo) {
-            if (mfo->is_partition_start()) {
-                _reader_heap.emplace_back(rk.reader, std::move(*mfo));
-                std::ranges::push_heap(_reader_heap, reader_heap_compare(*_schema));
-            } else {
-                if (reader_galloping) {
-                    // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
-                        _current.clear();
-                        _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
-                        _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
-                        return make_ready_future<needs_merge>(needs_merge::no);
-                    }
-
-                    _gallop_mode_hits = 0;
+        if (mfo && !mfo->is_partition_start()) {
+            if (reader_galloping) {
+                // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
+                // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
+                if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    _current.clear();
+                    _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
+                    _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
+                    return make_ready_future<needs_merge>(needs_merge::no);
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                std::ranges::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
-            }
-        } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
-            // When in streamed_mutation::forwarding mode we need
-            // to keep track of readers that returned
-            // end-of-stream to know what readers to ff. We can't
-            // just ff all readers as we might drop fragments from
-            // partitions we haven't even read yet.
-            // Readers whose last emitted fragment was a partition
-            // end are out of data for good for the current range.
-            _halted_readers.push_back(rk);
-        } else if (_fwd_mr == mutation_reader::forwarding::no) {
-            mutation_reader r = std::move(*rk.reader);
-            _all_readers.erase(rk.reader);
-            _pending_close++;
-            _to_close = _to_close.then([this, r = std::move(r)] () mutable {
-                return r.close().then([this] { _pending_close--; });
-            });
-            if (reader_galloping) {
-                // Galloping reader iterator may have become invalid at this point, so - to be safe - clear it
-                auto fut = _galloping_reader.reader->close();
-                _to_close = when_all_succeed(std::move(_to_close), std::move(fut)).discard_result();
+                _gallop_mode_hits = 0;
             }
+
+            _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
+            std::ranges::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+        } else {
+            park_reader(rk, std::move(mfo), reader_galloping);
         }
 
         if (reader_galloping) {
             _gallop_mode_hits = 0;
         }
-        // to_close is a chain of mutation_reader close futures,
-        // therefore it can not fail.
-        // To prevent memory usage from growing unbounded, we'll wait for pending closes
-        // if we're submitting them faster than we can retire them.
-        future<> to_close = _pending_close >= 4 ? std::exchange(_to_close, make_ready_future<>()) : make_ready_future<>();
-        return to_close.then([] {
+        return maybe_wait_for_pending_closes().then([] {
             return needs_merge::yes;
         });
     });
 }
 
+void mutation_reader_merger::park_reader(reader_and_last_fragment_kind rk, mutation_fragment_v2_opt mfo, reader_galloping reader_galloping) {
+    if (mfo) {
+        _reader_heap.emplace_back(rk.reader, std::move(*mfo));
+        std::ranges::push_heap(_reader_heap, reader_heap_compare(*_schema));
+    } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
+        // When in streamed_mutation::forwarding mode we need
+        // to keep track of readers that returned
+        // end-of-stream to know what readers to ff. We can't
+        // just ff all readers as we might drop fragments from
+        // partitions we haven't even read yet.
+        // Readers whose last emitted fragment was a partition
+        // end are out of data for good for the current range.
+        _halted_readers.push_back(rk);
+    } else if (_fwd_mr == mutation_reader::forwarding::no) {
+        mutation_reader r = std::move(*rk.reader);
+        _all_readers.erase(rk.reader);
+        _pending_close++;
+        _to_close = _to_close.then([this, r = std::move(r)] () mutable {
+            return r.close().then([this] { _pending_close--; });
+        });
+        if (reader_galloping) {
+            // Galloping reader iterator may have become invalid at this point, so - to be safe - clear it
+            auto fut = _galloping_reader.reader->close();
+            _to_close = when_all_succeed(std::move(_to_close), std::move(fut)).discard_result();
+        }
+    }
+}
+
+future<> mutation_reader_merger::maybe_wait_for_pending_closes() {
+    // to_close is a chain of mutation_reader close futures,
+    // therefore it can not fail.
+    // To prevent memory usage from growing unbounded, we'll wait for pending closes
+    // if we're submitting them faster than we can retire them.
+    return _pending_close >= 4 ? std::exchange(_to_close, make_ready_future<>()) : make_ready_future<>();
+}
+
 void mutation_reader_merger::prepare_forwardable_readers() {
     auto prepare_single_reader = _single_reader.reader != reader_iterator{};
 
-    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size() +
+    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _fragment_tree.size() + _next.size() +
         prepare_single_reader + in_gallop_mode());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
@@ -467,9 +497,13 @@ void mutation_reader_merger::prepare_forwardable_readers() {
     for (auto& df : _fragment_heap) {
         _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
     }
+    _fragment_tree.for_each([this] (reader_and_fragment& df) {
+        _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
+    });
 
     _halted_readers.clear();
     _fragment_heap.clear();
+    _fragment_tree.clear();
 }
 
 mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
@@ -478,6 +512,7 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
     , _schema(std::move(schema))
+    , _fragment_tree(fragment_tree_compare{position_in_partition::less_compare(*_schema)}, gallop_mode_entering_threshold)
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
     maybe_add_readers(std::nullopt);
@@ -524,6 +559,10 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
         return prepare_next().then([] { return make_ready_future<mutation_fragment_batch_opt>(); });
     }
 
+    if (!_fragment_tree.empty()) {
+        return produce_batch_from_tree();
+    }
+
     _current.clear();
 
     // If we ran out of fragments for the current partition, select the
@@ -552,6 +591,12 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
             _gallop_mode_hits = 0;
             return make_ready_future<mutation_fragment_batch_opt>(_current);
         }
+        if (_fragment_heap.size() >= loser_tree_min_readers) {
+            _fragment_tree.assign(_fragment_heap | std::views::as_rvalue);
+            _fragment_heap.clear();
+            _gallop_mode_hits = 0;
+            return produce_batch_from_tree();
+        }
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
@@ -579,6 +624,29 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
     return make_ready_future<mutation_fragment_batch_opt>(_current);
 }
 
+future<mutation_fragment_batch_opt> mutation_reader_merger::produce_batch_from_tree() {
+    _current.clear();
+    const auto equal = position_in_partition::equal_compare(*_schema);
+    do {
+        auto& top = _fragment_tree.top();
+        auto reader = top.reader;
+        _current.emplace_back(std::move(top.fragment), &*reader);
+        // Refill the reader right away, so that it takes a single pass
+        // over the tree to replace its fragment with the next one.
+        auto rk = reader_and_last_fragment_kind(reader, _current.back().fragment.mutation_fragment_kind());
+        auto mfo = co_await (*reader)();
+        if (mfo && !mfo->is_partition_start()) {
+            _fragment_tree.replace_top(reader_and_fragment(reader, std::move(*mfo)));
+        } else {
+            _fragment_tree.pop_top();
+            park_reader(rk, std::move(mfo), reader_galloping::no);
+            co_await maybe_wait_for_pending_closes();
+        }
+    } while (!_fragment_tree.empty() && equal(_current.front().fragment.position(), _fragment_tree.top().fragment.position()));
+    maybe_add_readers_at_partition_boundary();
+    co_return _current;
+}
+
 future<> mutation_reader_merger::next_partition() {
     // If the last batch of fragments returned by operator() came from partition P,
     // we must forward to the partition immediately following P (as per the `next_partition`
@@ -605,6 +673,7 @@ future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr)
     _next.clear();
     _halted_readers.clear();
     _fragment_heap.clear();
+    _fragment_tree.clear();
     _reader_heap.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
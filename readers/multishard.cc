@@ -555,6 +555,9 @@ evictable_reader::evictable_reader(
     , _fwd_mr(fwd_mr)
     , _tri_cmp(*_schema)
     , _reader(std::move(reader)) {
+    // Lets the sstable readers of a recreated reader resume without looking
+    // up the index.
+    _permit.enable_sstable_resume_positions();
 }
 
 future<> evictable_reader::fill_buffer() {
@@ -706,6 +709,9 @@ struct buffer_fill_hint {
 //
 // Shard reader manages a reader located on a remote shard. It transparently
 // supports read-ahead (background fill_buffer() calls).
+// The depth of the read-ahead adapts to the shard: it grows while the read-aheads
+// are still in progress when their fragments are needed, that is while the
+// shard is slower than the consumer, and shrinks back once they complete in time.
 // This reader is not for general use, it was designed to serve the
 // multishard_combining_reader.
 // Although it implements the mutation_reader:impl interface it cannot be
@@ -720,8 +726,11 @@ class shard_reader : public mutation_reader::impl {
     tracing::global_trace_state_ptr _trace_state;
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
+    // Number of buffers filled by a read-ahead.
+    unsigned _read_ahead_depth = 1;
     foreign_ptr<std::unique_ptr<evictable_reader>> _reader;
 
+    static constexpr unsigned max_read_ahead_depth = 8;
 private:
     future<remote_fill_buffer_result> fill_reader_buffer(evictable_reader& reader, std::optional<buffer_fill_hint> hint);
     future<> do_fill_buffer(std::optional<buffer_fill_hint> hint);
@@ -924,6 +933,12 @@ future<> shard_reader::fill_buffer(std::optional<buffer_fill_hint> hint) {
     // FIXME: want to move this to the inner scopes but it makes clang miscompile the code.
     reader_permit::awaits_guard guard(_permit);
     if (_read_ahead) {
+        if (_read_ahead->available()) {
+            _read_ahead_depth = std::max(_read_ahead_depth - 1, 1u);
+        } else {
+            // The shard is on the critical path.
+            _read_ahead_depth = std::min(_read_ahead_depth * 2, max_read_ahead_depth);
+        }
         co_await *std::exchange(_read_ahead, std::nullopt);
         co_return;
     }
@@ -986,7 +1001,16 @@ void shard_reader::read_ahead() {
         return;
     }
 
-    _read_ahead.emplace(do_fill_buffer(std::nullopt));
+    std::optional<buffer_fill_hint> hint;
+    if (_read_ahead_depth > 1) {
+        // The fragments are accounted in the semaphore of the permit once they are
+        // brought over, only read deeper than a buffer if it has the memory for them.
+        const auto size = _read_ahead_depth * max_buffer_size_in_bytes;
+        if (_permit.semaphore().available_resources().memory >= ssize_t(size)) {
+            hint.emplace(size, dht::maximum_token());
+        }
+    }
+    _read_ahead.emplace(do_fill_buffer(std::move(hint)));
 }
 
 } // anonymous namespace
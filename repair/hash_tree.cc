@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "repair/hash_tree.hh"
+#include <seastar/coroutine/maybe_yield.hh>
+#include <algorithm>
+#include <stdexcept>
+
+namespace repair {
+
+// Rows per leaf the depth is chosen for
+static constexpr size_t hash_tree_rows_per_leaf = 8;
+
+unsigned hash_tree_depth_for(size_t rows) {
+    unsigned depth = 1;
+    size_t leaves = hash_tree_fanout;
+    while (depth < hash_tree_max_depth && leaves * hash_tree_rows_per_leaf < rows) {
+        ++depth;
+        leaves *= hash_tree_fanout;
+    }
+    return depth;
+}
+
+static void check_level(unsigned level) {
+    if (level > hash_tree_max_depth) {
+        throw std::invalid_argument(fmt::format("Invalid repair hash tree level {}", level));
+    }
+}
+
+uint32_t hash_tree_node_of(repair_hash h, unsigned level) {
+    if (level == 0) {
+        return 0;
+    }
+    return h.hash >> (64 - level * hash_tree_bits_per_level);
+}
+
+static void check_node(unsigned level, uint32_t node) {
+    const uint64_t nodes_at_level = uint64_t(1) << (level * hash_tree_bits_per_level);
+    if (node >= nodes_at_level) {
+        throw std::invalid_argument(fmt::format("Invalid repair hash tree node {} at level {}", node, level));
+    }
+}
+
+future<const hash_tree::level_values*> hash_tree::get_level(unsigned level) {
+    check_level(level);
+    if (!_levels[level]) {
+        level_values values;
+        for (const auto& h : _hashes) {
+            auto node = hash_tree_node_of(h, level);
+            if (values.empty() || values.back().first != node) {
+                values.emplace_back(node, repair_hash());
+            }
+            values.back().second.add(h);
+            co_await coroutine::maybe_yield();
+        }
+        // A concurrent request could have computed the level in the meantime.
+        if (!_levels[level]) {
+            _levels[level] = std::move(values);
+        }
+    }
+    co_return &*_levels[level];
+}
+
+future<std::vector<repair_hash>> hash_tree::get_nodes(unsigned level, const std::vector<uint32_t>& nodes) {
+    const auto& values = *co_await get_level(level);
+    std::vector<repair_hash> ret;
+    ret.reserve(nodes.size());
+    for (auto node : nodes) {
+        check_node(level, node);
+        auto it = std::lower_bound(values.begin(), values.end(), node, [] (const auto& v, uint32_t n) { return v.first < n; });
+        ret.push_back(it != values.end() && it->first == node ? it->second : repair_hash());
+        co_await coroutine::maybe_yield();
+    }
+    co_return ret;
+}
+
+future<repair_hash_set> hash_tree::get_hashes_in_nodes(unsigned level, const std::vector<uint32_t>& nodes) const {
+    check_level(level);
+    const unsigned shift = 64 - level * hash_tree_bits_per_level;
+    const uint64_t nodes_at_level = uint64_t(1) << (level * hash_tree_bits_per_level);
+    repair_hash_set ret;
+    for (auto node : nodes) {
+        check_node(level, node);
+        auto first = level == 0 ? _hashes.begin() : _hashes.lower_bound(repair_hash(uint64_t(node) << shift));
+        auto last = level == 0 || node + 1 == nodes_at_level ? _hashes.end() : _hashes.lower_bound(repair_hash(uint64_t(node + 1) << shift));
+        // Nodes are sorted, so the hashes are inserted in order.
+        ret.insert(first, last);
+        co_await coroutine::maybe_yield();
+    }
+    co_return ret;
+}
+
+std::vector<uint32_t> hash_tree_mismatched_nodes(const std::vector<uint32_t>& nodes,
+        const std::vector<repair_hash>& a, const std::vector<repair_hash>& b) {
+    if (a.size() != nodes.size() || b.size() != nodes.size()) {
+        throw std::runtime_error(fmt::format("Got {} and {} repair hash tree nodes, expected {}", a.size(), b.size(), nodes.size()));
+    }
+    std::vector<uint32_t> mismatched;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (a[i] != b[i]) {
+            mismatched.push_back(nodes[i]);
+        }
+    }
+    return mismatched;
+}
+
+std::vector<uint32_t> hash_tree_children(const std::vector<uint32_t>& nodes) {
+    std::vector<uint32_t> children;
+    children.reserve(nodes.size() * hash_tree_fanout);
+    for (auto node : nodes) {
+        for (uint32_t c = 0; c < hash_tree_fanout; ++c) {
+            children.push_back(node * hash_tree_fanout + c);
+        }
+    }
+    return children;
+}
+
+} // namespace repair
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+#include <seastar/core/future.hh>
+#include "repair/hash.hh"
+#include "utils/chunked_vector.hh"
+
+// A hash tree (Merkle tree) over a set of repair row hashes.
+//
+// When the combined hashes of a row buffer differ between the master and a
+// follower, the master can walk the tree of the follower's working row buffer
+// level by level, descending only into the nodes which differ from its own
+// tree, and then fetch the row hashes of the mismatched leaves only, instead
+// of the full set of row hashes.
+//
+// The tree partitions the space of `repair_hasher` outputs rather than the
+// token range, so all replicas build identically shaped trees no matter which
+// rows they have, and nothing but node values has to be exchanged. Node `i`
+// of level `l` (the root being level 0) covers the hashes whose top
+// `l * hash_tree_bits_per_level` bits are equal to `i`, and its value is the
+// XOR of those hashes. In particular, the root is the combined hash of the set.
+//
+// Only the non-empty nodes of the levels which are asked for are kept: the
+// values of the nodes of a level are computed in a single pass over the sorted
+// `repair_hash_set` when the level is first used.
+namespace repair {
+
+constexpr unsigned hash_tree_bits_per_level = 4;
+constexpr uint32_t hash_tree_fanout = 1 << hash_tree_bits_per_level;
+constexpr unsigned hash_tree_max_depth = 5;
+
+// Depth of the tree the master uses for a row buffer with `rows` rows,
+// aiming at a handful of rows per leaf.
+unsigned hash_tree_depth_for(size_t rows);
+
+// Index of the node of `level` covering `h`.
+uint32_t hash_tree_node_of(repair_hash h, unsigned level);
+
+class hash_tree {
+    repair_hash_set _hashes;
+    // The non-empty nodes of each level and their values, sorted by node.
+    using level_values = utils::chunked_vector<std::pair<uint32_t, repair_hash>>;
+    std::array<std::optional<level_values>, hash_tree_max_depth + 1> _levels;
+private:
+    future<const level_values*> get_level(unsigned level);
+public:
+    explicit hash_tree(repair_hash_set hashes) noexcept : _hashes(std::move(hashes)) {}
+
+    const repair_hash_set& hashes() const noexcept {
+        return _hashes;
+    }
+
+    // Returns the values of the given nodes of `level`.
+    future<std::vector<repair_hash>> get_nodes(unsigned level, const std::vector<uint32_t>& nodes);
+
+    // Returns the hashes covered by the given nodes of `level`.
+    // `nodes` must be sorted.
+    future<repair_hash_set> get_hashes_in_nodes(unsigned level, const std::vector<uint32_t>& nodes) const;
+};
+
+// Returns those of `nodes` whose values in `a` and `b` differ.
+std::vector<uint32_t> hash_tree_mismatched_nodes(const std::vector<uint32_t>& nodes,
+        const std::vector<repair_hash>& a, const std::vector<repair_hash>& b);
+
+// Returns the children of `nodes`, in the next level. The result is sorted if `nodes` is.
+std::vector<uint32_t> hash_tree_children(const std::vector<uint32_t>& nodes);
+
+} // namespace repair
@@ -810,6 +810,7 @@ void repair_stats::add(const repair_stats& o) {
     round_nr_fast_path_already_synced += o.round_nr_fast_path_already_synced;
     round_nr_fast_path_same_combined_hashes += o.round_nr_fast_path_same_combined_hashes;
     round_nr_slow_path += o.round_nr_slow_path;
+    hash_tree_nr += o.hash_tree_nr;
     rpc_call_nr += o.rpc_call_nr;
     tx_hashes_nr += o.tx_hashes_nr;
     rx_hashes_nr += o.rx_hashes_nr;
@@ -846,11 +847,12 @@ sstring repair_stats::get_stats() {
             row_from_disk_rows_per_sec[x.first] = 0;
         }
     }
-    return seastar::format("round_nr={}, round_nr_fast_path_already_synced={}, round_nr_fast_path_same_combined_hashes={}, round_nr_slow_path={}, rpc_call_nr={}, tx_hashes_nr={}, rx_hashes_nr={}, duration={} seconds, tx_row_nr={}, rx_row_nr={}, tx_row_bytes={}, rx_row_bytes={}, row_from_disk_bytes={}, row_from_disk_nr={}, row_from_disk_bytes_per_sec={} MiB/s, row_from_disk_rows_per_sec={} Rows/s, tx_row_nr_peer={}, rx_row_nr_peer={}",
+    return seastar::format("round_nr={}, round_nr_fast_path_already_synced={}, round_nr_fast_path_same_combined_hashes={}, round_nr_slow_path={}, hash_tree_nr={}, rpc_call_nr={}, tx_hashes_nr={}, rx_hashes_nr={}, duration={} seconds, tx_row_nr={}, rx_row_nr={}, tx_row_bytes={}, rx_row_bytes={}, row_from_disk_bytes={}, row_from_disk_nr={}, row_from_disk_bytes_per_sec={} MiB/s, row_from_disk_rows_per_sec={} Rows/s, tx_row_nr_peer={}, rx_row_nr_peer={}",
             round_nr,
             round_nr_fast_path_already_synced,
             round_nr_fast_path_same_combined_hashes,
             round_nr_slow_path,
+            hash_tree_nr,
             rpc_call_nr,
             tx_hashes_nr,
             rx_hashes_nr,
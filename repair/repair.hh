@@ -115,6 +115,8 @@ class repair_stats {
     uint64_t round_nr_fast_path_already_synced = 0;
     uint64_t round_nr_fast_path_same_combined_hashes= 0;
     uint64_t round_nr_slow_path = 0;
+    // Number of times row hashes were fetched from a peer through the hash tree
+    uint64_t hash_tree_nr = 0;
 
     uint64_t rpc_call_nr = 0;
 
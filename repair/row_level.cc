@@ -63,6 +63,7 @@
 #include "repair/writer.hh"
 #include "repair/reader.hh"
 #include "repair/incremental.hh"
+#include "repair/hash_tree.hh"
 #include "compaction/compaction_manager.hh"
 #include "utils/xx_hasher.hh"
 #include "utils/error_injection.hh"
@@ -103,6 +104,8 @@ enum class repair_state : uint16_t {
     get_full_row_hashes_with_rpc_stream_finished,
     get_full_row_hashes_started,
     get_full_row_hashes_finished,
+    get_row_hashes_with_hash_tree_started,
+    get_row_hashes_with_hash_tree_finished,
     get_row_diff_started,
     get_row_diff_finished,
     put_row_diff_with_rpc_stream_started,
@@ -196,6 +199,8 @@ struct row_level_repair_metrics {
     uint64_t rx_hashes_nr{0};
     uint64_t inc_sst_skipped_bytes{0};
     uint64_t inc_sst_read_bytes{0};
+    uint64_t inc_sst_skipped_nr{0};
+    uint64_t inc_sst_read_nr{0};
     row_level_repair_metrics() {
         namespace sm = seastar::metrics;
         _metrics.add_group("repair", {
@@ -219,6 +224,10 @@ struct row_level_repair_metrics {
                             sm::description("Total number of bytes skipped from sstables for incremental repair on this shard.")),
             sm::make_counter("inc_sst_read_bytes", inc_sst_read_bytes,
                             sm::description("Total number of bytes read from sstables for incremental repair on this shard.")),
+            sm::make_counter("inc_sst_skipped_nr", inc_sst_skipped_nr,
+                            sm::description("Total number of already repaired sstables skipped by incremental repair on this shard.")),
+            sm::make_counter("inc_sst_read_nr", inc_sst_read_nr,
+                            sm::description("Total number of sstables read by incremental repair on this shard.")),
         });
     }
 };
@@ -332,7 +341,9 @@ mutation_reader repair_reader::make_reader(
                 });
         }
         case read_strategy::incremental_repair: {
-            return cf.make_streaming_reader(_schema, _permit, _range, inc.sst_set, gc_clock::now());
+            // Use the compaction time chosen by the master, like the other strategies, so that
+            // all replicas compact the data they hash identically.
+            return cf.make_streaming_reader(_schema, _permit, _range, inc.sst_set, compaction_time);
         }
         default:
             on_internal_error(rlogger,
@@ -774,6 +785,9 @@ class repair_meta {
     std::list<repair_row> _working_row_buf;
     // Combines all the repair_hash in _working_row_buf
     repair_hash _working_row_buf_combined_hash;
+    // The hash tree of _working_row_buf, built on first use by a hash
+    // tree walk and dropped whenever _working_row_buf changes
+    lw_shared_ptr<repair::hash_tree> _working_row_buf_hash_tree;
     // Tracks the last sync boundary
     std::optional<repair_sync_boundary> _last_sync_boundary;
     // Tracks current sync boundary
@@ -968,6 +982,7 @@ class repair_meta {
 public:
     future<> clear_gently() noexcept {
         co_await utils::clear_gently(_peer_row_hash_sets);
+        _working_row_buf_hash_tree = {};
         co_await utils::clear_gently(_working_row_buf);
         co_await utils::clear_gently(_row_buf);
     }
@@ -1021,6 +1036,18 @@ class repair_meta {
         co_return std::move(hashes);
     }
 
+    // Get the hash tree of _working_row_buf
+    future<lw_shared_ptr<repair::hash_tree>>
+    working_row_hash_tree() {
+        if (!_working_row_buf_hash_tree) {
+            auto tree = make_lw_shared<repair::hash_tree>(co_await working_row_hashes());
+            if (!_working_row_buf_hash_tree) {
+                _working_row_buf_hash_tree = std::move(tree);
+            }
+        }
+        co_return _working_row_buf_hash_tree;
+    }
+
     std::pair<std::optional<repair_sync_boundary>, bool>
     get_common_sync_boundary(bool zero_rows,
             std::vector<repair_sync_boundary>& sync_boundaries,
@@ -1175,22 +1202,34 @@ class repair_meta {
         auto sstables = co_await table.take_storage_snapshot(_range);
         _incremental_repair_meta.sst_set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(_schema, _range));
         _incremental_repair_meta.sstables_repaired_at = sstables_repaired_at;
+        size_t skipped_nr = 0;
+        uint64_t skipped_bytes = 0;
+        size_t read_nr = 0;
+        uint64_t read_bytes = 0;
         for (auto& snap : sstables) {
             co_await coroutine::maybe_yield();
             auto& sst = snap.sst;
             auto bytes_on_disk = sst->bytes_on_disk();
             if (repair::is_repaired(sstables_repaired_at, sst)) {
-                rlogger.info("Skipped adding sst={} repaired_at={} sstables_repaired_at={} being_repaired={} session_id={} for incremental repair",
+                rlogger.debug("Skipped adding sst={} repaired_at={} sstables_repaired_at={} being_repaired={} session_id={} for incremental repair",
                     sst->toc_filename(), sst->get_stats_metadata().repaired_at, sstables_repaired_at, sst->being_repaired, _frozen_topology_guard);
                 _metrics.inc_sst_skipped_bytes += bytes_on_disk;
+                _metrics.inc_sst_skipped_nr++;
+                skipped_nr++;
+                skipped_bytes += bytes_on_disk;
             } else {
                 sst->mark_as_being_repaired(_frozen_topology_guard);
-                rlogger.info("Added sst={} repaired_at={} sstables_repaired_at={} being_repaired={} session_id={} for incremental repair",
+                rlogger.debug("Added sst={} repaired_at={} sstables_repaired_at={} being_repaired={} session_id={} for incremental repair",
                     sst->toc_filename(), sst->get_stats_metadata().repaired_at, sstables_repaired_at, sst->being_repaired, _frozen_topology_guard);
                 _incremental_repair_meta.sst_set->insert(sst);
                 _metrics.inc_sst_read_bytes += bytes_on_disk;
+                _metrics.inc_sst_read_nr++;
+                read_nr++;
+                read_bytes += bytes_on_disk;
             }
         }
+        rlogger.info("Incremental repair of table={} range={} session_id={} sstables_repaired_at={}: reading {} sstables ({} bytes), skipped {} repaired sstables ({} bytes)",
+                _schema->id(), _range, _frozen_topology_guard, sstables_repaired_at, read_nr, read_bytes, skipped_nr, skipped_bytes);
         // Note: It is safe to re-enable compaction again because all
         // sstables particiating the repair have been marked as
         // being_repaired which will be ignored by the new unrepaired
@@ -1303,6 +1342,7 @@ class repair_meta {
     }
 
     future<> clear_working_row_buf() {
+        _working_row_buf_hash_tree = {};
         co_await utils::clear_gently(_working_row_buf);
         _working_row_buf_combined_hash.clear();
     }
@@ -1378,6 +1418,7 @@ class repair_meta {
         rlogger.trace("SET _current_sync_boundary to {}, common_sync_boundary={}", _current_sync_boundary, common_sync_boundary);
         _working_row_buf.clear();
         _working_row_buf_combined_hash.clear();
+        _working_row_buf_hash_tree = {};
 
         if (_row_buf.empty()) {
             co_return get_combined_row_hash_response();
@@ -1419,6 +1460,7 @@ class repair_meta {
     get_row_diff(repair_hash_set set_diff, needs_all_rows_t needs_all_rows = needs_all_rows_t::no) {
         if (needs_all_rows) {
             if (!_repair_master || _nr_peer_nodes == 1) {
+                _working_row_buf_hash_tree = {};
                 return make_ready_future<std::list<repair_row>>(std::move(_working_row_buf));
             }
             return copy_rows_from_working_row_buf();
@@ -1430,6 +1472,9 @@ class repair_meta {
     future<> do_apply_rows(std::list<repair_row> row_diff, update_working_row_buf update_buf) {
         auto sem_units = co_await get_units(_repair_writer->sem(), 1);
         _repair_writer->create_writer();
+        if (update_buf) {
+            _working_row_buf_hash_tree = {};
+        }
         while (!row_diff.empty()) {
             repair_row& r = row_diff.front();
             if (update_buf) {
@@ -1460,6 +1505,7 @@ class repair_meta {
         stats().rx_row_nr += row_diff.size();
         stats().rx_row_nr_peer[from] += row_diff.size();
         if (update_buf) {
+            _working_row_buf_hash_tree = {};
             // Both row_diff and _working_row_buf and are ordered, merging
             // two sored list to make sure the combination of row_diff
             // and _working_row_buf are ordered.
@@ -1692,6 +1738,81 @@ class repair_meta {
         co_return co_await working_row_hashes();
     }
 
+    bool use_hash_tree() const {
+        auto min_rows = _db.local().get_config().repair_hash_tree_min_rows();
+        return min_rows && _working_row_buf.size() >= min_rows && _db.local().features().repair_hash_tree;
+    }
+
+    // RPC API
+    // Compares the hash trees (see repair/hash_tree.hh) of the working row bufs of the
+    // local and the remote node and returns the row hashes of the remote working row buf,
+    // fetching from the peer only the hashes in the mismatched leaves of the tree. The rest
+    // are known to be identical to the local ones.
+    // Returns std::nullopt if the trees differ in so many places that fetching the full
+    // set of row hashes is cheaper.
+    future<std::optional<repair_hash_set>>
+    get_row_hashes_with_hash_tree(locator::host_id remote_node, shard_id dst_cpu_id) {
+        auto local_tree = co_await working_row_hash_tree();
+        const auto& local_hashes = local_tree->hashes();
+        const unsigned depth = repair::hash_tree_depth_for(local_hashes.size());
+        // The children of the root
+        auto nodes = repair::hash_tree_children({0});
+        for (unsigned level = 1; ; ++level) {
+            auto remote_values = co_await ser::repair_rpc_verbs::send_repair_get_row_hash_tree_nodes(&_messaging, remote_node,
+                    _repair_meta_id, level, nodes, dst_cpu_id);
+            stats().rpc_call_nr++;
+            stats().rx_hashes_nr += remote_values.size();
+            _metrics.rx_hashes_nr += remote_values.size();
+            auto local_values = co_await local_tree->get_nodes(level, nodes);
+            nodes = repair::hash_tree_mismatched_nodes(nodes, local_values, remote_values);
+            const uint64_t nodes_at_level = uint64_t(1) << (level * repair::hash_tree_bits_per_level);
+            if (nodes.size() * 2 > nodes_at_level) {
+                rlogger.debug("get_row_hashes_with_hash_tree: peer={}, {} of {} nodes differ at level {}, falling back to the full set",
+                        remote_node, nodes.size(), nodes_at_level, level);
+                co_return std::nullopt;
+            }
+            if (level == depth || nodes.empty()) {
+                break;
+            }
+            nodes = repair::hash_tree_children(nodes);
+        }
+        stats().hash_tree_nr++;
+        if (nodes.empty()) {
+            co_return local_hashes;
+        }
+        auto remote_hashes = co_await ser::repair_rpc_verbs::send_repair_get_row_hashes_in_hash_tree_nodes(&_messaging, remote_node,
+                _repair_meta_id, depth, nodes, dst_cpu_id);
+        stats().rpc_call_nr++;
+        stats().rx_hashes_nr += remote_hashes.size();
+        _metrics.rx_hashes_nr += remote_hashes.size();
+        rlogger.debug("get_row_hashes_with_hash_tree: peer={}, depth={}, mismatched_leaves={}, local_hashes={}, fetched_hashes={}",
+                remote_node, depth, nodes.size(), local_hashes.size(), remote_hashes.size());
+        for (const auto& h : local_hashes) {
+            if (!std::ranges::binary_search(nodes, repair::hash_tree_node_of(h, depth))) {
+                remote_hashes.insert(h);
+            }
+            co_await coroutine::maybe_yield();
+        }
+        co_return std::move(remote_hashes);
+    }
+
+    // RPC handler
+    future<std::vector<repair_hash>>
+    get_row_hash_tree_nodes_handler(unsigned level, std::vector<uint32_t> nodes) {
+        auto gate_held = _gate.hold();
+        auto tree = co_await working_row_hash_tree();
+        co_return co_await tree->get_nodes(level, nodes);
+    }
+
+    // RPC handler
+    future<repair_hash_set>
+    get_row_hashes_in_hash_tree_nodes_handler(unsigned level, std::vector<uint32_t> nodes) {
+        auto gate_held = _gate.hold();
+        auto tree = co_await working_row_hash_tree();
+        std::ranges::sort(nodes);
+        co_return co_await tree->get_hashes_in_nodes(level, nodes);
+    }
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -2666,6 +2787,28 @@ future<> repair_service::init_ms_handlers() {
             });
         }) ;
     });
+    ser::repair_rpc_verbs::register_repair_get_row_hash_tree_nodes(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+            uint32_t level, std::vector<uint32_t> nodes, shard_id dst_cpu_id) {
+        auto from = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        return container().invoke_on(dst_cpu_id, [from, repair_meta_id, level, nodes = std::move(nodes)] (repair_service& local_repair) mutable {
+            auto rm = local_repair.get_repair_meta(from, repair_meta_id);
+            return rm->get_row_hash_tree_nodes_handler(level, std::move(nodes)).then([rm] (std::vector<repair_hash> values) {
+                _metrics.tx_hashes_nr += values.size();
+                return values;
+            });
+        });
+    });
+    ser::repair_rpc_verbs::register_repair_get_row_hashes_in_hash_tree_nodes(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+            uint32_t level, std::vector<uint32_t> nodes, shard_id dst_cpu_id) {
+        auto from = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        return container().invoke_on(dst_cpu_id, [from, repair_meta_id, level, nodes = std::move(nodes)] (repair_service& local_repair) mutable {
+            auto rm = local_repair.get_repair_meta(from, repair_meta_id);
+            return rm->get_row_hashes_in_hash_tree_nodes_handler(level, std::move(nodes)).then([rm] (repair_hash_set hashes) {
+                _metrics.tx_hashes_nr += hashes.size();
+                return hashes;
+            });
+        });
+    });
     ser::repair_rpc_verbs::register_repair_get_combined_row_hash(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
             std::optional<repair_sync_boundary> common_sync_boundary, rpc::optional<shard_id> dst_cpu_id_opt) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
@@ -3134,8 +3277,19 @@ class row_level_repair {
 
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
+            // If the working row buf is large, try to find the differing
+            // rows by descending the hash tree before falling back to
+            // transferring all of the peer's row hashes.
+            std::optional<repair_hash_set> hashes_from_tree;
+            if (master.use_hash_tree()) {
+                ns.state = repair_state::get_row_hashes_with_hash_tree_started;
+                hashes_from_tree = master.get_row_hashes_with_hash_tree(node, dst_cpu_id).get();
+                ns.state = repair_state::get_row_hashes_with_hash_tree_finished;
+            }
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (hashes_from_tree) {
+                master.peer_row_hash_sets(node_idx) = std::move(*hashes_from_tree);
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx, dst_cpu_id).get();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -114,6 +114,8 @@ class compaction_group {
     // replace entire sstable sets, they are still called only by compaction, so the maximum
     // seen timestamp remains the same and there is no need to update the variable in those cases.
     api::timestamp_type _max_seen_timestamp = api::missing_timestamp;
+    // Number of reads and writes served by the group, which make up the heat of its tablet.
+    uint64_t _requests = 0;
 public:
     compaction_group(table& t, size_t gid, dht::token_range token_range, repair_classifier_func repair_classifier);
     ~compaction_group();
@@ -133,6 +135,13 @@ class compaction_group {
         return _group_id;
     }
 
+    void note_request() noexcept {
+        ++_requests;
+    }
+    uint64_t requests() const noexcept {
+        return _requests;
+    }
+
     const schema_ptr& schema() const;
 
     // Stops all activity in the group, synchronizes with in-flight writes, before
@@ -274,6 +283,8 @@ class storage_group {
     std::vector<compaction_group_ptr> _merging_groups;
     std::vector<compaction_group_ptr> _split_ready_groups;
     seastar::named_gate _async_gate;
+    // Number of requests served by the group when its heat was last sampled.
+    std::optional<uint64_t> _sampled_requests;
 private:
     bool splitting_mode() const {
         return !_split_ready_groups.empty();
@@ -301,6 +312,12 @@ class storage_group {
 
     uint64_t live_disk_space_used() const noexcept;
 
+    // Number of reads and writes served by the compaction groups.
+    uint64_t requests() const noexcept;
+    // Returns the number of requests served since the previous call, or
+    // nullopt on the first one, e.g. after the group was created by a resize.
+    std::optional<uint64_t> sample_requests() noexcept;
+
     void for_each_compaction_group(std::function<void(const compaction_group_ptr&)> action) const noexcept;
     utils::small_vector<compaction_group_ptr, 3> compaction_groups() noexcept;
     utils::small_vector<const_compaction_group_ptr, 3> compaction_groups() const noexcept;
@@ -427,11 +444,15 @@ class storage_group_manager {
     virtual utils::chunked_vector<storage_group_ptr> storage_groups_for_token_range(dht::token_range tr) const = 0;
 
     virtual locator::table_load_stats table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept = 0;
+    // Returns the request rates of tablets since the previous call.
+    virtual locator::tablet_heat_stats tablet_heat_stats() noexcept = 0;
     virtual bool all_storage_groups_split() = 0;
     virtual future<> split_all_storage_groups(tasks::task_info tablet_split_task_info) = 0;
     virtual future<> maybe_split_compaction_group_of(size_t idx) = 0;
     virtual future<std::vector<sstables::shared_sstable>> maybe_split_sstable(const sstables::shared_sstable& sst) = 0;
     virtual dht::token_range get_token_range_after_split(const dht::token&) const noexcept = 0;
+    // Returns the options for splitting the data of the group, if it awaits split.
+    virtual std::optional<sstables::compaction_type_options::split> split_options_for(const compaction_group& cg) const noexcept = 0;
 
     virtual lw_shared_ptr<sstables::sstable_set> make_sstable_set() const = 0;
 };
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "replica/counter_cache.hh"
+#include "counters.hh"
+#include "mutation/mutation.hh"
+#include "schema/schema.hh"
+
+namespace replica {
+
+size_t counter_cache::key_hash::operator()(const key_type& k) const noexcept {
+    return std::hash<table_id>()(k.table) ^ std::hash<bytes_view>()(k.key);
+}
+
+counter_cache::counter_cache(size_t capacity) noexcept
+    : _capacity(capacity)
+{ }
+
+counter_cache::key_type counter_cache::make_key(const schema& s, partition_key_view key) {
+    return key_type{s.id(), to_bytes(key.representation())};
+}
+
+void counter_cache::set_capacity(size_t capacity) noexcept {
+    _capacity = capacity;
+    evict();
+}
+
+void counter_cache::erase(map_type::iterator it) noexcept {
+    _used -= it->second.memory_usage;
+    _entries.erase(it);
+}
+
+void counter_cache::invalidate(map_type::iterator it) noexcept {
+    ++_stats.invalidations;
+    erase(it);
+}
+
+void counter_cache::update_memory_usage(entry& e) noexcept {
+    // Approximates the overhead of a node of the map.
+    static constexpr size_t cell_overhead = 4 * sizeof(void*);
+    size_t usage = sizeof(map_type::value_type) + e.key->key.size();
+    for (auto& [key, shard] : e.cells) {
+        usage += cell_overhead + sizeof(cell_key) + sizeof(shard) + key.clustering_key.size();
+    }
+    _used = _used - e.memory_usage + usage;
+    e.memory_usage = usage;
+}
+
+void counter_cache::evict() noexcept {
+    while (_used > _capacity && !_lru.empty()) {
+        auto& e = _lru.front();
+        ++_stats.evictions;
+        erase(_entries.find(*e.key));
+    }
+}
+
+std::optional<mutation> counter_cache::get(const mutation& update, version_type version, locator::host_id local_id) {
+    const auto& s = *update.schema();
+    auto it = _entries.find(make_key(s, update.key()));
+    if (it == _entries.end()) {
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    auto& e = it->second;
+    if (e.schema_version != s.version() || e.version != version) {
+        ++_stats.misses;
+        invalidate(it);
+        return std::nullopt;
+    }
+
+    auto id = counter_id(local_id.uuid());
+    mutation current(update.schema(), update.decorated_key());
+    bool all_cached = true;
+    auto find_cells = [&] (bool is_static, const bytes& ckey, const row& cells, auto&& set_cell) {
+        auto kind = is_static ? column_kind::static_column : column_kind::regular_column;
+        cells.for_each_cell_until([&] (column_id cid, const atomic_cell_or_collection& ac_o_c) {
+            auto& cdef = s.column_at(kind, cid);
+            auto acv = ac_o_c.as_atomic_cell(cdef);
+            auto cell = e.cells.find(cell_key{is_static, ckey, cid});
+            if (cell == e.cells.end()) {
+                all_cached = false;
+                return stop_iteration::yes;
+            }
+            set_cell(cdef, counter_cell_builder::from_single_shard(acv.timestamp(),
+                    counter_shard(id, cell->second.value, cell->second.logical_clock)));
+            return stop_iteration::no;
+        });
+    };
+    find_cells(true, bytes(), update.partition().static_row().get(), [&] (const column_definition& cdef, atomic_cell&& ac) {
+        current.set_static_cell(cdef, std::move(ac));
+    });
+    for (auto& cr : update.partition().clustered_rows()) {
+        if (!all_cached) {
+            break;
+        }
+        find_cells(false, to_bytes(managed_bytes_view(cr.key().representation())), cr.row().cells(), [&] (const column_definition& cdef, atomic_cell&& ac) {
+            current.set_clustered_cell(cr.key(), cdef, std::move(ac));
+        });
+    }
+    if (!all_cached) {
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    ++_stats.hits;
+    e.lru_link.unlink();
+    _lru.push_back(e);
+    return current;
+}
+
+void counter_cache::put(const mutation& applied, version_type version, locator::host_id local_id) {
+    if (!enabled()) {
+        return;
+    }
+    const auto& s = *applied.schema();
+    auto [it, inserted] = _entries.try_emplace(make_key(s, applied.key()));
+    auto& e = it->second;
+    if (inserted) {
+        e.key = &it->first;
+    } else {
+        e.lru_link.unlink();
+        if (e.schema_version != s.version() || e.version != version) {
+            e.cells.clear();
+        }
+    }
+    e.schema_version = s.version();
+    e.version = version;
+    _lru.push_back(e);
+
+    auto id = counter_id(local_id.uuid());
+    try {
+        auto record_cells = [&] (bool is_static, const bytes& ckey, const row& cells) {
+            auto kind = is_static ? column_kind::static_column : column_kind::regular_column;
+            cells.for_each_cell([&] (column_id cid, const atomic_cell_or_collection& ac_o_c) {
+                auto acv = ac_o_c.as_atomic_cell(s.column_at(kind, cid));
+                if (!acv.is_live()) {
+                    return;
+                }
+                auto cs = counter_cell_view(acv).get_shard(id);
+                if (!cs) {
+                    return;
+                }
+                e.cells.insert_or_assign(cell_key{is_static, ckey, cid}, shard{cs->value(), cs->logical_clock()});
+            });
+        };
+        record_cells(true, bytes(), applied.partition().static_row().get());
+        for (auto& cr : applied.partition().clustered_rows()) {
+            record_cells(false, to_bytes(managed_bytes_view(cr.key().representation())), cr.row().cells());
+        }
+    } catch (...) {
+        // Some of the cached shards may be stale now.
+        invalidate(it);
+        return;
+    }
+    update_memory_usage(e);
+    evict();
+}
+
+void counter_cache::invalidate(const schema& s, partition_key_view key) noexcept {
+    try {
+        if (auto it = _entries.find(make_key(s, key)); it != _entries.end()) {
+            invalidate(it);
+        }
+    } catch (...) {
+        // Building the key failed to allocate, drop the whole table to be safe.
+        invalidate(s.id());
+    }
+}
+
+void counter_cache::invalidate(table_id table) noexcept {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto next = std::next(it);
+        if (it->first.table == table) {
+            invalidate(it);
+        }
+        it = next;
+    }
+}
+
+} // namespace replica
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <boost/intrusive/list.hpp>
+#include "bytes.hh"
+#include "locator/host_id.hh"
+#include "schema/schema_fwd.hh"
+
+class mutation;
+class partition_key_view;
+
+namespace replica {
+
+// An in-memory index of the local counter shards of recently updated
+// counter cells, which spares the read-before-write of counter updates
+// to hot counters.
+//
+// Only the leader of a counter update changes the local shard of its
+// cells, and it does so under the counter cell locks. So once recorded
+// after a successful update, the local shard of a cell stays up to date
+// until the node updates it again, unless the data of the table changes
+// in ways which bypass the leader: deletes replicated from other leaders,
+// truncation, streaming and repair. The latter are handled by dropping the
+// cached shards of the table. Like the Cassandra counter cache, this one
+// doesn't see counter deletes applied by other leaders, see the
+// counter_cache_size_in_mb option.
+//
+// The shards are also dropped when the schema of the table or the token
+// metadata version changes, and evicted in LRU order when the cache is full.
+class counter_cache {
+public:
+    using version_type = int64_t;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+    };
+private:
+    struct key_type {
+        table_id table;
+        bytes key;
+
+        bool operator==(const key_type&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key_type& k) const noexcept;
+    };
+
+    struct cell_key {
+        bool is_static;
+        bytes clustering_key;
+        column_id id;
+
+        bool operator<(const cell_key& o) const noexcept {
+            return std::tie(is_static, clustering_key, id) < std::tie(o.is_static, o.clustering_key, o.id);
+        }
+    };
+    struct shard {
+        int64_t value;
+        int64_t logical_clock;
+    };
+
+    using lru_link_type = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+    struct entry {
+        std::map<cell_key, shard> cells;
+        table_schema_version schema_version;
+        version_type version;
+        size_t memory_usage = 0;
+        const key_type* key = nullptr;
+        lru_link_type lru_link;
+    };
+    using lru_type = boost::intrusive::list<entry,
+            boost::intrusive::member_hook<entry, lru_link_type, &entry::lru_link>,
+            boost::intrusive::constant_time_size<false>>;
+    using map_type = std::unordered_map<key_type, entry, key_hash>;
+
+    map_type _entries;
+    // Least recently used entries are at the front.
+    lru_type _lru;
+    size_t _capacity;
+    size_t _used = 0;
+    stats _stats;
+private:
+    static key_type make_key(const schema& s, partition_key_view key);
+    void erase(map_type::iterator it) noexcept;
+    void invalidate(map_type::iterator it) noexcept;
+    void update_memory_usage(entry& e) noexcept;
+    void evict() noexcept;
+public:
+    explicit counter_cache(size_t capacity) noexcept;
+
+    void set_capacity(size_t capacity) noexcept;
+    bool enabled() const noexcept {
+        return _capacity > 0;
+    }
+
+    // Returns the current state of the cells modified by the counter update,
+    // with the local shard only, if the local shards of all of them are cached
+    // and still valid for the given token metadata version. The result can be
+    // passed to transform_counter_updates_to_shards() in place of the state
+    // read from the table.
+    std::optional<mutation> get(const mutation& update, version_type version, locator::host_id local_id);
+
+    // Records the local shards of a counter update, transformed to shards,
+    // after it was successfully applied.
+    void put(const mutation& applied, version_type version, locator::host_id local_id);
+
+    // Drops the shards of the partition, e.g. after a failed update.
+    void invalidate(const schema& s, partition_key_view key) noexcept;
+    // Drops the shards of all partitions of the table.
+    void invalidate(table_id table) noexcept;
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+    size_t used_bytes() const noexcept {
+        return _used;
+    }
+};
+
+} // namespace replica
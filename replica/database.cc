@@ -8,6 +8,7 @@
 
 #include <algorithm>
 
+#include <cmath>
 #include <exception>
 #include <fmt/ranges.h>
 #include <fmt/std.h>
@@ -33,6 +34,8 @@
 #include "cql3/functions/user_function.hh"
 #include "cql3/functions/user_aggregate.hh"
 #include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/fstream.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
@@ -78,11 +81,14 @@
 #include "replica/data_dictionary_impl.hh"
 #include "replica/global_table_ptr.hh"
 #include "replica/exceptions.hh"
+#include "replica/counter_cache.hh"
 #include "readers/multi_range.hh"
 #include "readers/multishard.hh"
 #include "utils/labels.hh"
 #include "service/paxos/paxos_state.hh"
 #include "tracing/trace_keyspace_helper.hh"
+#include "utils/top_k.hh"
+#include "utils/runtime.hh"
 
 #include <algorithm>
 
@@ -366,6 +372,15 @@ database::view_update_read_concurrency_sem() {
     return *sem;
 }
 
+// Like in Cassandra, the counter cache defaults to the lesser of 2.5% of the
+// memory and 50MB.
+static size_t counter_cache_capacity(const db::config& cfg, size_t available_memory) {
+    if (!cfg.counter_cache_size_in_mb.is_set()) {
+        return std::min<size_t>(available_memory * 0.025, (size_t(50) << 20) / smp::count);
+    }
+    return (size_t(cfg.counter_cache_size_in_mb()) << 20) / smp::count;
+}
+
 database::database(const db::config& cfg, database_config dbcfg, service::migration_notifier& mn, gms::feature_service& feat, locator::shared_token_metadata& stm,
         compaction_manager& cm, sstables::storage_manager& sstm, lang::manager& langm, sstables::directory_semaphore& sst_dir_sem, sstable_compressor_factory& scf, const abort_source& abort, utils::cross_shard_barrier barrier)
     : _stats(make_lw_shared<db_stats>())
@@ -374,7 +389,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _cfg(cfg)
     // Allow system tables a pool of 10 MB memory to write, but never block on other regions.
     , _system_dirty_memory_manager(*this, 10 << 20, cfg.unspooled_dirty_soft_limit(), default_scheduling_group())
-    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group)
+    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group,
+            cfg.memtable_flush_writers())
     , _dbcfg(dbcfg)
     , _flush_sg(dbcfg.memtable_scheduling_group)
     , _memtable_controller(make_flush_controller(_cfg, _flush_sg, [this, limit = float(_dirty_memory_manager.throttle_threshold())] {
@@ -414,7 +430,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
             _cfg.view_update_reader_concurrency_semaphore_kill_limit_multiplier,
             _cfg.view_update_reader_concurrency_semaphore_cpu_concurrency,
             "view_update")
-    , _row_cache_tracker(_cfg.index_cache_fraction.operator utils::updateable_value<double>(), cache_tracker::register_metrics::yes)
+    , _row_cache_tracker(_cfg.index_cache_fraction.operator utils::updateable_value<double>(),
+            _cfg.cache_protected_fraction.operator utils::updateable_value<double>(), cache_tracker::register_metrics::yes)
     , _apply_stage("db_apply", &database::do_apply)
     , _version(empty_version)
     , _compaction_manager(cm)
@@ -439,6 +456,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _feat(feat)
     , _shared_token_metadata(stm)
     , _lang_manager(langm)
+    , _slow_read_log(_cfg.slow_read_log_threshold_in_ms)
+    , _hot_partitions(_cfg.hot_partitions_threshold)
     , _reader_concurrency_semaphores_group(max_memory_concurrent_reads(), max_count_concurrent_reads, max_inactive_queue_length(),
         _cfg.reader_concurrency_semaphore_serialize_limit_multiplier,
         _cfg.reader_concurrency_semaphore_kill_limit_multiplier,
@@ -446,6 +465,14 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _stop_barrier(std::move(barrier))
     , _update_memtable_flush_static_shares_action([this, &cfg] { return _memtable_controller.update_static_shares(cfg.memtable_flush_static_shares()); })
     , _memtable_flush_static_shares_observer(cfg.memtable_flush_static_shares.observe(_update_memtable_flush_static_shares_action.make_observer()))
+    , _adaptive_read_concurrency_observer(cfg.reader_concurrency_semaphore_adaptive_concurrency.observe([this] (bool enabled) {
+        _reader_concurrency_semaphores_group.set_adaptive_concurrency(enabled
+                ? std::make_optional<reader_concurrency_semaphore::adaptive_concurrency_config>() : std::nullopt);
+    }))
+    , _counter_cache(std::make_unique<counter_cache>(counter_cache_capacity(cfg, dbcfg.available_memory)))
+    , _counter_cache_size_observer(cfg.counter_cache_size_in_mb.observe([this] (uint32_t) {
+        _counter_cache->set_capacity(counter_cache_capacity(_cfg, _dbcfg.available_memory));
+    }))
 {
     SCYLLA_ASSERT(dbcfg.available_memory != 0); // Detect misconfigured unit tests, see #7544
 
@@ -454,6 +481,11 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
 
+    if (cfg.reader_concurrency_semaphore_adaptive_concurrency()) {
+        _reader_concurrency_semaphores_group.set_adaptive_concurrency(reader_concurrency_semaphore::adaptive_concurrency_config{});
+    }
+    _reader_concurrency_semaphores_group.set_slow_read_log(&_slow_read_log);
+
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
         set_format(*_dbcfg.sstables_format);
@@ -531,6 +563,26 @@ void backlog_controller::update_controller(float shares) {
     _scheduling_group.set_shares(shares);
 }
 
+void compaction_controller::update_controller(float shares) {
+    if (controller_disabled() || !_read_latency) {
+        backlog_controller::update_controller(shares);
+        return;
+    }
+    auto target = _read_latency_target();
+    auto latency = _read_latency();
+    if (target.count() == 0) {
+        _throttle = 1.0;
+    } else if (latency > target) {
+        _throttle = std::max(_throttle * throttle_decrease, min_throttle);
+    } else {
+        _throttle = std::min(_throttle * throttle_increase, 1.0f);
+    }
+    if (shares < _control_points.back().output) {
+        shares = std::max(shares * _throttle, std::min(shares, _control_points.front().output));
+    }
+    backlog_controller::update_controller(shares);
+}
+
 
 namespace replica {
 
@@ -586,8 +638,9 @@ database::setup_metrics() {
                        sm::description("Counts bloom filter invocations.")),
 
         sm::make_counter("clustering_filter_sstables_checked", _cf_stats.sstables_checked_by_clustering_filter,
-                       sm::description("Counts sstables checked after applying the bloom filter. "
-                                       "High value indicates that bloom filter is not very efficient.")),
+                       sm::description("Counts sstables checked by the clustering key filter. "
+                                       "In the standard read path they are checked after the bloom filter, so a high value indicates that the bloom filter is not very efficient. "
+                                       "Single partition reads of time-window compaction tables check them before the bloom filter, and don't count the sstables which start after the end of the slice.")),
 
         sm::make_counter("clustering_filter_fast_path_count", _cf_stats.clustering_filter_fast_path_count,
                        sm::description("Counts number of times bloom filtering short cut to include all sstables when only one full range was specified.")),
@@ -636,6 +689,21 @@ database::setup_metrics() {
         sm::make_counter("querier_cache_scheduling_group_mismatches", _querier_cache.get_stats().scheduling_group_mismatches,
                        sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to scheduling group mismatch")),
 
+        sm::make_counter("querier_cache_evicted_misses", _querier_cache.get_stats().evicted_misses,
+                       sm::description("Counts querier cache lookups that failed to find a cached querier because it was evicted")),
+
+        sm::make_counter("querier_cache_range_mismatches", _querier_cache.get_stats().range_mismatches,
+                       sm::description("Counts querier cache lookups that found cached queriers for the query but none of them matched the read range")),
+
+        sm::make_counter("querier_cache_schema_version_mismatches", _querier_cache.get_stats().schema_version_mismatches,
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to schema version mismatch")),
+
+        sm::make_counter("querier_cache_position_mismatches", _querier_cache.get_stats().position_mismatches,
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it because the page started at a different position")),
+
+        sm::make_counter("querier_cache_replacements", _querier_cache.get_stats().replacements,
+                       sm::description("Counts cached multishard queriers replaced by a newer querier of the same query")),
+
         sm::make_counter("querier_cache_time_based_evictions", _querier_cache.get_stats().time_based_evictions,
                        sm::description("Counts querier cache entries that timed out and were evicted.")),
 
@@ -677,6 +745,21 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_counter("counter_cache_hits", [this] { return _counter_cache->get_stats().hits; },
+                       sm::description("The number of counter updates which found the local shards of their cells in the counter cache and skipped the read before write.")),
+
+        sm::make_counter("counter_cache_misses", [this] { return _counter_cache->get_stats().misses; },
+                       sm::description("The number of counter updates which had to read the local shards of their cells from the table.")),
+
+        sm::make_counter("counter_cache_evictions", [this] { return _counter_cache->get_stats().evictions; },
+                       sm::description("The number of partitions evicted from the counter cache to stay within its capacity.")),
+
+        sm::make_counter("counter_cache_invalidations", [this] { return _counter_cache->get_stats().invalidations; },
+                       sm::description("The number of partitions dropped from the counter cache because they may have been stale.")),
+
+        sm::make_gauge("counter_cache_used_bytes", [this] { return _counter_cache->used_bytes(); },
+                       sm::description("The memory used by the counter cache.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
@@ -698,6 +781,13 @@ database::setup_metrics() {
 
         sm::make_total_operations("total_view_updates_failed_pairing", _cf_stats.total_view_updates_failed_pairing,
                 sm::description("Total number of view updates for which we failed base/view pairing.")).set_skip_when_empty(),
+
+        sm::make_gauge("sstables_summary_memory", [this] { return _user_sstables_manager->summary_memory_footprint() + _system_sstables_manager->summary_memory_footprint(); },
+                sm::description("Holds the current amount of memory used by summaries of sstables.")),
+
+        sm::make_gauge("sstables_summary_key_bytes", [this] { return _user_sstables_manager->summary_key_bytes() + _system_sstables_manager->summary_key_bytes(); },
+                sm::description("Holds the amount of memory the keys of sstable summaries would use without the front-coding. "
+                        "Compare with sstables_summary_memory to see the savings.")),
     });
     if (this_shard_id() == 0) {
         _metrics.add_group("database", {
@@ -842,40 +932,242 @@ static auto add_fragmented_listeners(const gms::feature& f, db::commitlog& cl) {
     });
 }
 
-future<>
-database::init_commitlog() {
-    if (_commitlog) {
-        return make_ready_future<>();
+sstring database::commitlog_domain_directory(const db::config& cfg, unsigned domain) {
+    if (domain == 0) {
+        return cfg.commitlog_directory();
+    }
+    return fmt::format("{}/domain-{}", cfg.commitlog_directory(), domain);
+}
+
+// The positions of a table must also keep growing across restarts, when
+// it starts over in the first domain: the truncation and cleanup records
+// written while it was in a following domain would otherwise drop its new
+// writes on replay. So every run which uses domains takes the segment ids
+// above the ones all domains of the previous run could use, the lowest of
+// which is kept in a file of the commitlog directory.
+future<db::segment_id_type> database::commitlog_domains_base_id(unsigned domains) {
+    auto boot_time = std::chrono::duration_cast<std::chrono::milliseconds>(runtime::get_boot_time().time_since_epoch()).count();
+    db::segment_id_type base_id = boot_time + 1;
+
+    auto dir = _cfg.commitlog_directory();
+    auto path = fmt::format("{}/.domain-ids-{}", dir, this_shard_id());
+    auto saved = co_await file_exists(path);
+    if (saved) {
+        auto content = co_await util::read_entire_file_contiguous(std::filesystem::path(path));
+        try {
+            base_id = std::max(base_id, db::segment_id_type(std::stoull(std::string(content.data(), content.size()))));
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(fmt::format("Invalid commitlog domain ids file {}", path));
+        }
+    }
+    if (domains == 1 && !saved) {
+        co_return base_id;
+    }
+
+    auto next = fmt::to_string(base_id + domains * commitlog_domain_id_span);
+    auto tmp_path = path + ".tmp";
+    co_await recursive_touch_directory(dir);
+    auto f = co_await open_file_dma(tmp_path, open_flags::wo | open_flags::create | open_flags::truncate);
+    auto os = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        co_await os.write(next.data(), next.size());
+        co_await os.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await os.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
     }
+    co_await rename_file(tmp_path, path);
+    co_await sync_directory(dir);
+    co_return base_id;
+}
 
+future<std::unique_ptr<db::commitlog>> database::create_commitlog_domain(unsigned domain, unsigned domains, db::segment_id_type base_id) {
     auto config = db::commitlog::config::from_db_config(_cfg, _dbcfg.commitlog_scheduling_group, _dbcfg.available_memory);
+    // Positions of different domains must not collide, segments of all
+    // domains are replayed together. They are also ordered by domain, so
+    // that the positions of a table only grow as it moves to the following
+    // domains.
+    config.base_segment_id = base_id + domain * commitlog_domain_id_span;
+    if (domain > 0) {
+        config.commit_log_location = commitlog_domain_directory(_cfg, domain);
+        config.metrics_category_name = fmt::format("commitlog-domain-{}", domain);
+        co_await recursive_touch_directory(config.commit_log_location);
+    }
+    config.commitlog_total_space_in_mb /= domains;
+    if (config.commitlog_flush_threshold_in_mb) {
+        *config.commitlog_flush_threshold_in_mb /= domains;
+    }
     // todo: it would be much cleaner to allow the test to set the appropriate value:
     // utils::get_local_injector().resolve("decrease_commitlog_base_segment_id")
-    if (utils::get_local_injector().enter("decrease_commitlog_base_segment_id")) {
+    if (domain == 0 && utils::get_local_injector().enter("decrease_commitlog_base_segment_id")) {
         config.base_segment_id = 0;
     }
     if (features().fragmented_commitlog_entries) {
         config.allow_fragmented_entries = true;
     }
-    return db::commitlog::create_commitlog(config).then([this](db::commitlog&& log) {
-        _commitlog = std::make_unique<db::commitlog>(std::move(log));
+    auto cl = std::make_unique<db::commitlog>(co_await db::commitlog::create_commitlog(config));
+
+    auto reg = add_fragmented_listeners(features().fragmented_commitlog_entries, *cl);
+
+    cl->add_flush_handler([this, &cl = *cl, reg = std::move(reg)](db::cf_id_type id, db::replay_position pos) {
+        if (!_tables_metadata.contains(id)) {
+            // the CF has been removed.
+            cl.discard_completed_segments(id);
+            return;
+        }
+        // Initiate a background flush. Waited upon in `stop()`.
+        (void)_tables_metadata.get_table(id).flush(pos);
+    }).release(); // we have longer life time than CL. Ignore reg anchor
+    co_return cl;
+}
+
+future<>
+database::init_commitlog() {
+    if (_commitlog) {
+        co_return;
+    }
+
+    auto domains = std::clamp<unsigned>(_cfg.commitlog_domains(), 1, max_commitlog_domains);
+    auto base_id = co_await commitlog_domains_base_id(domains);
+    _commitlog = co_await create_commitlog_domain(0, domains, base_id);
+    for (unsigned domain = 1; domain < domains; ++domain) {
+        _commitlog_domains.push_back(co_await create_commitlog_domain(domain, domains, base_id));
+    }
+
+    _cfg.commitlog_max_data_lifetime_in_seconds.observe([this](uint32_t max_time) {
+        for (auto cl : commitlogs()) {
+            cl->update_max_data_lifetime(max_time == 0 ? std::nullopt : std::make_optional(uint64_t(max_time)));
+        }
+    });
+
+    if (domains > 1) {
+        _commitlog_domains_rebalancing = rebalance_commitlog_domains();
+    }
+}
+
+std::vector<db::commitlog*> database::commitlogs() const {
+    std::vector<db::commitlog*> ret;
+    if (_commitlog) {
+        ret.reserve(1 + _commitlog_domains.size());
+        ret.push_back(_commitlog.get());
+        for (auto& cl : _commitlog_domains) {
+            ret.push_back(cl.get());
+        }
+    }
+    return ret;
+}
+
+unsigned database::commitlog_domain_of(const table& t) const {
+    auto cls = commitlogs();
+    auto it = std::ranges::find(cls, t.commitlog());
+    return it == cls.end() ? 0 : it - cls.begin();
+}
+
+future<std::vector<sstring>> database::get_commitlog_segments_to_replay() const {
+    std::vector<sstring> segments;
+    auto cls = commitlogs();
+    for (auto cl : cls) {
+        auto s = co_await cl->get_segments_to_replay();
+        std::ranges::move(s, std::back_inserter(segments));
+    }
+    // Domains which were configured in a previous run, but are not anymore.
+    for (unsigned domain = cls.size(); domain < max_commitlog_domains; ++domain) {
+        auto dir = commitlog_domain_directory(_cfg, domain);
+        if (co_await file_exists(dir)) {
+            auto s = co_await _commitlog->list_existing_segments(dir);
+            std::ranges::move(s, std::back_inserter(segments));
+        }
+    }
+    co_return segments;
+}
+
+gc_clock::time_point database::commitlog_min_gc_time(const table_id& id) const {
+    auto res = gc_clock::time_point::max();
+    for (auto cl : commitlogs()) {
+        res = std::min(res, cl->min_gc_time(id));
+    }
+    if (_schema_commitlog) {
+        res = std::min(res, _schema_commitlog->min_gc_time(id));
+    }
+    return res;
+}
 
-        auto reg = add_fragmented_listeners(features().fragmented_commitlog_entries, *_commitlog);
+db::replay_position database::commitlog_min_position() const {
+    // The first domain has the lowest positions.
+    auto res = _commitlog->min_position();
+    for (auto& cl : _commitlog_domains) {
+        res = std::min(res, cl->min_position());
+    }
+    return res;
+}
 
-        _commitlog->add_flush_handler([this, reg = std::move(reg)](db::cf_id_type id, db::replay_position pos) {
-            if (!_tables_metadata.contains(id)) {
-                // the CF has been removed.
-                _commitlog->discard_completed_segments(id);
+future<> database::rebalance_commitlog_domains() {
+    auto domains = commitlogs();
+    std::chrono::milliseconds period = commitlog_domains_rebalance_period;
+    if (utils::get_local_injector().is_enabled("short_commitlog_domains_rebalance_period")) {
+        period = std::chrono::seconds(1);
+    }
+    while (!_commitlog_domains_rebalancing_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(period, _commitlog_domains_rebalancing_as);
+        } catch (const sleep_aborted&) {
+            co_return;
+        }
+
+        // The writes of every table to the commitlog domains since the
+        // previous round.
+        std::vector<std::pair<lw_shared_ptr<table>, uint64_t>> writes;
+        uint64_t total_writes = 0;
+        std::unordered_map<table_id, uint64_t> write_counts;
+        _tables_metadata.for_each_table([&] (table_id id, lw_shared_ptr<table> t) {
+            // System tables may be written together with apply(), which
+            // needs the same commitlog for all of them.
+            if (!t->is_ready_for_writes() || !t->commitlog() || t->commitlog() == _schema_commitlog.get()
+                    || is_system_keyspace(t->schema()->ks_name())) {
                 return;
             }
-            // Initiate a background flush. Waited upon in `stop()`.
-            (void)_tables_metadata.get_table(id).flush(pos);
-        }).release(); // we have longer life time than CL. Ignore reg anchor
-
-        _cfg.commitlog_max_data_lifetime_in_seconds.observe([this](uint32_t max_time) {
-            _commitlog->update_max_data_lifetime(max_time == 0 ? std::nullopt : std::make_optional(uint64_t(max_time)));
+            auto count = t->get_stats().writes.hist.count;
+            auto it = _commitlog_domain_writes.find(id);
+            auto n = it == _commitlog_domain_writes.end() ? count : count - it->second;
+            write_counts.emplace(id, count);
+            total_writes += n;
+            writes.emplace_back(std::move(t), n);
         });
-    });
+        _commitlog_domain_writes = std::move(write_counts);
+        if (total_writes == 0) {
+            // No information about the write rates.
+            continue;
+        }
+
+        for (auto& [t, n] : writes) {
+            if (_commitlog_domains_rebalancing_as.abort_requested()) {
+                co_return;
+            }
+            // Every domain takes tables with a tenth of the shares of
+            // the writes of the previous one.
+            auto share = double(n) / total_writes;
+            auto target = n == 0 ? domains.size() - 1 : std::min<size_t>(domains.size() - 1, std::floor(-std::log10(share)));
+            auto current = commitlog_domain_of(*t);
+            // Tables never move back, their replay positions must only
+            // grow. They start over from the first domain after restart.
+            if (target <= current || t->async_gate().is_closed()) {
+                continue;
+            }
+            auto holder = t->async_gate().hold();
+            dblog.debug("Moving {}.{} from commitlog domain {} to {}, with {:.3f}% of the writes",
+                    t->schema()->ks_name(), t->schema()->cf_name(), current, target, share * 100);
+            try {
+                co_await t->switch_commitlog(domains[target]);
+            } catch (...) {
+                dblog.warn("Failed to move {}.{} to commitlog domain {}: {}",
+                        t->schema()->ks_name(), t->schema()->cf_name(), target, std::current_exception());
+            }
+        }
+    }
 }
 
 future<> database::modify_keyspace_on_all_shards(sharded<database>& sharded_db, std::function<future<>(replica::database&)> func) {
@@ -1471,11 +1763,14 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.statement_scheduling_group = _config.statement_scheduling_group;
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
     cfg.enable_node_aggregated_table_metrics = db_config.enable_node_aggregated_table_metrics();
+    cfg.latency_histograms_for_top_k_only = db_config.table_metrics_top_k() > 0;
     cfg.tombstone_warn_threshold = db_config.tombstone_warn_threshold();
     cfg.view_update_concurrency_semaphore_limit = _config.view_update_concurrency_semaphore_limit;
     cfg.data_listeners = &db.data_listeners();
+    cfg.counter_cache = &db.get_counter_cache();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
     cfg.enable_tombstone_gc_for_streaming_and_repair = db_config.enable_tombstone_gc_for_streaming_and_repair;
+    cfg.enable_lazy_latest_row_reads = db_config.enable_lazy_latest_row_reads;
 
     return cfg;
 }
@@ -1681,6 +1976,15 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
         co_await coroutine::return_exception(replica::rate_limit_exception());
     }
 
+    if (_hot_partitions.enabled() && (!cmd.query_uuid || cmd.is_first_page)) {
+        for (const auto& range : ranges) {
+            if (range.is_singular() && range.start()->value().has_key()) {
+                const auto& pos = range.start()->value();
+                _hot_partitions.record(db::operation_type::read, cmd.cf_id, pos.token(), *pos.key());
+            }
+        }
+    }
+
     auto& semaphore = get_reader_concurrency_semaphore();
     auto max_result_size = cmd.max_result_size ? *cmd.max_result_size : get_query_max_result_size();
 
@@ -1710,8 +2014,10 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
             reader_permit_opt permit_holder;
+            const auto ac = std::ranges::all_of(ranges, [] (const dht::partition_range& r) { return r.is_singular(); })
+                    ? reader_concurrency_semaphore::admission_class::point : reader_concurrency_semaphore::admission_class::scan;
             f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "data-query", cf.estimate_read_memory_cost(), timeout,
-                        trace_state, permit_holder, read_func));
+                        trace_state, permit_holder, read_func, ac));
         }
 
         if (!f.failed()) {
@@ -1774,8 +2080,10 @@ database::query_mutations(schema_ptr query_schema, const query::read_command& cm
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
             reader_permit_opt permit_holder;
+            const auto ac = range.is_singular()
+                    ? reader_concurrency_semaphore::admission_class::point : reader_concurrency_semaphore::admission_class::scan;
             f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "mutation-query", cf.estimate_read_memory_cost(), timeout,
-                        trace_state, permit_holder, read_func));
+                        trace_state, permit_holder, read_func, ac));
         }
 
         if (!f.failed()) {
@@ -1913,17 +2221,44 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     // Before counter update is applied it needs to be transformed from
     // deltas to counter shards. To do that, we need to read the current
     // counter state for each modified cell...
-
-    tracing::trace(trace_state, "Reading counter values from the CF");
-    auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(cf.schema(), "counter-read-before-write", timeout, trace_state);
-    auto mopt = co_await counter_write_query(cf.schema(), cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state);
+    //
+    // The local shards of recently updated cells are cached, and since only
+    // this node updates them, under the locks held here, they can be used
+    // instead of reading the table. Updates with tombstones are applied as
+    // they are and drop the cached shards of the partition.
+    auto& cache = get_counter_cache();
+    auto my_id = get_token_metadata().get_my_id();
+    auto erm_version = cf.get_effective_replication_map()->get_token_metadata().get_version();
+    bool cacheable = cache.enabled() && has_only_live_counter_cells(m);
+    std::optional<mutation> mopt;
+    if (cacheable) {
+        mopt = cache.get(m, erm_version, my_id);
+    }
+    if (mopt) {
+        tracing::trace(trace_state, "Found counter values in the counter cache");
+    } else {
+        tracing::trace(trace_state, "Reading counter values from the CF");
+        auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(cf.schema(), "counter-read-before-write", timeout, trace_state);
+        mopt = co_await counter_write_query(cf.schema(), cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state);
+    }
 
     // ...now, that we got existing state of all affected counter
     // cells we can look for our shard in each of them, increment
     // its clock and apply the delta.
-    transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), get_token_metadata().get_my_id());
+    transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), my_id);
     tracing::trace(trace_state, "Applying counter update");
-    co_await apply_with_commitlog(cf, m, timeout);
+    try {
+        co_await apply_with_commitlog(cf, m, timeout);
+    } catch (...) {
+        // The update may or may not have been applied.
+        cache.invalidate(*m.schema(), m.key());
+        throw;
+    }
+    if (cacheable) {
+        cache.put(m, erm_version, my_id);
+    } else {
+        cache.invalidate(*m.schema(), m.key());
+    }
 
     if (utils::get_local_injector().enter("apply_counter_update_delay_5s")) {
         co_await seastar::sleep(std::chrono::seconds(5));
@@ -2021,6 +2356,10 @@ future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema
 }
 
 future<> database::apply_in_memory(const mutation& m, column_family& cf, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
+    // Counter updates, see the frozen_mutation overload.
+    if (!data_listeners().empty()) {
+        data_listeners().on_write(m.schema(), freeze(m));
+    }
     return cf.apply(m, std::move(h), timeout);
 }
 
@@ -2119,6 +2458,9 @@ future<> database::apply(const utils::chunked_vector<frozen_mutation>& muts, db:
 
 future<> database::do_apply_many(const utils::chunked_vector<frozen_mutation>& muts, db::timeout_clock::time_point timeout) {
     utils::chunked_vector<commitlog_entry_writer> writers;
+    // Keeps the tables in their commitlog domains until the mutations are
+    // in the memtables.
+    std::vector<utils::phased_barrier::operation> ops;
     db::commitlog* cl = nullptr;
 
     if (muts.empty()) {
@@ -2126,10 +2468,12 @@ future<> database::do_apply_many(const utils::chunked_vector<frozen_mutation>& m
     }
 
     writers.reserve(muts.size());
+    ops.reserve(muts.size());
 
     for (size_t i = 0; i < muts.size(); ++i) {
         auto s = local_schema_registry().get(muts[i].schema_version());
         auto&& cf = find_column_family(muts[i].column_family_id());
+        ops.push_back(cf.write_in_progress());
 
         if (!cl) {
             cl = cf.commitlog();
@@ -2194,6 +2538,11 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
         }
     }
 
+    if (_hot_partitions.enabled()) {
+        auto pk = m.key();
+        _hot_partitions.record(db::operation_type::write, uuid, dht::get_token(*s, pk), pk);
+    }
+
     sync = sync || db::commitlog::force_sync(s->wait_for_sync_to_commitlog());
 
     // Signal to view building code that a write is in progress,
@@ -2519,6 +2868,15 @@ future<> database::start(sharded<qos::service_level_controller>& sl_controller,
     co_await _reader_concurrency_semaphores_group.adjust();
     co_await _view_update_read_concurrency_semaphores_group.adjust();
     _large_data_handler->start();
+    if (auto period = _cfg.cache_cold_partition_compression_period_in_s(); period > 0) {
+        _cold_cache_compression = with_scheduling_group(_dbcfg.memory_compaction_scheduling_group, [this, period] {
+            return compress_cold_cache_partitions(std::chrono::seconds(period));
+        });
+    }
+    if (auto k = _cfg.table_metrics_top_k(); k > 0 && this_shard_id() == 0
+            && !_cfg.enable_keyspace_column_family_metrics() && _cfg.enable_node_aggregated_table_metrics()) {
+        _table_metrics_top_k = table_metrics_top_k_loop(k);
+    }
     // We need the compaction manager ready early so we can reshard.
     if (!_compaction_manager.is_running()) {
         // It might be already enabled or even drained by the out of space controller.
@@ -2529,7 +2887,90 @@ future<> database::start(sharded<qos::service_level_controller>& sl_controller,
     co_await init_commitlog();
 }
 
+future<> database::compress_cold_cache_partitions(std::chrono::seconds period) {
+    while (!_cold_cache_compression_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(period, _cold_cache_compression_as);
+        } catch (const sleep_aborted&) {
+            co_return;
+        }
+        std::vector<lw_shared_ptr<table>> tables;
+        _tables_metadata.for_each_table([&] (table_id, lw_shared_ptr<table> t) {
+            if (t->cache_enabled()) {
+                tables.push_back(std::move(t));
+            }
+        });
+        for (auto& t : tables) {
+            if (_cold_cache_compression_as.abort_requested()) {
+                co_return;
+            }
+            if (t->async_gate().is_closed()) {
+                continue;
+            }
+            auto holder = t->async_gate().hold();
+            try {
+                co_await t->get_row_cache().compress_cold_partitions();
+            } catch (...) {
+                dblog.warn("Failed to compress cold partitions of {}.{}: {}", t->schema()->ks_name(), t->schema()->cf_name(), std::current_exception());
+            }
+        }
+    }
+}
+
+future<> database::table_metrics_top_k_loop(unsigned k) {
+    while (!_table_metrics_top_k_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(std::chrono::seconds(60), _table_metrics_top_k_as);
+        } catch (const sleep_aborted&) {
+            co_return;
+        }
+        try {
+            co_await update_table_metrics_top_k(k);
+        } catch (...) {
+            dblog.warn("Failed to pick the most active tables for metrics reporting: {}", std::current_exception());
+        }
+    }
+}
+
+future<> database::update_table_metrics_top_k(unsigned k) {
+    using top_tables = utils::space_saving_top_k<table_id>;
+    // Every shard reports its own most active tables, they are merged here.
+    const size_t per_shard_capacity = std::max<size_t>(4 * k, 64);
+    auto top = co_await container().map_reduce0([per_shard_capacity] (database& db) {
+        top_tables shard_top(per_shard_capacity);
+        db._tables_metadata.for_each_table([&] (table_id id, lw_shared_ptr<table> t) {
+            if (is_internal_keyspace(t->schema()->ks_name())) {
+                return;
+            }
+            auto activity = t->take_latency_histogram_activity();
+            if (activity) {
+                shard_top.append(id, std::min<uint64_t>(activity, std::numeric_limits<unsigned>::max()));
+            }
+        });
+        return shard_top.top(per_shard_capacity);
+    }, top_tables(per_shard_capacity), [] (top_tables acc, top_tables::results shard_top) {
+        acc.append(shard_top);
+        return acc;
+    });
+    std::unordered_set<table_id> reported;
+    for (auto& r : top.top(k)) {
+        reported.insert(r.item);
+    }
+    dblog.debug("Reporting latency histograms of {} most active tables", reported.size());
+    co_await container().invoke_on_all([&reported] (database& db) {
+        db._tables_metadata.for_each_table([&] (table_id id, lw_shared_ptr<table> t) {
+            if (!is_internal_keyspace(t->schema()->ks_name())) {
+                t->report_latency_histograms(reported.contains(id));
+            }
+        });
+    });
+}
+
 future<> database::shutdown() {
+    _table_metrics_top_k_as.request_abort();
+    co_await std::exchange(_table_metrics_top_k, make_ready_future<>());
+    _commitlog_domains_rebalancing_as.request_abort();
+    co_await std::exchange(_commitlog_domains_rebalancing, make_ready_future<>());
     _shutdown = true;
     auto b = defer([this] { _stop_barrier.abort(); });
     co_await _stop_barrier.arrive_and_wait();
@@ -2538,6 +2979,8 @@ future<> database::shutdown() {
     // stop compaction across all shards before closing tables
     co_await _compaction_manager.drain();
     co_await _stop_barrier.arrive_and_wait();
+    _cold_cache_compression_as.request_abort();
+    co_await std::exchange(_cold_cache_compression, make_ready_future<>());
 
     // Closing a table can cause us to find a large partition. Since we want to record that, we have to close
     // system.large_partitions after the regular tables.
@@ -2567,6 +3010,9 @@ future<> database::stop() {
         co_await _commitlog->shutdown();
         dblog.info("Shutting down commitlog complete");
     }
+    for (auto& cl : _commitlog_domains) {
+        co_await cl->shutdown();
+    }
     if (_schema_commitlog) {
         dblog.info("Shutting down schema commitlog");
         co_await _schema_commitlog->shutdown();
@@ -2576,6 +3022,9 @@ future<> database::stop() {
     if (_commitlog) {
         co_await _commitlog->release();
     }
+    for (auto& cl : _commitlog_domains) {
+        co_await cl->release();
+    }
     if (_schema_commitlog) {
         co_await _schema_commitlog->release();
     }
@@ -2631,8 +3080,11 @@ future<> database::flush_table_on_all_shards(sharded<database>& sharded_db, std:
     return flush_table_on_all_shards(sharded_db, sharded_db.local().find_uuid(ks_name, table_name));
 }
 
-static future<> force_new_commitlog_segments(std::unique_ptr<db::commitlog>& cl1, std::unique_ptr<db::commitlog>& cl2) {
+static future<> force_new_commitlog_segments(std::unique_ptr<db::commitlog>& cl1, std::vector<std::unique_ptr<db::commitlog>>& domains, std::unique_ptr<db::commitlog>& cl2) {
     co_await cl1->force_new_active_segment();
+    for (auto& cl : domains) {
+        co_await cl->force_new_active_segment();
+    }
     if (cl2) {
         co_await cl2->force_new_active_segment();
     }
@@ -2651,7 +3103,7 @@ future<> database::flush_tables_on_all_shards(sharded<database>& sharded_db, std
         tables.push_back(table_info{});
     }
     return sharded_db.invoke_on_all([] (replica::database& db) {
-        return force_new_commitlog_segments(db._commitlog, db._schema_commitlog);
+        return force_new_commitlog_segments(db._commitlog, db._commitlog_domains, db._schema_commitlog);
     }).then([&, tables = std::move(tables)] {
         return parallel_for_each(tables, [&] (const auto& ti) {
             return flush_table_on_all_shards(sharded_db, ti.id);
@@ -2662,7 +3114,7 @@ future<> database::flush_tables_on_all_shards(sharded<database>& sharded_db, std
 future<> database::flush_keyspace_on_all_shards(sharded<database>& sharded_db, std::string_view ks_name) {
     // see above
     return sharded_db.invoke_on_all([] (replica::database& db) {
-        return force_new_commitlog_segments(db._commitlog, db._schema_commitlog);
+        return force_new_commitlog_segments(db._commitlog, db._commitlog_domains, db._schema_commitlog);
     }).then([&, ks_name] {
         auto& ks = sharded_db.local().find_keyspace(ks_name);
         return parallel_for_each(ks.metadata()->cf_meta_data(), [&] (auto& pair) {
@@ -2674,12 +3126,16 @@ future<> database::flush_keyspace_on_all_shards(sharded<database>& sharded_db, s
 future<> database::flush_all_tables() {
     // see above
     dblog.info("Forcing new commitlog segment and flushing all tables");
-    co_await _commitlog->force_new_active_segment();
+    for (auto cl : commitlogs()) {
+        co_await cl->force_new_active_segment();
+    }
     co_await get_tables_metadata().parallel_for_each_table([] (table_id, lw_shared_ptr<table> t) {
         return t->flush();
     });
     _all_tables_flushed_at = db_clock::now();
-    co_await _commitlog->wait_for_pending_deletes();
+    for (auto cl : commitlogs()) {
+        co_await cl->wait_for_pending_deletes();
+    }
 }
 
 future<db_clock::time_point> database::get_all_tables_flushed_at(sharded<database>& sharded_db) {
@@ -3100,6 +3556,10 @@ future<> database::flush_system_column_families() {
 
 future<> database::drain() {
     auto b = defer([this] { _stop_barrier.abort(); });
+    // Tables moved to another commitlog domain are flushed, don't move them
+    // after they are flushed below.
+    _commitlog_domains_rebalancing_as.request_abort();
+    co_await std::exchange(_commitlog_domains_rebalancing, make_ready_future<>());
     // Interrupt on going compaction and shutdown to prevent further compaction
     co_await _compaction_manager.drain();
 
@@ -3110,7 +3570,9 @@ future<> database::drain() {
     co_await _stop_barrier.arrive_and_wait();
     co_await flush_system_column_families();
     co_await _stop_barrier.arrive_and_wait();
-    co_await _commitlog->shutdown();
+    for (auto cl : commitlogs()) {
+        co_await cl->shutdown();
+    }
     if (_schema_commitlog) {
         co_await _schema_commitlog->shutdown();
     }
@@ -64,6 +64,7 @@
 #include "utils/cross-shard-barrier.hh"
 #include "sstables/generation_type.hh"
 #include "db/rate_limiter.hh"
+#include "db/hot_partitions.hh"
 #include "db/operation_type.hh"
 #include "locator/tablets.hh"
 #include "utils/serialized_action.hh"
@@ -182,6 +183,7 @@ struct compaction_reenablers_and_lock_holders {
 
 using shared_memtable = lw_shared_ptr<memtable>;
 class global_table_ptr;
+class counter_cache;
 
 // We could just add all memtables, regardless of types, to a single list, and
 // then filter them out when we read them. Here's why I have chosen not to do
@@ -404,9 +406,20 @@ struct table_stats {
     int64_t pending_sstable_deletions = 0;
     int64_t memtable_partition_insertions = 0;
     int64_t memtable_partition_hits = 0;
+    // Single-partition reads which skipped a memtable, by its partition filter
+    int64_t memtable_skipped_probes = 0;
     int64_t memtable_range_tombstone_reads = 0;
     int64_t memtable_row_tombstone_reads = 0;
     int64_t tablet_count = 0;
+    /** Reads of single partitions, and bytes returned by range scans. Pick the
+     *  compression chunk length of the sstables of tables with an 'auto' one. */
+    uint64_t point_reads = 0;
+    uint64_t range_scan_bytes = 0;
+    /** Data read and written by compactions of this column family */
+    uint64_t compaction_bytes_read = 0;
+    uint64_t compaction_bytes_written = 0;
+    /** Data written by memtable flushes of this column family */
+    uint64_t memtable_flush_bytes_written = 0;
     mutation_application_stats memtable_app_stats;
     utils::timed_rate_moving_average_summary_and_histogram reads{256};
     utils::timed_rate_moving_average_summary_and_histogram writes{256};
@@ -417,6 +430,9 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    uint64_t query_result_cache_hits = 0;
+    uint64_t query_result_cache_misses = 0;
+    uint64_t query_result_cache_invalidations = 0;
     shared_ptr<alternator::table_stats> alternator_stats;
 };
 
@@ -470,12 +486,17 @@ class table : public enable_lw_shared_from_this<table>
         seastar::scheduling_group streaming_scheduling_group;
         bool enable_metrics_reporting = false;
         bool enable_node_aggregated_table_metrics = true;
+        // The node aggregated latency histograms are registered only when the
+        // table is one of the most active ones, see database::table_metrics_top_k_loop().
+        bool latency_histograms_for_top_k_only = false;
         size_t view_update_concurrency_semaphore_limit;
         db::data_listeners* data_listeners = nullptr;
+        replica::counter_cache* counter_cache = nullptr;
         uint32_t tombstone_warn_threshold{0};
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
         utils::updateable_value<bool> enable_tombstone_gc_for_streaming_and_repair;
+        utils::updateable_value<bool> enable_lazy_latest_row_reads{true};
     };
 
     using snapshot_details = db::snapshot_ctl::table_snapshot_details;
@@ -530,6 +551,9 @@ class table : public enable_lw_shared_from_this<table>
 
     // Provided by the database that owns this commitlog
     db::commitlog* _commitlog;
+    // The commitlogs the table was moved from, see switch_commitlog().
+    // The memtables may still hold positions in them.
+    std::vector<db::commitlog*> _previous_commitlogs;
     // The table is constructed in readonly mode - this flag is true after the constructor finishes.
     // This allows to read the table on the early stages of the node boot process,
     // when the commitlog is not yet initialized.
@@ -546,12 +570,22 @@ class table : public enable_lw_shared_from_this<table>
 
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
 
+    // Set once any tombstone or expiring cell is written to or loaded into
+    // the table, lets queries skip compacting rows until then.
+    lw_shared_ptr<dead_data_hint> _dead_data_hint;
+
     // Labels used to identify writes and reads for this table in the rate_limiter structure.
     db::rate_limiter::label _rate_limiter_label_for_writes;
     db::rate_limiter::label _rate_limiter_label_for_reads;
 
     void set_metrics();
     seastar::metrics::metric_groups _metrics;
+    // The node aggregated read and write latency histograms, registered
+    // separately so that they can be dropped when the table is not among
+    // the most active ones, see config::latency_histograms_for_top_k_only.
+    seastar::metrics::metric_groups _latency_histogram_metrics;
+    bool _latency_histograms_reported = false;
+    uint64_t _last_latency_histogram_activity = 0;
 
     // holds average cache hit rate of all shards
     // recalculated periodically
@@ -599,6 +633,13 @@ class table : public enable_lw_shared_from_this<table>
 public:
     void on_flush_timer();
     void deregister_metrics();
+    // Registers, or drops, the node aggregated read and write latency histograms.
+    void report_latency_histograms(bool report);
+    bool reports_latency_histograms() const noexcept {
+        return _latency_histograms_reported;
+    }
+    // Returns the number of reads and writes since the last call.
+    uint64_t take_latency_histogram_activity() noexcept;
 
     data_dictionary::table as_data_dictionary() const;
 
@@ -671,6 +712,7 @@ class table : public enable_lw_shared_from_this<table>
     future<> maybe_split_compaction_group_of(locator::tablet_id);
 
     dht::token_range get_token_range_after_split(const dht::token&) const noexcept;
+    std::optional<sstables::compaction_type_options::split> split_options_for(const compaction_group& cg) const noexcept;
 private:
     // If SSTable doesn't need split, the same input SSTable is returned as output.
     // If SSTable needs split, then output SSTables are returned and the input SSTable is deleted.
@@ -724,6 +766,11 @@ class table : public enable_lw_shared_from_this<table>
     void update_stats_for_new_sstable(const sstables::shared_sstable& sst) noexcept;
     future<> do_add_sstable_and_update_cache(compaction_group& cg, sstables::shared_sstable sst, sstables::offstrategy, bool trigger_compaction);
     future<> do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::offstrategy offstrategy, bool trigger_compaction);
+    // Drops the cached local counter shards of the table, when its data
+    // changes bypassing the counter write path.
+    void invalidate_counter_cache() noexcept;
+    void note_dead_data(const memtable& mt) noexcept;
+    void note_dead_data(const sstables::shared_sstable& sst) noexcept;
     // Helpers which add sstable on behalf of a compaction group and refreshes compound set.
     void add_sstable(compaction_group& cg, sstables::shared_sstable sstable);
     void add_maintenance_sstable(compaction_group& cg, sstables::shared_sstable sst);
@@ -809,6 +856,12 @@ class table : public enable_lw_shared_from_this<table>
     // likely already called. We need to call this explicitly when we are sure we're ready
     // to issue disk operations safely.
     void mark_ready_for_writes(db::commitlog* cl);
+    bool is_ready_for_writes() const noexcept { return !_readonly; }
+    // Moves the writes of the table to another commitlog, and flushes the
+    // memtables, so that the table stops pinning the segments of the
+    // previous one. The positions of the new commitlog must be greater than
+    // the ones of the previous one.
+    future<> switch_commitlog(db::commitlog* cl);
 
     // Creates a mutation reader which covers all data sources for this column family.
     // Caller needs to ensure that column_family remains live (FIXME: relax this).
@@ -939,6 +992,9 @@ class table : public enable_lw_shared_from_this<table>
     const schema_ptr& schema() const { return _schema; }
     void set_schema(schema_ptr);
     db::commitlog* commitlog() const;
+    // Releases the positions of a memtable in the commitlog, or the
+    // previous commitlogs of the table.
+    void discard_completed_segments(const db::rp_set& rp_set);
     const locator::effective_replication_map_ptr& get_effective_replication_map() const { return _erm; }
     void update_effective_replication_map(locator::effective_replication_map_ptr);
     [[gnu::always_inline]] bool uses_tablets() const;
@@ -1064,6 +1120,15 @@ class table : public enable_lw_shared_from_this<table>
         return _config.enable_incremental_backups;
     }
 
+    // The configuration of the writers of this table's sstables. Picks the
+    // compression chunk length from the reads of the table, if it is 'auto'.
+    sstables::sstable_writer_config configure_writer(sstring origin) const;
+private:
+    uint64_t mean_partition_size() const;
+public:
+    // Accounts a finished read in the point read / range scan statistics.
+    void note_read(const dht::partition_range_vector& ranges, size_t result_size) noexcept;
+
     void set_incremental_backups(bool val) {
         _config.enable_incremental_backups = val;
     }
@@ -1126,6 +1191,8 @@ class table : public enable_lw_shared_from_this<table>
     // The tablet filter is used to not double account migrating tablets, so it's important that
     // only one of pending or leaving replica is accounted based on current migration stage.
     locator::table_load_stats table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept;
+    // Returns the request rates of the tablets of this shard since the previous call.
+    locator::tablet_heat_stats tablet_heat_stats() noexcept;
 
     const db::view::stats& get_view_stats() const {
         return _view_stats;
@@ -1635,6 +1702,8 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     flat_hash_map<sstring, keyspace> _keyspaces;
     tables_metadata _tables_metadata;
     std::unique_ptr<db::commitlog> _commitlog;
+    // The commitlog domains after the first one, which is _commitlog.
+    std::vector<std::unique_ptr<db::commitlog>> _commitlog_domains;
     std::unique_ptr<db::commitlog> _schema_commitlog;
     utils::updateable_value_source<table_schema_version> _version;
     uint32_t _schema_change_count = 0;
@@ -1667,16 +1736,34 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     locator::shared_token_metadata& _shared_token_metadata;
     lang::manager& _lang_manager;
 
+    // Shared by the semaphores of user reads, has to outlive them.
+    slow_read_log _slow_read_log;
+    db::hot_partitions _hot_partitions;
     reader_concurrency_semaphore_group _reader_concurrency_semaphores_group;
     scheduling_group _default_read_concurrency_group;
     noncopyable_function<future<>()> _unsubscribe_qos_configuration_change;
 
     utils::cross_shard_barrier _stop_barrier;
 
+    abort_source _cold_cache_compression_as;
+    future<> _cold_cache_compression = make_ready_future<>();
+
+    abort_source _table_metrics_top_k_as;
+    future<> _table_metrics_top_k = make_ready_future<>();
+
+    abort_source _commitlog_domains_rebalancing_as;
+    future<> _commitlog_domains_rebalancing = make_ready_future<>();
+    // The write counts of the tables at the previous rebalancing
+    std::unordered_map<table_id, uint64_t> _commitlog_domain_writes;
+
     db::rate_limiter _rate_limiter;
 
     serialized_action _update_memtable_flush_static_shares_action;
     utils::observer<float> _memtable_flush_static_shares_observer;
+    utils::observer<bool> _adaptive_read_concurrency_observer;
+
+    std::unique_ptr<counter_cache> _counter_cache;
+    utils::observer<uint32_t> _counter_cache_size_observer;
 
     db_clock::time_point _all_tables_flushed_at;
 
@@ -1688,6 +1775,23 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     std::shared_ptr<data_dictionary::user_types_storage> as_user_types_storage() const noexcept;
     const data_dictionary::user_types_storage& user_types() const noexcept;
     future<> init_commitlog();
+
+    static constexpr unsigned max_commitlog_domains = 16;
+    // The segment ids each domain may use in a run
+    static constexpr db::segment_id_type commitlog_domain_id_span = db::segment_id_type(1) << 32;
+    static constexpr auto commitlog_domains_rebalance_period = std::chrono::minutes(5);
+    static sstring commitlog_domain_directory(const db::config& cfg, unsigned domain);
+    // The commitlog domains of the regular tables, in the order of their
+    // positions. Empty if there is no commitlog.
+    std::vector<db::commitlog*> commitlogs() const;
+    unsigned commitlog_domain_of(const table& t) const;
+    // The segments left by a previous run in all the domains, including
+    // domains which are not configured anymore.
+    future<std::vector<sstring>> get_commitlog_segments_to_replay() const;
+    // The minimum over all commitlogs, see db::commitlog::min_gc_time()
+    gc_clock::time_point commitlog_min_gc_time(const table_id& id) const;
+    // The minimum over all commitlog domains, see db::commitlog::min_position()
+    db::replay_position commitlog_min_position() const;
     const gms::feature_service& features() const { return _feat; }
     future<> apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&&, db::timeout_clock::time_point timeout);
     future<> apply_in_memory(const mutation& m, column_family& cf, db::rp_handle&&, db::timeout_clock::time_point timeout);
@@ -1874,6 +1978,20 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     future<> shutdown();
     future<> stop();
     future<> close_tables(table_kind kind_to_close);
+private:
+    // Periodically compresses the cold partitions of the row caches of all tables,
+    // see cache_cold_partition_compression_period_in_s.
+    future<> compress_cold_cache_partitions(std::chrono::seconds period);
+    // Periodically picks the k tables with the most reads and writes across all
+    // shards, and reports the latency histograms only for them, see table_metrics_top_k.
+    // Runs on shard 0.
+    future<> table_metrics_top_k_loop(unsigned k);
+    future<db::segment_id_type> commitlog_domains_base_id(unsigned domains);
+    future<std::unique_ptr<db::commitlog>> create_commitlog_domain(unsigned domain, unsigned domains, db::segment_id_type base_id);
+    // Periodically moves the tables with lower shares of the writes of the
+    // shard to the following commitlog domains, see commitlog_domains.
+    future<> rebalance_commitlog_domains();
+public:
 
     /// Checks whether per-partition rate limit can be applied to the operation or not.
     bool can_apply_per_partition_rate_limit(const schema& s, db::operation_type op_type) const;
@@ -2055,6 +2173,18 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
         return *_data_listeners;
     }
 
+    counter_cache& get_counter_cache() const noexcept {
+        return *_counter_cache;
+    }
+
+    const slow_read_log& get_slow_read_log() const noexcept {
+        return _slow_read_log;
+    }
+
+    const db::hot_partitions& get_hot_partitions() const noexcept {
+        return _hot_partitions;
+    }
+
     // Get the maximum result size for a query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_query_max_result_size() const;
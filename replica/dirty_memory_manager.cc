@@ -203,7 +203,7 @@ future<flush_permit> flush_permit::reacquire_sstable_write_permit() && {
     return _manager->get_flush_permit(std::move(_background_permit));
 }
 
-dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg, unsigned flush_concurrency)
     : _db(&db)
     , _region_group("memtable (unspooled)", dirty_memory_manager_logalloc::reclaim_config{
             .unspooled_hard_limit = threshold / 2,
@@ -211,7 +211,7 @@ dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t thresho
             .real_hard_limit = threshold,
             .start_reclaiming = std::bind_front(&dirty_memory_manager::start_reclaiming, this)
       }, deferred_work_sg)
-    , _flush_serializer(1)
+    , _flush_serializer(std::max(flush_concurrency, 1u))
     , _waiting_flush(flush_when_needed()) {}
 
 void
@@ -226,6 +226,16 @@ dirty_memory_manager::setup_collectd(sstring namestr) {
 
         sm::make_gauge(namestr +"_unspooled_dirty_bytes", [this] { return unspooled_dirty_memory(); },
                        sm::description("Holds the size of used memory in bytes. Compare it to \"dirty_bytes\" to see how many memory is wasted (neither used nor available).")),
+
+        sm::make_counter(namestr + "_memtable_flushes", [this] { return _flush_stats.flushes; },
+                       sm::description("Holds the number of completed memtable flushes.")),
+
+        sm::make_gauge(namestr + "_memtable_flushes_in_progress", [this] { return _flush_stats.flushes_in_progress; },
+                       sm::description("Holds the number of memtable flushes in progress, including those waiting for a flush permit to write.")),
+
+        sm::make_counter(namestr + "_memtable_flush_time_us", [this] { return _flush_stats.flush_time.count(); },
+                       sm::description("Holds the total time in microseconds from sealing a memtable until its memory was released. "
+                                       "Divide by memtable_flushes for the average time to release the memory of a flushed memtable.")),
     });
 }
 
@@ -238,7 +248,13 @@ future<> dirty_memory_manager::shutdown() {
 }
 
 future<> dirty_memory_manager::flush_one(replica::memtable_list& mtlist, flush_permit&& permit) noexcept {
-    return mtlist.seal_active_memtable(std::move(permit)).handle_exception([schema = mtlist.back()->schema()] (std::exception_ptr ep) {
+    ++_flush_stats.flushes_in_progress;
+    auto start = std::chrono::steady_clock::now();
+    return mtlist.seal_active_memtable(std::move(permit)).finally([this, start] {
+        --_flush_stats.flushes_in_progress;
+        ++_flush_stats.flushes;
+        _flush_stats.flush_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    }).handle_exception([schema = mtlist.back()->schema()] (std::exception_ptr ep) {
         auto level = log_level::error;
         if (try_catch<gate_closed_exception>(ep)) {
             level = log_level::warn;
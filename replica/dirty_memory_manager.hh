@@ -400,6 +400,9 @@ class dirty_memory_manager {
     // memtable is totally gone. That means that if we have throttled requests, they will stay
     // throttled for a long time. Even when we have unspooled dirty, that only provides a rough
     // estimate, and we can't release requests that early.
+    //
+    // Still, a single flush may not be able to keep a fast disk busy, so the number of
+    // concurrent sstable writes is configurable (memtable_flush_writers) and defaults to one.
     semaphore _flush_serializer;
     // We will accept a new flush before another one ends, once it is done with the data write.
     // That is so we can keep the disk always busy. But there is still some background work that is
@@ -423,6 +426,13 @@ class dirty_memory_manager {
 
     unsigned _extraneous_flushes = 0;
 
+    struct flush_stats {
+        uint64_t flushes = 0;
+        uint64_t flushes_in_progress = 0;
+        // From the moment the memtable is picked for flushing until its memory is released.
+        std::chrono::microseconds flush_time{0};
+    } _flush_stats;
+
     seastar::metrics::metric_groups _metrics;
 public:
     void setup_collectd(sstring namestr);
@@ -461,7 +471,9 @@ class dirty_memory_manager {
     //
     // We then set the soft limit to 80 % of the unspooled dirty hard limit, which is equal to 40 % of
     // the user-supplied threshold.
-    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg);
+    //
+    // flush_concurrency is the number of memtables which can write their sstables concurrently.
+    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg, unsigned flush_concurrency = 1);
     dirty_memory_manager()
         : _db(nullptr)
         , _region_group("memtable (unspooled)",
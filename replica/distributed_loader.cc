@@ -370,11 +370,15 @@ future<> table_populator::collect_subdirs() {
 future<> table_populator::process_subdir(sharded<sstables::sstable_directory>& directory) {
     co_await distributed_loader::lock_table(_global_table, directory);
 
+    const auto& cfg = _db.local().get_config();
     sstables::sstable_directory::process_flags flags {
         .throw_on_missing_toc = true,
-        .enable_dangerous_direct_import_of_cassandra_counters = _db.local().get_config().enable_dangerous_direct_import_of_cassandra_counters(),
+        .enable_dangerous_direct_import_of_cassandra_counters = cfg.enable_dangerous_direct_import_of_cassandra_counters(),
         .allow_loading_materialized_view = true,
         .garbage_collect = true,
+        .sstable_open_config = {
+            .defer_bloom_filter = cfg.defer_sstable_filter_loading_on_startup() && !is_system_keyspace(_ks),
+        },
     };
     co_await distributed_loader::process_sstable_dir(directory, flags);
 
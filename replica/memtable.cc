@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
  */
 
+#include <bit>
+
 #include "utils/assert.hh"
 #include "memtable.hh"
 #include "replica/database.hh"
@@ -202,6 +204,24 @@ future<> memtable::clear_gently() noexcept {
     });
 }
 
+memtable::partition_filter::partition_filter(size_t bits)
+        : _words(bits / 64)
+        , _shift(64 - std::countr_zero(bits)) {
+}
+
+void memtable::maybe_grow_partition_filter() {
+    auto bits = _partition_filter.bits();
+    if (nr_partitions * partition_filter_bits_per_partition <= bits || bits >= partition_filter_max_bits) {
+        return;
+    }
+    auto filter = partition_filter(std::min(std::bit_ceil(nr_partitions * partition_filter_bits_per_partition), partition_filter_max_bits));
+    // Doesn't allocate, so LSA can't move the entries under our feet.
+    for (const auto& e : partitions) {
+        filter.add(e.key().token());
+    }
+    _partition_filter = std::move(filter);
+}
+
 partition_entry&
 memtable::find_or_create_partition_slow(partition_key_view key) {
     SCYLLA_ASSERT(!reclaiming_enabled());
@@ -228,6 +248,7 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
     partitions_type::bound_hint hint;
     auto i = partitions.lower_bound(key, dht::ring_position_comparator(*_schema), hint);
     if (i == partitions.end() || !hint.match) {
+        _partition_filter.add(key.token());
         partitions_type::iterator entry = partitions.emplace_before(i,
                 key.token().raw(), hint,
                 _schema, dht::decorated_key(key), mutation_partition(*_schema));
@@ -246,7 +267,7 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
 
 bool
 memtable::contains_partition(const dht::decorated_key& key) const {
-    return partitions.find(key, dht::ring_position_comparator(*_schema)) != partitions.end();
+    return _partition_filter.may_contain(key.token()) && partitions.find(key, dht::ring_position_comparator(*_schema)) != partitions.end();
 }
 
 std::ranges::subrange<memtable::partitions_type::const_iterator>
@@ -722,6 +743,10 @@ memtable::make_mutation_reader_opt(schema_ptr query_schema,
     bool is_reversed = slice.is_reversed();
     if (query::is_single_partition(range) && !fwd_mr) {
         const query::ring_position& pos = range.start()->value();
+        if (!_partition_filter.may_contain(pos.token())) {
+            ++_table_stats.memtable_skipped_probes;
+            return {};
+        }
         auto snp = _table_shared_data.read_section(*this, [&] () -> partition_snapshot_ptr {
             auto i = partitions.find(pos, dht::ring_position_comparator(*_schema));
             if (i != partitions.end()) {
@@ -784,8 +809,13 @@ memtable::apply(memtable& mt, reader_permit permit) {
     [[unlikely]] return make_ready_future<>();
 }
 
+cell_value_pool* memtable::value_pool() noexcept {
+    return _schema->caching_options().intern_values() ? &_table_shared_data.value_pool : nullptr;
+}
+
 void
 memtable::apply(const mutation& m, db::rp_handle&& h) {
+    cell_value_pool::scope interning(value_pool());
     with_allocator(allocator(), [this, &m] {
         _table_shared_data.allocating_section(*this, [&, this] {
             auto& p = find_or_create_partition(m.decorated_key());
@@ -793,11 +823,13 @@ memtable::apply(const mutation& m, db::rp_handle&& h) {
             p.apply(region(), cleaner(), *_schema, m.partition(), *m.schema(), _table_stats.memtable_app_stats);
         });
     });
+    maybe_grow_partition_filter();
     update(std::move(h));
 }
 
 void
 memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& h) {
+    cell_value_pool::scope interning(value_pool());
     with_allocator(allocator(), [this, &m, &m_schema] {
         _table_shared_data.allocating_section(*this, [&, this] {
             auto& p = find_or_create_partition_slow(m.key());
@@ -808,6 +840,7 @@ memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_han
             p.apply(region(), cleaner(), *_schema, std::move(mp), *m_schema, _table_stats.memtable_app_stats);
         });
     });
+    maybe_grow_partition_filter();
     update(std::move(h));
 }
 
@@ -19,6 +19,7 @@
 #include "db/commitlog/rp_set.hh"
 #include "utils/extremum_tracking.hh"
 #include "mutation/mutation_cleaner.hh"
+#include "mutation/cell_value_pool.hh"
 #include "utils/double-decker.hh"
 #include "readers/empty.hh"
 #include "readers/mutation_source.hh"
@@ -97,6 +98,8 @@ namespace replica {
 struct memtable_table_shared_data {
     logalloc::allocating_section read_section;
     logalloc::allocating_section allocating_section;
+    // Shared with the row cache of the table, outlives both.
+    cell_value_pool value_pool;
 };
 
 class dirty_memory_manager;
@@ -152,6 +155,38 @@ class memtable final
     bool _merged_into_cache = false;
     replica::table_stats& _table_stats;
 
+    // Tells which tokens may have a partition in the memtable, so that
+    // single-partition reads can skip memtables which don't have it without
+    // a lookup. A bit per token range of equal size, so false positives only,
+    // e.g. after partitions were moved to cache.
+    class partition_filter {
+        std::vector<uint64_t> _words;
+        // 64 - log2 of the number of bits.
+        unsigned _shift;
+        size_t bit(dht::token t) const noexcept {
+            return t.unbias() >> _shift;
+        }
+    public:
+        explicit partition_filter(size_t bits);
+        size_t bits() const noexcept {
+            return _words.size() * 64;
+        }
+        void add(dht::token t) noexcept {
+            auto b = bit(t);
+            _words[b / 64] |= uint64_t(1) << (b % 64);
+        }
+        bool may_contain(dht::token t) const noexcept {
+            auto b = bit(t);
+            return _words[b / 64] & (uint64_t(1) << (b % 64));
+        }
+    };
+    // Grown with the partition count, and rebuilt from the partitions then,
+    // to keep about an eighth of the bits set.
+    static constexpr size_t partition_filter_bits_per_partition = 8;
+    static constexpr size_t partition_filter_min_bits = 1 << 10;
+    static constexpr size_t partition_filter_max_bits = 1 << 22;
+    partition_filter _partition_filter{partition_filter_min_bits};
+
     class memtable_encoding_stats_collector : public encoding_stats_collector {
     private:
         min_max_tracker<api::timestamp_type> min_max_timestamp;
@@ -215,9 +250,11 @@ class memtable final
     partition_entry& find_or_create_partition(const dht::decorated_key& key);
     partition_entry& find_or_create_partition_slow(partition_key_view key);
     void upgrade_entry(memtable_entry&);
+    void maybe_grow_partition_filter();
     void add_flushed_memory(uint64_t);
     void remove_flushed_memory(uint64_t);
     void clear() noexcept;
+    cell_value_pool* value_pool() noexcept;
 public:
     explicit memtable(schema_ptr schema, dirty_memory_manager&,
             memtable_table_shared_data& shared_data,
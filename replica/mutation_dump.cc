@@ -81,6 +81,13 @@ class mutation_dump_reader : public mutation_reader::impl {
         {
             auto ssts = tbl.select_sstables(_underlying_pr);
             for (size_t i = 0; i < ssts.size(); ++i) {
+                // Reading an sstable directly doesn't consult its bloom filter,
+                // every sstable of the token would have its index read for the
+                // partition, most of them for nothing.
+                if (!ssts[i]->filter_has_key(*_underlying_schema, _dk)) {
+                    tracing::trace(_ts, "Skipping sstable {}, its filter doesn't have the partition", ssts[i]->get_filename());
+                    continue;
+                }
                 auto current_source = format("sstable:{}", ssts[i]->get_filename());
                 all_mutation_sources.emplace(std::move(current_source), ssts[i]->as_mutation_source());
             }
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
  */
 
+#include <cmath>
+
 #include <seastar/core/seastar.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/with_scheduling_group.hh>
@@ -20,6 +22,7 @@
 #include "replica/database.hh"
 #include "replica/data_dictionary_impl.hh"
 #include "replica/compaction_group.hh"
+#include "replica/counter_cache.hh"
 #include "replica/query_state.hh"
 #include "sstables/shared_sstable.hh"
 #include "sstables/sstable_set.hh"
@@ -197,6 +200,7 @@ table::add_memtables_to_reader_list(std::vector<mutation_reader>& readers,
     if (range.is_singular() && range.start()->value().has_key()) {
         const dht::ring_position& pos = range.start()->value();
         auto& sg = storage_group_for_token(pos.token());
+        sg.main_compaction_group()->note_request();
         reserve_fn(sg.memtable_count());
         sg.for_each_compaction_group([&] (const compaction_group_ptr& cg) {
             add_memtables_from_cg(*cg);
@@ -580,11 +584,13 @@ void compaction_group::set_maintenance_sstables(lw_shared_ptr<sstables::sstable_
 }
 
 void table::add_sstable(compaction_group& cg, sstables::shared_sstable sstable) {
+    note_dead_data(sstable);
     cg.add_sstable(std::move(sstable));
     refresh_compound_sstable_set();
 }
 
 void table::add_maintenance_sstable(compaction_group& cg, sstables::shared_sstable sst) {
+    note_dead_data(sst);
     cg.add_maintenance_sstable(std::move(sst));
     refresh_compound_sstable_set();
 }
@@ -744,6 +750,9 @@ class single_storage_group_manager final : public storage_group_manager {
             .split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min()
         };
     }
+    locator::tablet_heat_stats tablet_heat_stats() noexcept override {
+        return {};
+    }
     bool all_storage_groups_split() override { return true; }
     future<> split_all_storage_groups(tasks::task_info tablet_split_task_info) override { return make_ready_future(); }
     future<> maybe_split_compaction_group_of(size_t idx) override { return make_ready_future(); }
@@ -751,6 +760,9 @@ class single_storage_group_manager final : public storage_group_manager {
         return make_ready_future<std::vector<sstables::shared_sstable>>(std::vector<sstables::shared_sstable>{sst});
     }
     dht::token_range get_token_range_after_split(const dht::token&) const noexcept override { return dht::token_range(); }
+    std::optional<sstables::compaction_type_options::split> split_options_for(const compaction_group&) const noexcept override {
+        return std::nullopt;
+    }
 
     lw_shared_ptr<sstables::sstable_set> make_sstable_set() const override {
         return get_compaction_group().make_sstable_set();
@@ -771,6 +783,8 @@ class tablet_storage_group_manager final : public storage_group_manager {
     condition_variable _merge_completion_event;
     // Holds compaction reenabler which disables compaction temporarily during tablet merge
     std::vector<compaction_reenabler> _compaction_reenablers_for_merging;
+    // When the tablet heat stats were last sampled.
+    lowres_clock::time_point _last_heat_sample = lowres_clock::now();
 private:
     const schema_ptr& schema() const {
         return _t.schema();
@@ -902,6 +916,7 @@ class tablet_storage_group_manager final : public storage_group_manager {
     }
 
     locator::table_load_stats table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept override;
+    locator::tablet_heat_stats tablet_heat_stats() noexcept override;
     bool all_storage_groups_split() override;
     future<> split_all_storage_groups(tasks::task_info tablet_split_task_info) override;
     future<> maybe_split_compaction_group_of(size_t idx) override;
@@ -909,6 +924,7 @@ class tablet_storage_group_manager final : public storage_group_manager {
     dht::token_range get_token_range_after_split(const dht::token& token) const noexcept override {
         return tablet_map().get_token_range_after_split(token);
     }
+    std::optional<sstables::compaction_type_options::split> split_options_for(const compaction_group& cg) const noexcept override;
 
     lw_shared_ptr<sstables::sstable_set> make_sstable_set() const override {
         // FIXME: avoid recreation of compound_set for groups which had no change. usually, only one group will be changed at a time.
@@ -1116,6 +1132,27 @@ sstables::compaction_type_options::split tablet_storage_group_manager::split_com
     }};
 }
 
+std::optional<sstables::compaction_type_options::split>
+tablet_storage_group_manager::split_options_for(const compaction_group& cg) const noexcept {
+    if (!tablet_map().needs_split()) {
+        return std::nullopt;
+    }
+    auto it = _storage_groups.find(cg.group_id());
+    if (it == _storage_groups.end() || !it->second->splitting_mode()) {
+        return std::nullopt;
+    }
+    // Only data of the split unready groups spans both halves of the tablet.
+    auto unready = it->second->split_unready_groups();
+    if (std::ranges::none_of(unready, [&cg] (const compaction_group_ptr& g) { return g.get() == &cg; })) {
+        return std::nullopt;
+    }
+    return split_compaction_options();
+}
+
+std::optional<sstables::compaction_type_options::split> table::split_options_for(const compaction_group& cg) const noexcept {
+    return _sg_manager->split_options_for(cg);
+}
+
 future<> tablet_storage_group_manager::split_all_storage_groups(tasks::task_info tablet_split_task_info) {
     sstables::compaction_type_options::split opt = split_compaction_options();
 
@@ -1374,6 +1411,24 @@ void table::update_stats_for_new_sstable(const sstables::shared_sstable& sst) no
     _stats.live_sstable_count++;
 }
 
+void table::note_dead_data(const memtable& mt) noexcept {
+    if (mt.get_encoding_stats().min_local_deletion_time != gc_clock::time_point::max()) {
+        _dead_data_hint->set_may_have_dead_data();
+    }
+}
+
+void table::note_dead_data(const sstables::shared_sstable& sst) noexcept {
+    if (sst->may_have_dead_data()) {
+        _dead_data_hint->set_may_have_dead_data();
+    }
+}
+
+void table::invalidate_counter_cache() noexcept {
+    if (_config.counter_cache && _schema->is_counter()) {
+        _config.counter_cache->invalidate(_schema->id());
+    }
+}
+
 future<>
 table::do_add_sstable_and_update_cache(compaction_group& cg, sstables::shared_sstable sst, sstables::offstrategy offstrategy,
                                        bool trigger_compaction) {
@@ -1387,6 +1442,8 @@ table::do_add_sstable_and_update_cache(compaction_group& cg, sstables::shared_ss
             add_maintenance_sstable(cg, sst);
         }
         update_stats_for_new_sstable(sst);
+        // The sstable may come with other versions of the local counter shards.
+        invalidate_counter_cache();
         if (trigger_compaction) {
             try_trigger_compaction(cg);
         }
@@ -1651,7 +1708,7 @@ table::seal_active_memtable(compaction_group& cg, flush_permit&& flush_permit) n
     undo_stats.reset();
 
     if (_commitlog) {
-        _commitlog->discard_completed_segments(_schema->id(), old->get_and_discard_rp_set());
+        discard_completed_segments(old->get_and_discard_rp_set());
     }
     co_await std::move(previous_flush);
     // keep `op` alive until after previous_flush resolves
@@ -1688,7 +1745,7 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
         auto consumer = _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, estimated_partitions, &cg] (mutation_reader reader) mutable -> future<> {
           std::exception_ptr ex;
           try {
-            sstables::sstable_writer_config cfg = get_sstables_manager().configure_writer("memtable");
+            sstables::sstable_writer_config cfg = configure_writer("memtable");
             cfg.backup = incremental_backups_enabled();
 
             auto newtab = make_sstable();
@@ -1720,6 +1777,9 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
                     co_await newtab->open_data();
                     tlogger.debug("Flushing to {} done", newtab->get_filename());
                 });
+                for (auto& newtab : newtabs) {
+                    _stats.memtable_flush_bytes_written += newtab->data_size();
+                }
 
                 co_await with_scheduling_group(_config.memtable_to_cache_scheduling_group, [this, old, &newtabs, &cg] {
                     return update_cache(cg, old, newtabs);
@@ -1801,6 +1861,7 @@ void table::set_metrics() {
                 ms::make_counter("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_skipped_probes", _stats.memtable_skipped_probes, ms::description("Number of times a single-partition read skipped a memtable, as the memtable's partition filter ruled the partition out"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
@@ -1812,6 +1873,9 @@ void table::set_metrics() {
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
                 ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks),
                 ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
+                ms::make_counter("compaction_bytes_read", ms::description("Number of bytes of sstables compacted away by compactions of this column family"), _stats.compaction_bytes_read)(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("compaction_bytes_written", ms::description("Number of bytes of sstables written by compactions of this column family"), _stats.compaction_bytes_written)(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_flush_bytes_written", ms::description("Number of bytes of sstables written by memtable flushes of this column family"), _stats.memtable_flush_bytes_written)(cf)(ks).set_skip_when_empty(),
                 ms::make_gauge("pending_sstable_deletions",
                         ms::description("Number of tasks waiting to delete sstables from a table"),
                         [this] { return _stats.pending_sstable_deletions; })(cf)(ks)
@@ -1855,7 +1919,10 @@ void table::set_metrics() {
                     ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_prepare.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_accept.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_learn.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
-                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
+                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks),
+                    ms::make_counter("query_result_cache_hits", _stats.query_result_cache_hits, ms::description("Number of prepared statements served from the query result cache"))(cf)(ks).set_skip_when_empty(),
+                    ms::make_counter("query_result_cache_misses", _stats.query_result_cache_misses, ms::description("Number of cacheable prepared statements not found in the query result cache"))(cf)(ks).set_skip_when_empty(),
+                    ms::make_counter("query_result_cache_invalidations", _stats.query_result_cache_invalidations, ms::description("Number of query result cache entries invalidated by writes"))(cf)(ks).set_skip_when_empty()
             });
         }
     } else {
@@ -1864,14 +1931,16 @@ void table::set_metrics() {
                 ms::make_counter("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                ms::make_counter("memtable_skipped_probes", _stats.memtable_skipped_probes, ms::description("Number of times a single-partition read skipped a memtable, as the memtable's partition filter ruled the partition out"))(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                 ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}),
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}),
-                ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.reads.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
-                ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.writes.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty()
             });
+            if (!_config.latency_histograms_for_top_k_only) {
+                report_latency_histograms(true);
+            }
             if (uses_tablets()) {
                 _metrics.add_group("column_family", {
                     ms::make_gauge("tablet_count", ms::description("Tablet count"), _stats.tablet_count)(cf)(ks).aggregate({seastar::metrics::shard_label})
@@ -1891,8 +1960,35 @@ void table::set_metrics() {
     }
 }
 
+void table::report_latency_histograms(bool report) {
+    if (report == _latency_histograms_reported) {
+        return;
+    }
+    _latency_histograms_reported = report;
+    if (!report) {
+        _latency_histogram_metrics.clear();
+        return;
+    }
+    auto cf = column_family_label(_schema->cf_name());
+    auto ks = keyspace_label(_schema->ks_name());
+    namespace ms = seastar::metrics;
+    _latency_histogram_metrics.add_group("column_family", {
+        ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.reads.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+        ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.writes.histogram());})(cf)(ks)(node_table_metrics).aggregate({seastar::metrics::shard_label}).set_skip_when_empty()
+    });
+}
+
+uint64_t table::take_latency_histogram_activity() noexcept {
+    uint64_t activity = _stats.reads.hist.count + _stats.writes.hist.count;
+    auto delta = activity - _last_latency_histogram_activity;
+    _last_latency_histogram_activity = activity;
+    return delta;
+}
+
 void table::deregister_metrics() {
     _metrics.clear();
+    _latency_histogram_metrics.clear();
+    _latency_histograms_reported = false;
     _view_stats._metrics.clear();
 }
 
@@ -1909,6 +2005,21 @@ uint64_t storage_group::live_disk_space_used() const noexcept {
     return std::ranges::fold_left(cgs | std::views::transform(std::mem_fn(&compaction_group::live_disk_space_used)), uint64_t(0), std::plus{});
 }
 
+uint64_t storage_group::requests() const noexcept {
+    auto cgs = const_cast<storage_group&>(*this).compaction_groups();
+    return std::ranges::fold_left(cgs | std::views::transform(std::mem_fn(&compaction_group::requests)), uint64_t(0), std::plus{});
+}
+
+std::optional<uint64_t> storage_group::sample_requests() noexcept {
+    auto requests = this->requests();
+    auto prev = std::exchange(_sampled_requests, requests);
+    if (!prev) {
+        return std::nullopt;
+    }
+    // Merging groups brings in the requests of the other tablet.
+    return requests - std::min(*prev, requests);
+}
+
 uint64_t compaction_group::total_disk_space_used() const noexcept {
     return live_disk_space_used() + std::ranges::fold_left(_sstables_compacted_but_not_deleted | std::views::transform(std::mem_fn(&sstables::sstable::bytes_on_disk)), uint64_t(0), std::plus{});
 }
@@ -2625,8 +2736,7 @@ class compaction_group::compaction_group_view : public compaction::compaction_gr
         return _t.make_sstable();
     }
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
-        auto cfg = _t.get_sstables_manager().configure_writer(std::move(origin));
-        return cfg;
+        return _t.configure_writer(std::move(origin));
     }
     api::timestamp_type min_memtable_timestamp() const override {
         return _cg.min_memtable_timestamp();
@@ -2641,6 +2751,12 @@ class compaction_group::compaction_group_view : public compaction::compaction_gr
         return _cg.memtable_has_key(key);
     }
     future<> on_compaction_completion(sstables::compaction_completion_desc desc, sstables::offstrategy offstrategy) override {
+        for (auto& sst : desc.old_sstables) {
+            _t.get_stats().compaction_bytes_read += sst->data_size();
+        }
+        for (auto& sst : desc.new_sstables) {
+            _t.get_stats().compaction_bytes_written += sst->data_size();
+        }
         co_await _cg.update_sstable_sets_on_compaction_completion(std::move(desc));
         if (offstrategy) {
             _cg.trigger_compaction();
@@ -2670,9 +2786,16 @@ class compaction_group::compaction_group_view : public compaction::compaction_gr
         return _t.get_token_range_after_split(t);
     }
 
+    std::optional<sstables::compaction_type_options::split> split_options() const noexcept override {
+        return _t.split_options_for(_cg);
+    }
+
     int64_t get_sstables_repaired_at() const noexcept override {
         return _cg.get_sstables_repaired_at();
     }
+    double read_amplification() const noexcept override {
+        return std::max(double(_t.get_stats().estimated_sstable_per_read.mean()), 1.0);
+    }
 };
 
 std::unique_ptr<compaction_group::compaction_group_view> compaction_group::make_compacting_view() {
@@ -2787,7 +2910,7 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
     , _sg_manager(make_storage_group_manager())
     , _sstables(make_compound_sstable_set())
     , _sstable_deletion_gate(format("[table {}.{}] sstable_deletion_gate", _schema->ks_name(), _schema->cf_name()))
-    , _cache(_schema, sstables_as_snapshot_source(), row_cache_tracker, is_continuous::yes)
+    , _cache(_schema, sstables_as_snapshot_source(), row_cache_tracker, is_continuous::yes, &_memtable_shared_data.value_pool)
     , _commitlog(nullptr)
     , _readonly(true)
     , _durable_writes(true)
@@ -2795,6 +2918,7 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
     , _index_manager(this->as_data_dictionary())
     , _flush_barrier(format("[table {}.{}] flush_barrier", _schema->ks_name(), _schema->cf_name()))
     , _counter_cell_locks(_schema->is_counter() ? std::make_unique<cell_locker>(_schema, cl_stats) : nullptr)
+    , _dead_data_hint(make_lw_shared<dead_data_hint>())
     , _async_gate(format("[table {}.{}] async_gate", _schema->ks_name(), _schema->cf_name()))
     , _pending_writes_phaser(format("[table {}.{}] pending_writes", _schema->ks_name(), _schema->cf_name()))
     , _pending_reads_phaser(format("[table {}.{}] pending_reads", _schema->ks_name(), _schema->cf_name()))
@@ -2808,6 +2932,11 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
         tlogger.warn("Writes disabled, column family no durable.");
     }
 
+    if (_schema->is_view()) {
+        // Rows of views can be shadowed by their dead row markers.
+        _dead_data_hint->set_may_have_dead_data();
+    }
+
     recalculate_tablet_count_stats();
     set_metrics();
 }
@@ -2840,6 +2969,25 @@ locator::table_load_stats table::table_load_stats(std::function<bool(const locat
     return _sg_manager->table_load_stats(std::move(tablet_filter));
 }
 
+locator::tablet_heat_stats tablet_storage_group_manager::tablet_heat_stats() noexcept {
+    locator::tablet_heat_stats stats;
+    stats.tablet_count = tablet_map().tablet_count();
+    auto now = lowres_clock::now();
+    auto elapsed = std::chrono::duration<double>(now - std::exchange(_last_heat_sample, now)).count();
+
+    for_each_storage_group([&] (size_t id, storage_group& sg) {
+        auto requests = sg.sample_requests();
+        if (requests && *requests && elapsed > 0) {
+            stats.requests_per_second.emplace(locator::tablet_id(id), uint64_t(std::ceil(*requests / elapsed)));
+        }
+    });
+    return stats;
+}
+
+locator::tablet_heat_stats table::tablet_heat_stats() noexcept {
+    return _sg_manager->tablet_heat_stats();
+}
+
 void tablet_storage_group_manager::handle_tablet_split_completion(const locator::tablet_map& old_tmap, const locator::tablet_map& new_tmap) {
     auto table_id = schema()->id();
     size_t old_tablet_count = old_tmap.tablet_count();
@@ -3197,21 +3345,6 @@ db::replay_position table::highest_flushed_replay_position() const {
 
 future<>
 table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets) {
-    std::ostringstream ss;
-    int n = 0;
-    ss << "{" << std::endl << "\t\"files\" : [ ";
-    for (const auto& fsp : file_sets) {
-      for (const auto& rf : *fsp) {
-        if (n++ > 0) {
-            ss << ", ";
-        }
-        ss << "\"" << rf << "\"";
-        co_await coroutine::maybe_yield();
-      }
-    }
-    ss << " ]" << std::endl << "}" << std::endl;
-
-    auto json = ss.str();
     auto jsonfile = jsondir + "/manifest.json";
 
     tlogger.debug("Storing manifest {}", jsonfile);
@@ -3221,7 +3354,16 @@ table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets)
     auto out = co_await make_file_output_stream(std::move(f));
     std::exception_ptr ex;
     try {
-        co_await out.write(json.c_str(), json.size());
+        // The manifest of a table with tens of thousands of sstables is
+        // written as it's generated, instead of being built in memory first.
+        co_await out.write("{\n\t\"files\" : [ ");
+        int n = 0;
+        for (const auto& fsp : file_sets) {
+            for (const auto& rf : *fsp) {
+                co_await out.write(seastar::format("{}\"{}\"", n++ > 0 ? ", " : "", rf));
+            }
+        }
+        co_await out.write(" ]\n}\n");
         co_await out.flush();
     } catch (...) {
         ex = std::current_exception();
@@ -3285,15 +3427,24 @@ future<> table::snapshot_on_all_shards(sharded<database>& sharded_db, const glob
         std::vector<table::snapshot_file_set> file_sets;
         file_sets.reserve(smp::count);
 
+        auto start = db_clock::now();
         co_await io_check([&jsondir] { return recursive_touch_directory(jsondir); });
         co_await coroutine::parallel_for_each(smp::all_cpus(), [&] (unsigned shard) -> future<> {
             file_sets.emplace_back(co_await smp::submit_to(shard, [&] {
                 return table_shards->take_snapshot(jsondir);
             }));
         });
+        // Makes the links of all shards durable, see take_snapshot().
         co_await io_check(sync_directory, jsondir);
-
-        co_await t.finalize_snapshot(table_shards, std::move(jsondir), std::move(file_sets));
+        auto linked = db_clock::now();
+
+        auto sstables = std::ranges::fold_left(file_sets | std::views::transform([] (const auto& fs) { return fs->size(); }), size_t(0), std::plus<>());
+        co_await t.finalize_snapshot(table_shards, jsondir, std::move(file_sets));
+        auto sealed = db_clock::now();
+        tlogger.info("Took snapshot of {}.{} with {} sstables in {}: linking took {}ms, writing the schema and the manifest took {}ms",
+                s->ks_name(), s->cf_name(), sstables, jsondir,
+                std::chrono::duration_cast<std::chrono::milliseconds>(linked - start).count(),
+                std::chrono::duration_cast<std::chrono::milliseconds>(sealed - linked).count());
     });
 }
 
@@ -3305,10 +3456,12 @@ future<table::snapshot_file_set> table::take_snapshot(sstring jsondir) {
     auto tables = *_sstables->all() | std::ranges::to<std::vector<sstables::shared_sstable>>();
     auto table_names = std::make_unique<std::unordered_set<sstring>>();
 
+    // The snapshot directory is synced once all shards linked their sstables,
+    // by snapshot_on_all_shards(), rather than a few times for each sstable.
     co_await _sstables_manager.dir_semaphore().parallel_for_each(tables, [&jsondir, &table_names] (sstables::shared_sstable sstable) {
         table_names->insert(sstable->component_basename(sstables::component_type::Data));
         return io_check([sstable, &dir = jsondir] {
-            return sstable->snapshot(dir);
+            return sstable->snapshot(dir, sstables::storage::sync_dir::no);
         });
     });
     co_return make_foreign(std::move(table_names));
@@ -3479,7 +3632,7 @@ bool table::can_flush() const {
 future<> compaction_group::clear_memtables() {
     if (_t.commitlog()) {
         for (auto& t : *_memtables) {
-            _t.commitlog()->discard_completed_segments(_t.schema()->id(), t->get_and_discard_rp_set());
+            _t.discard_completed_segments(t->get_and_discard_rp_set());
         }
     }
     auto old_memtables = _memtables->clear_and_add();
@@ -3570,6 +3723,7 @@ future<db::replay_position> table::discard_sstables(db_clock::time_point truncat
             cg.set_maintenance_sstables(std::move(maintenance_pruned));
         });
         refresh_compound_sstable_set();
+        invalidate_counter_cache();
         tlogger.debug("cleaning out row cache");
     }));
     rebuild_statistics();
@@ -3604,6 +3758,25 @@ db::commitlog* table::commitlog() const {
     return _commitlog;
 }
 
+void table::discard_completed_segments(const db::rp_set& rp_set) {
+    // A commitlog ignores the positions of segments it doesn't own.
+    _commitlog->discard_completed_segments(_schema->id(), rp_set);
+    for (auto cl : _previous_commitlogs) {
+        cl->discard_completed_segments(_schema->id(), rp_set);
+    }
+}
+
+future<> table::switch_commitlog(db::commitlog* cl) {
+    if (_readonly || !_commitlog || cl == _commitlog) {
+        co_return;
+    }
+    _previous_commitlogs.push_back(std::exchange(_commitlog, cl));
+    // The writes which got their positions from the previous commitlog
+    // are in the memtables once they complete.
+    co_await await_pending_writes();
+    co_await flush();
+}
+
 void table::set_schema(schema_ptr s) {
     SCYLLA_ASSERT(s->is_counter() == _schema->is_counter());
     tlogger.debug("Changing schema version of {}.{} ({}) from {} to {}",
@@ -3824,18 +3997,25 @@ void table::do_apply(compaction_group& cg, db::rp_handle&& h, Args&&... args) {
     _stats.writes.set_latency(lc);
     db::replay_position rp = h;
     check_valid_rp(rp);
+    auto& mt = cg.memtables()->active_memtable();
     try {
-        cg.memtables()->active_memtable().apply(std::forward<Args>(args)..., std::move(h));
+        mt.apply(std::forward<Args>(args)..., std::move(h));
         _highest_rp = std::max(_highest_rp, rp);
     } catch (...) {
         _failed_counter_applies_to_memtable++;
+        // Some of the mutation may have been applied.
+        note_dead_data(mt);
         throw;
     }
+    // No reader can see the mutation before this, there's no preemption
+    // point since it was applied.
+    note_dead_data(mt);
     _stats.writes.mark(lc);
 }
 
 future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     auto& cg = compaction_group_for_token(m.token());
+    cg.note_request();
     auto holder = cg.async_gate().hold();
     return dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
         do_apply(cg, std::move(h), m);
@@ -3850,6 +4030,7 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
     }
 
     auto& cg = compaction_group_for_key(m.key(), m_schema);
+    cg.note_request();
     auto holder = cg.async_gate().hold();
 
     return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder)]() mutable {
@@ -3913,6 +4094,7 @@ table::query(schema_ptr query_schema,
 
     auto finally = defer([&] () noexcept {
         _stats.reads.mark(lc);
+        _compaction_manager.note_read_latency(lc.latency());
     });
 
     const auto short_read_allowed = query::short_read(cmd.slice.options.contains<query::partition_slice::option::allow_short_read>());
@@ -3927,12 +4109,25 @@ table::query(schema_ptr query_schema,
         querier_opt = std::move(*saved_querier);
     }
 
+    // A single partition read returns at most the row limit of the query
+    // from the partition. Passing it as the partition row limit lets the
+    // sstable readers merge the sstables lazily for the latest row, see
+    // can_merge_latest_row_lazily().
+    std::optional<query::partition_slice> single_partition_slice;
+    if (!querier_opt && partition_ranges.size() == 1 && partition_ranges.front().is_singular() && cmd.slice.is_reversed()
+            && cmd.get_row_limit() < cmd.slice.partition_row_limit() && _config.enable_lazy_latest_row_reads()) {
+        single_partition_slice.emplace(cmd.slice);
+        single_partition_slice->set_partition_row_limit(cmd.get_row_limit());
+    }
+    const auto& slice = single_partition_slice ? *single_partition_slice : qs.cmd.slice;
+
     while (!qs.done()) {
         auto&& range = *qs.current_partition_range++;
 
         if (!querier_opt) {
             query::querier_base::querier_config conf(_config.tombstone_warn_threshold);
-            querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, qs.cmd.slice, trace_state, conf);
+            conf.dead_data_hint = _dead_data_hint;
+            querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, slice, trace_state, conf);
         }
         auto& q = *querier_opt;
 
@@ -3956,7 +4151,9 @@ table::query(schema_ptr query_schema,
         last_pos.emplace(*querier_opt->current_position());
     }
 
-    if (!saved_querier || (querier_opt && !querier_opt->are_limits_reached() && !qs.builder.is_short_read())) {
+    // A querier with the row limit of this page as the partition row limit
+    // can't be used for the next one.
+    if (!saved_querier || single_partition_slice || (querier_opt && !querier_opt->are_limits_reached() && !qs.builder.is_short_read())) {
         co_await querier_opt->close();
         querier_opt = {};
     }
@@ -3964,7 +4161,36 @@ table::query(schema_ptr query_schema,
         *saved_querier = std::move(querier_opt);
     }
 
-    co_return make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    auto result = make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    note_read(partition_ranges, result->buf().size());
+    co_return result;
+}
+
+void table::note_read(const dht::partition_range_vector& ranges, size_t result_size) noexcept {
+    if (std::ranges::all_of(ranges, &dht::partition_range::is_singular)) {
+        ++_stats.point_reads;
+    } else {
+        _stats.range_scan_bytes += result_size;
+    }
+}
+
+uint64_t table::mean_partition_size() const {
+    uint64_t data_size = 0;
+    uint64_t partitions = 0;
+    _sstables->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+        data_size += sst->data_size();
+        partitions += sst->get_estimated_key_count();
+    });
+    return partitions ? data_size / partitions : 0;
+}
+
+sstables::sstable_writer_config table::configure_writer(sstring origin) const {
+    auto cfg = get_sstables_manager().configure_writer(std::move(origin));
+    auto& cp = _schema->get_compressor_params();
+    if (cp.compression_enabled() && cp.auto_chunk_length()) {
+        cfg.compression_chunk_length = compression_parameters::pick_chunk_length(_stats.point_reads, _stats.range_scan_bytes, mean_partition_size());
+    }
+    return cfg;
 }
 
 future<reconcilable_result>
@@ -3988,13 +4214,15 @@ table::mutation_query(schema_ptr query_schema,
     }
     if (!querier_opt) {
         query::querier_base::querier_config conf(_config.tombstone_warn_threshold);
+        conf.dead_data_hint = _dead_data_hint;
         querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, cmd.slice, trace_state, conf);
     }
     auto& q = *querier_opt;
 
     std::exception_ptr ex;
   try {
-    auto rrb = reconcilable_result_builder(*query_schema, cmd.slice, std::move(accounter));
+    auto expected_partitions = range.is_singular() ? 1 : std::min<uint64_t>(cmd.partition_limit, cmd.get_row_limit());
+    auto rrb = reconcilable_result_builder(*query_schema, cmd.slice, std::move(accounter), expected_partitions);
     auto r = co_await q.consume_page(std::move(rrb), cmd.get_row_limit(), cmd.partition_limit, cmd.timestamp, trace_state);
 
     if (!saved_querier || (!q.are_limits_reached() && !r.is_short_read())) {
@@ -4498,7 +4726,7 @@ future<> table::cleanup_compaction_groups(database& db, db::system_keyspace& sys
         // records. This isn't ideal -- it would be more natural if the unneeded records
         // were deleted as soon as they become unneeded -- but this gets the job done with a
         // minimal amount of code.
-        co_await sys_ks.drop_old_commitlog_cleanup_records(db.commitlog()->min_position());
+        co_await sys_ks.drop_old_commitlog_cleanup_records(db.commitlog_min_position());
     }
 
     tlogger.info("Cleaned up tablet {} of table {}.{} successfully.", tid, _schema->ks_name(), _schema->cf_name());
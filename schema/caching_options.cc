@@ -12,8 +12,10 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, bool frequency_admission, std::chrono::milliseconds results_ttl,
+        bool intern_values)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _frequency_admission(frequency_admission), _results_ttl(results_ttl)
+        , _intern_values(intern_values) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
@@ -40,6 +42,15 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_frequency_admission) {
+        res.insert({"admission", "frequency"});
+    }
+    if (_results_ttl.count()) {
+        res.insert({"results_ttl_in_ms", std::to_string(_results_ttl.count())});
+    }
+    if (_intern_values) {
+        res.insert({"intern_values", "true"});
+    }
     return res;
 }
 
@@ -58,6 +69,9 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    bool a = false;
+    std::chrono::milliseconds ttl{0};
+    bool i = false;
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +80,25 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "admission") {
+            if (p.second == "frequency") {
+                a = true;
+            } else if (p.second != "always") {
+                throw exceptions::configuration_exception(format("Invalid caching admission policy: {}", p.second));
+            }
+        } else if (p.first == "results_ttl_in_ms") {
+            try {
+                ttl = std::chrono::milliseconds(boost::lexical_cast<uint32_t>(p.second));
+            } catch (boost::bad_lexical_cast& e) {
+                throw exceptions::configuration_exception(format("Invalid caching results_ttl_in_ms: {}", p.second));
+            }
+        } else if (p.first == "intern_values") {
+            i = p.second == "true";
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, a, ttl, i);
 }
 
 caching_options
@@ -8,6 +8,7 @@
 
 #pragma once
 #include <seastar/core/sstring.hh>
+#include <chrono>
 #include <map>
 #include "seastarx.hh"
 
@@ -25,7 +26,19 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // When set, partitions missing in cache are only populated once they
+    // were accessed frequently enough recently (TinyLFU-style admission),
+    // so that one-off scans don't evict the hot working set.
+    bool _frequency_admission = false;
+    // When non-zero, results of prepared single-partition SELECTs are cached
+    // by the coordinator for that long, see cql3::query_result_cache.
+    std::chrono::milliseconds _results_ttl{0};
+    // When set, small values of the cells in the memtables and the row
+    // cache are interned, so that identical values are stored once,
+    // see cell_value_pool.
+    bool _intern_values = false;
+    caching_options(sstring k, sstring r, bool enabled, bool frequency_admission = false, std::chrono::milliseconds results_ttl = {},
+            bool intern_values = false);
 
     friend class schema;
     caching_options();
@@ -34,6 +47,18 @@ class caching_options {
         return _enabled;
     }
 
+    bool frequency_admission() const {
+        return _frequency_admission;
+    }
+
+    std::chrono::milliseconds results_ttl() const {
+        return _results_ttl;
+    }
+
+    bool intern_values() const {
+        return _intern_values;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
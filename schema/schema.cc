@@ -32,6 +32,7 @@
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_extension.hh"
 #include "db/tags/utils.hh"
 #include "db/tags/extension.hh"
 #include "index/target_parser.hh"
@@ -1024,6 +1025,17 @@ managed_string schema::get_create_statement(const schema_describe_helper& helper
             
             if (custom_index_class) {
                 os << " USING '" << *custom_index_class << "'";
+            } else {
+                // Included columns are the only regular columns of the index
+                // view which are not virtual.
+                auto included = regular_columns() | std::views::filter([] (const column_definition& cdef) {
+                    return !cdef.is_view_virtual();
+                }) | std::views::transform([] (const column_definition& cdef) {
+                    return cdef.name_as_cql_string();
+                }) | std::ranges::to<std::vector>();
+                if (!included.empty()) {
+                    os << " WITH OPTIONS = {'include': " << cql3::util::single_quote(fmt::to_string(fmt::join(included, ", "))) << "}";
+                }
             }
 
             os << ";\n";
@@ -1634,6 +1646,12 @@ schema_ptr schema_builder::build(schema::raw_schema& new_raw) {
             dynamic_pointer_cast<db::per_partition_rate_limit_extension>(it->second)->get_options();
     }
 
+    // cache the bloom filter layout for fast access by sstable writers.
+    if (auto it = new_raw._extensions.find(db::bloom_filter_extension::NAME); it != new_raw._extensions.end()) {
+        new_raw._bloom_filter_layout =
+            dynamic_pointer_cast<db::bloom_filter_extension>(it->second)->get_layout();
+    }
+
     if (static_props.use_null_sharder) {
         new_raw._sharder = get_sharder(1, 0);
     }
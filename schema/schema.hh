@@ -30,6 +30,7 @@
 #include "timestamp.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "utils/i_filter.hh"
 #include "db/tablet_options.hh"
 #include "schema_fwd.hh"
 #include "db/view/base_info.hh"
@@ -542,6 +543,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         data_type _regular_column_name_type;
         data_type _default_validation_class = bytes_type;
         double _bloom_filter_fp_chance = 0.01;
+        utils::filter_layout _bloom_filter_layout = utils::filter_layout::classic;
         compression_parameters _compressor_params;
         extensions_map _extensions;
         bool _is_dense = false;
@@ -657,6 +659,9 @@ class schema final : public enable_lw_shared_from_this<schema> {
     double bloom_filter_fp_chance() const {
         return _raw._bloom_filter_fp_chance;
     }
+    utils::filter_layout bloom_filter_layout() const {
+        return _raw._bloom_filter_layout;
+    }
     const compression_parameters& get_compressor_params() const {
         return _raw._compressor_params;
     }
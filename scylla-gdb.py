@@ -5619,9 +5619,15 @@ class scylla_sstable_summary(gdb.Command):
             except gdb.error:
                 token = e['token']['_data']
 
+            # Keys are front-coded in summary_ka::_key_blocks, older versions keep them in the entries.
+            try:
+                key = self.to_hex(e['key']['_M_str'], int(e['key']['_M_len']))
+            except gdb.error:
+                key = '<front-coded>'
+
             gdb.write("[{}]: {{\n  token: {},\n  key: {},\n  position: {}}}\n".format(i,
                 token,
-                self.to_hex(e['key']['_M_str'], int(e['key']['_M_len'])),
+                key,
                 e['position']))
 
 
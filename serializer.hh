@@ -9,6 +9,7 @@
 
 #include <seastar/core/sstring.hh>
 #include <optional>
+#include <chrono>
 #include "utils/assert.hh"
 #include "utils/managed_bytes.hh"
 #include "bytes_ostream.hh"
@@ -245,6 +246,35 @@ template<> struct serializer<uint32_t> : public integral_serializer<uint32_t> {}
 template<> struct serializer<int64_t> : public integral_serializer<int64_t> {};
 template<> struct serializer<uint64_t> : public integral_serializer<uint64_t> {};
 
+// The size of the serialized form of T, if it's the same for all the values
+// of T, zero otherwise. The IDL compiler specializes it for enums and for
+// final classes made only of members of a fixed size.
+template<typename T>
+struct fixed_serialized_size : std::integral_constant<size_t, 0> {};
+
+template<> struct fixed_serialized_size<bool> : std::integral_constant<size_t, sizeof(uint8_t)> {};
+template<> struct fixed_serialized_size<int8_t> : std::integral_constant<size_t, sizeof(int8_t)> {};
+template<> struct fixed_serialized_size<uint8_t> : std::integral_constant<size_t, sizeof(uint8_t)> {};
+template<> struct fixed_serialized_size<int16_t> : std::integral_constant<size_t, sizeof(int16_t)> {};
+template<> struct fixed_serialized_size<uint16_t> : std::integral_constant<size_t, sizeof(uint16_t)> {};
+template<> struct fixed_serialized_size<int32_t> : std::integral_constant<size_t, sizeof(int32_t)> {};
+template<> struct fixed_serialized_size<uint32_t> : std::integral_constant<size_t, sizeof(uint32_t)> {};
+template<> struct fixed_serialized_size<int64_t> : std::integral_constant<size_t, sizeof(int64_t)> {};
+template<> struct fixed_serialized_size<uint64_t> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+// Time points are serialized as uint64_t, see serializer_impl.hh. Durations
+// aren't, as the size of a serialized gc_clock::duration depends on
+// gc_clock_using_3_1_0_serialization.
+template<typename Clock, typename Duration>
+struct fixed_serialized_size<std::chrono::time_point<Clock, Duration>> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+template<typename T>
+inline constexpr size_t fixed_serialized_size_v = fixed_serialized_size<T>::value;
+
+// The fixed size of a sequence of values of Ts, zero if any of them isn't fixed.
+template<typename... Ts>
+inline constexpr size_t fixed_serialized_size_of_all = ((fixed_serialized_size_v<Ts> != 0) && ...) ? (fixed_serialized_size_v<Ts> + ... + 0) : 0;
+
 template<typename Output>
 void safe_serialize_as_uint32(Output& output, uint64_t data);
 
@@ -268,6 +298,31 @@ inline void skip(Input& v, std::type_identity<T>) {
     return serializer<T>::skip(v);
 }
 
+// Skips the serialized values of Ts, one after the other. Runs of values
+// of a fixed size are skipped at once, with a single bounds check and, for
+// fragmented streams, a single walk over the fragments, instead of one per
+// value. Used by the views generated by the IDL compiler to get to their
+// members.
+template<typename... Ts, typename Input>
+inline void skip_all(Input& v) {
+    size_t pending = 0;
+    auto skip_one = [&] <typename T> (std::type_identity<T>) {
+        if constexpr (fixed_serialized_size_v<T> != 0) {
+            pending += fixed_serialized_size_v<T>;
+        } else {
+            if (pending) {
+                v.skip(pending);
+                pending = 0;
+            }
+            serializer<T>::skip(v);
+        }
+    };
+    (skip_one(std::type_identity<Ts>()), ...);
+    if (pending) {
+        v.skip(pending);
+    }
+}
+
 template<typename T>
 size_type get_sizeof(const T& obj);
 
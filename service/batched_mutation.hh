@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <optional>
+#include "mutation/frozen_mutation.hh"
+#include "gms/inet_address.hh"
+#include "locator/host_id.hh"
+#include "tracing/tracing.hh"
+#include "db/per_partition_rate_limit_info.hh"
+#include "service/topology_state_machine.hh"
+
+namespace service {
+
+// A single write carried by the MUTATION_BATCH verb.
+//
+// Holds the same information as the arguments of the MUTATION verb,
+// minus the forward lists, since mutations which have to be forwarded
+// by the replica are never coalesced. The message has a single timeout,
+// the latest one of all its mutations, and each mutation stores by how
+// much its own timeout precedes it.
+struct batched_mutation {
+    frozen_mutation fm;
+    gms::inet_address reply_to;
+    locator::host_id reply_to_id;
+    unsigned shard;
+    uint64_t response_id;
+    std::optional<tracing::trace_info> trace_info;
+    db::per_partition_rate_limit::info rate_limit_info;
+    fencing_token fence;
+    uint64_t timeout_delta_us;
+};
+
+} // namespace service
@@ -26,6 +26,7 @@ thread_local api::timestamp_type service::client_state::_last_timestamp_micros =
 
 void service::client_state::set_login(auth::authenticated_user user) {
     _user = std::move(user);
+    _permissions_snapshot.permissions.clear();
 }
 
 future<> service::client_state::check_user_can_login() {
@@ -234,7 +235,7 @@ future<bool> service::client_state::check_has_permission(auth::command_desc cmd)
 
     std::optional<auth::resource> parent_r = cmd.resource.parent();
 
-    auth::permission_set set = co_await auth::get_permissions(*_auth_service, *_user, cmd.resource);
+    auth::permission_set set = co_await get_permissions(cmd.resource);
     if (set.contains(cmd.permission)) {
         co_return true;
     }
@@ -244,6 +245,26 @@ future<bool> service::client_state::check_has_permission(auth::command_desc cmd)
     co_return false;
 }
 
+future<auth::permission_set> service::client_state::get_permissions(const auth::resource& r) const {
+    auto& snapshot = _permissions_snapshot;
+    auto epoch = _auth_service->permissions_epoch();
+    if (snapshot.epoch != epoch) {
+        snapshot.permissions.clear();
+        snapshot.epoch = epoch;
+    } else if (auto it = snapshot.permissions.find(r); it != snapshot.permissions.end()) {
+        co_return it->second;
+    }
+    auto set = co_await auth::get_permissions(*_auth_service, *_user, r);
+    // Permissions which may have changed while they were looked up are not kept.
+    if (snapshot.epoch == epoch && _auth_service->permissions_epoch() == epoch) {
+        if (snapshot.permissions.size() >= permissions_snapshot::max_entries) {
+            snapshot.permissions.clear();
+        }
+        snapshot.permissions.emplace(r, set);
+    }
+    co_return set;
+}
+
 future<> service::client_state::ensure_has_permission(auth::command_desc cmd) const {
     return check_has_permission(cmd).then([this, cmd](bool ok) {
         if (!ok) {
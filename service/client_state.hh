@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "auth/service.hh"
 #include "exceptions/exceptions.hh"
 #include "timeout_config.hh"
@@ -126,6 +128,19 @@ class client_state {
 
     workload_type _workload_type = workload_type::unspecified;
 
+    // The permissions of _user which were already checked, valid while the
+    // permissions epoch of the auth service stays the same. Spares statements
+    // of long-lived connections the lookups in the permissions cache.
+    // Not copied to other shards, the epochs are per shard.
+    struct permissions_snapshot {
+        static constexpr size_t max_entries = 128;
+        uint64_t epoch = 0;
+        std::unordered_map<auth::resource, auth::permission_set> permissions;
+    };
+    mutable permissions_snapshot _permissions_snapshot;
+
+    future<auth::permission_set> get_permissions(const auth::resource&) const;
+
 public:
     struct internal_tag {};
     struct external_tag {};
@@ -12,6 +12,7 @@
 
 #include "gms/inet_address.hh"
 #include "locator/host_id.hh"
+#include "locator/token_metadata_fwd.hh"
 #include "utils/atomic_vector.hh"
 
 namespace service {
@@ -58,6 +59,15 @@ class endpoint_lifecycle_subscriber {
      * @param endpoint the endpoint marked DOWN.
      */
     virtual void on_down(const gms::inet_address& endpoint, locator::host_id host_id) {}
+
+    /**
+     * Called when a new version of the token metadata was applied on this
+     * shard, e.g. after a tablet migration or a tablet resize.
+     *
+     * @param old_tm the previous version.
+     * @param new_tm the current version.
+     */
+    virtual void on_token_metadata_changed(const locator::token_metadata& old_tm, const locator::token_metadata& new_tm) {}
 };
 
 class endpoint_lifecycle_notifier {
@@ -71,6 +81,7 @@ class endpoint_lifecycle_notifier {
     future<> notify_left(gms::inet_address endpoint, locator::host_id host_id);
     future<> notify_up(gms::inet_address endpoint, locator::host_id host_id);
     future<> notify_joined(gms::inet_address endpoint, locator::host_id host_id);
+    future<> notify_token_metadata_changed(locator::token_metadata_ptr old_tm, locator::token_metadata_ptr new_tm);
 };
 
 }
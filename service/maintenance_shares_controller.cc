@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics.hh>
+
+#include "service/maintenance_shares_controller.hh"
+#include "utils/log.hh"
+
+namespace service {
+
+static logging::logger mslogger("maintenance_shares_controller");
+
+maintenance_shares_controller::maintenance_shares_controller(scheduling_group sg, config cfg, foreground_latency_func foreground_p99)
+        : _sg(sg)
+        , _cfg(std::move(cfg))
+        , _foreground_p99(std::move(foreground_p99))
+        , _shares(_cfg.shares())
+        , _adjust_action([this] { return adjust(); })
+        , _timer([this] {
+            // Waited for by stop(), through the gate.
+            (void)with_gate(_adjust_gate, [this] {
+                return _adjust_action.trigger_later().handle_exception([] (std::exception_ptr ep) {
+                    mslogger.warn("Failed to adjust the maintenance shares: {}", ep);
+                });
+            });
+        })
+        , _shares_observer(_cfg.shares.observe([this] (uint32_t shares) {
+            // Don't let a lowered limit wait for the next period.
+            set_shares(_cfg.latency_slo_ms() ? std::min<float>(_shares, shares) : shares);
+        })) {
+    set_shares(_shares);
+    _timer.arm_periodic(_cfg.period);
+    namespace sm = seastar::metrics;
+    _metrics.add_group("scheduler", {
+        sm::make_gauge("maintenance_shares", [this] { return _shares; },
+                sm::description("Current shares of the maintenance scheduling group, see maintenance_latency_slo_ms.")),
+        sm::make_counter("maintenance_latency_slo_violations", _slo_violations,
+                sm::description("Number of periods in which the foreground latency was above maintenance_latency_slo_ms, "
+                                "so the shares of the maintenance scheduling group were reduced.")),
+    });
+}
+
+future<> maintenance_shares_controller::stop() {
+    _timer.cancel();
+    co_await _adjust_gate.close();
+    co_await _adjust_action.join();
+}
+
+void maintenance_shares_controller::set_shares(float shares) {
+    shares = std::max(shares, _cfg.min_shares);
+    if (shares != _shares) {
+        mslogger.debug("Setting the maintenance shares to {}", shares);
+    }
+    _shares = shares;
+    _sg.set_shares(shares);
+}
+
+float maintenance_shares_controller::next_shares(float current, float max_shares, float min_shares,
+        std::chrono::microseconds p99, std::chrono::milliseconds slo) noexcept {
+    if (slo.count() == 0) {
+        return max_shares;
+    }
+    if (p99 > slo) {
+        // Back off quickly, so that the foreground latency recovers soon
+        return std::max(min_shares, std::min(current, max_shares) / 2);
+    }
+    // ... but give the shares back slowly, so that the background work
+    // doesn't push the latency above the SLO again right away.
+    return std::min(max_shares, current + std::max(max_shares / 10, 1.0f));
+}
+
+future<> maintenance_shares_controller::adjust() {
+    auto slo = std::chrono::milliseconds(_cfg.latency_slo_ms());
+    auto p99 = slo.count() ? co_await _foreground_p99() : std::chrono::microseconds(0);
+    if (slo.count() && p99 > slo) {
+        ++_slo_violations;
+    }
+    set_shares(next_shares(_shares, _cfg.shares(), _cfg.min_shares, p99, slo));
+}
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/timer.hh>
+
+#include "utils/serialized_action.hh"
+#include "utils/updateable_value.hh"
+
+namespace service {
+
+/// \brief Controls the shares of the maintenance scheduling group.
+///
+/// The maintenance (a.k.a. streaming) scheduling group runs the internal
+/// background work: streaming, repair, view building and hints replay.
+/// Its shares are set to maintenance_shares, unless maintenance_latency_slo_ms
+/// is set, in which case they are adjusted each period based on the 99th
+/// percentile of the foreground latency of this shard: when it is above the
+/// SLO the shares are halved, down to min_shares, and when it's within the
+/// SLO they grow back to maintenance_shares by a tenth at a time.
+///
+/// Each shard adjusts the shares of its own scheduling group.
+class maintenance_shares_controller {
+public:
+    using foreground_latency_func = std::function<future<std::chrono::microseconds>()>;
+
+    struct config {
+        utils::updateable_value<uint32_t> shares;
+        // When zero, the shares are not adjusted dynamically.
+        utils::updateable_value<uint32_t> latency_slo_ms;
+        float min_shares = 10;
+        lowres_clock::duration period = std::chrono::seconds(1);
+    };
+private:
+    scheduling_group _sg;
+    config _cfg;
+    foreground_latency_func _foreground_p99;
+    float _shares;
+    uint64_t _slo_violations = 0;
+    serialized_action _adjust_action;
+    // Holds the adjustments triggered by the timer.
+    seastar::named_gate _adjust_gate{"maintenance_shares_controller"};
+    timer<lowres_clock> _timer;
+    utils::observer<uint32_t> _shares_observer;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void set_shares(float shares);
+public:
+    maintenance_shares_controller(scheduling_group sg, config cfg, foreground_latency_func foreground_p99);
+
+    future<> stop();
+
+    // Computes the next shares, exposed for testing.
+    static float next_shares(float current, float max_shares, float min_shares,
+            std::chrono::microseconds p99, std::chrono::milliseconds slo) noexcept;
+
+    // Adjusts the shares once, called every period.
+    future<> adjust();
+
+    float shares() const noexcept {
+        return _shares;
+    }
+};
+
+}
@@ -263,6 +263,30 @@ class partition_ranges_owned_by_this_shard {
     }
 };
 
+// Splits the partition ranges of a request received by this node into the
+// pieces owned by each of the local shards. The request's shard hint, if it
+// names one of the local shards, takes precedence: all ranges go to that shard.
+static future<std::vector<dht::partition_range_vector>> split_ranges_to_local_shards(const query::mapreduce_request& req, dht::partition_range_vector ranges) {
+    std::vector<dht::partition_range_vector> ranges_per_shard(smp::count);
+    if (req.shard_id_hint && *req.shard_id_hint < smp::count) {
+        ranges_per_shard[*req.shard_id_hint] = std::move(ranges);
+        co_return ranges_per_shard;
+    }
+
+    schema_ptr schema = local_schema_registry().get(req.cmd.schema_version);
+    auto erm = schema->table().get_effective_replication_map();
+    const auto& sharder = erm->get_sharder(*schema);
+    for (auto& range : ranges) {
+        dht::ring_position_range_sharder intersecter(sharder, std::move(range));
+        while (auto r = intersecter.next(*schema)) {
+            ranges_per_shard[r->shard].push_back(std::move(r->ring_range));
+        }
+        // can potentially stall e.g. with a large vnodes count.
+        co_await coroutine::maybe_yield();
+    }
+    co_return ranges_per_shard;
+}
+
 // `retrying_dispatcher` is a class that dispatches mapreduce_requests to other
 // nodes. In case of a failure, local retries are available - request being
 // retried is executed on the super-coordinator.
@@ -366,6 +390,10 @@ static shared_ptr<cql3::selection::selection> mock_selection(
 
         auto reducible_aggr = aggr_function->reducible_aggregate_function();
         auto arg_exprs = info->column_names | std::views::transform(name_as_expression) | std::ranges::to<std::vector<cql3::expr::expression>>();
+        for (auto& value : info->constant_arguments) {
+            auto& type = reducible_aggr->arg_types().at(arg_exprs.size());
+            arg_exprs.push_back(cql3::expr::constant(cql3::raw_value::make_value(value), type));
+        }
         auto fc_expr = cql3::expr::function_call{reducible_aggr, arg_exprs};
         auto column_identifier = make_shared<cql3::column_identifier>(info->name.name, false);
         auto prepared_expr = cql3::expr::prepare_expression(fc_expr, db.as_data_dictionary(), "", schema.get(), nullptr);
@@ -390,11 +418,29 @@ future<query::mapreduce_result> mapreduce_service::dispatch_to_shards(
     std::optional<query::mapreduce_result> result;
     std::vector<future<query::mapreduce_result>> futures;
 
-    for (const auto& s : smp::all_cpus()) {
-        futures.push_back(container().invoke_on(s, [req, tr_info] (auto& fs) {
-            return fs.execute_on_this_shard(req, tr_info);
+    // Each shard gets only the sub-ranges it owns, with the hint pointing at
+    // itself, and shards owning none of the ranges are not bothered at all.
+    // Otherwise every shard would get a copy of all the ranges and would have
+    // to filter them by itself.
+    auto ranges_per_shard = co_await split_ranges_to_local_shards(req, std::exchange(req.pr, {}));
+    for (shard_id s = 0; s < ranges_per_shard.size(); ++s) {
+        if (ranges_per_shard[s].empty()) {
+            continue;
+        }
+        query::mapreduce_request shard_req = req;
+        shard_req.pr = std::move(ranges_per_shard[s]);
+        shard_req.shard_id_hint = s;
+        futures.push_back(container().invoke_on(s, [shard_req = std::move(shard_req), tr_info] (auto& fs) {
+            return fs.execute_on_this_shard(shard_req, tr_info);
         }));
     }
+    if (futures.empty()) {
+        // None of the ranges has any data. Still let this shard produce
+        // the result of an empty aggregation.
+        futures.push_back(execute_on_this_shard(req, tr_info));
+    }
+    flogger.debug("dispatching mapreduce_request to {} local shards", futures.size());
+    _stats.shard_subrequests_dispatched += futures.size();
     auto results = co_await when_all_succeed(futures.begin(), futures.end());
 
     mapreduce_aggregates aggrs(req);
@@ -823,6 +869,8 @@ void mapreduce_service::register_metrics() {
              sm::description("how many mapreduce requests were dispatched to other nodes"), {}),
         sm::make_total_operations("requests_dispatched_to_own_shards", _stats.requests_dispatched_to_own_shards,
              sm::description("how many mapreduce requests were dispatched to local shards"), {}),
+        sm::make_total_operations("shard_subrequests_dispatched", _stats.shard_subrequests_dispatched,
+             sm::description("how many per-shard parts of mapreduce requests were dispatched to local shards"), {}),
         sm::make_total_operations("requests_executed", _stats.requests_executed,
              sm::description("how many mapreduce requests were executed"), {}),
     });
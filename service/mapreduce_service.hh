@@ -38,10 +38,11 @@ class retrying_dispatcher;
 //   1. `dispatch` splits aggregation query into sub-queries. The caller of
 //      this method is named a super-coordinator.
 //   2. Sub-queries are distributed across some group of coordinators.
-//   3. Each coordinator forwards received sub-query to all its shards.
-//   3. Each shard executes received sub-query and filters query partition
-//      ranges so that they are contained in the set of partitions owned by
-//      that shard.
+//   3. Each coordinator splits the partition ranges of a received sub-query
+//      into the pieces owned by each of its shards, and forwards every shard
+//      a sub-query restricted to its own pieces. Shards which own none of the
+//      ranges are skipped.
+//   3. Each shard executes received sub-query, in parallel with the others.
 //   4. Each coordinator merges results produced by its shards and sends merged
 //      result to super-coordinator.
 //   5. `dispatch` merges results from all coordinators and returns merged
@@ -149,6 +150,7 @@ class mapreduce_service : public seastar::peering_sharded_service<mapreduce_serv
     struct stats {
         uint64_t requests_dispatched_to_other_nodes = 0;
         uint64_t requests_dispatched_to_own_shards = 0;
+        uint64_t shard_subrequests_dispatched = 0;
         uint64_t requests_executed = 0;
     } _stats;
     seastar::metrics::metric_groups _metrics;
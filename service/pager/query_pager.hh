@@ -52,6 +52,11 @@ using query_function = std::function<future<exceptions::coordinator_result<servi
  * list *if* isExhausted() return true). Indeed, isExhausted() does *not*
  * trigger a query so in some (fairly rare) case we might not know the paging
  * is done even though it is.
+ *
+ * Clients which enabled the SCYLLA_ADAPTIVE_PAGING protocol extension leave
+ * the size of pages to the server: the page size they request is ignored, and
+ * pages are cut once they reach query_page_size_in_bytes, or, for range scans,
+ * once they take more than adaptive_paging_latency_budget_in_ms.
  */
 class query_pager {
 public:
@@ -163,6 +168,10 @@ class query_pager {
                       const foreign_ptr<lw_shared_ptr<query::result>>& results,
                       uint32_t page_size, gc_clock::time_point now);
 
+    bool uses_adaptive_paging() const;
+    // The page size to use in place of the one requested by the client.
+    uint32_t effective_page_size(uint32_t page_size) const;
+
     virtual uint64_t max_rows_to_fetch(uint32_t page_size) {
         return std::min(_max, static_cast<uint64_t>(page_size));
     }
@@ -191,22 +191,37 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
     auto ranges = _ranges;
     auto command = ::make_lw_shared<query::read_command>(*_cmd);
     auto cas_shard = _cas_shard;
+    service::storage_proxy_coordinator_query_options query_options(timeout, _state.get_permit(), _state.get_client_state(), _state.get_trace_state(),
+            std::move(_last_replicas), _query_read_repair_decision, _options.get_specific_options().node_local_only);
+    if (auto budget = _proxy->get_adaptive_paging_latency_budget(); budget.count() && uses_adaptive_paging()) {
+        query_options.page_deadline = service::storage_proxy_clock_type::now() + budget;
+    }
     return _query_function(
             *_proxy,
             _query_schema,
             std::move(command),
             std::move(ranges),
             _options.get_consistency(),
-            {timeout, _state.get_permit(), _state.get_client_state(), _state.get_trace_state(), std::move(_last_replicas), _query_read_repair_decision, _options.get_specific_options().node_local_only},
+            std::move(query_options),
             std::move(cas_shard));
 }
 
+bool query_pager::uses_adaptive_paging() const {
+    return _state.get_client_state().is_protocol_extension_set(cql_transport::cql_protocol_extension::ADAPTIVE_PAGING);
+}
+
+uint32_t query_pager::effective_page_size(uint32_t page_size) const {
+    // The row limit is left to _max, the replicas cut the pages by size.
+    return uses_adaptive_paging() ? query::max_rows_if_set : page_size;
+}
+
 future<> query_pager::fetch_page(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
     return fetch_page_result(builder, page_size, now, timeout)
             .then(utils::result_into_future<result<>>);
 }
 
 future<result<>> query_pager::fetch_page_result(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
+    page_size = effective_page_size(page_size);
     return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
         _last_replicas = std::move(qr.last_replicas);
         _query_read_repair_decision = qr.read_repair_decision;
@@ -243,6 +258,7 @@ future<cql3::result_generator> query_pager::fetch_page_generator(uint32_t page_s
 }
 
 future<result<cql3::result_generator>> query_pager::fetch_page_generator_result(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout, cql3::cql_stats& stats) {
+    page_size = effective_page_size(page_size);
     return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, page_size, now, &stats] (service::storage_proxy::coordinator_query_result qr) -> future<result<cql3::result_generator>> {
         _last_replicas = std::move(qr.last_replicas);
         _query_read_repair_decision = qr.read_repair_decision;
@@ -268,6 +284,7 @@ class filtering_query_pager : public query_pager {
     virtual ~filtering_query_pager() {}
 
     virtual future<result<>> fetch_page_result(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) override {
+        page_size = effective_page_size(page_size);
         return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
             _last_replicas = std::move(qr.last_replicas);
             _query_read_repair_decision = qr.read_repair_decision;
@@ -396,6 +413,11 @@ void query_pager::handle_result(
 
         row_count = v.total_rows - v.dropped_rows;
         replica_row_count = v.total_rows;
+        if (!_cmd->slice.row_filter().empty() && results->row_count() && results->last_position()) {
+            // Rows dropped by the replica's row filter aren't in the result,
+            // but are included in its row count.
+            replica_row_count = std::max(replica_row_count, *results->row_count());
+        }
 
         // If per partition limit is defined, we need to accumulate rows fetched for last partition key if the key matches
         if (_cmd->slice.partition_row_limit() < query::max_rows_if_set) {
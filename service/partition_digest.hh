@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include "query-result.hh"
+#include "replica/exceptions.hh"
+#include "db/per_partition_rate_limit_info.hh"
+#include "cache_temperature.hh"
+#include "partition_range_compat.hh"
+#include "keys/full_position.hh"
+
+namespace service {
+
+// A single partition of a READ_DIGEST_MULTI request.
+struct partition_digest_request {
+    ::compat::wrapping_partition_range range;
+    db::per_partition_rate_limit::info rate_limit_info;
+};
+
+// The reply for a single partition of a READ_DIGEST_MULTI request.
+// Partitions of a request fail independently of each other, so that
+// each of them can be resolved (or repaired) on its own by the coordinator.
+struct partition_digest {
+    query::result_digest digest;
+    api::timestamp_type last_modified;
+    cache_temperature hit_rate;
+    replica::exception_variant exception;
+    // Where the read of the partition stopped, for paging.
+    std::optional<full_position> last_position;
+};
+
+} // namespace service
@@ -9,6 +9,7 @@
  */
 #include <exception>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/coroutine/all.hh>
 #include <seastar/coroutine/exception.hh>
 #include "service/storage_proxy.hh"
@@ -79,6 +80,47 @@ future<paxos_state::guard> paxos_state::get_cas_lock(const dht::token& key, cloc
     co_return m;
 }
 
+namespace {
+
+struct coordinator_lease {
+    table_id table;
+    paxos_state::lease lease;
+    lowres_clock::time_point expires;
+};
+
+// Leases are only used for a short while: the ballot of a leased proposal,
+// and so the timestamp of its update, is the one picked for the lease.
+constexpr auto coordinator_lease_duration = std::chrono::seconds(1);
+// The map is simply dropped when it grows past this size, which only costs
+// a prepare round to the keys whose leases are lost.
+constexpr size_t max_coordinator_leases = 100000;
+
+// Tokens of different keys may collide, in which case the lease of one key
+// may be taken for another. The replicas reject it like any other lost lease.
+thread_local std::unordered_map<dht::token, coordinator_lease> coordinator_leases;
+
+}
+
+std::optional<paxos_state::lease> paxos_state::take_coordinator_lease(const schema& s, const dht::token& key) {
+    auto it = coordinator_leases.find(key);
+    if (it == coordinator_leases.end()) {
+        return std::nullopt;
+    }
+    auto l = std::move(it->second);
+    coordinator_leases.erase(it);
+    if (l.table != s.id() || l.expires < lowres_clock::now()) {
+        return std::nullopt;
+    }
+    return l.lease;
+}
+
+void paxos_state::set_coordinator_lease(const schema& s, const dht::token& key, lease l) {
+    if (coordinator_leases.size() >= max_coordinator_leases) {
+        coordinator_leases.clear();
+    }
+    coordinator_leases.insert_or_assign(key, coordinator_lease{s.id(), std::move(l), lowres_clock::now() + coordinator_lease_duration});
+}
+
 static dht::shard_replica_set shards_for_writes(const schema& s, dht::token token) {
     auto shards = s.table().shard_for_writes(token);
     if (const auto it = std::ranges::find(shards, this_shard_id()); it == shards.end()) {
@@ -182,8 +224,32 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, paxos_store& pa
     }
 }
 
-future<bool> paxos_state::accept(storage_proxy& sp, paxos_store& paxos_store, tracing::trace_state_ptr tr_state, schema_ptr schema, dht::token token, const proposal& proposal,
+future<std::optional<foreign_ptr<lw_shared_ptr<query::result>>>> paxos_state::read_under_lease(storage_proxy& sp, paxos_store& paxos_store,
+        tracing::trace_state_ptr tr_state, schema_ptr schema, const query::read_command& cmd, const partition_key& key, lease l,
         clock_type::time_point timeout) {
+    dht::token token = dht::get_token(*schema, key);
+    const auto shards = shards_for_writes(*schema, token);
+    auto guard = co_await get_replica_lock(token, timeout, shards);
+
+    auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(l.ballot);
+    paxos_state state = co_await paxos_store.load_paxos_state(key, schema, gc_clock::time_point(now_in_sec), timeout);
+    // A decision is applied to the table before it's saved, so if the one of
+    // the lease is the most recent here, the table reflects it. Nothing can
+    // be decided after it without a quorum promising a newer ballot, in which
+    // case the leased proposal is rejected.
+    if (state._promised_ballot != l.ballot || !state._most_recent_commit || state._most_recent_commit->ballot != l.decision) {
+        logger.debug("Lease on {} is lost, promised {}", l.ballot, state._promised_ballot);
+        tracing::trace(tr_state, "Lease on {} is lost, promised {}", l.ballot, state._promised_ballot);
+        co_return std::nullopt;
+    }
+    auto&& [result, hit_rate] = co_await sp.get_db().local().query(schema, cmd,
+            query::result_options::only_result(),
+            dht::partition_range_vector({dht::partition_range::make_singular({token, key})}), tr_state, timeout);
+    co_return make_foreign(std::move(result));
+}
+
+future<bool> paxos_state::accept(storage_proxy& sp, paxos_store& paxos_store, tracing::trace_state_ptr tr_state, schema_ptr schema, dht::token token, const proposal& proposal,
+        clock_type::time_point timeout, bool leased, std::optional<utils::UUID> next_ballot) {
     co_await utils::get_local_injector().inject("paxos_accept_proposal_wait", utils::wait_for_message(std::chrono::minutes(2)));
     co_await utils::get_local_injector().inject("paxos_accept_proposal_timeout", timeout);
     utils::latency_counter lc;
@@ -204,7 +270,8 @@ future<bool> paxos_state::accept(storage_proxy& sp, paxos_store& paxos_store, tr
 
     // Accept the proposal if we promised to accept it or the proposal is newer than the one we promised.
     // Otherwise the proposal was cutoff by another Paxos proposer and has to be rejected.
-    if (proposal.ballot == state._promised_ballot || proposal.ballot.timestamp() > state._promised_ballot.timestamp()) {
+    // A leased proposal had no prepare round, so it must have been promised.
+    if (proposal.ballot == state._promised_ballot || (!leased && proposal.ballot.timestamp() > state._promised_ballot.timestamp())) {
         logger.debug("Accepting proposal {}", proposal);
         tracing::trace(tr_state, "Accepting proposal {}", proposal);
 
@@ -212,7 +279,14 @@ future<bool> paxos_state::accept(storage_proxy& sp, paxos_store& paxos_store, tr
             co_await coroutine::return_exception(utils::injected_error("injected_error_before_save_proposal"));
         }
 
-        co_await paxos_store.save_paxos_proposal(*schema, proposal, timeout);
+        if (next_ballot && next_ballot->timestamp() <= proposal.ballot.timestamp()) {
+            next_ballot = std::nullopt;
+        }
+        if (next_ballot) {
+            logger.debug("Promising next ballot {}", *next_ballot);
+            tracing::trace(tr_state, "Promising next ballot {}", *next_ballot);
+        }
+        co_await paxos_store.save_paxos_proposal(*schema, proposal, timeout, next_ballot);
 
         if (utils::get_local_injector().enter("paxos_error_after_save_proposal")) {
             co_await coroutine::return_exception(utils::injected_error("injected_error_after_save_proposal"));
@@ -317,10 +391,28 @@ paxos_store::paxos_store(db::system_keyspace& sys_ks, gms::feature_service& feat
     , _features(features)
     , _db(db)
     , _mm(mm)
+    , _cache((size_t(db.get_config().paxos_state_cache_size_in_mb()) << 20) / smp::count)
+    , _cache_size_observer(db.get_config().paxos_state_cache_size_in_mb.observe([this] (uint32_t size_in_mb) {
+        _cache.set_capacity((size_t(size_in_mb) << 20) / smp::count);
+    }))
 {
     if (this_shard_id() == 0) {
         _mm.get_notifier().register_listener(this);
     }
+
+    namespace sm = seastar::metrics;
+    _metrics.add_group("paxos_state_cache", {
+        sm::make_counter("hits", [this] { return _cache.get_stats().hits; },
+                sm::description("Number of reads of the Paxos state of a key served from the cache")),
+        sm::make_counter("misses", [this] { return _cache.get_stats().misses; },
+                sm::description("Number of reads of the Paxos state of a key which had to read the paxos table")),
+        sm::make_counter("evictions", [this] { return _cache.get_stats().evictions; },
+                sm::description("Number of Paxos states evicted from the cache to free memory")),
+        sm::make_counter("invalidations", [this] { return _cache.get_stats().invalidations; },
+                sm::description("Number of Paxos states dropped from the cache since they could have become stale")),
+        sm::make_gauge("used_bytes", [this] { return _cache.used_bytes(); },
+                sm::description("Memory used by the cached Paxos states")),
+    });
 }
 
 paxos_store::~paxos_store() {
@@ -424,6 +516,9 @@ future<> paxos_store::ensure_initialized(const schema& s, db::timeout_clock::tim
 }
 
 void paxos_store::on_before_drop_column_family(const schema& schema, utils::chunked_vector<mutation>& mutations, api::timestamp_type timestamp) {
+    container().invoke_on_all([id = schema.id()] (paxos_store& store) {
+        store._cache.drop_table(id);
+    }).get();
     if (const auto state_schema = try_get_paxos_state_schema(schema); state_schema) {
         auto muts = prepare_column_family_drop_announcement(_mm.get_storage_proxy(), 
             state_schema->ks_name(),
@@ -544,75 +639,123 @@ future<paxos_state> paxos_store::load_paxos_state(partition_key_view key, schema
 {
     co_await utils::get_local_injector().inject("load_paxos_state-enter", utils::wait_for_message(60s));
 
-    const auto state_schema = co_await get_paxos_state_schema(*s, timeout);
-    // FIXME: we need execute_cql_with_now()
-    (void)now;
-    const auto results = co_await execute_cql_with_timeout(
-        format("SELECT * FROM \"{}\".\"{}\" WHERE row_key = ?{}", 
-            state_schema->ks_name(), state_schema->cf_name(), 
-            paxos_state_cf_filter(*s, *state_schema)
-        ),
-        timeout,
-        to_legacy(*key.get_compound_type(*s), key.representation())
-    );
-    if (results.empty()) {
-        co_return service::paxos::paxos_state();
+    const auto version = s->table().get_effective_replication_map()->get_token_metadata().get_version();
+    auto to_paxos_state = [&] (paxos_state_cache::state st) {
+        std::optional<service::paxos::proposal> most_recent;
+        if (st.most_recent_commit_at) {
+            // the value can be missing if it was pruned, supply empty one since
+            // it will not going to be used anyway
+            auto fm = st.most_recent_commit ? std::move(*st.most_recent_commit) : freeze(mutation(s, key));
+            most_recent = service::paxos::proposal(*st.most_recent_commit_at, std::move(fm));
+        }
+        return service::paxos::paxos_state(st.promised, std::move(st.accepted), std::move(most_recent));
+    };
+    if (_cache.enabled()) {
+        // Truncating either the table or its paxos table drops the cached states.
+        auto truncated_at = s->table().get_truncation_time();
+        if (auto state_schema = try_get_paxos_state_schema(*s)) {
+            truncated_at = std::max(truncated_at, _db.find_column_family(state_schema).get_truncation_time());
+        }
+        _cache.invalidate_if_truncated(s->id(), truncated_at);
     }
-    auto& row = results.one();
-    auto promised = row.has("promise")
-                    ? row.get_as<utils::UUID>("promise") : utils::UUID_gen::min_time_UUID();
-
-    std::optional<service::paxos::proposal> accepted;
-    if (row.has("proposal")) {
-        accepted = service::paxos::proposal(row.get_as<utils::UUID>("proposal_ballot"),
-                ser::deserialize_from_buffer<>(row.get_blob_unfragmented("proposal"),  std::type_identity<frozen_mutation>(), 0));
+    if (auto cached = _cache.get(*s, key, version, now, std::chrono::seconds(paxos_ttl_sec(*s)))) {
+        co_return to_paxos_state(std::move(*cached));
     }
 
-    std::optional<service::paxos::proposal> most_recent;
-    if (row.has("most_recent_commit_at")) {
-        // the value can be missing if it was pruned, supply empty one since
-        // it will not going to be used anyway
-        auto fm = row.has("most_recent_commit") ?
-                    ser::deserialize_from_buffer<>(row.get_blob_unfragmented("most_recent_commit"), std::type_identity<frozen_mutation>(), 0) :
-                    freeze(mutation(s, key));
-        most_recent = service::paxos::proposal(row.get_as<utils::UUID>("most_recent_commit_at"),
-                std::move(fm));
+    const auto state_schema = co_await get_paxos_state_schema(*s, timeout);
+    const auto generation = _cache.start_load(*s, key, version);
+    paxos_state_cache::state loaded{.promised = utils::UUID_gen::min_time_UUID()};
+    try {
+        // FIXME: we need execute_cql_with_now()
+        const auto results = co_await execute_cql_with_timeout(
+            format("SELECT * FROM \"{}\".\"{}\" WHERE row_key = ?{}", 
+                state_schema->ks_name(), state_schema->cf_name(), 
+                paxos_state_cf_filter(*s, *state_schema)
+            ),
+            timeout,
+            to_legacy(*key.get_compound_type(*s), key.representation())
+        );
+        if (!results.empty()) {
+            auto& row = results.one();
+            if (row.has("promise")) {
+                loaded.promised = row.get_as<utils::UUID>("promise");
+            }
+            if (row.has("proposal")) {
+                loaded.accepted = service::paxos::proposal(row.get_as<utils::UUID>("proposal_ballot"),
+                        ser::deserialize_from_buffer<>(row.get_blob_unfragmented("proposal"),  std::type_identity<frozen_mutation>(), 0));
+            }
+            if (row.has("most_recent_commit_at")) {
+                loaded.most_recent_commit_at = row.get_as<utils::UUID>("most_recent_commit_at");
+                if (row.has("most_recent_commit")) {
+                    loaded.most_recent_commit = ser::deserialize_from_buffer<>(row.get_blob_unfragmented("most_recent_commit"), std::type_identity<frozen_mutation>(), 0);
+                }
+            }
+        }
+    } catch (...) {
+        if (generation) {
+            _cache.abort_load(*s, key, *generation);
+        }
+        throw;
+    }
+    if (generation) {
+        _cache.finish_load(*s, key, *generation, loaded);
     }
 
-    co_return service::paxos::paxos_state(promised, std::move(accepted), std::move(most_recent));
+    co_return to_paxos_state(std::move(loaded));
 }
 
 future<> paxos_store::save_paxos_promise(const schema& s, const partition_key& key, const utils::UUID& ballot, db::timeout_clock::time_point timeout) {
     const auto state_schema = co_await get_paxos_state_schema(s, timeout);
-    co_await execute_cql_with_timeout(
-            format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET promise = ? WHERE row_key = ?{}",
-                state_schema->ks_name(), state_schema->cf_name(), 
-                paxos_state_cf_filter(s, *state_schema)
-            ),
-            timeout,
-            utils::UUID_gen::micros_timestamp(ballot),
-            paxos_ttl_sec(s),
-            ballot,
-            to_legacy(*key.get_compound_type(s), key.representation())
-        );
+    try {
+        co_await execute_cql_with_timeout(
+                format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET promise = ? WHERE row_key = ?{}",
+                    state_schema->ks_name(), state_schema->cf_name(), 
+                    paxos_state_cf_filter(s, *state_schema)
+                ),
+                timeout,
+                utils::UUID_gen::micros_timestamp(ballot),
+                paxos_ttl_sec(s),
+                ballot,
+                to_legacy(*key.get_compound_type(s), key.representation())
+            );
+    } catch (...) {
+        _cache.invalidate(s, key);
+        throw;
+    }
+    _cache.apply_promise(s, key, ballot);
 }
 
-future<> paxos_store::save_paxos_proposal(const schema& s, const proposal& proposal, db::timeout_clock::time_point timeout) {
+future<> paxos_store::save_paxos_proposal(const schema& s, const proposal& proposal, db::timeout_clock::time_point timeout,
+        std::optional<utils::UUID> next_ballot) {
     const auto state_schema = co_await get_paxos_state_schema(s, timeout);
     partition_key_view key = proposal.update.key();
-    co_await execute_cql_with_timeout(
-            format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET promise = ?, proposal_ballot = ?, proposal = ? WHERE row_key = ?{}", 
-                state_schema->ks_name(), state_schema->cf_name(), 
-                paxos_state_cf_filter(s, *state_schema)
-            ),
-            timeout,
-            utils::UUID_gen::micros_timestamp(proposal.ballot),
-            paxos_ttl_sec(s),
-            proposal.ballot,
-            proposal.ballot,
-            ser::serialize_to_buffer<bytes>(proposal.update),
-            to_legacy(*key.get_compound_type(s), key.representation())
-        );
+    // The promise of the next ballot is written with its timestamp, like by
+    // save_paxos_promise(), and so is the proposal along with it. The decision
+    // then doesn't erase the proposal, which is harmless, see
+    // save_paxos_decision().
+    const auto& promise = next_ballot ? *next_ballot : proposal.ballot;
+    try {
+        co_await execute_cql_with_timeout(
+                format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET promise = ?, proposal_ballot = ?, proposal = ? WHERE row_key = ?{}", 
+                    state_schema->ks_name(), state_schema->cf_name(), 
+                    paxos_state_cf_filter(s, *state_schema)
+                ),
+                timeout,
+                utils::UUID_gen::micros_timestamp(promise),
+                paxos_ttl_sec(s),
+                promise,
+                proposal.ballot,
+                ser::serialize_to_buffer<bytes>(proposal.update),
+                to_legacy(*key.get_compound_type(s), key.representation())
+            );
+    } catch (...) {
+        _cache.invalidate(s, key);
+        throw;
+    }
+    _cache.apply_proposal(s, proposal);
+    if (next_ballot) {
+        _cache.apply_promise(s, key, *next_ballot);
+    }
 }
 
 future<> paxos_store::save_paxos_decision(const schema& s, const proposal& decision, db::timeout_clock::time_point timeout) {
@@ -625,19 +768,25 @@ future<> paxos_store::save_paxos_decision(const schema& s, const proposal& decis
     // sp::begin_and_repair_paxos will exclude an accepted proposal if it is older than the most
     // recent commit.
     partition_key_view key = decision.update.key();
-    co_await execute_cql_with_timeout(
-            format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET proposal_ballot = null, proposal = null, "
-                   "most_recent_commit_at = ?, most_recent_commit = ? WHERE row_key = ?{}",
-                state_schema->ks_name(), state_schema->cf_name(), 
-                paxos_state_cf_filter(s, *state_schema)
-            ),
-            timeout,
-            utils::UUID_gen::micros_timestamp(decision.ballot),
-            paxos_ttl_sec(s),
-            decision.ballot,
-            ser::serialize_to_buffer<bytes>(decision.update),
-            to_legacy(*key.get_compound_type(s), key.representation())
-        );
+    try {
+        co_await execute_cql_with_timeout(
+                format("UPDATE \"{}\".\"{}\" USING TIMESTAMP ? AND TTL ? SET proposal_ballot = null, proposal = null, "
+                       "most_recent_commit_at = ?, most_recent_commit = ? WHERE row_key = ?{}",
+                    state_schema->ks_name(), state_schema->cf_name(), 
+                    paxos_state_cf_filter(s, *state_schema)
+                ),
+                timeout,
+                utils::UUID_gen::micros_timestamp(decision.ballot),
+                paxos_ttl_sec(s),
+                decision.ballot,
+                ser::serialize_to_buffer<bytes>(decision.update),
+                to_legacy(*key.get_compound_type(s), key.representation())
+            );
+    } catch (...) {
+        _cache.invalidate(s, key);
+        throw;
+    }
+    _cache.apply_decision(s, decision);
 }
 
 future<> paxos_store::delete_paxos_decision(const schema& s, const partition_key& key, utils::UUID ballot, db::timeout_clock::time_point timeout) {
@@ -647,15 +796,21 @@ future<> paxos_store::delete_paxos_decision(const schema& s, const partition_key
     // In this case we can remove learned paxos value using ballot's timestamp which
     // guarantees that if there is more recent round it will not be affected.
 
-    co_await execute_cql_with_timeout(
-            format("DELETE most_recent_commit FROM \"{}\".\"{}\" USING TIMESTAMP ? WHERE row_key = ?{}",
-                state_schema->ks_name(), state_schema->cf_name(), 
-                paxos_state_cf_filter(s, *state_schema)
-            ),
-            timeout,
-            utils::UUID_gen::micros_timestamp(ballot),
-            to_legacy(*key.get_compound_type(s), key.representation())
-        );
+    try {
+        co_await execute_cql_with_timeout(
+                format("DELETE most_recent_commit FROM \"{}\".\"{}\" USING TIMESTAMP ? WHERE row_key = ?{}",
+                    state_schema->ks_name(), state_schema->cf_name(), 
+                    paxos_state_cf_filter(s, *state_schema)
+                ),
+                timeout,
+                utils::UUID_gen::micros_timestamp(ballot),
+                to_legacy(*key.get_compound_type(s), key.representation())
+            );
+    } catch (...) {
+        _cache.invalidate(s, key);
+        throw;
+    }
+    _cache.apply_prune(s, key, ballot);
 }
 
 } // end of namespace "service::paxos"
@@ -8,6 +8,7 @@
  */
 #pragma once
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/metrics_registration.hh>
 #include "service/paxos/proposal.hh"
 #include "utils/log.hh"
 #include "utils/digest_algorithm.hh"
@@ -15,6 +16,8 @@
 #include <unordered_map>
 #include "utils/UUID_gen.hh"
 #include "service/paxos/prepare_response.hh"
+#include "service/paxos/paxos_state_cache.hh"
+#include "utils/observable.hh"
 #include "service/migration_listener.hh"
 
 namespace cql3 {
@@ -95,6 +98,16 @@ class paxos_state {
 
     static future<guard> get_cas_lock(const dht::token& key, clock_type::time_point timeout);
 
+    // A ballot the replicas promised to a coordinator when they accepted
+    // the decision it made before. See accept().
+    struct lease {
+        utils::UUID decision;
+        utils::UUID ballot;
+    };
+    // Takes the lease this shard holds on the key as a coordinator, if any.
+    static std::optional<lease> take_coordinator_lease(const schema& s, const dht::token& key);
+    static void set_coordinator_lease(const schema& s, const dht::token& key, lease l);
+
     static logging::logger logger;
 
     paxos_state() {}
@@ -108,7 +121,21 @@ class paxos_state {
             const query::read_command& cmd, const partition_key& key, utils::UUID ballot,
             bool only_digest, query::digest_algorithm da, clock_type::time_point timeout);
     // Replica RPC endpoint for Paxos "accept" phase.
+    //
+    // If next_ballot is set, the replica also promises it to the coordinator
+    // when accepting the proposal. Once the proposal is decided, and learned
+    // by a quorum, the coordinator can propose its next value for the key
+    // with next_ballot right away: the promises of the replicas, made along
+    // with the most recent decision, stand for a prepare round.
+    // Such a proposal is leased, and is accepted only by the replicas which
+    // still promise exactly its ballot.
     static future<bool> accept(storage_proxy& sp, paxos_store& paxos_store, tracing::trace_state_ptr tr_state, schema_ptr schema, dht::token token, const proposal& proposal,
+            clock_type::time_point timeout, bool leased = false, std::optional<utils::UUID> next_ballot = std::nullopt);
+    // Reads the current value of the key from this replica for a leased
+    // proposal. Returns nothing unless the replica has learned the decision
+    // of the lease and still promises its ballot.
+    static future<std::optional<foreign_ptr<lw_shared_ptr<query::result>>>> read_under_lease(storage_proxy& sp, paxos_store& paxos_store,
+            tracing::trace_state_ptr tr_state, schema_ptr schema, const query::read_command& cmd, const partition_key& key, lease l,
             clock_type::time_point timeout);
     // Replica RPC endpoint for Paxos "learn".
     static future<> learn(storage_proxy& sp, paxos_store& paxos_store, schema_ptr schema, proposal decision, clock_type::time_point timeout, tracing::trace_state_ptr tr_state);
@@ -126,6 +153,9 @@ class paxos_store:
     gms::feature_service& _features;
     replica::database& _db;
     migration_manager& _mm;
+    paxos_state_cache _cache;
+    utils::observer<uint32_t> _cache_size_observer;
+    seastar::metrics::metric_groups _metrics;
     bool _stopped = false;
 
     template <typename... Args>
@@ -147,7 +177,10 @@ class paxos_store:
     future<service::paxos::paxos_state> load_paxos_state(partition_key_view key, schema_ptr s, gc_clock::time_point now,
         db::timeout_clock::time_point timeout);
     future<> save_paxos_promise(const schema& s, const partition_key& key, const utils::UUID& ballot, db::timeout_clock::time_point timeout);
-    future<> save_paxos_proposal(const schema& s, const service::paxos::proposal& proposal, db::timeout_clock::time_point timeout);
+    // Saves the promise of the proposal's ballot along with it, or of the
+    // next ballot, if given.
+    future<> save_paxos_proposal(const schema& s, const service::paxos::proposal& proposal, db::timeout_clock::time_point timeout,
+            std::optional<utils::UUID> next_ballot = std::nullopt);
     future<> save_paxos_decision(const schema& s, const service::paxos::proposal& decision, db::timeout_clock::time_point timeout);
     future<> delete_paxos_decision(const schema& s, const partition_key& key, utils::UUID ballot, db::timeout_clock::time_point timeout);
 
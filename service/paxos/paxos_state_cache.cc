@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "service/paxos/paxos_state_cache.hh"
+#include "schema/schema.hh"
+#include "utils/UUID_gen.hh"
+
+namespace service::paxos {
+
+static api::timestamp_type ballot_timestamp(const utils::UUID& ballot) {
+    return utils::UUID_gen::micros_timestamp(ballot);
+}
+
+size_t paxos_state_cache::key_hash::operator()(const key_type& k) const noexcept {
+    return std::hash<table_id>()(k.table) ^ std::hash<bytes_view>()(k.key);
+}
+
+paxos_state_cache::paxos_state_cache(size_t capacity) noexcept
+    : _capacity(capacity)
+{ }
+
+paxos_state_cache::key_type paxos_state_cache::make_key(const schema& s, partition_key_view key) {
+    return key_type{s.id(), to_bytes(key.representation())};
+}
+
+std::optional<gc_clock::time_point> paxos_state_cache::expiry(const entry& e, gc_clock::duration ttl) noexcept {
+    if (ttl == gc_clock::duration::zero()) {
+        return std::nullopt;
+    }
+    // The cells are written with the timestamp of their ballot, and expire
+    // ttl after they were written, which is not earlier than that.
+    auto oldest = api::max_timestamp;
+    if (e.promised != utils::UUID_gen::min_time_UUID()) {
+        oldest = std::min(oldest, ballot_timestamp(e.promised));
+    }
+    if (e.accepted) {
+        oldest = std::min(oldest, ballot_timestamp(e.accepted->ballot));
+    }
+    if (e.most_recent_commit_at) {
+        oldest = std::min(oldest, ballot_timestamp(*e.most_recent_commit_at));
+    }
+    if (oldest == api::max_timestamp) {
+        return std::nullopt;
+    }
+    auto written_at = gc_clock::time_point(std::chrono::duration_cast<gc_clock::duration>(std::chrono::microseconds(oldest)));
+    return written_at + ttl;
+}
+
+void paxos_state_cache::set_capacity(size_t capacity) noexcept {
+    _capacity = capacity;
+    evict();
+}
+
+void paxos_state_cache::erase(map_type::iterator it) noexcept {
+    _used -= it->second.memory_usage;
+    _entries.erase(it);
+}
+
+void paxos_state_cache::invalidate(map_type::iterator it) noexcept {
+    ++_stats.invalidations;
+    erase(it);
+}
+
+void paxos_state_cache::update_memory_usage(entry& e) noexcept {
+    size_t usage = sizeof(map_type::value_type);
+    if (e.accepted) {
+        usage += e.accepted->update.representation().size();
+    }
+    if (e.most_recent_commit) {
+        usage += e.most_recent_commit->representation().size();
+    }
+    _used = _used - e.memory_usage + usage;
+    e.memory_usage = usage;
+}
+
+void paxos_state_cache::evict() noexcept {
+    while (_used > _capacity && !_lru.empty()) {
+        auto& e = _lru.front();
+        ++_stats.evictions;
+        erase(_entries.find(*e.key));
+    }
+}
+
+void paxos_state_cache::touch(entry& e) noexcept {
+    e.lru_link.unlink();
+    _lru.push_back(e);
+}
+
+bool paxos_state_cache::merge_promise(entry& e, const utils::UUID& ballot) noexcept {
+    if (ballot == e.promised) {
+        return true;
+    }
+    auto ts = ballot_timestamp(ballot);
+    auto promised_ts = ballot_timestamp(e.promised);
+    if (ts == promised_ts) {
+        return false;
+    }
+    if (ts > promised_ts) {
+        e.promised = ballot;
+    }
+    return true;
+}
+
+bool paxos_state_cache::merge_proposal(entry& e, const proposal& p) {
+    auto ts = ballot_timestamp(p.ballot);
+    if (ts <= e.accepted_deleted_at) {
+        return true;
+    }
+    if (e.accepted) {
+        if (e.accepted->ballot == p.ballot) {
+            return true;
+        }
+        auto accepted_ts = ballot_timestamp(e.accepted->ballot);
+        if (ts == accepted_ts) {
+            return false;
+        }
+        if (ts < accepted_ts) {
+            return true;
+        }
+    }
+    e.accepted.emplace(p);
+    return true;
+}
+
+bool paxos_state_cache::merge_commit(entry& e, const utils::UUID& ballot, const frozen_mutation* update) {
+    auto ts = ballot_timestamp(ballot);
+    if (e.most_recent_commit_at && *e.most_recent_commit_at != ballot) {
+        auto commit_ts = ballot_timestamp(*e.most_recent_commit_at);
+        if (ts == commit_ts) {
+            return false;
+        }
+        if (ts < commit_ts) {
+            return true;
+        }
+        e.most_recent_commit.reset();
+    }
+    e.most_recent_commit_at = ballot;
+    if (update && ts > e.most_recent_commit_deleted_at && !e.most_recent_commit) {
+        e.most_recent_commit.emplace(*update);
+    }
+    return true;
+}
+
+bool paxos_state_cache::merge_decision(entry& e, const proposal& decision) {
+    // The decision deletes the accepted proposal and sets the most recent
+    // commit, all cells with the timestamp of its ballot.
+    auto ts = ballot_timestamp(decision.ballot);
+    e.accepted_deleted_at = std::max(e.accepted_deleted_at, ts);
+    if (e.accepted && ballot_timestamp(e.accepted->ballot) <= ts) {
+        e.accepted.reset();
+    }
+    return merge_commit(e, decision.ballot, &decision.update);
+}
+
+bool paxos_state_cache::merge_prune(entry& e, const utils::UUID& ballot) noexcept {
+    auto ts = ballot_timestamp(ballot);
+    e.most_recent_commit_deleted_at = std::max(e.most_recent_commit_deleted_at, ts);
+    if (e.most_recent_commit_at && ballot_timestamp(*e.most_recent_commit_at) <= ts) {
+        e.most_recent_commit.reset();
+    }
+    return true;
+}
+
+template <typename Func>
+void paxos_state_cache::apply(const schema& s, partition_key_view key, Func&& merge) {
+    auto it = _entries.find(make_key(s, key));
+    if (it == _entries.end()) {
+        return;
+    }
+    bool merged;
+    try {
+        merged = merge(it->second);
+    } catch (...) {
+        merged = false;
+    }
+    if (!merged) {
+        invalidate(it);
+        return;
+    }
+    update_memory_usage(it->second);
+    evict();
+}
+
+std::optional<paxos_state_cache::state> paxos_state_cache::get(const schema& s, partition_key_view key, version_type version,
+        gc_clock::time_point now, gc_clock::duration ttl) {
+    auto it = _entries.find(make_key(s, key));
+    if (it == _entries.end() || !it->second.complete) {
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    auto& e = it->second;
+    if (auto expires = expiry(e, ttl); e.version != version || (expires && *expires <= now)) {
+        ++_stats.misses;
+        invalidate(it);
+        return std::nullopt;
+    }
+    ++_stats.hits;
+    touch(e);
+    return state{e.promised, e.accepted, e.most_recent_commit_at, e.most_recent_commit};
+}
+
+std::optional<uint64_t> paxos_state_cache::start_load(const schema& s, partition_key_view key, version_type version) {
+    if (!enabled()) {
+        return std::nullopt;
+    }
+    auto k = make_key(s, key);
+    if (auto it = _entries.find(k); it != _entries.end()) {
+        if (!it->second.complete) {
+            // Another read of the key is in progress, let it fill the cache.
+            return std::nullopt;
+        }
+        // The state is stale.
+        erase(it);
+    }
+    auto [it, inserted] = _entries.try_emplace(std::move(k));
+    auto& e = it->second;
+    e.key = &it->first;
+    e.promised = utils::UUID_gen::min_time_UUID();
+    e.generation = _next_generation++;
+    e.version = version;
+    _lru.push_back(e);
+    update_memory_usage(e);
+    auto generation = e.generation;
+    evict();
+    return generation;
+}
+
+void paxos_state_cache::finish_load(const schema& s, partition_key_view key, uint64_t generation, const state& loaded) {
+    auto it = _entries.find(make_key(s, key));
+    if (it == _entries.end() || it->second.generation != generation) {
+        return;
+    }
+    auto& e = it->second;
+    bool merged;
+    try {
+        merged = merge_promise(e, loaded.promised)
+            && (!loaded.accepted || merge_proposal(e, *loaded.accepted));
+        if (merged && loaded.most_recent_commit_at) {
+            // A missing commit was pruned, which can only have happened
+            // with a timestamp at least as high as the one of the commit.
+            merged = merge_commit(e, *loaded.most_recent_commit_at, loaded.most_recent_commit ? &*loaded.most_recent_commit : nullptr)
+                && (loaded.most_recent_commit || merge_prune(e, *loaded.most_recent_commit_at));
+        }
+    } catch (...) {
+        merged = false;
+    }
+    if (!merged) {
+        invalidate(it);
+        return;
+    }
+    e.complete = true;
+    update_memory_usage(e);
+    evict();
+}
+
+void paxos_state_cache::abort_load(const schema& s, partition_key_view key, uint64_t generation) noexcept {
+    try {
+        if (auto it = _entries.find(make_key(s, key)); it != _entries.end() && it->second.generation == generation) {
+            erase(it);
+        }
+    } catch (...) {
+        invalidate(s.id());
+    }
+}
+
+void paxos_state_cache::apply_promise(const schema& s, partition_key_view key, const utils::UUID& ballot) {
+    apply(s, key, [&] (entry& e) { return merge_promise(e, ballot); });
+}
+
+void paxos_state_cache::apply_proposal(const schema& s, const proposal& p) {
+    // The proposal is saved together with the promise of its ballot.
+    apply(s, p.update.key(), [&] (entry& e) { return merge_promise(e, p.ballot) && merge_proposal(e, p); });
+}
+
+void paxos_state_cache::apply_decision(const schema& s, const proposal& decision) {
+    apply(s, decision.update.key(), [&] (entry& e) { return merge_decision(e, decision); });
+}
+
+void paxos_state_cache::apply_prune(const schema& s, partition_key_view key, const utils::UUID& ballot) {
+    apply(s, key, [&] (entry& e) { return merge_prune(e, ballot); });
+}
+
+void paxos_state_cache::invalidate(const schema& s, partition_key_view key) noexcept {
+    try {
+        if (auto it = _entries.find(make_key(s, key)); it != _entries.end()) {
+            invalidate(it);
+        }
+    } catch (...) {
+        // Building the key failed to allocate, drop the whole table to be safe.
+        invalidate(s.id());
+    }
+}
+
+void paxos_state_cache::invalidate(table_id table) noexcept {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto next = std::next(it);
+        if (it->first.table == table) {
+            invalidate(it);
+        }
+        it = next;
+    }
+}
+
+void paxos_state_cache::invalidate_if_truncated(table_id table, db_clock::time_point truncated_at) noexcept {
+    // States cached while the table wasn't tracked, e.g. because tracking it
+    // failed to allocate, can't be told apart, drop them too.
+    try {
+        auto [it, inserted] = _truncated_at.try_emplace(table, truncated_at);
+        if (!inserted && it->second == truncated_at) {
+            return;
+        }
+        it->second = truncated_at;
+    } catch (...) {
+    }
+    invalidate(table);
+}
+
+void paxos_state_cache::drop_table(table_id table) noexcept {
+    invalidate(table);
+    _truncated_at.erase(table);
+}
+
+} // namespace service::paxos
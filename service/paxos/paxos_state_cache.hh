@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <boost/intrusive/list.hpp>
+#include "bytes.hh"
+#include "db_clock.hh"
+#include "gc_clock.hh"
+#include "schema/schema_fwd.hh"
+#include "service/paxos/proposal.hh"
+#include "timestamp.hh"
+
+namespace service::paxos {
+
+// An in-memory index of the Paxos state of the keys a shard is a replica of,
+// which spares the paxos table read of each prepare and accept on hot keys.
+//
+// The paxos table stays the source of truth: every change is written there
+// first, and applied to the cached state once the write succeeds. All cells
+// of the paxos table are written with the timestamp of the ballot they carry,
+// so the cached state applies changes the way the table merges its cells,
+// whatever order they come in. Where it can't tell the outcome of the merge,
+// e.g. on timestamp ties, or when a write fails and may or may not have been
+// applied, the state is dropped and read from the table again.
+//
+// Learns and prunes don't take the replica lock, so they may race with the
+// read of the table which fills the cache. The state is inserted before the
+// read starts and collects the changes applied meanwhile, so that the read
+// is merged into a state which is already up to date.
+//
+// The state is also dropped when the token metadata version changes, since
+// topology changes may stream the paxos state of other replicas in, and when
+// the table is truncated or dropped. It is dropped once its oldest cell
+// could have expired in the table, and evicted in LRU order when the cache
+// is full.
+class paxos_state_cache {
+public:
+    using version_type = int64_t;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+    };
+
+    // The Paxos state of a key, as in the paxos table.
+    struct state {
+        utils::UUID promised;
+        std::optional<proposal> accepted;
+        std::optional<utils::UUID> most_recent_commit_at;
+        // Missing if the most recent commit was pruned.
+        std::optional<frozen_mutation> most_recent_commit;
+    };
+private:
+    struct key_type {
+        table_id table;
+        bytes key;
+
+        bool operator==(const key_type&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key_type& k) const noexcept;
+    };
+
+    using lru_link_type = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+    struct entry {
+        utils::UUID promised;
+        std::optional<proposal> accepted;
+        // Timestamp of the deletion of the accepted proposal by a decision.
+        api::timestamp_type accepted_deleted_at = api::missing_timestamp;
+        std::optional<utils::UUID> most_recent_commit_at;
+        std::optional<frozen_mutation> most_recent_commit;
+        // Timestamp of the deletion of the most recent commit by a prune.
+        api::timestamp_type most_recent_commit_deleted_at = api::missing_timestamp;
+        // False until the read of the table is merged.
+        bool complete = false;
+        uint64_t generation;
+        version_type version;
+        size_t memory_usage = 0;
+        const key_type* key = nullptr;
+        lru_link_type lru_link;
+    };
+    using lru_type = boost::intrusive::list<entry,
+            boost::intrusive::member_hook<entry, lru_link_type, &entry::lru_link>,
+            boost::intrusive::constant_time_size<false>>;
+    using map_type = std::unordered_map<key_type, entry, key_hash>;
+
+    map_type _entries;
+    // Least recently used entries are at the front.
+    lru_type _lru;
+    size_t _capacity;
+    size_t _used = 0;
+    uint64_t _next_generation = 0;
+    // The truncation time of each table with cached states, as of when they
+    // were cached.
+    std::unordered_map<table_id, db_clock::time_point> _truncated_at;
+    stats _stats;
+private:
+    static key_type make_key(const schema& s, partition_key_view key);
+    // Returns the time the oldest cell of the state could expire at in the
+    // table, if its cells have a TTL.
+    static std::optional<gc_clock::time_point> expiry(const entry& e, gc_clock::duration ttl) noexcept;
+    void erase(map_type::iterator it) noexcept;
+    void invalidate(map_type::iterator it) noexcept;
+    void update_memory_usage(entry& e) noexcept;
+    void evict() noexcept;
+    void touch(entry& e) noexcept;
+    // The merge functions return false if the outcome of the merge in the
+    // table isn't known.
+    static bool merge_promise(entry& e, const utils::UUID& ballot) noexcept;
+    static bool merge_proposal(entry& e, const proposal& p);
+    static bool merge_commit(entry& e, const utils::UUID& ballot, const frozen_mutation* update);
+    static bool merge_decision(entry& e, const proposal& decision);
+    static bool merge_prune(entry& e, const utils::UUID& ballot) noexcept;
+    template <typename Func>
+    void apply(const schema& s, partition_key_view key, Func&& merge);
+public:
+    explicit paxos_state_cache(size_t capacity) noexcept;
+
+    void set_capacity(size_t capacity) noexcept;
+    bool enabled() const noexcept {
+        return _capacity > 0;
+    }
+
+    // Returns the state of the key, if it's cached and still valid for the
+    // given token metadata version. ttl is the TTL of the paxos table cells,
+    // zero if they don't expire.
+    std::optional<state> get(const schema& s, partition_key_view key, version_type version,
+            gc_clock::time_point now, gc_clock::duration ttl);
+
+    // Starts filling the cache with the state of the key read from the table.
+    // Must be called before the read starts. Returns the generation to pass
+    // to finish_load(), or nothing if the state can't be cached.
+    std::optional<uint64_t> start_load(const schema& s, partition_key_view key, version_type version);
+    // Merges the state read from the table after start_load().
+    void finish_load(const schema& s, partition_key_view key, uint64_t generation, const state& loaded);
+    // Drops the state inserted by start_load() if the read failed.
+    void abort_load(const schema& s, partition_key_view key, uint64_t generation) noexcept;
+
+    // Apply successful writes to the paxos table.
+    void apply_promise(const schema& s, partition_key_view key, const utils::UUID& ballot);
+    void apply_proposal(const schema& s, const proposal& p);
+    void apply_decision(const schema& s, const proposal& decision);
+    void apply_prune(const schema& s, partition_key_view key, const utils::UUID& ballot);
+
+    // Drops the state of the key, e.g. after a failed write.
+    void invalidate(const schema& s, partition_key_view key) noexcept;
+    // Drops the state of all keys of the table.
+    void invalidate(table_id table) noexcept;
+    // Drops the state of all keys of the table if it was truncated since
+    // they were cached. Must be called before get() and start_load() with
+    // the latest truncation time of the table.
+    void invalidate_if_truncated(table_id table, db_clock::time_point truncated_at) noexcept;
+    // Drops the state of all keys of a table which is being dropped.
+    void drop_table(table_id table) noexcept;
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+    size_t used_bytes() const noexcept {
+        return _used;
+    }
+};
+
+} // namespace service::paxos
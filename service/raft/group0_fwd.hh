@@ -80,6 +80,15 @@ struct direct_fd_ping_reply {
     std::variant<std::monostate, wrong_destination, group_liveness_info> result;
 };
 
+// A one-way message of a raft group, sent in a RAFT_MESSAGE_BATCH message
+// together with the messages of other groups to the same server.
+struct raft_batched_message {
+    using message_type = std::variant<raft::append_request, raft::append_reply, raft::vote_request, raft::vote_reply,
+            raft::timeout_now, raft::read_quorum, raft::read_quorum_reply>;
+    raft::group_id gid;
+    message_type message;
+};
+
 using raft_ticker_type = seastar::timer<lowres_clock>;
 // TODO: should be configurable.
 static constexpr raft_ticker_type::duration raft_tick_interval = std::chrono::milliseconds(100);
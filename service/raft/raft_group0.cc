@@ -268,12 +268,9 @@ raft_server_for_group raft_group0::create_server_for_group0(raft::group_id gid,
     auto server = raft::create_server(my_id, std::move(rpc), std::move(state_machine),
             std::move(storage), _raft_gr.failure_detector(), config);
 
-    // initialize the corresponding timer to tick the raft server instance
-    auto ticker = std::make_unique<raft_ticker_type>([srv = server.get()] { srv->tick(); });
     return raft_server_for_group{
         .gid = std::move(gid),
         .server = std::move(server),
-        .ticker = std::move(ticker),
         .rpc = rpc_ref,
         .persistence = persistence_ref,
         .default_op_timeout_in_ms = qp.proxy().get_db().local().get_config().group0_raft_op_timeout_in_ms
@@ -10,17 +10,21 @@
 #include "service/raft/raft_rpc.hh"
 #include "db/system_keyspace.hh"
 #include "message/messaging_service.hh"
+#include "gms/feature_service.hh"
 #include "gms/gossiper.hh"
 #include "gms/i_endpoint_state_change_subscriber.hh"
 #include "serializer_impl.hh"
 #include "idl/raft.dist.hh"
 #include "utils/composite_abort_source.hh"
 #include "utils/error_injection.hh"
+#include "utils/overloaded_functor.hh"
 #include "seastar/core/shared_future.hh"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/when_all.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 
 namespace service {
 
@@ -79,8 +83,18 @@ class direct_fd_proxy : public raft::failure_detector, public direct_failure_det
 
 raft_group_registry::raft_group_registry(
         raft::server_id my_id,
-        netw::messaging_service& ms, direct_failure_detector::failure_detector& fd)
+        netw::messaging_service& ms, direct_failure_detector::failure_detector& fd, gms::feature_service& feat,
+        utils::updateable_value<uint32_t> message_coalescing_window_in_us)
     : _ms(ms)
+    , _feat(feat)
+    , _ticker([this] { tick_servers(); })
+    , _tick_gate("raft_group_registry::tick")
+    , _message_batcher([this] (raft::server_id dst, std::vector<raft_batched_message> messages) {
+        return ser::raft_rpc_verbs::send_raft_message_batch(&_ms, locator::host_id{dst.uuid()},
+                raft_ticker_type::clock::now() + raft_tick_interval * (raft::ELECTION_TIMEOUT.count() / 2), _my_id, dst, messages);
+    }, raft_message_batcher::config{
+        .window_in_us = std::move(message_coalescing_window_in_us),
+    })
     , _direct_fd(fd)
     , _direct_fd_proxy(make_shared<direct_fd_proxy>(my_id))
     , _my_id(my_id)
@@ -201,6 +215,27 @@ void raft_group_registry::init_rpc_verbs() {
         });
     });
 
+    ser::raft_rpc_verbs::register_raft_message_batch(&_ms, [this] (const rpc::client_info& cinfo, rpc::opt_time_point timeout,
+            raft::server_id from, raft::server_id dst, std::vector<raft_batched_message> messages) -> future<rpc::no_wait_type> {
+        if (_my_id != dst) {
+            rslog.debug("Got message batch for server {}, but my id is {}", dst, _my_id);
+            co_return netw::messaging_service::no_wait();
+        }
+        std::unordered_map<unsigned, std::vector<raft_batched_message>> messages_per_shard;
+        for (auto& m : messages) {
+            messages_per_shard[shard_for_group(m.gid)].push_back(std::move(m));
+        }
+        // The messages stay on this shard, so that the log entries they
+        // share are freed here, see the RAFT_APPEND_ENTRIES handler.
+        co_await coroutine::parallel_for_each(messages_per_shard, [this, from] (auto& shard_and_messages) {
+            return container().invoke_on(shard_and_messages.first, [from, &messages = shard_and_messages.second,
+                    original_shard_id = this_shard_id()] (raft_group_registry& self) {
+                self.receive_batched_messages(from, messages, original_shard_id);
+            });
+        });
+        co_return netw::messaging_service::no_wait();
+    });
+
     ser::raft_rpc_verbs::register_direct_fd_ping(&_ms,
             [this] (const rpc::client_info&, raft::server_id dst) -> future<direct_fd_ping_reply> {
         // XXX: update address map here as well?
@@ -243,10 +278,61 @@ future<> raft_group_registry::uninit_rpc_verbs() {
         ser::raft_rpc_verbs::unregister_raft_execute_read_barrier_on_leader(&_ms),
         ser::raft_rpc_verbs::unregister_raft_add_entry(&_ms),
         ser::raft_rpc_verbs::unregister_raft_modify_config(&_ms),
+        ser::raft_rpc_verbs::unregister_raft_message_batch(&_ms),
         ser::raft_rpc_verbs::unregister_direct_fd_ping(&_ms)
     ).discard_result();
 }
 
+void raft_group_registry::receive_batched_messages(raft::server_id from, const std::vector<raft_batched_message>& messages, unsigned original_shard_id) {
+    for (auto& m : messages) {
+        auto it = _servers.find(m.gid);
+        if (it == _servers.end()) {
+            // The group is being created or was destroyed, as when its
+            // messages are sent separately.
+            rslog.debug("Dropping a batched message from {} for group {}: the group is not found", from, m.gid);
+            continue;
+        }
+        auto& rpc = it->second.rpc;
+        std::visit(overloaded_functor{
+            [&] (const raft::append_request& r) {
+                if (utils::get_local_injector().enter("raft_drop_incoming_append_entries")) {
+                    return;
+                }
+                // See the RAFT_APPEND_ENTRIES handler.
+                rpc.append_entries(from, this_shard_id() == original_shard_id ? raft::append_request(r) : r.copy());
+            },
+            [&] (const raft::append_reply& r) { rpc.append_entries_reply(from, r); },
+            [&] (const raft::vote_request& r) { rpc.request_vote(from, r); },
+            [&] (const raft::vote_reply& r) { rpc.request_vote_reply(from, r); },
+            [&] (const raft::timeout_now& r) { rpc.timeout_now_request(from, r); },
+            [&] (const raft::read_quorum& r) { rpc.read_quorum_request(from, r); },
+            [&] (const raft::read_quorum_reply& r) { rpc.read_quorum_reply(from, r); },
+        }, m.message);
+    }
+}
+
+void raft_group_registry::tick_servers() {
+    if (_ticking || _tick_gate.is_closed()) {
+        return;
+    }
+    _ticking = true;
+    (void)with_gate(_tick_gate, [this] {
+        return do_tick_servers();
+    }).finally([this] {
+        _ticking = false;
+    });
+}
+
+future<> raft_group_registry::do_tick_servers() {
+    // The servers can be added and removed while ticking yields.
+    for (auto gid : all_groups()) {
+        if (auto it = _servers.find(gid); it != _servers.end() && !it->second.aborted) {
+            it->second.server->tick();
+        }
+        co_await coroutine::maybe_yield();
+    }
+}
+
 void raft_group_registry::destroy_server(raft::group_id gid) {
     const auto it = _servers.find(gid);
     if (it == _servers.end()) {
@@ -263,6 +349,10 @@ seastar::future<> raft_group_registry::start() {
     // and starts an election, so RPC must be ready by
     // then to send VoteRequest messages.
     init_rpc_verbs();
+    _message_batch_feature_listener = _feat.raft_message_batch.when_enabled([this] {
+        _message_batcher.set_supported();
+    });
+    _ticker.arm_periodic(raft_tick_interval);
 
     direct_fd_clock::base::duration threshold{std::chrono::seconds{2}};
     if (const auto ms = utils::get_local_injector().inject_parameter<int64_t>("raft-group-registry-fd-threshold-in-ms"); ms) {
@@ -279,7 +369,10 @@ seastar::future<> raft_group_registry::stop() {
     if (_servers.size() > 0) {
         on_internal_error(rslog, format("stop(): server for group {} is not destroyed", _servers.begin()->first));
     }
+    _ticker.cancel();
+    co_await _tick_gate.close();
     co_await uninit_rpc_verbs();
+    co_await _message_batcher.stop();
     _direct_fd_subscription.reset();
 }
 
@@ -350,7 +443,7 @@ future<> raft_group_registry::start_server_for_group(raft_server_for_group new_g
     }
 
     try {
-        // start the server instance prior to arming the ticker timer.
+        // start the server instance prior to adding it to the servers ticked by the ticker.
         // By the time the tick() is executed the server should already be initialized.
         co_await new_grp.server->start();
         new_grp.server->register_metrics();
@@ -365,13 +458,12 @@ future<> raft_group_registry::start_server_for_group(raft_server_for_group new_g
     raft::server& server = *new_grp.server;
 
     try {
-        auto [it, inserted] = _servers.emplace(std::move(gid), std::move(new_grp));
+        new_grp.rpc.use_message_batcher(_message_batcher);
+        _servers.emplace(std::move(gid), std::move(new_grp));
 
         if (_servers.size() == 1 && this_shard_id() == 0) {
             _group0_id = gid;
         }
-
-        it->second.ticker->arm_periodic(raft_tick_interval);
     } catch (...) {
         ex = std::current_exception();
     }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/sharded.hh>
 
 #include "message/messaging_service_fwd.hh"
@@ -17,12 +18,18 @@
 #include "utils/recent_entries_map.hh"
 #include "service/direct_failure_detector/failure_detector.hh"
 #include "service/raft/group0_fwd.hh"
+#include "service/raft/raft_message_batcher.hh"
+#include "gms/feature.hh"
 #include "utils/updateable_value.hh"
 
 namespace db {
 class system_keyspace;
 }
 
+namespace gms {
+class feature_service;
+}
+
 namespace service {
 
 class raft_rpc;
@@ -48,7 +55,6 @@ class raft_group_registry;
 struct raft_server_for_group {
     raft::group_id gid;
     std::unique_ptr<raft::server> server;
-    std::unique_ptr<raft_ticker_type> ticker;
     raft_rpc& rpc;
     raft_sys_table_storage& persistence;
     std::optional<seastar::shared_future<>> aborted;
@@ -105,10 +111,21 @@ class direct_fd_proxy;
 class raft_group_registry : public seastar::peering_sharded_service<raft_group_registry> {
 private:
     netw::messaging_service& _ms;
-    // Raft servers along with the corresponding timers to tick each instance.
-    // Currently ticking every 100ms.
+    gms::feature_service& _feat;
     std::unordered_map<raft::group_id, raft_server_for_group> _servers;
 
+    // Ticks all servers of the shard together, every raft_tick_interval,
+    // rather than a timer per server, so that the heartbeats of all groups
+    // are sent at the same time and can be batched.
+    raft_ticker_type _ticker;
+    // Held by the fiber ticking the servers, which can yield when there are
+    // many of them. A tick is skipped while the previous one is running.
+    seastar::named_gate _tick_gate;
+    bool _ticking = false;
+
+    raft_message_batcher _message_batcher;
+    gms::feature::listener_registration _message_batch_feature_listener;
+
     direct_failure_detector::failure_detector& _direct_fd;
     // Listens to notifications from direct failure detector.
     // Implements the `raft::failure_detector` interface. Used by all raft groups to check server liveness.
@@ -121,6 +138,12 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
 
     raft_server_for_group& server_for_group(raft::group_id id);
 
+    void tick_servers();
+    future<> do_tick_servers();
+
+    // Handles the messages of a RAFT_MESSAGE_BATCH message which are for the groups of this shard
+    void receive_batched_messages(raft::server_id from, const std::vector<raft_batched_message>& messages, unsigned original_shard);
+
     // Group 0 id, valid only on shard 0 after boot/upgrade is over
     std::optional<raft::group_id> _group0_id;
 
@@ -129,7 +152,8 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
 
 public:
     raft_group_registry(raft::server_id my_id, netw::messaging_service& ms,
-            direct_failure_detector::failure_detector& fd);
+            direct_failure_detector::failure_detector& fd, gms::feature_service& feat,
+            utils::updateable_value<uint32_t> message_coalescing_window_in_us);
     ~raft_group_registry();
 
     // Called manually at start on every shard.
@@ -175,12 +199,13 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
     // after boot/upgrade is complete
     raft_server_with_timeouts group0_with_timeouts();
 
-    // Start raft server instance, store in the map of raft servers and
-    // arm the associated timer to tick the server.
+    // Start raft server instance and store it in the map of raft servers,
+    // whose servers are ticked by the shared ticker.
     future<> start_server_for_group(raft_server_for_group grp);
     unsigned shard_for_group(const raft::group_id& gid) const;
     shared_ptr<raft::failure_detector> failure_detector();
     direct_failure_detector::failure_detector& direct_fd() { return _direct_fd; }
+    const raft_message_batcher::stats& message_batcher_stats() const { return _message_batcher.get_stats(); }
 };
 
 // Implementation of `direct_failure_detector::pinger` which uses DIRECT_FD_PING verb for pinging.
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/coroutine.hh>
+
+#include "service/raft/raft_message_batcher.hh"
+#include "utils/overloaded_functor.hh"
+
+namespace service {
+
+// A rough size of the message and of the group id, for limiting the size of a batch
+static size_t message_size(const raft_batched_message::message_type& message) {
+    static constexpr size_t fixed_size = 64;
+    return std::visit(overloaded_functor{
+        [] (const raft::append_request& r) {
+            size_t size = fixed_size;
+            for (const auto& e : r.entries) {
+                size += e->get_size();
+            }
+            return size;
+        },
+        [] (const auto&) {
+            return fixed_size;
+        },
+    }, message);
+}
+
+raft_message_batcher::raft_message_batcher(send_function send, config cfg)
+    : _send(std::move(send))
+    , _cfg(std::move(cfg))
+    , _gate("raft_message_batcher")
+{
+}
+
+future<> raft_message_batcher::send(raft::server_id dst, raft::group_id gid, raft_batched_message::message_type message) {
+    auto size = message_size(message);
+    auto [it, inserted] = _destinations.try_emplace(dst);
+    auto& d = it->second;
+    if (inserted) {
+        d.flush_timer.set_callback([this, dst] { flush(dst); });
+    }
+    if (!d.pending) {
+        d.pending = make_lw_shared<batch>();
+        d.flush_timer.arm(std::chrono::microseconds(_cfg.window_in_us()));
+    }
+    auto b = d.pending;
+    b->messages.push_back(raft_batched_message{.gid = gid, .message = std::move(message)});
+    b->bytes += size;
+    ++_stats.messages;
+    auto f = b->sent.get_shared_future();
+    if (b->bytes >= _cfg.max_batch_bytes) {
+        d.flush_timer.cancel();
+        flush(dst);
+    }
+    return f;
+}
+
+void raft_message_batcher::flush(raft::server_id dst) {
+    auto it = _destinations.find(dst);
+    if (it == _destinations.end() || !it->second.pending) {
+        return;
+    }
+    auto b = std::exchange(it->second.pending, nullptr);
+    ++_stats.batches;
+    (void)futurize_invoke([this, dst, b] {
+        return with_gate(_gate, [this, dst, b] {
+            return _send(dst, std::move(b->messages));
+        });
+    }).then_wrapped([b] (future<> f) {
+        if (f.failed()) {
+            b->sent.set_exception(f.get_exception());
+        } else {
+            b->sent.set_value();
+        }
+    });
+}
+
+future<> raft_message_batcher::stop() {
+    for (auto& [dst, d] : _destinations) {
+        d.flush_timer.cancel();
+        flush(dst);
+    }
+    co_await _gate.close();
+    _destinations.clear();
+}
+
+} // namespace service
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include "raft/raft.hh"
+#include "service/raft/group0_fwd.hh"
+#include "utils/updateable_value.hh"
+
+namespace service {
+
+// Coalesces the one-way messages which the raft groups of a shard send to
+// the same server into RAFT_MESSAGE_BATCH messages.
+//
+// With a raft group per tablet there are thousands of groups on a node, most
+// of them idle, whose leaders send heartbeats to the same few followers on
+// every tick. Sent one by one, each heartbeat and each reply to it is an RPC
+// message of its own. The batcher holds a message for up to the coalescing
+// window, and sends it together with the messages of other groups queued
+// for the same server in the meantime, as soon as the window passes or the
+// queued messages reach max_batch_bytes. Since all groups are ticked
+// together (see raft_group_registry), the heartbeats of a tick end up in a
+// single message to each follower.
+class raft_message_batcher {
+public:
+    using send_function = noncopyable_function<future<>(raft::server_id dst, std::vector<raft_batched_message> messages)>;
+
+    struct config {
+        // 0 disables the coalescing
+        utils::updateable_value<uint32_t> window_in_us;
+        size_t max_batch_bytes = 128 * 1024;
+    };
+
+    struct stats {
+        uint64_t messages = 0;
+        uint64_t batches = 0;
+    };
+private:
+    struct batch {
+        std::vector<raft_batched_message> messages;
+        size_t bytes = 0;
+        shared_promise<> sent;
+    };
+    struct destination {
+        lw_shared_ptr<batch> pending;
+        timer<> flush_timer;
+    };
+
+    send_function _send;
+    config _cfg;
+    bool _supported = false;
+    std::unordered_map<raft::server_id, destination> _destinations;
+    seastar::named_gate _gate;
+    stats _stats;
+private:
+    void flush(raft::server_id dst);
+public:
+    raft_message_batcher(send_function send, config cfg);
+
+    // Called once all nodes understand RAFT_MESSAGE_BATCH messages
+    void set_supported() noexcept {
+        _supported = true;
+    }
+
+    // Whether the groups should send their one-way messages through send()
+    bool enabled() const noexcept {
+        return _supported && _cfg.window_in_us() > 0 && !_gate.is_closed();
+    }
+
+    // Queues the message of the group for sending to the server. The returned
+    // future resolves when the batch with the message is sent, with the
+    // exception of the send function if it fails.
+    future<> send(raft::server_id dst, raft::group_id gid, raft_batched_message::message_type message);
+
+    // Sends the queued messages and waits for all the sends to complete.
+    future<> stop();
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+} // namespace service
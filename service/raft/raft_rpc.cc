@@ -13,6 +13,7 @@
 #include "message/msg_addr.hh"
 #include "message/messaging_service.hh"
 #include "db/timeout_clock.hh"
+#include "service/raft/raft_message_batcher.hh"
 #include "service/raft/raft_state_machine.hh"
 #include "service/raft/group0_fwd.hh"
 #include "idl/raft.dist.hh"
@@ -47,8 +48,10 @@ raft_rpc::one_way_rpc(sloc loc, raft::server_id id,
                 loc.file_name(), loc.line(), loc.function_name(), id);
             return make_ready_future<>();
         }
-        return verb(&_messaging, locator::host_id{id.uuid()}, timeout(), _group_id, _my_id, id, std::forward<Msg>(msg))
-            .handle_exception([loc = std::move(loc), id] (std::exception_ptr ex) {
+        auto f = _batcher && _batcher->enabled()
+            ? _batcher->send(id, _group_id, raft_batched_message::message_type(std::forward<Msg>(msg)))
+            : verb(&_messaging, locator::host_id{id.uuid()}, timeout(), _group_id, _my_id, id, std::forward<Msg>(msg));
+        return std::move(f).handle_exception([loc = std::move(loc), id] (std::exception_ptr ex) {
                 try {
                     std::rethrow_exception(ex);
                 } catch (seastar::rpc::timeout_error&) {
@@ -98,6 +101,9 @@ future<> raft_rpc::send_append_entries(raft::server_id id, const raft::append_re
     }
     const auto guard = co_await get_units(_append_entries_semaphore, std::min(req_size, append_entries_semaphore_limit_bytes));
 
+    if (_batcher && _batcher->enabled()) {
+        co_return co_await _batcher->send(id, _group_id, append_request);
+    }
     co_return co_await ser::raft_rpc_verbs::send_raft_append_entries(&_messaging, locator::host_id{id.uuid()},
             db::no_timeout, _group_id, _my_id, id, append_request);
 }
@@ -15,6 +15,7 @@
 namespace service {
 
 class raft_state_machine;
+class raft_message_batcher;
 
 // Scylla-specific implementation of raft RPC module.
 //
@@ -32,6 +33,9 @@ class raft_rpc : public raft::rpc {
     // Limits the total memory usage of raft::append_request messages that are currently being sent
     seastar::semaphore _append_entries_semaphore;
 
+    // Coalesces the one-way messages with those of other groups, if set and enabled
+    raft_message_batcher* _batcher = nullptr;
+
     explicit raft_rpc(raft_state_machine& sm, netw::messaging_service& ms,
              shared_ptr<raft::failure_detector> failure_detector, raft::group_id gid, raft::server_id my_id);
 
@@ -45,6 +49,10 @@ class raft_rpc : public raft::rpc {
     two_way_rpc(seastar::compat::source_location loc, raft::server_id id, Verb&& verb, Args&&... args);
 
 public:
+    void use_message_batcher(raft_message_batcher& batcher) noexcept {
+        _batcher = &batcher;
+    }
+
     future<raft::snapshot_reply> send_snapshot(raft::server_id server_id, const raft::install_snapshot& snap, seastar::abort_source& as) override;
     future<> send_append_entries(raft::server_id id, const raft::append_request& append_request) override;
     void send_append_entries_reply(raft::server_id id, const raft::append_reply& reply) override;
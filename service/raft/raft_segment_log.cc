@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+#include <charconv>
+
+#include <seastar/core/align.hh>
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/on_internal_error.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/util/file.hh>
+
+#include "service/raft/raft_segment_log.hh"
+#include "utils/assert.hh"
+#include "utils/checked-file-impl.hh"
+#include "utils/crc.hh"
+#include "utils/disk-error-handler.hh"
+#include "utils/lister.hh"
+#include "utils/log.hh"
+
+#include "serializer.hh"
+#include "idl/raft_storage.dist.hh"
+#include "serializer_impl.hh"
+#include "idl/raft_storage.dist.impl.hh"
+
+namespace service {
+
+static logging::logger rsllog("raft_segment_log");
+
+namespace {
+
+enum class record_type : uint8_t {
+    entry = 1,
+    truncation = 2,
+};
+
+constexpr size_t record_header_size = 2 * sizeof(uint32_t);
+constexpr size_t payload_header_size = sizeof(uint8_t) + 2 * sizeof(uint64_t);
+
+template <typename T>
+void write_be(bytes_ostream& out, T v) {
+    char buf[sizeof(T)];
+    seastar::write_be<T>(buf, v);
+    out.write(buf, sizeof(T));
+}
+
+void write_record(bytes_ostream& out, record_type type, raft::term_t term, raft::index_t idx, const bytes_ostream& data) {
+    bytes_ostream payload;
+    write_be<uint8_t>(payload, uint8_t(type));
+    write_be<uint64_t>(payload, term.value());
+    write_be<uint64_t>(payload, idx.value());
+    payload.append(data);
+    utils::crc32 crc;
+    for (bytes_view frag : payload) {
+        crc.process(reinterpret_cast<const uint8_t*>(frag.data()), frag.size());
+    }
+    write_be<uint32_t>(out, payload.size());
+    write_be<uint32_t>(out, crc.get());
+    out.append(payload);
+}
+
+std::optional<uint64_t> parse_segment_name(std::string_view name) {
+    static constexpr std::string_view prefix = "segment-";
+    static constexpr std::string_view suffix = ".log";
+    if (!name.starts_with(prefix) || !name.ends_with(suffix)) {
+        return std::nullopt;
+    }
+    name.remove_prefix(prefix.size());
+    name.remove_suffix(suffix.size());
+    uint64_t id;
+    auto [ptr, ec] = std::from_chars(name.data(), name.data() + name.size(), id);
+    if (ec != std::errc() || ptr != name.data() + name.size()) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+}
+
+raft_segment_log::raft_segment_log(std::filesystem::path dir, size_t max_segment_size)
+    : _dir(std::move(dir))
+    , _max_segment_size(max_segment_size) {
+}
+
+std::filesystem::path raft_segment_log::segment_path(uint64_t id) const {
+    return _dir / fmt::format("segment-{:020}.log", id);
+}
+
+future<raft::log_entries> raft_segment_log::load() {
+    SCYLLA_ASSERT(!_current);
+    _segments.clear();
+    _last_idx = raft::index_t(0);
+    _next_segment_id = 0;
+    raft::log_entries log;
+    if (!co_await file_exists(_dir.native())) {
+        _loaded = true;
+        co_return log;
+    }
+
+    std::vector<uint64_t> ids;
+    co_await lister::scan_dir(_dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [&ids] (fs::path, directory_entry de) {
+        if (auto id = parse_segment_name(de.name)) {
+            ids.push_back(*id);
+        } else {
+            rsllog.warn("Ignoring unexpected file {} in the raft log directory", de.name);
+        }
+        return make_ready_future<>();
+    });
+    std::ranges::sort(ids);
+
+    using data_variant_type = decltype(raft::log_entry::data);
+    for (auto id : ids) {
+        auto path = segment_path(id);
+        auto content = co_await util::read_entire_file_contiguous(path);
+        auto data = std::string_view(content.data(), content.size());
+        auto& seg = _segments.emplace_back(segment{.id = id});
+        size_t pos = 0;
+        while (pos + record_header_size <= data.size()) {
+            auto size = seastar::read_be<uint32_t>(data.data() + pos);
+            if (size == 0) {
+                // Padding up to the next block.
+                pos = align_up(pos + 1, block_size);
+                continue;
+            }
+            auto expected_crc = seastar::read_be<uint32_t>(data.data() + pos + sizeof(uint32_t));
+            if (size < payload_header_size || pos + record_header_size + size > data.size()) {
+                rsllog.info("Raft log segment {} ends with an incomplete record at offset {}", path.native(), pos);
+                break;
+            }
+            auto payload = data.substr(pos + record_header_size, size);
+            utils::crc32 crc;
+            crc.process(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+            if (crc.get() != expected_crc) {
+                rsllog.info("Raft log segment {} ends with an invalid record at offset {}", path.native(), pos);
+                break;
+            }
+            pos += record_header_size + size;
+
+            auto type = record_type(uint8_t(payload[0]));
+            auto term = raft::term_t(seastar::read_be<uint64_t>(payload.data() + 1));
+            auto idx = raft::index_t(seastar::read_be<uint64_t>(payload.data() + 1 + sizeof(uint64_t)));
+            payload.remove_prefix(payload_header_size);
+            switch (type) {
+            case record_type::truncation:
+                while (!log.empty() && log.back()->idx >= idx) {
+                    log.pop_back();
+                }
+                for (auto& s : _segments) {
+                    if (s.first_idx >= idx) {
+                        s.first_idx = s.last_idx = raft::index_t(0);
+                    } else if (s.last_idx >= idx) {
+                        s.last_idx = raft::index_t(idx.value() - 1);
+                    }
+                }
+                break;
+            case record_type::entry: {
+                if (!log.empty() && idx != raft::index_t(log.back()->idx.value() + 1)) {
+                    throw std::runtime_error(fmt::format("Raft log segment {} has entry {} following entry {}",
+                            path.native(), idx, log.back()->idx));
+                }
+                auto in = ser::as_input_stream(bytes_view(reinterpret_cast<const int8_t*>(payload.data()), payload.size()));
+                auto entry_data = ser::deserialize(in, std::type_identity<data_variant_type>());
+                log.emplace_back(make_lw_shared<const raft::log_entry>(
+                        raft::log_entry{.term = term, .idx = idx, .data = std::move(entry_data)}));
+                if (!seg.first_idx) {
+                    seg.first_idx = idx;
+                }
+                seg.last_idx = idx;
+                break;
+            }
+            default:
+                throw std::runtime_error(fmt::format("Raft log segment {} has a record of unknown type {} at offset {}",
+                        path.native(), uint8_t(type), pos));
+            }
+            co_await coroutine::maybe_yield();
+        }
+    }
+    _last_idx = log.empty() ? raft::index_t(0) : log.back()->idx;
+    _next_segment_id = ids.empty() ? 0 : ids.back() + 1;
+    _loaded = true;
+    rsllog.debug("Loaded {} raft log entries from {} segments in {}", log.size(), _segments.size(), _dir.native());
+    co_return log;
+}
+
+future<> raft_segment_log::ensure_loaded() {
+    if (!_loaded) {
+        co_await load();
+    }
+}
+
+future<> raft_segment_log::open_segment() {
+    if (_current) {
+        co_await _current->close();
+        _current.reset();
+    }
+    co_await io_check([this] { return recursive_touch_directory(_dir.native()); });
+    auto id = _next_segment_id++;
+    auto f = co_await open_checked_file_dma(general_disk_error_handler, segment_path(id).native(),
+            open_flags::wo | open_flags::create | open_flags::exclusive);
+    co_await io_check(sync_directory, _dir.native());
+    _current_alignment = std::max<size_t>(block_size, f.disk_write_dma_alignment());
+    _current = std::move(f);
+    _current_size = 0;
+    _segments.push_back(segment{.id = id});
+}
+
+future<> raft_segment_log::write(bytes_ostream records) {
+    // Don't leave an incomplete record of this write in a segment which
+    // will be appended to.
+    if (!_current || _current_size >= _max_segment_size) {
+        co_await open_segment();
+    }
+    auto size = align_up(records.size(), _current_alignment);
+    auto buf = temporary_buffer<char>::aligned(_current->memory_dma_alignment(), size);
+    auto out = buf.get_write();
+    for (bytes_view frag : records) {
+        out = std::copy_n(reinterpret_cast<const char*>(frag.data()), frag.size(), out);
+    }
+    std::fill(out, buf.get_write() + size, 0);
+    auto written = co_await _current->dma_write(_current_size, buf.get(), size);
+    if (written != size) {
+        throw std::runtime_error(fmt::format("Short write to raft log segment {}: {} out of {} bytes",
+                segment_path(_segments.back().id).native(), written, size));
+    }
+    co_await _current->flush();
+    _current_size += size;
+}
+
+future<> raft_segment_log::append(const std::vector<raft::log_entry_ptr>& entries) {
+    if (entries.empty()) {
+        co_return;
+    }
+    co_await ensure_loaded();
+    if (_last_idx && entries.front()->idx != raft::index_t(_last_idx.value() + 1)) {
+        on_internal_error(rsllog, fmt::format("Appending raft log entry {} after entry {} to {}", entries.front()->idx, _last_idx, _dir.native()));
+    }
+    bytes_ostream records;
+    for (auto& e : entries) {
+        bytes_ostream data;
+        ser::serialize(data, e->data);
+        write_record(records, record_type::entry, e->term, e->idx, data);
+        co_await coroutine::maybe_yield();
+    }
+    co_await write(std::move(records));
+    auto& seg = _segments.back();
+    if (!seg.first_idx) {
+        seg.first_idx = entries.front()->idx;
+    }
+    seg.last_idx = _last_idx = entries.back()->idx;
+}
+
+future<> raft_segment_log::truncate(raft::index_t idx) {
+    co_await ensure_loaded();
+    if (!_last_idx || _last_idx < idx) {
+        co_return;
+    }
+    bytes_ostream records;
+    write_record(records, record_type::truncation, raft::term_t(0), idx, bytes_ostream());
+    co_await write(std::move(records));
+    // The truncation record is durable, so the segments which only have the
+    // truncated entries can go. The current one is kept, as it has the record.
+    std::vector<segment> to_remove;
+    auto current_id = _segments.back().id;
+    std::erase_if(_segments, [&] (segment& s) {
+        if (s.first_idx >= idx && s.first_idx && s.id != current_id) {
+            to_remove.push_back(s);
+            return true;
+        }
+        if (s.first_idx >= idx) {
+            s.first_idx = s.last_idx = raft::index_t(0);
+        } else if (s.last_idx >= idx) {
+            s.last_idx = raft::index_t(idx.value() - 1);
+        }
+        return false;
+    });
+    _last_idx = raft::index_t(idx.value() - 1);
+    for (auto& s : to_remove) {
+        co_await remove_segment(s);
+    }
+}
+
+future<> raft_segment_log::truncate_prefix(raft::index_t idx) {
+    co_await ensure_loaded();
+    // Only the oldest segments can go, as later segments may have truncation
+    // records which apply to the entries of the earlier ones.
+    while (_segments.size() > 1 && _segments.front().last_idx <= idx) {
+        auto seg = _segments.front();
+        _segments.erase(_segments.begin());
+        co_await remove_segment(seg);
+    }
+}
+
+future<> raft_segment_log::remove_segment(const segment& seg) {
+    auto path = segment_path(seg.id);
+    rsllog.debug("Removing raft log segment {} with entries {}..{}", path.native(), seg.first_idx, seg.last_idx);
+    co_await io_check(remove_file, path.native());
+    co_await io_check(sync_directory, _dir.native());
+}
+
+future<> raft_segment_log::remove_all() {
+    co_await close();
+    _segments.clear();
+    _last_idx = raft::index_t(0);
+    if (co_await file_exists(_dir.native())) {
+        co_await lister::rmdir(_dir);
+        co_await io_check(sync_directory, _dir.parent_path().native());
+    }
+}
+
+future<> raft_segment_log::close() {
+    if (_current) {
+        co_await _current->close();
+        _current.reset();
+    }
+}
+
+} // namespace service
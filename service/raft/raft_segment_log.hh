@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+
+#include "bytes_ostream.hh"
+#include "raft/raft.hh"
+#include "seastarx.hh"
+
+namespace service {
+
+// Append-only, file based storage of the log of one raft group.
+//
+// The log is stored in segment files in a directory of its own, which are
+// written with direct IO and are never modified after they are written.
+// Each call to append() or truncate() writes its records at the end of the
+// current segment, padded to a block boundary, and syncs the file once, so
+// the entries of a batch share a single fsync. A new segment is started
+// after restarts and when the current one grows above the maximum size.
+//
+// A segment is a sequence of records:
+//
+//   record:  payload size (u32), CRC32 of the payload (u32), payload
+//   payload: type (u8), term (u64), index (u64), serialized entry data
+//
+// padded with zeros to the block size. All integers are big-endian.
+// An entry record appends an entry to the log; a truncation record removes
+// the entries with the given index and above, written by earlier records.
+// The log is read back by replaying the records of all segments in order,
+// stopping at the first invalid record of a segment, as left by a write
+// which didn't complete.
+//
+// Truncating the log tail (e.g. after a snapshot) deletes the oldest segments
+// whose entries are all covered, instead of writing tombstones.
+class raft_segment_log {
+public:
+    static constexpr size_t default_max_segment_size = 32 * 1024 * 1024;
+    static constexpr size_t block_size = 4096;
+private:
+    struct segment {
+        uint64_t id;
+        // The range of the entries of the log which are stored in the
+        // segment, 0 if there are none.
+        raft::index_t first_idx;
+        raft::index_t last_idx;
+    };
+
+    std::filesystem::path _dir;
+    size_t _max_segment_size;
+    bool _loaded = false;
+    // Ordered by id, which is also the order in which they were written.
+    std::vector<segment> _segments;
+    raft::index_t _last_idx;
+    uint64_t _next_segment_id = 0;
+    // The segment written to, the last one in _segments.
+    // Opened by the first write after load().
+    std::optional<file> _current;
+    uint64_t _current_size = 0;
+    size_t _current_alignment = block_size;
+private:
+    std::filesystem::path segment_path(uint64_t id) const;
+    future<> ensure_loaded();
+    future<> open_segment();
+    future<> write(bytes_ostream records);
+    future<> remove_segment(const segment& seg);
+public:
+    explicit raft_segment_log(std::filesystem::path dir, size_t max_segment_size = default_max_segment_size);
+
+    const std::filesystem::path& directory() const noexcept {
+        return _dir;
+    }
+
+    // Reads the log back from the segments.
+    // Must be called before the other functions, which otherwise load it
+    // first. A missing directory is an empty log.
+    future<raft::log_entries> load();
+
+    // Appends the entries, which must follow the last entry of the log.
+    // They are durable when the returned future resolves.
+    future<> append(const std::vector<raft::log_entry_ptr>& entries);
+
+    // Removes the entries with index `idx` and above.
+    future<> truncate(raft::index_t idx);
+
+    // Deletes the oldest segments which only have entries with index `idx`
+    // and below. Some of these entries may remain, in segments which also
+    // have later entries.
+    future<> truncate_prefix(raft::index_t idx);
+
+    // Deletes all segments, and the directory.
+    future<> remove_all();
+
+    future<> close();
+};
+
+} // namespace service
@@ -12,6 +12,7 @@
 #include "db/system_keyspace.hh"
 #include "utils/UUID.hh"
 #include "utils/error_injection.hh"
+#include "utils/log.hh"
 
 #include "serializer.hh"
 #include "idl/raft_storage.dist.hh"
@@ -30,7 +31,21 @@
 
 namespace service {
 
+static logging::logger rstlog("raft_sys_table_storage");
+
+static std::filesystem::path segment_log_directory(const db::config& cfg, raft::group_id gid) {
+    if (cfg.raft_log_directory().empty()) {
+        return {};
+    }
+    return std::filesystem::path(cfg.raft_log_directory()) / fmt::format("{}", gid);
+}
+
 raft_sys_table_storage::raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid, raft::server_id server_id)
+    : raft_sys_table_storage(qp, gid, server_id, segment_log_directory(qp.db().get_config(), gid), qp.db().get_config().raft_segment_log_storage())
+{ }
+
+raft_sys_table_storage::raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid, raft::server_id server_id,
+        std::filesystem::path segment_log_dir, bool use_segment_log)
     : _group_id(std::move(gid))
     , _server_id(std::move(server_id))
     , _qp(qp)
@@ -38,6 +53,8 @@ raft_sys_table_storage::raft_sys_table_storage(cql3::query_processor& qp, raft::
     , _pending_op_fut(make_ready_future<>())
     // max_mutation_size = 1/2 of commitlog segment size, thus _max_mutation_size is set 1/3 of commitlog segment size to leave space for metadata.
     , _max_mutation_size(_qp.db().get_config().schema_commitlog_segment_size_in_mb() * 1024 * 1024 / 3)
+    , _segment_log(segment_log_dir.empty() ? nullptr : std::make_unique<raft_segment_log>(std::move(segment_log_dir)))
+    , _use_segment_log(use_segment_log && _segment_log)
 {
     static const auto store_cql = format("INSERT INTO system.{} (group_id, term, \"index\", data) VALUES (?, ?, ?, ?)",
         db::system_keyspace::RAFT);
@@ -90,6 +107,35 @@ future<raft::index_t> raft_sys_table_storage::load_commit_idx() {
 }
 
 future<raft::log_entries> raft_sys_table_storage::load_log() {
+    auto log = co_await load_log_from_table();
+    if (!_segment_log) {
+        co_return log;
+    }
+    auto segment_log = co_await _segment_log->load();
+    auto [from, to] = _use_segment_log ? std::tie(log, segment_log) : std::tie(segment_log, log);
+    if (from.empty()) {
+        co_return std::move(to);
+    }
+    // Whatever is left in the store which isn't used was written by the last
+    // run, or is a copy of the other store left by an interrupted move.
+    // Either way, it replaces the content of the other store.
+    rstlog.info("Moving {} raft log entries of group {} from {} to {}", from.size(), _group_id,
+            _use_segment_log ? "system.raft" : _segment_log->directory().native(),
+            _use_segment_log ? _segment_log->directory().native() : "system.raft");
+    auto entries = std::vector<raft::log_entry_ptr>(from.begin(), from.end());
+    if (_use_segment_log) {
+        co_await _segment_log->remove_all();
+        co_await _segment_log->append(entries);
+        co_await truncate_log_in_table(raft::index_t(0));
+    } else {
+        co_await truncate_log_in_table(raft::index_t(0));
+        co_await do_store_log_entries(entries);
+        co_await _segment_log->remove_all();
+    }
+    co_return std::move(from);
+}
+
+future<raft::log_entries> raft_sys_table_storage::load_log_from_table() {
     static const auto load_cql = format("SELECT term, \"index\", data FROM system.{} WHERE group_id = ?", db::system_keyspace::RAFT);
     ::shared_ptr<cql3::untyped_result_set> rs = co_await _qp.execute_internal(load_cql, {_group_id.id}, cql3::query_processor::cache_internal::yes);
 
@@ -278,38 +324,59 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
 
 future<> raft_sys_table_storage::store_log_entries(const std::vector<raft::log_entry_ptr>& entries) {
     return execute_with_linearization_point([this, &entries] {
+        if (_use_segment_log) {
+            return _segment_log->append(entries);
+        }
         return do_store_log_entries(entries);
     });
 }
 
 future<> raft_sys_table_storage::truncate_log(raft::index_t idx) {
     return execute_with_linearization_point([this, idx] {
-        static const auto truncate_cql = format("DELETE FROM system.{} WHERE group_id = ? AND \"index\" >= ?",
-            db::system_keyspace::RAFT); 
-        return _qp.execute_internal(truncate_cql, {_group_id.id, int64_t(idx.value())}, cql3::query_processor::cache_internal::yes).discard_result();
+        if (_use_segment_log) {
+            return _segment_log->truncate(idx);
+        }
+        return truncate_log_in_table(idx);
     });
 }
 
+future<> raft_sys_table_storage::truncate_log_in_table(raft::index_t idx) {
+    static const auto truncate_cql = format("DELETE FROM system.{} WHERE group_id = ? AND \"index\" >= ?",
+        db::system_keyspace::RAFT);
+    return _qp.execute_internal(truncate_cql, {_group_id.id, int64_t(idx.value())}, cql3::query_processor::cache_internal::yes).discard_result();
+}
+
 future<> raft_sys_table_storage::abort() {
     // wait for pending write requests to complete.
     // TODO: should we wait for all kinds of requests?
-    return std::move(_pending_op_fut);
+    co_await std::move(_pending_op_fut);
+    if (_segment_log) {
+        co_await _segment_log->close();
+    }
 }
 
 future<> raft_sys_table_storage::update_snapshot_and_truncate_log_tail(const raft::snapshot_descriptor &snap, size_t preserve_log_entries) {
     // Update snapshot and truncate logs in `system.raft` atomically
     raft::index_t log_tail_idx(snap.idx.value() - preserve_log_entries);
+    if (_use_segment_log) {
+        static const auto store_latest_id_cql = format("INSERT INTO system.{} (group_id, snapshot_id) VALUES (?, ?)", db::system_keyspace::RAFT);
+        co_await _qp.execute_internal(store_latest_id_cql, {_group_id.id, snap.id.id}, cql3::query_processor::cache_internal::yes);
+        if (snap.idx.value() > preserve_log_entries) {
+            co_await _segment_log->truncate_prefix(log_tail_idx);
+        }
+        co_return;
+    }
     static const auto store_latest_id_and_truncate_log_tail_cql = format(
         "BEGIN UNLOGGED BATCH"
         "   INSERT INTO system.{} (group_id, snapshot_id) VALUES (?, ?);"   // store latest id
         "   DELETE FROM system.{} WHERE group_id = ? AND \"index\" <= ?;"   // truncate log tail
         "APPLY BATCH",
         db::system_keyspace::RAFT, db::system_keyspace::RAFT);
-    return _qp.execute_internal(
+    co_await _qp.execute_internal(
         store_latest_id_and_truncate_log_tail_cql,
         {_group_id.id, snap.id.id, _group_id.id, int64_t(log_tail_idx.value())},
         cql3::query_processor::cache_internal::yes
-    ).discard_result();
+    );
 }
 
 future<> raft_sys_table_storage::execute_with_linearization_point(std::function<future<>()> f) {
@@ -9,12 +9,15 @@
 
 #include "raft/raft.hh"
 
-#include <vector>
+#include <filesystem>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <seastar/core/future.hh>
 
 #include "service/query_state.hh"
+#include "service/raft/raft_segment_log.hh"
 #include "seastarx.hh"
 
 namespace cql3 {
@@ -34,6 +37,9 @@ namespace service {
 // Scylla-specific implementation of raft persistence module.
 //
 // Uses "raft" system table as a backend storage to persist raft state.
+// The log entries can be stored in a raft_segment_log instead, in which case
+// the entries found in the table on load are moved to the segments, and vice
+// versa when the segment log is not used.
 class raft_sys_table_storage : public raft::persistence {
     raft::group_id _group_id;
     raft::server_id _server_id;
@@ -52,8 +58,16 @@ class raft_sys_table_storage : public raft::persistence {
 
     const size_t _max_mutation_size;
 
+    // Null if there is no directory for the segments.
+    std::unique_ptr<raft_segment_log> _segment_log;
+    bool _use_segment_log;
+
 public:
+    // Uses the segment log according to raft_segment_log_storage and raft_log_directory.
     explicit raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid, raft::server_id server_id);
+    // Uses a segment log in `segment_log_dir` if `use_segment_log`, the table otherwise.
+    raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid, raft::server_id server_id,
+            std::filesystem::path segment_log_dir, bool use_segment_log);
 
     future<> store_term_and_vote(raft::term_t term, raft::server_id vote) override;
     future<std::pair<raft::term_t, raft::server_id>> load_term_and_vote() override;
@@ -82,6 +96,9 @@ class raft_sys_table_storage : public raft::persistence {
     future<> bootstrap(raft::configuration initial_configuation, bool nontrivial_snapshot);
 private:
 
+    future<raft::log_entries> load_log_from_table();
+    // Deletes the entries with indices >= idx from the table.
+    future<> truncate_log_in_table(raft::index_t idx);
     future<size_t> do_store_log_entries_one_batch(const std::vector<raft::log_entry_ptr>& entries, size_t start_idx);
     future<> do_store_log_entries(const std::vector<raft::log_entry_ptr>& entries);
     // Truncate all entries from the persisted log with indices <= idx
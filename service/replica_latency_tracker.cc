@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <cmath>
+#include "service/replica_latency_tracker.hh"
+
+using namespace std::chrono_literals;
+
+namespace service {
+
+// Decays the values by the time passed, however often the estimates are
+// refreshed, so that the samples of a replica which wasn't read from for a
+// while stop being trusted.
+void replica_latency_tracker::decay(replica_latency& rl, clock_type::time_point now) {
+    auto elapsed = std::chrono::duration<double>(now - rl.decayed_at).count();
+    if (elapsed < 1) {
+        return;
+    }
+    rl.histogram *= std::pow(0.9, elapsed);
+    rl.decayed_at = now;
+}
+
+void replica_latency_tracker::maybe_refresh(replica_latency& rl, double percentile) {
+    auto now = clock_type::now();
+    if (rl.refreshed_at && now - *rl.refreshed_at <= 1s && (percentile < 0 || rl.cached_percentile == percentile)) {
+        return;
+    }
+    rl.refreshed_at = now;
+    decay(rl, now);
+    if (rl.histogram.count() < min_samples) {
+        rl.median = 0us;
+        rl.cached_percentile_value = 0us;
+    } else {
+        rl.median = std::chrono::microseconds(std::max(rl.histogram.percentile(0.5), int64_t(1)));
+        if (percentile >= 0) {
+            rl.cached_percentile = percentile;
+        }
+        if (rl.cached_percentile >= 0) {
+            rl.cached_percentile_value = std::chrono::microseconds(std::max(rl.histogram.percentile(rl.cached_percentile), int64_t(1)));
+        }
+    }
+}
+
+void replica_latency_tracker::add(locator::host_id replica, std::chrono::microseconds latency) {
+    _replicas[replica].histogram.add(latency.count());
+}
+
+std::optional<std::chrono::microseconds> replica_latency_tracker::median(locator::host_id replica) {
+    auto it = _replicas.find(replica);
+    if (it == _replicas.end()) {
+        return std::nullopt;
+    }
+    maybe_refresh(it->second, -1);
+    if (it->second.median == 0us) {
+        return std::nullopt;
+    }
+    return it->second.median;
+}
+
+std::optional<std::chrono::microseconds> replica_latency_tracker::percentile(locator::host_id replica, double percentile) {
+    auto it = _replicas.find(replica);
+    if (it == _replicas.end()) {
+        return std::nullopt;
+    }
+    maybe_refresh(it->second, percentile);
+    if (it->second.cached_percentile_value == 0us) {
+        return std::nullopt;
+    }
+    return it->second.cached_percentile_value;
+}
+
+std::vector<replica_latency_tracker::replica_latency_info> replica_latency_tracker::get_replica_latencies() const {
+    std::vector<replica_latency_info> ret;
+    ret.reserve(_replicas.size());
+    for (auto& [host, rl] : _replicas) {
+        auto& h = rl.histogram;
+        ret.push_back(replica_latency_info{
+            .host = host,
+            .samples = h.count(),
+            .mean = std::chrono::microseconds(h.mean()),
+            .median = std::chrono::microseconds(h.percentile(0.5)),
+            .p99 = std::chrono::microseconds(h.percentile(0.99)),
+        });
+    }
+    return ret;
+}
+
+} // namespace service
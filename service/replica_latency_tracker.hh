@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <seastar/core/lowres_clock.hh>
+#include "locator/host_id.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace service {
+
+// Tracks the latency of the read requests which this shard, as a coordinator,
+// sends to each replica.
+//
+// Like the per-table coordinator read latency used for speculative retry,
+// the histograms are decayed by 10% for each second passed, so that recent
+// requests weigh more, and the percentiles are recomputed at most once a second.
+// Unlike it, a single slow replica doesn't affect the estimates of the others.
+class replica_latency_tracker {
+public:
+    using clock_type = seastar::lowres_clock;
+    // Below this many (decayed) samples a replica's estimates are not trusted.
+    static constexpr int64_t min_samples = 50;
+
+    struct replica_latency_info {
+        locator::host_id host;
+        int64_t samples;
+        std::chrono::microseconds mean;
+        std::chrono::microseconds median;
+        std::chrono::microseconds p99;
+    };
+private:
+    struct replica_latency {
+        utils::estimated_histogram histogram;
+        clock_type::time_point decayed_at = clock_type::now();
+        std::optional<clock_type::time_point> refreshed_at;
+        // Estimates as of refreshed_at, zero if there were too few samples.
+        std::chrono::microseconds median{0};
+        double cached_percentile = -1;
+        std::chrono::microseconds cached_percentile_value{0};
+    };
+    std::unordered_map<locator::host_id, replica_latency> _replicas;
+private:
+    static void decay(replica_latency& rl, clock_type::time_point now);
+    void maybe_refresh(replica_latency& rl, double percentile);
+public:
+    void add(locator::host_id replica, std::chrono::microseconds latency);
+
+    // Estimated median latency of requests to the replica,
+    // or std::nullopt if there is not enough recent data.
+    std::optional<std::chrono::microseconds> median(locator::host_id replica);
+
+    // Estimated latency of requests to the replica at the given percentile (0 - 1),
+    // or std::nullopt if there is not enough recent data.
+    std::optional<std::chrono::microseconds> percentile(locator::host_id replica, double percentile);
+
+    // Forgets a replica, e.g. one which left the cluster.
+    void remove(locator::host_id replica) {
+        _replicas.erase(replica);
+    }
+
+    std::vector<replica_latency_info> get_replica_latencies() const;
+};
+
+} // namespace service
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <cmath>
+
+#include "service/replica_phi_accrual_detector.hh"
+
+namespace service {
+
+// The weight of a new wait in the moving averages.
+static constexpr double alpha = 0.1;
+
+void replica_phi_accrual_detector::request_sent(locator::host_id replica, clock_type::time_point now) {
+    auto& rs = _replicas[replica];
+    if (!rs.awaited_since) {
+        rs.awaited_since = now;
+    }
+}
+
+void replica_phi_accrual_detector::response_received(locator::host_id replica, clock_type::time_point now) {
+    auto it = _replicas.find(replica);
+    if (it == _replicas.end() || !it->second.awaited_since) {
+        return;
+    }
+    auto& rs = it->second;
+    double wait = std::chrono::duration_cast<std::chrono::microseconds>(now - *std::exchange(rs.awaited_since, std::nullopt)).count();
+    if (rs.samples++ == 0) {
+        rs.mean_us = wait;
+        rs.variance_us2 = 0;
+        return;
+    }
+    auto diff = wait - rs.mean_us;
+    rs.mean_us += alpha * diff;
+    rs.variance_us2 = (1 - alpha) * (rs.variance_us2 + alpha * diff * diff);
+}
+
+double replica_phi_accrual_detector::phi(locator::host_id replica, clock_type::time_point now) const {
+    auto it = _replicas.find(replica);
+    if (it == _replicas.end() || !it->second.awaited_since || it->second.samples < min_samples) {
+        return 0;
+    }
+    auto& rs = it->second;
+    double waited = std::chrono::duration_cast<std::chrono::microseconds>(now - *rs.awaited_since).count();
+    double std_deviation = std::max(std::sqrt(rs.variance_us2), double(std::chrono::microseconds(min_std_deviation).count()));
+    // The logistic approximation of the cumulative distribution function of
+    // the normal distribution, as used by Akka's phi accrual failure detector.
+    auto y = (waited - rs.mean_us) / std_deviation;
+    auto e = std::exp(-y * (1.5976 + 0.070566 * y * y));
+    if (waited > rs.mean_us) {
+        return -std::log10(e / (1.0 + e));
+    }
+    return -std::log10(1.0 - 1.0 / (1.0 + e));
+}
+
+} // namespace service
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include "locator/host_id.hh"
+
+namespace service {
+
+// A phi accrual failure detector of the replicas, fed by the requests which
+// this shard, as a coordinator, sends to them.
+//
+// Unlike the failure detectors which use pings sent at a fixed interval, the
+// regular request traffic is the heartbeat: each time a request is sent to a
+// replica which has no unanswered requests, the replica starts being awaited,
+// and the next response from it (to any request) ends the wait. The durations
+// of the waits are modeled by a normal distribution, whose mean and variance
+// are exponential moving averages, so that they adapt to the current load of
+// the replica. While a replica is awaited, phi is -log10 of the probability
+// that the wait lasts that long; a replica which isn't awaited isn't
+// suspected, however long ago it last responded.
+class replica_phi_accrual_detector {
+public:
+    using clock_type = std::chrono::steady_clock;
+    // Below this many waits, a replica is never suspected.
+    static constexpr unsigned min_samples = 10;
+    // Tolerates the pauses, e.g. a slow request or a stall, which the
+    // recent waits don't show, so that the replica isn't suspected because
+    // it usually responds within a millisecond.
+    static constexpr std::chrono::milliseconds min_std_deviation{50};
+private:
+    struct replica_state {
+        double mean_us = 0;
+        double variance_us2 = 0;
+        unsigned samples = 0;
+        std::optional<clock_type::time_point> awaited_since;
+    };
+    std::unordered_map<locator::host_id, replica_state> _replicas;
+public:
+    void request_sent(locator::host_id replica, clock_type::time_point now = clock_type::now());
+    void response_received(locator::host_id replica, clock_type::time_point now = clock_type::now());
+
+    // The suspicion level of the replica, 0 if it is not awaited or there are too few samples.
+    double phi(locator::host_id replica, clock_type::time_point now = clock_type::now()) const;
+
+    bool suspected(locator::host_id replica, double threshold, clock_type::time_point now = clock_type::now()) const {
+        return phi(replica, now) > threshold;
+    }
+
+    // Forgets a replica, e.g. one which left the cluster.
+    void remove(locator::host_id replica) {
+        _replicas.erase(replica);
+    }
+};
+
+} // namespace service
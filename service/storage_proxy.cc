@@ -14,6 +14,9 @@
 
 #include <fmt/ranges.h>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/later.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/util/defer.hh>
 #include "gms/inet_address.hh"
@@ -24,10 +27,13 @@
 #include "db/commitlog/commitlog.hh"
 #include "storage_proxy.hh"
 #include "service/topology_state_machine.hh"
+#include "service/batched_mutation.hh"
+#include "service/partition_digest.hh"
 #include "db/view/view_building_state.hh"
 #include "unimplemented.hh"
 #include "mutation/mutation.hh"
 #include "mutation/frozen_mutation.hh"
+#include "counters.hh"
 #include "mutation/async_utils.hh"
 #include "query_result_merger.hh"
 #include <seastar/core/do_with.hh>
@@ -250,6 +256,32 @@ class storage_proxy::remote {
     netw::connection_drop_slot_t _connection_dropped;
     netw::connection_drop_registration_t _condrop_registration;
 
+    // Mutations waiting to be sent to a replica in a single MUTATION_BATCH message.
+    // Batches are kept per scheduling group, so that each one is sent over the
+    // connection of the tenant which issued its writes.
+    struct mutation_batch {
+        std::vector<batched_mutation> mutations;
+        std::vector<storage_proxy::clock_type::time_point> timeouts;
+        size_t size = 0;
+        storage_proxy::clock_type::time_point timeout = storage_proxy::clock_type::time_point::min();
+        shared_promise<> sent;
+        timer<> flush_timer;
+    };
+    struct mutation_batch_key {
+        locator::host_id addr;
+        scheduling_group sg;
+        // Hints are sent in HINT_MUTATION_BATCH messages, separately from regular writes.
+        bool hint = false;
+        bool operator==(const mutation_batch_key&) const = default;
+    };
+    struct mutation_batch_key_hash {
+        size_t operator()(const mutation_batch_key& k) const noexcept {
+            return std::hash<locator::host_id>()(k.addr) ^ std::hash<scheduling_group>()(k.sg) ^ size_t(k.hint);
+        }
+    };
+    std::unordered_map<mutation_batch_key, lw_shared_ptr<mutation_batch>, mutation_batch_key_hash> _mutation_batches;
+    seastar::named_gate _mutation_batch_gate;
+
     bool _stopped{false};
 
 public:
@@ -257,18 +289,22 @@ class storage_proxy::remote {
                 sharded<paxos::paxos_store>& paxos_store, raft_group0_client& group0_client, topology_state_machine& tsm, const db::view::view_building_state_machine& vbsm)
         : _sp(sp), _ms(ms), _gossiper(g), _mm(mm), _sys_ks(sys_ks), _paxos_store(paxos_store), _group0_client(group0_client), _topology_state_machine(tsm), _vb_state_machine(vbsm)
         , _truncate_gate("storage_proxy::remote::truncate_gate")
+        , _mutation_batch_gate("storage_proxy::remote::mutation_batch_gate")
         , _connection_dropped(std::bind_front(&remote::connection_dropped, this))
         , _condrop_registration(_ms.when_connection_drops(_connection_dropped))
     {
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::receive_mutation_batch_handler, this));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, std::bind_front(&remote::receive_hint_mutation_handler, this));
+        ser::storage_proxy_rpc_verbs::register_hint_mutation_batch(&_ms, std::bind_front(&remote::receive_hint_mutation_batch_handler, this));
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
         ser::storage_proxy_rpc_verbs::register_mutation_failed(&_ms, std::bind_front(&remote::handle_mutation_failed, this));
         ser::storage_proxy_rpc_verbs::register_read_data(&_ms, std::bind_front(&remote::handle_read_data, this));
         ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_ms, std::bind_front(&remote::handle_read_mutation_data, this));
         ser::storage_proxy_rpc_verbs::register_read_digest(&_ms, std::bind_front(&remote::handle_read_digest, this));
+        ser::storage_proxy_rpc_verbs::register_read_digest_multi(&_ms, std::bind_front(&remote::handle_read_digest_multi, this));
         ser::storage_proxy_rpc_verbs::register_truncate(&_ms, std::bind_front(&remote::handle_truncate, this));
         ser::storage_proxy_rpc_verbs::register_truncate_with_tablets(&_ms, std::bind_front(&remote::handle_truncate_with_tablets, this));
         // Register PAXOS verb handlers
@@ -285,6 +321,10 @@ class storage_proxy::remote {
     future<> stop() {
         _group0_as.request_abort();
         co_await _truncate_gate.close();
+        while (!_mutation_batches.empty()) {
+            flush_mutation_batch(_mutation_batches.begin()->first);
+        }
+        co_await _mutation_batch_gate.close();
         co_await ser::storage_proxy_rpc_verbs::unregister(&_ms);
         _stopped = true;
     }
@@ -312,6 +352,8 @@ class storage_proxy::remote {
     // Note: none of the `send_*` functions use `remote` after yielding - by the first yield,
     // control is delegated to another service (messaging_service). Thus unfinished `send`s
     // do not make it unsafe to destroy the `remote` object.
+    // The exception are coalesced mutations, which are sent from `flush_mutation_batch()`
+    // under `_mutation_batch_gate`, closed by `stop()`.
     //
     // Running handlers prevent the object from being destroyed,
     // assuming `stop()` is called before destruction.
@@ -332,6 +374,14 @@ class storage_proxy::remote {
             const frozen_mutation& m, const host_id_vector_replica_set& forward, gms::inet_address reply_to_ip, locator::host_id reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
+        // Mutations that the replica has to forward keep using the MUTATION verb,
+        // so that the forwarding node replies for each of them as before.
+        if (forward.empty() && !_mutation_batch_gate.is_closed() && _sp.features().coalesced_mutation_writes) {
+            auto window = std::chrono::microseconds(_sp._db.local().get_config().write_coalescing_window_in_us());
+            if (window.count() > 0) {
+                return coalesce_mutation(addr, timeout, trace_info, m, reply_to_ip, reply_to, shard, response_id, rate_limit_info, fence, window, false);
+            }
+        }
         inet_address_vector_replica_set forward_ips;
         return ser::storage_proxy_rpc_verbs::send_mutation(
                 &_ms, std::move(addr), timeout,
@@ -339,12 +389,82 @@ class storage_proxy::remote {
                 response_id, trace_info, rate_limit_info, fence, forward, reply_to);
     }
 
+    // Queues the mutation for the next MUTATION_BATCH message to `addr` (HINT_MUTATION_BATCH if
+    // `hint` is set). The message is sent once `window` passes since the first mutation was queued,
+    // or earlier, once the queued mutations reach write_coalescing_max_bytes. The returned future
+    // resolves when the message is handed over to messaging_service, like the one of send_mutation().
+    future<> coalesce_mutation(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, const std::optional<tracing::trace_info>& trace_info,
+            const frozen_mutation& m, gms::inet_address reply_to_ip, locator::host_id reply_to, unsigned shard,
+            storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
+            fencing_token fence, std::chrono::microseconds window, bool hint) {
+        auto key = mutation_batch_key{addr, current_scheduling_group(), hint};
+        auto it = _mutation_batches.find(key);
+        if (it == _mutation_batches.end()) {
+            auto b = make_lw_shared<mutation_batch>();
+            b->flush_timer.set_callback([this, key] { flush_mutation_batch(key); });
+            b->flush_timer.arm(window);
+            it = _mutation_batches.emplace(key, std::move(b)).first;
+        }
+        auto b = it->second;
+        b->mutations.push_back(batched_mutation{m, reply_to_ip, reply_to, shard, response_id, trace_info, rate_limit_info, fence, 0});
+        b->timeouts.push_back(timeout);
+        b->timeout = std::max(b->timeout, timeout);
+        b->size += m.representation().size();
+        auto f = b->sent.get_shared_future();
+        if (b->size >= _sp._db.local().get_config().write_coalescing_max_bytes()) {
+            flush_mutation_batch(key);
+        }
+        return f;
+    }
+
+    void flush_mutation_batch(mutation_batch_key key) {
+        auto node = _mutation_batches.extract(key);
+        if (node.empty()) {
+            return;
+        }
+        auto b = std::move(node.mapped());
+        b->flush_timer.cancel();
+        for (size_t i = 0; i < b->mutations.size(); ++i) {
+            b->mutations[i].timeout_delta_us = std::chrono::duration_cast<std::chrono::microseconds>(b->timeout - b->timeouts[i]).count();
+        }
+        // The gate is closed only after stop() flushes all batches.
+        (void)with_gate(_mutation_batch_gate, [this, key, b] {
+            return with_scheduling_group(key.sg, [this, key, b] {
+                auto& stats = _sp.get_stats();
+                if (key.hint) {
+                    ++stats.hint_mutation_batches_sent;
+                    stats.coalesced_hints_sent += b->mutations.size();
+                    return ser::storage_proxy_rpc_verbs::send_hint_mutation_batch(&_ms, key.addr, b->timeout, std::move(b->mutations));
+                }
+                ++stats.mutation_batches_sent;
+                stats.coalesced_mutations_sent += b->mutations.size();
+                return ser::storage_proxy_rpc_verbs::send_mutation_batch(&_ms, key.addr, b->timeout, std::move(b->mutations));
+            }).then_wrapped([b] (future<> f) {
+                if (f.failed()) {
+                    b->sent.set_exception(f.get_exception());
+                } else {
+                    b->sent.set_value();
+                }
+            });
+        });
+    }
+
     future<> send_hint_mutation(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const frozen_mutation& m, const host_id_vector_replica_set& forward, gms::inet_address reply_to_ip, locator::host_id reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
         tracing::trace(tr_state, "Sending a hint to /{}", addr);
+        // Replayed hints usually come in long runs to the same destination, so they are
+        // worth coalescing even when regular writes are not.
+        if (forward.empty() && !_mutation_batch_gate.is_closed() && _sp.features().coalesced_hint_replay) {
+            auto window = std::chrono::microseconds(_sp._db.local().get_config().hints_replay_coalescing_window_in_us());
+            if (window.count() > 0) {
+                return coalesce_mutation(addr, timeout, tracing::make_trace_info(tr_state), m, reply_to_ip, reply_to, shard, response_id,
+                        rate_limit_info, fence, window, true);
+            }
+        }
         return ser::storage_proxy_rpc_verbs::send_hint_mutation(
                 &_ms, std::move(addr), timeout,
                 m, get_forward_ips_if_needed(forward), reply_to_ip, shard,
@@ -430,6 +550,16 @@ class storage_proxy::remote {
         co_return rpc::tuple{d, t ? t.value() : api::missing_timestamp, hit_rate.value_or(cache_temperature::invalid()), opt_last_pos ? std::move(*opt_last_pos) : std::nullopt};
     }
 
+    future<std::vector<partition_digest>> send_read_digest_multi(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const query::read_command& cmd, std::vector<partition_digest_request> partitions,
+            query::digest_algorithm digest_algo, fencing_token fence) {
+        tracing::trace(tr_state, "read_digest_multi: sending a message with {} partitions to /{}", partitions.size(), addr);
+        auto digests = co_await ser::storage_proxy_rpc_verbs::send_read_digest_multi(&_ms, addr, timeout, cmd, std::move(partitions), digest_algo, fence);
+        tracing::trace(tr_state, "read_digest_multi: got response from /{}", addr);
+        co_return digests;
+    }
+
     future<> send_truncate(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout,
             sstring ks_name, sstring cf_name) {
@@ -446,9 +576,9 @@ class storage_proxy::remote {
 
     future<bool> send_paxos_accept(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
-            const service::paxos::proposal& proposal) {
+            const service::paxos::proposal& proposal, bool leased, std::optional<utils::UUID> next_ballot) {
         tracing::trace(tr_state, "accept_proposal: send accept {} to {}", proposal, addr);
-        return ser::storage_proxy_rpc_verbs::send_paxos_accept(&_ms, std::move(addr), timeout, proposal, tracing::make_trace_info(tr_state));
+        return ser::storage_proxy_rpc_verbs::send_paxos_accept(&_ms, std::move(addr), timeout, proposal, tracing::make_trace_info(tr_state), leased, next_ballot);
     }
 
     future<> send_paxos_learn(
@@ -708,6 +838,24 @@ class storage_proxy::remote {
                 });
     }
 
+    // Each mutation of the batch is applied and acknowledged (or failed) separately,
+    // exactly as if it arrived in its own MUTATION message.
+    future<rpc::no_wait_type> receive_mutation_batch_handler(
+            const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<batched_mutation> mutations) {
+        ++_sp.get_stats().received_mutation_batches;
+        co_await coroutine::parallel_for_each(mutations, [&] (batched_mutation& bm) {
+            auto timeout = t;
+            if (timeout) {
+                *timeout -= std::chrono::duration_cast<storage_proxy::clock_type::duration>(std::chrono::microseconds(bm.timeout_delta_us));
+            }
+            return receive_mutation_handler(_sp._write_smp_service_group, cinfo, timeout,
+                    std::move(bm.fm), {}, bm.reply_to, bm.shard, bm.response_id,
+                    std::move(bm.trace_info), bm.rate_limit_info, bm.fence,
+                    host_id_vector_replica_set{}, bm.reply_to_id).discard_result();
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     future<rpc::no_wait_type> receive_hint_mutation_handler(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             frozen_mutation in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
@@ -723,6 +871,23 @@ class storage_proxy::remote {
             std::monostate(), fence, std::move(forward_id), std::move(reply_to_id));
     }
 
+    // Like receive_mutation_batch_handler(), but each mutation is handled as a HINT_MUTATION.
+    future<rpc::no_wait_type> receive_hint_mutation_batch_handler(
+            const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<batched_mutation> mutations) {
+        ++_sp.get_stats().received_hint_mutation_batches;
+        co_await coroutine::parallel_for_each(mutations, [&] (batched_mutation& bm) {
+            auto timeout = t;
+            if (timeout) {
+                *timeout -= std::chrono::duration_cast<storage_proxy::clock_type::duration>(std::chrono::microseconds(bm.timeout_delta_us));
+            }
+            return receive_hint_mutation_handler(cinfo, timeout,
+                    std::move(bm.fm), {}, bm.reply_to, bm.shard, bm.response_id,
+                    std::move(bm.trace_info), bm.fence,
+                    host_id_vector_replica_set{}, bm.reply_to_id).discard_result();
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     future<rpc::no_wait_type> handle_paxos_learn(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             paxos::proposal decision, inet_address_vector_replica_set forward, gms::inet_address reply_to, unsigned shard,
@@ -958,6 +1123,21 @@ class storage_proxy::remote {
             std::move(pr), oda, rate_limit_info_opt, fence);
     }
 
+    // Reads each partition as a separate READ_DIGEST would, the partitions are read concurrently.
+    future<std::vector<partition_digest>> handle_read_digest_multi(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            query::read_command cmd, std::vector<partition_digest_request> partitions,
+            query::digest_algorithm da, service::fencing_token fence) {
+        std::vector<partition_digest> digests(partitions.size());
+        co_await coroutine::parallel_for_each(std::views::iota(size_t(0), partitions.size()), [&] (size_t i) {
+            return handle_read_digest(cinfo, t, cmd, std::move(partitions[i].range), da, partitions[i].rate_limit_info, fence).then([&digests, i] (read_digest_result_t r) {
+                auto&& [digest, last_modified, hit_rate, exception, last_pos] = r;
+                digests[i] = partition_digest{digest, last_modified, hit_rate, std::move(exception), std::move(last_pos)};
+            });
+        });
+        co_return digests;
+    }
+
     future<> handle_truncate(rpc::opt_time_point timeout, sstring ksname, sstring cfname) {
         co_await replica::database::truncate_table_on_all_shards(_sp._db, _sys_ks, ksname, cfname);
     }
@@ -1002,7 +1182,8 @@ class storage_proxy::remote {
 
     future<bool> handle_paxos_accept(
             const rpc::client_info& cinfo, rpc::opt_time_point timeout,
-            paxos::proposal proposal, std::optional<tracing::trace_info> trace_info) {
+            paxos::proposal proposal, std::optional<tracing::trace_info> trace_info,
+            rpc::optional<bool> leased_opt, rpc::optional<std::optional<utils::UUID>> next_ballot_opt) {
         auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
         auto src_shard = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
 
@@ -1023,8 +1204,9 @@ class storage_proxy::remote {
         bool local = shard == this_shard_id();
         _sp.get_stats().replica_cross_shard_ops += !local;
         co_return co_await _sp.container().invoke_on(shard, _sp._write_smp_service_group, coroutine::lambda([gs = global_schema_ptr(schema), gt = tracing::global_trace_state_ptr(tr_state),
-                                   proposal = std::move(proposal), timeout, token, this] (storage_proxy& sp) {
-            return paxos::paxos_state::accept(sp, paxos_store(), gt, gs, token, proposal, *timeout);
+                                   proposal = std::move(proposal), timeout, token, leased = leased_opt.value_or(false),
+                                   next_ballot = next_ballot_opt.value_or(std::nullopt), this] (storage_proxy& sp) {
+            return paxos::paxos_state::accept(sp, paxos_store(), gt, gs, token, proposal, *timeout, leased, next_ballot);
         }));
     }
 
@@ -1156,7 +1338,9 @@ using namespace exceptions;
 
 static inline
 query::digest_algorithm digest_algorithm(service::storage_proxy& proxy) {
-    return query::digest_algorithm::xxHash;
+    // All replicas of a read must use the same algorithm, which old nodes
+    // don't know.
+    return proxy.features().xxh3_digest ? query::digest_algorithm::xxh3 : query::digest_algorithm::xxHash;
 }
 
 static inline
@@ -1192,6 +1376,16 @@ static uint32_t random_variable_for_rate_limit() {
     return dist(re);
 }
 
+// In the coordinated mode, each replica accounts the operation on behalf of
+// the replicas which don't receive it, so that all the replicas - in all the
+// DCs - count the rate of the partition in the whole cluster.
+static uint32_t rate_limit_weight(const replica::database& db, size_t replicas, size_t targets) {
+    if (!db.get_config().per_partition_rate_limit_coordinated() || targets == 0) {
+        return 1;
+    }
+    return std::max<size_t>(1, (replicas + targets / 2) / targets);
+}
+
 static result<db::per_partition_rate_limit::info> choose_rate_limit_info(
         locator::effective_replication_map_ptr erm,
         replica::database& db,
@@ -1199,10 +1393,12 @@ static result<db::per_partition_rate_limit::info> choose_rate_limit_info(
         db::operation_type op_type,
         const schema_ptr& s,
         const dht::token& token,
+        uint32_t weight,
         tracing::trace_state_ptr tr_state) {
 
     db::per_partition_rate_limit::account_and_enforce enforce_info{
         .random_variable = random_variable_for_rate_limit(),
+        .weight = weight,
     };
     // It's fine to use shard_for_reads() because in case of no migration this is the
     // shard used by all requests. During migration, it is the shard used for request routing
@@ -1217,7 +1413,7 @@ static result<db::per_partition_rate_limit::info> choose_rate_limit_info(
                 // Tell other replicas only to account, but not reject
                 slogger.trace("Per-partition rate limiting: coordinator accepted");
                 tracing::trace(tr_state, "Per-partition rate limiting: coordinator accepted");
-                return db::per_partition_rate_limit::account_only{};
+                return db::per_partition_rate_limit::account_only{.weight = weight};
             } else {
                 // The coordinator has decided to reject, abort the operation
                 slogger.trace("Per-partition rate limiting: coordinator rejected");
@@ -1469,8 +1665,13 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
 
     // Steps of the Paxos protocol
     future<ballot_and_data> begin_and_repair_paxos(client_state& cs, unsigned& contentions, bool is_write);
+    // Skips the PREPARE step under the lease this coordinator holds on the key,
+    // see paxos_state::read_under_lease(). Returns nothing if the lease can't
+    // be used, in which case the round has to start with begin_and_repair_paxos().
+    future<std::optional<ballot_and_data>> begin_under_lease(paxos::paxos_state::lease lease);
     future<paxos::prepare_summary> prepare_ballot(utils::UUID ballot);
-    future<bool> accept_proposal(lw_shared_ptr<paxos::proposal> proposal, bool timeout_if_partially_accepted);
+    future<bool> accept_proposal(lw_shared_ptr<paxos::proposal> proposal, bool timeout_if_partially_accepted,
+            bool leased = false, std::optional<utils::UUID> next_ballot = std::nullopt);
     future<> learn_decision(lw_shared_ptr<paxos::proposal> proposal, bool allow_hints = false);
     void prune(utils::UUID ballot);
     uint64_t id() const {
@@ -1491,6 +1692,14 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
     // this is called with an id of a replica that replied to learn request
     // and returns true when quorum of such requests are accumulated
     bool learned(locator::host_id ep);
+    bool coordinator_is_participant() const {
+        const auto& topo = get_effective_replication_map()->get_topology();
+        return std::ranges::any_of(_live_endpoints, [&topo] (locator::host_id ep) { return topo.is_me(ep); });
+    }
+    // Whether a quorum of replicas has replied to the learn request so far.
+    bool learned_by_quorum() const {
+        return _learned == _required_participants;
+    }
 
     const locator::effective_replication_map_ptr& get_effective_replication_map() const noexcept {
         return _token_guard.get_erm();
@@ -1577,7 +1786,9 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     timer<storage_proxy::clock_type> _expire_timer;
     service_permit _permit; // holds admission permit until operation completes
     db::per_partition_rate_limit::info _rate_limit_info;
-    db::view::update_backlog _view_backlog; // max view update backlog of all participating targets
+    // Max view update backlog of all participating targets, if the write
+    // generates view updates. Writes to tables without views aren't delayed.
+    db::view::update_backlog _view_backlog;
 
 protected:
     virtual bool waited_for(locator::host_id from) = 0;
@@ -1599,7 +1810,7 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
             , _effective_replication_map_ptr(std::move(erm))
             , _trace_state(trace_state), _cl(cl), _type(type), _mutation_holder(std::move(mh)), _targets(std::move(targets)),
               _dead_endpoints(std::move(dead_endpoints)), _stats(stats), _expire_timer([this] { timeout_cb(); }), _permit(std::move(permit)),
-              _rate_limit_info(rate_limit_info), _view_backlog(max_backlog()) {
+              _rate_limit_info(rate_limit_info), _view_backlog(generates_view_updates() ? max_backlog() : db::view::update_backlog::no_backlog()) {
         // original comment from cassandra:
         // during bootstrap, include pending endpoints in the count
         // or we may fail the consistency level guarantees (see #833, #8058)
@@ -1779,6 +1990,11 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
         on_timeout();
         _proxy->remove_response_handler(_id);
     }
+    bool generates_view_updates() {
+        const auto& s = _mutation_holder->schema();
+        auto* t = s ? s->maybe_table() : nullptr;
+        return t && !t->views().empty();
+    }
     db::view::update_backlog max_backlog() {
         return std::ranges::fold_left(
                 get_targets() | std::views::transform([this] (locator::host_id ep) {
@@ -2151,6 +2367,7 @@ paxos_response_handler::begin_and_repair_paxos(client_state& cs, unsigned& conte
         if (missing_mrc.size() > 0) {
             paxos::paxos_state::logger.debug("CAS[{}] Repairing replicas that missed the most recent commit", _id);
             tracing::trace(tr_state, "Repairing replicas that missed the most recent commit");
+            ++_proxy->get_stats().cas_round_trips;
             std::array<std::tuple<lw_shared_ptr<paxos::proposal>, schema_ptr, shared_ptr<paxos_response_handler>, dht::token, host_id_vector_replica_set>, 1>
                 m{std::make_tuple(make_lw_shared<paxos::proposal>(std::move(*summary.most_recent_commit)), _schema, shared_from_this(), _key.token(), std::move(missing_mrc))};
             // create_write_response_handler is overloaded for paxos::proposal and will
@@ -2173,6 +2390,33 @@ paxos_response_handler::begin_and_repair_paxos(client_state& cs, unsigned& conte
     }
 }
 
+future<std::optional<paxos_response_handler::ballot_and_data>>
+paxos_response_handler::begin_under_lease(paxos::paxos_state::lease lease) {
+    auto _ = shared_from_this(); // hold the handler until co-routine ends
+
+    // The current value is read from the local replica, so the lease can
+    // only be used by a coordinator which takes part in the round.
+    if (!coordinator_is_participant()) {
+        co_return std::nullopt;
+    }
+
+    std::optional<foreign_ptr<lw_shared_ptr<query::result>>> data;
+    try {
+        data = co_await paxos::paxos_state::read_under_lease(*_proxy, _proxy->remote().paxos_store(), tr_state, _schema, *_cmd, _key.key(), lease, _timeout);
+    } catch (...) {
+        paxos::paxos_state::logger.debug("CAS[{}] Failed to read under lease {}: {}. Ignored.", _id, lease.ballot, std::current_exception());
+    }
+    if (!data) {
+        co_return std::nullopt;
+    }
+
+    // The replicas which accepted the previous decision promised the leased
+    // ballot along with it, so it can be proposed right away.
+    paxos::paxos_state::logger.debug("CAS[{}] Proposing {} under lease", _id, lease.ballot);
+    tracing::trace(tr_state, "Proposing {} under lease", lease.ballot);
+    co_return ballot_and_data{lease.ballot, std::move(*data)};
+}
+
 template<class T> struct dependent_false : std::false_type {};
 
 void paxos_response_handler::append_peer_error(sstring& target, locator::host_id peer, std::exception_ptr error) {
@@ -2185,6 +2429,7 @@ void paxos_response_handler::append_peer_error(sstring& target, locator::host_id
 // This function implement prepare stage of Paxos protocol and collects metadata needed to repair
 // previously unfinished round (if there was one).
 future<paxos::prepare_summary> paxos_response_handler::prepare_ballot(utils::UUID ballot) {
+    ++_proxy->get_stats().cas_round_trips;
     struct {
         size_t errors = 0;
         sstring errors_message;
@@ -2342,7 +2587,9 @@ future<paxos::prepare_summary> paxos_response_handler::prepare_ballot(utils::UUI
 }
 
 // This function implements accept stage of the Paxos protocol.
-future<bool> paxos_response_handler::accept_proposal(lw_shared_ptr<paxos::proposal> proposal, bool timeout_if_partially_accepted) {
+future<bool> paxos_response_handler::accept_proposal(lw_shared_ptr<paxos::proposal> proposal, bool timeout_if_partially_accepted,
+        bool leased, std::optional<utils::UUID> next_ballot) {
+    ++_proxy->get_stats().cas_round_trips;
     struct {
         // the promise can be set before all replies are received at which point
         // the optional will be disengaged so further replies are ignored
@@ -2374,10 +2621,10 @@ future<bool> paxos_response_handler::accept_proposal(lw_shared_ptr<paxos::propos
     auto f = request_tracker.p->get_future();
 
     // We may continue collecting propose responses in the background after the reply is ready
-    (void)do_with(std::move(request_tracker), shared_from_this(), [this, timeout_if_partially_accepted, proposal = std::move(proposal)]
+    (void)do_with(std::move(request_tracker), shared_from_this(), [this, timeout_if_partially_accepted, leased, next_ballot, proposal = std::move(proposal)]
                            (auto& request_tracker, shared_ptr<paxos_response_handler>& prh) -> future<> {
         paxos::paxos_state::logger.trace("CAS[{}] accept_proposal: sending commit {} to {}", _id, *proposal, _live_endpoints);
-        auto handle_one_msg = [this, &request_tracker, timeout_if_partially_accepted, proposal = std::move(proposal)] (locator::host_id peer) mutable -> future<> {
+        auto handle_one_msg = [this, &request_tracker, timeout_if_partially_accepted, leased, next_ballot, proposal = std::move(proposal)] (locator::host_id peer) mutable -> future<> {
             bool is_timeout = false;
             std::optional<bool> accepted;
             const auto& topo = get_effective_replication_map()->get_topology();
@@ -2385,9 +2632,9 @@ future<bool> paxos_response_handler::accept_proposal(lw_shared_ptr<paxos::propos
             try {
                 if (topo.is_me(peer)) {
                     tracing::trace(tr_state, "accept_proposal: accept {} locally", *proposal);
-                    accepted = co_await paxos::paxos_state::accept(*_proxy, _proxy->remote().paxos_store(), tr_state, _schema, proposal->update.decorated_key(*_schema).token(), *proposal, _timeout);
+                    accepted = co_await paxos::paxos_state::accept(*_proxy, _proxy->remote().paxos_store(), tr_state, _schema, proposal->update.decorated_key(*_schema).token(), *proposal, _timeout, leased, next_ballot);
                 } else {
-                    accepted = co_await _proxy->remote().send_paxos_accept(peer, _timeout, tr_state, *proposal);
+                    accepted = co_await _proxy->remote().send_paxos_accept(peer, _timeout, tr_state, *proposal, leased, next_ballot);
                 }
             } catch(...) {
                 if (request_tracker.p) {
@@ -2481,7 +2728,31 @@ future<bool> paxos_response_handler::accept_proposal(lw_shared_ptr<paxos::propos
                 }
             } // wait for more replies
         };
-        co_return co_await coroutine::parallel_for_each(_live_endpoints, handle_one_msg);
+        if (!leased) {
+            co_return co_await coroutine::parallel_for_each(_live_endpoints, handle_one_msg);
+        }
+        // A leased proposal is accepted by the remote replicas first. When
+        // they all reject it, which is what another round started since the
+        // previous decision usually results in, nobody has accepted it, so
+        // the coordinator can fall back to a full round instead of timing
+        // out. The lease was just checked on the local replica, which
+        // accepts it only once a quorum is reachable.
+        const auto& topo = get_effective_replication_map()->get_topology();
+        auto local = std::ranges::find_if(_live_endpoints, [&topo] (locator::host_id ep) { return topo.is_me(ep); });
+        auto remote = _live_endpoints | std::views::filter([&topo] (locator::host_id ep) { return !topo.is_me(ep); })
+                | std::ranges::to<host_id_vector_replica_set>();
+        co_await coroutine::parallel_for_each(remote, [&handle_one_msg] (locator::host_id peer) { return handle_one_msg(peer); });
+        if (local == _live_endpoints.end()) {
+            co_return;
+        }
+        if (request_tracker.p && request_tracker.accepts == 0 && request_tracker.errors == 0
+                && _required_participants > 1 && request_tracker.rejects + 1 == _live_endpoints.size()) {
+            tracing::trace(tr_state, "accept_proposal: leased proposal is rejected by all remote replicas");
+            paxos::paxos_state::logger.trace("CAS[{}] accept_proposal: leased proposal is rejected by all remote replicas", _id);
+            request_tracker.set_value(false);
+            co_return;
+        }
+        co_await handle_one_msg(*local);
     }); // do_with
 
     return f;
@@ -2503,6 +2774,7 @@ namespace service {
 future<> paxos_response_handler::learn_decision(lw_shared_ptr<paxos::proposal> decision, bool allow_hints) {
     tracing::trace(tr_state, "learn_decision: committing {} with cl={}", *decision, _cl_for_learn);
     paxos::paxos_state::logger.trace("CAS[{}] learn_decision: committing {} with cl={}", _id, *decision, _cl_for_learn);
+    ++_proxy->get_stats().cas_round_trips;
     // FIXME: allow_hints is ignored. Consider if we should follow it and remove if not.
     // Right now we do not store hints for when committing decisions.
 
@@ -2608,6 +2880,10 @@ query::tombstone_limit storage_proxy::get_tombstone_limit() const {
     return query::tombstone_limit::max;
 }
 
+std::chrono::milliseconds storage_proxy::get_adaptive_paging_latency_budget() const {
+    return std::chrono::milliseconds(_db.local().get_config().adaptive_paging_latency_budget_in_ms());
+}
+
 bool storage_proxy::need_throttle_writes() const {
     return get_global_stats().background_write_bytes > _background_write_throttle_threahsold || get_global_stats().queued_write_bytes > 6*1024*1024;
 }
@@ -2660,6 +2936,7 @@ void storage_proxy::got_response(storage_proxy::response_id_type id, locator::ho
     auto it = _response_handlers.find(id);
     if (it != _response_handlers.end()) {
         tracing::trace(it->second->get_trace_state(), "Got a response from /{}", from);
+        _replica_liveness.response_received(from);
         if (it->second->response(from)) {
             remove_response_handler_entry(std::move(it)); // last one, remove entry. Will cancel expiration timer too.
         } else {
@@ -2673,6 +2950,7 @@ void storage_proxy::got_failure_response(storage_proxy::response_id_type id, loc
     auto it = _response_handlers.find(id);
     if (it != _response_handlers.end()) {
         tracing::trace(it->second->get_trace_state(), "Got {} failures from /{}", count, from);
+        _replica_liveness.response_received(from);
         if (it->second->failure_response(from, count, err, std::move(msg))) {
             remove_response_handler_entry(std::move(it));
         } else {
@@ -2889,6 +3167,38 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of read retry attempts"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("slow_replicas_avoided", slow_replicas_avoided,
+                       sm::description("number of reads which replaced a replica with a much higher latency estimate by the one kept for speculative retry"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("suspected_replicas_avoided", suspected_replicas_avoided,
+                       sm::description("number of reads which replaced a replica suspected to be dead (see read_replica_phi_suspicion_threshold) by another replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("mutation_batches_sent", mutation_batches_sent,
+                       sm::description("number of coalesced write messages sent to replicas"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("coalesced_mutations_sent", coalesced_mutations_sent,
+                       sm::description("number of mutations sent to replicas inside coalesced write messages"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("hint_mutation_batches_sent", hint_mutation_batches_sent,
+                       sm::description("number of coalesced hint messages sent to replicas"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("coalesced_hints_sent", coalesced_hints_sent,
+                       sm::description("number of hints sent to replicas inside coalesced hint messages"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("multi_partition_digest_reads", multi_partition_digest_reads,
+                       sm::description("number of digest requests for several partitions of a multi-partition query sent to replicas in a single message"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("multi_partition_digest_read_partitions", multi_partition_digest_read_partitions,
+                       sm::description("number of partitions read by multi-partition digest requests"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("canceled_read_repairs", global_read_repairs_canceled_due_to_concurrent_write,
                        sm::description("number of global read repairs canceled due to a concurrent write"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2981,6 +3291,18 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("CAS read rounds issued only if previous value is missing on some replica"),
                        {storage_proxy_stats::current_scheduling_group_label(), basic_level, cas_label}).set_skip_when_empty(),
 
+        sm::make_total_operations("cas_round_trips", cas_round_trips,
+                       sm::description("number of replica round trips CAS operations waited for; divided by cas_total_operations, the average number of round trips per operation"),
+                       {storage_proxy_stats::current_scheduling_group_label(), basic_level, cas_label}).set_skip_when_empty(),
+
+        sm::make_total_operations("cas_leased_accepts", cas_leased_accepts,
+                       sm::description("number of CAS proposals accepted without a prepare round, under the lease of the previous decision on the key"),
+                       {storage_proxy_stats::current_scheduling_group_label(), basic_level, cas_label}).set_skip_when_empty(),
+
+        sm::make_total_operations("cas_lease_lost", cas_lease_lost,
+                       sm::description("number of CAS operations which fell back to a full paxos round because another round was started on the key since its previous decision"),
+                       {storage_proxy_stats::current_scheduling_group_label(), basic_level, cas_label}).set_skip_when_empty(),
+
         sm::make_histogram("cas_read_contention", sm::description("how many contended reads were encountered"),
                        {storage_proxy_stats::current_scheduling_group_label(), basic_level, cas_label},
                        [this]{ return cas_read_contention.get_histogram(1, 8);}).set_skip_when_empty(),
@@ -3015,6 +3337,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of counter updates received by this node acting as an update leader"),
                        {storage_proxy_stats::current_scheduling_group_label(), basic_level}).set_skip_when_empty(),
 
+        sm::make_total_operations("coalesced_counter_updates", coalesced_counter_updates,
+                       sm::description("number of counter updates merged by this node acting as an update leader into a concurrent update of the same partition"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("received_mutations", received_mutations,
                        sm::description("number of mutations received by a replica Node"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -3027,6 +3353,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of errors during forwarding mutations to other replica Nodes"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("received_mutation_batches", received_mutation_batches,
+                       sm::description("number of coalesced write messages received by a replica Node"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("received_hint_mutation_batches", received_hint_mutation_batches,
+                       sm::description("number of coalesced hint messages received by a replica Node"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("reads", replica_data_reads,
                        sm::description("number of remote reads this Node received. op_type label could be data, mutation_data or digest"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("data")}).set_skip_when_empty(),
@@ -3043,6 +3377,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("cross_shard_write_batches", replica_cross_shard_write_batches,
+                       sm::description("number of cross-shard messages carrying coalesced writes to another shard"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("cas_dropped_prune", cas_replica_dropped_prune,
                        sm::description("how many times a coordinator did not perform prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -3184,6 +3522,7 @@ storage_proxy::storage_proxy(distributed<replica::database>& db, storage_proxy::
     , _max_view_update_backlog(max_view_update_backlog)
     , _cancellable_write_handlers_list(std::make_unique<cancellable_write_handlers_list>())
     , _pending_writes_phaser("storage_proxy::pending_writes")
+    , _local_write_batch_gate("storage_proxy::local_write_batch_gate")
 {
     namespace sm = seastar::metrics;
     _metrics.add_group(storage_proxy_stats::COORDINATOR_STATS_CATEGORY, {
@@ -3316,6 +3655,104 @@ storage_proxy::mutate_locally(const schema_ptr& s, const frozen_mutation& m, tra
     return apply_on_shards(erm, *s, m.token(*s), std::move(apply));
 }
 
+future<>
+storage_proxy::apply_on_shard_coalesced(shard_id shard, const schema_ptr& s, const frozen_mutation& m, tracing::trace_state_ptr tr_state,
+        db::commitlog::force_sync sync, clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info,
+        locator::effective_replication_map_ptr erm) {
+    auto key = local_write_batch_key{shard, current_scheduling_group()};
+    auto it = _local_write_batches.find(key);
+    if (it == _local_write_batches.end()) {
+        it = _local_write_batches.emplace(key, make_lw_shared<local_write_batch>()).first;
+        // Flush once the tasks which are already queued had a chance to add
+        // their writes, e.g. the remaining mutations of the same batch.
+        // The gate is closed only after stop() flushes all batches.
+        (void)with_gate(_local_write_batch_gate, [this, key] {
+            return yield().then([this, key] {
+                flush_local_write_batch(key);
+            });
+        });
+    }
+    auto& b = *it->second;
+    b.timeout = std::max(b.timeout, timeout);
+    b.writes.push_back(local_write{s, &m, std::move(tr_state), sync, timeout, rate_limit_info, std::move(erm), promise<>()});
+    return b.writes.back().done.get_future();
+}
+
+void storage_proxy::flush_local_write_batch(local_write_batch_key key) {
+    auto node = _local_write_batches.extract(key);
+    if (node.empty()) {
+        return;
+    }
+    auto b = std::move(node.mapped());
+    // Flushes happen either under the gate, or in stop() before it closes it,
+    // which then waits for the batch to be applied.
+    auto gh = _local_write_batch_gate.hold();
+    ++get_stats().replica_cross_shard_write_batches;
+    struct foreign_write {
+        global_schema_ptr s;
+        const frozen_mutation* m;
+        tracing::global_trace_state_ptr tr_state;
+        db::commitlog::force_sync sync;
+        clock_type::time_point timeout;
+        db::per_partition_rate_limit::info rate_limit_info;
+    };
+    std::vector<foreign_write> writes;
+    writes.reserve(b->writes.size());
+    for (auto& w : b->writes) {
+        writes.push_back(foreign_write{global_schema_ptr(w.s), w.m, tracing::global_trace_state_ptr(w.tr_state), w.sync, w.timeout, w.rate_limit_info});
+    }
+    // The writes are applied concurrently on the target shard, and each one
+    // reports its own outcome.
+    (void)_db.invoke_on(key.shard, {_write_smp_service_group, b->timeout}, [writes = std::move(writes)] (replica::database& db) mutable -> future<std::vector<std::exception_ptr>> {
+        std::vector<std::exception_ptr> errors(writes.size());
+        co_await coroutine::parallel_for_each(std::views::iota(size_t(0), writes.size()), [&] (size_t i) -> future<> {
+            auto& w = writes[i];
+            try {
+                co_await db.apply(w.s, *w.m, w.tr_state.get(), w.sync, w.timeout, w.rate_limit_info);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+        co_return errors;
+    }).then_wrapped([b, gh = std::move(gh)] (future<std::vector<std::exception_ptr>> f) {
+        if (f.failed()) {
+            auto ex = f.get_exception();
+            for (auto& w : b->writes) {
+                w.done.set_exception(ex);
+            }
+            return;
+        }
+        auto errors = f.get();
+        for (size_t i = 0; i < b->writes.size(); ++i) {
+            if (errors[i]) {
+                b->writes[i].done.set_exception(std::move(errors[i]));
+            } else {
+                b->writes[i].done.set_value();
+            }
+        }
+    });
+}
+
+future<>
+storage_proxy::mutate_locally_coalesced(const schema_ptr& s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync,
+        clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
+    auto erm = _db.local().find_column_family(s).get_effective_replication_map();
+    auto apply = [this, erm, s, &m, tr_state, sync, timeout, rate_limit_info] (shard_id shard) -> future<> {
+        if (shard == this_shard_id()) {
+            return _db.local().apply(s, m, tr_state, sync, timeout, adjust_rate_limit_for_local_operation(rate_limit_info));
+        }
+        ++get_stats().replica_cross_shard_ops;
+        if (!_local_write_batch_gate.is_closed()) {
+            return apply_on_shard_coalesced(shard, s, m, tr_state, sync, timeout, rate_limit_info, erm);
+        }
+        return _db.invoke_on(shard, {_write_smp_service_group, timeout},
+                [&m, erm, gs = global_schema_ptr(s), gtr = tracing::global_trace_state_ptr(tr_state), timeout, sync, rate_limit_info] (replica::database& db) mutable -> future<> {
+            return db.apply(gs, m, gtr.get(), sync, timeout, rate_limit_info);
+        });
+    };
+    return apply_on_shards(erm, *s, m.token(*s), std::move(apply));
+}
+
 future<>
 storage_proxy::mutate_locally(utils::chunked_vector<mutation> mutations, tracing::trace_state_ptr tr_state, clock_type::time_point timeout, smp_service_group smp_grp, db::per_partition_rate_limit::info rate_limit_info) {
     co_await coroutine::parallel_for_each(mutations, [&] (const mutation& m) mutable {
@@ -3324,8 +3761,15 @@ storage_proxy::mutate_locally(utils::chunked_vector<mutation> mutations, tracing
 }
 
 future<>
-storage_proxy::mutate_locally(utils::chunked_vector<mutation> mutation, tracing::trace_state_ptr tr_state, clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
-        return mutate_locally(std::move(mutation), tr_state, timeout, _write_smp_service_group, rate_limit_info);
+storage_proxy::mutate_locally(utils::chunked_vector<mutation> mutations, tracing::trace_state_ptr tr_state, clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
+    // Freeze the mutations up front, so that they outlive the writes, which
+    // can then be coalesced per shard.
+    utils::chunked_vector<frozen_mutation_and_schema> frozen;
+    frozen.reserve(mutations.size());
+    for (const auto& m : mutations) {
+        frozen.push_back(frozen_mutation_and_schema{freeze(m), m.schema()});
+    }
+    co_await mutate_locally(std::move(frozen), std::move(tr_state), db::commitlog::force_sync::no, timeout, rate_limit_info);
 }
 
 future<>
@@ -3417,12 +3861,92 @@ storage_proxy::mutate_counter_on_leader_and_replicate(const schema_ptr& s, froze
     return _db.invoke_on(shard, {_write_smp_service_group, timeout}, [&proxy = container(), gs = global_schema_ptr(s), fm = std::move(fm), cl, timeout, gt = tracing::global_trace_state_ptr(std::move(trace_state)), permit = std::move(permit), local] (replica::database& db) {
         auto trace_state = gt.get();
         auto p = local ? std::move(permit) : /* FIXME: either obtain a real permit on this shard or hold original one across shard */ empty_service_permit();
-        return db.apply_counter_update(gs, fm, timeout, trace_state).then([&proxy, cl, timeout, trace_state, p = std::move(p)] (mutation m) mutable {
-            return proxy.local().replicate_counter_from_leader(std::move(m), cl, std::move(trace_state), timeout, std::move(p));
-        });
+        return proxy.local().apply_and_replicate_counter_update_coalesced(gs, fm, cl, timeout, std::move(trace_state), std::move(p));
     });
 }
 
+// Updates of a hot counter are serialized by the counter cell locks, and each
+// of them pays for a read before write and a commitlog write. Instead of
+// queueing on the locks, the updates which arrive while another update of the
+// partition is applied are merged, the deltas of the same cells summed, and
+// applied and replicated as a single update once the running one is done.
+static constexpr size_t max_coalesced_counter_updates = 128;
+
+future<>
+storage_proxy::apply_and_replicate_counter_update_coalesced(schema_ptr s, const frozen_mutation& fm, db::consistency_level cl,
+        clock_type::time_point timeout, tracing::trace_state_ptr trace_state, service_permit permit) {
+    auto key = counter_update_key{s->version(), to_bytes(fm.key().representation()), cl};
+    auto it = _counter_updates.find(key);
+    if (it == _counter_updates.end()) {
+        auto st = make_lw_shared<counter_update_state>();
+        st->running.emplace();
+        _counter_updates.emplace(key, st);
+        co_return co_await apply_and_replicate_counter_update(std::move(key), std::move(st), std::move(s), fm, cl, timeout,
+                std::move(trace_state), std::move(permit));
+    }
+    auto st = it->second;
+    auto update = fm.unfreeze(s);
+    // Deletes can't be merged with updates.
+    if (!has_only_live_counter_cells(update)) {
+        auto m = co_await _db.local().apply_counter_update(s, fm, timeout, trace_state);
+        co_return co_await replicate_counter_from_leader(std::move(m), cl, std::move(trace_state), timeout, std::move(permit));
+    }
+    if (auto batch = st->pending) {
+        // Don't make the update time out earlier than it would on its own.
+        if (batch->updates < max_coalesced_counter_updates && batch->timeout >= timeout) {
+            batch->update.apply(std::move(update));
+            ++batch->updates;
+            ++get_stats().coalesced_counter_updates;
+            tracing::trace(trace_state, "Coalesced counter update with {} concurrent updates", batch->updates - 1);
+            co_return co_await batch->done.get_shared_future(timeout);
+        }
+        auto m = co_await _db.local().apply_counter_update(s, fm, timeout, trace_state);
+        co_return co_await replicate_counter_from_leader(std::move(m), cl, std::move(trace_state), timeout, std::move(permit));
+    }
+
+    auto batch = make_lw_shared<counter_update_batch>(std::move(update), timeout, trace_state, std::move(permit));
+    st->pending = batch;
+    while (st->running) {
+        co_await st->running->get_shared_future();
+    }
+    st->pending = nullptr;
+    // Updates can't join the batch anymore.
+    std::optional<frozen_mutation> merged;
+    try {
+        merged.emplace(freeze(batch->update));
+    } catch (...) {
+        auto ex = std::current_exception();
+        _counter_updates.erase(key);
+        batch->done.set_exception(ex);
+        co_return coroutine::exception(std::move(ex));
+    }
+    // Only once the batch is frozen, so a failure to freeze it leaves no update waiting forever.
+    st->running.emplace();
+    auto f = co_await coroutine::as_future(apply_and_replicate_counter_update(std::move(key), std::move(st), std::move(s), *merged, cl,
+            batch->timeout, batch->tr_state, std::move(batch->permit)));
+    if (f.failed()) {
+        auto ex = f.get_exception();
+        batch->done.set_exception(ex);
+        co_return coroutine::exception(std::move(ex));
+    }
+    batch->done.set_value();
+}
+
+future<>
+storage_proxy::apply_and_replicate_counter_update(counter_update_key key, lw_shared_ptr<counter_update_state> st, schema_ptr s,
+        const frozen_mutation& fm, db::consistency_level cl, clock_type::time_point timeout, tracing::trace_state_ptr trace_state,
+        service_permit permit) {
+    auto f = co_await coroutine::as_future(_db.local().apply_counter_update(s, fm, timeout, trace_state));
+    // Let the next batch of updates of the partition be applied while this
+    // one is replicated.
+    std::exchange(st->running, std::nullopt)->set_value();
+    if (!st->pending) {
+        _counter_updates.erase(key);
+    }
+    auto m = co_await std::move(f);
+    co_await replicate_counter_from_leader(std::move(m), cl, std::move(trace_state), timeout, std::move(permit));
+}
+
 result<storage_proxy::response_id_type>
 storage_proxy::create_write_response_handler_helper(schema_ptr s, const dht::token& token, std::unique_ptr<mutation_holder> mh,
         db::consistency_level cl, db::write_type type, tracing::trace_state_ptr tr_state, service_permit permit, db::allow_per_partition_rate_limit allow_limit, is_cancellable cancellable, coordinator_mutate_options options) {
@@ -3493,7 +4017,8 @@ storage_proxy::create_write_response_handler_helper(schema_ptr s, const dht::tok
 
     db::per_partition_rate_limit::info rate_limit_info;
     if (allow_limit && _db.local().can_apply_per_partition_rate_limit(*s, db::operation_type::write)) {
-        auto r_rate_limit_info = choose_rate_limit_info(erm, _db.local(), coordinator_in_replica_set, db::operation_type::write, s, token, tr_state);
+        auto r_rate_limit_info = choose_rate_limit_info(erm, _db.local(), coordinator_in_replica_set, db::operation_type::write, s, token,
+                rate_limit_weight(_db.local(), all.size(), live_endpoints.size()), tr_state);
         if (!r_rate_limit_info) {
             return std::move(r_rate_limit_info).as_failure();
         }
@@ -4102,6 +4627,9 @@ storage_proxy::mutate_atomically_result(utils::chunked_vector<mutation> mutation
         coordinator_mutate_options _options;
 
         const utils::UUID _batch_uuid;
+        // The batchlog entry is written only to the local commitlog and memtable,
+        // and replayed by this node if the batch fails half way.
+        const bool _local_durable;
         const host_id_vector_replica_set _batchlog_endpoints;
 
     public:
@@ -4118,9 +4646,13 @@ storage_proxy::mutate_atomically_result(utils::chunked_vector<mutation> mutation
                 , _permit(std::move(permit))
                 , _options(std::move(options))
                 , _batch_uuid(utils::UUID_gen::get_time_UUID())
+                , _local_durable(_p._db.local().get_config().batchlog_local_durable_writes())
                 , _batchlog_endpoints(
                         [this]() -> host_id_vector_replica_set {
                             auto local_addr = _p.my_host_id(*_ermp);
+                            if (_local_durable) {
+                                return {local_addr};
+                            }
                             auto& topology = _ermp->get_topology();
                             auto local_dc = topology.get_datacenter();
                             std::unordered_map<sstring, std::unordered_set<locator::host_id>> local_token_owners;
@@ -4156,6 +4688,10 @@ storage_proxy::mutate_atomically_result(utils::chunked_vector<mutation> mutation
         }
         future<result<>> sync_write_to_batchlog() {
             auto m = _p.do_get_batchlog_mutation_for(_schema, _mutations, _batch_uuid, netw::messaging_service::current_version, db_clock::now());
+            if (_local_durable) {
+                tracing::trace(_trace_state, "Writing a batchlog mutation locally");
+                return utils::then_ok_result<result<>>(_p.mutate_locally(m, _trace_state, db::commitlog::force_sync::yes, _timeout));
+            }
             tracing::trace(_trace_state, "Sending a batchlog write mutation");
             return send_batchlog_mutation(std::move(m));
         };
@@ -4167,6 +4703,13 @@ storage_proxy::mutate_atomically_result(utils::chunked_vector<mutation> mutation
             mutation m(_schema, key);
             m.partition().apply_delete(*_schema, clustering_key_prefix::make_empty(), tombstone(now, gc_clock::now()));
 
+            if (_local_durable) {
+                // The entry is replayed if the tombstone is lost, so it doesn't have to be synced.
+                tracing::trace(_trace_state, "Removing the batchlog mutation locally");
+                return _p.mutate_locally(m, _trace_state, db::commitlog::force_sync::no, _timeout).handle_exception([] (std::exception_ptr ex) {
+                    slogger.error("Failed to remove mutations from batchlog: {}", ex);
+                });
+            }
             tracing::trace(_trace_state, "Sending a batchlog remove mutation");
             return send_batchlog_mutation(std::move(m), db::consistency_level::ANY).then_wrapped([] (future<result<>> f) {
                 auto print_exception = [] (const auto& ex) {
@@ -4472,6 +5015,11 @@ void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type respo
             if (coordinator == my_address) {
                 f = futurize_invoke(lmutate);
             } else {
+                // The forwarded-to replicas respond directly to us as well
+                _replica_liveness.request_sent(coordinator);
+                for (auto& ep : forward) {
+                    _replica_liveness.request_sent(ep);
+                }
                 f = futurize_invoke(rmutate, coordinator, forward);
             }
         }
@@ -5255,6 +5803,96 @@ class data_read_resolver : public abstract_read_resolver {
     }
 };
 
+// Gathers the digest requests which the read executors of a multi-partition
+// singular query send to remote replicas when they start, so that each replica
+// receives all of them in a single READ_DIGEST_MULTI message.
+//
+// The executors share the read command, the replication map and the timeout,
+// so those are taken from the query. Requests made after flush(), e.g.
+// speculative retries, are sent directly by the executors.
+class digest_request_batcher {
+public:
+    using digest_reply = rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>;
+private:
+    struct request {
+        dht::partition_range range;
+        db::per_partition_rate_limit::info rate_limit_info;
+        promise<digest_reply> reply;
+    };
+    std::unordered_map<locator::host_id, std::vector<request>> _requests;
+    bool _flushed = false;
+private:
+    static future<> send_one(storage_proxy& proxy, locator::host_id ep, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const query::read_command& cmd, fencing_token fence, request& req) {
+        return proxy.remote().send_read_digest(ep, timeout, std::move(tr_state), cmd, req.range, digest_algorithm(proxy), req.rate_limit_info, fence)
+                .then_wrapped([&req] (future<digest_reply> f) {
+            if (f.failed()) {
+                req.reply.set_exception(f.get_exception());
+            } else {
+                req.reply.set_value(f.get());
+            }
+        });
+    }
+    static future<> send_many(storage_proxy& proxy, locator::host_id ep, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const query::read_command& cmd, fencing_token fence, std::vector<request>& reqs) {
+        auto partitions = reqs | std::views::transform([] (const request& req) {
+            return partition_digest_request{::compat::wrapping_partition_range(req.range), req.rate_limit_info};
+        }) | std::ranges::to<std::vector>();
+        auto f = co_await coroutine::as_future(proxy.remote().send_read_digest_multi(ep, timeout, std::move(tr_state), cmd, std::move(partitions),
+                digest_algorithm(proxy), fence));
+        if (f.failed()) {
+            auto ex = f.get_exception();
+            for (auto& req : reqs) {
+                req.reply.set_exception(ex);
+            }
+            co_return;
+        }
+        auto digests = f.get();
+        if (digests.size() != reqs.size()) {
+            auto ex = std::make_exception_ptr(std::runtime_error(format("READ_DIGEST_MULTI to {} returned {} digests for {} partitions", ep, digests.size(), reqs.size())));
+            for (auto& req : reqs) {
+                req.reply.set_exception(ex);
+            }
+            co_return;
+        }
+        for (size_t i = 0; i < reqs.size(); ++i) {
+            auto& d = digests[i];
+            if (d.exception) {
+                reqs[i].reply.set_exception(d.exception.into_exception_ptr());
+            } else {
+                reqs[i].reply.set_value(digest_reply{d.digest, d.last_modified, d.hit_rate, std::move(d.last_position)});
+            }
+        }
+    }
+public:
+    bool accepts_requests() const noexcept {
+        return !_flushed;
+    }
+
+    future<digest_reply> add(locator::host_id ep, const dht::partition_range& pr, db::per_partition_rate_limit::info rate_limit_info) {
+        auto& reqs = _requests[ep];
+        reqs.push_back(request{pr, rate_limit_info, {}});
+        return reqs.back().reply.get_future();
+    }
+
+    // Sends out the gathered requests. The batcher has to be kept alive until
+    // the returned future resolves.
+    future<> flush(storage_proxy& proxy, const locator::effective_replication_map& erm, storage_proxy::clock_type::time_point timeout,
+            tracing::trace_state_ptr tr_state, lw_shared_ptr<query::read_command> cmd) {
+        _flushed = true;
+        auto fence = storage_proxy::get_fence(erm);
+        co_await coroutine::parallel_for_each(_requests, [&] (auto& ep_and_requests) {
+            auto& [ep, reqs] = ep_and_requests;
+            if (reqs.size() == 1) {
+                return send_one(proxy, ep, timeout, tr_state, *cmd, fence, reqs.front());
+            }
+            ++proxy.get_stats().multi_partition_digest_reads;
+            proxy.get_stats().multi_partition_digest_read_partitions += reqs.size();
+            return send_many(proxy, ep, timeout, tr_state, *cmd, fence, reqs);
+        });
+    }
+};
+
 class abstract_read_executor : public enable_shared_from_this<abstract_read_executor> {
 protected:
     using targets_iterator = host_id_vector_replica_set::iterator;
@@ -5282,6 +5920,8 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     bool _foreground = true;
     service_permit _permit; // holds admission permit until operation completes
     db::per_partition_rate_limit::info _rate_limit_info;
+    // Set when the executor is one of several of a multi-partition query.
+    lw_shared_ptr<digest_request_batcher> _digest_batcher;
 
 private:
     const bool _native_reversed_queries_enabled;
@@ -5314,6 +5954,10 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         _proxy->get_stats().foreground_reads -= int(_foreground);
     }
 
+    void set_digest_batcher(lw_shared_ptr<digest_request_batcher> batcher) {
+        _digest_batcher = std::move(batcher);
+    }
+
     /// Targets that were successfully ised for data and/or digest requests.
     ///
     /// Only filled after the request is finished, call only after
@@ -5368,6 +6012,10 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             return _proxy->apply_fence(_proxy->query_result_local_digest(_effective_replication_map_ptr, _schema, _cmd, _partition_range, _trace_state,
                         timeout, digest_algorithm(*_proxy), adjust_rate_limit_for_local_operation(_rate_limit_info)), fence, _proxy->my_address());
         } else {
+            if (_digest_batcher && _digest_batcher->accepts_requests()) {
+                tracing::trace(_trace_state, "read_digest: batching the request to /{}", ep);
+                return _digest_batcher->add(ep, _partition_range, _rate_limit_info);
+            }
             tracing::trace(_trace_state, "read_digest: sending a message to /{}", ep);
             const bool format_reverse_required = _cmd->slice.is_reversed() && !_native_reversed_queries_enabled;
             auto cmd = format_reverse_required ? reversed(::make_lw_shared(*_cmd)) : _cmd;
@@ -5377,6 +6025,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_mutation_data_requests(lw_shared_ptr<query::read_command> cmd, data_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const locator::host_id& ep : std::ranges::subrange(begin, end)) {
+            _proxy->_replica_liveness.request_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_mutation_data_request(cmd, ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> f) {
                 std::exception_ptr ex;
@@ -5387,6 +6036,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_mutate_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().mutation_data_read_completed.get_ep_stat(get_topology(), ep);
                     register_request_latency(latency_clock::now() - start);
+                    _proxy->_replica_liveness.response_received(ep);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -5403,6 +6053,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_data_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout, bool want_digest) {
         auto start = latency_clock::now();
         for (const locator::host_id& ep : std::ranges::subrange(begin, end)) {
+            _proxy->_replica_liveness.request_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
                 std::exception_ptr ex;
@@ -5413,7 +6064,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -5430,6 +6081,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void make_digest_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const locator::host_id& ep : std::ranges::subrange(begin, end)) {
+            _proxy->_replica_liveness.request_sent(ep);
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
                 std::exception_ptr ex;
@@ -5440,7 +6092,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v), std::get<3>(std::move(v)));
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -5715,6 +6367,14 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         _max_request_latency = std::max(_max_request_latency, d);
     }
 
+    // Also feeds the latency of a data or digest request to the per-replica estimates,
+    // and its response to the replica failure detector.
+    void register_request_latency(locator::host_id ep, latency_clock::duration d) {
+        register_request_latency(d);
+        _proxy->_replica_latencies.add(ep, std::chrono::duration_cast<std::chrono::microseconds>(d));
+        _proxy->_replica_liveness.response_received(ep);
+    }
+
     static constexpr latency_clock::duration NO_LATENCY{-1};
     latency_clock::duration _max_request_latency{NO_LATENCY};
 };
@@ -5780,9 +6440,27 @@ class speculating_read_executor : public abstract_read_executor {
             }
         });
         auto& sr = _schema->speculative_retry();
-        auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
+        storage_proxy::clock_type::duration t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
             std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
+        if (sr.get_type() == speculative_retry::type::PERCENTILE && _proxy->get_db().local().get_config().replica_latency_read_balancing()) {
+            // The table's percentile mixes all replicas, so a single slow one inflates it for reads
+            // which don't touch it. Use the percentile of the slowest of the replicas waited for
+            // instead, if known for all of them.
+            std::optional<std::chrono::microseconds> replicas_t = std::chrono::microseconds(0);
+            for (auto ep : std::ranges::subrange(_targets.begin(), _targets.end() - 1)) {
+                auto ep_t = _proxy->_replica_latencies.percentile(ep, sr.get_value());
+                if (!ep_t) {
+                    replicas_t.reset();
+                    break;
+                }
+                replicas_t = std::max(*replicas_t, *ep_t);
+            }
+            if (replicas_t && *replicas_t < t) {
+                tracing::trace(_trace_state, "Using replica latency percentile {}us for speculative retry", replicas_t->count());
+                t = std::chrono::duration_cast<storage_proxy::clock_type::duration>(*replicas_t);
+            }
+        }
         _speculate_timer.arm(t);
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
@@ -5838,6 +6516,12 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
             retry_type == speculative_retry::type::NONE ? nullptr : &extra_replica,
             _db.local().get_config().cache_hit_rate_read_balancing() ? &*cf : nullptr);
 
+    if (extra_replica && _db.local().get_config().replica_latency_read_balancing()) {
+        avoid_slow_replica(erm->get_topology(), target_replicas, *extra_replica);
+    }
+
+    avoid_suspected_replicas(*erm, all_replicas, target_replicas, extra_replica);
+
     slogger.trace("creating read executor for token {} with all: {} targets: {} rp decision: {}", token, all_replicas, target_replicas, repair_decision);
     tracing::trace(trace_state, "Creating read executor for token {} with all: {} targets: {} repair decision: {}", token, all_replicas, target_replicas, repair_decision);
 
@@ -5858,7 +6542,8 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
 
     db::per_partition_rate_limit::info rate_limit_info;
     if (cmd->allow_limit && _db.local().can_apply_per_partition_rate_limit(*schema, db::operation_type::read)) {
-        auto r_rate_limit_info = choose_rate_limit_info(erm, _db.local(), !is_read_non_local, db::operation_type::read, schema, token, trace_state);
+        auto r_rate_limit_info = choose_rate_limit_info(erm, _db.local(), !is_read_non_local, db::operation_type::read, schema, token,
+                rate_limit_weight(_db.local(), all_replicas.size(), target_replicas.size()), trace_state);
         if (!r_rate_limit_info) {
             slogger.debug("Read was rate limited");
             get_stats().read_rate_limited_by_coordinator.mark();
@@ -6056,9 +6741,23 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
                 }
                 co_return std::move(result);
             };
+            // Executors start their digest requests synchronously, so all of the initial
+            // ones are gathered by the time result_map_reduce() returns.
+            lw_shared_ptr<digest_request_batcher> digest_batcher;
+            if (features().multi_partition_digest_reads && (!cmd->slice.is_reversed() || features().native_reverse_queries)) {
+                digest_batcher = make_lw_shared<digest_request_batcher>();
+                for (auto& e : exec) {
+                    e.first->set_digest_batcher(digest_batcher);
+                }
+            }
             query::result_merger merger(cmd->get_row_limit(), cmd->partition_limit);
             merger.reserve(exec.size());
-            result = co_await utils::result_map_reduce(exec.begin(), exec.end(), std::move(mapper), std::move(merger));
+            auto f = utils::result_map_reduce(exec.begin(), exec.end(), std::move(mapper), std::move(merger));
+            if (digest_batcher) {
+                // Waited on indirectly, through the executors' replies. Keeps the batcher alive.
+                (void)digest_batcher->flush(*this, *erm, timeout, query_options.trace_state, cmd).finally([digest_batcher] {});
+            }
+            result = co_await std::move(f);
         }
     } catch(...) {
         handle_read_error(std::current_exception(), false);
@@ -6112,8 +6811,10 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         uint32_t remaining_partition_count,
         replicas_per_token_range preferred_replicas,
         service_permit permit,
-        node_local_only node_local_only) {
+        node_local_only node_local_only,
+        std::optional<clock_type::time_point> page_deadline) {
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
+    const auto row_limit = remaining_row_count;
     schema_ptr schema = local_schema_registry().get(cmd->schema_version);
     auto p = shared_from_this();
     auto& cf= _db.local().find_column_family(schema);
@@ -6287,8 +6988,19 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         result->ensure_counts();
         remaining_row_count -= result->row_count().value();
         remaining_partition_count -= result->partition_count().value();
+        // The results of the ranges after a short read would be dropped by
+        // the merger anyway.
+        bool page_done = result->is_short_read();
+        if (!page_done && page_deadline && remaining_row_count < row_limit && !ranges_to_vnodes.empty()
+                && (clock_type::now() >= *page_deadline || utils::get_local_injector().enter("storage_proxy_page_deadline_passed"))) {
+            // Out of the latency budget of the page. Cut it, the pager
+            // resumes from the last position of the result.
+            slogger.trace("range scan of {}.{} exceeded the page deadline", schema->ks_name(), schema->cf_name());
+            result->set_short_read(query::short_read::yes);
+            page_done = true;
+        }
         results.emplace_back(std::move(result));
-        if (ranges_to_vnodes.empty() || !remaining_row_count || !remaining_partition_count) {
+        if (page_done || ranges_to_vnodes.empty() || !remaining_row_count || !remaining_partition_count) {
             auto used_replicas = replicas_per_token_range();
             for (auto& e : exec) {
                 // We add used replicas in separate per-vnode entries even if
@@ -6354,7 +7066,8 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
             cmd->partition_limit,
             std::move(query_options.preferred_replicas),
             std::move(query_options.permit),
-            query_options.node_local_only);
+            query_options.node_local_only,
+            query_options.page_deadline);
 
     if (!wrapped_result) {
         co_return bo::failure(std::move(wrapped_result).assume_error());
@@ -6645,11 +7358,28 @@ future<bool> storage_proxy::cas(schema_ptr schema, cas_shard cas_shard, shared_p
 
         co_await utils::get_local_injector().inject("cas_timeout_after_lock", write_timeout + std::chrono::milliseconds(100));
 
+        // If the previous decision on the key was made here, the replicas which
+        // accepted it also promised the next ballot to this coordinator. Unless
+        // somebody started a round since, the PREPARE step can be skipped and
+        // the current value read locally.
+        std::optional<paxos::paxos_state::lease> lease;
+        if (_features.lwt_leased_accept) {
+            lease = paxos::paxos_state::take_coordinator_lease(*schema, token);
+        }
+
         while (true) {
+            std::optional<paxos_response_handler::ballot_and_data> leased;
+            if (auto l = std::exchange(lease, std::nullopt)) {
+                leased = co_await handler->begin_under_lease(*l);
+                if (!leased) {
+                    ++get_stats().cas_lease_lost;
+                }
+            }
+            const bool is_leased = bool(leased);
             // Finish the previous PAXOS round, if any, and, as a side effect, compute
             // a ballot (round identifier) which is a) unique b) has good chances of being
             // recent enough.
-            auto [ballot, qr] = co_await handler->begin_and_repair_paxos(query_options.cstate, contentions, write);
+            auto [ballot, qr] = leased ? std::move(*leased) : co_await handler->begin_and_repair_paxos(query_options.cstate, contentions, write);
             // Read the current values and check they validate the conditions.
             if (qr) {
                 paxos::paxos_state::logger.debug("CAS[{}]: Using prefetched values for CAS precondition",
@@ -6660,6 +7390,7 @@ future<bool> storage_proxy::cas(schema_ptr schema, cas_shard cas_shard, shared_p
                         handler->id());
                 tracing::trace(handler->tr_state, "Reading existing values for CAS precondition");
                 ++get_stats().cas_failed_read_round_optimization;
+                ++get_stats().cas_round_trips;
 
                 auto pr = partition_ranges; // cannot move original because it can be reused during retry
                 auto cqr = co_await query(schema, cmd, std::move(pr), cl, query_options);
@@ -6690,6 +7421,14 @@ future<bool> storage_proxy::cas(schema_ptr schema, cas_shard cas_shard, shared_p
 
             auto proposal = make_lw_shared<paxos::proposal>(ballot, freeze(*mutation));
 
+            // Ask the replicas which accept the proposal to promise the ballot
+            // of the next round on the key too, for the lease.
+            std::optional<utils::UUID> next_ballot;
+            if (_features.lwt_leased_accept && handler->coordinator_is_participant()) {
+                api::timestamp_type next_micros = query_options.cstate.get_timestamp_for_paxos(utils::UUID_gen::micros_timestamp(ballot) + 1);
+                next_ballot = utils::UUID_gen::get_random_time_UUID_from_micros(std::chrono::microseconds{next_micros});
+            }
+
             // We pass timeout_if_partially_accepted := write to accept_proposal()
             // for the following reasons:
             //   * Write requests cannot be safely retried if some replicas respond with
@@ -6701,9 +7440,12 @@ future<bool> storage_proxy::cas(schema_ptr schema, cas_shard cas_shard, shared_p
             //     twice, potentially overwriting effects of other LWTs that slipped in
             //     between.
             //   * Read requests do not have this problem, so they can be safely retried.
-            bool is_accepted = co_await handler->accept_proposal(proposal, write);
+            bool is_accepted = co_await handler->accept_proposal(proposal, write, is_leased, next_ballot);
 
             if (is_accepted) {
+                if (is_leased) {
+                    ++get_stats().cas_leased_accepts;
+                }
                 // The majority (aka a QUORUM) has promised the coordinator to
                 // accept the action associated with the computed ballot.
                 // Apply the mutation.
@@ -6719,7 +7461,21 @@ future<bool> storage_proxy::cas(schema_ptr schema, cas_shard cas_shard, shared_p
                 }
                 paxos::paxos_state::logger.debug("CAS[{}] successful", handler->id());
                 tracing::trace(handler->tr_state, "CAS successful");
+                // The data of the decision must be on a quorum before the next
+                // round may skip PREPARE, which would otherwise repair it.
+                if (next_ballot && handler->learned_by_quorum()) {
+                    paxos::paxos_state::set_coordinator_lease(*schema, token, {ballot, *next_ballot});
+                }
                 break;
+            } else if (is_leased) {
+                // Another coordinator started a round since our last decision.
+                // A write is rejected only if nobody accepted it, and a read
+                // can be retried anyway, so it's safe to go on with the full
+                // protocol right away.
+                paxos::paxos_state::logger.debug("CAS[{}] PAXOS proposal under lease not accepted, falling back to a full round",
+                        handler->id());
+                tracing::trace(handler->tr_state, "PAXOS proposal under lease not accepted, falling back to a full round");
+                ++get_stats().cas_lease_lost;
             } else {
                 paxos::paxos_state::logger.debug("CAS[{}] PAXOS proposal not accepted (preempted by a higher ballot)",
                         handler->id());
@@ -6837,6 +7593,72 @@ storage_proxy::filter_replicas_for_read(
     return filter_replicas_for_read(cl, erm, live_endpoints, preferred_endpoints, db::read_repair_decision::NONE, nullptr, cf);
 }
 
+void storage_proxy::avoid_slow_replica(const locator::topology& topo, host_id_vector_replica_set& targets, locator::host_id& extra) {
+    // How many times slower than the extra replica a target has to be to get replaced.
+    constexpr int slow_replica_ratio = 4;
+
+    auto extra_latency = _replica_latencies.median(extra);
+    if (!extra_latency) {
+        return;
+    }
+    // Only swap within a datacenter, so that the consistency level is still satisfied.
+    const auto& extra_dc = topo.get_datacenter(extra);
+    auto slowest = targets.end();
+    std::chrono::microseconds slowest_latency{0};
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+        if (topo.get_datacenter(*it) != extra_dc) {
+            continue;
+        }
+        if (auto l = _replica_latencies.median(*it); l && *l > slowest_latency) {
+            slowest = it;
+            slowest_latency = *l;
+        }
+    }
+    if (slowest != targets.end() && slowest_latency > slow_replica_ratio * *extra_latency) {
+        slogger.trace("replacing slow replica {} ({}us) with {} ({}us)", *slowest, slowest_latency.count(), extra, extra_latency->count());
+        std::swap(*slowest, extra);
+        get_stats().slow_replicas_avoided++;
+    }
+}
+
+void storage_proxy::avoid_suspected_replicas(const locator::effective_replication_map& erm, const host_id_vector_replica_set& all_replicas,
+        host_id_vector_replica_set& targets, std::optional<locator::host_id>& extra) {
+    auto threshold = _db.local().get_config().read_replica_phi_suspicion_threshold();
+    if (!threshold || targets.size() == all_replicas.size()) {
+        return;
+    }
+    auto now = replica_phi_accrual_detector::clock_type::now();
+    auto is_suspected = [&] (locator::host_id ep) {
+        return !is_me(erm, ep) && _replica_liveness.suspected(ep, threshold, now);
+    };
+    const auto& topo = erm.get_topology();
+    for (auto& target : targets) {
+        if (!is_suspected(target)) {
+            continue;
+        }
+        // Only replace within a datacenter, so that the consistency level is still satisfied.
+        // Prefer the replicas which are neither targets nor the extra one, so that speculative
+        // retry still has a replica to fall back to.
+        const auto& dc = topo.get_datacenter(target);
+        auto is_candidate = [&] (locator::host_id ep) {
+            return std::ranges::find(targets, ep) == targets.end() && topo.get_datacenter(ep) == dc && !is_suspected(ep);
+        };
+        auto it = std::ranges::find_if(all_replicas, [&] (locator::host_id ep) {
+            return ep != extra && is_candidate(ep);
+        });
+        if (it != all_replicas.end()) {
+            slogger.trace("replacing replica {} suspected to be dead with {}", target, *it);
+            target = *it;
+        } else if (extra && is_candidate(*extra)) {
+            slogger.trace("replacing replica {} suspected to be dead with {}", target, *extra);
+            std::swap(target, *extra);
+        } else {
+            continue;
+        }
+        get_stats().suspected_replicas_avoided++;
+    }
+}
+
 bool storage_proxy::is_alive(const locator::effective_replication_map& erm, const locator::host_id& ep) const {
     return is_me(erm, ep) || (_remote ? _remote->is_alive(ep) : false);
 }
@@ -7069,6 +7891,8 @@ future<> storage_proxy::wait_for_hint_sync_point(const db::hints::sync_point spo
 }
 
 void storage_proxy::on_leave_cluster(const gms::inet_address& endpoint, const locator::host_id& hid) {
+    _replica_latencies.remove(hid);
+    _replica_liveness.remove(hid);
     // Discarding these futures is safe. They're awaited by db::hints::manager::stop().
     (void) _hints_manager.drain_for(hid, endpoint);
     (void) _hints_for_views_manager.drain_for(hid, endpoint);
@@ -7121,7 +7945,10 @@ future<> storage_proxy::abort_batch_writes() {
 
 future<>
 storage_proxy::stop() {
-    return make_ready_future<>();
+    while (!_local_write_batches.empty()) {
+        flush_local_write_batch(_local_write_batches.begin()->first);
+    }
+    return _local_write_batch_gate.close();
 }
 
 locator::token_metadata_ptr storage_proxy::get_token_metadata_ptr() const noexcept {
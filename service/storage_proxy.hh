@@ -17,6 +17,8 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/scheduling_specific.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
 #include "db/read_repair_decision.hh"
 #include "db/write_type.hh"
 #include "db/hints/manager.hh"
@@ -26,6 +28,7 @@
 #include "storage_proxy_stats.hh"
 #include "service_permit.hh"
 #include "query-result.hh"
+#include "mutation/mutation.hh"
 #include "cdc/stats.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "db/hints/host_filter.hh"
@@ -40,6 +43,8 @@
 #include "service/storage_service.hh"
 #include "service/cas_shard.hh"
 #include "service/storage_proxy_fwd.hh"
+#include "service/replica_latency_tracker.hh"
+#include "service/replica_phi_accrual_detector.hh"
 
 class reconcilable_result;
 class frozen_mutation_and_schema;
@@ -128,6 +133,9 @@ class storage_proxy_coordinator_query_options {
     replicas_per_token_range preferred_replicas;
     std::optional<db::read_repair_decision> read_repair_decision;
     node_local_only node_local_only;
+    // When set, range scans stop issuing reads for the next ranges once it
+    // passes, and return a short read if they already have some rows.
+    std::optional<storage_proxy_clock_type::time_point> page_deadline;
 
     storage_proxy_coordinator_query_options(storage_proxy_clock_type::time_point timeout,
             service_permit permit_,
@@ -247,6 +255,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     query::max_result_size get_max_result_size(const query::partition_slice& slice) const;
     query::tombstone_limit get_tombstone_limit() const;
+    // The time a page of a client using adaptive paging may take, zero if unlimited.
+    std::chrono::milliseconds get_adaptive_paging_latency_budget() const;
     host_id_vector_replica_set get_live_endpoints(const locator::effective_replication_map& erm, const dht::token& token) const;
     bool is_alive(const locator::effective_replication_map& erm, const locator::host_id&) const;
 
@@ -338,7 +348,80 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     // Needed by sstable cleanup fiber to wait for all ongoing writes to complete
     utils::phased_barrier _pending_writes_phaser;
+
+    replica_latency_tracker _replica_latencies;
+    replica_phi_accrual_detector _replica_liveness;
+
+    // Writes to another shard, issued by mutate_locally() in the same task,
+    // which are sent to it together in a single cross-shard message.
+    struct local_write {
+        schema_ptr s;
+        const frozen_mutation* m;
+        tracing::trace_state_ptr tr_state;
+        db::commitlog::force_sync sync;
+        clock_type::time_point timeout;
+        db::per_partition_rate_limit::info rate_limit_info;
+        // Keeps the replication map alive until the write is done.
+        locator::effective_replication_map_ptr erm;
+        promise<> done;
+    };
+    struct local_write_batch {
+        std::vector<local_write> writes;
+        clock_type::time_point timeout = clock_type::time_point::min();
+    };
+    struct local_write_batch_key {
+        shard_id shard;
+        scheduling_group sg;
+        bool operator==(const local_write_batch_key&) const = default;
+    };
+    struct local_write_batch_key_hash {
+        size_t operator()(const local_write_batch_key& k) const noexcept {
+            return std::hash<shard_id>()(k.shard) ^ std::hash<scheduling_group>()(k.sg);
+        }
+    };
+    std::unordered_map<local_write_batch_key, lw_shared_ptr<local_write_batch>, local_write_batch_key_hash> _local_write_batches;
+    seastar::named_gate _local_write_batch_gate;
+
+    // Updates of a counter partition which arrive at its leader while another
+    // update of it is applied, merged into a single update.
+    struct counter_update_batch {
+        mutation update;
+        clock_type::time_point timeout;
+        tracing::trace_state_ptr tr_state;
+        service_permit permit;
+        size_t updates = 1;
+        shared_promise<with_clock<clock_type>> done;
+    };
+    struct counter_update_key {
+        table_schema_version schema_version;
+        bytes key;
+        db::consistency_level cl;
+        bool operator==(const counter_update_key&) const = default;
+    };
+    struct counter_update_key_hash {
+        size_t operator()(const counter_update_key& k) const noexcept {
+            return std::hash<table_schema_version>()(k.schema_version) ^ std::hash<bytes_view>()(k.key);
+        }
+    };
+    struct counter_update_state {
+        // Engaged while an update of the partition is applied on this shard.
+        std::optional<shared_promise<>> running;
+        lw_shared_ptr<counter_update_batch> pending;
+    };
+    std::unordered_map<counter_update_key, lw_shared_ptr<counter_update_state>, counter_update_key_hash> _counter_updates;
 private:
+    future<> apply_on_shard_coalesced(shard_id shard, const schema_ptr& s, const frozen_mutation& m, tracing::trace_state_ptr tr_state,
+            db::commitlog::force_sync sync, clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info,
+            locator::effective_replication_map_ptr erm);
+    void flush_local_write_batch(local_write_batch_key key);
+    // Like mutate_locally(), but writes to other shards are coalesced, see local_write_batch.
+    future<> mutate_locally_coalesced(const schema_ptr& s, const frozen_mutation& m, tracing::trace_state_ptr tr_state,
+            db::commitlog::force_sync sync, clock_type::time_point timeout, db::per_partition_rate_limit::info rate_limit_info);
+    // Swaps the slowest of `targets` with `extra` if the latter is known to be much faster.
+    void avoid_slow_replica(const locator::topology& topo, host_id_vector_replica_set& targets, locator::host_id& extra);
+    // Replaces the targets which are suspected to be dead by other replicas of the same datacenter.
+    void avoid_suspected_replicas(const locator::effective_replication_map& erm, const host_id_vector_replica_set& all_replicas,
+            host_id_vector_replica_set& targets, std::optional<locator::host_id>& extra);
     future<result<coordinator_query_result>> query_singular(lw_shared_ptr<query::read_command> cmd,
             dht::partition_range_vector&& partition_ranges,
             db::consistency_level cl,
@@ -441,7 +524,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             uint32_t remaining_partition_count,
             replicas_per_token_range preferred_replicas,
             service_permit permit,
-            node_local_only node_local_only);
+            node_local_only node_local_only,
+            std::optional<clock_type::time_point> page_deadline);
 
     future<result<coordinator_query_result>> do_query(schema_ptr,
         lw_shared_ptr<query::read_command> cmd,
@@ -478,6 +562,13 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
                                        tracing::trace_state_ptr trace_state, service_permit permit);
     future<> mutate_counter_on_leader_and_replicate(const schema_ptr& s, frozen_mutation m, db::consistency_level cl, clock_type::time_point timeout,
                                                     tracing::trace_state_ptr trace_state, service_permit permit);
+    // Applies the counter update on the leader shard, coalescing it with
+    // concurrent updates of the same partition, and replicates it.
+    future<> apply_and_replicate_counter_update_coalesced(schema_ptr s, const frozen_mutation& fm, db::consistency_level cl,
+            clock_type::time_point timeout, tracing::trace_state_ptr trace_state, service_permit permit);
+    future<> apply_and_replicate_counter_update(counter_update_key key, lw_shared_ptr<counter_update_state> st, schema_ptr s,
+            const frozen_mutation& fm, db::consistency_level cl, clock_type::time_point timeout, tracing::trace_state_ptr trace_state,
+            service_permit permit);
 
     locator::host_id find_leader_for_counter_update(const mutation& m, const locator::effective_replication_map& erm, db::consistency_level cl);
 
@@ -609,7 +700,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     // Applies mutation on this node.
     // Resolves with timed_out_error when timeout is reached.
     future<> mutate_locally(const schema_ptr& s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync, clock_type::time_point timeout = clock_type::time_point::max(), db::per_partition_rate_limit::info rate_limit_info = std::monostate()) {
-        return mutate_locally(s, m, tr_state, sync, timeout, _write_smp_service_group, rate_limit_info);
+        return mutate_locally_coalesced(s, m, std::move(tr_state), sync, timeout, rate_limit_info);
     }
     // Applies materialized view mutation on this node.
     // Resolves with timed_out_error when timeout is reached.
@@ -767,6 +858,9 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     stats& get_stats() {
         return scheduling_group_get_specific<storage_proxy_stats::stats>(_stats_key);
     }
+    const replica_latency_tracker& get_replica_latencies() const {
+        return _replica_latencies;
+    }
     const global_stats& get_global_stats() const {
         return _global_stats;
     }
@@ -792,6 +886,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     virtual void on_down(const gms::inet_address& endpoint, locator::host_id hid) override;
 
     friend class abstract_read_executor;
+    friend class digest_request_batcher;
     friend class abstract_write_response_handler;
     friend class speculating_read_executor;
     friend class view_update_backlog_broker;
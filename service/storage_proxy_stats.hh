@@ -108,6 +108,11 @@ struct write_stats {
     uint64_t cas_write_condition_not_met = 0;
     uint64_t cas_write_timeout_due_to_uncertainty = 0;
     uint64_t cas_failed_read_round_optimization = 0;
+    // Paxos round trips (prepare, read, accept, learn and commit repair)
+    // waited for by CAS operations.
+    uint64_t cas_round_trips = 0;
+    uint64_t cas_leased_accepts = 0;
+    uint64_t cas_lease_lost = 0;
     uint16_t cas_now_pruning = 0;
     uint64_t cas_prune = 0;
     uint64_t cas_coordinator_dropped_prune = 0;
@@ -149,17 +154,36 @@ struct stats : public write_stats {
 
     // number of counter updates received as a leader
     uint64_t received_counter_updates = 0;
+    // number of counter updates merged into a concurrent update of the same partition
+    uint64_t coalesced_counter_updates = 0;
 
     // number of forwarded mutations
     uint64_t forwarded_mutations = 0;
     uint64_t forwarding_errors = 0;
 
+    // number of MUTATION_BATCH messages sent and mutations carried by them
+    uint64_t mutation_batches_sent = 0;
+    uint64_t coalesced_mutations_sent = 0;
+    // number of MUTATION_BATCH messages received as a replica
+    uint64_t received_mutation_batches = 0;
+    // number of HINT_MUTATION_BATCH messages sent and hints carried by them
+    uint64_t hint_mutation_batches_sent = 0;
+    uint64_t coalesced_hints_sent = 0;
+    // number of HINT_MUTATION_BATCH messages received as a replica
+    uint64_t received_hint_mutation_batches = 0;
+
+    // number of READ_DIGEST_MULTI messages sent and partitions read by them
+    uint64_t multi_partition_digest_reads = 0;
+    uint64_t multi_partition_digest_read_partitions = 0;
+
     // number of read requests received as a replica
     uint64_t replica_data_reads = 0;
     uint64_t replica_digest_reads = 0;
     uint64_t replica_mutation_data_reads = 0;
 
     uint64_t replica_cross_shard_ops = 0;
+    // number of cross-shard messages carrying coalesced local writes
+    uint64_t replica_cross_shard_write_batches = 0;
 
     utils::timed_rate_moving_average_summary_and_histogram read;
     utils::timed_rate_moving_average_summary_and_histogram range;
@@ -168,6 +192,8 @@ struct stats : public write_stats {
     uint64_t reads = 0;
     uint64_t foreground_reads = 0; // client still waits for the read
     uint64_t read_retries = 0; // read is retried with new limit
+    uint64_t slow_replicas_avoided = 0; // a slow replica was swapped with the extra one
+    uint64_t suspected_replicas_avoided = 0; // a replica suspected to be dead was replaced by another one
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
 
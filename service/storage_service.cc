@@ -3270,8 +3270,10 @@ future<> storage_service::replicate_to_all_cores(mutable_token_metadata_ptr tmpt
     }
 
     // Apply changes on all shards
+    std::vector<token_metadata_ptr> old_token_metadata_ptr(smp::count);
     try {
         co_await container().invoke_on_all([&] (storage_service& ss) -> future<> {
+            old_token_metadata_ptr[this_shard_id()] = ss._shared_token_metadata.get();
             ss._shared_token_metadata.set(std::move(pending_token_metadata_ptr[this_shard_id()]));
             auto& db = ss._db.local();
 
@@ -3327,6 +3329,15 @@ future<> storage_service::replicate_to_all_cores(mutable_token_metadata_ptr tmpt
         slogger.error("Failed to apply token_metadata changes: {}. Aborting.", std::current_exception());
         abort();
     }
+
+    try {
+        co_await container().invoke_on_all([&] (storage_service& ss) {
+            auto old_tm = std::move(old_token_metadata_ptr[this_shard_id()]);
+            return ss._lifecycle_notifier.notify_token_metadata_changed(std::move(old_tm), ss.get_token_metadata_ptr());
+        });
+    } catch (...) {
+        slogger.warn("Failed to notify about token_metadata changes: {}", std::current_exception());
+    }
 }
 
 future<> storage_service::stop() {
@@ -6310,30 +6321,24 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
     });
     rtlogger.debug("Cloned storage of tablet {} from leaving replica {}, {} sstables were found", tablet, leaving, d.size());
 
-    auto load_sstable = [] (const dht::sharder& sharder, replica::table& t, sstables::entry_descriptor d) -> future<sstables::shared_sstable> {
-        auto& mng = t.get_sstables_manager();
-        auto sst = mng.make_sstable(t.schema(), t.get_storage_options(), d.generation, d.state.value_or(sstables::sstable_state::normal),
-                                    d.version, d.format, db_clock::now(), default_io_error_handler_gen());
-        // The loader will consider current shard as sstable owner, despite the tablet sharder
-        // will still point to leaving replica at this stage in migration. If node goes down,
-        // SSTables will be loaded at pending replica and migration is retried, so correctness
-        // wise, we're good.
-        auto cfg = sstables::sstable_open_config{ .current_shard_as_sstable_owner = true };
-        co_await sst->load(sharder, cfg);
-        co_return sst;
-    };
-
-    co_await smp::submit_to(pending.shard, [this, tablet, load_sstable, d = std::move(d)] () mutable -> future<> {
+    co_await smp::submit_to(pending.shard, [this, tablet, d = std::move(d)] () mutable -> future<> {
         // Loads cloned sstables from leaving replica into pending one.
         auto& table = _db.local().find_column_family(tablet.table);
         auto op = table.stream_in_progress();
         dht::auto_refreshing_sharder sharder(table.shared_from_this());
 
+        auto& mng = table.get_sstables_manager();
         std::vector<sstables::shared_sstable> ssts;
         ssts.reserve(d.size());
         for (auto&& sst_desc : d) {
-            ssts.push_back(co_await load_sstable(sharder, table, std::move(sst_desc)));
+            ssts.push_back(mng.make_sstable(table.schema(), table.get_storage_options(), sst_desc.generation, sst_desc.state.value_or(sstables::sstable_state::normal),
+                                            sst_desc.version, sst_desc.format, db_clock::now(), default_io_error_handler_gen()));
         }
+        // The loader will consider current shard as sstable owner, despite the tablet sharder
+        // will still point to leaving replica at this stage in migration. If node goes down,
+        // SSTables will be loaded at pending replica and migration is retried, so correctness
+        // wise, we're good.
+        co_await mng.load_sstables(ssts, sharder, sstables::sstable_open_config{ .current_shard_as_sstable_owner = true });
         co_await table.add_sstables_and_update_cache(ssts);
     });
     rtlogger.debug("Successfully loaded storage of tablet {} into pending replica {}", tablet, pending);
@@ -6982,6 +6987,7 @@ future<locator::load_stats> storage_service::load_stats_for_tablet_based_tables(
             };
 
             load_stats.tables.emplace(id, table->table_load_stats(tablet_filter));
+            load_stats.heat.emplace(id, table->tablet_heat_stats());
             co_await coroutine::maybe_yield();
         }
 
@@ -7849,6 +7855,18 @@ future<> endpoint_lifecycle_notifier::notify_joined(gms::inet_address endpoint,
     });
 }
 
+future<> endpoint_lifecycle_notifier::notify_token_metadata_changed(locator::token_metadata_ptr old_tm, locator::token_metadata_ptr new_tm) {
+    return seastar::async([this, old_tm = std::move(old_tm), new_tm = std::move(new_tm)] {
+        _subscribers.thread_for_each([&] (endpoint_lifecycle_subscriber* subscriber) {
+            try {
+                subscriber->on_token_metadata_changed(*old_tm, *new_tm);
+            } catch (...) {
+                slogger.warn("Token metadata change notification failed: {}", std::current_exception());
+            }
+        });
+    });
+}
+
 future<> storage_service::notify_joined(inet_address endpoint, locator::host_id hid) {
     co_await utils::get_local_injector().inject(
         "storage_service_notify_joined_sleep", std::chrono::milliseconds{500});
@@ -46,6 +46,8 @@ void load_balancer_stats_manager::setup_metrics(const dc_name& dc, load_balancer
                          stats.migrations_skipped)(dc_lb),
         sm::make_counter("cross_rack_collocations", sm::description("number of co-locating migrations which move replica across racks"),
                          stats.cross_rack_collocations)(dc_lb),
+        sm::make_counter("heat_migrations_produced", sm::description("number of intra-node migrations produced by the load balancer to even out heat of shards"),
+                         stats.heat_migrations_produced)(dc_lb),
     });
 }
 
@@ -1238,6 +1240,41 @@ class load_balancer {
         return {tablet_count, format("min_per_shard_tablet_count={:.3f} in DC {}", min_per_shard_tablet_count, *winning_dc)};
     }
 
+    struct tablet_heat_desc {
+        // The highest request rate of a single tablet replica among the co-located tables.
+        double max_replica_heat = 0;
+        // Set when the rates were measured before the last resize, so they don't apply yet.
+        bool stale = false;
+    };
+
+    // Returns nullopt if the heat of tablets is not known.
+    std::optional<tablet_heat_desc> get_tablet_heat_desc(const locator::table_group_set& tables, size_t tablet_count) const {
+        if (!_table_load_stats || !tablet_count) {
+            return std::nullopt;
+        }
+        std::optional<tablet_heat_desc> desc;
+        for (auto table : tables) {
+            auto it = _table_load_stats->heat.find(table);
+            if (it == _table_load_stats->heat.end()) {
+                continue;
+            }
+            if (!desc) {
+                desc.emplace();
+            }
+            if (it->second.tablet_count != tablet_count) {
+                desc->stale = true;
+                continue;
+            }
+            auto& tmap = _tm->tablets().get_tablet_map(table);
+            double table_max_heat = 0;
+            for (auto& [tid, rate] : it->second.requests_per_second) {
+                table_max_heat = std::max(table_max_heat, _table_load_stats->get_tablet_replica_heat(global_tablet_id{table, tid}, tmap));
+            }
+            desc->max_replica_heat = std::max(desc->max_replica_heat, table_max_heat);
+        }
+        return desc;
+    }
+
     future<sizing_plan> make_sizing_plan(schema_ptr new_table = nullptr, const tablet_aware_replication_strategy* new_rs = nullptr) {
         std::unordered_map<table_id, const tablet_aware_replication_strategy*> rs_by_table;
         sizing_plan plan;
@@ -1331,6 +1368,27 @@ class load_balancer {
                 maybe_apply({table_plan.current_tablet_count, "current count"});
             }
 
+            // Split tablets which serve more requests than a single shard should take, so that
+            // their halves can be spread between shards. The rates are averaged over the load stats
+            // refresh period, so short bursts don't trigger splits. Like for size, the decision is
+            // kept until the rate drops past the half-way point, and merges are held back for
+            // tablets that would become too hot again.
+            // Rates which predate the last resize don't apply, but they are about to be refreshed,
+            // so the tablet count is held until then.
+            auto heat_desc = get_tablet_heat_desc(tables, tablet_count);
+            auto split_heat_threshold = _db.get_config().tablet_split_requests_per_second_threshold();
+            if (heat_desc && split_heat_threshold) {
+                auto max_heat = heat_desc->max_replica_heat;
+                auto cur_decision = _tm->tablets().get_tablet_map(table).resize_decision();
+                if (heat_desc->stale) {
+                    maybe_apply({tablet_count, "stale tablet heat"});
+                } else if (max_heat > split_heat_threshold || (cur_decision.is_split() && max_heat * 2 >= split_heat_threshold)) {
+                    maybe_apply({tablet_count * 2, format("max_tablet_requests_per_second={:.0f}", max_heat)});
+                } else if (max_heat * 2 > split_heat_threshold) {
+                    maybe_apply({tablet_count, format("max_tablet_requests_per_second={:.0f}", max_heat)});
+                }
+            }
+
             if (utils::get_local_injector().enter("tablet_force_tablet_count_increase")) {
                 target_tablet_count = {tablet_count * 2, "force_tablet_count_increase"};
             } else if (utils::get_local_injector().enter("tablet_force_tablet_count_decrease")) {
@@ -1960,17 +2018,25 @@ class load_balancer {
     }
 
     static void unload(locator::load_sketch& sketch, host_id host, shard_id shard, const migration_tablet_set& tablet_set) {
-        for (auto _ : tablet_set.tablets()) {
-            sketch.unload(host, shard);
+        for (auto tablet : tablet_set.tablets()) {
+            sketch.unload(host, shard, sketch.get_tablet_heat(tablet));
         }
     }
 
     static void pick(locator::load_sketch& sketch, host_id host, shard_id shard, const migration_tablet_set& tablet_set) {
-        for (auto _ : tablet_set.tablets()) {
-            sketch.pick(host, shard);
+        for (auto tablet : tablet_set.tablets()) {
+            sketch.pick(host, shard, sketch.get_tablet_heat(tablet));
         }
     }
 
+    static double get_heat(const locator::load_sketch& sketch, const migration_tablet_set& tablet_set) {
+        double heat = 0;
+        for (auto tablet : tablet_set.tablets()) {
+            heat += sketch.get_tablet_heat(tablet);
+        }
+        return heat;
+    }
+
     future<migration_plan> make_node_plan(node_load_map& nodes, host_id host, node_load& node_load) {
         migration_plan plan;
         const tablet_metadata& tmeta = _tm->tablets();
@@ -2075,8 +2141,125 @@ class load_balancer {
             erase_candidates(nodes, tmap, tablets);
 
             update_node_load_on_migration(node_load, host, src, dst, tablets);
-            sketch.pick(host, dst);
-            sketch.unload(host, src);
+            pick(sketch, host, dst, tablets);
+            unload(sketch, host, src, tablets);
+        }
+
+        co_return plan;
+    }
+
+    // Returns the hottest candidate of the shard, or the coldest one if hottest == false,
+    // whose heat is within (min_heat, max_heat).
+    std::optional<migration_tablet_set> find_heat_candidate(const shard_load& shard_info, bool hottest, double min_heat, double max_heat) {
+        std::optional<migration_tablet_set> best;
+        double best_heat = 0;
+        auto consider = [&] (const migration_tablet_set& tablets) {
+            auto heat = get_heat(*_load_sketch, tablets);
+            if (heat <= min_heat || heat >= max_heat) {
+                return;
+            }
+            if (!best || (hottest ? heat > best_heat : heat < best_heat)) {
+                best = tablets;
+                best_heat = heat;
+            }
+        };
+        for (auto&& [table, tablets] : shard_info.candidates) {
+            std::ranges::for_each(tablets, consider);
+        }
+        std::ranges::for_each(shard_info.candidates_all_tables, consider);
+        return best;
+    }
+
+    // Evens out heat between shards of the node, which count-based balancing
+    // is blind to, by swapping hot tablets of the hottest shard with cold
+    // tablets of the coldest shard. Swaps keep tablet counts of shards intact.
+    future<migration_plan> make_node_heat_plan(node_load_map& nodes, host_id host, node_load& node_load, double threshold) {
+        migration_plan plan;
+        auto& sketch = *_load_sketch;
+        const tablet_metadata& tmeta = _tm->tablets();
+
+        // Each swap reduces the gap between the hottest and the coldest shard,
+        // but a shard can become the hottest one again, so bound the number of rounds.
+        for (shard_id round = 0; round < node_load.shard_count; ++round) {
+            co_await coroutine::maybe_yield();
+
+            auto avg_heat = sketch.get_avg_shard_heat(host);
+            auto hot = sketch.get_hottest_shard(host);
+            auto cold = sketch.get_coldest_shard(host);
+            auto hot_heat = sketch.get_shard_heat(host, hot);
+            auto cold_heat = sketch.get_shard_heat(host, cold);
+            if (hot == cold || avg_heat <= 0 || hot_heat <= avg_heat * (1 + threshold)) {
+                lblogger.debug("Heat of node {} is balanced, max: {}, avg: {}", host, hot_heat, avg_heat);
+                break;
+            }
+
+            // Swapping tablets of heat hh and hc changes the gap by -2 * (hh - hc),
+            // so it converges only if 0 < hh - hc < gap.
+            auto gap = hot_heat - cold_heat;
+            auto cold_candidate = find_heat_candidate(node_load.shards[cold], false, -1, gap);
+            if (!cold_candidate) {
+                lblogger.debug("No cold candidates on shard {} of {}", cold, host);
+                break;
+            }
+            auto cold_candidate_heat = get_heat(sketch, *cold_candidate);
+            auto hot_candidate = find_heat_candidate(node_load.shards[hot], true, cold_candidate_heat, cold_candidate_heat + gap);
+            if (!hot_candidate) {
+                lblogger.debug("No hot candidates on shard {} of {}", hot, host);
+                break;
+            }
+
+            auto hot_mig = get_migration_info(*hot_candidate, tablet_transition_kind::intranode_migration,
+                                              tablet_replica{host, hot}, tablet_replica{host, cold});
+            auto cold_mig = get_migration_info(*cold_candidate, tablet_transition_kind::intranode_migration,
+                                               tablet_replica{host, cold}, tablet_replica{host, hot});
+            auto& hot_tmap = tmeta.get_tablet_map(hot_candidate->table());
+            auto& cold_tmap = tmeta.get_tablet_map(cold_candidate->table());
+            auto hot_streaming_info = get_migration_streaming_infos(_tm->get_topology(), hot_tmap, hot_mig);
+            auto cold_streaming_info = get_migration_streaming_infos(_tm->get_topology(), cold_tmap, cold_mig);
+
+            // The two migrations stream in opposite directions, so they don't compete for the same limits.
+            if (!can_accept_load(nodes, hot_streaming_info) || !can_accept_load(nodes, cold_streaming_info)) {
+                _stats.for_dc(node_load.dc()).migrations_skipped++;
+                lblogger.debug("Unable to balance heat of {}: load limit reached", host);
+                break;
+            }
+            apply_load(nodes, hot_streaming_info);
+            apply_load(nodes, cold_streaming_info);
+
+            lblogger.debug("Swapping tablets to balance heat: {} and {}", hot_mig, cold_mig);
+            auto& dc_stats = _stats.for_dc(node_load.dc());
+            dc_stats.migrations_produced += 2;
+            dc_stats.intranode_migrations_produced += 2;
+            dc_stats.heat_migrations_produced += 2;
+            plan.add(std::move(hot_mig));
+            plan.add(std::move(cold_mig));
+
+            erase_candidates(nodes, hot_tmap, *hot_candidate);
+            erase_candidates(nodes, cold_tmap, *cold_candidate);
+
+            update_node_load_on_migration(node_load, host, hot, cold, *hot_candidate);
+            update_node_load_on_migration(node_load, host, cold, hot, *cold_candidate);
+            unload(sketch, host, hot, *hot_candidate);
+            pick(sketch, host, cold, *hot_candidate);
+            unload(sketch, host, cold, *cold_candidate);
+            pick(sketch, host, hot, *cold_candidate);
+        }
+
+        co_return plan;
+    }
+
+    future<migration_plan> make_heat_plan(node_load_map& nodes, const std::unordered_set<host_id>& skip_nodes) {
+        migration_plan plan;
+        auto threshold = _db.get_config().tablet_heat_imbalance_threshold();
+        if (threshold <= 0 || !_table_load_stats || _table_load_stats->heat.empty()) {
+            co_return plan;
+        }
+
+        for (auto&& [host, node_load] : nodes) {
+            if (skip_nodes.contains(host) || node_load.shard_count <= 1) {
+                continue;
+            }
+            plan.merge(co_await make_node_heat_plan(nodes, host, node_load, threshold));
         }
 
         co_return plan;
@@ -3039,7 +3222,7 @@ class load_balancer {
 
         // Compute per-shard load and candidate tablets.
 
-        _load_sketch = locator::load_sketch(_tm);
+        _load_sketch = locator::load_sketch(_tm, _table_load_stats);
         co_await _load_sketch->populate_dc(dc);
         _tablet_count_per_table.clear();
 
@@ -3123,6 +3306,7 @@ class load_balancer {
 
         if (_tm->tablets().balancing_enabled()) {
             plan.merge(co_await make_intranode_plan(nodes, nodes_to_drain));
+            plan.merge(co_await make_heat_plan(nodes, nodes_to_drain));
         }
 
         if (_tm->tablets().balancing_enabled() && plan.empty()) {
@@ -33,6 +33,7 @@ struct load_balancer_dc_stats {
     uint64_t stop_skip_limit = 0;
     uint64_t stop_batch_size = 0;
     uint64_t cross_rack_collocations = 0;
+    uint64_t heat_migrations_produced = 0;
 
     load_balancer_dc_stats operator-(const load_balancer_dc_stats& other) const {
         return {
@@ -52,6 +53,7 @@ struct load_balancer_dc_stats {
             stop_skip_limit - other.stop_skip_limit,
             stop_batch_size - other.stop_batch_size,
             cross_rack_collocations - other.cross_rack_collocations,
+            heat_migrations_produced - other.heat_migrations_produced,
         };
     }
 };
@@ -121,6 +121,7 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
     db::system_keyspace& _sys_ks;
     replica::database& _db;
     utils::updateable_value<uint32_t> _tablet_load_stats_refresh_interval_in_seconds;
+    utils::updateable_value<uint32_t> _tablet_balancing_join_window_in_ms;
     service::raft_group0& _group0;
     service::topology_state_machine& _topo_sm;
     db::view::view_building_state_machine& _vb_sm;
@@ -156,6 +157,11 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
 
     topology_coordinator_cmd_rpc_tracker& _topology_cmd_rpc_tracker;
 
+    // Tablet load balancing doesn't start until then, see tablet_balancing_join_window_in_ms.
+    lowres_clock::time_point _tablet_balancing_deferred_until;
+    // Wakes up the coordinator when balancing may start.
+    timer<lowres_clock> _tablet_balancing_timer;
+
     const locator::token_metadata& get_token_metadata() const noexcept {
         return *_shared_tm.get();
     }
@@ -2050,6 +2056,22 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
         }
     }
 
+    // Called when a node finished bootstrapping. Other nodes are often added
+    // right after it, e.g. when the cluster is scaled out. Their join requests
+    // preempt tablet load balancing, but only new migrations, the ongoing ones
+    // have to finish streaming first. And the migrations planned before they
+    // join don't account for them. Waiting for a while with balancing lets the
+    // nodes join back to back and the load balancer plan the migrations
+    // to all of them at once, streaming to them in parallel.
+    void defer_tablet_balancing_after_join() {
+        auto window = std::chrono::milliseconds(_tablet_balancing_join_window_in_ms());
+        if (window.count() == 0) {
+            return;
+        }
+        _tablet_balancing_deferred_until = lowres_clock::now() + window;
+        _tablet_balancing_timer.rearm(_tablet_balancing_deferred_until);
+    }
+
     void trigger_load_stats_refresh() {
         (void)_tablet_load_stats_refresh.trigger().handle_exception([] (auto ep) {
             rtlogger.warn("Error during tablet load stats refresh: {}", ep);
@@ -2153,6 +2175,17 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
                 guard = std::move(*guard_opt);
             }
 
+            // Nodes which join one after another are balanced for together, see
+            // tablet_balancing_join_window_in_ms.
+            if (auto now = lowres_clock::now(); now < _tablet_balancing_deferred_until) {
+                rtlogger.debug("Deferring tablet load balancing for {}ms after a node joined",
+                        std::chrono::duration_cast<std::chrono::milliseconds>(_tablet_balancing_deferred_until - now).count());
+                if (!_tablet_balancing_timer.armed()) {
+                    _tablet_balancing_timer.arm(_tablet_balancing_deferred_until);
+                }
+                co_return false;
+            }
+
             // If there is no other work, evaluate load and start tablet migration if there is imbalance.
             if (co_await maybe_start_tablet_migration(std::move(guard))) {
                 co_return true;
@@ -2527,6 +2560,7 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
                     co_await _voter_handler.on_node_added(node.id, _as);
                     co_await mark_view_build_statuses_on_node_join(muts, node.guard, node.id);
                     co_await update_topology_state(take_guard(std::move(node)), std::move(muts), "bootstrap: read fence completed");
+                    defer_tablet_balancing_after_join();
                     trigger_load_stats_refresh();
                     }
                     break;
@@ -3148,6 +3182,7 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
         : _sys_dist_ks(sys_dist_ks), _gossiper(gossiper), _messaging(messaging)
         , _shared_tm(shared_tm), _sys_ks(sys_ks), _db(db)
         , _tablet_load_stats_refresh_interval_in_seconds(db.get_config().tablet_load_stats_refresh_interval_in_seconds)
+        , _tablet_balancing_join_window_in_ms(db.get_config().tablet_balancing_join_window_in_ms)
         , _group0(group0), _topo_sm(topo_sm), _vb_sm(vb_sm), _as(as)
         , _feature_service(feature_service), _lifecycle_notifier(lifecycle_notifier)
         , _raft(raft_server), _term(raft_server.get_current_term())
@@ -3159,6 +3194,7 @@ class topology_coordinator : public endpoint_lifecycle_subscriber {
         , _group0_holder(_group0.hold_group0_gate())
         , _voter_handler(group0, topo_sm._topology, gossiper, feature_service)
         , _topology_cmd_rpc_tracker(topology_cmd_rpc_tracker)
+        , _tablet_balancing_timer([this] { _topo_sm.event.broadcast(); })
         , _async_gate("topology_coordinator")
     {}
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "sstables/key.hh"
+#include "sstables/types.hh"
 #include "dht/i_partitioner.hh"
 
 namespace sstables {
@@ -67,6 +68,34 @@ int binary_search(const dht::i_partitioner& partitioner, const T& entries, const
     return -mid - (result < 0 ? 1 : 2);
 }
 
+// Same as above, for the summary. The tokens of the summary entries are kept
+// in memory, so the (front-coded) keys only need to be decoded on token ties.
+inline int binary_search(const dht::i_partitioner& partitioner, const summary& s, const key& sk, const dht::token& token) {
+    int low = 0, mid = s.entries.size(), high = mid - 1;
+    std::strong_ordering result = std::strong_ordering::less;
+
+    while (low <= high) {
+        mid = low + ((high - low) >> 1);
+        auto mid_token = s.entries[mid].get_token();
+
+        if (token == mid_token) {
+            result = sk.tri_compare(key_view(s.key_at(mid)));
+        } else {
+            result = token < mid_token ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        if (result > 0) {
+            low = mid + 1;
+        } else if (result < 0) {
+            high = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+
+    return -mid - (result < 0 ? 1 : 2);
+}
+
 template <typename T>
 int binary_search(const dht::i_partitioner& partitioner, const T& entries, const key& sk) {
     return binary_search(partitioner, entries, sk, partitioner.get_token(key_view(sk)));
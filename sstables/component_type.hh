@@ -27,6 +27,7 @@ enum class component_type {
     TemporaryTOC,
     TemporaryStatistics,
     Scylla,
+    PartitionTrie,
     Unknown,
 };
 
@@ -73,6 +74,8 @@ struct fmt::formatter<sstables::component_type> : fmt::formatter<string_view> {
             return formatter<string_view>::format("TemporaryStatistics", ctx);
         case Scylla:
             return formatter<string_view>::format("Scylla", ctx);
+        case PartitionTrie:
+            return formatter<string_view>::format("PartitionTrie", ctx);
         case Unknown:
             return formatter<string_view>::format("Unknown", ctx);
         }
@@ -24,6 +24,7 @@
 #include "utils/class_registrator.hh"
 #include "reader_permit.hh"
 #include "data_source_types.hh"
+#include "decompressed_chunk_cache.hh"
 
 namespace sstables {
 
@@ -310,6 +311,10 @@ class compressed_file_data_source_impl : public data_source_impl {
     sstables::compression::segmented_offsets::accessor _offsets;
     [[no_unique_address]] sstables::digest_members<check_digest> _digests;
     reader_permit _permit;
+    // Set for reads which span only a few chunks.
+    sstables::decompressed_chunk_cache* _chunk_cache = nullptr;
+    // Position of the underlying stream when opened.
+    uint64_t _stream_start;
     uint64_t _underlying_pos;
     uint64_t _pos;
     uint64_t _beg_pos;
@@ -317,7 +322,8 @@ class compressed_file_data_source_impl : public data_source_impl {
 public:
     compressed_file_data_source_impl(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options,
-                reader_permit permit, std::optional<uint32_t> digest)
+                reader_permit permit, std::optional<uint32_t> digest,
+                sstables::decompressed_chunk_cache* chunk_cache)
             : _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_accessor())
             , _permit(std::move(permit))
@@ -356,17 +362,53 @@ class compressed_file_data_source_impl : public data_source_impl {
         _stream_creator = [stream_creator{std::move(stream_creator)}, start = start.chunk_start, length = end.chunk_start + end.chunk_len - start.chunk_start, options] mutable {
             return stream_creator(start, length, std::move(options));
         };
-        _underlying_pos = start.chunk_start;
+        _stream_start = _underlying_pos = start.chunk_start;
+        // Scans would only churn the cache, it's meant for the chunks
+        // of the partitions read over and over.
+        if constexpr (!check_digest) {
+            if (chunk_cache && chunk_idx(_end_pos - 1) - chunk_idx(_beg_pos) < max_cached_read_chunks) {
+                _chunk_cache = chunk_cache;
+            }
+        }
+    }
+private:
+    static constexpr uint64_t max_cached_read_chunks = 2;
+
+    uint64_t chunk_idx(uint64_t pos) const noexcept {
+        return pos / _compression_metadata->uncompressed_chunk_length();
     }
+
+    // Chunks served from the cache are not read from the underlying
+    // stream, so it is opened lazily, at the first chunk which isn't.
+    future<> open_input_stream() {
+        _input_stream = co_await _stream_creator();
+        if (_underlying_pos != _stream_start) {
+            co_await _input_stream->skip(_underlying_pos - _stream_start);
+        }
+    }
+public:
     virtual future<temporary_buffer<char>> get() override {
         if (_pos >= _end_pos) {
             co_return temporary_buffer<char>();
         }
 
+        auto addr = _compression_metadata->locate(_pos, _offsets);
+        if (_chunk_cache) {
+            auto res_units = co_await _permit.request_memory(_compression_metadata->uncompressed_chunk_length());
+            auto out = _chunk_cache->get(chunk_idx(_pos));
+            if (out) {
+                if (_input_stream) {
+                    co_await _input_stream->skip(addr.chunk_len);
+                }
+                out.trim_front(addr.offset);
+                _pos += out.size();
+                _underlying_pos += addr.chunk_len;
+                co_return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
+            }
+        }
         if (!_input_stream) {
-            _input_stream = co_await _stream_creator();
+            co_await open_input_stream();
         }
-        auto addr = _compression_metadata->locate(_pos, _offsets);
         // Uncompress the next chunk. We need to skip part of the first
         // chunk, but then continue to read from beginning of chunks.
         if (_pos != _beg_pos && addr.offset != 0) {
@@ -412,6 +454,9 @@ class compressed_file_data_source_impl : public data_source_impl {
         auto len = _compression_metadata->get_compressor().uncompress(buf.get(), compressed_len, out.get_write(), out.size());
 
         out.trim(len);
+        if (_chunk_cache) {
+            _chunk_cache->put(chunk_idx(_pos), out);
+        }
         out.trim_front(addr.offset);
         _pos += out.size();
         _underlying_pos += addr.chunk_len;
@@ -452,7 +497,8 @@ class compressed_file_data_source_impl : public data_source_impl {
         _underlying_pos = addr.chunk_start;
         _beg_pos = _pos;
         if (!_input_stream) {
-            _input_stream = co_await _stream_creator();
+            // Opened at _underlying_pos on the next get().
+            co_return temporary_buffer<char>();
         }
         co_await _input_stream->skip(underlying_n);
         co_return temporary_buffer<char>();
@@ -464,23 +510,23 @@ class compressed_file_data_source : public data_source {
 public:
     compressed_file_data_source(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
             uint64_t offset, size_t len, file_input_stream_options options, reader_permit permit,
-            std::optional<uint32_t> digest)
+            std::optional<uint32_t> digest, sstables::decompressed_chunk_cache* chunk_cache)
         : data_source(std::make_unique<compressed_file_data_source_impl<ChecksumType, check_digest, mode>>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest))
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache))
         {}
 };
 
 template <ChecksumUtils ChecksumType, compressed_checksum_mode mode>
 inline input_stream<char> make_compressed_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm, uint64_t offset, size_t len,
         file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest)
+        std::optional<uint32_t> digest, sstables::decompressed_chunk_cache* chunk_cache)
 {
     if (digest) [[unlikely]] {
         return input_stream<char>(compressed_file_data_source<ChecksumType, true, mode>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache));
     }
     return input_stream<char>(compressed_file_data_source<ChecksumType, false, mode>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache));
 }
 
 // compressed_file_data_sink_impl works as a filter for a file output stream,
@@ -566,11 +612,12 @@ requires ChecksumUtils<ChecksumType>
 inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
          sstables::compression* cm,
          const compression_parameters& cp,
-         compressor_ptr p) {
+         compressor_ptr p,
+         std::optional<uint32_t> chunk_length) {
     cm->set_compressor(std::move(p));
     // buffer of output stream is set to chunk length, because flush must
     // happen every time a chunk was filled up.
-    cm->set_uncompressed_chunk_length(cp.chunk_length());
+    cm->set_uncompressed_chunk_length(chunk_length.value_or(cp.chunk_length()));
     // FIXME: crc_check_chance can be configured by the user.
     // probability to verify the checksum of a compressed chunk we read.
     // defaults to 1.0.
@@ -582,25 +629,26 @@ inline output_stream<char> make_compressed_file_output_stream(output_stream<char
 input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(stream_creator_fn stream_creator,
         sstables::compression* cm, uint64_t offset, size_t len,
         class file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest)
+        std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache)
 {
     return make_compressed_file_input_stream<adler32_utils, compressed_checksum_mode::checksum_chunks_only>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest);
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache);
 }
 
 input_stream<char> sstables::make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
         sstables::compression *cm, uint64_t offset, size_t len,
         class file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest) {
+        std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache) {
     return make_compressed_file_input_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest);
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache);
 }
 
 output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
         sstables::compression* cm,
         const compression_parameters& cp,
-        compressor_ptr p) {
+        compressor_ptr p,
+        std::optional<uint32_t> chunk_length) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(out), cm, cp, std::move(p));
+            std::move(out), cm, cp, std::move(p), chunk_length);
 }
 
@@ -360,6 +360,8 @@ struct compression {
     friend class sstable;
 };
 
+class decompressed_chunk_cache;
+
 using stream_creator_fn = std::function<future<input_stream<char>>(uint64_t, uint64_t, file_input_stream_options)>;
 
 // Note: compression_metadata is passed by reference; The caller is
@@ -367,20 +369,24 @@ using stream_creator_fn = std::function<future<input_stream<char>>(uint64_t, uin
 // are open streams on it. This should happen naturally on a higher level -
 // as long as we have *sstables* work in progress, we need to keep the whole
 // sstable alive, and the compression metadata is only a part of it.
+// The same goes for the chunk cache, if given. It is used only by reads
+// of a few chunks which don't check the digest.
 input_stream<char> make_compressed_file_k_l_format_input_stream(stream_creator_fn stream_creator,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit,
-                std::optional<uint32_t> digest);
+                std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache = nullptr);
 
 input_stream<char> make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit,
-                std::optional<uint32_t> digest);
+                std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache = nullptr);
 
+// The chunk length of the table is used, unless one is given.
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
                 const compression_parameters& cp,
-                compressor_ptr);
+                compressor_ptr,
+                std::optional<uint32_t> chunk_length = std::nullopt);
 
 
 std::map<sstring, sstring> options_from_compression(const compression& c);
@@ -283,7 +283,7 @@ zstd_processor::zstd_processor(const compression_parameters& opts, cdict_ptr cdi
     // size and on the dictionary size.
     size_t dict_len = _cdict ? _cdict->raw().size() : 0;
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto chunk_len = opts.chunk_length();
+    auto chunk_len = opts.auto_chunk_length() ? compression_parameters::MAX_AUTO_CHUNK_LENGTH : opts.chunk_length();
     auto cparams = ZSTD_getCParams(_compression_level, chunk_len, dict_len);
     _cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
 
@@ -499,7 +499,9 @@ compression_parameters::compression_parameters(const std::map<sstring, sstring>&
     if (auto v = get_option(CHUNK_LENGTH_KB)) {
         chunk_length = v;
     }
-    if (chunk_length) {
+    if (chunk_length && *chunk_length == AUTO_CHUNK_LENGTH) {
+        _auto_chunk_length = true;
+    } else if (chunk_length) {
         try {
             _chunk_length = std::stoi(*chunk_length) * 1024;
         } catch (const std::exception& e) {
@@ -584,7 +586,9 @@ std::map<sstring, sstring> compression_parameters::get_options() const {
     if (_zstd_compression_level) {
         opts.emplace(COMPRESSION_LEVEL, std::to_string(_zstd_compression_level.value()));
     }
-    if (_chunk_length) {
+    if (_auto_chunk_length) {
+        opts.emplace(sstring(CHUNK_LENGTH_KB), sstring(AUTO_CHUNK_LENGTH));
+    } else if (_chunk_length) {
         opts.emplace(sstring(CHUNK_LENGTH_KB), std::to_string(_chunk_length.value() / 1024));
     }
     if (_crc_check_chance) {
@@ -593,6 +597,32 @@ std::map<sstring, sstring> compression_parameters::get_options() const {
     return opts;
 }
 
+int32_t compression_parameters::pick_chunk_length(uint64_t point_reads, uint64_t scan_bytes, uint64_t partition_size) {
+    if (point_reads == 0 && scan_bytes == 0) {
+        return DEFAULT_CHUNK_LENGTH;
+    }
+    // Reading a chunk costs about as much as decompressing this many more
+    // bytes: an I/O and the setup of the decompressor.
+    constexpr double chunk_overhead = 4096;
+    // Point reads of large partitions only read the chunks of the rows
+    // they select, found through the promoted index.
+    partition_size = std::min<uint64_t>(partition_size, MAX_AUTO_CHUNK_LENGTH);
+
+    auto best = MIN_AUTO_CHUNK_LENGTH;
+    auto best_cost = std::numeric_limits<double>::max();
+    for (auto len = MIN_AUTO_CHUNK_LENGTH; len <= MAX_AUTO_CHUNK_LENGTH; len *= 2) {
+        // A point read decompresses the chunks of the partition, at least one.
+        auto point_chunks = std::max(1.0, double(partition_size) / len);
+        auto scan_chunks = double(scan_bytes) / len;
+        auto cost = (point_reads * point_chunks + scan_chunks) * (len + chunk_overhead);
+        if (cost < best_cost) {
+            best = len;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
 lz4_processor::lz4_processor(cdict_ptr cdict, ddict_ptr ddict)
     : _cdict(std::move(cdict))
     , _ddict(std::move(ddict))
@@ -696,6 +726,26 @@ compressor_ptr make_lz4_sstable_compressor_for_tests() {
     return std::make_unique<lz4_processor>();
 }
 
+compressor_ptr make_compressor_without_dicts(const compression_parameters& params) {
+    using algorithm = compression_parameters::algorithm;
+    switch (params.get_algorithm()) {
+    case algorithm::lz4:
+        return std::make_unique<lz4_processor>();
+    case algorithm::deflate:
+        return std::make_unique<deflate_processor>();
+    case algorithm::snappy:
+        return std::make_unique<snappy_processor>();
+    case algorithm::zstd:
+        return std::make_unique<zstd_processor>(params, nullptr, nullptr);
+    case algorithm::lz4_with_dicts:
+    case algorithm::zstd_with_dicts:
+        throw std::invalid_argument(fmt::format("{} requires a dictionary", params.get_algorithm()));
+    case algorithm::none:
+        return nullptr;
+    }
+    abort();
+}
+
 size_t deflate_processor::uncompress(const char* input,
                 size_t input_len, char* output, size_t output_len) const {
     z_stream zs;
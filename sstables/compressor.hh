@@ -70,6 +70,12 @@ using compressor_ptr = compressor::ptr_type;
 
 compressor_ptr make_lz4_sstable_compressor_for_tests();
 
+// Creates a compressor which doesn't use a dictionary, synchronously.
+// Meant for data compressed outside of sstables (e.g. commitlog entries),
+// where there is no place to keep a dictionary next to the data.
+// Throws for the algorithms which require dictionaries, returns nullptr for algorithm::none.
+compressor_ptr make_compressor_without_dicts(const compression_parameters& params);
+
 // Per-table compression options, parsed and validated.
 //
 // Compression options are configured through the JSON-like `compression` entry in the schema.
@@ -83,6 +89,9 @@ class compression_parameters {
     static constexpr std::string_view name_prefix = "org.apache.cassandra.io.compress.";
 
     static constexpr int32_t DEFAULT_CHUNK_LENGTH = 4 * 1024;
+    static constexpr int32_t MIN_AUTO_CHUNK_LENGTH = 4 * 1024;
+    static constexpr int32_t MAX_AUTO_CHUNK_LENGTH = 64 * 1024;
+    static constexpr std::string_view AUTO_CHUNK_LENGTH = "auto";
     static constexpr double DEFAULT_CRC_CHECK_CHANCE = 1.0;
 
     static const sstring SSTABLE_COMPRESSION;
@@ -92,6 +101,7 @@ class compression_parameters {
 private:
     algorithm _algorithm;
     std::optional<int> _chunk_length;
+    bool _auto_chunk_length = false;
     std::optional<double> _crc_check_chance;
     std::optional<int> _zstd_compression_level;
 public:
@@ -101,6 +111,9 @@ class compression_parameters {
     ~compression_parameters();
 
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
+    // `chunk_length_in_kb: auto`: the chunk length of each sstable is picked
+    // by the table when the sstable is written, see pick_chunk_length().
+    bool auto_chunk_length() const { return _auto_chunk_length; }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
     algorithm get_algorithm() const { return _algorithm; }
     std::optional<int> zstd_compression_level() const { return _zstd_compression_level; }
@@ -119,6 +132,11 @@ class compression_parameters {
     }
     bool operator==(const compression_parameters&) const = default;
     static std::string_view algorithm_to_name(algorithm);
+
+    // The chunk length, between MIN_AUTO_CHUNK_LENGTH and MAX_AUTO_CHUNK_LENGTH,
+    // which is the cheapest for the observed reads of a table: the number of
+    // point reads, the bytes returned by range scans, and the mean partition size.
+    static int32_t pick_chunk_length(uint64_t point_reads, uint64_t scan_bytes, uint64_t partition_size);
     static std::string algorithm_to_qualified_name(algorithm);
 private:
     static void validate_options(const std::map<sstring, sstring>&);
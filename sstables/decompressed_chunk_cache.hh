@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "utils/assert.hh"
+#include "utils/bptree.hh"
+#include "utils/logalloc.hh"
+#include "utils/lru.hh"
+#include "sstables/decompressed_chunk_cache_stats.hh"
+
+namespace sstables {
+
+/// \brief A cache of the decompressed chunks of the data file of a compressed sstable.
+///
+/// Point reads which miss (or bypass) the row cache decompress the chunks
+/// holding their partition. When the same chunks are hit again and again,
+/// e.g. because the working set is slightly larger than the row cache,
+/// decompressing them is a large part of the cost of the read.
+///
+/// The chunks live in the cache region and are linked in the cache LRU,
+/// so they are evicted together with the row cache entries. Readers get
+/// copies of the chunks, so cached chunks are never pinned.
+///
+/// There is one cache per sstable, keyed by chunk index.
+class decompressed_chunk_cache {
+public:
+    using chunk_idx_type = uint64_t;
+private:
+    class cached_chunk final : public evictable {
+    public:
+        decompressed_chunk_cache* parent;
+        chunk_idx_type idx;
+        logalloc::lsa_buffer buf;
+    public:
+        cached_chunk(decompressed_chunk_cache* parent, chunk_idx_type idx, const temporary_buffer<char>& data)
+            : parent(parent)
+            , idx(idx)
+            , buf(parent->_region.alloc_buf(data.size()))
+        {
+            std::copy(data.begin(), data.end(), buf.get());
+        }
+
+        cached_chunk(cached_chunk&&) noexcept {
+            // Required by the generic bplus::tree, but the object is never
+            // moved, see cached_file::cached_page.
+            abort();
+        }
+
+        void on_evicted() noexcept override;
+    };
+
+    struct chunk_idx_less_comparator {
+        bool operator()(chunk_idx_type lhs, chunk_idx_type rhs) const noexcept {
+            return lhs < rhs;
+        }
+    };
+
+    using cache_type = bplus::tree<chunk_idx_type, cached_chunk, chunk_idx_less_comparator, 12, bplus::key_search::linear>;
+
+    decompressed_chunk_cache_stats& _stats;
+    lru& _lru;
+    logalloc::region& _region;
+    logalloc::allocating_section _as;
+    cache_type _cache;
+
+    cached_chunk* find(chunk_idx_type idx) noexcept {
+        auto i = _cache.find(idx);
+        return i != _cache.end() ? &*i : nullptr;
+    }
+
+    void on_evicted(cached_chunk& c) noexcept {
+        _stats.cached_bytes -= c.buf.size();
+        ++_stats.evictions;
+    }
+public:
+    decompressed_chunk_cache(decompressed_chunk_cache_stats& stats, lru& l, logalloc::region& reg)
+        : _stats(stats)
+        , _lru(l)
+        , _region(reg)
+        , _cache(chunk_idx_less_comparator())
+    { }
+
+    decompressed_chunk_cache(decompressed_chunk_cache&&) = delete; // captured this
+
+    ~decompressed_chunk_cache() {
+        with_allocator(standard_allocator(), [this] {
+            auto i = _cache.begin();
+            while (i != _cache.end()) {
+                _lru.remove(*i);
+                on_evicted(*i);
+                i = i.erase(chunk_idx_less_comparator());
+            }
+        });
+        SCYLLA_ASSERT(_cache.empty());
+    }
+
+    /// Returns a copy of the chunk, or an empty buffer if it's not cached.
+    temporary_buffer<char> get(chunk_idx_type idx) {
+        auto c = find(idx);
+        if (!c) {
+            ++_stats.misses;
+            return {};
+        }
+        // Allocating the copy may evict the chunk, or move its buffer.
+        temporary_buffer<char> out(c->buf.size());
+        c = find(idx);
+        if (!c) {
+            ++_stats.misses;
+            return {};
+        }
+        std::copy(c->buf.get(), c->buf.get() + c->buf.size(), out.get_write());
+        _lru.touch(*c);
+        ++_stats.hits;
+        return out;
+    }
+
+    /// Caches a copy of the decompressed chunk.
+    void put(chunk_idx_type idx, const temporary_buffer<char>& data) {
+        // _cache.emplace() needs to run under allocating section even though it lives in the std space
+        // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
+        auto [c, inserted] = _as(_region, [&] {
+            return _cache.emplace(idx, this, idx, data);
+        });
+        if (inserted) {
+            _lru.add(*c);
+            ++_stats.populations;
+            _stats.cached_bytes += c->buf.size();
+        }
+    }
+
+    future<> evict_gently() {
+        auto i = _cache.begin();
+        while (i != _cache.end()) {
+            _lru.remove(*i);
+            on_evicted(*i);
+            i = i.erase(chunk_idx_less_comparator());
+            if (need_preempt() && i != _cache.end()) {
+                auto key = i->idx;
+                co_await coroutine::maybe_yield();
+                i = _cache.lower_bound(key);
+            }
+        }
+    }
+};
+
+inline
+void decompressed_chunk_cache::cached_chunk::on_evicted() noexcept {
+    parent->on_evicted(*this);
+    with_allocator(standard_allocator(), [this] {
+        decompressed_chunk_cache::cache_type::iterator it(this);
+        it.erase(chunk_idx_less_comparator());
+    });
+}
+
+}
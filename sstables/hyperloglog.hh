@@ -49,6 +49,8 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <span>
+#include <optional>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/temporary_buffer.hh>
 
@@ -89,6 +91,20 @@ inline size_t write_unsigned_var_int(unsigned int value, uint8_t* to) {
     return size;
 }
 
+// Reads an unsigned var int written by write_unsigned_var_int() and advances
+// `from` past it.
+inline std::optional<unsigned int> read_unsigned_var_int(std::span<const uint8_t>& from) {
+    unsigned int value = 0;
+    for (size_t i = 0; i < 5 && i < from.size(); ++i) {
+        value |= unsigned(from[i] & 0x7F) << (7 * i);
+        if (!(from[i] & 0x80)) {
+            from = from.subspan(i + 1);
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
 /** @class HyperLogLog
  *  @brief Implement of 'HyperLogLog' estimate cardinality algorithm
  */
@@ -128,11 +144,31 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
-    static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+    /**
+     * Creates a HyperLogLog from the bytes returned by get_bytes(), e.g. the
+     * cardinality data of the compaction metadata of an sstable.
+     *
+     * @return disengaged optional if the bytes are not in the format written
+     *         by get_bytes(). Cassandra writes a bit-packed register set of
+     *         HyperLogLog++ which isn't supported.
+     */
+    static std::optional<HyperLogLog> from_bytes(std::span<const uint8_t> bytes) {
+        static constexpr int version = 2;
+
+        if (bytes.size() < sizeof(int32_t) || read_be<int32_t>(reinterpret_cast<const char*>(bytes.data())) != -version) {
+            return std::nullopt;
+        }
+        bytes = bytes.subspan(sizeof(int32_t));
+        auto b = read_unsigned_var_int(bytes);
+        auto sp = read_unsigned_var_int(bytes);
+        auto type = read_unsigned_var_int(bytes);
+        auto size = read_unsigned_var_int(bytes);
+        if (!b || !sp || !type || !size || *b < 4 || *b > 16 || *type != 0 || *size != (1u << *b) || bytes.size() != *size) {
+            return std::nullopt;
+        }
+        HyperLogLog hll(*b);
+        hll.restore_registers(bytes);
+        return hll;
     }
 
     /**
@@ -270,6 +306,32 @@ class HyperLogLog {
         return m_;
     }
 
+    /**
+     * Returns the registers, e.g. for keeping the estimator in a serialized form.
+     *
+     * @return Registers
+     */
+    std::span<const uint8_t> registers() const {
+        return M_;
+    }
+
+    /**
+     * Replaces the registers with ones previously returned by registers()
+     * of an estimator with the same bit width.
+     *
+     * @param[in] registers Registers to restore
+     *
+     * @exception std::invalid_argument number of registers doesn't match.
+     */
+    void restore_registers(std::span<const uint8_t> registers) {
+        if (registers.size() != m_) {
+            std::stringstream ss;
+            ss << "number of registers doesn't match: " << m_ << " != " << registers.size();
+            throw std::invalid_argument(ss.str().c_str());
+        }
+        std::copy(registers.begin(), registers.end(), M_.begin());
+    }
+
     /**
      * Exchanges the content of the instance
      *
@@ -12,6 +12,7 @@
 #include "downsampling.hh"
 #include "exceptions.hh"
 #include "sstables/partition_index_cache.hh"
+#include <deque>
 #include <seastar/util/bool_class.hh>
 #include <seastar/core/when_all.hh>
 #include "tracing/traced_file.hh"
@@ -515,7 +516,8 @@ std::unique_ptr<clustered_index_cursor> promoted_index::make_cursor(shared_sstab
         return std::make_unique<mc::bsearch_clustered_cursor>(*sst->get_schema(),
             _promoted_index_start, _promoted_index_size,
             promoted_index_cache_metrics, permit,
-            sst->get_column_translation(), cached_file_ptr, _num_blocks, trace_state, sst->features());
+            sst->get_column_translation(), cached_file_ptr, _num_blocks, trace_state, sst->features(),
+            caching ? sst->_promoted_index_block_cache.get() : nullptr);
     }
 
     auto file = make_tracked_index_file(*sst, permit, std::move(trace_state), caching);
@@ -530,10 +532,6 @@ class index_comparator {
 public:
     index_comparator(const schema& s) : _tri_cmp(s) {}
 
-    bool operator()(const summary_entry& e, dht::ring_position_view rp) const {
-        return _tri_cmp(e.get_decorated_key(), rp) < 0;
-    }
-
     bool operator()(const index_entry& e, dht::ring_position_view rp) const {
         return _tri_cmp(e.get_decorated_key(_tri_cmp.s), rp) < 0;
     }
@@ -546,15 +544,54 @@ class index_comparator {
         return operator()(rp, *e);
     }
 
-    bool operator()(dht::ring_position_view rp, const summary_entry& e) const {
-        return _tri_cmp(e.get_decorated_key(), rp) > 0;
-    }
-
     bool operator()(dht::ring_position_view rp, const index_entry& e) const {
         return _tri_cmp(e.get_decorated_key(_tri_cmp.s), rp) > 0;
     }
 };
 
+// Lookups of entry indexes in the summary.
+// The tokens are compared first, keys are decoded only on token ties.
+class summary_comparator {
+    const summary& _summary;
+    dht::ring_position_comparator_for_sstables _tri_cmp;
+
+    std::strong_ordering tri_compare(size_t idx, dht::ring_position_view rp) const {
+        auto token = _summary.entries[idx].get_token();
+        if (auto r = token <=> rp.token(); r != 0) {
+            return r;
+        }
+        auto key = _summary.key_at(idx);
+        return _tri_cmp(decorated_key_view(token, key_view(key)), rp);
+    }
+
+    template <typename Pred>
+    size_t partition_point(size_t first, Pred pred) const {
+        size_t count = _summary.entries.size() - first;
+        while (count > 0) {
+            auto step = count / 2;
+            if (pred(first + step)) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+public:
+    summary_comparator(const schema& s, const summary& summary) : _summary(summary), _tri_cmp(s) {}
+
+    // Returns the index of the first entry, starting at `first`, which is not less than rp.
+    size_t lower_bound(size_t first, dht::ring_position_view rp) const {
+        return partition_point(first, [&] (size_t idx) { return tri_compare(idx, rp) < 0; });
+    }
+
+    // Returns the index of the first entry, starting at `first`, which is greater than rp.
+    size_t upper_bound(size_t first, dht::ring_position_view rp) const {
+        return partition_point(first, [&] (size_t idx) { return tri_compare(idx, rp) <= 0; });
+    }
+};
+
 // Contains information about index_reader position in the index file
 struct index_bound {
     index_bound() = default;
@@ -635,6 +672,21 @@ class index_reader final : public abstract_index_reader {
     // Upper bound may remain uninitialized
     std::optional<index_bound> _upper_bound;
 
+    // Read-ahead of index pages for sequential scans, see maybe_read_ahead().
+    // Uses its own input stream, so that it doesn't disturb the lower bound's.
+    index_bound _read_ahead_bound;
+    // Pages read ahead which the lower bound didn't reach yet, kept alive so that
+    // they're not evicted before they're used.
+    std::deque<std::pair<uint64_t, partition_index_cache::entry_ptr>> _read_ahead_pages;
+    future<> _read_ahead = make_ready_future<>();
+    // Summary index of the next page to read ahead.
+    uint64_t _read_ahead_next_idx = 0;
+    // Number of times in a row the lower bound moved to the next page.
+    unsigned _sequential_pages = 0;
+
+    // Number of subsequent page advances after which read-ahead starts.
+    static constexpr unsigned read_ahead_threshold = 2;
+
 private:
     bool bound_eof(const index_bound& b) const {
         return b.data_file_position == data_file_end();
@@ -658,21 +710,9 @@ class index_reader final : public abstract_index_reader {
         return reset_clustered_cursor(bound);
     }
 
-    // Must be called for non-decreasing summary_idx.
-    future<> advance_to_page(index_bound& bound, uint64_t summary_idx) {
-        sstlog.trace("index {}: advance_to_page({}), bound {}", fmt::ptr(this), summary_idx, fmt::ptr(&bound));
-        parse_assert(!bound.current_list || bound.current_summary_idx <= summary_idx, _sstable->index_filename());
-        if (bound.current_list && bound.current_summary_idx == summary_idx) {
-            sstlog.trace("index {}: same page", fmt::ptr(this));
-            return make_ready_future<>();
-        }
-
-        auto& summary = _sstable->get_summary();
-        if (summary_idx >= summary.header.size) {
-            sstlog.trace("index {}: eof", fmt::ptr(this));
-            return advance_to_end(bound);
-        }
-        auto loader = [this, &bound] (uint64_t summary_idx) -> future<index_list> {
+    // Returns a loader of index pages for partition_index_cache, which reads them with the input stream of the bound.
+    auto page_loader(index_bound& bound) {
+        return [this, &bound] (uint64_t summary_idx) -> future<index_list> {
             auto& summary = _sstable->get_summary();
             uint64_t position = summary.entries[summary_idx].position;
             uint64_t quantity = downsampling::get_effective_index_interval_after_index(summary_idx, summary.header.sampling_level,
@@ -699,8 +739,73 @@ class index_reader final : public abstract_index_reader {
                 });
             });
         };
+    }
 
-        return _index_cache.get_or_load(summary_idx, loader).then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
+    future<> read_ahead_pages(uint64_t first, uint64_t last) {
+        auto& stats = _sstable->manager().get_cache_tracker().get_partition_index_cache_stats();
+        try {
+            for (auto idx = first; idx < last; ++idx) {
+                if (_index_cache.contains(idx)) {
+                    continue;
+                }
+                ++stats.read_aheads;
+                auto page = co_await _index_cache.get_or_load(idx, page_loader(_read_ahead_bound));
+                _read_ahead_pages.emplace_back(idx, std::move(page));
+            }
+        } catch (...) {
+            // The lower bound will retry reading the page, and report the error if it persists.
+            sstlog.debug("index {}: failed reading ahead index pages of {}: {}", fmt::ptr(this), _sstable->get_filename(), std::current_exception());
+        }
+    }
+
+    // Called when the lower bound moves to the summary_idx page. Once the lower bound
+    // moved to the next page read_ahead_threshold times in a row, reads pages
+    // following summary_idx in the background, twice as many on every further move,
+    // up to global_index_read_ahead_pages. Never reads past the upper bound's page,
+    // so stays within the range being read.
+    void maybe_read_ahead(uint64_t summary_idx) {
+        while (!_read_ahead_pages.empty() && _read_ahead_pages.front().first <= summary_idx) {
+            _read_ahead_pages.pop_front();
+        }
+        uint32_t max_pages = global_index_read_ahead_pages();
+        if (_single_page_read || _sequential_pages < read_ahead_threshold || !max_pages || !_read_ahead.available()) {
+            return;
+        }
+        uint64_t end = _sstable->get_summary().header.size;
+        if (_upper_bound && !bound_eof(*_upper_bound)) {
+            end = std::min(end, _upper_bound->current_list ? _upper_bound->current_summary_idx + 1 : 0);
+        }
+        uint64_t window = std::min<uint64_t>(max_pages, uint64_t(1) << std::min(_sequential_pages - read_ahead_threshold, 31u));
+        uint64_t first = std::max(_read_ahead_next_idx, summary_idx + 1);
+        uint64_t last = std::min(end, summary_idx + 1 + window);
+        if (first >= last) {
+            return;
+        }
+        sstlog.trace("index {}: reading ahead pages [{}, {})", fmt::ptr(this), first, last);
+        _read_ahead_next_idx = last;
+        _read_ahead = read_ahead_pages(first, last);
+    }
+
+    // Must be called for non-decreasing summary_idx.
+    future<> advance_to_page(index_bound& bound, uint64_t summary_idx) {
+        sstlog.trace("index {}: advance_to_page({}), bound {}", fmt::ptr(this), summary_idx, fmt::ptr(&bound));
+        parse_assert(!bound.current_list || bound.current_summary_idx <= summary_idx, _sstable->index_filename());
+        if (bound.current_list && bound.current_summary_idx == summary_idx) {
+            sstlog.trace("index {}: same page", fmt::ptr(this));
+            return make_ready_future<>();
+        }
+
+        auto& summary = _sstable->get_summary();
+        if (summary_idx >= summary.header.size) {
+            sstlog.trace("index {}: eof", fmt::ptr(this));
+            return advance_to_end(bound);
+        }
+        auto f = _index_cache.get_or_load(summary_idx, page_loader(bound));
+        if (&bound == &_lower_bound) {
+            _sequential_pages = bound.current_list && summary_idx == bound.current_summary_idx + 1 ? _sequential_pages + 1 : 0;
+            maybe_read_ahead(summary_idx);
+        }
+        return std::move(f).then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
             bound.current_list = std::move(ref);
             bound.current_summary_idx = summary_idx;
             bound.current_index_idx = 0;
@@ -803,8 +908,7 @@ class index_reader final : public abstract_index_reader {
         }
 
         auto& summary = _sstable->get_summary();
-        bound.previous_summary_idx = std::distance(std::begin(summary.entries),
-            std::upper_bound(summary.entries.begin() + bound.previous_summary_idx, summary.entries.end(), pos, index_comparator(*_sstable->_schema)));
+        bound.previous_summary_idx = summary_comparator(*_sstable->_schema, summary).upper_bound(bound.previous_summary_idx, pos);
 
         if (bound.previous_summary_idx == 0) {
             sstlog.trace("index {}: first entry", fmt::ptr(this));
@@ -1125,6 +1229,21 @@ class index_reader final : public abstract_index_reader {
     // If upper_bound is provided, the upper bound within position is looked up
     future<bool> advance_lower_and_check_if_present(dht::ring_position_view key) override {
         utils::get_local_injector().inject("advance_lower_and_check_if_present", [] { throw std::runtime_error("advance_lower_and_check_if_present"); });
+        if (_sstable->has_bti_partition_index() && key.key() && key.weight() == 0) {
+            // The trie rejects most of the keys which passed the bloom filter
+            // by mistake without touching Index.db.
+            return _sstable->bti_partition_position(dht::decorated_key(key.token(), *key.key())).then([this, key] (std::optional<uint64_t> pos) {
+                if (!pos) {
+                    _sstable->get_stats().on_bti_partition_index_rejection();
+                    return make_ready_future<bool>(false);
+                }
+                return advance_lower_and_check_if_present_in_index(key);
+            });
+        }
+        return advance_lower_and_check_if_present_in_index(key);
+    }
+
+    future<bool> advance_lower_and_check_if_present_in_index(dht::ring_position_view key) {
         return advance_to(_lower_bound, key).then([this, key] {
             if (eof()) {
                 return make_ready_future<bool>(false);
@@ -1272,10 +1391,14 @@ class index_reader final : public abstract_index_reader {
     const shared_sstable& sstable() const { return _sstable; }
 
     future<> close() noexcept override {
+        // read_ahead_pages() doesn't fail
+        co_await std::exchange(_read_ahead, make_ready_future<>());
+        _read_ahead_pages.clear();
         // index_bound::close must not fail
         auto close_lb = close(_lower_bound);
         auto close_ub = _upper_bound ? close(*_upper_bound) : make_ready_future<>();
-        return when_all(std::move(close_lb), std::move(close_ub)).discard_result().finally([this] {
+        auto close_ra = close(_read_ahead_bound);
+        co_await when_all(std::move(close_lb), std::move(close_ub), std::move(close_ra)).discard_result().finally([this] {
             if (_local_index_cache) {
                 return _local_index_cache->evict_gently();
             }
@@ -121,8 +121,8 @@ class metadata_collector {
     static constexpr double NO_COMPRESSION_RATIO = -1.0;
 
     static hll::HyperLogLog hyperloglog(int p, int sp) {
-        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring parameters by the time being.
-        return hll::HyperLogLog();
+        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring sp by the time being.
+        return hll::HyperLogLog(p);
     }
 private:
     const schema& _schema;
@@ -150,11 +150,13 @@ class metadata_collector {
 
     /**
      * Default cardinality estimation method is to use HyperLogLog++.
-     * Parameter here(p=13, sp=25) should give reasonable estimation
-     * while lowering bytes required to hold information.
-     * See CASSANDRA-5906 for detail.
+     * Cassandra uses p=13, sp=25, see CASSANDRA-5906 for detail. Without
+     * the sparse format, every register takes a byte of the Statistics
+     * component, which is kept in memory for the lifetime of the sstable,
+     * so p=10 is used: 1KB per sstable for a standard error of ~3%, which
+     * is good enough for sizing the bloom filters of compaction output.
      */
-    hll::HyperLogLog _cardinality = hyperloglog(13, 25);
+    hll::HyperLogLog _cardinality = hyperloglog(10, 25);
 private:
     void convert(disk_array<uint32_t, disk_string<uint16_t>>&to, const std::optional<position_in_partition>& from);
 public:
@@ -11,6 +11,7 @@
 #include "sstables/index_entry.hh"
 #include "sstables/column_translation.hh"
 #include "parsers.hh"
+#include "promoted_index_block_cache.hh"
 #include "schema/schema.hh"
 #include "utils/cached_file.hh"
 #include "utils/to_string.hh"
@@ -169,6 +170,8 @@ class cached_promoted_index {
     metrics& _metrics;
     const pi_index_type _blocks_count;
     cached_file& _cached_file;
+    // Blocks parsed by earlier cursors, outlives this cursor. May be null.
+    promoted_index_block_cache* _block_cache;
     data_consumer::primitive_consumer_impl<Buffer> _primitive_parser;
     u32_parser _u32_parser;
     column_translation _ctr;
@@ -244,6 +247,17 @@ class cached_promoted_index {
             return make_ready_future<promoted_index_block*>(const_cast<promoted_index_block*>(&*i));
         }
         ++_metrics.misses_l0;
+        if (_block_cache) {
+            promoted_index_block block(idx, 0);
+            if (_block_cache->get(_promoted_index_start, block)) {
+                auto mem_usage = block.memory_usage();
+                auto it = this->_blocks.emplace_hint(i, std::move(block));
+                _metrics.used_bytes += mem_usage;
+                ++_metrics.block_count;
+                ++_metrics.populations;
+                return make_ready_future<promoted_index_block*>(const_cast<promoted_index_block*>(&*it));
+            }
+        }
         return read_block_offset(idx, trace_state).then([this, idx, hint = i] (pi_offset_type offset) {
             auto i = this->_blocks.emplace_hint(hint, idx, offset);
             _metrics.used_bytes += sizeof(promoted_index_block);
@@ -270,7 +284,8 @@ class cached_promoted_index {
             reader_permit permit,
             column_translation ctr,
             cached_file& f,
-            pi_index_type blocks_count)
+            pi_index_type blocks_count,
+            promoted_index_block_cache* block_cache = nullptr)
         : _blocks(block_comparator{s})
         , _s(s)
         , _promoted_index_start(promoted_index_start)
@@ -278,6 +293,7 @@ class cached_promoted_index {
         , _metrics(m)
         , _blocks_count(blocks_count)
         , _cached_file(f)
+        , _block_cache(block_cache)
         , _primitive_parser(permit)
         , _u32_parser(_primitive_parser)
         , _ctr(std::move(ctr))
@@ -402,6 +418,9 @@ future<> cached_promoted_index::read_block_start(promoted_index_block& block, tr
         block.start.emplace(_clustering_parser.get_and_reset());
         sstlog.trace("cached_promoted_index {}: read_block_start: {}", fmt::ptr(this), block);
         _metrics.used_bytes += block.memory_usage() - mem_before;
+        if (_block_cache) {
+            _block_cache->put(_promoted_index_start, block);
+        }
     });
 }
 
@@ -416,6 +435,9 @@ future<> cached_promoted_index::read_block(promoted_index_block& block, tracing:
         block.width = _block_parser.width();
         _metrics.used_bytes += block.memory_usage() - mem_before;
         sstlog.trace("cached_promoted_index {}: read_block: {}", fmt::ptr(this), block);
+        if (_block_cache) {
+            _block_cache->put(_promoted_index_start, block);
+        }
     });
 }
 
@@ -518,7 +540,8 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             seastar::shared_ptr<cached_file> f,
             pi_index_type blocks_count,
             tracing::trace_state_ptr trace_state,
-            sstable_enabled_features features)
+            sstable_enabled_features features,
+            promoted_index_block_cache* block_cache = nullptr)
         : _s(s)
         , _blocks_count(blocks_count)
         , _cached_file(std::move(f))
@@ -529,7 +552,8 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             std::move(permit),
             std::move(ctr),
             *_cached_file,
-            blocks_count)
+            blocks_count,
+            block_cache)
         , _trace_state(std::move(trace_state))
         , _features(features)
     { }
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "mutation/position_in_partition.hh"
+#include "sstables/types.hh"
+#include "sstables/promoted_index_block_cache_stats.hh"
+#include "utils/bptree.hh"
+#include "utils/logalloc.hh"
+#include "utils/lru.hh"
+
+namespace sstables::mc {
+
+/// \brief A cache of the parsed promoted index blocks of an sstable.
+///
+/// cached_promoted_index keeps the blocks it parsed only for the lifetime of
+/// a single cursor. Reads which slice the same large partition over and over
+/// would parse the same blocks again on every read, even though the index
+/// pages they come from are cached by cached_file.
+///
+/// The blocks are kept in the cache region, keyed by the position of the
+/// promoted index of their partition in the index file and by the block
+/// index, and are linked in the cache LRU, so they are evicted together
+/// with the row cache and the index pages. Cursors get copies of the blocks.
+///
+/// There is one cache per sstable.
+class promoted_index_block_cache {
+public:
+    struct key_type {
+        uint64_t promoted_index_start;
+        uint32_t block_idx;
+    };
+private:
+    struct key_less_comparator {
+        bool operator()(const key_type& lhs, const key_type& rhs) const noexcept {
+            return std::tie(lhs.promoted_index_start, lhs.block_idx) < std::tie(rhs.promoted_index_start, rhs.block_idx);
+        }
+    };
+
+    // Allocated inside LSA. Has as many fields valid as the cursor which
+    // populated it parsed, see cached_promoted_index::promoted_index_block.
+    class entry final : public index_evictable {
+    public:
+        promoted_index_block_cache* parent;
+        key_type key;
+        uint32_t offset;
+        std::optional<position_in_partition> start;
+        std::optional<position_in_partition> end;
+        std::optional<deletion_time> end_open_marker;
+        uint64_t data_file_offset = 0;
+        uint64_t width = 0;
+        size_t size_in_allocator = 0;
+    public:
+        entry(promoted_index_block_cache* parent, key_type key, uint32_t offset) noexcept
+            : parent(parent)
+            , key(key)
+            , offset(offset)
+        { }
+
+        entry(entry&&) noexcept = default;
+
+        size_t memory_usage() const noexcept {
+            return sizeof(entry)
+                + (start ? start->external_memory_usage() : 0)
+                + (end ? end->external_memory_usage() : 0);
+        }
+
+        void on_evicted() noexcept override;
+    };
+
+    using cache_type = bplus::tree<key_type, entry, key_less_comparator, 8, bplus::key_search::binary>;
+
+    promoted_index_block_cache_stats& _stats;
+    lru& _lru;
+    logalloc::region& _region;
+    logalloc::allocating_section _as;
+    cache_type _cache;
+
+    void on_evicted(entry& e) noexcept {
+        _stats.used_bytes -= e.size_in_allocator;
+        ++_stats.evictions;
+    }
+public:
+    promoted_index_block_cache(promoted_index_block_cache_stats& stats, lru& l, logalloc::region& reg)
+        : _stats(stats)
+        , _lru(l)
+        , _region(reg)
+        , _cache(key_less_comparator())
+    { }
+
+    promoted_index_block_cache(promoted_index_block_cache&&) = delete; // captured this
+
+    ~promoted_index_block_cache() {
+        with_allocator(_region.allocator(), [&] {
+            _cache.clear_and_dispose([this] (entry* e) noexcept {
+                _lru.remove(*e);
+                on_evicted(*e);
+            });
+        });
+    }
+
+    /// Fills the fields of the block which are cached and not engaged in the block yet.
+    /// Returns false if the block is not cached, in which case the block is not modified.
+    template <typename Block>
+    bool get(uint64_t promoted_index_start, Block& block) {
+        return _as(_region, [&] {
+            auto i = _cache.find(key_type{promoted_index_start, block.index});
+            if (i == _cache.end()) {
+                ++_stats.misses;
+                return false;
+            }
+            block.offset = i->offset;
+            if (!block.start && i->start) {
+                block.start.emplace(*i->start);
+            }
+            if (!block.end && i->end) {
+                block.end.emplace(*i->end);
+                block.end_open_marker = i->end_open_marker;
+                block.data_file_offset = i->data_file_offset;
+                block.width = i->width;
+            }
+            _lru.touch(*i);
+            ++_stats.hits;
+            return true;
+        });
+    }
+
+    /// Caches the fields valid in the block which are not cached yet.
+    template <typename Block>
+    void put(uint64_t promoted_index_start, const Block& block) {
+        _as(_region, [&] {
+            with_allocator(_region.allocator(), [&] {
+                auto [i, inserted] = _cache.emplace(key_type{promoted_index_start, block.index}, this,
+                        key_type{promoted_index_start, block.index}, block.offset);
+                auto& e = *i;
+                if (inserted) {
+                    _lru.add(e);
+                    ++_stats.populations;
+                }
+                if (!e.start && block.start) {
+                    e.start.emplace(*block.start);
+                }
+                if (!e.end && block.end) {
+                    e.end.emplace(*block.end);
+                    e.end_open_marker = block.end_open_marker;
+                    e.data_file_offset = block.data_file_offset;
+                    e.width = block.width;
+                }
+                _stats.used_bytes -= e.size_in_allocator;
+                e.size_in_allocator = e.memory_usage();
+                _stats.used_bytes += e.size_in_allocator;
+            });
+        });
+    }
+
+    future<> evict_gently() {
+        auto i = _cache.begin();
+        while (i != _cache.end()) {
+            with_allocator(_region.allocator(), [&] {
+                _lru.remove(*i);
+                on_evicted(*i);
+                i = i.erase(key_less_comparator());
+            });
+            if (need_preempt() && i != _cache.end()) {
+                auto key = i->key;
+                co_await coroutine::maybe_yield();
+                i = _cache.lower_bound(key);
+            }
+        }
+    }
+};
+
+inline
+void promoted_index_block_cache::entry::on_evicted() noexcept {
+    parent->on_evicted(*this);
+    cache_type::iterator it(this);
+    it.erase(key_less_comparator());
+}
+
+}
@@ -14,6 +14,7 @@
 #include "sstables/m_format_read_helpers.hh"
 #include "sstables/sstable_mutation_reader.hh"
 #include "sstables/processing_result_generator.hh"
+#include "sstables/resume_positions.hh"
 #include "utils/to_string.hh"
 #include "utils/value_or_reference.hh"
 
@@ -34,6 +35,9 @@ class mp_row_consumer_reader_mx : public mp_row_consumer_reader_base, public mut
     }
 
     virtual data_consumer::proceed on_next_partition(dht::decorated_key, tombstone);
+    // Called before on_next_partition() for the partitions whose start the
+    // consumer parses from the data file.
+    virtual void on_partition_start_parsed(const dht::decorated_key&) { }
 };
 
 enum class row_processing_result {
@@ -75,6 +79,9 @@ class mp_row_consumer_m {
     };
     std::vector<cell> _cells;
     collection_mutation_description _cm;
+    // The static and regular columns selected by the slice, by ordinal id.
+    // Engaged only if the reader projects the columns, see project_columns.
+    std::optional<column_set> _selected_columns;
 
     data_consumer::proceed consume_range_tombstone_start(clustering_key_prefix ck, bound_kind k, tombstone t) {
         sstlog.trace("mp_row_consumer_m {}: consume_range_tombstone_start(ck={}, k={}, t={})", fmt::ptr(this), ck, k, t);
@@ -122,6 +129,10 @@ class mp_row_consumer_m {
         return _schema->column_at(column_type, *column_id);
     }
 
+    bool is_projected_out(const column_definition& column_def) const {
+        return _selected_columns && !_selected_columns->test(column_def.ordinal_id);
+    }
+
     inline data_consumer::proceed on_range_tombstone_change(position_in_partition pos, tombstone t) {
         sstlog.trace("mp_row_consumer_m {}: on_range_tombstone_change({}, {}->{})", fmt::ptr(this), pos,
                      _mf_filter->current_tombstone(), t);
@@ -192,7 +203,8 @@ class mp_row_consumer_m {
                         const query::partition_slice& slice,
                         tracing::trace_state_ptr trace_state,
                         streamed_mutation::forwarding fwd,
-                        const shared_sstable& sst)
+                        const shared_sstable& sst,
+                        project_columns projection = project_columns::no)
         : _permit(std::move(permit))
         , _sst(sst)
         , _trace_state(std::move(trace_state))
@@ -204,6 +216,15 @@ class mp_row_consumer_m {
             && (!sst->has_scylla_component() || sst->features().is_enabled(sstable_feature::CorrectStaticCompact))) // See #4139
     {
         _cells.reserve(std::max(_schema->static_columns_count(), _schema->regular_columns_count()));
+        if (projection) {
+            auto& selected = _selected_columns.emplace(_schema->all_columns_count());
+            for (auto id : _slice.static_columns) {
+                selected.set(_schema->static_column_at(id).ordinal_id);
+            }
+            for (auto id : _slice.regular_columns) {
+                selected.set(_schema->regular_column_at(id).ordinal_id);
+            }
+        }
     }
 
     mp_row_consumer_m(mp_row_consumer_reader_mx* reader,
@@ -299,6 +320,7 @@ class mp_row_consumer_m {
         setup_for_partition(pk);
         auto dk = dht::decorate_key(*_schema, pk);
 
+        _reader->on_partition_start_parsed(dk);
         auto should_proceed = _reader->on_next_partition(std::move(dk), tombstone(deltime));
         if (should_proceed == data_consumer::proceed::no) {
             return data_consumer::proceed::no;
@@ -394,6 +416,10 @@ class mp_row_consumer_m {
             return data_consumer::proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        if (is_projected_out(column_def)) {
+            // Keep the cell for its liveness, but don't copy the value nobody reads.
+            value = fragmented_temporary_buffer::view();
+        }
         if (column_def.is_multi_cell()) {
             auto& value_type = visit(*column_def.type, make_visitor(
                 [] (const collection_type_impl& ctype) -> const abstract_type& { return *ctype.value_comparator(); },
@@ -704,6 +730,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     const bool _has_shadowable_tombstones;
 
     temporary_buffer<char> _pk;
+    uint64_t _partition_start_position = 0;
 
     unfiltered_flags_m _flags{0};
     unfiltered_extended_flags_m _extended_flags{0};
@@ -742,6 +769,9 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     gc_clock::time_point _column_local_deletion_time;
     gc_clock::duration _column_ttl;
     fragmented_temporary_buffer _column_value;
+    // The value of the current cell, either in _column_value, or in place in
+    // the processed buffer when it was all there.
+    fragmented_temporary_buffer::view _column_value_view;
     temporary_buffer<char> _cell_path;
     uint64_t _ck_blocks_header;
     uint32_t _ck_blocks_header_offset;
@@ -764,6 +794,11 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
 
     processing_result_generator _gen;
     temporary_buffer<char>* _processing_data;
+
+    // The largest header of a cell of a simple column: the flags, and vints with
+    // the timestamp, the local deletion time, the ttl and the length of the value.
+    static constexpr size_t max_simple_cell_header_size = 1 + 4 * max_vint_length;
+
     void start_row(row_schema& rs) {
         _row = &rs;
         _row->_columns = _row->_all_columns;
@@ -843,6 +878,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             goto flags_label;
         }
         partition_start_label: {
+            _partition_start_position = this->position() - _processing_data->size();
             _is_first_unfiltered = true;
             _state = state::DELETION_TIME;
             co_yield this->read_short_length_bytes(*_processing_data, _pk);
@@ -1071,58 +1107,108 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                 }
                 _subcolumns_to_read = 0;
             }
-            co_yield this->read_8(*_processing_data);
-            _column_flags = column_flags_m(this->_u8);
-
-            if (_column_flags.use_row_timestamp()) {
-                _column_timestamp = _liveness.timestamp();
-            } else {
-                co_yield this->read_unsigned_vint(*_processing_data);
-                _column_timestamp = parse_timestamp(_header, this->_u64);
-            }
-            if (_column_flags.use_row_ttl()) {
-                _column_local_deletion_time = _liveness.local_deletion_time();
-            } else if (!_column_flags.is_deleted() && ! _column_flags.is_expiring()) {
-                _column_local_deletion_time = gc_clock::time_point::max();
-            } else {
-                co_yield this->read_unsigned_vint(*_processing_data);
-                _column_local_deletion_time = parse_expiry(_header, this->_u64);
-            }
-            if (_column_flags.use_row_ttl()) {
-                _column_ttl = _liveness.ttl();
-            } else if (!_column_flags.is_expiring()) {
-                _column_ttl = gc_clock::duration::zero();
-            } else {
-                co_yield this->read_unsigned_vint(*_processing_data);
-                _column_ttl = parse_ttl(_header, this->_u64);
-            }
-            if (!is_column_simple()) {
-                co_yield this->read_unsigned_vint_length_bytes_contiguous(*_processing_data, _cell_path);
-            } else {
+            if (is_column_simple() && _processing_data->size() >= max_simple_cell_header_size) {
+                // The whole header of the cell is in the buffer, so decode it
+                // in one pass, without going through the state machine.
+                auto src = reinterpret_cast<const int8_t*>(_processing_data->get());
+                const auto header_start = src;
+                _column_flags = column_flags_m(uint8_t(*src++));
+                if (_column_flags.use_row_timestamp()) {
+                    _column_timestamp = _liveness.timestamp();
+                } else {
+                    _column_timestamp = parse_timestamp(_header, unsigned_vint::deserialize_unchecked(src));
+                }
+                if (_column_flags.use_row_ttl()) {
+                    _column_local_deletion_time = _liveness.local_deletion_time();
+                } else if (!_column_flags.is_deleted() && ! _column_flags.is_expiring()) {
+                    _column_local_deletion_time = gc_clock::time_point::max();
+                } else {
+                    _column_local_deletion_time = parse_expiry(_header, unsigned_vint::deserialize_unchecked(src));
+                }
+                if (_column_flags.use_row_ttl()) {
+                    _column_ttl = _liveness.ttl();
+                } else if (!_column_flags.is_expiring()) {
+                    _column_ttl = gc_clock::duration::zero();
+                } else {
+                    _column_ttl = parse_ttl(_header, unsigned_vint::deserialize_unchecked(src));
+                }
                 _cell_path = temporary_buffer<char>(0);
-            }
-            if (!_column_flags.has_value()) {
-                _column_value = fragmented_temporary_buffer();
+                std::optional<uint32_t> value_length;
+                if (_column_flags.has_value()) {
+                    value_length = get_column_value_length();
+                    if (!value_length) {
+                        value_length = static_cast<uint32_t>(unsigned_vint::deserialize_unchecked(src));
+                    }
+                }
+                _processing_data->trim_front(src - header_start);
+                if (!value_length) {
+                    _column_value_view = fragmented_temporary_buffer::view();
+                } else if (_processing_data->size() >= *value_length) {
+                    // The cell is consumed before the buffer is advanced any further, so
+                    // the value can be referred to in place instead of sharing the buffer.
+                    // This covers all but a few values of the fixed-width columns.
+                    _column_value_view = fragmented_temporary_buffer::view(bytes_view(
+                            reinterpret_cast<const bytes::value_type*>(_processing_data->get()), *value_length));
+                    _processing_data->trim_front(*value_length);
+                } else {
+                    co_yield this->read_bytes(*_processing_data, *value_length, _column_value);
+                    _column_value_view = fragmented_temporary_buffer::view(_column_value);
+                }
             } else {
-                read_status status = read_status::waiting;
-                if (auto len = get_column_value_length()) {
-                    status = this->read_bytes(*_processing_data, *len, _column_value);
+                co_yield this->read_8(*_processing_data);
+                _column_flags = column_flags_m(this->_u8);
+
+                if (_column_flags.use_row_timestamp()) {
+                    _column_timestamp = _liveness.timestamp();
                 } else {
-                    status = this->read_unsigned_vint_length_bytes(*_processing_data, _column_value);
+                    co_yield this->read_unsigned_vint(*_processing_data);
+                    _column_timestamp = parse_timestamp(_header, this->_u64);
+                }
+                if (_column_flags.use_row_ttl()) {
+                    _column_local_deletion_time = _liveness.local_deletion_time();
+                } else if (!_column_flags.is_deleted() && ! _column_flags.is_expiring()) {
+                    _column_local_deletion_time = gc_clock::time_point::max();
+                } else {
+                    co_yield this->read_unsigned_vint(*_processing_data);
+                    _column_local_deletion_time = parse_expiry(_header, this->_u64);
+                }
+                if (_column_flags.use_row_ttl()) {
+                    _column_ttl = _liveness.ttl();
+                } else if (!_column_flags.is_expiring()) {
+                    _column_ttl = gc_clock::duration::zero();
+                } else {
+                    co_yield this->read_unsigned_vint(*_processing_data);
+                    _column_ttl = parse_ttl(_header, this->_u64);
+                }
+                if (!is_column_simple()) {
+                    co_yield this->read_unsigned_vint_length_bytes_contiguous(*_processing_data, _cell_path);
+                } else {
+                    _cell_path = temporary_buffer<char>(0);
+                }
+                if (!_column_flags.has_value()) {
+                    _column_value_view = fragmented_temporary_buffer::view();
+                } else {
+                    read_status status = read_status::waiting;
+                    if (auto len = get_column_value_length()) {
+                        status = this->read_bytes(*_processing_data, *len, _column_value);
+                    } else {
+                        status = this->read_unsigned_vint_length_bytes(*_processing_data, _column_value);
+                    }
+                    co_yield status;
+                    _column_value_view = fragmented_temporary_buffer::view(_column_value);
                 }
-                co_yield status;
             }
             _consuming = false;
             if (is_column_counter() && !_column_flags.is_deleted()) {
                 if (_consumer.consume_counter_column(get_column_info(),
-                                                     fragmented_temporary_buffer::view(_column_value),
+                                                     _column_value_view,
                                                      _column_timestamp) == data_consumer::proceed::no) {
                     co_yield data_consumer::proceed::no;
                 }
             } else {
                 if (_consumer.consume_column(get_column_info(),
                                              to_bytes_view(_cell_path),
-                                             fragmented_temporary_buffer::view(_column_value),
+                                             _column_value_view,
                                              _column_timestamp,
                                              _column_ttl,
                                              _column_local_deletion_time,
@@ -1251,6 +1337,11 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     reader_permit& permit() {
         return _consumer.permit();
     }
+
+    // The data file offset of the last partition whose start was parsed
+    uint64_t partition_start_position() const {
+        return _partition_start_position;
+    }
 };
 
 class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
@@ -1277,6 +1368,9 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     // of the reversing data source used underneath (see `partition_reversing_data_source`).
     // Engaged after `_context` is engaged, i.e. after `initialize()`.
     const uint64_t* _reversed_read_sstable_position;
+
+    // Engaged for range reads of evictable reads, see resume_positions.
+    std::optional<resume_positions::reader_positions> _resume_positions;
 public:
     mx_sstable_mutation_reader(shared_sstable sst,
                             schema_ptr schema,
@@ -1288,11 +1382,12 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                             mutation_reader::forwarding fwd_mr,
                             read_monitor& mon,
                             integrity_check integrity,
+                            project_columns projection,
                             std::unique_ptr<abstract_index_reader> ir = nullptr)
             : mp_row_consumer_reader_mx(std::move(schema), permit, std::move(sst))
             , _slice_holder(std::move(slice))
             , _slice(_slice_holder.get())
-            , _consumer(this, _schema, std::move(permit), _slice, std::move(trace_state), fwd, _sst)
+            , _consumer(this, _schema, std::move(permit), _slice, std::move(trace_state), fwd, _sst, projection)
             , _index_reader(std::move(ir))
             // FIXME: I want to add `&& fwd_mr == mutation_reader::forwarding::no` below
             // but can't because many call sites use the default value for
@@ -1377,6 +1472,9 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             return read_from_datafile();
         }
         auto key = dht::decorate_key(*_schema, std::move(*pk));
+        if (_resume_positions) {
+            _resume_positions->add(key, _index_reader->data_file_positions().start);
+        }
         _consumer.setup_for_partition(key.key());
         on_next_partition(std::move(key), tombstone(*tomb));
         return make_ready_future<>();
@@ -1523,6 +1621,9 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         }
 
         _will_likely_slice = will_likely_slice(_slice);
+        // The data file range of the resumed read, saved by the reader
+        // evicted before, see resume_positions.
+        std::optional<std::pair<uint64_t, uint64_t>> resumed_range;
 
         if (_single_partition_read) {
             _sst->get_stats().on_single_partition_read();
@@ -1562,11 +1663,27 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             }
         } else {
             _sst->get_stats().on_range_partition_read();
-            co_await get_index_reader().advance_to(_pr);
+            if (auto* permit_positions = _consumer.permit().sstable_resume_positions()) {
+                if (auto saved = permit_positions->take(_sst->generation())) {
+                    resumed_range = saved->find(*_schema, _pr);
+                }
+                _resume_positions.emplace();
+                _resume_positions->range_end = _pr.get().end();
+            }
+            if (resumed_range) {
+                _sst->get_stats().on_range_partition_read_resumed();
+            } else {
+                co_await get_index_reader().advance_to(_pr);
+            }
         }
 
-        auto [begin, end] = _index_reader->data_file_positions();
+        auto [begin, end] = resumed_range
+                ? data_file_positions_range{resumed_range->first, resumed_range->second}
+                : _index_reader->data_file_positions();
         parse_assert(bool(end), _sst->get_filename());
+        if (_resume_positions) {
+            _resume_positions->data_end = *end;
+        }
 
         sstlog.trace("sstable_reader: {}: data file range [{}, {})", fmt::ptr(this), begin, *end);
 
@@ -1600,7 +1717,8 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         }
 
         _monitor.on_read_started(_context->reader_position());
-        _index_in_current_partition = true;
+        // The index wasn't looked up for a resumed read.
+        _index_in_current_partition = !resumed_range;
         co_return true;
     }
     future<> skip_to(indexable_element el, uint64_t begin) {
@@ -1653,8 +1771,10 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                 _partition_finished = true;
                 _before_partition = true;
                 _end_of_stream = false;
-                parse_assert(bool(_index_reader), _sst->get_filename());
-                auto f1 = _index_reader->advance_to(pr);
+                // The partitions of the new range don't directly follow
+                // the ones read so far.
+                _resume_positions.reset();
+                auto f1 = get_index_reader().advance_to(pr);
                 return f1.then([this] {
                     auto [start, end] = _index_reader->data_file_positions();
                     parse_assert(bool(end), _sst->get_filename());
@@ -1785,6 +1905,17 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         }
     }
     virtual future<> close() noexcept override {
+        if (_resume_positions && !_resume_positions->partitions.empty()) {
+            if (auto* permit_positions = _permit.sstable_resume_positions()) {
+                try {
+                    permit_positions->save(_sst->generation(), std::move(*_resume_positions));
+                } catch (...) {
+                    // Only makes resuming the read after eviction cheaper.
+                    sstlog.debug("Failed to save the resume positions of sstable {}: {}", _sst->get_filename(), std::current_exception());
+                }
+            }
+            _resume_positions.reset();
+        }
         auto close_context = make_ready_future<>();
         if (_context) {
             _monitor.on_read_completed();
@@ -1845,6 +1976,12 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             return mp_row_consumer_reader_mx::on_next_partition(std::move(key), tomb);
         }
     }
+
+    void on_partition_start_parsed(const dht::decorated_key& key) override {
+        if (_resume_positions) {
+            _resume_positions->add(key, _context->partition_start_position());
+        }
+    }
 };
 
 static mutation_reader make_reader(
@@ -1858,10 +1995,11 @@ static mutation_reader make_reader(
         mutation_reader::forwarding fwd_mr,
         read_monitor& monitor,
         integrity_check integrity,
+        project_columns projection,
         std::unique_ptr<abstract_index_reader> ir = nullptr) {
     return make_mutation_reader<mx_sstable_mutation_reader>(
         std::move(sstable), std::move(schema), std::move(permit), range,
-        std::move(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity, std::move(ir));
+        std::move(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity, projection, std::move(ir));
 }
 
 mutation_reader make_reader(
@@ -1874,9 +2012,10 @@ mutation_reader make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& monitor,
-        integrity_check integrity) {
+        integrity_check integrity,
+        project_columns projection) {
     return make_reader(std::move(sstable), std::move(schema), std::move(permit), range,
-            value_or_reference(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity);
+            value_or_reference(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity, projection);
 }
 
 mutation_reader make_reader(
@@ -1889,9 +2028,10 @@ mutation_reader make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& monitor,
-        integrity_check integrity) {
+        integrity_check integrity,
+        project_columns projection) {
     return make_reader(std::move(sstable), std::move(schema), std::move(permit), range,
-            value_or_reference(std::move(slice)), std::move(trace_state), fwd, fwd_mr, monitor, integrity);
+            value_or_reference(std::move(slice)), std::move(trace_state), fwd, fwd_mr, monitor, integrity, projection);
 }
 
 mutation_reader make_reader_with_index_reader(
@@ -1907,7 +2047,7 @@ mutation_reader make_reader_with_index_reader(
         integrity_check integrity,
         std::unique_ptr<abstract_index_reader> ir) {
     return make_reader(std::move(sstable), std::move(schema), std::move(permit), range,
-            value_or_reference(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity, std::move(ir));
+            value_or_reference(slice), std::move(trace_state), fwd, fwd_mr, monitor, integrity, project_columns::no, std::move(ir));
 }
 
 /// a reader which does not support seeking to given position.
@@ -20,6 +20,13 @@ namespace mx {
 // Precondition: if the slice is reversed, the schema must be reversed as well
 // and the range must be singular (`range.is_singular()`).
 // Fast-forwarding is not supported in reversed queries (FIXME).
+//
+// With project_columns::yes, the cells of the static and regular columns not
+// selected by the slice are emitted with their metadata (timestamp, ttl,
+// deletion), so that they still count towards the liveness of the rows and
+// reconcile with other sources, but without their values, which are not
+// copied out of the data file. The output of such readers is only good for
+// querying the selected columns, it must not be cached or written.
 mutation_reader make_reader(
         shared_sstable sstable,
         schema_ptr schema,
@@ -30,7 +37,8 @@ mutation_reader make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& monitor,
-        integrity_check integrity);
+        integrity_check integrity,
+        project_columns projection = project_columns::no);
 
 // Same as above but the slice is moved and stored inside the reader.
 mutation_reader make_reader(
@@ -43,7 +51,8 @@ mutation_reader make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& monitor,
-        integrity_check integrity);
+        integrity_check integrity,
+        project_columns projection = project_columns::no);
 
 mutation_reader make_reader_with_index_reader(
         shared_sstable sstable,
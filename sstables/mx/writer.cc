@@ -14,6 +14,7 @@
 #include "vint-serialization.hh"
 #include "sstables/types.hh"
 #include "sstables/mx/types.hh"
+#include "sstables/trie/bti_partition_index.hh"
 #include "mutation/atomic_cell.hh"
 #include "utils/assert.hh"
 #include "utils/exceptions.hh"
@@ -532,6 +533,9 @@ class writer : public sstable_writer::writer_impl {
     bool _compression_enabled = false;
     std::unique_ptr<file_writer> _data_writer;
     std::unique_ptr<file_writer> _index_writer;
+    // Set if the BTI partition index (PartitionTrie.db) is written too.
+    std::unique_ptr<file_writer> _partitions_writer;
+    std::unique_ptr<trie::bti_partition_index_writer> _bti_partition_index;
     bool _tombstone_written = false;
     bool _static_row_written = false;
     // The length of partition header (partition key, partition deletion and static row, if present)
@@ -794,6 +798,10 @@ class writer : public sstable_writer::writer_impl {
         // exactly what callers used to do anyway.
         estimated_partitions = std::max(uint64_t(1), estimated_partitions);
 
+        if (cfg.write_bti_partition_index) {
+            // Must be recognized before the temporary TOC is written.
+            _sst._recognized_components.insert(component_type::PartitionTrie);
+        }
         _sst.open_sstable(cfg.origin);
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
@@ -801,7 +809,8 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format,
+                _sst._schema->bloom_filter_layout());
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
@@ -828,6 +837,8 @@ writer::~writer() {
             }
         }
     };
+    _bti_partition_index.reset();
+    close_writer(_partitions_writer);
     close_writer(_index_writer);
     close_writer(_data_writer);
 }
@@ -891,11 +902,19 @@ void writer::init_file_writers() {
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
                 _sst._schema->get_compressor_params(),
-                std::move(compressor)), _sst.get_filename());
+                std::move(compressor),
+                _cfg.compression_chunk_length), _sst.get_filename());
     }
 
     out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index).get();
     _index_writer = std::make_unique<file_writer>(output_stream<char>(std::move(out)), _sst.index_filename());
+
+    if (_sst.has_component(component_type::PartitionTrie)) {
+        file_output_stream_options options;
+        options.buffer_size = _sst.sstable_buffer_size;
+        _partitions_writer = std::make_unique<file_writer>(_sst.make_component_file_writer(component_type::PartitionTrie, std::move(options)).get());
+        _bti_partition_index = std::make_unique<trie::bti_partition_index_writer>(*_partitions_writer);
+    }
 }
 
 std::unique_ptr<file_writer> writer::close_writer(std::unique_ptr<file_writer>& w) {
@@ -935,6 +954,9 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     // and collecting the sample of columns.
     write(_sst.get_version(), *_index_writer, p_key);
     write_vint(*_index_writer, _data_writer->offset());
+    if (_bti_partition_index) {
+        _bti_partition_index->add(_schema, dk, _data_writer->offset());
+    }
 
     _pi_write_m.first_entry.reset();
     _pi_write_m.blocks.clear();
@@ -1510,6 +1532,11 @@ void writer::consume_end_of_stream() {
     }
 
     close_writer(_index_writer);
+    if (_bti_partition_index) {
+        _bti_partition_index->finish();
+        _bti_partition_index.reset();
+        _sst._metadata_size_on_disk += close_writer(_partitions_writer)->offset();
+    }
     _sst.set_first_and_last_keys();
 
     _sst._components->statistics.contents[metadata_type::Serialization] = std::make_unique<serialization_header>(std::move(_sst_schema.header));
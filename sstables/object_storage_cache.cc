@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/coroutine/exception.hh>
+
+#include "sstables/object_storage_cache.hh"
+
+namespace sstables {
+
+object_storage_cache::object_storage_cache(size_t capacity)
+    : _capacity(capacity)
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("object_storage_cache", {
+        sm::make_counter("hits", _stats.hits,
+                sm::description("Number of block reads of sstable components in object storage served from the cache")),
+        sm::make_counter("misses", _stats.misses,
+                sm::description("Number of block reads of sstable components in object storage which had to read the object")),
+        sm::make_counter("bytes_hit", _stats.bytes_hit,
+                sm::description("Number of bytes of sstable components in object storage served from the cache")),
+        sm::make_counter("bytes_fetched", _stats.bytes_fetched,
+                sm::description("Number of bytes of sstable components read from object storage into the cache")),
+        sm::make_counter("evictions", _stats.evictions,
+                sm::description("Number of blocks evicted from the cache")),
+        sm::make_gauge("used_bytes", [this] { return _used; },
+                sm::description("Memory used by the cached blocks")),
+    });
+}
+
+object_storage_cache::~object_storage_cache() = default;
+
+void object_storage_cache::set_capacity(size_t capacity) noexcept {
+    _capacity = capacity;
+    evict();
+}
+
+void object_storage_cache::touch(block& b) noexcept {
+    b.lru_link.unlink();
+    (b.pinned ? _pinned_lru : _lru).push_back(b);
+}
+
+void object_storage_cache::insert(block_key key, temporary_buffer<char> data, bool pinned) {
+    if (data.empty() || data.size() > _capacity) {
+        return;
+    }
+    auto [it, inserted] = _blocks.try_emplace(std::move(key));
+    if (!inserted) {
+        return;
+    }
+    auto& b = it->second;
+    b.key = &it->first;
+    b.pinned = pinned;
+    _used += data.size();
+    b.data = std::move(data);
+    (pinned ? _pinned_lru : _lru).push_back(b);
+    evict();
+}
+
+void object_storage_cache::evict() noexcept {
+    while (_used > _capacity) {
+        auto& lru = _lru.empty() ? _pinned_lru : _lru;
+        if (lru.empty()) {
+            break;
+        }
+        auto& b = lru.front();
+        _used -= b.data.size();
+        ++_stats.evictions;
+        _blocks.erase(_blocks.find(*b.key));
+    }
+}
+
+future<temporary_buffer<char>> object_storage_cache::get_block(file& f, const sstring& object_name, uint64_t index, bool pinned) {
+    block_key key{object_name, index};
+    for (;;) {
+        if (auto it = _blocks.find(key); it != _blocks.end()) {
+            ++_stats.hits;
+            _stats.bytes_hit += it->second.data.size();
+            touch(it->second);
+            co_return it->second.data.share();
+        }
+        auto pending = _pending.find(key);
+        if (pending == _pending.end()) {
+            break;
+        }
+        // The block may be evicted right after it's read if the cache is
+        // small, in which case we read it ourselves.
+        co_await pending->second.get_future();
+    }
+
+    ++_stats.misses;
+    if (!enabled()) {
+        co_return co_await f.dma_read_bulk<char>(index * block_size, block_size);
+    }
+    promise<> read_done;
+    _pending.emplace(key, read_done.get_future());
+    std::exception_ptr ex;
+    temporary_buffer<char> data;
+    try {
+        data = co_await f.dma_read_bulk<char>(index * block_size, block_size);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    _pending.erase(key);
+    if (ex) {
+        read_done.set_exception(ex);
+        co_return coroutine::exception(std::move(ex));
+    }
+    _stats.bytes_fetched += data.size();
+    insert(std::move(key), data.share(), pinned);
+    read_done.set_value();
+    co_return data;
+}
+
+void object_storage_cache::invalidate(const sstring& object_name) noexcept {
+    auto it = _blocks.lower_bound(block_key{object_name, 0});
+    while (it != _blocks.end() && it->first.first == object_name) {
+        _used -= it->second.data.size();
+        it = _blocks.erase(it);
+    }
+}
+
+namespace {
+
+class cached_object_file : public file_impl {
+    object_storage_cache& _cache;
+    file _file;
+    sstring _object_name;
+    bool _pinned;
+    // Objects are immutable, so there's no need to ask for the size more than once.
+    std::optional<uint64_t> _size;
+
+    future<size_t> read(uint64_t pos, char* buffer, size_t len) {
+        size_t done = 0;
+        while (done < len) {
+            auto block_pos = pos + done;
+            auto offset = block_pos % object_storage_cache::block_size;
+            auto b = co_await _cache.get_block(_file, _object_name, block_pos / object_storage_cache::block_size, _pinned);
+            if (offset >= b.size()) {
+                break;
+            }
+            auto n = std::min(len - done, b.size() - offset);
+            std::copy_n(b.get() + offset, n, buffer + done);
+            done += n;
+            if (b.size() < object_storage_cache::block_size) {
+                break;
+            }
+        }
+        co_return done;
+    }
+public:
+    cached_object_file(object_storage_cache& cache, file f, sstring object_name, bool pinned)
+        : _cache(cache)
+        , _file(std::move(f))
+        , _object_name(std::move(object_name))
+        , _pinned(pinned)
+    {
+        _memory_dma_alignment = _file.memory_dma_alignment();
+        _disk_read_dma_alignment = _file.disk_read_dma_alignment();
+        _disk_write_dma_alignment = _file.disk_write_dma_alignment();
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, intent);
+    }
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), intent);
+    }
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override {
+        return read(pos, static_cast<char*>(buffer), len);
+    }
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override {
+        size_t done = 0;
+        for (auto& v : iov) {
+            auto n = co_await read(pos + done, static_cast<char*>(v.iov_base), v.iov_len);
+            done += n;
+            if (n < v.iov_len) {
+                break;
+            }
+        }
+        co_return done;
+    }
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override {
+        auto block_offset = offset % object_storage_cache::block_size;
+        if (block_offset + range_size <= object_storage_cache::block_size) {
+            // Served without copying from a single block.
+            auto b = co_await _cache.get_block(_file, _object_name, offset / object_storage_cache::block_size, _pinned);
+            if (block_offset >= b.size()) {
+                co_return temporary_buffer<uint8_t>();
+            }
+            b = b.share(block_offset, std::min(range_size, b.size() - block_offset));
+            co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(b.get_write()), b.size(), b.release());
+        }
+        auto buf = temporary_buffer<uint8_t>::aligned(_memory_dma_alignment, range_size);
+        auto n = co_await read(offset, reinterpret_cast<char*>(buf.get_write()), range_size);
+        buf.trim(n);
+        co_return buf;
+    }
+    virtual future<> flush() override {
+        return get_file_impl(_file)->flush();
+    }
+    virtual future<struct stat> stat() override {
+        return get_file_impl(_file)->stat();
+    }
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+    virtual future<uint64_t> size() override {
+        if (!_size) {
+            _size = co_await _file.size();
+        }
+        co_return *_size;
+    }
+    virtual future<> close() override {
+        return _file.close();
+    }
+    // The cache is per shard, so a file opened from the handle on another
+    // shard reads the object directly.
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+};
+
+} // anonymous namespace
+
+file object_storage_cache::wrap(file f, sstring object_name, bool pinned) {
+    if (!enabled()) {
+        return f;
+    }
+    return file(make_shared<cached_object_file>(*this, std::move(f), std::move(object_name), pinned));
+}
+
+} // namespace sstables
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <map>
+#include <boost/intrusive/list.hpp>
+#include <seastar/core/file.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include "seastarx.hh"
+
+namespace sstables {
+
+// A size-bounded cache of fixed-size blocks of sstable components stored
+// in object storage, shared by all tables of a shard.
+//
+// Objects in object storage are immutable and their names are unique, so
+// cached blocks never become stale. They are only dropped to free memory,
+// in LRU order, or when the object is deleted.
+//
+// Blocks of the components which are consulted by every lookup (index,
+// summary, filter, compression info) are pinned: they are evicted only
+// once no unpinned block is left, so that scans of data files don't push
+// them out.
+class object_storage_cache {
+public:
+    static constexpr size_t block_size = 128 * 1024;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t bytes_hit = 0;
+        uint64_t bytes_fetched = 0;
+        uint64_t evictions = 0;
+    };
+private:
+    using block_key = std::pair<sstring, uint64_t>;
+    using lru_link_type = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+    struct block {
+        temporary_buffer<char> data;
+        bool pinned;
+        const block_key* key = nullptr;
+        lru_link_type lru_link;
+    };
+    using lru_type = boost::intrusive::list<block,
+            boost::intrusive::member_hook<block, lru_link_type, &block::lru_link>,
+            boost::intrusive::constant_time_size<false>>;
+
+    std::map<block_key, block> _blocks;
+    // Least recently used blocks are at the front.
+    lru_type _lru;
+    lru_type _pinned_lru;
+    // Reads of blocks which are not cached yet. Concurrent misses of the
+    // same block wait for the first read instead of issuing their own.
+    std::map<block_key, shared_future<>> _pending;
+    size_t _capacity;
+    size_t _used = 0;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void touch(block& b) noexcept;
+    void insert(block_key key, temporary_buffer<char> data, bool pinned);
+    void evict() noexcept;
+public:
+    explicit object_storage_cache(size_t capacity);
+    ~object_storage_cache();
+
+    void set_capacity(size_t capacity) noexcept;
+    bool enabled() const noexcept {
+        return _capacity > 0;
+    }
+
+    // Returns block number `index` of the object, reading it from `f` if
+    // it's not cached. The block is shorter than block_size only if it's
+    // the last one of the object, and empty past its end.
+    future<temporary_buffer<char>> get_block(file& f, const sstring& object_name, uint64_t index, bool pinned);
+
+    // Returns a file which reads the object through the cache, falling back
+    // to `f` for everything else.
+    file wrap(file f, sstring object_name, bool pinned);
+
+    // Drops all cached blocks of the object.
+    void invalidate(const sstring& object_name) noexcept;
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+    size_t used_bytes() const noexcept {
+        return _used;
+    }
+};
+
+} // namespace sstables
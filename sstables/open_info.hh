@@ -76,6 +76,11 @@ struct sstable_open_config {
     // filter, meaning that the SSTable will be opened on every single-partition
     // read.
     bool load_bloom_filter = true;
+    // If set, the bloom filter is not read when the SSTable is opened, but
+    // later, in the background, by the components reloader of the sstables
+    // manager, as if it was reclaimed. Until then, the SSTable uses an
+    // always-present filter. Speeds up opening large numbers of SSTables.
+    bool defer_bloom_filter = false;
     // Mimics behavior when a SSTable is streamed to a given shard, where SSTable
     // writer considers the shard that created the SSTable as its owner.
     bool current_shard_as_sstable_owner = false;
@@ -175,6 +175,11 @@ class partition_index_cache {
     partition_index_cache(partition_index_cache&&) = delete;
     partition_index_cache(const partition_index_cache&) = delete;
 
+    // Returns true if the entry for given key is present, possibly still being loaded.
+    bool contains(const key_type& key) const noexcept {
+        return _cache.find(key) != _cache.end();
+    }
+
     // Returns a future which resolves with a shared pointer to index_list for given key.
     // Always returns a valid pointer if succeeds. The pointer is never invalidated externally.
     //
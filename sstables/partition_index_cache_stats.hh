@@ -17,4 +17,5 @@ struct partition_index_cache_stats {
     uint64_t evictions = 0; // Number of times entry was evicted
     uint64_t populations = 0; // Number of times entry was inserted
     uint64_t used_bytes = 0; // Number of bytes entries occupy in memory
+    uint64_t read_aheads = 0; // Number of entries loaded by read-ahead of sequential scans
 };
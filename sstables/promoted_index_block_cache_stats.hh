@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+struct promoted_index_block_cache_stats {
+    uint64_t hits = 0; // Number of blocks found parsed
+    uint64_t misses = 0; // Number of blocks which had to be parsed
+    uint64_t populations = 0; // Number of blocks inserted
+    uint64_t evictions = 0; // Number of blocks evicted
+    uint64_t used_bytes = 0; // Number of bytes cached blocks occupy in memory
+};
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+
+#include "sstables/resume_positions.hh"
+
+namespace sstables {
+
+std::optional<std::pair<uint64_t, uint64_t>> resume_positions::reader_positions::find(const schema& s, const dht::partition_range& pr) const {
+    if (!pr.start() || pr.is_singular()) {
+        return std::nullopt;
+    }
+    dht::ring_position_comparator cmp(s);
+
+    // The end of the data file range is only known for the same range end.
+    if (bool(pr.end()) != bool(range_end)) {
+        return std::nullopt;
+    }
+    if (range_end && (pr.end()->is_inclusive() != range_end->is_inclusive() || cmp(pr.end()->value(), range_end->value()) != 0)) {
+        return std::nullopt;
+    }
+
+    const auto& start = *pr.start();
+    auto in_range = [&] (const partition_position& p) {
+        auto res = cmp(p.key, start.value());
+        return start.is_inclusive() ? res >= 0 : res > 0;
+    };
+    auto it = std::ranges::find_if(partitions, in_range);
+    if (it == partitions.end()) {
+        return std::nullopt;
+    }
+    // There may be partitions of the range between the last partition before
+    // the resumed range which the reader went through and the first partition
+    // it went through, unless the latter is the first partition of the data
+    // file or the start of the resumed range itself.
+    if (it == partitions.begin() && it->data_offset != 0 && !(start.is_inclusive() && cmp(it->key, start.value()) == 0)) {
+        return std::nullopt;
+    }
+    if (it->data_offset > data_end) {
+        return std::nullopt;
+    }
+    return std::pair(it->data_offset, data_end);
+}
+
+} // namespace sstables
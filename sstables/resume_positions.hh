@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "dht/i_partitioner.hh"
+#include "sstables/generation_type.hh"
+
+namespace sstables {
+
+// The data file positions of the partitions which the sstable range readers
+// of an evictable read went through, left in the permit of the read when the
+// readers are closed.
+//
+// When an inactive read is evicted, it is recreated later to resume from the
+// partition it stopped at. Without the saved positions, each sstable reader
+// of the recreated read has to look up that partition in the index, which
+// often means reading the index pages dropped from the cache in the meantime.
+// With them, a reader of an sstable which is still in the sstable set starts
+// reading the data file from the saved position of the first partition of the
+// resumed range instead.
+class resume_positions {
+public:
+    // Keeps at most this many partitions for a reader. The partitions the read
+    // resumes from are the last ones the reader went through, it only reads
+    // ahead by a buffer.
+    static constexpr size_t max_partitions = 64;
+
+    struct partition_position {
+        dht::decorated_key key;
+        uint64_t data_offset;
+    };
+
+    struct reader_positions {
+        // Partitions which directly follow each other in the data file
+        std::vector<partition_position> partitions;
+        // The end of the range the reader was created with, and the end of
+        // the data file range the index returned for it.
+        std::optional<dht::partition_range::bound> range_end;
+        uint64_t data_end = 0;
+
+        void add(dht::decorated_key key, uint64_t data_offset) {
+            if (partitions.size() == max_partitions) {
+                partitions.erase(partitions.begin());
+            }
+            partitions.push_back(partition_position{std::move(key), data_offset});
+        }
+
+        // Returns the data file range to read `pr` from, if the positions
+        // have it.
+        std::optional<std::pair<uint64_t, uint64_t>> find(const schema& s, const dht::partition_range& pr) const;
+    };
+
+private:
+    std::unordered_map<generation_type, reader_positions> _readers;
+
+public:
+    void save(generation_type gen, reader_positions positions) {
+        _readers.insert_or_assign(gen, std::move(positions));
+    }
+
+    std::optional<reader_positions> take(generation_type gen) {
+        auto it = _readers.find(gen);
+        if (it == _readers.end()) {
+            return std::nullopt;
+        }
+        auto positions = std::move(it->second);
+        _readers.erase(it);
+        return positions;
+    }
+};
+
+} // namespace sstables
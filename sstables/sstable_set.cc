@@ -7,6 +7,8 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <span>
 
 #include "utils/assert.hh"
 #include <seastar/util/defer.hh>
@@ -287,6 +289,92 @@ bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) cons
     return as_unleveled;
 }
 
+size_t partitioned_sstable_set::disjoint_level::lower_bound(int64_t token) const noexcept {
+    if (_entries.empty()) {
+        return 0;
+    }
+    const entry* base = _entries.data();
+    size_t len = _entries.size();
+    while (len > 1) {
+        auto half = len / 2;
+        base += (base[half - 1].last < token) * half;
+        len -= half;
+    }
+    return (base - _entries.data()) + (base->last < token);
+}
+
+bool partitioned_sstable_set::disjoint_level::insert(const shared_sstable& sst) {
+    auto first = sst->get_first_decorated_key().token().raw();
+    auto last = sst->get_last_decorated_key().token().raw();
+    auto i = lower_bound(first);
+    if (i < _entries.size() && _entries[i].first <= last) {
+        return false;
+    }
+    _entries.insert(_entries.begin() + i, entry{first, last, sst});
+    return true;
+}
+
+bool partitioned_sstable_set::disjoint_level::erase(const shared_sstable& sst) {
+    auto i = lower_bound(sst->get_last_decorated_key().token().raw());
+    if (i == _entries.size() || _entries[i].sst != sst) {
+        return false;
+    }
+    _entries.erase(_entries.begin() + i);
+    return true;
+}
+
+void partitioned_sstable_set::disjoint_level::select(const schema& s, const dht::partition_range& range, std::vector<shared_sstable>& ssts) const {
+    auto start = range.start() ? range.start()->value().token().raw() : std::numeric_limits<int64_t>::min();
+    auto end = range.end() ? range.end()->value().token().raw() : std::numeric_limits<int64_t>::max();
+    for (auto i = lower_bound(start); i < _entries.size() && _entries[i].first <= end; ++i) {
+        auto& e = _entries[i];
+        // Only an sstable sharing a token with a bound of the range may not overlap with it.
+        if ((e.last == start || e.first == end)
+                && !range.overlaps(dht::partition_range::make({e.sst->get_first_decorated_key()}, {e.sst->get_last_decorated_key()}), dht::ring_position_comparator(s))) {
+            continue;
+        }
+        ssts.push_back(e.sst);
+    }
+}
+
+std::pair<dht::partition_range::bound, dht::ring_position_ext>
+partitioned_sstable_set::disjoint_level::select(const dht::ring_position_view& pos, std::vector<shared_sstable>& ssts) const {
+    auto i = lower_bound(pos.token().raw());
+    if (i == _entries.size()) {
+        return {dht::partition_range::bound(dht::ring_position::max()), dht::ring_position_ext::max()};
+    }
+    auto& e = _entries[i];
+    if (e.first > pos.token().raw()) {
+        auto first = e.sst->get_first_decorated_key().token();
+        return {dht::partition_range::bound(dht::ring_position::starting_at(first), false), dht::ring_position_ext::starting_at(first)};
+    }
+    // The sstable may not contain pos, if pos is before its first key, or after
+    // its last one, in the same token. Selecting it anyway is harmless.
+    ssts.push_back(e.sst);
+    auto next = i + 1 < _entries.size()
+            ? dht::ring_position_ext::starting_at(_entries[i + 1].sst->get_first_decorated_key().token())
+            : dht::ring_position_ext::max();
+    return {dht::partition_range::bound(dht::ring_position::ending_at(e.sst->get_last_decorated_key().token())), std::move(next)};
+}
+
+bool partitioned_sstable_set::insert_disjoint(const shared_sstable& sst) {
+    // LCS has less than 10 levels, don't let a bogus level grow the vector.
+    static constexpr uint32_t max_disjoint_levels = 16;
+    auto level = sst->get_sstable_level();
+    if (level == 0 || level >= max_disjoint_levels) {
+        return false;
+    }
+    if (_disjoint_levels.size() <= level) {
+        _disjoint_levels.resize(level + 1);
+    }
+    return _disjoint_levels[level].insert(sst);
+}
+
+bool partitioned_sstable_set::erase_disjoint(const shared_sstable& sst) {
+    auto level = sst->get_sstable_level();
+    return level < _disjoint_levels.size() && _disjoint_levels[level].erase(sst);
+}
+
 dht::ring_position partitioned_sstable_set::to_ring_position(const dht::compatible_ring_position_or_view& crp) {
     // Ring position views, representing bounds of sstable intervals are
     // guaranteed to have key() != nullptr;
@@ -294,23 +382,13 @@ dht::ring_position partitioned_sstable_set::to_ring_position(const dht::compatib
     return dht::ring_position(pos.token(), *pos.key());
 }
 
-dht::partition_range partitioned_sstable_set::to_partition_range(const interval_type& i) {
-    return dht::partition_range::make(
-            {to_ring_position(i.lower()), boost::icl::is_left_closed(i.bounds())},
-            {to_ring_position(i.upper()), boost::icl::is_right_closed(i.bounds())});
-}
-
-dht::partition_range partitioned_sstable_set::to_partition_range(const dht::ring_position_view& pos, const interval_type& i) {
-    auto lower_bound = [&] {
-        if (pos.key()) {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
-                    pos.is_after_key() == dht::ring_position_view::after_key::no);
-        } else {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
-        }
-    }();
-    auto upper_bound = dht::partition_range::bound(to_ring_position(i.lower()), !boost::icl::is_left_closed(i.bounds()));
-    return dht::partition_range::make(std::move(lower_bound), std::move(upper_bound));
+dht::partition_range::bound partitioned_sstable_set::range_start(const dht::ring_position_view& pos) {
+    if (pos.key()) {
+        return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
+                pos.is_after_key() == dht::ring_position_view::after_key::no);
+    } else {
+        return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
+    }
 }
 
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, dht::token_range token_range)
@@ -326,18 +404,20 @@ static std::unordered_map<run_id, shared_sstable_run> clone_runs(const std::unor
 }
 
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
-        const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, dht::token_range token_range, uint64_t bytes_on_disk)
+        const std::vector<disjoint_level>& disjoint_levels, const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs,
+        dht::token_range token_range, uint64_t bytes_on_disk)
         : sstable_set_impl(bytes_on_disk)
         , _schema(schema)
         , _unleveled_sstables(unleveled_sstables)
         , _leveled_sstables(leveled_sstables)
+        , _disjoint_levels(disjoint_levels)
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(clone_runs(all_runs))
         , _token_range(std::move(token_range)) {
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
-    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _all, _all_runs, _token_range, _bytes_on_disk);
+    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _disjoint_levels, _all, _all_runs, _token_range, _bytes_on_disk);
 }
 
 std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition_range& range) const {
@@ -347,6 +427,9 @@ std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition
     }
     auto r = _unleveled_sstables;
     r.insert(r.end(), result.begin(), result.end());
+    for (auto& level : _disjoint_levels) {
+        level.select(*_schema, range, r);
+    }
     return r;
 }
 
@@ -405,7 +488,7 @@ bool partitioned_sstable_set::insert(shared_sstable sst) {
 
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.push_back(sst);
-    } else {
+    } else if (!insert_disjoint(sst)) {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.add({make_interval(*sst), value_set({sst})});
     }
@@ -427,7 +510,7 @@ bool partitioned_sstable_set::erase(shared_sstable sst) {
     }
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
-    } else {
+    } else if (!erase_disjoint(sst)) {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
     }
@@ -443,6 +526,7 @@ class partitioned_sstable_set::incremental_selector : public incremental_selecto
     schema_ptr _schema;
     const std::vector<shared_sstable>& _unleveled_sstables;
     const interval_map_type& _leveled_sstables;
+    const std::vector<disjoint_level>& _disjoint_levels;
     const uint64_t& _leveled_sstables_change_cnt;
     uint64_t _last_known_leveled_sstables_change_cnt;
     map_iterator _it;
@@ -470,10 +554,11 @@ class partitioned_sstable_set::incremental_selector : public incremental_selecto
     }
 public:
     incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
-                         const uint64_t& leveled_sstables_change_cnt)
+                         const std::vector<disjoint_level>& disjoint_levels, const uint64_t& leveled_sstables_change_cnt)
         : _schema(std::move(schema))
         , _unleveled_sstables(unleveled_sstables)
         , _leveled_sstables(leveled_sstables)
+        , _disjoint_levels(disjoint_levels)
         , _leveled_sstables_change_cnt(leveled_sstables_change_cnt)
         , _last_known_leveled_sstables_change_cnt(leveled_sstables_change_cnt)
         , _it(leveled_sstables.begin()) {
@@ -482,22 +567,45 @@ class partitioned_sstable_set::incremental_selector : public incremental_selecto
         const dht::ring_position_view& pos = s.pos;
         auto crp = dht::compatible_ring_position_or_view(*_schema, pos);
         auto ssts = _unleveled_sstables;
-        using namespace dht;
+
+        // The selection stays the same from pos up to the nearest end over the
+        // interval map and the disjoint levels.
+        auto end = dht::partition_range::bound(dht::ring_position::max());
+        std::optional<dht::ring_position_ext> next;
+        auto restrict = [&] (dht::partition_range::bound e, dht::ring_position_ext n) {
+            auto cmp = dht::ring_position_tri_compare(*_schema, e.value(), end.value());
+            if (cmp < 0 || (cmp == 0 && !e.is_inclusive())) {
+                end = std::move(e);
+            }
+            if (!next || dht::ring_position_tri_compare(*_schema, n, *next) < 0) {
+                next.emplace(std::move(n));
+            }
+        };
 
         maybe_invalidate_iterator(crp);
 
         while (_it != _leveled_sstables.end()) {
             if (boost::icl::contains(_it->first, crp)) {
                 ssts.insert(ssts.end(), _it->second.begin(), _it->second.end());
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(_it->first), std::move(ssts), next_position(std::next(_it)));
+                restrict({to_ring_position(_it->first.upper()), boost::icl::is_right_closed(_it->first.bounds())}, next_position(std::next(_it)));
+                break;
             }
             // We don't want to skip current interval if pos lies before it.
             if (is_before_interval(crp, _it->first)) {
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(pos, _it->first), std::move(ssts), next_position(_it));
+                restrict({to_ring_position(_it->first.lower()), !boost::icl::is_left_closed(_it->first.bounds())}, next_position(_it));
+                break;
             }
             _it++;
         }
-        return std::make_tuple(partition_range::make_open_ended_both_sides(), std::move(ssts), ring_position_view::max());
+        for (auto& level : _disjoint_levels) {
+            if (!level.empty()) {
+                auto [e, n] = level.select(pos, ssts);
+                restrict(std::move(e), std::move(n));
+            }
+        }
+
+        auto range = dht::partition_range::make(range_start(pos), std::move(end));
+        return std::make_tuple(std::move(range), std::move(ssts), next ? std::move(*next) : dht::ring_position_ext::max());
     }
 };
 
@@ -617,7 +725,12 @@ sstable_set_impl::selector_and_schema_t time_series_sstable_set::make_incrementa
 //
 // Skips sstables that don't pass the supplied filter.
 // Guarantees that the filter will be called at most once for each sstable;
-// exactly once after all sstables are iterated over.
+// exactly once for each sstable with lower_bound(s) <= end after all sstables
+// are iterated over.
+//
+// If an end position is supplied, sstables with lower_bound(s) > end are never
+// returned nor passed to the filter, their readers would return no fragments
+// before `end`. Without one, every sstable is passed to the filter.
 //
 // The readers are created lazily on-demand using the supplied factory function.
 //
@@ -661,18 +774,19 @@ class sstable_position_reader_queue : public position_reader_queue {
     // Assumes that `create_reader` returns readers that emit only fragments from partition `pk`.
     //
     // For reversed reads `query_schema` must be reversed (see docs/dev/reverse-reads.md).
-    sstable_position_reader_queue(const time_series_sstable_set& set,
+    sstable_position_reader_queue(lw_shared_ptr<const container_t> sstables,
             schema_ptr query_schema,
             std::function<mutation_reader(sstable&)> create_reader,
             std::function<bool(const sstable&)> filter,
             partition_key pk,
             reader_permit permit,
             streamed_mutation::forwarding fwd_sm,
-            bool reversed)
+            bool reversed,
+            const std::optional<position_in_partition>& end = std::nullopt)
         : _query_schema(std::move(query_schema))
-        , _sstables(reversed ? set._sstables_reversed : set._sstables)
+        , _sstables(std::move(sstables))
         , _it(_sstables->begin())
-        , _end(_sstables->end())
+        , _end(end ? _sstables->upper_bound(*end) : _sstables->end())
         , _cmp(*_query_schema)
         , _create_reader(std::move(create_reader))
         , _filter(std::move(filter))
@@ -687,6 +801,16 @@ class sstable_position_reader_queue : public position_reader_queue {
 
     virtual ~sstable_position_reader_queue() override = default;
 
+    // Orders the sstables like time_series_sstable_set does, for a query with `query_schema`.
+    static lw_shared_ptr<const container_t> make_container(const schema& query_schema,
+            const std::vector<shared_sstable>& sstables, bool reversed) {
+        auto c = make_lw_shared<container_t>(position_in_partition::less_compare(query_schema));
+        for (const auto& sst : sstables) {
+            c->emplace(reversed ? sst->max_position().reversed() : sst->min_position(), sst);
+        }
+        return c;
+    }
+
     // If the dummy reader was not yet returned, return the dummy reader.
     // Otherwise, open sstable readers to all sstables with smallest lower_bound() from the set
     // {S: filter(S) and prev_min_pos < lower_bound(S) <= bound}, where `prev_min_pos` is the lower_bound()
@@ -754,14 +878,15 @@ std::unique_ptr<position_reader_queue> time_series_sstable_set::make_position_re
         std::function<mutation_reader(sstable&)> create_reader,
         std::function<bool(const sstable&)> filter,
         partition_key pk, schema_ptr query_schema, reader_permit permit,
-        streamed_mutation::forwarding fwd_sm, bool reversed) const {
-    return std::make_unique<sstable_position_reader_queue>(*this,
+        streamed_mutation::forwarding fwd_sm, bool reversed,
+        const std::optional<position_in_partition>& end) const {
+    return std::make_unique<sstable_position_reader_queue>(reversed ? _sstables_reversed : _sstables,
             std::move(query_schema), std::move(create_reader), std::move(filter),
-            std::move(pk), std::move(permit), fwd_sm, reversed);
+            std::move(pk), std::move(permit), fwd_sm, reversed, end);
 }
 
 sstable_set_impl::selector_and_schema_t partitioned_sstable_set::make_incremental_selector() const {
-    return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _leveled_sstables_change_cnt), std::cref(*_schema));
+    return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _disjoint_levels, _leveled_sstables_change_cnt), std::cref(*_schema));
 }
 
 std::unique_ptr<sstable_set_impl> compaction_strategy_impl::make_sstable_set(const compaction_group_view& ts) const {
@@ -916,10 +1041,39 @@ make_sstable_filter(const dht::ring_position& pos, const schema& schema, const s
 }
 
 // Filter out sstables for reader using bloom filter and supplied predicate
+//
+// The cheap checks are done first, then the filters of the remaining sstables
+// are probed in batches, so that their cache misses overlap.
 static std::vector<shared_sstable>
 filter_sstable_for_reader(std::vector<shared_sstable>&& sstables, const schema& schema, const dht::ring_position& pos, const sstable_predicate& predicate) {
-    auto filter = [_filter = make_sstable_filter(pos, schema, predicate)] (const shared_sstable& sst) { return !_filter(*sst); };
-    std::erase_if(sstables, filter);
+    auto cmp = dht::ring_position_comparator(schema);
+    std::erase_if(sstables, [&] (const shared_sstable& sst) {
+        return !predicate(*sst) || cmp(pos, sst->get_first_decorated_key()) < 0 || cmp(pos, sst->get_last_decorated_key()) > 0;
+    });
+    if (sstables.empty()) {
+        return std::move(sstables);
+    }
+
+    constexpr size_t batch_size = 64;
+    auto hk = utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(schema, *pos.key())));
+    std::array<utils::i_filter*, batch_size> filters;
+    auto out = sstables.begin();
+    for (auto batch = sstables.begin(); batch != sstables.end();) {
+        auto n = std::min<size_t>(batch_size, sstables.end() - batch);
+        for (size_t i = 0; i < n; ++i) {
+            filters[i] = &batch[i]->get_filter();
+        }
+        auto present = utils::is_present_batch(std::span(filters.data(), n), hk);
+        for (size_t i = 0; i < n; ++i, ++batch) {
+            if (present & (uint64_t(1) << i)) {
+                if (out != batch) {
+                    *out = std::move(*batch);
+                }
+                ++out;
+            }
+        }
+    }
+    sstables.erase(out, sstables.end());
     return std::move(sstables);
 }
 
@@ -957,6 +1111,28 @@ filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica:
     return std::move(sstables);
 }
 
+// Whether the single partition read can merge the sstables lazily, opening them in the
+// order of their max clustering positions, see sstable_position_reader_queue.
+//
+// Done for reads of the latest row of a partition (ORDER BY ck DESC LIMIT 1), which
+// are usually satisfied by the first sstable(s) opened, so the rest are never read.
+// The conditions on the sstables are the same as for the optimized time-series reads,
+// see time_series_sstable_set::create_single_key_sstable_reader().
+// The row limit of single partition queries is passed as the partition row limit,
+// see table::query().
+static bool can_merge_latest_row_lazily(const replica::column_family& cf, const schema& schema, const query::partition_slice& slice,
+        const std::vector<shared_sstable>& sstables) {
+    return cf.get_config().enable_lazy_latest_row_reads()
+        && slice.is_reversed()
+        && slice.partition_row_limit() == 1
+        && sstables.size() > 1
+        && schema.clustering_key_size()
+        && !schema.has_static_columns()
+        && std::ranges::none_of(sstables, [] (const shared_sstable& sst) {
+            return sst->get_version() < sstable_version_types::md || sst->may_have_partition_tombstones();
+        });
+}
+
 std::vector<frozen_sstable_run>
 sstable_set_impl::all_sstable_runs() const {
     auto all_sstables = all();
@@ -995,7 +1171,21 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_mutation_reader(schema, permit);
     }
-    auto readers = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+    selected_sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+    if (can_merge_latest_row_lazily(*cf, *schema, slice, selected_sstables)) {
+        sstable_histogram.add(selected_sstables.size());
+        auto create_reader = [schema, permit, &pr, &slice, trace_state, fwd, &pos] (sstable& sst) {
+            tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sst] { return sst.get_filename(); }));
+            return sst.make_reader(schema, permit, pr, slice, trace_state, fwd);
+        };
+        // The queue always includes a reader which emits the partition_start/end pair, see #3552 below.
+        return make_clustering_combined_reader(schema, permit, fwd,
+                std::make_unique<sstable_position_reader_queue>(
+                        sstable_position_reader_queue::make_container(*schema, selected_sstables, true),
+                        schema, std::move(create_reader), [] (const sstable&) { return true; },
+                        *pos.key(), permit, fwd, true));
+    }
+    auto readers = std::move(selected_sstables)
         | std::views::transform([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, trace_state, fwd);
@@ -1069,33 +1259,65 @@ time_series_sstable_set::create_single_key_sstable_reader(
     };
 
     auto pk_filter = make_pk_filter(pos, *schema);
-    auto ck_filter = [ranges = slice.get_all_ranges()] (const sstable& sst) { return sst.may_contain_rows(ranges); };
+    auto ranges = slice.get_all_ranges();
+    auto full_range = ranges.size() == 1 && ranges.front().is_full();
+    auto ck_filter = [ranges, full_range] (const sstable& sst) { return full_range || sst.may_contain_rows(ranges); };
+    if (full_range) {
+        stats.clustering_filter_fast_path_count++;
+    }
+
+    // Number of sstables which passed the filter, recorded in the histogram once the reader is gone.
+    struct sstables_read {
+        utils::estimated_histogram& histogram;
+        uint64_t count = 0;
+        ~sstables_read() {
+            histogram.add(count);
+        }
+    };
+    auto read = make_lw_shared<sstables_read>(sstable_histogram);
 
     // We're going to pass this filter into sstable_position_reader_queue. The queue guarantees that
-    // the filter is going to be called at most once for each sstable and exactly once after
-    // the queue is exhausted. We use that fact to gather statistics.
-    auto filter = [pk_filter = std::move(pk_filter), ck_filter = std::move(ck_filter), &stats]
+    // the filter is going to be called at most once for each sstable, and, once the queue is
+    // exhausted, exactly once for each sstable starting before the end of the slice; the sstables
+    // starting after it are pruned without being checked. We use that fact to gather statistics.
+    //
+    // The clustering filter only looks at the min/max metadata of the sstable, so it goes
+    // first, sparing the bloom filter probes of the sstables which can't have rows in the slice.
+    auto filter = [pk_filter = std::move(pk_filter), ck_filter = std::move(ck_filter), &stats, read]
         (const sstable& sst) {
-            if (!pk_filter(sst)) {
+            ++stats.sstables_checked_by_clustering_filter;
+            if (!ck_filter(sst)) {
                 return false;
             }
+            ++stats.surviving_sstables_after_clustering_filter;
 
-            ++stats.sstables_checked_by_clustering_filter;
-            if (ck_filter(sst)) {
-                ++stats.surviving_sstables_after_clustering_filter;
-                return true;
+            if (!pk_filter(sst)) {
+                return false;
             }
-
-            return false;
+            ++read->count;
+            return true;
     };
 
     auto reversed = slice.is_reversed();
+    // The queue visits the sstables in the order of their lower bounds, so it can stop at the first
+    // one which starts after the end of the slice. Only done for forward reads, the sstables of
+    // reversed reads are ordered by their max positions.
+    std::optional<position_in_partition> end;
+    if (!reversed && !full_range) {
+        position_in_partition::tri_compare cmp(*schema);
+        for (const auto& r : ranges) {
+            auto range_end = position_in_partition::for_range_end(r);
+            if (!end || cmp(range_end, *end) > 0) {
+                end = std::move(range_end);
+            }
+        }
+    }
     // Note that `sstable_position_reader_queue` always includes a reader which emits a `partition_start` fragment,
     // guaranteeing that the reader we return emits it as well; this helps us avoid the problem from #3552.
     return make_clustering_combined_reader(
             schema, permit, fwd_sm,
             make_position_reader_queue(
-                std::move(create_reader), std::move(filter), *pos.key(), schema, permit, fwd_sm, reversed));
+                std::move(create_reader), std::move(filter), *pos.key(), schema, permit, fwd_sm, reversed, end));
 }
 
 compound_sstable_set::compound_sstable_set(schema_ptr schema, std::vector<lw_shared_ptr<sstable_set>> sets)
@@ -1400,21 +1622,127 @@ sstable_set::make_range_sstable_reader(
             fwd_mr);
 }
 
-mutation_reader
-sstable_set::make_local_shard_sstable_reader(
+// Reads the sstables of a run, which don't overlap, one after another.
+//
+// Only the sstable which is being read has an open reader, and the run
+// reader drops its reference to each sstable once it's done with it, so
+// that incremental compaction can still release exhausted sstables early.
+// Doesn't support streamed_mutation::forwarding.
+class sstable_run_reader final : public mutation_reader::impl {
+    // Sorted by their first keys, so also by their last keys.
+    std::vector<shared_sstable> _sstables;
+    // Index of the next sstable to open.
+    size_t _next = 0;
+    const dht::partition_range* _pr;
+    mutation_reader::forwarding _fwd_mr;
+    sstable_reader_factory_type _fn;
+    shared_sstable _current;
+    mutation_reader_opt _reader;
+private:
+    int compare_last_key(const sstable& sst, dht::ring_position_view pos) const {
+        return dht::ring_position_tri_compare(*_schema, dht::ring_position_view(sst.get_last_decorated_key()), pos);
+    }
+
+    // Returns false if none of the remaining sstables overlaps the range.
+    bool open_next_reader() {
+        const auto start = dht::ring_position_view::for_range_start(*_pr);
+        for (; _next < _sstables.size(); ++_next) {
+            auto& sst = _sstables[_next];
+            if (compare_last_key(*sst, start) < 0) {
+                sst = nullptr;
+                continue;
+            }
+            if (dht::ring_position_tri_compare(*_schema, dht::ring_position_view(sst->get_first_decorated_key()), dht::ring_position_view::for_range_end(*_pr)) > 0) {
+                // Might be needed after a fast-forward.
+                return false;
+            }
+            _current = std::exchange(sst, nullptr);
+            ++_next;
+            _reader = _fn(_current, *_pr);
+            return true;
+        }
+        return false;
+    }
+
+    future<> close_reader() noexcept {
+        auto reader = std::exchange(_reader, std::nullopt);
+        _current = nullptr;
+        return reader ? reader->close() : make_ready_future<>();
+    }
+public:
+    sstable_run_reader(schema_ptr s, reader_permit permit, const sstable_run& run, const dht::partition_range& pr,
+            mutation_reader::forwarding fwd_mr, sstable_reader_factory_type fn)
+        : impl(std::move(s), std::move(permit))
+        , _sstables(run.all().begin(), run.all().end())
+        , _pr(&pr)
+        , _fwd_mr(fwd_mr)
+        , _fn(std::move(fn))
+    { }
+
+    virtual future<> fill_buffer() override {
+        while (!is_buffer_full() && !_end_of_stream) {
+            if (!_reader && !open_next_reader()) {
+                _end_of_stream = true;
+                break;
+            }
+            co_await _reader->fill_buffer();
+            _reader->move_buffer_content_to(*this);
+            if (!_reader->is_end_of_stream()) {
+                continue;
+            }
+            if (_fwd_mr && compare_last_key(*_current, dht::ring_position_view::for_range_end(*_pr)) > 0) {
+                // The sstable has more data past the range, for a later
+                // fast-forward. No other sstable of the run overlaps the range.
+                _end_of_stream = true;
+                break;
+            }
+            co_await close_reader();
+        }
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        _pr = &pr;
+        if (!_reader) {
+            co_return;
+        }
+        if (compare_last_key(*_current, dht::ring_position_view::for_range_start(pr)) < 0) {
+            co_await close_reader();
+        } else {
+            co_await _reader->fast_forward_to(pr);
+        }
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty() && !is_end_of_stream() && _reader) {
+            return _reader->next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> close() noexcept override {
+        return close_reader();
+    }
+};
+
+static bool sstable_overlaps(const schema& s, const sstable& sst, const dht::partition_range& pr) {
+    return dht::ring_position_tri_compare(s, dht::ring_position_view(sst.get_last_decorated_key()), dht::ring_position_view::for_range_start(pr)) >= 0
+        && dht::ring_position_tri_compare(s, dht::ring_position_view(sst.get_first_decorated_key()), dht::ring_position_view::for_range_end(pr)) <= 0;
+}
+
+static sstable_reader_factory_type make_local_shard_reader_factory(
         schema_ptr s,
         reader_permit permit,
-        const dht::partition_range& pr,
         const query::partition_slice& slice,
         tracing::trace_state_ptr trace_state,
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor_generator& monitor_generator,
         const sstable_predicate& predicate,
-        combined_reader_statistics* statistics,
-        integrity_check integrity) const
-{
-    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate, integrity]
+        integrity_check integrity) {
+    return [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate, integrity]
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
         SCYLLA_ASSERT(!sst->is_shared());
         if (!predicate(*sst)) {
@@ -1427,6 +1755,23 @@ sstable_set::make_local_shard_sstable_reader(
         }
         return reader;
     };
+}
+
+mutation_reader
+sstable_set::make_local_shard_sstable_reader(
+        schema_ptr s,
+        reader_permit permit,
+        const dht::partition_range& pr,
+        const query::partition_slice& slice,
+        tracing::trace_state_ptr trace_state,
+        streamed_mutation::forwarding fwd,
+        mutation_reader::forwarding fwd_mr,
+        read_monitor_generator& monitor_generator,
+        const sstable_predicate& predicate,
+        combined_reader_statistics* statistics,
+        integrity_check integrity) const
+{
+    auto reader_factory_fn = make_local_shard_reader_factory(s, permit, slice, trace_state, fwd, fwd_mr, monitor_generator, predicate, integrity);
     if (_impl->size() == 1) [[unlikely]] {
         auto sstables = _impl->all();
         auto sst = *sstables->begin();
@@ -1442,6 +1787,48 @@ sstable_set::make_local_shard_sstable_reader(
             statistics);
 }
 
+mutation_reader
+sstable_set::make_local_shard_sstable_reader_by_runs(
+        schema_ptr s,
+        reader_permit permit,
+        const dht::partition_range& pr,
+        const query::partition_slice& slice,
+        tracing::trace_state_ptr trace_state,
+        streamed_mutation::forwarding fwd,
+        mutation_reader::forwarding fwd_mr,
+        read_monitor_generator& monitor_generator,
+        const sstable_predicate& predicate,
+        combined_reader_statistics* statistics,
+        integrity_check integrity) const
+{
+    auto runs = all_sstable_runs();
+    auto has_multi_fragment_runs = std::ranges::any_of(runs, [] (const frozen_sstable_run& run) {
+        return run->all().size() > 1;
+    });
+    // The run reader can't tell the end of a clustering range from the end
+    // of an sstable.
+    if (fwd || !has_multi_fragment_runs) {
+        return make_local_shard_sstable_reader(std::move(s), std::move(permit), pr, slice, std::move(trace_state), fwd, fwd_mr,
+                monitor_generator, predicate, statistics, integrity);
+    }
+
+    auto reader_factory_fn = make_local_shard_reader_factory(s, permit, slice, trace_state, fwd, fwd_mr, monitor_generator, predicate, integrity);
+    std::vector<mutation_reader> readers;
+    readers.reserve(runs.size());
+    for (auto& run : runs) {
+        if (run->all().size() > 1) {
+            readers.push_back(make_mutation_reader<sstable_run_reader>(s, permit, *run, pr, fwd_mr, reader_factory_fn));
+            continue;
+        }
+        auto sst = *run->all().begin();
+        if (fwd_mr || sstable_overlaps(*s, *sst, pr)) {
+            tracing::trace(trace_state, "Reading partition range {} from sstable {}", pr, seastar::value_of([&sst] { return sst->get_filename(); }));
+            readers.push_back(reader_factory_fn(sst, pr));
+        }
+    }
+    return make_combined_reader(s, std::move(permit), std::move(readers), fwd, fwd_mr, statistics);
+}
+
 mutation_reader sstable_set::make_full_scan_reader(
         schema_ptr schema,
         reader_permit permit,
@@ -246,6 +246,24 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         combined_reader_statistics* statistics = nullptr,
         integrity_check integrity = integrity_check::no) const;
 
+    // Like make_local_shard_sstable_reader(), but reads all sstables of a
+    // run through a single reader which goes over them one after another,
+    // instead of merging them, so that only readers of different runs are
+    // merged. Falls back to make_local_shard_sstable_reader() with
+    // streamed_mutation::forwarding, or if no run has more than one sstable.
+    mutation_reader make_local_shard_sstable_reader_by_runs(
+        schema_ptr,
+        reader_permit,
+        const dht::partition_range&,
+        const query::partition_slice&,
+        tracing::trace_state_ptr,
+        streamed_mutation::forwarding,
+        mutation_reader::forwarding,
+        read_monitor_generator& rmg = default_read_monitor_generator(),
+        const sstable_predicate& p = default_sstable_predicate(),
+        combined_reader_statistics* statistics = nullptr,
+        integrity_check integrity = integrity_check::no) const;
+
     mutation_reader make_full_scan_reader(
             schema_ptr,
             reader_permit,
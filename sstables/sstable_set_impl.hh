@@ -24,10 +24,42 @@ class partitioned_sstable_set : public sstable_set_impl {
     using interval_map_type = boost::icl::interval_map<dht::compatible_ring_position_or_view, value_set>;
     using interval_type = interval_map_type::interval_type;
     using map_iterator = interval_map_type::const_iterator;
+public:
+    // SSTables of a level above 0 which are disjoint, by token, with each
+    // other, sorted by token. Under LCS that's all sstables of the level, so
+    // looking up a position is a binary search per level, rather than a walk
+    // over an interval map which is fragmented by every sstable in it.
+    class disjoint_level {
+        struct entry {
+            int64_t first;
+            int64_t last;
+            shared_sstable sst;
+        };
+        std::vector<entry> _entries;
+    public:
+        // Like std::lower_bound() over the last tokens, but without branches
+        // which the CPU can't predict, as the probed entries are random.
+        size_t lower_bound(int64_t token) const noexcept;
+        bool empty() const noexcept {
+            return _entries.empty();
+        }
+        // Fails if sst overlaps, by token, with an sstable of the level.
+        bool insert(const shared_sstable& sst);
+        bool erase(const shared_sstable& sst);
+        // Appends the sstables which overlap with range.
+        void select(const schema& s, const dht::partition_range& range, std::vector<shared_sstable>& ssts) const;
+        // Appends the sstable containing the token of pos, if any, and returns
+        // the end of the range after pos in which the selection stays the same,
+        // and where the next sstable starts.
+        std::pair<dht::partition_range::bound, dht::ring_position_ext> select(const dht::ring_position_view& pos, std::vector<shared_sstable>& ssts) const;
+    };
 private:
     schema_ptr _schema;
     std::vector<shared_sstable> _unleveled_sstables;
+    // L0 sstables, and leveled sstables which overlap with others of their level.
     interval_map_type _leveled_sstables;
+    // Indexed by level, level 0 is always empty.
+    std::vector<disjoint_level> _disjoint_levels;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<run_id, shared_sstable_run> _all_runs;
     // Change counter on interval map for leveled sstables which is used by
@@ -44,10 +76,11 @@ class partitioned_sstable_set : public sstable_set_impl {
     std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
+    bool insert_disjoint(const shared_sstable& sst);
+    bool erase_disjoint(const shared_sstable& sst);
 public:
     static dht::ring_position to_ring_position(const dht::compatible_ring_position_or_view& crp);
-    static dht::partition_range to_partition_range(const interval_type& i);
-    static dht::partition_range to_partition_range(const dht::ring_position_view& pos, const interval_type& i);
+    static dht::partition_range::bound range_start(const dht::ring_position_view& pos);
 
     partitioned_sstable_set(const partitioned_sstable_set&) = delete;
     explicit partitioned_sstable_set(schema_ptr schema, dht::token_range token_range);
@@ -56,6 +89,7 @@ class partitioned_sstable_set : public sstable_set_impl {
         schema_ptr schema,
         const std::vector<shared_sstable>& unleveled_sstables,
         const interval_map_type& leveled_sstables,
+        const std::vector<disjoint_level>& disjoint_levels,
         const lw_shared_ptr<sstable_list>& all,
         const std::unordered_map<run_id, shared_sstable_run>& all_runs,
         dht::token_range token_range,
@@ -105,7 +139,8 @@ class time_series_sstable_set : public sstable_set_impl {
         std::function<bool(const sstable&)> filter,
         partition_key pk, schema_ptr schema, reader_permit permit,
         streamed_mutation::forwarding fwd_sm,
-        bool reversed) const;
+        bool reversed,
+        const std::optional<position_in_partition>& end = std::nullopt) const;
 
     virtual mutation_reader create_single_key_sstable_reader(
         replica::column_family*,
@@ -48,6 +48,9 @@ sstable_version_constants::component_map_t sstable_version_constants::create_com
         { component_type::Scylla, "Scylla.db" },
         { component_type::TemporaryTOC, TEMPORARY_TOC_SUFFIX },
         { component_type::TemporaryStatistics, "Statistics.db.tmp" },
+        // Not Partitions.db, which is the partition index of Cassandra's BTI
+        // format, since the layout of the file differs from it.
+        { component_type::PartitionTrie, "PartitionTrie.db" },
     };
 }
 
@@ -61,6 +61,8 @@
 #include "utils/checked-file-impl.hh"
 #include "db/extensions.hh"
 #include "sstables/partition_index_cache.hh"
+#include "sstables/decompressed_chunk_cache.hh"
+#include "sstables/mx/promoted_index_block_cache.hh"
 #include "db/large_data_handler.hh"
 #include "db/config.hh"
 #include "sstables/random_access_reader.hh"
@@ -71,6 +73,7 @@
 #include "tracing/traced_file.hh"
 #include "kl/reader.hh"
 #include "mx/reader.hh"
+#include "trie/bti_partition_index.hh"
 #include "utils/bit_cast.hh"
 #include "utils/cached_file.hh"
 #include "tombstone_gc.hh"
@@ -103,6 +106,14 @@ namespace sstables {
 //
 thread_local utils::updateable_value<bool> global_cache_index_pages(true);
 
+// Maximum number of index pages which the index reader reads ahead of
+// sequential scans. Passed through a global, like global_cache_index_pages.
+thread_local utils::updateable_value<uint32_t> global_index_read_ahead_pages(8);
+
+// Whether point reads of compressed sstables cache the decompressed chunks,
+// see decompressed_chunk_cache. Passed through a global, like global_cache_index_pages.
+thread_local utils::updateable_value<bool> global_cache_decompressed_chunks(true);
+
 logging::logger sstlog("sstable");
 
 [[noreturn]] void on_parse_error(sstring message, std::optional<component_name> filename) {
@@ -545,23 +556,87 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
         check_buf_size(buf, entrysize);
 
         auto keysize = entrysize - 8;
-        auto key_data = s.add_summary_data(bytes_view(reinterpret_cast<const int8_t*>(buf.get()), keysize));
-        buf.trim_front(keysize);
+        auto key_data = bytes_view(reinterpret_cast<const int8_t*>(buf.get()), keysize);
 
         // position is little-endian encoded
-        auto position = seastar::read_le<uint64_t>(buf.get());
+        auto position = seastar::read_le<uint64_t>(buf.get() + keysize);
         auto token = schema.get_partitioner().get_token(key_view(key_data));
-        s.entries.push_back(summary_entry{ token, key_data, position });
+        s.add_entry(token, key_data, position);
     }
+    s.seal_keys();
     // Delete last element which isn't part of the on-disk format.
     s.positions.pop_back();
 }
 
-inline void write(sstable_version_types v, file_writer& out, const summary_entry& entry) {
+void summary_ka::add_entry(dht::token token, bytes_view key, uint64_t position) {
+    if (entries.size() % key_restart_interval == 0 && !_open_key_block.empty()) {
+        _key_blocks.push_back(add_summary_data(bytes_view(_open_key_block.data(), _open_key_block.size())));
+        _open_key_block.clear();
+    }
+    size_t shared = 0;
+    if (entries.size() % key_restart_interval) {
+        bytes_view prev(_prev_key);
+        shared = std::ranges::mismatch(prev, key).in1 - prev.begin();
+    }
+    auto suffix = key.substr(shared);
+    // Keys are at most 64kB, so both lengths fit in 16 bits.
+    char lengths[4];
+    seastar::write_le<uint16_t>(lengths, shared);
+    seastar::write_le<uint16_t>(lengths + 2, suffix.size());
+    _open_key_block.insert(_open_key_block.end(), lengths, lengths + sizeof(lengths));
+    _open_key_block.insert(_open_key_block.end(), suffix.begin(), suffix.end());
+    _prev_key = bytes(key);
+    _key_bytes += key.size();
+    entries.push_back(summary_entry{token, position});
+}
+
+void summary_ka::seal_keys() {
+    if (!_open_key_block.empty()) {
+        _key_blocks.push_back(add_summary_data(bytes_view(_open_key_block.data(), _open_key_block.size())));
+    }
+    _open_key_block = {};
+    _prev_key = {};
+}
+
+bytes_view summary_ka::key_block(size_t block) const {
+    if (block < _key_blocks.size()) {
+        return _key_blocks[block];
+    }
+    return bytes_view(_open_key_block.data(), _open_key_block.size());
+}
+
+summary_ka::key_cursor::key_cursor(const summary_ka& s, size_t idx)
+        : _s(s)
+        , _idx(idx - idx % key_restart_interval)
+{
+    while (_idx < idx) {
+        next();
+    }
+}
+
+bytes_view summary_ka::key_cursor::next() {
+    if (_idx % key_restart_interval == 0) {
+        _pos = _s.key_block(_idx / key_restart_interval).data();
+    }
+    auto shared = seastar::read_le<uint16_t>(reinterpret_cast<const char*>(_pos));
+    auto suffix_size = seastar::read_le<uint16_t>(reinterpret_cast<const char*>(_pos) + 2);
+    _pos += 4;
+    _key.resize(shared);
+    _key.insert(_key.end(), _pos, _pos + suffix_size);
+    _pos += suffix_size;
+    ++_idx;
+    return bytes_view(_key.data(), _key.size());
+}
+
+bytes summary_ka::key_at(size_t idx) const {
+    return bytes(key_cursor(*this, idx).next());
+}
+
+inline void write(sstable_version_types v, file_writer& out, bytes_view key, const summary_entry& entry) {
     // FIXME: summary entry is supposedly written in memory order, but that
     // would prevent portability of summary file between machines of different
     // endianness. We can treat it as little endian to preserve portability.
-    write(v, out, entry.key);
+    write(v, out, key);
     auto p = seastar::cpu_to_le<uint64_t>(entry.position);
     out.write(reinterpret_cast<const char*>(&p), sizeof(p));
 }
@@ -577,7 +652,10 @@ inline void write(sstable_version_types v, file_writer& out, const summary& s) {
         auto p = seastar::cpu_to_le(e);
         out.write(reinterpret_cast<const char*>(&p), sizeof(p));
     }
-    write(v, out, s.entries);
+    summary::key_cursor keys(s);
+    for (auto& e : s.entries) {
+        write(v, out, keys.next(), e);
+    }
     write(v, out, s.first_key, s.last_key);
 }
 
@@ -1278,18 +1356,30 @@ future<> sstable::load_first_and_last_position_in_partition() {
     _last_partition_last_position = std::move(*last_pos_opt);
 }
 
-double sstable::estimate_droppable_tombstone_ratio(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const {
-    auto gc_before = get_gc_before_for_drop_estimation(compaction_time, gc_state, s);
+std::optional<hll::HyperLogLog> sstable::get_partition_count_estimator() const {
+    auto entry = _components->statistics.contents.find(metadata_type::Compaction);
+    if (entry == _components->statistics.contents.end() || !entry->second) {
+        return std::nullopt;
+    }
+    const auto& cardinality = static_cast<const compaction_metadata&>(*entry->second).cardinality.elements;
+    auto bytes = std::vector<uint8_t>(cardinality.begin(), cardinality.end());
+    return hll::HyperLogLog::from_bytes(bytes);
+}
 
+double sstable::estimate_droppable_tombstone_ratio(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const {
     auto& st = get_stats_metadata();
     auto estimated_count = st.estimated_cells_count.mean() * st.estimated_cells_count.count();
     if (estimated_count > 0) {
-        double droppable = st.estimated_tombstone_drop_time.sum(gc_before.time_since_epoch().count());
-        return droppable / estimated_count;
+        return estimate_droppable_tombstones(compaction_time, gc_state, s) / estimated_count;
     }
     return 0.0f;
 }
 
+double sstable::estimate_droppable_tombstones(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const {
+    auto gc_before = get_gc_before_for_drop_estimation(compaction_time, gc_state, s);
+    return get_stats_metadata().estimated_tombstone_drop_time.sum(gc_before.time_since_epoch().count());
+}
+
 future<> sstable::read_statistics() {
     return read_simple<component_type::Statistics>(_components->statistics);
 }
@@ -1394,6 +1484,8 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
 
     if (this->has_component(component_type::CompressionInfo)) {
         _components->compression.update(st.st_size);
+        _chunk_cache = std::make_unique<decompressed_chunk_cache>(_manager.get_cache_tracker().get_decompressed_chunk_cache_stats(),
+                _manager.get_cache_tracker().get_lru(), _manager.get_cache_tracker().region());
     }
     _data_file_size = st.st_size;
     _data_file_write_time = db_clock::from_time_t(st.st_mtime);
@@ -1408,6 +1500,10 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
                                                             _index_file_size);
     _index_file = make_cached_seastar_file(*_cached_index_file);
 
+    if (has_component(component_type::PartitionTrie)) {
+        co_await open_bti_partition_index();
+    }
+
     this->set_min_max_position_range();
     this->set_first_and_last_keys();
     _run_identifier = _components->scylla_metadata->get_optional_run_identifier().value_or(run_id::create_random_id());
@@ -1419,6 +1515,31 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
     }
 }
 
+future<> sstable::open_bti_partition_index() {
+    parse_assert(!_cached_partitions_file, get_filename());
+    _partitions_file = co_await open_file(component_type::PartitionTrie, open_flags::ro);
+    auto size = co_await _partitions_file.size();
+    if (size < trie::bti_partition_index_footer_size) {
+        throw malformed_sstable_exception(fmt::format("PartitionTrie file too short: {} bytes", size), filename(component_type::PartitionTrie));
+    }
+    auto buf = co_await _partitions_file.dma_read_exactly<char>(size - trie::bti_partition_index_footer_size, trie::bti_partition_index_footer_size);
+    auto footer = trie::parse_bti_partition_index_footer(buf.get());
+    if (footer.root_pos >= int64_t(size)) {
+        throw malformed_sstable_exception(fmt::format("PartitionTrie root position {} out of file bounds {}", footer.root_pos, size), filename(component_type::PartitionTrie));
+    }
+    _bti_partitions_root_pos = footer.root_pos;
+    _cached_partitions_file = seastar::make_shared<cached_file>(_partitions_file,
+                                                                _manager.get_cache_tracker().get_index_cached_file_stats(),
+                                                                _manager.get_cache_tracker().get_lru(),
+                                                                _manager.get_cache_tracker().region(),
+                                                                size);
+    _partitions_file = make_cached_seastar_file(*_cached_partitions_file);
+}
+
+future<std::optional<uint64_t>> sstable::bti_partition_position(const dht::decorated_key& dk) {
+    return trie::bti_partition_index_lookup(*_cached_partitions_file, _bti_partitions_root_pos, *_schema, dk);
+}
+
 future<> sstable::create_data() noexcept {
     auto oflags = open_flags::wo | open_flags::create | open_flags::exclusive;
     file_open_options opt;
@@ -1432,6 +1553,15 @@ future<> sstable::create_data() noexcept {
 future<> sstable::drop_caches() {
     co_await _cached_index_file->evict_gently();
     co_await _index_cache->evict_gently();
+    if (_cached_partitions_file) {
+        co_await _cached_partitions_file->evict_gently();
+    }
+    if (_chunk_cache) {
+        co_await _chunk_cache->evict_gently();
+    }
+    if (_promoted_index_block_cache) {
+        co_await _promoted_index_block_cache->evict_gently();
+    }
 }
 
 // Return the filter format for the given sstable version
@@ -1442,7 +1572,7 @@ static inline utils::filter_format get_filter_format(sstable_version_types versi
 }
 
 future<> sstable::read_filter(sstable_open_config cfg) {
-    if (!cfg.load_bloom_filter || !has_component(component_type::Filter)) {
+    if (!cfg.load_bloom_filter || cfg.defer_bloom_filter || !has_component(component_type::Filter)) {
         _components->filter = std::make_unique<utils::filter::always_present_filter>();
         return make_ready_future<>();
     }
@@ -1451,8 +1581,12 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         sstables::filter filter;
         read_simple<component_type::Filter>(filter).get();
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
+        auto layout = _components->scylla_metadata ? _components->scylla_metadata->get_filter_layout() : utils::filter_layout::classic;
+        if (layout == utils::filter_layout::split_block && nr_bits % utils::filter::split_block_bloom_filter::bits_per_block) {
+            throw malformed_sstable_exception(format("Split-block filter size {} is not a multiple of the block size", nr_bits), filename(component_type::Filter));
+        }
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version), layout);
     });
 }
 
@@ -1461,7 +1595,7 @@ void sstable::write_filter() {
         return;
     }
 
-    auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(_components->filter.get());
+    auto f = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1476,11 +1610,12 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     // Skip rebuilding the bloom filter if the false positive rate based
     // on the current bitset size is within 75% to 125% of the configured
     // false positive rate.
+    auto layout = _components->filter->layout();
     auto curr_bitset_size = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get())->bits().memory_size();
     auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 1.25);
+                                                                    _schema->bloom_filter_fp_chance() * 1.25, layout);
     auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 0.75);
+                                                                    _schema->bloom_filter_fp_chance() * 0.75, layout);
     if (bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound) {
         return;
     }
@@ -1496,7 +1631,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     };
 
     // Create a new filter that can optimally represent the given num_partitions.
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
+    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version), layout);
     sstlog.info("Rebuilding bloom filter {}: resizing bitset from {} bytes to {} bytes. sstable origin: {}", filename(component_type::Filter), curr_bitset_size,
                 downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
 
@@ -1573,7 +1708,8 @@ future<> sstable::reload_reclaimed_components() {
 
     co_await read_filter();
     _total_reclaimable_memory.reset();
-    _total_memory_reclaimed -= _components->filter->memory_size();
+    // The size of a deferred filter was only estimated, see load_metadata().
+    _total_memory_reclaimed = 0;
     sstlog.info("Reloaded bloom filter of {}", get_filename());
 }
 
@@ -1598,6 +1734,13 @@ future<> sstable::load_metadata(sstable_open_config cfg) noexcept {
             [&] { return read_compression(); },
             [&] { return read_filter(cfg); },
             [&] { return read_summary(); });
+    if (cfg.load_bloom_filter && cfg.defer_bloom_filter && has_component(component_type::Filter)) {
+        // Let the sstables manager load the filter later, as if it was reclaimed.
+        // Its size is estimated from the number of partitions, which is
+        // good enough to account for it until it's loaded.
+        auto layout = _components->scylla_metadata ? _components->scylla_metadata->get_filter_layout() : utils::filter_layout::classic;
+        _total_memory_reclaimed = std::max<size_t>(1, utils::i_filter::get_filter_size(get_estimated_key_count(), _schema->bloom_filter_fp_chance(), layout));
+    }
 }
 
 // This interface is only used during tests, snapshot loading and early initialization.
@@ -1709,12 +1852,15 @@ future<> seal_summary(summary& s,
         s.last_key.value = s.first_key.value;
     }
 
+    s.seal_keys();
     s.header.memory_size = s.header.size * sizeof(uint32_t);
     s.positions.reserve(s.entries.size());
-    return do_for_each(s.entries, [&s] (summary_entry& e) {
+    summary::key_cursor keys(s);
+    for (auto& e : s.entries) {
         s.positions.push_back(s.header.memory_size);
-        s.header.memory_size += e.key.size() + sizeof(e.position);
-    });
+        s.header.memory_size += keys.next().size() + sizeof(e.position);
+        co_await coroutine::maybe_yield();
+    }
 }
 
 static
@@ -1817,8 +1963,7 @@ void maybe_add_summary_entry(summary& s, const dht::token& token, bytes_view key
     if (data_offset >= state.next_data_offset_to_write_summary) {
         auto entry_size = 8 + 2 + key.size();  // offset + key_size.size + key.size
         state.next_data_offset_to_write_summary += state.summary_byte_cost * entry_size;
-        auto key_data = s.add_summary_data(key);
-        s.entries.push_back(summary_entry{ token, key_data, index_offset });
+        s.add_entry(token, key, index_offset);
     }
 }
 
@@ -1910,6 +2055,12 @@ sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
     }
     _components->scylla_metadata->data.set<scylla_metadata_type::SSTableIdentifier>(scylla_metadata::sstable_identifier{sid});
 
+    // Only record non-default layouts, so that sstables with a classic
+    // filter remain readable by versions which don't know about layouts.
+    if (_components->filter && _components->filter->layout() != utils::filter_layout::classic) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::FilterLayout>(filter_layout_metadata{_components->filter->layout()});
+    }
+
     write_simple<component_type::Scylla>(*_components->scylla_metadata);
 }
 
@@ -2304,8 +2455,8 @@ std::vector<std::pair<component_type, sstring>> sstable::all_components() const
     return all;
 }
 
-future<> sstable::snapshot(const sstring& dir) const {
-    return _storage->snapshot(*this, dir, storage::absolute_path::yes);
+future<> sstable::snapshot(const sstring& dir, storage::sync_dir sync) const {
+    return _storage->snapshot(*this, dir, storage::absolute_path::yes, std::nullopt, sync);
 }
 
 future<> sstable::change_state(sstable_state to, delayed_commit_changes* delay_commit) {
@@ -2335,10 +2486,11 @@ sstable::make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& mon,
-        integrity_check integrity) {
+        integrity_check integrity,
+        project_columns projection) {
     const auto reversed = slice.is_reversed();
     if (_version >= version_types::mc && (!reversed || range.is_singular())) {
-        return mx::make_reader(shared_from_this(), std::move(query_schema), std::move(permit), range, slice, std::move(trace_state), fwd, fwd_mr, mon, integrity);
+        return mx::make_reader(shared_from_this(), std::move(query_schema), std::move(permit), range, slice, std::move(trace_state), fwd, fwd_mr, mon, integrity, projection);
     }
 
     // Multi-partition reversed queries are not yet supported natively in the mx reader.
@@ -2349,7 +2501,7 @@ sstable::make_reader(
     if (_version >= version_types::mc) {
         // The only mx case falling through here is reversed multi-partition reader
         auto rd = make_reversing_reader(mx::make_reader(shared_from_this(), query_schema->make_reversed(), std::move(permit),
-                range, reverse_slice(*query_schema, slice), std::move(trace_state), streamed_mutation::forwarding::no, fwd_mr, mon, integrity),
+                range, reverse_slice(*query_schema, slice), std::move(trace_state), streamed_mutation::forwarding::no, fwd_mr, mon, integrity, projection),
             max_result_size);
         if (fwd) {
             rd = make_forwardable(std::move(rd));
@@ -2500,15 +2652,22 @@ future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
         digest = get_digest();
     }
     auto stream_creator = [this, f](uint64_t pos, uint64_t len, file_input_stream_options options) mutable -> future<input_stream<char>> {
+        // Reads of less than a buffer, like those of the inputs of a compaction
+        // of thousands of tiny sstables, don't need full buffers and read-ahead.
+        if (len < options.buffer_size) {
+            options.buffer_size = align_up(std::max<uint64_t>(len, 1), uint64_t(4096));
+            options.read_ahead = 1;
+        }
         co_return input_stream<char>(co_await _storage->make_data_or_index_source(*this, component_type::Data, std::move(f), pos, len, std::move(options)));
     };
     if (_components->compression && raw == raw_stream::no) {
+        auto chunk_cache = global_cache_decompressed_chunks() ? _chunk_cache.get() : nullptr;
         if (_version >= sstable_version_types::mc) {
             co_return make_compressed_file_m_format_input_stream(stream_creator, &_components->compression,
-               pos, len, std::move(options), permit, digest);
+               pos, len, std::move(options), permit, digest, chunk_cache);
         } else {
             co_return make_compressed_file_k_l_format_input_stream(stream_creator, &_components->compression,
-                pos, len, std::move(options), permit, digest);
+                pos, len, std::move(options), permit, digest, chunk_cache);
         }
     }
     if (_components->checksum && integrity == integrity_check::yes) {
@@ -2847,6 +3006,13 @@ future<> sstable::close_files() {
             general_disk_error();
         });
     }
+    auto partitions_closed = make_ready_future<>();
+    if (_partitions_file) {
+        partitions_closed = _partitions_file.close().handle_exception([me = shared_from_this()] (auto ep) {
+            sstlog.warn("sstable close partitions_file failed: {}", ep);
+            general_disk_error();
+        });
+    }
     auto data_closed = make_ready_future<>();
     if (_data_file) {
         data_closed = _data_file.close().handle_exception([me = shared_from_this()] (auto ep) {
@@ -2878,7 +3044,7 @@ future<> sstable::close_files() {
 
     _on_closed(*this);
 
-    return when_all_succeed(std::move(index_closed), std::move(data_closed), std::move(unlinked)).discard_result().then([this, me = shared_from_this()] {
+    return when_all_succeed(std::move(index_closed), std::move(partitions_closed), std::move(data_closed), std::move(unlinked)).discard_result().then([this, me = shared_from_this()] {
         if (_open_mode) {
             if (_open_mode.value() == open_flags::ro) {
                 _stats.on_close_for_reading();
@@ -2898,7 +3064,7 @@ std::optional<std::pair<uint64_t, uint64_t>> sstable::get_sample_indexes_for_ran
         auto kind = before ? key::kind::before_all_keys : key::kind::after_all_keys;
         key k(kind);
         // Binary search will never returns positive values.
-        return uint64_t((binary_search(_schema->get_partitioner(), _components->summary.entries, k, token) + 1) * -1);
+        return uint64_t((binary_search(_schema->get_partitioner(), _components->summary, k, token) + 1) * -1);
     };
     uint64_t left = 0;
     if (range.start()) {
@@ -2948,9 +3114,8 @@ future<sstring> make_toc_temporary(sstring sstable_toc_name, storage::sync_dir s
  * optional if the sstable does not include any keys from the range.
  */
 std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(const dht::token_range& range) {
-    const auto& entries = _components->summary.entries;
-    auto entries_size = entries.size();
-    index_comparator cmp(*_schema);
+    auto entries_size = _components->summary.entries.size();
+    summary_comparator cmp(*_schema, _components->summary);
     dht::ring_position_comparator rp_cmp(*_schema);
     uint64_t left = 0;
     if (range.start()) {
@@ -2966,8 +3131,7 @@ std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(
             return std::nullopt;
         }
 
-        left = std::distance(std::begin(entries),
-            std::lower_bound(entries.begin(), entries.end(), pos, cmp));
+        left = cmp.lower_bound(0, pos);
 
         if (left) {
             --left;
@@ -2979,8 +3143,7 @@ std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(
                                       ? dht::ring_position_view::ending_at(range.end()->value())
                                       : dht::ring_position_view::starting_at(range.end()->value());
 
-        right = std::distance(std::begin(entries),
-            std::lower_bound(entries.begin(), entries.end(), pos, cmp));
+        right = cmp.lower_bound(0, pos);
         if (right == 0) {
             // The first key is strictly greater than right.
             return std::nullopt;
@@ -2996,8 +3159,9 @@ std::vector<dht::decorated_key> sstable::get_key_samples(const schema& s, const
     auto index_range = get_sample_indexes_for_range(range);
     std::vector<dht::decorated_key> res;
     if (index_range) {
+        summary::key_cursor keys(_components->summary, index_range->first);
         for (auto idx = index_range->first; idx < index_range->second; ++idx) {
-            auto pkey = _components->summary.entries[idx].get_key().to_partition_key(s);
+            auto pkey = key_view(keys.next()).to_partition_key(s);
             res.push_back(dht::decorate_key(s, std::move(pkey)));
         }
     }
@@ -3119,6 +3283,10 @@ void register_index_page_cache_metrics(seastar::metrics::metric_groups& metrics,
             sm::description("Total number of bytes cached in the index page cache")),
         sm::make_gauge("index_page_cache_bytes_in_std", [&m] { return m.bytes_in_std; },
             sm::description("Total number of bytes in temporary buffers which live in the std allocator")),
+        sm::make_counter("index_page_cache_reads", [&m] { return m.page_reads; },
+            sm::description("Total number of reads issued by the index page cache. Misses of adjacent pages share reads")),
+        sm::make_counter("index_page_cache_pages_read", [&m] { return m.pages_read; },
+            sm::description("Total number of pages read by the index page cache, divide by index_page_cache_reads for pages per read")),
     });
 }
 
@@ -3137,7 +3305,41 @@ void register_index_page_metrics(seastar::metrics::metric_groups& metrics, parti
             sm::description("Index pages which got populated into memory")),
         sm::make_gauge("index_page_used_bytes", [&m] { return m.used_bytes; },
             sm::description("Amount of bytes used by index pages in memory")),
+        sm::make_counter("index_page_read_aheads", [&m] { return m.read_aheads; },
+            sm::description("Index pages which were read ahead of a sequential scan")),
+
+    });
+}
+
+void register_decompressed_chunk_cache_metrics(seastar::metrics::metric_groups& metrics, decompressed_chunk_cache_stats& m) {
+    namespace sm = seastar::metrics;
+    metrics.add_group("sstables", {
+        sm::make_counter("decompressed_chunk_cache_hits", [&m] { return m.hits; },
+            sm::description("Compressed data chunks which were read from the decompressed chunk cache")),
+        sm::make_counter("decompressed_chunk_cache_misses", [&m] { return m.misses; },
+            sm::description("Compressed data chunks looked up in the decompressed chunk cache which had to be decompressed")),
+        sm::make_counter("decompressed_chunk_cache_populations", [&m] { return m.populations; },
+            sm::description("Decompressed chunks which were inserted into the decompressed chunk cache")),
+        sm::make_counter("decompressed_chunk_cache_evictions", [&m] { return m.evictions; },
+            sm::description("Decompressed chunks which were evicted from the decompressed chunk cache")),
+        sm::make_gauge("decompressed_chunk_cache_bytes", [&m] { return m.cached_bytes; },
+            sm::description("Total number of bytes cached in the decompressed chunk cache")),
+    });
+}
 
+void register_promoted_index_block_cache_metrics(seastar::metrics::metric_groups& metrics, promoted_index_block_cache_stats& m) {
+    namespace sm = seastar::metrics;
+    metrics.add_group("sstables", {
+        sm::make_counter("pi_block_cache_hits", [&m] { return m.hits; },
+            sm::description("Promoted index blocks which were found parsed by an earlier read")),
+        sm::make_counter("pi_block_cache_misses", [&m] { return m.misses; },
+            sm::description("Promoted index blocks which had to be parsed")),
+        sm::make_counter("pi_block_cache_populations", [&m] { return m.populations; },
+            sm::description("Parsed promoted index blocks which were inserted into the cache")),
+        sm::make_counter("pi_block_cache_evictions", [&m] { return m.evictions; },
+            sm::description("Parsed promoted index blocks which were evicted from the cache")),
+        sm::make_gauge("pi_block_cache_bytes", [&m] { return m.used_bytes; },
+            sm::description("Total number of bytes used by parsed promoted index blocks kept across reads")),
     });
 }
 
@@ -3180,6 +3382,8 @@ future<> init_metrics() {
             sm::description("Number of range tombstones written"))(basic_level),
         sm::make_counter("pi_auto_scale_events", [] { return sstables_stats::get_shard_stats().promoted_index_auto_scale_events; },
             sm::description("Number of promoted index auto-scaling events")),
+        sm::make_counter("bti_partition_index_rejections", [] { return sstables_stats::get_shard_stats().bti_partition_index_rejections; },
+            sm::description("Number of single-partition lookups rejected by the BTI partition index without reading the partition index")),
 
         sm::make_counter("range_tombstone_reads", [] { return sstables_stats::get_shard_stats().range_tombstone_reads; },
             sm::description("Number of range tombstones read"))(basic_level),
@@ -3191,6 +3395,8 @@ future<> init_metrics() {
             sm::description("Number of single partition flat mutation reads")),
         sm::make_counter("range_partition_reads", [] { return sstables_stats::get_shard_stats().range_partition_reads; },
             sm::description("Number of partition range flat mutation reads")),
+        sm::make_counter("resumed_range_partition_reads", [] { return sstables_stats::get_shard_stats().resumed_range_partition_reads; },
+            sm::description("Number of partition range flat mutation reads of evicted reads resumed without looking up the index")),
         sm::make_counter("partition_reads", [] { return sstables_stats::get_shard_stats().partition_reads; },
             sm::description("Number of partitions read")),
         sm::make_counter("partition_seeks", [] { return sstables_stats::get_shard_stats().partition_seeks; },
@@ -3266,9 +3472,16 @@ sstable::sstable(schema_ptr schema,
     , _corrupt_data_handler(corrupt_data_handler)
     , _manager(manager)
 {
+    if (_version >= sstable_version_types::mc) {
+        _promoted_index_block_cache = std::make_unique<mc::promoted_index_block_cache>(
+                manager.get_cache_tracker().get_promoted_index_block_cache_stats(),
+                manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region());
+    }
     manager.add(this);
 }
 
+sstable::~sstable() = default;
+
 file sstable::uncached_index_file() {
     return _cached_index_file->get_file();
 }
@@ -3294,6 +3507,15 @@ future<> sstable::destroy() {
     if (_cached_index_file) {
         co_await _cached_index_file->evict_gently();
     }
+    if (_cached_partitions_file) {
+        co_await _cached_partitions_file->evict_gently();
+    }
+    if (_chunk_cache) {
+        co_await _chunk_cache->evict_gently();
+    }
+    if (_promoted_index_block_cache) {
+        co_await _promoted_index_block_cache->evict_gently();
+    }
     co_await _storage->destroy(*this);
 
     if (ex) {
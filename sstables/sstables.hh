@@ -37,6 +37,7 @@
 #include "sstables/storage.hh"
 #include "sstables/generation_type.hh"
 #include "sstables/types.hh"
+#include "sstables/hyperloglog.hh"
 #include "sstables/checksummed_data_source.hh"
 #include "mutation/mutation_fragment_stream_validator.hh"
 #include "readers/mutation_reader_fwd.hh"
@@ -66,10 +67,14 @@ namespace sstables {
 
 struct abstract_index_reader;
 class sstable_directory;
+class decompressed_chunk_cache;
 extern thread_local utils::updateable_value<bool> global_cache_index_pages;
+extern thread_local utils::updateable_value<uint32_t> global_index_read_ahead_pages;
+extern thread_local utils::updateable_value<bool> global_cache_decompressed_chunks;
 
 namespace mc {
 class writer;
+class promoted_index_block_cache;
 }
 
 namespace fs = std::filesystem;
@@ -115,6 +120,11 @@ struct sstable_writer_config {
     size_t summary_byte_cost;
     sstring origin;
     bool correct_pi_block_width = true;
+    // Write the BTI partition index (PartitionTrie.db) in addition to Index.db.
+    bool write_bti_partition_index = false;
+    // Overrides the compression chunk length of the table, see
+    // compression_parameters::auto_chunk_length().
+    std::optional<uint32_t> compression_chunk_length;
 
 private:
     explicit sstable_writer_config() {}
@@ -210,6 +220,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     sstable& operator=(const sstable&) = delete;
     sstable(const sstable&) = delete;
     sstable(sstable&&) = delete;
+    ~sstable();
 
     // disk_read_range describes a byte ranges covering part of an sstable
     // row that we need to read from disk. Usually this is the whole byte
@@ -278,6 +289,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // Returns a mutation_reader for given range of partitions.
     //
     // Precondition: if the slice is reversed, the schema must be reversed as well.
+    //
+    // See mx::make_reader() for project_columns, which is ignored for
+    // sstables older than mc.
     mutation_reader make_reader(
             schema_ptr query_schema,
             reader_permit permit,
@@ -287,7 +301,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
             streamed_mutation::forwarding fwd = streamed_mutation::forwarding::no,
             mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::yes,
             read_monitor& monitor = default_read_monitor(),
-            integrity_check integrity = integrity_check::no);
+            integrity_check integrity = integrity_check::no,
+            project_columns projection = project_columns::no);
 
     // A reader which doesn't use the index at all. It reads everything from the
     // sstable and it doesn't support skipping.
@@ -340,6 +355,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return get_estimated_key_count(_components->summary.header.size_at_full_sampling, _components->summary.header.min_index_interval);
     }
 
+    // Returns the estimator of the number of distinct partitions of the sstable
+    // kept in its compaction metadata, if there is one in a supported format.
+    // Unlike get_estimated_key_count(), estimators of several sstables can be
+    // merged for estimating the number of partitions in their union.
+    std::optional<hll::HyperLogLog> get_partition_count_estimator() const;
+
     uint64_t estimated_keys_for_range(const dht::token_range& range);
 
     std::vector<dht::decorated_key> get_key_samples(const schema& s, const dht::token_range& range);
@@ -380,6 +401,14 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _index_file;
     }
     file uncached_index_file();
+    bool has_bti_partition_index() const {
+        return bool(_cached_partitions_file);
+    }
+    // Looks the key up in the BTI partition index (PartitionTrie.db).
+    // Returns std::nullopt if the key is definitely absent from the sstable,
+    // otherwise a Data file position which may belong to a different partition.
+    // Must only be called if has_bti_partition_index().
+    future<std::optional<uint64_t>> bti_partition_position(const dht::decorated_key& dk);
     // Returns size of bloom filter data.
     uint64_t filter_size() const;
 
@@ -435,7 +464,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     std::vector<std::pair<component_type, sstring>> all_components() const;
 
-    future<> snapshot(const sstring& dir) const;
+    // See storage::snapshot() for sync_dir::no.
+    future<> snapshot(const sstring& dir, storage::sync_dir sync = storage::sync_dir::yes) const;
 
     // Delete the sstable by unlinking all sstable files
     // Ignores all errors.
@@ -545,6 +575,14 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     std::set<generation_type> _compaction_ancestors;
     file _index_file;
     seastar::shared_ptr<cached_file> _cached_index_file;
+    // BTI partition index, opened only if the sstable has the PartitionTrie component.
+    file _partitions_file;
+    seastar::shared_ptr<cached_file> _cached_partitions_file;
+    // Set for compressed sstables.
+    std::unique_ptr<decompressed_chunk_cache> _chunk_cache;
+    // Set for sstables of the mc format and newer.
+    std::unique_ptr<mc::promoted_index_block_cache> _promoted_index_block_cache;
+    int64_t _bti_partitions_root_pos = -1;
     file _data_file;
     uint64_t _data_file_size;
     uint64_t _index_file_size;
@@ -674,6 +712,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     void maybe_rebuild_filter_from_index(uint64_t num_partitions);
 
     future<> update_info_for_opened_data(sstable_open_config cfg = {});
+    future<> open_bti_partition_index();
 
     future<> read_toc() noexcept;
     future<> read_summary() noexcept;
@@ -874,6 +913,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return filter_has_key(key::from_partition_key(s, key));
     }
 
+    // For probing the filters of many sstables at once, see utils::is_present_batch().
+    utils::i_filter& get_filter() const {
+        return *_components->filter;
+    }
+
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
@@ -985,6 +1029,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // for cells and tombstones expired before the time point "GC before", which
     // is the point before which expiring data can be purged.
     double estimate_droppable_tombstone_ratio(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const;
+    // Gets the estimated number of droppable tombstones, as above.
+    double estimate_droppable_tombstones(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const;
 
     // get sstable open info from a loaded sstable, which can be used to quickly open a sstable
     // at another shard.
@@ -1002,6 +1048,14 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // Return true if this sstable possibly stores clustering row(s) specified by ranges.
     bool may_contain_rows(const query::clustering_row_ranges& ranges) const;
 
+    // false => there are no tombstones nor expiring cells, true => we don't know
+    bool may_have_dead_data() const {
+        // Every tombstone and expiring cell lowers the minimum local deletion
+        // time, which is only tracked since the mc format.
+        return _version < sstable_version_types::mc
+            || get_stats_metadata().min_local_deletion_time != std::numeric_limits<int32_t>::max();
+    }
+
     // false => there are no partition tombstones, true => we don't know
     bool may_have_partition_tombstones() const {
         return !has_correct_min_max_column_names()
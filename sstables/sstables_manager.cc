@@ -14,6 +14,7 @@
 #include "sstables/sstables_registry.hh"
 #include "sstables/partition_index_cache.hh"
 #include "sstables/sstables.hh"
+#include "sstables/sstable_directory.hh"
 #include "db/config.hh"
 #include "gms/feature.hh"
 #include "gms/feature_service.hh"
@@ -71,6 +72,10 @@ void sstables_manager::subscribe(sstables_manager_event_handler& handler) {
 storage_manager::storage_manager(const db::config& cfg, config stm_cfg)
     : _s3_clients_memory(stm_cfg.s3_clients_memory)
     , _config_updater(this_shard_id() == 0 ? std::make_unique<config_updater>(cfg, *this) : nullptr)
+    , _object_storage_cache((size_t(cfg.object_storage_cache_size_in_mb()) << 20) / smp::count)
+    , _object_storage_cache_size_observer(cfg.object_storage_cache_size_in_mb.observe([this] (uint32_t size_in_mb) {
+        _object_storage_cache.set_capacity((size_t(size_in_mb) << 20) / smp::count);
+    }))
 {
     for (auto& e : cfg.object_storage_endpoints()) {
         _s3_endpoints.emplace(std::make_pair(std::move(e.endpoint), make_lw_shared<s3::endpoint_config>(std::move(e.config))));
@@ -174,6 +179,7 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.write_bti_partition_index = _db_config.sstable_write_bti_partition_index();
 
     cfg.origin = std::move(origin);
 
@@ -182,6 +188,12 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
 
 void sstables_manager::increment_total_reclaimable_memory(sstable* sst) {
     _total_reclaimable_memory += sst->total_reclaimable_memory_size();
+    // An sstable opened with a deferred filter has it loaded by the
+    // components reloader, like a reclaimed one.
+    if (auto deferred = sst->total_memory_reclaimed(); deferred > 0 && !sst->_manager_set_link.is_linked()) {
+        _total_memory_reclaimed += deferred;
+        _reclaimed.insert(*sst);
+    }
     _components_memory_change_event.signal();
 }
 
@@ -213,6 +225,22 @@ size_t sstables_manager::get_memory_available_for_reclaimable_components() const
     return get_components_memory_reclaim_threshold() - _total_reclaimable_memory;
 }
 
+uint64_t sstables_manager::summary_memory_footprint() const {
+    uint64_t total = 0;
+    for (const auto& sst : _active) {
+        total += sst.get_summary().memory_footprint();
+    }
+    return total;
+}
+
+uint64_t sstables_manager::summary_key_bytes() const {
+    uint64_t total = 0;
+    for (const auto& sst : _active) {
+        total += sst.get_summary().key_bytes();
+    }
+    return total;
+}
+
 future<> sstables_manager::components_reclaim_reload_fiber() {
     auto components_memory_reclaim_threshold_observer = _db_config.components_memory_reclaim_threshold.observe([&] (double) {
         // any change to the components_memory_reclaim_threshold config should trigger reload/reclaim
@@ -271,6 +299,8 @@ future<> sstables_manager::maybe_reload_components() {
         }
 
         _total_memory_reclaimed -= reclaimed_memory;
+        // The size of a deferred filter is only estimated until it's loaded.
+        _total_reclaimable_memory = _total_reclaimable_memory - reclaimed_memory + sstable_ptr->total_reclaimable_memory_size();
         memory_available = get_memory_available_for_reclaimable_components();
     }
 }
@@ -282,7 +312,9 @@ void sstables_manager::reclaim_memory_and_stop_tracking_sstable(sstable* sst) {
     // reclaim any remaining memory from the sstable
     sst->reclaim_memory_from_components();
     // disable further reload of components
-    _reclaimed.erase(*sst);
+    if (sst->_manager_set_link.is_linked()) {
+        _reclaimed.erase(_reclaimed.iterator_to(*sst));
+    }
     sst->disable_component_memory_reload();
 }
 
@@ -339,6 +371,12 @@ future<> sstables_manager::delete_atomically(std::vector<shared_sstable> ssts) {
     co_await storage.atomic_delete_complete(std::move(ctx));
 }
 
+future<> sstables_manager::load_sstables(std::vector<shared_sstable>& ssts, const dht::sharder& sharder, sstable_open_config cfg) {
+    co_await _dir_semaphore.parallel_for_each(ssts, [&sharder, cfg] (shared_sstable& sst) {
+        return sst->load(sharder, cfg);
+    });
+}
+
 future<> sstables_manager::close() {
     _closing = true;
     maybe_done();
@@ -19,6 +19,7 @@
 #include "sstables/sstables.hh"
 #include "sstables/shareable_components.hh"
 #include "sstables/shared_sstable.hh"
+#include "sstables/object_storage_cache.hh"
 #include "sstables/version.hh"
 #include "db/cache_tracker.hh"
 #include "locator/host_id.hh"
@@ -65,6 +66,8 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     semaphore _s3_clients_memory;
     std::unordered_map<sstring, s3_endpoint> _s3_endpoints;
     std::unique_ptr<config_updater> _config_updater;
+    object_storage_cache _object_storage_cache;
+    utils::observer<uint32_t> _object_storage_cache_size_observer;
 
     future<> update_config(const db::config&);
 
@@ -76,6 +79,9 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     storage_manager(const db::config&, config cfg);
     shared_ptr<s3::client> get_endpoint_client(sstring endpoint);
     bool is_known_endpoint(sstring endpoint) const;
+    object_storage_cache& get_object_storage_cache() noexcept {
+        return _object_storage_cache;
+    }
     future<> stop();
 };
 
@@ -83,7 +89,7 @@ class sstables_manager {
     using list_type = boost::intrusive::list<sstable,
             boost::intrusive::member_hook<sstable, sstable::manager_list_link_type, &sstable::_manager_list_link>,
             boost::intrusive::constant_time_size<false>>;
-    using set_type = boost::intrusive::set<sstable,
+    using set_type = boost::intrusive::multiset<sstable,
             boost::intrusive::member_hook<sstable, sstable::manager_set_link_type, &sstable::_manager_set_link>,
             boost::intrusive::constant_time_size<false>,
             boost::intrusive::compare<sstable::lesser_reclaimed_memory>>;
@@ -119,7 +125,8 @@ class sstables_manager {
     size_t _total_reclaimable_memory{0};
     // Total memory reclaimed so far across all sstables
     size_t _total_memory_reclaimed{0};
-    // Set of sstables from which memory has been reclaimed
+    // Set of sstables from which memory has been reclaimed, or whose
+    // components are yet to be loaded (see sstable_open_config::defer_bloom_filter)
     set_type _reclaimed;
     // Condition variable that needs to be notified when an sstable is created or deleted
     seastar::condition_variable _components_memory_change_event;
@@ -178,6 +185,11 @@ class sstables_manager {
         return _storage->get_endpoint_client(std::move(endpoint));
     }
 
+    object_storage_cache& get_object_storage_cache() const {
+        SCYLLA_ASSERT(_storage != nullptr);
+        return _storage->get_object_storage_cache();
+    }
+
     bool is_known_endpoint(sstring endpoint) const {
         SCYLLA_ASSERT(_storage != nullptr);
         return _storage->is_known_endpoint(std::move(endpoint));
@@ -215,6 +227,12 @@ class sstables_manager {
     }
 
     future<> delete_atomically(std::vector<shared_sstable> ssts);
+
+    // Loads the sstables, many at a time. The components of an sstable are
+    // read with a round trip each, so loading thousands of small sstables one
+    // after another is dominated by the latency of the storage. The number of
+    // sstables loaded at a time is bounded by the directory semaphore.
+    future<> load_sstables(std::vector<shared_sstable>& ssts, const dht::sharder& sharder, sstable_open_config cfg);
     future<lw_shared_ptr<const data_dictionary::storage_options>> init_table_storage(const schema& s, const data_dictionary::storage_options& so);
     future<> destroy_table_storage(const data_dictionary::storage_options& so);
     future<> init_keyspace_storage(const data_dictionary::storage_options& so, sstring dir);
@@ -233,6 +251,11 @@ class sstables_manager {
     // unsubscribe happens automatically when the handler is destroyed
     void subscribe(sstables_manager_event_handler& handler);
 
+    // Memory used by the summaries of the active sstables.
+    uint64_t summary_memory_footprint() const;
+    // Total size the keys of those summaries would take uncompressed.
+    uint64_t summary_key_bytes() const;
+
 private:
     void add(sstable* sst);
     // Transition the sstable to the "inactive" state. It has no
@@ -25,6 +25,7 @@ class sstables_stats {
         uint64_t cell_tombstone_writes = 0;
         uint64_t single_partition_reads = 0;
         uint64_t range_partition_reads = 0;
+        uint64_t resumed_range_partition_reads = 0;
         uint64_t partition_reads = 0;
         uint64_t partition_seeks = 0;
         uint64_t row_reads = 0;
@@ -36,6 +37,7 @@ class sstables_stats {
         uint64_t closed_for_writing = 0;
         uint64_t deleted = 0;
         uint64_t promoted_index_auto_scale_events = 0;
+        uint64_t bti_partition_index_rejections = 0;
     } _shard_stats;
 
     stats& _stats = _shard_stats;
@@ -89,6 +91,10 @@ class sstables_stats {
         ++_stats.range_partition_reads;
     }
 
+    inline void on_range_partition_read_resumed() noexcept {
+        ++_stats.resumed_range_partition_reads;
+    }
+
     inline void on_partition_read() noexcept {
         ++_stats.partition_reads;
     }
@@ -130,6 +136,10 @@ class sstables_stats {
     inline void on_promoted_index_auto_scale() noexcept {
         ++_stats.promoted_index_auto_scale_events;
     }
+
+    inline void on_bti_partition_index_rejection() noexcept {
+        ++_stats.bti_partition_index_rejections;
+    }
 };
 
 }
@@ -39,14 +39,151 @@
 
 #include "utils/checked-file-impl.hh"
 
+bool is_internal_keyspace(std::string_view name);
+
 namespace sstables {
 
+// Uploads of the components of an sstable being written to local disk,
+// made from the written buffers (see the backup_on_flush_* options), so
+// that backing the sstable up needs no second read of it.
+struct backup_on_flush {
+    shared_ptr<s3::client> client;
+    // "/bucket/prefix/keyspace/table"
+    sstring prefix;
+    // Set once an upload of any component failed. The TOC is then not
+    // uploaded, so the backup of the sstable stays visibly incomplete.
+    bool failed = false;
+};
+
+// Passes the written buffers to both the local file and to the upload of
+// the component. Failures of the upload don't fail the write.
+class backup_on_flush_sink final : public data_sink_impl {
+    data_sink _local;
+    std::optional<data_sink> _upload;
+    lw_shared_ptr<backup_on_flush> _backup;
+    sstring _object_name;
+    bool _local_failed = false;
+    bool _flushed = false;
+
+    future<> upload(std::vector<temporary_buffer<char>> bufs) {
+        if (!_upload) {
+            co_return;
+        }
+        try {
+            co_await _upload->put(std::move(bufs));
+        } catch (...) {
+            sstlog.warn("Failed to back up {}: {}", _object_name, std::current_exception());
+            _backup->failed = true;
+        }
+        if (_backup->failed) {
+            co_await close_upload();
+        }
+    }
+
+    future<> close_upload() noexcept {
+        // Closing the upload sink before flushing it aborts the upload.
+        auto sink = std::move(*_upload);
+        _upload.reset();
+        try {
+            co_await sink.close();
+        } catch (...) {
+            sstlog.warn("Failed to close the backup of {}: {}", _object_name, std::current_exception());
+        }
+    }
+
+    // Writes data to the local file while its copy in bufs is uploaded,
+    // so a slow upload doesn't add to the latency of the local write.
+    template <typename Data>
+    future<> put_both(Data data, std::vector<temporary_buffer<char>> bufs) {
+        // upload() never fails.
+        auto uploaded = upload(std::move(bufs));
+        std::exception_ptr ex;
+        try {
+            co_await _local.put(std::move(data));
+        } catch (...) {
+            _local_failed = true;
+            ex = std::current_exception();
+        }
+        co_await std::move(uploaded);
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+    }
+public:
+    backup_on_flush_sink(data_sink local, lw_shared_ptr<backup_on_flush> backup, sstring object_name)
+        : _local(std::move(local))
+        , _backup(std::move(backup))
+        , _object_name(std::move(object_name))
+    {
+        if (!_backup->failed) {
+            _upload.emplace(_backup->client->make_upload_sink(_object_name));
+        }
+    }
+
+    virtual future<> put(net::packet p) override {
+        return put(p.release());
+    }
+    virtual future<> put(std::vector<temporary_buffer<char>> data) override {
+        _flushed = false;
+        std::vector<temporary_buffer<char>> shared;
+        if (_upload) {
+            shared.reserve(data.size());
+            for (auto& buf : data) {
+                shared.push_back(buf.share());
+            }
+        }
+        co_await put_both(std::move(data), std::move(shared));
+    }
+    virtual future<> put(temporary_buffer<char> buf) override {
+        _flushed = false;
+        std::vector<temporary_buffer<char>> shared;
+        if (_upload) {
+            shared.push_back(buf.share());
+        }
+        co_await put_both(std::move(buf), std::move(shared));
+    }
+    virtual future<> flush() override {
+        co_await _local.flush();
+        _flushed = !_local_failed;
+    }
+    virtual future<> close() override {
+        std::exception_ptr ex;
+        try {
+            co_await _local.close();
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        // The upload is completed only if everything written made it to
+        // the local file, otherwise it's aborted.
+        if (_upload && _flushed && !ex) {
+            try {
+                co_await _upload->flush();
+            } catch (...) {
+                sstlog.warn("Failed to back up {}: {}", _object_name, std::current_exception());
+                _backup->failed = true;
+            }
+        } else if (_upload) {
+            _backup->failed = true;
+        }
+        if (_upload) {
+            co_await close_upload();
+        }
+        if (ex) {
+            std::rethrow_exception(ex);
+        }
+    }
+    virtual size_t buffer_size() const noexcept override {
+        return _local.buffer_size();
+    }
+};
+
 // cannot define these classes in an anonymous namespace, as we need to
 // declare these storage classes as "friend" of class sstable
 class filesystem_storage final : public sstables::storage {
     mutable opened_directory _base_dir;
     mutable opened_directory _dir;
     std::optional<std::filesystem::path> _temp_dir; // Valid while the sstable is being created, until sealed
+    lw_shared_ptr<backup_on_flush> _backup; // Valid while the sstable is being created, if it's backed up on flush
 
 private:
     using mark_for_removal = bool_class<class mark_for_removal_tag>;
@@ -59,6 +196,9 @@ class filesystem_storage final : public sstables::storage {
 
     future<> check_create_links_replay(const sstable& sst, const sstring& dst_dir, generation_type dst_gen, const std::vector<std::pair<sstables::component_type, sstring>>& comps) const;
     future<> remove_temp_dir();
+    void maybe_start_backup(const sstable& sst);
+    future<data_sink> maybe_back_up(const sstable& sst, component_type type, data_sink sink) const;
+    future<> finish_backup(const sstable& sst);
     virtual future<> create_links(const sstable& sst, const std::filesystem::path& dir) const override;
     future<> create_links_common(const sstable& sst, sstring dst_dir, generation_type dst_gen, mark_for_removal mark_for_removal) const;
     future<> create_links_common(const sstable& sst, const std::filesystem::path& dir, std::optional<generation_type> dst_gen) const;
@@ -82,7 +222,7 @@ class filesystem_storage final : public sstables::storage {
     {}
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir sync) const override;
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -100,6 +240,7 @@ class filesystem_storage final : public sstables::storage {
     }
 
     virtual sstring prefix() const override { return _dir.native(); }
+    virtual bool supports_snapshot() const noexcept override { return true; }
 };
 
 future<data_sink> filesystem_storage::make_data_or_index_sink(sstable& sst, component_type type) {
@@ -108,7 +249,8 @@ future<data_sink> filesystem_storage::make_data_or_index_sink(sstable& sst, comp
     options.write_behind = 10;
 
     SCYLLA_ASSERT(type == component_type::Data || type == component_type::Index);
-    return make_file_data_sink(type == component_type::Data ? std::move(sst._data_file) : std::move(sst._index_file), options);
+    auto sink = co_await make_file_data_sink(type == component_type::Data ? std::move(sst._data_file) : std::move(sst._index_file), options);
+    co_return co_await maybe_back_up(sst, type, std::move(sink));
 }
 
 future<data_source> filesystem_storage::make_data_or_index_source(sstable&, component_type type, file f, uint64_t offset, uint64_t len, file_input_stream_options opt) const {
@@ -117,9 +259,56 @@ future<data_source> filesystem_storage::make_data_or_index_source(sstable&, comp
 }
 
 future<data_sink> filesystem_storage::make_component_sink(sstable& sst, component_type type, open_flags oflags, file_output_stream_options options) {
-    return sst.new_sstable_component_file(sst._write_error_handler, type, oflags).then([options = std::move(options)] (file f) mutable {
-        return make_file_data_sink(std::move(f), std::move(options));
-    });
+    auto f = co_await sst.new_sstable_component_file(sst._write_error_handler, type, oflags);
+    auto sink = co_await make_file_data_sink(std::move(f), std::move(options));
+    co_return co_await maybe_back_up(sst, type, std::move(sink));
+}
+
+void filesystem_storage::maybe_start_backup(const sstable& sst) {
+    const auto& cfg = sst.manager().config();
+    auto endpoint = cfg.backup_on_flush_endpoint();
+    if (endpoint.empty() || is_internal_keyspace(sst._schema->ks_name())) {
+        return;
+    }
+    if (!cfg.extensions().sstable_file_io_extensions().empty()) {
+        // The written buffers are not encrypted yet, the backup task is to be used instead.
+        sstlog.debug("Not backing up {} on flush, sstable file extensions are in use", sst.get_filename());
+        return;
+    }
+    auto backup = make_lw_shared<backup_on_flush>();
+    backup->client = sst.manager().get_endpoint_client(endpoint);
+    backup->prefix = format("/{}/{}/{}/{}", cfg.backup_on_flush_bucket(), cfg.backup_on_flush_prefix(), sst._schema->ks_name(), sst._schema->cf_name());
+    _backup = std::move(backup);
+}
+
+future<data_sink> filesystem_storage::maybe_back_up(const sstable& sst, component_type type, data_sink sink) const {
+    // The TOC is uploaded when the sstable is sealed.
+    if (!_backup || type == component_type::TOC || type == component_type::TemporaryTOC) {
+        co_return sink;
+    }
+    co_return data_sink(std::make_unique<backup_on_flush_sink>(std::move(sink), _backup, format("{}/{}", _backup->prefix, sst.component_basename(type))));
+}
+
+future<> filesystem_storage::finish_backup(const sstable& sst) {
+    auto backup = std::exchange(_backup, nullptr);
+    if (!backup) {
+        co_return;
+    }
+    auto toc_name = format("{}/{}", backup->prefix, sst.component_basename(component_type::TOC));
+    if (backup->failed) {
+        sstlog.warn("Backup of {} on flush is incomplete, not uploading {}", sst.get_filename(), toc_name);
+        co_return;
+    }
+    sstring toc;
+    for (auto&& c : sst._recognized_components) {
+        toc += sstable_version_constants::get_component_map(sst.get_version()).at(c) + "\n";
+    }
+    try {
+        co_await backup->client->put_object(toc_name, temporary_buffer<char>(toc.data(), toc.size()));
+        sstlog.debug("Backed up {} on flush", sst.get_filename());
+    } catch (...) {
+        sstlog.warn("Failed to back up {}: {}", toc_name, std::current_exception());
+    }
 }
 
 static future<file> open_sstable_component_file_non_checked(std::string_view name, open_flags flags, file_open_options options,
@@ -175,6 +364,7 @@ future<file> filesystem_storage::open_component(const sstable& sst, component_ty
 
 void filesystem_storage::open(sstable& sst) {
     touch_temp_dir(sst).get();
+    maybe_start_backup(sst);
 
     // Writing TOC content to temporary file.
     // If creation of temporary TOC failed, it implies that that boot failed to
@@ -216,6 +406,7 @@ future<> filesystem_storage::seal(const sstable& sst) {
     co_await _dir.sync(sst._write_error_handler);
     // If this point was reached, sstable should be safe in disk.
     sstlog.debug("SSTable with generation {} of {}.{} was sealed successfully.", sst._generation, sst._schema->ks_name(), sst._schema->cf_name());
+    co_await finish_backup(sst);
 }
 
 future<> filesystem_storage::touch_temp_dir(const sstable& sst) {
@@ -387,7 +578,7 @@ future<> filesystem_storage::create_links(const sstable& sst, const std::filesys
     return create_links_common(sst, dir.native(), sst._generation, mark_for_removal::no);
 }
 
-future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const {
+future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir sync) const {
     std::filesystem::path snapshot_dir;
     if (abs) {
         snapshot_dir = dir;
@@ -395,7 +586,24 @@ future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_
         snapshot_dir = _dir.path() / dir;
     }
     co_await sst.sstable_touch_directory_io_check(snapshot_dir);
-    co_await create_links_common(sst, snapshot_dir, std::move(gen));
+    if (sync) {
+        co_await create_links_common(sst, snapshot_dir, std::move(gen));
+        co_return;
+    }
+    // Without the TemporaryTOC and the directory syncs of create_links_common(),
+    // which add up to several fsyncs of the snapshot directory per sstable.
+    // idempotent_link_file() fails if a different file exists under the name.
+    auto dst_gen = gen.value_or(sst._generation);
+    auto comps = sst.all_components();
+    std::erase_if(comps, [] (const auto& p) { return p.first == component_type::TOC; });
+    co_await parallel_for_each(comps, [this, &sst, &snapshot_dir, dst_gen] (const auto& p) {
+        auto src = filename(sst, _dir.native(), sst._generation, p.second);
+        auto dst = filename(sst, snapshot_dir.native(), dst_gen, p.second);
+        return sst.sstable_write_io_check(idempotent_link_file, std::move(src), std::move(dst));
+    });
+    // TOC is linked last, so that an sstable without it is known to be incomplete.
+    co_await sst.sstable_write_io_check(idempotent_link_file, fmt::to_string(sst.filename(component_type::TOC)),
+            filename(sst, snapshot_dir.native(), dst_gen, component_type::TOC));
 }
 
 future<> filesystem_storage::move(const sstable& sst, sstring new_dir, generation_type new_generation, delayed_commit_changes* delay_commit) {
@@ -545,12 +753,16 @@ class s3_storage : public sstables::storage {
     sstring _bucket;
     std::variant<sstring, table_id> _location;
     seastar::abort_source* _as;
+    object_storage_cache& _cache;
 
     static constexpr auto status_creating = "creating";
     static constexpr auto status_sealed = "sealed";
     static constexpr auto status_removing = "removing";
 
     sstring make_s3_object_name(const sstable& sst, component_type type) const;
+    // Opens the object of the component, reading it through the cache if
+    // the component is worth caching.
+    file make_readable_file(const sstable& sst, component_type type) const;
 
     table_id owner() const {
         if (std::holds_alternative<sstring>(_location)) {
@@ -560,16 +772,17 @@ class s3_storage : public sstables::storage {
     }
 
 public:
-    s3_storage(shared_ptr<s3::client> client, sstring bucket, std::variant<sstring, table_id> loc, seastar::abort_source* as)
+    s3_storage(shared_ptr<s3::client> client, sstring bucket, std::variant<sstring, table_id> loc, seastar::abort_source* as, object_storage_cache& cache)
         : _client(std::move(client))
         , _bucket(std::move(bucket))
         , _location(std::move(loc))
         , _as(as)
+        , _cache(cache)
     {
     }
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type>) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type>, sync_dir) const override;
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -590,6 +803,7 @@ class s3_storage : public sstables::storage {
     }
 
     virtual sstring prefix() const override { return std::visit([] (const auto& v) { return fmt::to_string(v); }, _location); }
+    virtual bool supports_snapshot() const noexcept override { return false; }
 };
 
 sstring s3_storage::make_s3_object_name(const sstable& sst, component_type type) const {
@@ -607,6 +821,24 @@ sstring s3_storage::make_s3_object_name(const sstable& sst, component_type type)
     }, _location);
 }
 
+file s3_storage::make_readable_file(const sstable& sst, component_type type) const {
+    auto object_name = make_s3_object_name(sst, type);
+    auto f = _client->make_readable_file(object_name, _as);
+    switch (type) {
+    case component_type::Data:
+        return _cache.wrap(std::move(f), std::move(object_name), false);
+    case component_type::Index:
+    case component_type::PartitionTrie:
+    case component_type::Summary:
+    case component_type::Filter:
+    case component_type::CompressionInfo:
+        return _cache.wrap(std::move(f), std::move(object_name), true);
+    default:
+        // The other components are read once, when the sstable is loaded.
+        return f;
+    }
+}
+
 void s3_storage::open(sstable& sst) {
     entry_descriptor desc(sst._generation, sst._version, sst._format, component_type::TOC);
     sst.manager().sstables_registry().create_entry(owner(), status_creating, sst._state, std::move(desc)).get();
@@ -625,7 +857,7 @@ void s3_storage::open(sstable& sst) {
 }
 
 future<file> s3_storage::open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) {
-    return maybe_wrap_file(sst, type, flags, _client->make_readable_file(make_s3_object_name(sst, type), _as));
+    return maybe_wrap_file(sst, type, flags, make_readable_file(sst, type));
 }
 
 static future<data_sink> maybe_wrap_sink(const sstable& sst, component_type type, data_sink sink) {
@@ -671,6 +903,21 @@ future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_ty
 
 future<data_source>
 s3_storage::make_data_or_index_source(sstable& sst, component_type type, file f, uint64_t offset, uint64_t len, file_input_stream_options options) const {
+    const auto& cfg = sst.manager().config();
+    auto depth = cfg.object_storage_read_ahead_depth();
+    size_t part_size = size_t(cfg.object_storage_read_ahead_part_size_in_kb()) << 10;
+    // Reads spanning several parts are scans, which are worth fetching ahead
+    // in parallel. Shorter ones are left to the chunked source or the cache.
+    if (depth > 0 && part_size > 0 && len > part_size) {
+        co_return co_await maybe_wrap_source(
+            sst,
+            type,
+            [this, object_name = make_s3_object_name(sst, type), depth, part_size](uint64_t offset, uint64_t len) {
+                return _client->make_parallel_download_source(object_name, s3::range{offset, len}, depth, part_size, _as);
+            },
+            offset,
+            len);
+    }
     if (offset == 0) {
         co_return co_await maybe_wrap_source(
             sst,
@@ -682,7 +929,7 @@ s3_storage::make_data_or_index_source(sstable& sst, component_type type, file f,
             len);
     }
     co_return make_file_data_source(
-        co_await maybe_wrap_file(sst, type, open_flags::ro, _client->make_readable_file(make_s3_object_name(sst, type), _as)), offset, len, std::move(options));
+        co_await maybe_wrap_file(sst, type, open_flags::ro, make_readable_file(sst, type)), offset, len, std::move(options));
 }
 
 future<data_sink> s3_storage::make_component_sink(sstable& sst, component_type type, open_flags oflags, file_output_stream_options options) {
@@ -709,7 +956,9 @@ future<> s3_storage::wipe(const sstable& sst, sync_dir) noexcept {
     co_await sstables_registry.update_entry_status(owner(), sst.generation(), status_removing);
 
     co_await coroutine::parallel_for_each(sst._recognized_components, [this, &sst] (auto type) -> future<> {
-        co_await _client->delete_object(make_s3_object_name(sst, type));
+        auto object_name = make_s3_object_name(sst, type);
+        _cache.invalidate(object_name);
+        co_await _client->delete_object(std::move(object_name));
     });
 
     co_await sstables_registry.delete_entry(owner(), sst.generation());
@@ -747,7 +996,7 @@ future<> s3_storage::remove_by_registry_entry(entry_descriptor desc) {
     co_await _client->delete_object(prefix + "/" + sstable_version_constants::TOC_SUFFIX);
 }
 
-future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const {
+future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen, sync_dir) const {
     on_internal_error(sstlog, "Snapshotting S3 objects not implemented");
     co_return;
 }
@@ -767,7 +1016,8 @@ std::unique_ptr<sstables::storage> make_storage(sstables_manager& manager, const
                     }, os.location)) {
                 on_internal_error(sstlog, "S3 storage options is missing 'location'");
             }
-            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.bucket, os.location, os.abort_source);
+            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.bucket, os.location, os.abort_source,
+                    manager.get_object_storage_cache());
         }
     }, s_opts.value);
 }
@@ -99,7 +99,9 @@ class storage {
     using sync_dir = bool_class<struct sync_dir_tag>; // meaningful only to filesystem storage
 
     virtual future<> seal(const sstable& sst) = 0;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen = {}) const = 0;
+    // With sync_dir::no, the links are not made durable, nor crash-safe, one
+    // sstable at a time, and the caller is responsible for syncing the directory.
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen = {}, sync_dir sync = sync_dir::yes) const = 0;
     virtual future<> change_state(const sstable& sst, sstable_state to, generation_type generation, delayed_commit_changes* delay) = 0;
     // runs in async context
     virtual void open(sstable& sst) = 0;
@@ -116,6 +118,8 @@ class storage {
     virtual future<uint64_t> free_space() const = 0;
 
     virtual sstring prefix() const  = 0;
+    // Whether snapshot() is implemented, so that sstables can be cloned cheaply.
+    virtual bool supports_snapshot() const noexcept = 0;
 };
 
 std::unique_ptr<sstables::storage> make_storage(sstables_manager& manager, const data_dictionary::storage_options& s_opts, sstable_state state);
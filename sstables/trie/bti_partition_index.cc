@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <seastar/core/byteorder.hh>
+#include "bti_partition_index.hh"
+#include "bti_key_translation.hh"
+#include "bti_node_reader.hh"
+#include "trie_traversal.hh"
+#include "utils/cached_file.hh"
+
+namespace sstables::trie {
+
+static uint8_t token_byte(const dht::token& t) {
+    return uint8_t(t.unbias());
+}
+
+static std::vector<std::byte> translate_key(const schema& s, const dht::decorated_key& dk) {
+    lazy_comparable_bytes_from_ring_position lcb(s, dk);
+    std::vector<std::byte> out;
+    for (auto it = lcb.begin(); it != lcb.end(); ++it) {
+        auto frag = *it;
+        out.insert(out.end(), frag.begin(), frag.end());
+    }
+    return out;
+}
+
+bti_partition_index_writer::bti_partition_index_writer(file_writer& w)
+    : _w(w)
+    , _sink(w, cached_file::page_size)
+    , _trie(_sink)
+{ }
+
+void bti_partition_index_writer::add_prev(size_t next_mismatch) {
+    auto len = std::min(std::max(_prev_depth, next_mismatch) + 1, _prev_key.size());
+    std::array<std::byte, 9> payload;
+    unsigned pos_bytes = std::max<unsigned>(1, (std::bit_width(_prev_pos) + 7) / 8);
+    for (unsigned i = 0; i < pos_bytes; ++i) {
+        payload[i] = std::byte(_prev_pos >> (8 * (pos_bytes - 1 - i)));
+    }
+    payload[pos_bytes] = std::byte(_prev_token_byte);
+    _trie.add(_prev_depth, const_bytes(_prev_key).subspan(_prev_depth, len - _prev_depth),
+            trie_payload(pos_bytes, const_bytes(payload).first(pos_bytes + 1)));
+}
+
+void bti_partition_index_writer::add(const schema& s, const dht::decorated_key& dk, uint64_t data_file_pos) {
+    auto key = translate_key(s, dk);
+    if (_count) {
+        size_t mismatch = std::ranges::mismatch(_prev_key, key).in1 - _prev_key.begin();
+        add_prev(mismatch);
+        _prev_depth = mismatch;
+    }
+    _prev_key = std::move(key);
+    _prev_pos = data_file_pos;
+    _prev_token_byte = token_byte(dk.token());
+    ++_count;
+}
+
+void bti_partition_index_writer::finish() {
+    if (_count) {
+        add_prev(0);
+    }
+    auto root = _trie.finish();
+    char footer[bti_partition_index_footer_size];
+    seastar::write_be<uint64_t>(footer, _count);
+    seastar::write_be<uint64_t>(footer + 8, root.valid() ? uint64_t(root.value) : std::numeric_limits<uint64_t>::max());
+    _w.write(footer, sizeof(footer));
+}
+
+bti_partition_index_footer parse_bti_partition_index_footer(const char* buf) {
+    bti_partition_index_footer footer;
+    footer.partition_count = seastar::read_be<uint64_t>(buf);
+    auto root = seastar::read_be<uint64_t>(buf + 8);
+    footer.root_pos = root == std::numeric_limits<uint64_t>::max() ? -1 : int64_t(root);
+    return footer;
+}
+
+future<std::optional<uint64_t>> bti_partition_index_lookup(cached_file& f, int64_t root_pos,
+        const schema& s, const dht::decorated_key& dk) {
+    if (root_pos < 0) {
+        co_return std::nullopt;
+    }
+    bti_node_reader reader(f);
+    lazy_comparable_bytes_from_ring_position key(s, dk);
+    auto key_it = key.begin();
+    auto state = co_await traverse(reader, key_it, root_pos);
+    // Keys are stored as the leaves of the trie. If the walk stopped
+    // anywhere else, the key diverges from all the stored prefixes.
+    const auto& last = state.trail.back();
+    if (!last.payload_bits) {
+        co_return std::nullopt;
+    }
+    auto payload = reader.get_payload(last.pos);
+    uint64_t pos = 0;
+    for (unsigned i = 0; i < last.payload_bits; ++i) {
+        pos = (pos << 8) | uint8_t(payload[i]);
+    }
+    if (uint8_t(payload[last.payload_bits]) != token_byte(dk.token())) {
+        co_return std::nullopt;
+    }
+    co_return pos;
+}
+
+} // namespace sstables::trie
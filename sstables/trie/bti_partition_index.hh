@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+// This file implements the BTI partition index (PartitionTrie.db) on top of
+// the generic trie writer and traversal routines.
+//
+// The index maps partition keys, translated to the BTI byte-comparable
+// encoding (see bti_key_translation.hh), to positions of the partitions
+// in the Data file. Like in Cassandra, each key is stored as its shortest
+// prefix which distinguishes it from both of its neighbours, so the trie
+// is typically only a few bytes deep (mostly token bytes), regardless of
+// the length of the keys.
+//
+// Since the full keys are not stored, a lookup of a key which is absent
+// from the sstable can end on the leaf of a different key. To filter out
+// most of those, the payload of each leaf carries one extra byte of the
+// key's token (the least significant one, which is almost never a part of
+// the stored prefix), in addition to the Data file position.
+//
+// Payload layout: `payload_bits` (1-8) is the number of bytes of the Data
+// file position, which follows in big-endian, and is followed by the token byte.
+//
+// The file ends with a footer:
+//
+//   number of partitions (u64), position of the root node (u64)
+//
+// Both big-endian. The root position is UINT64_MAX for an empty trie.
+
+#pragma once
+
+#include <vector>
+#include <seastar/core/future.hh>
+#include "dht/decorated_key.hh"
+#include "sstables/file_writer.hh"
+#include "bti_node_sink.hh"
+#include "trie_writer.hh"
+
+class cached_file;
+
+namespace sstables::trie {
+
+constexpr size_t bti_partition_index_footer_size = 16;
+
+struct bti_partition_index_footer {
+    uint64_t partition_count = 0;
+    // Negative if the trie is empty.
+    int64_t root_pos = -1;
+};
+
+// Builds a BTI partition index from keys added in ring order.
+class bti_partition_index_writer {
+    file_writer& _w;
+    bti_node_sink _sink;
+    trie_writer<bti_node_sink> _trie;
+    // Each key can be added to the trie only once the following key is known,
+    // because its stored prefix has to distinguish it from that key too.
+    std::vector<std::byte> _prev_key;
+    // Length of the common prefix of the previous key and its predecessor.
+    size_t _prev_depth = 0;
+    uint64_t _prev_pos = 0;
+    uint8_t _prev_token_byte = 0;
+    uint64_t _count = 0;
+private:
+    void add_prev(size_t next_mismatch);
+public:
+    explicit bti_partition_index_writer(file_writer& w);
+
+    // Keys must be added in strictly increasing ring order.
+    void add(const schema& s, const dht::decorated_key& dk, uint64_t data_file_pos);
+    // Writes out the remaining nodes and the footer. Doesn't close the file writer.
+    void finish();
+};
+
+// Parses the footer, the last bti_partition_index_footer_size bytes of the file.
+bti_partition_index_footer parse_bti_partition_index_footer(const char* buf);
+
+// Returns the Data file position of the partition with the given key,
+// or std::nullopt if the key is definitely absent from the sstable.
+// A returned position may belong to a different partition, the caller has
+// to check its key.
+future<std::optional<uint64_t>> bti_partition_index_lookup(cached_file& f, int64_t root_pos,
+        const schema& s, const dht::decorated_key& dk);
+
+} // namespace sstables::trie
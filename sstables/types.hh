@@ -17,6 +17,7 @@
 #include "mutation/tombstone.hh"
 #include "utils/streaming_histogram.hh"
 #include "utils/estimated_histogram.hh"
+#include "utils/i_filter.hh"
 #include "sstables/key.hh"
 #include "sstables/file_writer.hh"
 #include "db/commitlog/replay_position.hh"
@@ -121,30 +122,18 @@ inline auto format_as(indexable_element e) {
 class summary_entry {
 public:
     int64_t raw_token;
-    bytes_view key;
     uint64_t position;
 
-    explicit summary_entry(dht::token token, bytes_view key, uint64_t position)
+    explicit summary_entry(dht::token token, uint64_t position)
             : raw_token(dht::token::to_int64(token))
-            , key(key)
             , position(position) {
     }
 
-    key_view get_key() const {
-        return key_view{key};
-    }
-
     dht::token get_token() const {
         return dht::token::from_int64(raw_token);
     }
 
-    decorated_key_view get_decorated_key() const {
-        return decorated_key_view(get_token(), get_key());
-    }
-
-    bool operator==(const summary_entry& x) const {
-        return position ==  x.position && key == x.key;
-    }
+    bool operator==(const summary_entry& x) const = default;
 };
 
 // Note: Sampling level is present in versions ka and higher. We ATM only support ka,
@@ -172,6 +161,8 @@ struct summary_ka {
     // not the file. The memory stream effectively begins after the header,
     // so every position here has to be added of sizeof(header).
     utils::chunked_vector<uint32_t> positions;   // can be large, so use a deque instead of a vector
+    // Tokens and index positions of the entries. The keys are kept
+    // separately, front-coded, see add_entry() and key_at().
     utils::chunked_vector<summary_entry> entries;
 
     disk_string<uint32_t> first_key;
@@ -187,12 +178,16 @@ struct summary_ka {
     // However, it was tested that Cassandra loads successfully a Summary file with
     // this structure removed from it. Anyway, let's pay attention to it.
 
+    // Keys are stored in blocks of this many consecutive entries.
+    static constexpr size_t key_restart_interval = 16;
+
     /*
      * Returns total amount of memory used by the summary
      * Similar to origin off heap size
      */
     uint64_t memory_footprint() const {
         auto sz = sizeof(summary_entry) * entries.size() + sizeof(uint32_t) * positions.size() + sizeof(*this);
+        sz += sizeof(bytes_view) * _key_blocks.size() + _open_key_block.capacity() + _prev_key.size();
         sz += first_key.value.size() + last_key.value.size();
         for (auto& sd : _summary_data) {
             sz += sd.size();
@@ -200,10 +195,46 @@ struct summary_ka {
         return sz;
     }
 
+    // Total size of the keys of the entries, as they would take
+    // in memory without the front-coding.
+    uint64_t key_bytes() const {
+        return _key_bytes;
+    }
+
     explicit operator bool() const {
         return entries.size();
     }
 
+    // Appends an entry. Entries must be added in ring order.
+    //
+    // The first key of each block of key_restart_interval entries is stored
+    // in full, and each of the following ones as the length of the prefix it
+    // shares with the preceding key, followed by the rest of the key.
+    // Partition keys with a common structure (e.g. long text keys sharing
+    // a leading component) are stored much more compactly this way.
+    void add_entry(dht::token token, bytes_view key, uint64_t position);
+    // Moves the last, partially filled, block of keys to the summary memory.
+    // Called once all the entries are added.
+    void seal_keys();
+    // Returns the key of the idx-th entry.
+    // Decodes the keys of its block from the start, so use key_cursor
+    // to go over many consecutive keys.
+    bytes key_at(size_t idx) const;
+
+    // Decodes the keys of consecutive entries.
+    class key_cursor {
+        const summary_ka& _s;
+        size_t _idx;
+        const bytes::value_type* _pos = nullptr;
+        std::vector<bytes::value_type> _key;
+    public:
+        explicit key_cursor(const summary_ka& s, size_t idx = 0);
+        // Returns the key of the current entry and moves to the next one.
+        // The returned view is valid until the next call.
+        bytes_view next();
+    };
+private:
+    bytes_view key_block(size_t block) const;
     bytes_view add_summary_data(bytes_view data) {
         if (_summary_data.empty() || (_summary_index_pos + data.size() > _buffer_size)) {
             _buffer_size = std::min(_buffer_size << 1, 128u << 10);
@@ -217,7 +248,7 @@ struct summary_ka {
         _summary_index_pos += data.size();
         return ret;
     }
-private:
+
     class summary_data_memory {
         unsigned _size;
         std::unique_ptr<bytes::value_type[]> _data;
@@ -235,6 +266,13 @@ struct summary_ka {
     unsigned _buffer_size = 1 << 10;
     std::vector<summary_data_memory> _summary_data = {};
     unsigned _summary_index_pos = 0;
+    // Complete blocks of front-coded keys, stored in _summary_data.
+    utils::chunked_vector<bytes_view> _key_blocks;
+    // The block being filled.
+    std::vector<bytes::value_type> _open_key_block;
+    // The last added key, to compute the shared prefix of the next one.
+    bytes _prev_key;
+    uint64_t _key_bytes = 0;
 };
 using summary = summary_ka;
 
@@ -538,6 +576,7 @@ enum class scylla_metadata_type : uint32_t {
     ScyllaVersion = 8,
     ExtTimestampStats = 9,
     SSTableIdentifier = 10,
+    FilterLayout = 11,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -564,6 +603,15 @@ struct sstable_identifier_type {
     auto describe_type(sstable_version_types v, Describer f) { return f(value); }
 };
 
+// Layout of the bits in the Filter component.
+// Absent for the classic layout, which is the only one Cassandra knows.
+struct filter_layout_metadata {
+    utils::filter_layout layout;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(layout); }
+};
+
 // Types of large data statistics.
 //
 // Note: For extensibility, never reuse an identifier,
@@ -613,7 +661,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaBuildId, scylla_build_id>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExtTimestampStats, ext_timestamp_stats>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::FilterLayout, filter_layout_metadata>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -648,6 +697,10 @@ struct scylla_metadata {
         auto* sid = data.get<scylla_metadata_type::SSTableIdentifier, scylla_metadata::sstable_identifier>();
         return sid ? sid->value : sstable_id::create_null_id();
     }
+    utils::filter_layout get_filter_layout() const {
+        auto* fl = data.get<scylla_metadata_type::FilterLayout, filter_layout_metadata>();
+        return fl ? fl->layout : utils::filter_layout::classic;
+    }
 
     template <typename Describer>
     auto describe_type(sstable_version_types v, Describer f) { return f(data); }
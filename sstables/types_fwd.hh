@@ -16,5 +16,8 @@ namespace sstables {
 
 using run_id = utils::tagged_uuid<struct run_id_tag>;
 using integrity_check = bool_class<class integrity_check_tag>;
+// When set, readers don't materialize the values of the columns the slice
+// doesn't select, see mx::make_reader().
+using project_columns = bool_class<class project_columns_tag>;
 
 } // namespace sstables
@@ -8,7 +8,9 @@
 
 #include <fmt/ranges.h>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/map_reduce.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/shared_mutex.hh>
 #include <seastar/coroutine/maybe_yield.hh>
@@ -24,6 +26,8 @@
 #include "gms/feature_service.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
 #include "streaming/stream_reason.hh"
+#include "streaming/stream_blob.hh"
+#include "db/config.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "message/messaging_service.hh"
@@ -141,6 +145,11 @@ class sstable_streamer {
     const primary_replica_only _primary_replica_only;
     const unlink_sstables _unlink_sstables;
     const stream_scope _stream_scope;
+    // Bounds the number of batches of sstables streamed concurrently by this
+    // shard. The memory used by their readers is bounded by the streaming
+    // reader concurrency semaphore, which admits each batch's reader.
+    const size_t _concurrency;
+    semaphore _concurrency_sem;
 public:
     sstable_streamer(netw::messaging_service& ms, replica::database& db, ::table_id table_id, std::vector<sstables::shared_sstable> sstables, primary_replica_only primary, unlink_sstables unlink, stream_scope scope)
             : _ms(ms)
@@ -151,6 +160,8 @@ class sstable_streamer {
             , _primary_replica_only(primary)
             , _unlink_sstables(unlink)
             , _stream_scope(scope)
+            , _concurrency(std::max(db.get_config().load_and_stream_concurrency(), 1u))
+            , _concurrency_sem(_concurrency)
     {
         if (_primary_replica_only && _stream_scope != stream_scope::all) {
             throw std::runtime_error("Scoped streaming of primary replica only is not supported yet");
@@ -170,6 +181,7 @@ class sstable_streamer {
 
     virtual future<> stream(shared_ptr<stream_progress> progress);
     host_id_vector_replica_set get_endpoints(const dht::token& token) const;
+    bool endpoint_in_scope(const locator::host_id& ep) const;
     future<> stream_sstable_mutations(streaming::plan_id, const dht::partition_range&, std::vector<sstables::shared_sstable>);
 protected:
     virtual host_id_vector_replica_set get_primary_endpoints(const dht::token& token) const;
@@ -199,26 +211,30 @@ class tablet_sstable_streamer : public sstable_streamer {
         return result;
     }
 
-    future<> stream_fully_contained_sstables(const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables, shared_ptr<stream_progress> progress) {
-        // FIXME: fully contained sstables can be optimized.
-        return stream_sstables(pr, std::move(sstables), std::move(progress));
-    }
+    future<> stream_fully_contained_sstables(locator::tablet_id tid, const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables, shared_ptr<stream_progress> progress);
+    future<> stream_sstable_files(locator::tablet_id tid, sstables::shared_sstable sst);
+    bool can_stream_files(locator::tablet_id tid) const;
 
     bool tablet_in_scope(locator::tablet_id) const;
 };
 
+bool sstable_streamer::endpoint_in_scope(const locator::host_id& ep) const {
+    const auto& topo = _erm->get_topology();
+    switch (_stream_scope) {
+    case stream_scope::all:
+        return true;
+    case stream_scope::dc:
+        return topo.get_datacenter(ep) == topo.get_datacenter();
+    case stream_scope::rack:
+        return topo.get_location(ep) == topo.get_location();
+    case stream_scope::node:
+        return topo.is_me(ep);
+    }
+}
+
 host_id_vector_replica_set sstable_streamer::get_endpoints(const dht::token& token) const {
-    return get_all_endpoints(token) | std::views::filter([&topo = _erm->get_topology(), scope = _stream_scope] (const auto& ep) {
-        switch (scope) {
-        case stream_scope::all:
-            return true;
-        case stream_scope::dc:
-            return topo.get_datacenter(ep) == topo.get_datacenter();
-        case stream_scope::rack:
-            return topo.get_location(ep) == topo.get_location();
-        case stream_scope::node:
-            return topo.is_me(ep);
-        }
+    return get_all_endpoints(token) | std::views::filter([this] (const auto& ep) {
+        return endpoint_in_scope(ep);
     }) | std::ranges::to<host_id_vector_replica_set>();
 }
 
@@ -341,6 +357,13 @@ future<> tablet_sstable_streamer::stream(shared_ptr<stream_progress> progress) {
         progress->start(_tablet_map.tablet_count());
     }
 
+    struct tablet_sstables {
+        locator::tablet_id tid;
+        std::vector<sstables::shared_sstable> fully_contained;
+        std::vector<sstables::shared_sstable> partially_contained;
+    };
+    std::vector<tablet_sstables> tablets;
+
     // sstables are sorted by first key in reverse order.
     auto sstable_it = _sstables.rbegin();
 
@@ -352,8 +375,8 @@ future<> tablet_sstable_streamer::stream(shared_ptr<stream_progress> progress) {
                                     sst->get_last_decorated_key().token());
         };
 
-        std::vector<sstables::shared_sstable> sstables_fully_contained;
-        std::vector<sstables::shared_sstable> sstables_partially_contained;
+        tablets.push_back(tablet_sstables{.tid = tablet_id});
+        auto& t = tablets.back();
 
         // sstable is exhausted if its last key is before the current tablet range
         auto exhausted = [&tablet_range] (const sstables::shared_sstable& sst) {
@@ -372,44 +395,111 @@ future<> tablet_sstable_streamer::stream(shared_ptr<stream_progress> progress) {
             }
 
             if (tablet_range.contains(sst_token_range, dht::token_comparator{})) {
-                sstables_fully_contained.push_back(*sst_it);
+                t.fully_contained.push_back(*sst_it);
             } else {
-                sstables_partially_contained.push_back(*sst_it);
+                t.partially_contained.push_back(*sst_it);
             }
             co_await coroutine::maybe_yield();
         }
+    }
 
+    // Tablets are streamed concurrently, so that tablets with only a few
+    // sstables each don't leave the shard underutilized. The total number of
+    // batches in flight is still bounded by _concurrency_sem.
+    co_await max_concurrent_for_each(tablets, _concurrency, [this, &progress] (tablet_sstables& t) -> future<> {
         auto per_tablet_progress = make_shared<per_tablet_stream_progress>(
             progress,
-            sstables_fully_contained.size() + sstables_partially_contained.size());
-        auto tablet_pr = dht::to_partition_range(tablet_range);
-        co_await stream_sstables(tablet_pr, std::move(sstables_partially_contained), per_tablet_progress);
-        co_await stream_fully_contained_sstables(tablet_pr, std::move(sstables_fully_contained), per_tablet_progress);
+            t.fully_contained.size() + t.partially_contained.size());
+        auto tablet_pr = dht::to_partition_range(_tablet_map.get_token_range(t.tid));
+        co_await stream_sstables(tablet_pr, std::move(t.partially_contained), per_tablet_progress);
+        co_await stream_fully_contained_sstables(t.tid, tablet_pr, std::move(t.fully_contained), per_tablet_progress);
+    });
+}
+
+bool tablet_sstable_streamer::can_stream_files(locator::tablet_id tid) const {
+    // Files are loaded as they are by the receivers, which bypasses the
+    // generation of view updates. Tablets in transition are left to the
+    // mutation-based path, which takes care of the pending replicas.
+    return _db.features().file_based_load_and_stream
+            && _db.get_config().enable_file_stream()
+            && _table.views().empty()
+            && !_tablet_map.get_tablet_transition_info(tid);
+}
+
+future<> tablet_sstable_streamer::stream_fully_contained_sstables(locator::tablet_id tid, const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables, shared_ptr<stream_progress> progress) {
+    if (!can_stream_files(tid)) {
+        co_await stream_sstables(pr, std::move(sstables), std::move(progress));
+        co_return;
+    }
+    // The sstable is owned by the tablet's replicas as a whole, so there's no
+    // need to read it and split its mutations among the owners.
+    co_await coroutine::parallel_for_each(sstables, [this, tid, &progress] (sstables::shared_sstable& sst) -> future<> {
+        auto units = co_await get_units(_concurrency_sem, 1);
+        co_await stream_sstable_files(tid, sst);
+        if (progress) {
+            progress->advance(1);
+        }
+    });
+}
+
+future<> tablet_sstable_streamer::stream_sstable_files(locator::tablet_id tid, sstables::shared_sstable sst) {
+    auto s = _table.schema();
+    auto ops_id = streaming::file_stream_id::create_random_id();
+    const auto& info = _tablet_map.get_tablet_info(tid);
+    auto replicas = _primary_replica_only ? locator::get_primary_replicas(info, nullptr) : info.replicas;
+    auto targets = replicas
+            | std::views::filter([this] (const locator::tablet_replica& r) { return endpoint_in_scope(r.host); })
+            | std::views::transform([] (const locator::tablet_replica& r) { return streaming::node_and_shard{r.host, r.shard}; })
+            | std::ranges::to<std::vector>();
+
+    llog.info("load_and_stream: started ops_id={}, ks={}, table={}, streaming sstable={} as files to targets={}",
+            ops_id, s->ks_name(), s->cf_name(), sst->get_filename(), targets);
+    auto start_time = std::chrono::steady_clock::now();
+    utils::chunked_vector<sstables::sstable_files_snapshot> snapshot;
+    snapshot.push_back({
+        .sst = sst,
+        .files = co_await sst->readable_file_for_all_components(),
+    });
+    auto files = streaming::make_sstable_stream_files(_table, snapshot, ops_id, true);
+    size_t stream_bytes = co_await streaming::tablet_stream_files(_ms, std::move(files), std::move(targets), s->id(), ops_id, service::null_topology_guard);
+    if (_unlink_sstables) {
+        llog.debug("load_and_stream: ops_id={}, ks={}, table={}, remove sst={}",
+                ops_id, s->ks_name(), s->cf_name(), sst->toc_filename());
+        co_await sst->unlink();
     }
+    auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start_time).count();
+    auto bytes_rate = std::fabs(duration) > FLT_EPSILON ? stream_bytes / duration / 1024 / 1024 : 0;
+    llog.info("load_and_stream: finished ops_id={}, ks={}, table={}, bytes_sent={} bytes, bytes_per_second={} MiB/s, duration={} s",
+            ops_id, s->ks_name(), s->cf_name(), stream_bytes, bytes_rate, duration);
 }
 
 future<> sstable_streamer::stream_sstables(const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables, shared_ptr<stream_progress> progress) {
     size_t nr_sst_total = sstables.size();
     size_t nr_sst_current = 0;
 
+    std::vector<std::vector<sstables::shared_sstable>> batches;
     while (!sstables.empty()) {
         const size_t batch_sst_nr = std::min(16uz, sstables.size());
-        auto sst_processed = sstables
+        batches.push_back(sstables
             | std::views::reverse
             | std::views::take(batch_sst_nr)
-            | std::ranges::to<std::vector>();
+            | std::ranges::to<std::vector>());
         sstables.erase(sstables.end() - batch_sst_nr, sstables.end());
+    }
 
+    co_await coroutine::parallel_for_each(batches, [&] (std::vector<sstables::shared_sstable>& sst_processed) -> future<> {
+        auto units = co_await get_units(_concurrency_sem, 1);
+        const size_t batch_sst_nr = sst_processed.size();
         auto ops_uuid = streaming::plan_id{utils::make_random_uuid()};
         llog.info("load_and_stream: started ops_uuid={}, process [{}-{}] out of {} sstables=[{}]",
-            ops_uuid, nr_sst_current, nr_sst_current + sst_processed.size(), nr_sst_total,
+            ops_uuid, nr_sst_current, nr_sst_current + batch_sst_nr, nr_sst_total,
             fmt::join(sst_processed | std::views::transform([] (auto sst) { return sst->get_filename(); }), ", "));
-        nr_sst_current += sst_processed.size();
+        nr_sst_current += batch_sst_nr;
         co_await stream_sstable_mutations(ops_uuid, pr, std::move(sst_processed));
         if (progress) {
             progress->advance(batch_sst_nr);
         }
-    }
+    });
 }
 
 future<> sstable_streamer::stream_sstable_mutations(streaming::plan_id ops_uuid, const dht::partition_range& pr, std::vector<sstables::shared_sstable> sstables) {
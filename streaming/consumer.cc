@@ -9,6 +9,8 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/with_scheduling_group.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/closeable.hh>
 
 #include "consumer.hh"
 #include "db/view/view_building_worker.hh"
@@ -18,9 +20,32 @@
 #include "db/view/view_update_checks.hh"
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/sstable_writer.hh"
 
 namespace streaming {
 
+// Writes the fragments of the reader into a run of sstables of at most
+// cfg.max_sstable_size bytes each, and passes each sstable to the callback
+// once it is sealed.
+static future<> write_sstable_run(mutation_reader reader,
+        noncopyable_function<sstables::shared_sstable()> make_sstable,
+        uint64_t estimated_partitions,
+        sstables::sstable_writer_config cfg,
+        noncopyable_function<future<>(sstables::shared_sstable)> on_sstable) {
+    return seastar::async([reader = std::move(reader), make_sstable = std::move(make_sstable), estimated_partitions, cfg = std::move(cfg), on_sstable = std::move(on_sstable)] () mutable {
+        auto close_reader = deferred_close(reader);
+        auto s = reader.schema();
+        while (reader.peek().get()) {
+            auto sst = make_sstable();
+            reader.consume_in_thread(sst->get_writer(*s, estimated_partitions, cfg, encoding_stats{}));
+            // The partitions of the first sstable are a better estimate for
+            // the next ones than those of the whole stream.
+            estimated_partitions = std::min(estimated_partitions, std::max<uint64_t>(sst->get_estimated_key_count(), 1));
+            on_sstable(std::move(sst)).get();
+        }
+    });
+}
+
 mutation_reader_consumer make_streaming_consumer(sstring origin,
         sharded<replica::database>& db,
         db::view::view_builder& vb,
@@ -47,27 +72,21 @@ mutation_reader_consumer make_streaming_consumer(sstring origin,
             //FIXME: for better estimations this should be transmitted from remote
             auto metadata = mutation_source_metadata{};
             auto& cs = cf->get_compaction_strategy();
-            // Data segregation is postponed to happen during off-strategy if latter is enabled, which
-            // means partition estimation shouldn't be adjusted.
-            const auto adjusted_estimated_partitions = (offstrategy) ? estimated_partitions : cs.adjust_partition_estimate(metadata, estimated_partitions, cf->schema());
+            // The data is segregated as the strategy wants it, e.g. into time windows,
+            // and written into runs of sstables of the size the strategy compacts into,
+            // so that off-strategy compaction finds it in shape when it arrives sorted
+            // and disjoint.
+            const auto adjusted_estimated_partitions = cs.adjust_partition_estimate(metadata, estimated_partitions, cf->schema());
             mutation_reader_consumer consumer =
                     [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, &vb, &vbw, origin = std::move(origin),
                 offstrategy, repaired_at, sstable_list_to_mark_as_repaired, frozen_guard] (mutation_reader reader) {
-                sstables::shared_sstable sst;
-                try {
-                    sst = use_view_update_path == db::view::sstable_destination_decision::normal_directory ? cf->make_streaming_sstable_for_write() : cf->make_streaming_staging_sstable();
-                } catch (...) {
-                    return current_exception_as_future().finally([reader = std::move(reader)] () mutable {
-                        return reader.close();
-                    });
-                }
-                schema_ptr s = reader.schema();
-
-                auto cfg = cf->get_sstables_manager().configure_writer(origin);
-                return sst->write_components(std::move(reader), adjusted_estimated_partitions, s,
-                                             cfg, encoding_stats{}).then([sst] {
-                    return sst->open_data();
-                }).then([cf, sst, offstrategy, origin, repaired_at, sstable_list_to_mark_as_repaired, frozen_guard] -> future<> {
+                auto make_sstable = [cf, use_view_update_path] {
+                    return use_view_update_path == db::view::sstable_destination_decision::normal_directory ? cf->make_streaming_sstable_for_write() : cf->make_streaming_staging_sstable();
+                };
+                auto cfg = cf->configure_writer(origin);
+                cfg.max_sstable_size = std::max<uint64_t>(cf->get_compaction_strategy().max_sstable_size(), 1);
+                auto add_sstable = [cf, offstrategy, origin, repaired_at, sstable_list_to_mark_as_repaired, frozen_guard, use_view_update_path, &vb, &vbw] (sstables::shared_sstable sst) -> future<> {
+                    co_await sst->open_data();
                     if (repaired_at && sstables::repair_origin == origin) {
                         sst->being_repaired = frozen_guard;
                         if (sstable_list_to_mark_as_repaired) {
@@ -80,18 +99,15 @@ mutation_reader_consumer make_streaming_consumer(sstring origin,
                         cf->enable_off_strategy_trigger();
                     }
                     co_await cf->add_sstable_and_update_cache(sst, offstrategy);
-                }).then([cf, s, sst, use_view_update_path, &vb, &vbw]() mutable -> future<> {
                     if (use_view_update_path == db::view::sstable_destination_decision::staging_managed_by_vbc) {
-                        return vbw.local().register_staging_sstable_tasks({sst}, std::move(cf));
+                        co_await vbw.local().register_staging_sstable_tasks({sst}, cf);
                     } else if (use_view_update_path == db::view::sstable_destination_decision::staging_directly_to_generator) {
-                        return vb.local().register_staging_sstable(sst, std::move(cf));
+                        co_await vb.local().register_staging_sstable(sst, cf);
                     }
-                    return make_ready_future<>();
-                });
+                };
+                return write_sstable_run(std::move(reader), std::move(make_sstable), adjusted_estimated_partitions, std::move(cfg), std::move(add_sstable));
             };
-            if (!offstrategy) {
-                consumer = cs.make_interposer_consumer(metadata, std::move(consumer));
-            }
+            consumer = cs.make_interposer_consumer(metadata, std::move(consumer));
             co_return co_await consumer(std::move(reader));
         } catch (...) {
             ex = std::current_exception();
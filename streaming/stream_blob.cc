@@ -36,9 +36,14 @@ namespace streaming {
 
 static logging::logger blogger("stream_blob");
 
+// The size of the data in a stream_blob_cmd::data message.
 constexpr size_t file_stream_buffer_size = 128 * 1024;
-constexpr size_t file_stream_write_behind = 10;
-constexpr size_t file_stream_read_ahead = 4;
+// The files are read and written in larger aligned chunks than the messages,
+// the read buffers are handed to the messages by sharing, so the sender
+// doesn't copy the data, and both sides issue fewer and larger I/Os.
+constexpr size_t file_stream_io_size = 1024 * 1024;
+constexpr size_t file_stream_write_behind = 2;
+constexpr size_t file_stream_read_ahead = 1;
 
 static sstables::sstable_state sstable_state(const streaming::stream_blob_meta& meta) {
     return meta.sstable_state.value_or(sstables::sstable_state::normal);
@@ -144,7 +149,9 @@ future<> stream_blob_handler(replica::database& db,
                 blogger.info("stream_mutation_fragments: done (tablets)");
             })));
         }
-        auto status = get_tablet_stream(meta.ops_id);
+        // Load-and-stream isn't coordinated by the receiver, so there's no
+        // registered stream which could be finished under our feet.
+        auto status = meta.load_and_stream ? make_lw_shared<tablet_stream_status>() : get_tablet_stream(meta.ops_id);
         auto guard = service::topology_guard(meta.topo_guard);
 
         // Reject any file_ops that is not support by this node
@@ -325,7 +332,7 @@ future<> stream_blob_handler(replica::database& db, netw::messaging_service& ms,
         foptions.extent_allocation_size_hint = 32 << 20;
 
         auto stream_options = file_output_stream_options();
-        stream_options.buffer_size = file_stream_buffer_size;
+        stream_options.buffer_size = file_stream_io_size;
         stream_options.write_behind = file_stream_write_behind;
 
         auto& table = db.find_column_family(meta.table);
@@ -406,7 +413,7 @@ tablet_stream_files(netw::messaging_service& ms, std::list<stream_blob_info> sou
     std::exception_ptr error;
 
     auto stream_options = file_input_stream_options();
-    stream_options.buffer_size = file_stream_buffer_size;
+    stream_options.buffer_size = file_stream_io_size;
     stream_options.read_ahead = file_stream_read_ahead;
 
     for (auto& info : sources) {
@@ -417,6 +424,7 @@ tablet_stream_files(netw::messaging_service& ms, std::list<stream_blob_info> sou
             meta.fops = info.fops;
             meta.filename = info.filename;
             meta.sstable_state = info.sstable_state;
+            meta.load_and_stream = info.load_and_stream;
             fstream = co_await info.source(stream_options);
         } catch (...) {
             blogger.warn("fstream[{}] Master failed sources={} targets={} error={}",
@@ -443,6 +451,7 @@ tablet_stream_files(netw::messaging_service& ms, std::list<stream_blob_info> sou
                 try {
                     while (!got_error_from_peer) {
                         may_inject_error(meta, inject_errors, "read_data");
+                        // Shares the read buffer of the stream, see file_stream_io_size.
                         auto buf = co_await fstream->read_up_to(file_stream_buffer_size);
                         if (buf.size() == 0) {
                             break;
@@ -603,43 +612,32 @@ tablet_stream_files(netw::messaging_service& ms, std::list<stream_blob_info> sou
 }
 
 
-future<stream_files_response> tablet_stream_files_handler(replica::database& db, netw::messaging_service& ms, streaming::stream_files_request req) {
-    stream_files_response resp;
-    auto& table = db.find_column_family(req.table);
-    auto sstables = co_await table.take_storage_snapshot(req.range);
-    co_await utils::get_local_injector().inject("order_sstables_for_streaming", [&sstables] (auto& handler) -> future<> {
-        if (sstables.size() == 3) {
-            // make sure the sstables are ordered so that the sstable containing shadowed data is streamed last
-            const std::string_view shadowed_file = handler.template get<std::string_view>("shadowed_file").value();
-            for (int index: {0, 1}) {
-                if (sstables[index].sst->component_basename(component_type::Data) == shadowed_file) {
-                    std::swap(sstables[index], sstables[2]);
-                }
-            }
-        }
-        return make_ready_future<>();
-    });
+std::list<stream_blob_info> make_sstable_stream_files(replica::table& table, const utils::chunked_vector<sstables::sstable_files_snapshot>& sstables,
+        file_stream_id ops_id, bool load_and_stream) {
     auto files = std::list<stream_blob_info>();
 
     auto& sst_gen = table.get_sstable_generation_generator();
 
     for (auto& sst_snapshot : sstables) {
         auto& sst = sst_snapshot.sst;
-        // stable state (across files) is a must for load to work on destination
-        auto sst_state = sst->state();
+        // stable state (across files) is a must for load to work on destination.
+        // Loaded sstables are just being uploaded here, but are to be made
+        // part of the table on the destination.
+        auto sst_state = load_and_stream ? sstables::sstable_state::normal : sst->state();
 
         auto sources = create_stream_sources(sst_snapshot);
         auto newgen = fmt::to_string(sst_gen());
 
         for (auto&& s : sources) {
             auto oldname = s->component_basename();
-            auto newname = get_sstable_name_with_generation(req.ops_id, oldname, newgen);
+            auto newname = get_sstable_name_with_generation(ops_id, oldname, newgen);
 
-            blogger.debug("fstream[{}] Get name oldname={}, newname={}", req.ops_id, oldname, newname);
+            blogger.debug("fstream[{}] Get name oldname={}, newname={}", ops_id, oldname, newname);
 
             auto& info = files.emplace_back();
             info.fops = file_ops::stream_sstables;
             info.sstable_state = sst_state;
+            info.load_and_stream = load_and_stream;
             info.filename = std::move(newname);
             info.source = [s = std::move(s)](const file_input_stream_options& options) {
                 return s->input(options);
@@ -650,6 +648,26 @@ future<stream_files_response> tablet_stream_files_handler(replica::database& db,
             files.back().fops = file_ops::load_sstables;
         }
     }
+    return files;
+}
+
+future<stream_files_response> tablet_stream_files_handler(replica::database& db, netw::messaging_service& ms, streaming::stream_files_request req) {
+    stream_files_response resp;
+    auto& table = db.find_column_family(req.table);
+    auto sstables = co_await table.take_storage_snapshot(req.range);
+    co_await utils::get_local_injector().inject("order_sstables_for_streaming", [&sstables] (auto& handler) -> future<> {
+        if (sstables.size() == 3) {
+            // make sure the sstables are ordered so that the sstable containing shadowed data is streamed last
+            const std::string_view shadowed_file = handler.template get<std::string_view>("shadowed_file").value();
+            for (int index: {0, 1}) {
+                if (sstables[index].sst->component_basename(component_type::Data) == shadowed_file) {
+                    std::swap(sstables[index], sstables[2]);
+                }
+            }
+        }
+        return make_ready_future<>();
+    });
+    auto files = make_sstable_stream_files(table, sstables, req.ops_id);
     if (files.empty()) {
         co_return resp;
     }
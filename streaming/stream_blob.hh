@@ -23,10 +23,15 @@
 #include "locator/host_id.hh"
 #include "service/topology_guard.hh"
 #include "sstables/open_info.hh"
+#include "utils/chunked_vector.hh"
 
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
+namespace sstables {
+struct sstable_files_snapshot;
+}
+
 namespace streaming {
 
 using file_stream_id = utils::tagged_uuid<struct file_stream_id_tag>;
@@ -92,6 +97,9 @@ class stream_blob_meta {
     streaming::file_ops fops;
     service::frozen_topology_guard topo_guard;
     std::optional<sstables::sstable_state> sstable_state;
+    // Set when the stream is driven by the sender, as in load-and-stream,
+    // rather than registered by the receiver with mark_tablet_stream_start().
+    bool load_and_stream = false;
     // We can extend this verb to send arbitrary blob of data
 };
 
@@ -108,6 +116,7 @@ struct stream_blob_info {
     sstring filename;
     streaming::file_ops fops;
     std::optional<sstables::sstable_state> sstable_state;
+    bool load_and_stream = false;
     stream_blob_source_fn source;
 
     friend inline std::ostream& operator<<(std::ostream& os, const stream_blob_info& x) {
@@ -180,6 +189,17 @@ future<size_t> tablet_stream_files(netw::messaging_service& ms,
     bool may_inject_errors = false
     );
 
+// Returns the files of the given sstables to be streamed with tablet_stream_files(),
+// renamed to new generations of the table, ordered so that each sstable is
+// loaded on the destination once its last component is received.
+//
+// With load_and_stream, the receivers load the sstables into the normal state
+// without the stream being registered with mark_tablet_stream_start().
+std::list<stream_blob_info> make_sstable_stream_files(replica::table& table,
+    const utils::chunked_vector<sstables::sstable_files_snapshot>& sstables,
+    file_stream_id ops_id,
+    bool load_and_stream = false);
+
 
 future<> mark_tablet_stream_start(file_stream_id);
 future<> mark_tablet_stream_done(file_stream_id);
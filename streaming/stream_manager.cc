@@ -63,6 +63,15 @@ stream_manager::stream_manager(db::config& cfg,
         sm::make_counter("total_outgoing_bytes", [this] { return _total_outgoing_bytes; },
                         sm::description("Total number of bytes sent on this shard.")),
 
+        sm::make_gauge("active_sessions", [this] { return active_sessions(); },
+                        sm::description("Number of streaming sessions with some progress on this shard.")),
+
+        sm::make_gauge("outgoing_throughput", [this] { return outgoing_throughput(); },
+                        sm::description("Number of bytes per second sent on this shard, averaged over the last minute.")),
+
+        sm::make_gauge("incoming_throughput", [this] { return incoming_throughput(); },
+                        sm::description("Number of bytes per second received on this shard, averaged over the last minute.")),
+
         sm::make_gauge("finished_percentage", [this] { return _finished_percentage[streaming::stream_reason::bootstrap]; },
                 sm::description("Finished percentage of node operation on this shard"), {ops_label_type("bootstrap"), basic_level}),
 
@@ -189,9 +198,11 @@ void stream_manager::update_progress(streaming::plan_id plan_id, locator::host_i
     if (dir == progress_info::direction::OUT) {
         sbytes[peer].bytes_sent += fm_size;
         _total_outgoing_bytes += fm_size;
+        _outgoing_rate.mark(fm_size);
     } else {
         sbytes[peer].bytes_received += fm_size;
         _total_incoming_bytes += fm_size;
+        _incoming_rate.mark(fm_size);
     }
 }
 
@@ -209,6 +220,22 @@ void stream_manager::remove_progress(streaming::plan_id plan_id) {
     _stream_bytes.erase(plan_id);
 }
 
+size_t stream_manager::active_sessions() const {
+    size_t n = 0;
+    for (auto& [plan_id, sbytes] : _stream_bytes) {
+        n += sbytes.size();
+    }
+    return n;
+}
+
+double stream_manager::outgoing_throughput() const {
+    return _outgoing_rate.rate().rates[0];
+}
+
+double stream_manager::incoming_throughput() const {
+    return _incoming_rate.rate().rates[0];
+}
+
 stream_bytes stream_manager::get_progress(streaming::plan_id plan_id, locator::host_id peer) const {
     auto it = _stream_bytes.find(plan_id);
     if (it == _stream_bytes.end()) {
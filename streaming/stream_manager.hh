@@ -16,6 +16,7 @@
 #include <seastar/core/distributed.hh>
 #include "utils/updateable_value.hh"
 #include "utils/serialized_action.hh"
+#include "utils/histogram.hh"
 #include "gms/i_endpoint_state_change_subscriber.hh"
 #include "gms/inet_address.hh"
 #include "gms/endpoint_state.hh"
@@ -95,6 +96,8 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     std::unordered_map<plan_id, std::unordered_map<locator::host_id, stream_bytes>> _stream_bytes;
     uint64_t _total_incoming_bytes{0};
     uint64_t _total_outgoing_bytes{0};
+    utils::timed_rate_moving_average _incoming_rate;
+    utils::timed_rate_moving_average _outgoing_rate;
     semaphore _mutation_send_limiter{256};
     seastar::metrics::metric_groups _metrics;
     std::unordered_map<streaming::stream_reason, float> _finished_percentage;
@@ -170,6 +173,12 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
 
     stream_bytes get_progress_on_local_shard() const;
 
+    // The number of (plan, peer) sessions with some progress on this shard.
+    size_t active_sessions() const;
+    // The streaming throughput of this shard over all sessions, in bytes per second.
+    double outgoing_throughput() const;
+    double incoming_throughput() const;
+
     shared_ptr<stream_session> get_session(streaming::plan_id plan_id, locator::host_id from, const char* verb, std::optional<table_id> cf_id = {});
 
     mutation_reader_consumer make_streaming_consumer(
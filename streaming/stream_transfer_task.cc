@@ -33,6 +33,7 @@
 #include "streaming/table_check.hh"
 #include "gms/feature_service.hh"
 #include "utils/error_injection.hh"
+#include "db/config.hh"
 #include "idl/streaming.dist.hh"
 
 namespace streaming {
@@ -203,6 +204,34 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
  });
 }
 
+std::vector<dht::token_range_vector> split_ranges_for_streams(dht::token_range_vector ranges, size_t n) {
+    while (ranges.size() < n) {
+        dht::token_range_vector halves;
+        for (auto& r : ranges) {
+            if (r.start() && r.end() && r.start()->value()._kind == dht::token_kind::key && r.end()->value()._kind == dht::token_kind::key
+                    && r.start()->value() < r.end()->value()) {
+                auto mid = dht::token::midpoint(r.start()->value(), r.end()->value());
+                if (mid != r.start()->value() && mid != r.end()->value()) {
+                    halves.emplace_back(r.start(), dht::token_range::bound(mid, true));
+                    halves.emplace_back(dht::token_range::bound(mid, false), r.end());
+                    continue;
+                }
+            }
+            halves.push_back(std::move(r));
+        }
+        if (halves.size() == ranges.size()) {
+            break;
+        }
+        ranges = std::move(halves);
+    }
+    n = std::max(size_t(1), std::min(n, ranges.size()));
+    std::vector<dht::token_range_vector> groups(n);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        groups[i * n / ranges.size()].push_back(std::move(ranges[i]));
+    }
+    return groups;
+}
+
 future<> stream_transfer_task::execute() {
     auto plan_id = session->plan_id();
     auto cf_id = this->cf_id;
@@ -214,22 +243,27 @@ future<> stream_transfer_task::execute() {
         sort_and_merge_ranges();
         auto reason = session->get_reason();
         auto topo_guard = session->topo_guard();
-        return sm.container().invoke_on_all([plan_id, cf_id, id, dst_cpu_id, ranges=this->_ranges, reason, topo_guard] (stream_manager& sm) mutable {
+        auto streams = sm.db().get_config().stream_rpc_streams_per_shard();
+        return sm.container().invoke_on_all([plan_id, cf_id, id, dst_cpu_id, ranges=this->_ranges, reason, topo_guard, streams] (stream_manager& sm) mutable {
             auto tbl = sm.db().find_column_family(cf_id).shared_from_this();
-            return sm.db().obtain_reader_permit(*tbl, "stream-transfer-task", db::no_timeout, {}).then([&sm, tbl, plan_id, cf_id, id, dst_cpu_id, ranges=std::move(ranges), reason, topo_guard] (reader_permit permit) mutable {
-                auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, topo_guard, [&sm, plan_id, id] (size_t sz) {
-                    sm.update_progress(plan_id, id, streaming::progress_info::direction::OUT, sz);
-                });
-                return si->has_relevant_range_on_this_shard().then([si, plan_id, cf_id] (bool has_relevant_range_on_this_shard) {
-                    if (!has_relevant_range_on_this_shard) {
-                        sslog.debug("[Stream #{}] stream_transfer_task: cf_id={}: ignore ranges on shard={}",
-                                plan_id, cf_id, this_shard_id());
-                        return make_ready_future<>();
-                    }
-                    return send_mutation_fragments(std::move(si));
-                }).finally([si] {
-                    return si->reader.close();
+            return do_with(split_ranges_for_streams(std::move(ranges), streams), [&sm, tbl, plan_id, cf_id, id, dst_cpu_id, reason, topo_guard] (std::vector<dht::token_range_vector>& groups) {
+              return parallel_for_each(groups, [&sm, tbl, plan_id, cf_id, id, dst_cpu_id, reason, topo_guard] (dht::token_range_vector& ranges) {
+                return sm.db().obtain_reader_permit(*tbl, "stream-transfer-task", db::no_timeout, {}).then([&sm, tbl, plan_id, cf_id, id, dst_cpu_id, ranges=std::move(ranges), reason, topo_guard] (reader_permit permit) mutable {
+                    auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, topo_guard, [&sm, plan_id, id] (size_t sz) {
+                        sm.update_progress(plan_id, id, streaming::progress_info::direction::OUT, sz);
+                    });
+                    return si->has_relevant_range_on_this_shard().then([si, plan_id, cf_id] (bool has_relevant_range_on_this_shard) {
+                        if (!has_relevant_range_on_this_shard) {
+                            sslog.debug("[Stream #{}] stream_transfer_task: cf_id={}: ignore ranges on shard={}",
+                                    plan_id, cf_id, this_shard_id());
+                            return make_ready_future<>();
+                        }
+                        return send_mutation_fragments(std::move(si));
+                    }).finally([si] {
+                        return si->reader.close();
+                    });
                 });
+              });
             });
         }).then([this, plan_id, cf_id, id, &sm] {
             sslog.debug("[Stream #{}] SEND STREAM_MUTATION_DONE to {}, cf_id={}", plan_id, id, cf_id);
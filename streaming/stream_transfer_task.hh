@@ -51,4 +51,9 @@ class stream_transfer_task : public stream_task {
     void sort_and_merge_ranges();
 };
 
+// Splits the sorted ranges into at most n groups of contiguous ranges, each
+// to be sent in its own RPC stream. When there are fewer ranges than groups,
+// e.g. for a tablet, the ranges are halved first.
+std::vector<dht::token_range_vector> split_ranges_for_streams(dht::token_range_vector ranges, size_t n);
+
 } // namespace streaming
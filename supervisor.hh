@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <optional>
+#include <vector>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/format.hh>
 #include <seastar/util/log.hh>
@@ -21,6 +24,25 @@ class supervisor {
     static constexpr auto systemd_ready_msg = "READY=1";
     /** A systemd status message has a format <status message prefix>=<message> */
     static constexpr auto systemd_status_msg_prefix = "STATUS";
+    /** The notification sent once the startup is complete */
+    static constexpr auto serving_msg = "serving";
+
+    // Each notification starts a phase of the startup, which lasts until
+    // the next one. The last phase ends with the serving_msg notification.
+    struct startup_phase {
+        sstring name;
+        std::chrono::steady_clock::duration duration;
+        bool completed;
+    };
+private:
+    struct phase_start {
+        sstring name;
+        std::chrono::steady_clock::time_point start;
+    };
+    // Only accessed on shard 0, where the startup runs
+    static inline std::vector<startup_phase> _completed_phases;
+    static inline std::optional<phase_start> _current_phase;
+    static inline bool _serving = false;
 public:
     /**
      * @brief Notify the Supervisor with the given message.
@@ -30,9 +52,39 @@ class supervisor {
     static inline void notify(sstring msg, bool ready = false) {
         startlog.info("{}", msg);
         try_notify_systemd(msg, ready);
+        record_phase(msg);
+    }
+
+    /**
+     * @brief Returns the phases of the startup so far, the last one being
+     * still in progress unless the service is ready. Must be called on shard 0.
+     */
+    static inline std::vector<startup_phase> startup_phases() {
+        auto ret = _completed_phases;
+        if (_current_phase) {
+            ret.push_back({_current_phase->name, std::chrono::steady_clock::now() - _current_phase->start, false});
+        }
+        return ret;
     }
 
 private:
+    static inline void record_phase(const sstring& msg) {
+        // Notifications after the startup is complete are not phases of it.
+        if (_serving) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (_current_phase) {
+            _completed_phases.push_back({std::move(_current_phase->name), now - _current_phase->start, true});
+            _current_phase.reset();
+        }
+        if (msg == serving_msg) {
+            _serving = true;
+        } else {
+            _current_phase = phase_start{msg, now};
+        }
+    }
+
     static inline void try_notify_systemd(sstring msg, bool ready) {
         if (ready) {
             sd_notify(0, format("{}\n{}={}\n", systemd_ready_msg, systemd_status_msg_prefix, msg).c_str());
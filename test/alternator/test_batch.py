@@ -51,6 +51,21 @@ def test_batch_write_item_mixed(test_table):
     for item in items:
         assert test_table.get_item(Key={'p': item['p'], 'c': item['c']}, ConsistentRead=True)['Item'] == item
 
+# Puts and deletes of different items of one partition in the same batch
+# are joined into a single write of the partition, and each of them must
+# still take effect.
+def test_batch_write_item_mixed_put_and_delete(test_table_sn):
+    p = random_string()
+    with test_table_sn.batch_writer() as batch:
+        for i in range(6):
+            batch.put_item({'p': p, 'c': i, 'v': 'old'})
+    test_table_sn.meta.client.batch_write_item(RequestItems = {
+        test_table_sn.name: [{'DeleteRequest': {'Key': {'p': p, 'c': i}}} for i in range(0, 6, 2)] +
+                            [{'PutRequest': {'Item': {'p': p, 'c': i, 'v': 'new'}}} for i in range(1, 9, 2)],
+    })
+    assert full_query(test_table_sn, KeyConditionExpression='p=:p', ExpressionAttributeValues={':p': p}
+        ) == [{'p': p, 'c': i, 'v': 'new'} for i in range(1, 9, 2)]
+
 # Test batch write to a table with only a hash key
 def test_batch_write_hash_only(test_table_s):
     items = [{'p': random_string(), 'val': random_string()} for i in range(10)]
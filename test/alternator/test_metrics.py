@@ -32,6 +32,7 @@ import requests
 from botocore.exceptions import ClientError
 
 from test.alternator.test_manual_requests import get_signed_request
+from test.alternator.test_streams import latest_iterators, fetch_more
 from test.alternator.util import random_string, new_test_table, is_aws, scylla_config_read
 
 # Fixture for checking if we are able to test Scylla metrics. Scylla metrics
@@ -394,6 +395,21 @@ def test_item_latency(test_table_s, metrics):
         test_table_s.meta.client.batch_get_item(RequestItems = {
             test_table_s.name: {'Keys': [{'p': random_string()}], 'ConsistentRead': True}})
 
+# Wait for the stream of the table to become active, and return its ARN
+# and the id of one of its shards. This should be instantaneous in
+# Alternator, so the loop won't wait.
+def wait_for_stream_shard(table, dynamodbstreams):
+    start_time = time.time()
+    while time.time() < start_time + 60:
+        desc = table.meta.client.describe_table(TableName=table.name)['Table']
+        if 'LatestStreamArn' in desc:
+            arn = desc['LatestStreamArn']
+            desc = dynamodbstreams.describe_stream(StreamArn=arn)
+            if desc['StreamDescription']['StreamStatus'] == 'ENABLED':
+                return arn, desc['StreamDescription']['Shards'][0]['ShardId']
+        time.sleep(1)
+    pytest.fail('stream did not become enabled')
+
 # Test latency metrics for GetRecords. Other Streams-related operations -
 # ListStreams, DescribeStream, and GetShardIterator, have an operation
 # count (tested above) but do NOT currently have a latency histogram.
@@ -413,26 +429,34 @@ def test_streams_latency(dynamodb, dynamodbstreams, metrics):
         AttributeDefinitions=[{ 'AttributeName': 'p', 'AttributeType': 'S' }],
         StreamSpecification={ 'StreamEnabled': True, 'StreamViewType': 'NEW_AND_OLD_IMAGES'}
         ) as table:
-        # Wait for the stream to become active. This should be instantenous
-        # in Alternator, so the following loop won't wait
-        stream_enabled = False
-        start_time = time.time()
-        while time.time() < start_time + 60:
-            desc = table.meta.client.describe_table(TableName=table.name)['Table']
-            if 'LatestStreamArn' in desc:
-                arn = desc['LatestStreamArn']
-                desc = dynamodbstreams.describe_stream(StreamArn=arn)
-                if desc['StreamDescription']['StreamStatus'] == 'ENABLED':
-                    stream_enabled = True
-                    break
-            time.sleep(1)
-        assert stream_enabled
-        desc = dynamodbstreams.describe_stream(StreamArn=arn)
-        shard_id = desc['StreamDescription']['Shards'][0]['ShardId'];
+        arn, shard_id = wait_for_stream_shard(table, dynamodbstreams)
         it = dynamodbstreams.get_shard_iterator(StreamArn=arn, ShardId=shard_id, ShardIteratorType='LATEST')['ShardIterator']
         with check_sets_latency(metrics, ['GetRecords']):
             dynamodbstreams.get_records(ShardIterator=it)
 
+# Test the metrics of the CDC log rows read by GetRecords and of the records
+# returned, which tell the read amplification of GetRecords.
+def test_streams_get_records_rows_read(dynamodb, dynamodbstreams, metrics):
+    with new_test_table(dynamodb,
+        # See test_streams_latency about the tablets
+        Tags=[{'Key': 'experimental:initial_tablets', 'Value': 'none'}],
+        KeySchema=[{ 'AttributeName': 'p', 'KeyType': 'HASH' }],
+        AttributeDefinitions=[{ 'AttributeName': 'p', 'AttributeType': 'S' }],
+        StreamSpecification={ 'StreamEnabled': True, 'StreamViewType': 'KEYS_ONLY'}
+        ) as table:
+        arn, _ = wait_for_stream_shard(table, dynamodbstreams)
+        iterators = latest_iterators(dynamodbstreams, arn)
+        with check_increases_metric(metrics, ['scylla_alternator_get_records_rows_read', 'scylla_alternator_get_records_records_returned']):
+            table.put_item(Item={'p': random_string()})
+            # Records only show up in GetRecords after a while (see
+            # alternator_streams_time_window_s), so read until they do.
+            output = []
+            start_time = time.time()
+            while not output and time.time() < start_time + 120:
+                iterators = fetch_more(dynamodbstreams, iterators, output)
+                time.sleep(0.5)
+            assert output
+
 ###### Test for other metrics, not counting specific DynamoDB API operations:
 
 # Test that unsupported operations operations increment a counter. Instead
@@ -451,6 +475,24 @@ def test_total_operations(dynamodb, metrics):
     with check_increases_metric(metrics, ['scylla_alternator_total_operations']):
         dynamodb.meta.client.describe_endpoints()
 
+# Test the metrics of the cache of parsed expressions. An expression which
+# was never seen before has to be parsed, and when the same expression is
+# used again, it is found in the cache. The cache is per shard, so we repeat
+# the request a few times to be sure some of them hit a shard which had
+# already seen the expression.
+def test_expression_cache(test_table_s, metrics):
+    p = random_string()
+    # The attribute name is a part of the expression's text, so the
+    # expression is new to the cache.
+    expr = f'SET a{random_string()} = :val'
+    with check_increases_metric(metrics, ['scylla_alternator_expression_cache_misses']):
+        test_table_s.update_item(Key={'p': p}, UpdateExpression=expr,
+            ExpressionAttributeValues={':val': 1})
+    with check_increases_metric(metrics, ['scylla_alternator_expression_cache_hits']):
+        for i in range(20):
+            test_table_s.update_item(Key={'p': p}, UpdateExpression=expr,
+                ExpressionAttributeValues={':val': i})
+
 # A fixture to read alternator-ttl-period-in-seconds from Scylla's
 # configuration. If we're testing something which isn't Scylla, or
 # this configuration does not exist, skip this test. If the configuration
@@ -473,7 +515,8 @@ def alternator_ttl_period_in_seconds(dynamodb, request):
 
 # Test metrics of the background expiration thread run for Alternator's TTL
 # feature. The metrics tested in this test are scylla_expiration_scan_passes,
-# scylla_expiration_scan_table and scylla_expiration_items_deleted. The
+# scylla_expiration_scan_table, scylla_expiration_items_scanned and
+# scylla_expiration_items_deleted. The
 # metric scylla_expiration_secondary_ranges_scanned is not tested in this
 # test - testing it requires a multi-node cluster because it counts the
 # number of times that this node took over another node's expiration duty.
@@ -488,7 +531,7 @@ def alternator_ttl_period_in_seconds(dynamodb, request):
 TAGS = [{'Key': 'experimental:initial_tablets', 'Value': 'none'}]
 def test_ttl_stats(dynamodb, metrics, alternator_ttl_period_in_seconds):
     print(alternator_ttl_period_in_seconds)
-    with check_increases_metric(metrics, ['scylla_expiration_scan_passes', 'scylla_expiration_scan_table', 'scylla_expiration_items_deleted']):
+    with check_increases_metric(metrics, ['scylla_expiration_scan_passes', 'scylla_expiration_scan_table', 'scylla_expiration_items_scanned', 'scylla_expiration_items_deleted']):
         with new_test_table(dynamodb,
             Tags = TAGS,
             KeySchema=[ { 'AttributeName': 'p', 'KeyType': 'HASH' }, ],
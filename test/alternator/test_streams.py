@@ -5,6 +5,7 @@
 # Tests for stream operations: ListStreams, DescribeStream, GetShardIterator,
 # GetRecords.
 
+import threading
 import time
 import urllib.request
 from contextlib import contextmanager, ExitStack
@@ -14,7 +15,7 @@ import pytest
 from boto3.dynamodb.types import TypeDeserializer
 from botocore.exceptions import ClientError
 
-from test.alternator.util import unique_table_name, create_test_table, new_test_table, random_string, freeze, list_tables, get_region
+from test.alternator.util import unique_table_name, create_test_table, new_test_table, random_string, freeze, list_tables, get_region, scylla_config_temporary
 
 # All tests in this file are expected to fail with tablets due to #16317.
 # To ensure that Alternator Streams is still being tested, instead of
@@ -1049,6 +1050,49 @@ def test_streams_another_result(test_table_ss_keys_only, dynamodbstreams):
         time.sleep(0.5)
     pytest.fail("timed out")
 
+# Scylla can be configured, with alternator_streams_get_records_max_wait_ms,
+# to have GetRecords on an open shard with no new data wait for a while for
+# new records instead of returning an empty result right away. Test that an
+# empty GetRecords indeed waits, and that a record written during the wait
+# is returned as soon as it appears. This is a Scylla-only extension.
+def test_streams_get_records_wait(test_table_ss_keys_only, dynamodb, dynamodbstreams, scylla_only):
+    table, arn = test_table_ss_keys_only
+    iterators = latest_iterators(dynamodbstreams, arn)
+    p = random_string()
+    c = random_string()
+    table.update_item(Key={'p': p, 'c': c},
+        UpdateExpression='SET x = :val1', ExpressionAttributeValues={':val1': 5})
+    # Find the shard of this key, as in test_streams_another_result above.
+    iter = None
+    timeout = time.time() + 15
+    while not iter and time.time() < timeout:
+        for i in iterators:
+            response = dynamodbstreams.get_records(ShardIterator=i)
+            if response['Records'] != []:
+                iter = response['NextShardIterator']
+                break
+        else:
+            time.sleep(0.5)
+    assert iter
+    with scylla_config_temporary(dynamodb, 'alternator_streams_get_records_max_wait_ms', '1000'):
+        start = time.time()
+        response = dynamodbstreams.get_records(ShardIterator=iter)
+        assert time.time() - start >= 0.8
+        assert response['Records'] == []
+        iter = response['NextShardIterator']
+    with scylla_config_temporary(dynamodb, 'alternator_streams_get_records_max_wait_ms', '10000'):
+        writer = threading.Timer(0.5, lambda: table.update_item(Key={'p': p, 'c': c},
+            UpdateExpression='SET x = :val2', ExpressionAttributeValues={':val2': 7}))
+        writer.start()
+        try:
+            start = time.time()
+            response = dynamodbstreams.get_records(ShardIterator=iter)
+            assert time.time() - start < 8
+            assert len(response['Records']) == 1
+            assert response['Records'][0]['dynamodb']['Keys'] == {'p': {'S': p}, 'c': {'S': c}}
+        finally:
+            writer.join()
+
 # Test the SequenceNumber attribute returned for stream events, and the
 # "AT_SEQUENCE_NUMBER" iterator that can be used to re-read from the same
 # event again given its saved "sequence number".
@@ -99,6 +99,24 @@ BOOST_AUTO_TEST_CASE(test_get_time_uuid) {
     BOOST_CHECK(unix_timestamp == millis);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_time_uuids) {
+    BOOST_REQUIRE(utils::UUID_gen::get_time_UUIDs(0).empty());
+
+    auto before = utils::UUID_gen::get_time_UUID();
+    auto uuids = utils::UUID_gen::get_time_UUIDs(20000);
+    auto after = utils::UUID_gen::get_time_UUID();
+    BOOST_REQUIRE_EQUAL(uuids.size(), 20000);
+
+    auto prev = before;
+    for (const auto& uuid : uuids) {
+        BOOST_REQUIRE(uuid.is_timestamp());
+        BOOST_REQUIRE_GT(uuid.timestamp(), prev.timestamp());
+        BOOST_REQUIRE(utils::timeuuid_tri_compare(uuid, prev) > 0);
+        prev = uuid;
+    }
+    BOOST_REQUIRE(utils::timeuuid_tri_compare(after, prev) > 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_uuid_to_uint32) {
     // (gdb) p/x 0x3123223d ^ 0x17300 ^ 0x31e31215 ^ 0x98312
     // $2 = 0xc8c03a
@@ -289,3 +289,78 @@ SEASTAR_THREAD_TEST_CASE(test_tracker_cpu_limit_longterm) {
     BOOST_REQUIRE_GE(used, elapsed * limit * 0.9);
     BOOST_REQUIRE_LE(used, elapsed * limit * 1.1);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_tracker_adaptive_algorithm_selection) {
+    using algo = utils::compression_algorithm::type;
+    constexpr size_t raw_max_msg_size = 64;
+    auto cfg = utils::advanced_rpc_compressor::tracker::config{
+        .zstd_quota_fraction{1.0},
+        .algo_config = utils::updateable_value<utils::algo_config>{
+            {algo::ZSTD, algo::LZ4},
+        },
+        .adaptive = utils::updateable_value<bool>{true},
+        .adaptive_raw_max_msg_size = utils::updateable_value<uint32_t>{raw_max_msg_size},
+    };
+    // With a clock which never advances, compression is free, so the
+    // adaptive mode should simply pick the algorithm with the best ratio.
+    tracker_without_clock tracker{cfg};
+    const auto cls = utils::connection_class{.index = 3, .cross_dc = true};
+    auto feature_string = tracker.supported();
+    auto server_compressor = tracker.negotiate(feature_string, true, [] { return make_ready_future<>(); });
+    auto close_server_compressor = deferred_close(*server_compressor);
+    auto client_compressor = tracker.negotiate(server_compressor->name(), false, [] { return make_ready_future<>(); }, cls);
+    auto close_client_compressor = deferred_close(*client_compressor);
+
+    auto roundtrip = [&] (const bytes& message) {
+        auto msg = client_compressor->compress(0, rpc::snd_buf{bytes_view_to_temporary_buffer(message)});
+        auto decompressed = server_compressor->decompress(convert_rpc_buf<rpc::rcv_buf>(std::move(msg)));
+        BOOST_REQUIRE_EQUAL(message, rpc_buf_to_bytes(decompressed));
+    };
+    auto messages_sent = [&] (algo a) {
+        return tracker.get_stats()[utils::compression_algorithm(a).idx()].messages_sent;
+    };
+
+    // Settle negotiations.
+    for (int i = 0; i < 3; ++i) {
+        roundtrip(bytes());
+        auto msg = server_compressor->compress(0, rpc::snd_buf{0});
+        client_compressor->decompress(convert_rpc_buf<rpc::rcv_buf>(std::move(msg)));
+    }
+
+    // Tiny messages are sent raw.
+    auto raw_before = messages_sent(algo::RAW);
+    for (int i = 0; i < 10; ++i) {
+        roundtrip(tests::random::get_bytes(raw_max_msg_size));
+    }
+    BOOST_REQUIRE_EQUAL(messages_sent(algo::RAW) - raw_before, 10);
+
+    // Compressible messages are compressed, apart from the occasional exploration.
+    auto compressible = tests::random::get_bytes(1000) + bytes(size_t(10000), bytes::value_type(0));
+    for (int i = 0; i < 20; ++i) {
+        roundtrip(compressible);
+    }
+    raw_before = messages_sent(algo::RAW);
+    constexpr int n_messages = 200;
+    for (int i = 0; i < n_messages; ++i) {
+        roundtrip(compressible);
+    }
+    BOOST_REQUIRE_LE(messages_sent(algo::RAW) - raw_before, n_messages / 32);
+
+    // Incompressible messages mostly go raw, since compression doesn't pay off.
+    // Give the moving averages time to forget the compressible messages.
+    auto incompressible = tests::random::get_bytes(10000);
+    for (int i = 0; i < 300; ++i) {
+        roundtrip(incompressible);
+    }
+    raw_before = messages_sent(algo::RAW);
+    for (int i = 0; i < n_messages; ++i) {
+        roundtrip(incompressible);
+    }
+    BOOST_REQUIRE_GE(messages_sent(algo::RAW) - raw_before, n_messages - n_messages / 32);
+
+    auto cs = tracker.get_class_stats(cls);
+    BOOST_REQUIRE(cs);
+    BOOST_REQUIRE_GT(cs->bytes_sent, cs->compressed_bytes_sent);
+    BOOST_REQUIRE(tracker.get_class_stats(utils::connection_class{}));
+    BOOST_REQUIRE(!tracker.get_class_stats(utils::connection_class{.index = 3, .cross_dc = false}));
+}
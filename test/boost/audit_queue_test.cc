@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "audit/audit_queue.hh"
+#include "db/config.hh"
+
+using namespace audit;
+
+namespace {
+
+class fake_storage_helper : public storage_helper {
+public:
+    std::vector<std::vector<sstring>> batches;
+    std::optional<promise<>> blocked;
+
+    virtual future<> start(const db::config&) override { return make_ready_future<>(); }
+    virtual future<> stop() override { return make_ready_future<>(); }
+    virtual future<> write(const audit_info*, socket_address, socket_address, db::consistency_level, const sstring&, bool) override {
+        return make_exception_future<>(std::runtime_error("not batched"));
+    }
+    virtual future<> write_login(const sstring&, socket_address, socket_address, bool) override {
+        return make_exception_future<>(std::runtime_error("not batched"));
+    }
+    virtual future<> write_batch(std::span<const audit_record> records) override {
+        auto& batch = batches.emplace_back();
+        for (const auto& r : records) {
+            batch.push_back(r.info ? r.info->query() : "LOGIN " + r.username);
+        }
+        if (blocked) {
+            return blocked->get_future();
+        }
+        return make_ready_future<>();
+    }
+};
+
+audit_record make_record(sstring query) {
+    audit_info info(statement_category::QUERY, "ks", "t");
+    info.set_query_string(query);
+    return audit_record{
+        .info = std::move(info),
+        .node_ip = socket_address(),
+        .client_ip = socket_address(),
+        .cl = db::consistency_level::ONE,
+        .username = "user",
+        .error = false,
+        .time = std::chrono::system_clock::now(),
+    };
+}
+
+void wait_for_batches(const fake_storage_helper& helper, size_t n) {
+    while (helper.batches.size() < n) {
+        seastar::sleep(std::chrono::milliseconds(1)).get();
+    }
+}
+
+}
+
+SEASTAR_THREAD_TEST_CASE(test_audit_queue_writes_in_batches) {
+    fake_storage_helper helper;
+    audit_queue queue(helper, {.flush_interval = std::chrono::milliseconds(10), .max_records = 100, .policy = audit_queue::full_policy::block});
+    queue.start();
+
+    queue.push(make_record("q1")).get();
+    queue.push(make_record("q2")).get();
+    BOOST_REQUIRE(helper.batches.empty());
+    wait_for_batches(helper, 1);
+    BOOST_REQUIRE((helper.batches[0] == std::vector<sstring>{"q1", "q2"}));
+
+    // Records queued before stopping are written.
+    queue.push(make_record("q3")).get();
+    queue.stop().get();
+    BOOST_REQUIRE_EQUAL(helper.batches.size(), 2);
+    BOOST_REQUIRE((helper.batches[1] == std::vector<sstring>{"q3"}));
+    BOOST_REQUIRE_EQUAL(queue.get_stats().written, 3);
+    BOOST_REQUIRE_EQUAL(queue.size(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_audit_queue_full) {
+    for (auto policy : {audit_queue::full_policy::block, audit_queue::full_policy::drop}) {
+        fake_storage_helper helper;
+        helper.blocked.emplace();
+        // A long interval, flushes are triggered by the queue filling up.
+        audit_queue queue(helper, {.flush_interval = std::chrono::hours(1), .max_records = 2, .policy = policy});
+        queue.start();
+
+        queue.push(make_record("q1")).get();
+        wait_for_batches(helper, 1);
+        queue.push(make_record("q2")).get();
+        BOOST_REQUIRE_EQUAL(queue.size(), 2);
+
+        // The write of the first batch is stuck, the queue is full.
+        auto f = queue.push(make_record("q3"));
+        if (policy == audit_queue::full_policy::drop) {
+            BOOST_REQUIRE(f.available());
+            f.get();
+            BOOST_REQUIRE_EQUAL(queue.get_stats().dropped, 1);
+        } else {
+            BOOST_REQUIRE(!f.available());
+        }
+
+        std::exchange(helper.blocked, std::nullopt)->set_value();
+        f.get();
+        queue.stop().get();
+        std::vector<sstring> written;
+        for (auto& batch : helper.batches) {
+            written.insert(written.end(), batch.begin(), batch.end());
+        }
+        if (policy == audit_queue::full_policy::drop) {
+            BOOST_REQUIRE((written == std::vector<sstring>{"q1", "q2"}));
+        } else {
+            BOOST_REQUIRE((written == std::vector<sstring>{"q1", "q2", "q3"}));
+        }
+        BOOST_REQUIRE_EQUAL(queue.get_stats().written, written.size());
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_audit_queue_stop_releases_waiters) {
+    fake_storage_helper helper;
+    helper.blocked.emplace();
+    audit_queue queue(helper, {.flush_interval = std::chrono::hours(1), .max_records = 2, .policy = audit_queue::full_policy::block});
+    queue.start();
+
+    queue.push(make_record("q1")).get();
+    wait_for_batches(helper, 1);
+    queue.push(make_record("q2")).get();
+    auto f = queue.push(make_record("q3"));
+    BOOST_REQUIRE(!f.available());
+
+    // The waiter doesn't wait for the stuck write.
+    auto stopped = queue.stop();
+    f.get();
+    BOOST_REQUIRE_EQUAL(queue.get_stats().dropped, 1);
+    queue.push(make_record("q4")).get();
+    BOOST_REQUIRE_EQUAL(queue.get_stats().dropped, 2);
+
+    std::exchange(helper.blocked, std::nullopt)->set_value();
+    stopped.get();
+    std::vector<sstring> written;
+    for (auto& batch : helper.batches) {
+        written.insert(written.end(), batch.begin(), batch.end());
+    }
+    BOOST_REQUIRE((written == std::vector<sstring>{"q1", "q2"}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_audit_queue_parse_full_policy) {
+    BOOST_REQUIRE(audit_queue::parse_full_policy("block") == audit_queue::full_policy::block);
+    BOOST_REQUIRE(audit_queue::parse_full_policy("drop") == audit_queue::full_policy::drop);
+    BOOST_REQUIRE_THROW(audit_queue::parse_full_policy("wait"), audit_exception);
+}
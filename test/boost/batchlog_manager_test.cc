@@ -22,6 +22,8 @@
 #include "db/commitlog/commitlog.hh"
 #include "message/messaging_service.hh"
 #include "service/storage_proxy.hh"
+#include "db/config.hh"
+#include "utils/UUID_gen.hh"
 
 BOOST_AUTO_TEST_SUITE(batchlog_manager_test)
 
@@ -67,4 +69,48 @@ SEASTAR_TEST_CASE(test_execute_batch) {
     });
 }
 
+SEASTAR_TEST_CASE(test_replay_all_token_slices) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p1 varchar, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
+        auto& qp = e.local_qp();
+        auto& bp = e.batchlog_manager().local();
+        auto s = e.local_db().find_schema("ks", "cf");
+        const column_definition& r1_col = *s->get_column_definition("r1");
+        auto c_key = clustering_key::from_exploded(*s, {int32_type->decompose(1)});
+
+        // Batches land in the slices of all the shards.
+        using namespace std::chrono_literals;
+        constexpr int batches = 32;
+        for (int i = 0; i < batches; ++i) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(format("key{}", i))}));
+            m.set_clustered_cell(c_key, r1_col, make_atomic_cell(int32_type, int32_type->decompose(i)));
+            auto bm = qp.proxy().get_batchlog_mutation_for({ m }, utils::UUID_gen::get_time_UUID(), netw::messaging_service::current_version, db_clock::now() - db_clock::duration(3h));
+            qp.proxy().mutate_locally(bm, tracing::trace_state_ptr(), db::commitlog::force_sync::no).get();
+        }
+        BOOST_REQUIRE_EQUAL(bp.count_all_batches().get(), batches);
+
+        bp.do_batch_log_replay(db::batchlog_manager::post_replay_cleanup::no).get();
+        BOOST_REQUIRE_EQUAL(bp.count_all_batches().get(), 0);
+        auto rs = qp.execute_internal("select count(*) from ks.cf", cql3::query_processor::cache_internal::no).get();
+        BOOST_REQUIRE_EQUAL(rs->one().get_as<int64_t>("count"), batches);
+    });
+}
+
+SEASTAR_TEST_CASE(test_local_durable_batch) {
+    cql_test_config cfg;
+    cfg.db_config->batchlog_local_durable_writes.set(true);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p1 varchar, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
+        e.execute_cql("begin batch "
+                "insert into cf (p1, c1, r1) values ('key1', 1, 100); "
+                "insert into cf (p1, c1, r1) values ('key2', 1, 200); "
+                "apply batch;").get();
+
+        // The entry is written and removed locally.
+        BOOST_REQUIRE_EQUAL(e.batchlog_manager().local().count_all_batches().get(), 0);
+        auto rs = e.local_qp().execute_internal("select count(*) from ks.cf", cql3::query_processor::cache_internal::no).get();
+        BOOST_REQUIRE_EQUAL(rs->one().get_as<int64_t>("count"), 2);
+    }, cfg);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -195,6 +195,35 @@ BOOST_AUTO_TEST_CASE(test_big_decimal_add) {
     test_add("000000000012345678901234.5678901234e-1", "0777.555555555555555555555e2", "1234567967879.0123445678955555555");
 }
 
+// Values around the limits of the 64-bit fast paths.
+BOOST_AUTO_TEST_CASE(test_big_decimal_small_value_edges) {
+    test_add("9223372036854775807", "1", "9223372036854775808");
+    test_add("-9223372036854775808", "-1", "-9223372036854775809");
+    test_add("-9223372036854775808", "9223372036854775807", "-1");
+    test_sub("-9223372036854775808", "1", "-9223372036854775809");
+    test_sub("9223372036854775807", "-9223372036854775808", "18446744073709551615");
+    // Rescaled by 10^18, the largest rescale done in 128 bits.
+    test_add("9223372036854775807", "0.000000000000000001", "9223372036854775807.000000000000000001");
+    test_add("-9223372036854775808", "-0.000000000000000001", "-9223372036854775808.000000000000000001");
+    // Rescaled by 10^19, falls back to the multiprecision arithmetic.
+    test_add("9223372036854775807", "0.0000000000000000001", "9223372036854775807.0000000000000000001");
+    test_add("1", "9223372036854775808", "9223372036854775809");
+
+    test_div("-9223372036854775808", 1, "-9223372036854775808");
+    test_div("-9223372036854775808", 2, "-4611686018427387904");
+    test_div("9223372036854775807", 2, "4611686018427387904");
+    test_div("9223372036854775805", std::numeric_limits<int64_t>::max(), "1");
+    test_div("4611686018427387904", std::numeric_limits<int64_t>::max(), "1");
+    test_div("4611686018427387903", std::numeric_limits<int64_t>::max(), "0");
+
+    BOOST_REQUIRE(big_decimal("9223372036854775807") < big_decimal("9223372036854775808"));
+    BOOST_REQUIRE(big_decimal("-9223372036854775808") > big_decimal("-9223372036854775809"));
+    BOOST_REQUIRE(big_decimal("9223372036854775807") > big_decimal("9223372036854775806.999999999999999999"));
+    BOOST_REQUIRE((big_decimal("9223372036854775807") <=> big_decimal("9223372036854775807.000000000000000000")) == 0);
+    BOOST_REQUIRE(big_decimal("-9223372036854775808") < big_decimal("-9223372036854775807.999999999999999999"));
+    BOOST_REQUIRE(big_decimal("1") > big_decimal("0.9999999999999999999"));
+}
+
 BOOST_AUTO_TEST_CASE(test_big_decimal_assignsub) {
     test_assignsub("1", "4", "-3");
     test_assignsub("1.00", "4.00", "-3.00");
@@ -13,6 +13,7 @@
 #include "test/lib/sstable_test_env.hh"
 #include "test/lib/sstable_utils.hh"
 
+#include "db/bloom_filter_extension.hh"
 #include "db/config.hh"
 #include "readers/from_mutations.hh"
 #include "utils/bloom_filter.hh"
@@ -110,6 +111,34 @@ SEASTAR_TEST_CASE(test_sstable_manager_auto_reclaim_and_reload_of_bloom_filter)
     });
 }
 
+SEASTAR_TEST_CASE(test_deferred_bloom_filter_is_loaded_in_background) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto pks = ss.make_pkeys(10);
+
+        utils::chunked_vector<mutation> muts;
+        for (auto& pk : pks) {
+            auto m = mutation(s, pk);
+            m.partition().apply_insert(*s, ss.make_ckey(0), ss.new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        auto written = make_sstable_containing(env.make_sstable(s), std::move(muts));
+        auto filter_memory = written->filter_memory_size();
+        BOOST_REQUIRE_GT(filter_memory, 0);
+
+        auto& sst_mgr = env.manager();
+        auto sst = env.reusable_sst(s, written->get_storage().prefix(), written->generation(), written->get_version(),
+                sstables::sstable::format_types::big, { .defer_bloom_filter = true }).get();
+        // The filter is loaded by the components reloader, once there's memory for it
+        REQUIRE_EVENTUALLY_EQUAL<size_t>([&] { return sst->filter_memory_size(); }, filter_memory);
+        REQUIRE_EVENTUALLY_EQUAL<size_t>([&] { return sst_mgr.get_total_memory_reclaimed(); }, 0);
+        for (auto& pk : pks) {
+            BOOST_REQUIRE(sst->filter_has_key(*s, pk));
+        }
+    });
+}
+
 // Reproducer for https://github.com/scylladb/scylladb/issues/18398.
 SEASTAR_TEST_CASE(test_reclaimed_bloom_filter_deletion_from_disk) {
     return test_env::do_with_async([] (test_env& env) {
@@ -405,3 +434,89 @@ SEASTAR_TEST_CASE(test_components_memory_reclaim_threshold_liveupdateness) {
         .available_memory = 1000
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_bloom_filter) {
+    const int64_t nr_keys = 10000;
+    const double fp_chance = 0.01;
+    auto filter = utils::i_filter::get_filter(nr_keys, fp_chance, utils::filter_format::m_format, utils::filter_layout::split_block);
+    BOOST_REQUIRE(filter->layout() == utils::filter_layout::split_block);
+    auto& bits = static_cast<utils::filter::bloom_filter*>(filter.get())->bits();
+    BOOST_REQUIRE_EQUAL(bits.size() % utils::filter::split_block_bloom_filter::bits_per_block, 0);
+    BOOST_REQUIRE_EQUAL(bits.size() / 8, utils::i_filter::get_filter_size(nr_keys, fp_chance, utils::filter_layout::split_block));
+
+    auto make_key = [] (int64_t i) {
+        return bytes(reinterpret_cast<const int8_t*>(&i), sizeof(i));
+    };
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        filter->add(make_key(i));
+    }
+    // No false negatives.
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(filter->is_present(make_key(i)));
+    }
+    // The false positive rate is within a reasonable margin of the requested one.
+    int64_t false_positives = 0;
+    for (int64_t i = nr_keys; i < 11 * nr_keys; ++i) {
+        false_positives += filter->is_present(make_key(i));
+    }
+    BOOST_REQUIRE_LE(double(false_positives) / (10 * nr_keys), 2 * fp_chance);
+}
+
+SEASTAR_TEST_CASE(test_split_block_bloom_filter_layout_is_persisted) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = schema_builder(ss.schema())
+                .add_extension(db::bloom_filter_extension::NAME, ::make_shared<db::bloom_filter_extension>(utils::filter_layout::split_block))
+                .build();
+        BOOST_REQUIRE(schema->bloom_filter_layout() == utils::filter_layout::split_block);
+
+        utils::chunked_vector<mutation> mutations;
+        auto pks = ss.make_pkeys(10);
+        for (auto& pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(schema), mutations);
+        auto reopened = env.reusable_sst(sst).get();
+
+        BOOST_REQUIRE(reopened->get_scylla_metadata()->get_filter_layout() == utils::filter_layout::split_block);
+        auto& filter = sstables::test(reopened).get_filter();
+        BOOST_REQUIRE(filter->layout() == utils::filter_layout::split_block);
+        for (auto& pk : pks) {
+            BOOST_REQUIRE(filter->is_present(key::from_partition_key(*schema, pk.key()).get_bytes()));
+        }
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_is_present_batch) {
+    const int64_t nr_keys = 100;
+    std::vector<utils::filter_ptr> filters;
+    for (auto layout : {utils::filter_layout::classic, utils::filter_layout::split_block}) {
+        for (int i = 0; i < 3; ++i) {
+            filters.push_back(utils::i_filter::get_filter(nr_keys, 0.01, utils::filter_format::m_format, layout));
+        }
+    }
+    filters.push_back(std::make_unique<utils::filter::always_present_filter>());
+
+    auto make_key = [] (int64_t i) {
+        return bytes(reinterpret_cast<const int8_t*>(&i), sizeof(i));
+    };
+    // Filter j contains the keys which are multiples of j + 1.
+    for (int64_t k = 0; k < nr_keys; ++k) {
+        for (size_t j = 0; j < filters.size(); ++j) {
+            if (k % (j + 1) == 0) {
+                filters[j]->add(make_key(k));
+            }
+        }
+    }
+
+    auto raw_filters = filters | std::views::transform([] (auto& f) { return f.get(); }) | std::ranges::to<std::vector<utils::i_filter*>>();
+    for (int64_t k = 0; k < 2 * nr_keys; ++k) {
+        auto hk = utils::make_hashed_key(make_key(k));
+        auto present = utils::is_present_batch(raw_filters, hk);
+        for (size_t j = 0; j < filters.size(); ++j) {
+            BOOST_REQUIRE_EQUAL(bool(present & (uint64_t(1) << j)), filters[j]->is_present(hk));
+        }
+    }
+}
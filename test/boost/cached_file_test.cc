@@ -20,6 +20,7 @@
 #include "test/lib/tmpdir.hh"
 
 #include "utils/cached_file.hh"
+#include "sstables/decompressed_chunk_cache.hh"
 
 using namespace seastar;
 
@@ -162,6 +163,35 @@ SEASTAR_THREAD_TEST_CASE(test_concurrent_population) {
     BOOST_REQUIRE_EQUAL(1, metrics.page_populations);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_adjacent_misses_are_coalesced) {
+    auto page_size = cached_file::page_size;
+    cached_file_stats metrics;
+    test_file tf = make_test_file(page_size * 4);
+    logalloc::region region;
+    cached_file cf(tf.f, metrics, cf_lru, region, page_size * 4);
+    seastar::file f = make_cached_seastar_file(cf);
+
+    seastar::when_all(
+        seastar::async([&] {
+            BOOST_REQUIRE_EQUAL(tf.contents.substr(0, 1), read_to_string(f, 0, 1));
+        }),
+        seastar::async([&] {
+            BOOST_REQUIRE_EQUAL(tf.contents.substr(page_size, 1), read_to_string(f, page_size, 1));
+        }),
+        seastar::async([&] {
+            BOOST_REQUIRE_EQUAL(tf.contents.substr(page_size * 3, 1), read_to_string(f, page_size * 3, 1));
+        })
+    ).get();
+
+    // Misses are only coalesced when the first one has to yield, pages 0
+    // and 1 may share a read, page 3 isn't adjacent.
+    BOOST_REQUIRE_EQUAL(3, metrics.page_misses);
+    BOOST_REQUIRE_EQUAL(3, metrics.page_populations);
+    BOOST_REQUIRE_GE(metrics.page_reads, 2);
+    BOOST_REQUIRE_LE(metrics.page_reads, 3);
+    BOOST_REQUIRE_EQUAL(3, metrics.pages_read);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_reading_from_small_file) {
     test_file tf = make_test_file(1024);
 
@@ -501,3 +531,43 @@ SEASTAR_THREAD_TEST_CASE(test_page_view_as_contiguous_shared_buffer) {
     // p should not affect p2
     BOOST_REQUIRE_EQUAL(tf.contents.substr(5, 2), sstring(p2.begin(), p2.end()));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_decompressed_chunk_cache) {
+    decompressed_chunk_cache_stats stats;
+    logalloc::region region;
+    sstables::decompressed_chunk_cache cache(stats, cf_lru, region);
+
+    auto chunk = [] (char c) {
+        temporary_buffer<char> buf(4096);
+        std::fill(buf.get_write(), buf.get_write() + buf.size(), c);
+        return buf;
+    };
+
+    BOOST_REQUIRE(!cache.get(0));
+    BOOST_REQUIRE_EQUAL(1, stats.misses);
+
+    cache.put(0, chunk('a'));
+    cache.put(1, chunk('b'));
+    cache.put(1, chunk('c')); // already cached
+    BOOST_REQUIRE_EQUAL(2, stats.populations);
+    BOOST_REQUIRE_EQUAL(2 * 4096, stats.cached_bytes);
+
+    auto buf = cache.get(1);
+    BOOST_REQUIRE(buf == chunk('b'));
+    BOOST_REQUIRE_EQUAL(1, stats.hits);
+
+    // The returned copy doesn't pin the chunk.
+    with_allocator(region.allocator(), [] {
+        cf_lru.evict_all();
+    });
+    BOOST_REQUIRE_EQUAL(2, stats.evictions);
+    BOOST_REQUIRE_EQUAL(0, stats.cached_bytes);
+    BOOST_REQUIRE(!cache.get(1));
+    BOOST_REQUIRE(buf == chunk('b'));
+
+    cache.put(2, chunk('d'));
+    cache.evict_gently().get();
+    BOOST_REQUIRE_EQUAL(3, stats.evictions);
+    BOOST_REQUIRE(!cache.get(2));
+    BOOST_REQUIRE_EQUAL(region.occupancy().used_space(), 0);
+}
@@ -1842,6 +1842,30 @@ void test_batch_images(bool preimage, bool postimage) {
                     }
                 }
             },
+            // Update different columns in different clustering rows, all of
+            // which have previous values. All rows are read by one preimage
+            // query, which must select the columns of all of them.
+            {
+                {
+                    "BEGIN UNLOGGED BATCH"
+                    "   UPDATE ks.tbl SET v1 = 12 WHERE pk = 0 AND ck = 1;"
+                    "   UPDATE ks.tbl SET v2 = 23 WHERE pk = 0 AND ck = 2;"
+                    "APPLY BATCH"
+                },
+                {"ck", "v1", "v2"},
+                {
+                    {
+                        .preimage = {
+                            {int32_t(1), int32_t(11), int_null},
+                            {int32_t(2), int_null, int32_t(22)}
+                        },
+                        .postimage = {
+                            {int32_t(1), int32_t(12), int_null},
+                            {int32_t(2), int32_t(20), int32_t(23)}
+                        }
+                    }
+                }
+            },
             // Delete clustering rows (same pk as before)
             {
                 {
@@ -1855,8 +1879,8 @@ void test_batch_images(bool preimage, bool postimage) {
                     {
                         .preimage = {
                             // Preimage for delete contains everything
-                            {int32_t(1), int32_t(11), int_null},
-                            {int32_t(2), int32_t(20), int32_t(22)}
+                            {int32_t(1), int32_t(12), int_null},
+                            {int32_t(2), int32_t(20), int32_t(23)}
                         },
                     }
                 }
@@ -81,3 +81,34 @@ BOOST_AUTO_TEST_CASE(test_libdeflate_matches_zlib) {
 BOOST_AUTO_TEST_CASE(test_default_matches_zlib) {
     test<zlib_crc32_checksummer, crc32_utils>();
 }
+
+// Bit-at-a-time CRC32C, as a reference.
+static uint32_t reference_crc32c(uint32_t crc, const char* input, size_t input_len) {
+    for (size_t i = 0; i < input_len; ++i) {
+        crc ^= uint8_t(input[i]);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = crc & 1 ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+BOOST_AUTO_TEST_CASE(test_crc32c) {
+    // The standard check value, with pre- and post-inversion.
+    const char check[] = "123456789";
+    BOOST_REQUIRE_EQUAL(crc32c_utils::checksum(0xffffffff, check, 9) ^ 0xffffffff, 0xe3069283);
+
+    auto rolling = crc32c_utils::init_checksum();
+    for (auto size : {0, 1, 2, 10, 13, 16, 17, 22, 31, 1023, 1024, 1025, 2000, 80000}) {
+        auto data = make_random_string(size);
+
+        auto current = crc32c_utils::checksum(data.data(), data.size());
+        BOOST_REQUIRE_EQUAL(current, reference_crc32c(0, data.data(), data.size()));
+
+        auto new_rolling = crc32c_utils::checksum(rolling, data.data(), data.size());
+        BOOST_REQUIRE_EQUAL(new_rolling, reference_crc32c(rolling, data.data(), data.size()));
+        BOOST_REQUIRE_EQUAL(crc32c_utils::checksum_combine(rolling, current, data.size()), new_rolling);
+
+        rolling = new_rolling;
+    }
+}
@@ -15,6 +15,7 @@
 #include <unordered_set>
 #include <set>
 #include <deque>
+#include <ranges>
 
 #include <fmt/ranges.h>
 
@@ -25,6 +26,7 @@
 #include <seastar/core/do_with.hh>
 #include <seastar/core/scollectd_api.hh>
 #include <seastar/core/file.hh>
+#include <seastar/core/byteorder.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/closeable.hh>
@@ -109,6 +111,28 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_batch){
         });
 }
 
+// check that concurrent writes in batch mode share syncs when group commit is enabled
+SEASTAR_TEST_CASE(test_commitlog_group_commit_batch){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    cfg.group_commit_window = std::chrono::milliseconds(10);
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        constexpr size_t writes = 20;
+        auto uuid = make_table_id();
+        co_await parallel_for_each(std::views::iota(size_t(0), writes), [&log, uuid] (size_t) {
+            sstring tmp = "hej bubba cow";
+            return log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            }).then([](replay_position rp) {
+                BOOST_CHECK_NE(rp, db::replay_position());
+            });
+        });
+        auto n = log.get_flush_count();
+        BOOST_REQUIRE(n > 0);
+        BOOST_REQUIRE_LT(n, writes);
+    });
+}
+
 // check that an entry marked as sync is immediately flushed to a storage
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_sync){
     commitlog::config cfg;
@@ -1103,6 +1127,65 @@ SEASTAR_TEST_CASE(test_commitlog_add_entries) {
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries) {
+    for (auto type : { commitlog_entry_compression::lz4, commitlog_entry_compression::zstd }) {
+        commitlog_entry_compressor compressor(type);
+        // Too small to bother.
+        BOOST_REQUIRE(!compressor.compress(bytes(16, int8_t('a'))));
+        auto compressed = compressor.compress(bytes(4096, int8_t('a')));
+        BOOST_REQUIRE(compressed);
+        BOOST_REQUIRE_LT(compressed->size(), 4096);
+        BOOST_REQUIRE_EQUAL(read_le<uint32_t>(reinterpret_cast<const char*>(compressed->data())), 0);
+
+        commitlog::config cfg;
+        cfg.metrics_category_name = "commitlog";
+        cfg.compression = type;
+        co_await cl_test(cfg, [](commitlog& log) {
+            return seastar::async([&] {
+                constexpr auto n = 10;
+                utils::chunked_vector<commitlog_entry_writer> writers;
+                utils::chunked_vector<frozen_mutation> mutations;
+                std::vector<replay_position> rps;
+
+                writers.reserve(n);
+                mutations.reserve(n);
+
+                for (auto i = 0; i < n; ++i) {
+                    random_mutation_generator gen(random_mutation_generator::generate_counters(false));
+                    mutations.emplace_back(gen(1).front());
+                    writers.emplace_back(gen.schema(), mutations.back(), commitlog_entry_writer::force_sync::no);
+                }
+
+                for (auto& w : writers) {
+                    auto h = log.add_entry(w.schema()->id(), w, db::timeout_clock::now() + 60s).get();
+                    rps.emplace_back(h.rp());
+                }
+                for (auto& h : log.add_entries(writers, db::timeout_clock::now() + 60s).get()) {
+                    rps.emplace_back(h.rp());
+                }
+
+                log.sync_all_segments().get();
+
+                // Both the compressed and the uncompressed entries have to come back intact.
+                size_t found = 0;
+                for (auto& seg : log.get_active_segment_names()) {
+                    db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                        commitlog_entry_reader r(buf_rp.buffer);
+                        auto i = std::find(rps.begin(), rps.end(), buf_rp.position);
+                        BOOST_REQUIRE(i != rps.end());
+                        auto idx = std::distance(rps.begin(), i) % n;
+                        auto s = writers.at(idx).schema();
+                        BOOST_CHECK_EQUAL(mutations.at(idx).unfreeze(s), r.mutation().unfreeze(s));
+                        ++found;
+                        return make_ready_future<>();
+                    }).get();
+                }
+                BOOST_CHECK_EQUAL(found, rps.size());
+            });
+        });
+    }
+}
+
 // #16298 - check entry offsets so that we report the correct file positions both
 // when reading and writing CL data.
 SEASTAR_TEST_CASE(test_commitlog_entry_offsets) {
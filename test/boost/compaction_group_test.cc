@@ -128,7 +128,9 @@ class single_compaction_group : public compaction::compaction_group_view {
     virtual const std::string get_group_id() const noexcept override { return "0"; }
     virtual seastar::condition_variable& get_staging_done_condition() noexcept override { return _staging_done_condition; }
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override { return dht::token_range(); }
+    std::optional<sstables::compaction_type_options::split> split_options() const noexcept override { return std::nullopt; }
     int64_t get_sstables_repaired_at() const noexcept override { return 0; }
+    double read_amplification() const noexcept override { return 1.0; }
 };
 
 SEASTAR_TEST_CASE(basic_compaction_group_splitting_test) {
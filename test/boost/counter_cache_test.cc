@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+
+#include "counters.hh"
+#include "replica/counter_cache.hh"
+#include "schema/schema_builder.hh"
+#include "mutation/mutation.hh"
+
+using replica::counter_cache;
+
+static constexpr counter_cache::version_type version = 1;
+
+static schema_ptr get_schema() {
+    return schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("s1", counter_type, column_kind::static_column)
+            .with_column("c1", counter_type)
+            .build();
+}
+
+struct counter_table {
+    schema_ptr s = get_schema();
+    const column_definition& col = *s->get_column_definition(to_bytes("c1"));
+    const column_definition& scol = *s->get_column_definition(to_bytes("s1"));
+    locator::host_id local_id = locator::host_id::create_random_id();
+
+    partition_key pk(int32_t v) const {
+        return partition_key::from_single_value(*s, int32_type->decompose(v));
+    }
+    clustering_key ck(int32_t v) const {
+        return clustering_key::from_single_value(*s, int32_type->decompose(v));
+    }
+    mutation make_update(int32_t p, std::vector<int32_t> cks, int64_t delta, bool with_static = false) const {
+        mutation m(s, pk(p));
+        for (auto c : cks) {
+            m.set_clustered_cell(ck(c), col, atomic_cell::make_live_counter_update(api::new_timestamp(), delta));
+        }
+        if (with_static) {
+            m.set_static_cell(scol, atomic_cell::make_live_counter_update(api::new_timestamp(), delta));
+        }
+        return m;
+    }
+    // Applies the update the way the counter write path does, with the state
+    // from the cache, and records the result in the cache.
+    mutation apply(counter_cache& cache, mutation update, const mutation* current_state) const {
+        transform_counter_updates_to_shards(update, current_state, 0, local_id);
+        cache.put(update, version, local_id);
+        return update;
+    }
+};
+
+static void check_shard(const counter_table& t, const mutation& m, int32_t ck, int64_t value, int64_t logical_clock) {
+    auto cells = m.partition().find_row(*t.s, t.ck(ck));
+    BOOST_REQUIRE(cells);
+    auto acv = cells->cell_at(t.col.id).as_atomic_cell(t.col);
+    auto cs = counter_cell_view(acv).get_shard(counter_id(t.local_id.uuid()));
+    BOOST_REQUIRE(cs);
+    BOOST_REQUIRE_EQUAL(cs->value(), value);
+    BOOST_REQUIRE_EQUAL(cs->logical_clock(), logical_clock);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_serves_applied_shards) {
+    counter_table t;
+    counter_cache cache(1 << 20);
+
+    auto u1 = t.make_update(0, {0, 1}, 5, true);
+    BOOST_REQUIRE(!cache.get(u1, version, t.local_id));
+    auto m1 = t.apply(cache, u1, nullptr);
+
+    // All cells of the update are known.
+    auto current = cache.get(t.make_update(0, {1}, 3, true), version, t.local_id);
+    BOOST_REQUIRE(current);
+    check_shard(t, *current, 1, 5, 1);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+
+    auto m2 = t.apply(cache, t.make_update(0, {1}, 3, true), &*current);
+    check_shard(t, m2, 1, 8, 2);
+
+    // Cells which were never updated through the cache have to be read.
+    BOOST_REQUIRE(!cache.get(t.make_update(0, {1, 2}, 1), version, t.local_id));
+    BOOST_REQUIRE(!cache.get(t.make_update(1, {1}, 1), version, t.local_id));
+
+    // Updates of other cells don't drop the cached ones.
+    t.apply(cache, t.make_update(0, {2}, 1), nullptr);
+    current = cache.get(t.make_update(0, {0, 1, 2}, 1), version, t.local_id);
+    BOOST_REQUIRE(current);
+    check_shard(t, *current, 0, 5, 1);
+    check_shard(t, *current, 1, 8, 2);
+    check_shard(t, *current, 2, 1, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_drops_stale_shards) {
+    counter_table t;
+    counter_cache cache(1 << 20);
+
+    auto update = t.make_update(0, {0}, 1);
+    t.apply(cache, update, nullptr);
+    BOOST_REQUIRE(cache.get(update, version, t.local_id));
+
+    // A topology change.
+    BOOST_REQUIRE(!cache.get(update, version + 1, t.local_id));
+    BOOST_REQUIRE(!cache.get(update, version, t.local_id));
+
+    // A schema change.
+    t.apply(cache, update, nullptr);
+    auto new_schema = schema_builder(t.s).with_column("c2", counter_type).build();
+    auto upgraded = update;
+    upgraded.upgrade(new_schema);
+    BOOST_REQUIRE(!cache.get(upgraded, version, t.local_id));
+
+    // Truncation or streaming.
+    t.apply(cache, update, nullptr);
+    cache.invalidate(t.s->id());
+    BOOST_REQUIRE(!cache.get(update, version, t.local_id));
+
+    // A failed write.
+    t.apply(cache, update, nullptr);
+    cache.invalidate(*t.s, t.pk(0));
+    BOOST_REQUIRE(!cache.get(update, version, t.local_id));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().invalidations, 4);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_only_live_counter_cells) {
+    counter_table t;
+
+    BOOST_REQUIRE(has_only_live_counter_cells(t.make_update(0, {0, 1}, 1, true)));
+
+    auto m = t.make_update(0, {0}, 1);
+    m.set_clustered_cell(t.ck(1), t.col, atomic_cell::make_dead(api::new_timestamp(), gc_clock::now()));
+    BOOST_REQUIRE(!has_only_live_counter_cells(m));
+
+    m = t.make_update(0, {0}, 1);
+    m.set_static_cell(t.scol, atomic_cell::make_dead(api::new_timestamp(), gc_clock::now()));
+    BOOST_REQUIRE(!has_only_live_counter_cells(m));
+
+    m = t.make_update(0, {0}, 1);
+    m.partition().apply(tombstone(api::new_timestamp(), gc_clock::now()));
+    BOOST_REQUIRE(!has_only_live_counter_cells(m));
+
+    m = t.make_update(0, {0}, 1);
+    m.partition().apply_delete(*t.s, t.ck(1), tombstone(api::new_timestamp(), gc_clock::now()));
+    BOOST_REQUIRE(!has_only_live_counter_cells(m));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_eviction) {
+    counter_table t;
+    counter_cache cache(1 << 20);
+
+    for (int32_t p = 0; p < 10; ++p) {
+        t.apply(cache, t.make_update(p, {0, 1, 2, 3}, 1), nullptr);
+    }
+    BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 0);
+    auto used = cache.used_bytes();
+
+    // The least recently used partitions go first.
+    BOOST_REQUIRE(cache.get(t.make_update(0, {0}, 1), version, t.local_id));
+    cache.set_capacity(used / 2);
+    BOOST_REQUIRE_LE(cache.used_bytes(), used / 2);
+    BOOST_REQUIRE_GT(cache.get_stats().evictions, 0);
+    BOOST_REQUIRE(cache.get(t.make_update(0, {0}, 1), version, t.local_id));
+    BOOST_REQUIRE(!cache.get(t.make_update(1, {0}, 1), version, t.local_id));
+
+    cache.set_capacity(0);
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+    t.apply(cache, t.make_update(0, {0}, 1), nullptr);
+    BOOST_REQUIRE(!cache.get(t.make_update(0, {0}, 1), version, t.local_id));
+}
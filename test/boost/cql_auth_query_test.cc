@@ -344,4 +344,24 @@ SEASTAR_TEST_CASE(modify_table_with_index) {
     }, db_config_with_auth());
 }
 
+SEASTAR_TEST_CASE(permissions_snapshot_follows_cache) {
+    auto cfg = db_config_with_auth();
+    cfg->permissions_validity_in_ms.set(3600000);
+    cfg->permissions_update_interval_in_ms.set(3600000);
+    return do_with_cql_env_thread([](auto&& env) {
+        cquery_nofail(env, "CREATE TABLE t (p int PRIMARY KEY)");
+        create_user_if_not_exists(env, bob);
+        cquery_nofail(env, "GRANT ALL PERMISSIONS ON t TO bob");
+        with_user(env, bob, [&env] {
+            cquery_nofail(env, "SELECT * FROM t");
+            cquery_nofail(env, "REVOKE SELECT ON t FROM bob");
+            // Cached permissions are still used, like without the snapshot.
+            cquery_nofail(env, "SELECT * FROM t");
+            // But not after the cache is reset.
+            env.local_auth_service().reset_authorization_cache();
+            BOOST_REQUIRE_THROW(env.execute_cql("SELECT * FROM t").get(), exceptions::unauthorized_exception);
+        });
+    }, cfg);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
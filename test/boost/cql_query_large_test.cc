@@ -27,6 +27,8 @@
 #include "db/config.hh"
 #include "compaction/compaction_manager.hh"
 #include "schema/schema_builder.hh"
+#include "db/large_data_handler.hh"
+#include "sstables/sstables_manager.hh"
 
 BOOST_AUTO_TEST_SUITE(cql_query_large_test)
 
@@ -46,7 +48,10 @@ SEASTAR_TEST_CASE(test_large_row_count) {
 
 static void flush(cql_test_env& e) {
     e.db().invoke_on_all([](replica::database& dbi) {
-        return dbi.flush_all_memtables();
+        return dbi.flush_all_memtables().then([&dbi] {
+            auto& handler = dynamic_cast<db::cql_table_large_data_handler&>(dbi.get_user_sstables_manager().get_large_data_handler());
+            return handler.flush_pending_records();
+        });
     }).get();
 }
 
@@ -143,6 +148,36 @@ SEASTAR_THREAD_TEST_CASE(test_large_data) {
     }, cfg).get();
 }
 
+// The records are inserted in the background, the deletion of the entries
+// of a compacted sstable must not be overtaken by its still queued records.
+SEASTAR_THREAD_TEST_CASE(test_large_data_deleted_before_recorded) {
+    auto cfg = make_shared<db::config>();
+    cfg->compaction_large_row_warning_threshold_mb(1);
+    do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("create table tbl (a int, b text, primary key (a))").get();
+        sstring blob(1024*1024, 'x');
+        e.execute_cql("insert into tbl (a, b) values (44, '" + blob + "');").get();
+        e.db().invoke_on_all([] (replica::database& dbi) {
+            return dbi.flush_all_memtables();
+        }).get();
+        e.execute_cql("delete from tbl where a = 44;").get();
+        e.db().invoke_on_all([] (replica::database& dbi) {
+            return dbi.flush_all_memtables().then([&dbi] {
+                return dbi.get_tables_metadata().parallel_for_each_table([&dbi] (table_id, lw_shared_ptr<replica::table> t) {
+                    return dbi.get_compaction_manager().perform_major_compaction(t->try_get_compaction_group_view_with_static_sharding(), tasks::task_info{});
+                });
+            });
+        }).get();
+        flush(e);
+
+        assert_that(e.execute_cql("select partition_key from system.large_rows where table_name = 'tbl' allow filtering;").get())
+            .is_rows()
+            .is_empty();
+
+        return make_ready_future<>();
+    }, cfg).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_large_row_count_warning) {
     auto cfg = make_shared<db::config>();
     cfg->compaction_rows_count_warning_threshold(10);
@@ -73,6 +73,27 @@ SEASTAR_TEST_CASE(test_like_operator_on_clustering_key) {
     });
 }
 
+SEASTAR_TEST_CASE(test_like_operator_prefix_on_clustering_key) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        for (auto order : {"asc", "desc"}) {
+            cquery_nofail(e, format("create table t_{} (p int, s text, primary key(p, s)) with clustering order by (s {})", order, order));
+            for (auto s : {"ab", "abc", "abd", "ab%", "ac", "a", "Ж", "Жa", "Жб"}) {
+                cquery_nofail(e, format("insert into t_{} (p, s) values (1, '{}')", order, s));
+            }
+            auto query = [&] (const char* pattern) {
+                return format("select s from t_{} where p = 1 and s like '{}' allow filtering", order, pattern);
+            };
+            require_rows(e, query("ab%"), {{T("ab")}, {T("ab%")}, {T("abc")}, {T("abd")}});
+            require_rows(e, query("ab_"), {{T("ab%")}, {T("abc")}, {T("abd")}});
+            require_rows(e, query("ab"), {{T("ab")}});
+            require_rows(e, query("ab\\%"), {{T("ab%")}});
+            require_rows(e, query("a%c"), {{T("abc")}, {T("ac")}});
+            require_rows(e, query("Ж%"), {{T("Ж")}, {T("Жa")}, {T("Жб")}});
+            require_rows(e, query("b%"), {});
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_like_operator_conjunction) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "create table t (s1 text primary key, s2 text)");
@@ -2016,9 +2016,30 @@ SEASTAR_TEST_CASE(test_table_compression) {
         e.execute_cql("create table tb6 (foo text PRIMARY KEY, bar text);").get();
         BOOST_REQUIRE(e.local_db().has_schema("ks", "tb6"));
         BOOST_REQUIRE(e.local_db().find_schema("ks", "tb6")->get_compressor_params().get_algorithm() == compression_parameters::algorithm::lz4);
+
+        e.execute_cql("create table tb7 (foo text PRIMARY KEY, bar text) with compression = { 'sstable_compression' : 'LZ4Compressor', 'chunk_length_in_kb' : 'auto' };").get();
+        auto& cp = e.local_db().find_schema("ks", "tb7")->get_compressor_params();
+        BOOST_REQUIRE(cp.auto_chunk_length());
+        BOOST_REQUIRE_EQUAL(cp.get_options().at(compression_parameters::CHUNK_LENGTH_KB), "auto");
     });
 }
 
+SEASTAR_TEST_CASE(test_pick_compression_chunk_length) {
+    constexpr auto min = compression_parameters::MIN_AUTO_CHUNK_LENGTH;
+    constexpr auto max = compression_parameters::MAX_AUTO_CHUNK_LENGTH;
+    // No reads yet.
+    BOOST_REQUIRE_EQUAL(compression_parameters::pick_chunk_length(0, 0, 100), compression_parameters::DEFAULT_CHUNK_LENGTH);
+    // Point reads of small partitions.
+    BOOST_REQUIRE_EQUAL(compression_parameters::pick_chunk_length(1000, 0, 100), min);
+    // Scans only.
+    BOOST_REQUIRE_EQUAL(compression_parameters::pick_chunk_length(0, 1 << 30, 100), max);
+    // Point reads of partitions spanning several small chunks.
+    BOOST_REQUIRE_EQUAL(compression_parameters::pick_chunk_length(1000, 0, 32 * 1024), 32 * 1024);
+    // Mostly point reads, with a few scans.
+    BOOST_REQUIRE_EQUAL(compression_parameters::pick_chunk_length(100000, 1 << 20, 100), min);
+    return make_ready_future<>();
+}
+
 SEASTAR_TEST_CASE(test_ttl) {
     return do_with_cql_env([] (cql_test_env& e) {
         auto make_my_list_type = [] { return list_type_impl::get_instance(utf8_type, true); };
@@ -4103,6 +4124,120 @@ SEASTAR_TEST_CASE(test_double_sum_overflow) {
     });
 }
 
+SEASTAR_TEST_CASE(test_batched_aggregates_on_wide_partition) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "create table cf (pk int, ck int, i int, b bigint, d double, primary key(pk, ck));");
+        // More rows than fit in one batch, with nulls and with bigints whose
+        // partial sums exceed 64 bits.
+        const int nr_rows = 3000;
+        int64_t count = 0;
+        int32_t i_sum = 0;
+        int32_t i_min = std::numeric_limits<int32_t>::max();
+        int32_t i_max = std::numeric_limits<int32_t>::min();
+        int64_t b_sum = 0;
+        int64_t b_min = std::numeric_limits<int64_t>::max();
+        int64_t b_max = std::numeric_limits<int64_t>::min();
+        double d_sum = 0;
+        for (int ck = 0; ck < nr_rows; ++ck) {
+            if (ck % 7 == 0) {
+                cquery_nofail(e, format("insert into cf (pk, ck) values (0, {});", ck));
+                continue;
+            }
+            int32_t i = ck - nr_rows / 2;
+            int64_t b = (ck % 2 ? int64_t(1) << 62 : -(int64_t(1) << 62)) + i;
+            double d = i * 0.1;
+            cquery_nofail(e, format("insert into cf (pk, ck, i, b, d) values (0, {}, {}, {}, {});", ck, i, b, d));
+            ++count;
+            i_sum += i;
+            i_min = std::min(i_min, i);
+            i_max = std::max(i_max, i);
+            b_sum += b;
+            b_min = std::min(b_min, b);
+            b_max = std::max(b_max, b);
+            d_sum += d;
+        }
+        auto msg = e.execute_cql("select count(*), count(b), sum(i), min(i), max(i), sum(b), min(b), max(b), sum(d) from cf where pk = 0;").get();
+        assert_that(msg).is_rows().with_rows({{
+            long_type->decompose(int64_t(nr_rows)),
+            long_type->decompose(count),
+            int32_type->decompose(i_sum),
+            int32_type->decompose(i_min),
+            int32_type->decompose(i_max),
+            long_type->decompose(b_sum),
+            long_type->decompose(b_min),
+            long_type->decompose(b_max),
+            double_type->decompose(d_sum),
+        }});
+
+        // Empty values are aggregated by the aggregation functions.
+        cquery_nofail(e, format("insert into cf (pk, ck, i) values (0, {}, blobasint(0x));", nr_rows));
+        msg = e.execute_cql("select count(i), max(i) from cf where pk = 0;").get();
+        assert_that(msg).is_rows().with_rows({{
+            long_type->decompose(count + 1),
+            int32_type->decompose(i_max),
+        }});
+    });
+}
+
+SEASTAR_TEST_CASE(test_approximate_aggregates) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "create table cf (pk int, ck int, v int, d double, t text, primary key(pk, ck));");
+        const int nr_partitions = 10;
+        const int nr_rows = 300;
+        const int nr_distinct = 1000;
+        int64_t nr_values_in_pk1 = 0;
+        for (int pk = 0; pk < nr_partitions; ++pk) {
+            for (int ck = 0; ck < nr_rows; ++ck) {
+                int n = pk * nr_rows + ck;
+                if (n % 11 == 0) {
+                    cquery_nofail(e, format("insert into cf (pk, ck) values ({}, {});", pk, ck));
+                    continue;
+                }
+                nr_values_in_pk1 += pk == 1;
+                cquery_nofail(e, format("insert into cf (pk, ck, v, d) values ({}, {}, {}, {});", pk, ck, n % nr_distinct, n));
+            }
+        }
+
+        auto select_row = [&] (sstring query) {
+            auto msg = e.execute_cql(query).get();
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+            BOOST_REQUIRE(rows);
+            auto result_rows = rows->rs().result_set().rows();
+            BOOST_REQUIRE_EQUAL(result_rows.size(), 1);
+            return result_rows[0];
+        };
+        auto as_long = [] (const managed_bytes_opt& v) {
+            BOOST_REQUIRE(v);
+            return value_cast<int64_t>(long_type->deserialize(*v));
+        };
+        auto as_double = [] (const managed_bytes_opt& v) {
+            BOOST_REQUIRE(v);
+            return value_cast<double>(double_type->deserialize(*v));
+        };
+
+        // Over the whole table, so that the parts computed for each range are reduced.
+        auto row = select_row("select approx_count_distinct(pk), approx_count_distinct(v), approx_percentile(d, 0.5), approx_percentile(d, 0.99) from cf;");
+        BOOST_REQUIRE_EQUAL(as_long(row[0]), nr_partitions);
+        BOOST_REQUIRE_LE(std::abs(as_long(row[1]) - nr_distinct), nr_distinct / 20);
+        const double nr_values = nr_partitions * nr_rows;
+        BOOST_REQUIRE_LE(std::abs(as_double(row[2]) - 0.5 * nr_values), nr_values / 50);
+        BOOST_REQUIRE_LE(std::abs(as_double(row[3]) - 0.99 * nr_values), nr_values / 50);
+
+        // Within a partition, batched.
+        row = select_row("select approx_count_distinct(v), approx_percentile(d, 0.5) from cf where pk = 1;");
+        BOOST_REQUIRE_LE(std::abs(as_long(row[0]) - nr_values_in_pk1), nr_values_in_pk1 / 20);
+        BOOST_REQUIRE_LE(std::abs(as_double(row[1]) - 1.5 * nr_rows), nr_rows / 50.0);
+
+        // Nothing to aggregate.
+        row = select_row("select approx_count_distinct(v), approx_percentile(d, 0.5) from cf where pk = 1 and ck = 8;");
+        BOOST_REQUIRE_EQUAL(as_long(row[0]), 0);
+        BOOST_REQUIRE(!row[1]);
+
+        BOOST_REQUIRE_THROW(e.execute_cql("select approx_percentile(d, 1.5) from cf where pk = 1;").get(), exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("select approx_percentile(t, 0.5) from cf;").get(), exceptions::invalid_request_exception);
+    });
+}
+
 SEASTAR_TEST_CASE(test_int_avg) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "create table cf (pk text, val int, primary key(pk));");
@@ -6112,4 +6247,88 @@ SEASTAR_TEST_CASE(test_sstable_load_mixed_generation_type) {
     });
 }
 
+SEASTAR_TEST_CASE(test_query_result_cache) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (p int, c int, v int, PRIMARY KEY (p, c))"
+                " WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL', 'results_ttl_in_ms': '600000'}").get();
+        e.execute_cql("INSERT INTO ks.t (p, c, v) VALUES (1, 1, 1)").get();
+        auto& stats = e.local_db().find_column_family("ks", "t").get_stats();
+        auto id = e.prepare("SELECT v FROM ks.t WHERE p = ? AND c = ?").get();
+        auto select = [&] {
+            return e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(1)), cql3::raw_value::make_value(int32_type->decompose(1))}).get();
+        };
+
+        assert_that(select()).is_rows().with_rows({{int32_type->decompose(1)}});
+        BOOST_REQUIRE_EQUAL(stats.query_result_cache_misses, 1);
+        assert_that(select()).is_rows().with_rows({{int32_type->decompose(1)}});
+        BOOST_REQUIRE_EQUAL(stats.query_result_cache_hits, 1);
+
+        // A write to the partition must not be hidden by the cached result.
+        e.execute_cql("UPDATE ks.t SET v = 2 WHERE p = 1 AND c = 1").get();
+        BOOST_REQUIRE_GE(stats.query_result_cache_invalidations, 1);
+        assert_that(select()).is_rows().with_rows({{int32_type->decompose(2)}});
+        BOOST_REQUIRE_EQUAL(stats.query_result_cache_misses, 2);
+
+        // Results of tables without a results TTL aren't cached.
+        e.execute_cql("ALTER TABLE ks.t WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL'}").get();
+        id = e.prepare("SELECT v FROM ks.t WHERE p = ? AND c = ?").get();
+        assert_that(select()).is_rows().with_rows({{int32_type->decompose(2)}});
+        assert_that(select()).is_rows().with_rows({{int32_type->decompose(2)}});
+        BOOST_REQUIRE_EQUAL(stats.query_result_cache_hits, 1);
+        BOOST_REQUIRE_EQUAL(stats.query_result_cache_misses, 2);
+    });
+}
+
+SEASTAR_TEST_CASE(test_query_result_cache_counter_update) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (p int PRIMARY KEY, c counter)"
+                " WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL', 'results_ttl_in_ms': '600000'}").get();
+        e.execute_cql("UPDATE ks.t SET c = c + 1 WHERE p = 1").get();
+        auto id = e.prepare("SELECT c FROM ks.t WHERE p = ?").get();
+        auto select = [&] {
+            return e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(1))}).get();
+        };
+
+        assert_that(select()).is_rows().with_rows({{long_type->decompose(int64_t(1))}});
+        assert_that(select()).is_rows().with_rows({{long_type->decompose(int64_t(1))}});
+
+        // Counter updates are applied through their own path, which must
+        // invalidate the cached result too.
+        e.execute_cql("UPDATE ks.t SET c = c + 1 WHERE p = 1").get();
+        assert_that(select()).is_rows().with_rows({{long_type->decompose(int64_t(2))}});
+    });
+}
+
+SEASTAR_TEST_CASE(test_latest_row_read_merges_sstables_lazily) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (p int, c int, v text, PRIMARY KEY (p, c)) WITH caching = {'enabled': 'false'}").get();
+        // Rows larger than the reader buffer, so that reading one doesn't
+        // read ahead into the older sstables.
+        const auto v = std::string(16 * 1024, 'x');
+        for (int first : {0, 3, 6}) {
+            for (int c = first; c < first + 3; ++c) {
+                e.execute_cql(format("INSERT INTO ks.t (p, c, v) VALUES (0, {}, '{}')", c, v)).get();
+            }
+            e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        }
+
+        auto sstable_reads = [] {
+            return sstables::sstables_stats::get_shard_stats().single_partition_reads;
+        };
+        auto select_latest = [&] {
+            auto reads = sstable_reads();
+            assert_that(e.execute_cql("SELECT c FROM ks.t WHERE p = 0 ORDER BY c DESC LIMIT 1").get())
+                    .is_rows().with_rows({{int32_type->decompose(8)}});
+            return sstable_reads() - reads;
+        };
+
+        // The row limit of the query makes it read only the sstables with
+        // the latest rows.
+        BOOST_REQUIRE_LT(select_latest(), 3);
+
+        e.db_config().enable_lazy_latest_row_reads.set(false);
+        BOOST_REQUIRE_EQUAL(select_latest(), 3);
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
 #include <fmt/std.h>
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/result_set_assertions.hh"
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
@@ -966,6 +967,52 @@ SEASTAR_TEST_CASE(toppartitions_cross_shard_schema_ptr) {
     });
 }
 
+SEASTAR_TEST_CASE(test_hot_partitions) {
+    cql_test_config cfg;
+    cfg.db_config->hot_partitions_threshold.set(10);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE hot (k int, c int, PRIMARY KEY (k, c));").get();
+        for (int i = 0; i < 50; ++i) {
+            e.execute_cql(format("INSERT INTO hot (k, c) VALUES (1, {});", i)).get();
+            e.execute_cql("SELECT * FROM hot WHERE k = 1;").get();
+        }
+        // Below the threshold.
+        for (int i = 0; i < 5; ++i) {
+            e.execute_cql(format("INSERT INTO hot (k, c) VALUES (2, {});", i)).get();
+            e.execute_cql("SELECT * FROM hot WHERE k = 2;").get();
+        }
+
+        auto id = e.local_db().find_schema("ks", "hot")->id();
+        auto hot_keys = [&] (db::operation_type op) {
+            return e.db().map_reduce0([id, op] (replica::database& db) {
+                auto s = db.find_schema(id);
+                std::map<sstring, unsigned> keys;
+                for (auto& r : db.get_hot_partitions().top(op, 64)) {
+                    if (r.item.table == id) {
+                        keys.emplace(fmt::to_string(r.item.dk.key().with_schema(*s)), r.count);
+                    }
+                }
+                return keys;
+            }, std::map<sstring, unsigned>{}, [] (auto acc, auto keys) {
+                acc.merge(keys);
+                return acc;
+            }).get();
+        };
+
+        for (auto op : {db::operation_type::read, db::operation_type::write}) {
+            auto keys = hot_keys(op);
+            testlog.info("hot partitions for {}: {}", op, keys);
+            BOOST_REQUIRE_EQUAL(keys.size(), 1);
+            BOOST_REQUIRE_EQUAL(keys.begin()->first, "1");
+            // The counts may have been halved once by a decay.
+            BOOST_REQUIRE_GE(keys.begin()->second, 25);
+        }
+
+        auto msg = e.execute_cql("SELECT partition_key FROM system.hot_partitions WHERE table_name = 'hot' ALLOW FILTERING;").get();
+        assert_that(msg).is_rows().with_size(2);
+    }, std::move(cfg));
+}
+
 SEASTAR_THREAD_TEST_CASE(read_max_size) {
     do_with_cql_env_and_compaction_groups([] (cql_test_env& e) {
         e.execute_cql("CREATE TABLE test (pk text, ck int, v text, PRIMARY KEY (pk, ck));").get();
@@ -1857,4 +1904,73 @@ SEASTAR_TEST_CASE(test_max_purgeable_can_purge) {
     return make_ready_future<>();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_table_metrics_top_k) {
+    cql_test_config cfg;
+    cfg.db_config->table_metrics_top_k(2, utils::config_file::config_source::CommandLine);
+
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        for (auto t : {"t1", "t2", "t3"}) {
+            e.execute_cql(format("CREATE TABLE ks.{} (pk int PRIMARY KEY, v int)", t)).get();
+        }
+        auto write = [&] (std::string_view t, int n) {
+            for (int i = 0; i < n; ++i) {
+                e.execute_cql(format("INSERT INTO ks.{} (pk, v) VALUES ({}, 0)", t, i)).get();
+            }
+        };
+        // Checks on all shards, which must agree.
+        auto reported = [&] (std::string_view t) {
+            return e.db().map_reduce0([t = sstring(t)] (replica::database& db) {
+                return db.find_column_family("ks", t).reports_latency_histograms() ? 1u : 0u;
+            }, 0u, std::plus<unsigned>()).get();
+        };
+        auto update = [&] {
+            e.db().invoke_on(0, [] (replica::database& db) {
+                return db.update_table_metrics_top_k(2);
+            }).get();
+        };
+
+        // The histograms aren't registered until the table is picked.
+        for (auto t : {"t1", "t2", "t3"}) {
+            BOOST_REQUIRE_EQUAL(reported(t), 0u);
+        }
+
+        write("t1", 30);
+        write("t2", 20);
+        write("t3", 10);
+        update();
+        BOOST_REQUIRE_EQUAL(reported("t1"), smp::count);
+        BOOST_REQUIRE_EQUAL(reported("t2"), smp::count);
+        BOOST_REQUIRE_EQUAL(reported("t3"), 0u);
+
+        // Only the activity since the previous round counts, and the
+        // histograms of the tables which fell out of the top are dropped.
+        write("t3", 50);
+        write("t1", 1);
+        update();
+        BOOST_REQUIRE_EQUAL(reported("t1"), smp::count);
+        BOOST_REQUIRE_EQUAL(reported("t2"), 0u);
+        BOOST_REQUIRE_EQUAL(reported("t3"), smp::count);
+
+        // A table is registered again once it's back in the top.
+        write("t2", 10);
+        update();
+        BOOST_REQUIRE_EQUAL(reported("t1"), 0u);
+        BOOST_REQUIRE_EQUAL(reported("t2"), smp::count);
+        BOOST_REQUIRE_EQUAL(reported("t3"), 0u);
+    }, std::move(cfg)).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_latency_histograms_reported_without_top_k) {
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int PRIMARY KEY, v int)").get();
+        auto& t = e.local_db().find_column_family("ks", "t");
+        BOOST_REQUIRE(t.reports_latency_histograms());
+
+        t.report_latency_histograms(false);
+        BOOST_REQUIRE(!t.reports_latency_histograms());
+        t.report_latency_histograms(true);
+        BOOST_REQUIRE(t.reports_latency_histograms());
+    }).get();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
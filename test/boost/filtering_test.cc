@@ -1073,6 +1073,46 @@ SEASTAR_TEST_CASE(test_filtering_on_empty_partition_with_a_static_row) {
     });
 }
 
+SEASTAR_TEST_CASE(test_filtering_with_replica_side_row_filter) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (p int, c int, s int static, v int, w text, PRIMARY KEY(p, c));");
+        for (int p = 0; p < 4; ++p) {
+            cquery_nofail(e, format("INSERT INTO t (p, s) VALUES ({}, {});", p, p));
+            for (int c = 0; c < 100; ++c) {
+                cquery_nofail(e, format("INSERT INTO t (p, c, v, w) VALUES ({}, {}, {}, '{}');", p, c, c % 10, c));
+            }
+        }
+        cquery_nofail(e, "UPDATE t SET v = 100 WHERE p = 3 AND c > 10;");
+
+        // Partitions whose rows all fail the filter must not turn into static-only partitions.
+        auto msg = cquery_nofail(e, "SELECT * FROM t WHERE v = 50 ALLOW FILTERING;");
+        assert_that(msg).is_rows().is_empty();
+
+        // Internally paged, with pages mostly made of rows dropped by replicas.
+        msg = cquery_nofail(e, "SELECT count(*) FROM t WHERE v = 7 ALLOW FILTERING;");
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(31))}});
+
+        msg = cquery_nofail(e, "SELECT count(*) FROM t WHERE v IN (1, 2) AND c < 50 ALLOW FILTERING;");
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(32))}});
+
+        msg = cquery_nofail(e, "SELECT count(*) FROM t WHERE v >= 8 AND v < 100 AND w = '58' ALLOW FILTERING;");
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(3))}});
+
+        for (int page_size : {1, 3, 100}) {
+            auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                    cql3::query_options::specific_options{page_size, nullptr, {}, api::new_timestamp()});
+            msg = cquery_nofail(e, "SELECT p, c, s FROM t WHERE p = 3 AND v < 100 ALLOW FILTERING;", std::move(qo));
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+            BOOST_REQUIRE(rows);
+            std::vector<std::vector<bytes_opt>> expected;
+            for (int c = 0; c <= 10 && c < page_size; ++c) {
+                expected.push_back({int32_type->decompose(3), int32_type->decompose(c), int32_type->decompose(3)});
+            }
+            assert_that(msg).is_rows().with_rows(expected);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_filtering) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("CREATE TABLE cf (k int, v int,m int,n int,o int,p int static, PRIMARY KEY ((k,v),m,n));").get();
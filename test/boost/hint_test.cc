@@ -18,6 +18,7 @@
 #include "idl/hinted_handoff.dist.impl.hh"
 
 #include "db/hints/sync_point.hh"
+#include "db/hints/internal/replay_rate_limiter.hh"
 
 enum class encode_version {
     v1,
@@ -247,3 +248,38 @@ SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization_v2) {
 SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization_v1) {
     return test_decode_v1_or_v2(encode_version::v1);
 };
+
+BOOST_AUTO_TEST_CASE(test_hint_replay_rate_limiter) {
+    using namespace std::chrono_literals;
+    using db::hints::internal::replay_rate_limiter;
+    using clock = replay_rate_limiter::clock;
+
+    replay_rate_limiter rl;
+    auto now = clock::now();
+
+    // Unlimited rate never delays.
+    BOOST_REQUIRE(rl.reserve(100'000'000, 0, now) == clock::duration::zero());
+
+    // The bucket starts full, with one second worth of the rate.
+    BOOST_REQUIRE(rl.reserve(600, 1000, now) == clock::duration::zero());
+    BOOST_REQUIRE(rl.reserve(400, 1000, now) == clock::duration::zero());
+    // It's empty now, so the next 500 bytes have to wait for half a second.
+    auto d = rl.reserve(500, 1000, now);
+    BOOST_REQUIRE(d > 450ms && d < 550ms);
+    // After the debt is paid off and another 100ms pass, there is room for 100 bytes.
+    now += 600ms;
+    BOOST_REQUIRE(rl.reserve(100, 1000, now) == clock::duration::zero());
+    d = rl.reserve(100, 1000, now);
+    BOOST_REQUIRE(d > 50ms && d < 150ms);
+
+    // A hint bigger than the capacity is let through once the bucket refills.
+    replay_rate_limiter big;
+    BOOST_REQUIRE(big.reserve(5000, 1000, now) == clock::duration::zero());
+    d = big.reserve(5000, 1000, now);
+    BOOST_REQUIRE(d > 4500ms && d < 5500ms);
+
+    BOOST_REQUIRE_EQUAL(db::hints::internal::replay_rate_for_backlog(1600, 0), 1600);
+    BOOST_REQUIRE_EQUAL(db::hints::internal::replay_rate_for_backlog(1600, 0.5), 800);
+    BOOST_REQUIRE_EQUAL(db::hints::internal::replay_rate_for_backlog(1600, 1), 100);
+    BOOST_REQUIRE_EQUAL(db::hints::internal::replay_rate_for_backlog(1600, 3), 100);
+}
@@ -22,6 +22,7 @@
 #include "test/lib/test_utils.hh"
 #include "bytes.hh"
 #include "bytes_ostream.hh"
+#include "gc_clock.hh"
 
 struct simple_compound {
     // TODO: change this to test for #905
@@ -484,3 +485,35 @@ BOOST_AUTO_TEST_CASE(test_const_template_arg)
     auto deser_obj = ser::deserialize(in, std::type_identity<const_template_arg_test_object>());
     BOOST_REQUIRE(obj == deser_obj);
 }
+
+static_assert(ser::fixed_serialized_size_v<uint32_t> == 4);
+static_assert(ser::fixed_serialized_size_v<utils::UUID> == 16);
+static_assert(ser::fixed_serialized_size_v<gc_clock::time_point> == 8);
+static_assert(ser::fixed_serialized_size_v<gc_clock::duration> == 0);
+static_assert(ser::fixed_serialized_size_v<simple_compound> == 0);
+static_assert(ser::fixed_serialized_size_v<bytes> == 0);
+
+BOOST_AUTO_TEST_CASE(test_skip_all)
+{
+    // Large enough for the buffer to be fragmented.
+    for (size_t value_size : {10, 300000}) {
+        bytes_ostream buf;
+        ser::serialize(buf, uint32_t(1));
+        ser::serialize(buf, utils::UUID(2, 3));
+        ser::serialize(buf, bytes(value_size, 'x'));
+        ser::serialize(buf, int64_t(4));
+        ser::serialize(buf, uint8_t(5));
+        ser::serialize(buf, int64_t(6));
+
+        auto check = [value_size] (auto in) {
+            auto in2 = in;
+            ser::skip_all<uint32_t, utils::UUID>(in2);
+            BOOST_REQUIRE_EQUAL(ser::deserialize(in2, std::type_identity<bytes>()).size(), value_size);
+            ser::skip_all<uint32_t, utils::UUID, bytes, int64_t, uint8_t>(in);
+            BOOST_REQUIRE_EQUAL(ser::deserialize(in, std::type_identity<int64_t>()), 6);
+            BOOST_REQUIRE_EQUAL(in.size(), 0);
+        };
+        check(ser::as_input_stream(buf));
+        check(ser::as_input_stream(buf.linearize()));
+    }
+}
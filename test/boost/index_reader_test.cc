@@ -11,6 +11,7 @@
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_test_env.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/key_utils.hh"
 #include "test/lib/make_random_string.hh"
 
 #include "readers/from_mutations.hh"
@@ -251,3 +252,111 @@ SEASTAR_TEST_CASE(test_no_data_file_read_on_missing_clustering_keys_with_dense_i
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_index_page_read_ahead) {
+    return test_env::do_with_async([](test_env& env) {
+        auto s = schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("v", int32_type)
+            .set_min_index_interval(4)
+            .build();
+
+        const int nr_partitions = 256;
+        auto pks = tests::generate_partition_keys(nr_partitions, s);
+        utils::chunked_vector<mutation> muts;
+        for (auto& pk : pks) {
+            mutation m(s, pk);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("v"), data_value(int32_t(1)), 1);
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(s, env.make_reader_permit(), std::move(muts)),
+                env.manager().configure_writer());
+        BOOST_REQUIRE_GT(sst->get_summary().header.size, 8);
+
+        auto& stats = env.manager().get_cache_tracker().get_partition_index_cache_stats();
+        auto permit = env.make_reader_permit();
+
+        // Point reads don't read ahead.
+        auto read_aheads = stats.read_aheads;
+        for (int i = 0; i < nr_partitions; i += 16) {
+            auto index = std::make_unique<index_reader>(sst, permit, nullptr, use_caching::no, true);
+            auto close_index = deferred_close(*index);
+            index->advance_to(dht::partition_range::make_singular(pks[i])).get();
+            BOOST_REQUIRE(!index->eof());
+        }
+        BOOST_REQUIRE_EQUAL(stats.read_aheads, read_aheads);
+
+        // Sequential scans do, and see every partition.
+        auto index = std::make_unique<index_reader>(sst, permit, nullptr, use_caching::no);
+        auto close_index = deferred_close(*index);
+        index->read_partition_data().get();
+        int nr_seen = 0;
+        while (!index->eof()) {
+            ++nr_seen;
+            index->advance_to_next_partition().get();
+        }
+        BOOST_REQUIRE_EQUAL(nr_seen, nr_partitions);
+        BOOST_REQUIRE_GT(stats.read_aheads, read_aheads);
+
+        // Read-ahead stops at the end of the range.
+        read_aheads = stats.read_aheads;
+        auto range = dht::partition_range::make({pks[0]}, {pks[nr_partitions / 4]});
+        auto ranged_index = std::make_unique<index_reader>(sst, permit, nullptr, use_caching::no);
+        auto close_ranged_index = deferred_close(*ranged_index);
+        ranged_index->advance_to(range).get();
+        auto end = ranged_index->data_file_positions().end;
+        BOOST_REQUIRE(end);
+        while (ranged_index->data_file_positions().start < *end) {
+            ranged_index->advance_to_next_partition().get();
+        }
+        BOOST_REQUIRE_LE(stats.read_aheads - read_aheads, sst->get_summary().header.size / 4 + 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_bti_partition_index) {
+    return test_env::do_with_async([](test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        // Every other key is written, the rest are used as absent keys.
+        const int nr_partitions = 1000;
+        auto pks = tests::generate_partition_keys(2 * nr_partitions, s);
+        std::vector<dht::decorated_key> present, absent;
+        utils::chunked_vector<mutation> muts;
+        for (int i = 0; i < 2 * nr_partitions; ++i) {
+            if (i % 2) {
+                absent.push_back(pks[i]);
+                continue;
+            }
+            present.push_back(pks[i]);
+            mutation m(s, pks[i]);
+            ss.add_row(m, ss.make_ckey(0), "v");
+            muts.push_back(std::move(m));
+        }
+        auto cfg = env.manager().configure_writer();
+        cfg.write_bti_partition_index = true;
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(s, env.make_reader_permit(), std::move(muts)), cfg);
+        BOOST_REQUIRE(sst->has_component(component_type::PartitionTrie));
+        BOOST_REQUIRE(sst->has_bti_partition_index());
+
+        auto permit = env.make_reader_permit();
+        for (auto& pk : present) {
+            auto pos = sst->bti_partition_position(pk).get();
+            BOOST_REQUIRE(pos);
+            auto index = std::make_unique<index_reader>(sst, permit, nullptr, use_caching::no, true);
+            auto close_index = deferred_close(*index);
+            BOOST_REQUIRE(index->advance_lower_and_check_if_present(pk).get());
+            BOOST_REQUIRE_EQUAL(*pos, index->data_file_positions().start);
+        }
+
+        int nr_rejected = 0;
+        for (auto& pk : absent) {
+            nr_rejected += !sst->bti_partition_position(pk).get();
+            auto index = std::make_unique<index_reader>(sst, permit, nullptr, use_caching::no, true);
+            auto close_index = deferred_close(*index);
+            BOOST_REQUIRE(!index->advance_lower_and_check_if_present(pk).get());
+        }
+        // Absent keys pass only if they share the stored prefix and the token byte of a present one.
+        BOOST_REQUIRE_GT(nr_rejected, nr_partitions * 9 / 10);
+    });
+}
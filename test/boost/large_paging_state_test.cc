@@ -11,10 +11,14 @@
 #include <boost/test/unit_test.hpp>
 #undef SEASTAR_TESTING_MAIN
 #include <seastar/testing/test_case.hh>
+#include <seastar/util/defer.hh>
 
 #include "test/lib/cql_test_env.hh"
 #include "transport/messages/result_message.hh"
 #include "types/types.hh"
+#include "cql3/query_processor.hh"
+#include "service/query_state.hh"
+#include "utils/error_injection.hh"
 
 BOOST_AUTO_TEST_SUITE(large_paging_state_test)
 
@@ -118,4 +122,85 @@ SEASTAR_TEST_CASE(test_use_high_bits_of_remaining_rows_in_paging_state_filtering
     });
 }
 
+// Executes the query as a client which enabled the SCYLLA_ADAPTIVE_PAGING extension.
+static ::shared_ptr<cql_transport::messages::result_message> execute_with_adaptive_paging(cql_test_env& e, std::string_view query,
+        int32_t page_size, lw_shared_ptr<service::pager::paging_state> paging_state) {
+    auto& cs = e.local_client_state();
+    cql_transport::cql_protocol_extension_enum_set exts;
+    exts.set(cql_transport::cql_protocol_extension::ADAPTIVE_PAGING);
+    cs.set_protocol_extensions(std::move(exts));
+    service::query_state qs(cs, empty_service_permit());
+    cql3::query_options qo(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+            cql3::query_options::specific_options{page_size, std::move(paging_state), {}, api::new_timestamp()});
+    return e.local_qp().execute_direct(query, qs, cql3::dialect{}, qo).get();
+}
+
+// Clients using adaptive paging leave the size of pages to the server, so the
+// page size they request doesn't limit the number of rows of a page.
+SEASTAR_TEST_CASE(test_adaptive_paging_ignores_page_size) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE test (pk int, ck int, PRIMARY KEY (pk, ck));").get();
+        auto id = e.prepare("INSERT INTO test (pk, ck) VALUES (?, ?);").get();
+        const auto cql3_pk = cql3::raw_value::make_value(int32_type->decompose(data_value(0)));
+        for (int i = 0; i < 50; i++) {
+            const auto cql3_ck = cql3::raw_value::make_value(int32_type->decompose(data_value(i)));
+            e.execute_prepared(id, {cql3_pk, cql3_ck}).get();
+        }
+
+        for (auto query : {"SELECT * FROM ks.test", "SELECT * FROM ks.test WHERE pk = 0", "SELECT * FROM ks.test WHERE ck >= 0 ALLOW FILTERING"}) {
+            auto msg = execute_with_adaptive_paging(e, query, 5, nullptr);
+            BOOST_REQUIRE_EQUAL(count_rows_fetched(msg), 50);
+            BOOST_REQUIRE(!has_more_pages(msg));
+        }
+
+        // Clients not using the extension still get the page size they asked for.
+        auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                    cql3::query_options::specific_options{5, nullptr, {}, api::new_timestamp()});
+        auto msg = e.execute_cql("SELECT * FROM test;", std::move(qo)).get();
+        BOOST_REQUIRE_EQUAL(count_rows_fetched(msg), 5);
+        BOOST_REQUIRE(has_more_pages(msg));
+    });
+}
+
+// A range scan which passed the deadline of its page returns the rows it has
+// as a short page, and the following pages resume from where it stopped.
+SEASTAR_TEST_CASE(test_adaptive_paging_cuts_range_scans_at_the_deadline) {
+#ifndef SCYLLA_ENABLE_ERROR_INJECTION
+    fmt::print("Skipping test as it depends on error injection. Please run in mode where it's enabled (debug,dev).\n");
+    return make_ready_future<>();
+#endif
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE test (pk int, ck int, PRIMARY KEY (pk, ck));").get();
+        auto id = e.prepare("INSERT INTO test (pk, ck) VALUES (?, ?);").get();
+        const auto cql3_ck = cql3::raw_value::make_value(int32_type->decompose(data_value(0)));
+        const int partitions = 100;
+        for (int i = 0; i < partitions; i++) {
+            const auto cql3_pk = cql3::raw_value::make_value(int32_type->decompose(data_value(i)));
+            e.execute_prepared(id, {cql3_pk, cql3_ck}).get();
+        }
+
+        utils::get_local_injector().enable("storage_proxy_page_deadline_passed");
+        auto disable = defer([] { utils::get_local_injector().disable("storage_proxy_page_deadline_passed"); });
+
+        std::set<int32_t> seen;
+        lw_shared_ptr<service::pager::paging_state> paging_state;
+        size_t pages = 0;
+        ::shared_ptr<cql_transport::messages::result_message> msg;
+        do {
+            msg = execute_with_adaptive_paging(e, "SELECT pk FROM ks.test", 1000, paging_state);
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+            for (auto& row : rows->rs().result_set().rows()) {
+                auto pk = value_cast<int32_t>(int32_type->deserialize(*row[0]));
+                BOOST_REQUIRE(seen.insert(pk).second);
+            }
+            ++pages;
+            paging_state = extract_paging_state(msg);
+        } while (has_more_pages(msg));
+
+        // Every page stops at the first round of range reads which found rows.
+        BOOST_REQUIRE_GT(pages, 1);
+        BOOST_REQUIRE_EQUAL(seen.size(), partitions);
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
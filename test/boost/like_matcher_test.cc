@@ -443,3 +443,40 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_percent_both_ends) {
+    auto m = matcher(u8"%жёл%");
+    BOOST_TEST(matches(m, u8"жёл"));
+    BOOST_TEST(matches(m, u8"жёлтый"));
+    BOOST_TEST(matches(m, u8"pale жёлтый"));
+    BOOST_TEST(!matches(m, u8"жел"));
+    BOOST_TEST(!matches(m, u8"жё"));
+    BOOST_TEST(!matches(m, u8""));
+
+    BOOST_TEST(matches(matcher(u8"%%a\\%%%"), u8"ba%c"));
+    BOOST_TEST(!matches(matcher(u8"%%a\\%%%"), u8"bac"));
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_between_literal_and_wildcards) {
+    auto m = matcher(u8"%alpha%");
+    BOOST_TEST(matches(m, u8"alphabet"));
+    m.reset(bytes(reinterpret_cast<const char*>(u8"%al_ha%")));
+    BOOST_TEST(matches(m, u8"alohabet"));
+    BOOST_TEST(!matches(m, u8"alpbet"));
+    m.reset(bytes(reinterpret_cast<const char*>(u8"alpha%")));
+    BOOST_TEST(matches(m, u8"alphabet"));
+    BOOST_TEST(!matches(m, u8"alohabet"));
+}
+
+BOOST_AUTO_TEST_CASE(test_literal_prefix) {
+    auto prefix = [] (const char8_t* pattern) {
+        return like_matcher::literal_prefix(bytes(reinterpret_cast<const char*>(pattern)));
+    };
+    auto b = [] (const char8_t* s) { return bytes(reinterpret_cast<const char*>(s)); };
+    BOOST_CHECK(prefix(u8"abc") == b(u8"abc"));
+    BOOST_CHECK(prefix(u8"abc%") == b(u8"abc"));
+    BOOST_CHECK(prefix(u8"ab_c") == b(u8"ab"));
+    BOOST_CHECK(prefix(u8"%abc") == b(u8""));
+    BOOST_CHECK(prefix(u8"Шa\\%b%") == b(u8"Шa%b"));
+    BOOST_CHECK(prefix(u8"a\\\\b\\") == b(u8"a\\b"));
+}
@@ -0,0 +1,23 @@
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+
+#include "utils/logalloc.hh"
+#include "test/lib/scylla_test_case.hh"
+
+using namespace logalloc;
+
+SEASTAR_TEST_CASE(test_preinit) {
+    return use_hugepage_arena_segment_pool_backend();
+}
+
+#include "./logalloc_test.cc"
+
+#else
+
+#include <iostream>
+
+int main() {
+    std::cout << "this test is for release mode only" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#define BOOST_TEST_MODULE loser_tree
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "utils/loser_tree.hh"
+
+namespace {
+
+struct stream_value {
+    int value;
+    size_t stream;
+};
+
+struct stream_value_less {
+    bool operator()(const stream_value& a, const stream_value& b) const {
+        return a.value < b.value;
+    }
+};
+
+// Merges sorted streams with a loser tree, the way a k-way merge uses it.
+std::vector<int> merge(const std::vector<std::vector<int>>& streams) {
+    utils::loser_tree<stream_value, stream_value_less> tree;
+    std::vector<size_t> next(streams.size(), 0);
+    std::vector<stream_value> heads;
+    for (size_t i = 0; i < streams.size(); ++i) {
+        if (!streams[i].empty()) {
+            heads.push_back({streams[i][next[i]++], i});
+        }
+    }
+    tree.assign(heads);
+
+    std::vector<int> merged;
+    while (!tree.empty()) {
+        auto [value, stream] = tree.top();
+        merged.push_back(value);
+        if (next[stream] < streams[stream].size()) {
+            tree.replace_top({streams[stream][next[stream]++], stream});
+        } else {
+            tree.pop_top();
+        }
+    }
+    return merged;
+}
+
+std::vector<int> sorted_concatenation(const std::vector<std::vector<int>>& streams) {
+    std::vector<int> all;
+    for (auto& s : streams) {
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    std::ranges::sort(all);
+    return all;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(test_empty) {
+    utils::loser_tree<stream_value, stream_value_less> tree;
+    BOOST_REQUIRE(tree.empty());
+    tree.assign(std::vector<stream_value>{});
+    BOOST_REQUIRE(tree.empty());
+    BOOST_REQUIRE_EQUAL(tree.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_random_streams) {
+    std::mt19937 rnd(1234);
+    for (size_t k : {1, 2, 3, 5, 8, 13, 64}) {
+        std::vector<std::vector<int>> streams(k);
+        for (auto& s : streams) {
+            s.resize(std::uniform_int_distribution<size_t>(0, 50)(rnd));
+            for (auto& v : s) {
+                v = std::uniform_int_distribution<int>(0, 100)(rnd);
+            }
+            std::ranges::sort(s);
+        }
+        BOOST_REQUIRE(merge(streams) == sorted_concatenation(streams));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_with_dominating_stream) {
+    // One stream wins long runs, which makes the tree skip replays while
+    // the winner stays below the runner-up.
+    for (size_t k : {2, 4, 7, 16}) {
+        std::vector<std::vector<int>> streams(k);
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 100 == 0) {
+                streams[(i / 100) % k].push_back(i);
+            } else {
+                streams[0].push_back(i);
+            }
+        }
+        BOOST_REQUIRE(merge(streams) == sorted_concatenation(streams));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_and_clear) {
+    utils::loser_tree<stream_value, stream_value_less> tree;
+    tree.assign(std::vector<stream_value>{{3, 0}, {1, 1}, {2, 2}});
+    BOOST_REQUIRE_EQUAL(tree.top().value, 1);
+    tree.pop_top();
+    BOOST_REQUIRE_EQUAL(tree.size(), 2);
+
+    std::vector<int> values;
+    tree.for_each([&] (stream_value& v) { values.push_back(v.value); });
+    std::ranges::sort(values);
+    BOOST_REQUIRE(values == std::vector<int>({2, 3}));
+
+    tree.clear();
+    BOOST_REQUIRE(tree.empty());
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include "service/maintenance_shares_controller.hh"
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_maintenance_next_shares) {
+    using controller = service::maintenance_shares_controller;
+
+    // No SLO: the configured shares
+    BOOST_REQUIRE_EQUAL(controller::next_shares(50, 200, 10, 100000us, 0ms), 200);
+
+    // Above the SLO: halved, but not below the minimum
+    BOOST_REQUIRE_EQUAL(controller::next_shares(200, 200, 10, 20000us, 10ms), 100);
+    BOOST_REQUIRE_EQUAL(controller::next_shares(16, 200, 10, 20000us, 10ms), 10);
+
+    // Within the SLO: grow back by a tenth of the configured shares, up to them
+    BOOST_REQUIRE_EQUAL(controller::next_shares(100, 200, 10, 5000us, 10ms), 120);
+    BOOST_REQUIRE_EQUAL(controller::next_shares(190, 200, 10, 5000us, 10ms), 200);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_maintenance_shares_follow_foreground_latency) {
+    auto sg = create_scheduling_group("test_maintenance", 200).get();
+    auto destroy_sg = defer([sg] { destroy_scheduling_group(sg).get(); });
+
+    auto shares = utils::updateable_value_source<uint32_t>(200);
+    auto slo = utils::updateable_value_source<uint32_t>(10);
+    auto p99 = 20000us;
+
+    service::maintenance_shares_controller controller(sg, {
+        .shares = utils::updateable_value<uint32_t>(shares),
+        .latency_slo_ms = utils::updateable_value<uint32_t>(slo),
+        // Only adjust when the test asks to
+        .period = std::chrono::hours(1),
+    }, [&p99] { return make_ready_future<std::chrono::microseconds>(p99); });
+    auto stop_controller = defer([&controller] { controller.stop().get(); });
+
+    BOOST_REQUIRE_EQUAL(controller.shares(), 200);
+
+    controller.adjust().get();
+    BOOST_REQUIRE_EQUAL(controller.shares(), 100);
+    controller.adjust().get();
+    BOOST_REQUIRE_EQUAL(controller.shares(), 50);
+
+    p99 = 1000us;
+    controller.adjust().get();
+    BOOST_REQUIRE_EQUAL(controller.shares(), 70);
+
+    // Lowering the configured shares takes effect immediately
+    shares.set(40);
+    BOOST_REQUIRE_EQUAL(controller.shares(), 40);
+
+    // Without an SLO, the configured shares are used as they are
+    slo.set(0);
+    p99 = 20000us;
+    controller.adjust().get();
+    BOOST_REQUIRE_EQUAL(controller.shares(), 40);
+}
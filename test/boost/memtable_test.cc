@@ -494,6 +494,48 @@ SEASTAR_TEST_CASE(test_fast_forward_to_after_memtable_is_flushed) {
     });
 }
 
+// The partition filter grows as partitions are added, and must never rule
+// out a partition which is in the memtable.
+SEASTAR_TEST_CASE(test_single_partition_reads_skip_by_partition_filter) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("col", bytes_type, column_kind::regular_column)
+            .build();
+
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        replica::table_stats tbl_stats;
+        replica::memtable_table_shared_data table_shared_data;
+        replica::dirty_memory_manager mgr;
+        auto mt = make_lw_shared<replica::memtable>(s, mgr, table_shared_data, tbl_stats);
+
+        auto read = [&] (const mutation& m) {
+            return assert_that(mt->make_mutation_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(m.decorated_key()),
+                    s->full_slice(), nullptr, streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+        };
+
+        utils::chunked_vector<mutation> ring = make_ring(s, 2000);
+        for (auto& m : ring) {
+            set_column(m, "col");
+            mt->apply(m);
+        }
+        for (auto& m : ring) {
+            BOOST_REQUIRE(mt->contains_partition(m.decorated_key()));
+            read(m).produces(m).produces_end_of_stream();
+        }
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_skipped_probes, 0);
+
+        const auto absent = make_ring(s, 1000);
+        for (auto& m : absent) {
+            read(m).produces_end_of_stream();
+        }
+        // About an eighth of the bits are set, so most absent partitions are
+        // ruled out.
+        testlog.info("Skipped {} out of {} probes", tbl_stats.memtable_skipped_probes, absent.size());
+        BOOST_REQUIRE_GT(size_t(tbl_stats.memtable_skipped_probes), absent.size() / 2);
+    });
+}
+
 SEASTAR_TEST_CASE(test_exception_safety_of_partition_range_reads) {
     return seastar::async([] {
         random_mutation_generator gen(random_mutation_generator::generate_counters::no);
@@ -661,6 +703,64 @@ SEASTAR_THREAD_TEST_CASE(test_tombstone_merging_with_multiple_versions) {
         .produces(m1 + m2 + m3);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_covered_range_tombstones_in_multiple_versions) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    simple_schema ss;
+    auto s = ss.schema();
+    auto mt = make_lw_shared<replica::memtable>(ss.schema());
+
+    auto pk = ss.make_pkey(0);
+    auto pr = dht::partition_range::make_singular(pk);
+
+    auto t1 = ss.new_tombstone();
+    auto t2 = ss.new_tombstone();
+
+    // Fill so that rd1 stays in the partition snapshot
+    mutation m1(s, pk);
+    int n_rows = 1000;
+    auto v = make_random_string(512);
+    for (int i = 0; i < n_rows; ++i) {
+        ss.add_row(m1, ss.make_ckey(n_rows + i), v);
+    }
+
+    // More range tombstones than the reader coalesces at once.
+    mutation m2(s, pk);
+    for (int i = 0; i < 300; ++i) {
+        ss.delete_range(m2, query::clustering_range::make(ss.make_ckey(i * 3), ss.make_ckey(i * 3 + 1)), t1);
+    }
+
+    mutation m3(s, pk);
+    ss.delete_range(m3, query::clustering_range::make(ss.make_ckey(1), ss.make_ckey(n_rows - 2)), t2);
+
+    mt->apply(m1);
+    mt->apply(m2);
+
+    auto rd1 = mt->make_mutation_reader(s, semaphore.make_permit(), pr, s->full_slice(),
+                                    nullptr, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+    auto close_rd1 = defer([&] { rd1.close().get(); });
+
+    rd1.fill_buffer().get();
+    BOOST_REQUIRE(!rd1.is_end_of_stream()); // rd1 must keep the m2 version alive
+
+    mt->apply(m3);
+
+    assert_that(mt->make_mutation_reader(s, semaphore.make_permit(), pr))
+        .has_monotonic_positions();
+
+    assert_that(mt->make_mutation_reader(s, semaphore.make_permit(), pr))
+        .produces(m1 + m2 + m3);
+
+    // The bounds of the range tombstones covered by t2 don't show up.
+    auto rd = mt->make_mutation_reader(s, semaphore.make_permit(), pr);
+    auto close_rd = deferred_close(rd);
+    unsigned changes = 0;
+    while (auto mf = rd().get()) {
+        changes += mf->is_range_tombstone_change();
+    }
+    // t1 from 0, t2 from 1 and the end of t2.
+    BOOST_REQUIRE_EQUAL(changes, 3);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tombstone_merging_with_mvcc_and_preemption) {
     tests::reader_concurrency_semaphore_wrapper semaphore;
     simple_schema ss;
@@ -1602,4 +1702,69 @@ SEASTAR_TEST_CASE(memtable_reader_after_tablet_migration) {
     }, cfg);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_memtable_interns_cell_values) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto make_schema = [] (bool intern_values) {
+        return schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("v", utf8_type)
+            .set_caching_options(caching_options::from_map({{"intern_values", intern_values ? "true" : "false"}}))
+            .build();
+    };
+    auto memory_used = [&] (schema_ptr s) {
+        auto& v = *s->get_column_definition("v");
+        std::vector<mutation> muts;
+        for (int p = 0; p < 2; ++p) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(p)));
+            for (int i = 0; i < 100; ++i) {
+                m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(i)), v,
+                        atomic_cell::make_live(*utf8_type, i, utf8_type->decompose(sstring(i % 2 ? "a status which repeats" : "another status which repeats"))));
+            }
+            muts.push_back(std::move(m));
+        }
+        std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+
+        auto mt = make_lw_shared<replica::memtable>(s);
+        // Both the copying and the deserializing paths.
+        mt->apply(muts[0]);
+        mt->apply(freeze(muts[1]), s);
+        assert_that(mt->make_mutation_reader(s, semaphore.make_permit()))
+            .produces(muts[0])
+            .produces(muts[1])
+            .produces_end_of_stream();
+        return mt->occupancy().used_space();
+    };
+    BOOST_REQUIRE_LT(memory_used(make_schema(true)), memory_used(make_schema(false)));
+}
+
+// The frozen path moves the deserialized partition into the memtable
+// instead of copying it, check it ends up with the same contents.
+SEASTAR_THREAD_TEST_CASE(test_apply_frozen_mutation_matches_apply_mutation) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+    auto s = gen.schema();
+
+    for (int i = 0; i < 10; ++i) {
+        auto m1 = gen();
+        // Applied over the same partition, to merge with an existing entry.
+        auto m2 = mutation(s, m1.decorated_key(), gen().partition());
+
+        auto mt_frozen = make_lw_shared<replica::memtable>(s);
+        mt_frozen->apply(freeze(m1), s);
+        mt_frozen->apply(freeze(m2), s);
+
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m1);
+        mt->apply(m2);
+
+        assert_that(mt_frozen->make_mutation_reader(s, semaphore.make_permit()))
+            .produces(m1 + m2)
+            .produces_end_of_stream();
+        assert_that(mt->make_mutation_reader(s, semaphore.make_permit()))
+            .produces(m1 + m2)
+            .produces_end_of_stream();
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
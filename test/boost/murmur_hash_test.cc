@@ -109,3 +109,37 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_multi_key_hash_output) {
+    // Keys of different lengths, so that lanes of a group run out of common
+    // blocks at different points, in both orders.
+    std::vector<bytes_view> keys;
+    for (size_t i = 0; i < full_sequence.size(); ++i) {
+        keys.emplace_back(full_sequence.begin(), i);
+    }
+    for (size_t i = full_sequence.size(); i > 0; --i) {
+        keys.emplace_back(full_sequence.begin(), i - 1);
+    }
+    std::vector<std::array<uint64_t, 2>> results(keys.size());
+    utils::murmur_hash::hash3_x64_128(keys, seed, results);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        BOOST_REQUIRE(results[i] == prefix_hashes[keys[i].size()]);
+    }
+
+    // Bytes with the high bit set are sign-extended in the tail, like in Cassandra.
+    bytes high(bytes::initialized_later(), 40);
+    for (size_t i = 0; i < high.size(); ++i) {
+        high[i] = int8_t(0x80 + i * 3);
+    }
+    keys.clear();
+    for (size_t i = 0; i <= high.size(); ++i) {
+        keys.emplace_back(high.begin() + i, high.size() - i);
+    }
+    results.resize(keys.size());
+    utils::murmur_hash::hash3_x64_128(keys, seed, results);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::array<uint64_t, 2> expected;
+        utils::murmur_hash::hash3_x64_128(keys[i], seed, expected);
+        BOOST_REQUIRE(results[i] == expected);
+    }
+}
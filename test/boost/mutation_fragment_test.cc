@@ -644,6 +644,55 @@ SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_mixed_api_usage
     BOOST_REQUIRE(!validator(dk0));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_clustering_key_fingerprint) {
+    using mf_kind = mutation_fragment_v2::kind;
+
+    // The positions are compared by a prefix of the first clustering key
+    // component before the full keys, check that the validator orders the
+    // keys the same way as the full comparison does, including on prefix ties.
+    auto check = [] (data_type ck_type, std::vector<data_value> values) {
+        testlog.info("Checking clustering key type {}", ck_type->name());
+        auto s = schema_builder("ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck1", ck_type, column_kind::clustering_key)
+                .with_column("ck2", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type)
+                .build();
+        std::vector<clustering_key> keys;
+        for (const auto& v : values) {
+            for (int32_t i : {-1, 0, 1}) {
+                keys.push_back(clustering_key::from_exploded(*s, {v.serialize_nonnull(), int32_type->decompose(i)}));
+            }
+        }
+        std::ranges::sort(keys, clustering_key::less_compare(*s));
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            for (size_t j = 0; j < keys.size(); ++j) {
+                mutation_fragment_stream_validator validator(*s);
+                BOOST_REQUIRE(validator(mf_kind::partition_start, {}));
+                BOOST_REQUIRE(validator(mf_kind::clustering_row, position_in_partition_view::for_key(keys[i]), {}));
+                BOOST_REQUIRE_EQUAL(bool(validator(mf_kind::clustering_row, position_in_partition_view::for_key(keys[j]), {})), i < j);
+            }
+        }
+    };
+
+    const auto ints = std::vector<data_value>{std::numeric_limits<int32_t>::min(), -256, -1, 0, 1, 256, std::numeric_limits<int32_t>::max()};
+    check(int32_type, ints);
+    check(reversed_type_impl::get_instance(int32_type), ints);
+    check(long_type, {std::numeric_limits<int64_t>::min(), int64_t(-1), int64_t(0), int64_t(1) << 40, std::numeric_limits<int64_t>::max()});
+
+    // Values which share the first 8 bytes tie on the fingerprint
+    const auto texts = std::vector<data_value>{"", "a", "abcdefg", "abcdefgh", "abcdefgh1", "abcdefgh2", "b"};
+    check(utf8_type, texts);
+    check(reversed_type_impl::get_instance(utf8_type), texts);
+
+    // No fingerprint, always the full comparison
+    check(timeuuid_type, {
+            timeuuid_native_type{utils::UUID("00000000-0000-1000-0000-000000000000")},
+            timeuuid_native_type{utils::UUID("00000000-0000-1000-0000-000000000001")},
+            timeuuid_native_type{utils::UUID("00000001-0000-1000-0000-000000000000")}});
+}
+
 SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_validation_level) {
     simple_schema ss;
 
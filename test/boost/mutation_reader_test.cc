@@ -239,6 +239,36 @@ SEASTAR_THREAD_TEST_CASE(combined_reader_galloping_changing_multiple_partitions_
         .produces_end_of_stream();
 }
 
+SEASTAR_THREAD_TEST_CASE(combined_reader_with_many_readers_test) {
+    simple_schema s;
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto permit = semaphore.make_permit();
+
+    const auto k = s.make_pkeys(2);
+    // Enough readers for the partitions to be merged with the loser tree.
+    const int n_readers = 16;
+
+    std::vector<mutation_reader> v;
+    for (int r = 0; r < n_readers; ++r) {
+        // In the first partition every row comes from two readers. In the
+        // second one, the first reader has most rows, so it keeps winning.
+        auto rows = std::views::iota(0, 100) | std::views::filter([r] (int i) {
+            return i % n_readers == r || (i + 1) % n_readers == r;
+        });
+        auto other_rows = r == 0 ? std::views::iota(0, 50) : std::views::iota(50 + r, 51 + r);
+        v.push_back(make_mutation_reader_from_mutations(s.schema(), permit, {
+            make_partition_with_clustering_rows(s, k[0], rows),
+            make_partition_with_clustering_rows(s, k[1], other_rows)
+        }));
+    }
+    auto expected = make_partition_with_clustering_rows(s, k[1], std::views::iota(0, 50));
+    expected.apply(make_partition_with_clustering_rows(s, k[1], std::views::iota(51, 50 + n_readers)));
+    assert_that(make_combined_reader(s.schema(), permit, std::move(v), streamed_mutation::forwarding::no, mutation_reader::forwarding::no))
+        .produces(make_partition_with_clustering_rows(s, k[0], std::views::iota(0, 100)))
+        .produces(expected)
+        .produces_end_of_stream();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_combined_reader_range_tombstone_change_merging) {
     simple_schema s;
     const auto schema = s.schema();
@@ -1235,6 +1265,7 @@ SEASTAR_TEST_CASE(test_combined_mutation_source_is_a_mutation_source) {
         run_mutation_source_tests(make_combined_populator(1));
         run_mutation_source_tests(make_combined_populator(2));
         run_mutation_source_tests(make_combined_populator(3));
+        run_mutation_source_tests(make_combined_populator(10));
     });
 }
 
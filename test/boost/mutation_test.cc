@@ -1431,6 +1431,7 @@ SEASTAR_TEST_CASE(test_mutation_hash) {
             };
             test_with_hasher(md5_hasher());
             test_with_hasher(xx_hasher());
+            test_with_hasher(xxh3_hasher());
         });
     });
 }
@@ -1447,13 +1448,15 @@ SEASTAR_TEST_CASE(test_query_digest) {
         auto check_digests_equal = [now] (const mutation& m1, const mutation& m2) {
             auto ps1 = partition_slice_builder(*m1.schema()).build();
             auto ps2 = partition_slice_builder(*m2.schema()).build();
-            auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-            auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-
-            if (digest1 != digest2) {
-                BOOST_FAIL(format("Digest should be the same for {} and {}", m1, m2));
+            for (auto da : {query::digest_algorithm::xxHash, query::digest_algorithm::xxh3}) {
+                auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
+                        query::result_options::only_digest(da)).digest();
+                auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
+                        query::result_options::only_digest(da)).digest();
+
+                if (digest1 != digest2) {
+                    BOOST_FAIL(format("Digest should be the same for {} and {}", m1, m2));
+                }
             }
         };
 
@@ -2003,6 +2006,95 @@ SEASTAR_TEST_CASE(test_collection_cell_diff) {
     });
 }
 
+// Checks merge() of serialized collection mutations against merging their
+// descriptions cell by cell.
+SEASTAR_THREAD_TEST_CASE(test_collection_mutation_merge) {
+    auto map_type = map_type_impl::get_instance(int32_type, int32_type, true);
+    const auto now = gc_clock::now();
+
+    auto make_cell = [&] () {
+        auto ts = api::timestamp_type(tests::random::get_int(1, 10));
+        switch (tests::random::get_int(0, 2)) {
+        case 0:
+            return atomic_cell::make_dead(ts, now);
+        case 1:
+            return atomic_cell::make_live(*int32_type, ts, int32_type->decompose(tests::random::get_int(0, 3)), now + 1h, 1h,
+                    atomic_cell::collection_member::yes);
+        default:
+            return atomic_cell::make_live(*int32_type, ts, int32_type->decompose(tests::random::get_int(0, 3)),
+                    atomic_cell::collection_member::yes);
+        }
+    };
+    auto make_collection = [&] () {
+        collection_mutation_description d;
+        if (tests::random::get_bool()) {
+            d.tomb = tombstone(api::timestamp_type(tests::random::get_int(1, 10)), now);
+        }
+        for (int32_t key = 0; key < 50; ++key) {
+            if (tests::random::get_bool()) {
+                d.cells.emplace_back(int32_type->decompose(key), make_cell());
+            }
+        }
+        return d;
+    };
+    auto killed = [] (tombstone t, const atomic_cell& c) {
+        return t && t.timestamp >= c.timestamp();
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        auto a = make_collection();
+        auto b = make_collection();
+
+        std::map<int32_t, atomic_cell_view> cells;
+        for (auto& [key, cell] : a.cells) {
+            if (!killed(b.tomb, cell)) {
+                cells.emplace(value_cast<int32_t>(int32_type->deserialize(key)), cell);
+            }
+        }
+        for (auto& [key, cell] : b.cells) {
+            if (killed(a.tomb, cell)) {
+                continue;
+            }
+            auto [it, inserted] = cells.emplace(value_cast<int32_t>(int32_type->deserialize(key)), cell);
+            if (!inserted && compare_atomic_cell_for_merge(it->second, cell) <= 0) {
+                it->second = cell;
+            }
+        }
+        collection_mutation_description expected;
+        expected.tomb = std::max(a.tomb, b.tomb);
+        for (auto& [key, cell] : cells) {
+            expected.cells.emplace_back(int32_type->decompose(key), atomic_cell(*int32_type, cell));
+        }
+
+        auto merged = merge(*map_type, a.serialize(*map_type), b.serialize(*map_type));
+        BOOST_REQUIRE(merged._data == expected.serialize(*map_type)._data);
+    }
+
+    // A killed cell left over after the other side ran out of cells
+    {
+        collection_mutation_description a;
+        a.cells.emplace_back(int32_type->decompose(1), atomic_cell::make_live(*int32_type, 10, int32_type->decompose(1), atomic_cell::collection_member::yes));
+        a.cells.emplace_back(int32_type->decompose(2), atomic_cell::make_live(*int32_type, 1, int32_type->decompose(2), atomic_cell::collection_member::yes));
+        collection_mutation_description b;
+        b.tomb = tombstone(5, now);
+        collection_mutation_description expected;
+        expected.tomb = b.tomb;
+        expected.cells.emplace_back(a.cells[0].first, atomic_cell(*int32_type, a.cells[0].second));
+        BOOST_REQUIRE(merge(*map_type, a.serialize(*map_type), b.serialize(*map_type))._data == expected.serialize(*map_type)._data);
+        BOOST_REQUIRE(merge(*map_type, b.serialize(*map_type), a.serialize(*map_type))._data == expected.serialize(*map_type)._data);
+    }
+
+    // Fields of user types are merged by their index
+    auto ut = user_type_impl::get_instance("ks", "ut", {to_bytes("f1"), to_bytes("f2")}, {int32_type, utf8_type}, true);
+    collection_mutation_description a;
+    a.cells.emplace_back(serialize_field_index(0), atomic_cell::make_live(*int32_type, 1, int32_type->decompose(1), atomic_cell::collection_member::yes));
+    a.cells.emplace_back(serialize_field_index(1), atomic_cell::make_live(*utf8_type, 2, utf8_type->decompose("a"), atomic_cell::collection_member::yes));
+    collection_mutation_description b;
+    b.cells.emplace_back(serialize_field_index(1), atomic_cell::make_live(*utf8_type, 1, utf8_type->decompose("b"), atomic_cell::collection_member::yes));
+    auto merged = merge(*ut, a.serialize(*ut), b.serialize(*ut));
+    BOOST_REQUIRE(merged._data == a.serialize(*ut)._data);
+}
+
 SEASTAR_TEST_CASE(test_apply_is_commutative) {
     return seastar::async([] {
         for_each_mutation_pair([] (auto&& m1, auto&& m2, are_equal eq) {
@@ -3675,6 +3767,117 @@ SEASTAR_THREAD_TEST_CASE(test_compactor_detach_state) {
     }
 };
 
+SEASTAR_THREAD_TEST_CASE(test_compactor_dead_data_hint) {
+    simple_schema ss;
+    auto pk = ss.make_pkey();
+    auto s = ss.schema();
+
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    auto permit = semaphore.make_permit();
+
+    const auto query_time = gc_clock::now();
+    const auto max_partitions = std::numeric_limits<uint32_t>::max();
+
+    mutation live_mut(s, pk);
+    ss.add_static_row(live_mut, "static_row");
+    for (uint32_t ck = 0; ck < 10; ++ck) {
+        ss.add_row(live_mut, ss.make_ckey(ck), "v");
+    }
+    live_mut.partition().clustered_row(*s, ss.make_ckey(10)).apply(row_marker(ss.new_timestamp()));
+
+    struct consumer {
+        mutation_rebuilder_v2 builder;
+        mutation& mut;
+        uint64_t& live_rows;
+
+        consumer(schema_ptr s, mutation& mut, uint64_t& live_rows) : builder(std::move(s)), mut(mut), live_rows(live_rows) { }
+        void consume_new_partition(const dht::decorated_key& dk) {
+            builder.consume_new_partition(dk);
+        }
+        void consume(const tombstone& t) {
+            builder.consume(t);
+        }
+        stop_iteration consume(static_row&& sr, tombstone, bool is_alive) {
+            live_rows += is_alive;
+            builder.consume(std::move(sr));
+            return stop_iteration::no;
+        }
+        stop_iteration consume(clustering_row&& cr, row_tombstone, bool is_alive) {
+            live_rows += is_alive;
+            builder.consume(std::move(cr));
+            return stop_iteration::no;
+        }
+        stop_iteration consume(range_tombstone_change&& rtc) {
+            builder.consume(std::move(rtc));
+            return stop_iteration::no;
+        }
+        stop_iteration consume_end_of_partition() {
+            builder.consume_end_of_partition();
+            return stop_iteration::no;
+        }
+        void consume_end_of_stream() {
+            if (auto mut_opt = builder.consume_end_of_stream()) {
+                mut += *mut_opt;
+            }
+        }
+    };
+
+    struct result {
+        mutation mut;
+        uint64_t live_rows;
+        compaction_stats stats;
+    };
+
+    auto query = [&] (const mutation& m, lw_shared_ptr<const dead_data_hint> hint, uint64_t row_limit) {
+        auto compaction_state = make_lw_shared<compact_mutation_state<compact_for_sstables::no>>(*s, query_time, s->full_slice(), row_limit, max_partitions);
+        compaction_state->set_dead_data_hint(std::move(hint));
+        auto reader = make_mutation_reader_from_mutations(s, permit, m);
+        auto close_reader = deferred_close(reader);
+        mutation res_mut(s, pk);
+        uint64_t live_rows = 0;
+        reader.consume(compact_for_query<consumer>(compaction_state, consumer(s, res_mut, live_rows))).get();
+        return result{std::move(res_mut), live_rows, compaction_state->stats()};
+    };
+
+    auto check_same = [&] (const result& a, const result& b) {
+        BOOST_REQUIRE_EQUAL(a.mut, b.mut);
+        BOOST_REQUIRE_EQUAL(a.live_rows, b.live_rows);
+        BOOST_REQUIRE_EQUAL(a.stats.static_rows.live, b.stats.static_rows.live);
+        BOOST_REQUIRE_EQUAL(a.stats.clustering_rows.live, b.stats.clustering_rows.live);
+        BOOST_REQUIRE_EQUAL(a.stats.live_cells(), b.stats.live_cells());
+    };
+
+    auto hint = make_lw_shared<dead_data_hint>();
+
+    testlog.info("live data");
+    for (uint64_t row_limit : {uint64_t(3), query::max_rows}) {
+        check_same(query(live_mut, hint, row_limit), query(live_mut, nullptr, row_limit));
+    }
+
+    testlog.info("live data with tombstones");
+    {
+        // The hint isn't set but the source has tombstones anyway, they
+        // still apply to the rows they cover.
+        auto m = live_mut;
+        ss.delete_range(m, query::clustering_range::make(ss.make_ckey(2), ss.make_ckey(4)));
+        m.partition().apply_delete(*s, ss.make_ckey(6), tombstone(ss.new_timestamp(), query_time));
+        auto res = query(m, hint, query::max_rows);
+        check_same(res, query(m, nullptr, query::max_rows));
+        BOOST_REQUIRE_EQUAL(res.live_rows, 8);
+    }
+
+    testlog.info("dead data");
+    {
+        auto m = live_mut;
+        ss.add_row_with_dead_cell(m, ss.make_ckey(0));
+        hint->set_may_have_dead_data();
+        auto res = query(m, hint, query::max_rows);
+        check_same(res, query(m, nullptr, query::max_rows));
+        BOOST_REQUIRE_EQUAL(res.live_rows, 11);
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_compactor_validator) {
     const auto abort_ie = set_abort_on_internal_error(false);
     auto reset_abort_ie = defer([abort_ie] {
@@ -4300,3 +4503,87 @@ SEASTAR_THREAD_TEST_CASE(test_mutation_partition_v2_empty_and_nonfull_keys) {
     BOOST_REQUIRE_THROW(mp.append_clustered_row(*schema, position_in_partition_view::after_all_prefixed(ckey), is_dummy::no, is_continuous::no), std::runtime_error);
     BOOST_REQUIRE_THROW(mp.append_clustered_row(*schema, position_in_partition_view::for_static_row(), is_dummy::no, is_continuous::no), std::runtime_error);
 }
+
+// position_in_partition::tri_compare has a fast path for some types of the first
+// clustering column, check that it orders positions like the component by
+// component comparison.
+SEASTAR_THREAD_TEST_CASE(test_position_in_partition_tri_compare_key_prefixes) {
+    auto check = [] (data_type first_type, std::vector<data_value> values) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck1", first_type, column_kind::clustering_key)
+                .with_column("ck2", int32_type, column_kind::clustering_key)
+                .build();
+        testlog.info("Checking first clustering column of type {}", first_type->name());
+
+        std::vector<clustering_key> keys;
+        keys.push_back(clustering_key::make_empty());
+        for (auto& v : values) {
+            keys.push_back(clustering_key::from_exploded(*s, {v.serialize_nonnull()}));
+            for (int32_t i : {-1, 0, 1}) {
+                keys.push_back(clustering_key::from_exploded(*s, {v.serialize_nonnull(), int32_type->decompose(i)}));
+            }
+        }
+
+        std::vector<position_in_partition_view> positions;
+        positions.push_back(position_in_partition_view::after_all_clustered_rows());
+        for (auto& k : keys) {
+            positions.push_back(position_in_partition_view::before_key(k));
+            positions.push_back(position_in_partition_view::for_key(k));
+            positions.push_back(position_in_partition_view::after_all_prefixed(k));
+        }
+
+        position_in_partition::tri_compare fast_cmp(*s);
+        rows_entry::tri_compare rows_cmp(*s);
+        bound_view::tri_compare cmp(*s);
+        for (auto& p1 : positions) {
+            for (auto& p2 : positions) {
+                auto expected = cmp(p1.key(), int8_t(p1.get_bound_weight()), p2.key(), int8_t(p2.get_bound_weight()));
+                BOOST_REQUIRE(fast_cmp(p1, p2) == expected);
+                BOOST_REQUIRE(rows_cmp(p1, p2) == expected);
+            }
+        }
+    };
+
+    std::vector<data_value> longs;
+    for (int64_t v : {std::numeric_limits<int64_t>::min(), int64_t(-256), int64_t(-1), int64_t(0), int64_t(1), int64_t(255), std::numeric_limits<int64_t>::max()}) {
+        longs.emplace_back(v);
+    }
+    check(long_type, longs);
+    check(reversed_type_impl::get_instance(long_type), longs);
+
+    std::vector<data_value> timestamps;
+    for (int64_t v : {int64_t(-1000), int64_t(0), int64_t(1), int64_t(1700000000000)}) {
+        timestamps.emplace_back(db_clock::time_point(db_clock::duration(v)));
+    }
+    check(timestamp_type, timestamps);
+
+    std::vector<data_value> timeuuids;
+    for (auto ms : {0, 1, 1000}) {
+        auto u = utils::UUID_gen::get_time_UUID(std::chrono::milliseconds(ms));
+        timeuuids.emplace_back(timeuuid_native_type{u});
+        // Same timestamp, different clock sequence and node.
+        timeuuids.emplace_back(timeuuid_native_type{utils::UUID(u.get_most_significant_bits(), ~u.get_least_significant_bits())});
+    }
+    check(timeuuid_type, timeuuids);
+    check(reversed_type_impl::get_instance(timeuuid_type), timeuuids);
+
+    std::vector<data_value> ints;
+    for (int32_t v : {std::numeric_limits<int32_t>::min(), -1, 0, 1, std::numeric_limits<int32_t>::max()}) {
+        ints.emplace_back(v);
+    }
+    check(int32_type, ints);
+    check(short_type, {data_value(int16_t(-300)), data_value(int16_t(-1)), data_value(int16_t(0)), data_value(int16_t(300))});
+
+    // Values longer than the prefix, or sharing it, tie on it.
+    std::vector<data_value> texts;
+    for (auto v : {"", "a", "aa", "abcdefg", "abcdefgh", "abcdefgh1", "abcdefgh2", "abcdefgi", "b"}) {
+        texts.emplace_back(sstring(v));
+    }
+    check(utf8_type, texts);
+    check(reversed_type_impl::get_instance(utf8_type), texts);
+    check(bytes_type, {data_value(bytes()), data_value(bytes(1, int8_t(0))), data_value(bytes(9, int8_t(0x7f))), data_value(bytes(1, int8_t(0x80)))});
+
+    // Not covered by the fast path.
+    check(double_type, {data_value(-1.0), data_value(0.5), data_value(1.0)});
+}
@@ -1111,6 +1111,47 @@ SEASTAR_THREAD_TEST_CASE(test_topology_sort_by_proximity) {
     topology.test_sort_by_proximity(address, nodes);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_topology_sort_by_proximity_from_this_node) {
+    std::unordered_map<sstring, size_t> datacenters = {
+                    { "dc1", 3 },
+                    { "dc2", 3 },
+    };
+    host_id_vector_replica_set nodes;
+    std::generate_n(std::back_inserter(nodes), 6, [i = 0u]() mutable {
+        return host_id{utils::UUID(0, ++i)};
+    });
+
+    locator::token_metadata::config tm_cfg;
+    auto my_address = gms::inet_address("localhost");
+    tm_cfg.topo_cfg.this_endpoint = my_address;
+    tm_cfg.topo_cfg.this_cql_address = my_address;
+    tm_cfg.topo_cfg.this_host_id = nodes[0];
+    tm_cfg.topo_cfg.local_dc_rack = locator::endpoint_dc_rack::default_location;
+    semaphore sem(1);
+    shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, tm_cfg);
+    auto stop_stm = deferred_stop(stm);
+    stm.mutate_token_metadata([&] (token_metadata& tm) -> future<> {
+        auto& topo = tm.get_topology();
+        generate_topology(topo, datacenters, nodes);
+
+        // Sorting the same replica set from this node again is served
+        // from the cache.
+        for (int i = 0; i < 3; ++i) {
+            topo.test_sort_by_proximity(nodes[0], nodes);
+        }
+
+        // Moving the other nodes to another DC must not leave
+        // stale orders around.
+        const auto my_dc = topo.get_location(nodes[0]).dc;
+        for (auto& id : nodes | std::views::drop(1)) {
+            auto dc = topo.get_location(id).dc == my_dc ? sstring("dc3") : my_dc;
+            topo.add_or_update_endpoint(id, endpoint_dc_rack{dc, "rack1"}, node::state::normal);
+            topo.test_sort_by_proximity(nodes[0], nodes);
+        }
+        return make_ready_future();
+    }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_topology_tracks_local_node) {
     inet_address ip1("192.168.0.1");
     inet_address ip2("192.168.0.2");
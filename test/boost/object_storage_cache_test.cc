@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/random_utils.hh"
+#include "test/lib/tmpdir.hh"
+
+#include "sstables/object_storage_cache.hh"
+
+using namespace seastar;
+using sstables::object_storage_cache;
+
+static constexpr size_t block_size = object_storage_cache::block_size;
+
+struct test_file {
+    tmpdir dir;
+    file f;
+    sstring contents;
+
+    ~test_file() {
+        f.close().get();
+    }
+};
+
+static test_file make_test_file(size_t size) {
+    tmpdir dir;
+    auto contents = tests::random::get_sstring(size);
+    auto path = dir.path() / "file";
+    file f = open_file_dma(path.c_str(), open_flags::create | open_flags::rw).get();
+    output_stream<char> out = make_file_output_stream(f).get();
+    auto close_out = defer([&] { out.close().get(); });
+    out.write(contents.begin(), contents.size()).get();
+    out.flush().get();
+    f = open_file_dma(path.c_str(), open_flags::ro).get();
+    return test_file{
+        .dir = std::move(dir),
+        .f = std::move(f),
+        .contents = std::move(contents)
+    };
+}
+
+static sstring read_to_string(file& f, size_t pos, size_t len) {
+    auto buf = f.dma_read_bulk<char>(pos, len).get();
+    return sstring(buf.get(), buf.size());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reads_through_cache) {
+    test_file tf = make_test_file(block_size * 2 + 100);
+    object_storage_cache cache(block_size * 10);
+    auto f = cache.wrap(tf.f, "obj", false);
+
+    // Within a single block
+    BOOST_REQUIRE_EQUAL(read_to_string(f, 10, 100), tf.contents.substr(10, 100));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 1);
+    BOOST_REQUIRE_EQUAL(read_to_string(f, 200, 100), tf.contents.substr(200, 100));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 1);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+
+    // Across blocks, up to and past the end of the object
+    BOOST_REQUIRE_EQUAL(read_to_string(f, block_size - 10, 20), tf.contents.substr(block_size - 10, 20));
+    BOOST_REQUIRE_EQUAL(read_to_string(f, block_size * 2, 1000), tf.contents.substr(block_size * 2));
+    BOOST_REQUIRE_EQUAL(read_to_string(f, block_size * 3, 10), "");
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 4);
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), tf.contents.size());
+
+    // Concurrent reads of a block which is not cached read it once
+    cache.invalidate("obj");
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+    auto misses = cache.get_stats().misses;
+    auto [a, b] = when_all_succeed(f.dma_read_bulk<char>(0, 10), f.dma_read_bulk<char>(20, 10)).get();
+    BOOST_REQUIRE_EQUAL(sstring(a.get(), a.size()), tf.contents.substr(0, 10));
+    BOOST_REQUIRE_EQUAL(sstring(b.get(), b.size()), tf.contents.substr(20, 10));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, misses + 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_eviction_prefers_unpinned_blocks) {
+    test_file tf = make_test_file(block_size * 4);
+    object_storage_cache cache(block_size * 3);
+    auto index = cache.wrap(tf.f, "index", true);
+    auto data = cache.wrap(tf.f, "data", false);
+
+    read_to_string(index, 0, 10);
+    read_to_string(index, block_size, 10);
+    for (size_t i = 0; i < 4; ++i) {
+        read_to_string(data, block_size * i, 10);
+    }
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), block_size * 3);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 3);
+
+    // The pinned blocks survived the scan of the data file
+    auto misses = cache.get_stats().misses;
+    read_to_string(index, 0, 10);
+    read_to_string(index, block_size, 10);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, misses);
+
+    // Shrinking the cache evicts pinned blocks when nothing else is left
+    cache.set_capacity(block_size);
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), block_size);
+    cache.set_capacity(0);
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+    BOOST_REQUIRE_EQUAL(read_to_string(data, 5, 10), tf.contents.substr(5, 10));
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+}
@@ -124,6 +124,36 @@ SEASTAR_THREAD_TEST_CASE(test_decorated_key_is_compatible_with_origin) {
     BOOST_REQUIRE(dk._key.equal(*s, key));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_batch_tokens_match_single_tokens) {
+    auto singular = schema_builder("ks", "cf")
+        .with_column("pk", bytes_type, column_kind::partition_key)
+        .with_column("v", int32_type)
+        .build();
+    auto compound = schema_builder("ks", "cf2")
+        .with_column("pk1", bytes_type, column_kind::partition_key)
+        .with_column("pk2", bytes_type, column_kind::partition_key)
+        .with_column("v", int32_type)
+        .build();
+
+    for (auto s : {singular, compound}) {
+        std::vector<partition_key> keys;
+        // More than a single internal batch, with empty keys and keys of many lengths.
+        for (size_t i = 0; i < 200; ++i) {
+            std::vector<data_value> components;
+            for (size_t c = 0; c < s->partition_key_size(); ++c) {
+                components.push_back(data_value(tests::random::get_bytes(i % 70)));
+            }
+            keys.push_back(partition_key::from_deeply_exploded(*s, components));
+        }
+        std::vector<partition_key_view> views(keys.begin(), keys.end());
+        std::vector<dht::token> tokens(keys.size());
+        dht::get_tokens(*s, views, tokens);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(tokens[i], dht::get_token(*s, keys[i]));
+        }
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_token_wraparound_1) {
     auto t1 = token_from_long(0x7000'0000'0000'0000);
     auto t2 = token_from_long(0xa000'0000'0000'0000);
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+
+#include "service/paxos/paxos_state_cache.hh"
+#include "test/lib/simple_schema.hh"
+#include "utils/UUID_gen.hh"
+
+using namespace service::paxos;
+
+static constexpr paxos_state_cache::version_type version = 1;
+static constexpr gc_clock::duration no_ttl = gc_clock::duration::zero();
+
+static utils::UUID make_ballot(api::timestamp_type ts) {
+    return utils::UUID_gen::get_random_time_UUID_from_micros(std::chrono::microseconds{ts});
+}
+
+static proposal make_proposal(simple_schema& ss, const dht::decorated_key& dk, api::timestamp_type ts, sstring v) {
+    mutation m(ss.schema(), dk);
+    ss.add_row(m, ss.make_ckey(0), v, ts);
+    return proposal(make_ballot(ts), freeze(m));
+}
+
+static paxos_state_cache::state empty_state() {
+    return paxos_state_cache::state{.promised = utils::UUID_gen::min_time_UUID()};
+}
+
+// Fills the cache with the given state of the key, as if read from the table.
+static void load(paxos_state_cache& cache, const schema& s, const dht::decorated_key& dk, const paxos_state_cache::state& st) {
+    auto generation = cache.start_load(s, dk.key(), version);
+    BOOST_REQUIRE(generation);
+    cache.finish_load(s, dk.key(), *generation, st);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_serves_written_state) {
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    auto dk = ss.make_pkey(0);
+    paxos_state_cache cache(1 << 20);
+
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+    // Writes to keys which aren't cached are ignored.
+    cache.apply_promise(s, dk.key(), make_ballot(5));
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+
+    load(cache, s, dk, empty_state());
+    auto p = make_proposal(ss, dk, 10, "a");
+    cache.apply_promise(s, dk.key(), p.ballot);
+    cache.apply_proposal(s, p);
+
+    auto st = cache.get(s, dk.key(), version, gc_clock::now(), no_ttl);
+    BOOST_REQUIRE(st);
+    BOOST_REQUIRE_EQUAL(st->promised, p.ballot);
+    BOOST_REQUIRE(st->accepted);
+    BOOST_REQUIRE_EQUAL(st->accepted->ballot, p.ballot);
+
+    cache.apply_decision(s, p);
+    st = cache.get(s, dk.key(), version, gc_clock::now(), no_ttl);
+    BOOST_REQUIRE(st);
+    BOOST_REQUIRE(!st->accepted);
+    BOOST_REQUIRE_EQUAL(*st->most_recent_commit_at, p.ballot);
+    BOOST_REQUIRE(st->most_recent_commit);
+
+    // Older writes lose, as they do in the table.
+    cache.apply_promise(s, dk.key(), make_ballot(7));
+    cache.apply_proposal(s, make_proposal(ss, dk, 8, "b"));
+    st = cache.get(s, dk.key(), version, gc_clock::now(), no_ttl);
+    BOOST_REQUIRE(st);
+    BOOST_REQUIRE_EQUAL(st->promised, p.ballot);
+    BOOST_REQUIRE(!st->accepted);
+
+    // Pruning keeps the ballot of the commit, and a late learn of the same
+    // decision doesn't bring it back.
+    cache.apply_prune(s, dk.key(), p.ballot);
+    cache.apply_decision(s, p);
+    st = cache.get(s, dk.key(), version, gc_clock::now(), no_ttl);
+    BOOST_REQUIRE(st);
+    BOOST_REQUIRE_EQUAL(*st->most_recent_commit_at, p.ballot);
+    BOOST_REQUIRE(!st->most_recent_commit);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_merges_writes_racing_with_load) {
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    auto dk = ss.make_pkey(0);
+    paxos_state_cache cache(1 << 20);
+
+    auto old_decision = make_proposal(ss, dk, 10, "a");
+    auto new_decision = make_proposal(ss, dk, 20, "b");
+
+    auto generation = cache.start_load(s, dk.key(), version);
+    BOOST_REQUIRE(generation);
+    // Not served until the read completes.
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+    // A second read of the key doesn't fill the cache.
+    BOOST_REQUIRE(!cache.start_load(s, dk.key(), version));
+
+    // A learn completes while the table is read, and the read doesn't see it.
+    cache.apply_decision(s, new_decision);
+    auto loaded = empty_state();
+    loaded.promised = old_decision.ballot;
+    loaded.most_recent_commit_at = old_decision.ballot;
+    loaded.most_recent_commit = old_decision.update;
+    cache.finish_load(s, dk.key(), *generation, loaded);
+
+    auto st = cache.get(s, dk.key(), version, gc_clock::now(), no_ttl);
+    BOOST_REQUIRE(st);
+    BOOST_REQUIRE_EQUAL(st->promised, old_decision.ballot);
+    BOOST_REQUIRE_EQUAL(*st->most_recent_commit_at, new_decision.ballot);
+    BOOST_REQUIRE(st->most_recent_commit);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_drops_state_of_unknown_merge_outcome) {
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    auto dk = ss.make_pkey(0);
+    paxos_state_cache cache(1 << 20);
+
+    // Different ballots with the same timestamp, the table resolves the tie
+    // by value.
+    load(cache, s, dk, empty_state());
+    cache.apply_promise(s, dk.key(), make_ballot(10));
+    cache.apply_promise(s, dk.key(), make_ballot(10));
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+    BOOST_REQUIRE_EQUAL(cache.get_stats().invalidations, 1);
+
+    // A failed read.
+    auto generation = cache.start_load(s, dk.key(), version);
+    BOOST_REQUIRE(generation);
+    cache.abort_load(s, dk.key(), *generation);
+    BOOST_REQUIRE(cache.start_load(s, dk.key(), version));
+    cache.invalidate(s, dk.key());
+
+    // A topology change.
+    load(cache, s, dk, empty_state());
+    BOOST_REQUIRE(cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version + 1, gc_clock::now(), no_ttl));
+
+    // Expiry of the oldest cell, which may have been written long before
+    // the state was read.
+    const auto ttl = std::chrono::seconds(10);
+    const auto written_at = gc_clock::time_point(std::chrono::seconds(1000));
+    auto micros = [] (gc_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+    };
+    auto p = make_proposal(ss, dk, micros(written_at), "a");
+    auto loaded = empty_state();
+    loaded.promised = p.ballot;
+    loaded.accepted = p;
+    load(cache, s, dk, loaded);
+    BOOST_REQUIRE(cache.get(s, dk.key(), version, written_at + ttl / 2, ttl));
+    // A newer promise doesn't extend the life of the older proposal.
+    cache.apply_promise(s, dk.key(), make_ballot(micros(written_at + ttl / 2)));
+    BOOST_REQUIRE(cache.get(s, dk.key(), version, written_at + ttl - std::chrono::seconds(1), ttl));
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, written_at + ttl, ttl));
+    // The TTL is the current one of the table.
+    load(cache, s, dk, loaded);
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, written_at + ttl / 2, ttl / 10));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_drops_state_of_truncated_and_dropped_tables) {
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    auto dk = ss.make_pkey(0);
+    paxos_state_cache cache(1 << 20);
+
+    auto t0 = db_clock::time_point(std::chrono::seconds(1));
+    cache.invalidate_if_truncated(s.id(), t0);
+    load(cache, s, dk, empty_state());
+    cache.invalidate_if_truncated(s.id(), t0);
+    BOOST_REQUIRE(cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+
+    cache.invalidate_if_truncated(s.id(), t0 + std::chrono::seconds(1));
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+
+    load(cache, s, dk, empty_state());
+    cache.drop_table(s.id());
+    BOOST_REQUIRE(!cache.get(s, dk.key(), version, gc_clock::now(), no_ttl));
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_eviction) {
+    simple_schema ss;
+    const auto& s = *ss.schema();
+    auto keys = ss.make_pkeys(10);
+    paxos_state_cache cache(1 << 20);
+
+    for (auto& dk : keys) {
+        load(cache, s, dk, empty_state());
+        cache.apply_decision(s, make_proposal(ss, dk, 10, sstring(1000, 'x')));
+    }
+    BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 0);
+    auto used = cache.used_bytes();
+    BOOST_REQUIRE_GT(used, 10 * 1000);
+
+    // The least recently used states go first.
+    BOOST_REQUIRE(cache.get(s, keys[0].key(), version, gc_clock::now(), no_ttl));
+    cache.set_capacity(used / 2);
+    BOOST_REQUIRE_LE(cache.used_bytes(), used / 2);
+    BOOST_REQUIRE_GT(cache.get_stats().evictions, 0);
+    BOOST_REQUIRE(cache.get(s, keys[0].key(), version, gc_clock::now(), no_ttl));
+    BOOST_REQUIRE(!cache.get(s, keys[1].key(), version, gc_clock::now(), no_ttl));
+
+    cache.set_capacity(0);
+    BOOST_REQUIRE_EQUAL(cache.used_bytes(), 0);
+    BOOST_REQUIRE(!cache.start_load(s, keys[0].key(), version));
+}
@@ -199,6 +199,10 @@ class test_querier_cache {
         return _sem;
     }
 
+    const query::querier_cache::stats& get_cache_stats() const {
+        return _cache.get_stats();
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -397,6 +401,8 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_wrong_key_misses) {
         .misses()
         .no_drops()
         .no_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().evicted_misses, 0);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().range_mismatches, 0);
 }
 
 SEASTAR_THREAD_TEST_CASE(lookup_data_querier_as_mutation_querier_misses) {
@@ -550,6 +556,8 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_different_schema_version_drops) {
         .no_misses()
         .drops()
         .no_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().schema_version_mismatches, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().position_mismatches, 0);
 }
 
 /*
@@ -579,6 +587,8 @@ SEASTAR_THREAD_TEST_CASE(test_time_based_cache_eviction) {
         .no_drops()
         .time_based_evictions();
 
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().evicted_misses, 2);
+
     // There should be no inactive reads, the querier_cache should unregister
     // the expired queriers.
     BOOST_REQUIRE_EQUAL(t.get_semaphore().get_stats().inactive_reads, 0);
@@ -23,6 +23,8 @@
 #include "transport/messages/result_message.hh"
 #include "cql3/query_processor.hh"
 #include "cql3/untyped_result_set.hh"
+#include "transport/server.hh"
+#include "db/config.hh"
 
 BOOST_AUTO_TEST_SUITE(query_processor_test)
 
@@ -356,4 +358,103 @@ SEASTAR_TEST_CASE(test_select_full_scan_metrics) {
     });
 }
 
+SEASTAR_TEST_CASE(test_unprepared_statements_cache) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& cache = e.local_qp().get_unprepared_cache();
+        cquery_nofail(e, "create table ks.cf (k int, v int, primary key (k))");
+
+        auto hits = cache.get_stats().hits;
+        auto size = cache.size();
+        cquery_nofail(e, "insert into ks.cf (k, v) values (1, 1)");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 1);
+        cquery_nofail(e, "insert into ks.cf (k, v) values (1, 2)");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 2);
+        cquery_nofail(e, "select v from ks.cf where k = 1");
+        assert_that(e.execute_cql("select v from ks.cf where k = 1").get()).is_rows().with_rows({{int32_type->decompose(2)}});
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, hits + 1);
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 3);
+
+        // Schema statements are not cached.
+        cquery_nofail(e, "create table ks.cf2 (k int primary key)");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 3);
+
+        // Schema changes invalidate the statements reading the table.
+        cquery_nofail(e, "alter table ks.cf add w int");
+        BOOST_REQUIRE_EQUAL(cache.size(), size);
+        assert_that(e.execute_cql("select * from ks.cf where k = 1").get()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(2), std::nullopt}});
+    });
+}
+
+SEASTAR_TEST_CASE(test_unprepared_statements_cache_normalizes_whitespace) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& cache = e.local_qp().get_unprepared_cache();
+        cquery_nofail(e, "create table ks.cf (k int, v text, primary key (k))");
+
+        auto hits = cache.get_stats().hits;
+        auto size = cache.size();
+        cquery_nofail(e, "insert into ks.cf (k, v) values (1, 'a  b')");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 1);
+        cquery_nofail(e, "  insert into ks.cf\n  (k, v)\tvalues (1, 'a  b') ");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 1);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, hits + 1);
+
+        // Whitespace inside string literals is part of the value.
+        cquery_nofail(e, "insert into ks.cf (k, v) values (1, 'a b')");
+        BOOST_REQUIRE_EQUAL(cache.size(), size + 2);
+        assert_that(e.execute_cql("select v from ks.cf where k = 1").get()).is_rows().with_rows({{utf8_type->decompose("a b")}});
+    });
+}
+
+SEASTAR_TEST_CASE(test_unprepared_statements_cache_normalize) {
+    using cache = cql3::unprepared_statements_cache;
+    BOOST_REQUIRE_EQUAL(cache::normalize(" select  *\nfrom\tks.cf "), "select * from ks.cf");
+    BOOST_REQUIRE_EQUAL(cache::normalize("select \"a  b\" from ks.cf where k = 'x  ''  y'"), "select \"a  b\" from ks.cf where k = 'x  ''  y'");
+    BOOST_REQUIRE_EQUAL(cache::normalize("select * from ks.cf -- a  comment"), "select * from ks.cf -- a  comment");
+    BOOST_REQUIRE_EQUAL(cache::normalize("select * from ks.cf where v = $$a  b$$"), "select * from ks.cf where v = $$a  b$$");
+    // The case is kept, ISO 8601 durations are case sensitive.
+    BOOST_REQUIRE_EQUAL(cache::normalize("SELECT  * FROM ks.cf"), "SELECT * FROM ks.cf");
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_cached_statement_cost) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        const auto d = cql3::dialect{
+            .duplicate_bind_variable_names_refer_to_same_variable = e.local_db().get_config().cql_duplicate_bind_variable_names_refer_to_same_variable(),
+        };
+        cquery_nofail(e, "create table ks.cf (k int, v int, primary key (k))");
+
+        auto find = [&] (std::string_view query) {
+            return qp.find_cached_statement(query, e.local_client_state(), d);
+        };
+        // Queries which weren't seen yet aren't parsed.
+        BOOST_REQUIRE(!find("select v from ks.cf"));
+
+        // Unprepared range scans cost as much as prepared ones.
+        cquery_nofail(e, "select v from ks.cf");
+        cquery_nofail(e, "select v from ks.cf where k = 1");
+        e.prepare("select v from ks.cf where token(k) > 0").get();
+        BOOST_REQUIRE_EQUAL(cql_transport::statement_cost(*find("select v from ks.cf")), 8);
+        BOOST_REQUIRE_EQUAL(cql_transport::statement_cost(*find("select v from ks.cf where token(k) > 0")), 8);
+        BOOST_REQUIRE_EQUAL(cql_transport::statement_cost(*find("select v from ks.cf where k = 1")), 1);
+        cquery_nofail(e, "insert into ks.cf (k, v) values (1, 1)");
+        BOOST_REQUIRE_EQUAL(cql_transport::statement_cost(*find("insert into ks.cf (k, v) values (1, 1)")), 2);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_should_shed_by_priority) {
+    using cql_transport::should_shed_by_priority;
+    // Disabled, or below the threshold.
+    BOOST_REQUIRE(!should_shed_by_priority(1000, 0, 100, 8));
+    BOOST_REQUIRE(!should_shed_by_priority(100, 100, 100, 8));
+    // The expensive requests of low priority service levels go first...
+    BOOST_REQUIRE(should_shed_by_priority(110, 100, 100, 8));
+    BOOST_REQUIRE(!should_shed_by_priority(110, 100, 100, 1));
+    BOOST_REQUIRE(!should_shed_by_priority(110, 100, 1000, 8));
+    // ...and the cheap requests of the top service levels at twice the threshold.
+    BOOST_REQUIRE(!should_shed_by_priority(200, 100, 1000, 1));
+    BOOST_REQUIRE(should_shed_by_priority(201, 100, 1000, 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
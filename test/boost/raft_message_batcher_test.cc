@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include "service/raft/raft_message_batcher.hh"
+#include "serializer_impl.hh"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct sent_batch {
+    raft::server_id dst;
+    std::vector<service::raft_batched_message> messages;
+};
+
+service::raft_message_batcher make_batcher(std::vector<sent_batch>& sent, utils::updateable_value_source<uint32_t>& window, size_t max_batch_bytes = 128 * 1024) {
+    return service::raft_message_batcher([&sent] (raft::server_id dst, std::vector<service::raft_batched_message> messages) {
+        sent.push_back(sent_batch{dst, std::move(messages)});
+        return make_ready_future<>();
+    }, service::raft_message_batcher::config{
+        .window_in_us = utils::updateable_value<uint32_t>(window),
+        .max_batch_bytes = max_batch_bytes,
+    });
+}
+
+raft::append_request heartbeat(raft::term_t term) {
+    return raft::append_request{.current_term = term};
+}
+
+}
+
+SEASTAR_THREAD_TEST_CASE(test_raft_message_batcher_coalesces_per_destination) {
+    std::vector<sent_batch> sent;
+    auto window = utils::updateable_value_source<uint32_t>(1000);
+    auto batcher = make_batcher(sent, window);
+    auto stop_batcher = defer([&batcher] { batcher.stop().get(); });
+
+    BOOST_REQUIRE(!batcher.enabled());
+    batcher.set_supported();
+    BOOST_REQUIRE(batcher.enabled());
+
+    auto a = raft::server_id::create_random_id();
+    auto b = raft::server_id::create_random_id();
+    std::vector<raft::group_id> groups;
+    for (int i = 0; i < 10; ++i) {
+        groups.push_back(raft::group_id{utils::make_random_uuid()});
+    }
+
+    std::vector<future<>> futures;
+    for (auto gid : groups) {
+        futures.push_back(batcher.send(a, gid, heartbeat(raft::term_t(1))));
+        futures.push_back(batcher.send(b, gid, raft::vote_reply{.current_term = raft::term_t(1), .vote_granted = true}));
+    }
+    BOOST_REQUIRE(sent.empty());
+    when_all_succeed(futures.begin(), futures.end()).get();
+
+    BOOST_REQUIRE_EQUAL(sent.size(), 2);
+    BOOST_REQUIRE_EQUAL(batcher.get_stats().messages, 20);
+    BOOST_REQUIRE_EQUAL(batcher.get_stats().batches, 2);
+    for (auto& batch : sent) {
+        BOOST_REQUIRE_EQUAL(batch.messages.size(), groups.size());
+        for (size_t i = 0; i < groups.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(batch.messages[i].gid, groups[i]);
+            if (batch.dst == a) {
+                BOOST_REQUIRE(std::holds_alternative<raft::append_request>(batch.messages[i].message));
+            } else {
+                BOOST_REQUIRE_EQUAL(batch.dst, b);
+                BOOST_REQUIRE(std::holds_alternative<raft::vote_reply>(batch.messages[i].message));
+            }
+        }
+    }
+
+    // Disabled with a zero window
+    window.set(0);
+    BOOST_REQUIRE(!batcher.enabled());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_raft_message_batcher_flushes_full_batches) {
+    std::vector<sent_batch> sent;
+    auto window = utils::updateable_value_source<uint32_t>(std::chrono::microseconds(10s).count());
+    auto batcher = make_batcher(sent, window, 4096);
+    auto stop_batcher = defer([&batcher] { batcher.stop().get(); });
+    batcher.set_supported();
+
+    auto dst = raft::server_id::create_random_id();
+    auto gid = raft::group_id{utils::make_random_uuid()};
+    raft::command cmd;
+    ser::serialize(cmd, sstring(5000, 'x'));
+    auto req = heartbeat(raft::term_t(1));
+    req.entries.push_back(make_lw_shared<const raft::log_entry>(raft::log_entry{
+            .term = raft::term_t(1), .idx = raft::index_t(1), .data = std::move(cmd)}));
+
+    auto f1 = batcher.send(dst, gid, heartbeat(raft::term_t(1)));
+    BOOST_REQUIRE(sent.empty());
+    // Goes over max_batch_bytes, so the batch is sent without waiting for the window
+    auto f2 = batcher.send(dst, gid, req);
+    f1.get();
+    f2.get();
+    BOOST_REQUIRE_EQUAL(sent.size(), 1);
+    BOOST_REQUIRE_EQUAL(sent[0].messages.size(), 2);
+
+    // Stopping sends what is queued
+    auto f3 = batcher.send(dst, gid, raft::timeout_now{.current_term = raft::term_t(2)});
+    stop_batcher.cancel();
+    batcher.stop().get();
+    f3.get();
+    BOOST_REQUIRE_EQUAL(sent.size(), 2);
+    BOOST_REQUIRE(!batcher.enabled());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_raft_message_batcher_send_failure) {
+    auto window = utils::updateable_value_source<uint32_t>(100);
+    service::raft_message_batcher batcher([] (raft::server_id, std::vector<service::raft_batched_message>) {
+        return make_exception_future<>(std::runtime_error("send failed"));
+    }, service::raft_message_batcher::config{
+        .window_in_us = utils::updateable_value<uint32_t>(window),
+    });
+    auto stop_batcher = defer([&batcher] { batcher.stop().get(); });
+    batcher.set_supported();
+
+    auto f = batcher.send(raft::server_id::create_random_id(), raft::group_id{utils::make_random_uuid()}, heartbeat(raft::term_t(1)));
+    BOOST_REQUIRE_THROW(f.get(), std::runtime_error);
+}
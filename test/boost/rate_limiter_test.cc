@@ -127,3 +127,30 @@ SEASTAR_TEST_CASE(test_rate_limiter_account_operation) {
     }
     BOOST_REQUIRE(encountered_rejection);
 }
+
+SEASTAR_TEST_CASE(test_rate_limiter_weighted_operations) {
+    test_rate_limiter::label lbl1;
+    test_rate_limiter::label lbl2;
+
+    test_rate_limiter limiter;
+
+    // An operation accounted with the weight of N counts as much
+    // as N operations accounted one by one.
+    for (int i = 0; i < 100; i++) {
+        limiter.increase_and_get_counter(lbl1, 0, 3);
+        for (int j = 0; j < 3; j++) {
+            limiter.increase_and_get_counter(lbl2, 0);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl1, 0, 3), 303u);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl2, 0, 3), 303u);
+
+    // The weight is carried by the rate limit info
+    db::per_partition_rate_limit::account_only info {
+        .weight = 5,
+    };
+    BOOST_REQUIRE(limiter.account_operation(lbl1, 0, 1, info) == test_rate_limiter::can_proceed::yes);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl1, 0, 0), 308u);
+
+    co_return;
+}
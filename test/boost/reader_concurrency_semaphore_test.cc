@@ -2373,4 +2373,153 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_double_permit_abort)
     BOOST_REQUIRE_THROW(requested_memory2_fut.get(), named_semaphore_timed_out);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_adaptive_concurrency) {
+    const int count = 16;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), count, 1024 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    semaphore.set_adaptive_concurrency(reader_concurrency_semaphore::adaptive_concurrency_config{
+            .adjust_period = std::chrono::milliseconds(50),
+            .min_count = 2,
+            .latency_tolerance = 2.0});
+
+    // Establish a baseline with fast reads.
+    for (int i = 0; i < 10; ++i) {
+        semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    }
+    seastar::sleep(std::chrono::milliseconds(60)).get();
+    BOOST_REQUIRE_EQUAL(semaphore.effective_count_limit(), count);
+
+    // Slow reads, all of them reading from the disk.
+    std::vector<reader_permit> permits;
+    for (int i = 0; i < count; ++i) {
+        permits.push_back(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get());
+        permits.back().on_start_sstable_read();
+    }
+    seastar::sleep(std::chrono::milliseconds(120)).get();
+    permits.erase(permits.begin() + count / 2, permits.end());
+    seastar::sleep(std::chrono::milliseconds(60)).get();
+    BOOST_REQUIRE_LT(semaphore.effective_count_limit(), count);
+    BOOST_REQUIRE_EQUAL(semaphore.consumed_resources().count, count / 2);
+    // Units released by the reads are withheld, not handed out above the limit.
+    BOOST_REQUIRE_LE(semaphore.available_resources().count,
+            std::max(semaphore.effective_count_limit() - semaphore.consumed_resources().count, 0));
+    BOOST_REQUIRE_EQUAL(semaphore.withheld_count(), count - std::max(semaphore.effective_count_limit(), count / 2));
+
+    // Once the disk is not saturated anymore, the limit recovers.
+    permits.clear();
+    for (int i = 0; i < 100 && semaphore.effective_count_limit() < count; ++i) {
+        seastar::sleep(std::chrono::milliseconds(10)).get();
+    }
+    BOOST_REQUIRE_EQUAL(semaphore.effective_count_limit(), count);
+
+    // The static limit remains an upper bound.
+    semaphore.set_resources({count / 2, 1024 * 1024});
+    BOOST_REQUIRE_LE(semaphore.effective_count_limit(), count / 2);
+
+    semaphore.set_adaptive_concurrency(std::nullopt);
+    BOOST_REQUIRE_EQUAL(semaphore.effective_count_limit(), count / 2);
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources(), semaphore.initial_resources());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_admission_classes) {
+    using ac = reader_concurrency_semaphore::admission_class;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 1024 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    const auto now = db::timeout_clock::now();
+    auto obtain = [&] (ac cls, std::chrono::seconds timeout) {
+        return semaphore.obtain_permit(nullptr, get_name(), 1024, now + timeout, {}, cls);
+    };
+
+    std::optional<reader_permit> active = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+
+    // A point read overtakes a scan with a later timeout.
+    auto scan_fut = obtain(ac::scan, std::chrono::seconds(60));
+    auto point_fut = obtain(ac::point, std::chrono::seconds(30));
+    active.reset();
+    while (!point_fut.available() && !scan_fut.available()) {
+        seastar::thread::yield();
+    }
+    BOOST_REQUIRE(point_fut.available());
+    BOOST_REQUIRE(!scan_fut.available());
+    active = point_fut.get();
+
+    // But not a scan with an earlier timeout.
+    auto late_point_fut = obtain(ac::point, std::chrono::seconds(120));
+    active.reset();
+    while (!scan_fut.available() && !late_point_fut.available()) {
+        seastar::thread::yield();
+    }
+    BOOST_REQUIRE(scan_fut.available());
+    BOOST_REQUIRE(!late_point_fut.available());
+    active = scan_fut.get();
+    active.reset();
+    late_point_fut.get();
+
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().point_reads_admitted_after_wait, 2);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().scans_admitted_after_wait, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_slow_read_log) {
+    auto threshold = utils::updateable_value_source<uint32_t>(1);
+    slow_read_log log(utils::updateable_value<uint32_t>(threshold), 2);
+
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 1024 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+    semaphore.set_slow_read_log(&log);
+
+    std::optional<reader_permit> permit1 = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    auto permit2_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {});
+    BOOST_REQUIRE(!permit2_fut.available());
+
+    seastar::sleep(std::chrono::milliseconds(2)).get();
+    permit1.reset();
+    std::optional<reader_permit> permit2 = permit2_fut.get();
+    permit2.reset();
+
+    BOOST_REQUIRE_EQUAL(log.recorded(), 2);
+    BOOST_REQUIRE_EQUAL(log.entries().size(), 2);
+    for (const auto& e : log.entries()) {
+        BOOST_REQUIRE_GE(e.duration, std::chrono::milliseconds(1));
+        BOOST_REQUIRE_EQUAL(e.keyspace, "*");
+        BOOST_REQUIRE_EQUAL(e.semaphore, get_name());
+    }
+    BOOST_REQUIRE_EQUAL(log.entries()[0].seq, 0);
+    BOOST_REQUIRE_EQUAL(log.entries()[0].queued.count(), 0);
+    BOOST_REQUIRE_EQUAL(log.entries()[1].seq, 1);
+    BOOST_REQUIRE_GE(log.entries()[1].queued, std::chrono::milliseconds(1));
+
+    // Only the latest entries are kept.
+    permit1 = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    seastar::sleep(std::chrono::milliseconds(2)).get();
+    permit1.reset();
+    BOOST_REQUIRE_EQUAL(log.recorded(), 3);
+    BOOST_REQUIRE_EQUAL(log.entries().size(), 2);
+    BOOST_REQUIRE_EQUAL(log.entries().front().seq, 1);
+    BOOST_REQUIRE_EQUAL(log.entries().back().seq, 2);
+
+    // Permits created while the log is disabled are not recorded.
+    threshold.set(0);
+    permit1 = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get();
+    threshold.set(1);
+    seastar::sleep(std::chrono::milliseconds(2)).get();
+    permit1.reset();
+    BOOST_REQUIRE_EQUAL(log.recorded(), 3);
+
+    // The time spent registered as inactive, e.g. between pages, doesn't count.
+    simple_schema s;
+    threshold.set(100);
+    permit1 = semaphore.obtain_permit(s.schema(), get_name(), 1024, db::no_timeout, {}).get();
+    {
+        auto handle = semaphore.register_inactive_read(make_empty_mutation_reader(s.schema(), *permit1));
+        seastar::sleep(std::chrono::milliseconds(200)).get();
+        auto reader = semaphore.unregister_inactive_read(std::move(handle));
+        BOOST_REQUIRE(reader);
+        reader->close().get();
+    }
+    permit1.reset();
+    BOOST_REQUIRE_EQUAL(log.recorded(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,7 @@
 #include "schema/schema_registry.hh"
 #include "utils/chunked_vector.hh"
 #include "repair/incremental.hh"
+#include "repair/hash_tree.hh"
 
 BOOST_AUTO_TEST_SUITE(repair_test)
 
@@ -275,4 +276,56 @@ SEASTAR_TEST_CASE(repair_rows_size_considers_external_memory) {
     });
 }
 
+
+SEASTAR_TEST_CASE(test_repair_hash_tree) {
+    return seastar::async([&] {
+        repair_hash_set common;
+        while (common.size() < 20000) {
+            common.insert(repair_hash(tests::random::get_int<uint64_t>()));
+        }
+        auto local = common;
+        auto remote = common;
+        for (int i = 0; i < 3; ++i) {
+            local.insert(repair_hash(tests::random::get_int<uint64_t>()));
+            remote.insert(repair_hash(tests::random::get_int<uint64_t>()));
+        }
+        // A hash changed on the remote side only.
+        remote.erase(remote.begin());
+
+        // The root is the combined hash of the set.
+        repair_hash combined;
+        for (auto& h : remote) {
+            combined.add(h);
+        }
+        repair::hash_tree local_tree(local);
+        repair::hash_tree remote_tree(remote);
+        BOOST_REQUIRE(remote_tree.get_nodes(0, {0}).get() == std::vector<repair_hash>{combined});
+
+        // Walk the tree like the repair master does.
+        const unsigned depth = repair::hash_tree_depth_for(local.size());
+        BOOST_REQUIRE_GT(depth, 1);
+        auto nodes = repair::hash_tree_children({0});
+        for (unsigned level = 1; ; ++level) {
+            auto local_values = local_tree.get_nodes(level, nodes).get();
+            auto remote_values = remote_tree.get_nodes(level, nodes).get();
+            // Levels are computed once, and then served from the cache.
+            BOOST_REQUIRE(remote_tree.get_nodes(level, nodes).get() == remote_values);
+            nodes = repair::hash_tree_mismatched_nodes(nodes, local_values, remote_values);
+            BOOST_REQUIRE_LE(nodes.size(), 7);
+            if (level == depth) {
+                break;
+            }
+            nodes = repair::hash_tree_children(nodes);
+        }
+        auto fetched = remote_tree.get_hashes_in_nodes(depth, nodes).get();
+        BOOST_REQUIRE_LT(fetched.size(), 100);
+        for (auto& h : local) {
+            if (!std::ranges::binary_search(nodes, repair::hash_tree_node_of(h, depth))) {
+                fetched.insert(h);
+            }
+        }
+        BOOST_REQUIRE(fetched == remote);
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
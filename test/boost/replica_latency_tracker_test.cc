@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/sleep.hh>
+
+#include "service/replica_latency_tracker.hh"
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_replica_latency_estimates_are_per_replica) {
+    service::replica_latency_tracker tracker;
+    auto fast = locator::host_id::create_random_id();
+    auto slow = locator::host_id::create_random_id();
+    auto unknown = locator::host_id::create_random_id();
+
+    for (int i = 0; i < 200; ++i) {
+        tracker.add(fast, 1000us);
+        tracker.add(slow, i % 10 ? 1000us : 50000us);
+    }
+
+    BOOST_REQUIRE(!tracker.median(unknown));
+    BOOST_REQUIRE(!tracker.percentile(unknown, 0.99));
+
+    auto fast_median = tracker.median(fast);
+    auto slow_median = tracker.median(slow);
+    BOOST_REQUIRE(fast_median && slow_median);
+    BOOST_REQUIRE_EQUAL(fast_median->count(), slow_median->count());
+    BOOST_REQUIRE_GE(fast_median->count(), 1000);
+    BOOST_REQUIRE_LT(fast_median->count(), 1300);
+
+    // The outliers of the slow replica only show in its own tail.
+    auto fast_p99 = tracker.percentile(fast, 0.99);
+    auto slow_p99 = tracker.percentile(slow, 0.99);
+    BOOST_REQUIRE(fast_p99 && slow_p99);
+    BOOST_REQUIRE_LT(fast_p99->count(), 1300);
+    BOOST_REQUIRE_GE(slow_p99->count(), 50000);
+
+    auto latencies = tracker.get_replica_latencies();
+    BOOST_REQUIRE_EQUAL(latencies.size(), 2);
+
+    tracker.remove(slow);
+    BOOST_REQUIRE(!tracker.median(slow));
+    BOOST_REQUIRE_EQUAL(tracker.get_replica_latencies().size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_replica_latency_needs_enough_samples) {
+    service::replica_latency_tracker tracker;
+    auto replica = locator::host_id::create_random_id();
+
+    for (int64_t i = 0; i < service::replica_latency_tracker::min_samples / 2; ++i) {
+        tracker.add(replica, 1000us);
+    }
+    BOOST_REQUIRE(!tracker.median(replica));
+    BOOST_REQUIRE(!tracker.percentile(replica, 0.99));
+    BOOST_REQUIRE_EQUAL(tracker.get_replica_latencies().size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_replica_latency_decays_by_time) {
+    service::replica_latency_tracker tracker;
+    auto replica = locator::host_id::create_random_id();
+
+    for (int i = 0; i < 60; ++i) {
+        tracker.add(replica, 1000us);
+    }
+    // Refreshing the estimates often doesn't decay them any faster.
+    for (int i = 0; i < 20; ++i) {
+        BOOST_REQUIRE(tracker.percentile(replica, 0.5 + i * 0.01));
+    }
+    BOOST_REQUIRE(tracker.median(replica));
+
+    // But time does, even without any refresh in between.
+    seastar::sleep(3s).get();
+    BOOST_REQUIRE(!tracker.median(replica));
+}
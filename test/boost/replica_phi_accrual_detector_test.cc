@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "service/replica_phi_accrual_detector.hh"
+
+using namespace std::chrono_literals;
+using detector = service::replica_phi_accrual_detector;
+
+// Sends a request and gets its response `rtt` later, `count` times.
+static detector::clock_type::time_point exchange(detector& d, locator::host_id replica, detector::clock_type::time_point now,
+        std::chrono::microseconds rtt, unsigned count) {
+    for (unsigned i = 0; i < count; ++i) {
+        d.request_sent(replica, now);
+        now += rtt;
+        d.response_received(replica, now);
+        now += 1ms;
+    }
+    return now;
+}
+
+BOOST_AUTO_TEST_CASE(test_phi_accrual_detector_suspects_unresponsive_replica) {
+    detector d;
+    auto replica = locator::host_id::create_random_id();
+    auto now = detector::clock_type::now();
+
+    // Too few samples
+    now = exchange(d, replica, now, 1ms, detector::min_samples - 1);
+    d.request_sent(replica, now);
+    BOOST_REQUIRE_EQUAL(d.phi(replica, now + 10s), 0);
+    d.response_received(replica, now + 1ms);
+    now += 2ms;
+
+    now = exchange(d, replica, now, 1ms, 100);
+
+    // Not awaited, so not suspected, however long it stays idle
+    BOOST_REQUIRE_EQUAL(d.phi(replica, now + 10s), 0);
+
+    d.request_sent(replica, now);
+    BOOST_REQUIRE(!d.suspected(replica, 8, now + 10ms));
+    BOOST_REQUIRE(!d.suspected(replica, 8, now + 100ms));
+    // Suspected well within half a second
+    BOOST_REQUIRE(d.suspected(replica, 8, now + 400ms));
+    // phi only grows with the time waited
+    BOOST_REQUIRE_LT(d.phi(replica, now + 200ms), d.phi(replica, now + 300ms));
+
+    // A later request doesn't restart the wait
+    d.request_sent(replica, now + 300ms);
+    BOOST_REQUIRE(d.suspected(replica, 8, now + 400ms));
+
+    // A response clears the suspicion
+    d.response_received(replica, now + 500ms);
+    BOOST_REQUIRE(!d.suspected(replica, 8, now + 500ms));
+}
+
+BOOST_AUTO_TEST_CASE(test_phi_accrual_detector_adapts_to_slow_replica) {
+    detector d;
+    auto fast = locator::host_id::create_random_id();
+    auto slow = locator::host_id::create_random_id();
+    auto now = detector::clock_type::now();
+
+    now = exchange(d, fast, now, 1ms, 100);
+    now = exchange(d, slow, now, 500ms, 100);
+
+    d.request_sent(fast, now);
+    d.request_sent(slow, now);
+    // A replica which usually takes half a second to respond isn't suspected
+    // when a fast one would be.
+    BOOST_REQUIRE(d.suspected(fast, 8, now + 400ms));
+    BOOST_REQUIRE(!d.suspected(slow, 8, now + 400ms));
+    BOOST_REQUIRE(d.suspected(slow, 8, now + 2s));
+
+    d.remove(fast);
+    BOOST_REQUIRE_EQUAL(d.phi(fast, now + 10s), 0);
+}
@@ -45,6 +45,8 @@
 #include "readers/empty.hh"
 #include <seastar/testing/thread_test_case.hh>
 
+#include <deque>
+
 using namespace std::chrono_literals;
 
 static schema_ptr make_schema() {
@@ -146,6 +148,83 @@ SEASTAR_TEST_CASE(test_cache_delegates_to_underlying) {
     });
 }
 
+SEASTAR_TEST_CASE(test_recently_used_partitions) {
+    return seastar::async([] {
+        auto s = make_schema();
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(make_empty_mutation_source()), tracker);
+
+        std::vector<dht::decorated_key> keys;
+        for (int i = 0; i < 10; i++) {
+            auto m = make_new_mutation(s);
+            keys.emplace_back(m.decorated_key());
+            cache.populate(m);
+        }
+        cache.touch(keys[3]);
+
+        auto recently_used = [&] (size_t max_rows) {
+            std::vector<dht::decorated_key> listed;
+            tracker.for_each_recently_used_partition(max_rows, [&] (const cache_entry& ce) {
+                listed.push_back(ce.key());
+                return stop_iteration::no;
+            });
+            return listed;
+        };
+
+        // Each partition is listed once, the most recently used first.
+        auto listed = recently_used(std::numeric_limits<size_t>::max());
+        BOOST_REQUIRE_EQUAL(listed.size(), keys.size());
+        BOOST_REQUIRE(listed[0].equal(*s, keys[3]));
+        BOOST_REQUIRE(listed[1].equal(*s, keys[9]));
+        BOOST_REQUIRE(listed.back().equal(*s, keys[0]));
+
+        // The walk is bounded by the number of rows.
+        listed = recently_used(1);
+        BOOST_REQUIRE_EQUAL(listed.size(), 1);
+        BOOST_REQUIRE(listed[0].equal(*s, keys[3]));
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cold_partition_compression) {
+    simple_schema ss;
+    auto s = ss.schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    auto pk = ss.make_pkey(0);
+    mutation m(s, pk);
+    for (int i = 0; i < 100; ++i) {
+        ss.add_row(m, ss.make_ckey(i), "a value which compresses well");
+    }
+
+    cache_tracker tracker;
+    row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+    cache.populate(m);
+
+    // Just populated partitions are hot.
+    cache.compress_cold_partitions().get();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+
+    cache.compress_cold_partitions().get();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 1);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 0);
+    BOOST_REQUIRE_LT(tracker.get_stats().compressed_partition_bytes, tracker.get_stats().compressed_partition_uncompressed_bytes);
+
+    assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(pk)))
+        .produces(m)
+        .produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_decompressions, 1);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+
+    // Compressed partitions go away with the cached data.
+    cache.compress_cold_partitions().get();
+    cache.compress_cold_partitions().get();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 1);
+    cache.invalidate(row_cache::external_updater([] {})).get();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partitions, 0);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().compressed_partition_bytes, 0);
+}
+
 SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     return seastar::async([] {
         auto s = make_schema();
@@ -167,6 +246,91 @@ SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     });
 }
 
+SEASTAR_TEST_CASE(test_frequency_admission_populates_only_repeatedly_read_partitions) {
+    return seastar::async([] {
+        auto s = schema_builder(make_schema())
+            .set_caching_options(caching_options::from_map({{"admission", "frequency"}}))
+            .build();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto m = make_new_mutation(s);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+
+        // The first read, a scan, only records the access.
+        assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_admission_rejections, 1);
+
+        auto range = dht::partition_range::make_singular(m.decorated_key());
+        assert_that(cache.make_reader(s, semaphore.make_permit(), range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_admissions, 1);
+
+        auto hits = tracker.get_stats().partition_hits;
+        assert_that(cache.make_reader(s, semaphore.make_permit(), range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_hits, hits + 1);
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_segmented_lru_protects_entries_touched_more_than_once) {
+    struct test_evictable final : public evictable {
+        std::vector<int>& evicted;
+        int id;
+        test_evictable(std::vector<int>& evicted, int id) : evicted(evicted), id(id) {}
+        void on_evicted() noexcept override { evicted.push_back(id); }
+    };
+
+    std::vector<int> evicted;
+    std::deque<test_evictable> entries;
+    utils::updateable_value_source<double> protected_fraction(0.5);
+    lru l(utils::updateable_value<double>(protected_fraction));
+
+    for (int i = 0; i < 4; ++i) {
+        l.add(entries.emplace_back(evicted, i));
+    }
+    // Touched for the second time, becomes protected.
+    l.touch(entries[0]);
+    BOOST_REQUIRE_EQUAL(l.probation_size(), 3);
+    BOOST_REQUIRE_EQUAL(l.protected_size(), 1);
+
+    // A sweep over entries which are never touched again.
+    for (int i = 4; i < 8; ++i) {
+        l.add(entries.emplace_back(evicted, i));
+    }
+    for (int i = 0; i < 7; ++i) {
+        l.evict();
+    }
+    BOOST_REQUIRE(evicted == (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+    BOOST_REQUIRE_EQUAL(l.protected_size(), 1);
+
+    // The protected segment is limited, its least recently used entries are demoted.
+    evicted.clear();
+    for (int i = 8; i < 11; ++i) {
+        l.add(entries.emplace_back(evicted, i));
+        l.touch(entries.back());
+    }
+    BOOST_REQUIRE_EQUAL(l.protected_size(), 2);
+    BOOST_REQUIRE_EQUAL(l.probation_size(), 2);
+    l.evict();
+    l.evict();
+    BOOST_REQUIRE(evicted == (std::vector<int>{0, 8}));
+
+    // With no protected segment the LRU is a plain one.
+    protected_fraction.set(0);
+    evicted.clear();
+    l.add(entries.emplace_back(evicted, 11));
+    l.touch(entries[9]);
+    l.evict_all();
+    BOOST_REQUIRE(evicted == (std::vector<int>{11, 10, 9}));
+}
+
 class partition_counting_reader final : public delegating_reader {
     int& _counter;
     bool _count_fill_buffer = true;
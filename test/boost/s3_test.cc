@@ -701,6 +701,44 @@ SEASTAR_THREAD_TEST_CASE(test_chunked_download_data_source_proxy) {
     test_download_data_source(make_proxy_client, true, 3 * 1024);
 }
 
+void test_parallel_download_data_source(const client_maker_function& client_maker) {
+    const sstring name(fmt::format("/{}/testparalleldatasourceobject-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
+
+    semaphore mem(16 << 20);
+    auto cln = client_maker(mem);
+    auto close_client = deferred_close(*cln);
+    auto delete_object = deferred_delete_object(cln, name);
+
+    // Not a multiple of the part size, so that the last part is short
+    auto data = tests::random::get_bytes(1_MiB + 1234);
+    cln->put_object(name, temporary_buffer<char>(reinterpret_cast<const char*>(data.data()), data.size())).get();
+
+    auto check = [&] (s3::range r, size_t expected_offset, size_t expected_size) {
+        testlog.info("Download range {}", r);
+        auto in = input_stream<char>(cln->make_parallel_download_source(name, r, 4, 64_KiB));
+        auto close = seastar::deferred_close(in);
+        auto buf = seastar::util::read_entire_stream_contiguous(in).get();
+        BOOST_REQUIRE_EQUAL(buf.size(), expected_size);
+        BOOST_REQUIRE_EQUAL(memcmp(buf.begin(), data.data() + expected_offset, expected_size), 0);
+    };
+
+    check(s3::full_range, 0, data.size());
+    check(s3::range{100_KiB + 7}, 100_KiB + 7, data.size() - 100_KiB - 7);
+    check(s3::range{1000, 300_KiB}, 1000, 300_KiB);
+    check(s3::range{5, 10}, 5, 10);
+    // Depleted memory doesn't stall the read
+    auto units = get_units(mem, mem.available_units()).get();
+    check(s3::full_range, 0, data.size());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_parallel_download_data_source_minio) {
+    test_parallel_download_data_source(make_minio_client);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_parallel_download_data_source_proxy) {
+    test_parallel_download_data_source(make_proxy_client);
+}
+
 void test_chunked_download_data_source(const client_maker_function& client_maker, size_t object_size) {
     const sstring base_name(fmt::format("test_object-{}", ::getpid()));
 
@@ -1053,6 +1053,45 @@ SEASTAR_TEST_CASE(test_schema_digest_does_not_change_with_keyspace_storage_optio
         });
 }
 
+// The cached schema digest, which only reads again what schema changes wrote,
+// must match the one computed over the whole schema.
+SEASTAR_TEST_CASE(test_incremental_schema_digest) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        using namespace db::schema_tables;
+        auto check = [&] (std::string_view change) {
+            with_merge_lock([&] () -> future<> {
+                auto sf = e.local_db().features().cluster_schema_features();
+                auto cached = co_await calculate_schema_digest(e.get_storage_proxy(), sf);
+                auto full = co_await calculate_schema_digest(e.get_storage_proxy(), sf, std::not_fn(&is_system_keyspace));
+                testlog.info("after {}: cached {}, full {}", change, cached, full);
+                BOOST_REQUIRE_EQUAL(cached, full);
+            }).get();
+        };
+
+        check("start");
+        for (auto& stmt : {
+                "create keyspace ks1 with replication = { 'class' : 'NetworkTopologyStrategy', 'replication_factor' : 1 }",
+                "create table ks1.t1 (pk int primary key, v int)",
+                "create table ks1.t2 (pk int, ck int, v int, primary key (pk, ck))",
+                "create type ks1.ut (a int, b text)",
+                "alter table ks1.t1 add w text",
+                "alter table ks1.t2 drop v",
+                "create index on ks1.t1 (v)",
+                "create materialized view ks1.mv as select * from ks1.t2 where ck is not null primary key (ck, pk)",
+                "drop materialized view ks1.mv",
+                "alter table ks1.t1 with comment = 'c'",
+                "drop table ks1.t2",
+                "alter keyspace ks1 with replication = { 'class' : 'NetworkTopologyStrategy', 'replication_factor' : 1 } and durable_writes = false",
+                "create keyspace ks2 with replication = { 'class' : 'NetworkTopologyStrategy', 'replication_factor' : 1 }",
+                "create table ks2.t1 (pk int primary key, v int)",
+                "drop keyspace ks1",
+        }) {
+            e.execute_cql(stmt).get();
+            check(stmt);
+        }
+    });
+}
+
 // Regression test, ensuring people don't forget to set the null sharder
 // for newly added schema tables.
 SEASTAR_TEST_CASE(test_schema_tables_use_null_sharder) {
@@ -116,10 +116,13 @@ static mutation_reader sstable_reader(shared_sstable sst, schema_ptr s, reader_p
 class strategy_control_for_test : public strategy_control {
     bool _has_ongoing_compaction;
     std::optional<std::vector<shared_sstable>> _candidates_opt;
+    std::optional<uint64_t> _available_disk_space;
 public:
-    explicit strategy_control_for_test(bool has_ongoing_compaction, std::optional<std::vector<shared_sstable>> candidates) noexcept
+    explicit strategy_control_for_test(bool has_ongoing_compaction, std::optional<std::vector<shared_sstable>> candidates,
+            std::optional<uint64_t> available_disk_space = std::nullopt) noexcept
         : _has_ongoing_compaction(has_ongoing_compaction)
-        , _candidates_opt(candidates) {}
+        , _candidates_opt(candidates)
+        , _available_disk_space(available_disk_space) {}
 
     bool has_ongoing_compaction(compaction_group_view& table_s) const noexcept override {
         return _has_ongoing_compaction;
@@ -134,6 +137,10 @@ class strategy_control_for_test : public strategy_control {
         auto main_set = co_await t.main_sstable_set();
         co_return main_set->all_sstable_runs();
     }
+
+    std::optional<uint64_t> available_disk_space() const noexcept override {
+        return _available_disk_space;
+    }
 };
 
 static std::unique_ptr<strategy_control> make_strategy_control_for_test(bool has_ongoing_compaction, std::optional<std::vector<shared_sstable>> candidates = std::nullopt) {
@@ -1888,6 +1895,77 @@ SEASTAR_TEST_CASE(time_window_strategy_size_tiered_behavior_correctness) {
     });
 }
 
+SEASTAR_TEST_CASE(time_window_strategy_incremental_window_compaction) {
+    using namespace std::chrono;
+
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "time_window_strategy")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::time_window);
+        auto s = builder.build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_insert = [&] (partition_key key, api::timestamp_type t) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), t);
+            return m;
+        };
+
+        BOOST_REQUIRE_THROW(time_window_compaction_strategy_options({{incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, "0"}}),
+                exceptions::configuration_exception);
+
+        std::map<sstring, sstring> options = {{incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, "1"}};
+        time_window_compaction_strategy twcs(options);
+        std::map<api::timestamp_type, std::vector<shared_sstable>> buckets; // windows
+        int min_threshold = 4;
+        int max_threshold = 32;
+        auto window_size = duration_cast<seconds>(hours(1));
+
+        auto add_new_sstable_to_bucket = [&] (api::timestamp_type ts, api::timestamp_type window_ts) {
+            auto key = partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(ts))});
+            auto mut = make_insert(std::move(key), ts);
+            auto sst = make_sstable_containing(sst_gen, {std::move(mut)});
+            auto bound = time_window_compaction_strategy::get_window_lower_bound(window_size, window_ts);
+            buckets[bound].push_back(std::move(sst));
+        };
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+
+        api::timestamp_type current_window_ts = api::timestamp_clock::now().time_since_epoch().count();
+        api::timestamp_type past_window_ts = current_window_ts - duration_cast<microseconds>(seconds(2L * 3600L)).count();
+        auto past_bound = time_window_compaction_strategy::get_window_lower_bound(window_size, past_window_ts);
+        auto control = make_strategy_control_for_test(false);
+
+        add_new_sstable_to_bucket(0, past_window_ts);
+        add_new_sstable_to_bucket(1, past_window_ts);
+        // let the strategy know about the past window while it's active.
+        twcs.newest_bucket(cf.as_compaction_group_view(), *control, buckets, min_threshold, max_threshold, past_bound);
+        add_new_sstable_to_bucket(2, current_window_ts);
+        auto now = time_window_compaction_strategy::get_window_lower_bound(window_size, current_window_ts);
+
+        // the closed window is compacted into a single run.
+        auto major = twcs.newest_bucket(cf.as_compaction_group_view(), *control, buckets, min_threshold, max_threshold, now);
+        BOOST_REQUIRE_EQUAL(major.size(), 2);
+        // a fragment for every partition.
+        auto ret = compact_sstables(env, sstables::compaction_descriptor(std::move(major), 0, 1), cf, sst_gen).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 2);
+        BOOST_REQUIRE(ret.new_sstables[0]->run_identifier() == ret.new_sstables[1]->run_identifier());
+        buckets[past_bound] = std::move(ret.new_sstables);
+
+        // the fragments of the run are not compacted again.
+        BOOST_REQUIRE(twcs.newest_bucket(cf.as_compaction_group_view(), *control, buckets, min_threshold, max_threshold, now).empty());
+
+        // min_threshold runs of similar size are compacted, whole.
+        for (api::timestamp_type t = 10; t < 10 + min_threshold - 1; t++) {
+            add_new_sstable_to_bucket(t, past_window_ts);
+        }
+        BOOST_REQUIRE_EQUAL(twcs.newest_bucket(cf.as_compaction_group_view(), *control, buckets, min_threshold, max_threshold, now).size(), size_t(min_threshold + 1));
+    });
+}
+
 static void check_min_max_column_names(const sstable_ptr& sst, std::vector<bytes> min_components, std::vector<bytes> max_components) {
     const auto& st = sst->get_stats_metadata();
     BOOST_TEST_MESSAGE(fmt::format("min {}/{} max {}/{}", st.min_column_names.elements.size(), min_components.size(), st.max_column_names.elements.size(), max_components.size()));
@@ -1968,6 +2046,73 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(size_tiered_fits_job_to_disk_space_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto cf = env.make_table_for_tests();
+    auto stop_cf = deferred_stop(cf);
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, cf.schema()->compaction_strategy_options());
+
+    // All in the same bucket, as they are below min_sstable_size
+    std::vector<sstables::shared_sstable> candidates;
+    const auto keys = tests::generate_partition_keys(2, cf->schema());
+    for (uint64_t size : {1000, 10, 20, 30, 40}) {
+        auto sst = env.make_sstable(cf->schema());
+        sstables::test(sst).set_values(keys[0].key(), keys[1].key(), stats_metadata{}, size);
+        candidates.push_back(std::move(sst));
+    }
+    auto get_job = [&] (std::optional<uint64_t> available_disk_space) {
+        auto control = strategy_control_for_test(false, candidates, available_disk_space);
+        return cs.get_sstables_for_compaction(cf.as_compaction_group_view(), control).get();
+    };
+
+    BOOST_REQUIRE_EQUAL(get_job(std::nullopt).sstables.size(), candidates.size());
+    BOOST_REQUIRE_EQUAL(get_job(1100).sstables.size(), candidates.size());
+
+    // The largest sstable is dropped, the job still meets min_threshold
+    auto desc = get_job(100);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4);
+    BOOST_REQUIRE_EQUAL(desc.sstables_size(), 100);
+    BOOST_REQUIRE_EQUAL(desc.estimated_output_disk_space(), 100);
+
+    // Below min_threshold, the whole bucket is left for the compaction manager to postpone
+    BOOST_REQUIRE_EQUAL(get_job(60).sstables.size(), candidates.size());
+  });
+}
+
+SEASTAR_TEST_CASE(compaction_manager_disk_space_reservation_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto& cm = env.test_compaction_manager().get_compaction_manager();
+
+    // Not limited until the budget is set
+    BOOST_REQUIRE(!cm.available_disk_space());
+    BOOST_REQUIRE(cm.try_reserve_disk_space(std::numeric_limits<uint64_t>::max() / 2));
+    BOOST_REQUIRE_EQUAL(cm.reserved_disk_space(), 0);
+
+    cm.set_disk_space_budget(100);
+    auto r1 = cm.try_reserve_disk_space(60);
+    BOOST_REQUIRE(r1);
+    BOOST_REQUIRE_EQUAL(cm.reserved_disk_space(), 60);
+    BOOST_REQUIRE_EQUAL(*cm.available_disk_space(), 40);
+    BOOST_REQUIRE(!cm.try_reserve_disk_space(50));
+
+    auto r2 = cm.try_reserve_disk_space(40);
+    BOOST_REQUIRE(r2);
+    BOOST_REQUIRE_EQUAL(*cm.available_disk_space(), 0);
+
+    r1->release();
+    BOOST_REQUIRE_EQUAL(cm.reserved_disk_space(), 40);
+    BOOST_REQUIRE(cm.try_reserve_disk_space(50));
+
+    // The budget may shrink below the reservations
+    cm.set_disk_space_budget(10);
+    BOOST_REQUIRE_EQUAL(*cm.available_disk_space(), 0);
+    r2.reset();
+    BOOST_REQUIRE_EQUAL(cm.reserved_disk_space(), 0);
+    BOOST_REQUIRE_EQUAL(*cm.available_disk_space(), 10);
+    cm.set_disk_space_budget(std::nullopt);
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (std::string_view cf, sstables::compaction_strategy_type cst) {
@@ -2037,6 +2182,8 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
         auto descriptor = get_sstables_for_compaction(cs, stcs_table.as_compaction_group_view(), { sst }).get();
         BOOST_REQUIRE(descriptor.sstables.size() == 1);
         BOOST_REQUIRE(descriptor.sstables.front() == sst);
+        BOOST_REQUIRE(descriptor.estimated_droppable_tombstones);
+        BOOST_REQUIRE(std::fabs(*descriptor.estimated_droppable_tombstones - expired_keys) <= 0.1 * total_keys);
 
         // Makes sure that get_sstables_for_compaction() is called with a compaction_group_view which will provide
         // the correct LCS state.
@@ -2060,6 +2207,7 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
         descriptor = get_sstables_for_compaction(cs, twcs_table.as_compaction_group_view(), { sst }).get();
         BOOST_REQUIRE(descriptor.sstables.size() == 1);
         BOOST_REQUIRE(descriptor.sstables.front() == sst);
+        BOOST_REQUIRE(descriptor.estimated_droppable_tombstones);
 
         // sstable with droppable ratio of 0.3 won't be included due to threshold
         {
@@ -2262,6 +2410,129 @@ SEASTAR_TEST_CASE(sstable_cleanup_correctness_test) {
     });
 }
 
+SEASTAR_TEST_CASE(compaction_with_parallel_subranges_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_insert = [&] (const dht::decorated_key& key, int32_t value, api::timestamp_type ts) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(value), ts);
+            return m;
+        };
+
+        const auto total_partitions = 1000U;
+        auto keys = tests::generate_partition_keys(total_partitions, s);
+        std::ranges::sort(keys, dht::decorated_key::less_comparator(s));
+        utils::chunked_vector<mutation> old_mutations;
+        utils::chunked_vector<mutation> new_mutations;
+        for (auto i = 0U; i < total_partitions; i++) {
+            old_mutations.push_back(make_insert(keys[i], 1, 1));
+            if (i % 2 == 0) {
+                new_mutations.push_back(make_insert(keys[i], 2, 2));
+            }
+        }
+        auto sst1 = make_sstable_containing(sst_gen, old_mutations);
+        auto sst2 = make_sstable_containing(sst_gen, new_mutations);
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+
+        auto descriptor = sstables::compaction_descriptor({sst1, sst2});
+        descriptor.parallel_subranges = 4;
+        auto ret = compact_sstables(env, std::move(descriptor), cf, sst_gen).get();
+
+        // Every sub-range is written separately, and their outputs don't overlap.
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 4);
+        auto new_sstables = ret.new_sstables;
+        std::ranges::sort(new_sstables, [&] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(*s, b->get_first_decorated_key()) < 0;
+        });
+        for (size_t i = 1; i < new_sstables.size(); ++i) {
+            BOOST_REQUIRE(new_sstables[i - 1]->get_last_decorated_key().tri_compare(*s, new_sstables[i]->get_first_decorated_key()) < 0);
+            BOOST_REQUIRE(new_sstables[i]->run_identifier() == new_sstables[0]->run_identifier());
+        }
+
+        auto expected = old_mutations;
+        for (auto& m : new_mutations) {
+            auto it = std::ranges::find_if(expected, [&] (const mutation& e) { return e.decorated_key().equal(*s, m.decorated_key()); });
+            it->apply(m);
+        }
+        auto sst_set = make_lw_shared<sstable_set>(env.make_sstable_set(cf->get_compaction_strategy(), s));
+        for (auto& sst : new_sstables) {
+            sst_set->insert(sst);
+        }
+        auto reader = sst_set->make_range_sstable_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice(), nullptr,
+                ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
+        auto assertions = assert_that(std::move(reader));
+        for (auto& m : expected) {
+            assertions.produces(m);
+        }
+        assertions.produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(compaction_passes_through_non_overlapping_sstables_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_insert = [&] (const dht::decorated_key& key, int32_t value) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(value), api::timestamp_type(1));
+            return m;
+        };
+        auto make_sstable = [&] (const std::vector<dht::decorated_key>& keys, size_t first, size_t last) {
+            utils::chunked_vector<mutation> mutations;
+            for (auto i = first; i < last; ++i) {
+                mutations.push_back(make_insert(keys[i], i));
+            }
+            return make_sstable_containing(sst_gen, mutations);
+        };
+
+        auto keys = tests::generate_partition_keys(300, s);
+        std::ranges::sort(keys, dht::decorated_key::less_comparator(s));
+        // The first sstable overlaps no other, the other two overlap each other.
+        auto sst1 = make_sstable(keys, 0, 100);
+        auto sst2 = make_sstable(keys, 100, 200);
+        auto sst3 = make_sstable(keys, 150, 300);
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+
+        auto ret = compact_sstables(env, sstables::compaction_descriptor({sst1, sst2, sst3}, 1, 1024*1024*1024), cf, sst_gen).get();
+
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 2);
+        for (auto& sst : ret.new_sstables) {
+            BOOST_REQUIRE_EQUAL(sst->get_sstable_level(), 1);
+        }
+        auto passed_through = std::ranges::find_if(ret.new_sstables, [&] (const shared_sstable& sst) {
+            return sst->get_first_decorated_key().equal(*s, keys[0]);
+        });
+        BOOST_REQUIRE(passed_through != ret.new_sstables.end());
+        BOOST_REQUIRE_EQUAL((*passed_through)->data_size(), sst1->data_size());
+        BOOST_REQUIRE_EQUAL(sst1->get_sstable_level(), 0);
+
+        auto sst_set = make_lw_shared<sstable_set>(env.make_sstable_set(cf->get_compaction_strategy(), s));
+        for (auto& sst : ret.new_sstables) {
+            sst_set->insert(sst);
+        }
+        auto reader = sst_set->make_range_sstable_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice(), nullptr,
+                ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
+        auto assertions = assert_that(std::move(reader));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            assertions.produces(make_insert(keys[i], i));
+        }
+        assertions.produces_end_of_stream();
+    });
+}
+
 future<> foreach_compaction_group_view_with_thread(table_for_tests& table, std::function<void(compaction::compaction_group_view&)> action) {
     return table->parallel_foreach_compaction_group_view([action] (compaction::compaction_group_view& ts) {
         return seastar::async([action, &ts] {
@@ -4156,15 +4427,23 @@ SEASTAR_TEST_CASE(sstable_needs_cleanup_test) {
 
         auto sst = sst_gen(keys[0], keys[1]);
         BOOST_REQUIRE(!needs_cleanup(sst, local_ranges));
+        BOOST_REQUIRE(!is_fully_unowned(sst, local_ranges));
 
         auto sst2 = sst_gen(keys[2], keys[2]);
         BOOST_REQUIRE(needs_cleanup(sst2, local_ranges));
+        BOOST_REQUIRE(is_fully_unowned(sst2, local_ranges));
 
         auto sst3 = sst_gen(keys[0], keys[6]);
         BOOST_REQUIRE(needs_cleanup(sst3, local_ranges));
+        BOOST_REQUIRE(!is_fully_unowned(sst3, local_ranges));
+
+        auto sst4 = sst_gen(keys[2], keys[3]);
+        BOOST_REQUIRE(needs_cleanup(sst4, local_ranges));
+        BOOST_REQUIRE(!is_fully_unowned(sst4, local_ranges));
 
         auto sst5 = sst_gen(keys[7], keys[7]);
         BOOST_REQUIRE(needs_cleanup(sst5, local_ranges));
+        BOOST_REQUIRE(is_fully_unowned(sst5, local_ranges));
     }
   });
 }
@@ -4791,6 +5070,132 @@ SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     });
 }
 
+SEASTAR_TEST_CASE(test_twcs_single_key_reader_slice_pruning) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "twcs_single_key_reader_slice_pruning")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::time_window);
+        auto s = builder.build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto ck = [&] (int32_t v) {
+            return clustering_key::from_single_value(*s, int32_type->decompose(v));
+        };
+        auto make_row = [&] (int32_t pk, int32_t c) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(ck(c), to_bytes("v"), int32_t(0), api::new_timestamp());
+            return m;
+        };
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, {});
+        auto set = cs.make_sstable_set(cf.as_compaction_group_view());
+        std::optional<dht::decorated_key> dkey;
+        for (auto c : {0, 10, 20, 30}) {
+            auto sst = make_sstable_containing(sst_gen, {make_row(0, c)});
+            dkey = sst->get_first_decorated_key();
+            set.insert(std::move(sst));
+        }
+
+        auto pr = dht::partition_range::make_singular(*dkey);
+        auto& cf_stats = cf.cf_stats();
+
+        utils::estimated_histogram eh;
+        auto read = [&] (query::clustering_range range) {
+            eh.clear();
+            auto slice = partition_slice_builder(*s).with_range(std::move(range)).build();
+            auto checked_by_ck = cf_stats.sstables_checked_by_clustering_filter;
+            auto surviving_after_ck = cf_stats.surviving_sstables_after_clustering_filter;
+            {
+                auto reader = set.create_single_key_sstable_reader(
+                        &*cf, s, env.make_reader_permit(), eh, pr, slice,
+                        tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no,
+                        ::mutation_reader::forwarding::no);
+                auto close_reader = deferred_close(reader);
+                while (reader().get());
+            }
+            BOOST_REQUIRE_EQUAL(eh.count(), 1);
+            return std::pair(cf_stats.sstables_checked_by_clustering_filter - checked_by_ck,
+                    cf_stats.surviving_sstables_after_clustering_filter - surviving_after_ck);
+        };
+
+        // The sstables starting after the end of the slice are not even checked.
+        BOOST_REQUIRE(read(query::clustering_range::make({ck(5)}, {ck(15)})) == std::pair<int64_t, int64_t>(2, 1));
+        BOOST_REQUIRE_EQUAL(eh.mean(), 1);
+        BOOST_REQUIRE(read(query::clustering_range::make({ck(0)}, {ck(20)})) == std::pair<int64_t, int64_t>(3, 3));
+        BOOST_REQUIRE_EQUAL(eh.mean(), 3);
+        BOOST_REQUIRE(read(query::clustering_range::make_starting_with({ck(25)})) == std::pair<int64_t, int64_t>(4, 1));
+        BOOST_REQUIRE_EQUAL(eh.mean(), 1);
+        BOOST_REQUIRE(read(query::clustering_range::make_ending_with({ck(-1)})) == std::pair<int64_t, int64_t>(0, 0));
+    });
+}
+
+SEASTAR_TEST_CASE(test_single_key_reader_latest_row) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "single_key_reader_latest_row")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type)
+                .build();
+        auto query_schema = s->make_reversed();
+
+        auto sst_gen = env.make_sst_factory(s);
+        auto pk = partition_key::from_single_value(*s, int32_type->decompose(0));
+        auto ck = [&] (int32_t v) {
+            return clustering_key::from_single_value(*s, int32_type->decompose(v));
+        };
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {});
+        auto set = cs.make_sstable_set(cf.as_compaction_group_view());
+        mutation merged(s, pk);
+        for (auto first : {0, 3, 6}) {
+            mutation m(s, pk);
+            for (auto c = first; c < first + 3; ++c) {
+                m.set_clustered_cell(ck(c), to_bytes("v"), int32_t(c), api::new_timestamp());
+            }
+            merged.apply(m);
+            set.insert(make_sstable_containing(sst_gen, {std::move(m)}));
+        }
+        // The latest rows are deleted in a newer sstable.
+        mutation m(s, pk);
+        m.partition().apply_delete(*s, range_tombstone(ck(7), bound_kind::incl_start, ck(8), bound_kind::incl_end,
+                tombstone(api::new_timestamp(), gc_clock::now())));
+        merged.apply(m);
+        auto sst = make_sstable_containing(sst_gen, {std::move(m)});
+        auto dkey = sst->get_first_decorated_key();
+        set.insert(std::move(sst));
+
+        auto pr = dht::partition_range::make_singular(dkey);
+        auto slice = partition_slice_builder(*query_schema)
+                .reversed()
+                .with_partition_row_limit(1)
+                .build();
+
+        utils::estimated_histogram eh;
+        auto reader = set.create_single_key_sstable_reader(
+                &*cf, query_schema, env.make_reader_permit(), eh, pr, slice,
+                tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no,
+                ::mutation_reader::forwarding::no);
+        auto close_reader = deferred_close(reader);
+
+        auto result = read_mutation_from_mutation_reader(reader).get();
+        BOOST_REQUIRE(result);
+        assert_that(*result).is_equal_to_compacted(reverse(merged));
+        BOOST_REQUIRE(!reader().get());
+        BOOST_REQUIRE_EQUAL(eh.mean(), 4);
+    });
+}
+
 SEASTAR_TEST_CASE(max_ongoing_compaction_test) {
     return test_env::do_with_async([] (test_env& env) {
         BOOST_REQUIRE(smp::count == 1);
@@ -5315,6 +5720,36 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_incremental) {
     return run_controller_test(sstables::compaction_strategy_type::incremental);
 }
 
+SEASTAR_THREAD_TEST_CASE(compaction_controller_read_latency_feedback_test) {
+    auto sg = create_scheduling_group("compaction_controller_test", 100).get();
+    auto destroy_sg = defer([&] () noexcept {
+        destroy_scheduling_group(sg).get();
+    });
+
+    float backlog = 1.0;
+    auto latency = std::chrono::microseconds(20000);
+    auto target = std::chrono::microseconds(10000);
+    compaction_controller controller(sg, 0, std::chrono::milliseconds(1), [&] { return backlog; });
+    auto stop_controller = defer([&] () noexcept {
+        controller.shutdown().get();
+    });
+    controller.set_read_latency_feedback([&] { return latency; }, [&] { return target; });
+
+    // Slow reads cut the shares, down to a bound.
+    BOOST_REQUIRE(eventually_true([&] { return controller.read_latency_throttle() < 0.11; }));
+    sleep(std::chrono::milliseconds(20)).get();
+    BOOST_REQUIRE_GE(controller.read_latency_throttle(), 0.1);
+
+    // And the shares recover with the reads.
+    latency = std::chrono::microseconds(1000);
+    BOOST_REQUIRE(eventually_true([&] { return controller.read_latency_throttle() == 1.0; }));
+
+    latency = std::chrono::microseconds(20000);
+    BOOST_REQUIRE(eventually_true([&] { return controller.read_latency_throttle() < 1.0; }));
+    target = std::chrono::microseconds(0);
+    BOOST_REQUIRE(eventually_true([&] { return controller.read_latency_throttle() == 1.0; }));
+}
+
 SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
     return test_env::do_with_async([] (test_env& env) {
         constexpr size_t all_files = 64;
@@ -6159,4 +6594,79 @@ SEASTAR_TEST_CASE(splitting_compaction_test) {
     });
 }
 
+SEASTAR_TEST_CASE(offstrategy_round_size_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder(some_keyspace, some_column_family).with_column("p1", utf8_type, column_kind::partition_key).build();
+        const auto keys = tests::generate_partition_keys(8, s);
+        constexpr uint64_t sst_size = 1024 * 1024;
+
+        auto make_sst = [&] (size_t k0, size_t k1, uint32_t level) {
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values_for_leveled_strategy(sst_size, level, 0 /* max_timestamp */, keys[k0].key(), keys[k1].key());
+            return sst;
+        };
+        auto disjoint = [&] (uint32_t level) {
+            // Out of token order, to check the round takes the lowest first keys.
+            return std::vector<shared_sstable>{make_sst(6, 7, level), make_sst(0, 1, level), make_sst(4, 5, level), make_sst(2, 3, level)};
+        };
+
+        // A level 0 job is trimmed, the sstables with the lowest first keys are kept.
+        {
+            auto ssts = disjoint(0);
+            compaction_descriptor desc(ssts);
+            BOOST_REQUIRE(compaction::trim_reshape_job_to_round_size(desc, s, 2 * sst_size));
+            BOOST_REQUIRE(desc.sstables == (std::vector<shared_sstable>{ssts[1], ssts[3]}));
+        }
+
+        // A round compacts at least two sstables.
+        {
+            auto ssts = disjoint(0);
+            compaction_descriptor desc(ssts);
+            BOOST_REQUIRE(compaction::trim_reshape_job_to_round_size(desc, s, sst_size / 2));
+            BOOST_REQUIRE(desc.sstables == (std::vector<shared_sstable>{ssts[1], ssts[3]}));
+        }
+
+        // A job within the round size is left alone.
+        {
+            compaction_descriptor desc(disjoint(0));
+            BOOST_REQUIRE(!trim_reshape_job_to_round_size(desc, s, 4 * sst_size));
+            BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4);
+        }
+
+        // A job with disjoint input into a leveled level is trimmed.
+        {
+            auto ssts = disjoint(0);
+            compaction_descriptor desc(ssts, 2);
+            BOOST_REQUIRE(compaction::trim_reshape_job_to_round_size(desc, s, 3 * sst_size));
+            BOOST_REQUIRE(desc.sstables == (std::vector<shared_sstable>{ssts[1], ssts[3], ssts[2]}));
+        }
+
+        // A job compacting an overlapping leveled level is done in a single round.
+        {
+            std::vector<shared_sstable> ssts{make_sst(0, 3, 1), make_sst(2, 5, 1), make_sst(4, 7, 1)};
+            compaction_descriptor desc(ssts, 1);
+            BOOST_REQUIRE(!trim_reshape_job_to_round_size(desc, s, sst_size));
+            BOOST_REQUIRE_EQUAL(desc.sstables.size(), 3);
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(offstrategy_round_priority_test) {
+    int a, b;
+    std::unordered_map<const void*, double> waiters;
+    BOOST_REQUIRE(!has_more_urgent_offstrategy_waiter(waiters, 1.0));
+
+    waiters[&a] = 2.0;
+    waiters[&b] = 5.0;
+    // The table whose reads touch the most sstables goes first.
+    BOOST_REQUIRE(compaction::has_more_urgent_offstrategy_waiter(waiters, 3.0));
+    BOOST_REQUIRE(!has_more_urgent_offstrategy_waiter(waiters, 5.0));
+    BOOST_REQUIRE(!has_more_urgent_offstrategy_waiter(waiters, 8.0));
+
+    // Ties keep the FIFO order of the semaphore.
+    waiters.erase(&b);
+    BOOST_REQUIRE(!has_more_urgent_offstrategy_waiter(waiters, 2.0));
+    return make_ready_future<>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
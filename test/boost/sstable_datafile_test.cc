@@ -108,6 +108,9 @@ SEASTAR_TEST_CASE(datafile_generation_09) {
         BOOST_REQUIRE(::memcmp(&sst1_s.header, &sst2_s.header, sizeof(summary::header)) == 0);
         BOOST_REQUIRE(sst1_s.positions == sst2_s.positions);
         BOOST_REQUIRE(sst1_s.entries == sst2_s.entries);
+        for (size_t i = 0; i < sst1_s.entries.size(); ++i) {
+            BOOST_REQUIRE(sst1_s.key_at(i) == sst2_s.key_at(i));
+        }
         BOOST_REQUIRE(sst1_s.first_key.value == sst2_s.first_key.value);
         BOOST_REQUIRE(sst1_s.last_key.value == sst2_s.last_key.value);
 
@@ -462,6 +465,37 @@ SEASTAR_TEST_CASE(test_counter_write) {
     });
 }
 
+SEASTAR_TEST_CASE(test_load_many_sstables) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        std::vector<mutation> muts;
+        std::vector<shared_sstable> ssts;
+        for (int i = 0; i < 20; ++i) {
+            mutation m(s, ss.make_pkey(i));
+            ss.add_row(m, ss.make_ckey(i), "val");
+            ssts.push_back(env.make_sstable(s));
+            make_sstable_containing(ssts.back(), {m});
+            muts.push_back(std::move(m));
+        }
+
+        std::vector<shared_sstable> loaded;
+        for (auto& sst : ssts) {
+            loaded.push_back(env.make_sstable(s, sst->generation(), sst->get_version()));
+        }
+        env.manager().load_sstables(loaded, s->get_sharder(), sstable_open_config{}).get();
+
+        for (size_t i = 0; i < loaded.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(loaded[i]->get_estimated_key_count(), ssts[i]->get_estimated_key_count());
+            // The data file is much smaller than a read buffer.
+            assert_that(sstable_mutation_reader(loaded[i], s, env.make_reader_permit()))
+                .produces(muts[i])
+                .produces_end_of_stream();
+        }
+    });
+}
+
 static shared_sstable sstable_for_overlapping_test(test_env& env, const schema_ptr& schema,
         const partition_key& first_key, const partition_key& last_key, uint32_t level = 0) {
     auto sst = env.make_sstable(schema);
@@ -1896,6 +1930,60 @@ SEASTAR_TEST_CASE(sstable_set_incremental_selector) {
   });
 }
 
+// Leveled sstables which are disjoint with the others of their level are
+// looked up by binary search, the rest in the interval map. Check that both
+// select the same sstables as a brute force overlap check.
+SEASTAR_TEST_CASE(sstable_set_disjoint_levels) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto s = schema_builder(some_keyspace, some_column_family).with_column("p1", utf8_type, column_kind::partition_key).build();
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::leveled, s->compaction_strategy_options());
+    const auto keys = tests::generate_partition_keys(64, s);
+
+    sstable_set set = env.make_sstable_set(cs, s);
+    std::vector<shared_sstable> ssts;
+    auto add = [&] (size_t k0, size_t k1, uint32_t level) {
+        auto sst = sstable_for_overlapping_test(env, s, keys[k0].key(), keys[k1].key(), level);
+        set.insert(sst);
+        ssts.push_back(std::move(sst));
+    };
+    // Disjoint sstables in L1 and L2, with gaps between them.
+    for (size_t k = 0; k + 1 < keys.size(); k += 4) {
+        add(k, k + 1, 1);
+    }
+    for (size_t k = 1; k + 2 < keys.size(); k += 8) {
+        add(k, k + 2, 2);
+    }
+    // An L1 sstable overlapping with others of the level, and an L0 one.
+    add(5, 9, 1);
+    add(20, 30, 0);
+    set.erase(ssts[3]);
+    ssts.erase(ssts.begin() + 3);
+
+    auto expected = [&] (const dht::partition_range& range) {
+        return ssts | std::views::filter([&] (const shared_sstable& sst) {
+            auto sst_range = dht::partition_range::make({sst->get_first_decorated_key()}, {sst->get_last_decorated_key()});
+            return range.overlaps(sst_range, dht::ring_position_comparator(*s));
+        }) | std::ranges::to<std::unordered_set>();
+    };
+    auto check_select = [&] (const dht::partition_range& range) {
+        testlog.debug("checking range {}", range);
+        BOOST_REQUIRE(set.select(range) | std::ranges::to<std::unordered_set>() == expected(range));
+    };
+
+    sstable_set::incremental_selector sel = set.make_incremental_selector();
+    for (size_t k = 0; k < keys.size(); ++k) {
+        auto range = dht::partition_range::make_singular(keys[k]);
+        check_select(range);
+        BOOST_REQUIRE(sel.select(keys[k]).sstables | std::ranges::to<std::unordered_set>() == expected(range));
+        if (k + 3 < keys.size()) {
+            check_select(dht::partition_range::make({keys[k], false}, {keys[k + 3], false}));
+        }
+    }
+    check_select(dht::partition_range::make_starting_with({keys[40]}));
+    check_select(dht::partition_range::make_ending_with({keys[10], false}));
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_set_erase) {
   return test_env::do_with_async([] (test_env& env) {
     auto s = schema_builder(some_keyspace, some_column_family).with_column("p1", utf8_type, column_kind::partition_key).build();
@@ -2298,6 +2386,9 @@ SEASTAR_TEST_CASE(summary_rebuild_sanity) {
         BOOST_REQUIRE(::memcmp(&s1.header, &s2.header, sizeof(summary::header)) == 0);
         BOOST_REQUIRE(s1.positions == s2.positions);
         BOOST_REQUIRE(s1.entries == s2.entries);
+        for (size_t i = 0; i < s1.entries.size(); ++i) {
+            BOOST_REQUIRE(s1.key_at(i) == s2.key_at(i));
+        }
         BOOST_REQUIRE(s1.first_key.value == s2.first_key.value);
         BOOST_REQUIRE(s1.last_key.value == s2.last_key.value);
     });
@@ -2354,6 +2445,45 @@ SEASTAR_TEST_CASE(sstable_partition_estimation_sanity_test) {
     });
 }
 
+SEASTAR_TEST_CASE(test_partition_count_estimator) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "partition_count_estimator")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+        const column_definition& col = *s->get_column_definition("value");
+
+        auto make_sstable = [&] (int first, int last) {
+            utils::chunked_vector<mutation> mutations;
+            for (auto i = first; i < last; i++) {
+                mutation m(s, partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(i))}));
+                m.set_clustered_cell(clustering_key::make_empty(), col, make_atomic_cell(int32_type, int32_type->decompose(i)));
+                mutations.push_back(std::move(m));
+            }
+            return make_sstable_containing(env.make_sstable(s), mutations);
+        };
+
+        auto sst1 = make_sstable(0, 10000);
+        auto sst2 = make_sstable(5000, 15000);
+
+        auto estimator1 = sst1->get_partition_count_estimator();
+        auto estimator2 = sst2->get_partition_count_estimator();
+        BOOST_REQUIRE(estimator1);
+        BOOST_REQUIRE(estimator2);
+        BOOST_REQUIRE_CLOSE(estimator1->estimate(), 10000, 10);
+
+        // The union of overlapping sstables is estimated, not their sum
+        estimator1->merge(*estimator2);
+        BOOST_REQUIRE_CLOSE(estimator1->estimate(), 15000, 10);
+
+        // Bytes of other formats are rejected
+        auto bytes = estimator2->get_bytes();
+        BOOST_REQUIRE(hll::HyperLogLog::from_bytes(std::span(bytes.get(), bytes.size())));
+        BOOST_REQUIRE(!hll::HyperLogLog::from_bytes(std::span(bytes.get(), bytes.size() - 1)));
+        bytes.get_write()[3] = 3;
+        BOOST_REQUIRE(!hll::HyperLogLog::from_bytes(std::span(bytes.get(), bytes.size())));
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_timestamp_metadata_correcness_with_negative) {
     BOOST_REQUIRE(smp::count == 1);
     return test_env::do_with_async([] (test_env& env) {
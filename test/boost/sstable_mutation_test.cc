@@ -1468,6 +1468,105 @@ SEASTAR_TEST_CASE(test_static_compact_tables_are_read) {
     });
 }
 
+SEASTAR_TEST_CASE(test_reader_column_projection) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            auto s = schema_builder("ks", "test")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("s1", utf8_type, column_kind::static_column)
+                .with_column("v1", int32_type)
+                .with_column("v2", utf8_type)
+                .build();
+
+            const auto& s1 = *s->get_column_definition("s1");
+            const auto& v1 = *s->get_column_definition("v1");
+            const auto& v2 = *s->get_column_definition("v2");
+            const api::timestamp_type ts = 1;
+            const auto ttl = std::chrono::duration_cast<gc_clock::duration>(std::chrono::hours(1));
+            const auto expiry = gc_clock::now() + ttl;
+
+            auto ck1 = clustering_key::from_exploded(*s, {int32_type->decompose(1)});
+            auto ck2 = clustering_key::from_exploded(*s, {int32_type->decompose(2)});
+
+            mutation m(s, partition_key::from_exploded(*s, {int32_type->decompose(0)}));
+            m.set_static_cell(s1, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose("static")));
+            m.set_clustered_cell(ck1, v1, atomic_cell::make_live(*int32_type, ts, int32_type->decompose(1)));
+            m.set_clustered_cell(ck1, v2, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose("unselected")));
+            // This row has no row marker and no selected cell, it is alive only
+            // thanks to the unselected cell.
+            m.set_clustered_cell(ck2, v2, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose("unselected"), expiry, ttl));
+
+            auto sst = make_sstable_containing(env.make_sstable(s, version), {m});
+            auto slice = partition_slice_builder(*s).with_no_static_columns().with_regular_column("v1").build();
+
+            // The unselected cells keep their metadata, only their values are dropped.
+            mutation expected(s, m.decorated_key());
+            expected.set_static_cell(s1, atomic_cell::make_live(*utf8_type, ts, bytes_view()));
+            expected.set_clustered_cell(ck1, v1, atomic_cell::make_live(*int32_type, ts, int32_type->decompose(1)));
+            expected.set_clustered_cell(ck1, v2, atomic_cell::make_live(*utf8_type, ts, bytes_view()));
+            expected.set_clustered_cell(ck2, v2, atomic_cell::make_live(*utf8_type, ts, bytes_view(), expiry, ttl));
+
+            assert_that(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, slice, nullptr,
+                        streamed_mutation::forwarding::no, mutation_reader::forwarding::no, default_read_monitor(),
+                        integrity_check::no, project_columns::yes))
+                .produces(expected)
+                .produces_end_of_stream();
+
+            // Without projection, the values are read.
+            assert_that(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, slice))
+                .produces(m)
+                .produces_end_of_stream();
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_range_read_resumes_from_saved_positions) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (const auto version : writable_sstable_versions) {
+            simple_schema ss;
+            auto s = ss.schema();
+            utils::chunked_vector<mutation> muts;
+            for (auto& dk : ss.make_pkeys(20)) {
+                auto& m = muts.emplace_back(s, dk);
+                ss.add_row(m, ss.make_ckey(0), "v");
+            }
+            auto sst = make_sstable_containing(env.make_sstable(s, version), muts);
+            auto resumed_reads = [] { return sstables_stats::get_shard_stats().resumed_range_partition_reads; };
+
+            auto permit = env.make_reader_permit();
+            permit.enable_sstable_resume_positions();
+            {
+                auto rd = assert_that(sst->make_reader(s, permit, query::full_partition_range, s->full_slice()));
+                for (size_t i = 0; i < 5; ++i) {
+                    rd.produces(muts[i]);
+                }
+            }
+
+            // Resuming after the last partition read starts from the saved position.
+            auto before = resumed_reads();
+            auto pr = dht::partition_range::make_starting_with({muts[4].decorated_key(), false});
+            {
+                auto rd = assert_that(sst->make_reader(s, permit, pr, s->full_slice()));
+                rd.produces(muts[5]);
+                rd.produces(muts[6]);
+            }
+            BOOST_REQUIRE_EQUAL(resumed_reads(), before + 1);
+
+            // The positions don't cover a range with another end, the index is used.
+            pr = dht::partition_range::make({muts[6].decorated_key(), false}, {muts[10].decorated_key(), true});
+            {
+                auto rd = assert_that(sst->make_reader(s, permit, pr, s->full_slice()));
+                for (size_t i = 7; i <= 10; ++i) {
+                    rd.produces(muts[i]);
+                }
+                rd.produces_end_of_stream();
+            }
+            BOOST_REQUIRE_EQUAL(resumed_reads(), before + 1);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(writer_handles_subsequent_range_tombstone_changes_without_tombstones) {
     // This test exposes a problem of a peculiar setup of tombstones that trigger
     // a mutation fragment stream validation exception if stream is compacted.
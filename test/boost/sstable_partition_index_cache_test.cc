@@ -12,6 +12,7 @@
 #include <seastar/testing/thread_test_case.hh>
 
 #include "sstables/partition_index_cache.hh"
+#include "sstables/mx/bsearch_clustered_cursor.hh"
 #include "test/lib/simple_schema.hh"
 
 using namespace sstables;
@@ -272,3 +273,59 @@ SEASTAR_THREAD_TEST_CASE(test_evict_gently) {
 
     cache.evict_gently().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_promoted_index_block_caching) {
+    using block_type = mc::cached_promoted_index::promoted_index_block;
+    ::lru lru;
+    simple_schema s;
+    logalloc::region r;
+    promoted_index_block_cache_stats stats;
+    mc::promoted_index_block_cache cache(stats, lru, r);
+
+    block_type b0(0, 16);
+    BOOST_REQUIRE(!cache.get(100, b0));
+    BOOST_REQUIRE_EQUAL(stats.misses, 1);
+
+    // Blocks with only the start parsed are cached too.
+    b0.start.emplace(position_in_partition::for_key(s.make_ckey(1)));
+    cache.put(100, b0);
+    BOOST_REQUIRE_EQUAL(stats.populations, 1);
+    auto used_l1 = stats.used_bytes;
+
+    r.full_compaction();
+
+    block_type b1(0, 0);
+    BOOST_REQUIRE(cache.get(100, b1));
+    BOOST_REQUIRE_EQUAL(b1.offset, 16);
+    BOOST_REQUIRE(b1.start);
+    BOOST_REQUIRE(!b1.end);
+    // Same block index in another partition.
+    block_type other(0, 0);
+    BOOST_REQUIRE(!cache.get(200, other));
+
+    b1.end.emplace(position_in_partition::for_key(s.make_ckey(2)));
+    b1.data_file_offset = 1024;
+    b1.width = 512;
+    cache.put(100, b1);
+    BOOST_REQUIRE_EQUAL(stats.populations, 1);
+    BOOST_REQUIRE_GT(stats.used_bytes, used_l1);
+
+    block_type b2(0, 0);
+    BOOST_REQUIRE(cache.get(100, b2));
+    BOOST_REQUIRE(b2.end);
+    BOOST_REQUIRE_EQUAL(b2.data_file_offset, 1024);
+    BOOST_REQUIRE_EQUAL(b2.width, 512);
+    BOOST_REQUIRE_EQUAL(stats.hits, 2);
+
+    with_allocator(r.allocator(), [&] {
+        lru.evict_all();
+    });
+    BOOST_REQUIRE_EQUAL(stats.evictions, 1);
+    BOOST_REQUIRE_EQUAL(stats.used_bytes, 0);
+    block_type b3(0, 0);
+    BOOST_REQUIRE(!cache.get(100, b3));
+
+    cache.put(100, b2);
+    cache.evict_gently().get();
+    BOOST_REQUIRE_EQUAL(stats.evictions, 2);
+}
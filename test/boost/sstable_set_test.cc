@@ -21,6 +21,7 @@
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/mutation_assertions.hh"
 #include "readers/from_mutations.hh"
 #include "service/storage_service.hh"
 
@@ -274,6 +275,72 @@ SEASTAR_TEST_CASE(test_sstable_set_fast_forward_by_cache_reader_simulation) {
     });
 }
 
+SEASTAR_TEST_CASE(test_sstable_set_reader_by_runs) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        auto pks = tests::generate_partition_keys(8, s);
+        auto make_mutation = [&] (int key, int ckey) {
+            auto mut = mutation(s, pks[key]);
+            ss.add_row(mut, ss.make_ckey(ckey), "val");
+            return mut;
+        };
+        auto make_sstable = [&] (std::vector<mutation> muts, sstables::run_id run) {
+            sstable_writer_config cfg = env.manager().configure_writer("");
+            cfg.run_identifier = run;
+            return make_sstable_easy(env, make_mutation_reader_from_mutations(s, env.make_reader_permit(), std::move(muts)), cfg);
+        };
+
+        // A run of three sstables, and an sstable overlapping all of them.
+        auto run = sstables::run_id::create_random_id();
+        auto set = make_lw_shared<sstable_set>(std::make_unique<partitioned_sstable_set>(s, full_range));
+        set->insert(make_sstable({make_mutation(0, 0), make_mutation(1, 0)}, run));
+        set->insert(make_sstable({make_mutation(3, 0), make_mutation(4, 0)}, run));
+        set->insert(make_sstable({make_mutation(6, 0), make_mutation(7, 0)}, run));
+        set->insert(make_sstable({make_mutation(1, 1), make_mutation(4, 1), make_mutation(5, 1)}, sstables::run_id::create_random_id()));
+
+        auto expected = [&] (int key) {
+            auto mut = mutation(s, pks[key]);
+            if (key != 5) {
+                mut.apply(make_mutation(key, 0));
+            }
+            if (key == 1 || key == 4 || key == 5) {
+                mut.apply(make_mutation(key, 1));
+            }
+            return mut;
+        };
+        auto check_reads = [&] (mutation_reader& reader, std::vector<int> keys) {
+            for (auto key : keys) {
+                auto mopt = read_mutation_from_mutation_reader(reader).get();
+                BOOST_REQUIRE(mopt);
+                assert_that(*mopt).is_equal_to(expected(key));
+            }
+        };
+
+        {
+            auto reader = set->make_local_shard_sstable_reader_by_runs(s, env.make_reader_permit(), query::full_partition_range, s->full_slice(),
+                    nullptr, ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
+            auto close_r = deferred_close(reader);
+            check_reads(reader, {0, 1, 3, 4, 5, 6, 7});
+            BOOST_REQUIRE(!read_mutation_from_mutation_reader(reader).get());
+        }
+
+        auto first_range = dht::partition_range::make({pks[0]}, {pks[1]});
+        auto reader = set->make_local_shard_sstable_reader_by_runs(s, env.make_reader_permit(), first_range, s->full_slice(),
+                nullptr, ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::yes);
+        auto close_r = deferred_close(reader);
+        check_reads(reader, {0, 1});
+        BOOST_REQUIRE(!read_mutation_from_mutation_reader(reader).get());
+
+        // Starts in the middle of the second sstable of the run.
+        auto second_range = dht::partition_range::make({pks[4]}, {pks[6]});
+        reader.fast_forward_to(second_range).get();
+        check_reads(reader, {4, 5, 6});
+        BOOST_REQUIRE(!read_mutation_from_mutation_reader(reader).get());
+    });
+}
+
 static future<> guarantee_all_tablet_replicas_on_shard0(cql_test_env& env) {
     auto& ss = env.get_storage_service().local();
     auto& stm = env.get_shared_token_metadata().local();
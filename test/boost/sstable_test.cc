@@ -96,7 +96,7 @@ future<> summary_query(schema_ptr schema, sstring path, sstables::generation_typ
     return test_using_reusable_sst(std::move(schema), path, generation, [] (test_env& env, sstable_ptr ptr) {
         auto entry = sstables::test(ptr).read_summary_entry(Position).get();
         BOOST_REQUIRE(entry.position == EntryPosition);
-        BOOST_REQUIRE(entry.key.size() == EntryKeySize);
+        BOOST_REQUIRE(ptr->get_summary().key_at(Position).size() == EntryKeySize);
     });
 }
 
@@ -162,6 +162,35 @@ SEASTAR_TEST_CASE(missing_summary_first_last_sane) {
     });
 }
 
+SEASTAR_TEST_CASE(summary_keys_front_coding) {
+    summary s;
+    std::vector<bytes> keys;
+    // Long keys with a shared prefix, several blocks and a partial last one.
+    const auto prefix = bytes(200, bytes::value_type('k'));
+    const size_t nr_keys = 3 * summary::key_restart_interval + 5;
+    for (size_t i = 0; i < nr_keys; ++i) {
+        keys.push_back(prefix + to_bytes(fmt::format("{:04}", i)));
+        s.add_entry(dht::token::from_int64(i), keys.back(), i * 10);
+    }
+    // Lookups must work both before and after sealing.
+    BOOST_REQUIRE(s.key_at(nr_keys - 1) == keys.back());
+    s.seal_keys();
+
+    BOOST_REQUIRE_EQUAL(s.entries.size(), nr_keys);
+    summary::key_cursor cursor(s);
+    for (size_t i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(s.key_at(i) == keys[i]);
+        BOOST_REQUIRE(bytes(cursor.next()) == keys[i]);
+        BOOST_REQUIRE_EQUAL(s.entries[i].position, i * 10);
+    }
+    summary::key_cursor mid_cursor(s, summary::key_restart_interval + 3);
+    BOOST_REQUIRE(bytes(mid_cursor.next()) == keys[summary::key_restart_interval + 3]);
+
+    BOOST_REQUIRE_EQUAL(s.key_bytes(), nr_keys * keys.front().size());
+    BOOST_REQUIRE_LT(s.memory_footprint(), s.key_bytes());
+    return make_ready_future<>();
+}
+
 static future<std::pair<sstable_ptr, sstable_ptr>> do_write_sst(test_env& env, schema_ptr schema, sstring load_dir, sstring write_dir, sstables::generation_type generation) {
     auto sst = co_await env.reusable_sst(std::move(schema), load_dir, generation);
     sstable_generation_generator gen;
@@ -212,6 +241,9 @@ SEASTAR_TEST_CASE(check_summary_func) {
         BOOST_REQUIRE(::memcmp(&sst1_s.header, &sst2_s.header, sizeof(summary::header)) == 0);
         BOOST_REQUIRE(sst1_s.positions == sst2_s.positions);
         BOOST_REQUIRE(sst1_s.entries == sst2_s.entries);
+        for (size_t i = 0; i < sst1_s.entries.size(); ++i) {
+            BOOST_REQUIRE(sst1_s.key_at(i) == sst2_s.key_at(i));
+        }
         BOOST_REQUIRE(sst1_s.first_key.value == sst2_s.first_key.value);
         BOOST_REQUIRE(sst1_s.last_key.value == sst2_s.last_key.value);
     });
@@ -282,7 +314,7 @@ SEASTAR_TEST_CASE(find_key_map) {
         kk.push_back(make_map_value(map_type, map));
 
         auto key = sstables::key::from_deeply_exploded(*s, kk);
-        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary.entries, key) == 0);
+        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary, key) == 0);
     });
 }
 
@@ -303,7 +335,7 @@ SEASTAR_TEST_CASE(find_key_set) {
         kk.push_back(make_set_value(set_type, set));
 
         auto key = sstables::key::from_deeply_exploded(*s, kk);
-        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary.entries, key) == 0);
+        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary, key) == 0);
     });
 }
 
@@ -324,7 +356,7 @@ SEASTAR_TEST_CASE(find_key_list) {
         kk.push_back(make_list_value(list_type, list));
 
         auto key = sstables::key::from_deeply_exploded(*s, kk);
-        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary.entries, key) == 0);
+        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary, key) == 0);
     });
 }
 
@@ -342,7 +374,7 @@ SEASTAR_TEST_CASE(find_key_composite) {
         kk.push_back(data_value(b2));
 
         auto key = sstables::key::from_deeply_exploded(*s, kk);
-        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary.entries, key) == 0);
+        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary, key) == 0);
     });
 }
 
@@ -350,10 +382,9 @@ SEASTAR_TEST_CASE(all_in_place) {
     return test_using_reusable_sst(uncompressed_schema(), "test/resource/sstables/bigsummary", 76, [] (auto& env, auto sstp) {
         auto& summary = sstables::test(sstp)._summary();
 
-        int idx = 0;
-        for (auto& e: summary.entries) {
-            auto key = sstables::key::from_bytes(bytes(e.key));
-            BOOST_REQUIRE(sstables::binary_search(sstp->get_schema()->get_partitioner(), summary.entries, key) == idx++);
+        for (size_t idx = 0; idx < summary.entries.size(); ++idx) {
+            auto key = sstables::key::from_bytes(summary.key_at(idx));
+            BOOST_REQUIRE(sstables::binary_search(sstp->get_schema()->get_partitioner(), summary, key) == int(idx));
         }
     });
 }
@@ -383,7 +414,7 @@ SEASTAR_TEST_CASE(not_find_key_composite_bucket0) {
 
         auto key = sstables::key::from_deeply_exploded(*s, kk);
         // (result + 1) * -1 -1 = 0
-        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary.entries, key) == -2);
+        BOOST_REQUIRE(sstables::binary_search(s->get_partitioner(), summary, key) == -2);
     });
 }
 
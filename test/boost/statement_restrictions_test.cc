@@ -132,7 +132,17 @@ SEASTAR_TEST_CASE(slice_one_column) {
         BOOST_CHECK_EQUAL(slice_parse("c='123'", e), std::vector{singular({T("123")})});
         BOOST_CHECK_EQUAL(slice_parse("c='a' and c='a'", e), std::vector{singular({T("a")})});
         BOOST_CHECK_EQUAL(slice_parse("c='a' and c='b'", e), query::clustering_row_ranges{});
-        BOOST_CHECK_EQUAL(slice_parse("c like '123'", e), std::vector{open_ended});
+        BOOST_CHECK_EQUAL(slice_parse("c like '123'", e), std::vector{left_closed_right_open({T("123")}, {T("124")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%'", e), std::vector{left_closed_right_open({T("ab")}, {T("ac")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'a_c'", e), std::vector{left_closed_right_open({T("a")}, {T("b")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'a\\%%'", e), std::vector{left_closed_right_open({T("a%")}, {T("a&")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like '%a'", e), std::vector{open_ended});
+        BOOST_CHECK_EQUAL(slice_parse("c like '_a'", e), std::vector{open_ended});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%' and c like 'abc%'", e), std::vector{left_closed_right_open({T("abc")}, {T("abd")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%' and c > 'abc'", e), std::vector{both_open({T("abc")}, {T("ac")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%' and c like '%a'", e), std::vector{left_closed_right_open({T("ab")}, {T("ac")})});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%' and c != 'abc'", e), std::vector{open_ended});
+        BOOST_CHECK_EQUAL(slice_parse("c like 'ab%' and c like 'b%'", e), query::clustering_row_ranges{});
 
         BOOST_CHECK_EQUAL(slice_parse("c in ('x','y','z')", e),
                           (std::vector{singular({T("x")}), singular({T("y")}), singular({T("z")})}));
@@ -157,7 +167,9 @@ SEASTAR_TEST_CASE(slice_two_columns) {
 
         BOOST_CHECK_EQUAL(slice_parse("c1=123 and c2='321'", e), std::vector{singular({I(123), T("321")})});
         BOOST_CHECK_EQUAL(slice_parse("c1=123", e), std::vector{singular({I(123)})});
-        BOOST_CHECK_EQUAL(slice_parse("c1=123 and c2 like '321'", e), std::vector{singular({I(123)})});
+        BOOST_CHECK_EQUAL(slice_parse("c1=123 and c2 like '321'", e), std::vector{
+                left_closed_right_open({I(123), T("321")}, {I(123), T("322")})});
+        BOOST_CHECK_EQUAL(slice_parse("c1=123 and c2 like '%321'", e), std::vector{singular({I(123)})});
         BOOST_CHECK_EQUAL(slice_parse("c1=123 and c1=123", e), std::vector{singular({I(123)})});
         BOOST_CHECK_EQUAL(slice_parse("c2='abc'", e), std::vector{open_ended});
         BOOST_CHECK_EQUAL(slice_parse("c1=0 and c1=1 and c2='a'", e), query::clustering_row_ranges{});
@@ -187,6 +199,10 @@ SEASTAR_TEST_CASE(slice_two_columns) {
         BOOST_CHECK_EQUAL(slice_parse("c1 in (1)", e), std::vector{singular({I(1)})});
         BOOST_CHECK_EQUAL(slice_parse("c1 in ()", e), query::clustering_row_ranges{});
         BOOST_CHECK_EQUAL(slice_parse("c2 like 'a' and c1 in (1,2)", e),
+                          (std::vector{
+                              left_closed_right_open({I(1), T("a")}, {I(1), T("b")}),
+                              left_closed_right_open({I(2), T("a")}, {I(2), T("b")})}));
+        BOOST_CHECK_EQUAL(slice_parse("c2 like '_' and c1 in (1,2)", e),
                           (std::vector{singular({I(1)}), singular({I(2)})}));
 
         BOOST_CHECK_EQUAL(slice_parse("c1=123 and c2>'321'", e), std::vector{
@@ -366,6 +382,69 @@ SEASTAR_TEST_CASE(slice_single_column_mixed_order) {
     });
 }
 
+SEASTAR_TEST_CASE(bound_primary_key) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "create table ks.t(p1 int, p2 text, c1 int, c2 text, v int, "
+                "primary key((p1, p2), c1, c2)) with clustering order by (c1 desc, c2 asc)");
+        auto s = e.local_db().find_schema("ks", "t");
+        auto analyze = [&] (std::string_view where_clause) {
+            prepare_context ctx;
+            return restrictions::analyze_statement_restrictions(
+                    e.data_dictionary(),
+                    s,
+                    statements::statement_type::SELECT,
+                    expr::conjunction{boolean_factors(cql3::util::where_clause_to_relations(where_clause, cql3::dialect{}))},
+                    ctx,
+                    /*contains_only_static_columns=*/false,
+                    /*for_view=*/false,
+                    /*allow_filtering=*/true,
+                    restrictions::check_indexes::yes);
+        };
+
+        BOOST_REQUIRE(analyze("p1=? and p2=?").has_bound_primary_key());
+        BOOST_REQUIRE(analyze("p2=? and p1=? and c1=? and c2=?").has_bound_primary_key());
+        BOOST_REQUIRE(analyze("p1=? and p2=? and v=?").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("p1=? and p2=? and c1=?").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("p1=? and p2=? and c1=? and c2>?").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("p1=? and p2='a'").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("p1=? and p2 in ?").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("p1=? and p2=? and (c1, c2)=?").has_bound_primary_key());
+        BOOST_REQUIRE(!analyze("token(p1, p2)=?").has_bound_primary_key());
+
+        // The key ranges are the same as those of the restrictions evaluated in the general way.
+        auto bound = analyze("p2=? and p1=? and c1=? and c2=?");
+        auto literal = analyze("p2='a' and p1=1 and c1=2 and c2='b'");
+        BOOST_REQUIRE(!literal.has_bound_primary_key());
+        query_options options(raw_value_vector_with_unset({
+                raw_value::make_value(T("a")), raw_value::make_value(I(1)),
+                raw_value::make_value(I(2)), raw_value::make_value(T("b"))}));
+        auto ranges = bound.get_partition_key_ranges(options);
+        auto expected_ranges = literal.get_partition_key_ranges(query_options({}));
+        BOOST_REQUIRE_EQUAL(ranges.size(), 1);
+        BOOST_REQUIRE_EQUAL(expected_ranges.size(), 1);
+        BOOST_REQUIRE(ranges[0].is_singular());
+        BOOST_REQUIRE(ranges[0].equal(expected_ranges[0], dht::ring_position_comparator(*s)));
+        BOOST_CHECK_EQUAL(bound.get_clustering_bounds(options), literal.get_clustering_bounds(query_options({})));
+        BOOST_CHECK_EQUAL(bound.get_clustering_bounds(options), std::vector{singular({I(2), T("b")})});
+
+        // Nothing matches NULL.
+        query_options null_pk(raw_value_vector_with_unset({
+                raw_value::make_value(T("a")), raw_value::make_null(),
+                raw_value::make_value(I(2)), raw_value::make_value(T("b"))}));
+        BOOST_REQUIRE(bound.get_partition_key_ranges(null_pk).empty());
+        query_options null_ck(raw_value_vector_with_unset({
+                raw_value::make_value(T("a")), raw_value::make_value(I(1)),
+                raw_value::make_null(), raw_value::make_value(T("b"))}));
+        BOOST_REQUIRE(bound.get_clustering_bounds(null_ck).empty());
+
+        // Bound values are still validated.
+        query_options invalid(raw_value_vector_with_unset({
+                raw_value::make_value(T("a")), raw_value::make_value(T("bad")),
+                raw_value::make_value(I(2)), raw_value::make_value(T("b"))}));
+        BOOST_REQUIRE_THROW(bound.get_partition_key_ranges(invalid), exceptions::invalid_request_exception);
+    });
+}
+
 // Currently expression doesn't have operator==().
 // Implementing it is ugly, because there are shared pointers and the term base class.
 // For testing purposes checking stringified expressions is enough.
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <fmt/ranges.h>
+#include <seastar/core/thread.hh>
+#undef SEASTAR_TESTING_MAIN
+#include <seastar/testing/test_case.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "test/lib/cql_test_env.hh"
+#include "streaming/stream_manager.hh"
+#include "streaming/stream_transfer_task.hh"
+#include "dht/token.hh"
+
+BOOST_AUTO_TEST_SUITE(stream_manager_test)
+
+static dht::token_range make_range(int64_t start, int64_t end) {
+    return dht::token_range(dht::token_range::bound(dht::token::from_int64(start), false),
+            dht::token_range::bound(dht::token::from_int64(end), true));
+}
+
+BOOST_AUTO_TEST_CASE(test_split_ranges_for_streams) {
+    // More ranges than streams: contiguous ranges are grouped evenly.
+    dht::token_range_vector ranges;
+    for (int64_t i = 0; i < 8; ++i) {
+        ranges.push_back(make_range(i * 100, (i + 1) * 100));
+    }
+    auto groups = streaming::split_ranges_for_streams(ranges, 4);
+    BOOST_REQUIRE_EQUAL(groups.size(), 4);
+    dht::token_range_vector merged;
+    for (auto& g : groups) {
+        BOOST_REQUIRE_EQUAL(g.size(), 2);
+        merged.insert(merged.end(), g.begin(), g.end());
+    }
+    BOOST_REQUIRE(merged == ranges);
+
+    // A single range, e.g. of a tablet, is halved until there's one per stream.
+    groups = streaming::split_ranges_for_streams({make_range(0, 1000)}, 4);
+    BOOST_REQUIRE_EQUAL(groups.size(), 4);
+    auto prev_end = dht::token::from_int64(0);
+    for (auto& g : groups) {
+        BOOST_REQUIRE_EQUAL(g.size(), 1);
+        BOOST_REQUIRE(g.front().start()->value() == prev_end);
+        prev_end = g.front().end()->value();
+    }
+    BOOST_REQUIRE(prev_end == dht::token::from_int64(1000));
+
+    // A range which can't be halved stays in a single stream.
+    groups = streaming::split_ranges_for_streams({make_range(0, 1)}, 4);
+    BOOST_REQUIRE_EQUAL(groups.size(), 1);
+    BOOST_REQUIRE_EQUAL(groups.front().size(), 1);
+
+    // Nothing to stream.
+    groups = streaming::split_ranges_for_streams({}, 4);
+    BOOST_REQUIRE_EQUAL(groups.size(), 1);
+    BOOST_REQUIRE(groups.front().empty());
+}
+
+SEASTAR_TEST_CASE(test_stream_manager_aggregated_metrics) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& sm = e.get_stream_manager().local();
+        auto plan1 = streaming::plan_id{utils::make_random_uuid()};
+        auto plan2 = streaming::plan_id{utils::make_random_uuid()};
+        auto peer1 = locator::host_id{utils::make_random_uuid()};
+        auto peer2 = locator::host_id{utils::make_random_uuid()};
+
+        BOOST_REQUIRE_EQUAL(sm.active_sessions(), 0);
+
+        sm.update_progress(plan1, peer1, streaming::progress_info::direction::OUT, 100);
+        sm.update_progress(plan1, peer1, streaming::progress_info::direction::IN, 10);
+        sm.update_progress(plan1, peer2, streaming::progress_info::direction::OUT, 200);
+        sm.update_progress(plan2, peer1, streaming::progress_info::direction::IN, 20);
+        BOOST_REQUIRE_EQUAL(sm.active_sessions(), 3);
+
+        auto total = sm.get_progress_on_local_shard();
+        BOOST_REQUIRE_EQUAL(total.bytes_sent, 300);
+        BOOST_REQUIRE_EQUAL(total.bytes_received, 30);
+
+        // Removing a plan drops its sessions, without affecting the others.
+        sm.remove_progress(plan1);
+        BOOST_REQUIRE_EQUAL(sm.active_sessions(), 1);
+        BOOST_REQUIRE_EQUAL(sm.get_progress(plan2, peer1).bytes_received, 20);
+
+        // Late progress of a removed plan is accounted for as a new session,
+        // without registering any per-session metric.
+        sm.update_progress(plan1, peer1, streaming::progress_info::direction::OUT, 1);
+        BOOST_REQUIRE_EQUAL(sm.active_sessions(), 2);
+
+        sm.remove_progress(plan1);
+        sm.remove_progress(plan2);
+        BOOST_REQUIRE_EQUAL(sm.active_sessions(), 0);
+        BOOST_REQUIRE_GE(sm.outgoing_throughput(), 0);
+        BOOST_REQUIRE_GE(sm.incoming_throughput(), 0);
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
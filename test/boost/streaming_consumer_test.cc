@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/thread.hh>
+#undef SEASTAR_TESTING_MAIN
+#include <seastar/testing/test_case.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/reader_concurrency_semaphore.hh"
+#include "test/lib/random_utils.hh"
+#include "streaming/consumer.hh"
+#include "replica/database.hh"
+#include "readers/from_mutations.hh"
+#include "compaction/compaction_strategy.hh"
+
+BOOST_AUTO_TEST_SUITE(streaming_consumer_test)
+
+// Streams partitions of value_size bytes into the table, with write
+// timestamps spread over the given number of hours.
+static void stream_partitions(cql_test_env& e, replica::table& t, int partitions, size_t value_size, int hours = 1) {
+    auto s = t.schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto now = api::new_timestamp();
+    utils::chunked_vector<mutation> muts;
+    for (int i = 0; i < partitions; ++i) {
+        auto ts = now - std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::hours(i % hours)).count();
+        mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(i)));
+        m.set_clustered_cell(clustering_key::make_empty(), to_bytes("v"), data_value(tests::random::get_bytes(value_size)), ts);
+        muts.push_back(std::move(m));
+    }
+    std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+    auto consumer = streaming::make_streaming_consumer("streaming", e.db(), e.local_view_builder(), e.view_building_worker(),
+            partitions, streaming::stream_reason::bootstrap, sstables::offstrategy::no, service::null_topology_guard);
+    consumer(make_mutation_reader_from_mutations(s, semaphore.make_permit(), std::move(muts))).get();
+}
+
+SEASTAR_TEST_CASE(test_max_sstable_size_of_strategies) {
+    using sstables::compaction_strategy_type;
+    return seastar::async([] {
+        BOOST_REQUIRE_EQUAL(sstables::make_compaction_strategy(compaction_strategy_type::size_tiered, {}).max_sstable_size(), std::numeric_limits<uint64_t>::max());
+        BOOST_REQUIRE_EQUAL(sstables::make_compaction_strategy(compaction_strategy_type::time_window, {}).max_sstable_size(), std::numeric_limits<uint64_t>::max());
+        BOOST_REQUIRE_EQUAL(sstables::make_compaction_strategy(compaction_strategy_type::leveled, {{"sstable_size_in_mb", "10"}}).max_sstable_size(), uint64_t(10) << 20);
+        BOOST_REQUIRE_EQUAL(sstables::make_compaction_strategy(compaction_strategy_type::incremental, {{"sstable_size_in_mb", "100"}}).max_sstable_size(), uint64_t(100) << 20);
+    });
+}
+
+SEASTAR_TEST_CASE(test_streaming_writes_runs_of_the_leveled_sstable_size) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.lcs (pk int PRIMARY KEY, v blob) WITH compaction = {'class': 'LeveledCompactionStrategy', 'sstable_size_in_mb': '1'}"
+                " AND compression = {'sstable_compression': ''}").get();
+        auto& t = e.local_db().find_column_family("ks", "lcs");
+        t.disable_auto_compaction().get();
+        // About 4MB, streamed into sstables of about 1MB.
+        stream_partitions(e, t, 400, 10 * 1024);
+        BOOST_REQUIRE_GE(t.sstables_count(), 3);
+        for (auto& sst : *t.get_sstables()) {
+            BOOST_REQUIRE_LE(sst->data_size(), uint64_t(2) << 20);
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_streaming_writes_one_sstable_for_size_tiered) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.stcs (pk int PRIMARY KEY, v blob) WITH compaction = {'class': 'SizeTieredCompactionStrategy'}").get();
+        auto& t = e.local_db().find_column_family("ks", "stcs");
+        t.disable_auto_compaction().get();
+        stream_partitions(e, t, 400, 10 * 1024);
+        BOOST_REQUIRE_EQUAL(t.sstables_count(), 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_streaming_segregates_time_windows) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.twcs (pk int PRIMARY KEY, v blob) WITH compaction = {'class': 'TimeWindowCompactionStrategy', "
+                "'compaction_window_unit': 'HOURS', 'compaction_window_size': '1'}").get();
+        auto& t = e.local_db().find_column_family("ks", "twcs");
+        t.disable_auto_compaction().get();
+        stream_partitions(e, t, 40, 1024, 4);
+        // One sstable per window.
+        BOOST_REQUIRE_EQUAL(t.sstables_count(), 4);
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
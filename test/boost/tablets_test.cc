@@ -2316,6 +2316,49 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_works_with_in_progress_transitions)
   }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancer_evens_out_shard_heat) {
+  do_with_cql_env_thread([] (auto& e) {
+    topology_builder topo(e);
+
+    auto host1 = topo.add_node(node_state::normal, 2);
+
+    auto ks_name = add_keyspace(e, {{topo.dc(), 1}}, 4);
+    auto table1 = add_table(e, ks_name).get();
+
+    // Tablet counts of shards are balanced, but both hot tablets are on shard 0.
+    mutate_tablets(e, [&] (tablet_metadata& tmeta) -> future<> {
+        tablet_map tmap(4);
+        std::optional<tablet_id> tid = tmap.first_tablet();
+        for (int i = 0; i < 4; ++i) {
+            tmap.set_tablet(*tid, tablet_info {
+                    tablet_replica_set {
+                            tablet_replica {host1, shard_id(i / 2)},
+                    }
+            });
+            tid = tmap.next_tablet(*tid);
+        }
+        tmeta.set_tablet_map(table1, std::move(tmap));
+        co_return;
+    });
+
+    auto& stats = topo.get_shared_load_stats();
+    stats.set_heat(table1, 4, tablet_id(0), 1000);
+    stats.set_heat(table1, 4, tablet_id(1), 1000);
+    stats.set_heat(table1, 4, tablet_id(2), 10);
+
+    rebalance_tablets(e, &stats);
+
+    auto& stm = e.shared_token_metadata().local();
+    load_sketch load(stm.get(), stats.get());
+    load.populate().get();
+    BOOST_REQUIRE_EQUAL(load.get_shard_minmax(host1).min(), 2);
+    BOOST_REQUIRE_EQUAL(load.get_shard_minmax(host1).max(), 2);
+    // Each shard ends up with one hot tablet.
+    BOOST_REQUIRE_GE(load.get_shard_heat(host1, 0), 1000);
+    BOOST_REQUIRE_GE(load.get_shard_heat(host1, 1), 1000);
+  }).get();
+}
+
 #ifdef SCYLLA_ENABLE_ERROR_INJECTION
 SEASTAR_THREAD_TEST_CASE(test_load_balancer_shuffle_mode) {
   do_with_cql_env_thread([] (auto& e) {
@@ -3627,6 +3670,68 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_split_on_heat) {
+    do_with_cql_env_thread([] (auto& e) {
+        topology_builder topo(e);
+
+        topo.add_node(node_state::normal, 2);
+        topo.start_new_rack();
+        topo.add_node(node_state::normal, 2);
+
+        const size_t initial_tablets = 2;
+        auto ks_name = add_keyspace(e, {{topo.dc(), 2}}, initial_tablets);
+        auto table1 = add_table(e, ks_name).get();
+        e.execute_cql(fmt::format("alter keyspace {} with tablets = {{'enabled': true, 'initial': 1}}", ks_name)).get();
+
+        auto& stm = e.shared_token_metadata().local();
+
+        auto tablet_count = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).tablet_count();
+        };
+
+        auto resize_decision = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).resize_decision();
+        };
+
+        shared_load_stats& load_stats = topo.get_shared_load_stats();
+        auto do_rebalance_tablets = [&] () {
+            rebalance_tablets(e, &load_stats, {}, nullptr, false); // no auto-split
+        };
+
+        // Tablets are small enough to be merged, but a hot tablet holds it back.
+        const uint64_t threshold = e.local_db().get_config().tablet_split_requests_per_second_threshold();
+        load_stats.set_size(table1, service::default_target_tablet_size / 4 * initial_tablets);
+        load_stats.set_split_ready_seq_number(table1, std::numeric_limits<locator::resize_decision::seq_number_t>::min());
+        // Rates are of all replicas, so each of the two replicas serves 0.75 of the threshold.
+        load_stats.set_heat(table1, initial_tablets, tablet_id(0), threshold * 3 / 2);
+        {
+            do_rebalance_tablets();
+            BOOST_REQUIRE_EQUAL(tablet_count(), initial_tablets);
+            BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+        }
+
+        // The tablet gets too hot for a single shard, so it's split.
+        load_stats.set_heat(table1, initial_tablets, tablet_id(0), threshold * 4);
+        {
+            do_rebalance_tablets();
+            BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision().way));
+        }
+
+        {
+            load_stats.set_split_ready_seq_number(table1, resize_decision().sequence_number);
+            do_rebalance_tablets();
+            BOOST_REQUIRE_EQUAL(tablet_count(), initial_tablets * 2);
+        }
+
+        // Rates measured before the split don't merge the tablets back.
+        {
+            do_rebalance_tablets();
+            BOOST_REQUIRE_EQUAL(tablet_count(), initial_tablets * 2);
+            BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+        }
+    }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tablet_range_splitter) {
     simple_schema ss;
 
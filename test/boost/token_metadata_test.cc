@@ -40,11 +40,12 @@ namespace {
     }
 
     template <typename Strategy>
-    mutable_static_erm_ptr create_erm(mutable_token_metadata_ptr tmptr, replication_strategy_config_options opts = {}) {
+    mutable_static_erm_ptr create_erm(mutable_token_metadata_ptr tmptr, replication_strategy_config_options opts = {},
+            const vnode_effective_replication_map* prev = nullptr) {
         dc_rack_fn get_dc_rack_fn = get_dc_rack;
         tmptr->update_topology_change_info(get_dc_rack_fn).get();
         auto strategy = seastar::make_shared<Strategy>(replication_strategy_params(opts, std::nullopt));
-        return calculate_vnode_effective_replication_map(std::move(strategy), tmptr).get();
+        return calculate_vnode_effective_replication_map(std::move(strategy), tmptr, prev).get();
     }
 }
 
@@ -296,3 +297,44 @@ SEASTAR_THREAD_TEST_CASE(test_replace_node_with_same_endpoint) {
         host_id_vector_replica_set{e1_id1});
     BOOST_REQUIRE_EQUAL(token_metadata->get_endpoint(t1), e1_id1);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_natural_replicas_from_previous_map) {
+    const auto e1_id = gen_id(1);
+    const auto e2_id = gen_id(2);
+    const auto e3_id = gen_id(3);
+    const auto e4_id = gen_id(4);
+    const replication_strategy_config_options opts{{"replication_factor", "2"}};
+
+    semaphore sem(1);
+    auto tm_cfg = create_token_metadata_config(e1_id);
+    shared_token_metadata stm([&] () noexcept { return get_units(sem, 1); }, tm_cfg);
+    auto stop_stm = deferred_stop(stm);
+    auto token_metadata = stm.make_token_metadata_ptr();
+    for (auto id : {e1_id, e2_id, e3_id, e4_id}) {
+        token_metadata->update_topology(id, get_dc_rack(id), node::state::normal);
+    }
+    token_metadata->update_normal_tokens({dht::token::from_int64(10)}, e1_id).get();
+    token_metadata->update_normal_tokens({dht::token::from_int64(20)}, e2_id).get();
+    token_metadata->update_normal_tokens({dht::token::from_int64(30)}, e3_id).get();
+    auto prev = create_erm<simple_strategy>(token_metadata, opts);
+
+    auto check = [&] (mutable_token_metadata_ptr tmptr) {
+        auto erm = create_erm<simple_strategy>(tmptr, opts, prev->maybe_as_vnode_effective_replication_map());
+        auto expected = create_erm<simple_strategy>(tmptr, opts);
+        for (int64_t t = 0; t <= 40; t += 5) {
+            auto token = dht::token::from_int64(t);
+            BOOST_REQUIRE_EQUAL(erm->get_natural_replicas(token), expected->get_natural_replicas(token));
+            BOOST_REQUIRE_EQUAL(erm->get_pending_replicas(token), expected->get_pending_replicas(token));
+        }
+    };
+
+    // The ring is the same, only pending ranges change.
+    auto bootstrapping = stm.make_token_metadata_ptr(token_metadata->clone_async().get());
+    bootstrapping->add_bootstrap_token(dht::token::from_int64(25), e4_id);
+    check(bootstrapping);
+
+    // The ring changes, the previous replicas are stale.
+    auto joined = stm.make_token_metadata_ptr(token_metadata->clone_async().get());
+    joined->update_normal_tokens({dht::token::from_int64(25)}, e4_id).get();
+    check(joined);
+}
@@ -11,8 +11,10 @@
 
 #include "tracing/tracing.hh"
 #include "tracing/trace_state.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 
 BOOST_AUTO_TEST_SUITE(tracing_test)
 
@@ -84,4 +86,66 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
     });
 }
 
+SEASTAR_TEST_CASE(tracing_ring_buffer) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        sharded<tracing::tracing>& tracing = tracing::tracing::tracing_instance();
+        tracing.start(sstring(tracing::trace_ring_buffer_helper::CLASS_NAME), size_t(4)).get();
+        auto stop = defer([&tracing] { tracing.stop().get(); });
+        tracing.invoke_on_all(&tracing::tracing::start, std::ref(e.qp()), std::ref(e.migration_manager())).get();
+
+        tracing::tracing& t = tracing::tracing::get_local_tracing_instance();
+        auto& helper = dynamic_cast<tracing::trace_ring_buffer_helper&>(t.backend_helper());
+        BOOST_REQUIRE_EQUAL(helper.capacity(), 4);
+
+        auto trace_session = [&] (sstring request, int events) {
+            tracing::trace_state_props_set trace_props;
+            trace_props.set(tracing::trace_state_props::full_tracing);
+            auto trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+            BOOST_REQUIRE(trace_state);
+            tracing::begin(trace_state, request, gms::inet_address());
+            for (int i = 0; i < events; ++i) {
+                tracing::trace(trace_state, "event {}", i);
+            }
+            auto session_id = trace_state->session_id();
+            trace_state = nullptr;
+            t.write_pending_records();
+            return session_id;
+        };
+
+        auto s1 = trace_session("first", 3);
+        auto records = helper.get_records();
+        BOOST_REQUIRE_EQUAL(records.size(), 4);
+        for (unsigned i = 0; i < 3; ++i) {
+            BOOST_REQUIRE_EQUAL(records[i].seq, i);
+            BOOST_REQUIRE_EQUAL(records[i].session_id, s1);
+            BOOST_REQUIRE(!records[i].is_session);
+            BOOST_REQUIRE_EQUAL(records[i].message, fmt::format("event {}", i));
+        }
+        BOOST_REQUIRE(records[3].is_session);
+        BOOST_REQUIRE_EQUAL(records[3].message, "first");
+        BOOST_REQUIRE(records[3].command == tracing::trace_type::QUERY);
+
+        // The oldest records are overwritten.
+        auto s2 = trace_session("second", 2);
+        records = helper.get_records();
+        BOOST_REQUIRE_EQUAL(records.size(), 4);
+        BOOST_REQUIRE_EQUAL(records[0].seq, 3);
+        BOOST_REQUIRE_EQUAL(records[0].session_id, s1);
+        BOOST_REQUIRE_EQUAL(records[3].seq, 6);
+        BOOST_REQUIRE_EQUAL(records[3].session_id, s2);
+        BOOST_REQUIRE_EQUAL(records[3].message, "second");
+        BOOST_REQUIRE_EQUAL(helper.get_stats().records, 7);
+        BOOST_REQUIRE_EQUAL(helper.get_stats().overwritten_records, 3);
+
+        assert_that(e.execute_cql(format("SELECT seq, kind, message FROM system.tracing_ring_buffer WHERE shard = {}", this_shard_id())).get())
+            .is_rows()
+            .with_rows({
+                {long_type->decompose(int64_t(3)), utf8_type->decompose("session"), utf8_type->decompose("first")},
+                {long_type->decompose(int64_t(4)), utf8_type->decompose("event"), utf8_type->decompose("event 0")},
+                {long_type->decompose(int64_t(5)), utf8_type->decompose("event"), utf8_type->decompose("event 1")},
+                {long_type->decompose(int64_t(6)), utf8_type->decompose("session"), utf8_type->decompose("second")},
+            });
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
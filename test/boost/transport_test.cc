@@ -10,6 +10,7 @@
 
 #include <fmt/ranges.h>
 #include <fmt/std.h>
+#include <seastar/core/byteorder.hh>
 
 #include "transport/request.hh"
 #include "transport/response.hh"
@@ -160,3 +161,65 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+// Returns the frame of the message, header included.
+static bytes message_frame(scattered_message<char> msg) {
+    auto p = msg.release();
+    bytes frame(bytes::initialized_later(), p.len());
+    auto out = frame.begin();
+    for (auto& f : p.fragments()) {
+        out = std::copy_n(reinterpret_cast<const int8_t*>(f.base), f.size, out);
+    }
+    return frame;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_response_compression_with_dictionary) {
+    static constexpr auto version = 4;
+    static constexpr size_t header_size = 9;
+    auto row = [] (int i) {
+        return fmt::format("{{\"user_id\": {}, \"country\": \"PL\", \"status\": \"active\", \"plan\": \"premium\"}}", i);
+    };
+    auto make_response = [&] {
+        auto res = cql_transport::response(0, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+        res.write_string(row(7));
+        return res;
+    };
+    sstring samples;
+    for (int i = 0; i < 100; ++i) {
+        samples += row(i * 13);
+    }
+    auto dict = utils::shared_dict(std::as_bytes(std::span(samples)), 0, utils::UUID());
+    auto uncompressed = make_response();
+    auto body = message_frame(uncompressed.make_message(version, cql_transport::cql_compression::none)).substr(header_size);
+
+    auto zstd = make_response();
+    auto zstd_frame = message_frame(zstd.make_message(version, cql_transport::cql_compression::zstd));
+    auto zstd_dict = make_response();
+    auto zstd_dict_frame = message_frame(zstd_dict.make_message(version, cql_transport::cql_compression::zstd, &dict));
+    BOOST_REQUIRE(zstd_dict_frame[1] & cql_transport::cql_frame_flags::compression);
+    BOOST_REQUIRE_LT(zstd_dict_frame.size(), zstd_frame.size());
+
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    auto check_zstd = [&] (bytes_view compressed, const ZSTD_DDict* ddict) {
+        bytes out(bytes::initialized_later(), body.size());
+        auto ret = ddict
+                ? ZSTD_decompress_usingDDict(dctx.get(), out.data(), out.size(), compressed.data(), compressed.size(), ddict)
+                : ZSTD_decompressDCtx(dctx.get(), out.data(), out.size(), compressed.data(), compressed.size());
+        BOOST_REQUIRE(!ZSTD_isError(ret));
+        BOOST_REQUIRE_EQUAL(ret, body.size());
+        BOOST_REQUIRE_EQUAL(out, body);
+    };
+    check_zstd(bytes_view(zstd_frame).substr(header_size), nullptr);
+    check_zstd(bytes_view(zstd_dict_frame).substr(header_size), dict.zstd_ddict.get());
+
+    auto lz4_dict = make_response();
+    auto lz4_dict_frame = message_frame(lz4_dict.make_message(version, cql_transport::cql_compression::lz4, &dict));
+    auto compressed = bytes_view(lz4_dict_frame).substr(header_size);
+    BOOST_REQUIRE_EQUAL(size_t(read_be<int32_t>(reinterpret_cast<const char*>(compressed.data()))), body.size());
+    compressed.remove_prefix(4);
+    bytes out(bytes::initialized_later(), body.size());
+    auto ret = LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(compressed.data()), reinterpret_cast<char*>(out.data()),
+            compressed.size(), out.size(), reinterpret_cast<const char*>(dict.lz4_ddict.data()), dict.lz4_ddict.size());
+    BOOST_REQUIRE_EQUAL(size_t(ret), body.size());
+    BOOST_REQUIRE_EQUAL(out, body);
+}
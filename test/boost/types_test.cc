@@ -22,6 +22,7 @@
 #include "types/map.hh"
 #include "types/list.hh"
 #include "types/set.hh"
+#include "types/user.hh"
 #include "types/vector.hh"
 #include "test/lib/exception_utils.hh"
 #include "test/lib/test_utils.hh"
@@ -918,6 +919,23 @@ BOOST_AUTO_TEST_CASE(test_map_to_json) {
     BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), "{\"42\": \"abc\", \"42\": \"abc\"}");
 }
 
+BOOST_AUTO_TEST_CASE(test_write_json) {
+    auto ut = user_type_impl::get_instance("ks", "ut", {to_bytes("f1"), to_bytes("f2")}, {utf8_type, list_type_impl::get_instance(int32_type, false)}, false);
+    auto m = map_type_impl::get_instance(utf8_type, ut, false);
+    auto ut_v = make_user_value(ut, {data_value("a\"b\\c\n\x01"), make_list_value(ut->type(1), {data_value(int32_t(1)), data_value(int32_t(2))})});
+    auto map_v = make_map_value(m, {std::pair(data_value("k"), ut_v)});
+    const sstring expected = "{\"k\": {\"f1\": \"a\\\"b\\\\c\\n\\u0001\", \"f2\": [1, 2]}}";
+
+    BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize_nonnull()), expected);
+
+    bytes_ostream out;
+    out.write("[", 1);
+    write_json(out, *m, map_v.serialize_nonnull());
+    out.write("]", 1);
+    auto linearized = out.linearize();
+    BOOST_REQUIRE_EQUAL(sstring(reinterpret_cast<const char*>(linearized.data()), linearized.size()), "[" + expected + "]");
+}
+
 BOOST_AUTO_TEST_CASE(test_set_to_string) {
     auto m = set_type_impl::get_instance(int32_type, true);
     using native_type = std::vector<data_value>;
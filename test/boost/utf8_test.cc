@@ -13,6 +13,7 @@
 #include <boost/test/unit_test.hpp>
 #include <random>
 
+#include "utils/ascii.hh"
 #include "utils/utf8.hh"
 #include "utils/fragmented_temporary_buffer.hh"
 
@@ -116,8 +117,8 @@ BOOST_AUTO_TEST_CASE(test_utf8_positive) {
         size_t buf_len = 1024;
         prepare_test_buf(buf, i);
 
-        // Shift 16 bytes, validate each shift
-        for (int j = 0; j < 16; ++j) {
+        // Shift 32 bytes, validate each shift
+        for (int j = 0; j < 32; ++j) {
             BOOST_CHECK(utils::utf8::validate(buf, buf_len));
             for (int k = buf_len; k >= 1; --k)
                 buf[k] = buf[k-1];
@@ -133,7 +134,7 @@ BOOST_AUTO_TEST_CASE(test_utf8_negative) {
         BOOST_CHECK(!utils::utf8::validate((const uint8_t*)test.data, test.len));
     }
 
-    // Must be larger than 1024 + 16 + max(negative string length)
+    // Must be larger than 1024 + 32 + max(negative string length)
     uint8_t buf[1024*2];
 
     for (size_t i = 0; i < negative.size(); ++i) {
@@ -143,8 +144,8 @@ BOOST_AUTO_TEST_CASE(test_utf8_negative) {
         memcpy(buf+1024, negative[i].data, negative[i].len);
         size_t buf_len = 1024 + negative[i].len;
 
-        // Shift 16 bytes, validate each shift
-        for (int j = 0; j < 16; ++j) {
+        // Shift 32 bytes, validate each shift
+        for (int j = 0; j < 32; ++j) {
             BOOST_CHECK(!utils::utf8::validate(buf, buf_len));
             for (int k = buf_len; k >= 1; --k)
                 buf[k] = buf[k-1];
@@ -223,3 +224,20 @@ BOOST_AUTO_TEST_CASE(test_utf8_fragmented) {
         BOOST_REQUIRE(result == bad_pos);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_ascii) {
+    std::vector<uint8_t> buf(1024 + 64);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf[i] = i % 0x80;
+    }
+    // Cover the vectorized loops and the tails after them, with a non-ASCII
+    // byte at every position.
+    for (size_t len = 0; len <= buf.size(); ++len) {
+        BOOST_CHECK(utils::ascii::validate(buf.data(), len));
+        for (size_t pos = 0; pos < len; ++pos) {
+            auto c = std::exchange(buf[pos], 0x80 | pos);
+            BOOST_CHECK(!utils::ascii::validate(buf.data(), len));
+            buf[pos] = c;
+        }
+    }
+}
@@ -3298,4 +3298,35 @@ SEASTAR_TEST_CASE(test_mv_allow_some_column_drops) {
     });
 }
 
+// The view updates generated for the rows of a base mutation which fall in
+// the same view partition should be sent as a single mutation.
+SEASTAR_TEST_CASE(test_view_updates_batched_per_view_partition) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto f = e.local_view_builder().wait_until_built("ks", "mv");
+        e.execute_cql("create table t (k int, c int, v int, primary key (k, c))").get();
+        e.execute_cql("create materialized view mv as select * from t "
+                      "where k is not null and c is not null primary key (k, c)").get();
+        f.get();
+
+        sstring batch = "begin unlogged batch ";
+        for (int c = 0; c < 10; ++c) {
+            batch += format("insert into t (k, c, v) values (1, {}, {}); ", c, c);
+        }
+        batch += "apply batch";
+        e.execute_cql(batch).get();
+
+        auto total = [&] (int64_t db::view::stats::* counter) {
+            return e.db().map_reduce0([counter] (replica::database& local_db) {
+                return local_db.find_column_family("ks", "t").get_view_stats().*counter;
+            }, int64_t(0), std::plus<int64_t>()).get();
+        };
+        eventually([&] {
+            BOOST_REQUIRE_EQUAL(total(&db::view::stats::view_update_rows), 10);
+            BOOST_REQUIRE_EQUAL(total(&db::view::stats::view_update_mutations), 1);
+            auto msg = e.execute_cql("select count(*) from mv").get();
+            assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(10))}});
+        });
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -47,6 +47,14 @@ void check_bytes_and_roundtrip(typename Vint::value_type value, BytesInspector&&
     const auto deserialized = Vint::deserialize(view);
     BOOST_REQUIRE_EQUAL(deserialized, value);
     test_serialized_size_from_first_byte<Vint>(size, view);
+
+    // The bytes following the vint must not affect its value.
+    std::array<int8_t, 2 * max_vint_length> padded_buffer;
+    padded_buffer.fill(-1);
+    std::copy_n(encoding_buffer.begin(), size, padded_buffer.begin());
+    const int8_t* src = padded_buffer.data();
+    BOOST_REQUIRE_EQUAL(Vint::deserialize_unchecked(src), value);
+    BOOST_REQUIRE_EQUAL(src - padded_buffer.data(), size);
 };
 
 // Check that the encoded value decodes back to the value.
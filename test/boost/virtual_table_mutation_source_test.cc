@@ -48,6 +48,33 @@ class streaming_test_vt : public db::streaming_virtual_table {
     }
 };
 
+// Emits reversed partitions itself, and only what the query selects.
+class native_reverse_streaming_test_vt : public db::streaming_virtual_table {
+    schema_ptr _s;
+    utils::chunked_vector<mutation> _mutations;
+public:
+    native_reverse_streaming_test_vt(schema_ptr s, utils::chunked_vector<mutation> mutations)
+            : streaming_virtual_table(s)
+            , _s(s)
+            , _mutations(std::move(mutations)) {
+        _native_reverse = true;
+    }
+
+    virtual future<> execute(reader_permit permit, db::result_collector& rc, const query_restrictions& qr) override {
+        return async([this, permit, &rc, &qr] {
+            auto mt = make_memtable(_s, _mutations);
+            auto s = qr.reversed() ? _s->make_reversed() : _s;
+            auto pr = qr.partition_range();
+            auto slice = qr.slice();
+            auto rdr = mt->make_mutation_reader(s, permit, pr, slice);
+            auto close_rdr = deferred_close(rdr);
+            rdr.consume_pausable([&rc] (mutation_fragment_v2 mf) {
+                return rc.take(std::move(mf)).then([] { return stop_iteration::no; });
+            }).get();
+        });
+    }
+};
+
 SEASTAR_THREAD_TEST_CASE(test_memtable_filling_vt_as_mutation_source) {
     std::unique_ptr<memtable_filling_test_vt> table; // Used to prolong table's life
 
@@ -73,3 +100,20 @@ SEASTAR_THREAD_TEST_CASE(test_streaming_vt_as_mutation_source) {
         });
     }, false /* with_partition_range_forwarding */);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_native_reverse_streaming_vt_as_mutation_source) {
+    std::unique_ptr<native_reverse_streaming_test_vt> table; // Used to prolong table's life
+
+    run_mutation_source_tests([&table] (schema_ptr s, const utils::chunked_vector<mutation>& mutations, gc_clock::time_point) -> mutation_source {
+        table = std::make_unique<native_reverse_streaming_test_vt>(s, mutations);
+        return mutation_source([ms = table->as_mutation_source()] (schema_ptr s,
+                reader_permit permit,
+                const dht::partition_range& pr,
+                const query::partition_slice& slice,
+                tracing::trace_state_ptr trace_state,
+                streamed_mutation::forwarding stream_fwd,
+                mutation_reader::forwarding) {
+            return ms.make_mutation_reader(s, permit, pr, slice, trace_state, stream_fwd, mutation_reader::forwarding::no);
+        });
+    }, false /* with_partition_range_forwarding */);
+}
@@ -11,7 +11,7 @@ import time
 from test.pylib.manager_client import ManagerClient
 from test.pylib.random_tables import RandomTables
 from test.pylib.util import wait_for_cql_and_get_hosts
-from test.cluster.util import reconnect_driver
+from test.cluster.util import reconnect_driver, new_test_keyspace
 from test.cluster.conftest import skip_mode
 from test.pylib.random_tables import Column, TextType
 
@@ -90,3 +90,50 @@ async def test_reboot(request, manager: ManagerClient):
     logging.info(f"table content before crash [{table_content_before_crash}], "
                  f"after crash [{table_content_after_crash}]")
     assert table_content_before_crash == table_content_after_crash
+
+
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_truncate_after_commitlog_domain_move(manager: ManagerClient):
+    # A table truncated after it moved to a following commitlog domain starts
+    # over in the first domain after a restart. The writes it gets then
+    # must not be dropped by the replay as covered by the truncation record.
+    server_info = await manager.server_add(config={
+        'commitlog_sync': 'batch',
+        'commitlog_domains': 2,
+        'error_injections_at_startup': ['short_commitlog_domains_rebalance_period'],
+    }, cmdline=['--smp', '1', '--logger-log-level', 'database=debug'])
+    cql = manager.cql
+    await wait_for_cql_and_get_hosts(cql, [server_info], time.time() + 60)
+    log = await manager.server_open_log(server_info.server_id)
+
+    async with new_test_keyspace(manager, "WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1}") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.hot (p int PRIMARY KEY, v int)")
+        await cql.run_async(f"CREATE TABLE {ks}.cold (p int PRIMARY KEY, v int)")
+        await cql.run_async(f"INSERT INTO {ks}.cold (p, v) VALUES (0, 0)")
+
+        # The idle table moves to the last domain.
+        deadline = time.time() + 60
+        p = 0
+        while not await log.grep(f"Moving {ks}.cold from commitlog domain 0 to 1"):
+            assert time.time() < deadline, "cold table was not moved to the second commitlog domain"
+            await cql.run_async(f"INSERT INTO {ks}.hot (p, v) VALUES ({p}, {p})")
+            p += 1
+        logger.info("Test table moved to the second commitlog domain")
+
+        await cql.run_async(f"TRUNCATE TABLE {ks}.cold")
+
+        await manager.server_stop_gracefully(server_info.server_id)
+        await manager.server_start(server_info.server_id)
+        cql = await reconnect_driver(manager)
+        await wait_for_cql_and_get_hosts(cql, [server_info], time.time() + 60)
+
+        await asyncio.gather(*(cql.run_async(f"INSERT INTO {ks}.cold (p, v) VALUES ({i}, {i})") for i in range(10)))
+        await manager.server_stop(server_info.server_id)
+        await manager.server_start(server_info.server_id)
+        cql = await reconnect_driver(manager)
+        await wait_for_cql_and_get_hosts(cql, [server_info], time.time() + 60)
+        logger.info("Node is killed and restarted")
+
+        rows = await cql.run_async(f"SELECT p, v FROM {ks}.cold")
+        assert sorted((r.p, r.v) for r in rows) == [(i, i) for i in range(10)]
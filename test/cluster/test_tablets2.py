@@ -905,7 +905,7 @@ async def test_tablet_count_metric_per_shard(manager: ManagerClient):
     # Given two running servers
     shards_count = 4
     cmdline = ['--smp=4']
-    servers = await manager.servers_add(2, cmdline=cmdline)
+    servers = await manager.servers_add(2, cmdline=cmdline, auto_rack_dc="dc1")
 
     # And given disabled load balancing
     await manager.api.disable_tablet_balancing(servers[0].ip_addr)
@@ -1072,12 +1072,58 @@ async def test_tablet_load_and_stream(manager: ManagerClient, primary_replica_on
 
     await asyncio.gather(*[cql.run_async(f"drop keyspace {i}") for i in [ks, ks2]])
 
+@pytest.mark.asyncio
+async def test_tablet_load_and_stream_files(manager: ManagerClient):
+    """Sstables which fall within a single tablet of the destination table
+    are streamed as whole files to the tablet's replicas."""
+    cmdline = ['--smp', '1', '--load-and-stream-concurrency', '2']
+    servers = await manager.servers_add(2, cmdline=cmdline, auto_rack_dc="dc1")
+    await manager.api.disable_tablet_balancing(servers[0].ip_addr)
+    cql = manager.get_cql()
+
+    async def create_table(tablet_count: int) -> str:
+        ks_name = await create_new_test_keyspace(cql, "WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 2}" \
+                            f" AND tablets = {{ 'initial': {tablet_count} }};")
+        await cql.run_async(f"CREATE TABLE {ks_name}.test (pk int PRIMARY KEY, c int);")
+        return ks_name
+
+    # Each sstable of the source table lies within one of its 16 tablets,
+    # and hence within one of the 4 tablets of the destination table.
+    ks = await create_table(16)
+    ks2 = await create_table(4)
+    keys = range(256)
+    await asyncio.gather(*[cql.run_async(f"INSERT INTO {ks}.test (pk, c) VALUES ({k}, {k});") for k in keys])
+    await manager.api.flush_keyspace(servers[0].ip_addr, ks)
+
+    node_workdir = await manager.server_get_workdir(servers[0].server_id)
+    cql = await safe_server_stop_gracefully(manager, servers[0].server_id)
+    table_dir = glob.glob(os.path.join(node_workdir, "data", ks, "test-*"))[0]
+    dst_upload_dir = os.path.join(glob.glob(os.path.join(node_workdir, "data", ks2, "test-*"))[0], "upload")
+    for src_path in glob.glob(os.path.join(table_dir, "*.db")) + glob.glob(os.path.join(table_dir, "*.txt")):
+        os.rename(src_path, os.path.join(dst_upload_dir, os.path.basename(src_path)))
+
+    await manager.server_start(servers[0].server_id)
+    cql = manager.get_cql()
+    await wait_for_cql_and_get_hosts(cql, servers, time.time() + 60)
+
+    log = await manager.server_open_log(servers[0].server_id)
+    mark = await log.mark()
+    await manager.api.load_new_sstables(servers[0].ip_addr, ks2, "test")
+    assert await log.grep("load_and_stream: started .* as files to targets", from_mark=mark)
+
+    for server in servers:
+        await manager.api.flush_keyspace(server.ip_addr, ks2)
+    rows = await cql.run_async(f"SELECT * FROM {ks2}.test BYPASS CACHE;")
+    assert sorted((r.pk, r.c) for r in rows) == [(k, k) for k in keys]
+
+    await asyncio.gather(*[cql.run_async(f"drop keyspace {i}") for i in [ks, ks2]])
+
 @pytest.mark.asyncio
 async def test_storage_service_api_uneven_ownership_keyspace_and_table_params_used(manager: ManagerClient):
     # Given two running servers
     shards_count = 4
     cmdline = ['--smp=4']
-    servers = await manager.servers_add(2, cmdline=cmdline)
+    servers = await manager.servers_add(2, cmdline=cmdline, auto_rack_dc="dc1")
 
     # When table is created with initial tablets set to 1
     cql = manager.get_cql()
@@ -803,3 +803,47 @@ async def test_no_uncertainty_for_reads(manager: ManagerClient):
         row = rows[0]
         assert row.pk == 1
         assert row.c == 2
+
+
+@pytest.mark.asyncio
+async def test_lwt_under_lease(manager: ManagerClient):
+    # Consecutive LWTs on a key coordinated by the same replica skip the
+    # prepare round, under the lease of the previous decision on the key.
+    # An LWT from another coordinator breaks the lease, and the next LWT
+    # falls back to the full protocol without missing its write.
+    servers = await manager.servers_add(3, auto_rack_dc='my_dc')
+    cql = manager.get_cql()
+    hosts = await wait_for_cql_and_get_hosts(cql, servers, time.time() + 60)
+
+    async def get_metric(server, name):
+        metrics = await manager.metrics.query(server.ip_addr)
+        return metrics.get(name=f"scylla_storage_proxy_coordinator_{name}") or 0
+
+    async with new_test_keyspace(manager, "WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 3} AND tablets = {'initial': 1}") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.test (pk int PRIMARY KEY, c int);")
+
+        rows = await cql.run_async(f"INSERT INTO {ks}.test (pk, c) VALUES (1, 0) IF NOT EXISTS", host=hosts[0])
+        assert rows[0].applied
+        writes = 10
+        for i in range(writes):
+            rows = await cql.run_async(f"UPDATE {ks}.test SET c = {i + 1} WHERE pk = 1 IF c = {i}", host=hosts[0])
+            assert rows[0].applied
+
+        leased_accepts = await get_metric(servers[0], "cas_leased_accepts")
+        assert leased_accepts > 0
+        # A full round takes three round trips: prepare, accept and learn.
+        round_trips = await get_metric(servers[0], "cas_round_trips")
+        assert round_trips < 3 * (writes + 1)
+
+        rows = await cql.run_async(f"UPDATE {ks}.test SET c = 100 WHERE pk = 1 IF c = {writes}", host=hosts[1])
+        assert rows[0].applied
+
+        lease_lost = await get_metric(servers[0], "cas_lease_lost")
+        rows = await cql.run_async(f"UPDATE {ks}.test SET c = 101 WHERE pk = 1 IF c = 100", host=hosts[0])
+        assert rows[0].applied
+        assert await get_metric(servers[0], "cas_lease_lost") == lease_lost + 1
+        assert await get_metric(servers[0], "cas_leased_accepts") == leased_accepts
+
+        lwt_read = SimpleStatement(f"SELECT * FROM {ks}.test WHERE pk = 1;", consistency_level=ConsistencyLevel.SERIAL)
+        rows = await cql.run_async(lwt_read, host=hosts[2])
+        assert rows[0].c == 101
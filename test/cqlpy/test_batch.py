@@ -7,7 +7,7 @@
 #############################################################################
 from cassandra import InvalidRequest
 from cassandra.cluster import NoHostAvailable
-from .util import new_test_table
+from .util import new_test_table, unique_name
 from .rest_api import scylla_inject_error
 
 
@@ -74,3 +74,30 @@ def test_batch_with_error(cql, table1):
         # exceptions::exception_code::SERVER_ERROR, it gets converted to NoHostAvailable by the driver
         with pytest.raises(NoHostAvailable, match="Value too large"):
             cql.execute(generate_big_batch(table1, 100) + injection_key)
+
+# BEGIN SCHEMA BATCH applies several DDL statements as a single schema change.
+def test_schema_batch(scylla_only, cql, test_keyspace):
+    names = [unique_name() for _ in range(3)]
+    batch = "BEGIN SCHEMA BATCH\n" + "\n".join(
+        f"CREATE TABLE {test_keyspace}.{name} (k int PRIMARY KEY, v int);" for name in names) + "\nAPPLY BATCH"
+    cql.execute(batch)
+    try:
+        for name in names:
+            cql.execute(f"INSERT INTO {test_keyspace}.{name} (k, v) VALUES (1, 2)")
+            assert list(cql.execute(f"SELECT v FROM {test_keyspace}.{name} WHERE k = 1")) == [(2,)]
+        cql.execute(f"BEGIN SCHEMA BATCH ALTER TABLE {test_keyspace}.{names[0]} ADD w int; "
+                    f"CREATE INDEX ON {test_keyspace}.{names[1]} (v) APPLY BATCH")
+        cql.execute(f"SELECT w FROM {test_keyspace}.{names[0]}")
+        assert list(cql.execute(f"SELECT k FROM {test_keyspace}.{names[1]} WHERE v = 2")) == [(1,)]
+    finally:
+        for name in names:
+            cql.execute(f"DROP TABLE {test_keyspace}.{name}")
+
+def test_schema_batch_same_table(scylla_only, cql, test_keyspace):
+    name = unique_name()
+    with pytest.raises(InvalidRequest, match="more than one statement"):
+        cql.execute(f"BEGIN SCHEMA BATCH CREATE TABLE {test_keyspace}.{name} (k int PRIMARY KEY); "
+                    f"CREATE TABLE {test_keyspace}.{name} (k int PRIMARY KEY, v int) APPLY BATCH")
+    # Nothing was applied.
+    with pytest.raises(InvalidRequest):
+        cql.execute(f"SELECT * FROM {test_keyspace}.{name}")
@@ -2100,3 +2100,70 @@ def test_limit_partition_slice(cql, test_keyspace):
         rs = cql.execute(f'SELECT pk, ck2 FROM {table} WHERE ck1 = 1 LIMIT 3')
         assert sorted(list(rs)) == [(1,1), (1,2), (2,1)]
         assert rs.has_more_pages == False
+
+# Scylla allows including regular columns in a secondary index, with the
+# "include" index option. The included columns are stored in the index view,
+# so queries which select only them and the key columns are answered from the
+# index alone. Check that the results are the same as without the option,
+# including with paging and after the included column is modified.
+def test_index_include_columns(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, 'p int, c int, v int, a int, b text, primary key (p, c)') as table:
+        cql.execute(f"CREATE INDEX ON {table}(v) WITH OPTIONS = {{'include': 'a, b'}}")
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v, a, b) VALUES (?, ?, ?, ?, ?)')
+        for p in range(5):
+            for c in range(3):
+                cql.execute(stmt, [p, c, c % 2, p * 10 + c, str(p)])
+        expected = [(p, c, p * 10 + c, str(p)) for p in range(5) for c in range(3) if c % 2 == 1]
+        rows = list(cql.execute(f'SELECT p, c, a, b FROM {table} WHERE v = 1'))
+        assert sorted(rows) == sorted(expected)
+        # Same with a small page size
+        rows = list(cql.execute(SimpleStatement(f'SELECT p, c, a, b FROM {table} WHERE v = 1', fetch_size=2)))
+        assert sorted(rows) == sorted(expected)
+        # The order of the selected columns is kept
+        rows = list(cql.execute(f'SELECT b, a FROM {table} WHERE v = 1 AND p = 2'))
+        assert rows == [('2', 21)]
+        # Updates of an included column are visible through the index
+        cql.execute(f'UPDATE {table} SET a = 100 WHERE p = 2 AND c = 1')
+        assert list(cql.execute(f'SELECT a FROM {table} WHERE v = 1 AND p = 2')) == [(100,)]
+        cql.execute(f'DELETE b FROM {table} WHERE p = 2 AND c = 1')
+        assert list(cql.execute(f'SELECT a, b FROM {table} WHERE v = 1 AND p = 2')) == [(100, None)]
+        # The indexed column itself can be selected as well
+        cql.execute(f'UPDATE {table} SET v = 1 WHERE p = 2 AND c = 0')
+        rows = list(cql.execute(f'SELECT c, v FROM {table} WHERE v = 1 AND p = 2'))
+        assert sorted(rows) == [(0, 1), (1, 1)]
+
+def test_index_include_columns_local(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, 'p int, c int, v int, a int, primary key (p, c)') as table:
+        cql.execute(f"CREATE INDEX ON {table}((p), v) WITH OPTIONS = {{'include': 'a'}}")
+        stmt = cql.prepare(f'INSERT INTO {table} (p, c, v, a) VALUES (?, ?, ?, ?)')
+        for c in range(4):
+            cql.execute(stmt, [1, c, c % 2, c * 10])
+            cql.execute(stmt, [2, c, c % 2, c * 100])
+        assert sorted(cql.execute(f'SELECT c, a FROM {table} WHERE p = 1 AND v = 1')) == [(1, 10), (3, 30)]
+
+# DESCRIBE of an index with included columns shows the "include" option,
+# so the index can be recreated from the output.
+def test_index_include_columns_describe(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, 'p int primary key, v int, a int, "B" int') as table:
+        index_name = unique_name()
+        cql.execute(f"CREATE INDEX {index_name} ON {table}(v) WITH OPTIONS = {{'include': 'A, \"B\"'}}")
+        desc = cql.execute(f"DESC INDEX {test_keyspace}.{index_name}").one().create_statement
+        assert "WITH OPTIONS = {'include': 'a, \"B\"'}" in desc
+        cql.execute(f'INSERT INTO {table} (p, v, a, "B") VALUES (1, 2, 3, 4)')
+        assert list(cql.execute(f'SELECT a, "B" FROM {table} WHERE v = 2')) == [(3, 4)]
+
+def test_index_include_columns_invalid(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, 'p int, c int, v int, a int, s int static, m map<int,int>, primary key (p, c)') as table:
+        for include in ['p', 'c', 'v', 's', 'nonexistent', 'a, a', '', 'a,', '"a']:
+            with pytest.raises(InvalidRequest):
+                cql.execute(f"CREATE INDEX ON {table}(v) WITH OPTIONS = {{'include': '{include}'}}")
+        # Only plain indexes on values of a column can include columns
+        with pytest.raises(InvalidRequest):
+            cql.execute(f"CREATE INDEX ON {table}(keys(m)) WITH OPTIONS = {{'include': 'a'}}")
+        # Other options are still not allowed for a non-CUSTOM index
+        with pytest.raises(InvalidRequest):
+            cql.execute(f"CREATE INDEX ON {table}(v) WITH OPTIONS = {{'include': 'a', 'other': 'x'}}")
+        # An included column cannot be dropped while the index exists
+        cql.execute(f"CREATE INDEX ON {table}(v) WITH OPTIONS = {{'include': 'a'}}")
+        with pytest.raises(InvalidRequest):
+            cql.execute(f"ALTER TABLE {table} DROP a")
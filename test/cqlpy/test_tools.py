@@ -320,6 +320,52 @@ def test_scylla_sstable_write(cql, test_keyspace, scylla_path, scylla_data_dir,
             assert actual_json == original_json
 
 
+@pytest.mark.parametrize("shards", [None, 2])
+def test_scylla_sstable_write_csv(scylla_path, shards):
+    partitions = 32
+    rows_per_partition = 4
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        schema_file = os.path.join(tmp_dir, "schema.cql")
+        with open(schema_file, "w") as f:
+            f.write("CREATE TABLE ks.tbl (pk int, ck int, v text, s int STATIC, PRIMARY KEY (pk, ck))")
+
+        # Unsorted input, with the columns in a different order than in the schema.
+        rows = [(pk, ck) for pk in range(partitions) for ck in range(rows_per_partition)]
+        random.shuffle(rows)
+        input_file = os.path.join(tmp_dir, "input.csv")
+        with open(input_file, "w") as f:
+            f.write("ck,v,pk,s\n")
+            for pk, ck in rows:
+                # Null v for some rows, quoted v with a comma and an escaped quote for others.
+                v = "" if ck == 0 else f'"v,""{pk}"""'
+                f.write(f"{ck},{v},{pk},{pk}\n")
+
+        output_dir = os.path.join(tmp_dir, "output")
+        os.mkdir(output_dir)
+        generation = util.unique_key_int()
+        args = [scylla_path, "sstable", "write", "--schema-file", schema_file, "--input-format", "csv", "--input-file", input_file,
+                "--output-dir", output_dir, "--generation", str(generation), "--timestamp", "1000"]
+        if shards:
+            args += ["--shards", str(shards)]
+        subprocess.check_call(args)
+
+        sstables = glob.glob(os.path.join(output_dir, "*-Data.db"))
+        assert len(sstables) == (shards or 1)
+        # The directory of the sorted runs is removed.
+        assert len([e for e in os.listdir(output_dir) if os.path.isdir(os.path.join(output_dir, e))]) == 0
+
+        out = json.loads(subprocess.check_output([scylla_path, "sstable", "dump-data", "--schema-file", schema_file, "--output-format", "json", "--merge"] + sstables))
+        actual = {}
+        for partition in out["sstables"]["anonymous"]:
+            pk = int(partition["key"]["value"])
+            assert partition["static_row"]["s"]["value"] == str(pk)
+            for row in partition["clustering_elements"]:
+                assert row["marker"]["timestamp"] == 1000
+                actual[(pk, int(row["key"]["value"]))] = row["columns"].get("v", {}).get("value")
+
+        assert actual == {(pk, ck): (None if ck == 0 else f'v,"{pk}"') for pk, ck in rows}
+
+
 def script_consume_test_table_factory(cql, keyspace):
     table = util.unique_name()
     schema = f"CREATE TABLE {keyspace}.{table} (pk int, ck int, v int, s int STATIC, PRIMARY KEY (pk, ck)) WITH compaction = {{'class': 'NullCompactionStrategy'}}"
@@ -1214,6 +1260,15 @@ def test_scrub_validate_mode(scylla_path, scrub_workdir, scrub_schema_file, scru
         assert os.path.exists(scrub_bad_sstable)
 
 
+def test_scrub_parallelism(scylla_path, scrub_workdir, scrub_schema_file, scrub_good_sstable, scrub_bad_sstable):
+    subprocess_check_error([scylla_path, "sstable", "scrub", "--schema-file", scrub_schema_file, "--scrub-mode", "validate", "--parallelism", "0", scrub_good_sstable], "error processing arguments: parallelism must be at least 1")
+
+    # With --parallelism > 1, each sstable is scrubbed on its own, so each one gets its own output sstable(s).
+    with tempfile.TemporaryDirectory(prefix="test_scrub_parallelism", dir=scrub_workdir) as tmp_dir:
+        subprocess.check_call([scylla_path, "sstable", "scrub", "--schema-file", scrub_schema_file, "--scrub-mode", "segregate", "--parallelism", "2", "--output-dir", tmp_dir, scrub_good_sstable, scrub_bad_sstable])
+        check_scrub_output_dir(tmp_dir, 3)
+
+
 def _to_cql3_type(t: Type) -> str:
     # map from Python type to Cassandra type, only a small subset is supported
     py_to_cql3_type = {int: "Int32Type",
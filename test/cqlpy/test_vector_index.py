@@ -7,7 +7,7 @@
 ###############################################################################
 
 import pytest
-from .util import new_test_table, is_scylla, unique_name
+from .util import new_test_table, is_scylla, unique_name, config_value_context
 from cassandra.protocol import InvalidRequest, ConfigurationException
 
 @pytest.mark.parametrize("test_keyspace",
@@ -320,3 +320,29 @@ def test_vector_search_when_tracing_is_enabled(cql, test_keyspace, scylla_only):
                 f"SELECT * FROM {table} ORDER BY v ANN OF [0.2,0.3,0.4] LIMIT 1",
                 trace=True,
             )
+
+# With vector_search_local_fallback, ANN queries don't need the vector store
+# and are answered with an exact search of the whole table by the coordinator.
+@pytest.mark.parametrize(
+    "test_keyspace",
+    [
+        pytest.param("tablets", marks=[pytest.mark.xfail(reason="issue #16317")]),
+        "vnodes",
+    ],
+    indirect=True,
+)
+def test_vector_search_local_fallback(cql, test_keyspace, scylla_only):
+    schema = "p int, c int, v vector<float, 2>, primary key (p, c)"
+    with new_test_table(cql, test_keyspace, schema) as table:
+        cql.execute(f"CREATE CUSTOM INDEX ON {table}(v) USING 'vector_index' WITH OPTIONS = {{'similarity_function': 'euclidean'}}")
+        stmt = cql.prepare(f"INSERT INTO {table} (p, c, v) VALUES (?, ?, ?)")
+        for p in range(4):
+            for c in range(4):
+                cql.execute(stmt, [p, c, [float(p), float(c)]])
+        cql.execute(f"INSERT INTO {table} (p, c) VALUES (10, 10)")
+        with config_value_context(cql, 'vector_search_local_fallback', 'true'):
+            rows = list(cql.execute(f"SELECT p, c FROM {table} ORDER BY v ANN OF [2.9, 1.2] LIMIT 3"))
+            assert sorted(rows) == [(2, 1), (3, 1), (3, 2)]
+            assert list(cql.execute(f"SELECT p, c FROM {table} ORDER BY v ANN OF [0, 0] LIMIT 1")) == [(0, 0)]
+        with pytest.raises(InvalidRequest, match="Vector Store is disabled"):
+            cql.execute(f"SELECT p, c FROM {table} ORDER BY v ANN OF [0, 0] LIMIT 1")
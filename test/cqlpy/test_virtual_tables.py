@@ -85,6 +85,16 @@ def test_clients(scylla_only, cql):
         assert(cl[0] == '127.0.0.1')
         assert(cl[2] == 'cql')
 
+def test_clients_io_counters(scylla_only, cql):
+    cls = [cl for cl in cql.execute("SELECT client_type, frames_read, frames_written, socket_reads, socket_writes FROM system.clients")
+           if cl.client_type == 'cql']
+    assert len(cls) > 0
+    for cl in cls:
+        assert cl.frames_read >= 0 and cl.frames_written >= 0
+        assert cl.socket_reads >= 0 and cl.socket_writes >= 0
+    # The connection which sent this SELECT has read at least the STARTUP and the SELECT.
+    assert max(cl.frames_read for cl in cls) >= 2
+
 # We only want to check that the table exists with the listed columns, to assert
 # backwards compatibility.
 def _check_exists(cql, table_name, columns):
@@ -174,3 +184,12 @@ def test_token_ring_tablets(scylla_only, cql, test_keyspace_tablets):
         for row in rows:
             assert row.keyspace_name == test_keyspace_tablets
             assert row.table_name == table
+
+def test_scheduling_groups(scylla_only, cql):
+    rows = list(cql.execute("SELECT * FROM system.scheduling_groups WHERE shard = 0"))
+    groups = {row.group_name: row for row in rows}
+    assert 'main' in groups
+    assert 'compaction' in groups
+    assert all(row.shard == 0 for row in rows)
+    assert all(row.shares > 0 for row in rows)
+    assert sum(row.tasks_processed for row in rows) > 0
@@ -422,6 +422,10 @@ class single_node_cql_env : public cql_test_env {
         return _ss;
     }
 
+    virtual sharded<streaming::stream_manager>& get_stream_manager() override {
+        return _stream_manager;
+    }
+
     virtual sharded<tasks::task_manager>& get_task_manager() override {
         return _task_manager;
     }
@@ -534,6 +538,7 @@ class single_node_cql_env : public cql_test_env {
             }
             cfg->commitlog_directory.set(data_dir_path + "/commitlog.dir");
             cfg->schema_commitlog_directory.set(cfg->commitlog_directory() + "/schema");
+            cfg->raft_log_directory.set(data_dir_path + "/raft_log.dir");
             cfg->hints_directory.set(data_dir_path + "/hints.dir");
             cfg->view_hints_directory.set(data_dir_path + "/view_hints.dir");
             cfg->num_tokens.set(256);
@@ -647,6 +652,8 @@ class single_node_cql_env : public cql_test_env {
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
                     .flush_all_tables_before_major = cfg->compaction_flush_all_tables_before_major_seconds() * 1s,
+                    .major_compaction_parallel_subranges = cfg->compaction_major_parallel_subranges,
+                    .offstrategy_round_size_in_mb = cfg->compaction_offstrategy_round_size_in_mb,
                 };
             });
             _cm.start(std::move(get_cm_cfg), std::ref(abort_sources), std::ref(_task_manager)).get();
@@ -714,7 +721,7 @@ class single_node_cql_env : public cql_test_env {
             if (cfg_in.qp_mcfg) {
                 qp_mcfg = *cfg_in.qp_mcfg;
             } else {
-                qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+                qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 256};
             }
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(_db));
 
@@ -883,7 +890,9 @@ class single_node_cql_env : public cql_test_env {
 
             _group0_registry.start(
                 raft::server_id{host_id.id},
-                std::ref(_ms), std::ref(_fd)).get();
+                std::ref(_ms), std::ref(_fd), std::ref(_feature_service), sharded_parameter([&cfg] {
+                    return utils::updateable_value<uint32_t>(cfg->raft_message_coalescing_window_in_us);
+                })).get();
             auto stop_raft_gr = deferred_stop(_group0_registry);
 
             _feature_service.invoke_on_all([] (auto& fs) {
@@ -966,7 +975,7 @@ class single_node_cql_env : public cql_test_env {
             });
 
             smp::invoke_on_all([&] {
-                return db::initialize_virtual_tables(_db, _ss, _gossiper, _group0_registry, _sys_ks, _tablet_allocator, _ms, *cfg);
+                return db::initialize_virtual_tables(_db, _ss, _gossiper, _group0_registry, _sys_ks, _tablet_allocator, _ms, _proxy, *cfg);
             }).get();
 
             _qp.invoke_on_all([this, &group0_client] (cql3::query_processor& qp) {
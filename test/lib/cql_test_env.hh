@@ -54,6 +54,10 @@ namespace utils {
 class disk_space_monitor;
 }
 
+namespace streaming {
+class stream_manager;
+}
+
 namespace service {
 
 class client_state;
@@ -193,6 +197,8 @@ class cql_test_env {
 
     virtual sharded<service::storage_service>& get_storage_service() = 0;
 
+    virtual sharded<streaming::stream_manager>& get_stream_manager() = 0;
+
     virtual sharded<tasks::task_manager>& get_task_manager() = 0;
 
     virtual sharded<locator::shared_token_metadata>& get_shared_token_metadata() = 0;
@@ -66,7 +66,9 @@ class test_env_sstables_manager : public sstables_manager {
     }
 
     void remove_sst_from_reclaimed(sstable* sst) {
-        _reclaimed.erase(*sst);
+        if (sst->_manager_set_link.is_linked()) {
+            _reclaimed.erase(_reclaimed.iterator_to(*sst));
+        }
     }
 
     auto& get_active_list() {
@@ -131,7 +131,9 @@ class table_for_tests::compaction_group_view : public compaction::compaction_gro
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override {
         return table().get_token_range_after_split(t);
     }
+    std::optional<sstables::compaction_type_options::split> split_options() const noexcept override { return std::nullopt; }
     int64_t get_sstables_repaired_at() const noexcept override { return 0; }
+    double read_amplification() const noexcept override { return 1.0; }
 };
 
 table_for_tests::data::data()
@@ -41,6 +41,12 @@ struct shared_load_stats {
     void set_capacity(locator::host_id host, size_t capacity) {
         stats.capacity[host] = capacity;
     }
+
+    void set_heat(table_id table, size_t tablet_count, locator::tablet_id tablet, uint64_t requests_per_second) {
+        auto& heat = stats.heat[table];
+        heat.tablet_count = tablet_count;
+        heat.requests_per_second[tablet] = requests_per_second;
+    }
 };
 
 /// Modifies topology inside a given cql_test_env.
@@ -20,6 +20,7 @@
 #include "test/lib/tmpdir.hh"
 #include "sstables/sstables.hh"
 #include "mutation/canonical_mutation.hh"
+#include "db_clock.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/test_services.hh"
 #include "test/lib/sstable_test_env.hh"
@@ -141,6 +142,9 @@ struct mutation_settings {
     size_t partition_key_size;
     size_t clustering_key_size;
     size_t data_size;
+    // When non-zero, cell values are drawn from that many random values.
+    size_t distinct_values = 0;
+    bool intern_values = false;
 };
 
 static schema_ptr make_schema(const mutation_settings& settings) {
@@ -151,11 +155,14 @@ static schema_ptr make_schema(const mutation_settings& settings) {
     for (size_t i = 0; i < settings.column_count; ++i) {
         builder.with_column(to_bytes(random_name(settings.column_name_size)), bytes_type);
     }
+    if (settings.intern_values) {
+        builder.set_caching_options(caching_options::from_map({{"intern_values", "true"}}));
+    }
 
     return builder.build();
 }
 
-static mutation make_mutation(schema_ptr s, mutation_settings settings) {
+static mutation make_mutation(schema_ptr s, mutation_settings settings, const std::vector<bytes>& values) {
     mutation m(s, partition_key::from_single_value(*s, bytes_type->decompose(data_value(random_bytes(settings.partition_key_size)))));
 
     for (size_t i = 0; i < settings.row_count; ++i) {
@@ -163,7 +170,7 @@ static mutation make_mutation(schema_ptr s, mutation_settings settings) {
         for (auto&& col : s->regular_columns()) {
             m.set_clustered_cell(ck, col,
                 atomic_cell::make_live(*bytes_type, 1,
-                    bytes_type->decompose(data_value(random_bytes(settings.data_size)))));
+                    bytes_type->decompose(data_value(values.empty() ? random_bytes(settings.data_size) : values[std::rand() % values.size()]))));
         }
     }
     return m;
@@ -182,7 +189,13 @@ static sizes calculate_sizes(cache_tracker& tracker, const mutation_settings& se
     sizes result;
     auto s = make_schema(settings);
     auto mt = make_lw_shared<replica::memtable>(s);
-    row_cache cache(s, make_empty_snapshot_source(), tracker);
+    cell_value_pool value_pool;
+    row_cache cache(s, make_empty_snapshot_source(), tracker, is_continuous::no, &value_pool);
+
+    std::vector<bytes> values;
+    for (size_t i = 0; i < settings.distinct_values; ++i) {
+        values.push_back(random_bytes(settings.data_size));
+    }
 
     auto cache_initial_occupancy = tracker.region().occupancy().used_space();
 
@@ -190,7 +203,7 @@ static sizes calculate_sizes(cache_tracker& tracker, const mutation_settings& se
 
     std::vector<mutation> muts;
     for (size_t i = 0; i < settings.partition_count; ++i) {
-        muts.emplace_back(make_mutation(s, settings));
+        muts.emplace_back(make_mutation(s, settings, values));
         mt->apply(muts.back());
         cache.populate(muts.back());
     }
@@ -217,6 +230,47 @@ static sizes calculate_sizes(cache_tracker& tracker, const mutation_settings& se
     return result;
 }
 
+// Time-series shape: one wide partition per sensor, rows appended in
+// increasing timestamp order, a fixed set of numeric columns.
+static schema_ptr make_time_series_schema(size_t column_count) {
+    auto builder = schema_builder("ks", "ts")
+        .with_column("sensor", long_type, column_kind::partition_key)
+        .with_column("ts", timestamp_type, column_kind::clustering_key);
+    for (size_t i = 0; i < column_count; ++i) {
+        builder.with_column(to_bytes(format("v{}", i)), double_type);
+    }
+    return builder.build();
+}
+
+struct time_series_sizes {
+    size_t rows;
+    size_t memtable;
+    // Lower bound for a columnar layout: arrays of clustering keys, values,
+    // write timestamps and liveness flags, without any per-row structure.
+    size_t columnar_estimate;
+};
+
+static time_series_sizes calculate_time_series_sizes(const mutation_settings& settings) {
+    auto s = make_time_series_schema(settings.column_count);
+    auto mt = make_lw_shared<replica::memtable>(s);
+    auto now = db_clock::now();
+    for (size_t p = 0; p < settings.partition_count; ++p) {
+        mutation m(s, partition_key::from_single_value(*s, long_type->decompose(int64_t(p))));
+        for (size_t i = 0; i < settings.row_count; ++i) {
+            auto ck = clustering_key::from_single_value(*s, timestamp_type->decompose(now + std::chrono::seconds(i)));
+            for (auto&& col : s->regular_columns()) {
+                m.set_clustered_cell(ck, col, atomic_cell::make_live(*double_type, api::timestamp_type(i), double_type->decompose(double(i))));
+            }
+        }
+        mt->apply(m);
+    }
+    time_series_sizes result;
+    result.rows = settings.partition_count * settings.row_count;
+    result.memtable = mt->occupancy().used_space();
+    result.columnar_estimate = result.rows * (sizeof(int64_t) + settings.column_count * (sizeof(double) + sizeof(api::timestamp_type) + 1));
+    return result;
+}
+
 int main(int argc, char** argv) {
     namespace bpo = boost::program_options;
     app_template app;
@@ -228,7 +282,11 @@ int main(int argc, char** argv) {
         ("partition-count", bpo::value<size_t>()->default_value(1), "partition count")
         ("partition-key-size", bpo::value<size_t>()->default_value(10), "partition key size")
         ("clustering-key-size", bpo::value<size_t>()->default_value(10), "clustering key size")
-        ("data-size", bpo::value<size_t>()->default_value(32), "cell data size");
+        ("data-size", bpo::value<size_t>()->default_value(32), "cell data size")
+        ("distinct-values", bpo::value<size_t>()->default_value(0), "draw cell values from that many random values, 0 for all distinct")
+        ("intern-values", "Also measure the memtable and cache footprint with cell values interned")
+        ("time-series", "Measure a time-series shaped memtable (timestamp clustering key, double columns) instead, "
+                        "and compare it with a columnar layout");
 
     return app.run(argc, argv, [&] {
         if (smp::count != 1) {
@@ -248,6 +306,15 @@ int main(int argc, char** argv) {
             settings.partition_key_size = app.configuration()["partition-key-size"].as<size_t>();
             settings.clustering_key_size = app.configuration()["clustering-key-size"].as<size_t>();
             settings.data_size = app.configuration()["data-size"].as<size_t>();
+            settings.distinct_values = app.configuration()["distinct-values"].as<size_t>();
+
+            if (app.configuration().contains("time-series")) {
+                auto ts = calculate_time_series_sizes(settings);
+                std::cout << "time-series memtable footprint (" << ts.rows << " rows):\n";
+                std::cout << " - row-wise:            " << ts.memtable << " (" << ts.memtable / std::max<size_t>(ts.rows, 1) << " per row)\n";
+                std::cout << " - columnar (estimate): " << ts.columnar_estimate << " (" << ts.columnar_estimate / std::max<size_t>(ts.rows, 1) << " per row)\n";
+                return;
+            }
 
             auto& tracker = env.local_db().find_column_family("system", "local").get_row_cache().get_cache_tracker();
             auto sizes = calculate_sizes(tracker, settings);
@@ -263,6 +330,15 @@ int main(int argc, char** argv) {
             std::cout << " - canonical:    " << sizes.canonical << "\n";
             std::cout << " - query result: " << sizes.query_result << "\n";
 
+            if (app.configuration().contains("intern-values")) {
+                settings.intern_values = true;
+                auto interned = calculate_sizes(tracker, settings);
+                auto rows = std::max<size_t>(settings.partition_count * settings.row_count, 1);
+                std::cout << "\nper-row footprint, with interned cell values:\n";
+                std::cout << " - in cache:     " << sizes.cache / rows << " -> " << interned.cache / rows << "\n";
+                std::cout << " - in memtable:  " << sizes.memtable / rows << " -> " << interned.memtable / rows << "\n";
+            }
+
             std::cout << "\n";
             size_calculator::print_cache_entry_size();
 
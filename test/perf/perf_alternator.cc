@@ -19,6 +19,7 @@
 #include <seastar/util/short_streams.hh>
 #include <tuple>
 #include <boost/program_options.hpp>
+#include <fmt/ranges.h>
 
 #include "db/config.hh"
 #include "test/perf/perf.hh"
@@ -329,6 +330,55 @@ static future<> get_item(const test_config& _, http::experimental::client& cli,
     co_await make_request(cli, "GetItem", std::move(body));
 }
 
+// The maximum number of items DynamoDB allows in BatchWriteItem
+static constexpr uint64_t batch_items = 25;
+
+// Writes 5 items into each of 5 partitions, so items of one partition are
+// written together, and different partitions in parallel.
+static future<> batch_write_item(const test_config& c, http::experimental::client& cli, uint64_t seq) {
+    std::vector<sstring> requests;
+    requests.reserve(batch_items);
+    for (uint64_t i = 0; i < batch_items; ++i) {
+        requests.push_back(format(R"({{
+                "PutRequest": {{
+                    "Item": {{
+                        "p": {{ "S": "{}" }},
+                        "c": {{ "S": "{}" }},
+                        "C0": {{ "S": "Hello" }},
+                        "C1": {{ "N": "123.45" }}
+                    }}
+                }}
+            }})", seq + i / 5, i % 5));
+    }
+    auto body = format(R"({{
+        "RequestItems": {{
+            "workloads_test": [{}]
+        }}
+    }})", fmt::join(requests, ","));
+    co_await make_request(cli, "BatchWriteItem", std::move(body));
+}
+
+// Reads items of 25 partitions, as written by create_partitions(). Needs
+// at least that many partitions, or the batch would have duplicate keys.
+static future<> batch_get_item(const test_config& c, http::experimental::client& cli, uint64_t seq) {
+    std::vector<sstring> keys;
+    keys.reserve(batch_items);
+    for (uint64_t i = 0; i < batch_items; ++i) {
+        auto key = (seq + i) % c.partitions;
+        keys.push_back(format(R"({{ "p": {{ "S": "{}" }}, "c": {{ "S": "{}" }} }})", key, key));
+    }
+    auto body = format(R"({{
+        "RequestItems": {{
+            "workloads_test": {{
+                "Keys": [{}],
+                "ProjectionExpression": "C0, C1, C2, C3, C4, C5, C6, C7, C8, C9",
+                "ConsistentRead": false
+            }}
+        }}
+    }})", fmt::join(keys, ","));
+    co_await make_request(cli, "BatchGetItem", std::move(body));
+}
+
 static future<> scan(const test_config& c, http::experimental::client& cli, uint64_t seq) {
     // This uses "parallel scan" feature, see https://docs.aws.amazon.com/amazondynamodb/latest/developerguide/Scan.html#Scan.ParallelScan
     auto body = format(R"({{
@@ -393,9 +443,11 @@ void workload_main(const test_config& c) {
         // needs to be executed together with --alternator-write-isolation only_rmw_uses_lwt
         // for realistic scenario
         {"write_rmw", update_item_rmw},
+        {"batch_write", batch_write_item},
+        {"batch_read", batch_get_item},
     };
 
-    if (c.prepopulate_partitions && (c.workload == "read" || c.workload == "scan")) {
+    if (c.prepopulate_partitions && (c.workload == "read" || c.workload == "scan" || c.workload == "batch_read")) {
         create_partitions(c, cli);
     }
 
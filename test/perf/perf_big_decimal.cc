@@ -10,6 +10,7 @@
 #include <seastar/testing/test_runner.hh>
 
 #include <random>
+#include <vector>
 
 #include "utils/big_decimal.hh"
 #include "test/lib/make_random_string.hh"
@@ -36,3 +37,41 @@ PERF_TEST_F(big_decimal_test, from_string) {
     perf_tests::do_not_optimize(big_decimal{neg_data_fraction_neg_exponent});
 }
 
+
+struct big_decimal_arithmetic_test {
+    // Typical values of decimal columns, which fit in 64 bits.
+    std::vector<big_decimal> values = [] {
+        std::vector<big_decimal> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(make_random_numeric_string(8) + "." + make_random_numeric_string(i % 4 + 1));
+        }
+        return v;
+    }();
+};
+
+PERF_TEST_F(big_decimal_arithmetic_test, sum) {
+    big_decimal sum;
+    for (const auto& v : values) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum);
+    return values.size();
+}
+
+PERF_TEST_F(big_decimal_arithmetic_test, avg) {
+    big_decimal sum;
+    for (const auto& v : values) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum.div(values.size(), big_decimal::rounding_mode::HALF_EVEN));
+    return values.size();
+}
+
+PERF_TEST_F(big_decimal_arithmetic_test, compare) {
+    size_t less = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        less += values[i - 1] < values[i];
+    }
+    perf_tests::do_not_optimize(less);
+    return values.size() - 1;
+}
@@ -53,3 +53,32 @@ PERF_TEST_F(crc_test, perf_zlib_crc32_checksum) {
     perf_tests::do_not_optimize(
         zlib_crc32_checksummer::checksum(data.data(), data.size()));
 }
+
+PERF_TEST_F(crc_test, perf_crc32c_checksum) {
+    perf_tests::do_not_optimize(
+        crc32c_utils::checksum(data.data(), data.size()));
+}
+
+PERF_TEST_F(crc_test, perf_crc32c_combine) {
+    perf_tests::do_not_optimize(
+        crc32c_utils::checksum_combine(sum1, sum2, data.size()));
+}
+
+// Checksums of a single block of the given size, for comparing the
+// implementations on the sizes used by sstable chunks and commitlog entries.
+#define PERF_TEST_CHECKSUM_BLOCK(name, impl, size) \
+    PERF_TEST_F(crc_test, perf_##name##_checksum_##size) { \
+        perf_tests::do_not_optimize(impl::checksum(data.data(), size)); \
+    }
+
+#define PERF_TEST_CHECKSUM_BLOCKS(name, impl) \
+    PERF_TEST_CHECKSUM_BLOCK(name, impl, 64) \
+    PERF_TEST_CHECKSUM_BLOCK(name, impl, 512) \
+    PERF_TEST_CHECKSUM_BLOCK(name, impl, 4096) \
+    PERF_TEST_CHECKSUM_BLOCK(name, impl, 16384) \
+    PERF_TEST_CHECKSUM_BLOCK(name, impl, 65536)
+
+PERF_TEST_CHECKSUM_BLOCKS(adler, adler32_utils)
+PERF_TEST_CHECKSUM_BLOCKS(zlib_crc32, zlib_crc32_checksummer)
+PERF_TEST_CHECKSUM_BLOCKS(deflate_crc32, libdeflate_crc32_checksummer)
+PERF_TEST_CHECKSUM_BLOCKS(crc32c, crc32c_utils)
@@ -1072,6 +1072,46 @@ class large_part_ds1 : public simple_large_part_ds {
     }
 };
 
+// Rows of large_part_ds1, with range tombstones which overlap each other
+// but are older than the rows. All rows are live, but readers have to merge
+// the range tombstones.
+class large_part_rt_ds1 : public simple_large_part_ds {
+public:
+    static constexpr int n_range_tombstones = 10000;
+
+    large_part_rt_ds1() : simple_large_part_ds("large-part-rt-ds1", "One large partition with many small rows and 10k overlapping range tombstones") {}
+
+    generator_fn make_generator(schema_ptr s, const table_config& cfg) override {
+        auto value = serialized(make_blob(cfg.value_size));
+        auto& value_cdef = *s->get_column_definition("value");
+        auto pk = make_pk(*s);
+        auto n_ck = n_rows(cfg);
+        auto stride = std::max(1, n_ck / n_range_tombstones);
+        return [this, s, ck = 0, n_ck, rt = 0, stride, &value_cdef, value, pk] () mutable -> std::optional<mutation> {
+            mutation m(s, pk);
+            if (ck < n_ck) {
+                auto& row = m.partition().clustered_row(*s, make_ck(*s, ck));
+                row.cells().apply(value_cdef, atomic_cell::make_live(*value_cdef.type, api::new_timestamp(), value));
+                ++ck;
+                return m;
+            }
+            if (rt == n_range_tombstones) {
+                return std::nullopt;
+            }
+            // Each range tombstone overlaps the next two.
+            auto range = query::clustering_range::make(make_missing_ck(*s, rt * stride), make_missing_ck(*s, (rt + 3) * stride));
+            auto bounds = bound_view::from_range(range);
+            m.partition().apply_delete(*s, range_tombstone(bounds.first, bounds.second, tombstone(rt + 1, gc_clock::now())));
+            ++rt;
+            return m;
+        };
+    }
+
+    bool enabled_by_default() const override {
+        return false;
+    }
+};
+
 class scylla_bench_large_part_ds1 : public scylla_bench_ds {
 public:
     scylla_bench_large_part_ds1() : scylla_bench_ds("sb-large-part-ds1", "One large partition with many small rows, scylla-bench schema") {}
@@ -1693,6 +1733,35 @@ void test_large_partition_forwarding(app_template &app, replica::column_family&
   });
 }
 
+void test_large_partition_range_tombstones(app_template &app, replica::column_family& cf, large_part_rt_ds1& ds) {
+    auto n_rows = ds.n_rows(cfg);
+
+    output_mgr->set_test_param_names({{"offset", "{:<7}"}, {"read", "{:<7}"}}, test_result::stats_names());
+    auto test = [&] (int offset, int read) {
+      run_test_case(app, [&] {
+        auto r = slice_rows_by_ck(cf, ds, offset, read);
+        r.set_params(to_sstrings(offset, read));
+        // Range tombstone changes come on top of the rows.
+        if (r.fragments_read < uint64_t(std::min(n_rows - offset, read))) {
+            r.set_error(format("Expected to read at least {:d} rows", std::min(n_rows - offset, read)));
+        }
+        return r;
+      });
+    };
+
+    test(0, 1);
+    test(0, 32);
+    test(0, 256);
+    test(0, 4096);
+
+    test(n_rows / 2, 1);
+    test(n_rows / 2, 32);
+    test(n_rows / 2, 256);
+    test(n_rows / 2, 4096);
+
+    test(0, n_rows);
+}
+
 void test_small_partition_skips(app_template &app, replica::column_family& cf2, multipart_ds& ds) {
     auto n_parts = ds.n_partitions(cfg);
 
@@ -1786,6 +1855,7 @@ auto make_datasets() {
     };
     add(std::make_unique<small_part_ds1>());
     add(std::make_unique<large_part_ds1>());
+    add(std::make_unique<large_part_rt_ds1>());
     add(std::make_unique<scylla_bench_large_part_ds1>());
     add(std::make_unique<scylla_bench_small_part_ds1>());
     return dsets;
@@ -1923,6 +1993,14 @@ static std::initializer_list<test_group> test_groups = {
         test_group::type::large_partition,
         make_test_fn(test_large_partition_forwarding),
     },
+    {
+        "large-partition-range-tombstones",
+        "Testing slicing of large partition with many overlapping range tombstones.\n" \
+        "Requires the large-part-rt-ds1 dataset",
+        test_group::requires_cache::no,
+        test_group::type::large_partition,
+        make_test_fn(test_large_partition_range_tombstones),
+    },
     {
         "small-partition-skips",
         "Testing scanning small partitions with skips.\n" \
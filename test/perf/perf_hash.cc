@@ -7,6 +7,7 @@
  */
 
 #include "utils/murmur_hash.hh"
+#include "utils/xx_hasher.hh"
 #include "test/perf/perf.hh"
 
 volatile uint64_t black_hole;
@@ -35,5 +36,49 @@ int main(int argc, char* argv[]) {
         sink += dst[1];
     });
 
+    // Keys of a typical batch of writes, of a few different lengths.
+    std::vector<bytes> batch_src;
+    for (int i = 0; i < 256; ++i) {
+        batch_src.push_back(bytes(src.begin(), 8 + i % 32));
+        batch_src.back()[0] = i;
+    }
+    std::vector<bytes_view> batch(batch_src.begin(), batch_src.end());
+    std::vector<std::array<uint64_t,2>> batch_dst(batch.size());
+
+    std::cout << "Timing fixed hash of " << batch.size() << " keys one by one...\n";
+
+    time_it([&] {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            utils::murmur_hash::hash3_x64_128(batch[i], seed, batch_dst[i]);
+        }
+        sink += batch_dst.back()[0];
+    });
+
+    std::cout << "Timing multi-key hash of " << batch.size() << " keys...\n";
+
+    time_it([&] {
+        utils::murmur_hash::hash3_x64_128(batch, seed, batch_dst);
+        sink += batch_dst.back()[0];
+    });
+
+    // A digest is fed with many short values: cells, timestamps, lengths.
+    auto time_digest = [&] (auto hasher) {
+        time_it([&] {
+            auto h = hasher;
+            for (auto& v : batch) {
+                int64_t ts = v.size();
+                h.update(reinterpret_cast<const char*>(&ts), sizeof(ts));
+                h.update(reinterpret_cast<const char*>(v.data()), v.size());
+            }
+            sink += h.finalize_array()[0];
+        });
+    };
+
+    std::cout << "Timing XXH64 digest of " << batch.size() << " keys...\n";
+    time_digest(xx_hasher());
+
+    std::cout << "Timing XXH3 digest of " << batch.size() << " keys...\n";
+    time_digest(xxh3_hasher());
+
     black_hole = sink;
 }
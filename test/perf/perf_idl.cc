@@ -22,19 +22,31 @@ class frozen_mutation {
 
     mutation _one_small_row;
     ::frozen_mutation _frozen_one_small_row;
+
+    mutation _many_rows;
+    ::frozen_mutation _frozen_many_rows;
 public:
+    static constexpr unsigned many_rows_count = 1000;
+
     frozen_mutation()
         : _semaphore(__FILE__)
         , _one_small_row(_schema.schema(), _schema.make_pkey(0))
         , _frozen_one_small_row(_one_small_row)
+        , _many_rows(_schema.schema(), _schema.make_pkey(1))
+        , _frozen_many_rows(_many_rows)
     {
         _one_small_row.apply(_schema.make_row(_semaphore.make_permit(), _schema.make_ckey(0), "value"));
         _frozen_one_small_row = freeze(_one_small_row);
+        for (unsigned i = 0; i < many_rows_count; ++i) {
+            _many_rows.apply(_schema.make_row(_semaphore.make_permit(), _schema.make_ckey(i), "value"));
+        }
+        _frozen_many_rows = freeze(_many_rows);
     }
     schema_ptr schema() const { return _schema.schema(); }
 
     const mutation& one_small_row() const { return _one_small_row; }
     const ::frozen_mutation& frozen_one_small_row() const { return _frozen_one_small_row; }
+    const ::frozen_mutation& frozen_many_rows() const { return _frozen_many_rows; }
 };
 
 PERF_TEST_F(frozen_mutation, freeze_one_small_row)
@@ -57,4 +69,15 @@ PERF_TEST_F(frozen_mutation, apply_one_small_row)
     perf_tests::do_not_optimize(m);
 }
 
+// Applying a frozen mutation on the replica, which is dominated by walking
+// the serialized rows and cells through the IDL views.
+PERF_TEST_F(frozen_mutation, apply_many_rows)
+{
+    auto m = mutation(schema(), frozen_many_rows().key());
+    mutation_application_stats app_stats;
+    m.partition().apply(*schema(), frozen_many_rows().partition(), *schema(), app_stats);
+    perf_tests::do_not_optimize(m);
+    return many_rows_count;
+}
+
 }
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+// Measures the cost of running many Raft groups on the same nodes, as with
+// a group per tablet.
+//
+// Every group has a server on each of the nodes, and all servers run on
+// shard 0 and talk over an in-memory network. All servers are ticked
+// together, as raft_group_registry does. With --batching, the messages of
+// the groups are coalesced per destination node by raft_message_batcher,
+// otherwise each one is a network message of its own. Reports the number
+// of network messages, which is what batching reduces, and the time it
+// takes to tick all servers.
+
+#include <ranges>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/util/log.hh>
+
+#include "bytes.hh"
+#include "raft/server.hh"
+#include "service/raft/raft_message_batcher.hh"
+#include "test/lib/random_utils.hh"
+#include "utils/overloaded_functor.hh"
+
+using namespace std::chrono_literals;
+
+seastar::logger plog("perf");
+
+struct test_config {
+    unsigned groups;
+    unsigned nodes;
+    unsigned duration;
+    unsigned warmup;
+    unsigned concurrency;
+    std::chrono::milliseconds tick_interval;
+    bool batching;
+    uint32_t coalescing_window_us;
+};
+
+struct test_stats {
+    uint64_t raft_messages = 0;
+    uint64_t network_messages = 0;
+};
+
+class test_node;
+class test_rpc;
+
+struct test_net {
+    std::unordered_map<raft::server_id, std::unique_ptr<test_node>> nodes;
+    test_stats stats;
+};
+
+// A node, with a server for each group.
+class test_node {
+    raft::server_id _id;
+    test_net& _net;
+    std::unordered_map<raft::group_id, test_rpc*> _servers;
+    service::raft_message_batcher _batcher;
+    bool _batching;
+public:
+    test_node(raft::server_id id, test_net& net, const test_config& conf)
+        : _id(id)
+        , _net(net)
+        , _batcher([this] (raft::server_id dst, std::vector<service::raft_batched_message> messages) {
+            ++_net.stats.network_messages;
+            for (auto& m : messages) {
+                deliver(dst, std::move(m));
+            }
+            return make_ready_future<>();
+        }, service::raft_message_batcher::config{
+            .window_in_us = utils::updateable_value<uint32_t>(conf.coalescing_window_us),
+        })
+        , _batching(conf.batching)
+    {
+        _batcher.set_supported();
+    }
+
+    raft::server_id id() const {
+        return _id;
+    }
+
+    void add_server(raft::group_id gid, test_rpc& rpc) {
+        _servers[gid] = &rpc;
+    }
+
+    void remove_server(raft::group_id gid) {
+        _servers.erase(gid);
+    }
+
+    void deliver(raft::server_id dst, service::raft_batched_message m);
+
+    future<> send(raft::server_id dst, raft::group_id gid, service::raft_batched_message::message_type message) {
+        ++_net.stats.raft_messages;
+        if (_batching) {
+            return _batcher.send(dst, gid, std::move(message));
+        }
+        ++_net.stats.network_messages;
+        deliver(dst, service::raft_batched_message{.gid = gid, .message = std::move(message)});
+        return make_ready_future<>();
+    }
+
+    future<> stop() {
+        return _batcher.stop();
+    }
+};
+
+class test_rpc : public raft::rpc {
+    raft::group_id _gid;
+    test_node& _node;
+    seastar::gate _gate;
+
+    void send(raft::server_id id, service::raft_batched_message::message_type message) {
+        if (_gate.is_closed()) {
+            return;
+        }
+        (void)with_gate(_gate, [this, id, message = std::move(message)] () mutable {
+            return _node.send(id, _gid, std::move(message));
+        });
+    }
+public:
+    test_rpc(raft::group_id gid, test_node& node) : _gid(gid), _node(node) {}
+
+    raft::rpc_server& client() {
+        return *_client;
+    }
+
+    future<raft::snapshot_reply> send_snapshot(raft::server_id, const raft::install_snapshot&, seastar::abort_source&) override {
+        throw std::runtime_error("snapshot transfer is not supported");
+    }
+    future<> send_append_entries(raft::server_id id, const raft::append_request& append_request) override {
+        send(id, append_request);
+        return make_ready_future<>();
+    }
+    void send_append_entries_reply(raft::server_id id, const raft::append_reply& reply) override {
+        send(id, reply);
+    }
+    void send_vote_request(raft::server_id id, const raft::vote_request& vote_request) override {
+        send(id, vote_request);
+    }
+    void send_vote_reply(raft::server_id id, const raft::vote_reply& vote_reply) override {
+        send(id, vote_reply);
+    }
+    void send_timeout_now(raft::server_id id, const raft::timeout_now& timeout_now) override {
+        send(id, timeout_now);
+    }
+    void send_read_quorum(raft::server_id id, const raft::read_quorum& read_quorum) override {
+        send(id, read_quorum);
+    }
+    void send_read_quorum_reply(raft::server_id id, const raft::read_quorum_reply& reply) override {
+        send(id, reply);
+    }
+    future<raft::read_barrier_reply> execute_read_barrier_on_leader(raft::server_id) override {
+        throw std::runtime_error("read barriers are not supported");
+    }
+    future<raft::add_entry_reply> send_add_entry(raft::server_id, const raft::command&) override {
+        throw std::runtime_error("entry forwarding is not supported");
+    }
+    future<raft::add_entry_reply> send_modify_config(raft::server_id, const std::vector<raft::config_member>&,
+            const std::vector<raft::server_id>&) override {
+        throw std::runtime_error("configuration changes are not supported");
+    }
+    void on_configuration_change(raft::server_address_set, raft::server_address_set) override {
+    }
+    future<> abort() override {
+        _node.remove_server(_gid);
+        return _gate.close();
+    }
+};
+
+void test_node::deliver(raft::server_id dst, service::raft_batched_message m) {
+    auto node = _net.nodes.find(dst);
+    if (node == _net.nodes.end()) {
+        return;
+    }
+    auto it = node->second->_servers.find(m.gid);
+    if (it == node->second->_servers.end()) {
+        return;
+    }
+    auto& s = it->second->client();
+    std::visit(overloaded_functor{
+        [&] (raft::append_request& r) { s.append_entries(_id, std::move(r)); },
+        [&] (raft::append_reply& r) { s.append_entries_reply(_id, std::move(r)); },
+        [&] (raft::vote_request& r) { s.request_vote(_id, r); },
+        [&] (raft::vote_reply& r) { s.request_vote_reply(_id, r); },
+        [&] (raft::timeout_now& r) { s.timeout_now_request(_id, r); },
+        [&] (raft::read_quorum& r) { s.read_quorum_request(_id, r); },
+        [&] (raft::read_quorum_reply& r) { s.read_quorum_reply(_id, r); },
+    }, m.message);
+}
+
+class test_persistence : public raft::persistence {
+    raft::snapshot_descriptor _snapshot;
+public:
+    explicit test_persistence(raft::configuration config) : _snapshot{.config = std::move(config)} {}
+
+    future<> store_term_and_vote(raft::term_t, raft::server_id) override { co_return; }
+    future<std::pair<raft::term_t, raft::server_id>> load_term_and_vote() override {
+        co_return std::pair(raft::term_t{1}, raft::server_id{});
+    }
+    future<> store_commit_idx(raft::index_t) override { co_return; }
+    future<raft::index_t> load_commit_idx() override { co_return raft::index_t{0}; }
+    future<> store_snapshot_descriptor(const raft::snapshot_descriptor& snap, size_t) override {
+        _snapshot = snap;
+        co_return;
+    }
+    future<raft::snapshot_descriptor> load_snapshot_descriptor() override { co_return _snapshot; }
+    future<> store_log_entries(const std::vector<raft::log_entry_ptr>&) override { co_return; }
+    future<raft::log_entries> load_log() override { co_return raft::log_entries{}; }
+    future<> truncate_log(raft::index_t) override { co_return; }
+    future<> abort() override { co_return; }
+};
+
+class test_state_machine : public raft::state_machine {
+public:
+    future<> apply(std::vector<raft::command_cref>) override { co_return; }
+    future<raft::snapshot_id> take_snapshot() override { co_return raft::snapshot_id::create_random_id(); }
+    void drop_snapshot(raft::snapshot_id) override {}
+    future<> load_snapshot(raft::snapshot_id) override { co_return; }
+    future<> abort() override { co_return; }
+};
+
+struct test_failure_detector : public raft::failure_detector {
+    bool is_alive(raft::server_id) override { return true; }
+};
+
+struct test_group {
+    raft::group_id gid;
+    std::vector<std::unique_ptr<raft::server>> servers;
+};
+
+// Ticks all servers together, yielding between the groups, as raft_group_registry does.
+future<std::chrono::steady_clock::duration> tick_all(std::vector<test_group>& groups) {
+    auto start = std::chrono::steady_clock::now();
+    for (auto& g : groups) {
+        for (auto& s : g.servers) {
+            s->tick();
+        }
+        co_await coroutine::maybe_yield();
+    }
+    co_return std::chrono::steady_clock::now() - start;
+}
+
+future<> run(const test_config& conf) {
+    test_net net;
+    auto fd = seastar::make_shared<test_failure_detector>();
+
+    raft::configuration config;
+    for (unsigned i = 0; i < conf.nodes; ++i) {
+        auto id = raft::server_id::create_random_id();
+        net.nodes.emplace(id, std::make_unique<test_node>(id, net, conf));
+        config.current.emplace(raft::server_address{id, {}}, true);
+    }
+
+    std::vector<test_group> groups(conf.groups);
+    for (auto& g : groups) {
+        g.gid = raft::group_id{utils::make_random_uuid()};
+        for (auto& [id, node] : net.nodes) {
+            auto rpc = std::make_unique<test_rpc>(g.gid, *node);
+            auto& rpc_ref = *rpc;
+            g.servers.push_back(raft::create_server(id, std::move(rpc), std::make_unique<test_state_machine>(),
+                    std::make_unique<test_persistence>(config), fd, raft::server::configuration{.enable_forwarding = false}));
+            node->add_server(g.gid, rpc_ref);
+        }
+        co_await coroutine::parallel_for_each(g.servers, [] (auto& s) {
+            return s->start();
+        });
+    }
+    plog.info("Started {} groups on {} nodes", conf.groups, conf.nodes);
+
+    uint64_t ticks = 0;
+    std::chrono::steady_clock::duration tick_time{};
+    std::chrono::steady_clock::duration max_tick_time{};
+    bool ticking = false;
+    seastar::gate tick_gate;
+    timer<lowres_clock> ticker([&] {
+        if (ticking) {
+            return;
+        }
+        ticking = true;
+        (void)with_gate(tick_gate, [&] {
+            return tick_all(groups).then([&] (std::chrono::steady_clock::duration t) {
+                ++ticks;
+                tick_time += t;
+                max_tick_time = std::max(max_tick_time, t);
+                ticking = false;
+            });
+        });
+    });
+    ticker.arm_periodic(conf.tick_interval);
+
+    co_await seastar::sleep(std::chrono::seconds(conf.warmup));
+    ticks = 0;
+    tick_time = max_tick_time = {};
+    net.stats = {};
+
+    uint64_t commands = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(conf.duration);
+    co_await coroutine::parallel_for_each(std::views::iota(0u, conf.concurrency), [&] (unsigned) -> future<> {
+        while (std::chrono::steady_clock::now() < end) {
+            auto& g = groups[tests::random::get_int<size_t>(0, groups.size() - 1)];
+            auto leader = std::ranges::find_if(g.servers, [] (auto& s) { return s->is_leader(); });
+            if (leader == g.servers.end()) {
+                co_await seastar::sleep(conf.tick_interval);
+                continue;
+            }
+            raft::command cmd;
+            cmd.write(bytes(bytes::initialized_later(), 128));
+            try {
+                co_await (*leader)->add_entry(std::move(cmd), raft::wait_type::committed, nullptr);
+                ++commands;
+            } catch (raft::not_a_leader&) {
+            } catch (raft::dropped_entry&) {
+            }
+        }
+    });
+    if (!conf.concurrency) {
+        co_await seastar::sleep_until(end);
+    }
+
+    ticker.cancel();
+    co_await tick_gate.close();
+    unsigned leaders = 0;
+    for (auto& g : groups) {
+        leaders += std::ranges::count_if(g.servers, [] (auto& s) { return s->is_leader(); });
+    }
+    auto avg_tick = ticks ? tick_time / ticks : tick_time;
+    fmt::print("groups={} nodes={} batching={} leaders={} commands/s={:.0f} raft_messages/s={:.0f} network_messages/s={:.0f}"
+            " messages/network_message={:.1f} tick avg={}us max={}us\n",
+            conf.groups, conf.nodes, conf.batching, leaders, double(commands) / conf.duration,
+            double(net.stats.raft_messages) / conf.duration, double(net.stats.network_messages) / conf.duration,
+            net.stats.network_messages ? double(net.stats.raft_messages) / net.stats.network_messages : 0.0,
+            std::chrono::duration_cast<std::chrono::microseconds>(avg_tick).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(max_tick_time).count());
+
+    for (auto& g : groups) {
+        for (auto& s : g.servers) {
+            co_await s->abort();
+        }
+    }
+    for (auto& [id, node] : net.nodes) {
+        co_await node->stop();
+    }
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("groups", bpo::value<unsigned>()->default_value(10000), "number of raft groups")
+        ("nodes", bpo::value<unsigned>()->default_value(3), "number of nodes, each group has a server on every node")
+        ("duration", bpo::value<unsigned>()->default_value(10), "seconds to measure for")
+        ("warmup", bpo::value<unsigned>()->default_value(5), "seconds to wait for the groups to elect leaders before measuring")
+        ("concurrency", bpo::value<unsigned>()->default_value(0), "number of clients adding entries to random groups")
+        ("tick-interval-ms", bpo::value<unsigned>()->default_value(100), "interval of the shared ticker")
+        ("batching", bpo::value<bool>()->default_value(true), "coalesce the messages of the groups per destination node")
+        ("coalescing-window-us", bpo::value<uint32_t>()->default_value(200), "how long the batcher holds a message")
+    ;
+    return app.run(argc, argv, [&app] () -> future<> {
+        auto& opts = app.configuration();
+        test_config conf {
+            .groups = opts["groups"].as<unsigned>(),
+            .nodes = opts["nodes"].as<unsigned>(),
+            .duration = opts["duration"].as<unsigned>(),
+            .warmup = opts["warmup"].as<unsigned>(),
+            .concurrency = opts["concurrency"].as<unsigned>(),
+            .tick_interval = std::chrono::milliseconds(opts["tick-interval-ms"].as<unsigned>()),
+            .batching = opts["batching"].as<bool>(),
+            .coalescing_window_us = opts["coalescing-window-us"].as<uint32_t>(),
+        };
+        co_await run(conf);
+    });
+}
@@ -21,7 +21,8 @@ int main(int argc, char* argv[]) {
     namespace bpo = boost::program_options;
     app_template app;
     app.add_options()
-        ("column-count", bpo::value<size_t>()->default_value(1), "column count");
+        ("column-count", bpo::value<size_t>()->default_value(1), "column count")
+        ("rows-per-append", bpo::value<size_t>()->default_value(16), "number of rows in each mutation appended to a partition");
     return app.run_deprecated(argc, argv, [&] {
         size_t column_count = app.configuration()["column-count"].as<size_t>();
         auto builder = schema_builder("ks", "cf")
@@ -49,6 +50,24 @@ int main(int argc, char* argv[]) {
             m.set_clustered_cell(c_key, col, make_atomic_cell(col.type, value));
             mt.apply(std::move(m));
         });
+
+        size_t rows_per_append = app.configuration()["rows-per-append"].as<size_t>();
+        std::cout << "Timing appends of " << rows_per_append << " rows to the end of one partition...\n";
+
+        replica::memtable append_mt(s);
+        auto append_key = partition_key::from_exploded(*s, {to_bytes("key2")});
+        int32_t next_ck = 0;
+        time_it([&] {
+            mutation m(s, append_key);
+            for (size_t i = 0; i < rows_per_append; ++i) {
+                auto ck = clustering_key::from_exploded(*s, {int32_type->decompose(next_ck++)});
+                for (auto& name : cnames) {
+                    const column_definition& col = *s->get_column_definition(to_bytes(name));
+                    m.set_clustered_cell(ck, col, make_atomic_cell(col.type, value));
+                }
+            }
+            append_mt.apply(std::move(m));
+        });
         engine().exit(0);
     });
 }
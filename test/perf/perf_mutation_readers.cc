@@ -219,6 +219,65 @@ PERF_TEST_F(combined, overlapping_partitions_disjoint_rows)
     ));
 }
 
+// A single wide partition, with its rows spread round-robin over the
+// readers, so that each fragment comes from a different reader than the
+// previous one. Measures the cost of merging as many readers as there
+// are sstables in a large compaction.
+class combined_wide {
+    mutable simple_schema _schema;
+    perf::reader_concurrency_semaphore_wrapper _semaphore;
+    reader_permit _permit;
+    dht::decorated_key _pkey;
+protected:
+    static constexpr int rows = 4096;
+
+    future<size_t> read_interleaved(int n_readers) const;
+public:
+    combined_wide()
+        : _semaphore("combined_wide")
+        , _permit(_semaphore.make_permit())
+        , _pkey(_schema.make_pkey())
+    { }
+};
+
+future<size_t> combined_wide::read_interleaved(int n_readers) const {
+    std::vector<mutation_reader> mrs;
+    mrs.reserve(n_readers);
+    for (int r = 0; r < n_readers; r++) {
+        auto m = mutation(_schema.schema(), _pkey);
+        for (int i = r; i < rows; i += n_readers) {
+            m.apply(_schema.make_row(_permit, _schema.make_ckey(i), "value"));
+        }
+        mrs.emplace_back(make_mutation_reader_from_mutations(_schema.schema(), _permit, std::move(m)));
+    }
+    auto rd = make_combined_reader(_schema.schema(), _permit, std::move(mrs));
+    return with_closeable(std::move(rd), [] (mutation_reader& rd) {
+        perf_tests::start_measuring_time();
+        return rd.consume_pausable([] (mutation_fragment_v2 mf) {
+            perf_tests::do_not_optimize(mf);
+            return stop_iteration::no;
+        }).then([] {
+            perf_tests::stop_measuring_time();
+            return size_t(rows);
+        });
+    });
+}
+
+PERF_TEST_F(combined_wide, interleaved_4)
+{
+    return read_interleaved(4);
+}
+
+PERF_TEST_F(combined_wide, interleaved_16)
+{
+    return read_interleaved(16);
+}
+
+PERF_TEST_F(combined_wide, interleaved_64)
+{
+    return read_interleaved(64);
+}
+
 struct mutation_bounds {
     mutation m;
     position_in_partition lower;
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+// Measures throughput and commit latency of a single Raft group.
+//
+// All servers of the group run on shard 0 and talk over an in-memory
+// network. The network and the log persistence can be given a fixed
+// delay each, to see how well the write path hides them by batching
+// log entries and pipelining append entries requests.
+
+#include <ranges>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/util/log.hh>
+
+#include "bytes.hh"
+#include "raft/server.hh"
+
+using namespace std::chrono_literals;
+
+seastar::logger plog("perf");
+
+struct test_config {
+    unsigned duration;
+    unsigned concurrency;
+    std::vector<unsigned> nodes;
+    unsigned command_size;
+    std::chrono::microseconds network_delay;
+    std::chrono::microseconds persistence_delay;
+    size_t append_request_threshold;
+    size_t max_in_flight_append_requests;
+};
+
+class test_rpc;
+using test_net = std::unordered_map<raft::server_id, test_rpc*>;
+
+// Counters shared by all servers of the group.
+struct test_stats {
+    uint64_t appends = 0;
+    uint64_t stores = 0;
+    uint64_t stored_entries = 0;
+};
+
+class test_rpc : public raft::rpc {
+    raft::server_id _id;
+    test_net& _net;
+    test_stats& _stats;
+    std::chrono::microseconds _delay;
+    seastar::gate _gate;
+
+    template <typename Func>
+    void deliver(raft::server_id to, Func func) {
+        auto it = _net.find(to);
+        if (it == _net.end() || _gate.is_closed()) {
+            return;
+        }
+        if (_delay == 0us) {
+            func(*it->second->_client);
+            return;
+        }
+        (void)with_gate(_gate, [this, to, func = std::move(func)] () mutable {
+            return seastar::sleep(_delay).then([this, to, func = std::move(func)] () mutable {
+                if (auto it = _net.find(to); it != _net.end()) {
+                    func(*it->second->_client);
+                }
+            });
+        });
+    }
+public:
+    test_rpc(raft::server_id id, test_net& net, test_stats& stats, std::chrono::microseconds delay)
+            : _id(id), _net(net), _stats(stats), _delay(delay) {
+        _net[_id] = this;
+    }
+
+    future<raft::snapshot_reply> send_snapshot(raft::server_id, const raft::install_snapshot&, seastar::abort_source&) override {
+        throw std::runtime_error("snapshot transfer is not supported");
+    }
+    future<> send_append_entries(raft::server_id id, const raft::append_request& append_request) override {
+        ++_stats.appends;
+        deliver(id, [from = _id, req = append_request.copy()] (raft::rpc_server& s) mutable {
+            s.append_entries(from, std::move(req));
+        });
+        return make_ready_future<>();
+    }
+    void send_append_entries_reply(raft::server_id id, const raft::append_reply& reply) override {
+        deliver(id, [from = _id, reply] (raft::rpc_server& s) {
+            s.append_entries_reply(from, reply);
+        });
+    }
+    void send_vote_request(raft::server_id id, const raft::vote_request& vote_request) override {
+        deliver(id, [from = _id, vote_request] (raft::rpc_server& s) {
+            s.request_vote(from, vote_request);
+        });
+    }
+    void send_vote_reply(raft::server_id id, const raft::vote_reply& vote_reply) override {
+        deliver(id, [from = _id, vote_reply] (raft::rpc_server& s) {
+            s.request_vote_reply(from, vote_reply);
+        });
+    }
+    void send_timeout_now(raft::server_id id, const raft::timeout_now& timeout_now) override {
+        deliver(id, [from = _id, timeout_now] (raft::rpc_server& s) {
+            s.timeout_now_request(from, timeout_now);
+        });
+    }
+    void send_read_quorum(raft::server_id id, const raft::read_quorum& read_quorum) override {
+        deliver(id, [from = _id, read_quorum] (raft::rpc_server& s) {
+            s.read_quorum_request(from, read_quorum);
+        });
+    }
+    void send_read_quorum_reply(raft::server_id id, const raft::read_quorum_reply& reply) override {
+        deliver(id, [from = _id, reply] (raft::rpc_server& s) {
+            s.read_quorum_reply(from, reply);
+        });
+    }
+    future<raft::read_barrier_reply> execute_read_barrier_on_leader(raft::server_id) override {
+        throw std::runtime_error("read barriers are not supported");
+    }
+    future<raft::add_entry_reply> send_add_entry(raft::server_id, const raft::command&) override {
+        throw std::runtime_error("entry forwarding is not supported");
+    }
+    future<raft::add_entry_reply> send_modify_config(raft::server_id, const std::vector<raft::config_member>&,
+            const std::vector<raft::server_id>&) override {
+        throw std::runtime_error("configuration changes are not supported");
+    }
+    void on_configuration_change(raft::server_address_set, raft::server_address_set) override {
+    }
+    future<> abort() override {
+        _net.erase(_id);
+        return _gate.close();
+    }
+};
+
+class test_persistence : public raft::persistence {
+    raft::snapshot_descriptor _snapshot;
+    test_stats& _stats;
+    std::chrono::microseconds _delay;
+public:
+    test_persistence(raft::configuration config, test_stats& stats, std::chrono::microseconds delay)
+            : _snapshot{.config = std::move(config)}, _stats(stats), _delay(delay) {
+    }
+
+    future<> store_term_and_vote(raft::term_t, raft::server_id) override { co_return; }
+    future<std::pair<raft::term_t, raft::server_id>> load_term_and_vote() override {
+        co_return std::pair(raft::term_t{1}, raft::server_id{});
+    }
+    future<> store_commit_idx(raft::index_t) override { co_return; }
+    future<raft::index_t> load_commit_idx() override { co_return raft::index_t{0}; }
+    future<> store_snapshot_descriptor(const raft::snapshot_descriptor& snap, size_t) override {
+        _snapshot = snap;
+        co_return;
+    }
+    future<raft::snapshot_descriptor> load_snapshot_descriptor() override { co_return _snapshot; }
+    // Simulates a single fsync per call, however many entries it carries.
+    future<> store_log_entries(const std::vector<raft::log_entry_ptr>& entries) override {
+        ++_stats.stores;
+        _stats.stored_entries += entries.size();
+        if (_delay > 0us) {
+            co_await seastar::sleep(_delay);
+        }
+    }
+    future<raft::log_entries> load_log() override { co_return raft::log_entries{}; }
+    future<> truncate_log(raft::index_t) override { co_return; }
+    future<> abort() override { co_return; }
+};
+
+class test_state_machine : public raft::state_machine {
+public:
+    future<> apply(std::vector<raft::command_cref>) override { co_return; }
+    future<raft::snapshot_id> take_snapshot() override { co_return raft::snapshot_id::create_random_id(); }
+    void drop_snapshot(raft::snapshot_id) override {}
+    future<> load_snapshot(raft::snapshot_id) override { co_return; }
+    future<> abort() override { co_return; }
+};
+
+struct test_failure_detector : public raft::failure_detector {
+    bool is_alive(raft::server_id) override { return true; }
+};
+
+struct test_result {
+    uint64_t commands = 0;
+    std::vector<std::chrono::microseconds> latencies;
+};
+
+future<> run_group(const test_config& conf, unsigned nodes) {
+    test_net net;
+    test_stats stats;
+    auto fd = seastar::make_shared<test_failure_detector>();
+
+    std::vector<raft::server_id> ids;
+    raft::configuration config;
+    for (unsigned i = 0; i < nodes; ++i) {
+        ids.push_back(raft::server_id::create_random_id());
+        config.current.emplace(raft::server_address{ids.back(), {}}, true);
+    }
+
+    raft::server::configuration server_config {
+        .append_request_threshold = conf.append_request_threshold,
+        .max_in_flight_append_requests = conf.max_in_flight_append_requests,
+        .enable_forwarding = false,
+    };
+    std::vector<std::unique_ptr<raft::server>> servers;
+    for (auto id : ids) {
+        servers.push_back(raft::create_server(id,
+                std::make_unique<test_rpc>(id, net, stats, conf.network_delay),
+                std::make_unique<test_state_machine>(),
+                std::make_unique<test_persistence>(config, stats, conf.persistence_delay),
+                fd, server_config));
+    }
+    co_await coroutine::parallel_for_each(servers, [] (auto& s) {
+        return s->start();
+    });
+
+    timer<lowres_clock> ticker([&servers] {
+        for (auto& s : servers) {
+            s->tick();
+        }
+    });
+    ticker.arm_periodic(10ms);
+
+    auto& leader = *servers[0];
+    leader.wait_until_candidate();
+    co_await leader.wait_election_done();
+
+    stats = {};
+    test_result result;
+    auto command_payload = bytes(bytes::initialized_later(), conf.command_size);
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(conf.duration);
+    auto start = std::chrono::steady_clock::now();
+    co_await coroutine::parallel_for_each(std::views::iota(0u, conf.concurrency), [&] (unsigned) -> future<> {
+        while (std::chrono::steady_clock::now() < end) {
+            raft::command cmd;
+            cmd.write(command_payload);
+            auto t = std::chrono::steady_clock::now();
+            co_await leader.add_entry(std::move(cmd), raft::wait_type::committed, nullptr);
+            result.latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t));
+            ++result.commands;
+        }
+    });
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ticker.cancel();
+    for (auto& s : servers) {
+        co_await s->abort();
+    }
+
+    std::ranges::sort(result.latencies);
+    auto percentile = [&] (double p) {
+        if (result.latencies.empty()) {
+            return 0us;
+        }
+        return result.latencies[std::min(result.latencies.size() - 1, size_t(result.latencies.size() * p))];
+    };
+    auto per_command = [&] (uint64_t v) {
+        return result.commands ? double(v) / result.commands : 0.0;
+    };
+    fmt::print("nodes={} commands={} throughput={:.0f} cmd/s latency p50={}us p99={}us max={}us"
+            " append_requests/cmd={:.3f} stores/cmd={:.3f} entries/store={:.1f}\n",
+            nodes, result.commands, result.commands / elapsed,
+            percentile(0.5).count(), percentile(0.99).count(), percentile(1).count(),
+            per_command(stats.appends), per_command(stats.stores),
+            stats.stores ? double(stats.stored_entries) / stats.stores : 0.0);
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("duration", bpo::value<unsigned>()->default_value(5), "seconds to run each group")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "number of concurrent clients of the leader")
+        ("nodes", bpo::value<std::vector<unsigned>>()->default_value({3, 5}, "3 5")->multitoken(), "group sizes to test")
+        ("command-size", bpo::value<unsigned>()->default_value(128), "size of a single command in bytes")
+        ("network-delay-us", bpo::value<unsigned>()->default_value(100), "one way delay of a message")
+        ("persistence-delay-us", bpo::value<unsigned>()->default_value(200), "delay of a single log store call, i.e. an fsync")
+        ("append-request-threshold", bpo::value<size_t>()->default_value(100000), "max size of an append entries request in bytes")
+        ("max-in-flight-append-requests", bpo::value<size_t>()->default_value(10), "max number of append entries requests in flight to a follower")
+    ;
+    return app.run(argc, argv, [&app] () -> future<> {
+        auto& opts = app.configuration();
+        test_config conf {
+            .duration = opts["duration"].as<unsigned>(),
+            .concurrency = opts["concurrency"].as<unsigned>(),
+            .nodes = opts["nodes"].as<std::vector<unsigned>>(),
+            .command_size = opts["command-size"].as<unsigned>(),
+            .network_delay = std::chrono::microseconds(opts["network-delay-us"].as<unsigned>()),
+            .persistence_delay = std::chrono::microseconds(opts["persistence-delay-us"].as<unsigned>()),
+            .append_request_threshold = opts["append-request-threshold"].as<size_t>(),
+            .max_in_flight_append_requests = opts["max-in-flight-append-requests"].as<size_t>(),
+        };
+        for (auto nodes : conf.nodes) {
+            plog.info("Running a group of {} nodes", nodes);
+            co_await run_group(conf, nodes);
+        }
+    });
+}
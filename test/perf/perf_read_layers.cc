@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <fstream>
+
+#include <fmt/ranges.h>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <json/json.h>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/util/closeable.hh>
+#include <seastar/util/defer.hh>
+
+#include "db/row_cache.hh"
+#include "readers/combined.hh"
+#include "release.hh"
+#include "replica/memtable.hh"
+#include "schema/schema_builder.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+#include "test/perf/perf.hh"
+
+/// Decomposes the cost of a single-partition read into the cost of each
+/// layer of the read path, by reading the same dataset from each of them:
+///
+///   memtable               - from a memtable
+///   cache_hit              - from a fully populated cache
+///   cache_miss             - through a cache which doesn't have the partition, from one sstable
+///   cache_miss_sstables    - through a cache which doesn't have the partition, from N sstables
+///                            which all have it
+///   sstable                - from one uncompressed sstable, bypassing the cache
+///   sstable_compressed     - from one compressed sstable
+///   sstables_overlapping   - from N sstables which all have the partition, merging them
+///   sstables_filtered      - from N sstables of which the bloom filters of all but one
+///                            reject the partition
+///
+/// Each shard reads from its own copy of the dataset.
+///
+/// Example run:
+///
+///    $ build/release/test/perf/perf_read_layers -c1 -m1G --json-result=read_layers.json
+
+struct test_config {
+    unsigned partitions;
+    unsigned rows;
+    unsigned value_size;
+    unsigned sstables;
+    unsigned concurrency;
+    unsigned iterations;
+};
+
+static schema_ptr make_schema(compression_parameters cp) {
+    return schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("v", bytes_type)
+            .set_compressor_params(std::move(cp))
+            .build();
+}
+
+// The dataset of a shard, and the layers reading it.
+class read_layers_dataset {
+    sstables::test_env& _env;
+    test_config _cfg;
+    schema_ptr _s;
+    schema_ptr _compressed_s;
+    std::vector<dht::decorated_key> _keys;
+    std::vector<dht::decorated_key> _compressed_keys;
+    lw_shared_ptr<replica::memtable> _mt;
+    sstables::shared_sstable _sst;
+    sstables::shared_sstable _compressed_sst;
+    // Each has a share of the rows of every partition
+    std::vector<sstables::shared_sstable> _overlapping;
+    // Each has a share of the partitions
+    std::vector<sstables::shared_sstable> _disjoint;
+    cache_tracker _tracker;
+    std::optional<row_cache> _cache;
+    // The caches of the cache_miss* layers have their own tracker, so that
+    // dropping the partitions they read doesn't touch the LRU of _cache.
+    cache_tracker _miss_tracker;
+    std::optional<row_cache> _miss_cache;
+    std::optional<row_cache> _miss_sstables_cache;
+    bytes _value;
+    api::timestamp_type _timestamp = api::new_timestamp();
+public:
+    read_layers_dataset(sstables::test_env& env, test_config cfg)
+        : _env(env)
+        , _cfg(cfg)
+        , _s(make_schema(compression_parameters::no_compression()))
+        , _compressed_s(make_schema(compression_parameters(compression_parameters::algorithm::lz4)))
+        , _value(tests::random::get_bytes(cfg.value_size))
+    { }
+
+    future<> populate() {
+        return seastar::async([this] {
+            do_populate();
+        });
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+
+    // Reads a random partition of the dataset through `layer`.
+    future<> read(const sstring& layer) {
+        const auto& keys = layer == "sstable_compressed" ? _compressed_keys : _keys;
+        const auto& dk = keys[tests::random::get_int<size_t>(0, keys.size() - 1)];
+        auto pr = dht::partition_range::make_singular(dk);
+        auto rd = make_layer_reader(layer, pr);
+        co_await with_closeable(std::move(rd), [] (mutation_reader& rd) {
+            return rd.consume_pausable([] (mutation_fragment_v2 mf) {
+                return stop_iteration::no;
+            });
+        });
+        // Drop only the partition read, so that the next read of it misses
+        // again, without evicting those which other reads are populating.
+        if (layer == "cache_miss") {
+            co_await _miss_cache->invalidate(row_cache::external_updater([] {}), dk);
+        } else if (layer == "cache_miss_sstables") {
+            co_await _miss_sstables_cache->invalidate(row_cache::external_updater([] {}), dk);
+        }
+    }
+
+    static const std::vector<sstring>& layers() {
+        static const std::vector<sstring> layers = {
+            "memtable",
+            "cache_hit",
+            "cache_miss",
+            "cache_miss_sstables",
+            "sstable",
+            "sstable_compressed",
+            "sstables_overlapping",
+            "sstables_filtered",
+        };
+        return layers;
+    }
+
+private:
+    // The partitions of the dataset, with the rows for which `has_row(partition, row)` is true.
+    utils::chunked_vector<mutation> make_mutations(schema_ptr s, std::function<bool(unsigned, unsigned)> has_row) {
+        utils::chunked_vector<mutation> muts;
+        for (unsigned p = 0; p < _cfg.partitions; ++p) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(int32_t(p))));
+            for (unsigned r = 0; r < _cfg.rows; ++r) {
+                if (has_row(p, r)) {
+                    auto ck = clustering_key::from_single_value(*s, int32_type->decompose(int32_t(r)));
+                    m.set_clustered_cell(ck, "v", data_value(_value), _timestamp);
+                }
+            }
+            if (!m.partition().empty()) {
+                muts.push_back(std::move(m));
+            }
+        }
+        std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+        return muts;
+    }
+
+    static std::vector<dht::decorated_key> keys_of(const utils::chunked_vector<mutation>& muts) {
+        return muts | std::views::transform(std::mem_fn(&mutation::decorated_key)) | std::ranges::to<std::vector<dht::decorated_key>>();
+    }
+
+    void do_populate() {
+        auto all_rows = [] (unsigned, unsigned) { return true; };
+        auto muts = make_mutations(_s, all_rows);
+        auto compressed_muts = make_mutations(_compressed_s, all_rows);
+        _keys = keys_of(muts);
+        _compressed_keys = keys_of(compressed_muts);
+
+        _mt = make_lw_shared<replica::memtable>(_s);
+        for (auto& m : muts) {
+            _mt->apply(m);
+        }
+        _sst = make_sstable_containing(_env.make_sstable(_s), muts);
+        _compressed_sst = make_sstable_containing(_env.make_sstable(_compressed_s), std::move(compressed_muts));
+
+        const auto n = _cfg.sstables;
+        for (unsigned i = 0; i < n; ++i) {
+            auto rows_share = make_mutations(_s, [n, i] (unsigned, unsigned r) { return r % n == i; });
+            if (!rows_share.empty()) {
+                _overlapping.push_back(make_sstable_containing(_env.make_sstable(_s), std::move(rows_share)));
+            }
+            auto partitions_share = make_mutations(_s, [n, i] (unsigned p, unsigned) { return p % n == i; });
+            if (!partitions_share.empty()) {
+                _disjoint.push_back(make_sstable_containing(_env.make_sstable(_s), std::move(partitions_share)));
+            }
+        }
+
+        auto sst_source = _sst->as_mutation_source();
+        _cache.emplace(_s, snapshot_source([sst_source] { return sst_source; }), _tracker);
+        _miss_cache.emplace(_s, snapshot_source([sst_source] { return sst_source; }), _miss_tracker);
+        auto overlapping_source = make_combined_mutation_source(_overlapping
+                | std::views::transform([] (const sstables::shared_sstable& sst) { return sst->as_mutation_source(); })
+                | std::ranges::to<std::vector<mutation_source>>());
+        _miss_sstables_cache.emplace(_s, snapshot_source([overlapping_source] { return overlapping_source; }), _miss_tracker);
+        // Populate the cache of cache_hit with the whole dataset.
+        for (const auto& dk : _keys) {
+            auto pr = dht::partition_range::make_singular(dk);
+            auto rd = _cache->make_reader(_s, _env.make_reader_permit(), pr);
+            auto close_rd = deferred_close(rd);
+            while (rd().get());
+        }
+    }
+
+    // Reads the partition from those of the sstables whose bloom filter
+    // has it, as sstable_set::create_single_key_sstable_reader() does.
+    mutation_reader make_sstables_reader(const std::vector<sstables::shared_sstable>& ssts, const dht::partition_range& pr) {
+        const auto& dk = pr.start()->value().as_decorated_key();
+        std::vector<mutation_reader> readers;
+        for (const auto& sst : ssts) {
+            if (sst->filter_has_key(*_s, dk.key())) {
+                readers.push_back(sst->make_reader(_s, _env.make_reader_permit(), pr, _s->full_slice(),
+                        {}, streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+            }
+        }
+        return make_combined_reader(_s, _env.make_reader_permit(), std::move(readers));
+    }
+
+    mutation_reader make_layer_reader(const sstring& layer, const dht::partition_range& pr) {
+        auto permit = _env.make_reader_permit();
+        if (layer == "memtable") {
+            return _mt->make_mutation_reader(_s, std::move(permit), pr);
+        } else if (layer == "cache_hit") {
+            return _cache->make_reader(_s, std::move(permit), pr);
+        } else if (layer == "cache_miss") {
+            return _miss_cache->make_reader(_s, std::move(permit), pr);
+        } else if (layer == "cache_miss_sstables") {
+            return _miss_sstables_cache->make_reader(_s, std::move(permit), pr);
+        } else if (layer == "sstable") {
+            return _sst->make_reader(_s, std::move(permit), pr, _s->full_slice(),
+                    {}, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+        } else if (layer == "sstable_compressed") {
+            return _compressed_sst->make_reader(_compressed_s, std::move(permit), pr, _compressed_s->full_slice(),
+                    {}, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+        } else if (layer == "sstables_overlapping") {
+            return make_sstables_reader(_overlapping, pr);
+        } else if (layer == "sstables_filtered") {
+            return make_sstables_reader(_disjoint, pr);
+        }
+        throw std::invalid_argument(fmt::format("Unknown layer {}", layer));
+    }
+};
+
+static Json::Value stats_to_json(const aggregated_perf_results& agg) {
+    Json::Value stats;
+    auto med = agg.median_by_throughput;
+    stats["median tps"] = med.throughput;
+    stats["allocs_per_op"] = med.mallocs_per_op;
+    stats["logallocs_per_op"] = med.logallocs_per_op;
+    stats["tasks_per_op"] = med.tasks_per_op;
+    stats["instructions_per_op"] = med.instructions_per_op;
+    stats["cpu_cycles_per_op"] = med.cpu_cycles_per_op;
+    const auto& tps = agg.stats.at("throughput");
+    stats["mad tps"] = tps.median_absolute_deviation;
+    stats["max tps"] = tps.max;
+    stats["min tps"] = tps.min;
+    return stats;
+}
+
+static void write_json_result(std::string result_file, const test_config& cfg, const std::vector<std::pair<sstring, aggregated_perf_results>>& results_per_layer) {
+    Json::Value results;
+
+    Json::Value params;
+    params["partitions"] = cfg.partitions;
+    params["rows"] = cfg.rows;
+    params["value-size"] = cfg.value_size;
+    params["sstables"] = cfg.sstables;
+    params["concurrency"] = cfg.concurrency;
+    params["cpus"] = smp::count;
+    params["partitions,rows,sstables,concurrency,cpus"] = fmt::format("{},{},{},{},{}", cfg.partitions, cfg.rows, cfg.sstables, cfg.concurrency, smp::count);
+    results["parameters"] = std::move(params);
+
+    // A "stats" object for each layer
+    for (const auto& [layer, agg] : results_per_layer) {
+        results["stats"][layer] = stats_to_json(agg);
+    }
+    results["test_properties"]["type"] = "read_layers";
+
+    // <version>-<release>
+    auto version_components = std::vector<std::string>{};
+    auto sver = scylla_version();
+    boost::algorithm::split(version_components, sver, boost::is_any_of("-"));
+    // <scylla-build>.<date>.<git-hash>
+    auto release_components = std::vector<std::string>{};
+    boost::algorithm::split(release_components, version_components[1], boost::is_any_of("."));
+
+    Json::Value version;
+    version["commit_id"] = release_components[2];
+    version["date"] = release_components[1];
+    version["version"] = version_components[0];
+
+    auto current_time = std::time(nullptr);
+    char time_str[100];
+    ::tm time_buf;
+    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", ::localtime_r(&current_time, &time_buf));
+    version["run_date_time"] = time_str;
+
+    results["versions"]["scylla-server"] = std::move(version);
+
+    auto out = std::ofstream(result_file);
+    out << results;
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("partitions", bpo::value<unsigned>()->default_value(1000), "number of partitions")
+        ("rows", bpo::value<unsigned>()->default_value(10), "number of rows in each partition")
+        ("value-size", bpo::value<unsigned>()->default_value(100), "size of the value of each row")
+        ("sstables", bpo::value<unsigned>()->default_value(4), "number of sstables for the sstables_* layers")
+        ("concurrency", bpo::value<unsigned>()->default_value(1), "reads in flight per shard")
+        ("iterations", bpo::value<unsigned>()->default_value(5), "number of iterations of one second for each layer")
+        ("layers", bpo::value<std::vector<sstring>>()->multitoken(), fmt::format("layers to read from, all by default: {}", fmt::join(read_layers_dataset::layers(), ", ")).c_str())
+        ("json-result", bpo::value<std::string>(), "name of the json result file")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return sstables::test_env::do_with_sharded_async([&app] (sharded<sstables::test_env>& env) {
+            auto& opts = app.configuration();
+            test_config cfg{
+                .partitions = opts["partitions"].as<unsigned>(),
+                .rows = opts["rows"].as<unsigned>(),
+                .value_size = opts["value-size"].as<unsigned>(),
+                .sstables = opts["sstables"].as<unsigned>(),
+                .concurrency = opts["concurrency"].as<unsigned>(),
+                .iterations = opts["iterations"].as<unsigned>(),
+            };
+            if (cfg.partitions == 0 || cfg.rows == 0 || cfg.sstables == 0) {
+                throw std::invalid_argument("partitions, rows and sstables must be positive");
+            }
+            auto layers = opts.contains("layers") ? opts["layers"].as<std::vector<sstring>>() : read_layers_dataset::layers();
+            for (const auto& layer : layers) {
+                if (std::ranges::find(read_layers_dataset::layers(), layer) == read_layers_dataset::layers().end()) {
+                    throw std::invalid_argument(fmt::format("Unknown layer {}", layer));
+                }
+            }
+
+            sharded<read_layers_dataset> datasets;
+            datasets.start(sharded_parameter([&env] { return std::ref(env.local()); }), cfg).get();
+            auto stop_datasets = defer([&datasets] { datasets.stop().get(); });
+            std::cout << "Populating" << std::endl;
+            datasets.invoke_on_all(&read_layers_dataset::populate).get();
+
+            std::vector<std::pair<sstring, aggregated_perf_results>> results_per_layer;
+            for (const auto& layer : layers) {
+                std::cout << "\n" << layer << std::endl;
+                auto results = time_parallel([&datasets, layer] {
+                    return datasets.local().read(layer);
+                }, cfg.concurrency, cfg.iterations);
+                aggregated_perf_results agg(results);
+                std::cout << agg << std::endl;
+                results_per_layer.emplace_back(layer, std::move(agg));
+            }
+
+            std::cout << "\nSummary (median tps):\n";
+            for (const auto& [layer, agg] : results_per_layer) {
+                std::cout << fmt::format("{:<24} {:>14.2f}\n", layer, agg.median_by_throughput.throughput);
+            }
+            if (opts.contains("json-result")) {
+                write_json_result(opts["json-result"].as<std::string>(), cfg, results_per_layer);
+            }
+        });
+    });
+}
@@ -28,6 +28,8 @@ class tester {
     utils::estimated_histogram _latencies;
     unsigned _errors = 0;
     unsigned _part_size_mb;
+    unsigned _read_ahead_depth;
+    unsigned _read_ahead_part_size_mb;
     bool _remove_file;
 
     static s3::endpoint_config_ptr make_config(unsigned sockets) {
@@ -45,13 +47,15 @@ class tester {
     std::chrono::steady_clock::time_point now() const { return std::chrono::steady_clock::now(); }
 
 public:
-    tester(std::chrono::seconds dur, unsigned sockets, unsigned part_size, sstring object_name, size_t obj_size)
+    tester(std::chrono::seconds dur, unsigned sockets, unsigned part_size, unsigned read_ahead_depth, unsigned read_ahead_part_size, sstring object_name, size_t obj_size)
             : _duration(dur)
             , _object_name(std::move(object_name))
             , _object_size(obj_size)
             , _mem(memory::stats().total_memory())
             , _client(s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_config(sockets), _mem))
             , _part_size_mb(part_size)
+            , _read_ahead_depth(read_ahead_depth)
+            , _read_ahead_part_size_mb(read_ahead_part_size)
             , _remove_file(false)
     {}
 
@@ -106,10 +110,23 @@ class tester {
         } while (now() < until);
     }
 
-    future<> run_download(bool is_chunked) {
+    enum class download_mode { plain, chunked, parallel };
+
+    data_source make_download_source(download_mode mode) {
+        switch (mode) {
+        case download_mode::plain:
+            return _client->make_download_source(_object_name, s3::range{0, _object_size});
+        case download_mode::chunked:
+            return _client->make_chunked_download_source(_object_name, s3::range{0, _object_size});
+        case download_mode::parallel:
+            return _client->make_parallel_download_source(_object_name, s3::range{0, _object_size}, _read_ahead_depth, size_t(_read_ahead_part_size_mb) << 20);
+        }
+        std::abort();
+    }
+
+    future<> run_download(download_mode mode) {
         plog.info("Downloading with input_stream");
-        auto in = input_stream<char>(is_chunked ? _client->make_chunked_download_source(_object_name, s3::range{0, _object_size})
-                                                : _client->make_download_source(_object_name, s3::range{0, _object_size}));
+        auto in = input_stream<char>(make_download_source(mode));
         auto start = now();
         uint64_t sz = 0;
         co_await in.consume([&sz] (auto buf) {
@@ -122,7 +139,7 @@ class tester {
         });
         co_await in.close();
         auto time = std::chrono::duration_cast<std::chrono::duration<double>>(now() - start);
-        plog.info("Downloaded {}MB in {}s, speed {}MB/s", sz >> 20, time.count(), (sz >> 20) / time.count());
+        plog.info("Downloaded {}MB in {}s, speed {}MB/s ({:.3f}GB/s)", sz >> 20, time.count(), (sz >> 20) / time.count(), sz / time.count() / (1 << 30));
     }
 
     future<> run_upload() {
@@ -162,10 +179,12 @@ int main(int argc, char** argv) {
     namespace bpo = boost::program_options;
     app_template app;
     app.add_options()
-        ("operation", bpo::value<sstring>()->required(), "which test to perform (options: upload, get, download)")
+        ("operation", bpo::value<sstring>()->required(), "which test to perform (options: upload, get, download, chunked_download, parallel_download)")
         ("duration", bpo::value<unsigned>()->default_value(10), "seconds to run")
         ("sockets", bpo::value<unsigned>()->default_value(1), "maximum number of socket for http client")
         ("part_size_mb", bpo::value<unsigned>()->default_value(5), "part size")
+        ("read_ahead_depth", bpo::value<unsigned>()->default_value(8), "number of concurrent GETs of parallel_download")
+        ("read_ahead_part_size_mb", bpo::value<unsigned>()->default_value(8), "size of a single GET of parallel_download")
         ("object_name", bpo::value<sstring>()->default_value(""), "use given object/file name")
         ("object_size", bpo::value<size_t>()->default_value(1 << 20), "size of test object")
     ;
@@ -174,12 +193,14 @@ int main(int argc, char** argv) {
         auto dur = std::chrono::seconds(app.configuration()["duration"].as<unsigned>());
         auto sks = app.configuration()["sockets"].as<unsigned>();
         auto part_size = app.configuration()["part_size_mb"].as<unsigned>();
+        auto read_ahead_depth = app.configuration()["read_ahead_depth"].as<unsigned>();
+        auto read_ahead_part_size = app.configuration()["read_ahead_part_size_mb"].as<unsigned>();
         auto oname = app.configuration()["object_name"].as<sstring>();
         auto osz = app.configuration()["object_size"].as<size_t>();
         auto operation = app.configuration()["operation"].as<sstring>();
         sharded<tester> test;
         plog.info("Creating");
-        co_await test.start(dur, sks, part_size, oname, osz);
+        co_await test.start(dur, sks, part_size, read_ahead_depth, read_ahead_part_size, oname, osz);
         try {
             plog.info("Starting");
             co_await test.invoke_on_all(&tester::start);
@@ -190,11 +211,15 @@ int main(int argc, char** argv) {
                 co_await test.invoke_on_all(&tester::run_contiguous_get);
             } else if (operation == "download") {
                 co_await test.invoke_on_all([](auto& tester) {
-                    return tester.run_download(false);
+                    return tester.run_download(tester::download_mode::plain);
                 });
             } else if (operation == "chunked_download") {
                 co_await test.invoke_on_all([](auto& tester) {
-                    return tester.run_download(true);
+                    return tester.run_download(tester::download_mode::chunked);
+                });
+            } else if (operation == "parallel_download") {
+                co_await test.invoke_on_all([](auto& tester) {
+                    return tester.run_download(tester::download_mode::parallel);
                 });
             } else {
                 throw std::runtime_error(format("Unknown operation {}", operation));
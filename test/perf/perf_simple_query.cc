@@ -29,6 +29,17 @@
 #include "db/extensions.hh"
 #include "db/tags/extension.hh"
 #include "gms/gossiper.hh"
+#include "service/memory_limiter.hh"
+#include "transport/response.hh"
+#include "transport/server.hh"
+#include "utils/estimated_histogram.hh"
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/net/api.hh>
+#include <seastar/net/inet_address.hh>
+#include <lz4.h>
+#include <snappy-c.h>
 
 static const sstring table_name = "cf";
 
@@ -74,6 +85,14 @@ struct test_config {
     sstring timeout;
     bool bypass_cache;
     std::optional<unsigned> initial_tablets;
+    // Drive the test through cql_server on loopback instead of calling the query processor directly.
+    bool cql_server = false;
+    uint16_t cql_server_port;
+    unsigned connections_per_shard;
+    unsigned pipeline_depth;
+    cql_transport::cql_compression compression = cql_transport::cql_compression::none;
+    // Client-side request latencies, in microseconds, set by tests run through cql_server.
+    std::optional<utils::estimated_histogram> latencies;
 };
 
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
@@ -91,6 +110,7 @@ std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
            << ", mode=" << cfg.mode
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
            << ", counters=" << (cfg.counters ? "yes" : "no")
+           << ", cql_server=" << (cfg.cql_server ? "yes" : "no")
            << "}";
 }
 
@@ -123,6 +143,429 @@ static bytes make_random_key(test_config& cfg) {
     return make_key(make_random_seq(cfg));
 }
 
+static sstring compression_name(cql_transport::cql_compression c) {
+    switch (c) {
+    case cql_transport::cql_compression::none: return "none";
+    case cql_transport::cql_compression::lz4: return "lz4";
+    case cql_transport::cql_compression::snappy: return "snappy";
+    }
+    abort();
+}
+
+// Serves the native protocol on loopback for the duration of a test, so that
+// frame parsing, compression and response writing are part of what is measured.
+class loopback_cql_server {
+    sharded<service::memory_limiter> _mem_limiter;
+    sharded<cql_transport::cql_server> _server;
+public:
+    // Must be called from a seastar thread.
+    void start(cql_test_env& env, socket_address addr) {
+        _mem_limiter.start(memory::stats().total_memory()).get();
+        auto stats_key = scheduling_group_key_create(
+                make_scheduling_group_key_config<cql_transport::cql_sg_stats>(maintenance_socket_enabled::no)).get();
+        const auto& db_cfg = env.local_db().get_config();
+        auto get_server_config = sharded_parameter([&] {
+            return cql_transport::cql_server_config {
+                .timeout_config = updateable_timeout_config(db_cfg),
+                .max_request_size = _mem_limiter.local().total_memory(),
+                .partitioner_name = db_cfg.partitioner(),
+                .sharding_ignore_msb = db_cfg.murmur3_partitioner_ignore_msb_bits(),
+                .max_concurrent_requests = db_cfg.max_concurrent_requests_per_shard,
+                .cql_duplicate_bind_variable_names_refer_to_same_variable = db_cfg.cql_duplicate_bind_variable_names_refer_to_same_variable,
+                .uninitialized_connections_semaphore_cpu_concurrency = db_cfg.uninitialized_connections_semaphore_cpu_concurrency,
+                .request_timeout_on_shutdown_in_seconds = db_cfg.request_timeout_on_shutdown_in_seconds,
+            };
+        });
+        _server.start(std::ref(env.qp()), sharded_parameter([&env] { return std::ref(env.local_auth_service()); }),
+                std::ref(_mem_limiter), std::move(get_server_config), std::ref(env.service_level_controller_service()),
+                std::ref(env.gossiper()), stats_key, maintenance_socket_enabled::no).get();
+        _server.invoke_on_all([addr] (cql_transport::cql_server& server) {
+            return server.listen(addr, nullptr, false, false, std::nullopt, [&c = server.container()] () -> auto& { return c.local(); });
+        }).get();
+    }
+
+    void stop() {
+        _server.invoke_on_all(&cql_transport::cql_server::shutdown).get();
+        _server.stop().get();
+        _mem_limiter.stop().get();
+    }
+};
+
+// A minimal native protocol v4 client: just enough to prepare a statement and
+// execute it with many requests in flight on a single connection.
+class cql_client_connection {
+    using opcode = cql_transport::cql_binary_opcode;
+    static constexpr uint8_t protocol_version = 4;
+    static constexpr size_t header_size = 9;
+
+    struct frame {
+        uint8_t flags;
+        int16_t stream;
+        opcode op;
+        temporary_buffer<char> body;
+    };
+
+    // Serializes the notations of the protocol specification ([short], [string], ...).
+    struct body_writer {
+        std::vector<char> buf;
+
+        template <typename T>
+        void write_be(T v) {
+            auto pos = buf.size();
+            buf.resize(pos + sizeof(T));
+            seastar::write_be<T>(buf.data() + pos, v);
+        }
+        void write_raw(std::string_view v) {
+            buf.insert(buf.end(), v.begin(), v.end());
+        }
+        void write_string(std::string_view v) {
+            write_be<uint16_t>(v.size());
+            write_raw(v);
+        }
+        void write_long_string(std::string_view v) {
+            write_be<int32_t>(v.size());
+            write_raw(v);
+        }
+        void write_short_bytes(bytes_view v) {
+            write_be<uint16_t>(v.size());
+            write_raw(to_string_view(v));
+        }
+        void write_value(bytes_view v) {
+            write_be<int32_t>(v.size());
+            write_raw(to_string_view(v));
+        }
+    };
+
+    // Reads the notations of the protocol specification from a frame body.
+    struct body_reader {
+        const char* pos;
+        const char* end;
+
+        explicit body_reader(const temporary_buffer<char>& b) : pos(b.begin()), end(b.end()) {}
+
+        template <typename T>
+        T read_be() {
+            if (size_t(end - pos) < sizeof(T)) {
+                throw std::runtime_error("truncated CQL response");
+            }
+            auto v = seastar::read_be<T>(pos);
+            pos += sizeof(T);
+            return v;
+        }
+        std::string_view read_raw(size_t n) {
+            if (size_t(end - pos) < n) {
+                throw std::runtime_error("truncated CQL response");
+            }
+            auto v = std::string_view(pos, n);
+            pos += n;
+            return v;
+        }
+        std::string_view read_string() {
+            return read_raw(read_be<uint16_t>());
+        }
+    };
+
+    connected_socket _socket;
+    input_stream<char> _in;
+    output_stream<char> _out;
+    cql_transport::cql_compression _compression;
+    utils::estimated_histogram& _latencies;
+    bytes _prepared_id;
+    // Requests waiting for a response, indexed by stream id.
+    std::vector<std::optional<promise<>>> _pending;
+    std::vector<int16_t> _free_streams;
+    semaphore _streams;
+    semaphore _write_sem{1};
+    future<> _reader = make_ready_future<>();
+private:
+    static std::vector<char> compress(cql_transport::cql_compression c, const std::vector<char>& in) {
+        std::vector<char> out;
+        if (c == cql_transport::cql_compression::lz4) {
+            out.resize(4 + LZ4_COMPRESSBOUND(in.size()));
+            seastar::write_be<int32_t>(out.data(), in.size());
+            auto ret = LZ4_compress_default(in.data(), out.data() + 4, in.size(), out.size() - 4);
+            if (ret == 0) {
+                throw std::runtime_error("CQL frame LZ4 compression failure");
+            }
+            out.resize(4 + ret);
+        } else {
+            size_t len = snappy_max_compressed_length(in.size());
+            out.resize(len);
+            if (snappy_compress(in.data(), in.size(), out.data(), &len) != SNAPPY_OK) {
+                throw std::runtime_error("CQL frame Snappy compression failure");
+            }
+            out.resize(len);
+        }
+        return out;
+    }
+
+    static temporary_buffer<char> decompress(cql_transport::cql_compression c, temporary_buffer<char> in) {
+        if (c == cql_transport::cql_compression::lz4) {
+            if (in.size() < 4) {
+                throw std::runtime_error("CQL frame truncated");
+            }
+            temporary_buffer<char> out(seastar::read_be<int32_t>(in.get()));
+            auto ret = LZ4_decompress_safe(in.get() + 4, out.get_write(), in.size() - 4, out.size());
+            if (ret < 0 || size_t(ret) != out.size()) {
+                throw std::runtime_error("CQL frame LZ4 uncompression failure");
+            }
+            return out;
+        } else if (c == cql_transport::cql_compression::snappy) {
+            size_t len;
+            if (snappy_uncompressed_length(in.get(), in.size(), &len) != SNAPPY_OK) {
+                throw std::runtime_error("CQL frame Snappy uncompressed size is unknown");
+            }
+            temporary_buffer<char> out(len);
+            if (snappy_uncompress(in.get(), in.size(), out.get_write(), &len) != SNAPPY_OK || len != out.size()) {
+                throw std::runtime_error("CQL frame Snappy uncompression failure");
+            }
+            return out;
+        }
+        throw std::runtime_error("compressed CQL frame on a connection without compression");
+    }
+
+    future<> send_frame(int16_t stream, opcode op, body_writer body, bool may_compress = true) {
+        uint8_t flags = 0;
+        if (may_compress && _compression != cql_transport::cql_compression::none) {
+            body.buf = compress(_compression, body.buf);
+            flags |= cql_transport::cql_frame_flags::compression;
+        }
+        char header[header_size];
+        header[0] = protocol_version;
+        header[1] = flags;
+        seastar::write_be<int16_t>(header + 2, stream);
+        header[4] = static_cast<uint8_t>(op);
+        seastar::write_be<int32_t>(header + 5, body.buf.size());
+        auto units = co_await get_units(_write_sem, 1);
+        co_await _out.write(header, header_size);
+        co_await _out.write(body.buf.data(), body.buf.size());
+        co_await _out.flush();
+    }
+
+    future<std::optional<frame>> read_frame() {
+        auto header = co_await _in.read_exactly(header_size);
+        if (header.empty()) {
+            co_return std::nullopt;
+        }
+        if (header.size() != header_size) {
+            throw std::runtime_error("CQL frame header truncated");
+        }
+        frame f;
+        f.flags = header[1];
+        f.stream = seastar::read_be<int16_t>(header.get() + 2);
+        f.op = static_cast<opcode>(header[4]);
+        auto length = seastar::read_be<int32_t>(header.get() + 5);
+        f.body = co_await _in.read_exactly(length);
+        if (f.body.size() != size_t(length)) {
+            throw std::runtime_error("CQL frame body truncated");
+        }
+        if (f.flags & cql_transport::cql_frame_flags::compression) {
+            f.body = decompress(_compression, std::move(f.body));
+        }
+        co_return f;
+    }
+
+    static void check_error(const frame& f) {
+        if (f.op == opcode::ERROR) {
+            body_reader r(f.body);
+            auto code = r.read_be<int32_t>();
+            throw std::runtime_error(fmt::format("CQL error {:#x}: {}", code, r.read_string()));
+        }
+    }
+
+    // Sends a request before the response reader is started and waits for the response.
+    future<frame> roundtrip(opcode op, body_writer body, bool may_compress = true) {
+        co_await send_frame(0, op, std::move(body), may_compress);
+        auto f = co_await read_frame();
+        if (!f) {
+            throw std::runtime_error("connection closed by the server");
+        }
+        check_error(*f);
+        co_return std::move(*f);
+    }
+
+    future<> read_responses() {
+        std::exception_ptr ex;
+        try {
+            while (auto f = co_await read_frame()) {
+                if (f->stream < 0 || size_t(f->stream) >= _pending.size() || !_pending[f->stream]) {
+                    throw std::runtime_error(fmt::format("CQL response for unexpected stream {}", f->stream));
+                }
+                auto p = std::exchange(_pending[f->stream], std::nullopt);
+                try {
+                    check_error(*f);
+                    p->set_value();
+                } catch (...) {
+                    p->set_exception(std::current_exception());
+                }
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        for (auto& p : _pending) {
+            if (p) {
+                p->set_exception(ex ? ex : std::make_exception_ptr(std::runtime_error("connection closed by the server")));
+                p.reset();
+            }
+        }
+        _streams.broken();
+    }
+public:
+    cql_client_connection(connected_socket socket, cql_transport::cql_compression compression, unsigned depth, utils::estimated_histogram& latencies)
+        : _socket(std::move(socket))
+        , _in(_socket.input())
+        , _out(_socket.output())
+        , _compression(compression)
+        , _latencies(latencies)
+        , _pending(depth)
+        , _streams(depth)
+    {
+        for (unsigned i = 0; i < depth; ++i) {
+            _free_streams.push_back(depth - 1 - i);
+        }
+    }
+
+    static future<std::unique_ptr<cql_client_connection>> connect(socket_address addr, cql_transport::cql_compression compression,
+            unsigned depth, utils::estimated_histogram& latencies) {
+        auto socket = co_await seastar::connect(addr);
+        socket.set_nodelay(true);
+        co_return std::make_unique<cql_client_connection>(std::move(socket), compression, depth, latencies);
+    }
+
+    // Negotiates the connection and prepares the statement executed by execute().
+    future<> start(sstring keyspace, sstring query) {
+        body_writer startup;
+        startup.write_be<uint16_t>(_compression == cql_transport::cql_compression::none ? 1 : 2);
+        startup.write_string("CQL_VERSION");
+        startup.write_string("3.0.0");
+        if (_compression != cql_transport::cql_compression::none) {
+            startup.write_string("COMPRESSION");
+            startup.write_string(compression_name(_compression));
+        }
+        auto ready = co_await roundtrip(opcode::STARTUP, std::move(startup), false);
+        if (ready.op != opcode::READY) {
+            throw std::runtime_error(fmt::format("unexpected response to STARTUP: {}", static_cast<unsigned>(ready.op)));
+        }
+
+        body_writer use;
+        use.write_long_string(format("USE {}", keyspace));
+        use.write_be<uint16_t>(uint16_t(db::consistency_level::ONE));
+        use.write_be<uint8_t>(0);
+        co_await roundtrip(opcode::QUERY, std::move(use));
+
+        body_writer prepare;
+        prepare.write_long_string(query);
+        auto prepared = co_await roundtrip(opcode::PREPARE, std::move(prepare));
+        body_reader r(prepared.body);
+        if (r.read_be<int32_t>() != 4) { // Prepared
+            throw std::runtime_error("unexpected response to PREPARE");
+        }
+        auto id = r.read_string();
+        _prepared_id = bytes(reinterpret_cast<const bytes::value_type*>(id.data()), id.size());
+
+        _reader = read_responses();
+    }
+
+    // Executes the prepared statement with the given key, pipelined with other
+    // requests in flight on this connection.
+    future<> execute(bytes_view key) {
+        auto units = co_await get_units(_streams, 1);
+        auto stream = _free_streams.back();
+        _free_streams.pop_back();
+        auto release_stream = defer([this, stream] () noexcept { _free_streams.push_back(stream); });
+
+        body_writer execute;
+        execute.write_short_bytes(_prepared_id);
+        execute.write_be<uint16_t>(uint16_t(db::consistency_level::ONE));
+        execute.write_be<uint8_t>(0x01 | 0x02); // values, skip metadata
+        execute.write_be<uint16_t>(1);
+        execute.write_value(key);
+
+        auto start = std::chrono::steady_clock::now();
+        auto response = _pending[stream].emplace().get_future();
+        try {
+            co_await send_frame(stream, opcode::EXECUTE, std::move(execute));
+        } catch (...) {
+            _pending[stream].reset();
+            throw;
+        }
+        co_await std::move(response);
+        _latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    future<> stop() {
+        co_await _out.close();
+        _socket.shutdown_input();
+        co_await std::move(_reader);
+        co_await _in.close();
+    }
+};
+
+// The client side of tests run through cql_server: a set of connections on each shard,
+// used in turns by the workers of time_parallel().
+class cql_load_generator {
+    utils::estimated_histogram _latencies;
+    std::vector<std::unique_ptr<cql_client_connection>> _connections;
+    size_t _next = 0;
+public:
+    future<> start(socket_address addr, sstring query, unsigned connections, unsigned depth, cql_transport::cql_compression compression) {
+        for (unsigned i = 0; i < connections; ++i) {
+            auto conn = co_await cql_client_connection::connect(addr, compression, depth, _latencies);
+            co_await conn->start("ks", query);
+            _connections.push_back(std::move(conn));
+        }
+    }
+
+    future<> execute(bytes key) {
+        auto& conn = *_connections[_next++ % _connections.size()];
+        co_await conn.execute(key);
+    }
+
+    const utils::estimated_histogram& latencies() const {
+        return _latencies;
+    }
+
+    future<> stop() {
+        for (auto& conn : _connections) {
+            co_await conn->stop();
+        }
+    }
+};
+
+static std::vector<perf_result> test_prepared_over_cql_server(cql_test_env& env, test_config& cfg, sstring query) {
+    auto addr = socket_address(net::inet_address("127.0.0.1"), cfg.cql_server_port);
+    loopback_cql_server server;
+    server.start(env, addr);
+    auto stop_server = defer([&server] { server.stop(); });
+
+    sharded<cql_load_generator> generator;
+    generator.start().get();
+    auto stop_generator = defer([&generator] { generator.stop().get(); });
+    generator.invoke_on_all([&] (cql_load_generator& g) {
+        return g.start(addr, query, cfg.connections_per_shard, cfg.pipeline_depth, cfg.compression);
+    }).get();
+
+    auto results = time_parallel([&generator, &cfg] {
+            return generator.local().execute(make_random_key(cfg));
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+
+    cfg.latencies = generator.map_reduce0([] (const cql_load_generator& g) { return g.latencies(); },
+            utils::estimated_histogram(), utils::estimated_histogram_merge).get();
+    return results;
+}
+
+// Runs the given single-key prepared statement with random keys.
+static std::vector<perf_result> test_prepared(cql_test_env& env, test_config& cfg, sstring query) {
+    if (cfg.cql_server) {
+        return test_prepared_over_cql_server(env, cfg, std::move(query));
+    }
+    auto id = env.prepare(query).get();
+    return time_parallel([&env, &cfg, id] {
+            bytes key = make_random_key(cfg);
+            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+}
+
 static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
     create_partitions(env, cfg);
     sstring query = "select \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" from cf where \"KEY\" = ?";
@@ -132,11 +575,7 @@ static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
     if (!cfg.timeout.empty()) {
         query += " using timeout " + cfg.timeout;
     }
-    auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
-            bytes key = make_random_key(cfg);
-            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    return test_prepared(env, cfg, std::move(query));
 }
 
 static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
@@ -151,11 +590,7 @@ static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg)
             "\"C3\" = 0x62bcb1dbc0ff953abc703bcb63ea954f437064c0c45366799658bd6b91d0f92908d7,"
             "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
             "WHERE \"KEY\" = ?", usings);
-    auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
-            bytes key = make_random_key(cfg);
-            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    return test_prepared(env, cfg, std::move(query));
 }
 
 static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
@@ -165,11 +600,7 @@ static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg)
         usings += "USING TIMEOUT " + cfg.timeout;
     }
     sstring query = format("DELETE \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" FROM cf {}WHERE \"KEY\" = ?", usings);
-    auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
-            bytes key = make_random_key(cfg);
-            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    return test_prepared(env, cfg, std::move(query));
 }
 
 static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
@@ -184,11 +615,7 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
             "\"C3\" = \"C3\" + 4,"
             "\"C4\" = \"C4\" + 5 "
             "WHERE \"KEY\" = ?", usings);
-    auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
-            bytes key = make_random_key(cfg);
-            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    return test_prepared(env, cfg, std::move(query));
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -251,6 +678,11 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     if (cfg.initial_tablets) {
         params["initial_tablets"] = cfg.initial_tablets.value();
     }
+    if (cfg.cql_server) {
+        params["connections"] = cfg.connections_per_shard;
+        params["pipeline_depth"] = cfg.pipeline_depth;
+        params["compression"] = std::string(compression_name(cfg.compression));
+    }
     results["parameters"] = std::move(params);
 
     Json::Value stats;
@@ -265,6 +697,11 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     stats["mad tps"] = tps.median_absolute_deviation;
     stats["max tps"] = tps.max;
     stats["min tps"] = tps.min;
+    if (cfg.latencies) {
+        stats["p50 latency us"] = Json::Int64(cfg.latencies->percentile(0.5));
+        stats["p99 latency us"] = Json::Int64(cfg.latencies->percentile(0.99));
+        stats["p999 latency us"] = Json::Int64(cfg.latencies->percentile(0.999));
+    }
     results["stats"] = std::move(stats);
 
     std::string test_type;
@@ -276,6 +713,9 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     if (cfg.counters) {
         test_type += "_counters";
     }
+    if (cfg.cql_server) {
+        test_type += "_cql_server";
+    }
     results["test_properties"]["type"] = test_type;
 
     // <version>-<release>
@@ -337,6 +777,11 @@ int scylla_simple_query_main(int argc, char** argv) {
         ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
         ("timeout", bpo::value<std::string>()->default_value(""), "use timeout")
         ("bypass-cache", "use bypass cache when querying")
+        ("cql-server", "run the test through cql_server on loopback instead of calling the query processor directly")
+        ("cql-server-port", bpo::value<uint16_t>()->default_value(19042), "loopback port for --cql-server")
+        ("connections", bpo::value<unsigned>()->default_value(4), "client connections per shard, for --cql-server")
+        ("pipeline-depth", bpo::value<unsigned>()->default_value(32), "requests in flight per connection, for --cql-server")
+        ("compression", bpo::value<std::string>()->default_value("none"), "frame compression for --cql-server: none, lz4 or snappy")
         ("audit", bpo::value<std::string>(), "value for audit config entry")
         ("audit-keyspaces", bpo::value<std::string>(), "value for audit_keyspaces config entry")
         ("audit-tables", bpo::value<std::string>(), "value for audit_tables config entry")
@@ -395,6 +840,24 @@ int scylla_simple_query_main(int argc, char** argv) {
             cfg.stop_on_error = app.configuration()["stop-on-error"].as<bool>();
             cfg.timeout = app.configuration()["timeout"].as<std::string>();
             cfg.bypass_cache = app.configuration().contains("bypass-cache");
+            cfg.cql_server = app.configuration().contains("cql-server");
+            cfg.cql_server_port = app.configuration()["cql-server-port"].as<uint16_t>();
+            cfg.connections_per_shard = app.configuration()["connections"].as<unsigned>();
+            cfg.pipeline_depth = app.configuration()["pipeline-depth"].as<unsigned>();
+            auto compression = app.configuration()["compression"].as<std::string>();
+            if (compression == "lz4") {
+                cfg.compression = cql_transport::cql_compression::lz4;
+            } else if (compression == "snappy") {
+                cfg.compression = cql_transport::cql_compression::snappy;
+            } else if (compression != "none") {
+                throw std::invalid_argument(fmt::format("unknown compression: {}", compression));
+            }
+            if (cfg.cql_server) {
+                if (cfg.connections_per_shard == 0 || cfg.pipeline_depth == 0 || cfg.pipeline_depth > 32768) {
+                    throw std::invalid_argument("--connections must be positive and --pipeline-depth must be in [1, 32768]");
+                }
+                cfg.concurrency = cfg.connections_per_shard * cfg.pipeline_depth;
+            }
             audit::audit::create_audit(env.local_db().get_config(), env.get_shared_token_metadata()).handle_exception([&] (auto&& e) {
                 fmt::print("audit creation failed: {}", e);
             }).get();
@@ -405,6 +868,10 @@ int scylla_simple_query_main(int argc, char** argv) {
             auto results = do_cql_test(env, cfg);
             aggregated_perf_results agg(results);
             std::cout << agg << std::endl;
+            if (cfg.latencies) {
+                std::cout << fmt::format("latency: p50={}us p99={}us p999={}us", cfg.latencies->percentile(0.5),
+                        cfg.latencies->percentile(0.99), cfg.latencies->percentile(0.999)) << std::endl;
+            }
             if (app.configuration().contains("json-result")) {
                 write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, agg);
             }
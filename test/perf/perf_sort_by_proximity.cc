@@ -103,3 +103,19 @@ PERF_TEST_F(sort_by_proximity_topology, perf_sort_by_proximity)
     }
     return iterations;
 }
+
+// The coordinator sorts the replicas by proximity to itself, which is served
+// from the topology's cache of sorted replica sets.
+PERF_TEST_F(sort_by_proximity_topology, perf_sort_by_proximity_from_this_node)
+{
+    const auto& topology = stm->get()->get_topology();
+    auto me = topology.my_host_id();
+    size_t iterations = 0;
+    for (size_t i = 0; i < NODES; ++i) {
+        for (auto& replicas : replica_sets) {
+            topology.do_sort_by_proximity(me, replicas);
+            iterations++;
+        }
+    }
+    return iterations;
+}
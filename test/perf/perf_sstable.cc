@@ -56,6 +56,10 @@ future<> test_partitioned_streaming(distributed<perf_sstable_test_env>& dt) {
     return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::partitioned_streaming);
 }
 
+future<> test_sstable_set_select(distributed<perf_sstable_test_env>& dt) {
+    return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::sstable_set_select);
+}
+
 enum class test_modes {
     sequential_read,
     index_read,
@@ -64,6 +68,7 @@ enum class test_modes {
     compaction,
     full_scan_streaming,
     partitioned_streaming,
+    sstable_set_select,
 };
 
 static const std::unordered_map<sstring, test_modes> test_mode = {
@@ -74,6 +79,7 @@ static const std::unordered_map<sstring, test_modes> test_mode = {
     {"compaction", test_modes::compaction },
     {"full_scan_streaming", test_modes::full_scan_streaming },
     {"parititioned_streaming", test_modes::partitioned_streaming },
+    {"sstable_set_select", test_modes::sstable_set_select },
 };
 
 std::istream& operator>>(std::istream& is, test_modes& mode) {
@@ -109,8 +115,8 @@ int scylla_sstable_main(int argc, char** argv) {
         ("key_size", bpo::value<unsigned>()->default_value(128), "size of partition key")
         ("num_columns", bpo::value<unsigned>()->default_value(5), "number of columns per row")
         ("column_size", bpo::value<unsigned>()->default_value(64), "size in bytes for each column")
-        ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction mode)")
-        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming")
+        ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction and sstable_set_select modes)")
+        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming, sstable_set_select")
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
@@ -168,6 +174,8 @@ int scylla_sstable_main(int argc, char** argv) {
             case compaction:
                 test_setup::create_empty_test_dir(dir).get();
                 break;
+            case sstable_set_select:
+                break;
             }
 
             switch (mode) {
@@ -192,6 +200,9 @@ int scylla_sstable_main(int argc, char** argv) {
             case compaction:
                 test_compaction(test).get();
                 break;
+            case sstable_set_select:
+                test_sstable_set_select(test).get();
+                break;
             }
         });
     });
@@ -344,6 +344,42 @@ class perf_sstable_test_env {
         });
     }
 
+    // Single-partition lookups, as done by reads, in a partitioned sstable set
+    // of _cfg.sstables synthetic sstables laid out in levels like LCS does:
+    // each level 10 times the previous one, its sstables disjoint.
+    future<double> sstable_set_select(int idx) {
+        return seastar::async([this] {
+            const auto keys_per_sstable = 16;
+            auto keys = tests::generate_partition_keys(_cfg.sstables * keys_per_sstable, s, local_shard_only::yes, tests::key_size{_cfg.key_size, _cfg.key_size});
+            auto full_token_range = dht::token_range::make(dht::first_token(), dht::last_token());
+            auto sst_set = sstables::make_partitioned_sstable_set(s, std::move(full_token_range));
+            unsigned created = 0;
+            for (uint32_t level = 1, level_size = 10; created < _cfg.sstables; ++level, level_size *= 10) {
+                auto n = std::min(level_size, _cfg.sstables - created);
+                auto keys_per_level_sstable = keys.size() / n;
+                for (unsigned i = 0; i < n; ++i) {
+                    auto sst = _env.make_sstable(s);
+                    sstables::test(sst).set_values_for_leveled_strategy(1, level, 0,
+                            keys[i * keys_per_level_sstable].key(), keys[(i + 1) * keys_per_level_sstable - 1].key());
+                    sst_set.insert(std::move(sst));
+                }
+                created += n;
+            }
+
+            size_t selected = 0;
+            const auto start = perf_sstable_test_env::now();
+            for (unsigned i = 0; i < _cfg.partitions; ++i) {
+                auto& key = keys[tests::random::get_int<size_t>(0, keys.size() - 1)];
+                selected += sst_set.select(dht::partition_range::make_singular(key)).size();
+                thread::maybe_yield();
+            }
+            const auto end = perf_sstable_test_env::now();
+            SCYLLA_ASSERT(selected >= _cfg.partitions);
+            const auto duration = std::chrono::duration<double>(end - start).count();
+            return _cfg.partitions / duration;
+        });
+    }
+
     future<double> full_scan_streaming(int idx) {
         return do_streaming(sst_reader::full_scan);
     }
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+// Measures the write path in steady state: with the commitlog enabled and
+// memtables flushed and compacted in the background, for long enough for
+// flushes and compaction to interfere with the writes, as they do in
+// production. perf-simple-query --write, in contrast, mostly measures
+// applying writes to the memtable.
+//
+// Reports the throughput and the write latency of every second, and over
+// the steady state, the write amplification and the space amplification
+// of the compaction strategy.
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <json/json.h>
+#include <fmt/ranges.h>
+
+#include <fstream>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/testing/test_runner.hh>
+#include <seastar/util/defer.hh>
+
+#include "cql3/query_processor.hh"
+#include "db/commitlog/commitlog.hh"
+#include "db/config.hh"
+#include "release.hh"
+#include "replica/database.hh"
+#include "tasks/types.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/random_utils.hh"
+#include "test/perf/perf.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace {
+
+struct test_config {
+    unsigned duration_in_seconds;
+    unsigned warmup_in_seconds;
+    unsigned concurrency;
+    uint64_t partitions;
+    uint64_t rows_per_partition;
+    size_t value_size;
+    sstring compaction_strategy;
+    std::map<sstring, sstring> compaction_options;
+    sstring commitlog_sync;
+    bool major_compaction;
+    bool stop_on_error;
+};
+
+std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
+    return os << "{duration=" << cfg.duration_in_seconds
+            << ", warmup=" << cfg.warmup_in_seconds
+            << ", concurrency=" << cfg.concurrency
+            << ", partitions=" << cfg.partitions
+            << ", rows-per-partition=" << cfg.rows_per_partition
+            << ", value-size=" << cfg.value_size
+            << ", compaction-strategy=" << cfg.compaction_strategy
+            << ", commitlog-sync=" << cfg.commitlog_sync
+            << "}";
+}
+
+// Bytes written by the node, and the space it takes on disk, summed over all shards.
+struct storage_stats {
+    uint64_t commitlog_bytes = 0;
+    uint64_t flush_bytes = 0;
+    uint64_t compaction_bytes = 0;
+    // Of the live sstables
+    uint64_t live_disk_space = 0;
+    // Including sstables which are already compacted, but not deleted yet
+    uint64_t total_disk_space = 0;
+
+    storage_stats operator+(const storage_stats& o) const {
+        return storage_stats{
+            .commitlog_bytes = commitlog_bytes + o.commitlog_bytes,
+            .flush_bytes = flush_bytes + o.flush_bytes,
+            .compaction_bytes = compaction_bytes + o.compaction_bytes,
+            .live_disk_space = live_disk_space + o.live_disk_space,
+            .total_disk_space = total_disk_space + o.total_disk_space,
+        };
+    }
+};
+
+storage_stats get_storage_stats(cql_test_env& env) {
+    return env.db().map_reduce0([] (replica::database& db) {
+        const auto& stats = db.find_column_family("ks", "cf").get_stats();
+        return storage_stats{
+            .commitlog_bytes = db.commitlog() ? db.commitlog()->get_bytes_written() : 0,
+            .flush_bytes = stats.memtable_flush_bytes_written,
+            .compaction_bytes = stats.compaction_bytes_written,
+            .live_disk_space = uint64_t(stats.live_disk_space_used),
+            .total_disk_space = uint64_t(stats.total_disk_space_used),
+        };
+    }, storage_stats{}, std::plus<storage_stats>()).get();
+}
+
+struct sustained_write_result : public perf_result {
+    // Of the writes completed in the interval, in microseconds
+    int64_t p50_latency_us;
+    int64_t p99_latency_us;
+    int64_t p999_latency_us;
+    // Bytes written in the interval, per second
+    double commitlog_bytes_per_second;
+    double flush_bytes_per_second;
+    double compaction_bytes_per_second;
+    // At the end of the interval
+    uint64_t live_disk_space;
+    uint64_t total_disk_space;
+};
+
+} // anonymous namespace
+
+template <> struct fmt::formatter<sustained_write_result> : fmt::formatter<string_view> {
+    auto format(const sustained_write_result& r, fmt::format_context& ctx) const {
+        return fmt::format_to(ctx.out(), "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} tasks/op, {:7.0f} insns/op, {:8} errors), "
+                "latency p50={}us p99={}us p999={}us, commitlog {:.1f} MB/s, flush {:.1f} MB/s, compaction {:.1f} MB/s, disk {:.1f} MB",
+                r.throughput, r.mallocs_per_op, r.tasks_per_op, r.instructions_per_op, r.errors,
+                r.p50_latency_us, r.p99_latency_us, r.p999_latency_us,
+                r.commitlog_bytes_per_second / 1e6, r.flush_bytes_per_second / 1e6, r.compaction_bytes_per_second / 1e6,
+                r.live_disk_space / 1e6);
+    }
+};
+
+namespace {
+
+// Executes the writes of a shard, and records their latencies.
+class sustained_writer {
+    cql_test_env& _env;
+    const test_config& _cfg;
+    cql3::prepared_cache_key_type _id;
+    // Values are picked from a pool of random ones, so that they compress
+    // like real data rather than like a single repeated value.
+    std::vector<bytes> _values;
+    utils::estimated_histogram _latencies;
+public:
+    static constexpr size_t value_pool_size = 1024;
+
+    sustained_writer(cql_test_env& env, const test_config& cfg, cql3::prepared_cache_key_type id)
+        : _env(env)
+        , _cfg(cfg)
+        , _id(std::move(id))
+    {
+        _values.reserve(value_pool_size);
+        for (size_t i = 0; i < value_pool_size; ++i) {
+            _values.push_back(tests::random::get_bytes(_cfg.value_size));
+        }
+    }
+
+    future<> write() {
+        auto pk = int64_t(tests::random::get_int<uint64_t>(_cfg.partitions - 1));
+        auto ck = int64_t(tests::random::get_int<uint64_t>(_cfg.rows_per_partition - 1));
+        const auto& value = _values[tests::random::get_int<size_t>(_values.size() - 1)];
+        auto start = std::chrono::steady_clock::now();
+        co_await _env.execute_prepared(_id, {{
+                cql3::raw_value::make_value(long_type->decompose(pk)),
+                cql3::raw_value::make_value(long_type->decompose(ck)),
+                cql3::raw_value::make_value(value)}}).discard_result();
+        _latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Returns the latencies recorded since the previous call.
+    utils::estimated_histogram take_latencies() {
+        return std::exchange(_latencies, utils::estimated_histogram());
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+// The payload of a write, as the user sees it.
+size_t row_size(const test_config& cfg) {
+    return 2 * sizeof(int64_t) + cfg.value_size;
+}
+
+double amplification(uint64_t written, uint64_t base) {
+    return base ? double(written) / base : 0;
+}
+
+void write_json_result(std::string result_file, const test_config& cfg, const aggregated_perf_results& agg,
+        const std::vector<sustained_write_result>& results, Json::Value summary) {
+    Json::Value json;
+
+    Json::Value params;
+    params["duration"] = cfg.duration_in_seconds;
+    params["warmup"] = cfg.warmup_in_seconds;
+    params["concurrency"] = cfg.concurrency;
+    params["partitions"] = Json::UInt64(cfg.partitions);
+    params["rows_per_partition"] = Json::UInt64(cfg.rows_per_partition);
+    params["value_size"] = Json::UInt64(cfg.value_size);
+    params["compaction_strategy"] = std::string(cfg.compaction_strategy);
+    for (const auto& [k, v] : cfg.compaction_options) {
+        params["compaction_options"][std::string(k)] = std::string(v);
+    }
+    params["commitlog_sync"] = std::string(cfg.commitlog_sync);
+    params["cpus"] = smp::count;
+    json["parameters"] = std::move(params);
+
+    auto stats = std::move(summary);
+    auto med = agg.median_by_throughput;
+    stats["median tps"] = med.throughput;
+    stats["allocs_per_op"] = med.mallocs_per_op;
+    stats["logallocs_per_op"] = med.logallocs_per_op;
+    stats["tasks_per_op"] = med.tasks_per_op;
+    stats["instructions_per_op"] = med.instructions_per_op;
+    stats["cpu_cycles_per_op"] = med.cpu_cycles_per_op;
+    const auto& tps = agg.stats.at("throughput");
+    stats["mad tps"] = tps.median_absolute_deviation;
+    stats["max tps"] = tps.max;
+    stats["min tps"] = tps.min;
+    for (const auto& r : results) {
+        Json::Value interval;
+        interval["tps"] = r.throughput;
+        interval["errors"] = Json::UInt64(r.errors);
+        interval["p50 latency us"] = Json::Int64(r.p50_latency_us);
+        interval["p99 latency us"] = Json::Int64(r.p99_latency_us);
+        interval["p999 latency us"] = Json::Int64(r.p999_latency_us);
+        interval["commitlog bytes/s"] = r.commitlog_bytes_per_second;
+        interval["flush bytes/s"] = r.flush_bytes_per_second;
+        interval["compaction bytes/s"] = r.compaction_bytes_per_second;
+        interval["live disk space"] = Json::UInt64(r.live_disk_space);
+        interval["total disk space"] = Json::UInt64(r.total_disk_space);
+        stats["intervals"].append(std::move(interval));
+    }
+    json["stats"] = std::move(stats);
+
+    json["test_properties"]["type"] = "sustained_write";
+
+    // <version>-<release>
+    auto version_components = std::vector<std::string>{};
+    auto sver = scylla_version();
+    boost::algorithm::split(version_components, sver, boost::is_any_of("-"));
+    // <scylla-build>.<date>.<git-hash>
+    auto release_components = std::vector<std::string>{};
+    boost::algorithm::split(release_components, version_components[1], boost::is_any_of("."));
+
+    Json::Value version;
+    version["commit_id"] = release_components[2];
+    version["date"] = release_components[1];
+    version["version"] = version_components[0];
+
+    auto current_time = std::time(nullptr);
+    char time_str[100];
+    ::tm time_buf;
+    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", ::localtime_r(&current_time, &time_buf));
+    version["run_date_time"] = time_str;
+
+    json["versions"]["scylla-server"] = std::move(version);
+
+    auto out = std::ofstream(result_file);
+    out << json;
+}
+
+void create_table(cql_test_env& env, const test_config& cfg) {
+    auto options = fmt::format("'class': '{}'", cfg.compaction_strategy);
+    for (const auto& [k, v] : cfg.compaction_options) {
+        options += fmt::format(", '{}': '{}'", k, v);
+    }
+    env.execute_cql(fmt::format("CREATE TABLE ks.cf (pk bigint, ck bigint, v blob, PRIMARY KEY (pk, ck)) WITH compaction = {{{}}}", options)).get();
+}
+
+void run_test(cql_test_env& env, const test_config& cfg, std::optional<std::string> json_result) {
+    std::cout << "Running test with config: " << cfg << std::endl;
+    create_table(env, cfg);
+
+    auto id = env.prepare("INSERT INTO ks.cf (pk, ck, v) VALUES (?, ?, ?)").get();
+    sharded<sustained_writer> writers;
+    writers.start(std::ref(env), std::cref(cfg), id).get();
+    auto stop_writers = defer([&writers] { writers.stop().get(); });
+
+    std::vector<utils::estimated_histogram> latencies;
+    auto prev = get_storage_stats(env);
+    auto prev_time = std::chrono::steady_clock::now();
+    auto update = [&] (sustained_write_result& r, const executor_shard_stats&) {
+        auto l = writers.map_reduce0(std::mem_fn(&sustained_writer::take_latencies),
+                utils::estimated_histogram(), utils::estimated_histogram_merge).get();
+        auto cur = get_storage_stats(env);
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration<double>(now - prev_time).count();
+        r.p50_latency_us = l.percentile(0.5);
+        r.p99_latency_us = l.percentile(0.99);
+        r.p999_latency_us = l.percentile(0.999);
+        r.commitlog_bytes_per_second = (cur.commitlog_bytes - prev.commitlog_bytes) / elapsed;
+        r.flush_bytes_per_second = (cur.flush_bytes - prev.flush_bytes) / elapsed;
+        r.compaction_bytes_per_second = (cur.compaction_bytes - prev.compaction_bytes) / elapsed;
+        r.live_disk_space = cur.live_disk_space;
+        r.total_disk_space = cur.total_disk_space;
+        latencies.push_back(std::move(l));
+        prev = cur;
+        prev_time = now;
+    };
+
+    if (cfg.warmup_in_seconds) {
+        std::cout << "Warming up for " << cfg.warmup_in_seconds << " seconds..." << std::endl;
+        time_parallel_ex<sustained_write_result>([&writers] {
+            return writers.local().write();
+        }, cfg.concurrency, cfg.warmup_in_seconds, 0, cfg.stop_on_error, update);
+        latencies.clear();
+    }
+    auto steady_state_start = get_storage_stats(env);
+    auto results = time_parallel_ex<sustained_write_result>([&writers] {
+        return writers.local().write();
+    }, cfg.concurrency, cfg.duration_in_seconds, 0, cfg.stop_on_error, update);
+    auto steady_state_end = get_storage_stats(env);
+
+    uint64_t peak_total_disk_space = 0;
+    for (const auto& r : results) {
+        peak_total_disk_space = std::max(peak_total_disk_space, r.total_disk_space);
+    }
+    auto all_latencies = std::ranges::fold_left(latencies, utils::estimated_histogram(), utils::estimated_histogram_merge);
+    uint64_t steady_state_writes = all_latencies.count();
+
+    // Bytes written by the workload, and by the node on its behalf, in the steady state.
+    auto user_bytes = steady_state_writes * row_size(cfg);
+    auto commitlog_bytes = steady_state_end.commitlog_bytes - steady_state_start.commitlog_bytes;
+    auto flush_bytes = steady_state_end.flush_bytes - steady_state_start.flush_bytes;
+    auto compaction_bytes = steady_state_end.compaction_bytes - steady_state_start.compaction_bytes;
+
+    Json::Value summary;
+    summary["p50 latency us"] = Json::Int64(all_latencies.percentile(0.5));
+    summary["p99 latency us"] = Json::Int64(all_latencies.percentile(0.99));
+    summary["p999 latency us"] = Json::Int64(all_latencies.percentile(0.999));
+    summary["max latency us"] = Json::Int64(all_latencies.max());
+    // All writes to disk per byte of user data, including the commitlog.
+    summary["write amplification"] = amplification(commitlog_bytes + flush_bytes + compaction_bytes, user_bytes);
+    // Sstable writes per byte of flushed sstables, the part of the write
+    // amplification owed to the compaction strategy.
+    summary["compaction write amplification"] = amplification(flush_bytes + compaction_bytes, flush_bytes);
+
+    auto perf_results = std::vector<perf_result>(results.begin(), results.end());
+    aggregated_perf_results agg(perf_results);
+    std::cout << agg << std::endl;
+    fmt::print("latency: p50={}us p99={}us p999={}us max={}us\n", all_latencies.percentile(0.5),
+            all_latencies.percentile(0.99), all_latencies.percentile(0.999), all_latencies.max());
+    fmt::print("write amplification: {:.2f} (commitlog: {:.2f}, flush: {:.2f}, compaction: {:.2f}), compaction write amplification: {:.2f}\n",
+            amplification(commitlog_bytes + flush_bytes + compaction_bytes, user_bytes), amplification(commitlog_bytes, user_bytes),
+            amplification(flush_bytes, user_bytes), amplification(compaction_bytes, user_bytes),
+            amplification(flush_bytes + compaction_bytes, flush_bytes));
+
+    if (cfg.major_compaction) {
+        // The space the data takes, once its overwritten versions are
+        // compacted away, is what the space used in the steady state is
+        // compared against.
+        std::cout << "Flushing memtables..." << std::endl;
+        env.db().invoke_on_all(&replica::database::flush_all_memtables).get();
+        auto before_major = get_storage_stats(env);
+        std::cout << "Running major compaction..." << std::endl;
+        env.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").compact_all_sstables(tasks::task_info{}, replica::table::do_flush::no);
+        }).get();
+        auto after_major = get_storage_stats(env);
+        summary["space amplification"] = amplification(before_major.live_disk_space, after_major.live_disk_space);
+        summary["peak space amplification"] = amplification(peak_total_disk_space, after_major.live_disk_space);
+        fmt::print("space amplification: {:.2f}, peak space amplification: {:.2f} ({} bytes after major compaction)\n",
+                amplification(before_major.live_disk_space, after_major.live_disk_space),
+                amplification(peak_total_disk_space, after_major.live_disk_space), after_major.live_disk_space);
+    }
+
+    if (json_result) {
+        write_json_result(*json_result, cfg, agg, results, std::move(summary));
+    }
+}
+
+std::map<sstring, sstring> parse_compaction_options(const std::string& s) {
+    std::map<sstring, sstring> ret;
+    std::vector<std::string> options;
+    boost::algorithm::split(options, s, boost::is_any_of(","));
+    for (const auto& option : options) {
+        if (option.empty()) {
+            continue;
+        }
+        auto eq = option.find('=');
+        if (eq == std::string::npos) {
+            throw std::invalid_argument(fmt::format("invalid compaction option, expected key=value: {}", option));
+        }
+        ret.emplace(option.substr(0, eq), option.substr(eq + 1));
+    }
+    return ret;
+}
+
+} // anonymous namespace
+
+namespace perf {
+
+int scylla_sustained_write_main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("random-seed", bpo::value<unsigned>(), "Random number generator seed")
+        ("duration", bpo::value<unsigned>()->default_value(300), "duration of the measured steady state, in seconds")
+        ("warmup", bpo::value<unsigned>()->default_value(60), "seconds to write before the steady state is measured, for memtables to fill and flushes and compaction to start")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("partitions", bpo::value<uint64_t>()->default_value(1000000), "number of partitions written to")
+        ("rows-per-partition", bpo::value<uint64_t>()->default_value(10), "number of rows in a partition written to")
+        ("value-size", bpo::value<size_t>()->default_value(100), "size of the written values, in bytes")
+        ("compaction-strategy", bpo::value<std::string>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy of the table")
+        ("compaction-options", bpo::value<std::string>()->default_value(""), "options of the compaction strategy, as key=value,...")
+        ("commitlog-sync", bpo::value<std::string>()->default_value("periodic"), "commitlog sync mode: periodic or batch")
+        ("commitlog-o-dsync", bpo::value<bool>()->default_value(true), "write the commitlog with O_DSYNC, as scylla does by default")
+        ("data-directory", bpo::value<std::string>(), "directory for the data and commitlog, instead of a temporary one; keep it off tmpfs to measure the disk")
+        ("major-compaction", bpo::value<bool>()->default_value(true), "run a major compaction at the end, to measure the space amplification")
+        ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
+        ("json-result", bpo::value<std::string>(), "name of the json result file")
+        ;
+
+    set_abort_on_internal_error(true);
+
+    return app.run(argc, argv, [&app] {
+        auto conf_seed = app.configuration()["random-seed"];
+        auto seed = conf_seed.empty() ? std::random_device()() : conf_seed.as<unsigned>();
+        std::cout << "random-seed=" << seed << '\n';
+        return smp::invoke_on_all([seed] {
+            seastar::testing::local_random_engine.seed(seed + this_shard_id());
+        }).then([&app] () -> future<> {
+            const auto& opts = app.configuration();
+            auto cfg = test_config{
+                .duration_in_seconds = opts["duration"].as<unsigned>(),
+                .warmup_in_seconds = opts["warmup"].as<unsigned>(),
+                .concurrency = opts["concurrency"].as<unsigned>(),
+                .partitions = opts["partitions"].as<uint64_t>(),
+                .rows_per_partition = opts["rows-per-partition"].as<uint64_t>(),
+                .value_size = opts["value-size"].as<size_t>(),
+                .compaction_strategy = opts["compaction-strategy"].as<std::string>(),
+                .compaction_options = parse_compaction_options(opts["compaction-options"].as<std::string>()),
+                .commitlog_sync = opts["commitlog-sync"].as<std::string>(),
+                .major_compaction = opts["major-compaction"].as<bool>(),
+                .stop_on_error = opts["stop-on-error"].as<bool>(),
+            };
+            if (cfg.duration_in_seconds == 0 || cfg.partitions == 0 || cfg.rows_per_partition == 0) {
+                throw std::invalid_argument("--duration, --partitions and --rows-per-partition must be positive");
+            }
+
+            cql_test_config env_cfg;
+            env_cfg.db_config->enable_commitlog(true);
+            env_cfg.db_config->commitlog_sync(cfg.commitlog_sync);
+            // cql_test_config disables it, to keep tests fast.
+            env_cfg.db_config->commitlog_use_o_dsync(opts["commitlog-o-dsync"].as<bool>());
+            if (opts.contains("data-directory")) {
+                env_cfg.db_config->data_file_directories.set({opts["data-directory"].as<std::string>()});
+            }
+            std::optional<std::string> json_result;
+            if (opts.contains("json-result")) {
+                json_result = opts["json-result"].as<std::string>();
+            }
+            return do_with_cql_env_thread([cfg = std::move(cfg), json_result = std::move(json_result)] (cql_test_env& env) {
+                run_test(env, cfg, json_result);
+            }, std::move(env_cfg));
+        });
+    });
+}
+
+} // namespace perf
@@ -106,6 +106,28 @@ static future<> test_basic_operations(app_template& app) {
 
         testlog.info("Copied in {:.6f} [ms]", time_to_copy.count() * 1000);
 
+        auto time_to_copy_on_all_shards = duration_in_seconds([&] {
+            smp::invoke_on_others([&tm] () -> future<> {
+                auto copy = co_await tm.copy();
+                co_await copy.clear_gently();
+            }).get();
+        });
+
+        testlog.info("Copied on all shards in {:.6f} [ms]", time_to_copy_on_all_shards.count() * 1000);
+
+        // What a topology change costs: a copy of the metadata, with one tablet of one table changed.
+        auto time_to_create_version = duration_in_seconds([&] {
+            auto version = tm.copy().get();
+            version.mutate_tablet_map_async(ids.front(), [&] (tablet_map& tmap) {
+                auto tb = tmap.first_tablet();
+                tmap.set_tablet(tb, tablet_info{tablet_replica_set{tablet_replica{h2, 0}}});
+                return make_ready_future<>();
+            }).get();
+            version.clear_gently().get();
+        });
+
+        testlog.info("Created a new version in {:.6f} [ms]", time_to_create_version.count() * 1000);
+
         auto time_to_clear = duration_in_seconds([&] {
             tm2.clear_gently().get();
         });
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include "test/lib/make_random_string.hh"
+#include "utils/ascii.hh"
+#include "utils/fragmented_temporary_buffer.hh"
+#include "utils/utf8.hh"
+
+#include <seastar/testing/perf_tests.hh>
+
+// Text of mixed-length characters, cut to size at a character boundary.
+static bytes make_multilingual_string(size_t size) {
+    static constexpr std::string_view text = "Zażółć gęślą jaźń, Ωμέγα, 日本語のテキスト, 😀🚀. ";
+    bytes b(bytes::initialized_later(), size);
+    for (size_t i = 0; i < size; ++i) {
+        b[i] = text[i % text.size()];
+    }
+    // Replace the character cut in the middle, if any, with ASCII.
+    auto is_continuation = [] (int8_t c) { return (uint8_t(c) & 0xc0) == 0x80; };
+    size_t last = size;
+    while (last > 0 && is_continuation(b[last - 1])) {
+        --last;
+    }
+    if (last > 0) {
+        auto c = uint8_t(b[last - 1]);
+        size_t char_size = c < 0x80 ? 1 : c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4;
+        if (last - 1 + char_size > size) {
+            std::fill(b.begin() + last - 1, b.end(), 'a');
+        }
+    }
+    return b;
+}
+
+static fragmented_temporary_buffer fragmentize(bytes_view b, size_t fragment_size) {
+    std::vector<temporary_buffer<char>> fragments;
+    for (size_t pos = 0; pos < b.size(); pos += fragment_size) {
+        auto n = std::min(fragment_size, b.size() - pos);
+        fragments.emplace_back(reinterpret_cast<const char*>(b.data() + pos), n);
+    }
+    return fragmented_temporary_buffer(std::move(fragments), b.size());
+}
+
+struct text_validation {
+    static constexpr size_t short_size = 16;
+    static constexpr size_t long_size = 64 * 1024;
+    // Odd-sized fragments, so that characters straddle them.
+    static constexpr size_t fragment_size = 4093;
+
+    const sstring ascii_short = make_random_string(short_size);
+    const sstring ascii_long = make_random_string(long_size);
+    const bytes utf8_short = make_multilingual_string(short_size);
+    const bytes utf8_long = make_multilingual_string(long_size);
+    const fragmented_temporary_buffer utf8_long_fragmented = fragmentize(utf8_long, fragment_size);
+
+    static const uint8_t* data(const sstring& s) {
+        return reinterpret_cast<const uint8_t*>(s.data());
+    }
+    static const uint8_t* data(const bytes& b) {
+        return reinterpret_cast<const uint8_t*>(b.data());
+    }
+};
+
+PERF_TEST_F(text_validation, ascii_16) {
+    perf_tests::do_not_optimize(utils::ascii::validate(data(ascii_short), ascii_short.size()));
+}
+
+PERF_TEST_F(text_validation, ascii_64k) {
+    perf_tests::do_not_optimize(utils::ascii::validate(data(ascii_long), ascii_long.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_ascii_16) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(ascii_short), ascii_short.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_ascii_64k) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(ascii_long), ascii_long.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_16) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(utf8_short), utf8_short.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_64k) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(utf8_long), utf8_long.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_64k_fragmented) {
+    perf_tests::do_not_optimize(utils::utf8::validate_with_error_position_fragmented(
+            fragmented_temporary_buffer::view(utf8_long_fragmented)));
+}
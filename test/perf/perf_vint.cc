@@ -59,3 +59,12 @@ PERF_TEST_F(vint, deserialize) {
     }
     return count;
 }
+
+PERF_TEST_F(vint, deserialize_unchecked) {
+    // The serialized buffer has room for the longest vint after the last one.
+    auto src = serialized().data();
+    for (auto i = 0u; i < count; i++) {
+        perf_tests::do_not_optimize(unsigned_vint::deserialize_unchecked(src));
+    }
+    return count;
+}
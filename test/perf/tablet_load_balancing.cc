@@ -8,6 +8,7 @@
 
 #include <fmt/ranges.h>
 #include <bit>
+#include <cmath>
 
 #include <seastar/core/distributed.hh>
 #include <seastar/core/app-template.hh>
@@ -203,6 +204,9 @@ struct params {
     int shards;
     int scale1 = 1;
     int scale2 = 1;
+    // Exponent of the Zipf distribution of request rates of tablets of the first table.
+    // 0 means that heat is not reported.
+    double heat_skew = 0;
 };
 
 struct table_balance {
@@ -215,6 +219,8 @@ constexpr auto nr_tables = 2;
 
 struct cluster_balance {
     table_balance tables[nr_tables];
+    // Heat of the hottest shard relative to the average shard heat of its node, worst among nodes.
+    double heat_overcommit = 0;
 };
 
 struct results {
@@ -237,7 +243,7 @@ template<>
 struct fmt::formatter<cluster_balance> : fmt::formatter<string_view> {
     template <typename FormatContext>
     auto format(const cluster_balance& r, FormatContext& ctx) const {
-        return fmt::format_to(ctx.out(), "{{table1={}, table2={}}}", r.tables[0], r.tables[1]);
+        return fmt::format_to(ctx.out(), "{{table1={}, table2={}, heat={:.2f}}}", r.tables[0], r.tables[1], r.heat_overcommit);
     }
 };
 
@@ -247,11 +253,11 @@ struct fmt::formatter<params> : fmt::formatter<string_view> {
     auto format(const params& p, FormatContext& ctx) const {
         auto tablets1_per_shard = double(p.tablets1.value_or(0)) * p.rf1 / (p.nodes * p.shards);
         auto tablets2_per_shard = double(p.tablets2.value_or(0)) * p.rf2 / (p.nodes * p.shards);
-        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}}}",
+        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}, heat_skew={}}}",
                          p.iterations, p.nodes,
                          p.tablets1.value_or(0), tablets1_per_shard,
                          p.tablets2.value_or(0), tablets2_per_shard,
-                         p.rf1, p.rf2, p.shards);
+                         p.rf1, p.rf2, p.shards, p.heat_skew);
     }
 };
 
@@ -266,6 +272,8 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
         topology_builder topo(e);
         std::vector<host_id> hosts;
         locator::load_stats stats;
+        std::optional<table_id> hot_table;
+        auto& stm = e.shared_token_metadata().local();
 
         auto add_host = [&] {
             auto host = topo.add_node(service::node_state::normal, shard_count);
@@ -275,6 +283,18 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
         };
 
         auto make_stats = [&] {
+            if (hot_table && p.heat_skew > 0) {
+                // Tablet counts are powers of two, so multiplying by an odd number
+                // permutes the ranks, which scatters hot tablets across the ring.
+                auto count = stm.get()->tablets().get_tablet_map(*hot_table).tablet_count();
+                auto& heat = stats.heat[*hot_table];
+                heat.tablet_count = count;
+                heat.requests_per_second.clear();
+                for (size_t i = 0; i < count; ++i) {
+                    auto rank = (i * 2654435761u) % count;
+                    heat.requests_per_second[tablet_id(i)] = 100000 / std::pow(rank + 1, p.heat_skew);
+                }
+            }
             return make_lw_shared<locator::load_stats>(stats);
         };
 
@@ -282,8 +302,6 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
             add_host();
         }
 
-        auto& stm = e.shared_token_metadata().local();
-
         auto bootstrap = [&] {
             add_host();
             global_res.stats += rebalance_tablets(e, make_stats());
@@ -310,6 +328,7 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
         auto id2 = add_table(e, ks2).get();
         schema_ptr s1 = e.local_db().find_schema(id1);
         schema_ptr s2 = e.local_db().find_schema(id2);
+        hot_table = id1;
 
         auto check_balance = [&] () -> cluster_balance {
             cluster_balance res;
@@ -357,6 +376,19 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 };
             }
 
+            if (p.heat_skew > 0) {
+                load_sketch load(stm.get(), make_stats());
+                load.populate().get();
+                for (auto h : hosts) {
+                    auto avg_heat = load.get_avg_shard_heat(h);
+                    if (avg_heat > 0) {
+                        res.heat_overcommit = std::max(res.heat_overcommit, load.get_shard_heat(h, load.get_hottest_shard(h)) / avg_heat);
+                    }
+                }
+                testlog.info("Shard heat overcommit: {:.2f}", res.heat_overcommit);
+                global_res.worst.heat_overcommit = std::max(global_res.worst.heat_overcommit, res.heat_overcommit);
+            }
+
             for (int i = 0; i < nr_tables; i++) {
                 auto t = res.tables[i];
                 global_res.worst.tables[i].shard_overcommit = std::max(global_res.worst.tables[i].shard_overcommit, t.shard_overcommit);
@@ -442,6 +474,7 @@ future<> run_simulations(const boost::program_options::variables_map& app_cfg) {
             .shards = shards,
             .scale1 = scale1,
             .scale2 = scale2,
+            .heat_skew = app_cfg["heat-skew"].as<double>(),
         };
 
         auto name = format("#{}", i);
@@ -463,6 +496,7 @@ int scylla_tablet_load_balancing_main(int argc, char** argv) {
             ("rf1", bpo::value<int>(), "Replication factor for the first table.")
             ("rf2", bpo::value<int>(), "Replication factor for the second table.")
             ("shards", bpo::value<int>(), "Number of shards per node.")
+            ("heat-skew", bpo::value<double>()->default_value(0), "Exponent of the Zipf distribution of request rates of tablets of the first table, 0 disables heat.")
             ("verbose", "Enables standard logging")
             ;
     return app.run(argc, argv, [&] {
@@ -488,6 +522,7 @@ int scylla_tablet_load_balancing_main(int argc, char** argv) {
                         .rf1 = app.configuration()["rf1"].as<int>(),
                         .rf2 = app.configuration()["rf2"].as<int>(),
                         .shards = app.configuration()["shards"].as<int>(),
+                        .heat_skew = app.configuration()["heat-skew"].as<double>(),
                     };
                     run_simulation(p).get();
                 }
@@ -1580,6 +1580,44 @@ BOOST_AUTO_TEST_CASE(test_non_voter_stays_pipeline) {
     BOOST_CHECK(A.get_progress(B_id).state == raft::follower_progress::state::PIPELINE);
 }
 
+BOOST_AUTO_TEST_CASE(test_max_in_flight_append_requests) {
+    // Check that the leader doesn't send more than
+    // max_in_flight_append_requests un-acked append entries
+    // requests to a follower in PIPELINE mode.
+    server_id A_id = id(), B_id = id();
+    raft::log log(raft::snapshot_descriptor{.idx = index_t{0}, .config = config_from_ids({A_id, B_id})});
+    raft::fsm_config cfg{.append_request_threshold = 1, .enable_prevoting = false, .max_in_flight_append_requests = 2};
+    fsm_debug A(A_id, term_t{}, server_id{}, log, trivial_failure_detector, cfg);
+    fsm_debug B(B_id, term_t{}, server_id{}, log, trivial_failure_detector, cfg);
+    election_timeout(A);
+    communicate(A, B);
+    BOOST_CHECK(A.is_leader());
+    A.add_entry(log_entry::dummy{});
+    A.tick();
+    communicate(A, B);
+    BOOST_CHECK(A.get_progress(B_id).state == raft::follower_progress::state::PIPELINE);
+    for (int i = 0; i < 5; ++i) {
+        A.add_entry(log_entry::dummy{});
+    }
+    // Each request carries a single entry because of the threshold,
+    // but only two of them may be sent before B replies.
+    auto output = A.get_output();
+    size_t requests = 0;
+    for (const auto& [to, m] : output.messages) {
+        if (to == B_id && std::holds_alternative<raft::append_request>(m)) {
+            ++requests;
+        }
+    }
+    BOOST_CHECK_EQUAL(requests, 2);
+    BOOST_CHECK_EQUAL(A.get_progress(B_id).in_flight, 2);
+    // Replies from B open the window again until B catches up.
+    raft_routing_map routes{{A_id, &A}, {B_id, &B}};
+    deliver(routes, A_id, std::move(output.messages));
+    communicate(A, B);
+    BOOST_CHECK_EQUAL(B.get_log().last_idx(), A.get_log().last_idx());
+    BOOST_CHECK_EQUAL(A.get_progress(B_id).match_idx, A.get_log().last_idx());
+}
+
 BOOST_AUTO_TEST_CASE(test_leader_change_to_non_voter) {
     // Test a two-node cluster, change a leader to a non-voter.
     server_id A_id = id(), B_id = id();
@@ -11,9 +11,11 @@
 
 #include "utils/UUID_gen.hh"
 
+#include "service/raft/raft_segment_log.hh"
 #include "service/raft/raft_sys_table_storage.hh"
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/tmpdir.hh"
 #include "cql3/query_processor.hh"
 
 #include "gms/inet_address_serializer.hh"
@@ -188,3 +190,159 @@ SEASTAR_TEST_CASE(test_store_snapshot_truncate_log_tail) {
         }
     });
 }
+
+static void check_log(const std::vector<raft::log_entry_ptr>& expected, const raft::log_entries& loaded) {
+    BOOST_REQUIRE_EQUAL(expected.size(), loaded.size());
+    for (size_t i = 0, end = expected.size(); i != end; ++i) {
+        BOOST_CHECK(*expected[i] == *loaded[i]);
+    }
+}
+
+static std::vector<raft::log_entry_ptr> create_test_log(raft::index_t first, size_t count) {
+    std::vector<raft::log_entry_ptr> entries;
+    for (size_t i = 0; i < count; ++i) {
+        raft::command cmd;
+        ser::serialize(cmd, sstring(1000, 'a' + i % 26));
+        entries.push_back(make_lw_shared(raft::log_entry{
+            .term = raft::term_t(1),
+            .idx = raft::index_t(first.value() + i),
+            .data = std::move(cmd)}));
+    }
+    return entries;
+}
+
+SEASTAR_TEST_CASE(test_segment_log_store_load_truncate) {
+    tmpdir tmp;
+    auto dir = tmp.path() / "log";
+    // Small segments, so that the entries are spread over several of them.
+    static constexpr size_t max_segment_size = 8 * raft_segment_log::block_size;
+    auto entries = create_test_log(raft::index_t(1), 100);
+    {
+        raft_segment_log log(dir, max_segment_size);
+        BOOST_REQUIRE((co_await log.load()).empty());
+        for (size_t i = 0; i < entries.size(); i += 10) {
+            co_await log.append(std::vector(entries.begin() + i, entries.begin() + i + 10));
+        }
+        co_await log.close();
+    }
+    {
+        raft_segment_log log(dir, max_segment_size);
+        check_log(entries, co_await log.load());
+        // Removes entries in the current and in the earlier segments
+        co_await log.truncate(raft::index_t(45));
+        entries.resize(44);
+        auto more = create_test_log(raft::index_t(45), 5);
+        co_await log.append(more);
+        entries.insert(entries.end(), more.begin(), more.end());
+        co_await log.close();
+    }
+    {
+        raft_segment_log log(dir, max_segment_size);
+        check_log(entries, co_await log.load());
+        co_await log.truncate_prefix(raft::index_t(30));
+        co_await log.close();
+    }
+    {
+        raft_segment_log log(dir, max_segment_size);
+        auto loaded = co_await log.load();
+        // Whole segments are removed, so some entries up to 30 may remain
+        BOOST_REQUIRE(!loaded.empty());
+        BOOST_REQUIRE_LE(loaded.front()->idx, raft::index_t(31));
+        BOOST_REQUIRE_GT(loaded.front()->idx, raft::index_t(1));
+        check_log(std::vector(entries.begin() + (loaded.front()->idx.value() - 1), entries.end()), loaded);
+        co_await log.remove_all();
+    }
+    {
+        raft_segment_log log(dir, max_segment_size);
+        BOOST_REQUIRE((co_await log.load()).empty());
+    }
+}
+
+SEASTAR_TEST_CASE(test_segment_log_ignores_incomplete_record) {
+    tmpdir tmp;
+    auto dir = tmp.path() / "log";
+    auto entries = create_test_log(raft::index_t(1), 3);
+    {
+        raft_segment_log log(dir);
+        co_await log.load();
+        co_await log.append(entries);
+        co_await log.close();
+    }
+    // Cut the last record short, as a write interrupted by a crash would.
+    auto segment = dir / "segment-00000000000000000000.log";
+    auto size = co_await file_size(segment.native());
+    auto f = co_await open_file_dma(segment.native(), open_flags::rw);
+    co_await f.truncate(size - raft_segment_log::block_size / 2);
+    co_await f.close();
+    {
+        raft_segment_log log(dir);
+        auto loaded = co_await log.load();
+        BOOST_REQUIRE_LT(loaded.size(), entries.size());
+        check_log(std::vector(entries.begin(), entries.begin() + loaded.size()), loaded);
+        // The log can be appended to after the last complete entry
+        auto more = std::vector(entries.begin() + loaded.size(), entries.end());
+        co_await log.append(more);
+        co_await log.close();
+    }
+    {
+        raft_segment_log log(dir);
+        check_log(entries, co_await log.load());
+    }
+}
+
+SEASTAR_TEST_CASE(test_segment_log_storage) {
+    return do_with_cql_env([] (cql_test_env& env) -> future<> {
+        cql3::query_processor& qp = env.local_qp();
+        tmpdir tmp;
+        auto id = raft::server_id::create_random_id();
+        std::vector<raft::log_entry_ptr> entries = create_test_log();
+        {
+            raft_sys_table_storage storage(qp, gid, id, tmp.path(), true);
+            co_await storage.store_log_entries(entries);
+            co_await storage.truncate_log(raft::index_t(3));
+            co_await storage.abort();
+        }
+        // Nothing is written to system.raft
+        raft_sys_table_storage table_storage(qp, gid, id, {}, false);
+        BOOST_REQUIRE((co_await table_storage.load_log()).empty());
+
+        raft_sys_table_storage storage(qp, gid, id, tmp.path(), true);
+        entries.resize(2);
+        check_log(entries, co_await storage.load_log());
+        co_await storage.abort();
+    });
+}
+
+SEASTAR_TEST_CASE(test_segment_log_storage_migration) {
+    return do_with_cql_env([] (cql_test_env& env) -> future<> {
+        cql3::query_processor& qp = env.local_qp();
+        tmpdir tmp;
+        auto id = raft::server_id::create_random_id();
+        std::vector<raft::log_entry_ptr> entries = create_test_log();
+        {
+            raft_sys_table_storage storage(qp, gid, id, tmp.path(), false);
+            co_await storage.store_log_entries(entries);
+            co_await storage.abort();
+        }
+        // Enabling the segment log moves the log out of system.raft
+        {
+            raft_sys_table_storage storage(qp, gid, id, tmp.path(), true);
+            check_log(entries, co_await storage.load_log());
+            co_await storage.abort();
+            raft_sys_table_storage table_storage(qp, gid, id, {}, false);
+            BOOST_REQUIRE((co_await table_storage.load_log()).empty());
+            raft_segment_log log(tmp.path());
+            check_log(entries, co_await log.load());
+        }
+        // Disabling it moves the log back
+        {
+            raft_sys_table_storage storage(qp, gid, id, tmp.path(), false);
+            check_log(entries, co_await storage.load_log());
+            co_await storage.abort();
+            raft_segment_log log(tmp.path());
+            BOOST_REQUIRE((co_await log.load()).empty());
+            raft_sys_table_storage table_storage(qp, gid, id, {}, false);
+            check_log(entries, co_await table_storage.load_log());
+        }
+    });
+}
@@ -0,0 +1,32 @@
+# Copyright 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+
+import requests
+
+from ..cqlpy.util import new_test_table, new_test_keyspace
+
+
+# A table with unflushed data in a segment which isn't active anymore is
+# reported as pinning it.
+def test_pinned_segments(cql, this_dc, rest_api):
+    ksdef = f"WITH REPLICATION = {{ 'class' : 'NetworkTopologyStrategy', '{this_dc}' : '1' }}"
+    with new_test_keyspace(cql, ksdef) as ks:
+        with new_test_table(cql, ks, "p int PRIMARY KEY, v text") as t1, new_test_table(cql, ks, "p int PRIMARY KEY") as t2:
+            for p in range(16):
+                cql.execute(f"INSERT INTO {t1} (p, v) VALUES ({p}, 'hello')")
+            # Flushing a table switches to new segments on all shards, but
+            # flushes only that table.
+            resp = rest_api.send("POST", f"storage_service/keyspace_flush/{ks}", params={"cf": t2.split('.')[1]})
+            resp.raise_for_status()
+
+            resp = rest_api.send("GET", "commitlog/pinned_segments")
+            assert resp.status_code == requests.codes.ok
+            entries = [e for e in resp.json() if e["keyspace"] == ks and e["table"] == t1.split('.')[1]]
+            assert entries
+            for e in entries:
+                assert e["segments"] >= 1
+                assert e["exclusive_segments"] <= e["segments"]
+                assert e["bytes"] > 0
+                assert e["oldest_data_age"] >= 0
+            assert not [e for e in resp.json() if e["keyspace"] == ks and e["table"] == t2.split('.')[1]]
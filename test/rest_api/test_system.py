@@ -10,11 +10,56 @@ def test_system_uptime_ms(rest_api):
     resp.raise_for_status()
 
 
+def test_system_startup_phases(rest_api):
+    resp = rest_api.send('GET', "system/startup_phases")
+    resp.raise_for_status()
+    phases = resp.json()
+    names = [p['name'] for p in phases]
+    assert 'loading non-system sstables' in names
+    # The node serves requests, so the startup is complete
+    assert all(p['completed'] for p in phases)
+    assert all(p['duration_ms'] >= 0 for p in phases)
+
 def test_system_highest_sstable_format(rest_api):
     resp = rest_api.send('GET', "system/highest_supported_sstable_version")
     resp.raise_for_status()
     assert resp.json() == "me"
 
+def test_system_cpu_sampler(rest_api):
+    resp = rest_api.send('POST', "system/cpu_sampler/start", params={'frequency': 1000})
+    assert resp.status_code == requests.codes.bad_request
+    resp = rest_api.send('POST', "system/cpu_sampler/start", params={'shard': 1000000})
+    assert resp.status_code == requests.codes.bad_request
+
+    resp = rest_api.send('POST', "system/cpu_sampler/start", params={'frequency': 100})
+    resp.raise_for_status()
+    try:
+        # Keep the node busy for a while, so there is something to sample
+        for _ in range(100):
+            rest_api.send('GET', "system/uptime_ms").raise_for_status()
+    finally:
+        resp = rest_api.send('POST', "system/cpu_sampler/stop")
+        resp.raise_for_status()
+    resp = rest_api.send('GET', "system/cpu_sampler/stacks")
+    resp.raise_for_status()
+    for line in resp.json():
+        stack, count = line.rsplit(' ', 1)
+        assert int(count) > 0
+        assert ';' in stack
+    resp = rest_api.send('GET', "system/cpu_sampler/stacks", params={'shard': 0})
+    resp.raise_for_status()
+
+def test_system_scheduling_groups(rest_api):
+    resp = rest_api.send('GET', "system/scheduling_groups")
+    resp.raise_for_status()
+    stats = resp.json()
+    assert 'compaction' in {s['group'] for s in stats if s['shard'] == 0}
+    assert all(s['shares'] > 0 for s in stats)
+
+    resp = rest_api.send('GET', "system/scheduling_groups", params={'shard': 0})
+    resp.raise_for_status()
+    assert all(s['shard'] == 0 for s in resp.json())
+
 @pytest.mark.parametrize("params", [
     ("storage_service/compaction_throughput", "value"),
     ("storage_service/stream_throughput", "value")
@@ -13,6 +13,7 @@
 #include <fmt/ostream.h>
 #include <fmt/ranges.h>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/units.hh>
 #include <seastar/http/short_streams.hh>
@@ -30,6 +31,8 @@
 #include "db/large_data_handler.hh"
 #include "db/corrupt_data_handler.hh"
 #include "gms/feature_service.hh"
+#include "mutation_writer/partition_based_splitting_writer.hh"
+#include "mutation_writer/shard_based_splitting_writer.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "readers/combined.hh"
 #include "readers/generating.hh"
@@ -976,7 +979,9 @@ class scylla_sstable_compaction_group_view : public compaction::compaction_group
     virtual const std::string get_group_id() const noexcept override { return _group_id; }
     virtual seastar::condition_variable& get_staging_done_condition() noexcept override { return _staging_done_condition; }
     dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override { return dht::token_range(); }
+    std::optional<sstables::compaction_type_options::split> split_options() const noexcept override { return std::nullopt; }
     int64_t get_sstables_repaired_at() const noexcept override { return 0; }
+    double read_amplification() const noexcept override { return 1.0; }
 };
 
 void validate_output_dir(std::filesystem::path output_dir, bool accept_nonempty_output_dir) {
@@ -991,6 +996,30 @@ void validate_output_dir(std::filesystem::path output_dir, bool accept_nonempty_
     }
 }
 
+unsigned get_parallelism(const bpo::variables_map& vm) {
+    const auto parallelism = vm["parallelism"].as<unsigned>();
+    if (!parallelism) {
+        throw std::invalid_argument("parallelism must be at least 1");
+    }
+    return parallelism;
+}
+
+// Runs func for all sstables, for up to parallelism of them at a time, and
+// returns the results in the order of the sstables.
+// The sstables are processed on the current shard: overlapping the I/O of
+// many sstables is what the operations which support it are bound by.
+template <typename Func>
+auto map_sstables_in_parallel(const std::vector<sstables::shared_sstable>& sstables, unsigned parallelism, Func func) {
+    using result_type = typename futurize_t<std::invoke_result_t<Func, const sstables::shared_sstable&>>::value_type;
+    std::vector<std::optional<result_type>> results(sstables.size());
+    max_concurrent_for_each(std::views::iota(size_t(0), sstables.size()), parallelism, [&] (size_t i) {
+        return futurize_invoke(func, sstables[i]).then([&results, i] (result_type res) {
+            results[i].emplace(std::move(res));
+        });
+    }).get();
+    return results | std::views::transform([] (std::optional<result_type>& res) { return std::move(*res); }) | std::ranges::to<std::vector>();
+}
+
 void validate_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
         sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
@@ -998,13 +1027,17 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
     }
 
     abort_source abort;
+    const auto results = map_sstables_in_parallel(sstables, get_parallelism(vm), [&] (const sstables::shared_sstable& sst) {
+        return sst->validate(permit, abort, [] (sstring what) { sst_log.info("{}", what); });
+    });
     // Collect JSON output and print after validation is done, to prevent
     // interleaving with error messages from validation.
     std::stringstream json_output_stream;
     json_writer writer(json_output_stream);
     writer.StartStream();
-    for (const auto& sst : sstables) {
-        const auto errors = sst->validate(permit, abort, [] (sstring what) { sst_log.info("{}", what); }).get();
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        const auto& sst = sstables[i];
+        const auto errors = results[i];
         writer.Key(fmt::to_string(sst->get_filename()));
         writer.StartObject();
         writer.Key("errors");
@@ -1050,15 +1083,27 @@ void scrub_operation(schema_ptr schema, reader_permit permit, const std::vector<
 
     scylla_sstable_compaction_group_view compaction_group_view(schema, permit, sst_man, output_dir);
 
-    auto compaction_descriptor = sstables::compaction_descriptor(std::move(sstables));
-    compaction_descriptor.options = sstables::compaction_type_options::make_scrub(scrub_mode, sstables::compaction_type_options::scrub::quarantine_invalid_sstables::no);
-    compaction_descriptor.creator = [&compaction_group_view] (shard_id) { return compaction_group_view.make_sstable(); };
-    compaction_descriptor.replacer = [] (sstables::compaction_completion_desc) { };
+    // Like the compaction manager does, scrub each sstable on its own when
+    // scrubbing more than one at a time.
+    const auto parallelism = get_parallelism(vm);
+    std::vector<std::vector<sstables::shared_sstable>> inputs;
+    if (parallelism == 1) {
+        inputs.push_back(sstables);
+    } else {
+        inputs = sstables | std::views::transform([] (const sstables::shared_sstable& sst) { return std::vector{sst}; }) | std::ranges::to<std::vector>();
+    }
+
+    max_concurrent_for_each(inputs, parallelism, [&] (std::vector<sstables::shared_sstable>& input) -> future<> {
+        auto compaction_descriptor = sstables::compaction_descriptor(std::move(input));
+        compaction_descriptor.options = sstables::compaction_type_options::make_scrub(scrub_mode, sstables::compaction_type_options::scrub::quarantine_invalid_sstables::no);
+        compaction_descriptor.creator = [&compaction_group_view] (shard_id) { return compaction_group_view.make_sstable(); };
+        compaction_descriptor.replacer = [] (sstables::compaction_completion_desc) { };
 
-    auto compaction_data = sstables::compaction_data{};
+        auto compaction_data = sstables::compaction_data{};
 
-    compaction_progress_monitor progress_monitor;
-    sstables::compact_sstables(std::move(compaction_descriptor), compaction_data, compaction_group_view, progress_monitor).get();
+        compaction_progress_monitor progress_monitor;
+        co_await sstables::compact_sstables(std::move(compaction_descriptor), compaction_data, compaction_group_view, progress_monitor);
+    }).get();
 }
 
 void dump_index_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1178,10 +1223,11 @@ void dump_summary_operation(schema_ptr schema, reader_permit permit, const std::
 
         writer.Key("entries");
         writer.StartArray();
+        sstables::summary::key_cursor keys(summary);
         for (const auto& e : summary.entries) {
             writer.StartObject();
 
-            auto pkey = e.get_key().to_partition_key(*schema);
+            auto pkey = sstables::key_view(keys.next()).to_partition_key(*schema);
             writer.Key("key");
             writer.DataKey(*schema, pkey, e.get_token());
             writer.Key("position");
@@ -1498,6 +1544,7 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::ScyllaBuildId: return "scylla_build_id";
         case sstables::scylla_metadata_type::ExtTimestampStats: return "ext_timestamp_stats";
         case sstables::scylla_metadata_type::SSTableIdentifier: return "sstable_identifier";
+        case sstables::scylla_metadata_type::FilterLayout: return "filter_layout";
     }
     std::abort();
 }
@@ -1623,6 +1670,10 @@ class scylla_metadata_visitor {
     void operator()(const sstables::scylla_metadata::sstable_identifier& sid) const {
         _writer.AsString(sid.value);
     }
+
+    void operator()(const sstables::filter_layout_metadata& fl) const {
+        _writer.String(utils::to_string(fl.layout));
+    }
 };
 
 void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1650,18 +1701,22 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
 }
 
 void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
-        sstables::sstables_manager& sst_man, const bpo::variables_map&) {
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
         throw std::invalid_argument("no sstables specified on the command line");
     }
 
+    const auto results = map_sstables_in_parallel(sstables, get_parallelism(vm), [&] (const sstables::shared_sstable& sst) {
+        return sstables::validate_checksums(sst, permit);
+    });
     // Collect JSON output and print after validation is done, to prevent
     // interleaving with error messages from validation.
     std::stringstream json_output_stream;
     json_writer writer(json_output_stream);
     writer.StartStream();
-    for (auto& sst : sstables) {
-        const auto res = sstables::validate_checksums(sst, permit).get();
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        const auto& sst = sstables[i];
+        const auto& res = results[i];
         writer.Key(fmt::to_string(sst->get_filename()));
         writer.StartObject();
         writer.Key("has_checksums");
@@ -2595,6 +2650,297 @@ class json_mutation_stream_parser {
     future<mutation_fragment_v2_opt> operator()() { return (*_impl)(); }
 };
 
+// Parses rows in CSV format into mutation fragments, one partition per row,
+// in input order.
+//
+// The first record is the header, with the name of the column of each field.
+// It has to have all key columns. Each following record is written as a row,
+// with a row marker, like an INSERT would, and one cell per non-empty field.
+// Fields can be quoted with ", quotes are escaped by doubling them. Empty
+// unquoted fields are nulls. Values are parsed like CQL literals, see
+// abstract_type::from_string().
+class csv_mutation_stream_parser {
+    using record = std::vector<std::optional<sstring>>;
+
+    class impl {
+        schema_ptr _schema;
+        reader_permit _permit;
+        input_stream<char> _is;
+        temporary_buffer<char> _buf;
+        size_t _line = 1;
+        // The line the last record started at, for error messages.
+        size_t _record_line = 1;
+        api::timestamp_type _timestamp;
+        uint64_t& _rows;
+        // The column of each field, in header order.
+        std::vector<const column_definition*> _columns;
+        std::deque<mutation_fragment_v2> _pending;
+        bool _eos = false;
+
+    private:
+        // Returns the fields of the next record, disengaged at the end of the input.
+        future<std::optional<record>> read_record() {
+            _record_line = _line;
+            record fields;
+            sstring field;
+            bool quoted = false;
+            bool in_quotes = false;
+            bool after_quote = false;
+            auto push_field = [&] {
+                fields.push_back(quoted || !field.empty() ? std::optional<sstring>(std::move(field)) : std::nullopt);
+                field = {};
+                quoted = false;
+            };
+            for (;;) {
+                if (_buf.empty()) {
+                    _buf = co_await _is.read();
+                    if (_buf.empty()) {
+                        if (in_quotes && !after_quote) {
+                            throw std::runtime_error(fmt::format("parsing input failed at line {}: unterminated quoted field", _record_line));
+                        }
+                        if (fields.empty() && field.empty() && !quoted) {
+                            co_return std::nullopt;
+                        }
+                        push_field();
+                        co_return fields;
+                    }
+                }
+                for (auto it = _buf.begin(); it != _buf.end(); ++it) {
+                    const char c = *it;
+                    if (in_quotes) {
+                        if (after_quote) {
+                            after_quote = false;
+                            if (c == '"') {
+                                field += '"';
+                                continue;
+                            }
+                            in_quotes = false;
+                        } else if (c == '"') {
+                            after_quote = true;
+                            continue;
+                        } else {
+                            if (c == '\n') {
+                                ++_line;
+                            }
+                            field += c;
+                            continue;
+                        }
+                    }
+                    if (c == '\n') {
+                        ++_line;
+                        if (fields.empty() && field.empty() && !quoted) {
+                            // Skip empty lines.
+                            _record_line = _line;
+                            continue;
+                        }
+                        push_field();
+                        _buf.trim_front(it - _buf.begin() + 1);
+                        co_return fields;
+                    } else if (c == ',') {
+                        push_field();
+                    } else if (c == '"' && field.empty() && !quoted) {
+                        quoted = in_quotes = true;
+                    } else if (c != '\r') {
+                        field += c;
+                    }
+                }
+                _buf = {};
+            }
+        }
+
+        future<> read_header() {
+            auto header = co_await read_record();
+            if (!header) {
+                co_return;
+            }
+            for (const auto& name : *header) {
+                const auto* cdef = name ? _schema->get_column_definition(to_bytes(*name)) : nullptr;
+                if (!cdef) {
+                    throw std::invalid_argument(fmt::format("header of the input has unknown column {}", name.value_or("")));
+                }
+                if (cdef->is_multi_cell() || cdef->is_counter()) {
+                    throw std::invalid_argument(fmt::format("column {} is of type {}, which is not supported", *name, cdef->type->cql3_type_name()));
+                }
+                if (std::ranges::find(_columns, cdef) != _columns.end()) {
+                    throw std::invalid_argument(fmt::format("header of the input has column {} more than once", *name));
+                }
+                _columns.push_back(cdef);
+            }
+            for (const auto& cdef : _schema->primary_key_columns()) {
+                if (std::ranges::find(_columns, &cdef) == _columns.end()) {
+                    throw std::invalid_argument(fmt::format("header of the input is missing key column {}", cdef.name_as_text()));
+                }
+            }
+        }
+
+        void parse_row(record fields) {
+            if (fields.size() != _columns.size()) {
+                throw std::runtime_error(fmt::format("parsing input failed at line {}: expected {} fields, got {}", _record_line, _columns.size(), fields.size()));
+            }
+            std::vector<bytes> pk(_schema->partition_key_size());
+            std::vector<bytes> ck(_schema->clustering_key_size());
+            row static_cells;
+            row regular_cells;
+            for (size_t i = 0; i < fields.size(); ++i) {
+                const auto& cdef = *_columns[i];
+                if (!fields[i]) {
+                    if (cdef.is_primary_key()) {
+                        throw std::runtime_error(fmt::format("parsing input failed at line {}: key column {} is null", _record_line, cdef.name_as_text()));
+                    }
+                    continue;
+                }
+                bytes value;
+                try {
+                    value = cdef.type->from_string(*fields[i]);
+                } catch (...) {
+                    throw std::runtime_error(fmt::format("parsing input failed at line {}: invalid value for column {}: {}", _record_line, cdef.name_as_text(), std::current_exception()));
+                }
+                switch (cdef.kind) {
+                    case column_kind::partition_key:
+                        pk[cdef.id] = std::move(value);
+                        break;
+                    case column_kind::clustering_key:
+                        ck[cdef.id] = std::move(value);
+                        break;
+                    case column_kind::static_column:
+                        static_cells.apply(cdef, atomic_cell_or_collection(atomic_cell::make_live(*cdef.type, _timestamp, value)));
+                        break;
+                    case column_kind::regular_column:
+                        regular_cells.apply(cdef, atomic_cell_or_collection(atomic_cell::make_live(*cdef.type, _timestamp, value)));
+                        break;
+                }
+            }
+            auto dk = dht::decorate_key(*_schema, partition_key::from_exploded(*_schema, pk));
+            _pending.emplace_back(*_schema, _permit, partition_start(std::move(dk), tombstone{}));
+            if (!static_cells.empty()) {
+                _pending.emplace_back(*_schema, _permit, static_row(std::move(static_cells)));
+            }
+            _pending.emplace_back(*_schema, _permit, clustering_row(clustering_key::from_exploded(*_schema, ck), row_tombstone{},
+                    row_marker(_timestamp), std::move(regular_cells)));
+            _pending.emplace_back(*_schema, _permit, partition_end{});
+            ++_rows;
+        }
+
+    public:
+        impl(schema_ptr schema, reader_permit permit, input_stream<char> istream, api::timestamp_type timestamp, uint64_t& rows)
+            : _schema(std::move(schema))
+            , _permit(std::move(permit))
+            , _is(std::move(istream))
+            , _timestamp(timestamp)
+            , _rows(rows)
+        { }
+        future<> close() {
+            return _is.close();
+        }
+        future<mutation_fragment_v2_opt> operator()() {
+            if (_pending.empty() && !_eos) {
+                if (_columns.empty()) {
+                    co_await read_header();
+                }
+                std::optional<record> fields;
+                if (!_columns.empty()) {
+                    fields = co_await read_record();
+                }
+                if (fields) {
+                    parse_row(std::move(*fields));
+                } else {
+                    _eos = true;
+                }
+            }
+            if (_pending.empty()) {
+                co_return std::nullopt;
+            }
+            auto mf = std::move(_pending.front());
+            _pending.pop_front();
+            co_return std::move(mf);
+        }
+    };
+    std::unique_ptr<impl> _impl;
+
+public:
+    // Counts the parsed rows into rows.
+    csv_mutation_stream_parser(schema_ptr schema, reader_permit permit, input_stream<char> istream, api::timestamp_type timestamp, uint64_t& rows)
+        : _impl(std::make_unique<impl>(std::move(schema), std::move(permit), std::move(istream), timestamp, rows))
+    { }
+    future<mutation_fragment_v2_opt> operator()() { return (*_impl)(); }
+    // Closes the input stream, must be called once the parser isn't used anymore.
+    future<> close() { return _impl->close(); }
+};
+
+// Writes the content of the CSV input into sstables, see csv_mutation_stream_parser.
+//
+// The input doesn't have to be sorted. It is sorted in memory, in runs of at
+// most memory_limit bytes, which are written to temporary sstables. The runs
+// are then merged into the output sstable(s). With a sharder, there is one
+// output sstable per shard, written concurrently.
+void write_csv(schema_ptr schema, reader_permit permit, sstables::sstables_manager& manager, input_stream<char> istream,
+        const std::filesystem::path& output_dir, int64_t generation, const dht::sharder* sharder, size_t memory_limit,
+        api::timestamp_type timestamp, const sstables::sstable_writer_config& writer_cfg) {
+    const auto format = sstables::sstable_format_types::big;
+    const auto version = sstables::get_highest_sstable_version();
+    const auto output_count = sharder ? sharder->shard_count() : 1;
+
+    for (unsigned i = 0; i < output_count; ++i) {
+        auto sst_name = sstables::sstable::filename(output_dir.native(), schema->ks_name(), schema->cf_name(), version, sstables::generation_type(generation + i), format, component_type::Data);
+        if (file_exists(sst_name).get()) {
+            throw std::invalid_argument(fmt::format("cannot create output sstable {}, file already exists", sst_name));
+        }
+    }
+
+    const auto runs_dir = output_dir / fmt::format("scylla-sstable-write-runs-{}", generation);
+    if (file_exists(runs_dir.native()).get()) {
+        throw std::invalid_argument(fmt::format("cannot create directory for the sorted runs {}, it already exists", runs_dir.native()));
+    }
+    recursive_touch_directory(runs_dir.native()).get();
+    std::vector<sstables::shared_sstable> runs;
+    auto remove_runs = defer([&] () noexcept {
+        try {
+            for (auto& sst : runs) {
+                sst->unlink(sstables::storage::sync_dir::no).get();
+            }
+            remove_file(runs_dir.native()).get();
+        } catch (...) {
+            sst_log.warn("failed to remove the sorted runs in {}: {}", runs_dir.native(), std::current_exception());
+        }
+    });
+
+    uint64_t rows = 0;
+    sstable_generation_generator run_generation_generator;
+    csv_mutation_stream_parser parser(schema, permit, std::move(istream), timestamp, rows);
+    auto close_parser = deferred_close(parser);
+    auto reader = make_generating_reader(schema, permit, [&parser] { return parser(); });
+    mutation_writer::segregate_by_partition(std::move(reader), mutation_writer::segregate_config{memory_limit}, [&] (mutation_reader rd) {
+        auto sst = manager.make_sstable(schema, data_dictionary::make_local_options(runs_dir), run_generation_generator(), sstables::sstable_state::normal, version, format);
+        runs.push_back(sst);
+        return sst->write_components(std::move(rd), std::max(rows, uint64_t(1)), schema, writer_cfg, encoding_stats{}).then([sst, schema] {
+            return sst->load(schema->get_sharder());
+        });
+    }).get();
+    close_parser.close_now();
+    sst_log.info("parsed {} rows into {} sorted run(s)", rows, runs.size());
+
+    if (runs.empty()) {
+        return;
+    }
+
+    const uint64_t estimated_partitions = std::max(rows / output_count, uint64_t(1));
+    auto next_generation = generation;
+    auto write = [&] (mutation_reader rd) {
+        auto sst = manager.make_sstable(schema, data_dictionary::make_local_options(output_dir), sstables::generation_type(next_generation++), sstables::sstable_state::normal, version, format);
+        return sst->write_components(std::move(rd), estimated_partitions, schema, writer_cfg, encoding_stats{}).then([sst] {
+            sst_log.info("written {}", sst->get_filename());
+        });
+    };
+    auto merged = make_combined_reader(schema, permit, runs | std::views::transform([&] (const sstables::shared_sstable& sst) {
+        return sst->make_reader(schema, permit, query::full_partition_range, schema->full_slice(), {}, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+    }) | std::ranges::to<std::vector<mutation_reader>>());
+    if (sharder) {
+        mutation_writer::segregate_by_shard(std::move(merged), *sharder, std::move(write)).get();
+    } else {
+        write(std::move(merged)).get();
+    }
+}
+
 void write_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
         sstables::sstables_manager& manager, const bpo::variables_map& vm) {
     static const std::vector<std::pair<std::string, mutation_fragment_stream_validation_level>> valid_validation_levels{
@@ -2626,6 +2972,32 @@ void write_operation(schema_ptr schema, reader_permit permit, const std::vector<
     if (!vm.count("generation")) {
         throw std::invalid_argument("missing required option '--generation'");
     }
+    const auto input_format = vm["input-format"].as<std::string>();
+    if (input_format != "json" && input_format != "csv") {
+        throw std::invalid_argument(fmt::format("invalid input-format {}", input_format));
+    }
+    if (input_format == "json" && vm.count("shards")) {
+        throw std::invalid_argument("--shards is only supported with --input-format=csv");
+    }
+
+    if (input_format == "csv") {
+        std::optional<dht::static_sharder> sharder;
+        if (vm.count("shards")) {
+            const auto shards = vm["shards"].as<unsigned>();
+            if (!shards) {
+                throw std::invalid_argument("shards must be at least 1");
+            }
+            sharder.emplace(shards, vm["ignore-msb-bits"].as<unsigned>());
+        }
+        const auto timestamp = vm.count("timestamp") ? vm["timestamp"].as<api::timestamp_type>() : api::new_timestamp();
+        auto writer_cfg = manager.configure_writer("scylla-sstable");
+        writer_cfg.validation_level = validation_level;
+        auto istream = make_file_input_stream(open_file_dma(input_file, open_flags::ro).get());
+        write_csv(schema, permit, manager, std::move(istream), output_dir, vm["generation"].as<int64_t>(),
+                sharder ? &*sharder : nullptr, size_t(vm["memory-limit"].as<unsigned>()) << 20, timestamp, writer_cfg);
+        return;
+    }
+
     auto generation = sstables::generation_type(vm["generation"].as<int64_t>());
     auto format = sstables::sstable_format_types::big;
     auto version = sstables::get_highest_sstable_version();
@@ -3006,6 +3378,10 @@ void query_operation(schema_ptr sstable_schema, reader_permit permit, const std:
         // cql_test_env).
         // Use the virtual reader facility to isolate the sstables from
         // cql-test-env.
+        // The partition range and the clustering ranges of the query are
+        // passed down to the sstable readers, which look them up in the index.
+        // The readers only materialize the values of the selected columns,
+        // this is safe because virtual readers are not cached.
         table.set_virtual_reader(mutation_source([&] (
                 schema_ptr schema,
                 reader_permit permit,
@@ -3019,7 +3395,8 @@ void query_operation(schema_ptr sstable_schema, reader_permit permit, const std:
                     permit,
                     sstables |
                             std::views::transform([&] (const sstables::shared_sstable& sst) {
-                                    return sst->make_reader(schema, permit, range, slice, tr, fwd_sm, fwd_mr);
+                                    return sst->make_reader(schema, permit, range, slice, tr, fwd_sm, fwd_mr,
+                                            sstables::default_read_monitor(), sstables::integrity_check::no, sstables::project_columns::yes);
                             }) |
                             std::ranges::to<std::vector<mutation_reader>>(),
                     fwd_sm,
@@ -3215,7 +3592,10 @@ validation will happen on the fragment level.
 
 See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#validate
 for more information on this operation.
-)"},
+)",
+            {
+                    typed_option<unsigned>("parallelism", 1u, "number of sstables to validate at a time"),
+            }},
             validate_operation},
 /* scrub */
     {{"scrub",
@@ -3240,6 +3620,7 @@ for more information on this operation, including what the different modes do.
                     typed_option<std::string>("scrub-mode", "scrub mode to use, one of (abort, skip, segregate, validate)"),
                     typed_option<std::string>("output-dir", ".", "directory to place the scrubbed sstables to"),
                     typed_option<>("unsafe-accept-nonempty-output-dir", "allow the operation to write into a non-empty output directory, acknowledging the risk that this may result in sstable clash"),
+                    typed_option<unsigned>("parallelism", 1u, "number of sstables to scrub at a time, each on its own; with 1, all sstables are scrubbed together"),
             }},
             scrub_operation},
 /* validate-checksums */
@@ -3250,7 +3631,10 @@ Validate both the whole-file and the per-chunk checksums of the data component.
 
 See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#validate-checksums
 for more information on this operation.
-)"},
+)",
+            {
+                    typed_option<unsigned>("parallelism", 1u, "number of sstables to validate at a time"),
+            }},
             validate_checksums_operation},
 /* decompress */
     {{"decompress",
@@ -3275,6 +3659,20 @@ representation has to have the same schema as that of a single sstable
 from the output of the dump-data operation (corresponding to the $SSTABLE
 symbol).
 
+Alternatively, with --input-format=csv, write the rows of a CSV file, for
+bulk loading data. The first line of the file is the header, with the names
+of the columns, which has to include all key columns. Each other line is
+written as a row, with the timestamp provided with --timestamp (the current
+time by default). Values are written as they would be in CQL statements,
+empty values (not quoted) are nulls. Only columns of native types are
+supported.
+The rows don't have to be sorted: they are sorted in memory, in chunks of at
+most --memory-limit MiB, which are written to temporary sstables, then merged
+into the output sstable. With --shards, one output sstable is written per
+shard of a node with that many shards (see also --ignore-msb-bits), with
+consecutive generations starting with --generation. The output can be
+loaded into a cluster with nodetool refresh.
+
 Note that "write" doesn't yet support all the features of the scylladb
 storage engine. The following is not supported:
 * Counters.
@@ -3297,6 +3695,11 @@ for more information on this operation, including the schema of the JSON input.
                     typed_option<std::string>("output-dir", ".", "directory to place the output sstable(s) to"),
                     typed_option<sstables::generation_type::int_t>("generation", "generation of generated sstable"),
                     typed_option<std::string>("validation-level", "clustering_key", "degree of validation on the output, one of (partition_region, token, partition_key, clustering_key)"),
+                    typed_option<std::string>("input-format", "json", "the format of the input, one of (json, csv)"),
+                    typed_option<unsigned>("memory-limit", 256u, "memory to use for sorting csv input, in MiB"),
+                    typed_option<unsigned>("shards", "write one sstable per shard of a node with this many shards (csv input only)"),
+                    typed_option<unsigned>("ignore-msb-bits", 12u, "'murmur3_partitioner_ignore_msb_bits' set by scylla.yaml"),
+                    typed_option<api::timestamp_type>("timestamp", "the timestamp of the written cells (csv input only), defaults to the current time"),
             }},
             write_operation},
 /* script */
@@ -3344,6 +3747,11 @@ When writing queries by hand, there are some things to keep in in mind:
   If the table-name wasn't provided with --table, the table name will be
   my_table.
 
+Restrictions on the partition key and clustering key columns are used to look
+up the data in the sstable index, so queries selecting a few partitions or rows
+don't have to scan the whole data file. Likewise, the values of columns which
+are not selected are not read into memory.
+
 Chose the output format with --output-format. Text is similar to CQLSH text
 output, while json is similar to SELECT JSON output.
 Default output format is text.
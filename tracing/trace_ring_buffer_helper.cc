@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <seastar/core/metrics.hh>
+#include "tracing/trace_ring_buffer_helper.hh"
+#include "utils/class_registrator.hh"
+
+namespace tracing {
+
+static logging::logger tlogger("trace_ring_buffer_helper");
+
+trace_ring_buffer_helper::trace_ring_buffer_helper(tracing& tr)
+        : i_tracing_backend_helper(tr)
+        , _capacity(tr.ring_buffer_records()) {
+    _records.reserve(_capacity);
+
+    namespace sm = seastar::metrics;
+    _metrics.add_group("tracing", {
+        sm::make_counter("ring_buffer_records", _stats.records,
+                        sm::description("Counts the tracing records written to the in-memory ring buffer.")),
+        sm::make_counter("ring_buffer_overwritten_records", _stats.overwritten_records,
+                        sm::description("Counts the tracing records which were overwritten in the in-memory ring buffer by newer records.")),
+    });
+}
+
+future<> trace_ring_buffer_helper::start(cql3::query_processor&, service::migration_manager&) {
+    tlogger.info("Keeping the latest {} tracing records of each shard in memory", _capacity);
+    return make_ready_future<>();
+}
+
+future<> trace_ring_buffer_helper::shutdown() {
+    return make_ready_future<>();
+}
+
+trace_ring_buffer_helper::record& trace_ring_buffer_helper::next_slot() {
+    ++_stats.records;
+    if (_records.size() < _capacity) {
+        _records.emplace_back();
+        _next = _records.size() % _capacity;
+        return _records.back();
+    }
+    ++_stats.overwritten_records;
+    auto& r = _records[_next];
+    _next = (_next + 1) % _capacity;
+    return r;
+}
+
+void trace_ring_buffer_helper::write_records_bulk(records_bulk& bulk) {
+    for (auto& records : bulk) {
+        auto nr = records->size();
+        if (_capacity) {
+            for (auto& e : records->events_recs) {
+                auto& r = next_slot();
+                r.seq = _seq++;
+                r.session_id = records->session_id;
+                r.at = e.event_time_point;
+                r.elapsed = e.elapsed;
+                r.message = std::move(e.message);
+                r.command = records->session_rec.command;
+                r.is_session = false;
+                r.slow_query = false;
+            }
+            // Events are written before the session which they belong to, like
+            // trace_keyspace_helper does.
+            if (records->session_rec.ready()) {
+                const auto& s = records->session_rec;
+                auto& r = next_slot();
+                r.seq = _seq++;
+                r.session_id = records->session_id;
+                r.at = s.started_at;
+                r.elapsed = s.elapsed;
+                r.message.assign(s.request.begin(), s.request.end());
+                r.command = s.command;
+                r.is_session = true;
+                r.slow_query = records->do_log_slow_query;
+            }
+        }
+        records->events_recs.clear();
+        records->data_consumed();
+        _local_tracing.write_complete(nr);
+    }
+}
+
+std::unique_ptr<backend_session_state_base> trace_ring_buffer_helper::allocate_session_state() const {
+    return std::make_unique<backend_session_state_base>();
+}
+
+std::vector<trace_ring_buffer_helper::record> trace_ring_buffer_helper::get_records() const {
+    std::vector<record> ret;
+    ret.reserve(_records.size());
+    for_each_record([&] (const record& r) {
+        ret.push_back(r);
+    });
+    return ret;
+}
+
+static std::vector<trace_ring_buffer_helper::record> get_local_records(tracing& local_tracing) {
+    if (!local_tracing.started()) {
+        return {};
+    }
+    auto helper = dynamic_cast<const trace_ring_buffer_helper*>(&local_tracing.backend_helper());
+    return helper ? helper->get_records() : std::vector<trace_ring_buffer_helper::record>();
+}
+
+future<std::vector<std::vector<trace_ring_buffer_helper::record>>> trace_ring_buffer_helper::get_records_of_all_shards() {
+    auto& tr = tracing::tracing_instance();
+    if (!tr.local_is_initialized()) {
+        return make_ready_future<std::vector<std::vector<record>>>();
+    }
+    return tr.map(&get_local_records);
+}
+
+future<std::vector<trace_ring_buffer_helper::record>> trace_ring_buffer_helper::get_records_of_shard(shard_id shard) {
+    auto& tr = tracing::tracing_instance();
+    if (!tr.local_is_initialized()) {
+        return make_ready_future<std::vector<record>>();
+    }
+    return tr.invoke_on(shard, &get_local_records);
+}
+
+using registry_ring_buffer = class_registrator<i_tracing_backend_helper, trace_ring_buffer_helper, tracing&>;
+static registry_ring_buffer registrator_ring_buffer(sstring(trace_ring_buffer_helper::CLASS_NAME));
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <seastar/core/metrics_registration.hh>
+#include "tracing/tracing.hh"
+
+namespace tracing {
+
+/// \brief A tracing backend which keeps the latest records of each shard in memory.
+///
+/// Writing the records into system_traces costs a few mutations per traced
+/// request, which makes probabilistic tracing expensive to keep enabled. This
+/// backend instead appends the records to a per-shard ring buffer of bounded
+/// size, overwriting the oldest records once it is full. No formatting or
+/// serialization happens on the write path: the messages of events are moved
+/// into the buffer as they were traced.
+///
+/// The records can be read back through the system.tracing_ring_buffer virtual
+/// table and the /storage_service/tracing_ring_buffer REST endpoint.
+class trace_ring_buffer_helper final : public i_tracing_backend_helper {
+public:
+    static constexpr std::string_view CLASS_NAME = "trace_ring_buffer_helper";
+
+    struct record {
+        // Numbers the records of a shard in the order in which they were written.
+        uint64_t seq;
+        utils::UUID session_id;
+        // The start of the session for a session record.
+        wall_clock::time_point at;
+        // The duration of the session for a session record, the time since the start
+        // of the session for an event record.
+        elapsed_clock::duration elapsed;
+        // The request of a session record, the message of an event record.
+        std::string message;
+        trace_type command = trace_type::NONE;
+        bool is_session = false;
+        bool slow_query = false;
+    };
+
+    struct stats {
+        uint64_t records = 0;
+        uint64_t overwritten_records = 0;
+    };
+private:
+    size_t _capacity;
+    std::vector<record> _records;
+    // Index of the slot the next record is written to.
+    size_t _next = 0;
+    uint64_t _seq = 0;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    // Returns the slot for a new record, overwriting the oldest one if the buffer is full.
+    record& next_slot();
+public:
+    explicit trace_ring_buffer_helper(tracing& tr);
+
+    virtual future<> start(cql3::query_processor& qp, service::migration_manager& mm) override;
+    virtual future<> shutdown() override;
+    virtual void write_records_bulk(records_bulk& bulk) override;
+    virtual std::unique_ptr<backend_session_state_base> allocate_session_state() const override;
+
+    size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+
+    // Calls func on each record in the buffer, from the oldest to the newest one.
+    template <typename Func>
+    void for_each_record(Func&& func) const {
+        for (size_t i = _next; i < _records.size(); ++i) {
+            func(_records[i]);
+        }
+        for (size_t i = 0; i < _next; ++i) {
+            func(_records[i]);
+        }
+    }
+
+    std::vector<record> get_records() const;
+
+    // Returns the records of each shard, indexed by shard, or nothing if tracing
+    // doesn't use this backend.
+    static future<std::vector<std::vector<record>>> get_records_of_all_shards();
+
+    // Returns the records of the given shard, or nothing if tracing doesn't
+    // use this backend.
+    static future<std::vector<record>> get_records_of_shard(shard_id shard);
+};
+
+}
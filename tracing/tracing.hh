@@ -306,6 +306,8 @@ class tracing : public seastar::async_sharded_service<tracing> {
 
     static const std::chrono::microseconds default_slow_query_duraion_threshold;
     static const std::chrono::seconds default_slow_query_record_ttl;
+    // default number of records kept per shard by the in-memory tracing backend
+    static constexpr size_t default_ring_buffer_records = 10000;
 
     struct stats {
         uint64_t dropped_sessions = 0;
@@ -383,6 +385,7 @@ class tracing : public seastar::async_sharded_service<tracing> {
     std::unique_ptr<i_tracing_backend_helper> _tracing_backend_helper_ptr;
     sstring _thread_name;
     sstring _tracing_backend_helper_class_name;
+    size_t _ring_buffer_records;
     seastar::metrics::metric_groups _metrics;
     double _trace_probability = 0.0; // keep this one for querying purposes
     uint64_t _normalized_trace_probability = 0;
@@ -418,7 +421,12 @@ class tracing : public seastar::async_sharded_service<tracing> {
         return !_down;
     }
 
-    tracing(sstring tracing_backend_helper_class_name);
+    tracing(sstring tracing_backend_helper_class_name, size_t ring_buffer_records = default_ring_buffer_records);
+
+    // The number of records the in-memory backend (trace_ring_buffer_helper) keeps.
+    size_t ring_buffer_records() const {
+        return _ring_buffer_records;
+    }
 
     // Initialize a tracing backend (e.g. tracing_keyspace or logstash)
     future<> start(cql3::query_processor& qp, service::migration_manager& mm);
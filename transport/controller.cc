@@ -219,6 +219,9 @@ future<> controller::do_start_server() {
         smp_service_group_config cql_server_smp_service_group_config;
         cql_server_smp_service_group_config.max_nonlocal_requests = 5000;
         auto bounce_request_smp_service_group = create_smp_service_group(cql_server_smp_service_group_config).get();
+        if (!_shard_loads && !_used_by_maintenance_socket) {
+            _shard_loads = std::make_unique<cql_shard_loads>();
+        }
         auto get_cql_server_config = sharded_parameter([&] {
             std::optional<uint16_t> shard_aware_transport_port;
             if (cfg.native_shard_aware_transport_port.is_set()) {
@@ -240,6 +243,9 @@ future<> controller::do_start_server() {
               .allow_shard_aware_drivers = cfg.enable_shard_aware_drivers(),
               .bounce_request_smp_service_group = bounce_request_smp_service_group,
               .max_concurrent_requests = cfg.max_concurrent_requests_per_shard,
+              .requests_offload_threshold = cfg.cql_requests_offload_threshold,
+              .requests_prioritized_shedding_threshold = cfg.cql_requests_prioritized_shedding_threshold,
+              .shard_loads = _shard_loads.get(),
               .cql_duplicate_bind_variable_names_refer_to_same_variable = cfg.cql_duplicate_bind_variable_names_refer_to_same_variable,
               .uninitialized_connections_semaphore_cpu_concurrency = cfg.uninitialized_connections_semaphore_cpu_concurrency,
               .request_timeout_on_shutdown_in_seconds = cfg.request_timeout_on_shutdown_in_seconds
@@ -33,10 +33,13 @@ struct client_data;
 namespace cql_transport {
 
 class cql_server;
+class cql_shard_loads;
 struct connection_service_level_params;
 class controller : public protocol_server {
     std::vector<socket_address> _listen_addresses;
     std::unique_ptr<sharded<cql_server>> _server;
+    // Outlives the servers, which share it between their shards.
+    std::unique_ptr<cql_shard_loads> _shard_loads;
     semaphore _ops_sem; /* protects start/stop operations on _server */
     named_gate _bg_stops;
     bool _stopped = false;
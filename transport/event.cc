@@ -72,4 +72,13 @@ event::schema_change::schema_change(change_type change, target_type target, sstr
         break;
     }
 }
+
+event::tablets_change::tablets_change(sstring keyspace, sstring table, int64_t version, std::vector<bytes> tablets)
+    : event(event_type::TABLETS_CHANGE)
+    , keyspace(std::move(keyspace))
+    , table(std::move(table))
+    , version(version)
+    , tablets(std::move(tablets))
+{ }
+
 }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "bytes.hh"
 #include "gms/inet_address.hh"
 
 #include <seastar/core/sstring.hh>
@@ -19,7 +20,7 @@ namespace cql_transport {
 
 class event {
 public:
-    enum class event_type { TOPOLOGY_CHANGE, STATUS_CHANGE, SCHEMA_CHANGE };
+    enum class event_type { TOPOLOGY_CHANGE, STATUS_CHANGE, SCHEMA_CHANGE, TABLETS_CHANGE };
 
     const event_type type;
 private:
@@ -28,6 +29,7 @@ class event {
     class topology_change;
     class status_change;
     class schema_change;
+    class tablets_change;
 };
 
 class event::topology_change : public event {
@@ -79,4 +81,20 @@ class event::schema_change : public event {
         : schema_change(change, target, keyspace, std::vector<sstring>{std::move(arguments)...}) {}
 };
 
+class event::tablets_change : public event {
+public:
+    const sstring keyspace;
+    const sstring table;
+
+    // Routing version of the table: the version of the token metadata in
+    // which its tablets last changed. Grows with every change.
+    const int64_t version;
+
+    // The tablets whose replicas changed, each serialized like the
+    // tablets-routing-v1 custom payload.
+    const std::vector<bytes> tablets;
+
+    tablets_change(sstring keyspace, sstring table, int64_t version, std::vector<bytes> tablets);
+};
+
 }
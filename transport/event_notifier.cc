@@ -10,6 +10,8 @@
 #include <seastar/core/gate.hh>
 #include "transport/response.hh"
 #include "gms/gossiper.hh"
+#include "locator/token_metadata.hh"
+#include "locator/tablets.hh"
 
 namespace cql_transport {
 
@@ -27,6 +29,9 @@ void cql_server::event_notifier::register_event(event::event_type et, cql_server
     case event::event_type::SCHEMA_CHANGE:
         _schema_change_listeners.emplace(conn);
         break;
+    case event::event_type::TABLETS_CHANGE:
+        _tablets_change_listeners.emplace(conn);
+        break;
     }
 }
 
@@ -35,6 +40,7 @@ void cql_server::event_notifier::unregister_connection(cql_server::connection* c
     _topology_change_listeners.erase(conn);
     _status_change_listeners.erase(conn);
     _schema_change_listeners.erase(conn);
+    _tablets_change_listeners.erase(conn);
 }
 
 void cql_server::event_notifier::on_create_keyspace(const sstring& ks_name)
@@ -292,4 +298,52 @@ void cql_server::event_notifier::on_down(const gms::inet_address& endpoint, loca
     }
 }
 
+// Returns the tablets of new_tmap whose replicas differ from old_tmap, all of
+// them if the tablet count changed, serialized like tablets-routing-v1.
+static std::vector<bytes> changed_tablets(const locator::tablet_map* old_tmap, const locator::tablet_map& new_tmap) {
+    std::vector<bytes> tablets;
+    const bool resized = !old_tmap || old_tmap->tablet_count() != new_tmap.tablet_count();
+    for (auto tid : new_tmap.tablet_ids()) {
+        auto& info = new_tmap.get_tablet_info(tid);
+        if (!resized && old_tmap->get_tablet_info(tid).replicas == info.replicas) {
+            continue;
+        }
+        auto first_token = tid == new_tmap.first_tablet() ? dht::minimum_token() : new_tmap.get_last_token(locator::tablet_id(size_t(tid) - 1));
+        tablets.push_back(messages::result_message::serialize_tablet_info(info.replicas, {first_token, new_tmap.get_last_token(tid)}));
+    }
+    return tablets;
+}
+
+void cql_server::event_notifier::on_token_metadata_changed(const locator::token_metadata& old_tm, const locator::token_metadata& new_tm)
+{
+    if (_tablets_change_listeners.empty()) {
+        return;
+    }
+    auto db = _server._query_processor.local().db();
+    for (auto&& [id, new_tmap_ptr] : new_tm.tablets().all_tables_ungrouped()) {
+        const locator::tablet_map* old_tmap = old_tm.tablets().has_tablet_map(id) ? &old_tm.tablets().get_tablet_map(id) : nullptr;
+        // Tablet maps of tables which didn't change are shared between versions.
+        if (old_tmap == new_tmap_ptr.get() || (old_tmap && *old_tmap == *new_tmap_ptr)) {
+            continue;
+        }
+        auto tablets = changed_tablets(old_tmap, *new_tmap_ptr);
+        if (tablets.empty()) {
+            // Only transitions changed, which don't affect routing.
+            continue;
+        }
+        auto table = db.try_find_table(id);
+        if (!table) {
+            continue;
+        }
+        auto s = table->schema();
+        elogger.debug("Sending tablets change of {}.{} with {} tablets, version {}", s->ks_name(), s->cf_name(), tablets.size(), new_tm.get_version());
+        auto change = event::tablets_change{s->ks_name(), s->cf_name(), new_tm.get_version(), std::move(tablets)};
+        for (auto&& conn : _tablets_change_listeners) {
+            if (!conn->_pending_requests_gate.is_closed()) {
+                conn->write_response(conn->make_tablets_change_event(change));
+            }
+        }
+    }
+}
+
 }
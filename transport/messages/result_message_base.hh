@@ -46,14 +46,19 @@ class result_message {
         _custom_payload.value()[key] = value;
     }
 
+    // Serializes routing information of a tablet in the format of the tablets-routing-v1 payload.
+    static bytes serialize_tablet_info(const locator::tablet_replica_set& tablet_replicas, std::pair<dht::token, dht::token> token_range) {
+        auto replicas_values = make_list_value(replica::get_replica_set_type(), replica::replicas_to_data_value(tablet_replicas));
+        auto v1 = data_value(dht::token::to_int64(token_range.first));
+        auto v2 = data_value(dht::token::to_int64(token_range.second));
+
+        auto tablets_routing = make_tuple_value(replica::get_tablet_info_type(), {v1, v2, replicas_values});
+        return tablets_routing.serialize_nonnull();
+    }
+
     void add_tablet_info(locator::tablet_replica_set tablet_replicas, std::pair<dht::token, dht::token> token_range) {
         if (!tablet_replicas.empty()) {
-            auto replicas_values = make_list_value(replica::get_replica_set_type(), replica::replicas_to_data_value(tablet_replicas));
-            auto v1 = data_value(dht::token::to_int64(token_range.first));
-            auto v2 = data_value(dht::token::to_int64(token_range.second));
-
-            auto tablets_routing = make_tuple_value(replica::get_tablet_info_type(), {v1, v2, replicas_values});
-            this->add_custom_payload("tablets-routing-v1", tablets_routing.serialize_nonnull());
+            this->add_custom_payload("tablets-routing-v1", serialize_tablet_info(tablet_replicas, token_range));
         }
     }
 
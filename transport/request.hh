@@ -220,7 +220,7 @@ class request_reader {
         options_flag::NAMES_FOR_VALUES
     >;
 public:
-    std::unique_ptr<cql3::query_options> read_options(uint8_t version, const cql3::cql_config& cql_config) {
+    cql3::query_options read_options(uint8_t version, const cql3::cql_config& cql_config) {
         auto consistency = read_consistency();
         auto flags = enum_set<options_flag_enum>::from_mask(read_byte());
         std::vector<cql3::raw_value_view> values;
@@ -239,7 +239,6 @@ class request_reader {
         flags.remove<options_flag::VALUES>();
         flags.remove<options_flag::SKIP_METADATA>();
 
-        std::unique_ptr<cql3::query_options> options;
         if (flags) {
             lw_shared_ptr<service::pager::paging_state> paging_state;
             int32_t page_size = flags.contains<options_flag::PAGE_SIZE>() ? read_int() : -1;
@@ -265,16 +264,13 @@ class request_reader {
             if (!names.empty()) {
                 onames = std::move(names);
             }
-            options = std::make_unique<cql3::query_options>(cql_config, consistency, std::move(onames),
+            return cql3::query_options(cql_config, consistency, std::move(onames),
                 cql3::raw_value_view_vector_with_unset(std::move(values), std::move(unset)), skip_metadata,
                 cql3::query_options::specific_options{page_size, std::move(paging_state), serial_consistency, ts});
-        } else {
-            options = std::make_unique<cql3::query_options>(cql_config, consistency, std::nullopt,
-                cql3::raw_value_view_vector_with_unset(std::move(values), std::move(unset)), skip_metadata,
-                cql3::query_options::specific_options::DEFAULT);
         }
-
-        return options;
+        return cql3::query_options(cql_config, consistency, std::nullopt,
+            cql3::raw_value_view_vector_with_unset(std::move(values), std::move(unset)), skip_metadata,
+            cql3::query_options::specific_options::DEFAULT);
     }
 };
 
@@ -38,7 +38,21 @@ class response {
     cql_binary_opcode _opcode;
     uint8_t           _flags = 0; // a bitwise OR mask of zero or more cql_frame_flags values
     bytes_ostream _body;
+
+    // Large values referenced in place instead of being copied into _body,
+    // see write_value_in_place(). Each one logically precedes the byte of _body at offset.
+    struct external_value {
+        size_t offset;
+        managed_bytes_view value;
+    };
+    std::vector<external_value> _external_values;
+    size_t _external_size = 0;
+    // Owns the memory of _external_values.
+    ::shared_ptr<messages::result_message> _result;
 public:
+    // Values smaller than that are cheaper to copy than to reference.
+    static constexpr size_t min_in_place_value_size = 16 * 1024;
+
     template<typename T>
     class placeholder;
 
@@ -76,23 +90,67 @@ class response {
     void write_string_bytes_map(const std::unordered_map<sstring, bytes>& map);
     void write_value(bytes_opt value);
     void write_value(std::optional<managed_bytes_view> value);
+    // Like write_value(), but large values are sent straight from the memory of the result
+    // set the response was made for instead of being copied. The value must stay valid
+    // for as long as that result is alive, see set_result().
+    void write_value_in_place(std::optional<managed_bytes_view> value);
+    // Makes the response keep the result it references values of alive.
+    void set_result(::shared_ptr<messages::result_message> result) {
+        _result = std::move(result);
+    }
     void write(const cql3::metadata& m, const cql_metadata_id_wrapper& request_metadata_id, bool no_metadata = false);
     void write(const cql3::prepared_metadata& m, uint8_t version);
 
     // Make a non-owning scattered_message of the response. Remains valid as long
-    // as the response object is alive.
-    scattered_message<char> make_message(uint8_t version, cql_compression compression);
+    // as the response object is alive. If dict is set, the body is compressed
+    // with it, see the SCYLLA_COMPRESSION_DICTIONARY protocol extension.
+    scattered_message<char> make_message(uint8_t version, cql_compression compression, const utils::shared_dict* dict = nullptr);
 
     cql_binary_opcode opcode() const {
         return _opcode;
     }
     size_t size() const {
-        return _body.size();
+        return _body.size() + _external_size;
     }
 private:
-    void compress(cql_compression compression);
-    void compress_lz4();
+    // Calls func for each fragment of the body, with external values spliced in.
+    template <typename Func>
+    void for_each_body_fragment(Func&& func) const {
+        auto ext = _external_values.begin();
+        auto emit_external = [&] {
+            auto v = ext->value;
+            while (!v.empty()) {
+                func(v.current_fragment());
+                v.remove_current();
+            }
+            ++ext;
+        };
+        size_t pos = 0;
+        for (bytes_view frag : _body.fragments()) {
+            while (ext != _external_values.end() && ext->offset < pos + frag.size()) {
+                auto n = ext->offset - pos;
+                if (n) {
+                    func(frag.substr(0, n));
+                    frag.remove_prefix(n);
+                    pos += n;
+                }
+                emit_external();
+            }
+            if (!frag.empty()) {
+                func(frag);
+                pos += frag.size();
+            }
+        }
+        while (ext != _external_values.end()) {
+            emit_external();
+        }
+    }
+    // Copies external values into _body, for transformations which need contiguous input.
+    void materialize_external_values();
+    void compress(cql_compression compression, const utils::shared_dict* dict);
+    void compress_lz4(const utils::shared_dict* dict);
     void compress_snappy();
+    void compress_zstd(const utils::shared_dict* dict);
 
     template <typename CqlFrameHeaderType>
     sstring make_frame_one(uint8_t version, size_t length) {
@@ -10,6 +10,7 @@
 
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/semaphore.hh>
 #include "types/collection.hh"
@@ -49,9 +50,11 @@
 #include "exceptions/exceptions.hh"
 #include "client_data.hh"
 #include "cql3/query_processor.hh"
+#include "cql3/untyped_result_set.hh"
 #include "auth/authenticator.hh"
 
 #include <cassert>
+#include <random>
 #include <string>
 
 #include <snappy-c.h>
@@ -192,6 +195,8 @@ parse_event_type(const sstring& value)
         return event::event_type::STATUS_CHANGE;
     } else if (value == "SCHEMA_CHANGE") {
         return event::event_type::SCHEMA_CHANGE;
+    } else if (value == "TABLETS_CHANGE") {
+        return event::event_type::TABLETS_CHANGE;
     } else {
         return exceptions::protocol_exception(format("Invalid value '{}' for Event.Type", value));
     }
@@ -242,6 +247,12 @@ void cql_sg_stats::register_metrics()
         );
     }
 
+    transport_metrics.emplace_back(
+            sm::make_gauge("cql_requests_queueing_delay", [this] { return _queueing_delay.count(); },
+                           sm::description("Moving average of the time, in microseconds, the CQL requests waited for memory before being processed."),
+                           {{"scheduling_group_name", cur_sg_name}})
+    );
+
     new_metrics.add_group("transport", std::move(transport_metrics));
     _metrics = std::exchange(new_metrics, {});
 }
@@ -293,9 +304,16 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
                         sm::description(
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _config.max_request_size))),
+        sm::make_counter("requests_offloaded", _stats.requests_offloaded,
+                        sm::description("Counts the EXECUTE requests which were processed on a less loaded shard, because this one was overloaded "
+                                            "(threshold configured via cql_requests_offload_threshold).")),
+
         sm::make_counter("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component."))(basic_level),
+        sm::make_counter("requests_shed_by_priority", _stats.requests_shed_by_priority,
+                        sm::description("Counts the requests which were shed because the shard processed too many requests for their cost and service level "
+                                            "(threshold configured via cql_requests_prioritized_shedding_threshold).")),
         sm::make_counter("connections_shed", _shed_connections,
             sm::description("Holds an incrementing counter with the CQL connections that were shed due to concurrency semaphore timeout (threshold configured via uninitialized_connections_semaphore_cpu_concurrency). "
                                             "This typically can happen during connection storm. ")),
@@ -330,6 +348,64 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
 
 cql_server::~cql_server() = default;
 
+void cql_server::update_requests_serving(int32_t delta) noexcept {
+    _stats.requests_serving += delta;
+    if (_config.shard_loads) {
+        _config.shard_loads->set(this_shard_id(), _stats.requests_serving);
+    }
+}
+
+std::optional<shard_id> cql_server::pick_offload_shard() const {
+    auto threshold = _config.requests_offload_threshold();
+    if (!_config.shard_loads || !threshold || smp::count == 1 || _stats.requests_serving < threshold) {
+        return std::nullopt;
+    }
+    // The less loaded one of two random other shards, which spreads the load
+    // almost as well as the least loaded shard would, without looking at all of them.
+    static thread_local std::default_random_engine engine{std::random_device{}()};
+    std::uniform_int_distribution<shard_id> dist(0, smp::count - 2);
+    auto pick = [&] {
+        auto shard = dist(engine);
+        return shard >= this_shard_id() ? shard + 1 : shard;
+    };
+    auto shard = pick();
+    if (auto other = pick(); _config.shard_loads->get(other) < _config.shard_loads->get(shard)) {
+        shard = other;
+    }
+    // Don't move the work unless it gets processed much sooner.
+    if (_config.shard_loads->get(shard) * 2 > _stats.requests_serving) {
+        return std::nullopt;
+    }
+    return shard;
+}
+
+future<lw_shared_ptr<const utils::shared_dict>> cql_server::get_compression_dict(sstring name, sstring sha256) {
+    std::transform(sha256.begin(), sha256.end(), sha256.begin(), ::tolower);
+    auto matches = [&sha256] (const utils::shared_dict& dict) {
+        auto& digest = dict.id.content_sha256;
+        return to_hex(bytes_view(reinterpret_cast<const int8_t*>(digest.data()), digest.size())) == sha256;
+    };
+    if (auto it = _compression_dicts.find(name); it != _compression_dicts.end() && matches(*it->second)) {
+        co_return it->second;
+    }
+    // The dictionary is used for the first time, or it was retrained since.
+    static const sstring query = "SELECT timestamp, origin, data FROM system.dicts WHERE name = ?";
+    auto rs = co_await _query_processor.local().execute_internal(query, {data_value(name)}, cql3::query_processor::cache_internal::yes);
+    if (rs->empty()) {
+        throw exceptions::protocol_exception(format("Unknown compression dictionary: {}", name));
+    }
+    auto& row = rs->one();
+    auto data = row.get_as<bytes>("data");
+    auto dict = make_lw_shared<const utils::shared_dict>(std::as_bytes(std::span(data)),
+            row.get_as<db_clock::time_point>("timestamp").time_since_epoch().count(),
+            row.get_as<utils::UUID>("origin"));
+    if (!matches(*dict)) {
+        throw exceptions::protocol_exception(format("Compression dictionary {} doesn't have the requested digest, it was probably retrained", name));
+    }
+    _compression_dicts.insert_or_assign(std::move(name), dict);
+    co_return dict;
+}
+
 shared_ptr<generic_server::connection>
 cql_server::make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr, named_semaphore& sem, semaphore_units<named_semaphore_exception_factory> initial_sem_units) {
     return make_shared<connection>(*this, server_addr, std::move(fd), std::move(addr), sem, std::move(initial_sem_units));
@@ -499,7 +575,7 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
         auto stop_trace = defer([&] {
             tracing::stop_foreground(trace_state);
         });
-        --_server._stats.requests_serving;
+        _server.update_requests_serving(-1);
 
         return seastar::futurize_invoke([&] () {
             if (f.failed()) {
@@ -679,6 +755,10 @@ client_data cql_server::connection::make_client_data() const {
         cd.connection_stage = client_connection_stage::authenticating;
     }
     cd.scheduling_group_name = _current_scheduling_group.name();
+    cd.frames_read = _frames_read;
+    cd.frames_written = _frames_written;
+    cd.socket_reads = _io_stats.reads;
+    cd.socket_writes = _io_stats.writes;
     return cd;
 }
 
@@ -718,6 +798,7 @@ future<> cql_server::connection::process_request() {
             // eof
             return make_ready_future<>();
         }
+        ++_frames_read;
 
         auto& f = *maybe_frame;
 
@@ -769,6 +850,7 @@ future<> cql_server::connection::process_request() {
         }
 
         const auto shedding_timeout = std::chrono::milliseconds(50);
+        const auto queued_at = std::chrono::steady_clock::now();
         auto fut = allow_shedding
                 ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
                     try {
@@ -791,17 +873,19 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, queued_at] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
+          _server.get_cql_sg_stats().update_queueing_delay(
+                  std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued_at));
           semaphore_units<> mem_permit = mem_permit_fut.get();
           return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
 
             ++_server._stats.requests_served;
-            ++_server._stats.requests_serving;
+            _server.update_requests_serving(1);
 
             _pending_requests_gate.enter();
             auto leave = defer([this] {
@@ -866,6 +950,24 @@ static utils::reusable_buffer_guard output_buffer_guard() {
     return buf;
 }
 
+// zstd contexts, shared by the connections of the shard.
+static ZSTD_CCtx* zstd_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    if (!cctx) {
+        throw std::bad_alloc();
+    }
+    return cctx.get();
+}
+static ZSTD_DCtx* zstd_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (!dctx) {
+        throw std::bad_alloc();
+    }
+    return dctx.get();
+}
+
+static constexpr int zstd_compression_level = 1;
+
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
 {
     if (flags & cql_frame_flags::compression) {
@@ -873,7 +975,7 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
             if (length < 4) {
                 return make_exception_future<fragmented_temporary_buffer>(std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length)));
             }
-            return _buffer_reader.read_exactly(_read_buf, length).then([] (fragmented_temporary_buffer buf) {
+            return _buffer_reader.read_exactly(_read_buf, length).then([dict = _compression_dict] (fragmented_temporary_buffer buf) {
                 auto input_buffer = input_buffer_guard();
                 auto output_buffer = output_buffer_guard();
                 auto v = fragmented_temporary_buffer::view(buf);
@@ -882,8 +984,11 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                     return make_exception_future<fragmented_temporary_buffer>(std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len)));
                 }
                 auto in = input_buffer.get_linearized_view(v);
-                return utils::result_into_future(output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
-                    auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
+                return utils::result_into_future(output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in, &dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+                    auto ret = dict
+                            ? LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size(),
+                                    reinterpret_cast<const char*>(dict->lz4_ddict.data()), dict->lz4_ddict.size())
+                            : LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
                     if (ret < 0) {
                         return bo::failure(std::runtime_error("CQL frame LZ4 uncompression failure"));
                     }
@@ -913,6 +1018,32 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                     return bo::success(output_len);
                 }));
             });
+        } else if (_compression == cql_compression::zstd) {
+            return _buffer_reader.read_exactly(_read_buf, length).then([this, dict = _compression_dict] (fragmented_temporary_buffer buf) {
+                auto input_buffer = input_buffer_guard();
+                auto output_buffer = output_buffer_guard();
+                auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
+                auto uncomp_len = ZSTD_getFrameContentSize(in.data(), in.size());
+                if (uncomp_len == ZSTD_CONTENTSIZE_UNKNOWN || uncomp_len == ZSTD_CONTENTSIZE_ERROR) {
+                    return make_exception_future<fragmented_temporary_buffer>(std::runtime_error("CQL frame zstd uncompressed size is unknown"));
+                }
+                if (uncomp_len > _server._config.max_request_size) {
+                    return make_exception_future<fragmented_temporary_buffer>(std::runtime_error(fmt::format(
+                            "CQL frame zstd uncompressed size {} exceeds the request size limit {}", uncomp_len, _server._config.max_request_size)));
+                }
+                return utils::result_into_future(output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in, &dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+                    auto ret = dict
+                            ? ZSTD_decompress_usingDDict(zstd_dctx(), out.data(), out.size(), in.data(), in.size(), dict->zstd_ddict.get())
+                            : ZSTD_decompressDCtx(zstd_dctx(), out.data(), out.size(), in.data(), in.size());
+                    if (ZSTD_isError(ret)) {
+                        return bo::failure(std::runtime_error(fmt::format("CQL frame zstd uncompression failure: {}", ZSTD_getErrorName(ret))));
+                    }
+                    if (ret != out.size()) {
+                        return bo::failure(std::runtime_error("Malformed CQL frame - provided uncompressed size different than real uncompressed size"));
+                    }
+                    return bo::success(ret);
+                }));
+            });
         } else {
             return make_exception_future<fragmented_temporary_buffer>(exceptions::protocol_exception("Unknown compression algorithm"));
         }
@@ -931,10 +1062,24 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
              _compression = cql_compression::lz4;
          } else if (compression == "snappy") {
              _compression = cql_compression::snappy;
+         } else if (compression == "zstd") {
+             _compression = cql_compression::zstd;
          } else {
              co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression))));
          }
     }
+    if (auto dict_opt = options.find(protocol_extension_name(cql_protocol_extension::COMPRESSION_DICTIONARY)); dict_opt != options.end()) {
+        if (_compression != cql_compression::lz4 && _compression != cql_compression::zstd) {
+            co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception(
+                    "Compression dictionaries require the lz4 or zstd compression")));
+        }
+        auto digest_opt = options.find("SCYLLA_COMPRESSION_DICTIONARY_SHA256");
+        if (digest_opt == options.end()) {
+            co_return coroutine::exception(std::make_exception_ptr(exceptions::protocol_exception(
+                    "SCYLLA_COMPRESSION_DICTIONARY_SHA256 is required with SCYLLA_COMPRESSION_DICTIONARY")));
+        }
+        _requested_compression_dict.emplace(dict_opt->second, digest_opt->second);
+    }
 
     if (auto driver_ver_opt = options.find("DRIVER_VERSION"); driver_ver_opt != options.end()) {
         _client_state.set_driver_version(driver_ver_opt->second);
@@ -968,11 +1113,13 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
             client_state.set_login(std::move(*opt_user));
             co_await client_state.check_user_can_login();
             co_await client_state.maybe_update_per_service_level_params();
+            co_await load_requested_compression_dict();
             res = make_ready(stream, trace_state);
         } else {
             res = make_autheticate(stream, a.qualified_java_name(), trace_state);
         }
     } else {
+        co_await load_requested_compression_dict();
         _ready = true;
         on_connection_ready();
         res = make_ready(stream, trace_state);
@@ -981,6 +1128,14 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
     co_return res;
 }
 
+// Reading system.dicts is left until the client is authenticated, so that
+// unauthenticated clients can't make the server run queries.
+future<> cql_server::connection::load_requested_compression_dict() {
+    if (auto requested = std::exchange(_requested_compression_dict, std::nullopt)) {
+        _compression_dict = co_await _server.get_compression_dict(std::move(requested->first), std::move(requested->second));
+    }
+}
+
 void cql_server::connection::update_scheduling_group() {
     switch_tenant([this] (noncopyable_function<future<> ()> process_loop) -> future<> {
         auto shg = co_await _server._sl_controller.get_user_scheduling_group(_client_state.user());
@@ -1005,6 +1160,9 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_au
                 f = f.then([&client_state] {
                     return client_state.maybe_update_per_service_level_params();
                 });
+                f = f.then([this] {
+                    return load_requested_compression_dict();
+                });
                 return f.then([this, stream, challenge = std::move(challenge), trace_state]() mutable {
                     _authenticating = false;
                     _ready = true;
@@ -1023,7 +1181,7 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_op
 }
 
 std::unique_ptr<cql_server::response>
-make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
+make_result(int16_t stream, ::shared_ptr<messages::result_message> msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata = false);
 
 template <typename Process>
@@ -1041,17 +1199,28 @@ template <typename Process>
                                    cql3::dialect>
 future<cql_server::process_fn_return_type>
 cql_server::connection::process_on_shard(shard_id shard, uint16_t stream, fragmented_temporary_buffer::istream is, service::client_state& cs,
-                tracing::trace_state_ptr trace_state, cql3::dialect dialect, cql3::computed_function_values&& cached_vals, Process process_fn) {
+                tracing::trace_state_ptr trace_state, cql3::dialect dialect, cql3::computed_function_values&& cached_vals, Process process_fn,
+                bool offloaded) {
     auto sg = _server._config.bounce_request_smp_service_group;
     auto gcs = cs.move_to_other_shard();
     auto gt = tracing::global_trace_state_ptr(std::move(trace_state));
-    co_return co_await _server.container().invoke_on(shard, sg, [&, stream, dialect] (cql_server& server) -> future<process_fn_return_type> {
+    co_return co_await _server.container().invoke_on(shard, sg, [&, stream, dialect, offloaded] (cql_server& server) -> future<process_fn_return_type> {
         bytes_ostream linearization_buffer;
         request_reader in(is, linearization_buffer);
         auto client_state = gcs.get();
         auto trace_state = gt.get();
+        // Offloaded requests add to the load of the shard which processes them,
+        // bounced ones were already processed on the shard of the connection.
+        if (offloaded) {
+            server.update_requests_serving(1);
+        }
+        auto update_load = defer([&server, offloaded] () noexcept {
+            if (offloaded) {
+                server.update_requests_serving(-1);
+            }
+        });
         co_return co_await process_fn(client_state, server._query_processor, in, stream, _version,
-                /* FIXME */empty_service_permit(), std::move(trace_state), false, cached_vals, dialect);
+                /* FIXME */empty_service_permit(), std::move(trace_state), offloaded, cached_vals, dialect);
     });
 }
 
@@ -1074,13 +1243,14 @@ template <typename Process>
                                    cql3::dialect>
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit,
-        tracing::trace_state_ptr trace_state, Process process_fn) {
+        tracing::trace_state_ptr trace_state, Process process_fn, std::optional<shard_id> offload_shard) {
     fragmented_temporary_buffer::istream is = in.get_stream();
 
     auto dialect = get_dialect();
 
-    auto f = co_await coroutine::as_future(process_fn(client_state, _server._query_processor, in, stream,
-            _version, permit, trace_state, true, {}, dialect));
+    auto f = co_await coroutine::as_future(offload_shard
+            ? process_on_shard(*offload_shard, stream, is, client_state, trace_state, dialect, {}, process_fn, true)
+            : process_fn(client_state, _server._query_processor, in, stream, _version, permit, trace_state, true, {}, dialect));
     if (f.failed()) {
         co_return coroutine::exception(f.get_exception());
     }
@@ -1102,7 +1272,7 @@ process_query_internal(service::client_state& client_state, distributed<cql3::qu
     auto query = in.read_long_string_view();
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
     auto& query_state = q_state->query_state;
-    q_state->options = in.read_options(version, qp.local().get_cql_config());
+    q_state->options.emplace(in.read_options(version, qp.local().get_cql_config()));
     auto& options = *q_state->options;
     if (!cached_pk_fn_calls.empty()) {
         options.set_cached_pk_function_calls(std::move(cached_pk_fn_calls));
@@ -1126,13 +1296,14 @@ process_query_internal(service::client_state& client_state, distributed<cql3::qu
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
 
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, cql_metadata_id_wrapper{}, skip_metadata)));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, q_state->query_state.get_trace_state(), version, cql_metadata_id_wrapper{}, skip_metadata)));
         }
     });
 }
 
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process_query(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
+    maybe_shed_by_priority(query_cost(in, client_state));
     return process(stream, in, client_state, std::move(permit), std::move(trace_state), process_query_internal);
 }
 
@@ -1156,7 +1327,7 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
             cql_metadata_id_wrapper metadata_id = is_metadata_id_supported(client_state)
                 ? cql_metadata_id_wrapper(msg->get_metadata_id())
                 : cql_metadata_id_wrapper();
-            return make_result(stream, *msg, trace_state, _version, std::move(metadata_id));
+            return make_result(stream, msg, trace_state, _version, std::move(metadata_id));
         });
     });
 }
@@ -1188,7 +1359,7 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
 
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
     auto& query_state = q_state->query_state;
-    q_state->options = in.read_options(version, qp.local().get_cql_config());
+    q_state->options.emplace(in.read_options(version, qp.local().get_cql_config()));
     auto& options = *q_state->options;
     if (!cached_pk_fn_calls.empty()) {
         options.set_cached_pk_function_calls(std::move(cached_pk_fn_calls));
@@ -1231,14 +1402,100 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
             return cql_server::process_fn_return_type(convert_error_message_to_coordinator_result(msg.get()));
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, std::move(metadata_id), skip_metadata)));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, q_state->query_state.get_trace_state(), version, std::move(metadata_id), skip_metadata)));
         }
     });
 }
 
+bool cql_server::connection::can_offload_execute(request_reader in) const {
+    // The changes of the client state made on the other shard are lost,
+    // so only statements which don't change it can be offloaded.
+    cql3::prepared_cache_key_type cache_key(in.read_short_bytes(), get_dialect());
+    auto prepared = _server._query_processor.local().get_prepared(cache_key);
+    if (!prepared) {
+        return false;
+    }
+    auto* stmt = prepared->statement.get();
+    return dynamic_cast<const cql3::statements::select_statement*>(stmt)
+            || dynamic_cast<const cql3::statements::modification_statement*>(stmt)
+            || dynamic_cast<const cql3::statements::batch_statement*>(stmt);
+}
+
+unsigned statement_cost(const cql3::cql_statement& stmt) noexcept {
+    if (auto* select = dynamic_cast<const cql3::statements::select_statement*>(&stmt)) {
+        // Range scans and indexed queries read much more than single partition reads
+        auto restrictions = select->get_restrictions();
+        return restrictions->is_key_range() || restrictions->uses_secondary_indexing() ? 8 : 1;
+    }
+    if (dynamic_cast<const cql3::statements::modification_statement*>(&stmt)) {
+        return 2;
+    }
+    if (auto* batch = dynamic_cast<const cql3::statements::batch_statement*>(&stmt)) {
+        return std::clamp<unsigned>(2 * batch->statements().size(), 1, 16);
+    }
+    return 1;
+}
+
+static unsigned batch_cost(request_reader in) {
+    in.read_byte(); // type
+    const unsigned n = in.read_short();
+    return std::clamp<unsigned>(2 * n, 1, 16);
+}
+
+unsigned cql_server::connection::execute_cost(request_reader in) const {
+    cql3::prepared_cache_key_type cache_key(in.read_short_bytes(), get_dialect());
+    auto prepared = _server._query_processor.local().get_prepared(cache_key);
+    // An unknown statement fails anyway
+    return prepared ? statement_cost(*prepared->statement) : 1;
+}
+
+unsigned cql_server::connection::query_cost(request_reader in, const service::client_state& client_state) const {
+    auto query = in.read_long_string_view();
+    // Parsing the query is part of the work shedding avoids, so only queries
+    // which were seen before have their cost estimated.
+    auto statement = _server._query_processor.local().find_cached_statement(query, client_state, get_dialect());
+    return statement ? statement_cost(*statement) : 1;
+}
+
+bool should_shed_by_priority(uint32_t requests_serving, uint32_t threshold, float shares, unsigned cost) noexcept {
+    if (!threshold || requests_serving <= threshold) {
+        return false;
+    }
+    // Service levels have up to 1000 shares. A request is shed once the
+    // shard has more than threshold * (1 + priority / cost) requests in
+    // flight: the cheap requests of the top service levels are shed only at
+    // twice the threshold, the expensive ones of the low priority service
+    // levels right above it.
+    auto priority = std::clamp(shares / 1000.0f, 0.01f, 1.0f);
+    return requests_serving > threshold * (1 + priority / cost);
+}
+
+void cql_server::connection::maybe_shed_by_priority(unsigned cost) {
+    if (!should_shed_by_priority(_server._stats.requests_serving, _server._config.requests_prioritized_shedding_threshold(),
+            _current_scheduling_group.get_shares(), cost)) {
+        return;
+    }
+    ++_server._stats.requests_shed_by_priority;
+    // Hint the client to retry once the requests which are queued now are processed.
+    auto retry_in = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(_server.get_cql_sg_stats().queueing_delay()),
+            std::chrono::milliseconds(1));
+    auto message = format("request shed due to coordinator overload (configured via cql_requests_prioritized_shedding_threshold): "
+            "{} in-flight requests, request cost {}, retry in {}ms", _server._stats.requests_serving, cost, retry_in.count());
+    clogger.debug("{}: {}", _client_state.get_remote_address(), message);
+    throw exceptions::overloaded_exception(std::move(message));
+}
+
 future<cql_server::result_with_foreign_response_ptr> cql_server::connection::process_execute(uint16_t stream, request_reader in,
         service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
-    return process(stream, in, client_state, std::move(permit), std::move(trace_state), process_execute_internal);
+    maybe_shed_by_priority(execute_cost(in));
+    auto offload_shard = _server.pick_offload_shard();
+    if (offload_shard && !can_offload_execute(in)) {
+        offload_shard = std::nullopt;
+    }
+    if (offload_shard) {
+        ++_server._stats.requests_offloaded;
+    }
+    return process(stream, in, client_state, std::move(permit), std::move(trace_state), process_execute_internal, offload_shard);
 }
 
 static future<cql_server::process_fn_return_type>
@@ -1329,8 +1586,8 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
     auto& query_state = q_state->query_state;
     // #563. CQL v2 encodes query_options in v1 format for batch requests.
-    q_state->options = std::make_unique<cql3::query_options>(cql3::query_options::make_batch_options(std::move(*in.read_options(version,
-                                                                     qp.local().get_cql_config())), std::move(values)));
+    q_state->options.emplace(cql3::query_options::make_batch_options(in.read_options(version,
+                                                                     qp.local().get_cql_config()), std::move(values)));
     auto& options = *q_state->options;
     if (!cached_pk_fn_calls.empty()) {
         options.set_cached_pk_function_calls(std::move(cached_pk_fn_calls));
@@ -1354,7 +1611,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
 
-            return cql_server::process_fn_return_type(make_foreign(make_result(stream, *msg, trace_state, version, cql_metadata_id_wrapper{})));
+            return cql_server::process_fn_return_type(make_foreign(make_result(stream, msg, trace_state, version, cql_metadata_id_wrapper{})));
         }
     });
 }
@@ -1369,6 +1626,7 @@ cql_server::connection::get_dialect() const {
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process_batch(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit,
         tracing::trace_state_ptr trace_state) {
+    maybe_shed_by_priority(batch_cost(in));
     return process(stream, in, client_state, permit, std::move(trace_state), process_batch_internal);
 }
 
@@ -1384,6 +1642,10 @@ cql_server::connection::process_register(uint16_t stream, request_reader in, ser
         if (!et) {
             return std::move(et).assume_error().into_exception_future<ret_type>();
         }
+        if (et.value() == event::event_type::TABLETS_CHANGE && !client_state.is_protocol_extension_set(cql_protocol_extension::TABLETS_ROUTING_EVENTS)) {
+            return make_exception_future<ret_type>(exceptions::protocol_exception(
+                    format("Event type '{}' requires the TABLETS_ROUTING_EVENTS protocol extension", event_type)));
+        }
         _server._notifier->register_event(std::move(et).value(), this);
     }
     _ready = true;
@@ -1540,6 +1802,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
     opts.insert({"COMPRESSION", "lz4"});
     opts.insert({"COMPRESSION", "snappy"});
+    opts.insert({"COMPRESSION", "zstd"});
     if (_server._config.allow_shard_aware_drivers) {
         opts.insert({"SCYLLA_SHARD", format("{:d}", this_shard_id())});
         opts.insert({"SCYLLA_NR_SHARDS", format("{:d}", smp::count)});
@@ -1634,6 +1897,9 @@ class cql_server::fmt_visitor : public messages::result_message::visitor_base {
             void accept_value(std::optional<managed_bytes_view> cell) {
                 _response.write_value(cell);
             }
+            void accept_stable_value(std::optional<managed_bytes_view> cell) {
+                _response.write_value_in_place(cell);
+            }
             void end_row() { }
 
             int64_t row_count() const { return _row_count; }
@@ -1646,9 +1912,11 @@ class cql_server::fmt_visitor : public messages::result_message::visitor_base {
 };
 
 std::unique_ptr<cql_server::response>
-make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
+make_result(int16_t stream, ::shared_ptr<messages::result_message> msg_ptr, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata) {
+    auto& msg = *msg_ptr;
     auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::RESULT, tr_state);
+    response->set_result(msg_ptr);
     if (!msg.warnings().empty() && version > 3) [[unlikely]] {
         response->set_frame_flag(cql_frame_flags::warning);
         response->write_string_list(msg.warnings());
@@ -1691,58 +1959,128 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
     return response;
 }
 
+std::unique_ptr<cql_server::response>
+cql_server::connection::make_tablets_change_event(const event::tablets_change& event) const
+{
+    auto response = std::make_unique<cql_server::response>(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
+    response->write_string("TABLETS_CHANGE");
+    response->write_string(event.keyspace);
+    response->write_string(event.table);
+    response->write_long(event.version);
+    response->write_int(event.tablets.size());
+    for (auto& tablet : event.tablets) {
+        response->write_bytes(tablet);
+    }
+    return response;
+}
+
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
-    _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
-        auto message = response->make_message(_version, compression);
-        message.on_delete([response = std::move(response)] { });
-        return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
-        });
+    if (_responses_failed) {
+        return;
+    }
+    _pending_responses.push_back(pending_response{std::move(response), std::move(permit), compression, _compression_dict});
+    if (_pending_responses.size() > 1) {
+        // The write of the pending responses is already scheduled.
+        return;
+    }
+    _ready_to_respond = _ready_to_respond.then_wrapped([this] (future<> f) {
+        if (f.failed()) {
+            // The connection is broken, don't hold on to the responses
+            // and their permits until it's closed.
+            _responses_failed = true;
+            _pending_responses.clear();
+            return f;
+        }
+        return write_pending_responses();
     });
 }
 
-scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
+future<> cql_server::connection::write_pending_responses() {
+    // The responses which complete from now on are written by the next call.
+    auto responses = std::exchange(_pending_responses, {});
+    for (auto& r : responses) {
+        auto message = r.response->make_message(_version, r.compression, r.compression_dict.get());
+        message.on_delete([response = std::move(r.response)] { });
+        co_await _write_buf.write(std::move(message));
+    }
+    _frames_written += responses.size();
+    // The output stream batches the messages written since the last flush
+    // into a single vectored write to the socket.
+    co_await _write_buf.flush();
+}
+
+scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression, const utils::shared_dict* dict) {
     if (compression != cql_compression::none) {
-        compress(compression);
+        materialize_external_values();
+        compress(compression, dict);
     }
     scattered_message<char> msg;
-    auto frame = make_frame(version, _body.size());
+    auto frame = make_frame(version, size());
     msg.append(std::move(frame));
-    for (auto&& fragment : _body.fragments()) {
+    for_each_body_fragment([&msg] (bytes_view fragment) {
         msg.append_static(reinterpret_cast<const char*>(fragment.data()), fragment.size());
-    }
+    });
     return msg;
 }
 
-void cql_server::response::compress(cql_compression compression)
+void cql_server::response::materialize_external_values() {
+    if (_external_values.empty()) {
+        return;
+    }
+    bytes_ostream body;
+    for_each_body_fragment([&body] (bytes_view fragment) {
+        body.write(fragment);
+    });
+    _body = std::move(body);
+    _external_values.clear();
+    _external_size = 0;
+}
+
+void cql_server::response::compress(cql_compression compression, const utils::shared_dict* dict)
 {
     switch (compression) {
     case cql_compression::lz4:
-        compress_lz4();
+        compress_lz4(dict);
         break;
     case cql_compression::snappy:
         compress_snappy();
         break;
+    case cql_compression::zstd:
+        compress_zstd(dict);
+        break;
     default:
         throw std::invalid_argument("Invalid CQL compression algorithm");
     }
     set_frame_flag(cql_frame_flags::compression);
 }
 
-void cql_server::response::compress_lz4()
+static int lz4_compress_using_dict(const utils::shared_dict& dict, const char* src, char* dst, int src_size, int dst_capacity) {
+    static thread_local LZ4_stream_t stream = [] {
+        LZ4_stream_t s;
+        LZ4_initStream(&s, sizeof(s));
+        return s;
+    }();
+    LZ4_resetStream_fast(&stream);
+    LZ4_attach_dictionary(&stream, dict.lz4_cdict.get());
+    return LZ4_compress_fast_continue(&stream, src, dst, src_size, dst_capacity, 1);
+}
+
+void cql_server::response::compress_lz4(const utils::shared_dict* dict)
 {
     auto input_buffer = input_buffer_guard();
     auto output_buffer = output_buffer_guard();
 
     auto in = input_buffer.get_linearized_view(_body);
     size_t output_len = LZ4_COMPRESSBOUND(in.size()) + 4;
-    auto bytes_ostream = output_buffer.make_bytes_ostream(output_len, [&in] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+    auto bytes_ostream = output_buffer.make_bytes_ostream(output_len, [&in, dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
         out.data()[0] = (in.size() >> 24) & 0xFF;
         out.data()[1] = (in.size() >> 16) & 0xFF;
         out.data()[2] = (in.size() >> 8) & 0xFF;
         out.data()[3] = in.size() & 0xFF;
-        auto ret = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4);
+        auto ret = dict
+                ? lz4_compress_using_dict(*dict, reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4)
+                : LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4);
         if (ret == 0) {
             return bo::failure(std::runtime_error("CQL frame LZ4 compression failure"));
         }
@@ -1776,6 +2114,30 @@ void cql_server::response::compress_snappy()
     _body = std::move(bytes_ostream).value();
 }
 
+void cql_server::response::compress_zstd(const utils::shared_dict* dict)
+{
+    auto input_buffer = input_buffer_guard();
+    auto output_buffer = output_buffer_guard();
+
+    auto in = input_buffer.get_linearized_view(_body);
+    size_t output_len = ZSTD_compressBound(in.size());
+    auto bytes_ostream = output_buffer.make_bytes_ostream(output_len, [&in, dict] (bytes_mutable_view out) -> utils::result_with_exception<size_t, std::runtime_error> {
+        // The context grows with the size of the largest frame compressed so far.
+        const memory::scoped_large_allocation_warning_threshold slawt{1024*1024};
+        auto ret = dict
+                ? ZSTD_compress_usingCDict(zstd_cctx(), out.data(), out.size(), in.data(), in.size(), dict->zstd_cdict.get())
+                : ZSTD_compressCCtx(zstd_cctx(), out.data(), out.size(), in.data(), in.size(), zstd_compression_level);
+        if (ZSTD_isError(ret)) {
+            return bo::failure(std::runtime_error(fmt::format("CQL frame zstd compression failure: {}", ZSTD_getErrorName(ret))));
+        }
+        return bo::success(ret);
+    });
+    if (!bytes_ostream) {
+        throw std::move(bytes_ostream).as_failure();
+    }
+    _body = std::move(bytes_ostream).value();
+}
+
 void cql_server::response::serialize(const event::schema_change& event, uint8_t version)
 {
     write_string(to_string(event.change));
@@ -1950,6 +2312,18 @@ void cql_server::response::write_value(std::optional<managed_bytes_view> value)
     }
 }
 
+void cql_server::response::write_value_in_place(std::optional<managed_bytes_view> value)
+{
+    if (!_result || !value || value->size_bytes() < min_in_place_value_size) {
+        write_value(std::move(value));
+        return;
+    }
+
+    write_int(value->size_bytes());
+    _external_values.push_back(external_value{_body.size(), *value});
+    _external_size += value->size_bytes();
+}
+
 class type_codec {
 private:
     enum class type_id : int16_t {
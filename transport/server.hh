@@ -19,6 +19,9 @@
 #include "service/qos/qos_configuration_change_subscriber.hh"
 #include "timeout_config.hh"
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/smp.hh>
+#include <atomic>
 #include <memory>
 #include <type_traits>
 #include <boost/intrusive/list.hpp>
@@ -40,10 +43,12 @@
 #include "exceptions/exceptions.hh"
 #include "db/operation_type.hh"
 #include "service/maintenance_mode.hh"
+#include "utils/shared_dict.hh"
 
 namespace cql3 {
 
 class query_processor;
+class cql_statement;
 
 }
 
@@ -78,6 +83,7 @@ enum class cql_compression {
     none,
     lz4,
     snappy,
+    zstd,
 };
 
 enum cql_frame_flags {
@@ -102,13 +108,32 @@ struct [[gnu::packed]] cql_binary_frame_v3 {
 
 struct cql_query_state {
     service::query_state query_state;
-    std::unique_ptr<cql3::query_options> options;
+    // Constructed in place, so that a request allocates the state only once.
+    std::optional<cql3::query_options> options;
 
     cql_query_state(service::client_state& client_state, tracing::trace_state_ptr trace_state_ptr, service_permit permit)
         : query_state(client_state, std::move(trace_state_ptr), std::move(permit))
     { }
 };
 
+// The number of requests in flight on each shard, published by each shard
+// for the others, so that overloaded shards can find less loaded ones.
+class cql_shard_loads {
+    struct alignas(seastar::cache_line_size) shard_load {
+        std::atomic<uint32_t> requests_serving{0};
+    };
+    std::vector<shard_load> _loads;
+public:
+    cql_shard_loads() : _loads(smp::count) { }
+
+    void set(shard_id shard, uint32_t requests_serving) noexcept {
+        _loads[shard].requests_serving.store(requests_serving, std::memory_order_relaxed);
+    }
+    uint32_t get(shard_id shard) const noexcept {
+        return _loads[shard].requests_serving.load(std::memory_order_relaxed);
+    }
+};
+
 struct cql_server_config {
     updateable_timeout_config timeout_config;
     size_t max_request_size;
@@ -119,6 +144,11 @@ struct cql_server_config {
     bool allow_shard_aware_drivers = true;
     smp_service_group bounce_request_smp_service_group = default_smp_service_group();
     utils::updateable_value<uint32_t> max_concurrent_requests;
+    utils::updateable_value<uint32_t> requests_offload_threshold;
+    // 0 disables the prioritized shedding of requests.
+    utils::updateable_value<uint32_t> requests_prioritized_shedding_threshold;
+    // Shared by the shards, null disables the offloading of requests.
+    cql_shard_loads* shard_loads = nullptr;
     utils::updateable_value<bool> cql_duplicate_bind_variable_names_refer_to_same_variable;
     utils::updateable_value<uint32_t> uninitialized_connections_semaphore_cpu_concurrency;
     utils::updateable_value<uint32_t> request_timeout_on_shutdown_in_seconds;
@@ -136,14 +166,30 @@ struct cql_sg_stats {
 
     cql_sg_stats(maintenance_socket_enabled);
     request_kind_stats& get_cql_opcode_stats(cql_binary_opcode op) { return _cql_requests_stats[static_cast<uint8_t>(op)]; }
+    std::chrono::microseconds queueing_delay() const noexcept { return _queueing_delay; }
+    // Accounts the time a request waited for the memory it needs before being processed.
+    void update_queueing_delay(std::chrono::microseconds delay) noexcept {
+        _queueing_delay = (_queueing_delay * 7 + delay) / 8;
+    }
     void register_metrics();
     void rename_metrics();
 private:
     bool _use_metrics = false;
     seastar::metrics::metric_groups _metrics;
     std::vector<request_kind_stats> _cql_requests_stats;
+    // Exponential moving average of the queueing delay of the requests.
+    std::chrono::microseconds _queueing_delay{0};
 };
 
+// The relative cost of executing a statement, so that the most expensive
+// requests are shed first.
+unsigned statement_cost(const cql3::cql_statement& stmt) noexcept;
+
+// Whether a request of the given cost, of a scheduling group with the given
+// shares, is shed while the shard serves requests_serving requests.
+// A zero threshold disables the shedding.
+bool should_shed_by_priority(uint32_t requests_serving, uint32_t threshold, float shares, unsigned cost) noexcept;
+
 struct connection_service_level_params {
     sstring role_name;
     timeout_config timeout_config;
@@ -191,6 +237,8 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving = 0;
         uint64_t requests_blocked_memory = 0;
         uint64_t requests_shed = 0;
+        uint64_t requests_shed_by_priority = 0;
+        uint64_t requests_offloaded = 0;
 
         std::unordered_map<exceptions::exception_code, uint64_t> errors;
     };
@@ -210,6 +258,8 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     qos::service_level_controller& _sl_controller;
     gms::gossiper& _gossiper;
     scheduling_group_key _stats_key;
+    // Compression dictionaries negotiated by the connections of this shard, by name.
+    std::unordered_map<sstring, lw_shared_ptr<const utils::shared_dict>> _compression_dicts;
 public:
     cql_server(distributed<cql3::query_processor>& qp, auth::service&,
             service::memory_limiter& ml,
@@ -229,8 +279,11 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     service::endpoint_lifecycle_subscriber* get_lifecycle_listener() const noexcept;
     service::migration_listener* get_migration_listener() const noexcept;
     qos::qos_configuration_change_subscriber* get_qos_configuration_listener() const noexcept;
+    cql_sg_stats& get_cql_sg_stats() {
+        return scheduling_group_get_specific<cql_sg_stats>(_stats_key);
+    }
     cql_sg_stats::request_kind_stats& get_cql_opcode_stats(cql_binary_opcode op) {
-        return scheduling_group_get_specific<cql_sg_stats>(_stats_key).get_cql_opcode_stats(op);
+        return get_cql_sg_stats().get_cql_opcode_stats(op);
     }
 
     future<utils::chunked_vector<client_data>> get_client_data();
@@ -238,9 +291,17 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     future<> update_connections_service_level_params();
     future<std::vector<connection_service_level_params>> get_connections_service_level_params();
 private:
+    // Returns the dictionary with the given name from system.dicts, if its
+    // content has the given SHA-256 digest, hex-encoded.
+    future<lw_shared_ptr<const utils::shared_dict>> get_compression_dict(sstring name, sstring sha256);
+
+    void update_requests_serving(int32_t delta) noexcept;
+    // Returns a less loaded shard to process a request on, if this one is overloaded.
+    std::optional<shard_id> pick_offload_shard() const;
+
     class fmt_visitor;
     friend class connection;
-    friend std::unique_ptr<cql_server::response> make_result(int16_t stream, messages::result_message& msg,
+    friend std::unique_ptr<cql_server::response> make_result(int16_t stream, ::shared_ptr<messages::result_message> msg,
             const tracing::trace_state_ptr& tr_state, cql_protocol_version_type version, cql_metadata_id_wrapper&& metadata_id, bool skip_metadata);
 
     class connection : public generic_server::connection {
@@ -249,6 +310,11 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         fragmented_temporary_buffer::reader _buffer_reader;
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
+        // Set when the SCYLLA_COMPRESSION_DICTIONARY extension is negotiated.
+        lw_shared_ptr<const utils::shared_dict> _compression_dict;
+        // The name and the digest of the dictionary requested in STARTUP. It's
+        // looked up only once the client is authenticated.
+        std::optional<std::pair<sstring, sstring>> _requested_compression_dict;
         service::client_state _client_state;
         timer<lowres_clock> _shedding_timer;
         scheduling_group _current_scheduling_group;
@@ -256,6 +322,21 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         bool _ready = false;
         bool _authenticating = false;
         bool _tenant_switch = false;
+        uint64_t _frames_read = 0;
+        uint64_t _frames_written = 0;
+
+        struct pending_response {
+            foreign_ptr<std::unique_ptr<cql_server::response>> response;
+            service_permit permit;
+            cql_compression compression;
+            lw_shared_ptr<const utils::shared_dict> compression_dict;
+        };
+        // Responses which completed while the previous ones were being written.
+        // They are written together, with a single flush.
+        std::vector<pending_response> _pending_responses;
+        // Set once writing the responses failed, the responses completing
+        // afterwards are dropped.
+        bool _responses_failed = false;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
@@ -295,6 +376,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         future<std::optional<cql_binary_frame_v3>> read_frame();
         future<std::unique_ptr<cql_server::response>> process_startup(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
         future<std::unique_ptr<cql_server::response>> process_auth_response(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
+        future<> load_requested_compression_dict();
         future<std::unique_ptr<cql_server::response>> process_options(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
         future<result_with_foreign_response_ptr> process_query(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state);
         future<std::unique_ptr<cql_server::response>> process_prepare(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
@@ -317,6 +399,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         std::unique_ptr<cql_server::response> make_topology_change_event(const cql_transport::event::topology_change& event) const;
         std::unique_ptr<cql_server::response> make_status_change_event(const cql_transport::event::status_change& event) const;
         std::unique_ptr<cql_server::response> make_schema_change_event(const cql_transport::event::schema_change& event) const;
+        std::unique_ptr<cql_server::response> make_tablets_change_event(const cql_transport::event::tablets_change& event) const;
         std::unique_ptr<cql_server::response> make_autheticate(int16_t, std::string_view, const tracing::trace_state_ptr& tr_state) const;
         std::unique_ptr<cql_server::response> make_auth_success(int16_t, bytes, const tracing::trace_state_ptr& tr_state) const;
         std::unique_ptr<cql_server::response> make_auth_challenge(int16_t, bytes, const tracing::trace_state_ptr& tr_state) const;
@@ -339,7 +422,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
                                            cql3::dialect>
         future<result_with_foreign_response_ptr>
         process(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state,
-                Process process_fn);
+                Process process_fn, std::optional<shard_id> offload_shard = std::nullopt);
 
         template <typename Process>
             requires std::is_invocable_r_v<future<cql_server::process_fn_return_type>,
@@ -356,9 +439,18 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
                                            cql3::dialect>
         future<process_fn_return_type>
         process_on_shard(shard_id shard, uint16_t stream, fragmented_temporary_buffer::istream is, service::client_state& cs,
-                tracing::trace_state_ptr trace_state, cql3::dialect dialect, cql3::computed_function_values&& cached_vals, Process process_fn);
+                tracing::trace_state_ptr trace_state, cql3::dialect dialect, cql3::computed_function_values&& cached_vals, Process process_fn,
+                bool offloaded = false);
+
+        bool can_offload_execute(request_reader in) const;
+        unsigned execute_cost(request_reader in) const;
+        unsigned query_cost(request_reader in, const service::client_state& client_state) const;
+        // Sheds the request with an OVERLOADED error if the shard processes
+        // too many requests for its cost and the priority of the connection.
+        void maybe_shed_by_priority(unsigned cost);
 
         void write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit = empty_service_permit(), cql_compression compression = cql_compression::none);
+        future<> write_pending_responses();
 
         friend event_notifier;
     };
@@ -379,6 +471,7 @@ class cql_server::event_notifier : public service::migration_listener,
     std::set<cql_server::connection*> _topology_change_listeners;
     std::set<cql_server::connection*> _status_change_listeners;
     std::set<cql_server::connection*> _schema_change_listeners;
+    std::set<cql_server::connection*> _tablets_change_listeners;
     std::unordered_map<gms::inet_address, event::status_change::status_type> _last_status_change;
 
     // We want to delay sending NEW_NODE CQL event to clients until the new node
@@ -421,6 +514,8 @@ class cql_server::event_notifier : public service::migration_listener,
     virtual void on_leave_cluster(const gms::inet_address& endpoint, const locator::host_id& hid) override;
     virtual void on_up(const gms::inet_address& endpoint, locator::host_id hid) override;
     virtual void on_down(const gms::inet_address& endpoint, locator::host_id hid) override;
+
+    virtual void on_token_metadata_changed(const locator::token_metadata& old_tm, const locator::token_metadata& new_tm) override;
 };
 
 inline service::endpoint_lifecycle_subscriber* cql_server::get_lifecycle_listener() const noexcept { return _notifier.get(); }
@@ -2268,6 +2268,18 @@ utils::multiprecision_int deserialize_value(const varint_type_impl&, View v) {
     }
     skip_empty_fragments(v);
     bool negative = v.current_fragment().front() < 0;
+    if (v.size_bytes() <= sizeof(uint64_t)) {
+        // The common case of values which fit in int64_t, read without
+        // going through the multiprecision arithmetic for each byte.
+        uint64_t small = negative ? ~uint64_t(0) : 0;
+        while (v.size_bytes()) {
+            for (uint8_t b : v.current_fragment()) {
+                small = (small << 8) | b;
+            }
+            v.remove_current();
+        }
+        return utils::multiprecision_int(static_cast<long long>(small));
+    }
     utils::multiprecision_int num;
   while (v.size_bytes()) {
     for (uint8_t b : v.current_fragment()) {
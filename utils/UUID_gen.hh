@@ -16,6 +16,7 @@
 #include <chrono>
 #include <random>
 #include <limits>
+#include <vector>
 
 #include "UUID.hh"
 #include "on_internal_error.hh"
@@ -97,14 +98,19 @@ class UUID_gen
     // need monotonicity between time UUIDs created at different
     // shards and UUID code uses thread local state on each shard.
     int64_t create_time_safe() {
+        return create_time(reserve_times(1));
+    }
+
+    // Like create_time_safe(), but reserves `n` consecutive decimicrosecond
+    // times, reading the clock once, and returns the first of them.
+    decimicroseconds reserve_times(size_t n) {
         auto millis = duration_cast<milliseconds>(db_clock::now().time_since_epoch());
         decimicroseconds when = from_unix_timestamp(millis);
-        if (when > _last_used_time) {
-            _last_used_time = when;
-        } else {
-            when = ++_last_used_time;
+        if (when <= _last_used_time) {
+            when = _last_used_time + decimicroseconds(1);
         }
-        return create_time(when);
+        _last_used_time = when + decimicroseconds(n - 1);
+        return when;
     }
 
 public:
@@ -123,6 +129,29 @@ class UUID_gen
         return uuid;
     }
 
+    /**
+     * Creates `n` type 1 UUIDs (time-based UUIDs), as if by calling
+     * get_time_UUID() `n` times, but cheaper. They are monotonic, and so
+     * are they with respect to other UUIDs created by get_time_UUID()
+     * on the same shard.
+     *
+     * @return UUIDs in increasing order
+     */
+    static std::vector<UUID> get_time_UUIDs(size_t n)
+    {
+        std::vector<UUID> uuids;
+        if (n == 0) {
+            return uuids;
+        }
+        uuids.reserve(n);
+        auto first = _instance.reserve_times(n);
+        for (size_t i = 0; i < n; ++i) {
+            uuids.emplace_back(create_time(first + decimicroseconds(i)), clock_seq_and_node);
+        }
+        SCYLLA_ASSERT(uuids.front().is_timestamp());
+        return uuids;
+    }
+
     /**
      * Creates a type 1 UUID (time-based UUID) with the wall clock time point @param tp.
      *
@@ -8,6 +8,7 @@
 
 #include <seastar/core/metrics.hh>
 #include <seastar/util/defer.hh>
+#include <bit>
 #include <numeric>
 #include "log.hh"
 #include "utils/advanced_rpc_compressor.hh"
@@ -182,11 +183,13 @@ static raw_stream the_raw_stream;
 
 advanced_rpc_compressor::advanced_rpc_compressor(
     tracker& fac,
-    std::function<future<>()> send_empty_frame)
+    std::function<future<>()> send_empty_frame,
+    per_connection_class_stats& class_stats)
     : _tracker(fac)
     , _control(_needs_progress)
     , _send_empty_frame(std::move(send_empty_frame))
     , _progress_fiber(start_progress_fiber())
+    , _class_stats(class_stats)
 {
     _idx =_tracker->register_compressor(this);
 }
@@ -221,7 +224,78 @@ compression_algorithm advanced_rpc_compressor::get_algo_for_next_msg(size_t msgs
     ) {
         algo = compression_algorithm::type::LZ4;
     }
-    return algo;
+    if (!_tracker->_cfg.adaptive.get() || algo == compression_algorithm::type::RAW) {
+        return algo;
+    }
+    if (msgsize <= _tracker->_cfg.adaptive_raw_max_msg_size.get()) {
+        return compression_algorithm::type::RAW;
+    }
+    // The receiver decompresses whatever the frame header says, so any algorithm
+    // not heavier than the negotiated one can be used for this message.
+    return _tracker->choose_adaptive_algorithm(_class_stats, compression_algorithm_set::this_or_lighter(algo));
+}
+
+// Every exploration_interval-th adaptive message is compressed with an algorithm other
+// than the currently best one, to keep the estimates of the other algorithms fresh
+// as the traffic changes.
+constexpr static uint64_t exploration_interval = 64;
+// Weight of the most recent message in the moving averages.
+constexpr static double estimate_decay = 1.0 / 16;
+// Number of samples an algorithm needs before its estimates are trusted.
+constexpr static uint64_t min_samples = 4;
+
+compression_algorithm advanced_rpc_compressor::tracker::choose_adaptive_algorithm(per_connection_class_stats& cs, compression_algorithm_set candidates) noexcept {
+    const auto n = ++cs.adaptive_messages;
+    // First make sure that every candidate has some samples.
+    for (size_t i = 0; i < compression_algorithm::count(); ++i) {
+        if (candidates.contains(compression_algorithm(i)) && cs.samples[i] < min_samples) {
+            return compression_algorithm(i);
+        }
+    }
+    const double byte_cost = cs.cls.cross_dc ? _cfg.adaptive_remote_byte_cost_nanos.get() : _cfg.adaptive_local_byte_cost_nanos.get();
+    std::optional<compression_algorithm> best;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < compression_algorithm::count(); ++i) {
+        if (!candidates.contains(compression_algorithm(i))) {
+            continue;
+        }
+        double cost = cs.ratio[i] * byte_cost + cs.cpu_nanos_per_byte[i];
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = compression_algorithm(i);
+        }
+    }
+    if (n % exploration_interval == 0) {
+        // Round-robin over the other candidates.
+        auto others = candidates.difference(compression_algorithm_set::singleton(*best));
+        auto n_others = std::popcount(others.value());
+        if (n_others) {
+            auto pick = (n / exploration_interval) % n_others;
+            for (size_t i = 0; i < compression_algorithm::count(); ++i) {
+                if (others.contains(compression_algorithm(i)) && pick-- == 0) {
+                    return compression_algorithm(i);
+                }
+            }
+        }
+    }
+    return *best;
+}
+
+void advanced_rpc_compressor::tracker::update_adaptive_estimates(per_connection_class_stats& cs, compression_algorithm algo,
+        size_t uncompressed, size_t compressed, uint64_t nanos) noexcept {
+    if (uncompressed == 0) {
+        return;
+    }
+    const auto i = algo.idx();
+    const double ratio = double(compressed) / uncompressed;
+    const double cpu = double(nanos) / uncompressed;
+    if (cs.samples[i]++ == 0) {
+        cs.ratio[i] = ratio;
+        cs.cpu_nanos_per_byte[i] = cpu;
+    } else {
+        cs.ratio[i] += (ratio - cs.ratio[i]) * estimate_decay;
+        cs.cpu_nanos_per_byte[i] += (cpu - cs.cpu_nanos_per_byte[i]) * estimate_decay;
+    }
 }
 
 sstring advanced_rpc_compressor::name() const {
@@ -235,12 +309,13 @@ const sstring& advanced_rpc_compressor::tracker::supported() const {
 std::unique_ptr<advanced_rpc_compressor> advanced_rpc_compressor::tracker::negotiate(
     sstring feature,
     bool is_server,
-    std::function<future<>()> send_empty_frame)
+    std::function<future<>()> send_empty_frame,
+    connection_class cls)
 {
     if (feature != COMPRESSOR_NAME) {
         return nullptr;
     }
-    auto c = std::make_unique<advanced_rpc_compressor>(*this, std::move(send_empty_frame));
+    auto c = std::make_unique<advanced_rpc_compressor>(*this, std::move(send_empty_frame), get_class_stats(cls));
     c->_control.set_supported_algos(algo_list_to_set(_cfg.algo_config.get()));
     c->_control.announce_dict(_most_recent_dict);
     return c;
@@ -303,6 +378,33 @@ void advanced_rpc_compressor::tracker::register_metrics() {
     }
 }
 
+per_connection_class_stats& advanced_rpc_compressor::tracker::get_class_stats(connection_class cls) {
+    auto [it, inserted] = _class_stats.try_emplace(cls.key(), cls);
+    if (inserted && _cfg.register_metrics) {
+        register_class_metrics(it->second);
+    }
+    return it->second;
+}
+
+const per_connection_class_stats* advanced_rpc_compressor::tracker::get_class_stats(connection_class cls) const noexcept {
+    auto it = _class_stats.find(cls.key());
+    return it == _class_stats.end() ? nullptr : &it->second;
+}
+
+void advanced_rpc_compressor::tracker::register_class_metrics(per_connection_class_stats& cs) {
+    namespace sm = seastar::metrics;
+    auto index_label = sm::label("connection_index")(cs.cls.index == connection_class::unknown_index ? "unknown" : fmt::to_string(cs.cls.index));
+    auto locality_label = sm::label("locality")(cs.cls.cross_dc ? "cross_dc" : "local");
+    _metrics.add_group("rpc_compression_connection_class", {
+        sm::make_counter("bytes_sent", cs.bytes_sent, sm::description("bytes written to RPC connections of this class, before compression"), {index_label, locality_label}),
+        sm::make_counter("compressed_bytes_sent", cs.compressed_bytes_sent, sm::description("bytes written to RPC connections of this class, after compression"), {index_label, locality_label}),
+        sm::make_counter("messages_sent", cs.messages_sent, sm::description("RPC messages sent over connections of this class"), {index_label, locality_label}),
+        sm::make_counter("compression_cpu_nanos", cs.compression_cpu_nanos, sm::description("nanoseconds spent on compression of messages sent over connections of this class"), {index_label, locality_label}),
+        sm::make_gauge("compression_cpu_nanos_per_byte", [&cs] { return cs.cpu_nanos_per_byte_sent(); },
+                sm::description("average nanoseconds spent on compression per byte sent over connections of this class"), {index_label, locality_label}),
+    });
+}
+
 uint64_t advanced_rpc_compressor::tracker::get_total_nanos_spent() const noexcept {
     return _stats[static_cast<int>(compression_algorithm::type::ZSTD)].decompression_cpu_nanos
         + _stats[static_cast<int>(compression_algorithm::type::ZSTD)].compression_cpu_nanos
@@ -363,8 +465,15 @@ rpc::snd_buf advanced_rpc_compressor::compress(size_t head_space, rpc::snd_buf d
     auto algo = get_algo_for_next_msg(data.size);
 
     auto& stats = _tracker->_stats[algo.idx()];
+    auto uncompressed_size = data.size;
+    size_t compressed_size = 0;
     auto update_time_stats = defer([&, nanos_before = now] {
-        stats.compression_cpu_nanos += _tracker->get_steady_nanos() - nanos_before;
+        auto nanos = _tracker->get_steady_nanos() - nanos_before;
+        stats.compression_cpu_nanos += nanos;
+        _class_stats.compression_cpu_nanos += nanos;
+        if (compressed_size && uncompressed_size > _tracker->_cfg.adaptive_raw_max_msg_size.get()) {
+            _tracker->update_adaptive_estimates(_class_stats, algo, uncompressed_size, compressed_size, nanos);
+        }
     });
 
     _tracker->ingest(data);
@@ -372,7 +481,6 @@ rpc::snd_buf advanced_rpc_compressor::compress(size_t head_space, rpc::snd_buf d
     auto protocol_header = _control.produce_control_header();
     const size_t protocol_header_size = protocol_header ? control_protocol_frame::serialized_size : 0;
 
-    auto uncompressed_size = data.size;
     auto compressed = std::invoke([&] {
         try {
             return compress_impl(head_space + 1 + checksum_size + protocol_header_size, std::move(data), get_compressor(algo), true, rpc::snd_buf::chunk_size);
@@ -401,9 +509,13 @@ rpc::snd_buf advanced_rpc_compressor::compress(size_t head_space, rpc::snd_buf d
         protocol_header->serialize(out);
     }
 
+    compressed_size = compressed.size - head_space;
     stats.bytes_sent += uncompressed_size;
-    stats.compressed_bytes_sent += compressed.size - head_space;
+    stats.compressed_bytes_sent += compressed_size;
     stats.messages_sent += 1;
+    _class_stats.bytes_sent += uncompressed_size;
+    _class_stats.compressed_bytes_sent += compressed_size;
+    _class_stats.messages_sent += 1;
     return compressed;
 }
 
@@ -10,6 +10,7 @@
 
 #include <seastar/core/condition-variable.hh>
 #include <seastar/rpc/rpc_types.hh>
+#include <map>
 #include <utility>
 #include "utils/refcounted.hh"
 #include "utils/updateable_value.hh"
@@ -125,6 +126,21 @@ class compression_algorithm_set {
 
 using algo_config = std::vector<enum_option<compression_algorithm>>;
 
+// Identifies a group of connections which are expected to carry similar traffic.
+// In adaptive mode, the compressors of each class learn their algorithm
+// choice together, and each class has its own metrics.
+//
+// messaging_service uses the connection index (which corresponds to the
+// kind of traffic: gossip, streaming, statements, ...) and whether the
+// peer is in a different DC.
+struct connection_class {
+    // Used for connections of unknown index, e.g. on the server side.
+    constexpr static unsigned unknown_index = std::numeric_limits<unsigned>::max();
+    unsigned index = unknown_index;
+    bool cross_dc = false;
+    constexpr uint64_t key() const noexcept { return (uint64_t(index) << 1) | cross_dc; }
+};
+
 // See docs/dev/advanced_rpc_compression.md,
 // section `Negotiation` for more information about the protocol.
 struct control_protocol {
@@ -170,6 +186,8 @@ struct control_protocol {
     const shared_dict& receiver_current_dict() const noexcept; 
 };
 
+struct per_connection_class_stats;
+
 class advanced_rpc_compressor final : public rpc::compressor {
 public:
     class tracker;
@@ -204,6 +222,10 @@ class advanced_rpc_compressor final : public rpc::compressor {
     // Calls the appropriate get_*_dstream() function.
     stream_decompressor& get_decompressor(compression_algorithm);
 
+    // Stats and adaptive mode state of the class this connection belongs to.
+    // Owned by the tracker.
+    per_connection_class_stats& _class_stats;
+
     // Decides the algorithm used for the next message, based
     // on the state of the negotiation and the size of the message.
     compression_algorithm get_algo_for_next_msg(size_t msgsize);
@@ -213,7 +235,8 @@ class advanced_rpc_compressor final : public rpc::compressor {
 public:
     advanced_rpc_compressor(
         tracker& fac,
-        std::function<future<>()> send_empty_frame
+        std::function<future<>()> send_empty_frame,
+        per_connection_class_stats& class_stats
     );
     ~advanced_rpc_compressor();
 
@@ -237,6 +260,32 @@ struct per_algorithm_stats {
     uint64_t decompression_cpu_nanos = 0;
 };
 
+// Tracker holds one of these for every connection_class which had a connection negotiated.
+// Apart from the metrics, they hold the estimates used by the adaptive mode.
+struct per_connection_class_stats {
+    connection_class cls;
+    uint64_t bytes_sent = 0;
+    uint64_t compressed_bytes_sent = 0;
+    uint64_t messages_sent = 0;
+    uint64_t compression_cpu_nanos = 0;
+    // Exponentially-weighted moving averages of the compression ratio (compressed size / uncompressed size)
+    // and of the CPU cost of compression of this class's messages, per algorithm.
+    // Only updated for messages which were worth compressing, i.e. weren't sent raw because of their size.
+    std::array<double, compression_algorithm::count()> ratio;
+    std::array<double, compression_algorithm::count()> cpu_nanos_per_byte;
+    std::array<uint64_t, compression_algorithm::count()> samples{};
+    // Counts the messages sent with adaptive choice, used for scheduling exploration.
+    uint64_t adaptive_messages = 0;
+
+    explicit per_connection_class_stats(connection_class c) : cls(c) {
+        ratio.fill(1.0);
+        cpu_nanos_per_byte.fill(0.0);
+    }
+    double cpu_nanos_per_byte_sent() const noexcept {
+        return bytes_sent ? double(compression_cpu_nanos) / bytes_sent : 0;
+    }
+};
+
 // The tracker contains everything which is shared between compressor instances:
 // stats, metrics, limits, reusable non-streaming compressors.
 //
@@ -259,6 +308,17 @@ class advanced_rpc_compressor::tracker : public refcounted {
         updateable_value<algo_config> algo_config{{compression_algorithm::type::ZSTD, compression_algorithm::type::LZ4}};
         bool register_metrics = false;
         updateable_value<bool> checksumming{true};
+        // If enabled, the algorithm used for each message is chosen (from those allowed by
+        // the negotiation and the limits above) based on the ratio and CPU cost observed
+        // for the connection class, instead of always using the negotiated one.
+        updateable_value<bool> adaptive{false};
+        // In adaptive mode, messages up to this size are sent uncompressed.
+        updateable_value<uint32_t> adaptive_raw_max_msg_size{64};
+        // In adaptive mode, the cost of sending one byte over the network, expressed
+        // in nanoseconds of CPU time, for intra-DC and cross-DC connections respectively.
+        // An algorithm is preferred if it minimizes `ratio * byte cost + CPU nanoseconds per byte`.
+        updateable_value<float> adaptive_local_byte_cost_nanos{1};
+        updateable_value<float> adaptive_remote_byte_cost_nanos{20};
     };
 private:
     friend advanced_rpc_compressor;
@@ -267,6 +327,8 @@ class advanced_rpc_compressor::tracker : public refcounted {
     observer<algo_config> _algo_config_observer;
 
     std::array<per_algorithm_stats, compression_algorithm::count()> _stats;
+    // Keyed by connection_class::key(). Node-based, so references to elements are stable.
+    std::map<uint64_t, per_connection_class_stats> _class_stats;
     metrics::metric_groups _metrics;
 
     // Compression contexts for non-streaming compression modes.
@@ -281,6 +343,14 @@ class advanced_rpc_compressor::tracker : public refcounted {
     dict_sampler* _dict_sampler = nullptr;
 
     void register_metrics();
+    void register_class_metrics(per_connection_class_stats&);
+    per_connection_class_stats& get_class_stats(connection_class);
+
+    // Implements the adaptive mode of get_algo_for_next_msg.
+    // `candidates` are the algorithms which are allowed for the message.
+    compression_algorithm choose_adaptive_algorithm(per_connection_class_stats&, compression_algorithm_set candidates) noexcept;
+    // Feeds the observed result of compressing a message into the estimates of the class.
+    void update_adaptive_estimates(per_connection_class_stats&, compression_algorithm, size_t uncompressed, size_t compressed, uint64_t nanos) noexcept;
     void maybe_refresh_zstd_quota(uint64_t now) noexcept;
     bool cpu_limit_exceeded() const noexcept;
     uint64_t get_total_nanos_spent() const noexcept;
@@ -307,8 +377,11 @@ class advanced_rpc_compressor::tracker : public refcounted {
     // `tracker` itself doesn't inherit from `factory` (just because this inheritance would have no users),
     // but a wrapper over `tracker` can use these to implement the interface.
     const sstring& supported() const;
-    std::unique_ptr<advanced_rpc_compressor> negotiate(sstring feature, bool is_server, std::function<future<>()> send_empty_frame);
+    std::unique_ptr<advanced_rpc_compressor> negotiate(sstring feature, bool is_server, std::function<future<>()> send_empty_frame,
+            connection_class cls = {});
     std::span<const per_algorithm_stats, compression_algorithm::count()> get_stats() const noexcept;
+    // Returns nullptr if no connection of the given class was negotiated yet.
+    const per_connection_class_stats* get_class_stats(connection_class) const noexcept;
 
     void announce_dict(dict_ptr);
     void attach_to_dict_sampler(dict_sampler*) noexcept;
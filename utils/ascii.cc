@@ -11,11 +11,18 @@
 #include "ascii.hh"
 #include <seastar/core/byteorder.hh>
 
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace utils {
 
 namespace ascii {
 
-bool validate(const uint8_t *data, size_t len) {
+static inline bool validate_scalar(const uint8_t *data, size_t len) {
     // OR all bytes
     uint8_t orall = 0;
 
@@ -46,6 +53,68 @@ bool validate(const uint8_t *data, size_t len) {
     return orall < 0x80;
 }
 
+#if defined(__x86_64__)
+
+arch_target("default") bool validate_impl(const uint8_t *data, size_t len) {
+    return validate_scalar(data, len);
+}
+
+// OR by 32-bytes and two independent streams, the sign bits of the
+// result are set if any of the bytes is not ASCII.
+arch_target("avx2") bool validate_impl(const uint8_t *data, size_t len) {
+    if (len >= 64) {
+        __m256i or1 = _mm256_setzero_si256();
+        __m256i or2 = _mm256_setzero_si256();
+
+        do {
+            or1 = _mm256_or_si256(or1, _mm256_loadu_si256((const __m256i *)data));
+            or2 = _mm256_or_si256(or2, _mm256_loadu_si256((const __m256i *)(data + 32)));
+
+            data += 64;
+            len -= 64;
+        } while (len >= 64);
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(or1, or2))) {
+            return false;
+        }
+    }
+    return validate_scalar(data, len);
+}
+
+#elif defined(__aarch64__)
+
+static bool validate_impl(const uint8_t *data, size_t len) {
+    if (len >= 32) {
+        uint8x16_t or1 = vdupq_n_u8(0);
+        uint8x16_t or2 = vdupq_n_u8(0);
+
+        do {
+            or1 = vorrq_u8(or1, vld1q_u8(data));
+            or2 = vorrq_u8(or2, vld1q_u8(data + 16));
+
+            data += 32;
+            len -= 32;
+        } while (len >= 32);
+
+        if (vmaxvq_u8(vorrq_u8(or1, or2)) >= 0x80) {
+            return false;
+        }
+    }
+    return validate_scalar(data, len);
+}
+
+#else
+
+static bool validate_impl(const uint8_t *data, size_t len) {
+    return validate_scalar(data, len);
+}
+
+#endif
+
+bool validate(const uint8_t *data, size_t len) {
+    return validate_impl(data, len);
+}
+
 } // namespace ascii
 
 } // namespace utils
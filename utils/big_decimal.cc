@@ -11,6 +11,8 @@
 #include <cassert>
 #include "marshal_exception.hh"
 #include <seastar/core/format.hh>
+#include <array>
+#include <optional>
 
 #ifdef __clang__
 
@@ -37,6 +39,78 @@ uint64_t from_varint_to_integer(const utils::multiprecision_int& varint) {
     return static_cast<uint64_t>(~static_cast<uint64_t>(0) & boost::multiprecision::cpp_int(varint));
 }
 
+namespace {
+
+// Fast paths for the common case of unscaled values which fit in int64_t.
+//
+// cpp_int keeps such values inline, but its generic algorithms, the
+// expression templates and the powers of ten computed for rescaling are
+// still costly. With both values in int64_t and the scales less than
+// 19 apart, rescaling and adding fit in 128-bit arithmetic, with no
+// chance of overflow: |v| * 10^18 * 2 < 2^63 * 2^60 * 2 = 2^124.
+
+using int128_t = __int128;
+using uint128_t = unsigned __int128;
+
+constexpr int max_small_rescale = 18;
+
+constexpr auto small_pow10 = [] {
+    std::array<int64_t, max_small_rescale + 1> p{};
+    p[0] = 1;
+    for (size_t i = 1; i < p.size(); ++i) {
+        p[i] = p[i - 1] * 10;
+    }
+    return p;
+}();
+
+std::optional<int64_t> small_value(const boost::multiprecision::cpp_int& v) noexcept {
+    if (v < std::numeric_limits<int64_t>::min() || v > std::numeric_limits<int64_t>::max()) {
+        return std::nullopt;
+    }
+    return v.convert_to<int64_t>();
+}
+
+// The unscaled values of a and b, rescaled to the larger of their scales.
+std::optional<std::pair<int128_t, int128_t>> rescale_small(const big_decimal& a, const big_decimal& b) noexcept {
+    auto x = small_value(a.unscaled_value());
+    if (!x) {
+        return std::nullopt;
+    }
+    auto y = small_value(b.unscaled_value());
+    if (!y) {
+        return std::nullopt;
+    }
+    int64_t diff = int64_t(a.scale()) - int64_t(b.scale());
+    if (diff > max_small_rescale || diff < -max_small_rescale) {
+        return std::nullopt;
+    }
+    int128_t u = *x;
+    int128_t v = *y;
+    if (diff > 0) {
+        v *= small_pow10[diff];
+    } else {
+        u *= small_pow10[-diff];
+    }
+    return std::pair(u, v);
+}
+
+boost::multiprecision::cpp_int to_cpp_int(int128_t v) {
+    if (v >= std::numeric_limits<int64_t>::min() && v <= std::numeric_limits<int64_t>::max()) {
+        return boost::multiprecision::cpp_int(int64_t(v));
+    }
+    const bool negative = v < 0;
+    const uint128_t magnitude = negative ? -uint128_t(v) : uint128_t(v);
+    boost::multiprecision::cpp_int r(uint64_t(magnitude >> 64));
+    r <<= 64;
+    r |= uint64_t(magnitude);
+    if (negative) {
+        r = -r;
+    }
+    return r;
+}
+
+}
+
 big_decimal::big_decimal() : big_decimal(0, 0) {}
 big_decimal::big_decimal(int32_t scale, boost::multiprecision::cpp_int unscaled_value)
     : _scale(scale), _unscaled_value(std::move(unscaled_value)) {}
@@ -151,6 +225,10 @@ std::strong_ordering big_decimal::tri_cmp_slow(const big_decimal& other) const
 
 std::strong_ordering big_decimal::operator<=>(const big_decimal& other) const
 {
+    if (auto r = rescale_small(*this, other)) {
+        auto [x, y] = *r;
+        return x < y ? std::strong_ordering::less : x > y ? std::strong_ordering::greater : std::strong_ordering::equal;
+    }
     if (_scale == other._scale) {
         return _unscaled_value.compare(other._unscaled_value) <=> 0;
     }
@@ -249,6 +327,11 @@ std::strong_ordering big_decimal::tri_cmp_positive_nonzero_different_scale(const
 
 big_decimal& big_decimal::operator+=(const big_decimal& other)
 {
+    if (auto r = rescale_small(*this, other)) {
+        _unscaled_value = to_cpp_int(r->first + r->second);
+        _scale = std::max(_scale, other._scale);
+        return *this;
+    }
     if (_scale == other._scale) {
         _unscaled_value += other._unscaled_value;
     } else {
@@ -263,6 +346,11 @@ big_decimal& big_decimal::operator+=(const big_decimal& other)
 }
 
 big_decimal& big_decimal::operator-=(const big_decimal& other) {
+    if (auto r = rescale_small(*this, other)) {
+        _unscaled_value = to_cpp_int(r->first - r->second);
+        _scale = std::max(_scale, other._scale);
+        return *this;
+    }
     if (_scale == other._scale) {
         _unscaled_value -= other._unscaled_value;
     } else {
@@ -302,6 +390,18 @@ big_decimal big_decimal::div(const ::uint64_t y, const rounding_mode mode) const
     }
 
     // Implementation of Division with Half to Even (aka Bankers) Rounding
+    if (auto x = small_value(_unscaled_value); x && y) {
+        const bool negative = *x < 0;
+        const uint64_t a = negative ? -uint64_t(*x) : uint64_t(*x);
+        uint64_t q = a / y;
+        const uint64_t r = a % y;
+        // Compares 2*r with y without overflowing.
+        if (r > y - r || (r == y - r && q % 2 == 1)) {
+            q += 1;
+        }
+        return big_decimal(_scale, to_cpp_int(negative ? -int128_t(q) : int128_t(q)));
+    }
+
     const boost::multiprecision::cpp_int sign = _unscaled_value >= 0 ? +1 : -1;
     const boost::multiprecision::cpp_int a = sign * _unscaled_value;
     // cpp_int uses lazy evaluation and for older versions of boost and some
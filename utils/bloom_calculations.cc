@@ -8,6 +8,8 @@
  * SPDX-License-Identifier: (LicenseRef-ScyllaDB-Source-Available-1.0 and Apache-2.0)
  */
 
+#include <cmath>
+
 #include "bloom_calculations.hh"
 
 namespace utils {
@@ -69,5 +71,30 @@ static std::vector<int> initialize_opt_k() {
 }
 
 const std::vector<int> opt_k_per_buckets = initialize_opt_k();
+
+double split_block_false_positive_probability(double bits_per_element) {
+    // The number of keys hashed to a block follows a Poisson distribution.
+    // A block holding n keys yields a false positive when the probed bit
+    // is set in each of its words, and each key sets one bit per word.
+    const double lambda = split_block_bits / bits_per_element;
+    const int max_keys = int(lambda + 20 * std::sqrt(lambda) + 20);
+    double p_keys = std::exp(-lambda);
+    double fp = 0;
+    for (int n = 1; n <= max_keys; ++n) {
+        p_keys *= lambda / n;
+        fp += p_keys * std::pow(1 - std::pow(1 - 1.0 / 64, n), split_block_words);
+    }
+    return fp;
+}
+
+int split_block_bits_per_element(double max_false_pos_prob) {
+    for (int bits = split_block_min_bits_per_element; bits <= split_block_max_bits_per_element; ++bits) {
+        if (split_block_false_positive_probability(bits) <= max_false_pos_prob) {
+            return bits;
+        }
+    }
+    throw exceptions::unsupported_operation_exception(format("Unable to satisfy {:f} with a split-block filter", max_false_pos_prob));
+}
+
 }
 }
@@ -134,6 +134,30 @@ namespace bloom_calculations {
         return probs.back().back();
     }
 
+    /**
+     * Split-block filters set one bit in each of the 64-bit words of a single
+     * 512 bit block, so their false positive rate for a given number of bits
+     * per element is somewhat higher than that of the classic layout, and
+     * they have to be sized by a model of their own.
+     */
+    int constexpr split_block_words = 8;
+    int constexpr split_block_bits = split_block_words * 64;
+    int constexpr split_block_min_bits_per_element = 2;
+    int constexpr split_block_max_bits_per_element = 64;
+
+    /**
+     * @return the expected false positive rate of a split-block filter
+     * with the given number of bits per element.
+     */
+    double split_block_false_positive_probability(double bits_per_element);
+
+    /**
+     * @return the smallest number of bits per element with which a split-block
+     * filter satisfies max_false_pos_prob.
+     * @throws unsupported_operation_exception if no supported size satisfies it
+     */
+    int split_block_bits_per_element(double max_false_pos_prob);
+
 }
 
 }
@@ -16,6 +16,8 @@
 #include "utils/large_bitset.hh"
 #include <array>
 #include <cstdlib>
+#include <cstring>
+#include "utils/div_ceil.hh"
 #include "utils/bloom_calculations.hh"
 #include "bloom_filter.hh"
 
@@ -61,6 +63,17 @@ bool bloom_filter::is_present(hashed_key key) {
     return result;
 }
 
+// Most negative lookups are decided by the first couple of probes, so only
+// prefetch those rather than paying for computing all k indexes twice.
+static constexpr int prefetched_probes = 2;
+
+void bloom_filter::prefetch(hashed_key key) noexcept {
+    for_each_index(key, std::min(_hash_count, prefetched_probes), _bitset.size(), _format, [this] (auto i) {
+        _bitset.prefetch(i);
+        return stop_iteration::no;
+    });
+}
+
 void bloom_filter::add(const bytes_view& key) {
     for_each_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, [this] (auto i) {
         _bitset.set(i);
@@ -72,18 +85,91 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+namespace {
+
+using block_vector = uint64_t __attribute__((vector_size(split_block_bloom_filter::words_per_block * sizeof(uint64_t))));
+
+// Odd multipliers, one per word of the block. The 6 most significant bits
+// of the product select the bit to probe in the corresponding word.
+constexpr block_vector block_salts = {
+    0x9e3779b97f4a7c15, 0xbf58476d1ce4e5b9, 0x94d049bb133111eb, 0xd6e8feb86659fd93,
+    0xc2b2ae3d27d4eb4f, 0x165667b19e3779f9, 0x85ebca77c2b2ae63, 0xff51afd7ed558ccd,
+};
+
+// The two halves of the murmur3 hash are independent, so use the first one
+// to pick the block and the second one to pick the bits within the block.
+size_t block_index(hashed_key hk, size_t nr_blocks) {
+    return (static_cast<unsigned __int128>(hk.hash()[0]) * nr_blocks) >> 64;
+}
+
+// Vectors are passed by reference rather than by value, so that the
+// calling convention doesn't depend on the vector ISA the code is built for.
+void block_mask(hashed_key hk, block_vector& mask) {
+    block_vector h = block_vector{} + hk.hash()[1];
+    mask = (block_vector{} + 1) << ((h * block_salts) >> 58);
+}
+
+}
+
+split_block_bloom_filter::split_block_bloom_filter(bitmap&& bs) noexcept
+    : bloom_filter(words_per_block, std::move(bs), filter_format::m_format)
+    , _nr_blocks(bits().size() / bits_per_block)
+{ }
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    block_vector mask, block;
+    block_mask(key, mask);
+    std::memcpy(&block, bits().word_ptr(block_index(key, _nr_blocks) * words_per_block), sizeof(block));
+    block_vector missing = mask & ~block;
+    uint64_t any_missing = 0;
+    for (size_t i = 0; i < words_per_block; ++i) {
+        any_missing |= missing[i];
+    }
+    return !any_missing;
+}
+
+void split_block_bloom_filter::prefetch(hashed_key key) noexcept {
+    __builtin_prefetch(bits().word_ptr(block_index(key, _nr_blocks) * words_per_block));
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    auto hk = make_hashed_key(key);
+    auto* p = bits().word_ptr(block_index(hk, _nr_blocks) * words_per_block);
+    block_vector mask, block;
+    block_mask(hk, mask);
+    std::memcpy(&block, p, sizeof(block));
+    block |= mask;
+    std::memcpy(p, &block, sizeof(block));
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
 size_t get_bitset_size(int64_t num_elements, int buckets_per) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
     return num_bits;
 }
 
-filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
+size_t get_split_block_bitset_size(int64_t num_elements, int bits_per_element) {
+    auto nr_blocks = div_ceil(uint64_t(std::max<int64_t>(num_elements, 1)) * bits_per_element, split_block_bloom_filter::bits_per_block);
+    return nr_blocks * split_block_bloom_filter::bits_per_block;
+}
+
+filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format, filter_layout layout) {
+    if (layout == filter_layout::split_block) {
+        return std::make_unique<split_block_bloom_filter>(std::move(bitset));
+    }
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
 
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, large_bitset(get_bitset_size(num_elements, buckets_per)), format);
 }
+
+filter_ptr create_split_block_filter(int64_t num_elements, int bits_per_element) {
+    return std::make_unique<split_block_bloom_filter>(large_bitset(get_split_block_bitset_size(num_elements, bits_per_element)));
+}
 }
 }
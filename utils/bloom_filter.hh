@@ -44,6 +44,8 @@ class bloom_filter: public i_filter {
 
     virtual bool is_present(hashed_key key) override;
 
+    virtual void prefetch(hashed_key key) noexcept override;
+
     virtual void clear() override {
         _bitset.clear();
     }
@@ -66,6 +68,38 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A split-block bloom filter: a key selects one 64-byte block of the bitset
+// and sets a single bit in each of the block's eight 64-bit words. A lookup
+// thus touches one cache line instead of k lines spread over the bitset, and
+// since the bit of each word is derived independently, all words of the
+// block are probed at once with vector instructions.
+//
+// Stored on disk in the same Filter component as the classic layout, with
+// the layout recorded in the Scylla component.
+class split_block_bloom_filter : public bloom_filter {
+public:
+    static constexpr size_t words_per_block = 8;
+    static constexpr size_t bits_per_block = words_per_block * 64;
+
+private:
+    size_t _nr_blocks;
+
+public:
+    explicit split_block_bloom_filter(bitmap&& bs) noexcept;
+
+    virtual void add(const bytes_view& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void prefetch(hashed_key key) noexcept override;
+
+    virtual filter_layout layout() const noexcept override {
+        return filter_layout::split_block;
+    }
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -90,7 +124,11 @@ struct always_present_filter: public i_filter {
 // Get the size of the bitset (in bits, not bytes) for the specific parameters.
 size_t get_bitset_size(int64_t num_elements, int buckets_per);
 
-filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
+// Get the size of the bitset (in bits) of a split-block filter, rounded up to whole blocks.
+size_t get_split_block_bitset_size(int64_t num_elements, int bits_per_element);
+
+filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format, filter_layout layout = filter_layout::classic);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_split_block_filter(int64_t num_elements, int bits_per_element);
 }
 }
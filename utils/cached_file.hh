@@ -19,6 +19,8 @@
 #include "utils/cached_file_stats.hh"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
 using namespace seastar;
@@ -162,6 +164,24 @@ class cached_file {
 
     offset_type _last_page_size;
     page_idx_type _last_page;
+
+    // Misses of adjacent pages are coalesced into reads of up to this many pages.
+    static constexpr page_count_type max_coalesced_pages = 32;
+
+    // A read of pages [first, end) which is shared by all the misses which
+    // joined it before it was issued.
+    struct pending_read {
+        page_idx_type first;
+        page_idx_type end;
+        shared_promise<> done;
+        // Set when done is resolved. Keeps the pages alive until all the
+        // waiters had their share.
+        std::vector<cached_page::ptr_type> pages;
+
+        pending_read(page_idx_type first, page_idx_type end) : first(first), end(end) {}
+    };
+    // The read which wasn't issued yet, if any.
+    lw_shared_ptr<pending_read> _pending_read;
 public:
     using ptr_type = cached_page::ptr_type;
     struct page_read_result {
@@ -189,47 +209,93 @@ class cached_file {
         }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
         ++_metrics.page_misses;
-        size_t size = (idx + read_ahead) > _last_page
-                ? (_last_page_size + (_last_page - idx) * page_size)
-                : read_ahead * page_size;
+        page_idx_type end = std::min(idx + read_ahead, _last_page + 1);
 
         std::optional<reader_permit::resource_units> units;
         std::optional<reader_permit::awaits_guard> await_guard;
         if (permit) {
-            units = permit->consume_memory(size);
+            units = permit->consume_memory(range_size(idx, end));
             await_guard.emplace(*permit);
         }
 
-        return _file.dma_read_exactly<char>(idx * page_size, size)
-            .then([this, ag = std::move(await_guard), units = std::move(units), idx] (temporary_buffer<char>&& buf) mutable {
-                cached_page::ptr_type first_page;
-                while (buf.size()) {
-                    auto this_size = std::min(page_size, buf.size());
-                    // _cache.emplace() needs to run under allocating section even though it lives in the std space
-                    // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
-                    auto [cp, missed] = _as(_region, [&] {
-                        auto this_buf = buf.share();
-                        this_buf.trim(this_size);
-                        return _cache.emplace(idx, this, idx, std::move(this_buf));
-                    });
-                    buf.trim_front(this_size);
-                    ++idx;
-                    if (missed) {
-                        ++_metrics.page_populations;
-                        _metrics.cached_bytes += cp->size_in_allocator();
-                        _cached_bytes += cp->size_in_allocator();
-                    }
-                    // pages read ahead will be placed into LRU, as there's no guarantee they will be fetched later.
-                    cached_page::ptr_type ptr = cp->share();
-                    if (!first_page) {
-                        first_page = std::move(ptr);
-                    }
+        auto r = _pending_read;
+        future<> issued = make_ready_future<>();
+        if (r && idx <= r->end && end >= r->first
+                && std::max(end, r->end) - std::min(idx, r->first) <= max_coalesced_pages) {
+            tracing::trace(trace_state, "page cache miss coalesced: file={}, pages=[{}, {})", _file_name, r->first, r->end);
+            r->first = std::min(idx, r->first);
+            r->end = std::max(end, r->end);
+        } else {
+            r = make_lw_shared<pending_read>(idx, end);
+            auto issue = [this, r] {
+                if (_pending_read == r) {
+                    _pending_read = nullptr;
                 }
-                utils::get_local_injector().inject("cached_file_get_first_page", []() {
-                    throw std::bad_alloc();
+                return read_pages(*r);
+            };
+            if (need_preempt()) {
+                // We have to yield anyway, give the misses of adjacent pages
+                // issued until then the opportunity to join the read.
+                _pending_read = r;
+                issued = seastar::yield().then(std::move(issue));
+            } else {
+                issued = issue();
+            }
+        }
+        // The units and the await guard are held until the page is ready,
+        // also by the misses which joined a read issued by someone else.
+        return issued.then([r] {
+            return r->done.get_shared_future();
+        }).then([r, idx, ag = std::move(await_guard), units = std::move(units)] {
+            return page_read_result{r->pages[idx - r->first]->share(), false};
+        });
+    }
+
+    // Returns the number of bytes in pages [first, end).
+    size_t range_size(page_idx_type first, page_idx_type end) const {
+        return end > _last_page
+                ? (_last_page_size + (_last_page - first) * page_size)
+                : (end - first) * page_size;
+    }
+
+    // Reads pages [r.first, r.end) with one I/O and populates the cache.
+    // Never fails, the outcome is published in r.done.
+    future<> read_pages(pending_read& r) {
+        ++_metrics.page_reads;
+        _metrics.pages_read += r.end - r.first;
+        return futurize_invoke([&] {
+            return _file.dma_read_exactly<char>(r.first * page_size, range_size(r.first, r.end));
+        }).then([this, &r] (temporary_buffer<char>&& buf) {
+            auto idx = r.first;
+            r.pages.reserve(r.end - r.first);
+            while (buf.size()) {
+                auto this_size = std::min(page_size, buf.size());
+                // _cache.emplace() needs to run under allocating section even though it lives in the std space
+                // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
+                auto [cp, missed] = _as(_region, [&] {
+                    auto this_buf = buf.share();
+                    this_buf.trim(this_size);
+                    return _cache.emplace(idx, this, idx, std::move(this_buf));
                 });
-                return page_read_result{std::move(first_page), false};
+                buf.trim_front(this_size);
+                ++idx;
+                if (missed) {
+                    ++_metrics.page_populations;
+                    _metrics.cached_bytes += cp->size_in_allocator();
+                    _cached_bytes += cp->size_in_allocator();
+                }
+                // Pages read ahead will be placed into LRU once the read is
+                // released, as there's no guarantee they will be fetched later.
+                r.pages.emplace_back(cp->share());
+            }
+            utils::get_local_injector().inject("cached_file_get_first_page", []() {
+                throw std::bad_alloc();
             });
+            r.done.set_value();
+        }).handle_exception([&r] (std::exception_ptr ep) {
+            r.pages.clear();
+            r.done.set_exception(std::move(ep));
+        });
     }
     // Returns (page, true) if the page was cached, and (page, false) if the page was uncached.
     future<std::pair<temporary_buffer<char>, bool>> get_page(page_idx_type idx,
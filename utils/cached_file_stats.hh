@@ -17,4 +17,6 @@ struct cached_file_stats {
     uint64_t page_populations = 0;
     uint64_t cached_bytes = 0;
     uint64_t bytes_in_std = 0; // memory used by active temporary_buffer:s
+    uint64_t page_reads = 0; // physical reads, a read can cover many misses
+    uint64_t pages_read = 0;
 };
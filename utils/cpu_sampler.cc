@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <seastar/core/reactor.hh>
+
+#include "utils/cpu_sampler.hh"
+#include "utils/log.hh"
+
+namespace utils {
+
+static logging::logger cslogger("cpu_sampler");
+
+// The profiler keeps a small ring buffer of samples, drain it often enough
+// for it not to fill up at max_frequency.
+static constexpr auto drain_period = std::chrono::milliseconds(500);
+
+cpu_sampler::cpu_sampler()
+    : _drain_timer([this] { drain(); })
+{ }
+
+void cpu_sampler::start(unsigned frequency) {
+    if (frequency == 0 || frequency > max_frequency) {
+        throw std::invalid_argument(fmt::format("sampling frequency must be between 1 and {}, got {}", max_frequency, frequency));
+    }
+    _stacks.clear();
+    _nr_stacks = 0;
+    _stats = {};
+    engine().set_cpu_profiler_period(std::chrono::nanoseconds(std::chrono::seconds(1)) / frequency);
+    engine().set_cpu_profiler_enabled(true);
+    // Drop samples taken before this start.
+    _traces.clear();
+    engine().profiler_results(_traces);
+    _started = true;
+    _drain_timer.arm_periodic(drain_period);
+    cslogger.info("Started sampling at {} Hz", frequency);
+}
+
+void cpu_sampler::stop() {
+    if (!_started) {
+        return;
+    }
+    _drain_timer.cancel();
+    drain();
+    engine().set_cpu_profiler_enabled(false);
+    _started = false;
+    cslogger.info("Stopped sampling, {} samples taken, {} dropped", _stats.samples, _stats.dropped);
+}
+
+void cpu_sampler::drain() {
+    _traces.clear();
+    _stats.dropped += engine().profiler_results(_traces);
+    for (auto& trace : _traces) {
+        auto& stacks = _stacks[trace.sg];
+        auto it = stacks.find(trace.user_backtrace);
+        if (it == stacks.end()) {
+            if (_nr_stacks == max_stacks) {
+                ++_stats.dropped;
+                continue;
+            }
+            it = stacks.emplace(std::move(trace.user_backtrace), 0).first;
+            ++_nr_stacks;
+        }
+        ++it->second;
+        ++_stats.samples;
+    }
+    _traces.clear();
+}
+
+std::unordered_map<sstring, uint64_t> cpu_sampler::collapsed_stacks() {
+    if (_started) {
+        drain();
+    }
+    std::unordered_map<sstring, uint64_t> ret;
+    ret.reserve(_nr_stacks);
+    for (const auto& [sg, stacks] : _stacks) {
+        for (const auto& [backtrace, count] : stacks) {
+            fmt::memory_buffer stack;
+            fmt::format_to(std::back_inserter(stack), "{}", sg.name());
+            const auto& frames = backtrace.frames();
+            for (auto f = frames.rbegin(); f != frames.rend(); ++f) {
+                if (f->so->name.empty()) {
+                    fmt::format_to(std::back_inserter(stack), ";0x{:x}", f->addr);
+                } else {
+                    fmt::format_to(std::back_inserter(stack), ";{}+0x{:x}", f->so->name, f->addr);
+                }
+            }
+            // Different backtraces may format the same, e.g. if they differ
+            // only in the shared objects of the frames.
+            ret[sstring(stack.data(), stack.size())] += count;
+        }
+    }
+    return ret;
+}
+
+cpu_sampler& get_local_cpu_sampler() {
+    // Constructed on first use, and so destroyed before the reactor,
+    // which the drain timer needs.
+    static thread_local cpu_sampler local_cpu_sampler;
+    return local_cpu_sampler;
+}
+
+} // namespace utils
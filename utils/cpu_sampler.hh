@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <seastar/core/internal/cpu_profiler.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/backtrace.hh>
+
+#include "seastarx.hh"
+
+namespace utils {
+
+// On-demand sampling of the stacks the shard is running, based on the
+// Seastar CPU profiler, for profiling under real load without attaching
+// perf to the process.
+//
+// While started, the profiler samples the running stack at the requested
+// frequency. The samples are moved out of the profiler's small ring buffer
+// periodically and aggregated by scheduling group and stack, so memory use
+// depends on the number of distinct stacks, which is capped, not on the
+// duration of the sampling.
+class cpu_sampler {
+public:
+    // Above this, the overhead of sampling stops being negligible.
+    static constexpr unsigned max_frequency = 100;
+    // Samples of stacks beyond this many are counted as dropped.
+    static constexpr size_t max_stacks = 100000;
+
+    struct stats {
+        uint64_t samples = 0;
+        // Samples lost because the profiler's buffer filled up
+        // before it was drained, or because of max_stacks.
+        uint64_t dropped = 0;
+    };
+
+private:
+    std::unordered_map<scheduling_group, std::unordered_map<simple_backtrace, uint64_t>> _stacks;
+    size_t _nr_stacks = 0;
+    stats _stats;
+    bool _started = false;
+    std::vector<cpu_profiler_trace> _traces;
+    timer<lowres_clock> _drain_timer;
+
+    void drain();
+public:
+    cpu_sampler();
+
+    // Starts sampling at `frequency` samples per second, discarding the
+    // samples aggregated so far. Throws std::invalid_argument if the
+    // frequency is 0 or above max_frequency.
+    void start(unsigned frequency);
+    void stop();
+    bool started() const noexcept {
+        return _started;
+    }
+    stats get_stats() const noexcept {
+        return _stats;
+    }
+
+    // Returns the number of samples of every stack sampled so far, with the
+    // stacks in the collapsed format of flamegraph.pl: the scheduling group
+    // and the frames from the outermost one, separated by semicolons. The
+    // frames are addresses, as in backtraces Seastar logs, for resolving
+    // with seastar-addr2line.
+    std::unordered_map<sstring, uint64_t> collapsed_stacks();
+};
+
+cpu_sampler& get_local_cpu_sampler();
+
+} // namespace utils
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <seastar/net/byteorder.hh>
 #include <seastar/core/byteorder.hh>
@@ -44,6 +45,10 @@ namespace utils {
 class crc32 {
     uint32_t _r = 0;
 public:
+    crc32() = default;
+    // Continues a checksum previously returned by get().
+    explicit crc32(uint32_t prev) : _r(prev) {}
+
     // All process() functions assume input is in
     // host byte order (i.e. equivalent to storing
     // the value in a buffer and crcing the buffer).
@@ -161,4 +166,54 @@ class crc32 {
     }
 };
 
+namespace detail {
+
+// Multiplies a by b modulo the CRC32C polynomial. Both are in the
+// bit-reflected representation used by the crc32 instruction, in which
+// bit 31 is the coefficient of x^0. a must not be zero.
+constexpr uint32_t crc32c_multmodp(uint32_t a, uint32_t b) {
+    constexpr uint32_t poly = 0x82f63b78;
+    uint32_t m = uint32_t(1) << 31;
+    uint32_t p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = b & 1 ? (b >> 1) ^ poly : b >> 1;
+    }
+    return p;
+}
+
+// x^(2^k) modulo the CRC32C polynomial.
+constexpr auto crc32c_x2n_table = [] {
+    std::array<uint32_t, 67> t;
+    t[0] = uint32_t(1) << 30;
+    for (size_t k = 1; k < t.size(); ++k) {
+        t[k] = crc32c_multmodp(t[k - 1], t[k - 1]);
+    }
+    return t;
+}();
+
+}
+
+// Computes crc32 (above) of the concatenation of A and B, given the
+// crc32 of A, the crc32 of B and the length of B in bytes.
+//
+// The cost is logarithmic in len2, but feeding the data to crc32::process()
+// is still faster up to a few KiB.
+constexpr uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    // x^(8 * len2)
+    uint32_t shift = uint32_t(1) << 31;
+    for (unsigned k = 3; len2; len2 >>= 1, ++k) {
+        if (len2 & 1) {
+            shift = detail::crc32c_multmodp(detail::crc32c_x2n_table[k], shift);
+        }
+    }
+    return detail::crc32c_multmodp(shift, crc1) ^ crc2;
+}
+
 }
@@ -15,6 +15,7 @@ namespace query {
 enum class digest_algorithm : uint8_t {
     none = 0,  // digest not required
     xxHash = 3, // default algorithm
+    xxh3 = 4, // default once all nodes support it (the XXH3_DIGEST feature)
 };
 
 }
@@ -23,7 +23,7 @@ struct noop_hasher {
 };
 
 class digester final {
-    std::variant<noop_hasher, xx_hasher> _impl;
+    std::variant<noop_hasher, xx_hasher, xxh3_hasher> _impl;
 
 public:
     explicit digester(digest_algorithm algo) {
@@ -31,6 +31,9 @@ class digester final {
         case digest_algorithm::xxHash:
             _impl = xx_hasher();
             break;
+        case digest_algorithm::xxh3:
+            _impl = xxh3_hasher();
+            break;
         case digest_algorithm ::none:
             _impl = noop_hasher();
             break;
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+/*
+ An approximate, aging frequency counter, as used by the TinyLFU cache
+ admission policy [1].
+
+ The sketch is a count-min sketch with 4-bit counters: each item is mapped
+ to one counter in each of `depth` rows, and its frequency is estimated as
+ the minimum of them. Counters saturate at 15. After `sample_size` additions
+ all counters are halved, so that the sketch tracks recent popularity only
+ and items that used to be popular fade away.
+
+ [1] Einziger, G., Friedman, R., & Manes, B. (2017).
+     TinyLFU: A Highly Efficient Cache Admission Policy.
+     ACM Transactions on Storage, 13(4).
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+class frequency_sketch {
+    static constexpr unsigned depth = 4;
+    static constexpr unsigned counters_per_word = 16;
+    static constexpr uint64_t max_count = 15;
+
+    std::vector<uint64_t> _table;
+    size_t _counter_mask;
+    size_t _sample_size;
+    size_t _additions = 0;
+private:
+    static uint64_t mix(uint64_t h, unsigned row) noexcept {
+        // splitmix64 finalizer, seeded differently for each row
+        h += 0x9e3779b97f4a7c15 * (row + 1);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+        return h ^ (h >> 31);
+    }
+
+    size_t counter_index(uint64_t hash, unsigned row) const noexcept {
+        return mix(hash, row) & _counter_mask;
+    }
+
+    uint64_t get(size_t idx) const noexcept {
+        return (_table[idx / counters_per_word] >> ((idx % counters_per_word) * 4)) & max_count;
+    }
+
+    void increment_counter(size_t idx) noexcept {
+        _table[idx / counters_per_word] += uint64_t(1) << ((idx % counters_per_word) * 4);
+    }
+
+    void age() noexcept {
+        for (auto& w : _table) {
+            w = (w >> 1) & 0x7777777777777777;
+        }
+        _additions /= 2;
+    }
+public:
+    // Sized to track about expected_items distinct items with a low error.
+    explicit frequency_sketch(size_t expected_items)
+        : _table(std::bit_ceil(std::max<size_t>(expected_items / 4, 1)))
+        , _counter_mask(_table.size() * counters_per_word - 1)
+        , _sample_size(std::max<size_t>(expected_items, 1) * 10)
+    { }
+
+    // Returns the estimated number of recent occurrences of the item with the given hash.
+    unsigned estimate(uint64_t hash) const noexcept {
+        uint64_t freq = max_count;
+        for (unsigned row = 0; row < depth; ++row) {
+            freq = std::min(freq, get(counter_index(hash, row)));
+        }
+        return freq;
+    }
+
+    // Records an occurrence of the item with the given hash.
+    // Uses conservative update: only the smallest counters of the item are
+    // incremented, which reduces over-estimation caused by collisions.
+    void increment(uint64_t hash) noexcept {
+        size_t idx[depth];
+        uint64_t freq = max_count;
+        for (unsigned row = 0; row < depth; ++row) {
+            idx[row] = counter_index(hash, row);
+            freq = std::min(freq, get(idx[row]));
+        }
+        if (freq == max_count) {
+            return;
+        }
+        for (unsigned row = 0; row < depth; ++row) {
+            if (get(idx[row]) == freq) {
+                increment_counter(idx[row]);
+            }
+        }
+        if (++_additions >= _sample_size) {
+            age();
+        }
+    }
+
+    size_t memory_usage() const noexcept {
+        return _table.size() * sizeof(uint64_t);
+    }
+};
+
+}
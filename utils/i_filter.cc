@@ -17,7 +17,7 @@
 namespace utils {
 static logging::logger filterlog("bloom_filter");
 
-filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat) {
+filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat, filter_layout layout) {
     SCYLLA_ASSERT(seastar::thread::running_in_thread());
 
     if (max_false_pos_probability > 1.0) {
@@ -28,22 +28,62 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
         return std::make_unique<filter::always_present_filter>();
     }
 
+    if (layout == filter_layout::split_block) {
+        auto bits_per_element = bloom_calculations::split_block_bits_per_element(max_false_pos_probability);
+        return filter::create_split_block_filter(num_elements, bits_per_element);
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
-size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability) {
+size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability, filter_layout layout) {
     if (max_false_pos_probability >= 1.0) {
         return 0;
     }
 
+    if (layout == filter_layout::split_block) {
+        auto bits_per_element = bloom_calculations::split_block_bits_per_element(max_false_pos_probability);
+        return filter::get_split_block_bitset_size(num_elements, bits_per_element) / 8;
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
 
     return filter::get_bitset_size(num_elements, spec.buckets_per_element) / 8;
 }
 
+std::string_view to_string(filter_layout layout) {
+    switch (layout) {
+    case filter_layout::classic: return "classic";
+    case filter_layout::split_block: return "split_block";
+    }
+    std::abort();
+}
+
+filter_layout filter_layout_from_string(std::string_view s) {
+    if (s == "classic") {
+        return filter_layout::classic;
+    }
+    if (s == "split_block") {
+        return filter_layout::split_block;
+    }
+    throw std::invalid_argument(format("Invalid bloom filter layout '{}': must be one of 'classic', 'split_block'", s));
+}
+
+uint64_t is_present_batch(std::span<i_filter* const> filters, hashed_key key) {
+    SCYLLA_ASSERT(filters.size() <= 64);
+    for (auto* f : filters) {
+        f->prefetch(key);
+    }
+    uint64_t present = 0;
+    for (size_t i = 0; i < filters.size(); ++i) {
+        present |= uint64_t(filters[i]->is_present(key)) << i;
+    }
+    return present;
+}
+
 hashed_key make_hashed_key(bytes_view b) {
     std::array<uint64_t, 2> h;
     utils::murmur_hash::hash3_x64_128(b, 0, h);
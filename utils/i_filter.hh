@@ -10,6 +10,8 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <string_view>
 #include "bytes_fwd.hh"
 
 namespace utils {
@@ -22,6 +24,18 @@ enum class filter_format {
     m_format,
 };
 
+// How the bits of a key are laid out in the filter.
+// Recorded in the Scylla component, so never reuse or renumber a value.
+enum class filter_layout : uint32_t {
+    // k bits spread over the whole bitset (Cassandra compatible).
+    classic = 0,
+    // All bits of a key live in a single 64-byte block.
+    split_block = 1,
+};
+
+std::string_view to_string(filter_layout);
+filter_layout filter_layout_from_string(std::string_view);
+
 class hashed_key {
 private:
     std::array<uint64_t, 2> _hash;
@@ -32,6 +46,12 @@ class hashed_key {
 
 hashed_key make_hashed_key(bytes_view key);
 
+// Probes key in up to 64 filters at once. The probed memory of all filters is
+// prefetched before any of them is tested, so that cache misses on different
+// filters overlap rather than being taken one after another.
+// Bit i of the result is set iff filters[i] may contain the key.
+uint64_t is_present_batch(std::span<i_filter* const> filters, hashed_key key);
+
 // FIXME: serialize() and serialized_size() not implemented. We should only be serializing to
 // disk, not in the wire.
 struct i_filter {
@@ -40,11 +60,18 @@ struct i_filter {
     virtual void add(const bytes_view& key) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
+    // Starts loading the memory is_present(key) will touch first,
+    // without waiting for it.
+    virtual void prefetch(hashed_key) noexcept { }
     virtual void clear() = 0;
     virtual void close() = 0;
 
     virtual size_t memory_size() = 0;
 
+    virtual filter_layout layout() const noexcept {
+        return filter_layout::classic;
+    }
+
     /**
      * @return The smallest bloom_filter that can provide the given false
      *         positive probability rate for the given number of elements.
@@ -52,11 +79,13 @@ struct i_filter {
      *         Asserts that the given probability can be satisfied using this
      *         filter.
      */
-    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format,
+            filter_layout layout = filter_layout::classic);
 
     /**
      * @return the size of the smallest filter (in bytes), according to the conditions described at get_filter()
      */
-    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob);
+    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob,
+            filter_layout layout = filter_layout::classic);
 };
 }
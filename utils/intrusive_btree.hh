@@ -827,6 +827,22 @@ class tree {
                 return nullptr;
             }
         }
+
+        /*
+         * Returns pointer on the owning tree, walking up to the root.
+         */
+        tree_ptr owning_tree() noexcept {
+            node_base* n = revalidate();
+
+            if (n->is_inline()) {
+                return tree::from_inline(n);
+            }
+            node_ptr nd = node::from_base(n);
+            while (!nd->_base.is_root()) {
+                nd = nd->_parent.n;
+            }
+            return nd->_parent.t;
+        }
     };
 
     using iterator_base_const = iterator_base<true, const_iterator>;
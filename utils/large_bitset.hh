@@ -47,6 +47,9 @@ class large_bitset {
         auto idx2 = idx;
         _storage[idx1] |= int_type(1) << idx2;
     }
+    void prefetch(size_t idx) const noexcept {
+        __builtin_prefetch(&_storage[idx / bits_per_int()]);
+    }
     void clear(size_t idx) {
         auto idx1 = idx / bits_per_int();
         idx %= bits_per_int();
@@ -55,6 +58,16 @@ class large_bitset {
     }
     void clear();
 
+    // Direct access to the underlying words, for filters which choose their
+    // own bit placement. Storage is fragmented, but any naturally aligned
+    // group of (up to) max_chunk_capacity() words is contiguous.
+    int_type* word_ptr(size_t word_idx) {
+        return &_storage[word_idx];
+    }
+    const int_type* word_ptr(size_t word_idx) const {
+        return &_storage[word_idx];
+    }
+
     const utils::chunked_vector<int_type>& get_storage() const {
         return _storage;
     }
@@ -12,6 +12,9 @@
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
+#include <algorithm>
+#include <cstring>
+#include <optional>
 #include <string>
 
 namespace {
@@ -75,33 +78,99 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// A pattern with no wildcards other than '%' at its ends, like 'abc', 'abc%', '%abc' or '%abc%'.
+///
+/// Such patterns are matched on the bytes of the text, without the regex: UTF-8 is self-synchronizing, so a
+/// sequence of whole characters is found in the text exactly where its bytes are.
+struct literal_pattern {
+    bytes literal;
+    bool leading_wildcard = false;
+    bool trailing_wildcard = false;
+
+    bool operator()(bytes_view text) const {
+        if (!leading_wildcard) {
+            return trailing_wildcard ? text.starts_with(bytes_view(literal)) : text == bytes_view(literal);
+        }
+        if (!trailing_wildcard) {
+            return text.ends_with(bytes_view(literal));
+        }
+        if (literal.empty()) {
+            return true;
+        }
+        return ::memmem(text.data(), text.size(), literal.data(), literal.size()) != nullptr;
+    }
+};
+
+std::optional<literal_pattern> parse_literal_pattern(bytes_view pattern) {
+    literal_pattern p{.literal = bytes(bytes::initialized_later(), pattern.size() + 1)};
+    size_t literal_size = 0;
+    auto is_wildcard = [] (int8_t c) { return c == '%'; };
+    auto it = std::ranges::find_if_not(pattern, is_wildcard);
+    p.leading_wildcard = it != pattern.begin();
+    bool escaping = false;
+    for (; it != pattern.end(); ++it) {
+        if (escaping) {
+            p.literal[literal_size++] = *it;
+            escaping = false;
+        } else if (*it == '\\') {
+            escaping = true;
+        } else if (*it == '_') {
+            return std::nullopt;
+        } else if (*it == '%') {
+            if (!std::all_of(it, pattern.end(), is_wildcard)) {
+                return std::nullopt;
+            }
+            p.trailing_wildcard = true;
+            break;
+        } else {
+            p.literal[literal_size++] = *it;
+        }
+    }
+    if (escaping) {
+        // An unescaped backslash ending the pattern matches itself.
+        p.literal[literal_size++] = '\\';
+    }
+    p.literal.resize(literal_size);
+    return p;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    std::optional<literal_pattern> _literal; // Matches the pattern when it has no wildcards inside.
+    boost::u32regex _re; // Performs pattern matching otherwise.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+    void init(bytes_view pattern) {
+        auto literal = parse_literal_pattern(pattern);
+        auto re = literal ? boost::u32regex()
+                : boost::make_u32regex(regex_from_pattern(pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        _literal = std::move(literal);
+        _re = std::move(re);
     }
 };
 
 like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
+    init(_pattern);
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
+    if (_literal) {
+        return (*_literal)(text);
+    }
     return boost::u32regex_match(text.begin(), text.end(), _re);
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
     if (pattern != _pattern) {
-        _pattern = bytes(pattern);
-        init_re();
+        // Keep matching the old pattern if the new one fails to compile.
+        bytes new_pattern(pattern);
+        init(new_pattern);
+        _pattern = std::move(new_pattern);
     }
 }
 
@@ -120,3 +189,22 @@ bool like_matcher::operator()(bytes_view text) const {
 void like_matcher::reset(bytes_view pattern) {
     return _impl->reset(pattern);
 }
+
+bytes like_matcher::literal_prefix(bytes_view pattern) {
+    bytes prefix(bytes::initialized_later(), pattern.size());
+    size_t prefix_size = 0;
+    bool escaping = false;
+    for (auto c : pattern) {
+        if (escaping) {
+            escaping = false;
+        } else if (c == '\\') {
+            escaping = true;
+            continue;
+        } else if (c == '_' || c == '%') {
+            break;
+        }
+        prefix[prefix_size++] = c;
+    }
+    prefix.resize(prefix_size);
+    return prefix;
+}
@@ -41,4 +41,8 @@ class like_matcher {
 
     /// Resets pattern if different from the current one.
     void reset(bytes_view pattern);
+
+    /// Returns the characters every text matching \c pattern starts with, that is
+    /// the pattern up to its first wildcard, unescaped.
+    static bytes literal_prefix(bytes_view pattern);
 };
@@ -11,6 +11,7 @@
 #include <boost/intrusive/slist.hpp>
 #include <stack>
 #include <ranges>
+#include <bit>
 
 #include <seastar/core/memory.hh>
 #include <seastar/core/align.hh>
@@ -24,6 +25,7 @@
 #include <seastar/util/alloc_failure_injector.hh>
 #include <seastar/util/backtrace.hh>
 #include <seastar/util/later.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/core/on_internal_error.hh>
 
 #include "utils/assert.hh"
@@ -35,6 +37,7 @@
 #include "utils/vle.hh"
 #include "utils/coarse_steady_clock.hh"
 #include "utils/labels.hh"
+#include "utils/histogram_metrics_helper.hh"
 
 #include <random>
 #include <chrono>
@@ -482,6 +485,13 @@ class tracker::impl {
     bool _abort_on_bad_alloc = false;
     bool _sanitizer_report_backtrace = false;
     reclaim_timer* _active_timer = nullptr;
+    // Preemptible reclaim yields after this much time even if the reactor
+    // has nothing else to run, so that a single round of background reclaim
+    // frees a bounded amount of memory. Zero disables the limit.
+    std::chrono::microseconds _reclaim_time_slice{0};
+    std::optional<std::chrono::steady_clock::time_point> _reclaim_deadline;
+    utils::time_estimated_histogram _sync_reclaim_latency;
+    utils::time_estimated_histogram _background_reclaim_latency;
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
     // invoked synchronously with allocator. This guard ensures that this
@@ -549,6 +559,15 @@ class tracker::impl {
     // const bool&, so interested parties can save a reference and see updates.
     const bool& sanitizer_report_backtrace() const { return _sanitizer_report_backtrace; }
     void set_sanitizer_report_backtrace(bool rb) { _sanitizer_report_backtrace = rb; }
+    void set_reclaim_time_slice(std::chrono::microseconds slice) noexcept { _reclaim_time_slice = slice; }
+    // Tells whether preemptible reclaim should stop, because the reactor has
+    // other work or because the reclaim used up its time slice.
+    bool should_preempt_reclaim() const noexcept {
+        return need_preempt() || (_reclaim_deadline && std::chrono::steady_clock::now() >= *_reclaim_deadline);
+    }
+    void record_reclaim_latency(is_preemptible preempt, std::chrono::steady_clock::duration d) noexcept {
+        (preempt ? _background_reclaim_latency : _sync_reclaim_latency).add(d);
+    }
     bool try_set_active_timer(reclaim_timer& timer) {
         if (_active_timer) {
             return false;
@@ -745,13 +764,15 @@ class segment_store_backend {
     virtual void* alloc_segment_memory() noexcept = 0;
     virtual void free_segment_memory(void* seg) noexcept = 0;
     virtual size_t free_memory() const noexcept = 0;
-    bool can_allocate_more_segments(size_t non_lsa_reserve) const noexcept {
+    virtual bool can_allocate_more_segments(size_t non_lsa_reserve) const noexcept {
         if (_freed_segment_increases_general_memory_availability) {
             return free_memory() >= non_lsa_reserve + segment::size;
         } else {
             return free_memory() >= segment::size;
         }
     }
+    // Memory held by the store which isn't in any segment.
+    virtual size_t unused_memory() const noexcept { return 0; }
 };
 
 // Segments are allocated from the seastar allocator.
@@ -833,6 +854,91 @@ class standard_memory_segment_store_backend : public segment_store_backend {
     }
 };
 
+// Segments are allocated from the seastar allocator, in hugepage-sized and aligned arenas.
+// Segments allocated one by one share hugepages, and so TLB entries, with other objects,
+// while segments allocated from arenas keep LSA memory on hugepages of its own. Like shard
+// memory in general, the arenas are local to the NUMA node of the shard.
+//
+// An arena is returned to the seastar allocator only once all of its segments are freed.
+// The reclaimer frees segments from the bottom of the address space, so it empties arenas
+// one after another, and allocation prefers the arenas at the top.
+class hugepage_arena_segment_store_backend : public segment_store_backend {
+    static constexpr size_t arena_size = 2 << 20;
+    static constexpr size_t segments_per_arena = arena_size / segment_size;
+    using slot_mask = uint16_t;
+    static_assert(segments_per_arena <= std::numeric_limits<slot_mask>::digits);
+    static constexpr slot_mask all_slots = slot_mask((1u << segments_per_arena) - 1);
+
+    uintptr_t _arenas_base;
+    // Free segments of each arena.
+    std::vector<slot_mask> _free_slots;
+    // Arenas with free segments.
+    utils::dynamic_bitset _partial_arenas;
+    size_t _free_arena_segments = 0;
+private:
+    size_t arena_idx(uintptr_t p) const noexcept {
+        return (p - _arenas_base) / arena_size;
+    }
+    uintptr_t arena_addr(size_t idx) const noexcept {
+        return _arenas_base + idx * arena_size;
+    }
+public:
+    // Freeing a segment returns memory to the seastar allocator only if it
+    // empties its arena, so it doesn't increase the availability of non-lsa
+    // memory in general.
+    hugepage_arena_segment_store_backend()
+        : segment_store_backend(memory::get_memory_layout(), false)
+        , _arenas_base(align_down(_layout.start, static_cast<uintptr_t>(arena_size)))
+        , _free_slots((_layout.end - _arenas_base) / arena_size + 1, 0)
+        , _partial_arenas(_free_slots.size())
+    { }
+    virtual void* alloc_segment_memory() noexcept override {
+        auto idx = _partial_arenas.find_last_set();
+        if (idx == utils::dynamic_bitset::npos) {
+            auto p = aligned_alloc(arena_size, arena_size);
+            if (!p) {
+                return nullptr;
+            }
+            // Has no effect when the memory is backed by hugetlbfs already.
+            madvise(p, arena_size, MADV_HUGEPAGE);
+            idx = arena_idx(reinterpret_cast<uintptr_t>(p));
+            _free_slots[idx] = all_slots;
+            _partial_arenas.set(idx);
+            _free_arena_segments += segments_per_arena;
+        }
+        // Fill arenas from the top, like the segment pool does.
+        auto slot = std::numeric_limits<slot_mask>::digits - 1 - std::countl_zero(_free_slots[idx]);
+        _free_slots[idx] &= ~slot_mask(1u << slot);
+        --_free_arena_segments;
+        if (!_free_slots[idx]) {
+            _partial_arenas.clear(idx);
+        }
+        return reinterpret_cast<void*>(arena_addr(idx) + slot * segment_size);
+    }
+    virtual void free_segment_memory(void* seg) noexcept override {
+        auto p = reinterpret_cast<uintptr_t>(seg);
+        auto idx = arena_idx(p);
+        _free_slots[idx] |= slot_mask(1u << ((p - arena_addr(idx)) / segment_size));
+        ++_free_arena_segments;
+        _partial_arenas.set(idx);
+        if (_free_slots[idx] == all_slots) {
+            _free_slots[idx] = 0;
+            _partial_arenas.clear(idx);
+            _free_arena_segments -= segments_per_arena;
+            ::free(reinterpret_cast<void*>(arena_addr(idx)));
+        }
+    }
+    virtual size_t free_memory() const noexcept override {
+        return memory::free_memory();
+    }
+    virtual bool can_allocate_more_segments(size_t non_lsa_reserve) const noexcept override {
+        return _free_arena_segments || free_memory() >= non_lsa_reserve + arena_size;
+    }
+    virtual size_t unused_memory() const noexcept override {
+        return _free_arena_segments * segment_size;
+    }
+};
+
 static constexpr size_t segment_npos = size_t(-1);
 
 // Segments are allocated from a large contiguous memory area.
@@ -852,6 +958,13 @@ class contiguous_memory_segment_store {
         _backend = std::make_unique<standard_memory_segment_store_backend>(available_memory / segment::size);
         llogger.debug("using the standard allocator segment pool backend with {} available memory", available_memory);
     }
+    void use_hugepage_arena_backend() {
+        _backend = std::make_unique<hugepage_arena_segment_store_backend>();
+        llogger.debug("using the hugepage arena segment pool backend");
+    }
+    size_t unused_memory() const noexcept {
+        return _backend->unused_memory();
+    }
     const segment* segment_from_idx(size_t idx) const noexcept {
         return reinterpret_cast<segment*>(_backend->segments_base()) + idx;
     }
@@ -919,6 +1032,15 @@ class segment_store {
         _segment_indexes = {};
         llogger.debug("using the standard allocator segment pool backend with {} available memory", available_memory);
     }
+    void use_hugepage_arena_backend() {
+        llogger.info("hugepage arenas are not supported by the default allocator, ignoring");
+    }
+    size_t unused_memory() const noexcept {
+        if (_delegate_store) {
+            return _delegate_store->unused_memory();
+        }
+        return 0;
+    }
     const segment* segment_from_idx(size_t idx) const noexcept {
         if (_delegate_store) {
             return _delegate_store->segment_from_idx(idx);
@@ -1071,6 +1193,16 @@ class segment_pool {
     logalloc::tracker::impl& tracker() { return _tracker; }
     void prime(size_t available_memory, size_t min_free_memory);
     void use_standard_allocator_segment_pool_backend(size_t available_memory);
+    void use_hugepage_arena_backend();
+    // Number of hugepages holding LSA segments, and the memory of the segment
+    // store which is neither used by LSA nor available to the rest of the shard.
+    size_t hugepages_in_use() const noexcept;
+    size_t unused_memory() const noexcept {
+        return _store.unused_memory();
+    }
+    size_t owned_segments() const noexcept {
+        return _segments_in_use + _free_segments;
+    }
     segment* new_segment(region::impl* r);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
         uintptr_t index = idx_from_segment(seg);
@@ -1178,6 +1310,8 @@ struct reclaim_timer {
     size_t _memory_released = 0;
 
     clock::time_point _start;
+    // The coarse clock is too coarse for the latency histograms.
+    std::chrono::steady_clock::time_point _precise_start;
     stats _start_stats, _end_stats, _stat_diff;
 
     clock::duration _duration;
@@ -1271,7 +1405,7 @@ size_t segment_pool::reclaim_segments(size_t target, is_preemptible preempt) {
         _store.free_segment(src);
         ++reclaimed_segments;
         --_free_segments;
-        if (preempt && need_preempt()) {
+        if (preempt && _tracker.should_preempt_reclaim()) {
             break;
         }
     }
@@ -1438,6 +1572,28 @@ void segment_pool::use_standard_allocator_segment_pool_backend(size_t available_
     _lsa_free_segments_bitmap = utils::dynamic_bitset(max_segments());
 }
 
+void segment_pool::use_hugepage_arena_backend() {
+    if (_lsa_owned_segments_bitmap.find_first_set() != utils::dynamic_bitset::npos) {
+        throw std::runtime_error("cannot change segment store backend after segments are allocated");
+    }
+    _store.use_hugepage_arena_backend();
+}
+
+size_t segment_pool::hugepages_in_use() const noexcept {
+    static constexpr size_t hugepage_size = 2 << 20;
+    size_t hugepages = 0;
+    uintptr_t last_hugepage = 0;
+    for (auto idx = _lsa_owned_segments_bitmap.find_first_set(); idx != utils::dynamic_bitset::npos;
+            idx = _lsa_owned_segments_bitmap.find_next_set(idx)) {
+        auto hugepage = align_down(reinterpret_cast<uintptr_t>(segment_from_idx(idx)), uintptr_t(hugepage_size));
+        if (!hugepages || hugepage != last_hugepage) {
+            ++hugepages;
+            last_hugepage = hugepage;
+        }
+    }
+    return hugepages;
+}
+
 inline void segment_pool::on_segment_compaction(size_t used_size) noexcept {
     _stats.segments_compacted++;
     _stats.memory_compacted += used_size;
@@ -1513,6 +1669,7 @@ reclaim_timer::reclaim_timer(const char* name, is_preemptible preemptible, size_
     }
 
     _start = clock::now();
+    _precise_start = std::chrono::steady_clock::now();
     sample_stats(_start_stats);
 }
 
@@ -1522,6 +1679,7 @@ reclaim_timer::~reclaim_timer() {
     }
 
     _duration = clock::now() - _start;
+    _tracker.record_reclaim_latency(_preemptible, std::chrono::steady_clock::now() - _precise_start);
     _stall_detected = _duration >= _duration_threshold;
     if (_debug_enabled || _stall_detected) {
         sample_stats(_end_stats);
@@ -2375,6 +2533,7 @@ void tracker::configure(const config& cfg) {
     }
     _impl->setup_background_reclaim(cfg.background_reclaim_sched_group);
     _impl->set_sanitizer_report_backtrace(cfg.sanitizer_report_backtrace);
+    _impl->set_reclaim_time_slice(cfg.reclaim_time_slice);
 }
 
 memory::reclaiming_result tracker::reclaim(seastar::memory::reclaimer::request r) {
@@ -2573,7 +2732,7 @@ static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, is
                 llogger.debug("Target met after evicting {} bytes", used - r.occupancy().used_space());
                 return;
             }
-            if (preempt && need_preempt()) {
+            if (preempt && r.segment_pool().tracker().should_preempt_reclaim()) {
                 llogger.debug("reclaim_from_evictable preempted");
                 return;
             }
@@ -2587,7 +2746,7 @@ static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, is
         // If the system is overwhelmed, and reclaim_from_evictable keeps getting
         // preempted without doing any useful work, then eventually memory will be
         // exhausted and reclaim will be called synchronously, without preemption.
-        if (preempt && need_preempt()) {
+        if (preempt && r.segment_pool().tracker().should_preempt_reclaim()) {
             llogger.debug("reclaim_from_evictable preempted");
             return;
         }
@@ -2635,6 +2794,11 @@ size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt)
         return 0;
     }
     reclaiming_lock rl(*this);
+    auto prev_deadline = _reclaim_deadline;
+    if (preempt && _reclaim_time_slice.count() && !_reclaim_deadline) {
+        _reclaim_deadline = std::chrono::steady_clock::now() + _reclaim_time_slice;
+    }
+    auto restore_deadline = defer([&] () noexcept { _reclaim_deadline = prev_deadline; });
     reclaim_timer timing_guard("reclaim", preempt, memory_to_release, 0, *this);
     return timing_guard.set_memory_released(reclaim_locked(memory_to_release, preempt));
 }
@@ -2652,7 +2816,7 @@ size_t tracker::impl::reclaim_locked(size_t memory_to_release, is_preemptible pr
         llogger.debug("reclaim_locked() = {}", memory_to_release);
         return memory_to_release;
     }
-    if (preempt && need_preempt()) {
+    if (preempt && should_preempt_reclaim()) {
         llogger.debug("reclaim_locked() = {}", mem_released);
         return mem_released;
     }
@@ -2759,7 +2923,7 @@ size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t m
 
             std::ranges::push_heap(_regions, cmp);
 
-            if (preempt && need_preempt()) {
+            if (preempt && should_preempt_reclaim()) {
                 break;
             }
         }
@@ -2775,7 +2939,7 @@ size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t m
         llogger.debug("Considering evictable regions.");
         // FIXME: Fair eviction
         for (region::impl* r : _regions) {
-            if (preempt && need_preempt()) {
+            if (preempt && should_preempt_reclaim()) {
                 break;
             }
             ++regions;
@@ -2822,6 +2986,7 @@ void tracker::impl::unregister_region(region::impl* r) noexcept {
 
 tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*this)) {
     namespace sm = seastar::metrics;
+    auto kind_label = sm::label("kind");
 
     _metrics.add_group("lsa", {
         sm::make_gauge("total_space_bytes", [this] { return region_occupancy().total_space(); },
@@ -2839,6 +3004,15 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
         sm::make_gauge("occupancy", [this] { return region_occupancy().used_fraction() * 100; },
                        sm::description("Holds a current portion (in percents) of the used memory.")),
 
+        sm::make_gauge("segments_per_hugepage", [this] {
+                            auto hugepages = _segment_pool->hugepages_in_use();
+                            return hugepages ? double(_segment_pool->owned_segments()) / hugepages : 0.0;
+                        },
+                       sm::description("Holds the mean number of LSA segments on the 2 MB pages holding LSA segments, the higher the fewer TLB entries LSA memory needs.")),
+
+        sm::make_gauge("hugepage_arena_unused_bytes", [this] { return _segment_pool->unused_memory(); },
+                       sm::description("Holds the memory of the hugepage arenas of the segment pool which isn't in any LSA segment, and not available to the rest of the shard either.")),
+
         sm::make_counter("segments_compacted", [this] { return _segment_pool->statistics().segments_compacted; },
                         sm::description("Counts a number of compacted segments.")),
 
@@ -2853,6 +3027,12 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
 
         sm::make_counter("memory_freed", [this] { return _segment_pool->statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_histogram("reclaim_latency", sm::description("Holds the latency (in microseconds) of LSA memory reclaim, invoked synchronously by allocations or done by the background reclaimer."),
+                        [this] { return to_metrics_histogram(_sync_reclaim_latency); })(kind_label("sync")).set_skip_when_empty(),
+
+        sm::make_histogram("reclaim_latency", sm::description("Holds the latency (in microseconds) of LSA memory reclaim, invoked synchronously by allocations or done by the background reclaimer."),
+                        [this] { return to_metrics_histogram(_background_reclaim_latency); })(kind_label("background")).set_skip_when_empty(),
     });
 }
 
@@ -2947,10 +3127,10 @@ void allocating_section::reserve(tracker::impl& tracker) {
 void allocating_section::on_alloc_failure(logalloc::region& r) {
     r.allocator().invalidate_references();
     if (r.get_tracker().get_impl().segment_pool().allocation_failure_flag()) {
-        _lsa_reserve *= 2;
+        _lsa_reserve = std::min(_lsa_reserve * 2, _lsa_reserve + s_max_lsa_reserve_step);
         llogger.info("LSA allocation failure, increasing reserve in section {} to {} segments; trace: {}", fmt::ptr(this), _lsa_reserve, current_backtrace());
     } else {
-        _std_reserve *= 2;
+        _std_reserve = std::min(_std_reserve * 2, _std_reserve + s_max_std_reserve_step);
         llogger.info("Standard allocator failure, increasing head-room in section {} to {} [B]; trace: {}", fmt::ptr(this), _std_reserve, current_backtrace());
     }
     reserve(r.get_tracker().get_impl());
@@ -2976,6 +3156,12 @@ future<> use_standard_allocator_segment_pool_backend(size_t available_memory) {
     });
 }
 
+future<> use_hugepage_arena_segment_pool_backend() {
+    return smp::invoke_on_all([] {
+        shard_tracker().get_impl().segment_pool().use_hugepage_arena_backend();
+    });
+}
+
 }
 
 // Orders segments by free space, assuming all segments have the same size.
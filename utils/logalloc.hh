@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <seastar/core/memory.hh>
 #include <seastar/core/shard_id.hh>
@@ -64,6 +65,9 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // Upper bound on the duration of a single round of preemptible
+        // reclaim, zero means the round runs until the reactor needs the CPU.
+        std::chrono::microseconds reclaim_time_slice{0};
     };
 
     struct stats {
@@ -435,6 +439,11 @@ class allocating_section {
     // Do not decay below these minimal values
     static constexpr size_t s_min_lsa_reserve = 1;
     static constexpr size_t s_min_std_reserve = 1024;
+    // Bound the growth of the reserves after a failure, so that a single
+    // failure of a section with a large reserve doesn't make the next
+    // attempt reclaim a huge amount of memory synchronously.
+    static constexpr size_t s_max_lsa_reserve_step = 64;
+    static constexpr size_t s_max_std_reserve_step = 8 << 20;
     static constexpr uint64_t s_bytes_per_decay = 10'000'000'000;
     static constexpr unsigned s_segments_per_decay = 100'000;
     size_t _lsa_reserve = s_min_lsa_reserve; // in segments
@@ -540,6 +549,11 @@ future<> prime_segment_pool(size_t available_memory, size_t min_free_memory);
 // Call once, when initializing the application, before any LSA allocation takes place.
 future<> use_standard_allocator_segment_pool_backend(size_t available_memory);
 
+// Allocate segments in hugepage-sized arenas, so that LSA memory doesn't share hugepages
+// with other objects, at the cost of the memory of arenas which are partially used.
+// Call once, when initializing the application, before any LSA allocation takes place.
+future<> use_hugepage_arena_segment_pool_backend();
+
 }
 
 template <> struct fmt::formatter<logalloc::occupancy_stats> : fmt::formatter<string_view> {
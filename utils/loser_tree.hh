@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// A tournament tree of losers, for k-way merging.
+//
+// Holds up to k values, one per leaf, and keeps track of the smallest one
+// (the winner). Each internal node stores the leaf which lost the match
+// played at that node, so replacing the winner takes a single pass from its
+// leaf to the root, with exactly one comparison per level: log2(k)
+// comparisons, compared to ~2*log2(k) for popping and pushing a binary heap.
+// The path doesn't depend on the outcome of the comparisons either, so the
+// branches are easy to predict.
+//
+// Only the winner can be replaced or removed. Removed leaves become empty
+// and lose every match.
+//
+// When the same leaf keeps winning, the tree remembers the runner-up (the
+// best of the losers on the winner's path) and replaces the winner without
+// replaying any match as long as the new value is smaller than it, so that
+// merging a stream which dominates the others costs one comparison per value.
+template <typename T, typename Less>
+class loser_tree {
+    static constexpr size_t no_leaf = std::numeric_limits<size_t>::max();
+
+    Less _less;
+    // Number of consecutive wins of the same leaf after which the
+    // runner-up is remembered.
+    unsigned _gallop_threshold;
+    std::vector<std::optional<T>> _leaves;
+    // _nodes[0] is the winner, _nodes[i] for 0 < i < k is the loser of the
+    // match played at internal node i. Leaf j is node j + k, so the
+    // children of node i are nodes 2i and 2i + 1.
+    std::vector<size_t> _nodes;
+    // Scratch space for the winners of the matches, used when building.
+    std::vector<size_t> _winners;
+    size_t _size = 0;
+    size_t _runner_up = no_leaf;
+    unsigned _wins = 0;
+private:
+    bool beats(size_t a, size_t b) const {
+        return _leaves[a] && (!_leaves[b] || _less(*_leaves[a], *_leaves[b]));
+    }
+
+    void replay(size_t leaf) {
+        auto candidate = leaf;
+        for (auto node = (leaf + _leaves.size()) / 2; node > 0; node /= 2) {
+            if (beats(_nodes[node], candidate)) {
+                std::swap(_nodes[node], candidate);
+            }
+        }
+        _nodes[0] = candidate;
+    }
+
+    size_t find_runner_up() const {
+        auto winner = _nodes[0];
+        auto best = no_leaf;
+        for (auto node = (winner + _leaves.size()) / 2; node > 0; node /= 2) {
+            if (best == no_leaf || beats(_nodes[node], best)) {
+                best = _nodes[node];
+            }
+        }
+        return best;
+    }
+
+    void build() {
+        const auto k = _leaves.size();
+        _nodes.assign(k, 0);
+        _winners.resize(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            _winners[i + k] = i;
+        }
+        for (auto i = k - 1; i > 0; --i) {
+            auto a = _winners[2 * i];
+            auto b = _winners[2 * i + 1];
+            if (beats(b, a)) {
+                std::swap(a, b);
+            }
+            _winners[i] = a;
+            _nodes[i] = b;
+        }
+        _nodes[0] = k > 1 ? _winners[1] : 0;
+        _runner_up = no_leaf;
+        _wins = 0;
+    }
+public:
+    explicit loser_tree(Less less = Less(), unsigned gallop_threshold = 3)
+        : _less(std::move(less))
+        , _gallop_threshold(gallop_threshold)
+    { }
+
+    // Replaces the contents of the tree with the values of the range.
+    template <std::ranges::input_range Range>
+    void assign(Range&& values) {
+        _leaves.clear();
+        for (auto&& v : values) {
+            _leaves.emplace_back(std::forward<decltype(v)>(v));
+        }
+        _size = _leaves.size();
+        if (_size) {
+            build();
+        }
+    }
+
+    void clear() noexcept {
+        _leaves.clear();
+        _nodes.clear();
+        _size = 0;
+        _runner_up = no_leaf;
+        _wins = 0;
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    // Number of values in the tree.
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    // The smallest value. The tree must not be empty.
+    T& top() noexcept {
+        return *_leaves[_nodes[0]];
+    }
+    const T& top() const noexcept {
+        return *_leaves[_nodes[0]];
+    }
+
+    // Replaces the smallest value with v. The tree must not be empty.
+    void replace_top(T v) {
+        auto winner = _nodes[0];
+        if (_runner_up != no_leaf && (!_leaves[_runner_up] || _less(v, *_leaves[_runner_up]))) {
+            _leaves[winner] = std::move(v);
+            return;
+        }
+        _leaves[winner] = std::move(v);
+        _runner_up = no_leaf;
+        replay(winner);
+        if (_nodes[0] != winner) {
+            _wins = 0;
+        } else if (++_wins >= _gallop_threshold && _size > 1) {
+            _runner_up = find_runner_up();
+        }
+    }
+
+    // Removes the smallest value. The tree must not be empty.
+    void pop_top() {
+        auto winner = _nodes[0];
+        _leaves[winner].reset();
+        --_size;
+        _runner_up = no_leaf;
+        _wins = 0;
+        replay(winner);
+    }
+
+    // Calls func on each value in the tree, in no particular order.
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (auto& v : _leaves) {
+            if (v) {
+                func(*v);
+            }
+        }
+    }
+};
+
+} // namespace utils
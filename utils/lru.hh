@@ -9,8 +9,11 @@
 #pragma once
 
 #include "utils/assert.hh"
+#include "utils/updateable_value.hh"
 #include <boost/intrusive/list.hpp>
+#include <algorithm>
 #include <seastar/core/memory.hh>
+#include <seastar/core/future.hh>
 
 class evictable {
     friend class lru;
@@ -32,6 +35,11 @@ class evictable {
     static_assert(std::is_nothrow_constructible_v<lru_link_type, lru_link_type&&>);
 private:
     lru_link_type _lru_link;
+    // Which segment of the LRU the evictable is linked in, see lru.
+    bool _lru_protected = false;
+    // Set once the evictable was added to the LRU. Survives remove(), so that
+    // re-adding an evictable which was taken out for use counts as a second touch.
+    bool _lru_referenced = false;
 protected:
     // Prevent destruction via evictable pointer. LRU is not aware of allocation strategy.
     // Prevent destruction of a linked evictable. While we could unlink the evictable here
@@ -54,6 +62,8 @@ class evictable {
 
     void swap(evictable& o) noexcept {
         _lru_link.swap_nodes(o._lru_link);
+        std::swap(_lru_protected, o._lru_protected);
+        std::swap(_lru_referenced, o._lru_referenced);
     }
 
     virtual bool is_index() const noexcept {
@@ -77,12 +87,25 @@ class index_evictable : public evictable {
 };
 
 // Implements LRU cache replacement for row cache and sstable index cache.
+//
+// The LRU is segmented. Evictables added for the first time land in the probationary
+// segment. Evictables which are added again, after being touched or taken out of the
+// LRU for use, land in the protected segment. Eviction takes from the probationary
+// segment first, so a one-off sweep over many entries (e.g. a scan done by repair,
+// streaming or view building) only displaces entries which were touched once.
+// The protected segment is limited to protected_fraction of all entries, the least
+// recently used protected entries are moved back to the probationary segment.
+// With protected_fraction equal to 0 this is a plain LRU.
 class lru {
 private:
     using lru_type = boost::intrusive::list<evictable,
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
-    lru_type _list;
+    lru_type _list; // probationary segment
+    lru_type _protected_list;
+    size_t _probation_size = 0;
+    size_t _protected_size = 0;
+    utils::updateable_value<double> _protected_fraction;
 
     // See the comment to index_evictable.
     using index_lru_type = boost::intrusive::list<index_evictable,
@@ -92,24 +115,64 @@ class lru {
 
     using reclaiming_result = seastar::memory::reclaiming_result;
 
+    double protected_fraction() const noexcept {
+        return std::clamp(_protected_fraction.get(), 0.0, 1.0);
+    }
+
+    void link(lru_type& list, lru_type::iterator pos, evictable& e, bool is_protected) noexcept {
+        list.insert(pos, e);
+        e._lru_protected = is_protected;
+        ++(is_protected ? _protected_size : _probation_size);
+    }
+
+    void unlink(evictable& e) noexcept {
+        if (e._lru_protected) {
+            _protected_list.erase(_protected_list.iterator_to(e));
+            --_protected_size;
+        } else {
+            _list.erase(_list.iterator_to(e));
+            --_probation_size;
+        }
+    }
+
+    // Moves the least recently used protected entries to the probationary segment
+    // until the protected segment fits in its limit.
+    void shrink_protected() noexcept {
+        auto max_protected = size_t(protected_fraction() * (_probation_size + _protected_size));
+        while (_protected_size > max_protected) {
+            evictable& e = _protected_list.front();
+            unlink(e);
+            link(_list, _list.end(), e, false);
+        }
+    }
 public:
+    lru() : _protected_fraction(0.0) {}
+
+    explicit lru(utils::updateable_value<double> protected_fraction)
+        : _protected_fraction(std::move(protected_fraction))
+    {}
+
     ~lru() {
-        while (!_list.empty()) {
-            evictable& e = _list.front();
-            remove(e);
-            e.on_evicted();
-        }
+        while (evict() == reclaiming_result::reclaimed_something) {}
     }
 
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        unlink(e);
         if (e.is_index()) {
             _index_list.erase(_index_list.iterator_to(static_cast<index_evictable&>(e)));
         }
     }
 
     void add(evictable& e) noexcept {
-        _list.push_back(e);
+        if (e._lru_referenced && protected_fraction() > 0) {
+            link(_protected_list, _protected_list.end(), e, true);
+        } else {
+            e._lru_referenced = true;
+            link(_list, _list.end(), e, false);
+        }
+        if (_protected_size) {
+            shrink_protected();
+        }
         if (e.is_index()) {
             _index_list.push_back(static_cast<index_evictable&>(e));
         }
@@ -117,7 +180,9 @@ class lru {
 
     // Like add(e) but makes sure that e is evicted right before "more_recent" in the absence of later touches.
     void add_before(evictable& more_recent, evictable& e) noexcept {
-        _list.insert(_list.iterator_to(more_recent), e);
+        auto& list = more_recent._lru_protected ? _protected_list : _list;
+        e._lru_referenced = true;
+        link(list, list.iterator_to(more_recent), e, more_recent._lru_protected);
     }
 
     void touch(evictable& e) noexcept {
@@ -125,13 +190,44 @@ class lru {
         add(e);
     }
 
+    // Number of entries in the probationary segment.
+    size_t probation_size() const noexcept {
+        return _probation_size;
+    }
+
+    // Number of entries in the protected segment.
+    size_t protected_size() const noexcept {
+        return _protected_size;
+    }
+
+    // Calls func on the entries, the most recently used first, until it returns
+    // stop_iteration::yes. func must not modify the LRU.
+    template <typename Func>
+    requires std::is_invocable_r_v<seastar::stop_iteration, Func, evictable&>
+    void for_each_most_recently_used(Func func) {
+        for (auto* list : {&_protected_list, &_list}) {
+            for (auto it = list->rbegin(); it != list->rend(); ++it) {
+                if (func(*it) == seastar::stop_iteration::yes) {
+                    return;
+                }
+            }
+        }
+    }
+
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict(bool should_evict_index) noexcept {
-        if (_list.empty()) {
+        evictable* ep;
+        if (should_evict_index && !_index_list.empty()) {
+            ep = &_index_list.front();
+        } else if (!_list.empty()) {
+            ep = &_list.front();
+        } else if (!_protected_list.empty()) {
+            ep = &_protected_list.front();
+        } else {
             return reclaiming_result::reclaimed_nothing;
         }
-        evictable& e = (should_evict_index && !_index_list.empty()) ? _index_list.front() : _list.front();
+        evictable& e = *ep;
         remove(e);
         if constexpr (!Shallow) {
             e.on_evicted();
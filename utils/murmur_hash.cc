@@ -9,6 +9,9 @@
  * SPDX-License-Identifier: (LicenseRef-ScyllaDB-Source-Available-1.0 and Apache-2.0)
  */
 
+#include <algorithm>
+#include <limits>
+
 #include "murmur_hash.hh"
 
 namespace utils {
@@ -148,32 +151,33 @@ static inline uint64_t getblock(bytes_view key, uint32_t index)
             | (uint64_t(p[7]) << 56);
 }
 
-void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+static constexpr uint64_t c1 = 0x87c37b91114253d5L;
+static constexpr uint64_t c2 = 0x4cf5ad432745937fL;
+
+static inline void mix_block(uint64_t& h1, uint64_t& h2, uint64_t k1, uint64_t k2)
 {
-    uint32_t length = key.size();
-    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
+    k1 *= c1; k1 = std::rotl(k1,31); k1 *= c2; h1 ^= k1;
+
+    h1 = std::rotl(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+
+    k2 *= c2; k2  = std::rotl(k2,33); k2 *= c1; h2 ^= k2;
 
-    uint64_t h1 = seed;
-    uint64_t h2 = seed;
+    h2 = std::rotl(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+}
 
-    uint64_t c1 = 0x87c37b91114253d5L;
-    uint64_t c2 = 0x4cf5ad432745937fL;
+// Mixes the blocks of the key starting from block `first_block`, and then
+// the tail, and produces the result.
+static inline void finish(bytes_view key, uint32_t first_block, uint64_t h1, uint64_t h2, std::array<uint64_t,2>& result)
+{
+    uint32_t length = key.size();
+    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
 
     //----------
     // body
 
-    for(uint32_t i = 0; i < nblocks; i++)
+    for(uint32_t i = first_block; i < nblocks; i++)
     {
-        uint64_t k1 = getblock(key, i*2+0);
-        uint64_t k2 = getblock(key, i*2+1);
-
-        k1 *= c1; k1 = std::rotl(k1,31); k1 *= c2; h1 ^= k1;
-
-        h1 = std::rotl(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
-
-        k2 *= c2; k2  = std::rotl(k2,33); k2 *= c1; h2 ^= k2;
-
-        h2 = std::rotl(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+        mix_block(h1, h2, getblock(key, i*2+0), getblock(key, i*2+1));
     }
 
     //----------
@@ -238,5 +242,43 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     result[1] = h2;
 }
 
+void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+{
+    finish(key, 0, seed, seed, result);
+}
+
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t,2>> results)
+{
+    // The hash of a single key is one long dependency chain of multiplications,
+    // so a lone key leaves most of the execution units idle. Keys are hashed
+    // in groups of `lanes`, with the blocks which all keys of the group have
+    // mixed in lockstep, so that the chains of different keys overlap. The
+    // loops over lanes have no dependencies between iterations, and are
+    // vectorized where the target has 64-bit vector multiplication.
+    constexpr size_t lanes = 4;
+    size_t i = 0;
+    for (; i + lanes <= keys.size(); i += lanes) {
+        uint64_t h1[lanes];
+        uint64_t h2[lanes];
+        uint32_t common_blocks = std::numeric_limits<uint32_t>::max();
+        for (size_t l = 0; l < lanes; ++l) {
+            h1[l] = seed;
+            h2[l] = seed;
+            common_blocks = std::min(common_blocks, uint32_t(keys[i + l].size() >> 4));
+        }
+        for (uint32_t b = 0; b < common_blocks; ++b) {
+            for (size_t l = 0; l < lanes; ++l) {
+                mix_block(h1[l], h2[l], getblock(keys[i + l], b*2+0), getblock(keys[i + l], b*2+1));
+            }
+        }
+        for (size_t l = 0; l < lanes; ++l) {
+            finish(keys[i + l], common_blocks, h1[l], h2[l], results[i + l]);
+        }
+    }
+    for (; i < keys.size(); ++i) {
+        finish(keys[i], 0, seed, seed, results[i]);
+    }
+}
+
 } // namespace murmur_hash
 } // namespace utils
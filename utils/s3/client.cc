@@ -1302,6 +1302,102 @@ data_source client::make_chunked_download_source(sstring object_name, range rang
     return data_source(std::make_unique<chunked_download_source>(shared_from_this(), std::move(object_name), range, as));
 }
 
+// Reads the object with up to `depth` ranged GETs of `part_size` bytes in
+// flight at the same time, returning the parts in order. Sequential scans of
+// large objects are bound by the latency of a single request rather than by
+// the bandwidth, so keeping several requests going on the pooled connections
+// multiplies the throughput.
+class client::parallel_download_source final : public seastar::data_source_impl {
+    shared_ptr<client> _client;
+    sstring _object_name;
+    seastar::abort_source* _as;
+    range _range;
+    unsigned _depth;
+    size_t _part_size;
+    bool _size_known;
+    // Parts in flight, in the order of their offsets.
+    std::deque<future<temporary_buffer<char>>> _parts;
+    bool _is_finished = false;
+
+    future<temporary_buffer<char>> get_part(range part, std::optional<semaphore_units<>> units) {
+        auto buf = co_await _client->get_object_contiguous(_object_name, part, _as);
+        if (units) {
+            units->return_units(part.length() - buf.size());
+            auto b = buf.get_write();
+            auto size = buf.size();
+            buf = temporary_buffer<char>(b, size, make_object_deleter(buf.release(), std::move(*units)));
+        }
+        co_return buf;
+    }
+
+    void issue_parts() {
+        while (_parts.size() < _depth && _range.length() > 0) {
+            // The memory is claimed only if it's available, otherwise
+            // the scan would stall waiting for other readers. The first
+            // part in flight doesn't need it, so each reader makes progress.
+            auto units = try_get_units(_client->_memory, _part_size);
+            if (!units && !_parts.empty()) {
+                break;
+            }
+            range part{_range.offset(), std::min<uint64_t>(_range.length(), _part_size)};
+            s3l.trace("Read-ahead for object '{}' issues GET of range {}", _object_name, part);
+            _parts.push_back(get_part(part, std::move(units)));
+            _range += part.length();
+        }
+    }
+
+public:
+    parallel_download_source(shared_ptr<client> cln, sstring object_name, range range, unsigned depth, size_t part_size, seastar::abort_source* as)
+        : _client(std::move(cln))
+        , _object_name(std::move(object_name))
+        , _as(as)
+        , _range(range)
+        , _depth(std::max(depth, 1u))
+        , _part_size(std::max<size_t>(part_size, 1))
+        , _size_known(range.length() != range::_max_object_size)
+    {
+        s3l.trace("Constructing parallel_download_source for object '{}', depth {}, part size {}", _object_name, _depth, _part_size);
+    }
+
+    future<temporary_buffer<char>> get() override {
+        if (!_size_known) {
+            auto size = co_await _client->get_object_size(_object_name, _as);
+            _range = range{_range.offset(), size > _range.offset() ? size - _range.offset() : 0};
+            _size_known = true;
+        }
+        if (_is_finished) {
+            co_return temporary_buffer<char>();
+        }
+        issue_parts();
+        if (_parts.empty()) {
+            _is_finished = true;
+            co_return temporary_buffer<char>();
+        }
+        auto f = std::move(_parts.front());
+        _parts.pop_front();
+        auto buf = co_await std::move(f);
+        if (buf.empty()) {
+            // The object turned out to be shorter than the requested range.
+            _is_finished = true;
+        } else {
+            issue_parts();
+        }
+        co_return buf;
+    }
+
+    future<> close() override {
+        _is_finished = true;
+        s3l.trace("Closing parallel_download_source for object '{}'", _object_name);
+        for (auto& f : std::exchange(_parts, {})) {
+            co_await std::move(f).handle_exception([] (auto) {});
+        }
+    }
+};
+
+data_source client::make_parallel_download_source(sstring object_name, range range, unsigned depth, size_t part_size, seastar::abort_source* as) {
+    return data_source(std::make_unique<parallel_download_source>(shared_from_this(), std::move(object_name), range, depth, part_size, as));
+}
+
 class client::download_source final : public seastar::data_source_impl {
     shared_ptr<client> _client;
     sstring _object_name;
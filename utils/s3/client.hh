@@ -104,6 +104,7 @@ class client : public enable_shared_from_this<client> {
     class upload_sink;
     class upload_jumbo_sink;
     class chunked_download_source;
+    class parallel_download_source;
     class download_source;
     class do_upload_file;
     class readable_file;
@@ -172,6 +173,8 @@ class client : public enable_shared_from_this<client> {
     data_sink make_upload_jumbo_sink(sstring object_name, std::optional<unsigned> max_parts_per_piece = {}, seastar::abort_source* = nullptr);
     data_source make_download_source(sstring object_name, range download_range = s3::full_range, seastar::abort_source* = nullptr);
     data_source make_chunked_download_source(sstring object_name, range range = s3::full_range, seastar::abort_source* = nullptr);
+    /// read the object with up to `depth` concurrent ranged GETs of `part_size` bytes each
+    data_source make_parallel_download_source(sstring object_name, range range, unsigned depth, size_t part_size, seastar::abort_source* = nullptr);
     /// upload a file with specified path to s3
     ///
     /// @param path the path to the file
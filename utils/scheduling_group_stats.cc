@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+#include <seastar/core/metrics_api.hh>
+
+#include "utils/scheduling_group_stats.hh"
+
+namespace utils {
+
+namespace {
+
+using stats_updater = std::function<void(scheduling_group_stats&, double)>;
+
+struct metric_family_updater {
+    // The label with the name of the scheduling group
+    const char* group_label;
+    stats_updater update;
+};
+
+const std::unordered_map<std::string_view, metric_family_updater>& metric_family_updaters() {
+    static const std::unordered_map<std::string_view, metric_family_updater> updaters = {
+        {"scheduler_shares", {"group", [] (scheduling_group_stats& s, double v) { s.shares = v; }}},
+        {"scheduler_runtime_ms", {"group", [] (scheduling_group_stats& s, double v) { s.runtime_ms = v; }}},
+        {"scheduler_waittime_ms", {"group", [] (scheduling_group_stats& s, double v) { s.waittime_ms = v; }}},
+        {"scheduler_starvetime_ms", {"group", [] (scheduling_group_stats& s, double v) { s.starvetime_ms = v; }}},
+        {"scheduler_tasks_processed", {"group", [] (scheduling_group_stats& s, double v) { s.tasks_processed = v; }}},
+        {"scheduler_queue_length", {"group", [] (scheduling_group_stats& s, double v) { s.queue_length = v; }}},
+        // There is a metric for each I/O queue, i.e. mountpoint.
+        {"io_queue_total_operations", {"class", [] (scheduling_group_stats& s, double v) { s.io_operations += v; }}},
+        {"io_queue_total_bytes", {"class", [] (scheduling_group_stats& s, double v) { s.io_bytes += v; }}},
+        {"io_queue_total_delay_sec", {"class", [] (scheduling_group_stats& s, double v) { s.io_queue_delay_us += v * 1e6; }}},
+        {"io_queue_total_exec_sec", {"class", [] (scheduling_group_stats& s, double v) { s.io_exec_us += v * 1e6; }}},
+    };
+    return updaters;
+}
+
+} // anonymous namespace
+
+std::vector<scheduling_group_stats> get_local_scheduling_group_stats() {
+    std::map<sstring, scheduling_group_stats> stats;
+    auto all_metrics = seastar::metrics::impl::get_values();
+    const auto& all_metadata = *all_metrics->metadata;
+    const auto& updaters = metric_family_updaters();
+    for (size_t i = 0; i < all_metadata.size(); ++i) {
+        auto updater = updaters.find(std::string_view(all_metadata[i].mf.name));
+        if (updater == updaters.end()) {
+            continue;
+        }
+        const auto& metrics = all_metadata[i].metrics;
+        const auto& values = all_metrics->values[i];
+        for (size_t j = 0; j < metrics.size() && j < values.size(); ++j) {
+            auto group = metrics[j].labels().find(updater->second.group_label);
+            if (group == metrics[j].labels().end()) {
+                continue;
+            }
+            auto& s = stats[group->second];
+            s.group = group->second;
+            updater->second.update(s, values[j].d());
+        }
+    }
+    std::vector<scheduling_group_stats> ret;
+    ret.reserve(stats.size());
+    for (auto& [_, s] : stats) {
+        ret.push_back(std::move(s));
+    }
+    return ret;
+}
+
+} // namespace utils
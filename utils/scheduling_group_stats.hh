@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <seastar/core/sstring.hh>
+
+#include "seastarx.hh"
+
+namespace utils {
+
+// What a scheduling group of a shard consumed and waited for, since the
+// start of the shard. For telling which group contends with which, e.g.
+// whether statements are slow because compaction takes the CPU or the disk.
+struct scheduling_group_stats {
+    sstring group;
+    double shares = 0;
+    // CPU time the group's tasks ran
+    uint64_t runtime_ms = 0;
+    // Time the group had tasks to run, but other groups ran
+    uint64_t waittime_ms = 0;
+    // Time the group had no tasks to run, though it was entitled to its shares
+    uint64_t starvetime_ms = 0;
+    uint64_t tasks_processed = 0;
+    uint64_t queue_length = 0;
+    // I/O of the group, summed over all I/O queues (mountpoints)
+    uint64_t io_operations = 0;
+    uint64_t io_bytes = 0;
+    // Time the group's requests spent in the I/O queues before dispatching,
+    // and executing after.
+    uint64_t io_queue_delay_us = 0;
+    uint64_t io_exec_us = 0;
+};
+
+// The stats of the scheduling groups of this shard, ordered by group name.
+//
+// The scheduler and the I/O queues only expose them as metrics, so this
+// reads the metrics registered by Seastar. A group which doesn't do I/O
+// has no I/O metrics.
+std::vector<scheduling_group_stats> get_local_scheduling_group_stats();
+
+} // namespace utils
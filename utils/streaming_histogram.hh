@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <map>
 
 namespace utils {
@@ -150,6 +151,42 @@ struct streaming_histogram {
         return sum;
     }
 
+    /**
+     * Estimates the q-quantile of the points of this histogram, i.e. the point b
+     * for which sum(b) is q times the number of all points.
+     *
+     * @param q quantile, between 0 and 1
+     * @return estimated q-quantile, or NaN if the histogram is empty
+     */
+    double quantile(double q) const {
+        if (bin.empty()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        uint64_t total = 0;
+        for (auto& e : bin) {
+            total += e.second;
+        }
+        double target = q * total;
+        double lo = bin.begin()->first;
+        double hi = bin.rbegin()->first;
+        if (target <= sum(lo)) {
+            return lo;
+        }
+        // sum() is non-decreasing, so bisect [lo, hi] until the interval
+        // can't be split any further.
+        for (;;) {
+            double mid = lo + (hi - lo) / 2;
+            if (mid <= lo || mid >= hi) {
+                return hi;
+            }
+            if (sum(mid) < target) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+
     // FIXME: convert Java code below.
 #if 0
     public Map<Double, Long> getAsMap()
@@ -34,6 +34,9 @@
 
 #include "bytes.hh"
 
+#include <seastar/core/byteorder.hh>
+
+#include <bit>
 #include <cstdint>
 
 using vint_size_type = bytes::size_type;
@@ -49,6 +52,28 @@ struct unsigned_vint final {
 
     static value_type deserialize(bytes_view v);
 
+    // Deserializes the vint at src and advances src past it.
+    //
+    // Doesn't check bounds: max_vint_length bytes starting at src must be readable,
+    // even if the vint is shorter. Meant for decoding runs of vints from a
+    // contiguous buffer after checking its size once.
+    static value_type deserialize_unchecked(const int8_t*& src) noexcept {
+        const int8_t first_byte = *src;
+        if (first_byte >= 0) {
+            ++src;
+            return value_type(first_byte);
+        }
+        const unsigned extra_bytes_size = std::countl_one(uint8_t(first_byte));
+        // A single load of the extra bytes, of which the ones past the vint are shifted out.
+        const auto extra_bytes = seastar::read_be<uint64_t>(reinterpret_cast<const char*>(src + 1));
+        src += 1 + extra_bytes_size;
+        if (extra_bytes_size == 8) {
+            return extra_bytes;
+        }
+        const auto high_bits = value_type(uint8_t(first_byte) & (0xff >> extra_bytes_size));
+        return (high_bits << (extra_bytes_size * 8)) | (extra_bytes >> ((8 - extra_bytes_size) * 8));
+    }
+
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };
 
@@ -61,5 +86,11 @@ struct signed_vint final {
 
     static value_type deserialize(bytes_view v);
 
+    // See unsigned_vint::deserialize_unchecked().
+    static value_type deserialize_unchecked(const int8_t*& src) noexcept {
+        const auto n = unsigned_vint::deserialize_unchecked(src);
+        return static_cast<value_type>((n >> 1) ^ -(n & 1));
+    }
+
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };